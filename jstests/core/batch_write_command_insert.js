@@ -242,6 +242,54 @@ assert.eq('string', typeof result.writeErrors[0].errmsg);
 
 assert.eq(coll.count(), 1);
 
+//
+// Fail with duplicate _id errors, on an existing document and within the batch, and with a
+// duplicate key error on the unique index, ordered false
+var docsWithDuplicates = [
+    {_id: 1, a: 1},
+    {_id: 2, a: 2},
+    {_id: 3, a: 3},
+    {_id: 4, a: 4},
+    {_id: 5, a: 5},
+    {_id: 5, a: 50},
+    {_id: 6, a: 1},
+    {_id: 7, a: 7}
+];
+coll.remove({});
+coll.insert({_id: 3, a: 103});
+request = {
+    insert: coll.getName(),
+    documents: docsWithDuplicates,
+    writeConcern: {w: 1},
+    ordered: false
+};
+result = coll.runCommand(request);
+assert(result.ok, tojson(result));
+assert.eq(5, result.n);
+assert.eq(3, result.writeErrors.length);
+assert.eq(2, result.writeErrors[0].index);
+assert.eq(5, result.writeErrors[1].index);
+assert.eq(6, result.writeErrors[2].index);
+assert.eq(6, coll.count());
+assert.eq(1, coll.count({_id: 5, a: 5}));
+
+//
+// Same, ordered true
+coll.remove({});
+coll.insert({_id: 3, a: 103});
+request = {
+    insert: coll.getName(),
+    documents: docsWithDuplicates,
+    writeConcern: {w: 1},
+    ordered: true
+};
+result = coll.runCommand(request);
+assert(result.ok, tojson(result));
+assert.eq(2, result.n);
+assert.eq(1, result.writeErrors.length);
+assert.eq(2, result.writeErrors[0].index);
+assert.eq(3, coll.count());
+
 //
 // Ensure _id is the first field in all documents
 coll.remove({});
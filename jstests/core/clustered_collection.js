@@ -0,0 +1,76 @@
+/**
+ * Tests that a clustered collection stores its documents keyed by their integral _id, without a
+ * separate _id index, and that _id lookups and ranges are answered from the record store.
+ * @tags: [
+ *   assumes_no_implicit_collection_creation_after_drop,
+ *   assumes_unsharded_collection,
+ *   requires_wiredtiger,
+ * ]
+ */
+(function() {
+    "use strict";
+
+    load("jstests/libs/analyze_plan.js");  // For getPlanStage and isIdhack.
+
+    if (jsTest.options().storageEngine && jsTest.options().storageEngine !== "wiredTiger") {
+        jsTest.log("Skipping test on non-WT storage engine: " + jsTest.options().storageEngine);
+        return;
+    }
+
+    const collName = "clustered_collection";
+    let coll = db[collName];
+    coll.drop();
+
+    assert.commandFailedWithCode(
+        db.createCollection(collName, {clustered: true, capped: true, size: 4096}),
+        ErrorCodes.BadValue);
+    assert.commandFailedWithCode(
+        db.createCollection(collName, {clustered: true, autoIndexId: true}), ErrorCodes.BadValue);
+    assert.commandWorked(db.createCollection(collName, {clustered: true}));
+
+    // No _id index is built for a clustered collection.
+    assert.eq([], coll.getIndexes());
+
+    for (let i = 1; i <= 10; ++i) {
+        assert.writeOK(coll.insert({_id: i, a: i * 10}));
+    }
+    assert.eq(ErrorCodes.DuplicateKey, coll.insert({_id: 3}).getWriteError().code);
+    assert.eq(ErrorCodes.DuplicateKey, coll.insert({_id: NumberLong(3)}).getWriteError().code);
+    assert.writeError(coll.insert({_id: "a"}));
+    assert.writeError(coll.insert({_id: 1.5}));
+    assert.writeError(coll.insert({_id: -1}));
+    assert.writeError(coll.insert({a: 1}));
+    assert.eq(10, coll.find().itcount());
+
+    // Documents are returned in _id order by a collection scan.
+    assert.eq([1, 2, 3, 4, 5, 6, 7, 8, 9, 10], coll.find().toArray().map(doc => doc._id));
+
+    // Point lookups on _id go straight to the record store.
+    assert.eq({_id: 4, a: 40}, coll.findOne({_id: 4}));
+    assert.eq({_id: 4, a: 40}, coll.findOne({_id: NumberLong(4)}));
+    assert(isIdhack(db, coll.find({_id: 4}).explain().queryPlanner.winningPlan));
+
+    assert.writeOK(coll.update({_id: 4}, {$set: {a: 41}}));
+    assert.eq({_id: 4, a: 41}, coll.findOne({_id: 4}));
+    assert.writeOK(coll.remove({_id: 4}));
+    assert.eq(null, coll.findOne({_id: 4}));
+    assert.writeOK(coll.update({_id: 4}, {$set: {a: 42}}, {upsert: true}));
+    assert.eq({_id: 4, a: 42}, coll.findOne({_id: 4}));
+
+    // A range on _id bounds the collection scan.
+    const rangeFilter = {_id: {$gt: 2.5, $lte: 6}};
+    assert.eq([3, 4, 5, 6], coll.find(rangeFilter).toArray().map(doc => doc._id));
+    const collScan = getPlanStage(coll.find(rangeFilter).explain().queryPlanner.winningPlan,
+                                  "COLLSCAN");
+    assert.neq(null, collScan);
+    assert.eq(3, collScan.minRecord);
+    assert.eq(6, collScan.maxRecord);
+    assert.eq([6, 5, 4, 3],
+              coll.find(rangeFilter).sort({$natural: -1}).toArray().map(doc => doc._id));
+    assert.eq(0, coll.find({_id: {$gt: 10}}).itcount());
+    assert.eq(0, coll.find({_id: {$lt: 1}}).itcount());
+
+    // The stored form of the _id is preserved.
+    assert.writeOK(coll.insert({_id: NumberLong(20)}));
+    assert.eq(NumberLong(20), coll.findOne({_id: 20})._id);
+})();
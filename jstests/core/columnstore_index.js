@@ -0,0 +1,58 @@
+// Tests that a query projecting fields stored by a columnstore index is answered by a column scan
+// over the index, and returns the same results as a collection scan.
+// @tags: [assumes_unsharded_collection]
+(function() {
+    "use strict";
+
+    load("jstests/libs/analyze_plan.js");  // For getPlanStage.
+
+    let coll = db.columnstore_index;
+    coll.drop();
+
+    assert.writeOK(coll.insert({_id: 0, a: 1, b: "x", c: {d: 1}}));
+    assert.writeOK(coll.insert({_id: 1, a: 2, c: {d: 2}}));
+    assert.writeOK(coll.insert({_id: 2, b: [1, 2], c: 3}));
+    assert.writeOK(coll.insert({_id: 3, a: 3, b: "y", c: null, e: 1}));
+
+    function assertColumnScanResults(filter, projection, expectedFields) {
+        // Sorting on _id could use the _id index, so compare the results in a canonical order.
+        const canonicalize = docs => docs.map(doc => tojson(doc)).sort();
+        const expected = coll.find(filter, projection).hint({$natural: 1}).toArray();
+        assert.eq(canonicalize(expected), canonicalize(coll.find(filter, projection).toArray()));
+
+        const explain = coll.find(filter, projection).explain("executionStats");
+        const columnScan = getPlanStage(explain.queryPlanner.winningPlan, "COLUMN_SCAN");
+        assert.neq(null, columnScan, tojson(explain));
+        assert.eq(expectedFields, columnScan.fields, tojson(columnScan));
+        assert.eq(expected.length, explain.executionStats.nReturned, tojson(explain));
+    }
+
+    // Sparse, unique and partial columnstore indexes are rejected, as are dotted fields.
+    assert.commandFailedWithCode(coll.createIndex({a: "columnstore"}, {sparse: true}),
+                                 ErrorCodes.CannotCreateIndex);
+    assert.commandFailedWithCode(coll.createIndex({a: "columnstore"}, {unique: true}),
+                                 ErrorCodes.CannotCreateIndex);
+    assert.commandFailed(coll.createIndex({"c.d": "columnstore"}));
+
+    assert.commandWorked(coll.createIndex({a: "columnstore", b: "columnstore", c: "columnstore"}));
+    assert.commandWorked(coll.validate(true));
+
+    assertColumnScanResults({}, {a: 1}, ["a"]);
+    assertColumnScanResults({a: {$gte: 2}}, {_id: 0, b: 1}, ["a", "b"]);
+    assertColumnScanResults({"c.d": 1}, {a: 1, "c.d": 1}, ["a", "c"]);
+    assertColumnScanResults({b: 1}, {b: 1}, ["b"]);
+
+    // A query needing a field the index does not store scans the collection instead.
+    let explain = coll.find({e: 1}, {a: 1}).explain();
+    assert(isCollscan(db, explain.queryPlanner.winningPlan), tojson(explain));
+
+    // The column scan sees updates and deletes.
+    assert.writeOK(coll.update({_id: 1}, {$set: {b: "z"}, $unset: {a: 1}}));
+    assert.writeOK(coll.remove({_id: 2}));
+    assertColumnScanResults({}, {a: 1, b: 1}, ["a", "b"]);
+
+    // An index of every field serves any top-level field.
+    assert.commandWorked(coll.dropIndexes());
+    assert.commandWorked(coll.createIndex({"$**": "columnstore"}));
+    assertColumnScanResults({e: {$exists: true}}, {a: 1}, ["a", "e"]);
+})();
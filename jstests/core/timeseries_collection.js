@@ -0,0 +1,92 @@
+/**
+ * Tests that a time-series collection stores its measurements in buckets grouped by metadata, that
+ * reads through its view unpack them again, and that closed buckets are compressed.
+ * @tags: [
+ *   assumes_no_implicit_collection_creation_after_drop,
+ *   assumes_unsharded_collection,
+ *   does_not_support_stepdowns,
+ *   requires_non_retryable_writes,
+ * ]
+ */
+(function() {
+    "use strict";
+
+    const testDB = db.getSiblingDB("timeseries_collection");
+    assert.commandWorked(testDB.dropDatabase());
+
+    const coll = testDB.weather;
+    const buckets = testDB.system.buckets.weather;
+
+    assert.commandFailedWithCode(
+        testDB.createCollection("bad", {timeseries: {metaField: "sensor"}}),
+        ErrorCodes.BadValue);
+    assert.commandFailed(testDB.createCollection(
+        "bad", {timeseries: {timeField: "time"}, capped: true, size: 4096}));
+
+    assert.commandWorked(testDB.createCollection(
+        coll.getName(),
+        {timeseries: {timeField: "time", metaField: "sensor", bucketMaxSpanSeconds: 60}}));
+
+    const infos = testDB.getCollectionInfos();
+    const viewInfo = infos.find(info => info.name === coll.getName());
+    assert.eq("view", viewInfo.type, tojson(infos));
+    assert.eq(buckets.getName(), viewInfo.options.viewOn, tojson(viewInfo));
+    const bucketsInfo = infos.find(info => info.name === buckets.getName());
+    assert.eq("time", bucketsInfo.options.timeseries.timeField, tojson(bucketsInfo));
+    assert.eq(60, bucketsInfo.options.timeseries.bucketMaxSpanSeconds, tojson(bucketsInfo));
+
+    const start = ISODate("2018-09-01T00:00:00Z");
+    const at = (seconds) => new Date(start.getTime() + seconds * 1000);
+
+    assert.commandWorked(coll.insert([
+        {_id: 0, time: at(0), sensor: "a", temp: 20.5},
+        {_id: 1, time: at(1), sensor: "b", temp: 18},
+        {_id: 2, time: at(2), sensor: "a", temp: 21.5},
+        {_id: 3, time: at(3), sensor: "b", temp: "n/a"},
+    ]));
+
+    // Measurements of each sensor share a bucket whose summaries cover them.
+    assert.eq(2, buckets.count());
+    const bucketA = buckets.findOne({meta: "a"});
+    assert.eq(2, bucketA.control.count, tojson(bucketA));
+    assert.eq(20.5, bucketA.control.min.temp, tojson(bucketA));
+    assert.eq(21.5, bucketA.control.max.temp, tojson(bucketA));
+    assert.eq(["temp"], buckets.findOne({meta: "b"}).control.mixed);
+
+    assert.eq([0, 1, 2, 3], coll.find().sort({_id: 1}).toArray().map(doc => doc._id));
+    assert.docEq({_id: 2, time: at(2), temp: 21.5, sensor: "a"}, coll.findOne({_id: 2}));
+    assert.eq([0, 2], coll.find({sensor: "a"}).sort({_id: 1}).toArray().map(doc => doc._id));
+    assert.eq([2, 3],
+              coll.find({time: {$gte: at(2)}}).sort({_id: 1}).toArray().map(doc => doc._id));
+    assert.eq([3], coll.find({temp: "n/a"}).toArray().map(doc => doc._id));
+
+    // The bucket-level $match on the summaries is added in front of the unpacking stage.
+    const explain = coll.explain().aggregate([{$match: {temp: {$gt: 21}}}]);
+    assert(JSON.stringify(explain).includes("control.max.temp"), tojson(explain));
+
+    // A measurement outside the time span of the open bucket starts a new bucket.
+    assert.commandWorked(coll.insert({_id: 4, time: at(120), sensor: "a", temp: 19}));
+    assert.eq(2, buckets.count({meta: "a"}));
+
+    // Measurements need a date in the time field.
+    assert.commandFailedWithCode(coll.insert({_id: 5, sensor: "a"}), ErrorCodes.BadValue);
+    assert.commandFailedWithCode(coll.insert({_id: 5, time: 1, sensor: "a"}), ErrorCodes.BadValue);
+
+    // A full bucket is closed and compressed, and still reads back the same.
+    const batch = [];
+    for (let i = 0; i < 1001; ++i) {
+        batch.push({_id: 100 + i, time: at(1000 + i % 50), sensor: "c", temp: i / 4});
+    }
+    assert.commandWorked(coll.insert(batch));
+    assert.eq(2, buckets.count({meta: "c"}));
+    const compressed = buckets.findOne({meta: "c", "control.version": 2});
+    assert.neq(null, compressed);
+    assert.eq(1000, compressed.control.count, tojson(compressed.control));
+    assert(compressed.data.temp instanceof BinData, tojson(compressed.data.temp));
+    assert.eq(1001, coll.count({sensor: "c"}));
+    assert.eq(250, coll.findOne({_id: 1100}).temp);
+
+    // Dropping the collection drops its buckets too.
+    assert(coll.drop());
+    assert.eq(null, testDB.getCollectionInfos().find(info => info.name === buckets.getName()));
+})();
@@ -0,0 +1,45 @@
+// Tests that an update modifying the fields of only some indexes leaves the keys of every index
+// correct, including indexes whose key pattern is untouched but whose partial filter is not.
+(function() {
+    "use strict";
+
+    let coll = db.update_unaffected_indexes;
+    coll.drop();
+
+    assert.commandWorked(coll.createIndex({a: 1}));
+    assert.commandWorked(coll.createIndex({"b.c": 1}));
+    assert.commandWorked(coll.createIndex({e: 1}, {partialFilterExpression: {f: {$gt: 0}}}));
+
+    function assertIndexedValues(keyPattern, query, expectedValues) {
+        let res = coll.find(query, {_id: 0}).hint(keyPattern).returnKey().toArray();
+        let field = Object.keys(keyPattern)[0];
+        assert.eq(expectedValues.sort(), res.map(key => key[field]).sort(), tojson(res));
+    }
+
+    assert.writeOK(coll.insert({_id: 0, a: 1, b: [{c: 1}, {c: 2}], e: 1, f: 0}));
+
+    // Modifying 'a' only changes the keys of the {a: 1} index.
+    assert.writeOK(coll.update({_id: 0}, {$set: {a: 2}}));
+    assertIndexedValues({a: 1}, {_id: 0}, [2]);
+    assertIndexedValues({"b.c": 1}, {_id: 0}, [1, 2]);
+
+    // Modifying one array element only changes the keys of the {"b.c": 1} index.
+    assert.writeOK(coll.update({_id: 0}, {$set: {"b.1.c": 3}}));
+    assertIndexedValues({a: 1}, {_id: 0}, [2]);
+    assertIndexedValues({"b.c": 1}, {_id: 0}, [1, 3]);
+
+    // Modifying the partial filter field adds the document to the partial index.
+    assertIndexedValues({e: 1}, {_id: 0, f: {$gt: 0}}, []);
+    assert.writeOK(coll.update({_id: 0}, {$inc: {f: 1}}));
+    assertIndexedValues({e: 1}, {_id: 0, f: {$gt: 0}}, [1]);
+
+    // A replacement may modify any field.
+    assert.writeOK(coll.update({_id: 0}, {a: 5, b: {c: 6}, e: 7, f: 1}));
+    assertIndexedValues({a: 1}, {_id: 0}, [5]);
+    assertIndexedValues({"b.c": 1}, {_id: 0}, [6]);
+    assertIndexedValues({e: 1}, {_id: 0, f: {$gt: 0}}, [7]);
+
+    let validateRes = coll.validate({full: true});
+    assert.commandWorked(validateRes);
+    assert(validateRes.valid, tojson(validateRes));
+}());
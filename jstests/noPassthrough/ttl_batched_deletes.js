@@ -0,0 +1,69 @@
+/**
+ * Tests that the TTL monitor deletes expired documents from several collections in batches, and
+ * reports its progress through serverStatus.
+ */
+(function() {
+    "use strict";
+
+    const conn = MongoRunner.runMongod({
+        setParameter: {
+            ttlMonitorSleepSecs: 1,
+            ttlMonitorDeletesPerWriteUnitOfWork: 10,
+            ttlMonitorMaxConcurrency: 2,
+        }
+    });
+    assert.neq(null, conn, "mongod was unable to start up");
+
+    const testDB = conn.getDB("test");
+    assert.commandFailedWithCode(
+        testDB.adminCommand({setParameter: 1, ttlMonitorDeletesPerWriteUnitOfWork: 0}),
+        ErrorCodes.BadValue);
+    assert.commandFailedWithCode(
+        testDB.adminCommand({setParameter: 1, ttlMonitorMaxConcurrency: 0}), ErrorCodes.BadValue);
+
+    assert.commandWorked(testDB.adminCommand({setParameter: 1, ttlMonitorEnabled: false}));
+
+    const numCollections = 3;
+    const numExpired = 95;
+    const numLive = 5;
+    const expired = new Date(Date.now() - 60 * 60 * 1000);
+    const live = new Date(Date.now() + 60 * 60 * 1000);
+    for (let i = 0; i < numCollections; ++i) {
+        const coll = testDB["ttl_batched_" + i];
+        const bulk = coll.initializeUnorderedBulkOp();
+        for (let j = 0; j < numExpired; ++j) {
+            bulk.insert({date: expired});
+        }
+        for (let j = 0; j < numLive; ++j) {
+            bulk.insert({date: live});
+        }
+        assert.writeOK(bulk.execute());
+        assert.commandWorked(coll.createIndex({date: 1}, {expireAfterSeconds: 60}));
+    }
+
+    const ttlMetrics = () => testDB.serverStatus().metrics.ttl;
+    const batchesBefore = ttlMetrics().deleteBatches;
+    const passesBefore = ttlMetrics().passes;
+
+    assert.commandWorked(testDB.adminCommand({setParameter: 1, ttlMonitorEnabled: true}));
+
+    // Wait for a pass to complete after the one that deleted the documents, so that its metrics
+    // have been published.
+    assert.soon(function() {
+        return ttlMetrics().passes >= passesBefore + 2 &&
+            ttlMetrics().deletedDocuments >= numCollections * numExpired;
+    }, "TTL monitor didn't delete the expired documents");
+
+    for (let i = 0; i < numCollections; ++i) {
+        assert.eq(numLive, testDB["ttl_batched_" + i].count());
+    }
+
+    const metrics = ttlMetrics();
+    // Each collection needs at least ten batches of at most ten deletes.
+    assert.gte(metrics.deleteBatches - batchesBefore, numCollections * 10, tojson(metrics));
+    assert.gte(metrics.lagSecs, 0, tojson(metrics));
+    assert.gte(metrics.lastPassMillis, 0, tojson(metrics));
+    assert.gte(metrics.throttledMillis, 0, tojson(metrics));
+
+    MongoRunner.stopMongod(conn);
+})();
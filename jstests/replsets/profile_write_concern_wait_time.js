@@ -0,0 +1,31 @@
+// Tests that the profiler and the slow query log report the time an operation spent waiting for
+// its write concern, split into the local sync wait and the replication wait.
+
+(function() {
+    "use strict";
+    var rst = new ReplSetTest({nodes: 2});
+    rst.startSet();
+    rst.initiate();
+    rst.awaitReplication();
+
+    var primaryDB = rst.getPrimary().getDB('test');
+    assert.commandWorked(primaryDB.runCommand({profile: 2}));
+
+    assert.commandWorked(primaryDB.runCommand(
+        {insert: "foo", documents: [{_id: 1}], writeConcern: {w: 2, j: true}, comment: "wc"}));
+    var entry = primaryDB.system.profile.findOne({"command.comment": "wc"});
+    assert.neq(null, entry, tojson(primaryDB.system.profile.find().toArray()));
+    assert(entry.hasOwnProperty("writeConcernSyncMicros"), tojson(entry));
+    assert(entry.hasOwnProperty("writeConcernReplicationMicros"), tojson(entry));
+    assert.gt(entry.writeConcernReplicationMicros, 0, tojson(entry));
+
+    // Writes which do not wait for replication do not report it.
+    assert.commandWorked(primaryDB.runCommand(
+        {insert: "foo", documents: [{_id: 2}], writeConcern: {w: 1}, comment: "noWait"}));
+    entry = primaryDB.system.profile.findOne({"command.comment": "noWait"});
+    assert.neq(null, entry, tojson(primaryDB.system.profile.find().toArray()));
+    assert(!entry.hasOwnProperty("writeConcernReplicationMicros"), tojson(entry));
+
+    assert.commandWorked(primaryDB.runCommand({profile: 0}));
+    rst.stopSet();
+})();
@@ -27,9 +27,9 @@
  *    then also delete it in the license file.
  */
 
+#include <boost/container/small_vector.hpp>
 #include <cstring>
 #include <limits>
-#include <vector>
 
 #include "mongo/base/data_view.h"
 #include "mongo/bson/bson_depth.h"
@@ -308,8 +308,9 @@ Status validateElementInfo(Buffer* buffer,
 }
 
 Status validateBSONIterative(Buffer* buffer) {
-    std::vector<ValidationObjectFrame> frames;
-    frames.reserve(16);
+    // Documents are rarely nested deeply, so keep the frames for the common case on the stack
+    // rather than allocating them for every document validated.
+    boost::container::small_vector<ValidationObjectFrame, 32> frames;
     ValidationObjectFrame* curr = NULL;
     ValidationState::State state = ValidationState::BeginObj;
 
@@ -0,0 +1,89 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/bson/bson_validate.h"
+#include "mongo/bson/bsonobjbuilder.h"
+
+namespace mongo {
+namespace {
+
+BSONObj makeFlatObj(int numFields) {
+    BSONObjBuilder builder;
+    builder.append("_id", OID::gen());
+    for (int i = 0; i < numFields; i++) {
+        builder.append(std::to_string(i), i);
+    }
+    return builder.obj();
+}
+
+BSONObj makeStringObj(int numFields) {
+    BSONObjBuilder builder;
+    builder.append("_id", OID::gen());
+    for (int i = 0; i < numFields; i++) {
+        builder.append(std::to_string(i), "the quick brown fox jumps over the lazy dog");
+    }
+    return builder.obj();
+}
+
+BSONObj makeNestedObj(int depth) {
+    BSONObj obj = BSON("a" << 1);
+    for (int i = 0; i < depth; i++) {
+        obj = BSON("a" << obj << "b" << BSON_ARRAY(i << i));
+    }
+    return obj;
+}
+
+void runValidate(benchmark::State& state, const BSONObj& obj) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(validateBSON(obj.objdata(), obj.objsize(), BSONVersion::kLatest));
+    }
+    state.SetBytesProcessed(state.iterations() * obj.objsize());
+}
+
+void BM_validateFlat(benchmark::State& state) {
+    runValidate(state, makeFlatObj(state.range(0)));
+}
+
+void BM_validateStrings(benchmark::State& state) {
+    runValidate(state, makeStringObj(state.range(0)));
+}
+
+void BM_validateNested(benchmark::State& state) {
+    runValidate(state, makeNestedObj(state.range(0)));
+}
+
+BENCHMARK(BM_validateFlat)->Ranges({{{1}, {10'000}}});
+BENCHMARK(BM_validateStrings)->Ranges({{{1}, {10'000}}});
+BENCHMARK(BM_validateNested)->Ranges({{{1}, {100}}});
+
+}  // namespace
+}  // namespace mongo
@@ -65,8 +65,7 @@ enum {
     ID_RESERVE_SIZE = 64,
     PAT_RESERVE_SIZE = 4096,
     OPT_RESERVE_SIZE = 64,
-    FIELD_RESERVE_SIZE = 4096,
-    STRINGVAL_RESERVE_SIZE = 4096,
+    FIELD_RESERVE_SIZE = 64,
     BINDATA_RESERVE_SIZE = 4096,
     BINDATATYPE_RESERVE_SIZE = 4096,
     NS_RESERVE_SIZE = 64,
@@ -95,7 +94,29 @@ Status JParse::parseError(StringData msg) {
 
 Status JParse::value(StringData fieldName, BSONObjBuilder& builder) {
     MONGO_JSON_DEBUG("fieldName: " << fieldName);
-    if (peekToken(LBRACE)) {
+    // Quoted strings and plain numbers are the most common values, and none of the tokens tried
+    // below can start like one, so dispatch them on their first character.
+    const char* next = _input;
+    while (next < _input_end && isspace(*reinterpret_cast<const unsigned char*>(next))) {
+        ++next;
+    }
+    const bool startsNumber = next < _input_end &&
+        (isdigit(*reinterpret_cast<const unsigned char*>(next)) ||
+         (*next == '-' && next + 1 < _input_end &&
+          isdigit(*reinterpret_cast<const unsigned char*>(next + 1))));
+    if (next < _input_end && (*next == '"' || *next == '\'')) {
+        std::string valueString;
+        Status ret = quotedString(&valueString);
+        if (ret != Status::OK()) {
+            return ret;
+        }
+        builder.append(fieldName, valueString);
+    } else if (startsNumber) {
+        Status ret = number(fieldName, builder);
+        if (ret != Status::OK()) {
+            return ret;
+        }
+    } else if (peekToken(LBRACE)) {
         Status ret = object(fieldName, builder);
         if (ret != Status::OK()) {
             return ret;
@@ -150,14 +171,6 @@ Status JParse::value(StringData fieldName, BSONObjBuilder& builder) {
         if (ret != Status::OK()) {
             return ret;
         }
-    } else if (peekToken(DOUBLEQUOTE) || peekToken(SINGLEQUOTE)) {
-        std::string valueString;
-        valueString.reserve(STRINGVAL_RESERVE_SIZE);
-        Status ret = quotedString(&valueString);
-        if (ret != Status::OK()) {
-            return ret;
-        }
-        builder.append(fieldName, valueString);
     } else if (readToken("true")) {
         builder.append(fieldName, true);
     } else if (readToken("false")) {
@@ -314,9 +327,11 @@ Status JParse::object(StringData fieldName, BSONObjBuilder& builder, bool subObj
         if (valueRet != Status::OK()) {
             return valueRet;
         }
+        // Reuse one buffer for the remaining field names rather than allocating one per field.
+        std::string fieldName;
+        fieldName.reserve(FIELD_RESERVE_SIZE);
         while (readToken(COMMA)) {
-            std::string fieldName;
-            fieldName.reserve(FIELD_RESERVE_SIZE);
+            fieldName.clear();
             Status fieldRet = field(&fieldName);
             if (fieldRet != Status::OK()) {
                 return fieldRet;
@@ -1100,10 +1115,26 @@ Status JParse::chars(std::string* result, const char* terminalSet, const char* a
     if (_input >= _input_end) {
         return parseError("Unexpected end of input");
     }
+    // Most strings have a single terminal character and long runs that need no unescaping.
+    // Compare against the terminal directly and copy such runs in one append.
+    const bool singleTerminal = terminalSet[0] != '\0' && terminalSet[1] == '\0';
+    auto isTerminal = [&](char c) {
+        return singleTerminal ? c == terminalSet[0] : match(c, terminalSet);
+    };
     const char* q = _input;
-    while (q < _input_end && !match(*q, terminalSet)) {
+    while (q < _input_end && !isTerminal(*q)) {
         MONGO_JSON_DEBUG("q: " << q);
-        if (allowedSet != NULL) {
+        if (allowedSet == NULL) {
+            const char* run = q;
+            while (q < _input_end && *q != '\\' && !(0x00 <= *q && *q <= 0x1F) &&
+                   !isTerminal(*q)) {
+                ++q;
+            }
+            result->append(run, q - run);
+            if (q >= _input_end || isTerminal(*q)) {
+                break;
+            }
+        } else {
             if (!match(*q, allowedSet)) {
                 _input = q;
                 return Status::OK();
@@ -1153,10 +1184,7 @@ Status JParse::chars(std::string* result, const char* terminalSet, const char* a
                     }
                     unsigned char first = uassertStatusOK(fromHex(q));
                     unsigned char second = uassertStatusOK(fromHex(q += 2));
-                    const std::string& utf8str = encodeUTF8(first, second);
-                    for (unsigned int i = 0; i < utf8str.size(); i++) {
-                        result->push_back(utf8str[i]);
-                    }
+                    result->append(encodeUTF8(first, second));
                     ++q;
                     break;
                 }
@@ -1196,18 +1224,18 @@ Status JParse::chars(std::string* result, const char* terminalSet, const char* a
 }
 
 std::string JParse::encodeUTF8(unsigned char first, unsigned char second) const {
-    std::ostringstream oss;
+    std::string utf8;
     if (first == 0 && second < 0x80) {
-        oss << second;
+        utf8.push_back(second);
     } else if (first < 0x08) {
-        oss << char(0xc0 | (first << 2 | second >> 6));
-        oss << char(0x80 | (~0xc0 & second));
+        utf8.push_back(char(0xc0 | (first << 2 | second >> 6)));
+        utf8.push_back(char(0x80 | (~0xc0 & second)));
     } else {
-        oss << char(0xe0 | (first >> 4));
-        oss << char(0x80 | (~0xc0 & (first << 2 | second >> 6)));
-        oss << char(0x80 | (~0xc0 & second));
+        utf8.push_back(char(0xe0 | (first >> 4)));
+        utf8.push_back(char(0x80 | (~0xc0 & (first << 2 | second >> 6))));
+        utf8.push_back(char(0x80 | (~0xc0 & second)));
     }
-    return oss.str();
+    return utf8;
 }
 
 inline bool JParse::peekToken(const char* token) {
@@ -2196,6 +2196,7 @@ void Document::Impl::writeChildren(Element::RepIdx repIdx, Builder* builder) con
     // it once with the recursive solution.
 
     const ElementRep& rep = getElementRep(repIdx);
+    const bool isObject = (getType(rep) == mongo::Object);
 
     // OK, need to resolve left if we haven't done that yet.
     Element::RepIdx current = rep.child.left;
@@ -2204,7 +2205,29 @@ void Document::Impl::writeChildren(Element::RepIdx repIdx, Builder* builder) con
 
     // We need to write the element, and then walk rightwards.
     while (current != Element::kInvalidRepIdx) {
-        writeElement(current, builder);
+        if (isObject && hasValue(getElementRep(current))) {
+            // Realized but unmodified siblings, such as those walked past to reach a field
+            // being updated, usually still sit back to back in their original buffer. Copy
+            // such a run with a single append rather than element by element. This is not
+            // possible in arrays, where the builder renumbers each element.
+            const BSONElement runStart = getSerializedElement(getElementRep(current));
+            const char* runEnd = runStart.rawdata() + runStart.size();
+            Element::RepIdx next = getElementRep(current).sibling.right;
+            while (next != Element::kInvalidRepIdx && next != Element::kOpaqueRepIdx) {
+                const ElementRep& nextRep = getElementRep(next);
+                if (!hasValue(nextRep))
+                    break;
+                const BSONElement nextElt = getSerializedElement(nextRep);
+                if (nextElt.rawdata() != runEnd)
+                    break;
+                runEnd += nextElt.size();
+                current = next;
+                next = nextRep.sibling.right;
+            }
+            builder->bb().appendBuf(runStart.rawdata(), runEnd - runStart.rawdata());
+        } else {
+            writeElement(current, builder);
+        }
 
         // If we have an opaque region to the right, and we are not in an array, then we
         // can bulk copy from the end of the element we just wrote to the end of our
@@ -1186,6 +1186,25 @@ TEST(Document, RenameDeserialization) {
     ASSERT_BSONOBJ_EQ(mongo::fromjson(outJson), outObj);
 }
 
+TEST(Document, SerializesRealizedSiblingsAroundModifications) {
+    static const char inJson[] =
+        "{ a : 1, b : 'two', c : { d : 3 }, e : [4, 5], f : 6, g : 7, h : 8 }";
+    mongo::BSONObj inObj = mongo::fromjson(inJson);
+
+    mmb::Document doc(inObj);
+    // Realize every child, then modify, rename, remove and insert around unmodified runs.
+    mmb::Element g = mmb::findFirstChildNamed(doc.root(), "g");
+    ASSERT_TRUE(g.ok());
+    ASSERT_OK(mmb::findFirstChildNamed(doc.root(), "h").setValueInt(80));
+    ASSERT_OK(mmb::findFirstChildNamed(doc.root(), "c").rename("C"));
+    ASSERT_OK(mmb::findFirstChildNamed(doc.root(), "f").remove());
+    ASSERT_OK(g.addSiblingLeft(doc.makeElementInt("x", 9)));
+
+    static const char outJson[] =
+        "{ a : 1, b : 'two', C : { d : 3 }, e : [4, 5], x : 9, g : 7, h : 80 }";
+    ASSERT_BSONOBJ_EQ(mongo::fromjson(outJson), doc.getObject());
+}
+
 TEST(Document, CantRenameRootElement) {
     mmb::Document doc;
     ASSERT_NOT_OK(doc.root().rename("foo"));
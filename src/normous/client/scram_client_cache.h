@@ -31,8 +31,10 @@
 #include <string>
 
 #include "mongo/crypto/mechanism_scram.h"
+#include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/mutex.h"
 #include "mongo/stdx/unordered_map.h"
+#include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/net/hostandport.h"
 
 namespace mongo {
@@ -76,7 +78,74 @@ public:
     scram::Secrets<HashBlock> getCachedSecrets(
         const HostAndPort& target, const scram::Presecrets<HashBlock>& presecrets) const {
         const stdx::lock_guard<stdx::mutex> lock(_hostToSecretsMutex);
+        return _getCachedSecrets(lock, target, presecrets);
+    }
+
+    /**
+     * Records a set of precomputed SCRAMSecrets for the specified
+     * host, along with the presecrets used to generate them.
+     */
+    void setCachedSecrets(HostAndPort target,
+                          scram::Presecrets<HashBlock> presecrets,
+                          scram::Secrets<HashBlock> secrets) {
+        const stdx::lock_guard<stdx::mutex> lock(_hostToSecretsMutex);
+        _setCachedSecrets(lock, std::move(target), std::move(presecrets), std::move(secrets));
+    }
+
+    /**
+     * Returns the SCRAMSecrets for the presecrets, from the cache if they
+     * are recorded there for the specified host, and otherwise by computing
+     * and recording them.
+     *
+     * Threads asking for the same host and presecrets while the secrets are
+     * being computed wait for that computation rather than repeating it, so
+     * a storm of new connections to one host pays for it only once.
+     */
+    scram::Secrets<HashBlock> getOrComputeSecrets(const HostAndPort& target,
+                                                  const scram::Presecrets<HashBlock>& presecrets) {
+        stdx::unique_lock<stdx::mutex> lock(_hostToSecretsMutex);
+        while (true) {
+            auto cachedSecrets = _getCachedSecrets(lock, target, presecrets);
+            if (cachedSecrets) {
+                return cachedSecrets;
+            }
+
+            auto inProgress = _hostsBeingComputed.find(target);
+            if (inProgress == _hostsBeingComputed.end() || !(inProgress->second == presecrets)) {
+                break;
+            }
+            _secretsComputed.wait(lock);
+        }
+
+        // If another computation is in progress for this host with different presecrets, ours
+        // proceeds alongside it without being waited on.
+        const bool registered = _hostsBeingComputed.emplace(target, presecrets).second;
+        const auto finishComputing = [&] {
+            if (registered) {
+                _hostsBeingComputed.erase(target);
+                _secretsComputed.notify_all();
+            }
+        };
 
+        lock.unlock();
+        scram::Secrets<HashBlock> secrets;
+        try {
+            secrets = presecrets;
+        } catch (...) {
+            lock.lock();
+            finishComputing();
+            throw;
+        }
+        lock.lock();
+
+        _setCachedSecrets(lock, target, presecrets, secrets);
+        finishComputing();
+        return secrets;
+    }
+
+private:
+    scram::Secrets<HashBlock> _getCachedSecrets(
+        WithLock, const HostAndPort& target, const scram::Presecrets<HashBlock>& presecrets) const {
         // Search the cache for a record associated with the host we're trying to connect to.
         auto foundSecret = _hostToSecrets.find(target);
         if (foundSecret == _hostToSecrets.end()) {
@@ -94,15 +163,10 @@ public:
         }
     }
 
-    /**
-     * Records a set of precomputed SCRAMSecrets for the specified
-     * host, along with the presecrets used to generate them.
-     */
-    void setCachedSecrets(HostAndPort target,
-                          scram::Presecrets<HashBlock> presecrets,
-                          scram::Secrets<HashBlock> secrets) {
-        const stdx::lock_guard<stdx::mutex> lock(_hostToSecretsMutex);
-
+    void _setCachedSecrets(WithLock,
+                           HostAndPort target,
+                           scram::Presecrets<HashBlock> presecrets,
+                           scram::Secrets<HashBlock> secrets) {
         typename HostToSecretsMap::iterator it;
         bool insertionSuccessful;
         auto cacheRecord = std::make_pair(std::move(presecrets), std::move(secrets));
@@ -115,9 +179,13 @@ public:
         }
     }
 
-private:
     mutable stdx::mutex _hostToSecretsMutex;
     HostToSecretsMap _hostToSecrets;
+
+    // The hosts for which secrets are being computed by getOrComputeSecrets, and the presecrets
+    // they are being computed from. Signaled through _secretsComputed when a computation ends.
+    stdx::unordered_map<HostAndPort, scram::Presecrets<HashBlock>> _hostsBeingComputed;
+    stdx::condition_variable _secretsComputed;
 };
 
 }  // namespace mongo
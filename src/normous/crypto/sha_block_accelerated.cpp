@@ -0,0 +1,332 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/crypto/sha_block_accelerated.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define MONGO_SHA_ACCELERATED_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__linux__) && (defined(__GNUC__) || defined(__clang__))
+#define MONGO_SHA_ACCELERATED_ARM 1
+#include <arm_neon.h>
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+
+namespace mongo {
+namespace sha_accelerated {
+namespace {
+
+#if defined(MONGO_SHA_ACCELERATED_X86) || defined(MONGO_SHA_ACCELERATED_ARM)
+
+const std::uint32_t kSHA1RoundConstants[4] = {0x5A827999, 0x6ED9EBA1, 0x8F1BBCDC, 0xCA62C1D6};
+
+alignas(16) const std::uint32_t kSHA256RoundConstants[64] = {
+    0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1, 0x923F82A4,
+    0xAB1C5ED5, 0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3, 0x72BE5D74, 0x80DEB1FE,
+    0x9BDC06A7, 0xC19BF174, 0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F,
+    0x4A7484AA, 0x5CB0A9DC, 0x76F988DA, 0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7,
+    0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967, 0x27B70A85, 0x2E1B2138, 0x4D2C6DFC,
+    0x53380D13, 0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85, 0xA2BFE8A1, 0xA81A664B,
+    0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070, 0x19A4C116,
+    0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+    0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208, 0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7,
+    0xC67178F2};
+
+#endif
+
+#if defined(MONGO_SHA_ACCELERATED_X86)
+
+/**
+ * The x86 SHA extensions keep message words with the first word in the highest lane.
+ *
+ * Each group of 4 rounds consumes one 128 bit vector of message words. A vector for group g >= 4
+ * is derived from those of groups g - 4 through g - 1, which rotate through 'msg', so msg[g % 4]
+ * holds group g - 4's words until it is replaced with group g's.
+ */
+#define MONGO_SHA_TARGET_X86 __attribute__((target("sha,sse4.1")))
+
+template <int kFunction>
+MONGO_SHA_TARGET_X86 inline __m128i sha1FourRounds(__m128i abcd, __m128i e) {
+    return _mm_sha1rnds4_epu32(abcd, e, kFunction);
+}
+
+MONGO_SHA_TARGET_X86 void sha1CompressX86(std::uint32_t state[5],
+                                          const std::uint8_t* blocks,
+                                          size_t numBlocks) {
+    const __m128i byteSwapMask = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+
+    __m128i abcd =
+        _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0x1B);
+    __m128i e = _mm_set_epi32(state[4], 0, 0, 0);
+
+    for (; numBlocks > 0; --numBlocks, blocks += 64) {
+        const __m128i abcdSave = abcd;
+        const __m128i eSave = e;
+
+        __m128i msg[4];
+        __m128i previousAbcd = abcd;
+        for (int g = 0; g < 20; ++g) {
+            if (g < 4) {
+                msg[g] = _mm_shuffle_epi8(
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks + 16 * g)),
+                    byteSwapMask);
+            } else {
+                msg[g % 4] = _mm_sha1msg2_epu32(
+                    _mm_xor_si128(_mm_sha1msg1_epu32(msg[g % 4], msg[(g + 1) % 4]),
+                                  msg[(g + 2) % 4]),
+                    msg[(g + 3) % 4]);
+            }
+
+            // The first group adds e to its message words. Every later group derives its e from
+            // a, as it was before the previous group's rounds.
+            const __m128i roundInput =
+                g == 0 ? _mm_add_epi32(e, msg[0]) : _mm_sha1nexte_epu32(previousAbcd, msg[g % 4]);
+            previousAbcd = abcd;
+            switch (g / 5) {
+                case 0:
+                    abcd = sha1FourRounds<0>(abcd, roundInput);
+                    break;
+                case 1:
+                    abcd = sha1FourRounds<1>(abcd, roundInput);
+                    break;
+                case 2:
+                    abcd = sha1FourRounds<2>(abcd, roundInput);
+                    break;
+                default:
+                    abcd = sha1FourRounds<3>(abcd, roundInput);
+                    break;
+            }
+        }
+
+        e = _mm_sha1nexte_epu32(previousAbcd, eSave);
+        abcd = _mm_add_epi32(abcd, abcdSave);
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_shuffle_epi32(abcd, 0x1B));
+    state[4] = _mm_extract_epi32(e, 3);
+}
+
+MONGO_SHA_TARGET_X86 void sha256CompressX86(std::uint32_t state[8],
+                                            const std::uint8_t* blocks,
+                                            size_t numBlocks) {
+    const __m128i byteSwapMask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // The SHA-256 instructions work on the state as (a, b, e, f) and (c, d, g, h).
+    __m128i cdab =
+        _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0xB1);
+    __m128i efgh =
+        _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4)), 0x1B);
+    __m128i abef = _mm_alignr_epi8(cdab, efgh, 8);
+    __m128i cdgh = _mm_blend_epi16(efgh, cdab, 0xF0);
+
+    for (; numBlocks > 0; --numBlocks, blocks += 64) {
+        const __m128i abefSave = abef;
+        const __m128i cdghSave = cdgh;
+
+        __m128i msg[4];
+        for (int g = 0; g < 16; ++g) {
+            if (g < 4) {
+                msg[g] = _mm_shuffle_epi8(
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks + 16 * g)),
+                    byteSwapMask);
+            } else {
+                msg[g % 4] = _mm_sha256msg2_epu32(
+                    _mm_add_epi32(_mm_sha256msg1_epu32(msg[g % 4], msg[(g + 1) % 4]),
+                                  _mm_alignr_epi8(msg[(g + 3) % 4], msg[(g + 2) % 4], 4)),
+                    msg[(g + 3) % 4]);
+            }
+
+            const __m128i roundInput = _mm_add_epi32(
+                msg[g % 4],
+                _mm_load_si128(reinterpret_cast<const __m128i*>(kSHA256RoundConstants + 4 * g)));
+            cdgh = _mm_sha256rnds2_epu32(cdgh, abef, roundInput);
+            abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(roundInput, 0x0E));
+        }
+
+        abef = _mm_add_epi32(abef, abefSave);
+        cdgh = _mm_add_epi32(cdgh, cdghSave);
+    }
+
+    const __m128i feba = _mm_shuffle_epi32(abef, 0x1B);
+    const __m128i dchg = _mm_shuffle_epi32(cdgh, 0xB1);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_blend_epi16(feba, dchg, 0xF0));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), _mm_alignr_epi8(dchg, feba, 8));
+}
+
+bool cpuHasSHAExtensions() {
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+    const bool hasSSSE3 = ecx & bit_SSSE3;
+    const bool hasSSE41 = ecx & bit_SSE4_1;
+
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+    const bool hasSHA = ebx & (1U << 29);
+
+    return hasSSSE3 && hasSSE41 && hasSHA;
+}
+
+SHA1CompressFn detectSHA1Compress() {
+    return cpuHasSHAExtensions() ? sha1CompressX86 : nullptr;
+}
+
+SHA256CompressFn detectSHA256Compress() {
+    return cpuHasSHAExtensions() ? sha256CompressX86 : nullptr;
+}
+
+#elif defined(MONGO_SHA_ACCELERATED_ARM)
+
+/**
+ * The ARMv8 cryptography extensions keep message words in memory order, one vector per group of
+ * 4 rounds. A vector for group g >= 4 is derived from those of groups g - 4 through g - 1, which
+ * rotate through 'msg', so msg[g % 4] holds group g - 4's words until it is replaced with group
+ * g's.
+ */
+#define MONGO_SHA_TARGET_ARM __attribute__((target("+crypto")))
+
+MONGO_SHA_TARGET_ARM void sha1CompressARM(std::uint32_t state[5],
+                                          const std::uint8_t* blocks,
+                                          size_t numBlocks) {
+    uint32x4_t abcd = vld1q_u32(state);
+    std::uint32_t e = state[4];
+
+    for (; numBlocks > 0; --numBlocks, blocks += 64) {
+        const uint32x4_t abcdSave = abcd;
+        const std::uint32_t eSave = e;
+
+        uint32x4_t msg[4];
+        for (int g = 0; g < 20; ++g) {
+            if (g < 4) {
+                msg[g] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(blocks + 16 * g)));
+            } else {
+                msg[g % 4] = vsha1su1q_u32(
+                    vsha1su0q_u32(msg[g % 4], msg[(g + 1) % 4], msg[(g + 2) % 4]),
+                    msg[(g + 3) % 4]);
+            }
+
+            const uint32x4_t roundInput =
+                vaddq_u32(msg[g % 4], vdupq_n_u32(kSHA1RoundConstants[g / 5]));
+            const std::uint32_t nextE = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+            switch (g / 5) {
+                case 0:
+                    abcd = vsha1cq_u32(abcd, e, roundInput);
+                    break;
+                case 2:
+                    abcd = vsha1mq_u32(abcd, e, roundInput);
+                    break;
+                default:
+                    abcd = vsha1pq_u32(abcd, e, roundInput);
+                    break;
+            }
+            e = nextE;
+        }
+
+        abcd = vaddq_u32(abcd, abcdSave);
+        e += eSave;
+    }
+
+    vst1q_u32(state, abcd);
+    state[4] = e;
+}
+
+MONGO_SHA_TARGET_ARM void sha256CompressARM(std::uint32_t state[8],
+                                            const std::uint8_t* blocks,
+                                            size_t numBlocks) {
+    uint32x4_t abcd = vld1q_u32(state);
+    uint32x4_t efgh = vld1q_u32(state + 4);
+
+    for (; numBlocks > 0; --numBlocks, blocks += 64) {
+        const uint32x4_t abcdSave = abcd;
+        const uint32x4_t efghSave = efgh;
+
+        uint32x4_t msg[4];
+        for (int g = 0; g < 16; ++g) {
+            if (g < 4) {
+                msg[g] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(blocks + 16 * g)));
+            } else {
+                msg[g % 4] = vsha256su1q_u32(vsha256su0q_u32(msg[g % 4], msg[(g + 1) % 4]),
+                                             msg[(g + 2) % 4],
+                                             msg[(g + 3) % 4]);
+            }
+
+            const uint32x4_t roundInput =
+                vaddq_u32(msg[g % 4], vld1q_u32(kSHA256RoundConstants + 4 * g));
+            const uint32x4_t previousAbcd = abcd;
+            abcd = vsha256hq_u32(abcd, efgh, roundInput);
+            efgh = vsha256h2q_u32(efgh, previousAbcd, roundInput);
+        }
+
+        abcd = vaddq_u32(abcd, abcdSave);
+        efgh = vaddq_u32(efgh, efghSave);
+    }
+
+    vst1q_u32(state, abcd);
+    vst1q_u32(state + 4, efgh);
+}
+
+SHA1CompressFn detectSHA1Compress() {
+    return (getauxval(AT_HWCAP) & HWCAP_SHA1) ? sha1CompressARM : nullptr;
+}
+
+SHA256CompressFn detectSHA256Compress() {
+    return (getauxval(AT_HWCAP) & HWCAP_SHA2) ? sha256CompressARM : nullptr;
+}
+
+#else
+
+SHA1CompressFn detectSHA1Compress() {
+    return nullptr;
+}
+
+SHA256CompressFn detectSHA256Compress() {
+    return nullptr;
+}
+
+#endif
+
+}  // namespace
+
+SHA1CompressFn getSHA1Compress() {
+    static const SHA1CompressFn compress = detectSHA1Compress();
+    return compress;
+}
+
+SHA256CompressFn getSHA256Compress() {
+    static const SHA256CompressFn compress = detectSHA256Compress();
+    return compress;
+}
+
+}  // namespace sha_accelerated
+}  // namespace mongo
@@ -0,0 +1,59 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mongo {
+namespace sha_accelerated {
+
+/**
+ * Compression functions that run the SHA-1 or SHA-256 block transform on 'numBlocks' consecutive
+ * 64 byte blocks of 'blocks', updating 'state' in place. 'state' holds the hash's working
+ * variables in their natural order (a, b, c, ...), exactly as a portable implementation keeps
+ * them, so the two can be used interchangeably on the same hash state.
+ */
+using SHA1CompressFn = void (*)(std::uint32_t state[5],
+                                const std::uint8_t* blocks,
+                                size_t numBlocks);
+using SHA256CompressFn = void (*)(std::uint32_t state[8],
+                                  const std::uint8_t* blocks,
+                                  size_t numBlocks);
+
+/**
+ * Returns a compression function using the CPU's SHA instructions (the SHA extensions on x86-64,
+ * the cryptography extensions on ARMv8), or nullptr if this CPU or build does not have them.
+ * Detection happens once, on first call.
+ */
+SHA1CompressFn getSHA1Compress();
+SHA256CompressFn getSHA256Compress();
+
+}  // namespace sha_accelerated
+}  // namespace mongo
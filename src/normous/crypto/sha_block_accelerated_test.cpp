@@ -0,0 +1,121 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <vector>
+
+#include "mongo/crypto/sha1_block.h"
+#include "mongo/crypto/sha256_block.h"
+#include "mongo/crypto/sha_block_accelerated.h"
+#include "mongo/unittest/unittest.h"
+
+#include "tomcrypt.h"
+
+namespace mongo {
+namespace {
+
+std::vector<unsigned char> makeMessage(size_t length) {
+    std::vector<unsigned char> message(length);
+    for (size_t i = 0; i < length; ++i) {
+        message[i] = static_cast<unsigned char>(i * 131 + 7);
+    }
+    return message;
+}
+
+template <typename HashType>
+HashType portableHash(int (*init)(hash_state*),
+                      int (*process)(hash_state*, const unsigned char*, unsigned long),
+                      int (*done)(hash_state*, unsigned char*),
+                      const std::vector<unsigned char>& message) {
+    HashType output;
+    hash_state state;
+    ASSERT_EQ(CRYPT_OK, init(&state));
+    ASSERT_EQ(CRYPT_OK, process(&state, message.data(), message.size()));
+    ASSERT_EQ(CRYPT_OK, done(&state, output.data()));
+    return output;
+}
+
+// Hashes every length up to several blocks, in two parts split at a range of points so that the
+// block buffering and final padding are exercised at every offset within a block.
+TEST(SHABlockAccelerated, SHA1MatchesPortableImplementation) {
+    for (size_t length = 0; length < 300; ++length) {
+        const auto message = makeMessage(length);
+        const auto expected =
+            portableHash<SHA1Block::HashType>(sha1_init, sha1_process, sha1_done, message);
+        const char* data = reinterpret_cast<const char*>(message.data());
+        for (size_t split = 0; split <= length; split += 13) {
+            const auto hash = SHA1Block::computeHash(
+                {ConstDataRange(data, split), ConstDataRange(data + split, length - split)});
+            ASSERT_TRUE(hash == SHA1Block(expected)) << "length " << length << " split " << split;
+        }
+    }
+}
+
+TEST(SHABlockAccelerated, SHA256MatchesPortableImplementation) {
+    for (size_t length = 0; length < 300; ++length) {
+        const auto message = makeMessage(length);
+        const auto expected =
+            portableHash<SHA256Block::HashType>(sha256_init, sha256_process, sha256_done, message);
+        const char* data = reinterpret_cast<const char*>(message.data());
+        for (size_t split = 0; split <= length; split += 13) {
+            const auto hash = SHA256Block::computeHash(
+                {ConstDataRange(data, split), ConstDataRange(data + split, length - split)});
+            ASSERT_TRUE(hash == SHA256Block(expected)) << "length " << length << " split " << split;
+        }
+    }
+}
+
+TEST(SHABlockAccelerated, CompressFunctionsMatchPortableBlockTransform) {
+    const auto message = makeMessage(64 * 5);
+
+    if (auto compress = sha_accelerated::getSHA1Compress()) {
+        hash_state portable;
+        sha1_init(&portable);
+        hash_state accelerated = portable;
+        ASSERT_EQ(CRYPT_OK, sha1_process(&portable, message.data(), message.size()));
+        compress(accelerated.sha1.state, message.data(), message.size() / 64);
+        for (size_t i = 0; i < 5; ++i) {
+            ASSERT_EQ(portable.sha1.state[i], accelerated.sha1.state[i]);
+        }
+    }
+
+    if (auto compress = sha_accelerated::getSHA256Compress()) {
+        hash_state portable;
+        sha256_init(&portable);
+        hash_state accelerated = portable;
+        ASSERT_EQ(CRYPT_OK, sha256_process(&portable, message.data(), message.size()));
+        compress(accelerated.sha256.state, message.data(), message.size() / 64);
+        for (size_t i = 0; i < 8; ++i) {
+            ASSERT_EQ(portable.sha256.state[i], accelerated.sha256.state[i]);
+        }
+    }
+}
+
+}  // namespace
+}  // namespace mongo
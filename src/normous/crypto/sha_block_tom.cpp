@@ -31,7 +31,10 @@
 #include "mongo/crypto/sha1_block.h"
 #include "mongo/crypto/sha256_block.h"
 
+#include "mongo/base/data_type_endian.h"
+#include "mongo/base/data_view.h"
 #include "mongo/config.h"
+#include "mongo/crypto/sha_block_accelerated.h"
 #include "mongo/util/assert_util.h"
 
 #ifdef MONGO_CONFIG_SSL
@@ -44,27 +47,149 @@ namespace mongo {
 
 namespace {
 
+constexpr size_t kSHABlockSize = 64;
+
+/**
+ * Replacements for tomcrypt's SHA process and done functions, which hand whole blocks to a
+ * compression function using the CPU's SHA instructions. They keep the hash state exactly as
+ * tomcrypt's own functions do, differing only in that runs of consecutive blocks are compressed
+ * in one call straight from the caller's buffer.
+ */
+template <typename StateType, StateType hash_state::*kState>
+struct AcceleratedSHA {
+    static constexpr size_t kStateWords = sizeof(StateType::state) / sizeof(StateType::state[0]);
+
+    static int process(hash_state* md, const unsigned char* in, unsigned long inlen) {
+        StateType& st = md->*kState;
+        if (st.curlen > sizeof(st.buf)) {
+            return CRYPT_INVALID_ARG;
+        }
+        if ((st.length + inlen) < st.length) {
+            return CRYPT_HASH_OVERFLOW;
+        }
+
+        if (st.curlen > 0) {
+            const unsigned long n = std::min<unsigned long>(inlen, kSHABlockSize - st.curlen);
+            memcpy(st.buf + st.curlen, in, n);
+            st.curlen += n;
+            in += n;
+            inlen -= n;
+            if (st.curlen < kSHABlockSize) {
+                return CRYPT_OK;
+            }
+            compress(st, st.buf, 1);
+            st.length += kSHABlockSize * 8;
+            st.curlen = 0;
+        }
+
+        const size_t numBlocks = inlen / kSHABlockSize;
+        if (numBlocks > 0) {
+            compress(st, in, numBlocks);
+            st.length += numBlocks * kSHABlockSize * 8;
+            in += numBlocks * kSHABlockSize;
+            inlen -= numBlocks * kSHABlockSize;
+        }
+
+        memcpy(st.buf, in, inlen);
+        st.curlen = inlen;
+        return CRYPT_OK;
+    }
+
+    static int done(hash_state* md, unsigned char* out) {
+        StateType& st = md->*kState;
+        if (st.curlen >= sizeof(st.buf)) {
+            return CRYPT_INVALID_ARG;
+        }
+
+        st.length += st.curlen * 8;
+        st.buf[st.curlen++] = 0x80;
+
+        // The message length takes the last 8 bytes of the final block, which may have to be a
+        // block of its own.
+        if (st.curlen > kSHABlockSize - 8) {
+            memset(st.buf + st.curlen, 0, kSHABlockSize - st.curlen);
+            compress(st, st.buf, 1);
+            st.curlen = 0;
+        }
+        memset(st.buf + st.curlen, 0, kSHABlockSize - 8 - st.curlen);
+        DataView(reinterpret_cast<char*>(st.buf))
+            .write<BigEndian<uint64_t>>(st.length, kSHABlockSize - 8);
+        compress(st, st.buf, 1);
+
+        for (size_t i = 0; i < kStateWords; ++i) {
+            DataView(reinterpret_cast<char*>(out)).write<BigEndian<uint32_t>>(st.state[i], 4 * i);
+        }
+        return CRYPT_OK;
+    }
+
+private:
+    static void compress(StateType& st, const unsigned char* blocks, size_t numBlocks);
+};
+
+template <>
+void AcceleratedSHA<sha1_state, &hash_state::sha1>::compress(sha1_state& st,
+                                                              const unsigned char* blocks,
+                                                              size_t numBlocks) {
+    sha_accelerated::getSHA1Compress()(st.state, blocks, numBlocks);
+}
+
+template <>
+void AcceleratedSHA<sha256_state, &hash_state::sha256>::compress(sha256_state& st,
+                                                                  const unsigned char* blocks,
+                                                                  size_t numBlocks) {
+    sha_accelerated::getSHA256Compress()(st.state, blocks, numBlocks);
+}
+
+/**
+ * Returns tomcrypt's descriptor for SHA-1, or SHA-256, with its process and done functions
+ * replaced by accelerated ones when this CPU has SHA instructions.
+ */
+const ltc_hash_descriptor* sha1Descriptor() {
+    using Accelerated = AcceleratedSHA<sha1_state, &hash_state::sha1>;
+    static const ltc_hash_descriptor desc = [] {
+        ltc_hash_descriptor desc = sha1_desc;
+        if (sha_accelerated::getSHA1Compress()) {
+            desc.process = Accelerated::process;
+            desc.done = Accelerated::done;
+        }
+        return desc;
+    }();
+    return &desc;
+}
+
+const ltc_hash_descriptor* sha256Descriptor() {
+    using Accelerated = AcceleratedSHA<sha256_state, &hash_state::sha256>;
+    static const ltc_hash_descriptor desc = [] {
+        ltc_hash_descriptor desc = sha256_desc;
+        if (sha_accelerated::getSHA256Compress()) {
+            desc.process = Accelerated::process;
+            desc.done = Accelerated::done;
+        }
+        return desc;
+    }();
+    return &desc;
+}
+
 /**
  * Computes a SHA hash of 'input'.
  */
-template <typename HashType,
-          int (*Init)(hash_state*),
-          int (*Process)(hash_state*, const unsigned char*, unsigned long),
-          int (*Done)(hash_state*, unsigned char*)>
-HashType computeHashImpl(std::initializer_list<ConstDataRange> input) {
+template <typename HashType>
+HashType computeHashImpl(const ltc_hash_descriptor* desc,
+                         std::initializer_list<ConstDataRange> input) {
     HashType output;
 
     hash_state hashState;
     fassert(40381,
-            Init(&hashState) == CRYPT_OK &&
+            desc->init(&hashState) == CRYPT_OK &&
                 std::all_of(begin(input),
                             end(input),
                             [&](const auto& i) {
-                                return Process(&hashState,
-                                               reinterpret_cast<const unsigned char*>(i.data()),
-                                               i.length()) == CRYPT_OK;
+                                return desc->process(
+                                           &hashState,
+                                           reinterpret_cast<const unsigned char*>(i.data()),
+                                           i.length()) == CRYPT_OK;
                             }) &&
-                Done(&hashState, output.data()) == CRYPT_OK);
+                desc->done(&hashState, output.data()) == CRYPT_OK);
     return output;
 }
 
@@ -99,13 +224,12 @@ void computeHmacImpl(const ltc_hash_descriptor* desc,
 
 SHA1BlockTraits::HashType SHA1BlockTraits::computeHash(
     std::initializer_list<ConstDataRange> input) {
-    return computeHashImpl<SHA1BlockTraits::HashType, sha1_init, sha1_process, sha1_done>(input);
+    return computeHashImpl<SHA1BlockTraits::HashType>(sha1Descriptor(), input);
 }
 
 SHA256BlockTraits::HashType SHA256BlockTraits::computeHash(
     std::initializer_list<ConstDataRange> input) {
-    return computeHashImpl<SHA256BlockTraits::HashType, sha256_init, sha256_process, sha256_done>(
-        input);
+    return computeHashImpl<SHA256BlockTraits::HashType>(sha256Descriptor(), input);
 }
 
 void SHA1BlockTraits::computeHmac(const uint8_t* key,
@@ -113,7 +237,7 @@ void SHA1BlockTraits::computeHmac(const uint8_t* key,
                                   const uint8_t* input,
                                   size_t inputLen,
                                   HashType* const output) {
-    return computeHmacImpl<HashType>(&sha1_desc, key, keyLen, input, inputLen, output);
+    return computeHmacImpl<HashType>(sha1Descriptor(), key, keyLen, input, inputLen, output);
 }
 
 void SHA256BlockTraits::computeHmac(const uint8_t* key,
@@ -121,7 +245,7 @@ void SHA256BlockTraits::computeHmac(const uint8_t* key,
                                     const uint8_t* input,
                                     size_t inputLen,
                                     HashType* const output) {
-    return computeHmacImpl<HashType>(&sha256_desc, key, keyLen, input, inputLen, output);
+    return computeHmacImpl<HashType>(sha256Descriptor(), key, keyLen, input, inputLen, output);
 }
 
 }  // namespace mongo
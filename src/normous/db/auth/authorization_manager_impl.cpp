@@ -273,18 +273,24 @@ public:
         if (!_lock.owns_lock()) {
             _lock.lock();
         }
-        if (_isThisGuardInFetchPhase) {
-            fassert(17190, _authzManager->_isFetchPhaseBusy);
-            _authzManager->_isFetchPhaseBusy = false;
+        if (_fetchingUser) {
+            fassert(17190, _authzManager->_usersInFetchPhase.erase(*_fetchingUser) == 1U);
             _authzManager->_fetchPhaseIsReady.notify_all();
         }
     }
 
     /**
-     * Returns true of the authzManager reports that it is in fetch phase.
+     * Returns true if the authzManager reports that any update is in fetch phase.
      */
     bool otherUpdateInFetchPhase() const {
-        return _authzManager->_isFetchPhaseBusy;
+        return !_authzManager->_usersInFetchPhase.empty();
+    }
+
+    /**
+     * Returns true if the authzManager reports that an update of 'userName' is in fetch phase.
+     */
+    bool otherUpdateInFetchPhase(const UserName& userName) const {
+        return _authzManager->_usersInFetchPhase.count(userName) > 0;
     }
 
     /**
@@ -296,22 +302,24 @@ public:
     }
 
     /**
-     * Enters fetch phase, releasing the _authzManager->_cacheMutex after recording the current
-     * cache generation.
+     * Enters fetch phase for 'userName', releasing the _authzManager->_cacheMutex after recording
+     * the current cache generation. Other guards may fetch other users in the meantime.
      */
-    void beginFetchPhase() {
-        beginFetchPhaseNoYield();
+    void beginFetchPhase(const UserName& userName) {
+        fassert(17191, !otherUpdateInFetchPhase(userName));
+        _enterFetchPhase();
+        _authzManager->_usersInFetchPhase.insert(userName);
+        _fetchingUser = userName;
         _lock.unlock();
     }
 
     /**
-     * Sets up the fetch phase without releasing _authzManager->_cacheMutex
+     * Sets up the fetch phase without releasing _authzManager->_cacheMutex, so no other guard can
+     * enter fetch phase until this one is destroyed.
      */
     void beginFetchPhaseNoYield() {
-        fassert(17191, !_authzManager->_isFetchPhaseBusy);
-        _isThisGuardInFetchPhase = true;
-        _authzManager->_isFetchPhaseBusy = true;
-        _startGeneration = _authzManager->_fetchGeneration;
+        fassert(50982, !otherUpdateInFetchPhase());
+        _enterFetchPhase();
     }
 
     /**
@@ -320,7 +328,7 @@ public:
     void endFetchPhase() {
         if (!_lock.owns_lock())
             _lock.lock();
-        // We do not clear _authzManager->_isFetchPhaseBusy or notify waiters until
+        // We do not clear _authzManager->_usersInFetchPhase or notify waiters until
         // ~CacheGuard(), for two reasons.  First, there's no value to notifying the waiters
         // before you're ready to release the mutex, because they'll just go to sleep on the
         // mutex.  Second, in order to meaningfully check the preconditions of
@@ -342,8 +350,15 @@ public:
     }
 
 private:
+    void _enterFetchPhase() {
+        fassert(50983, !_isThisGuardInFetchPhase);
+        _isThisGuardInFetchPhase = true;
+        _startGeneration = _authzManager->_fetchGeneration;
+    }
+
     OID _startGeneration;
     bool _isThisGuardInFetchPhase;
+    boost::optional<UserName> _fetchingUser;
     AuthorizationManagerImpl* _authzManager;
     std::unique_ptr<AuthzManagerExternalState::StateLock> _stateLock;
     stdx::unique_lock<stdx::mutex> _lock;
@@ -360,8 +375,7 @@ AuthorizationManagerImpl::AuthorizationManagerImpl(
       _externalState(std::move(externalState)),
       _version(schemaVersionInvalid),
       _userCache(authorizationManagerCacheSize, UserCacheInvalidator()),
-      _fetchGeneration(OID::gen()),
-      _isFetchPhaseBusy(false) {}
+      _fetchGeneration(OID::gen()) {}
 
 AuthorizationManagerImpl::~AuthorizationManagerImpl() {}
 
@@ -385,7 +399,9 @@ Status AuthorizationManagerImpl::getAuthorizationVersion(OperationContext* opCtx
     if (schemaVersionInvalid == newVersion) {
         while (guard.otherUpdateInFetchPhase())
             guard.wait();
-        guard.beginFetchPhase();
+        // Reading the schema version is a single small read, so hold on to the mutex through it
+        // rather than letting user fetches proceed against a version that is about to change.
+        guard.beginFetchPhaseNoYield();
         Status status = _externalState->getStoredAuthorizationVersion(opCtx, &newVersion);
         guard.endFetchPhase();
         if (!status.isOK()) {
@@ -537,8 +553,8 @@ StatusWith<UserHandle> AuthorizationManagerImpl::acquireUser(OperationContext* o
         return returnUser(cachedUser);
     }
 
-    // Otherwise make sure we have the locks we need and check whether and wait on another
-    // thread is fetching into the cache
+    // Otherwise make sure we have the locks we need and check whether another thread is
+    // fetching this user into the cache, and if so wait for it rather than fetching it again.
     CacheGuard guard(opCtx, this);
 
     auto pinnedIt =
@@ -550,7 +566,7 @@ StatusWith<UserHandle> AuthorizationManagerImpl::acquireUser(OperationContext* o
     }
 
     while ((boost::none == (cachedUser = _userCache.get(userName))) &&
-           guard.otherUpdateInFetchPhase()) {
+           guard.otherUpdateInFetchPhase(userName)) {
         guard.wait();
     }
 
@@ -558,22 +574,20 @@ StatusWith<UserHandle> AuthorizationManagerImpl::acquireUser(OperationContext* o
         return returnUser(cachedUser);
     }
 
-    guard.beginFetchPhase();
+    guard.beginFetchPhase(userName);
     // If there's still no user in the cache, then we need to go to disk. Take the slow path.
     LOG(1) << "Getting user " << userName << " from disk";
     auto ret = _acquireUserSlowPath(guard, opCtx, userName);
 
+    // Fetching a user does not invalidate anything, so unlike invalidation it leaves the cache
+    // generation alone; otherwise it would keep concurrent fetches of other users from caching
+    // their results.
     guard.endFetchPhase();
     if (!ret.isOK()) {
         return ret.getStatus();
     }
 
-    auto user = std::move(ret.getValue());
-    if (user->isValid()) {
-        _updateCacheGeneration_inlock(guard);
-    }
-
-    return user;
+    return std::move(ret.getValue());
 }
 
 StatusWith<UserHandle> AuthorizationManagerImpl::_acquireUserSlowPath(CacheGuard& guard,
@@ -52,6 +52,7 @@
 #include "mongo/stdx/functional.h"
 #include "mongo/stdx/mutex.h"
 #include "mongo/stdx/unordered_map.h"
+#include "mongo/stdx/unordered_set.h"
 #include "mongo/util/invalidating_lru_cache.h"
 
 namespace mongo {
@@ -232,7 +233,7 @@ private:
     std::vector<UserHandle> _pinnedUsers;
 
     /**
-     * Protects _cacheGeneration, _version and _isFetchPhaseBusy.  Manipulated
+     * Protects _cacheGeneration, _version and _usersInFetchPhase.  Manipulated
      * via CacheGuard.
      */
     stdx::mutex _cacheWriteMutex;
@@ -244,15 +245,17 @@ private:
     OID _fetchGeneration;
 
     /**
-     * True if there is an update to the _userCache in progress, and that update is currently in
-     * the "fetch phase", during which it does not hold the _cacheMutex.
+     * The users for which an update to the _userCache is in progress, and that update is currently
+     * in the "fetch phase", during which it does not hold the _cacheWriteMutex. Different users
+     * are fetched concurrently, but there is at most one fetch in progress per user: a thread
+     * needing a user that is being fetched waits for that fetch instead of starting another.
      *
      * Manipulated via CacheGuard.
      */
-    bool _isFetchPhaseBusy;
+    stdx::unordered_set<UserName> _usersInFetchPhase;
 
     /**
-     * Condition used to signal that it is OK for another CacheGuard to enter a fetch phase.
+     * Condition used to signal that a CacheGuard has left its fetch phase.
      * Manipulated via CacheGuard.
      */
     stdx::condition_variable _fetchPhaseIsReady;
@@ -175,6 +175,37 @@ TEST_F(AuthorizationManagerTest, testAcquireV2User) {
     // Make sure user's refCount is 0 at the end of the test to avoid an assertion failure
 }
 
+TEST_F(AuthorizationManagerTest, FetchingUserDoesNotChangeCacheGeneration) {
+    ASSERT_OK(externalState->insertPrivilegeDocument(opCtx.get(),
+                                                     BSON("_id"
+                                                          << "admin.v2read"
+                                                          << "user"
+                                                          << "v2read"
+                                                          << "db"
+                                                          << "test"
+                                                          << "credentials"
+                                                          << credentials
+                                                          << "roles"
+                                                          << BSON_ARRAY(BSON("role"
+                                                                             << "read"
+                                                                             << "db"
+                                                                             << "test"))),
+                                                     BSONObj()));
+
+    // Only invalidation moves the generation, so a fetch of one user does not keep concurrent
+    // fetches of other users from caching what they fetched.
+    const auto initialCacheGen = authzManager->getCacheGeneration();
+    {
+        auto swu = authzManager->acquireUser(opCtx.get(), UserName("v2read", "test"));
+        ASSERT_OK(swu.getStatus());
+        ASSERT(swu.getValue()->isValid());
+    }
+    ASSERT_EQ(initialCacheGen, authzManager->getCacheGeneration());
+
+    authzManager->invalidateUserByName(opCtx.get(), UserName("v2read", "test"));
+    ASSERT_NE(initialCacheGen, authzManager->getCacheGeneration());
+}
+
 #ifdef MONGO_CONFIG_SSL
 TEST_F(AuthorizationManagerTest, testLocalX509Authorization) {
     setX509PeerInfo(
@@ -655,5 +655,33 @@ TEST(SCRAMCache, testSetAndReset) {
     testSetAndReset<SHA256Block>();
 }
 
+template <typename HashBlock>
+void testGetOrComputeRecordsSecrets() {
+    SCRAMClientCache<HashBlock> cache;
+    const auto salt = scram::Presecrets<HashBlock>::generateSecureRandomSalt();
+    HostAndPort host("localhost:27017");
+
+    const auto presecrets = scram::Presecrets<HashBlock>("aaa", salt, 10000);
+    const auto computedSecrets = cache.getOrComputeSecrets(host, presecrets);
+    ASSERT_TRUE(computedSecrets);
+
+    const auto expectedSecrets = scram::Secrets<HashBlock>(presecrets);
+    ASSERT_TRUE(expectedSecrets.clientKey() == computedSecrets.clientKey());
+    ASSERT_TRUE(expectedSecrets.serverKey() == computedSecrets.serverKey());
+    ASSERT_TRUE(expectedSecrets.storedKey() == computedSecrets.storedKey());
+
+    // The computed secrets were recorded, and are returned again without recomputing them.
+    const auto cachedSecrets = cache.getCachedSecrets(host, presecrets);
+    ASSERT_TRUE(cachedSecrets);
+    ASSERT_TRUE(computedSecrets.clientKey() == cachedSecrets.clientKey());
+    ASSERT_TRUE(computedSecrets.clientKey() ==
+                cache.getOrComputeSecrets(host, presecrets).clientKey());
+}
+
+TEST(SCRAMCache, testGetOrComputeRecordsSecrets) {
+    testGetOrComputeRecordsSecrets<SHA1Block>();
+    testGetOrComputeRecordsSecrets<SHA256Block>();
+}
+
 }  // namespace
 }  // namespace mongo
@@ -107,6 +107,30 @@ StatusWith<OID> getCurrentCacheGeneration(OperationContext* opCtx) {
     }
 }
 
+/**
+ * Invalidates the user cache, then fetches the users that were in use at the time again. The
+ * sessions authenticated as those users will need them on their next command, so refreshing them
+ * here keeps every such session from having to fetch them itself.
+ */
+void invalidateAndRefreshUserCache(OperationContext* opCtx, AuthorizationManager* authzManager) {
+    std::vector<UserName> activeUsers;
+    for (const auto& userInfo : authzManager->getUserCacheInfo()) {
+        if (userInfo.active) {
+            activeUsers.push_back(userInfo.userName);
+        }
+    }
+
+    authzManager->invalidateUserCache(opCtx);
+
+    for (const auto& userName : activeUsers) {
+        auto swUser = authzManager->acquireUser(opCtx, userName);
+        if (!swUser.isOK()) {
+            LOG(1) << "Unable to refresh user " << userName
+                   << " after invalidating the user cache: " << swUser.getStatus();
+        }
+    }
+}
+
 }  // namespace
 
 UserCacheInvalidator::UserCacheInvalidator(AuthorizationManager* authzManager)
@@ -173,7 +197,7 @@ void UserCacheInvalidator::run() {
             }
             // When in doubt, invalidate the cache
             try {
-                _authzManager->invalidateUserCache(opCtx.get());
+                invalidateAndRefreshUserCache(opCtx.get(), _authzManager);
             } catch (const DBException& e) {
                 warning() << "Error invalidating user cache: " << e.toStatus();
             }
@@ -184,7 +208,7 @@ void UserCacheInvalidator::run() {
             log() << "User cache generation changed from " << _previousCacheGeneration << " to "
                   << currentGeneration.getValue() << "; invalidating user cache";
             try {
-                _authzManager->invalidateUserCache(opCtx.get());
+                invalidateAndRefreshUserCache(opCtx.get(), _authzManager);
             } catch (const DBException& e) {
                 warning() << "Error invalidating user cache: " << e.toStatus();
             }
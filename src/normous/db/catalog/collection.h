@@ -31,6 +31,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "mongo/base/shim.h"
 #include "mongo/base/status.h"
@@ -60,6 +61,7 @@
 
 namespace mongo {
 class CollectionCatalogEntry;
+class CollectionDocumentCache;
 class DatabaseCatalogEntry;
 class ExtentManager;
 class IndexCatalog;
@@ -120,6 +122,10 @@ struct CollectionUpdateArgs {
     bool fromMigrate = false;
 
     StoreDocOption storeDocOption = StoreDocOption::None;
+
+    // The modified paths which may be indexed, or nullptr if they are not known. When known, only
+    // the indexes on one of these paths are given new keys.
+    const std::vector<FieldRef>* modifiedIndexedPaths = nullptr;
 };
 
 /**
@@ -323,6 +329,8 @@ public:
 
         virtual std::shared_ptr<CappedInsertNotifier> getCappedInsertNotifier() const = 0;
 
+        virtual CollectionDocumentCache* getDocumentCache() const = 0;
+
         virtual uint64_t numRecords(OperationContext* opCtx) const = 0;
 
         virtual uint64_t dataSize(OperationContext* opCtx) const = 0;
@@ -674,6 +682,14 @@ public:
         return this->_impl().getCappedInsertNotifier();
     }
 
+    /**
+     * Returns the cache of recently read documents which IDHACK plans consult, or nullptr if
+     * documents of this collection are not cached.
+     */
+    inline CollectionDocumentCache* getDocumentCache() const {
+        return this->_impl().getDocumentCache();
+    }
+
     inline uint64_t numRecords(OperationContext* const opCtx) const {
         return this->_impl().numRecords(opCtx);
     }
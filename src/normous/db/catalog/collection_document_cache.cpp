@@ -0,0 +1,142 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/catalog/collection_document_cache.h"
+
+#include "mongo/bson/ordering.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/storage/key_string.h"
+#include "mongo/db/storage/recovery_unit.h"
+
+namespace mongo {
+
+constexpr int CollectionDocumentCache::kMaxCachedDocumentBytes;
+
+/**
+ * Ends a write announced by notifyOfWrite() once it commits or rolls back. Holds a reference to
+ * the cache, since the collection may be dropped before the write unit of work ends.
+ */
+class CollectionDocumentCache::WriteChange final : public RecoveryUnit::Change {
+public:
+    WriteChange(std::shared_ptr<CollectionDocumentCache> cache, std::string key)
+        : _cache(std::move(cache)), _key(std::move(key)) {}
+
+    void commit(boost::optional<Timestamp>) final {
+        _cache->_endWrite(_key);
+    }
+
+    void rollback() final {
+        _cache->_endWrite(_key);
+    }
+
+private:
+    const std::shared_ptr<CollectionDocumentCache> _cache;
+    const std::string _key;
+};
+
+CollectionDocumentCache::CollectionDocumentCache(size_t maxEntries) : _documents(maxEntries) {}
+
+void CollectionDocumentCache::notifyOfWrite(OperationContext* opCtx, const BSONElement& id) {
+    auto key = _makeKey(id);
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        ++_writesInProgress[key];
+        _documents.erase(key);
+        ++_generation;
+    }
+    opCtx->recoveryUnit()->registerChange(new WriteChange(shared_from_this(), std::move(key)));
+}
+
+void CollectionDocumentCache::invalidate() {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _documents.clear();
+    ++_generation;
+}
+
+unsigned long long CollectionDocumentCache::getGeneration() const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return _generation;
+}
+
+boost::optional<CollectionDocumentCache::CachedDocument> CollectionDocumentCache::get(
+    const BSONObj& idKey) const {
+    const auto key = _makeKey(idKey.firstElement());
+
+    // Documents with a write in progress are never present, so there is no need to check for one.
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    auto it = _documents.find(key);
+    if (it == _documents.end()) {
+        return boost::none;
+    }
+    return it->second;
+}
+
+void CollectionDocumentCache::add(const BSONObj& idKey,
+                                  const RecordId& recordId,
+                                  const BSONObj& doc,
+                                  unsigned long long generation) {
+    if (doc.objsize() > kMaxCachedDocumentBytes) {
+        return;
+    }
+
+    auto key = _makeKey(idKey.firstElement());
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    if (generation != _generation || _writesInProgress.count(key)) {
+        return;
+    }
+    _documents.add(std::move(key), CachedDocument{recordId, doc.getOwned()});
+}
+
+size_t CollectionDocumentCache::size() const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return _documents.size();
+}
+
+std::string CollectionDocumentCache::_makeKey(const BSONElement& id) {
+    // Encoding the _id the way the index does makes values which the index treats as equal, such
+    // as 1 and 1.0, share an entry.
+    static const Ordering kAscending = Ordering::make(BSONObj());
+    const KeyString keyString(KeyString::kLatestVersion, id.wrap(""), kAscending);
+    return std::string(keyString.getBuffer(), keyString.getSize());
+}
+
+void CollectionDocumentCache::_endWrite(const std::string& key) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    auto it = _writesInProgress.find(key);
+    invariant(it != _writesInProgress.end());
+    if (--it->second == 0) {
+        _writesInProgress.erase(it);
+    }
+    _documents.erase(key);
+    ++_generation;
+}
+
+}  // namespace mongo
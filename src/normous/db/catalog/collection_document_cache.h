@@ -0,0 +1,134 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <boost/optional.hpp>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/db/record_id.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/lru_cache.h"
+
+namespace mongo {
+
+class OperationContext;
+
+/**
+ * Remembers recently read documents of a collection by _id, so that repeated point reads of the
+ * same documents can be answered without searching the _id index and the record store.
+ *
+ * A cached document is always the latest committed version. Writers call notifyOfWrite() before
+ * changing a document, which discards it and marks its _id as having a write in progress until
+ * that write commits or rolls back. Either step advances a generation number. A reader may add a
+ * document only under the generation it observed before opening its snapshot, and only if the
+ * generation has not moved and no write to that _id is still in progress, so a document which
+ * changed while it was being read is never cached.
+ *
+ * _id values are compared the way the _id index compares them under the simple collation.
+ *
+ * All methods are thread-safe.
+ */
+class CollectionDocumentCache : public std::enable_shared_from_this<CollectionDocumentCache> {
+    MONGO_DISALLOW_COPYING(CollectionDocumentCache);
+
+public:
+    /**
+     * Documents larger than this are never cached.
+     */
+    static constexpr int kMaxCachedDocumentBytes = 16 * 1024;
+
+    struct CachedDocument {
+        RecordId recordId;
+        BSONObj doc;
+    };
+
+    explicit CollectionDocumentCache(size_t maxEntries);
+
+    /**
+     * Discards the document with _id 'id' on behalf of a write to it by 'opCtx', and keeps it from
+     * being cached again until that write commits or rolls back. Must be called inside the
+     * WriteUnitOfWork of the write, before the document is changed.
+     */
+    void notifyOfWrite(OperationContext* opCtx, const BSONElement& id);
+
+    /**
+     * Discards every cached document.
+     */
+    void invalidate();
+
+    /**
+     * Returns the current generation. Documents read from a snapshot opened after this call may be
+     * added under the returned value.
+     */
+    unsigned long long getGeneration() const;
+
+    /**
+     * Returns the document whose _id is the single element of 'idKey', if it is cached.
+     */
+    boost::optional<CachedDocument> get(const BSONObj& idKey) const;
+
+    /**
+     * Caches 'doc', stored at 'recordId', under the single element of 'idKey'. Ignored unless
+     * 'generation' is still the current generation and no write to the document is in progress.
+     */
+    void add(const BSONObj& idKey,
+             const RecordId& recordId,
+             const BSONObj& doc,
+             unsigned long long generation);
+
+    /**
+     * Returns the number of cached documents.
+     */
+    size_t size() const;
+
+private:
+    class WriteChange;
+
+    static std::string _makeKey(const BSONElement& id);
+
+    /**
+     * Called once a write announced by notifyOfWrite() commits or rolls back.
+     */
+    void _endWrite(const std::string& key);
+
+    mutable stdx::mutex _mutex;
+    mutable LRUCache<std::string, CachedDocument> _documents;
+
+    // The number of writes in progress to each _id which has any.
+    stdx::unordered_map<std::string, int> _writesInProgress;
+
+    unsigned long long _generation = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,154 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/catalog/collection_document_cache.h"
+
+#include "mongo/db/operation_context.h"
+#include "mongo/db/query/query_test_service_context.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+BSONObj idKey(int value) {
+    return BSON("_id" << value);
+}
+
+BSONObj doc(int value, int x) {
+    return BSON("_id" << value << "x" << x);
+}
+
+class CollectionDocumentCacheTest : public unittest::Test {
+protected:
+    void addCurrent(int value, int x) {
+        _cache->add(idKey(value), RecordId(value), doc(value, x), _cache->getGeneration());
+    }
+
+    QueryTestServiceContext _serviceContext;
+    ServiceContext::UniqueOperationContext _opCtx = _serviceContext.makeOperationContext();
+    std::shared_ptr<CollectionDocumentCache> _cache =
+        std::make_shared<CollectionDocumentCache>(10);
+};
+
+TEST_F(CollectionDocumentCacheTest, ReturnsCachedDocument) {
+    addCurrent(1, 10);
+
+    auto cached = _cache->get(idKey(1));
+    ASSERT(cached);
+    ASSERT_EQ(RecordId(1), cached->recordId);
+    ASSERT_BSONOBJ_EQ(doc(1, 10), cached->doc);
+    ASSERT_FALSE(_cache->get(idKey(2)));
+}
+
+TEST_F(CollectionDocumentCacheTest, EqualIdsOfDifferentNumericTypesShareAnEntry) {
+    addCurrent(1, 10);
+
+    ASSERT(_cache->get(BSON("_id" << 1.0)));
+    ASSERT(_cache->get(BSON("_id" << 1LL)));
+}
+
+TEST_F(CollectionDocumentCacheTest, WriteDiscardsDocumentUntilItEnds) {
+    addCurrent(1, 10);
+    addCurrent(2, 20);
+
+    WriteUnitOfWork wuow(_opCtx.get());
+    _cache->notifyOfWrite(_opCtx.get(), doc(1, 11)["_id"]);
+    ASSERT_FALSE(_cache->get(idKey(1)));
+    ASSERT(_cache->get(idKey(2)));
+
+    // A reader must not cache the document while the write has not committed.
+    addCurrent(1, 10);
+    ASSERT_FALSE(_cache->get(idKey(1)));
+
+    wuow.commit();
+    addCurrent(1, 11);
+    ASSERT_BSONOBJ_EQ(doc(1, 11), _cache->get(idKey(1))->doc);
+}
+
+TEST_F(CollectionDocumentCacheTest, RollbackEndsWrite) {
+    {
+        WriteUnitOfWork wuow(_opCtx.get());
+        _cache->notifyOfWrite(_opCtx.get(), doc(1, 11)["_id"]);
+    }
+
+    addCurrent(1, 10);
+    ASSERT(_cache->get(idKey(1)));
+}
+
+TEST_F(CollectionDocumentCacheTest, IgnoresDocumentReadBeforeAWrite) {
+    const auto generation = _cache->getGeneration();
+
+    // A write committed while the document was being read.
+    {
+        WriteUnitOfWork wuow(_opCtx.get());
+        _cache->notifyOfWrite(_opCtx.get(), doc(1, 11)["_id"]);
+        wuow.commit();
+    }
+    _cache->add(idKey(1), RecordId(1), doc(1, 10), generation);
+
+    ASSERT_FALSE(_cache->get(idKey(1)));
+    ASSERT_EQ(0U, _cache->size());
+}
+
+TEST_F(CollectionDocumentCacheTest, IgnoresLargeDocuments) {
+    const std::string large(CollectionDocumentCache::kMaxCachedDocumentBytes, 'a');
+    _cache->add(idKey(1), RecordId(1), BSON("_id" << 1 << "s" << large), _cache->getGeneration());
+
+    ASSERT_FALSE(_cache->get(idKey(1)));
+}
+
+TEST_F(CollectionDocumentCacheTest, InvalidateDiscardsEveryDocument) {
+    addCurrent(1, 10);
+    addCurrent(2, 20);
+
+    _cache->invalidate();
+
+    ASSERT_FALSE(_cache->get(idKey(1)));
+    ASSERT_FALSE(_cache->get(idKey(2)));
+    ASSERT_EQ(0U, _cache->size());
+}
+
+TEST_F(CollectionDocumentCacheTest, EvictsLeastRecentlyUsedDocument) {
+    _cache = std::make_shared<CollectionDocumentCache>(2);
+    addCurrent(1, 10);
+    addCurrent(2, 20);
+
+    // Touch the first document so that the second is evicted next.
+    ASSERT(_cache->get(idKey(1)));
+    addCurrent(3, 30);
+
+    ASSERT_EQ(2U, _cache->size());
+    ASSERT(_cache->get(idKey(1)));
+    ASSERT_FALSE(_cache->get(idKey(2)));
+    ASSERT(_cache->get(idKey(3)));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -34,6 +34,8 @@
 
 #include "mongo/db/catalog/collection_impl.h"
 
+#include <algorithm>
+
 #include "mongo/base/counter.h"
 #include "mongo/base/init.h"
 #include "mongo/base/owned_pointer_map.h"
@@ -42,6 +44,7 @@
 #include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/background.h"
 #include "mongo/db/catalog/collection_catalog_entry.h"
+#include "mongo/db/catalog/collection_document_cache.h"
 #include "mongo/db/catalog/collection_options.h"
 #include "mongo/db/catalog/database_catalog_entry.h"
 #include "mongo/db/catalog/document_validation.h"
@@ -50,9 +53,11 @@
 #include "mongo/db/catalog/multi_index_block_impl.h"
 #include "mongo/db/catalog/namespace_uuid_cache.h"
 #include "mongo/db/catalog/uuid_catalog.h"
+#include "mongo/db/client.h"
 #include "mongo/db/clientcursor.h"
 #include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/d_concurrency.h"
+#include "mongo/db/concurrency/locker_noop.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/index/index_access_method.h"
 #include "mongo/db/keypattern.h"
@@ -61,17 +66,25 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/ops/update_request.h"
 #include "mongo/db/query/collation/collator_factory_interface.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/key_string.h"
 #include "mongo/db/storage/record_store.h"
+#include "mongo/db/storage/storage_engine.h"
+#include "mongo/db/timeseries/timeseries_options.h"
 #include "mongo/db/update/update_driver.h"
 
 #include "mongo/db/auth/user_document_parser.h"  // XXX-ANDY
 #include "mongo/rpc/object_check.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/functional.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/log.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -133,6 +146,27 @@ std::unique_ptr<CollatorInterface> parseCollation(OperationContext* opCtx,
 
     return std::move(collator.getValue());
 }
+
+// Returns false if none of 'modifiedPaths' is indexed by 'descriptor', so that an update which
+// modifies only those paths leaves the index keys of the document unchanged. A null
+// 'modifiedPaths' means that any path may have been modified.
+bool indexAffectedByUpdate(OperationContext* opCtx,
+                           const CollectionInfoCache& infoCache,
+                           const IndexDescriptor* descriptor,
+                           const std::vector<FieldRef>* modifiedPaths) {
+    if (!modifiedPaths) {
+        return true;
+    }
+
+    const UpdateIndexData* indexedPaths = infoCache.getIndexKeys(opCtx, descriptor);
+    if (!indexedPaths) {
+        return true;
+    }
+
+    return std::any_of(modifiedPaths->begin(), modifiedPaths->end(), [&](const FieldRef& path) {
+        return indexedPaths->mightBeIndexed(path);
+    });
+}
 }  // namespace
 
 using std::endl;
@@ -149,6 +183,23 @@ CollectionImpl::CollectionImpl(Collection* _this_init,
                                CollectionCatalogEntry* details,
                                RecordStore* recordStore,
                                DatabaseCatalogEntry* dbce)
+    : CollectionImpl(_this_init,
+                     opCtx,
+                     fullNS,
+                     uuid,
+                     details,
+                     recordStore,
+                     dbce,
+                     details->getCollectionOptions(opCtx)) {}
+
+CollectionImpl::CollectionImpl(Collection* _this_init,
+                               OperationContext* opCtx,
+                               StringData fullNS,
+                               OptionalCollectionUUID uuid,
+                               CollectionCatalogEntry* details,
+                               RecordStore* recordStore,
+                               DatabaseCatalogEntry* dbce,
+                               const CollectionOptions& options)
     : _ns(fullNS),
       _uuid(uuid),
       _details(details),
@@ -158,18 +209,26 @@ CollectionImpl::CollectionImpl(Collection* _this_init,
       _infoCache(_this_init, _ns),
       _indexCatalog(std::make_unique<IndexCatalogImpl>(_this_init,
                                                        getCatalogEntry()->getMaxAllowedIndexes())),
-      _collator(parseCollation(opCtx, _ns, _details->getCollectionOptions(opCtx).collation)),
-      _validatorDoc(_details->getCollectionOptions(opCtx).validator.getOwned()),
+      _collator(parseCollation(opCtx, _ns, options.collation)),
+      _validatorDoc(options.validator.getOwned()),
       _validator(uassertStatusOK(
           parseValidator(opCtx, _validatorDoc, MatchExpressionParser::kAllowAllSpecialFeatures))),
-      _validationAction(uassertStatusOK(
-          parseValidationAction(_details->getCollectionOptions(opCtx).validationAction))),
-      _validationLevel(uassertStatusOK(
-          parseValidationLevel(_details->getCollectionOptions(opCtx).validationLevel))),
+      _validationAction(uassertStatusOK(parseValidationAction(options.validationAction))),
+      _validationLevel(uassertStatusOK(parseValidationLevel(options.validationLevel))),
       _cursorManager(_ns),
       _cappedNotifier(_recordStore->isCapped() ? stdx::make_unique<CappedInsertNotifier>()
                                                : nullptr),
-      _this(_this_init) {}
+      _this(_this_init) {
+    if (!options.timeseries.isEmpty()) {
+        timeseries::noteTimeseriesBucketsCollection();
+    }
+
+    // Capped deletes happen inside the record store, out of sight of the cache. Under a default
+    // collation, _id values which the cache tells apart may be equal.
+    if (internalQueryIdHackCacheSize > 0 && !_recordStore->isCapped() && !_collator) {
+        _documentCache = std::make_shared<CollectionDocumentCache>(internalQueryIdHackCacheSize);
+    }
+}
 
 void CollectionImpl::init(OperationContext* opCtx) {
     _magic = kMagicNumber;
@@ -206,6 +265,11 @@ bool CollectionImpl::requiresIdIndex() const {
         return false;
     }
 
+    if (_recordStore->isClustered()) {
+        // The records are found by their _id without an index.
+        return false;
+    }
+
     if (_ns.isSystem()) {
         StringData shortName = _ns.coll().substr(_ns.coll().find('.') + 1);
         if (shortName == "indexes" || shortName == "namespaces" || shortName == "profile") {
@@ -473,7 +537,13 @@ Status CollectionImpl::_insertDocuments(OperationContext* opCtx,
                 "Can't batch inserts into indexed capped collections"};
     }
 
-    if (_needCappedLock) {
+    // Timestamped inserts into a record store that keys them by their timestamps get RecordIds in
+    // oplog order without holding the lock, so secondaries place and delete the same documents.
+    const bool keyedByTimestamp = _recordStore->keysCappedInsertsByTimestamp() &&
+        std::all_of(begin, end, [](const InsertStatement& stmt) {
+            return !stmt.oplogSlot.opTime.getTimestamp().isNull();
+        });
+    if (_needCappedLock && !keyedByTimestamp) {
         // X-lock the metadata resource for this capped collection until the end of the WUOW. This
         // prevents the primary from executing with more concurrency than secondaries.
         // See SERVER-21646.
@@ -562,6 +632,10 @@ void CollectionImpl::deleteDocument(OperationContext* opCtx,
     Snapshotted<BSONObj> doc = docFor(opCtx, loc);
     getGlobalServiceContext()->getOpObserver()->aboutToDelete(opCtx, ns(), doc.value());
 
+    if (_documentCache) {
+        _documentCache->notifyOfWrite(opCtx, doc.value()["_id"]);
+    }
+
     boost::optional<BSONObj> deletedDoc;
     if (storeDeletedDoc == Collection::StoreDeletedDoc::On) {
         deletedDoc.emplace(doc.value().getOwned());
@@ -638,14 +712,21 @@ RecordId CollectionImpl::updateDocument(OperationContext* opCtx,
                                 << " != "
                                 << newDoc.objsize());
 
-    // At the end of this step, we will have a map of UpdateTickets, one per index, which
-    // represent the index updates needed to be done, based on the changes between oldDoc and
-    // newDoc.
+    // At the end of this step, we will have a map of UpdateTickets, one per index affected by the
+    // update, which represent the index updates needed to be done, based on the changes between
+    // oldDoc and newDoc.
     OwnedPointerMap<IndexDescriptor*, UpdateTicket> updateTickets;
     if (indexesAffected) {
         IndexCatalog::IndexIterator ii = _indexCatalog->getIndexIterator(opCtx, true);
         while (ii.more()) {
             IndexDescriptor* descriptor = ii.next();
+            if (!indexAffectedByUpdate(
+                    opCtx, _infoCache, descriptor, args->modifiedIndexedPaths)) {
+                // None of the modified paths is indexed by this index, so the old and new
+                // documents have the same keys in it.
+                continue;
+            }
+
             IndexCatalogEntry* entry = ii.catalogEntry(descriptor);
             IndexAccessMethod* iam = ii.accessMethod(descriptor);
 
@@ -665,6 +746,10 @@ RecordId CollectionImpl::updateDocument(OperationContext* opCtx,
 
     args->preImageDoc = oldDoc.value().getOwned();
 
+    if (_documentCache) {
+        _documentCache->notifyOfWrite(opCtx, oldId);
+    }
+
     Status updateStatus =
         _recordStore->updateRecord(opCtx, oldLocation, newDoc.objdata(), newDoc.objsize());
 
@@ -673,12 +758,15 @@ RecordId CollectionImpl::updateDocument(OperationContext* opCtx,
         IndexCatalog::IndexIterator ii = _indexCatalog->getIndexIterator(opCtx, true);
         while (ii.more()) {
             IndexDescriptor* descriptor = ii.next();
+            auto updateTicket = updateTickets.mutableMap().find(descriptor);
+            if (updateTicket == updateTickets.mutableMap().end()) {
+                continue;
+            }
             IndexAccessMethod* iam = ii.accessMethod(descriptor);
 
             int64_t keysInserted;
             int64_t keysDeleted;
-            uassertStatusOK(iam->update(
-                opCtx, *updateTickets.mutableMap()[descriptor], &keysInserted, &keysDeleted));
+            uassertStatusOK(iam->update(opCtx, *updateTicket->second, &keysInserted, &keysDeleted));
             if (opDebug) {
                 opDebug->additiveMetrics.incrementKeysInserted(keysInserted);
                 opDebug->additiveMetrics.incrementKeysDeleted(keysDeleted);
@@ -714,6 +802,15 @@ StatusWith<RecordData> CollectionImpl::updateDocumentWithDamages(
     invariant(oldRec.snapshotId() == opCtx->recoveryUnit()->getSnapshotId());
     invariant(updateWithDamagesSupported());
 
+    // Damages are applied in place, so the pre-image has to be copied out before they are.
+    if (!args->preImageDoc) {
+        args->preImageDoc = oldRec.value().toBson().getOwned();
+    }
+
+    if (_documentCache) {
+        _documentCache->notifyOfWrite(opCtx, (*args->preImageDoc)["_id"]);
+    }
+
     auto newRecStatus =
         _recordStore->updateWithDamages(opCtx, loc, oldRec.value(), damageSource, damages);
 
@@ -797,6 +894,10 @@ Status CollectionImpl::truncate(OperationContext* opCtx) {
     if (!status.isOK())
         return status;
 
+    if (_documentCache) {
+        _documentCache->invalidate();
+    }
+
     // 4) re-create indexes
     for (size_t i = 0; i < indexSpecs.size(); i++) {
         status = _indexCatalog->createIndexOnEmptyCollection(opCtx, indexSpecs[i]).getStatus();
@@ -982,28 +1083,252 @@ const CollatorInterface* CollectionImpl::getDefaultCollator() const {
     return _collator.get();
 }
 
+// A background validation of a replicated collection splits its record store and index scans
+// across up to this many threads, which all read at the same timestamp.
+MONGO_EXPORT_SERVER_PARAMETER(maxValidateThreads, int, 4)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 1 || newVal > 64) {
+            return Status(ErrorCodes::BadValue, "maxValidateThreads must be between 1 and 64");
+        }
+        return Status::OK();
+    });
+
 namespace {
 
 using ValidateResultsMap = std::map<std::string, ValidateResults>;
 
-void _validateRecordStore(OperationContext* opCtx,
-                          RecordStore* recordStore,
-                          ValidateCmdLevel level,
-                          bool background,
-                          RecordStoreValidateAdaptor* indexValidator,
-                          ValidateResults* results,
-                          BSONObjBuilder* output) {
+// The number of RecordIds sampled for each range of the record store validated by its own thread.
+const size_t kSamplesPerValidateRange = 10;
+
+/**
+ * Returns the number of records in the snapshot validated.
+ */
+long long _validateRecordStore(OperationContext* opCtx,
+                               RecordStore* recordStore,
+                               ValidateCmdLevel level,
+                               bool background,
+                               RecordStoreValidateAdaptor* indexValidator,
+                               ValidateResults* results,
+                               BSONObjBuilder* output) {
 
     // Validate RecordStore and, if `level == kValidateFull`, use the RecordStore's validate
     // function.
     if (background) {
-        indexValidator->traverseRecordStore(recordStore, level, results, output);
-    } else {
-        auto status = recordStore->validate(opCtx, level, indexValidator, results, output);
-        // RecordStore::validate always returns Status::OK(). Errors are reported through
-        // `results`.
-        dassert(status.isOK());
+        return indexValidator->traverseRecordStore(recordStore, level, results, output);
     }
+
+    auto status = recordStore->validate(opCtx, level, indexValidator, results, output);
+    // RecordStore::validate always returns Status::OK(). Errors are reported through
+    // `results`.
+    dassert(status.isOK());
+    return recordStore->numRecords(opCtx);
+}
+
+/**
+ * Pins the snapshot a background validation reads from. Returns its timestamp if the validation
+ * can be split across threads that each read at that timestamp, and boost::none otherwise.
+ */
+boost::optional<Timestamp> _establishBackgroundValidationSnapshot(OperationContext* opCtx,
+                                                                  const NamespaceString& nss) {
+    // Only the writes to replicated collections are all timestamped, which is what makes separate
+    // transactions reading at the same timestamp see the same data.
+    if (maxValidateThreads.load() <= 1 || !nss.isReplicated() ||
+        !repl::ReplicationCoordinator::get(opCtx)->isReplEnabled() ||
+        !opCtx->getServiceContext()->getStorageEngine()->supportsReadConcernSnapshot()) {
+        return boost::none;
+    }
+
+    opCtx->recoveryUnit()->abandonSnapshot();
+    opCtx->recoveryUnit()->setTimestampReadSource(RecoveryUnit::ReadSource::kAllCommittedSnapshot);
+    opCtx->recoveryUnit()->preallocateSnapshot();
+    return opCtx->recoveryUnit()->getPointInTimeReadTimestamp();
+}
+
+/**
+ * Runs 'task' for every number in [0, numTasks) on up to maxValidateThreads threads. Each thread
+ * has an OperationContext of its own that reads at 'readTimestamp'. The threads take no locks,
+ * relying on the intent lock held by 'opCtx' to keep the collection and its indexes from being
+ * dropped. Returns the first error of a task, or the interruption of 'opCtx'.
+ */
+Status _runValidateTasks(OperationContext* opCtx,
+                         Timestamp readTimestamp,
+                         size_t numTasks,
+                         const stdx::function<void(OperationContext*, size_t)>& task) {
+    const size_t numThreads = std::min(numTasks, static_cast<size_t>(maxValidateThreads.load()));
+
+    AtomicWord<bool> abort(false);
+    AtomicUInt64 nextTask;
+
+    stdx::mutex mutex;
+    stdx::condition_variable taskThreadFinished;
+    size_t numRunning = numThreads;             // Guarded by 'mutex'.
+    std::vector<OperationContext*> taskOpCtxs;  // Guarded by 'mutex'.
+    Status firstError = Status::OK();           // Guarded by 'mutex'.
+
+    auto killTaskOpCtxs_inlock = [&](ErrorCodes::Error killCode) {
+        for (auto taskOpCtx : taskOpCtxs) {
+            stdx::lock_guard<Client> clientLock(*taskOpCtx->getClient());
+            taskOpCtx->getServiceContext()->killOperation(taskOpCtx, killCode);
+        }
+    };
+
+    auto runTasks = [&] {
+        ON_BLOCK_EXIT([&] {
+            stdx::lock_guard<stdx::mutex> lk(mutex);
+            --numRunning;
+            taskThreadFinished.notify_all();
+        });
+
+        try {
+            Client::initThread("validateWorker");
+            auto taskOpCtx = cc().makeOperationContext();
+            taskOpCtx->swapLockState(stdx::make_unique<LockerNoop>());
+            taskOpCtx->recoveryUnit()->setTimestampReadSource(
+                RecoveryUnit::ReadSource::kProvided, readTimestamp);
+            {
+                stdx::lock_guard<stdx::mutex> lk(mutex);
+                taskOpCtxs.push_back(taskOpCtx.get());
+            }
+            ON_BLOCK_EXIT([&] {
+                stdx::lock_guard<stdx::mutex> lk(mutex);
+                taskOpCtxs.erase(std::find(taskOpCtxs.begin(), taskOpCtxs.end(), taskOpCtx.get()));
+            });
+
+            for (size_t i = nextTask.fetchAndAdd(1); i < numTasks && !abort.load();
+                 i = nextTask.fetchAndAdd(1)) {
+                task(taskOpCtx.get(), i);
+            }
+        } catch (...) {
+            stdx::lock_guard<stdx::mutex> lk(mutex);
+            if (firstError.isOK()) {
+                firstError = exceptionToStatus();
+            }
+            abort.store(true);
+            killTaskOpCtxs_inlock(ErrorCodes::Interrupted);
+        }
+    };
+
+    std::vector<stdx::thread> threads;
+    auto joinThreads = MakeGuard([&] {
+        abort.store(true);
+        for (auto&& thread : threads) {
+            thread.join();
+        }
+    });
+    for (size_t i = 0; i < numThreads; ++i) {
+        threads.emplace_back(runTasks);
+    }
+
+    // Wait for the tasks to finish, watching for interruption, which the task threads can't check
+    // for themselves.
+    Status interruptStatus = Status::OK();
+    {
+        stdx::unique_lock<stdx::mutex> lk(mutex);
+        while (numRunning > 0) {
+            taskThreadFinished.wait_for(lk, Milliseconds(100).toSystemDuration());
+            if (interruptStatus.isOK()) {
+                interruptStatus = opCtx->checkForInterruptNoAssert();
+            }
+            if (!interruptStatus.isOK()) {
+                // Threads that had yet to register their OperationContexts are killed on a later
+                // iteration.
+                abort.store(true);
+                killTaskOpCtxs_inlock(interruptStatus.code());
+            }
+        }
+    }
+    joinThreads.Dismiss();
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+
+    if (!interruptStatus.isOK()) {
+        return interruptStatus;
+    }
+    return firstError;
+}
+
+/**
+ * Like _validateRecordStore() for a background validation, but splits the record store into
+ * RecordId ranges validated by separate threads reading at 'readTimestamp'. Each thread counts the
+ * document keys in its own IndexConsistency, whose key-count buckets are then merged into
+ * 'indexConsistency'.
+ */
+long long _validateRecordStoreInParallel(OperationContext* opCtx,
+                                         Timestamp readTimestamp,
+                                         RecordStore* recordStore,
+                                         IndexCatalog* indexCatalog,
+                                         IndexConsistency* indexConsistency,
+                                         ValidateCmdLevel level,
+                                         ValidateResultsMap* indexNsResultsMap,
+                                         ValidateResults* results,
+                                         BSONObjBuilder* output) {
+    // Split the record store into ranges holding roughly equal numbers of records, using a random
+    // sample of its RecordIds, read at the same timestamp, as the range boundaries.
+    const size_t numRanges = static_cast<size_t>(maxValidateThreads.load());
+    std::vector<RecordId> boundaries;
+    if (auto randomCursor = recordStore->getRandomCursor(opCtx)) {
+        std::vector<RecordId> sample;
+        for (size_t i = 0; i < numRanges * kSamplesPerValidateRange; ++i) {
+            auto record = randomCursor->next();
+            if (!record) {
+                break;
+            }
+            sample.push_back(record->id);
+        }
+        std::sort(sample.begin(), sample.end());
+        sample.erase(std::unique(sample.begin(), sample.end()), sample.end());
+
+        for (size_t i = 1; i < numRanges && !sample.empty(); ++i) {
+            boundaries.push_back(sample[i * sample.size() / numRanges]);
+        }
+        boundaries.erase(std::unique(boundaries.begin(), boundaries.end()), boundaries.end());
+    }
+
+    struct RangeResults {
+        ValidateResults results;
+        ValidateResultsMap indexNsResultsMap;
+        RecordStoreValidateAdaptor::TraversalStats stats;
+    };
+    std::vector<RangeResults> ranges(boundaries.size() + 1);
+
+    uassertStatusOK(_runValidateTasks(
+        opCtx, readTimestamp, ranges.size(), [&](OperationContext* taskOpCtx, size_t i) {
+            IndexConsistency rangeConsistency(taskOpCtx, indexConsistency);
+            RecordStoreValidateAdaptor rangeValidator(
+                taskOpCtx, &rangeConsistency, level, indexCatalog, &ranges[i].indexNsResultsMap);
+            rangeValidator.traverseRecordRange(recordStore,
+                                               i > 0 ? boundaries[i - 1] : RecordId(),
+                                               i < boundaries.size() ? boundaries[i] : RecordId(),
+                                               &ranges[i].results,
+                                               &ranges[i].stats);
+            indexConsistency->merge(rangeConsistency);
+        }));
+
+    RecordStoreValidateAdaptor::TraversalStats stats;
+    results->valid = true;
+    for (auto&& range : ranges) {
+        stats.nrecords += range.stats.nrecords;
+        stats.nInvalid += range.stats.nInvalid;
+        if (!range.results.valid) {
+            if (results->valid) {
+                results->errors.push_back("detected one or more invalid documents (see logs)");
+            }
+            results->valid = false;
+        }
+
+        // As in a serial traversal, an index keeps the results of one of its invalid documents.
+        for (auto&& entry : range.indexNsResultsMap) {
+            ValidateResults& indexResults = (*indexNsResultsMap)[entry.first];
+            if (indexResults.valid && !entry.second.valid) {
+                indexResults = entry.second;
+            }
+        }
+    }
+
+    output->append("nInvalidDocuments", stats.nInvalid);
+    output->appendNumber("nrecords", stats.nrecords);
+    return stats.nrecords;
 }
 
 void _validateIndexes(OperationContext* opCtx,
@@ -1072,9 +1397,65 @@ void _markIndexEntriesInvalid(ValidateResultsMap* indexNsResultsMap, ValidateRes
     results->valid = false;
 }
 
+/**
+ * Like _validateIndexes() for a background validation, but traverses the indexes on separate
+ * threads reading at 'readTimestamp', merging their index key counts into 'indexConsistency'.
+ */
+void _validateIndexesInParallel(OperationContext* opCtx,
+                                Timestamp readTimestamp,
+                                IndexCatalog* indexCatalog,
+                                IndexConsistency* indexConsistency,
+                                BSONObjBuilder* keysPerIndex,
+                                ValidateCmdLevel level,
+                                ValidateResultsMap* indexNsResultsMap,
+                                ValidateResults* results) {
+    // Full validation checks the storage engine's structures, which requires exclusive access.
+    invariant(level != kValidateFull);
+
+    std::vector<const IndexDescriptor*> descriptors;
+    IndexCatalog::IndexIterator i = indexCatalog->getIndexIterator(opCtx, false);
+    while (i.more()) {
+        descriptors.push_back(i.next());
+    }
+
+    std::vector<ValidateResults> indexResults;
+    for (auto descriptor : descriptors) {
+        indexResults.push_back((*indexNsResultsMap)[descriptor->indexNamespace()]);
+    }
+    std::vector<int64_t> numTraversedKeys(descriptors.size(), 0);
+
+    uassertStatusOK(_runValidateTasks(
+        opCtx, readTimestamp, descriptors.size(), [&](OperationContext* taskOpCtx, size_t i) {
+            if (!indexResults[i].valid) {
+                return;
+            }
+            log(LogComponent::kIndex) << "validating index " << descriptors[i]->indexNamespace();
+
+            IndexConsistency indexKeyConsistency(taskOpCtx, indexConsistency);
+            ValidateResultsMap recordResultsMap;
+            RecordStoreValidateAdaptor indexValidator(
+                taskOpCtx, &indexKeyConsistency, level, indexCatalog, &recordResultsMap);
+            indexValidator.traverseIndex(indexCatalog->getIndex(descriptors[i]),
+                                         descriptors[i],
+                                         &indexResults[i],
+                                         &numTraversedKeys[i]);
+            indexConsistency->merge(indexKeyConsistency);
+        }));
+
+    for (size_t i = 0; i < descriptors.size(); ++i) {
+        (*indexNsResultsMap)[descriptors[i]->indexNamespace()] = indexResults[i];
+        if (indexResults[i].valid) {
+            keysPerIndex->appendNumber(descriptors[i]->indexNamespace(),
+                                       static_cast<long long>(numTraversedKeys[i]));
+        } else {
+            results->valid = false;
+        }
+    }
+}
+
 void _validateIndexKeyCount(OperationContext* opCtx,
                             IndexCatalog* indexCatalog,
-                            RecordStore* recordStore,
+                            long long numRecords,
                             RecordStoreValidateAdaptor* indexValidator,
                             ValidateResultsMap* indexNsResultsMap) {
 
@@ -1084,8 +1465,7 @@ void _validateIndexKeyCount(OperationContext* opCtx,
         ValidateResults& curIndexResults = (*indexNsResultsMap)[descriptor->indexNamespace()];
 
         if (curIndexResults.valid) {
-            indexValidator->validateIndexKeyCount(
-                descriptor, recordStore->numRecords(opCtx), curIndexResults);
+            indexValidator->validateIndexKeyCount(descriptor, numRecords, curIndexResults);
         }
     }
 }
@@ -1206,21 +1586,58 @@ Status CollectionImpl::validate(OperationContext* opCtx,
             << " (UUID: " << (uuid() ? uuid()->toString() : "none") << ")";
         log(LogComponent::kIndex) << "validating collection " << ns().toString() << uuidString
                                   << endl;
-        _validateRecordStore(
-            opCtx, _recordStore, level, background, &indexValidator, results, output);
+
+        // A background validation reads the record store and the indexes at one snapshot, while
+        // writes continue under their intent locks. If the snapshot has a timestamp, the work is
+        // split across threads that read at the same timestamp.
+        boost::optional<Timestamp> parallelReadTimestamp;
+        if (background) {
+            invariant(level != kValidateFull);
+            parallelReadTimestamp = _establishBackgroundValidationSnapshot(opCtx, ns());
+        }
+
+        long long numRecords;
+        if (parallelReadTimestamp) {
+            log(LogComponent::kIndex) << "validating collection " << ns().toString()
+                                      << " at timestamp " << parallelReadTimestamp->toString()
+                                      << " on up to " << maxValidateThreads.load() << " threads";
+            numRecords = _validateRecordStoreInParallel(opCtx,
+                                                        *parallelReadTimestamp,
+                                                        _recordStore,
+                                                        _indexCatalog.get(),
+                                                        &indexConsistency,
+                                                        level,
+                                                        &indexNsResultsMap,
+                                                        results,
+                                                        output);
+        } else {
+            numRecords = _validateRecordStore(
+                opCtx, _recordStore, level, background, &indexValidator, results, output);
+        }
 
         // Validate in-memory catalog information with the persisted info.
         _validateCatalogEntry(opCtx, this, _validatorDoc, results);
 
         // Validate indexes and check for mismatches.
         if (results->valid) {
-            _validateIndexes(opCtx,
-                             _indexCatalog.get(),
-                             &keysPerIndex,
-                             &indexValidator,
-                             level,
-                             &indexNsResultsMap,
-                             results);
+            if (parallelReadTimestamp) {
+                _validateIndexesInParallel(opCtx,
+                                           *parallelReadTimestamp,
+                                           _indexCatalog.get(),
+                                           &indexConsistency,
+                                           &keysPerIndex,
+                                           level,
+                                           &indexNsResultsMap,
+                                           results);
+            } else {
+                _validateIndexes(opCtx,
+                                 _indexCatalog.get(),
+                                 &keysPerIndex,
+                                 &indexValidator,
+                                 level,
+                                 &indexNsResultsMap,
+                                 results);
+            }
 
             if (indexConsistency.haveEntryMismatch()) {
                 _markIndexEntriesInvalid(&indexNsResultsMap, results);
@@ -1230,7 +1647,7 @@ Status CollectionImpl::validate(OperationContext* opCtx,
         // Validate index key count.
         if (results->valid) {
             _validateIndexKeyCount(
-                opCtx, _indexCatalog.get(), _recordStore, &indexValidator, &indexNsResultsMap);
+                opCtx, _indexCatalog.get(), numRecords, &indexValidator, &indexNsResultsMap);
         }
 
         // Report the validation results for the user to see
@@ -1248,6 +1665,12 @@ Status CollectionImpl::validate(OperationContext* opCtx,
         if (ErrorCodes::isInterruption(e.code())) {
             return e.toStatus();
         }
+        if (background && (e.code() == ErrorCodes::WriteConflict ||
+                           e.code() == ErrorCodes::SnapshotTooOld)) {
+            // The snapshot could not be held for the whole validation, which says nothing about
+            // the validity of the collection.
+            return e.toStatus();
+        }
         string err = str::stream() << "exception during index validation: " << e.toString();
         results->errors.push_back(err);
         results->valid = false;
@@ -315,6 +315,10 @@ public:
      */
     std::shared_ptr<CappedInsertNotifier> getCappedInsertNotifier() const final;
 
+    CollectionDocumentCache* getDocumentCache() const final {
+        return _documentCache.get();
+    }
+
     uint64_t numRecords(OperationContext* opCtx) const final;
 
     uint64_t dataSize(OperationContext* opCtx) const final;
@@ -359,6 +363,17 @@ public:
     std::unique_ptr<MultiIndexBlock> createMultiIndexBlock(OperationContext* opCtx) final;
 
 private:
+    // Delegated to by the public constructor so the collection options are read from the catalog
+    // entry only once.
+    CollectionImpl(Collection* _this,
+                   OperationContext* opCtx,
+                   StringData fullNS,
+                   OptionalCollectionUUID uuid,
+                   CollectionCatalogEntry* details,
+                   RecordStore* recordStore,
+                   DatabaseCatalogEntry* dbce,
+                   const CollectionOptions& options);
+
     inline DatabaseCatalogEntry* dbce() const final {
         return this->_dbce;
     }
@@ -424,6 +439,10 @@ private:
     // This is non-null if and only if the collection is a capped collection.
     const std::shared_ptr<CappedInsertNotifier> _cappedNotifier;
 
+    // Null unless 'internalQueryIdHackCacheSize' is positive and the collection is neither capped
+    // nor has a default collation. Shared with the recovery unit changes which end writes to it.
+    std::shared_ptr<CollectionDocumentCache> _documentCache;
+
     // The earliest snapshot that is allowed to use this collection.
     boost::optional<Timestamp> _minVisibleSnapshot;
 
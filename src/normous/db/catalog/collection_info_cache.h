@@ -56,6 +56,9 @@ public:
 
         virtual const UpdateIndexData& getIndexKeys(OperationContext* opCtx) const = 0;
 
+        virtual const UpdateIndexData* getIndexKeys(OperationContext* opCtx,
+                                                    const IndexDescriptor* desc) const = 0;
+
         virtual CollectionIndexUsageMap getIndexUsageStats() const = 0;
 
         virtual void init(OperationContext* opCtx) = 0;
@@ -110,6 +113,15 @@ public:
         return this->_impl().getIndexKeys(opCtx);
     }
 
+    /**
+     * Returns the paths indexed by the index 'desc' alone, in the same form as getIndexKeys(), or
+     * nullptr if the cache has not registered the index.
+     */
+    inline const UpdateIndexData* getIndexKeys(OperationContext* const opCtx,
+                                               const IndexDescriptor* const desc) const {
+        return this->_impl().getIndexKeys(opCtx, desc);
+    }
+
     /**
      * Returns cached index usage statistics for this collection.  The map returned will contain
      * entry for each index in the collection along with both a usage counter and a timestamp
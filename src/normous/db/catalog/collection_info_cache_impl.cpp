@@ -35,6 +35,7 @@
 #include "mongo/base/init.h"
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/fts/fts_spec.h"
 #include "mongo/db/index/index_descriptor.h"
@@ -51,6 +52,12 @@
 #include "mongo/util/log.h"
 
 namespace mongo {
+namespace {
+// Estimated bytes used by the plan caches of all collections.
+ServerStatusMetricField<Counter64> planCacheTotalSizeEstimateBytesDisplay(
+    "query.planCacheTotalSizeEstimateBytes", &PlanCache::getTotalSizeEstimateBytes());
+}  // namespace
+
 MONGO_REGISTER_SHIM(CollectionInfoCache::makeImpl)
 (Collection* const collection, const NamespaceString& ns, PrivateTo<CollectionInfoCache>)
     ->std::unique_ptr<CollectionInfoCache::Impl> {
@@ -80,8 +87,17 @@ const UpdateIndexData& CollectionInfoCacheImpl::getIndexKeys(OperationContext* o
     return _indexedPaths;
 }
 
+const UpdateIndexData* CollectionInfoCacheImpl::getIndexKeys(OperationContext* opCtx,
+                                                             const IndexDescriptor* desc) const {
+    dassert(opCtx->lockState()->isCollectionLockedForMode(_collection->ns().ns(), MODE_IS));
+    invariant(_keysComputed);
+    auto it = _indexedPathsByIndex.find(desc->indexName());
+    return it == _indexedPathsByIndex.end() ? nullptr : &it->second;
+}
+
 void CollectionInfoCacheImpl::computeIndexKeys(OperationContext* opCtx) {
     _indexedPaths.clear();
+    _indexedPathsByIndex.clear();
 
     bool hadTTLIndex = _hasTTLIndex;
     _hasTTLIndex = false;
@@ -89,6 +105,7 @@ void CollectionInfoCacheImpl::computeIndexKeys(OperationContext* opCtx) {
     IndexCatalog::IndexIterator i = _collection->getIndexCatalog()->getIndexIterator(opCtx, true);
     while (i.more()) {
         IndexDescriptor* descriptor = i.next();
+        UpdateIndexData& indexedPaths = _indexedPathsByIndex[descriptor->indexName()];
 
         if (descriptor->getAccessMethodName() == IndexNames::WILDCARD) {
             // Obtain the projection used by the $** index's key generator.
@@ -97,34 +114,38 @@ void CollectionInfoCacheImpl::computeIndexKeys(OperationContext* opCtx) {
             // If the projection is an exclusion, then we must check the new document's keys on all
             // updates, since we do not exhaustively know the set of paths to be indexed.
             if (pathProj->getType() == ProjectionExecAgg::ProjectionType::kExclusionProjection) {
-                _indexedPaths.allPathsIndexed();
+                indexedPaths.allPathsIndexed();
             } else {
                 // If a subtree was specified in the keyPattern, or if an inclusion projection is
                 // present, then we need only index the path(s) preserved by the projection.
                 for (const auto& path : pathProj->getExhaustivePaths()) {
-                    _indexedPaths.addPath(path);
+                    indexedPaths.addPath(path);
                 }
             }
+        } else if (descriptor->getAccessMethodName() == IndexNames::COLUMN &&
+                   descriptor->keyPattern().hasField("$**")) {
+            // A columnstore index over "$**" stores every top-level field.
+            indexedPaths.allPathsIndexed();
         } else if (descriptor->getAccessMethodName() == IndexNames::TEXT) {
             fts::FTSSpec ftsSpec(descriptor->infoObj());
 
             if (ftsSpec.wildcard()) {
-                _indexedPaths.allPathsIndexed();
+                indexedPaths.allPathsIndexed();
             } else {
                 for (size_t i = 0; i < ftsSpec.numExtraBefore(); ++i) {
-                    _indexedPaths.addPath(FieldRef(ftsSpec.extraBefore(i)));
+                    indexedPaths.addPath(FieldRef(ftsSpec.extraBefore(i)));
                 }
                 for (fts::Weights::const_iterator it = ftsSpec.weights().begin();
                      it != ftsSpec.weights().end();
                      ++it) {
-                    _indexedPaths.addPath(FieldRef(it->first));
+                    indexedPaths.addPath(FieldRef(it->first));
                 }
                 for (size_t i = 0; i < ftsSpec.numExtraAfter(); ++i) {
-                    _indexedPaths.addPath(FieldRef(ftsSpec.extraAfter(i)));
+                    indexedPaths.addPath(FieldRef(ftsSpec.extraAfter(i)));
                 }
                 // Any update to a path containing "language" as a component could change the
                 // language of a subdocument.  Add the override field as a path component.
-                _indexedPaths.addPathComponent(ftsSpec.languageOverrideField());
+                indexedPaths.addPathComponent(ftsSpec.languageOverrideField());
             }
         } else {
             BSONObj key = descriptor->keyPattern();
@@ -135,7 +156,7 @@ void CollectionInfoCacheImpl::computeIndexKeys(OperationContext* opCtx) {
             BSONObjIterator j(key);
             while (j.more()) {
                 BSONElement e = j.next();
-                _indexedPaths.addPath(FieldRef(e.fieldName()));
+                indexedPaths.addPath(FieldRef(e.fieldName()));
             }
         }
 
@@ -146,9 +167,11 @@ void CollectionInfoCacheImpl::computeIndexKeys(OperationContext* opCtx) {
             stdx::unordered_set<std::string> paths;
             QueryPlannerIXSelect::getFields(filter, &paths);
             for (auto it = paths.begin(); it != paths.end(); ++it) {
-                _indexedPaths.addPath(FieldRef(*it));
+                indexedPaths.addPath(FieldRef(*it));
             }
         }
+
+        _indexedPaths.merge(indexedPaths);
     }
 
     TTLCollectionCache& ttlCollectionCache = TTLCollectionCache::get(getGlobalServiceContext());
@@ -35,6 +35,7 @@
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/query_settings.h"
 #include "mongo/db/update_index_data.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 
@@ -67,6 +68,11 @@ public:
     */
     const UpdateIndexData& getIndexKeys(OperationContext* opCtx) const;
 
+    /**
+     * Get the paths indexed by the index 'desc'.
+     */
+    const UpdateIndexData* getIndexKeys(OperationContext* opCtx, const IndexDescriptor* desc) const;
+
     /**
      * Returns cached index usage statistics for this collection.  The map returned will contain
      * entry for each index in the collection along with both a usage counter and a timestamp
@@ -125,6 +131,9 @@ private:
     bool _keysComputed;
     UpdateIndexData _indexedPaths;
 
+    // The paths of each index, by index name. '_indexedPaths' is their union.
+    StringMap<UpdateIndexData> _indexedPathsByIndex;
+
     // A cache for query plans.
     std::unique_ptr<PlanCache> _planCache;
 
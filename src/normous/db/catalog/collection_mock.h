@@ -244,6 +244,10 @@ public:
         std::abort();
     }
 
+    CollectionDocumentCache* getDocumentCache() const {
+        return nullptr;
+    }
+
     uint64_t numRecords(OperationContext* opCtx) const {
         std::abort();
     }
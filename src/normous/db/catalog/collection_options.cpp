@@ -38,6 +38,7 @@
 #include "mongo/db/query/collation/collator_factory_interface.h"
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/db/server_parameters.h"
+#include "mongo/db/timeseries/timeseries_options.h"
 #include "mongo/util/mongoutils/str.h"
 
 namespace mongo {
@@ -176,6 +177,8 @@ Status CollectionOptions::parse(const BSONObj& options, ParseKind kind) {
             flagsSet = true;
         } else if (fieldName == "temp") {
             temp = e.trueValue();
+        } else if (fieldName == "clustered") {
+            clustered = e.trueValue();
         } else if (fieldName == "storageEngine") {
             Status status = checkStorageEngineOptions(e);
             if (!status.isOK()) {
@@ -243,6 +246,17 @@ Status CollectionOptions::parse(const BSONObj& options, ParseKind kind) {
             }
 
             pipeline = e.Obj().getOwned();
+        } else if (fieldName == "timeseries") {
+            if (e.type() != mongo::Object) {
+                return Status(ErrorCodes::TypeMismatch, "'timeseries' has to be a document.");
+            }
+
+            auto timeseriesOptions = timeseries::TimeseriesOptions::parse(e.Obj());
+            if (!timeseriesOptions.isOK()) {
+                return timeseriesOptions.getStatus().withContext("Error in timeseries options");
+            }
+            // Store the options with their defaults filled in.
+            timeseries = timeseriesOptions.getValue().toBSON();
         } else if (fieldName == "idIndex" && kind == parseForCommand) {
             if (e.type() != mongo::Object) {
                 return Status(ErrorCodes::TypeMismatch, "'idIndex' has to be an object.");
@@ -266,6 +280,23 @@ Status CollectionOptions::parse(const BSONObj& options, ParseKind kind) {
         return Status(ErrorCodes::BadValue, "'pipeline' cannot be specified without 'viewOn'");
     }
 
+    if (clustered) {
+        if (capped) {
+            return Status(ErrorCodes::BadValue, "a clustered collection cannot be capped");
+        }
+        if (autoIndexId == YES || !idIndex.isEmpty()) {
+            return Status(ErrorCodes::BadValue, "a clustered collection cannot have an _id index");
+        }
+        if (!viewOn.empty()) {
+            return Status(ErrorCodes::BadValue, "a view cannot be clustered");
+        }
+    }
+
+    if (!timeseries.isEmpty() && (capped || clustered)) {
+        return Status(ErrorCodes::BadValue,
+                      "a time-series collection cannot be capped or clustered");
+    }
+
     return Status::OK();
 }
 
@@ -302,6 +333,9 @@ void CollectionOptions::appendBSON(BSONObjBuilder* builder) const {
     if (temp)
         builder->appendBool("temp", true);
 
+    if (clustered)
+        builder->appendBool("clustered", true);
+
     if (!storageEngine.isEmpty()) {
         builder->append("storageEngine", storageEngine);
     }
@@ -334,6 +368,10 @@ void CollectionOptions::appendBSON(BSONObjBuilder* builder) const {
         builder->appendArray("pipeline", pipeline);
     }
 
+    if (!timeseries.isEmpty()) {
+        builder->append("timeseries", timeseries);
+    }
+
     if (!idIndex.isEmpty()) {
         builder->append("idIndex", idIndex);
     }
@@ -383,6 +421,10 @@ bool CollectionOptions::matchesStorageOptions(const CollectionOptions& other,
         return false;
     }
 
+    if (clustered != other.clustered) {
+        return false;
+    }
+
     if (storageEngine.woCompare(other.storageEngine) != 0) {
         return false;
     }
@@ -423,6 +465,10 @@ bool CollectionOptions::matchesStorageOptions(const CollectionOptions& other,
         return false;
     }
 
+    if (timeseries.woCompare(other.timeseries) != 0) {
+        return false;
+    }
+
     return true;
 }
 }
@@ -126,6 +126,9 @@ struct CollectionOptions {
 
     bool temp = false;
 
+    // Whether the documents are stored keyed by their _id, in place of an _id index.
+    bool clustered = false;
+
     // Storage engine collection options. Always owned or empty.
     BSONObj storageEngine;
 
@@ -149,5 +152,9 @@ struct CollectionOptions {
     std::string viewOn;
     // The aggregation pipeline that defines this view.
     BSONObj pipeline;
+
+    // The options of a time-series collection, stored both on the view through which it is read
+    // and on the collection of its buckets. Always owned or empty.
+    BSONObj timeseries;
 };
 }
@@ -252,6 +252,50 @@ TEST(CollectionOptions, PipelineFieldRequiresViewOn) {
     ASSERT_NOT_OK(options.parse(fromjson("{pipeline: [{$match: {}}]}")));
 }
 
+TEST(CollectionOptions, ClusteredRoundTrip) {
+    CollectionOptions options;
+    ASSERT_OK(options.parse(fromjson("{clustered: true}")));
+    ASSERT(options.clustered);
+    ASSERT_BSONOBJ_EQ(options.toBSON(), fromjson("{clustered: true}"));
+
+    CollectionOptions unclustered;
+    ASSERT_FALSE(options.matchesStorageOptions(unclustered, nullptr));
+}
+
+TEST(CollectionOptions, ClusteredCannotBeCappedOrHaveIdIndex) {
+    CollectionOptions options;
+    ASSERT_NOT_OK(options.parse(fromjson("{clustered: true, capped: true, size: 4096}")));
+    ASSERT_NOT_OK(options.parse(fromjson("{clustered: true, autoIndexId: true}")));
+    ASSERT_NOT_OK(options.parse(fromjson("{clustered: true, idIndex: {key: {_id: 1}}}")));
+    ASSERT_OK(options.parse(fromjson("{clustered: true, autoIndexId: false}")));
+}
+
+TEST(CollectionOptions, TimeseriesRoundTripWithDefaults) {
+    CollectionOptions options;
+    ASSERT_OK(options.parse(fromjson("{timeseries: {timeField: 't', metaField: 'm'}}")));
+    ASSERT_BSONOBJ_EQ(fromjson("{timeField: 't', metaField: 'm', bucketMaxSpanSeconds: 3600}"),
+                      options.timeseries);
+
+    CollectionOptions roundTripped;
+    ASSERT_OK(roundTripped.parse(options.toBSON()));
+    ASSERT_BSONOBJ_EQ(options.toBSON(), roundTripped.toBSON());
+}
+
+TEST(CollectionOptions, InvalidTimeseriesOptionsFailToParse) {
+    CollectionOptions options;
+    ASSERT_NOT_OK(options.parse(fromjson("{timeseries: 1}")));
+    ASSERT_NOT_OK(options.parse(fromjson("{timeseries: {}}")));
+    ASSERT_NOT_OK(options.parse(fromjson("{timeseries: {timeField: 1}}")));
+    ASSERT_NOT_OK(options.parse(fromjson("{timeseries: {timeField: 'a.b'}}")));
+    ASSERT_NOT_OK(options.parse(fromjson("{timeseries: {timeField: '_id'}}")));
+    ASSERT_NOT_OK(options.parse(fromjson("{timeseries: {timeField: 't', metaField: 't'}}")));
+    ASSERT_NOT_OK(options.parse(fromjson("{timeseries: {timeField: 't', other: 1}}")));
+    ASSERT_NOT_OK(
+        options.parse(fromjson("{timeseries: {timeField: 't', bucketMaxSpanSeconds: 0}}")));
+    ASSERT_NOT_OK(
+        options.parse(fromjson("{timeseries: {timeField: 't'}, capped: true, size: 4096}")));
+}
+
 TEST(CollectionOptions, UnknownTopLevelOptionFailsToParse) {
     CollectionOptions options;
     auto status = options.parse(fromjson("{invalidOption: 1}"));
@@ -44,11 +44,59 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/ops/insert.h"
 #include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/timeseries/timeseries_options.h"
 #include "mongo/logger/redaction.h"
 #include "mongo/util/log.h"
 
 namespace mongo {
 namespace {
+/**
+ * Creates a time-series collection 'nss': the bucket collection 'system.buckets.<coll>' holds the
+ * data and 'nss' itself is a view that unpacks the buckets back into measurements. Both are
+ * created in the caller's WriteUnitOfWork.
+ */
+Status createTimeseries(OperationContext* opCtx,
+                        Database* db,
+                        const NamespaceString& nss,
+                        const CollectionOptions& collectionOptions) {
+    if (collectionOptions.isView()) {
+        return {ErrorCodes::InvalidOptions,
+                "The 'timeseries' option cannot be combined with 'viewOn' or 'pipeline'"};
+    }
+    if (nss.isSystem()) {
+        return {ErrorCodes::InvalidNamespace,
+                str::stream() << "Cannot create a time-series collection in a system namespace: "
+                              << nss.ns()};
+    }
+
+    const auto bucketsNss = nss.makeTimeseriesBucketsNamespace();
+    Status status = userAllowedCreateNS(bucketsNss.db(), bucketsNss.coll());
+    if (!status.isOK()) {
+        return status;
+    }
+
+    const bool createDefaultIndexes = true;
+    status = Database::userCreateNS(
+        opCtx, db, bucketsNss.ns(), collectionOptions, createDefaultIndexes, BSONObj());
+    if (!status.isOK()) {
+        return status;
+    }
+
+    CollectionOptions viewOptions;
+    viewOptions.viewOn = bucketsNss.coll().toString();
+    viewOptions.collation = collectionOptions.collation;
+    viewOptions.pipeline =
+        BSON_ARRAY(BSON("$_internalUnpackBucket" << collectionOptions.timeseries));
+    status = Database::userCreateNS(
+        opCtx, db, nss.ns(), std::move(viewOptions), createDefaultIndexes, BSONObj());
+    if (!status.isOK()) {
+        return status;
+    }
+
+    timeseries::noteTimeseriesBucketsCollection();
+    return Status::OK();
+}
+
 /**
  * Shared part of the implementation of the createCollection versions for replicated and regular
  * collection creation.
@@ -103,7 +151,9 @@ Status createCollection(OperationContext* opCtx,
             return status;
         }
 
-        if (collectionOptions.isView()) {
+        const bool isTimeseries =
+            !collectionOptions.timeseries.isEmpty() && !nss.isTimeseriesBucketsCollection();
+        if (collectionOptions.isView() || isTimeseries) {
             // If the `system.views` collection does not exist, create it in a separate
             // WriteUnitOfWork.
             WriteUnitOfWork wuow(opCtx);
@@ -113,6 +163,15 @@ Status createCollection(OperationContext* opCtx,
 
         WriteUnitOfWork wunit(opCtx);
 
+        if (isTimeseries) {
+            status = createTimeseries(opCtx, ctx.db(), nss, collectionOptions);
+            if (!status.isOK()) {
+                return status;
+            }
+            wunit.commit();
+            return Status::OK();
+        }
+
         // Create collection.
         const bool createDefaultIndexes = true;
         status = Database::userCreateNS(
@@ -459,7 +459,8 @@ Status DatabaseImpl::dropCollection(OperationContext* opCtx,
                 if (_profile != 0)
                     return Status(ErrorCodes::IllegalOperation,
                                   "turn off profiling before dropping system.profile collection");
-            } else if (!(nss.isSystemDotViews() || nss.isHealthlog() ||
+            } else if (!(nss.isSystemDotViews() || nss.isTimeseriesBucketsCollection() ||
+                         nss.isHealthlog() ||
                          nss == NamespaceString::kLogicalSessionsNamespace ||
                          nss == NamespaceString::kSystemKeysNamespace)) {
                 return Status(ErrorCodes::IllegalOperation,
@@ -743,6 +744,19 @@ void DatabaseImpl::_checkCanCreateCollection(OperationContext* opCtx,
 
     uassert(17316, "cannot create a blank collection", nss.coll() > 0);
     uassert(28838, "cannot create a non-capped oplog collection", options.capped || !nss.isOplog());
+    if (options.clustered) {
+        uassert(ErrorCodes::InvalidOptions,
+                "the storage engine does not support clustered collections",
+                opCtx->getServiceContext()->getStorageEngine()->supportsClusteredCollections());
+        uassert(ErrorCodes::InvalidOptions,
+                "clustered collections are not supported in this featureCompatibilityVersion",
+                !serverGlobalParams.featureCompatibility.isVersionInitialized() ||
+                    serverGlobalParams.featureCompatibility.getVersion() ==
+                        ServerGlobalParams::FeatureCompatibility::Version::kFullyUpgradedTo42);
+        uassert(ErrorCodes::InvalidOptions,
+                "a system collection cannot be clustered",
+                !nss.isSystem() && !nss.isOnInternalDb());
+    }
     uassert(ErrorCodes::DatabaseDropPending,
             str::stream() << "Cannot create collection " << nss.ns()
                           << " - database is in the process of being dropped.",
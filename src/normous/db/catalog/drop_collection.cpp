@@ -42,6 +42,7 @@
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/server_options.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/timeseries/bucket_catalog.h"
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/util/log.h"
 
@@ -106,6 +107,18 @@ Status dropCollection(OperationContext* opCtx,
             if (!status.isOK()) {
                 return status;
             }
+
+            // Dropping the view of a time-series collection drops its bucket collection too. On
+            // secondaries the bucket collection drop is replicated as its own oplog entry.
+            const auto bucketsNss = collectionName.makeTimeseriesBucketsNamespace();
+            if (opCtx->writesAreReplicated() && view->viewOn() == bucketsNss &&
+                db->getCollection(opCtx, bucketsNss)) {
+                status = db->dropCollectionEvenIfSystem(opCtx, bucketsNss, dropOpTime);
+                if (!status.isOK()) {
+                    return status;
+                }
+                timeseries::BucketCatalog::get(opCtx->getServiceContext()).clear(bucketsNss);
+            }
         }
         wunit.commit();
 
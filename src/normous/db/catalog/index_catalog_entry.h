@@ -29,6 +29,7 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <memory>
 #include <string>
 
 #include "mongo/base/owned_pointer_vector.h"
@@ -49,6 +50,8 @@ class CollectionInfoCache;
 class HeadManager;
 class IndexAccessMethod;
 class IndexDescriptor;
+class IndexKeyHistogram;
+class IndexRangeCountCache;
 class MatchExpression;
 class OperationContext;
 
@@ -141,6 +144,20 @@ public:
     virtual boost::optional<Timestamp> getMinimumVisibleSnapshot() = 0;
 
     virtual void setMinimumVisibleSnapshot(const Timestamp name) = 0;
+
+    /**
+     * Returns the statistics about the keys of this index gathered when it was last built, or
+     * nullptr if there are none.
+     */
+    virtual std::shared_ptr<const IndexKeyHistogram> getKeyHistogram() const = 0;
+
+    virtual void setKeyHistogram(std::shared_ptr<const IndexKeyHistogram> histogram) = 0;
+
+    /**
+     * Returns the cache of key counts over ranges of this index, or nullptr if counts are not
+     * cached. The cache is thread-safe.
+     */
+    virtual IndexRangeCountCache* getRangeCountCache() const = 0;
 };
 
 class IndexCatalogEntryContainer {
@@ -42,11 +42,13 @@
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/index/index_access_method.h"
 #include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/index/index_range_count_cache.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/multi_key_path_tracker.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/query/collation/collator_factory_interface.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/transaction_participant.h"
 #include "mongo/stdx/memory.h"
@@ -93,6 +95,10 @@ IndexCatalogEntryImpl::IndexCatalogEntryImpl(OperationContext* const opCtx,
     _isReady = _catalogIsReady(opCtx);
     _head = _catalogHead(opCtx);
 
+    if (internalQueryCountScanCacheSize > 0) {
+        _rangeCountCache = std::make_shared<IndexRangeCountCache>(internalQueryCountScanCacheSize);
+    }
+
     {
         stdx::lock_guard<stdx::mutex> lk(_indexMultikeyPathsMutex);
         _isMultikey.store(_catalogIsMultikey(opCtx, &_indexMultikeyPaths));
@@ -168,6 +168,20 @@ public:
         _minVisibleSnapshot = name;
     }
 
+    std::shared_ptr<const IndexKeyHistogram> getKeyHistogram() const final {
+        stdx::lock_guard<stdx::mutex> lk(_keyHistogramMutex);
+        return _keyHistogram;
+    }
+
+    void setKeyHistogram(std::shared_ptr<const IndexKeyHistogram> histogram) final {
+        stdx::lock_guard<stdx::mutex> lk(_keyHistogramMutex);
+        _keyHistogram = std::move(histogram);
+    }
+
+    IndexRangeCountCache* getRangeCountCache() const final {
+        return _rangeCountCache.get();
+    }
+
 private:
     class SetMultikeyChange;
     class SetHeadChange;
@@ -236,5 +250,14 @@ private:
 
     // The earliest snapshot that is allowed to read this index.
     boost::optional<Timestamp> _minVisibleSnapshot;
+
+    // Statistics about the keys of this index, which are read by query planning while holding
+    // only an intent lock on the collection.
+    mutable stdx::mutex _keyHistogramMutex;
+    std::shared_ptr<const IndexKeyHistogram> _keyHistogram;
+
+    // Null unless 'internalQueryCountScanCacheSize' is positive. Shared with the recovery unit
+    // changes which invalidate it when writes to this index commit or roll back.
+    std::shared_ptr<IndexRangeCountCache> _rangeCountCache;
 };
 }  // namespace mongo
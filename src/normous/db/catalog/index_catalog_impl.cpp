@@ -64,12 +64,15 @@
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/storage_engine_init.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/represent_as.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -85,6 +88,68 @@ static const int INDEX_CATALOG_UNINIT = 654321;
 
 const BSONObj IndexCatalogImpl::_idObj = BSON("_id" << 1);
 
+MONGO_EXPORT_SERVER_PARAMETER(maxInsertIndexKeyGenerationThreads, int, 1)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 1 || newVal > 64) {
+            return Status(ErrorCodes::BadValue,
+                          "maxInsertIndexKeyGenerationThreads must be between 1 and 64");
+        }
+        return Status::OK();
+    });
+
+namespace {
+
+// Index keys for a batch of inserted documents are only generated in parallel if the batch has at
+// least this many documents.
+const size_t kMinRecordsForParallelKeyGeneration = 16;
+
+// The keys of a batch of inserted documents are merged and inserted in index key order if the
+// batch has at least this many documents.
+const size_t kMinRecordsForKeyOrderInsertion = 2;
+
+// The keys getKeys() generated for one document on one index.
+struct GeneratedKeys {
+    BSONObjSet keys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+    BSONObjSet multikeyMetadataKeys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+    MultikeyPaths multikeyPaths;
+    Status status = Status::OK();
+};
+
+/**
+ * Inserts the keys generated for 'records' into 'index' in index key order. 'generatedKeys[j]'
+ * holds the keys of 'records[j]'. A document whose keys could not be generated throws, as
+ * getKeys() would have.
+ */
+Status insertGeneratedKeysInOrder(OperationContext* opCtx,
+                                  IndexCatalogEntry* index,
+                                  const InsertDeleteOptions& options,
+                                  const std::vector<BsonRecord>& records,
+                                  const std::vector<GeneratedKeys>& generatedKeys,
+                                  int64_t* keysInsertedOut) {
+    std::vector<IndexAccessMethod::DocumentKeys> documents;
+    documents.reserve(records.size());
+    for (size_t j = 0; j < records.size(); ++j) {
+        const GeneratedKeys& keys = generatedKeys[j];
+        uassertStatusOK(keys.status);
+        documents.push_back(
+            {&keys.keys, &keys.multikeyMetadataKeys, &keys.multikeyPaths, records[j].id,
+             records[j].ts});
+    }
+
+    int64_t inserted;
+    Status status =
+        index->accessMethod()->insertKeysInOrder(opCtx, documents, options, &inserted);
+    if (!status.isOK())
+        return status;
+
+    if (keysInsertedOut) {
+        *keysInsertedOut += inserted;
+    }
+    return Status::OK();
+}
+
+}  // namespace
+
 // -------------
 
 IndexCatalogImpl::IndexCatalogImpl(Collection* collection, int maxNumIndexesAllowed)
@@ -583,7 +648,7 @@ Status IndexCatalogImpl::_isSpecOk(OperationContext* opCtx, const BSONObj& spec)
 
     const bool isSparse = spec["sparse"].trueValue();
 
-    if (pluginName == IndexNames::WILDCARD) {
+    if (pluginName == IndexNames::WILDCARD || pluginName == IndexNames::COLUMN) {
         if (isSparse) {
             return Status(ErrorCodes::CannotCreateIndex,
                           str::stream() << "Index type '" << pluginName
@@ -603,6 +668,23 @@ Status IndexCatalogImpl::_isSpecOk(OperationContext* opCtx, const BSONObj& spec)
         }
     }
 
+    if (pluginName == IndexNames::COLUMN) {
+        // A columnstore index returns rows in place of documents, so it must store every document.
+        if (spec.getField("partialFilterExpression")) {
+            return Status(ErrorCodes::CannotCreateIndex,
+                          str::stream() << "Index type '" << pluginName
+                                        << "' cannot be a partial index");
+        }
+
+        // The rows of a columnstore index are identified by _id.
+        if (_collection->getCatalogEntry()->getCollectionOptions(opCtx).autoIndexId ==
+            CollectionOptions::NO) {
+            return Status(ErrorCodes::CannotCreateIndex,
+                          str::stream() << "Index type '" << pluginName
+                                        << "' requires the collection to have an _id index");
+        }
+    }
+
     // Ensure if there is a filter, its valid.
     BSONElement filterElement = spec.getField("partialFilterExpression");
     if (filterElement) {
@@ -1221,6 +1303,20 @@ Status IndexCatalogImpl::_indexFilteredRecords(OperationContext* opCtx,
     InsertDeleteOptions options;
     prepareInsertDeleteOptions(opCtx, index->descriptor(), &options);
 
+    if (bsonRecords.size() >= kMinRecordsForKeyOrderInsertion) {
+        std::vector<GeneratedKeys> generatedKeys(bsonRecords.size());
+        for (size_t j = 0; j < bsonRecords.size(); ++j) {
+            GeneratedKeys& keys = generatedKeys[j];
+            index->accessMethod()->getKeys(*bsonRecords[j].docPtr,
+                                           options.getKeysMode,
+                                           &keys.keys,
+                                           &keys.multikeyMetadataKeys,
+                                           &keys.multikeyPaths);
+        }
+        return insertGeneratedKeysInOrder(
+            opCtx, index, options, bsonRecords, generatedKeys, keysInsertedOut);
+    }
+
     for (auto bsonRecord : bsonRecords) {
         int64_t inserted;
         invariant(bsonRecord.id != RecordId());
@@ -1294,6 +1390,78 @@ Status IndexCatalogImpl::_unindexRecord(OperationContext* opCtx,
 }
 
 
+Status IndexCatalogImpl::_indexRecordsWithParallelKeyGeneration(
+    OperationContext* opCtx,
+    const std::vector<BsonRecord>& bsonRecords,
+    size_t numThreads,
+    int64_t* keysInsertedOut) {
+    std::vector<IndexCatalogEntry*> entries;
+    for (auto&& entry : _entries) {
+        entries.push_back(entry.get());
+    }
+
+    // Options and partial index filters are evaluated here, since they may need the
+    // OperationContext.
+    std::vector<InsertDeleteOptions> options(entries.size());
+    std::vector<std::vector<BsonRecord>> records(entries.size());
+    std::vector<std::vector<GeneratedKeys>> generatedKeys(entries.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+        prepareInsertDeleteOptions(opCtx, entries[i]->descriptor(), &options[i]);
+        const MatchExpression* filter = entries[i]->getFilterExpression();
+        for (auto&& bsonRecord : bsonRecords) {
+            if (!filter || filter->matchesBSON(*bsonRecord.docPtr)) {
+                records[i].push_back(bsonRecord);
+            }
+        }
+        generatedKeys[i].resize(records[i].size());
+    }
+
+    // Generating keys only reads the documents and the index specifications, so each thread can
+    // generate the keys of its share of the indexes. Failures are reported when the keys are
+    // inserted, in the order in which inserting would have hit them.
+    auto generateKeys = [&](size_t firstIndex) {
+        for (size_t i = firstIndex; i < entries.size(); i += numThreads) {
+            const IndexAccessMethod* accessMethod = entries[i]->accessMethod();
+            for (size_t j = 0; j < records[i].size(); ++j) {
+                GeneratedKeys& keys = generatedKeys[i][j];
+                try {
+                    accessMethod->getKeys(*records[i][j].docPtr,
+                                          options[i].getKeysMode,
+                                          &keys.keys,
+                                          &keys.multikeyMetadataKeys,
+                                          &keys.multikeyPaths);
+                } catch (...) {
+                    keys.status = exceptionToStatus();
+                    break;
+                }
+            }
+        }
+    };
+
+    std::vector<stdx::thread> threads;
+    auto joinThreads = MakeGuard([&] {
+        for (auto&& thread : threads) {
+            thread.join();
+        }
+    });
+    for (size_t t = 1; t < numThreads; ++t) {
+        threads.emplace_back([&generateKeys, t] { generateKeys(t); });
+    }
+    generateKeys(0);
+    joinThreads.Dismiss();
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+
+    for (size_t i = 0; i < entries.size(); ++i) {
+        Status status = insertGeneratedKeysInOrder(
+            opCtx, entries[i], options[i], records[i], generatedKeys[i], keysInsertedOut);
+        if (!status.isOK())
+            return status;
+    }
+    return Status::OK();
+}
+
 Status IndexCatalogImpl::indexRecords(OperationContext* opCtx,
                                       const std::vector<BsonRecord>& bsonRecords,
                                       int64_t* keysInsertedOut) {
@@ -1301,6 +1469,14 @@ Status IndexCatalogImpl::indexRecords(OperationContext* opCtx,
         *keysInsertedOut = 0;
     }
 
+    const size_t numThreads = std::min(
+        static_cast<size_t>(maxInsertIndexKeyGenerationThreads.load()),
+        static_cast<size_t>(_entries.size()));
+    if (numThreads > 1 && bsonRecords.size() >= kMinRecordsForParallelKeyGeneration) {
+        return _indexRecordsWithParallelKeyGeneration(
+            opCtx, bsonRecords, numThreads, keysInsertedOut);
+    }
+
     for (IndexCatalogEntryContainer::const_iterator i = _entries.begin(); i != _entries.end();
          ++i) {
         Status s = _indexRecords(opCtx, i->get(), bsonRecords, keysInsertedOut);
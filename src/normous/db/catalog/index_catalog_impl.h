@@ -39,6 +39,7 @@
 #include "mongo/db/record_id.h"
 #include "mongo/db/server_options.h"
 #include "mongo/db/storage/record_store.h"
+#include "mongo/platform/atomic_word.h"
 
 namespace mongo {
 
@@ -49,6 +50,11 @@ class IndexDescriptor;
 class IndexAccessMethod;
 struct InsertDeleteOptions;
 
+/**
+ * The maximum number of threads the index keys of a batch of inserted documents are generated on.
+ */
+extern AtomicInt32 maxInsertIndexKeyGenerationThreads;
+
 /**
  * how many: 1 per Collection.
  * lifecycle: attached to a Collection.
@@ -363,6 +369,15 @@ private:
                          const std::vector<BsonRecord>& bsonRecords,
                          int64_t* keysInsertedOut);
 
+    /**
+     * Like indexRecords(), but generates the keys of the indexes on 'numThreads' threads before
+     * inserting them on this one.
+     */
+    Status _indexRecordsWithParallelKeyGeneration(OperationContext* opCtx,
+                                                  const std::vector<BsonRecord>& bsonRecords,
+                                                  size_t numThreads,
+                                                  int64_t* keysInsertedOut);
+
     Status _unindexRecord(OperationContext* opCtx,
                           IndexCatalogEntry* index,
                           const BSONObj& obj,
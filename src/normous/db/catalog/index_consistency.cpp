@@ -104,6 +104,47 @@ IndexConsistency::IndexConsistency(OperationContext* opCtx,
     }
 }
 
+IndexConsistency::IndexConsistency(OperationContext* opCtx, IndexConsistency* parent)
+    : _opCtx(opCtx),
+      _collection(parent->_collection),
+      _nss(parent->_nss),
+      _recordStore(parent->_recordStore),
+      _tracker(opCtx->getServiceContext()->getFastClockSource(),
+               internalQueryExecYieldIterations.load(),
+               Milliseconds(internalQueryExecYieldPeriodMS.load())),
+      _parent(parent) {
+    stdx::lock_guard<stdx::mutex> lock(parent->_classMutex);
+    _indexNumber = parent->_indexNumber;
+    for (const auto& entry : parent->_indexesInfo) {
+        IndexInfo indexInfo;
+        indexInfo.isReady = entry.second.isReady;
+        indexInfo.indexNsHash = entry.second.indexNsHash;
+        indexInfo.indexScanFinished = false;
+        indexInfo.numKeys = 0;
+        indexInfo.numLongKeys = 0;
+        indexInfo.numRecords = 0;
+        indexInfo.numExtraIndexKeys = 0;
+        _indexesInfo[entry.first] = indexInfo;
+    }
+}
+
+void IndexConsistency::merge(const IndexConsistency& other) {
+    invariant(other._parent == this);
+
+    stdx::lock_guard<stdx::mutex> lock(_classMutex);
+    stdx::lock_guard<stdx::mutex> otherLock(other._classMutex);
+    for (const auto& bucket : other._indexKeyCount) {
+        _indexKeyCount[bucket.first] += bucket.second;
+    }
+    for (const auto& entry : other._indexesInfo) {
+        IndexInfo& indexInfo = _indexesInfo.at(entry.first);
+        indexInfo.numKeys += entry.second.numKeys;
+        indexInfo.numLongKeys += entry.second.numLongKeys;
+        indexInfo.numRecords += entry.second.numRecords;
+        indexInfo.numExtraIndexKeys += entry.second.numExtraIndexKeys;
+    }
+}
+
 void IndexConsistency::addDocKey(const KeyString& ks, int indexNumber) {
 
     if (indexNumber < 0 || indexNumber >= static_cast<int>(_indexesInfo.size())) {
@@ -125,6 +166,9 @@ void IndexConsistency::addIndexKey(const KeyString& ks, int indexNumber) {
 }
 
 void IndexConsistency::addMultikeyMetadataPath(const KeyString& ks, int indexNumber) {
+    if (_parent) {
+        return _parent->addMultikeyMetadataPath(ks, indexNumber);
+    }
     if (indexNumber < 0) {
         return;
     }
@@ -135,6 +179,9 @@ void IndexConsistency::addMultikeyMetadataPath(const KeyString& ks, int indexNum
 }
 
 void IndexConsistency::removeMultikeyMetadataPath(const KeyString& ks, int indexNumber) {
+    if (_parent) {
+        return _parent->removeMultikeyMetadataPath(ks, indexNumber);
+    }
     if (indexNumber < 0) {
         return;
     }
@@ -145,6 +192,9 @@ void IndexConsistency::removeMultikeyMetadataPath(const KeyString& ks, int index
 }
 
 size_t IndexConsistency::getMultikeyMetadataPathCount(int indexNumber) {
+    if (_parent) {
+        return _parent->getMultikeyMetadataPathCount(indexNumber);
+    }
     if (indexNumber < 0) {
         return 0;
     }
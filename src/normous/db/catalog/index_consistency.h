@@ -92,6 +92,21 @@ public:
                      std::unique_ptr<Lock::CollectionLock> collLk,
                      const bool background);
 
+    /**
+     * Constructs an IndexConsistency that tracks the same indexes as 'parent', starting with no
+     * keys. It is meant for a thread validating part of the collection on its own, whose counts
+     * are then added to the parent's with merge(). Multikey metadata paths are tracked by the
+     * parent directly, since the paths added for documents and removed for index entries must meet
+     * in one set.
+     */
+    IndexConsistency(OperationContext* opCtx, IndexConsistency* parent);
+
+    /**
+     * Adds the key counts and statistics gathered by 'other', which must have been constructed
+     * with this IndexConsistency as its parent.
+     */
+    void merge(const IndexConsistency& other);
+
     /**
      * Helper functions for `_addDocKey` and `_addIndexKey` for concurrency control.
      */
@@ -171,6 +186,10 @@ private:
     std::unique_ptr<Lock::CollectionLock> _collLk;
     ElapsedTracker _tracker;
 
+    // The IndexConsistency whose counts this one's are merged into, or null if this is not a
+    // partial IndexConsistency.
+    IndexConsistency* const _parent = nullptr;
+
     // We map the hashed KeyString values to a bucket which contain the count of how many
     // index keys and document keys we've seen in each bucket.
     // Count rules:
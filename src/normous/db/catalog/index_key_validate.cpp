@@ -38,6 +38,7 @@
 #include "mongo/base/status.h"
 #include "mongo/base/status_with.h"
 #include "mongo/db/field_ref.h"
+#include "mongo/db/hasher.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index/wildcard_key_generator.h"
 #include "mongo/db/index_names.h"
@@ -80,6 +81,7 @@ static std::set<StringData> allowedFieldNames = {
     IndexDescriptor::kDropDuplicatesFieldName,
     IndexDescriptor::kExpireAfterSecondsFieldName,
     IndexDescriptor::kGeoHaystackBucketSize,
+    IndexDescriptor::kHashVersionFieldName,
     IndexDescriptor::kIndexNameFieldName,
     IndexDescriptor::kIndexVersionFieldName,
     IndexDescriptor::kKeyPatternFieldName,
@@ -135,7 +137,7 @@ Status validateKeyPattern(const BSONObj& key, IndexDescriptor::IndexVersion inde
                                           << static_cast<int>(indexVersion)};
                 }
 
-                if (pluginName == IndexNames::WILDCARD) {
+                if (pluginName == IndexNames::WILDCARD || pluginName == IndexNames::COLUMN) {
                     return {code,
                             str::stream() << "'" << pluginName
                                           << "' index plugin is not allowed with index version v:"
@@ -182,6 +184,22 @@ Status validateKeyPattern(const BSONObj& key, IndexDescriptor::IndexVersion inde
             return Status(code, "wildcard indexes do not allow compounding");
         }
 
+        // Every field of a columnstore index is a column, so they must all be marked as such.
+        if (pluginName == IndexNames::COLUMN) {
+            if (keyElement.type() != String) {
+                return Status(code,
+                              str::stream() << "All values in a '" << IndexNames::COLUMN
+                                            << "' index key pattern must be '"
+                                            << IndexNames::COLUMN
+                                            << "'");
+            }
+            if (keyElement.fieldNameStringData() == "$**" && key.nFields() != 1) {
+                return Status(code,
+                              str::stream() << "A '" << IndexNames::COLUMN
+                                            << "' index on '$**' cannot list other fields");
+            }
+        }
+
         // Ensure that the fields on which we are building the index are valid: a field must not
         // begin with a '$' unless it is part of a wildcard, DBRef or text index, and a field path
         // cannot contain an empty field. If a field cannot be created or updated, it should not be
@@ -194,11 +212,19 @@ Status validateKeyPattern(const BSONObj& key, IndexDescriptor::IndexVersion inde
             return Status(code, "Index keys cannot be an empty field.");
         }
 
-        // "$**" is acceptable for a text index or wildcard index.
+        // "$**" is acceptable for a text, wildcard or columnstore index.
         if (mongoutils::str::equals(keyElement.fieldName(), "$**") &&
-            ((keyElement.isNumber()) || (keyElement.valuestrsafe() == IndexNames::TEXT)))
+            ((keyElement.isNumber()) || (keyElement.valuestrsafe() == IndexNames::TEXT) ||
+             (keyElement.valuestrsafe() == IndexNames::COLUMN)))
             continue;
 
+        // A columnstore index stores the whole values of top-level fields.
+        if (pluginName == IndexNames::COLUMN && numParts != 1) {
+            return Status(code,
+                          str::stream() << "A '" << IndexNames::COLUMN
+                                        << "' index can only store top-level fields");
+        }
+
         if (mongoutils::str::equals(keyElement.fieldName(), "_fts") &&
             keyElement.valuestrsafe() != IndexNames::TEXT) {
             return Status(code, "Index key contains an illegal field name: '_fts'");
@@ -283,13 +309,13 @@ StatusWith<BSONObj> validateIndexSpec(
                 return keyPatternValidateStatus;
             }
 
+            const auto pluginName = IndexNames::findPluginName(
+                indexSpec.getObjectField(IndexDescriptor::kKeyPatternFieldName));
             if ((featureCompatibility.getVersion() <
                  ServerGlobalParams::FeatureCompatibility::Version::kFullyUpgradedTo42) &&
-                (IndexNames::findPluginName(indexSpec.getObjectField(
-                     IndexDescriptor::kKeyPatternFieldName)) == IndexNames::WILDCARD)) {
+                (pluginName == IndexNames::WILDCARD || pluginName == IndexNames::COLUMN)) {
                 return {ErrorCodes::CannotCreateIndex,
-                        mongoutils::str::stream() << "Unknown index plugin '"
-                                                  << IndexNames::WILDCARD
+                        mongoutils::str::stream() << "Unknown index plugin '" << pluginName
                                                   << "'"};
             }
             hasKeyPatternField = true;
@@ -434,6 +460,37 @@ StatusWith<BSONObj> validateIndexSpec(
                 return ex.toStatus(str::stream() << "Failed to parse: "
                                                  << IndexDescriptor::kPathProjectionFieldName);
             }
+        } else if (IndexDescriptor::kHashVersionFieldName == indexSpecElemFieldName) {
+            const auto key = indexSpec.getObjectField(IndexDescriptor::kKeyPatternFieldName);
+            if (IndexNames::findPluginName(key) != IndexNames::HASHED) {
+                return {ErrorCodes::BadValue,
+                        str::stream() << "The field '" << IndexDescriptor::kHashVersionFieldName
+                                      << "' is only allowed in a '"
+                                      << IndexNames::HASHED
+                                      << "' index"};
+            }
+            if (!indexSpecElem.isNumber()) {
+                return {ErrorCodes::TypeMismatch,
+                        str::stream() << "The field '" << IndexDescriptor::kHashVersionFieldName
+                                      << "' must be a number, but got "
+                                      << typeName(indexSpecElem.type())};
+            }
+
+            auto hashVersion = representAs<int>(indexSpecElem.number());
+            if (!hashVersion || !BSONElementHasher::isSupportedHashVersion(*hashVersion)) {
+                return {ErrorCodes::CannotCreateIndex,
+                        str::stream() << "Unsupported hash version: "
+                                      << indexSpecElem.toString(false, false)};
+            }
+
+            // Binaries older than 4.2 can only read hash version 0.
+            if (*hashVersion != BSONElementHasher::MD5_HASH_VERSION &&
+                featureCompatibility.getVersion() !=
+                    ServerGlobalParams::FeatureCompatibility::Version::kFullyUpgradedTo42) {
+                return {ErrorCodes::CannotCreateIndex,
+                        str::stream() << "Hash version " << *hashVersion
+                                      << " requires featureCompatibilityVersion 4.2"};
+            }
         } else {
             // We can assume field name is valid at this point. Validation of fieldname is handled
             // prior to this in validateIndexSpecFieldNames().
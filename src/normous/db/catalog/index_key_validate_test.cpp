@@ -284,6 +284,57 @@ TEST(IndexKeyValidateTest, KeyElementNameWildcardFailsWhenValueIsPluginNameWithV
     ASSERT_EQ(status, ErrorCodes::CannotCreateIndex);
 }
 
+TEST(IndexKeyValidateTest, ColumnStoreKeyPatternSucceeds) {
+    ASSERT_OK(validateKeyPattern(BSON("a"
+                                      << "columnstore"
+                                      << "b"
+                                      << "columnstore"),
+                                 IndexVersion::kV2));
+    ASSERT_OK(validateKeyPattern(BSON("$**"
+                                      << "columnstore"),
+                                 IndexVersion::kV2));
+}
+
+TEST(IndexKeyValidateTest, ColumnStoreKeyPatternFailsWithNonColumnField) {
+    ASSERT_EQ(ErrorCodes::CannotCreateIndex,
+              validateKeyPattern(BSON("a"
+                                      << "columnstore"
+                                      << "b"
+                                      << 1),
+                                 IndexVersion::kV2));
+    ASSERT_EQ(ErrorCodes::CannotCreateIndex,
+              validateKeyPattern(BSON("a" << 1 << "b"
+                                          << "columnstore"),
+                                 IndexVersion::kV2));
+}
+
+TEST(IndexKeyValidateTest, ColumnStoreKeyPatternFailsOnDottedField) {
+    ASSERT_EQ(ErrorCodes::CannotCreateIndex,
+              validateKeyPattern(BSON("a.b"
+                                      << "columnstore"),
+                                 IndexVersion::kV2));
+    ASSERT_EQ(ErrorCodes::CannotCreateIndex,
+              validateKeyPattern(BSON("a.$**"
+                                      << "columnstore"),
+                                 IndexVersion::kV2));
+}
+
+TEST(IndexKeyValidateTest, ColumnStoreKeyPatternFailsWhenAllFieldsIsCompounded) {
+    ASSERT_EQ(ErrorCodes::CannotCreateIndex,
+              validateKeyPattern(BSON("$**"
+                                      << "columnstore"
+                                      << "a"
+                                      << "columnstore"),
+                                 IndexVersion::kV2));
+}
+
+TEST(IndexKeyValidateTest, ColumnStoreKeyPatternFailsWithIndexVersionV1) {
+    ASSERT_EQ(ErrorCodes::CannotCreateIndex,
+              validateKeyPattern(BSON("a"
+                                      << "columnstore"),
+                                 IndexVersion::kV1));
+}
+
 }  // namespace
 
 }  // namespace mongo
@@ -977,5 +977,63 @@ TEST(IndexSpecWildcard, FailsWhenExclusionWithSubpath) {
     ASSERT_EQ(result.getStatus().code(), ErrorCodes::FailedToParse);
 }
 
+TEST(IndexSpecHashVersion, AcceptsSupportedHashVersions) {
+    EnsureFCV guard(ServerGlobalParams::FeatureCompatibility::Version::kFullyUpgradedTo42);
+    for (int hashVersion : {0, 1}) {
+        auto result = validateIndexSpec(kDefaultOpCtx,
+                                        BSON("key" << BSON("a"
+                                                           << "hashed")
+                                                   << "name"
+                                                   << "indexName"
+                                                   << "hashVersion"
+                                                   << hashVersion),
+                                        kTestNamespace,
+                                        serverGlobalParams.featureCompatibility);
+        ASSERT_OK(result.getStatus());
+    }
+}
+
+TEST(IndexSpecHashVersion, FailsWithUnknownHashVersion) {
+    EnsureFCV guard(ServerGlobalParams::FeatureCompatibility::Version::kFullyUpgradedTo42);
+    auto result = validateIndexSpec(kDefaultOpCtx,
+                                    BSON("key" << BSON("a"
+                                                       << "hashed")
+                                               << "name"
+                                               << "indexName"
+                                               << "hashVersion"
+                                               << 2),
+                                    kTestNamespace,
+                                    serverGlobalParams.featureCompatibility);
+    ASSERT_EQ(result.getStatus().code(), ErrorCodes::CannotCreateIndex);
+}
+
+TEST(IndexSpecHashVersion, FailsOnNonHashedIndex) {
+    EnsureFCV guard(ServerGlobalParams::FeatureCompatibility::Version::kFullyUpgradedTo42);
+    auto result = validateIndexSpec(kDefaultOpCtx,
+                                    BSON("key" << BSON("a" << 1) << "name"
+                                               << "indexName"
+                                               << "hashVersion"
+                                               << 1),
+                                    kTestNamespace,
+                                    serverGlobalParams.featureCompatibility);
+    ASSERT_EQ(result.getStatus().code(), ErrorCodes::BadValue);
+}
+
+TEST(IndexSpecHashVersion, FailsWithImproperFeatureCompatabilityVersion) {
+    EnsureFCV guard(ServerGlobalParams::FeatureCompatibility::Version::kFullyUpgradedTo42);
+    serverGlobalParams.featureCompatibility.setVersion(
+        ServerGlobalParams::FeatureCompatibility::Version::kUpgradingTo42);
+    auto result = validateIndexSpec(kDefaultOpCtx,
+                                    BSON("key" << BSON("a"
+                                                       << "hashed")
+                                               << "name"
+                                               << "indexName"
+                                               << "hashVersion"
+                                               << 1),
+                                    kTestNamespace,
+                                    serverGlobalParams.featureCompatibility);
+    ASSERT_EQ(result.getStatus().code(), ErrorCodes::CannotCreateIndex);
+}
+
 }  // namespace
 }  // namespace mongo
@@ -32,6 +32,8 @@
 
 #include "mongo/db/catalog/multi_index_block_impl.h"
 
+#include <algorithm>
+
 #include "mongo/base/error_codes.h"
 #include "mongo/base/init.h"
 #include "mongo/db/audit.h"
@@ -50,7 +52,9 @@
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/server_parameters.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/log.h"
@@ -95,6 +99,25 @@ public:
 
 } exportedMaxIndexBuildMemoryUsageParameter;
 
+MONGO_EXPORT_SERVER_PARAMETER(maxIndexBuildScanThreads, int, 1)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 1 || newVal > 64) {
+            return Status(ErrorCodes::BadValue,
+                          "maxIndexBuildScanThreads must be between 1 and 64");
+        }
+        return Status::OK();
+    });
+
+namespace {
+
+// A parallel scan uses at most one thread for every this many records in the collection.
+const long long kMinRecordsPerScanThread = 10000;
+
+// The number of RecordIds sampled per scanning thread to pick the boundaries of their ranges.
+const size_t kSamplesPerScanThread = 16;
+
+}  // namespace
+
 
 /**
  * On rollback sets MultiIndexBlockImpl::_needToCleanup to true.
@@ -235,6 +258,7 @@ StatusWith<std::vector<BSONObj>> MultiIndexBlockImpl::init(const std::vector<BSO
             static_cast<std::size_t>(maxIndexBuildMemoryUsageMegabytes.load()) * 1024 * 1024 /
             indexSpecs.size();
     }
+    _eachIndexBuildMaxMemoryUsageBytes = eachIndexBuildMaxMemoryUsageBytes;
 
     for (size_t i = 0; i < indexSpecs.size(); i++) {
         BSONObj info = indexSpecs[i];
@@ -347,6 +371,75 @@ Status MultiIndexBlockImpl::insertAllDocumentsInCollection() {
 
     unsigned long long n = 0;
 
+    const size_t numScanThreads = _numScanThreads();
+    Status scanStatus = numScanThreads > 1
+        ? _scanCollectionInParallel(numScanThreads, progress.get(), &n)
+        : _scanCollectionSerially(progress.get(), &n);
+    if (!scanStatus.isOK()) {
+        return scanStatus;
+    }
+
+    if (MONGO_FAIL_POINT(hangAfterStartingIndexBuildUnlocked)) {
+        // Unlock before hanging so replication recognizes we've completed.
+        Locker::LockSnapshot lockInfo;
+        invariant(_opCtx->lockState()->saveLockStateAndUnlock(&lockInfo));
+        while (MONGO_FAIL_POINT(hangAfterStartingIndexBuildUnlocked)) {
+            log() << "Hanging index build with no locks due to "
+                     "'hangAfterStartingIndexBuildUnlocked' failpoint";
+            sleepmillis(1000);
+        }
+
+        if (_buildInBackground) {
+            _opCtx->lockState()->restoreLockState(_opCtx, lockInfo);
+            _opCtx->recoveryUnit()->abandonSnapshot();
+            return Status(ErrorCodes::OperationFailed,
+                          "background index build aborted due to failpoint");
+        } else {
+            invariant(
+                !"the hangAfterStartingIndexBuildUnlocked failpoint can't be turned off for foreground index builds");
+        }
+    }
+
+    progress->finished();
+
+    Status ret = doneInserting();
+    if (!ret.isOK())
+        return ret;
+
+    log() << "build index done.  scanned " << n << " total records. " << t.seconds() << " secs";
+
+    return Status::OK();
+}
+
+size_t MultiIndexBlockImpl::_numScanThreads() const {
+    const size_t maxThreads = static_cast<size_t>(maxIndexBuildScanThreads.load());
+    if (maxThreads <= 1 || _buildInBackground || _indexes.empty()) {
+        return 1;
+    }
+
+    // The scanning threads read the collection without taking any locks of their own, relying on
+    // the exclusive lock held by a foreground build to keep it from changing underneath them. All
+    // they do with the documents is feed them to BulkBuilders.
+    for (auto&& index : _indexes) {
+        if (!index.bulk) {
+            return 1;
+        }
+    }
+
+    // The failpoints used to test index builds are only checked by the serial scan.
+    if (MONGO_FAIL_POINT(hangAfterStartingIndexBuild) ||
+        MONGO_FAIL_POINT(slowBackgroundIndexBuild) || MONGO_FAIL_POINT(hangBeforeIndexBuildOf) ||
+        MONGO_FAIL_POINT(hangAfterIndexBuildOf)) {
+        return 1;
+    }
+
+    const long long numRecords = _collection->numRecords(_opCtx);
+    const size_t threadsForSize = static_cast<size_t>(numRecords / kMinRecordsPerScanThread);
+    return std::max(size_t(1), std::min(maxThreads, threadsForSize));
+}
+
+Status MultiIndexBlockImpl::_scanCollectionSerially(ProgressMeter* progress,
+                                                    unsigned long long* n) {
     PlanExecutor::YieldPolicy yieldPolicy;
     if (_buildInBackground) {
         invariant(_allowInterruption);
@@ -409,7 +502,7 @@ Status MultiIndexBlockImpl::insertAllDocumentsInCollection() {
 
             // Go to the next document
             progress->hit();
-            n++;
+            (*n)++;
             retries = 0;
         } catch (const WriteConflictException&) {
             CurOp::get(_opCtx)->debug().additiveMetrics.incrementWriteConflicts(1);
@@ -432,35 +525,185 @@ Status MultiIndexBlockImpl::insertAllDocumentsInCollection() {
         return WorkingSetCommon::getMemberObjectStatus(objToIndex.value());
     }
 
-    if (MONGO_FAIL_POINT(hangAfterStartingIndexBuildUnlocked)) {
-        // Unlock before hanging so replication recognizes we've completed.
-        Locker::LockSnapshot lockInfo;
-        invariant(_opCtx->lockState()->saveLockStateAndUnlock(&lockInfo));
-        while (MONGO_FAIL_POINT(hangAfterStartingIndexBuildUnlocked)) {
-            log() << "Hanging index build with no locks due to "
-                     "'hangAfterStartingIndexBuildUnlocked' failpoint";
-            sleepmillis(1000);
+    return Status::OK();
+}
+
+Status MultiIndexBlockImpl::_scanCollectionInParallel(size_t numThreads,
+                                                      ProgressMeter* progress,
+                                                      unsigned long long* n) {
+    RecordStore* rs = _collection->getRecordStore();
+
+    // Split the collection into ranges holding roughly equal numbers of records, using a random
+    // sample of its RecordIds as the range boundaries.
+    std::vector<RecordId> boundaries;
+    {
+        auto randomCursor = rs->getRandomCursor(_opCtx);
+        if (!randomCursor) {
+            return _scanCollectionSerially(progress, n);
         }
 
-        if (_buildInBackground) {
-            _opCtx->lockState()->restoreLockState(_opCtx, lockInfo);
-            _opCtx->recoveryUnit()->abandonSnapshot();
-            return Status(ErrorCodes::OperationFailed,
-                          "background index build aborted due to failpoint");
-        } else {
-            invariant(
-                !"the hangAfterStartingIndexBuildUnlocked failpoint can't be turned off for foreground index builds");
+        std::vector<RecordId> sample;
+        for (size_t i = 0; i < numThreads * kSamplesPerScanThread; ++i) {
+            auto record = randomCursor->next();
+            if (!record) {
+                break;
+            }
+            sample.push_back(record->id);
+        }
+        std::sort(sample.begin(), sample.end());
+        sample.erase(std::unique(sample.begin(), sample.end()), sample.end());
+
+        for (size_t i = 1; i < numThreads && !sample.empty(); ++i) {
+            boundaries.push_back(sample[i * sample.size() / numThreads]);
         }
+        boundaries.erase(std::unique(boundaries.begin(), boundaries.end()), boundaries.end());
     }
 
-    progress->finished();
+    if (boundaries.empty()) {
+        return _scanCollectionSerially(progress, n);
+    }
 
-    Status ret = doneInserting();
-    if (!ret.isOK())
-        return ret;
+    struct ScanRange {
+        RecordId start;  // Null for the start of the collection.
+        RecordId end;    // Null for the end of the collection.
+        std::vector<std::unique_ptr<IndexAccessMethod::BulkBuilder>> bulks;
+        Status status = Status::OK();
+    };
+
+    std::vector<ScanRange> ranges(boundaries.size() + 1);
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        if (i > 0) {
+            ranges[i].start = boundaries[i - 1];
+        }
+        if (i < boundaries.size()) {
+            ranges[i].end = boundaries[i];
+        }
+        for (auto&& index : _indexes) {
+            ranges[i].bulks.push_back(
+                index.real->initiateBulk(_eachIndexBuildMaxMemoryUsageBytes / ranges.size()));
+        }
+    }
 
-    log() << "build index done.  scanned " << n << " total records. " << t.seconds() << " secs";
+    log() << "index build: scanning " << _collection->ns() << " on " << ranges.size()
+          << " threads";
+
+    AtomicWord<bool> abort(false);
+    AtomicUInt64 numScanned;
+
+    stdx::mutex mutex;
+    stdx::condition_variable scanFinished;
+    size_t numRunning = ranges.size();
+
+    auto scanRange = [&](ScanRange* range) {
+        ON_BLOCK_EXIT([&] {
+            stdx::lock_guard<stdx::mutex> lk(mutex);
+            --numRunning;
+            scanFinished.notify_all();
+        });
+
+        try {
+            Client::initThread("indexBuildScan");
+            auto opCtx = cc().makeOperationContext();
+            auto cursor = rs->getCursor(opCtx.get());
+
+            // Nothing else can write to the collection, so a write conflict can only come from the
+            // storage engine wanting us to release our snapshot.
+            auto advance = [&](bool first) {
+                while (true) {
+                    try {
+                        return first && !range->start.isNull() ? cursor->seekExact(range->start)
+                                                               : cursor->next();
+                    } catch (const WriteConflictException&) {
+                        cursor->save();
+                        opCtx->recoveryUnit()->abandonSnapshot();
+                        cursor->restore();
+                    }
+                }
+            };
+
+            for (auto record = advance(true);
+                 record && (range->end.isNull() || record->id < range->end);
+                 record = advance(false)) {
+                if (abort.loadRelaxed()) {
+                    return;
+                }
+
+                const BSONObj doc = record->data.toBson();
+                for (size_t i = 0; i < _indexes.size(); ++i) {
+                    if (_indexes[i].filterExpression &&
+                        !_indexes[i].filterExpression->matchesBSON(doc)) {
+                        continue;
+                    }
+
+                    Status status = range->bulks[i]->insert(
+                        opCtx.get(), doc, record->id, _indexes[i].options);
+                    if (!status.isOK()) {
+                        range->status = status;
+                        abort.store(true);
+                        return;
+                    }
+                }
+                numScanned.fetchAndAdd(1);
+            }
+        } catch (...) {
+            range->status = exceptionToStatus();
+            abort.store(true);
+        }
+    };
+
+    std::vector<stdx::thread> threads;
+    auto joinThreads = MakeGuard([&] {
+        abort.store(true);
+        for (auto&& thread : threads) {
+            thread.join();
+        }
+    });
+    for (auto&& range : ranges) {
+        threads.emplace_back([&scanRange, &range] { scanRange(&range); });
+    }
+
+    // Wait for the scans to finish, keeping the progress meter up to date and watching for
+    // interruption, which the scanning threads can't check for themselves.
+    Status interruptStatus = Status::OK();
+    {
+        stdx::unique_lock<stdx::mutex> lk(mutex);
+        unsigned long long reported = 0;
+        while (numRunning > 0) {
+            scanFinished.wait_for(lk, Milliseconds(100).toSystemDuration());
+
+            const unsigned long long scanned = numScanned.load();
+            progress->hit(static_cast<int>(scanned - reported));
+            reported = scanned;
+
+            if (_allowInterruption && interruptStatus.isOK()) {
+                interruptStatus = _opCtx->checkForInterruptNoAssert();
+                if (!interruptStatus.isOK()) {
+                    abort.store(true);
+                }
+            }
+        }
+    }
+    joinThreads.Dismiss();
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+
+    if (!interruptStatus.isOK()) {
+        return interruptStatus;
+    }
+    for (auto&& range : ranges) {
+        if (!range.status.isOK()) {
+            return range.status;
+        }
+    }
+
+    for (auto&& range : ranges) {
+        for (size_t i = 0; i < _indexes.size(); ++i) {
+            _indexes[i].bulk->addPartition(std::move(range.bulks[i]));
+        }
+    }
 
+    *n = numScanned.load();
     return Status::OK();
 }
 
@@ -41,6 +41,7 @@
 #include "mongo/db/catalog/index_catalog_impl.h"
 #include "mongo/db/index/index_access_method.h"
 #include "mongo/db/record_id.h"
+#include "mongo/platform/atomic_word.h"
 
 namespace mongo {
 
@@ -48,6 +49,12 @@ class BackgroundOperation;
 class BSONObj;
 class Collection;
 class OperationContext;
+class ProgressMeter;
+
+/**
+ * The maximum number of threads a foreground index build may scan the collection with.
+ */
+extern AtomicInt32 maxIndexBuildScanThreads;
 
 /**
  * Builds one or more indexes.
@@ -190,6 +197,28 @@ private:
     class SetNeedToCleanupOnRollback;
     class CleanupIndexesVectorOnRollback;
 
+    /**
+     * Returns how many threads insertAllDocumentsInCollection() should scan the collection with.
+     * Returns 1 unless this is a foreground build with every index using a BulkBuilder, and the
+     * collection is large enough to be worth splitting.
+     */
+    size_t _numScanThreads() const;
+
+    /**
+     * Feeds every document in the collection to the indexes, reading them on this thread.
+     */
+    Status _scanCollectionSerially(ProgressMeter* progress, unsigned long long* n);
+
+    /**
+     * Feeds every document in the collection to the indexes, splitting the collection into up to
+     * 'numThreads' ranges of RecordIds that are scanned concurrently. Each range fills its own
+     * BulkBuilders, which are handed to the indexes' BulkBuilders to be merged when the bulk
+     * builds are committed. Falls back to the serial scan if the collection can't be split.
+     */
+    Status _scanCollectionInParallel(size_t numThreads,
+                                     ProgressMeter* progress,
+                                     unsigned long long* n);
+
     struct IndexToBuild {
         std::unique_ptr<IndexCatalog::IndexBuildBlockInterface> block;
 
@@ -202,6 +231,9 @@ private:
 
     std::vector<IndexToBuild> _indexes;
 
+    // The memory budget given to each index's BulkBuilder.
+    std::size_t _eachIndexBuildMaxMemoryUsageBytes = 0;
+
     std::unique_ptr<BackgroundOperation> _backgroundOperation;
 
     // Pointers not owned here and must outlive 'this'
@@ -198,28 +198,45 @@ void RecordStoreValidateAdaptor::traverseIndex(const IndexAccessMethod* iam,
     *numTraversedKeys = numKeys;
 }
 
-void RecordStoreValidateAdaptor::traverseRecordStore(RecordStore* recordStore,
-                                                     ValidateCmdLevel level,
-                                                     ValidateResults* results,
-                                                     BSONObjBuilder* output) {
-    long long nrecords = 0;
-    long long dataSizeTotal = 0;
-    long long nInvalid = 0;
-
+long long RecordStoreValidateAdaptor::traverseRecordStore(RecordStore* recordStore,
+                                                          ValidateCmdLevel level,
+                                                          ValidateResults* results,
+                                                          BSONObjBuilder* output) {
+    TraversalStats stats;
     results->valid = true;
+    traverseRecordRange(recordStore, RecordId(), RecordId(), results, &stats);
+
+    // The record store's size statistics are not corrected from the counts, since writes may have
+    // happened concurrently with the traversal.
+    output->append("nInvalidDocuments", stats.nInvalid);
+    output->appendNumber("nrecords", stats.nrecords);
+    return stats.nrecords;
+}
+
+void RecordStoreValidateAdaptor::traverseRecordRange(RecordStore* recordStore,
+                                                     const RecordId& start,
+                                                     const RecordId& end,
+                                                     ValidateResults* results,
+                                                     TraversalStats* stats) {
     std::unique_ptr<SeekableRecordCursor> cursor = recordStore->getCursor(_opCtx, true);
     int interruptInterval = 4096;
     RecordId prevRecordId;
 
-    while (auto record = cursor->next()) {
-        ++nrecords;
+    auto record = start.isNull() ? cursor->next() : cursor->seekExact(start);
+    uassert(50991,
+            str::stream() << "Could not find the record " << start
+                          << " to start validating from",
+            start.isNull() || record);
+
+    for (; record && (end.isNull() || record->id < end); record = cursor->next()) {
+        ++stats->nrecords;
 
-        if (!(nrecords % interruptInterval)) {
+        if (!(stats->nrecords % interruptInterval)) {
             _opCtx->checkForInterrupt();
         }
 
         auto dataSize = record->data.size();
-        dataSizeTotal += dataSize;
+        stats->dataSizeTotal += dataSize;
         size_t validatedSize;
         Status status = validate(record->id, record->data, &validatedSize);
 
@@ -235,20 +252,13 @@ void RecordStoreValidateAdaptor::traverseRecordStore(RecordStore* recordStore,
                 // Only log once.
                 results->errors.push_back("detected one or more invalid documents (see logs)");
             }
-            nInvalid++;
+            stats->nInvalid++;
             results->valid = false;
             log() << "document at location: " << record->id << " is corrupted";
         }
 
         prevRecordId = record->id;
     }
-
-    if (results->valid) {
-        recordStore->updateStatsAfterRepair(_opCtx, nrecords, dataSizeTotal);
-    }
-
-    output->append("nInvalidDocuments", nInvalid);
-    output->appendNumber("nrecords", nrecords);
 }
 
 void RecordStoreValidateAdaptor::validateIndexKeyCount(IndexDescriptor* idx,
@@ -278,10 +288,11 @@ void RecordStoreValidateAdaptor::validateIndexKeyCount(IndexDescriptor* idx,
 
     // Confirm that the number of index entries is not greater than the number of documents in the
     // collection. This check is only valid for indexes that are not multikey (indexed arrays
-    // produce an index key per array entry) and not $** indexes which can produce index keys for
-    // multiple paths within a single document.
+    // produce an index key per array entry) and not $** or columnstore indexes which can produce
+    // index keys for multiple paths within a single document.
     if (results.valid && !idx->isMultikey(_opCtx) &&
-        idx->getIndexType() != IndexType::INDEX_WILDCARD && totalKeys > numRecs) {
+        idx->getIndexType() != IndexType::INDEX_WILDCARD &&
+        idx->getIndexType() != IndexType::INDEX_COLUMN && totalKeys > numRecs) {
         std::string err = str::stream()
             << "index " << idx->indexName() << " is not multi-key, but has more entries ("
             << numIndexedKeys << ") than documents in the index (" << numRecs - numLongKeys << ")";
@@ -50,6 +50,15 @@ using ValidateResultsMap = std::map<std::string, ValidateResults>;
  */
 class RecordStoreValidateAdaptor : public ValidateAdaptor {
 public:
+    /**
+     * The counts gathered while traversing records.
+     */
+    struct TraversalStats {
+        long long nrecords = 0;
+        long long dataSizeTotal = 0;
+        long long nInvalid = 0;
+    };
+
     RecordStoreValidateAdaptor(OperationContext* opCtx,
                                IndexConsistency* indexConsistency,
                                ValidateCmdLevel level,
@@ -79,12 +88,24 @@ public:
 
     /**
      * Traverses the record store to retrieve every record and go through its document key
-     * set to keep track of the index consistency during a validation.
+     * set to keep track of the index consistency during a validation. Returns the number of
+     * records traversed.
+     */
+    long long traverseRecordStore(RecordStore* recordStore,
+                                  ValidateCmdLevel level,
+                                  ValidateResults* results,
+                                  BSONObjBuilder* output);
+
+    /**
+     * Like traverseRecordStore(), but only for the records with RecordIds in ['start', 'end'),
+     * where a null bound stands for the corresponding end of the record store. A non-null 'start'
+     * must be the RecordId of a record. Adds the counts to 'stats' rather than reporting them.
      */
-    void traverseRecordStore(RecordStore* recordStore,
-                             ValidateCmdLevel level,
+    void traverseRecordRange(RecordStore* recordStore,
+                             const RecordId& start,
+                             const RecordId& end,
                              ValidateResults* results,
-                             BSONObjBuilder* output);
+                             TraversalStats* stats);
 
     /**
      * Validate that the number of document keys matches the number of index keys.
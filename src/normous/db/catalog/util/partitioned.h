@@ -37,6 +37,7 @@
 #include <vector>
 
 #include <boost/align/aligned_allocator.hpp>
+#include <boost/optional.hpp>
 
 #include "mongo/stdx/mutex.h"
 #include "mongo/util/assert_util.h"
@@ -128,8 +129,9 @@ inline std::vector<stdx::unique_lock<stdx::mutex>> lockAllPartitions(T& mutexes)
  * A templated class used to partition an associative container like a set or a map to increase
  * scalability. `AssociativeContainer` is a type like a std::map or std::set that meets the
  * requirements of either the AssociativeContainer or UnorderedAssociativeContainer concept.
- * `nPartitions` determines how many partitions to make. `Partitioner` can be provided to customize
- * how the partition of each entry is computed.
+ * `nPartitions` determines how many partitions to make, unless a different number is given at
+ * construction. `Partitioner` can be provided to customize how the partition of each entry is
+ * computed.
  */
 template <typename AssociativeContainer,
           std::size_t nPartitions = 16,
@@ -215,7 +217,7 @@ public:
          * Returns the number of entries with the given key.
          */
         std::size_t count(const key_type& key) const {
-            auto partitionId = KeyPartitioner()(key, nPartitions);
+            auto partitionId = KeyPartitioner()(key, this->_partitionedContainer->_nPartitions);
             return this->_partitionedContainer->_partitions[partitionId].count(key);
         }
 
@@ -232,8 +234,8 @@ public:
          * Inserts `value` into its designated partition.
          */
         void insert(value_type value) & {
-            const auto partitionId =
-                KeyPartitioner()(partitioned_detail::getKey(value), nPartitions);
+            const auto partitionId = KeyPartitioner()(partitioned_detail::getKey(value),
+                                                      this->_partitionedContainer->_nPartitions);
             this->_partitionedContainer->_partitions[partitionId].insert(std::move(value));
         }
         void insert(value_type)&& = delete;
@@ -242,7 +244,8 @@ public:
          * Erases one entry from the partitioned structure, returns the number of entries removed.
          */
         std::size_t erase(const key_type& key) & {
-            const auto partitionId = KeyPartitioner()(key, nPartitions);
+            const auto partitionId =
+                KeyPartitioner()(key, this->_partitionedContainer->_nPartitions);
             return this->_partitionedContainer->_partitions[partitionId].erase(key);
         }
         void erase(const key_type&) && = delete;
@@ -290,6 +293,15 @@ public:
               _partitioned(&partitioned),
               _id(partitionId) {}
 
+        /**
+         * Tries to acquire the lock for the ith partition without blocking. The caller must check
+         * '_partitionLock.owns_lock()'.
+         */
+        OnePartition(Partitioned& partitioned, PartitionId partitionId, stdx::try_to_lock_t)
+            : _partitionLock(partitioned._mutexes[partitionId], stdx::try_to_lock),
+              _partitioned(&partitioned),
+              _id(partitionId) {}
+
         stdx::unique_lock<stdx::mutex> _partitionLock;
         Partitioned* _partitioned;
         PartitionId _id;
@@ -298,7 +310,15 @@ public:
     /**
      * Constructs a partitioned version of a AssociativeContainer, with `nPartitions` partitions.
      */
-    Partitioned() : _mutexes(nPartitions), _partitions(nPartitions) {}
+    Partitioned() : Partitioned(nPartitions) {}
+
+    /**
+     * Constructs a partitioned version of a AssociativeContainer, with `numPartitions` partitions.
+     */
+    explicit Partitioned(std::size_t numPartitions)
+        : _nPartitions(numPartitions), _mutexes(numPartitions), _partitions(numPartitions) {
+        invariant(numPartitions > 0);
+    }
 
     Partitioned(const Partitioned&) = delete;
     Partitioned(Partitioned&&) = default;
@@ -354,7 +374,7 @@ public:
      */
     void insert(const value_type value) & {
         auto partition = this->lockOnePartitionById(
-            KeyPartitioner()(partitioned_detail::getKey(value), nPartitions));
+            KeyPartitioner()(partitioned_detail::getKey(value), _nPartitions));
         partition->insert(std::move(value));
     }
     void insert(const value_type) && = delete;
@@ -374,19 +394,40 @@ public:
     }
 
     OnePartition lockOnePartition(const key_type key) & {
-        return OnePartition{*this, KeyPartitioner()(key, nPartitions)};
+        return OnePartition{*this, KeyPartitioner()(key, _nPartitions)};
     }
 
     OnePartition lockOnePartitionById(PartitionId id) & {
         return OnePartition{*this, id};
     }
 
+    /**
+     * Like lockOnePartition(), but returns boost::none rather than block if another thread holds
+     * the partition's lock.
+     */
+    boost::optional<OnePartition> tryLockOnePartition(const key_type key) & {
+        OnePartition partition{*this, KeyPartitioner()(key, _nPartitions), stdx::try_to_lock};
+        if (!partition._partitionLock.owns_lock()) {
+            return boost::none;
+        }
+        return std::move(partition);
+    }
+
+    /**
+     * Returns the number of partitions.
+     */
+    std::size_t numPartitions() const {
+        return _nPartitions;
+    }
+
 private:
     using CacheAlignedAssociativeContainer = CacheAligned<AssociativeContainer>;
 
     template <typename T>
     using AlignedVector = std::vector<T, boost::alignment::aligned_allocator<T>>;
 
+    std::size_t _nPartitions;
+
     // These two vectors parallel each other, but we keep them separate so that we can return an
     // iterator over `_partitions` from within All.
     mutable AlignedVector<partitioned_detail::CacheAlignedMutex> _mutexes;
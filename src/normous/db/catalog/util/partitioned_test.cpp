@@ -164,6 +164,35 @@ TEST(PartitionedAll, ErasingEntryThatDoesNotExistShouldNotModifySize) {
     ASSERT_EQ(all.size(), 3UL);
 }
 
+TEST(Partitioned, PartitionCountCanBeChosenAtConstruction) {
+    PartitionedIntSet test(5);
+    ASSERT_EQ(test.numPartitions(), 5UL);
+    for (std::size_t value = 0; value < 10; ++value) {
+        test.insert(value);
+    }
+    ASSERT_EQ(test.size(), 10UL);
+    for (std::size_t partitionId = 0; partitionId < 5; ++partitionId) {
+        auto partition = test.lockOnePartitionById(partitionId);
+        ASSERT_EQ(partition->size(), 2UL);
+        ASSERT_EQ(partition->count(partitionId), 1UL);
+        ASSERT_EQ(partition->count(partitionId + 5), 1UL);
+    }
+}
+
+TEST(Partitioned, TryLockOnePartitionFailsOnlyForAHeldPartition) {
+    PartitionedIntSet test;
+    ASSERT_EQ(test.numPartitions(), nPartitions);
+    auto held = test.lockOnePartition(0);
+    stdx::thread([&test] {
+        ASSERT_FALSE(test.tryLockOnePartition(0));
+        ASSERT_FALSE(test.tryLockOnePartition(nPartitions));
+        auto other = test.tryLockOnePartition(1);
+        ASSERT_TRUE(other);
+        (*other)->insert(1);
+    }).join();
+    ASSERT_EQ(test.count(1), 1UL);
+}
+
 TEST(PartitionedConcurrency, ShouldBeAbleToGuardSeparatePartitionsSimultaneously) {
     PartitionedIntSet test;
     {
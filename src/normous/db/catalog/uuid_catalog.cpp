@@ -166,8 +166,11 @@ void UUIDCatalog::onCloseCatalog(OperationContext* opCtx) {
     stdx::lock_guard<stdx::mutex> lock(_catalogLock);
     invariant(!_shadowCatalog);
     _shadowCatalog.emplace();
-    for (auto entry : _catalog)
-        _shadowCatalog->insert({entry.first, entry.second->ns()});
+    auto allPartitions = _catalog.lockAllPartitions();
+    for (auto&& partition : allPartitions) {
+        for (auto&& entry : partition)
+            _shadowCatalog->insert({entry.first, entry.second->ns()});
+    }
 }
 
 void UUIDCatalog::onOpenCatalog(OperationContext* opCtx) {
@@ -178,16 +181,20 @@ void UUIDCatalog::onOpenCatalog(OperationContext* opCtx) {
 }
 
 Collection* UUIDCatalog::lookupCollectionByUUID(CollectionUUID uuid) const {
-    stdx::lock_guard<stdx::mutex> lock(_catalogLock);
-    auto foundIt = _catalog.find(uuid);
-    return foundIt == _catalog.end() ? nullptr : foundIt->second;
+    auto partition = _catalog.lockOnePartition(uuid);
+    auto foundIt = partition->find(uuid);
+    return foundIt == partition->end() ? nullptr : foundIt->second;
 }
 
 NamespaceString UUIDCatalog::lookupNSSByUUID(CollectionUUID uuid) const {
+    {
+        auto partition = _catalog.lockOnePartition(uuid);
+        auto foundIt = partition->find(uuid);
+        if (foundIt != partition->end())
+            return foundIt->second->ns();
+    }
+
     stdx::lock_guard<stdx::mutex> lock(_catalogLock);
-    auto foundIt = _catalog.find(uuid);
-    if (foundIt != _catalog.end())
-        return foundIt->second->ns();
 
     // Only in the case that the catalog is closed and a UUID is currently unknown, resolve it
     // using the pre-close state. This ensures that any tasks reloading the catalog can see their
@@ -203,9 +210,20 @@ NamespaceString UUIDCatalog::lookupNSSByUUID(CollectionUUID uuid) const {
 Collection* UUIDCatalog::replaceUUIDCatalogEntry(CollectionUUID uuid, Collection* coll) {
     stdx::lock_guard<stdx::mutex> lock(_catalogLock);
     invariant(coll);
-    Collection* oldColl = _removeUUIDCatalogEntry_inlock(uuid);
-    invariant(oldColl != nullptr);  // Need to replace an existing coll
-    _registerUUIDCatalogEntry_inlock(uuid, coll);
+
+    // Replace the entry in place, so that concurrent lookups never miss the UUID.
+    auto partition = _catalog.lockOnePartition(uuid);
+    auto foundIt = partition->find(uuid);
+    invariant(foundIt != partition->end());  // Need to replace an existing coll
+    Collection* oldColl = foundIt->second;
+
+    // Invalidate the orderings of both databases, since the UUID may move between them.
+    _orderedCollections.erase(oldColl->ns().db());
+    _orderedCollections.erase(coll->ns().db());
+
+    LOG(2) << "replacing collection " << oldColl->ns() << " with " << coll->ns() << " for UUID "
+           << uuid.toString();
+    foundIt->second = coll;
     return oldColl;
 }
 void UUIDCatalog::registerUUIDCatalogEntry(CollectionUUID uuid, Collection* coll) {
@@ -254,9 +272,12 @@ const std::vector<CollectionUUID>& UUIDCatalog::_getOrdering_inlock(
 
     // Otherwise, get all of the UUIDs for this database,
     auto& newOrdering = _orderedCollections[db];
-    for (const auto& pair : _catalog) {
-        if (pair.second->ns().db() == db) {
-            newOrdering.push_back(pair.first);
+    auto allPartitions = _catalog.lockAllPartitions();
+    for (auto&& partition : allPartitions) {
+        for (const auto& pair : partition) {
+            if (pair.second->ns().db() == db) {
+                newOrdering.push_back(pair.first);
+            }
         }
     }
 
@@ -266,18 +287,23 @@ const std::vector<CollectionUUID>& UUIDCatalog::_getOrdering_inlock(
     return newOrdering;
 }
 void UUIDCatalog::_registerUUIDCatalogEntry_inlock(CollectionUUID uuid, Collection* coll) {
-    if (coll && !_catalog.count(uuid)) {
+    if (!coll)
+        return;
+
+    auto partition = _catalog.lockOnePartition(uuid);
+    if (!partition->count(uuid)) {
         // Invalidate this database's ordering, since we're adding a new UUID.
         _orderedCollections.erase(coll->ns().db());
 
         std::pair<CollectionUUID, Collection*> entry = std::make_pair(uuid, coll);
         LOG(2) << "registering collection " << coll->ns() << " with UUID " << uuid.toString();
-        invariant(_catalog.insert(entry).second == true);
+        invariant(partition->insert(entry).second == true);
     }
 }
 Collection* UUIDCatalog::_removeUUIDCatalogEntry_inlock(CollectionUUID uuid) {
-    auto foundIt = _catalog.find(uuid);
-    if (foundIt == _catalog.end())
+    auto partition = _catalog.lockOnePartition(uuid);
+    auto foundIt = partition->find(uuid);
+    if (foundIt == partition->end())
         return nullptr;
 
     // Invalidate this database's ordering, since we're deleting a UUID.
@@ -285,7 +311,7 @@ Collection* UUIDCatalog::_removeUUIDCatalogEntry_inlock(CollectionUUID uuid) {
 
     auto foundCol = foundIt->second;
     LOG(2) << "unregistering collection " << foundCol->ns() << " with UUID " << uuid.toString();
-    _catalog.erase(foundIt);
+    partition->erase(foundIt);
     return foundCol;
 }
 }  // namespace mongo
@@ -32,9 +32,11 @@
 
 #include "mongo/base/disallow_copying.h"
 #include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/util/partitioned.h"
 #include "mongo/db/op_observer.h"
 #include "mongo/db/service_context.h"
 #include "mongo/stdx/functional.h"
+#include "mongo/stdx/unordered_map.h"
 #include "mongo/util/uuid.h"
 
 namespace mongo {
@@ -214,11 +216,26 @@ public:
     boost::optional<CollectionUUID> next(const StringData& db, CollectionUUID uuid);
 
 private:
+    struct UUIDPartitioner {
+        std::size_t operator()(const CollectionUUID& uuid, const std::size_t nPartitions) {
+            return CollectionUUID::Hash()(uuid) % nPartitions;
+        }
+    };
+
+    using CollectionMap =
+        Partitioned<stdx::unordered_map<CollectionUUID, Collection*, CollectionUUID::Hash>,
+                    16,
+                    UUIDPartitioner>;
+
     const std::vector<CollectionUUID>& _getOrdering_inlock(const StringData& db,
                                                            const stdx::lock_guard<stdx::mutex>&);
     void _registerUUIDCatalogEntry_inlock(CollectionUUID uuid, Collection* coll);
     Collection* _removeUUIDCatalogEntry_inlock(CollectionUUID uuid);
 
+    /**
+     * Protects '_shadowCatalog' and '_orderedCollections', and serializes changes to '_catalog'.
+     * Must be acquired before any partition of '_catalog'.
+     */
     mutable mongo::stdx::mutex _catalogLock;
     /**
      * When present, indicates that the catalog is in closed state, and contains a map from UUID
@@ -235,7 +252,12 @@ private:
      * not all databases are guaranteed to have an ordering in it.
      */
     StringMap<std::vector<CollectionUUID>> _orderedCollections;
-    mongo::stdx::unordered_map<CollectionUUID, Collection*, CollectionUUID::Hash> _catalog;
+
+    /**
+     * Map from UUID to collection. Lookups by UUID only lock the partition of that UUID, so that
+     * they neither wait for '_catalogLock' nor contend with lookups of other collections.
+     */
+    mutable CollectionMap _catalog;
 };
 
 }  // namespace mongo
@@ -32,6 +32,8 @@
 
 #include "mongo/db/catalog/collection_mock.h"
 #include "mongo/db/operation_context_noop.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
 
 using namespace mongo;
@@ -123,6 +125,54 @@ TEST_F(UUIDCatalogTest, OnRenameCollection) {
     ASSERT_EQUALS(catalog.lookupCollectionByUUID(oldUUID), &newCol);
 }
 
+TEST_F(UUIDCatalogTest, RenameAcrossDatabasesInvalidatesBothOrderings) {
+    NamespaceString nextNss(nss.db(), "nextcol");
+    Collection nextCol(stdx::make_unique<CollectionMock>(nextNss));
+    catalog.onCreateCollection(&opCtx, &nextCol, nextUUID);
+
+    // Cache the orderings of both databases.
+    ASSERT_EQUALS(*catalog.next(nss.db(), colUUID), nextUUID);
+    ASSERT_FALSE(catalog.next("otherdb", nextUUID));
+
+    NamespaceString otherNss("otherdb", "nextcol");
+    Collection otherCol(stdx::make_unique<CollectionMock>(otherNss));
+    catalog.onRenameCollection(&opCtx, &otherCol, nextUUID);
+
+    ASSERT_FALSE(catalog.next(nss.db(), colUUID));
+    ASSERT_FALSE(catalog.prev("otherdb", nextUUID));
+    ASSERT_FALSE(catalog.next("otherdb", nextUUID));
+    ASSERT_EQUALS(catalog.lookupNSSByUUID(nextUUID), otherNss);
+}
+
+TEST_F(UUIDCatalogTest, LookupsDuringRenamesNeverMissTheCollection) {
+    NamespaceString otherNss(nss.db(), "othercol");
+    Collection otherCol(stdx::make_unique<CollectionMock>(otherNss));
+
+    AtomicWord<bool> done{false};
+    AtomicWord<int> numMisses{0};
+    std::vector<stdx::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([&] {
+            while (!done.load()) {
+                if (!catalog.lookupCollectionByUUID(colUUID)) {
+                    numMisses.fetchAndAdd(1);
+                }
+            }
+        });
+    }
+
+    for (int i = 0; i < 10000; ++i) {
+        catalog.onRenameCollection(&opCtx, i % 2 ? &col : &otherCol, colUUID);
+    }
+    done.store(true);
+    for (auto&& reader : readers) {
+        reader.join();
+    }
+
+    ASSERT_EQUALS(numMisses.load(), 0);
+    ASSERT_EQUALS(catalog.lookupCollectionByUUID(colUUID), &col);
+}
+
 TEST_F(UUIDCatalogTest, NonExistingNextCol) {
     ASSERT_FALSE(catalog.next(nss.db(), colUUID));
     ASSERT_FALSE(catalog.next(nss.db(), nextUUID));
@@ -45,6 +45,7 @@
 #include "mongo/db/commands.h"
 #include "mongo/db/commands/server_status.h"
 #include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/curop.h"
 #include "mongo/db/cursor_server_params.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/query/explain.h"
@@ -94,7 +95,8 @@ ClientCursor::ClientCursor(ClientCursorParams params,
       _operationUsingCursor(operationUsingCursor),
       _lastUseDate(now),
       _createdDate(now),
-      _planSummary(Explain::getPlanSummary(_exec.get())) {
+      _planSummary(Explain::getPlanSummary(_exec.get())),
+      _queryStatsKey(CurOp::get(operationUsingCursor)->debug().queryStatsKey) {
     invariant(_cursorManager);
     invariant(_exec);
     invariant(_operationUsingCursor);
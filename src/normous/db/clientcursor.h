@@ -29,6 +29,7 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <utility>
 
 #include "mongo/db/auth/user_name.h"
 #include "mongo/db/cursor_id.h"
@@ -201,6 +202,18 @@ public:
         ++_nBatchesReturned;
     }
 
+    /**
+     * Returns the size in bytes of the last getMore batch returned by this cursor, or 0 if no
+     * getMore has returned a batch yet. Used to size the reply buffer of the next getMore.
+     */
+    std::size_t getLastGetMoreBatchBytes() const {
+        return _lastGetMoreBatchBytes;
+    }
+
+    void setLastGetMoreBatchBytes(std::size_t bytes) {
+        _lastGetMoreBatchBytes = bytes;
+    }
+
     Date_t getLastUseDate() const {
         return _lastUseDate;
     }
@@ -217,6 +230,14 @@ public:
         return StringData(_planSummary);
     }
 
+    /**
+     * Returns the key of the query shape that getMores on this cursor add their statistics to, or
+     * an empty string if the shape is not tracked.
+     */
+    const std::string& getQueryStatsKey() const {
+        return _queryStatsKey;
+    }
+
     /**
      * Returns a generic cursor containing diagnostics about this cursor.
      * The caller must either have this cursor pinned or hold a mutex from the cursor manager.
@@ -247,6 +268,25 @@ public:
         _leftoverMaxTimeMicros = leftoverMaxTimeMicros;
     }
 
+    //
+    // Prefetching.
+    //
+
+    /**
+     * Records that running the executor between getMores, to prefetch the next batch, failed with
+     * 'error'. The next getMore reports 'error' instead of returning a batch.
+     */
+    void setPrefetchError(Status error) {
+        _prefetchError = std::move(error);
+    }
+
+    /**
+     * Returns the error recorded by setPrefetchError(), if any, and clears it.
+     */
+    Status takePrefetchError() {
+        return std::exchange(_prefetchError, Status::OK());
+    }
+
     /**
      * Returns the server-wide the count of living cursors. Such a cursor is called an "open
      * cursor".
@@ -340,6 +380,9 @@ private:
     // Tracks the number of batches returned by this cursor so far.
     std::uint64_t _nBatchesReturned = 0;
 
+    // Size of the last batch returned by a getMore on this cursor, 0 until the first getMore.
+    std::size_t _lastGetMoreBatchBytes = 0;
+
     // Holds an owned copy of the command specification received from the client.
     const BSONObj _originatingCommand;
 
@@ -349,6 +392,9 @@ private:
     // Unused maxTime budget for this cursor.
     Microseconds _leftoverMaxTimeMicros = Microseconds::max();
 
+    // The error hit while prefetching the next batch, if any.
+    Status _prefetchError = Status::OK();
+
     // The underlying query execution machinery. Must be non-null.
     std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> _exec;
 
@@ -385,6 +431,10 @@ private:
 
     // A string with the plan summary of the cursor's query.
     std::string _planSummary;
+
+    // The QueryStatsStore key of the shape of the cursor's query, taken from the operation which
+    // created the cursor.
+    const std::string _queryStatsKey;
 };
 
 /**
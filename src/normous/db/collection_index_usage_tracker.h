@@ -58,12 +58,14 @@ public:
         IndexUsageStats(const IndexUsageStats& other)
             : accesses(other.accesses.load()),
               trackerStartTime(other.trackerStartTime),
-              indexKey(other.indexKey) {}
+              indexKey(other.indexKey),
+              keyStatistics(other.keyStatistics) {}
 
         IndexUsageStats& operator=(const IndexUsageStats& other) {
             accesses.store(other.accesses.load());
             trackerStartTime = other.trackerStartTime;
             indexKey = other.indexKey;
+            keyStatistics = other.keyStatistics;
             return *this;
         }
 
@@ -75,6 +77,10 @@ public:
 
         // An owned copy of the associated IndexDescriptor's index key.
         BSONObj indexKey;
+
+        // The statistics about the index's keys used for query planning, if there are any. Not
+        // maintained by the tracker, but filled in when the stats are reported.
+        BSONObj keyStatistics;
     };
 
     /**
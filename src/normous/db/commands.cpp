@@ -574,10 +574,16 @@ std::unique_ptr<CommandInvocation> BasicCommand::parse(OperationContext* opCtx,
 Command::Command(StringData name, StringData oldName)
     : _name(name.toString()),
       _commandsExecutedMetric("commands." + _name + ".total", &_commandsExecuted),
-      _commandsFailedMetric("commands." + _name + ".failed", &_commandsFailed) {
+      _commandsFailedMetric("commands." + _name + ".failed", &_commandsFailed),
+      _latencyHistogramMetric("commands." + _name + ".latency", &_latencyHistogram) {
     globalCommandRegistry()->registerCommand(this, name, oldName);
 }
 
+void Command::LatencyHistogramMetric::appendAtLeaf(BSONObjBuilder& b) const {
+    BSONObjBuilder histogramBuilder(b.subobjStart(_leafName));
+    _histogram->append(false, &histogramBuilder);
+}
+
 Status BasicCommand::explain(OperationContext* opCtx,
                              const OpMsgRequest& request,
                              ExplainOptions::Verbosity verbosity,
@@ -44,6 +44,7 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/query/explain.h"
 #include "mongo/db/repl/read_concern_args.h"
+#include "mongo/db/stats/hdr_latency_histogram.h"
 #include "mongo/db/write_concern.h"
 #include "mongo/rpc/op_msg.h"
 #include "mongo/rpc/reply_builder_interface.h"
@@ -412,6 +413,13 @@ public:
         _commandsFailed.increment();
     }
 
+    /**
+     * Records the latency, in microseconds, of one completed invocation of this command.
+     */
+    void recordLatency(uint64_t micros) const {
+        _latencyHistogram.increment(micros);
+    }
+
     /**
      * Generates a reply from the 'help' information associated with a command. The state of
      * the passed ReplyBuilder will be in kOutputDocs after calling this method.
@@ -421,6 +429,21 @@ public:
                                      const Command& command);
 
 private:
+    /**
+     * Reports a command's latency histogram as a subdocument of fixed shape under the metrics
+     * tree.
+     */
+    class LatencyHistogramMetric : public ServerStatusMetric {
+    public:
+        LatencyHistogramMetric(const std::string& name, const HdrLatencyHistogram* histogram)
+            : ServerStatusMetric(name), _histogram(histogram) {}
+
+        void appendAtLeaf(BSONObjBuilder& b) const override;
+
+    private:
+        const HdrLatencyHistogram* const _histogram;
+    };
+
     // The full name of the command
     const std::string _name;
 
@@ -430,6 +453,10 @@ private:
     // Pointers to hold the metrics tree references
     ServerStatusMetricField<Counter64> _commandsExecutedMetric;
     ServerStatusMetricField<Counter64> _commandsFailedMetric;
+
+    // Latencies of this command's invocations, reported as metrics.commands.<name>.latency
+    mutable HdrLatencyHistogram _latencyHistogram;
+    LatencyHistogramMetric _latencyHistogramMetric;
 };
 
 /**
@@ -65,6 +65,7 @@ struct DbCheckCollectionInfo {
     int64_t maxCount;
     int64_t maxSize;
     int64_t maxRate;
+    bool digest;
 };
 
 /**
@@ -116,7 +117,8 @@ std::unique_ptr<DbCheckRun> singleCollectionRun(OperationContext* opCtx,
     auto maxCount = invocation.getMaxCount();
     auto maxSize = invocation.getMaxSize();
     auto maxRate = invocation.getMaxCountPerSecond();
-    auto info = DbCheckCollectionInfo{nss, start, end, maxCount, maxSize, maxRate};
+    auto digest = invocation.getDigest();
+    auto info = DbCheckCollectionInfo{nss, start, end, maxCount, maxSize, maxRate, digest};
     auto result = stdx::make_unique<DbCheckRun>();
     result->push_back(info);
     return result;
@@ -137,9 +139,11 @@ std::unique_ptr<DbCheckRun> fullDatabaseRun(OperationContext* opCtx,
 
     int64_t max = std::numeric_limits<int64_t>::max();
     auto rate = invocation.getMaxCountPerSecond();
+    auto digest = invocation.getDigest();
 
     for (Collection* coll : *db) {
-        DbCheckCollectionInfo info{coll->ns(), BSONKey::min(), BSONKey::max(), max, max, rate};
+        DbCheckCollectionInfo info{
+            coll->ns(), BSONKey::min(), BSONKey::max(), max, max, rate, digest};
         result->push_back(info);
     }
 
@@ -222,6 +226,12 @@ private:
             return;
         }
 
+        // Collections that can't keep a digest are still checked, just in batches.
+        if (info.digest && _supportsDigest(info)) {
+            _doCollectionDigest(info);
+            return;
+        }
+
         // Parameters for the hasher.
         auto start = info.start;
         bool reachedEnd = false;
@@ -295,6 +305,54 @@ private:
         } while (!reachedEnd);
     }
 
+    /**
+     * Builds (or brings up to date) the collection's digest and sends it to the secondaries, which
+     * build theirs alongside from the same oplog entries.
+     */
+    void _doCollectionDigest(const DbCheckCollectionInfo& info) {
+        using Clock = stdx::chrono::system_clock;
+        using TimePoint = stdx::chrono::time_point<Clock>;
+        TimePoint lastStart = Clock::now();
+        int64_t docsInCurrentInterval = 0;
+
+        while (true) {
+            using namespace std::literals::chrono_literals;
+
+            if (Clock::now() - lastStart > 1s) {
+                lastStart = Clock::now();
+                docsInCurrentInterval = 0;
+            }
+
+            auto result = _runDigestBatch(info);
+
+            if (_done) {
+                return;
+            }
+
+            if (!result.isOK()) {
+                auto entry = dbCheckErrorHealthLogEntry(info.nss,
+                                                        "dbCheck digest failed",
+                                                        OplogEntriesEnum::Digest,
+                                                        result.getStatus());
+                HealthLog::get(Client::getCurrent()->getServiceContext()).log(*entry);
+                return;
+            }
+
+            // A negative count means the digest is complete and has been sent.
+            if (result.getValue() < 0) {
+                return;
+            }
+
+            docsInCurrentInterval += result.getValue();
+
+            if (docsInCurrentInterval > info.maxRate && info.maxRate > 0) {
+                int64_t timesExceeded = docsInCurrentInterval / info.maxRate;
+
+                stdx::this_thread::sleep_for(timesExceeded * 1s - (Clock::now() - lastStart));
+            }
+        }
+    }
+
     /**
      * For organizing the results of batches.
      */
@@ -439,6 +497,78 @@ private:
         return result;
     }
 
+    bool _supportsDigest(const DbCheckCollectionInfo& info) {
+        auto uniqueOpCtx = Client::getCurrent()->makeOperationContext();
+        auto opCtx = uniqueOpCtx.get();
+        AutoGetCollectionForRead agc(opCtx, info.nss);
+        return agc.getCollection() && DbCheckCollectionDigest::isSupported(agc.getCollection());
+    }
+
+    /**
+     * Extends the digest by one batch, logging how far it got. Once the digest is complete, logs
+     * the digest itself instead and returns -1; otherwise returns the number of documents added.
+     */
+    StatusWith<int64_t> _runDigestBatch(const DbCheckCollectionInfo& info) {
+        // New OperationContext for each batch.
+        auto uniqueOpCtx = Client::getCurrent()->makeOperationContext();
+        auto opCtx = uniqueOpCtx.get();
+
+        AutoGetCollectionForDbCheck agc(opCtx, info.nss, OplogEntriesEnum::Digest);
+
+        if (_stepdownHasOccurred(opCtx, info.nss)) {
+            _done = true;
+            return Status(ErrorCodes::PrimarySteppedDown, "dbCheck terminated due to stepdown");
+        }
+
+        auto collection = agc.getCollection();
+
+        if (!collection) {
+            return {ErrorCodes::NamespaceNotFound, "dbCheck collection no longer exists"};
+        }
+
+        if (!DbCheckCollectionDigest::isSupported(collection)) {
+            return {ErrorCodes::CommandNotSupported, "collection does not support dbCheck digests"};
+        }
+
+        auto digest = DbCheckDigestCatalog::get(opCtx).getOrCreate(collection);
+
+        if (!digest->isComplete()) {
+            auto added = digest->extend(opCtx, collection, BSONKey::max(), kBatchDocs);
+
+            if (!added.isOK()) {
+                return added.getStatus();
+            }
+
+            DbCheckOplogDigestBatch batch;
+            batch.setNss(info.nss);
+            batch.setType(OplogEntriesEnum::DigestBatch);
+            batch.setMaxKey(digest->builtThrough());
+            _logOp(opCtx, info.nss, collection->uuid(), batch.toBSON());
+
+            if (!digest->isComplete()) {
+                return added;
+            }
+        }
+
+        auto buckets = digest->buckets();
+        auto root = DbCheckCollectionDigest::rootHash(buckets);
+        auto serialized = DbCheckCollectionDigest::serialize(buckets);
+
+        DbCheckOplogDigest entry;
+        entry.setNss(info.nss);
+        entry.setType(OplogEntriesEnum::Digest);
+        entry.setRoot(root);
+        entry.setBuckets(
+            ConstDataRange(reinterpret_cast<const char*>(serialized.data()), serialized.size()));
+
+        auto optime = _logOp(opCtx, info.nss, collection->uuid(), entry.toBSON());
+
+        auto hle = dbCheckDigestEntry(info.nss, root, buckets, buckets, optime);
+        HealthLog::get(opCtx).log(*hle);
+
+        return -1;
+    }
+
     /**
      * Return `true` iff the primary the check is running on has stepped down.
      */
@@ -513,7 +643,8 @@ public:
                "              maxKey: <last key, inclusive>,\n"
                "              maxCount: <max number of docs>,\n"
                "              maxSize: <max size of docs>,\n"
-               "              maxCountPerSecond: <max rate in docs/sec> } "
+               "              maxCountPerSecond: <max rate in docs/sec>,\n"
+               "              digest: <compare maintained digests instead of batches> } "
                "to check a collection.\n"
                "Invoke with {dbCheck: 1} to check all collections in the database.";
     }
@@ -30,6 +30,7 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 
@@ -39,6 +40,7 @@
 #include "mongo/db/client.h"
 #include "mongo/db/clientcursor.h"
 #include "mongo/db/commands.h"
+#include "mongo/db/commands/getmore_prefetcher.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/curop_failpoint_helpers.h"
 #include "mongo/db/cursor_manager.h"
@@ -70,6 +72,25 @@ MONGO_FAIL_POINT_DEFINE(rsStopGetMoreCmd);
 
 MONGO_FAIL_POINT_DEFINE(waitWithPinnedCursorDuringGetMoreBatch);
 
+/**
+ * Returns the number of bytes to reserve for the reply to a getMore on a cursor whose last getMore
+ * batch was 'lastBatchBytes' long (0 if there was none). Batches of one cursor tend to be of
+ * similar size, so rather than reserving room for a maximal batch on every getMore, reserve a
+ * little more than the previous batch needed. The first getMore still reserves a full batch,
+ * since the initial batch is usually capped by the default batch size and is no guide.
+ */
+std::size_t getMoreReplyBytesToReserve(std::size_t lastBatchBytes) {
+    // The extra 1K is an artifact of how we construct batches. We consider a batch to be full
+    // when it exceeds the goal batch size. In the case that we are just below the limit and
+    // then read a large document, the extra 1K helps prevent a final realloc+memcpy.
+    const std::size_t maxBytes = FindCommon::kMaxBytesToReturnToClientAtOnce + 1024u;
+    if (lastBatchBytes == 0) {
+        return maxBytes;
+    }
+    const std::size_t hint = lastBatchBytes + lastBatchBytes / 8 + 1024u;
+    return std::min(maxBytes, std::max<std::size_t>(hint, FindCommon::kInitReplyBufferSize));
+}
+
 /**
  * Validates that the lsid of 'opCtx' matches that of 'cursor'. This must be called after
  * authenticating, so that it is safe to report the lsid of 'cursor'.
@@ -275,6 +296,19 @@ public:
             // the pin's destructor is called before the lock's destructor (if there is one) so that
             // the
             // cursor cleanup can occur under the lock.
+            //
+            // A background prefetch of this cursor's next batch holds the pin and takes the same
+            // locks, so we stop it before taking ours, and only start the next one once both our
+            // pin and locks are released.
+            auto prefetcher = GetMorePrefetcher::get(opCtx->getServiceContext());
+            prefetcher->waitForPrefetch(opCtx, _request.cursorid);
+            bool prefetchNextBatch = false;
+            ON_BLOCK_EXIT([&] {
+                if (prefetchNextBatch) {
+                    prefetcher->schedulePrefetch(_request.nss, _request.cursorid);
+                }
+            });
+
             boost::optional<AutoGetCollectionForRead> readLock;
             boost::optional<AutoStatsTracker> statsTracker;
             CursorManager* cursorManager;
@@ -375,6 +409,8 @@ public:
             // On early return, get rid of the cursor.
             ScopeGuard cursorFreer = MakeGuard(&ClientCursorPin::deleteUnderlying, &ccPin);
 
+            uassertStatusOK(cursor->takePrefetchError());
+
             const auto replicationMode =
                 repl::ReplicationCoordinator::get(opCtx)->getReplicationMode();
             if (replicationMode == repl::ReplicationCoordinator::modeReplSet &&
@@ -411,6 +447,9 @@ public:
             exec->reattachToOperationContext(opCtx);
             uassertStatusOK(exec->restoreState());
 
+            // Add this getMore's statistics to those of the shape of the cursor's query.
+            curOp->debug().queryStatsKey = cursor->getQueryStatsKey();
+
             auto planSummary = Explain::getPlanSummary(exec);
             {
                 stdx::lock_guard<Client> lk(*opCtx->getClient());
@@ -430,6 +469,7 @@ public:
 
             CursorId respondWithId = 0;
 
+            reply->reserveBytes(getMoreReplyBytesToReserve(cursor->getLastGetMoreBatchBytes()));
             CursorResponseBuilder nextBatch(reply, CursorResponseBuilder::Options());
             BSONObj obj;
             PlanExecutor::ExecState state = PlanExecutor::ADVANCED;
@@ -496,6 +536,9 @@ public:
                 cursor->setLeftoverMaxTimeMicros(opCtx->getRemainingMaxTimeMicros());
                 cursor->incNReturnedSoFar(numResults);
                 cursor->incNBatches();
+                cursor->setLastGetMoreBatchBytes(nextBatch.bytesUsed());
+
+                prefetchNextBatch = GetMorePrefetcher::canPrefetch(opCtx, *cursor);
             } else {
                 curOp->debug().cursorExhausted = true;
             }
@@ -551,10 +594,9 @@ public:
     }
 
     std::size_t reserveBytesForReply() const override {
-        // The extra 1K is an artifact of how we construct batches. We consider a batch to be full
-        // when it exceeds the goal batch size. In the case that we are just below the limit and
-        // then read a large document, the extra 1K helps prevent a final realloc+memcpy.
-        return FindCommon::kMaxBytesToReturnToClientAtOnce + 1024u;
+        // The space for the batch itself is reserved once the cursor is pinned, based on the size
+        // of its previous batch. See getMoreReplyBytesToReserve().
+        return FindCommon::kInitReplyBufferSize;
     }
 
     /**
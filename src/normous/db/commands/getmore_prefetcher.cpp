@@ -0,0 +1,206 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kQuery
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/commands/getmore_prefetcher.h"
+
+#include <vector>
+
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/client.h"
+#include "mongo/db/cursor_manager.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/query/plan_executor.h"
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/service_context.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/util/log.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+
+namespace {
+
+const auto getGetMorePrefetcher = ServiceContext::declareDecoration<GetMorePrefetcher>();
+
+// The most prefetches that run at once. Further prefetches queue behind them.
+const size_t kMaxPrefetchThreads = 4;
+
+}  // namespace
+
+GetMorePrefetcher::~GetMorePrefetcher() {
+    if (_pool) {
+        _pool->shutdown();
+        _pool->join();
+    }
+}
+
+GetMorePrefetcher* GetMorePrefetcher::get(ServiceContext* serviceContext) {
+    return &getGetMorePrefetcher(serviceContext);
+}
+
+bool GetMorePrefetcher::canPrefetch(OperationContext* opCtx, const ClientCursor& cursor) {
+    // Cursors owned by the global cursor manager manage their own collection state, tailable
+    // cursors wait for inserts, and cursors in a transaction or with time left to run must be read
+    // only on the client's behalf.
+    return internalQueryGetMorePrefetchBytes.load() > 0 &&
+        !CursorManager::isGloballyManagedCursor(cursor.cursorid()) && !cursor.isTailable() &&
+        !cursor.getTxnNumber() &&
+        cursor.getReadConcernLevel() != repl::ReadConcernLevel::kSnapshotReadConcern &&
+        cursor.getLeftoverMaxTimeMicros() == Microseconds::max() &&
+        !opCtx->getClient()->isInDirectClient();
+}
+
+void GetMorePrefetcher::schedulePrefetch(const NamespaceString& nss, CursorId cursorId) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    if (!_prefetching.emplace(cursorId, false).second) {
+        return;
+    }
+
+    if (!_pool) {
+        ThreadPool::Options options;
+        options.poolName = "GetMorePrefetch";
+        options.threadNamePrefix = "getMorePrefetch-";
+        options.minThreads = 0;
+        options.maxThreads = kMaxPrefetchThreads;
+        options.onCreateThread = [](const std::string& threadName) {
+            Client::initThread(threadName.c_str());
+        };
+        _pool = stdx::make_unique<ThreadPool>(options);
+        _pool->startup();
+    }
+
+    Status status = _pool->schedule([this, nss, cursorId] { _prefetch(nss, cursorId); });
+    if (!status.isOK()) {
+        LOG(1) << "Could not schedule prefetch of cursor " << cursorId << ": " << status;
+        _prefetching.erase(cursorId);
+        _prefetchFinished.notify_all();
+    }
+}
+
+void GetMorePrefetcher::waitForPrefetch(OperationContext* opCtx, CursorId cursorId) {
+    stdx::unique_lock<stdx::mutex> lk(_mutex);
+    auto it = _prefetching.find(cursorId);
+    if (it == _prefetching.end()) {
+        return;
+    }
+
+    it->second = true;
+    opCtx->waitForConditionOrInterrupt(
+        _prefetchFinished, lk, [&] { return _prefetching.find(cursorId) == _prefetching.end(); });
+}
+
+bool GetMorePrefetcher::_stopRequested(CursorId cursorId) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    auto it = _prefetching.find(cursorId);
+    invariant(it != _prefetching.end());
+    return it->second;
+}
+
+void GetMorePrefetcher::_prefetch(const NamespaceString& nss, CursorId cursorId) {
+    ON_BLOCK_EXIT([this, cursorId] {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _prefetching.erase(cursorId);
+        _prefetchFinished.notify_all();
+    });
+
+    if (_stopRequested(cursorId)) {
+        return;
+    }
+
+    auto opCtx = cc().makeOperationContext();
+    try {
+        AutoGetCollectionForRead readLock(opCtx.get(), nss);
+        Collection* collection = readLock.getCollection();
+        if (!collection) {
+            return;
+        }
+
+        // The prefetch runs without the client's session, which the getMore already checked.
+        auto swPin = collection->getCursorManager()->pinCursor(
+            opCtx.get(), cursorId, CursorManager::kNoCheckSession);
+        if (!swPin.isOK()) {
+            return;
+        }
+        ClientCursorPin& pin = swPin.getValue();
+        ClientCursor* cursor = pin.getCursor();
+
+        // If execution throws, the executor is left attached to an OperationContext that is
+        // about to go away, so the cursor cannot be used again. The next getMore then finds no
+        // cursor, just as it would had it hit the error itself.
+        ScopeGuard cursorFreer = MakeGuard(&ClientCursorPin::deleteUnderlying, &pin);
+
+        if (repl::ReplicationCoordinator::get(opCtx.get())->getReplicationMode() ==
+                repl::ReplicationCoordinator::modeReplSet &&
+            cursor->getReadConcernLevel() == repl::ReadConcernLevel::kMajorityReadConcern) {
+            opCtx->recoveryUnit()->setTimestampReadSource(
+                RecoveryUnit::ReadSource::kMajorityCommitted);
+            uassertStatusOK(opCtx->recoveryUnit()->obtainMajorityCommittedSnapshot());
+        }
+
+        PlanExecutor* exec = cursor->getExecutor();
+        exec->reattachToOperationContext(opCtx.get());
+        uassertStatusOK(exec->restoreState());
+
+        // Results already stashed in the executor come back first, so the prefetched results are
+        // buffered here and stashed again in order once execution stops.
+        const long long budgetBytes = internalQueryGetMorePrefetchBytes.load();
+        long long bytesBuffered = 0;
+        std::vector<BSONObj> results;
+        BSONObj obj;
+        PlanExecutor::ExecState state = PlanExecutor::ADVANCED;
+        while (bytesBuffered < budgetBytes && !_stopRequested(cursorId) &&
+               PlanExecutor::ADVANCED == (state = exec->getNext(&obj, nullptr))) {
+            bytesBuffered += obj.objsize();
+            results.push_back(obj.getOwned());
+        }
+
+        if (PlanExecutor::DEAD == state || PlanExecutor::FAILURE == state) {
+            // The next getMore reports the error and closes the cursor.
+            cursor->setPrefetchError(WorkingSetCommon::getMemberObjectStatus(obj));
+        } else {
+            for (auto&& result : results) {
+                exec->enqueue(result);
+            }
+        }
+
+        exec->saveState();
+        exec->detachFromOperationContext();
+        cursorFreer.Dismiss();
+    } catch (const DBException& ex) {
+        LOG(1) << "Prefetch of cursor " << cursorId << " on " << nss << " failed: " << ex;
+    }
+}
+
+}  // namespace mongo
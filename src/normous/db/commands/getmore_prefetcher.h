@@ -0,0 +1,102 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/db/clientcursor.h"
+#include "mongo/db/cursor_id.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/concurrency/thread_pool.h"
+
+namespace mongo {
+
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Fills the next batch of find cursors in the background between getMores, so that a client
+ * streaming a cursor overlaps the network round trip of each batch with the execution of the
+ * next.
+ *
+ * After a getMore returns, schedulePrefetch() queues a task which pins the cursor, runs its
+ * executor on its own OperationContext until it has buffered internalQueryGetMorePrefetchBytes of
+ * results, and stashes those results in the executor for the next getMore to return. The task
+ * takes the same collection lock a getMore would and yields as the executor's policy directs.
+ *
+ * A getMore calls waitForPrefetch() before taking any locks. This asks a running prefetch of its
+ * cursor to stop at the next result and waits until it has unpinned the cursor.
+ *
+ * All methods are thread-safe.
+ */
+class GetMorePrefetcher {
+    MONGO_DISALLOW_COPYING(GetMorePrefetcher);
+
+public:
+    GetMorePrefetcher() = default;
+    ~GetMorePrefetcher();
+
+    static GetMorePrefetcher* get(ServiceContext* serviceContext);
+
+    /**
+     * Returns whether the next batch of 'cursor', which 'opCtx' has pinned, may be prefetched.
+     */
+    static bool canPrefetch(OperationContext* opCtx, const ClientCursor& cursor);
+
+    /**
+     * Schedules a background fill of the next batch of cursor 'cursorId' on 'nss'. The caller must
+     * have unpinned the cursor and released its locks.
+     */
+    void schedulePrefetch(const NamespaceString& nss, CursorId cursorId);
+
+    /**
+     * Stops any prefetch of cursor 'cursorId' and waits until it has finished.
+     */
+    void waitForPrefetch(OperationContext* opCtx, CursorId cursorId);
+
+private:
+    void _prefetch(const NamespaceString& nss, CursorId cursorId);
+
+    // Returns whether a getMore is waiting for the prefetch of 'cursorId' to finish.
+    bool _stopRequested(CursorId cursorId);
+
+    stdx::mutex _mutex;
+    stdx::condition_variable _prefetchFinished;
+
+    // Maps the id of each cursor with a prefetch scheduled or running to whether a getMore has
+    // asked it to stop.
+    stdx::unordered_map<CursorId, bool> _prefetching;
+
+    // Started on the first call to schedulePrefetch().
+    std::unique_ptr<ThreadPool> _pool;
+};
+
+}  // namespace mongo
@@ -58,6 +58,7 @@
 #include "mongo/db/query/find_common.h"
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/s/collection_sharding_state.h"
@@ -278,7 +279,9 @@ BSONObj JSReducer::finalReduce(const BSONList& tuples, Finalizer* finalizer) {
 void JSReducer::_reduce(const BSONList& tuples, BSONObj& key, int& endSizeEstimate) {
     uassert(10074, "need values", tuples.size());
 
-    int sizeEstimate = (tuples.size() * tuples.begin()->getField("value").size()) + 128;
+    // Each tuple is {"0": key, "1": value}. Sizing by whole tuples slightly overestimates the
+    // array of values, but avoids regrowing the builder as it fills.
+    int sizeEstimate = (tuples.size() * tuples.begin()->objsize()) + 128;
 
     // need to build the reduce args: ( key, [values] )
     BSONObjBuilder reduceArgs(sizeEstimate);
@@ -374,19 +377,12 @@ Config::Config(const string& _dbname, const BSONObj& cmdObj) {
     }
 
     if (outputOptions.outType != INMEMORY) {
-        // Create names for the temp collection and the incremental collection. The incremental
-        // collection goes in the "local" database, so that it doesn't get replicated.
+        // Create a name for the temp collection.
         const std::string& outDBName = outputOptions.outDB.empty() ? dbname : outputOptions.outDB;
         const std::string tmpCollDesc = str::stream()
             << "tmp.mr." << cmdObj.firstElement().valueStringData() << "_"
             << JOB_NUMBER.fetchAndAdd(1);
         tempNamespace = NamespaceString(outDBName, tmpCollDesc);
-
-        // The name of the incremental collection includes the name of the database that we put
-        // temporary collection in, to make it easier to see which incremental database is paired
-        // with which temporary database when debugging.
-        incLong =
-            NamespaceString("local", str::stream() << tmpCollDesc << "_" << outDBName << "_inc");
     }
 
     {
@@ -438,7 +434,7 @@ Config::Config(const string& _dbname, const BSONObj& cmdObj) {
 }
 
 /**
- * Clean up the temporary and incremental collections
+ * Clean up the temporary collection
  */
 void State::dropTempCollections() {
     // The cleanup handler should not be interruptible.
@@ -463,19 +459,6 @@ void State::dropTempCollections() {
         // Always forget about temporary namespaces, so we don't cache lots of them
         ShardConnection::forgetNS(_config.tempNamespace.ns());
     }
-    if (_useIncremental && !_config.incLong.isEmpty()) {
-        writeConflictRetry(_opCtx, "M/R dropTempCollections", _config.incLong.ns(), [this] {
-            Lock::DBLock lk(_opCtx, _config.incLong.db(), MODE_X);
-            if (Database* db =
-                    DatabaseHolder::getDatabaseHolder().get(_opCtx, _config.incLong.ns())) {
-                WriteUnitOfWork wunit(_opCtx);
-                uassertStatusOK(db->dropCollection(_opCtx, _config.incLong.ns()));
-                wunit.commit();
-            }
-        });
-
-        ShardConnection::forgetNS(_config.incLong.ns());
-    }
 }
 
 /**
@@ -487,35 +470,15 @@ void State::prepTempCollection() {
 
     dropTempCollections();
 
-    if (_useIncremental) {
-        // Create the inc collection and make sure we have index on "0" key. The inc collection is
-        // in the "local" database, so it does not get replicated to secondaries.
-        writeConflictRetry(_opCtx, "M/R prepTempCollection", _config.incLong.ns(), [this] {
-            AutoGetOrCreateDb autoGetIncCollDb(_opCtx, _config.incLong.db(), MODE_X);
-            auto const db = autoGetIncCollDb.getDb();
-            invariant(!db->getCollection(_opCtx, _config.incLong));
-
-            CollectionOptions options;
-            options.setNoIdIndex();
-            options.temp = true;
-            options.uuid.emplace(UUID::gen());
-
-            WriteUnitOfWork wuow(_opCtx);
-            auto incColl = db->createCollection(
-                _opCtx, _config.incLong.ns(), options, false /* force no _id index */);
-
-            auto rawIndexSpec =
-                BSON("key" << BSON("0" << 1) << "ns" << _config.incLong.ns() << "name"
-                           << "_temp_0");
-            auto indexSpec = uassertStatusOK(index_key_validate::validateIndexSpec(
-                _opCtx, rawIndexSpec, _config.incLong, serverGlobalParams.featureCompatibility));
-
-            uassertStatusOKWithContext(
-                incColl->getIndexCatalog()->createIndexOnEmptyCollection(_opCtx, indexSpec),
-                str::stream() << "createIndex failed for mr incLong ns " << _config.incLong.ns());
-            wuow.commit();
-        });
-    }
+    // Tuples which don't fit in memory are sorted by key in an external sort, rather than in an
+    // indexed collection, so that spilling them doesn't pay for writes to a storage engine.
+    _incSorter.reset(IncSorter::make(
+        SortOptions()
+            .TempDir(storageGlobalParams.getTmpDirectory())
+            .ExtSortAllowed()
+            .MaxMemoryUsageBytes(internalQueryExecMaxBlockingSortBytes.load())
+            .SortThreads(internalQueryExecSortThreads.load()),
+        IncSorterCmp()));
 
     CollectionOptions finalOptions;
     vector<BSONObj> indexesToInsert;
@@ -816,42 +779,27 @@ void State::insert(const NamespaceString& nss, const BSONObj& o) {
 }
 
 /**
- * Insert doc into the inc collection. The inc collection is in the "local" database, so this insert
- * will not be replicated.
+ * Adds a tuple of the form {"0": <key>, "1": <value>} to the incremental sorter.
  */
-void State::_insertToInc(BSONObj& o) {
+void State::_insertToInc(const BSONObj& o) {
     verify(_onDisk);
+    invariant(_incSorter);
+
+    if (o.objsize() > BSONObjMaxUserSize) {
+        uasserted(ErrorCodes::BadValue,
+                  str::stream() << "object to insert too large for incremental collection"
+                                << ". size in bytes: "
+                                << o.objsize()
+                                << ", max size: "
+                                << BSONObjMaxUserSize);
+    }
 
-    writeConflictRetry(_opCtx, "M/R insertToInc", _config.incLong.ns(), [this, &o] {
-        AutoGetCollection autoColl(_opCtx, _config.incLong, MODE_IX);
-        assertCollectionNotNull(_config.incLong, autoColl);
-
-        WriteUnitOfWork wuow(_opCtx);
-        // The documents inserted into the incremental collection are of the form
-        // {"0": <key>, "1": <value>}, so we cannot call fixDocumentForInsert(o) here because the
-        // check that the document has an "_id" field would fail. Instead, we directly verify that
-        // the size of the document to insert is smaller than 16MB.
-        if (o.objsize() > BSONObjMaxUserSize) {
-            uasserted(ErrorCodes::BadValue,
-                      str::stream() << "object to insert too large for incremental collection"
-                                    << ". size in bytes: "
-                                    << o.objsize()
-                                    << ", max size: "
-                                    << BSONObjMaxUserSize);
-        }
-
-        // TODO: Consider whether to pass OpDebug for stats tracking under SERVER-23261.
-        OpDebug* const nullOpDebug = nullptr;
-        uassertStatusOK(autoColl.getCollection()->insertDocument(
-            _opCtx, InsertStatement(o), nullOpDebug, false));
-        wuow.commit();
-    });
+    _incSorter->add(o.getOwned(), RecordId(++_numIncTuples));
 }
 
 State::State(OperationContext* opCtx, const Config& c)
     : _config(c),
       _db(opCtx),
-      _useIncremental(true),
       _opCtx(opCtx),
       _size(0),
       _dupCount(0),
@@ -889,7 +837,7 @@ State::~State() {
 }
 
 /**
- * Initialize the mapreduce operation, creating the inc collection
+ * Initialize the mapreduce operation
  */
 void State::init() {
     // setup js
@@ -1103,121 +1051,48 @@ void State::finalReduce(OperationContext* opCtx, CurOp* curOp, ProgressMeterHold
         return;
     }
 
-    // use index on "0" to pull sorted data
+    // pull the spilled tuples back in key order
     verify(_temp->size() == 0);
-    BSONObj sortKey = BSON("0" << 1);
+    invariant(_incSorter);
 
     {
-        AutoGetCollection autoIncColl(_opCtx, _config.incLong, MODE_IS);
-        assertCollectionNotNull(_config.incLong, autoIncColl);
-
-        bool foundIndex = false;
-        IndexCatalog::IndexIterator ii =
-            autoIncColl.getCollection()->getIndexCatalog()->getIndexIterator(_opCtx, true);
-        // Iterate over incColl's indexes.
-        while (ii.more()) {
-            IndexDescriptor* currIndex = ii.next();
-            BSONObj x = currIndex->infoObj();
-            if (sortKey.woCompare(x["key"].embeddedObject()) == 0) {
-                foundIndex = true;
-                break;
-            }
-        }
-
-        invariant(foundIndex);
-    }
-
-    boost::optional<AutoGetCollectionForReadCommand> ctx;
-    ctx.emplace(_opCtx, _config.incLong);
-    assertCollectionNotNull(_config.incLong, *ctx);
-
-    BSONObj prev;
-    BSONList all;
-
-    {
-        const auto count = _db.count(_config.incLong.ns(), BSONObj(), QueryOption_SlaveOk);
         stdx::lock_guard<Client> lk(*_opCtx->getClient());
         verify(pm ==
                curOp->setMessage_inlock("m/r: (3/3) final reduce to collection",
                                         "M/R: (3/3) Final Reduce Progress",
-                                        count));
+                                        _numIncTuples));
     }
 
-    const ExtensionsCallbackReal extensionsCallback(_opCtx, &_config.incLong);
-
-    auto qr = stdx::make_unique<QueryRequest>(_config.incLong);
-    qr->setSort(sortKey);
-
-    const boost::intrusive_ptr<ExpressionContext> expCtx;
-    auto statusWithCQ =
-        CanonicalQuery::canonicalize(opCtx,
-                                     std::move(qr),
-                                     expCtx,
-                                     extensionsCallback,
-                                     MatchExpressionParser::kAllowAllSpecialFeatures);
-    verify(statusWithCQ.isOK());
-    std::unique_ptr<CanonicalQuery> cq = std::move(statusWithCQ.getValue());
+    std::unique_ptr<IncSorter::Iterator> it(_incSorter->done());
 
-    // The following anonymous block makes sure to destroy the executor prior to the
-    // finalReduce(all) call. This is important to clear the cursors being held by the
-    // storage engine.
-    {
-        auto exec = uassertStatusOK(getExecutor(_opCtx,
-                                                ctx->getCollection(),
-                                                std::move(cq),
-                                                PlanExecutor::YIELD_AUTO,
-                                                QueryPlannerParams::NO_TABLE_SCAN));
-
-        // Make sure the PlanExecutor is destroyed while holding a collection lock.
-        ON_BLOCK_EXIT([&exec, &ctx, opCtx, this] {
-            if (!ctx) {
-                AutoGetCollection autoColl(opCtx, _config.incLong, MODE_IS);
-                exec.reset();
-            }
-        });
+    BSONObj prev;
+    BSONList all;
 
-        // iterate over all sorted objects
-        BSONObj o;
-        PlanExecutor::ExecState state;
-        while (PlanExecutor::ADVANCED == (state = exec->getNext(&o, NULL))) {
-            o = o.getOwned();  // we will be accessing outside of the lock
-            pm.hit();
+    while (it->more()) {
+        BSONObj o = it->next().first;
+        pm.hit();
 
-            if (dps::compareObjectsAccordingToSort(o, prev, sortKey) == 0) {
-                // object is same as previous, add to array
-                all.push_back(o);
-                if (pm->hits() % 100 == 0) {
-                    _opCtx->checkForInterrupt();
-                }
-                continue;
+        if (o.firstElement().woCompare(prev.firstElement(), false) == 0) {
+            // object is same as previous, add to array
+            all.push_back(o);
+            if (pm->hits() % 100 == 0) {
+                _opCtx->checkForInterrupt();
             }
+            continue;
+        }
 
-            exec->saveState();
-
-            ctx.reset();
-
-            // reduce a finalize array
-            finalReduce(all);
-            ctx.emplace(_opCtx, _config.incLong);
-
-            all.clear();
-            prev = o;
-            all.push_back(o);
+        // reduce a finalize array
+        finalReduce(all);
 
-            _opCtx->checkForInterrupt();
-            uassertStatusOK(exec->restoreState());
-        }
+        all.clear();
+        prev = o;
+        all.push_back(o);
 
-        uassert(34428,
-                "Plan executor error during mapReduce command: " +
-                    WorkingSetCommon::toStatusString(o),
-                PlanExecutor::IS_EOF == state);
+        _opCtx->checkForInterrupt();
     }
-    ctx.reset();
 
     // reduce and finalize last array
     finalReduce(all);
-    ctx.emplace(_opCtx, _config.incLong);
 
     pm.finished();
 }
@@ -1225,7 +1100,7 @@ void State::finalReduce(OperationContext* opCtx, CurOp* curOp, ProgressMeterHold
 /**
  * Attempts to reduce objects in the memory map.
  * A new memory map will be created to hold the results.
- * If applicable, objects with unique key may be dumped to inc collection.
+ * If applicable, objects with unique key may be dumped to the incremental sorter.
  * Input and output objects are both {"0": key, "1": val}
  */
 void State::reduceInMemory() {
@@ -1263,7 +1138,7 @@ void State::reduceInMemory() {
 }
 
 /**
- * Dumps the entire in memory map to the inc collection.
+ * Dumps the entire in memory map to the incremental sorter.
  */
 void State::dumpToInc() {
     if (!_onDisk)
@@ -1609,7 +1484,7 @@ public:
             // do reduce in memory
             // this will be the last reduce needed for inline mode
             state.reduceInMemory();
-            // if not inline: dump the in memory map to inc collection, all data is on disk
+            // if not inline: dump the in memory map to the incremental sorter
             state.dumpToInc();
             // final reduce
             state.finalReduce(opCtx, curOp, pm);
@@ -1736,10 +1611,6 @@ public:
         State state(opCtx, config);
         state.init();
 
-        // no need for incremental collection because records are already sorted
-        state._useIncremental = false;
-        config.incLong = config.tempNamespace;
-
         BSONObj shardCounts = cmdObj["shardCounts"].embeddedObjectUserCheck();
         BSONObj counts = cmdObj["counts"].embeddedObjectUserCheck();
 
@@ -1855,3 +1726,6 @@ public:
 
 }  // namespace mr
 }  // namespace mongo
+
+#include "mongo/db/sorter/sorter.cpp"
+MONGO_CREATE_SORTER(mongo::BSONObj, mongo::RecordId, mongo::mr::IncSorterCmp);
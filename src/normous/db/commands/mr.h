@@ -36,6 +36,8 @@
 #include "mongo/db/dbdirectclient.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/namespace_string.h"
+#include "mongo/db/record_id.h"
+#include "mongo/db/sorter/sorter.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/scripting/engine.h"
 
@@ -183,6 +185,24 @@ public:
 
 typedef std::map<BSONObj, BSONList, TupleKeyCmp> InMemory;  // from key to list of tuples
 
+/**
+ * Tuples spilled to disk are sorted by key, paired with the order in which they were spilled.
+ */
+using IncSorter = Sorter<BSONObj, RecordId>;
+
+/**
+ * Orders spilled tuples by key, and tuples with the same key in the order they were spilled.
+ */
+class IncSorterCmp {
+public:
+    int operator()(const IncSorter::Data& l, const IncSorter::Data& r) const {
+        const int cmp = l.first.firstElement().woCompare(r.first.firstElement(), false);
+        if (cmp != 0)
+            return cmp;
+        return l.second.compare(r.second);
+    }
+};
+
 /**
  * holds map/reduce config information
  */
@@ -215,7 +235,6 @@ public:
     BSONObj scopeSetup;
 
     // output tables
-    NamespaceString incLong;
     NamespaceString tempNamespace;
 
     enum OutputType {
@@ -291,11 +310,10 @@ public:
     void reduceInMemory();
 
     /**
-     * transfers in memory storage to temp collection
+     * transfers in memory storage to the incremental sorter
      */
     void dumpToInc();
-    void insertToInc(BSONObj& o);
-    void _insertToInc(BSONObj& o);
+    void _insertToInc(const BSONObj& o);
 
     // ------ reduce stage -----------
 
@@ -308,7 +326,7 @@ public:
     // ------- cleanup/data positioning ----------
 
     /**
-     * Clean up the temporary and incremental collections
+     * Clean up the temporary collection
      */
     void dropTempCollections();
 
@@ -373,7 +391,6 @@ public:
 
     const Config& _config;
     DBDirectClient _db;
-    bool _useIncremental;  // use an incremental collection
 
 protected:
     /**
@@ -392,6 +409,10 @@ protected:
     long _size;      // bytes in _temp
     long _dupCount;  // number of duplicate key entries
 
+    // Tuples spilled from _temp when it grows too large, sorted by key for the final reduce.
+    std::unique_ptr<IncSorter> _incSorter;
+    long long _numIncTuples = 0;
+
     long long _numEmits;
 
     bool _jsMode;
@@ -0,0 +1,163 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <string>
+#include <vector>
+
+#include "mongo/base/init.h"
+#include "mongo/db/auth/action_set.h"
+#include "mongo/db/auth/action_type.h"
+#include "mongo/db/auth/privilege.h"
+#include "mongo/db/commands.h"
+#include "mongo/db/commands/server_status.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/util/sampling_profiler.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Controls and reports on the sampling CPU profiler.
+ *
+ * Format
+ * {
+ *    samplingProfiler: <string>, // one of 'start', 'stop', 'reset' or 'report'.
+ *    samplesPerSecond: <int>, // for 'start'; defaults to 100.
+ *    maxStacks: <int> // for 'report'; the number of most sampled stacks to return, default 100.
+ * }
+ *
+ * To keep the profiler on from startup, run with --setParameter samplingProfilerRate=<n>.
+ */
+class SamplingProfilerCmd : public BasicCommand {
+public:
+    SamplingProfilerCmd() : BasicCommand("samplingProfiler") {}
+
+    AllowedOnSecondary secondaryAllowed(ServiceContext*) const override {
+        return AllowedOnSecondary::kAlways;
+    }
+
+    bool supportsWriteConcern(const BSONObj& cmd) const override {
+        return false;
+    }
+
+    bool adminOnly() const override {
+        return true;
+    }
+
+    void addRequiredPrivileges(const std::string& dbname,
+                               const BSONObj& cmdObj,
+                               std::vector<Privilege>* out) const override {
+        ActionSet actions;
+        actions.addAction(ActionType::cpuProfiler);
+        out->push_back(Privilege(ResourcePattern::forClusterResource(), actions));
+    }
+
+    std::string help() const override {
+        return "starts, stops, resets or reports on the sampling CPU profiler";
+    }
+
+    bool run(OperationContext* opCtx,
+             const std::string& dbname,
+             const BSONObj& cmdObj,
+             BSONObjBuilder& result) override {
+        const std::string action = cmdObj.firstElement().str();
+
+        if (action == "start") {
+            long long samplesPerSecond = 100;
+            if (auto elem = cmdObj["samplesPerSecond"]) {
+                uassert(ErrorCodes::TypeMismatch,
+                        "samplesPerSecond must be a number",
+                        elem.isNumber());
+                samplesPerSecond = elem.safeNumberLong();
+            }
+            uassert(ErrorCodes::BadValue,
+                    "samplesPerSecond must be between 1 and 1000",
+                    samplesPerSecond >= 1 && samplesPerSecond <= 1000);
+            uassertStatusOK(SamplingProfiler::start(static_cast<int>(samplesPerSecond)));
+        } else if (action == "stop") {
+            SamplingProfiler::stop();
+        } else if (action == "reset") {
+            uassertStatusOK(SamplingProfiler::reset());
+        } else if (action == "report") {
+            long long maxStacks = 100;
+            if (auto elem = cmdObj["maxStacks"]) {
+                uassert(ErrorCodes::TypeMismatch, "maxStacks must be a number", elem.isNumber());
+                maxStacks = elem.safeNumberLong();
+            }
+            uassert(ErrorCodes::BadValue, "maxStacks must not be negative", maxStacks >= 0);
+            SamplingProfiler::report(maxStacks, &result);
+            return true;
+        } else {
+            uasserted(ErrorCodes::BadValue,
+                      str::stream() << "unknown samplingProfiler action '" << action
+                                    << "'; expected 'start', 'stop', 'reset' or 'report'");
+        }
+
+        SamplingProfiler::reportTotals(&result);
+        return true;
+    }
+} samplingProfilerCmd;
+
+int samplingProfilerStartupRate = 0;
+
+ExportedServerParameter<int, ServerParameterType::kStartupOnly> samplingProfilerRateParameter(
+    ServerParameterSet::getGlobal(), "samplingProfilerRate", &samplingProfilerStartupRate);
+
+/**
+ * Reports totals only, so that FTDC, which samples serverStatus, records the profiler's activity
+ * without its schema changing as stacks are discovered. Use the samplingProfiler command for the
+ * stacks themselves.
+ */
+class SamplingProfilerServerStatusSection final : public ServerStatusSection {
+public:
+    SamplingProfilerServerStatusSection() : ServerStatusSection("samplingProfiler") {}
+
+    bool includeByDefault() const override {
+        return SamplingProfiler::isSupported();
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        BSONObjBuilder builder;
+        SamplingProfiler::reportTotals(&builder);
+        return builder.obj();
+    }
+} samplingProfilerServerStatusSection;
+
+MONGO_INITIALIZER_GENERAL(StartSamplingProfiler, ("EndStartupOptionHandling"), ("default"))
+(InitializerContext* context) {
+    if (samplingProfilerStartupRate > 0) {
+        return SamplingProfiler::start(samplingProfilerStartupRate);
+    }
+    return Status::OK();
+}
+
+}  // namespace
+}  // namespace mongo
@@ -38,6 +38,7 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/repl/repl_client_info.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/transaction_coordinator_factory.h"
 #include "mongo/db/transaction_participant.h"
 #include "mongo/util/log.h"
 
@@ -106,6 +107,10 @@ public:
         } else {
             // commitUnpreparedTransaction will throw if the transaction is prepared.
             txnParticipant->commitUnpreparedTransaction(opCtx);
+
+            // A transaction that commits without being prepared only ran on this shard, so if
+            // this shard was chosen as its coordinator, the coordinator will never be used.
+            releaseUnusedTransactionCoordinator(opCtx, *opCtx->getTxnNumber());
         }
 
         return true;
@@ -39,6 +39,7 @@
 #include "mongo/db/db_raii.h"
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/storage/record_store.h"
+#include "mongo/db/storage/storage_engine.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/log.h"
 #include "mongo/util/scopeguard.h"
@@ -76,7 +77,8 @@ public:
                "Slow.\n"
                "Add full:true option to do a more thorough check\n"
                "Add scandata:false to skip the scan of the collection data without skipping scans "
-               "of any indexes";
+               "of any indexes\n"
+               "Add background:true to validate at a snapshot while writes continue";
     }
 
     virtual bool supportsWriteConcern(const BSONObj& cmd) const override {
@@ -89,7 +91,8 @@ public:
         actions.addAction(ActionType::validate);
         out->push_back(Privilege(parseResourcePattern(dbname, cmdObj), actions));
     }
-    //{ validate: "collectionnamewithoutthedbpart" [, scandata: <bool>] [, full: <bool> } */
+    //{ validate: "collectionnamewithoutthedbpart" [, scandata: <bool>] [, full: <bool>]
+    //  [, background: <bool>] } */
 
     bool run(OperationContext* opCtx,
              const string& dbname,
@@ -104,6 +107,7 @@ public:
 
         const bool full = cmdObj["full"].trueValue();
         const bool scanData = cmdObj["scandata"].trueValue();
+        const bool background = cmdObj["background"].trueValue();
 
         ValidateCmdLevel level = kValidateIndex;
 
@@ -118,12 +122,28 @@ public:
                       "Can only run full validate on a regular collection");
         }
 
+        if (background) {
+            // Full validation checks the storage engine's own structures, which can only be done
+            // with exclusive access to the collection.
+            uassert(ErrorCodes::InvalidOptions,
+                    "Running validate with both {background: true} and {full: true} is not "
+                    "supported",
+                    !full);
+            uassert(ErrorCodes::CommandNotSupported,
+                    "Running validate with {background: true} requires a storage engine that "
+                    "supports document-level locking",
+                    opCtx->getServiceContext()->getStorageEngine()->supportsDocLocking());
+        }
+
         if (!serverGlobalParams.quiet.load()) {
             LOG(0) << "CMD: validate " << nss.ns();
         }
 
-        AutoGetDb ctx(opCtx, nss.db(), MODE_IX);
-        auto collLk = stdx::make_unique<Lock::CollectionLock>(opCtx->lockState(), nss.ns(), MODE_X);
+        // A background validation reads at a snapshot and only needs to keep the collection from
+        // being dropped, so writes can continue while it runs.
+        AutoGetDb ctx(opCtx, nss.db(), background ? MODE_IS : MODE_IX);
+        auto collLk = stdx::make_unique<Lock::CollectionLock>(
+            opCtx->lockState(), nss.ns(), background ? MODE_IS : MODE_X);
         Collection* collection = ctx.getDb() ? ctx.getDb()->getCollection(opCtx, nss) : NULL;
         if (!collection) {
             if (ctx.getDb() && ctx.getDb()->getViewCatalog()->lookup(opCtx, nss.ns())) {
@@ -159,9 +179,6 @@ public:
             _validationNotifier.notify_all();
         });
 
-        // TODO SERVER-30357: Add support for background validation.
-        const bool background = false;
-
         ValidateResults results;
         Status status =
             collection->validate(opCtx, level, background, std::move(collLk), &results, &result);
@@ -1176,6 +1176,45 @@ TEST_F(DConcurrencyTestFixture, NoThrottlingWhenNotAcquiringTickets) {
     ASSERT(R2.isLocked());
 }
 
+TEST_F(DConcurrencyTestFixture, PriorityTicketAdmissionUsesReserveWhenTicketsAreExhausted) {
+    auto clientOpctxPairs = makeKClientsWithLockers(3);
+    auto opctx1 = clientOpctxPairs[0].second.get();
+    auto opctx2 = clientOpctxPairs[1].second.get();
+    auto opctx3 = clientOpctxPairs[2].second.get();
+    // Limit the lockers to 1 regular ticket and 1 priority ticket at a time.
+    UseGlobalThrottling throttle(opctx1, 1);
+    TicketHolder reserve(1);
+    Locker::setGlobalPriorityTicketReserves(&reserve, &reserve);
+    ON_BLOCK_EXIT([] { Locker::setGlobalPriorityTicketReserves(nullptr, nullptr); });
+
+    opctx2->lockState()->setPriorityTicketAdmission(true);
+    opctx3->lockState()->setPriorityTicketAdmission(true);
+
+    {
+        Lock::GlobalRead R1(opctx1, Date_t::now(), Lock::InterruptBehavior::kThrow);
+        ASSERT(R1.isLocked());
+
+        {
+            // The priority locker gets the reserved ticket rather than queueing.
+            Lock::GlobalRead R2(opctx2, Date_t::now(), Lock::InterruptBehavior::kThrow);
+            ASSERT(R2.isLocked());
+            ASSERT_EQ(reserve.used(), 1);
+
+            // Once the reserve is used up, priority lockers queue like any other.
+            Lock::GlobalRead R3(opctx3, Date_t::now(), Lock::InterruptBehavior::kThrow);
+            ASSERT(!R3.isLocked());
+        }
+
+        // The reserved ticket went back to the reserve.
+        ASSERT_EQ(reserve.used(), 0);
+    }
+
+    // With a regular ticket free, the priority locker leaves the reserve alone.
+    Lock::GlobalRead R2(opctx2, Date_t::now(), Lock::InterruptBehavior::kThrow);
+    ASSERT(R2.isLocked());
+    ASSERT_EQ(reserve.used(), 0);
+}
+
 TEST_F(DConcurrencyTestFixture, ReleaseAndReacquireTicket) {
     auto clientOpctxPairs = makeKClientsWithLockers(2);
     auto opctx1 = clientOpctxPairs[0].second.get();
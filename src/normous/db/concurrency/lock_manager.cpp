@@ -32,6 +32,7 @@
 
 #include "mongo/db/concurrency/lock_manager.h"
 
+#include <algorithm>
 #include <third_party/murmurhash3/MurmurHash3.h>
 
 #include "mongo/base/data_type_endian.h"
@@ -73,6 +74,9 @@ static const int LockConflictsTable[] = {
 // Mask of modes
 const uint64_t intentModes = (1 << MODE_IS) | (1 << MODE_IX);
 
+// Number of lock requests, across all lock managers, currently queued on a conflict list.
+AtomicWord<long long> numWaitingRequests{0};
+
 // Ensure we do not add new modes without updating the conflicts table
 MONGO_STATIC_ASSERT((sizeof(LockConflictsTable) / sizeof(LockConflictsTable[0])) == LockModesCount);
 
@@ -298,6 +302,7 @@ void LockHead::decGrantedModeCount(LockMode mode) {
 
 void LockHead::incConflictModeCount(LockMode mode) {
     invariant(conflictCounts[mode] >= 0);
+    numWaitingRequests.fetchAndAdd(1);
     if (++conflictCounts[mode] == 1) {
         invariant((conflictModes & modeMask(mode)) == 0);
         conflictModes |= modeMask(mode);
@@ -306,6 +311,7 @@ void LockHead::incConflictModeCount(LockMode mode) {
 
 void LockHead::decConflictModeCount(LockMode mode) {
     invariant(conflictCounts[mode] >= 1);
+    numWaitingRequests.fetchAndSubtract(1);
     if (--conflictCounts[mode] == 0) {
         invariant((conflictModes & modeMask(mode)) == modeMask(mode));
         conflictModes &= ~modeMask(mode);
@@ -323,10 +329,7 @@ const unsigned LockManager::_numLockBuckets(128);
 // The exact value doesn't appear very important, but should be power of two
 const unsigned LockManager::_numPartitions = 32;
 
-LockManager::LockManager() {
-    _lockBuckets = new LockBucket[_numLockBuckets];
-    _partitions = new Partition[_numPartitions];
-}
+LockManager::LockManager() : _lockBuckets(_numLockBuckets), _partitions(_numPartitions) {}
 
 LockManager::~LockManager() {
     cleanupUnusedLocks();
@@ -335,9 +338,6 @@ LockManager::~LockManager() {
         // TODO: dump more information about the non-empty bucket to see what locks were leaked
         invariant(_lockBuckets[i].data.empty());
     }
-
-    delete[] _lockBuckets;
-    delete[] _partitions;
 }
 
 LockResult LockManager::lock(ResourceId resId, LockRequest* request, LockMode mode) {
@@ -567,6 +567,10 @@ void LockManager::downgrade(LockRequest* request, LockMode newMode) {
     _onLockModeChanged(lock, true);
 }
 
+long long LockManager::getNumWaitingRequests() {
+    return numWaitingRequests.load();
+}
+
 void LockManager::cleanupUnusedLocks() {
     for (unsigned i = 0; i < _numLockBuckets; i++) {
         LockBucket* bucket = &_lockBuckets[i];
@@ -799,6 +803,109 @@ void LockManager::getLockInfoBSON(const std::map<LockerId, BSONObj>& lockToClien
     result->append("lockInfo", lockInfo.arr());
 }
 
+std::vector<BSONObj> LockManager::getLockContentionSample() const {
+    struct RequestSample {
+        LockerId lockerId;
+        LockMode mode;
+        bool waiting;
+    };
+
+    struct ResourceSample {
+        ResourceId resourceId;
+        std::vector<RequestSample> requests;
+        size_t numWaiting;
+    };
+
+    if (getNumWaitingRequests() == 0) {
+        return {};
+    }
+
+    std::vector<ResourceSample> samples;
+
+    for (unsigned i = 0; i < _numLockBuckets; i++) {
+        LockBucket* bucket = &_lockBuckets[i];
+        stdx::unique_lock<SimpleMutex> scopedLock(bucket->mutex, stdx::try_to_lock);
+        if (!scopedLock.owns_lock()) {
+            continue;
+        }
+
+        for (auto& bucketEntry : bucket->data) {
+            const LockHead* lock = bucketEntry.second;
+            if (lock->conflictList.empty() && lock->conversionsCount == 0) {
+                continue;
+            }
+
+            ResourceSample sample{lock->resourceId, {}, 0};
+            for (const LockRequest* iter = lock->grantedList._front; iter != nullptr;
+                 iter = iter->next) {
+                sample.requests.push_back({iter->locker->getId(), iter->mode, false});
+
+                // A pending conversion waits on the other holders in its target mode.
+                if (iter->convertMode != MODE_NONE) {
+                    sample.requests.push_back({iter->locker->getId(), iter->convertMode, true});
+                    sample.numWaiting++;
+                }
+            }
+            for (const LockRequest* iter = lock->conflictList._front; iter != nullptr;
+                 iter = iter->next) {
+                sample.requests.push_back({iter->locker->getId(), iter->mode, true});
+                sample.numWaiting++;
+            }
+            samples.push_back(std::move(sample));
+        }
+    }
+
+    // Build the documents outside of the bucket mutexes.
+    std::sort(samples.begin(), samples.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.numWaiting > rhs.numWaiting;
+    });
+
+    std::vector<BSONObj> result;
+    result.reserve(samples.size());
+    for (const auto& sample : samples) {
+        BSONObjBuilder b;
+        b.append("resourceId", sample.resourceId.toString());
+        b.append("resourceType", resourceTypeName(sample.resourceId.getType()));
+        b.append("numWaiting", static_cast<long long>(sample.numWaiting));
+
+        BSONArrayBuilder granted(b.subarrayStart("granted"));
+        for (const auto& request : sample.requests) {
+            if (!request.waiting) {
+                granted.append(BSON("lockerId" << static_cast<long long>(request.lockerId)
+                                               << "mode"
+                                               << modeName(request.mode)));
+            }
+        }
+        granted.doneFast();
+
+        BSONArrayBuilder waiting(b.subarrayStart("waiting"));
+        for (const auto& request : sample.requests) {
+            if (!request.waiting) {
+                continue;
+            }
+
+            BSONObjBuilder waiter(waiting.subobjStart());
+            waiter.append("lockerId", static_cast<long long>(request.lockerId));
+            waiter.append("mode", modeName(request.mode));
+
+            BSONArrayBuilder waitingFor(waiter.subarrayStart("waitingFor"));
+            for (const auto& holder : sample.requests) {
+                if (!holder.waiting && holder.lockerId != request.lockerId &&
+                    conflicts(request.mode, modeMask(holder.mode))) {
+                    waitingFor.append(static_cast<long long>(holder.lockerId));
+                }
+            }
+            waitingFor.doneFast();
+            waiter.doneFast();
+        }
+        waiting.doneFast();
+
+        result.push_back(b.obj());
+    }
+
+    return result;
+}
+
 void LockManager::_dumpBucket(const LockBucket* bucket) const {
     for (LockBucket::Map::const_iterator it = bucket->data.begin(); it != bucket->data.end();
          it++) {
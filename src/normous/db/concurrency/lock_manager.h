@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <boost/align/aligned_allocator.hpp>
 #include <cstdint>
 #include <deque>
 #include <map>
@@ -41,6 +42,7 @@
 #include "mongo/platform/compiler.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/mutex.h"
+#include "mongo/stdx/new.h"
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/util/concurrency/mutex.h"
 
@@ -121,6 +123,13 @@ public:
      */
     void cleanupUnusedLocks();
 
+    /**
+     * Returns the number of lock requests which are currently waiting on a conflicting request,
+     * summed over all lock managers in the process. This is a single atomic read and is cheap
+     * enough to be polled by running operations to decide whether anybody is waiting on them.
+     */
+    static long long getNumWaitingRequests();
+
     /**
      * Dumps the contents of all locks to the log.
      */
@@ -133,6 +142,18 @@ public:
     void getLockInfoBSON(const std::map<LockerId, BSONObj>& lockToClientMap,
                          BSONObjBuilder* result);
 
+    /**
+     * Returns one document for each resource which currently has requests waiting on it, most
+     * waited on resources first. Each document lists the granted requests and the waiting ones,
+     * with the lockers each waiter is blocked behind, i.e. the edges of the wait-for graph.
+     *
+     * Unlike getLockInfoBSON, this is safe to call while the server is struggling with lock
+     * contention: it returns immediately if nothing is waiting, never blocks on a bucket mutex
+     * (busy buckets are skipped), and only holds a bucket while copying its contended entries.
+     * The result is therefore a best-effort sample, not a consistent snapshot.
+     */
+    std::vector<BSONObj> getLockContentionSample() const;
+
 private:
     // The deadlock detector needs to access the buckets and locks directly
     friend class DeadlockDetector;
@@ -144,9 +165,11 @@ private:
     // encapsulate specific logic for replication state transitions.
     friend class ReplicationLockManagerManipulator;
 
-    // These types describe the locks hash table
+    // These types describe the locks hash table. Buckets and partitions are allocated as arrays
+    // and each carries its own mutex, so they are cache line aligned to keep threads working on
+    // neighbouring entries from invalidating each other's lines.
 
-    struct LockBucket {
+    struct alignas(stdx::hardware_destructive_interference_size) LockBucket {
         SimpleMutex mutex;
         typedef stdx::unordered_map<ResourceId, LockHead*> Map;
         Map data;
@@ -156,7 +179,7 @@ private:
     // Each locker maps to a partition that is used for resources acquired in intent modes
     // modes and potentially other modes that don't conflict with themselves. This avoids
     // contention on the regular LockHead in the lock manager.
-    struct Partition {
+    struct alignas(stdx::hardware_destructive_interference_size) Partition {
         PartitionedLockHead* find(ResourceId resId);
         PartitionedLockHead* findOrInsert(ResourceId resId);
         typedef stdx::unordered_map<ResourceId, PartitionedLockHead*> Map;
@@ -217,11 +240,14 @@ private:
      */
     void _cleanupUnusedLocksInBucket(LockBucket* bucket);
 
+    template <typename T>
+    using AlignedVector = std::vector<T, boost::alignment::aligned_allocator<T>>;
+
     static const unsigned _numLockBuckets;
-    LockBucket* _lockBuckets;
+    mutable AlignedVector<LockBucket> _lockBuckets;
 
     static const unsigned _numPartitions;
-    Partition* _partitions;
+    mutable AlignedVector<Partition> _partitions;
 };
 
 
@@ -382,6 +382,88 @@ TEST(LockManager, ConflictCancelWaiting) {
     lockMgr.unlock(&request1);
 }
 
+TEST(LockManager, NumWaitingRequests) {
+    LockManager lockMgr;
+    const ResourceId resId(RESOURCE_COLLECTION, std::string("TestDB.collection"));
+
+    LockerImpl locker1;
+    LockerImpl locker2;
+    LockerImpl locker3;
+
+    LockRequestCombo request1(&locker1);
+    LockRequestCombo request2(&locker2);
+    LockRequestCombo request3(&locker3);
+
+    const long long numWaitingBefore = LockManager::getNumWaitingRequests();
+
+    ASSERT(LOCK_OK == lockMgr.lock(resId, &request1, MODE_X));
+    ASSERT_EQ(numWaitingBefore, LockManager::getNumWaitingRequests());
+
+    ASSERT(LOCK_WAITING == lockMgr.lock(resId, &request2, MODE_S));
+    ASSERT(LOCK_WAITING == lockMgr.lock(resId, &request3, MODE_S));
+    ASSERT_EQ(numWaitingBefore + 2, LockManager::getNumWaitingRequests());
+
+    // Cancelling a waiting request stops counting it
+    lockMgr.unlock(&request3);
+    ASSERT_EQ(numWaitingBefore + 1, LockManager::getNumWaitingRequests());
+
+    // So does granting it
+    lockMgr.unlock(&request1);
+    ASSERT(request2.lastResult == LOCK_OK);
+    ASSERT_EQ(numWaitingBefore, LockManager::getNumWaitingRequests());
+
+    lockMgr.unlock(&request2);
+    ASSERT_EQ(numWaitingBefore, LockManager::getNumWaitingRequests());
+}
+
+TEST(LockManager, LockContentionSample) {
+    LockManager lockMgr;
+    const ResourceId resId(RESOURCE_COLLECTION, std::string("TestDB.collection"));
+    const ResourceId otherResId(RESOURCE_COLLECTION, std::string("TestDB.other"));
+
+    LockerImpl locker1;
+    LockerImpl locker2;
+    LockerImpl locker3;
+
+    LockRequestCombo request1(&locker1);
+    LockRequestCombo request2(&locker2);
+    LockRequestCombo request3(&locker3);
+    LockRequestCombo request4(&locker1);
+
+    // Uncontended resources are not reported
+    ASSERT(LOCK_OK == lockMgr.lock(otherResId, &request4, MODE_X));
+    ASSERT(lockMgr.getLockContentionSample().empty());
+
+    ASSERT(LOCK_OK == lockMgr.lock(resId, &request1, MODE_S));
+    ASSERT(LOCK_WAITING == lockMgr.lock(resId, &request2, MODE_X));
+    ASSERT(LOCK_WAITING == lockMgr.lock(resId, &request3, MODE_S));
+
+    auto sample = lockMgr.getLockContentionSample();
+    ASSERT_EQ(1U, sample.size());
+    ASSERT_EQ(resId.toString(), sample[0]["resourceId"].str());
+    ASSERT_EQ(2, sample[0]["numWaiting"].numberLong());
+
+    auto granted = sample[0]["granted"].Array();
+    ASSERT_EQ(1U, granted.size());
+    ASSERT_EQ(static_cast<long long>(locker1.getId()), granted[0]["lockerId"].numberLong());
+
+    // The X waiter conflicts with the S holder. The S waiter is only queued behind the X waiter,
+    // which does not hold anything yet, so it has no wait-for edges.
+    auto waiting = sample[0]["waiting"].Array();
+    ASSERT_EQ(2U, waiting.size());
+    ASSERT_EQ(static_cast<long long>(locker2.getId()), waiting[0]["lockerId"].numberLong());
+    auto waitingFor = waiting[0]["waitingFor"].Array();
+    ASSERT_EQ(1U, waitingFor.size());
+    ASSERT_EQ(static_cast<long long>(locker1.getId()), waitingFor[0].numberLong());
+    ASSERT(waiting[1]["waitingFor"].Array().empty());
+
+    lockMgr.unlock(&request3);
+    lockMgr.unlock(&request2);
+    lockMgr.unlock(&request1);
+    lockMgr.unlock(&request4);
+    ASSERT(lockMgr.getLockContentionSample().empty());
+}
+
 TEST(LockManager, ConflictCancelMultipleWaiting) {
     LockManager lockMgr;
     const ResourceId resId(RESOURCE_COLLECTION, std::string("TestDB.collection"));
@@ -238,6 +238,7 @@ void CondVarLockGrantNotification::notify(ResourceId resId, LockResult result) {
 
 namespace {
 TicketHolder* ticketHolders[LockModesCount] = {};
+TicketHolder* priorityTicketHolders[LockModesCount] = {};
 }  // namespace
 
 
@@ -252,6 +253,14 @@ void Locker::setGlobalThrottling(class TicketHolder* reading, class TicketHolder
     ticketHolders[MODE_IX] = writing;
 }
 
+/* static */
+void Locker::setGlobalPriorityTicketReserves(class TicketHolder* reading,
+                                             class TicketHolder* writing) {
+    priorityTicketHolders[MODE_S] = reading;
+    priorityTicketHolders[MODE_IS] = reading;
+    priorityTicketHolders[MODE_IX] = writing;
+}
+
 LockerImpl::LockerImpl()
     : _id(idCounter.addAndFetch(1)), _wuowNestingLevel(0), _threadId(stdx::this_thread::get_id()) {}
 
@@ -338,11 +347,33 @@ LockResult LockerImpl::_acquireTicket(OperationContext* opCtx, LockMode mode, Da
         // If the ticket wait is interrupted, restore the state of the client.
         auto restoreStateOnErrorGuard = MakeGuard([&] { _clientState.store(kInactive); });
 
+        // Priority lockers take a regular ticket when one is free and only fall back to the
+        // reserve when none is, so that the reserve is left for when user operations have
+        // exhausted the regular tickets. With the reserve also used up, they queue as usual.
+        auto priorityHolder =
+            hasPriorityTicketAdmission() ? priorityTicketHolders[mode] : nullptr;
+        bool acquired = false;
+        _holdsPriorityTicket = false;
+        if (priorityHolder) {
+            acquired = holder->tryAcquire();
+            if (!acquired && priorityHolder->tryAcquire()) {
+                acquired = true;
+                _holdsPriorityTicket = true;
+            }
+        }
+
         OperationContext* interruptible = _uninterruptibleLocksRequested ? nullptr : opCtx;
-        if (deadline == Date_t::max()) {
-            holder->waitForTicket(interruptible);
-        } else if (!holder->waitForTicketUntil(interruptible, deadline)) {
-            return LOCK_TIMEOUT;
+        if (!acquired && !holder->tryAcquire()) {
+            const uint64_t startOfWaitTime = curTimeMicros64();
+            ON_BLOCK_EXIT([&] {
+                _ticketWaitTime +=
+                    Microseconds(static_cast<long long>(curTimeMicros64() - startOfWaitTime));
+            });
+            if (deadline == Date_t::max()) {
+                holder->waitForTicket(interruptible);
+            } else if (!holder->waitForTicketUntil(interruptible, deadline)) {
+                return LOCK_TIMEOUT;
+            }
         }
         restoreStateOnErrorGuard.Dismiss();
     }
@@ -918,6 +949,10 @@ void LockerImpl::releaseTicket() {
 
 void LockerImpl::_releaseTicket() {
     auto holder = shouldAcquireTicket() ? ticketHolders[_modeForTicket] : nullptr;
+    if (holder && _holdsPriorityTicket) {
+        holder = priorityTicketHolders[_modeForTicket];
+        _holdsPriorityTicket = false;
+    }
     if (holder) {
         holder->release();
     }
@@ -73,6 +73,14 @@ public:
      */
     static void setGlobalThrottling(class TicketHolder* reading, class TicketHolder* writing);
 
+    /**
+     * Sets the reserves of tickets that lockers with priority ticket admission fall back to when
+     * the tickets from setGlobalThrottling() are all in use. The holders must have static
+     * lifetimes. Without reserves, priority lockers queue for tickets like any other.
+     */
+    static void setGlobalPriorityTicketReserves(class TicketHolder* reading,
+                                                class TicketHolder* writing);
+
     /**
      * State for reporting the number of active and queued reader and writer clients.
      */
@@ -451,6 +459,28 @@ public:
     bool shouldAcquireTicket() const {
         return _shouldAcquireTicket;
     }
+
+    /**
+     * If set to true, a ticket that is not immediately available is taken from the priority
+     * reserve, if there is one, rather than waited for. This is meant for internal work such as
+     * oplog application and TTL deletes, which should not queue behind user operations when
+     * those use up all of the tickets.
+     */
+    void setPriorityTicketAdmission(bool newValue) {
+        invariant(!isLocked() || isNoop());
+        _priorityTicketAdmission = newValue;
+    }
+    bool hasPriorityTicketAdmission() const {
+        return _priorityTicketAdmission;
+    }
+
+    /**
+     * Returns the cumulative time this locker has spent waiting for tickets.
+     */
+    Microseconds getTicketWaitTime() const {
+        return _ticketWaitTime;
+    }
+
     /**
      * This function is for unit testing only.
      */
@@ -475,9 +505,15 @@ protected:
      */
     unsigned _numResourcesToUnlockAtEndUnitOfWork = 0;
 
+    /**
+     * The cumulative time spent waiting for tickets that were not immediately available.
+     */
+    Microseconds _ticketWaitTime{0};
+
 private:
     bool _shouldConflictWithSecondaryBatchApplication = true;
     bool _shouldAcquireTicket = true;
+    bool _priorityTicketAdmission = false;
 };
 
 /**
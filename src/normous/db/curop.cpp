@@ -46,6 +46,8 @@
 #include "mongo/db/json.h"
 #include "mongo/db/query/getmore_request.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_stats_store.h"
+#include "mongo/db/sorter/sorter.h"
 #include "mongo/rpc/metadata/client_metadata.h"
 #include "mongo/rpc/metadata/client_metadata_ismaster.h"
 #include "mongo/rpc/metadata/impersonated_user_metadata.h"
@@ -291,6 +293,9 @@ void CurOp::reportCurrentOpForClient(OperationContext* opCtx,
         }
 
         CurOp::get(clientOpCtx)->reportState(infoBuilder, truncateOps);
+
+        BSONObjBuilder storageBuilder(infoBuilder->subobjStart("storage"));
+        CurOp::get(clientOpCtx)->getStorageStats(clientOpCtx).append(&storageBuilder);
     }
 }
 
@@ -301,11 +306,17 @@ void CurOp::setGenericCursor_inlock(GenericCursor gc) {
 CurOp::CurOp(OperationContext* opCtx) : CurOp(opCtx, &_curopStack(opCtx)) {
     // If this is a sub-operation, we store the snapshot of lock stats as the base lock stats of the
     // current operation.
-    if (_parent != nullptr)
+    if (_parent != nullptr) {
         _lockStatsBase = opCtx->lockState()->getLockerInfo(boost::none)->stats;
+        _ticketWaitBase = opCtx->lockState()->getTicketWaitTime();
+        _storageStatsBase = StorageOperationStats::get(opCtx).snapshot();
+    }
 }
 
 CurOp::CurOp(OperationContext* opCtx, CurOpStack* stack) : _stack(stack) {
+    if (opCtx && opCtx->getServiceContext() && opCtx->getServiceContext()->getTickSource()) {
+        _tickSource = opCtx->getServiceContext()->getTickSource();
+    }
     if (opCtx) {
         _stack->push(opCtx, this);
     } else {
@@ -314,8 +325,10 @@ CurOp::CurOp(OperationContext* opCtx, CurOpStack* stack) : _stack(stack) {
 }
 
 CurOp::~CurOp() {
-    if (parent() != nullptr)
+    if (parent() != nullptr) {
         parent()->yielded(_numYields);
+        parent()->_numYieldsSkipped += _numYieldsSkipped;
+    }
     invariant(this == _stack->pop());
 }
 
@@ -363,7 +376,7 @@ void CurOp::setNS_inlock(StringData ns) {
 
 void CurOp::ensureStarted() {
     if (_start == 0) {
-        _start = curTimeMicros64();
+        _start = _tickSource->getTicks();
     }
 }
 
@@ -396,9 +409,27 @@ bool CurOp::completeAndLogOperation(OperationContext* opCtx,
     }
 
     // Obtain the total execution time of this operation.
-    _end = curTimeMicros64();
+    _end = _tickSource->getTicks();
     _debug.executionTimeMicros = durationCount<Microseconds>(elapsedTimeExcludingPauses());
 
+    addPhaseTime(Phase::kTicketWait, opCtx->lockState()->getTicketWaitTime() - _ticketWaitBase);
+
+    auto storageStats = getStorageStats(opCtx);
+    _debug.storageBytesRead = storageStats.bytesRead;
+    _debug.storageBytesWritten = storageStats.bytesWritten;
+
+    if (!_debug.queryStatsKey.empty() && QueryStatsStore::isEnabled()) {
+        QueryStatsStore::Execution execution;
+        execution.isGetMore = (_logicalOp == LogicalOp::opGetMore);
+        execution.micros = _debug.executionTimeMicros;
+        execution.keysExamined = _debug.additiveMetrics.keysExamined.value_or(0);
+        execution.docsExamined = _debug.additiveMetrics.docsExamined.value_or(0);
+        execution.nreturned = std::max(_debug.nreturned, 0LL);
+        execution.bytesReturned = std::max(_debug.responseLength, 0);
+        const auto now = opCtx->getServiceContext()->getFastClockSource()->now();
+        QueryStatsStore::get(opCtx).record(_debug.queryStatsKey, execution, now);
+    }
+
     const bool shouldSample =
         client->getPrng().nextCanonicalDouble() < serverGlobalParams.sampleRate;
 
@@ -528,6 +559,37 @@ void CurOp::reportState(BSONObjBuilder* builder, bool truncateOps) {
     }
 
     builder->append("numYields", _numYields);
+    if (_numYieldsSkipped) {
+        builder->append("numYieldsSkipped", _numYieldsSkipped);
+    }
+
+    appendPhaseTimes(builder);
+}
+
+StringData CurOp::phaseName(Phase phase) {
+    switch (phase) {
+        case Phase::kPlanning:
+            return "planning"_sd;
+        case Phase::kTicketWait:
+            return "ticketWait"_sd;
+        case Phase::kAdmissionWait:
+            return "admissionWait"_sd;
+        case Phase::kNumPhases:
+            break;
+    }
+    MONGO_UNREACHABLE;
+}
+
+void CurOp::appendPhaseTimes(BSONObjBuilder* builder) const {
+    boost::optional<BSONObjBuilder> phaseBuilder;
+    for (size_t i = 0; i < _phaseMicros.size(); ++i) {
+        const long long micros = _phaseMicros[i].load();
+        if (micros <= 0)
+            continue;
+        if (!phaseBuilder)
+            phaseBuilder.emplace(builder->subobjStart("phaseMicros"));
+        phaseBuilder->appendNumber(phaseName(static_cast<Phase>(i)), micros);
+    }
 }
 
 namespace {
@@ -611,6 +673,17 @@ string OpDebug::report(Client* client,
     OPDEBUG_TOSTRING_HELP_OPTIONAL("docsExamined", additiveMetrics.docsExamined);
     OPDEBUG_TOSTRING_HELP_BOOL(hasSortStage);
     OPDEBUG_TOSTRING_HELP_BOOL(usedDisk);
+    if (sortSpilledBytes > 0) {
+        s << " sortSpilledBytes:" << sortSpilledBytes << " sortSpillMicros:" << sortSpillMicros;
+    }
+    if (writeConcernSyncMicros > 0 || writeConcernReplicationMicros > 0) {
+        s << " writeConcernSyncMicros:" << writeConcernSyncMicros
+          << " writeConcernReplicationMicros:" << writeConcernReplicationMicros;
+    }
+    if (storageBytesRead > 0 || storageBytesWritten > 0) {
+        s << " storageBytesRead:" << storageBytesRead
+          << " storageBytesWritten:" << storageBytesWritten;
+    }
     OPDEBUG_TOSTRING_HELP_BOOL(fromMultiPlanner);
     OPDEBUG_TOSTRING_HELP_BOOL(replanned);
     OPDEBUG_TOSTRING_HELP_OPTIONAL("nMatched", additiveMetrics.nMatched);
@@ -628,6 +701,9 @@ string OpDebug::report(Client* client,
     OPDEBUG_TOSTRING_HELP_OPTIONAL("writeConflicts", additiveMetrics.writeConflicts);
 
     s << " numYields:" << curop.numYields();
+    if (curop.numYieldsSkipped()) {
+        s << " numYieldsSkipped:" << curop.numYieldsSkipped();
+    }
     OPDEBUG_TOSTRING_HELP(nreturned);
 
     if (queryHash) {
@@ -652,6 +728,15 @@ string OpDebug::report(Client* client,
         s << " locks:" << locks.obj().toString();
     }
 
+    {
+        BSONObjBuilder phases;
+        curop.appendPhaseTimes(&phases);
+        auto phasesObj = phases.obj();
+        if (!phasesObj.isEmpty()) {
+            s << " phaseMicros:" << phasesObj.firstElement().Obj().toString();
+        }
+    }
+
     if (iscommand) {
         s << " protocol:" << getProtoString(networkOp);
     }
@@ -696,6 +781,18 @@ void OpDebug::append(const CurOp& curop,
     OPDEBUG_APPEND_OPTIONAL("docsExamined", additiveMetrics.docsExamined);
     OPDEBUG_APPEND_BOOL(hasSortStage);
     OPDEBUG_APPEND_BOOL(usedDisk);
+    if (sortSpilledBytes > 0) {
+        b.appendNumber("sortSpilledBytes", sortSpilledBytes);
+        b.appendNumber("sortSpillMicros", sortSpillMicros);
+    }
+    if (writeConcernSyncMicros > 0 || writeConcernReplicationMicros > 0) {
+        b.appendNumber("writeConcernSyncMicros", writeConcernSyncMicros);
+        b.appendNumber("writeConcernReplicationMicros", writeConcernReplicationMicros);
+    }
+    if (storageBytesRead > 0 || storageBytesWritten > 0) {
+        b.appendNumber("storageBytesRead", storageBytesRead);
+        b.appendNumber("storageBytesWritten", storageBytesWritten);
+    }
     OPDEBUG_APPEND_BOOL(fromMultiPlanner);
     OPDEBUG_APPEND_BOOL(replanned);
     OPDEBUG_APPEND_OPTIONAL("nMatched", additiveMetrics.nMatched);
@@ -713,6 +810,9 @@ void OpDebug::append(const CurOp& curop,
     OPDEBUG_APPEND_OPTIONAL("writeConflicts", additiveMetrics.writeConflicts);
 
     b.appendNumber("numYield", curop.numYields());
+    if (curop.numYieldsSkipped()) {
+        b.appendNumber("numYieldsSkipped", curop.numYieldsSkipped());
+    }
     OPDEBUG_APPEND_NUMBER(nreturned);
 
     if (queryHash) {
@@ -724,6 +824,8 @@ void OpDebug::append(const CurOp& curop,
         lockStats.report(&locks);
     }
 
+    curop.appendPhaseTimes(&b);
+
     if (!errInfo.isOK()) {
         b.appendNumber("ok", 0.0);
         if (!errInfo.reason().empty()) {
@@ -757,6 +859,11 @@ void OpDebug::setPlanSummaryMetrics(const PlanSummaryStats& planSummaryStats) {
     replanned = planSummaryStats.replanned;
 }
 
+void OpDebug::addSortSpill(const SorterSpillStats& spillStats) {
+    sortSpilledBytes += spillStats.spilledBytes.get();
+    sortSpillMicros += spillStats.spillMicros.get();
+}
+
 namespace {
 
 /**
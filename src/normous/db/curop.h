@@ -31,14 +31,20 @@
 
 #pragma once
 
+#include <array>
+
 #include "mongo/base/disallow_copying.h"
 #include "mongo/db/clientcursor.h"
 #include "mongo/db/commands.h"
 #include "mongo/db/cursor_id.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/storage/storage_operation_stats.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/util/progress_meter.h"
+#include "mongo/util/sampling_profiler.h"
+#include "mongo/util/system_tick_source.h"
+#include "mongo/util/tick_source.h"
 #include "mongo/util/time_support.h"
 
 namespace mongo {
@@ -47,6 +53,7 @@ class Client;
 class CurOp;
 class OperationContext;
 struct PlanSummaryStats;
+struct SorterSpillStats;
 
 /* lifespan is different than CurOp because of recursives with DBDirectClient */
 class OpDebug {
@@ -148,6 +155,12 @@ public:
      */
     void setPlanSummaryMetrics(const PlanSummaryStats& planSummaryStats);
 
+    /**
+     * Adds the spills counted in 'spillStats' to this operation's sortSpilledBytes and
+     * sortSpillMicros.
+     */
+    void addSortSpill(const SorterSpillStats& spillStats);
+
     // -------------------
 
     // basic options
@@ -169,6 +182,20 @@ public:
 
     bool usedDisk{false};  // true if the given query used disk
 
+    // Bytes that external sorts spilled to disk for this operation, and the time spent writing.
+    long long sortSpilledBytes{0};
+    long long sortSpillMicros{0};
+
+    // Time spent waiting for this operation's write concern, split into waiting for the write to
+    // be journaled or fsynced locally and waiting for it to replicate.
+    long long writeConcernSyncMicros{0};
+    long long writeConcernReplicationMicros{0};
+
+    // Bytes of records and index keys this operation read from, and records it wrote to, the
+    // storage engine. See StorageOperationStats.
+    long long storageBytesRead{0};
+    long long storageBytesWritten{0};
+
     // True if the plan came from the multi-planner (not from the plan cache and not a query with a
     // single solution).
     bool fromMultiPlanner{false};
@@ -185,6 +212,10 @@ public:
 
     boost::optional<uint32_t> queryHash;
 
+    // Key of the query shape whose statistics this operation adds to, or empty if the operation
+    // is not tracked by the QueryStatsStore.
+    std::string queryStatsKey;
+
     // Details of any error (whether from an exception or a command returning failure).
     Status errInfo = Status::OK();
 
@@ -385,20 +416,16 @@ public:
     }
 
     //
-    // Methods for getting/setting elapsed time. Note that the observed elapsed time may be
-    // negative, if the system time has been reset during the course of this operation.
+    // Methods for getting/setting elapsed time. Times are measured with the service context's
+    // TickSource, a monotonic clock, so they are unaffected by resets of the system time.
     //
 
     void ensureStarted();
     bool isStarted() const {
         return _start > 0;
     }
-    long long startTime() {  // micros
-        ensureStarted();
-        return _start;
-    }
     void done() {
-        _end = curTimeMicros64();
+        _end = _tickSource->getTicks();
     }
     bool isDone() const {
         return _end > 0;
@@ -414,7 +441,7 @@ public:
     void pauseTimer() {
         invariant(isStarted());
         invariant(_lastPauseTime == 0);
-        _lastPauseTime = curTimeMicros64();
+        _lastPauseTime = _tickSource->getTicks();
     }
 
     /**
@@ -425,15 +452,15 @@ public:
         invariant(isStarted());
         invariant(_lastPauseTime > 0);
         _totalPausedDuration +=
-            Microseconds{static_cast<long long>(curTimeMicros64()) - _lastPauseTime};
+            _tickSource->ticksTo<Microseconds>(_tickSource->getTicks() - _lastPauseTime);
         _lastPauseTime = 0;
     }
 
     /**
-     * If this op has been marked as done(), returns the wall clock duration between being marked as
-     * started with ensureStarted() and the call to done().
+     * If this op has been marked as done(), returns the duration between being marked as started
+     * with ensureStarted() and the call to done().
      *
-     * Otherwise, returns the wall clock duration between the start time and now.
+     * Otherwise, returns the duration between the start time and now.
      *
      * If this op has not yet been started, returns 0.
      */
@@ -442,11 +469,8 @@ public:
             return Microseconds{0};
         }
 
-        if (!_end) {
-            return Microseconds{static_cast<long long>(curTimeMicros64() - startTime())};
-        } else {
-            return Microseconds{static_cast<long long>(_end - startTime())};
-        }
+        const auto end = _end ? _end : _tickSource->getTicks();
+        return _tickSource->ticksTo<Microseconds>(end - _start);
     }
 
     /**
@@ -544,6 +568,22 @@ public:
         return _numYields;
     }
 
+    /**
+     * Records that the operation reached a yield point but kept running because nothing was
+     * contending for its resources.
+     */
+    void yieldSkipped() {
+        ++_numYieldsSkipped;
+    }
+
+    /**
+     * Returns the number of times yieldSkipped() was called. Callers on threads other than the
+     * one executing the operation must lock the client.
+     */
+    int numYieldsSkipped() const {
+        return _numYieldsSkipped;
+    }
+
     /**
      * this should be used very sparingly
      * generally the Context should set this up
@@ -569,6 +609,78 @@ public:
         return _lockStatsBase;
     }
 
+    /**
+     * Phases of an operation whose wall time is also reported on its own, under "phaseMicros" in
+     * currentOp, profiler entries and the slow query log, so that latency can be attributed.
+     * Phases may overlap each other. Subsystems report into the CurOp at the top of the
+     * operation's stack, usually through a PhaseTimer.
+     */
+    enum class Phase {
+        kPlanning,       // Query planning, including multi-planner and cached plan trial runs.
+        kTicketWait,     // Waiting for a storage engine read or write ticket.
+        kAdmissionWait,  // Queued for admission to the client's resource group.
+        kNumPhases,
+    };
+
+    /**
+     * Returns the phase's name, a null-terminated string literal.
+     */
+    static StringData phaseName(Phase phase);
+
+    /**
+     * Adds 'duration' to the time spent in 'phase'. Safe to call concurrently with a currentOp
+     * report of this CurOp.
+     */
+    void addPhaseTime(Phase phase, Microseconds duration) {
+        _phaseMicros[static_cast<size_t>(phase)].fetchAndAdd(durationCount<Microseconds>(duration));
+    }
+
+    Microseconds getPhaseTime(Phase phase) const {
+        return Microseconds(_phaseMicros[static_cast<size_t>(phase)].load());
+    }
+
+    /**
+     * Appends a "phaseMicros" subobject with the phases this operation spent time in. Appends
+     * nothing if there are none.
+     */
+    void appendPhaseTimes(BSONObjBuilder* builder) const;
+
+    /**
+     * Returns the storage engine I/O done by this operation so far, excluding what was done before
+     * this CurOp was pushed when it is a sub-operation.
+     */
+    StorageOperationStats::Snapshot getStorageStats(OperationContext* opCtx) const {
+        return StorageOperationStats::get(opCtx).snapshot() - _storageStatsBase;
+    }
+
+    /**
+     * Reports the time between its construction and destruction as time spent in 'phase' by the
+     * operation's current CurOp.
+     */
+    class PhaseTimer {
+        MONGO_DISALLOW_COPYING(PhaseTimer);
+
+    public:
+        PhaseTimer(OperationContext* opCtx, Phase phase)
+            : _curOp(get(opCtx)),
+              _phase(phase),
+              _profilerTag(SamplingProfiler::TagKind::kPhase, phaseName(phase).rawData()),
+              _start(_curOp->_tickSource->getTicks()) {}
+
+        ~PhaseTimer() {
+            _curOp->addPhaseTime(
+                _phase, _curOp->_tickSource->ticksTo<Microseconds>(_curOp->_tickSource->getTicks() -
+                                                                   _start));
+        }
+
+    private:
+        CurOp* const _curOp;
+        const Phase _phase;
+        // Tags CPU profile samples taken during the phase with the phase's name.
+        SamplingProfiler::ScopedTag _profilerTag;
+        const TickSource::Tick _start;
+    };
+
 private:
     class CurOpStack;
 
@@ -580,15 +692,18 @@ private:
     CurOp* _parent{nullptr};
     const Command* _command{nullptr};
 
-    // The time at which this CurOp instance was marked as started.
-    long long _start{0};
+    // The clock used to time this operation. Comes from the ServiceContext, if there is one.
+    TickSource* _tickSource{SystemTickSource::get()};
+
+    // The tick at which this CurOp instance was marked as started.
+    TickSource::Tick _start{0};
 
-    // The time at which this CurOp instance was marked as done.
-    long long _end{0};
+    // The tick at which this CurOp instance was marked as done.
+    TickSource::Tick _end{0};
 
-    // The time at which this CurOp instance had its timer paused, or 0 if the timer is not
+    // The tick at which this CurOp instance had its timer paused, or 0 if the timer is not
     // currently paused.
-    long long _lastPauseTime{0};
+    TickSource::Tick _lastPauseTime{0};
 
     // The cumulative duration for which the timer has been paused.
     Microseconds _totalPausedDuration{0};
@@ -609,12 +724,22 @@ private:
     std::string _message;
     ProgressMeter _progressMeter;
     int _numYields{0};
+    int _numYieldsSkipped{0};
     // A GenericCursor containing information about the active cursor for a getMore operation.
     boost::optional<GenericCursor> _genericCursor;
 
     std::string _planSummary;
     boost::optional<SingleThreadedLockStats>
         _lockStatsBase;  // This is the snapshot of lock stats taken when curOp is constructed.
+
+    // The locker's cumulative ticket wait when this CurOp was constructed, so that a
+    // sub-operation reports only its own wait.
+    Microseconds _ticketWaitBase{0};
+
+    // The operation's storage engine I/O when this CurOp was constructed, for the same reason.
+    StorageOperationStats::Snapshot _storageStatsBase;
+
+    std::array<AtomicInt64, static_cast<size_t>(Phase::kNumPhases)> _phaseMicros;
 };
 
 /**
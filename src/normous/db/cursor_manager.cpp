@@ -41,6 +41,7 @@
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/client.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/cursor_server_params.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/kill_sessions_common.h"
@@ -53,6 +54,7 @@
 #include "mongo/db/session_catalog.h"
 #include "mongo/platform/random.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/exit.h"
 #include "mongo/util/log.h"
 #include "mongo/util/startup_test.h"
@@ -64,6 +66,10 @@ using std::vector;
 constexpr int CursorManager::kNumPartitions;
 
 namespace {
+Counter64 cursorStatsPartitionLockContended;
+ServerStatusMetricField<Counter64> dCursorStatsPartitionLockContended(
+    "cursor.partitionLock.contended", &cursorStatsPartitionLockContended);
+
 uint32_t idFromCursorId(CursorId id) {
     uint64_t x = static_cast<uint64_t>(id);
     x = x >> 32;
@@ -421,8 +427,9 @@ CursorManager::CursorManager(NamespaceString nss)
       _collectionCacheRuntimeId(_nss.isEmpty() ? 0
                                                : globalCursorIdCache->registerCursorManager(_nss)),
       _random(stdx::make_unique<PseudoRandom>(globalCursorIdCache->nextSeed())),
-      _registeredPlanExecutors(),
-      _cursorMap(stdx::make_unique<Partitioned<stdx::unordered_map<CursorId, ClientCursor*>>>()) {}
+      _registeredPlanExecutors(partitionCount(_nss)),
+      _cursorMap(stdx::make_unique<CursorMap>(partitionCount(_nss))),
+      _expiryTimeout(getCursorTimeoutMillis()) {}
 
 CursorManager::~CursorManager() {
     // All cursors and PlanExecutors should have been deleted already.
@@ -472,6 +479,7 @@ void CursorManager::invalidateAll(OperationContext* opCtx,
                     // will result in a useful error message.
                     ++it;
                 } else {
+                    cancelTimeout(cursor->cursorid());
                     toDisposeWithoutMutex.emplace_back(cursor);
                     it = partition.erase(it);
                 }
@@ -486,6 +494,24 @@ void CursorManager::invalidateAll(OperationContext* opCtx,
     }
 }
 
+std::size_t CursorManager::partitionCount(const NamespaceString& nss) {
+    if (int configured = getCursorManagerPartitions()) {
+        return configured;
+    }
+    if (!nss.isEmpty()) {
+        return kNumPartitions;
+    }
+    return std::max<std::size_t>(kNumPartitions, stdx::thread::hardware_concurrency());
+}
+
+CursorManager::CursorMap::OnePartition CursorManager::lockCursorPartition(CursorId id) {
+    if (auto partition = _cursorMap->tryLockOnePartition(id)) {
+        return std::move(*partition);
+    }
+    cursorStatsPartitionLockContended.increment();
+    return _cursorMap->lockOnePartition(id);
+}
+
 bool CursorManager::cursorShouldTimeout_inlock(const ClientCursor* cursor, Date_t now) {
     if (cursor->isNoTimeout() || cursor->_operationUsingCursor) {
         return false;
@@ -493,22 +519,85 @@ bool CursorManager::cursorShouldTimeout_inlock(const ClientCursor* cursor, Date_
     return (now - cursor->_lastUseDate) >= Milliseconds(getCursorTimeoutMillis());
 }
 
+constexpr Milliseconds CursorManager::kExpiryResolution;
+
+void CursorManager::scheduleTimeout_inlock(const ClientCursor* cursor) {
+    if (cursor->isNoTimeout() || cursor->_operationUsingCursor) {
+        return;
+    }
+
+    stdx::lock_guard<SimpleMutex> lk(_expiryLock);
+    if (Date_t::max() - cursor->_lastUseDate <= _expiryTimeout) {
+        // The cursor cannot time out before the end of time.
+        return;
+    }
+    if (!_expiryWheel) {
+        _expiryWheel = stdx::make_unique<TimerWheel<CursorId>>(kExpiryResolution, Date_t());
+    }
+    _expiryWheel->schedule(cursor->cursorid(), cursor->_lastUseDate + _expiryTimeout);
+}
+
+void CursorManager::cancelTimeout(CursorId id) {
+    stdx::lock_guard<SimpleMutex> lk(_expiryLock);
+    if (_expiryWheel) {
+        _expiryWheel->cancel(id);
+    }
+}
+
 std::size_t CursorManager::timeoutCursors(OperationContext* opCtx, Date_t now) {
     std::vector<std::unique_ptr<ClientCursor, ClientCursor::Deleter>> toDisposeWithoutMutex;
 
-    for (size_t partitionId = 0; partitionId < kNumPartitions; ++partitionId) {
-        auto lockedPartition = _cursorMap->lockOnePartitionById(partitionId);
-        for (auto it = lockedPartition->begin(); it != lockedPartition->end();) {
-            auto* cursor = it->second;
-            if (cursorShouldTimeout_inlock(cursor, now)) {
-                toDisposeWithoutMutex.emplace_back(cursor);
-                it = lockedPartition->erase(it);
-            } else {
-                ++it;
+    // Deadlines computed with a cursor timeout which has since been changed are wrong, so in that
+    // case sweep every cursor once and compute new deadlines. Otherwise only the cursors whose
+    // deadlines have passed need to be visited.
+    const Milliseconds timeout(getCursorTimeoutMillis());
+    bool sweepAllCursors = false;
+    std::vector<CursorId> dueCursors;
+    {
+        stdx::lock_guard<SimpleMutex> lk(_expiryLock);
+        if (timeout != _expiryTimeout) {
+            _expiryTimeout = timeout;
+            _expiryWheel.reset();
+            sweepAllCursors = true;
+        } else if (_expiryWheel) {
+            dueCursors = _expiryWheel->advance(now);
+        }
+    }
+
+    if (sweepAllCursors) {
+        for (size_t partitionId = 0; partitionId < _cursorMap->numPartitions(); ++partitionId) {
+            auto lockedPartition = _cursorMap->lockOnePartitionById(partitionId);
+            for (auto it = lockedPartition->begin(); it != lockedPartition->end();) {
+                auto* cursor = it->second;
+                if (cursorShouldTimeout_inlock(cursor, now)) {
+                    toDisposeWithoutMutex.emplace_back(cursor);
+                    it = lockedPartition->erase(it);
+                } else {
+                    scheduleTimeout_inlock(cursor);
+                    ++it;
+                }
             }
         }
     }
 
+    for (auto id : dueCursors) {
+        auto lockedPartition = lockCursorPartition(id);
+        auto it = lockedPartition->find(id);
+        if (it == lockedPartition->end()) {
+            continue;
+        }
+
+        // Check the cursor again, since the cursor timeout may have been changed after its deadline
+        // was computed.
+        auto* cursor = it->second;
+        if (cursorShouldTimeout_inlock(cursor, now)) {
+            toDisposeWithoutMutex.emplace_back(cursor);
+            lockedPartition->erase(it);
+        } else {
+            scheduleTimeout_inlock(cursor);
+        }
+    }
+
     // Be careful not to dispose of cursors while holding the partition lock.
     for (auto&& cursor : toDisposeWithoutMutex) {
         log() << "Cursor id " << cursor->cursorid() << " timed out, idle since "
@@ -539,7 +628,7 @@ void CursorManager::deregisterExecutor(PlanExecutor* exec) {
 StatusWith<ClientCursorPin> CursorManager::pinCursor(OperationContext* opCtx,
                                                      CursorId id,
                                                      AuthCheck checkSessionAuth) {
-    auto lockedPartition = _cursorMap->lockOnePartition(id);
+    auto lockedPartition = lockCursorPartition(id);
     auto it = lockedPartition->find(id);
     if (it == lockedPartition->end()) {
         return {ErrorCodes::CursorNotFound, str::stream() << "cursor id " << id << " not found"};
@@ -566,6 +655,7 @@ StatusWith<ClientCursorPin> CursorManager::pinCursor(OperationContext* opCtx,
     }
 
     cursor->_operationUsingCursor = opCtx;
+    cancelTimeout(id);
 
     // We use pinning of a cursor as a proxy for active, user-initiated use of a cursor.  Therefore,
     // we pass down to the logical session cache and vivify the record (updating last use).
@@ -585,7 +675,7 @@ void CursorManager::unpin(OperationContext* opCtx,
     // Avoid computing the current time within the critical section.
     auto now = opCtx->getServiceContext()->getPreciseClockSource()->now();
 
-    auto partition = _cursorMap->lockOnePartition(cursor->cursorid());
+    auto partition = lockCursorPartition(cursor->cursorid());
     invariant(cursor->_operationUsingCursor);
 
     // We must verify that no interrupts have occurred since we finished building the current
@@ -609,7 +699,7 @@ void CursorManager::unpin(OperationContext* opCtx,
 
     // The cursor will stay around in '_cursorMap', so release the unique pointer to avoid deleting
     // it.
-    cursor.release();
+    scheduleTimeout_inlock(cursor.release());
 }
 
 void CursorManager::appendActiveSessions(LogicalSessionIdSet* lsids) const {
@@ -684,7 +774,7 @@ CursorId CursorManager::allocateCursorId_inlock() {
             uint32_t myPart = static_cast<uint32_t>(_random->nextInt32());
             id = cursorIdFromParts(_collectionCacheRuntimeId, myPart);
         }
-        auto partition = _cursorMap->lockOnePartition(id);
+        auto partition = lockCursorPartition(id);
         if (partition->count(id) == 0)
             return id;
     }
@@ -716,7 +806,7 @@ ClientCursorPin CursorManager::registerCursor(OperationContext* opCtx,
     }
 
     // Transfer ownership of the cursor to '_cursorMap'.
-    auto partition = _cursorMap->lockOnePartition(cursorId);
+    auto partition = lockCursorPartition(cursorId);
     ClientCursor* unownedCursor = clientCursor.release();
     partition->emplace(cursorId, unownedCursor);
     return ClientCursorPin(opCtx, unownedCursor);
@@ -724,15 +814,17 @@ ClientCursorPin CursorManager::registerCursor(OperationContext* opCtx,
 
 void CursorManager::deregisterCursor(ClientCursor* cursor) {
     _cursorMap->erase(cursor->cursorid());
+    cancelTimeout(cursor->cursorid());
 }
 
 void CursorManager::deregisterAndDestroyCursor(
-    Partitioned<stdx::unordered_map<CursorId, ClientCursor*>, kNumPartitions>::OnePartition&& lk,
+    CursorMap::OnePartition&& lk,
     OperationContext* opCtx,
     std::unique_ptr<ClientCursor, ClientCursor::Deleter> cursor) {
     {
         auto lockWithRestrictedScope = std::move(lk);
         lockWithRestrictedScope->erase(cursor->cursorid());
+        cancelTimeout(cursor->cursorid());
     }
     // Dispose of the cursor without holding any cursor manager mutexes. Disposal of a cursor can
     // require taking lock manager locks, which we want to avoid while holding a mutex. If we did
@@ -742,7 +834,7 @@ void CursorManager::deregisterAndDestroyCursor(
 }
 
 Status CursorManager::killCursor(OperationContext* opCtx, CursorId id, bool shouldAudit) {
-    auto lockedPartition = _cursorMap->lockOnePartition(id);
+    auto lockedPartition = lockCursorPartition(id);
     auto it = lockedPartition->find(id);
     if (it == lockedPartition->end()) {
         if (shouldAudit) {
@@ -779,7 +871,7 @@ Status CursorManager::killCursor(OperationContext* opCtx, CursorId id, bool shou
 }
 
 Status CursorManager::checkAuthForKillCursors(OperationContext* opCtx, CursorId id) {
-    auto lockedPartition = _cursorMap->lockOnePartition(id);
+    auto lockedPartition = lockCursorPartition(id);
     auto it = lockedPartition->find(id);
     if (it == lockedPartition->end()) {
         return {ErrorCodes::CursorNotFound, str::stream() << "cursor id " << id << " not found"};
@@ -42,6 +42,7 @@
 #include "mongo/stdx/unordered_set.h"
 #include "mongo/util/concurrency/mutex.h"
 #include "mongo/util/duration.h"
+#include "mongo/util/timer_wheel.h"
 
 namespace mongo {
 
@@ -251,8 +252,15 @@ public:
 
 private:
     static constexpr int kNumPartitions = 16;
+
+    // The granularity of the timer wheel holding cursor deadlines. Cursors still time out exactly,
+    // but coarser ticks make the wheel's levels span longer times.
+    static constexpr Milliseconds kExpiryResolution{1000};
+
     friend class ClientCursorPin;
 
+    using CursorMap = Partitioned<stdx::unordered_map<CursorId, ClientCursor*>, kNumPartitions>;
+
     struct PlanExecutorPartitioner {
         std::size_t operator()(const PlanExecutor* exec, std::size_t nPartitions);
     };
@@ -264,7 +272,7 @@ private:
 
     void deregisterCursor(ClientCursor* cursor);
     void deregisterAndDestroyCursor(
-        Partitioned<stdx::unordered_map<CursorId, ClientCursor*>, kNumPartitions>::OnePartition&&,
+        CursorMap::OnePartition&&,
         OperationContext* opCtx,
         std::unique_ptr<ClientCursor, ClientCursor::Deleter> cursor);
 
@@ -273,6 +281,31 @@ private:
 
     bool cursorShouldTimeout_inlock(const ClientCursor* cursor, Date_t now);
 
+    /**
+     * Sets the deadline at which 'cursor' times out, if it is idle and can time out. Must be
+     * called with the partition of '_cursorMap' holding 'cursor' locked.
+     */
+    void scheduleTimeout_inlock(const ClientCursor* cursor);
+
+    /**
+     * Removes the deadline of cursor 'id', once it is pinned or no longer registered.
+     */
+    void cancelTimeout(CursorId id);
+
+    /**
+     * Locks the partition of '_cursorMap' holding cursor 'id', counting the acquisition in the
+     * "cursor.partitionLock.contended" metric if another thread held the lock.
+     */
+    CursorMap::OnePartition lockCursorPartition(CursorId id);
+
+    /**
+     * Returns the number of partitions for the cursor manager of 'nss'. Unless configured
+     * otherwise, the global cursor manager, which holds the cursors of every aggregation and change
+     * stream, gets a partition per core. Collection cursor managers, of which there is one per
+     * collection, keep the default.
+     */
+    static std::size_t partitionCount(const NamespaceString& nss);
+
     bool isGlobalManager() const {
         return _nss.isEmpty();
     }
@@ -300,11 +333,19 @@ private:
     // - If you need to access multiple partitions within '_registeredPlanExecutors' or '_cursorMap'
     //   at once, you must acquire the mutexes for those partitions in ascending order, or use the
     //   partition helpers to acquire mutexes for all partitions.
+    // - '_expiryLock' must be acquired last, and no other mutex may be acquired while holding it.
     mutable SimpleMutex _registrationLock;
     std::unique_ptr<PseudoRandom> _random;
     Partitioned<stdx::unordered_set<PlanExecutor*>, kNumPartitions, PlanExecutorPartitioner>
         _registeredPlanExecutors;
-    std::unique_ptr<Partitioned<stdx::unordered_map<CursorId, ClientCursor*>, kNumPartitions>>
-        _cursorMap;
+    std::unique_ptr<CursorMap> _cursorMap;
+
+    // The deadline of every idle cursor which can time out, computed with the cursor timeout in
+    // '_expiryTimeout', so that timeoutCursors() only visits the cursors which are due instead of
+    // sweeping every cursor. The wheel is created by the first deadline, since most collections
+    // never have idle cursors. Both are protected by '_expiryLock'.
+    mutable SimpleMutex _expiryLock;
+    std::unique_ptr<TimerWheel<CursorId>> _expiryWheel;
+    Milliseconds _expiryTimeout;
 };
 }  // namespace mongo
@@ -42,6 +42,15 @@ MONGO_EXPORT_SERVER_PARAMETER(cursorTimeoutMillis,
                               long long,
                               durationCount<Milliseconds>(kDefaultCursorTimeoutMinutes));
 
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(cursorManagerPartitions, int, 0)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0 || newVal > 1024) {
+            return Status(ErrorCodes::BadValue,
+                          "cursorManagerPartitions must be between 0 and 1024");
+        }
+        return Status::OK();
+    });
+
 }  // namespace
 
 int getClientCursorMonitorFrequencySecs() {
@@ -56,4 +65,8 @@ Milliseconds getDefaultCursorTimeoutMillis() {
     return kDefaultCursorTimeoutMinutes;
 }
 
+int getCursorManagerPartitions() {
+    return cursorManagerPartitions;
+}
+
 }  // namespace mongo
@@ -40,4 +40,9 @@ long long getCursorTimeoutMillis();
 
 Milliseconds getDefaultCursorTimeoutMillis();
 
+// Number of partitions each CursorManager splits its cursors and executors into, or 0 to size the
+// global cursor manager to the machine's core count. Configurable at startup with server parameter
+// "cursorManagerPartitions".
+int getCursorManagerPartitions();
+
 }  // namespace mongo
@@ -54,6 +54,7 @@
 #include "mongo/db/repl/repl_client_info.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/storage/clustered_record_id.h"
 #include "mongo/db/storage/data_protector.h"
 #include "mongo/db/storage/encryption_hooks.h"
 #include "mongo/db/storage/storage_options.h"
@@ -72,6 +73,25 @@ using std::set;
 using std::string;
 using std::stringstream;
 
+namespace {
+
+/**
+ * Returns the RecordId of the document of the clustered 'collection' with the given _id, or a null
+ * RecordId if there is none.
+ */
+RecordId findByIdInClusteredCollection(OperationContext* opCtx,
+                                       const Collection* collection,
+                                       const BSONElement& id) {
+    auto key = clustered_record_id::keyForId(id);
+    RecordData unused;
+    if (!key.isOK() || !collection->getRecordStore()->findRecord(opCtx, key.getValue(), &unused)) {
+        return RecordId();
+    }
+    return key.getValue();
+}
+
+}  // namespace
+
 /* fetch a single object from collection ns that matches query
    set your db SavedContext first
 */
@@ -157,14 +177,17 @@ bool Helpers::findById(OperationContext* opCtx,
 
     IndexCatalog* catalog = collection->getIndexCatalog();
     const IndexDescriptor* desc = catalog->findIdIndex(opCtx);
+    const bool isClustered = collection->getRecordStore()->isClustered();
 
-    if (!desc)
+    if (!desc && !isClustered)
         return false;
 
     if (indexFound)
         *indexFound = 1;
 
-    RecordId loc = catalog->getIndex(desc)->findSingle(opCtx, query["_id"].wrap());
+    RecordId loc = isClustered
+        ? findByIdInClusteredCollection(opCtx, collection, query["_id"])
+        : catalog->getIndex(desc)->findSingle(opCtx, query["_id"].wrap());
     if (loc.isNull())
         return false;
     result = collection->docFor(opCtx, loc).value();
@@ -175,6 +198,10 @@ RecordId Helpers::findById(OperationContext* opCtx,
                            Collection* collection,
                            const BSONObj& idquery) {
     verify(collection);
+    if (collection->getRecordStore()->isClustered()) {
+        return findByIdInClusteredCollection(opCtx, collection, idquery["_id"]);
+    }
+
     IndexCatalog* catalog = collection->getIndexCatalog();
     const IndexDescriptor* desc = catalog->findIdIndex(opCtx);
     uassert(13430, "no _id index", desc);
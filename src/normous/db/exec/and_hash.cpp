@@ -32,17 +32,10 @@
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/mongoutils/str.h"
 
-namespace {
-
-// Upper limit for buffered data.
-// Stage execution will fail once size of all buffered data exceeds this threshold.
-const size_t kDefaultMaxMemUsageBytes = 32 * 1024 * 1024;
-
-}  // namespace
-
 namespace mongo {
 
 using std::unique_ptr;
@@ -61,7 +54,7 @@ AndHashStage::AndHashStage(OperationContext* opCtx, WorkingSet* ws, const Collec
       _hashingChildren(true),
       _currentChild(0),
       _memUsage(0),
-      _maxMemUsage(kDefaultMaxMemUsageBytes) {}
+      _maxMemUsage(static_cast<size_t>(internalQueryMaxAndHashBufferSizeBytes.load())) {}
 
 AndHashStage::AndHashStage(OperationContext* opCtx,
                            WorkingSet* ws,
@@ -171,7 +164,7 @@ PlanStage::StageState AndHashStage::doWork(WorkingSetID* out) {
         if (_memUsage > _maxMemUsage) {
             mongoutils::str::stream ss;
             ss << "hashed AND stage buffered data usage of " << _memUsage
-               << " bytes exceeds internal limit of " << kDefaultMaxMemUsageBytes << " bytes";
+               << " bytes exceeds internal limit of " << _maxMemUsage << " bytes";
             Status status(ErrorCodes::Overflow, ss);
             *out = WorkingSetCommon::allocateStatusMember(_ws, status);
             return PlanStage::FAILURE;
@@ -212,7 +205,7 @@ PlanStage::StageState AndHashStage::doWork(WorkingSetID* out) {
     // with no record id.
     invariant(member->hasRecordId());
 
-    DataMap::iterator it = _dataMap.find(member->recordId);
+    DataMap::iterator it = probe(member->recordId);
     if (_dataMap.end() == it) {
         // Child's output wasn't in every previous child.  Throw it out.
         _ws->free(*out);
@@ -281,6 +274,7 @@ PlanStage::StageState AndHashStage::readFirstChild(WorkingSetID* out) {
         }
 
         _specificStats.mapAfterChild.push_back(_dataMap.size());
+        rebuildBloomFilter();
 
         return PlanStage::NEED_TIME;
     } else if (PlanStage::FAILURE == childStatus || PlanStage::DEAD == childStatus) {
@@ -312,12 +306,13 @@ PlanStage::StageState AndHashStage::hashOtherChildren(WorkingSetID* out) {
         // WSM with no record id.
         invariant(member->hasRecordId());
 
-        if (_dataMap.end() == _dataMap.find(member->recordId)) {
+        DataMap::iterator it = probe(member->recordId);
+        if (_dataMap.end() == it) {
             // Ignore.  It's not in any previous child.
         } else {
             // We have a hit.  Copy data into the WSM we already have.
             _seenMap.insert(member->recordId);
-            WorkingSetID olderMemberID = _dataMap[member->recordId];
+            WorkingSetID olderMemberID = it->second;
             WorkingSetMember* olderMember = _ws->get(olderMemberID);
             size_t memUsageBefore = olderMember->getMemUsage();
 
@@ -335,7 +330,7 @@ PlanStage::StageState AndHashStage::hashOtherChildren(WorkingSetID* out) {
         // Keep elements of _dataMap that are in _seenMap.
         DataMap::iterator it = _dataMap.begin();
         while (it != _dataMap.end()) {
-            if (_seenMap.end() == _seenMap.find(it->first)) {
+            if (!_seenMap.contains(it->first)) {
                 DataMap::iterator toErase = it;
                 ++it;
 
@@ -353,6 +348,7 @@ PlanStage::StageState AndHashStage::hashOtherChildren(WorkingSetID* out) {
         _specificStats.mapAfterChild.push_back(_dataMap.size());
 
         _seenMap.clear();
+        rebuildBloomFilter();
 
         // _dataMap is now the intersection of the first _currentChild nodes.
 
@@ -383,6 +379,39 @@ PlanStage::StageState AndHashStage::hashOtherChildren(WorkingSetID* out) {
     }
 }
 
+void AndHashStage::rebuildBloomFilter() {
+    const size_t minEntries =
+        static_cast<size_t>(internalQueryAndHashBloomFilterMinEntries.load());
+    if (_dataMap.empty() || _dataMap.size() < minEntries) {
+        _bloomFilter.clear();
+        return;
+    }
+
+    _bloomFilter.reset(_dataMap.size());
+    for (auto&& entry : _dataMap) {
+        _bloomFilter.insert(entry.first);
+    }
+    _specificStats.bloomFilterBits = _bloomFilter.numBits();
+}
+
+AndHashStage::DataMap::iterator AndHashStage::probe(const RecordId& rid) {
+    if (_bloomFilter.isEmpty()) {
+        return _dataMap.find(rid);
+    }
+
+    ++_specificStats.bloomFilterProbes;
+    if (!_bloomFilter.mayContain(rid)) {
+        ++_specificStats.bloomFilterRejected;
+        return _dataMap.end();
+    }
+
+    DataMap::iterator it = _dataMap.find(rid);
+    if (_dataMap.end() == it) {
+        ++_specificStats.bloomFilterFalsePositives;
+    }
+    return it;
+}
+
 unique_ptr<PlanStageStats> AndHashStage::getStats() {
     _commonStats.isEOF = isEOF();
 
@@ -31,11 +31,12 @@
 #include <vector>
 
 #include "mongo/db/exec/plan_stage.h"
+#include "mongo/db/exec/record_id_bitmap.h"
+#include "mongo/db/exec/record_id_bloom_filter.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/record_id.h"
 #include "mongo/stdx/unordered_map.h"
-#include "mongo/stdx/unordered_set.h"
 
 namespace mongo {
 
@@ -85,6 +86,19 @@ private:
     StageState hashOtherChildren(WorkingSetID* out);
     StageState workChild(size_t childNo, WorkingSetID* out);
 
+    /**
+     * Rebuilds '_bloomFilter' from the RecordIds in '_dataMap', or clears it if '_dataMap' is too
+     * small for the filter to pay off.
+     */
+    void rebuildBloomFilter();
+
+    /**
+     * Returns an iterator to the entry of '_dataMap' for 'rid', or _dataMap.end() if there is
+     * none. Consults '_bloomFilter' first when there is one.
+     */
+    stdx::unordered_map<RecordId, WorkingSetID, RecordId::Hasher>::iterator probe(
+        const RecordId& rid);
+
     // Not owned by us.
     const Collection* _collection;
 
@@ -103,8 +117,11 @@ private:
 
     // Keeps track of what elements from _dataMap subsequent children have seen.
     // Only used while _hashingChildren.
-    typedef stdx::unordered_set<RecordId, RecordId::Hasher> SeenMap;
-    SeenMap _seenMap;
+    RecordIdBitmap _seenMap;
+
+    // Summarizes the keys of _dataMap so that most probes for RecordIds missing from it can be
+    // answered without a hash table lookup. Empty if _dataMap is too small for this to help.
+    RecordIdBloomFilter _bloomFilter;
 
     // True if we're still intersecting _children[0..._children.size()-1].
     bool _hashingChildren;
@@ -121,7 +138,7 @@ private:
     size_t _memUsage;
 
     // Upper limit for buffered data memory usage.
-    // Defaults to 32 MB (See kMaxBytes in and_hash.cpp).
+    // Defaults to 'internalQueryMaxAndHashBufferSizeBytes'.
     size_t _maxMemUsage;
 };
 
@@ -34,10 +34,10 @@
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/exec/collection_scan_common.h"
-#include "mongo/db/exec/filter.h"
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/repl/optime.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/fail_point_service.h"
@@ -62,10 +62,16 @@ CollectionScan::CollectionScan(OperationContext* opCtx,
       _workingSet(workingSet),
       _filter(filter),
       _params(params),
+      _batchSize(static_cast<size_t>(internalQueryExecCollectionScanBatchSize.load())),
       _isDead(false) {
+    if (_filter) {
+        _compiledFilter = stdx::make_unique<CompiledMatchExpression>(_filter);
+    }
     // Explain reports the direction of the collection scan.
     _specificStats.direction = params.direction;
     _specificStats.maxTs = params.maxTs;
+    _specificStats.minRecord = params.minRecord;
+    _specificStats.maxRecord = params.maxRecord;
     invariant(!_params.shouldTrackLatestOplogTimestamp || _params.collection->ns().isOplog());
 
     if (params.maxTs) {
@@ -91,10 +97,8 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
-    boost::optional<Record> record;
-    const bool needToMakeCursor = !_cursor;
-    try {
-        if (needToMakeCursor) {
+    if (!_cursor) {
+        try {
             const bool forward = _params.direction == CollectionScanParams::FORWARD;
 
             if (forward && _params.shouldWaitForOplogVisibility) {
@@ -115,6 +119,18 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
                     getOpCtx());
             }
 
+            auto rs = _params.collection->getRecordStore();
+            if (_params.tailable && rs->keysCappedInsertsByTimestamp()) {
+                // Inserts into this capped collection are not serialized, so a record may become
+                // visible before one with a lower RecordId. Tailing past it would skip the earlier
+                // one for good. The bound must be read before the snapshot is established so that
+                // every insert at or below it is visible to the cursor.
+                if (!getOpCtx()->lockState()->inAWriteUnitOfWork()) {
+                    getOpCtx()->recoveryUnit()->abandonSnapshot();
+                }
+                _visibilityBound = rs->getCappedVisibilityBound(getOpCtx());
+            }
+
             _cursor = _params.collection->getCursor(getOpCtx(), forward);
 
             if (!_lastSeenId.isNull()) {
@@ -138,50 +154,116 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
             }
 
             return PlanStage::NEED_TIME;
+        } catch (const WriteConflictException&) {
+            // Leave us in a state to try again next time.
+            _cursor.reset();
+            *out = WorkingSet::INVALID_ID;
+            return PlanStage::NEED_YIELD;
         }
+    }
 
-        if (_lastSeenId.isNull() && !_params.start.isNull()) {
-            record = _cursor->seekExact(_params.start);
-        } else {
-            record = _cursor->next();
+    // Examine up to '_batchSize' records in this call, evaluating the filter directly against each
+    // record so that those which do not match never need a working set member or a trip back up
+    // the plan.
+    for (size_t recordsRejected = 0;;) {
+        boost::optional<Record> record;
+        try {
+            if (_lastSeenId.isNull() && !_params.start.isNull()) {
+                record = _cursor->seekExact(_params.start);
+            } else if (_lastSeenId.isNull() &&
+                       (_isForward() ? _params.minRecord : _params.maxRecord)) {
+                record = _seekToStartBound();
+            } else {
+                record = _cursor->next();
+            }
+        } catch (const WriteConflictException&) {
+            // The cursor keeps its position, so we can pick up where we left off next time.
+            *out = WorkingSet::INVALID_ID;
+            return PlanStage::NEED_YIELD;
         }
-    } catch (const WriteConflictException&) {
-        // Leave us in a state to try again next time.
-        if (needToMakeCursor)
-            _cursor.reset();
-        *out = WorkingSet::INVALID_ID;
-        return PlanStage::NEED_YIELD;
-    }
 
-    if (!record) {
-        // We just hit EOF. If we are tailable and have already returned data, leave us in a
-        // state to pick up where we left off on the next call to work(). Otherwise EOF is
-        // permanent.
-        if (_params.tailable && !_lastSeenId.isNull()) {
+        if (!record) {
+            // We just hit EOF. If we are tailable and have already returned data, leave us in a
+            // state to pick up where we left off on the next call to work(). Otherwise EOF is
+            // permanent.
+            if (_params.tailable && !_lastSeenId.isNull()) {
+                _cursor.reset();
+            } else {
+                _commonStats.isEOF = true;
+            }
+
+            return PlanStage::IS_EOF;
+        }
+
+        if (_visibilityBound && record->id > *_visibilityBound) {
+            // An insert before this record may still commit. Stop as if at EOF, and resume after
+            // the last returned record once more of the collection is visible.
             _cursor.reset();
-        } else {
+            return PlanStage::IS_EOF;
+        }
+
+        if (_isForward() ? _params.maxRecord && record->id > *_params.maxRecord
+                      : _params.minRecord && record->id < *_params.minRecord) {
             _commonStats.isEOF = true;
+            return PlanStage::IS_EOF;
         }
 
-        return PlanStage::IS_EOF;
-    }
+        _lastSeenId = record->id;
+        if (_params.shouldTrackLatestOplogTimestamp) {
+            auto status = setLatestOplogEntryTimestamp(*record);
+            if (!status.isOK()) {
+                *out = WorkingSetCommon::allocateStatusMember(_workingSet, status);
+                return PlanStage::FAILURE;
+            }
+        }
 
-    _lastSeenId = record->id;
-    if (_params.shouldTrackLatestOplogTimestamp) {
-        auto status = setLatestOplogEntryTimestamp(*record);
-        if (!status.isOK()) {
-            *out = WorkingSetCommon::allocateStatusMember(_workingSet, status);
-            return PlanStage::FAILURE;
+        ++_specificStats.docsTested;
+        const BSONObj doc = record->data.toBson();
+
+        if (!_filter || _compiledFilter->matchesBSON(doc)) {
+            if (_params.stopApplyingFilterAfterFirstMatch) {
+                _filter = nullptr;
+            }
+
+            WorkingSetID id = _workingSet->allocate();
+            WorkingSetMember* member = _workingSet->get(id);
+            member->recordId = record->id;
+            member->obj = {getOpCtx()->recoveryUnit()->getSnapshotId(),
+                           record->data.releaseToBson()};
+            _workingSet->transitionToRecordIdAndObj(id);
+
+            *out = id;
+            return PlanStage::ADVANCED;
+        }
+
+        if (_endCondition && _endCondition->matchesBSON(doc)) {
+            _commonStats.isEOF = true;
+            return PlanStage::IS_EOF;
+        }
+
+        if (++recordsRejected >= _batchSize) {
+            return PlanStage::NEED_TIME;
         }
     }
+}
 
-    WorkingSetID id = _workingSet->allocate();
-    WorkingSetMember* member = _workingSet->get(id);
-    member->recordId = record->id;
-    member->obj = {getOpCtx()->recoveryUnit()->getSnapshotId(), record->data.releaseToBson()};
-    _workingSet->transitionToRecordIdAndObj(id);
+boost::optional<Record> CollectionScan::_seekToStartBound() {
+    const RecordId& bound = _isForward() ? *_params.minRecord : *_params.maxRecord;
+    const auto startLoc =
+        _params.collection->getRecordStore()->oplogStartHack(getOpCtx(), bound);
+    if (!startLoc) {
+        // The record store cannot seek, so the records before the bound are read and rejected.
+        return _cursor->next();
+    }
+    if (startLoc->isNull()) {
+        // There are no records before the bound. A forward scan starts at the first record, and
+        // a reverse scan has nothing to return.
+        return _isForward() ? _cursor->next() : boost::none;
+    }
 
-    return returnIfMatches(member, id, out);
+    // A forward scan starts at the last record before its lower bound, which the filter rejects
+    // if it is not within the bound.
+    return _cursor->seekExact(*startLoc);
 }
 
 Status CollectionScan::setLatestOplogEntryTimestamp(const Record& record) {
@@ -197,27 +279,6 @@ Status CollectionScan::setLatestOplogEntryTimestamp(const Record& record) {
     return Status::OK();
 }
 
-PlanStage::StageState CollectionScan::returnIfMatches(WorkingSetMember* member,
-                                                      WorkingSetID memberID,
-                                                      WorkingSetID* out) {
-    ++_specificStats.docsTested;
-
-    if (Filter::passes(member, _filter)) {
-        if (_params.stopApplyingFilterAfterFirstMatch) {
-            _filter = nullptr;
-        }
-        *out = memberID;
-        return PlanStage::ADVANCED;
-    } else if (_endCondition && Filter::passes(member, _endCondition.get())) {
-        _workingSet->free(memberID);
-        _commonStats.isEOF = true;
-        return PlanStage::IS_EOF;
-    } else {
-        _workingSet->free(memberID);
-        return PlanStage::NEED_TIME;
-    }
-}
-
 bool CollectionScan::isEOF() {
     return _commonStats.isEOF || _isDead;
 }
@@ -32,6 +32,7 @@
 
 #include "mongo/db/exec/collection_scan_common.h"
 #include "mongo/db/exec/plan_stage.h"
+#include "mongo/db/matcher/compiled_match_expression.h"
 #include "mongo/db/matcher/expression_leaf.h"
 #include "mongo/db/record_id.h"
 
@@ -78,12 +79,6 @@ public:
     static const char* kStageType;
 
 private:
-    /**
-     * If the member (with id memberID) passes our filter, set *out to memberID and return that
-     * ADVANCED.  Otherwise, free memberID and return NEED_TIME.
-     */
-    StageState returnIfMatches(WorkingSetMember* member, WorkingSetID memberID, WorkingSetID* out);
-
     /**
      * Extracts the timestamp from the 'ts' field of 'record', and sets '_latestOplogEntryTimestamp'
      * to that time if it isn't already greater.  Returns an error if the 'ts' field cannot be
@@ -91,12 +86,25 @@ private:
      */
     Status setLatestOplogEntryTimestamp(const Record& record);
 
+    /**
+     * Positions '_cursor' for the first record of a scan with a bound on the RecordIds at which it
+     * starts, and returns that record.
+     */
+    boost::optional<Record> _seekToStartBound();
+
+    bool _isForward() const {
+        return _params.direction == CollectionScanParams::FORWARD;
+    }
+
     // WorkingSet is not owned by us.
     WorkingSet* _workingSet;
 
     // The filter is not owned by us.
     const MatchExpression* _filter;
 
+    // Evaluates '_filter' against each record. Null if there is no filter.
+    std::unique_ptr<CompiledMatchExpression> _compiledFilter;
+
     // If a document does not pass '_filter' but passes '_endCondition', stop scanning and return
     // IS_EOF.
     BSONObj _endConditionBSON;
@@ -106,10 +114,19 @@ private:
 
     CollectionScanParams _params;
 
+    // The most records a single call to work() examines while looking for one that passes
+    // '_filter'. See 'internalQueryExecCollectionScanBatchSize'.
+    const size_t _batchSize;
+
     bool _isDead;
 
     RecordId _lastSeenId;  // Null if nothing has been returned from _cursor yet.
 
+    // If this is a tailable scan of a capped collection whose inserts may commit out of RecordId
+    // order, the RecordId past which '_cursor' may not return records. See
+    // RecordStore::getCappedVisibilityBound().
+    boost::optional<RecordId> _visibilityBound;
+
     // If _params.shouldTrackLatestOplogTimestamp is set and the collection is the oplog, the latest
     // timestamp seen in the collection.  Otherwise, this is a null timestamp.
     Timestamp _latestOplogEntryTimestamp;
@@ -52,6 +52,12 @@ struct CollectionScanParams {
     // that does not pass the filter and has 'ts' greater than 'maxTs'.
     boost::optional<Timestamp> maxTs;
 
+    // If present, the scan only returns records whose RecordIds are at least 'minRecord' or at most
+    // 'maxRecord'. The scan starts from the first of these bounds in its direction, as found by
+    // RecordStore::oplogStartHack(), and returns EOF once it passes the other.
+    boost::optional<RecordId> minRecord;
+    boost::optional<RecordId> maxRecord;
+
     Direction direction = FORWARD;
 
     // Do we want the scan to be 'tailable'?  Only meaningful if the collection is capped.
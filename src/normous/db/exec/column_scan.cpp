@@ -0,0 +1,243 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/column_scan.h"
+
+#include "mongo/bson/simple_bsonelement_comparator.h"
+#include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/exec/working_set.h"
+#include "mongo/db/index/column_store_key_generator.h"
+#include "mongo/stdx/memory.h"
+
+namespace mongo {
+
+namespace {
+
+const auto kWantKey = SortedDataInterface::Cursor::kWantKey;
+
+// The keys of a columnstore index are { '': <field name>, '': <_id>, '': <value> }.
+BSONElement getRowId(const IndexKeyEntry& entry) {
+    BSONObjIterator it(entry.key);
+    it.next();
+    return it.next();
+}
+
+BSONElement getValue(const IndexKeyEntry& entry) {
+    BSONObjIterator it(entry.key);
+    it.next();
+    it.next();
+    return it.next();
+}
+
+}  // namespace
+
+// static
+const char* ColumnScanStage::kStageType = "COLUMN_SCAN";
+
+ColumnScanStage::ColumnScanStage(OperationContext* opCtx,
+                                 ColumnScanParams params,
+                                 WorkingSet* workingSet,
+                                 const MatchExpression* filter)
+    : PlanStage(kStageType, opCtx),
+      _workingSet(workingSet),
+      _iam(params.accessMethod),
+      _filter(filter),
+      _params(std::move(params)) {
+    _columns.resize(_params.fields.size() + 1);
+    _columns[0].field = ColumnStoreKeyGenerator::kRowIdColumn.toString();
+    for (size_t i = 0; i < _params.fields.size(); ++i) {
+        _columns[i + 1].field = _params.fields[i];
+    }
+
+    _specificStats.indexName = _params.name;
+    _specificStats.keyPattern = _params.keyPattern;
+    _specificStats.fields = _params.fields;
+}
+
+void ColumnScanStage::_openCursors() {
+    for (auto&& column : _columns) {
+        column.cursor = _iam->newCursor(getOpCtx());
+        column.cursor->setEndPosition(ColumnStoreKeyGenerator::makeColumnEndKey(column.field),
+                                      true);
+        column.head = column.cursor->seek(
+            ColumnStoreKeyGenerator::makeColumnStartKey(column.field), true, kWantKey);
+        ++_specificStats.keysExamined;
+    }
+    _cursorsOpen = true;
+}
+
+void ColumnScanStage::_reseekCursors() {
+    auto& rowIdColumn = _columns[0];
+    if (!rowIdColumn.head) {
+        return;
+    }
+
+    // The seeks replace the key holding the row's _id, so keep a copy of it.
+    BSONObjBuilder rowIdBuilder;
+    rowIdBuilder.appendAs(getRowId(*rowIdColumn.head), "");
+    const BSONObj rowIdObj = rowIdBuilder.obj();
+    const BSONElement rowId = rowIdObj.firstElement();
+
+    for (auto&& column : _columns) {
+        column.head = column.cursor->seek(
+            ColumnStoreKeyGenerator::makeColumnStartKey(column.field, rowId), true, kWantKey);
+        ++_specificStats.keysExamined;
+    }
+}
+
+void ColumnScanStage::_advance(Column* column) {
+    column->head = column->cursor->next(kWantKey);
+    ++_specificStats.keysExamined;
+}
+
+PlanStage::StageState ColumnScanStage::doWork(WorkingSetID* out) {
+    if (_commonStats.isEOF) {
+        return PlanStage::IS_EOF;
+    }
+
+    BSONObj row;
+    try {
+        if (!_cursorsOpen) {
+            _openCursors();
+        } else if (_needsReseek) {
+            _reseekCursors();
+        }
+        _needsReseek = false;
+
+        auto& rowIdColumn = _columns[0];
+        if (!rowIdColumn.head) {
+            _commonStats.isEOF = true;
+            _columns.clear();
+            return PlanStage::IS_EOF;
+        }
+
+        // Every document has a key in the _id column, so its current key identifies the next row.
+        // The other columns are at that row's keys or, if the document does not have their field,
+        // at the keys of later rows.
+        const BSONElement rowId = getRowId(*rowIdColumn.head);
+        BSONObjBuilder bob;
+        bob.appendAs(rowId, rowIdColumn.field);
+        for (size_t i = 1; i < _columns.size(); ++i) {
+            auto& column = _columns[i];
+            while (column.head &&
+                   SimpleBSONElementComparator::kInstance.evaluate(getRowId(*column.head) <
+                                                                   rowId)) {
+                _advance(&column);
+            }
+            if (column.head &&
+                SimpleBSONElementComparator::kInstance.evaluate(getRowId(*column.head) == rowId)) {
+                bob.appendAs(getValue(*column.head), column.field);
+                _advance(&column);
+            }
+        }
+        row = bob.obj();
+
+        _advance(&rowIdColumn);
+    } catch (const WriteConflictException&) {
+        if (!_cursorsOpen) {
+            // Release our cursors and try again next time.
+            for (auto&& column : _columns) {
+                column.cursor.reset();
+            }
+        } else {
+            // Some of the columns may have moved past the row being read.
+            _needsReseek = true;
+        }
+        *out = WorkingSet::INVALID_ID;
+        return PlanStage::NEED_YIELD;
+    }
+
+    ++_specificStats.rowsTested;
+    if (_filter && !_filter->matchesBSON(row, nullptr)) {
+        return PlanStage::NEED_TIME;
+    }
+
+    WorkingSetID id = _workingSet->allocate();
+    WorkingSetMember* member = _workingSet->get(id);
+    member->obj = Snapshotted<BSONObj>(SnapshotId(), std::move(row));
+    member->transitionToOwnedObj();
+    *out = id;
+    return PlanStage::ADVANCED;
+}
+
+bool ColumnScanStage::isEOF() {
+    return _commonStats.isEOF;
+}
+
+void ColumnScanStage::doSaveState() {
+    for (auto&& column : _columns) {
+        if (column.cursor) {
+            column.cursor->save();
+        }
+    }
+}
+
+void ColumnScanStage::doRestoreState() {
+    for (auto&& column : _columns) {
+        if (column.cursor) {
+            column.cursor->restore();
+        }
+    }
+
+    // The keys read before the yield may have been deleted, or the values of their fields
+    // changed, in the meantime.
+    if (_cursorsOpen) {
+        _needsReseek = true;
+    }
+}
+
+void ColumnScanStage::doDetachFromOperationContext() {
+    for (auto&& column : _columns) {
+        if (column.cursor) {
+            column.cursor->detachFromOperationContext();
+        }
+    }
+}
+
+void ColumnScanStage::doReattachToOperationContext() {
+    for (auto&& column : _columns) {
+        if (column.cursor) {
+            column.cursor->reattachToOperationContext(getOpCtx());
+        }
+    }
+}
+
+std::unique_ptr<PlanStageStats> ColumnScanStage::getStats() {
+    _commonStats.isEOF = isEOF();
+    auto ret = stdx::make_unique<PlanStageStats>(_commonStats, STAGE_COLUMN_SCAN);
+    ret->specific = stdx::make_unique<ColumnScanStats>(_specificStats);
+    return ret;
+}
+
+const SpecificStats* ColumnScanStage::getSpecificStats() const {
+    return &_specificStats;
+}
+
+}  // namespace mongo
@@ -0,0 +1,143 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/db/exec/plan_stage.h"
+#include "mongo/db/index/index_access_method.h"
+#include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/db/matcher/expression.h"
+#include "mongo/db/storage/sorted_data_interface.h"
+
+namespace mongo {
+
+class WorkingSet;
+
+struct ColumnScanParams {
+    explicit ColumnScanParams(const IndexDescriptor& descriptor)
+        : accessMethod(descriptor.getIndexCatalog()->getIndex(&descriptor)),
+          name(descriptor.indexName()),
+          keyPattern(descriptor.keyPattern()) {
+        invariant(accessMethod);
+    }
+
+    const IndexAccessMethod* accessMethod;
+
+    std::string name;
+
+    BSONObj keyPattern;
+
+    // The top-level fields to read into each row, in the order they appear in it. The _id column
+    // is always read, and comes first.
+    std::vector<std::string> fields;
+};
+
+/**
+ * Reads rows made of the requested top-level fields from the columns of a columnstore index,
+ * without looking at the documents themselves. The stage merges one cursor per column: since the
+ * keys of every column are ordered by _id, each row is assembled from the current key of each
+ * column in turn, driven by the _id column which has a key for every document. Fields which a
+ * document does not have are missing from its row.
+ *
+ * Rows which pass 'filter' are returned as WorkingSetMembers in the OWNED_OBJ state. They have no
+ * RecordId, so this stage can only answer queries which need no more than these fields.
+ */
+class ColumnScanStage final : public PlanStage {
+public:
+    ColumnScanStage(OperationContext* opCtx,
+                    ColumnScanParams params,
+                    WorkingSet* workingSet,
+                    const MatchExpression* filter);
+
+    StageState doWork(WorkingSetID* out) final;
+    bool isEOF() final;
+    void doSaveState() final;
+    void doRestoreState() final;
+    void doDetachFromOperationContext() final;
+    void doReattachToOperationContext() final;
+
+    StageType stageType() const final {
+        return STAGE_COLUMN_SCAN;
+    }
+
+    std::unique_ptr<PlanStageStats> getStats() final;
+
+    const SpecificStats* getSpecificStats() const final;
+
+    static const char* kStageType;
+
+private:
+    struct Column {
+        std::string field;
+        std::unique_ptr<SortedDataInterface::Cursor> cursor;
+
+        // The next key of the column, or none once the column is exhausted.
+        boost::optional<IndexKeyEntry> head;
+    };
+
+    /**
+     * Opens a cursor over each column, positioned at its first key.
+     */
+    void _openCursors();
+
+    /**
+     * Positions every column at the first key of the row which the _id column is at. Used after
+     * a yield, when the keys read beforehand may no longer exist, or their values may have
+     * changed.
+     */
+    void _reseekCursors();
+
+    void _advance(Column* column);
+
+    // The WorkingSet we annotate with results. Not owned by us.
+    WorkingSet* _workingSet;
+
+    // Index access. The pointer below is owned by Collection -> IndexCatalog.
+    const IndexAccessMethod* _iam;
+
+    // The _id column first, then the columns of 'fields'.
+    std::vector<Column> _columns;
+
+    bool _cursorsOpen = false;
+    bool _needsReseek = false;
+
+    // Not owned by us.
+    const MatchExpression* _filter;
+
+    ColumnScanParams _params;
+
+    ColumnScanStats _specificStats;
+};
+
+}  // namespace mongo
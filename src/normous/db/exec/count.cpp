@@ -31,6 +31,7 @@
 #include "mongo/db/exec/count.h"
 
 #include "mongo/db/catalog/collection.h"
+#include "mongo/db/exec/count_scan.h"
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/stdx/memory.h"
@@ -59,7 +60,7 @@ CountStage::CountStage(OperationContext* opCtx,
 }
 
 bool CountStage::isEOF() {
-    if (_specificStats.recordStoreCount) {
+    if (_specificStats.recordStoreCount || _countedFromCache) {
         return true;
     }
 
@@ -72,7 +73,12 @@ bool CountStage::isEOF() {
 
 void CountStage::recordStoreCount() {
     invariant(_collection);
-    long long nCounted = _collection->numRecords(getOpCtx());
+    countFromTotal(_collection->numRecords(getOpCtx()));
+    _specificStats.recordStoreCount = true;
+}
+
+void CountStage::countFromTotal(long long total) {
+    long long nCounted = total;
 
     if (0 != _params.skip) {
         nCounted -= _params.skip;
@@ -92,7 +98,6 @@ void CountStage::recordStoreCount() {
 
     _specificStats.nCounted = nCounted;
     _specificStats.nSkipped = _params.skip;
-    _specificStats.recordStoreCount = true;
 }
 
 PlanStage::StageState CountStage::doWork(WorkingSetID* out) {
@@ -113,6 +118,19 @@ PlanStage::StageState CountStage::doWork(WorkingSetID* out) {
     // For cases where we can't ask the record store directly, we should always have a child stage
     // from which we can retrieve results.
     invariant(child());
+
+    if (!_checkedCountScanCache) {
+        _checkedCountScanCache = true;
+        if (STAGE_COUNT_SCAN == child()->stageType()) {
+            if (auto total = static_cast<CountScan*>(child().get())->countFromCache()) {
+                countFromTotal(*total);
+                _countedFromCache = true;
+                _commonStats.isEOF = true;
+                return PlanStage::IS_EOF;
+            }
+        }
+    }
+
     WorkingSetID id = WorkingSet::INVALID_ID;
     PlanStage::StageState state = child()->work(&id);
 
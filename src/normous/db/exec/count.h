@@ -99,6 +99,12 @@ private:
      */
     void recordStoreCount();
 
+    /**
+     * Stores the count obtained by applying the skip and limit to 'total' results in
+     * '_specificStats'.
+     */
+    void countFromTotal(long long total);
+
     // The collection over which we are counting.
     Collection* _collection;
 
@@ -107,6 +113,11 @@ private:
     // The number of documents that we still need to skip.
     long long _leftToSkip;
 
+    // Whether the child COUNT_SCAN, if any, has been asked for a cached count yet, and whether it
+    // provided one.
+    bool _checkedCountScanCache = false;
+    bool _countedFromCache = false;
+
     // The working set used to pass intermediate results between stages. Not owned
     // by us.
     WorkingSet* _ws;
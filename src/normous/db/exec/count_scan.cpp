@@ -32,6 +32,8 @@
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/index/index_access_method.h"
+#include "mongo/db/index/index_range_count_cache.h"
+#include "mongo/db/repl/read_concern_args.h"
 #include "mongo/stdx/memory.h"
 
 namespace mongo {
@@ -60,6 +62,24 @@ BSONObj replaceBSONFieldNames(const BSONObj& replace, const BSONObj& fieldNames)
 
     return bob.obj();
 }
+
+/**
+ * Cached range counts describe the latest committed state of the index, so they may only serve
+ * reads which would otherwise look at the latest committed data.
+ */
+bool canUseRangeCountCache(OperationContext* opCtx) {
+    if (opCtx->lockState()->inAWriteUnitOfWork()) {
+        return false;
+    }
+
+    if (opCtx->recoveryUnit()->getTimestampReadSource() != RecoveryUnit::ReadSource::kUnset) {
+        return false;
+    }
+
+    const auto level = repl::ReadConcernArgs::get(opCtx).getLevel();
+    return level == repl::ReadConcernLevel::kLocalReadConcern ||
+        level == repl::ReadConcernLevel::kAvailableReadConcern;
+}
 }
 
 using std::unique_ptr;
@@ -127,10 +147,19 @@ PlanStage::StageState CountScan::doWork(WorkingSetID* out) {
     if (!entry) {
         _commonStats.isEOF = true;
         _cursor.reset();
+
+        if (_rangeCountGeneration) {
+            _params.rangeCountCache->add(_params.startKey,
+                                         _params.startKeyInclusive,
+                                         _params.endKey,
+                                         _params.endKeyInclusive,
+                                         _commonStats.advanced,
+                                         *_rangeCountGeneration);
+        }
         return PlanStage::IS_EOF;
     }
 
-    if (_shouldDedup && !_returned.insert(entry->loc).second) {
+    if (_shouldDedup && !_returned.insert(entry->loc)) {
         // *loc was already in _returned.
         return PlanStage::NEED_TIME;
     }
@@ -185,4 +214,28 @@ const SpecificStats* CountScan::getSpecificStats() const {
     return &_specificStats;
 }
 
+boost::optional<long long> CountScan::countFromCache() {
+    invariant(!_cursor && !_commonStats.isEOF);
+
+    if (!_params.rangeCountCache || !canUseRangeCountCache(getOpCtx())) {
+        return boost::none;
+    }
+
+    const auto generation = _params.rangeCountCache->getGeneration();
+    if (auto count = _params.rangeCountCache->get(_params.startKey,
+                                                  _params.startKeyInclusive,
+                                                  _params.endKey,
+                                                  _params.endKeyInclusive)) {
+        _specificStats.countFromCache = true;
+        _commonStats.isEOF = true;
+        return count;
+    }
+
+    // Writes which committed before 'generation' was observed may not be visible in a snapshot
+    // opened earlier. Scan from a new snapshot so that the count can be cached under it.
+    getOpCtx()->recoveryUnit()->abandonSnapshot();
+    _rangeCountGeneration = generation;
+    return boost::none;
+}
+
 }  // namespace mongo
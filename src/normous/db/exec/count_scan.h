@@ -28,17 +28,20 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+
 #include "mongo/db/exec/plan_stage.h"
+#include "mongo/db/exec/record_id_bitmap.h"
 #include "mongo/db/index/index_access_method.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/record_id.h"
-#include "mongo/stdx/unordered_set.h"
 
 namespace mongo {
 
+class IndexRangeCountCache;
 class WorkingSet;
 
 struct CountScanParams {
@@ -48,6 +51,8 @@ struct CountScanParams {
                     MultikeyPaths multikeyPaths,
                     bool multikey)
         : accessMethod(descriptor.getIndexCatalog()->getIndex(&descriptor)),
+          rangeCountCache(
+              descriptor.getIndexCatalog()->getEntry(&descriptor)->getRangeCountCache()),
           name(std::move(indexName)),
           keyPattern(std::move(keyPattern)),
           multikeyPaths(std::move(multikeyPaths)),
@@ -70,6 +75,10 @@ struct CountScanParams {
                           descriptor.isMultikey(opCtx)) {}
 
     const IndexAccessMethod* accessMethod;
+
+    // Remembers the counts of recently scanned ranges of the index. Null if disabled.
+    IndexRangeCountCache* rangeCountCache;
+
     std::string name;
 
     BSONObj keyPattern;
@@ -120,6 +129,14 @@ public:
 
     const SpecificStats* getSpecificStats() const final;
 
+    /**
+     * Returns the number of keys in range if it is known from the index's cache of range counts,
+     * in which case this stage is EOF without having produced any results. Otherwise prepares the
+     * scan to add its count to the cache when it completes. Must be called before the first
+     * work().
+     */
+    boost::optional<long long> countFromCache();
+
     static const char* kStageType;
 
 private:
@@ -133,10 +150,14 @@ private:
 
     // Could our index have duplicates?  If so, we use _returned to dedup.
     const bool _shouldDedup;
-    stdx::unordered_set<RecordId, RecordId::Hasher> _returned;
+    RecordIdBitmap _returned;
 
     CountScanParams _params;
 
+    // The generation of the range count cache observed before this scan opened its snapshot. Set
+    // only if the result of the scan may be cached.
+    boost::optional<unsigned long long> _rangeCountGeneration;
+
     CountScanStats _specificStats;
 };
 
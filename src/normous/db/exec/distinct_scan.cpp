@@ -104,7 +104,7 @@ PlanStage::StageState DistinctScan::doWork(WorkingSetID* out) {
             // are using.
 
             if (!kv->key.isOwned())
-                kv->key = kv->key.getOwned();
+                kv->key = _workingSet->copyToArena(kv->key);
             _seekPoint.keyPrefix = kv->key;
             _seekPoint.prefixLen = _params.fieldNo + 1;
             _seekPoint.prefixExclusive = true;
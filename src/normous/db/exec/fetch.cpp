@@ -35,6 +35,7 @@
 #include "mongo/db/exec/filter.h"
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/mongoutils/str.h"
@@ -57,7 +58,8 @@ FetchStage::FetchStage(OperationContext* opCtx,
       _collection(collection),
       _ws(ws),
       _filter(filter),
-      _idRetrying(WorkingSet::INVALID_ID) {
+      _idRetrying(WorkingSet::INVALID_ID),
+      _batchSize(static_cast<size_t>(internalQueryExecFetchBatchSize.load())) {
     _children.emplace_back(child);
 }
 
@@ -69,6 +71,11 @@ bool FetchStage::isEOF() {
         return false;
     }
 
+    if (!_pending.empty() || !_fetched.empty()) {
+        // We still have buffered members to fetch or to return.
+        return false;
+    }
+
     return child()->isEOF();
 }
 
@@ -77,6 +84,10 @@ PlanStage::StageState FetchStage::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
+    if (_batchSize > 1) {
+        return doWorkBatched(out);
+    }
+
     // Either retry the last WSM we worked on or get a new one from our child.
     WorkingSetID id;
     StageState status;
@@ -131,6 +142,96 @@ PlanStage::StageState FetchStage::doWork(WorkingSetID* out) {
     return status;
 }
 
+PlanStage::StageState FetchStage::doWorkBatched(WorkingSetID* out) {
+    // Hand out members whose documents have already been fetched before doing anything else.
+    if (!_fetched.empty()) {
+        WorkingSetID id = _fetched.front();
+        _fetched.pop();
+        return returnIfMatches(_ws->get(id), id, out);
+    }
+
+    // Accumulate a batch of members from our child. Members which already have an object are
+    // buffered too, so that we return results in the order our child produced them.
+    if (_pending.size() < _batchSize) {
+        WorkingSetID id = WorkingSet::INVALID_ID;
+        StageState status = child()->work(&id);
+
+        if (PlanStage::ADVANCED == status) {
+            WorkingSetMember* member = _ws->get(id);
+            if (member->hasObj()) {
+                ++_specificStats.alreadyHasObj;
+                // We hold on to this member across calls to work(), so it must survive a yield.
+                member->makeObjOwnedIfNeeded();
+            } else {
+                // We need a valid RecordId to fetch from and this is the only state that has one.
+                verify(WorkingSetMember::RID_AND_IDX == member->getState());
+                verify(member->hasRecordId());
+            }
+
+            _pending.push_back(id);
+            if (_pending.size() < _batchSize) {
+                return PlanStage::NEED_TIME;
+            }
+        } else if (PlanStage::IS_EOF == status) {
+            if (_pending.empty()) {
+                return PlanStage::IS_EOF;
+            }
+            // Fall through to fetch the final, partial batch.
+        } else if (PlanStage::FAILURE == status || PlanStage::DEAD == status) {
+            // The stage which produces a failure is responsible for allocating a working set member
+            // with error details.
+            invariant(WorkingSet::INVALID_ID != id);
+            *out = id;
+            return status;
+        } else {
+            if (PlanStage::NEED_YIELD == status) {
+                *out = id;
+            }
+            return status;
+        }
+    }
+
+    // Look up the documents for the whole batch with a single call down to the record store.
+    std::vector<WorkingSetID> toFetch;
+    for (auto id : _pending) {
+        if (!_ws->get(id)->hasObj()) {
+            toFetch.push_back(id);
+        }
+    }
+
+    try {
+        if (!_cursor)
+            _cursor = _collection->getCursor(getOpCtx());
+
+        auto fetched = WorkingSetCommon::fetchBatch(getOpCtx(), _ws, toFetch, _cursor);
+
+        // 'toFetch' is a subsequence of '_pending', so a single pass lines the two up.
+        size_t fetchIdx = 0;
+        for (auto id : _pending) {
+            if (fetchIdx < toFetch.size() && toFetch[fetchIdx] == id) {
+                if (!fetched[fetchIdx++]) {
+                    _ws->free(id);
+                    continue;
+                }
+            }
+            _fetched.push(id);
+        }
+        _pending.clear();
+    } catch (const WriteConflictException&) {
+        // No member has been modified, so the whole batch is simply retried after the yield.
+        *out = WorkingSet::INVALID_ID;
+        return NEED_YIELD;
+    }
+
+    if (_fetched.empty()) {
+        return PlanStage::NEED_TIME;
+    }
+
+    WorkingSetID id = _fetched.front();
+    _fetched.pop();
+    return returnIfMatches(_ws->get(id), id, out);
+}
+
 void FetchStage::doSaveState() {
     if (_cursor)
         _cursor->saveUnpositioned();
@@ -29,6 +29,8 @@
 #pragma once
 
 #include <memory>
+#include <queue>
+#include <vector>
 
 #include "mongo/db/exec/plan_stage.h"
 #include "mongo/db/jsobj.h"
@@ -76,6 +78,13 @@ public:
     static const char* kStageType;
 
 private:
+    /**
+     * Implements doWork() when batching is enabled: buffers up to '_batchSize' members from our
+     * child and then fetches all of their documents at once with
+     * SeekableRecordCursor::seekExactBatch(), amortizing the cost of a record store lookup.
+     */
+    StageState doWorkBatched(WorkingSetID* out);
+
     /**
      * If the member (with id memberID) passes our filter, set *out to memberID and return that
      * ADVANCED.  Otherwise, free memberID and return NEED_TIME.
@@ -97,6 +106,16 @@ private:
     // If not Null, we use this rather than asking our child what to do next.
     WorkingSetID _idRetrying;
 
+    // The number of members to accumulate before fetching them together. Batching is disabled when
+    // this is 1. See 'internalQueryExecFetchBatchSize'.
+    const size_t _batchSize;
+
+    // Members received from our child which have not been fetched yet, in the order they arrived.
+    std::vector<WorkingSetID> _pending;
+
+    // Members whose documents have been fetched and which are waiting to be returned.
+    std::queue<WorkingSetID> _fetched;
+
     // Stats
     FetchStats _specificStats;
 };
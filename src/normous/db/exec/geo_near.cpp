@@ -50,7 +50,9 @@
 #include "mongo/db/query/expression_index.h"
 #include "mongo/db/query/expression_index_knobs.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/stdx/mutex.h"
 #include "mongo/util/log.h"
+#include "mongo/util/lru_cache.h"
 
 #include <algorithm>
 
@@ -832,6 +834,61 @@ S2Region* buildS2Region(const R2Annulus& sphereBounds) {
     // Takes ownership of caps
     return new S2RegionIntersection(&regions);
 }
+
+/**
+ * Remembers the S2 coverings of recently searched annuli across GeoNear2DSphereStages. Repeated
+ * queries around the same center search the same sequence of annuli, so they can skip running the
+ * S2RegionCoverer for each one.
+ */
+class AnnulusCoveringCache {
+public:
+    static AnnulusCoveringCache& get() {
+        static AnnulusCoveringCache cache(internalQueryS2GeoNearCoveringCacheSize);
+        return cache;
+    }
+
+    /**
+     * Returns the covering of 'annulus', whose region is 'region', under the current covering
+     * knobs.
+     */
+    std::vector<S2CellId> getCovering(const R2Annulus& annulus, const S2Region& region) {
+        if (internalQueryS2GeoNearCoveringCacheSize == 0) {
+            return ExpressionMapping::get2dsphereCovering(region);
+        }
+
+        std::string key;
+        auto appendToKey = [&key](auto value) {
+            key.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        };
+        appendToKey(annulus.center().x);
+        appendToKey(annulus.center().y);
+        appendToKey(annulus.getInner());
+        appendToKey(annulus.getOuter());
+        appendToKey(internalQueryS2GeoCoarsestLevel.load());
+        appendToKey(internalQueryS2GeoFinestLevel.load());
+        appendToKey(internalQueryS2GeoMaxCells.load());
+
+        {
+            stdx::lock_guard<stdx::mutex> lk(_mutex);
+            auto it = _coverings.find(key);
+            if (it != _coverings.end()) {
+                return it->second;
+            }
+        }
+
+        std::vector<S2CellId> cover = ExpressionMapping::get2dsphereCovering(region);
+
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _coverings.add(std::move(key), cover);
+        return cover;
+    }
+
+private:
+    explicit AnnulusCoveringCache(size_t maxSize) : _coverings(maxSize) {}
+
+    stdx::mutex _mutex;
+    LRUCache<std::string, std::vector<S2CellId>> _coverings;
+};
 }
 
 // Estimate the density of data by search the nearest cells level by level around center.
@@ -1062,7 +1119,7 @@ StatusWith<NearStage::CoveredInterval*>  //
     scanParams.bounds.fields[s2FieldPosition].intervals.clear();
     std::unique_ptr<S2Region> region(buildS2Region(_currBounds));
 
-    std::vector<S2CellId> cover = ExpressionMapping::get2dsphereCovering(*region);
+    std::vector<S2CellId> cover = AnnulusCoveringCache::get().getCovering(_currBounds, *region);
 
     // Generate a covering that does not intersect with any previous coverings
     S2CellUnion coverUnion;
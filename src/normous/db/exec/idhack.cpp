@@ -30,6 +30,7 @@
 
 #include "mongo/db/exec/idhack.h"
 
+#include "mongo/db/catalog/collection_document_cache.h"
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/exec/index_scan.h"
@@ -38,10 +39,36 @@
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/exec/working_set_computed_data.h"
 #include "mongo/db/index/btree_access_method.h"
+#include "mongo/db/repl/read_concern_args.h"
+#include "mongo/db/storage/clustered_record_id.h"
 #include "mongo/stdx/memory.h"
 
 namespace mongo {
 
+namespace {
+
+/**
+ * Cached documents are the latest committed versions, so they may only serve reads which would
+ * otherwise open a new snapshot of the latest committed data.
+ */
+bool canUseDocumentCache(OperationContext* opCtx) {
+    if (opCtx->lockState()->inAWriteUnitOfWork()) {
+        return false;
+    }
+
+    auto recoveryUnit = opCtx->recoveryUnit();
+    if (recoveryUnit->getTimestampReadSource() != RecoveryUnit::ReadSource::kUnset ||
+        recoveryUnit->inActiveTxn()) {
+        return false;
+    }
+
+    const auto level = repl::ReadConcernArgs::get(opCtx).getLevel();
+    return level == repl::ReadConcernLevel::kLocalReadConcern ||
+        level == repl::ReadConcernLevel::kAvailableReadConcern;
+}
+
+}  // namespace
+
 using std::unique_ptr;
 using std::vector;
 using stdx::make_unique;
@@ -58,10 +85,15 @@ IDHackStage::IDHackStage(OperationContext* opCtx,
       _collection(collection),
       _workingSet(ws),
       _key(query->getQueryObj()["_id"].wrap()),
-      _done(false) {
-    const IndexCatalog* catalog = _collection->getIndexCatalog();
-    _specificStats.indexName = descriptor->indexName();
-    _accessMethod = catalog->getIndex(descriptor);
+      _done(false),
+      _documentCache(collection->getDocumentCache()) {
+    if (descriptor) {
+        const IndexCatalog* catalog = _collection->getIndexCatalog();
+        _specificStats.indexName = descriptor->indexName();
+        _accessMethod = catalog->getIndex(descriptor);
+    } else {
+        invariant(_collection->getRecordStore()->isClustered());
+    }
 
     if (NULL != query->getProj()) {
         _addKeyMetadata = query->getProj()->wantIndexKey();
@@ -81,9 +113,13 @@ IDHackStage::IDHackStage(OperationContext* opCtx,
       _key(key),
       _done(false),
       _addKeyMetadata(false) {
-    const IndexCatalog* catalog = _collection->getIndexCatalog();
-    _specificStats.indexName = descriptor->indexName();
-    _accessMethod = catalog->getIndex(descriptor);
+    if (descriptor) {
+        const IndexCatalog* catalog = _collection->getIndexCatalog();
+        _specificStats.indexName = descriptor->indexName();
+        _accessMethod = catalog->getIndex(descriptor);
+    } else {
+        invariant(_collection->getRecordStore()->isClustered());
+    }
 }
 
 IDHackStage::~IDHackStage() {}
@@ -97,10 +133,39 @@ PlanStage::StageState IDHackStage::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
+    boost::optional<unsigned long long> cacheGeneration;
+    if (_documentCache && canUseDocumentCache(getOpCtx())) {
+        cacheGeneration = _documentCache->getGeneration();
+        if (auto cached = _documentCache->get(_key)) {
+            ++_specificStats.docsExamined;
+            _specificStats.docFromCache = true;
+
+            WorkingSetID id = _workingSet->allocate();
+            WorkingSetMember* member = _workingSet->get(id);
+            member->recordId = cached->recordId;
+            member->obj = {getOpCtx()->recoveryUnit()->getSnapshotId(), std::move(cached->doc)};
+            _workingSet->transitionToRecordIdAndObj(id);
+            return advance(id, member, out);
+        }
+    }
+
     WorkingSetID id = WorkingSet::INVALID_ID;
     try {
-        // Look up the key by going directly to the index.
-        RecordId recordId = _accessMethod->findSingle(getOpCtx(), _key);
+        RecordId recordId;
+        if (_accessMethod) {
+            // Look up the key by going directly to the index.
+            recordId = _accessMethod->findSingle(getOpCtx(), _key);
+            if (!recordId.isNull()) {
+                ++_specificStats.keysExamined;
+            }
+        } else {
+            // The _id of a document in a clustered collection is its RecordId. Values which are not
+            // valid RecordIds cannot be the _id of any document.
+            auto key = clustered_record_id::keyForId(_key.firstElement());
+            if (key.isOK()) {
+                recordId = key.getValue();
+            }
+        }
 
         // Key not found.
         if (recordId.isNull()) {
@@ -108,7 +173,6 @@ PlanStage::StageState IDHackStage::doWork(WorkingSetID* out) {
             return PlanStage::IS_EOF;
         }
 
-        ++_specificStats.keysExamined;
         ++_specificStats.docsExamined;
 
         // Create a new WSM for the result document.
@@ -129,6 +193,10 @@ PlanStage::StageState IDHackStage::doWork(WorkingSetID* out) {
             return IS_EOF;
         }
 
+        if (cacheGeneration) {
+            _documentCache->add(_key, recordId, member->obj.value(), *cacheGeneration);
+        }
+
         return advance(id, member, out);
     } catch (const WriteConflictException&) {
         // Restart at the beginning on retry.
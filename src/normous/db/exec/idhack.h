@@ -37,6 +37,7 @@
 
 namespace mongo {
 
+class CollectionDocumentCache;
 class IndexAccessMethod;
 class RecordCursor;
 
@@ -44,6 +45,9 @@ class RecordCursor;
  * A standalone stage implementing the fast path for key-value retrievals via the _id index. Since
  * the _id index always has the collection default collation, the IDHackStage can only be used when
  * the query's collation is equal to the collection default.
+ *
+ * A clustered collection has no _id index, and is given a null 'descriptor': the record is then
+ * looked up directly by the RecordId its _id maps to.
  */
 class IDHackStage final : public PlanStage {
 public:
@@ -101,8 +105,8 @@ private:
     // The WorkingSet we annotate with results.  Not owned by us.
     WorkingSet* _workingSet;
 
-    // Not owned here.
-    const IndexAccessMethod* _accessMethod;
+    // Not owned here. Null if the collection is clustered.
+    const IndexAccessMethod* _accessMethod = nullptr;
 
     // The value to match against the _id field.
     BSONObj _key;
@@ -113,6 +117,10 @@ private:
     // Do we need to add index key metadata for returnKey?
     bool _addKeyMetadata;
 
+    // Not owned here. Null if the collection does not cache documents, or if this stage does not
+    // answer a query.
+    CollectionDocumentCache* _documentCache = nullptr;
+
     IDHackStats _specificStats;
 };
 
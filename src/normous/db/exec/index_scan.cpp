@@ -188,7 +188,7 @@ PlanStage::StageState IndexScan::doWork(WorkingSetID* out) {
 
     if (_params.shouldDedup) {
         ++_specificStats.dupsTested;
-        if (!_returned.insert(kv->loc).second) {
+        if (!_returned.insert(kv->loc)) {
             // We've seen this RecordId before. Skip it this time.
             ++_specificStats.dupsDropped;
             return PlanStage::NEED_TIME;
@@ -202,7 +202,7 @@ PlanStage::StageState IndexScan::doWork(WorkingSetID* out) {
     }
 
     if (!kv->key.isOwned())
-        kv->key = kv->key.getOwned();
+        kv->key = _workingSet->copyToArena(kv->key);
 
     // We found something to return, so fill out the WSM.
     WorkingSetID id = _workingSet->allocate();
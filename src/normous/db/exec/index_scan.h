@@ -29,6 +29,7 @@
 #pragma once
 
 #include "mongo/db/exec/plan_stage.h"
+#include "mongo/db/exec/record_id_bitmap.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression.h"
@@ -36,7 +37,6 @@
 #include "mongo/db/record_id.h"
 #include "mongo/db/storage/index_entry_comparison.h"
 #include "mongo/db/storage/sorted_data_interface.h"
-#include "mongo/stdx/unordered_set.h"
 
 namespace mongo {
 
@@ -166,7 +166,7 @@ private:
     const MatchExpression* const _filter;
 
     // Could our index have duplicates?  If so, we use _returned to dedup.
-    stdx::unordered_set<RecordId, RecordId::Hasher> _returned;
+    RecordIdBitmap _returned;
 
     const bool _forward;
     const IndexScanParams _params;
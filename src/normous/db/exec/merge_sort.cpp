@@ -31,7 +31,9 @@
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/query/collation/collation_index_key.h"
 #include "mongo/db/query/collation/collator_interface.h"
+#include "mongo/db/storage/key_string.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/mongoutils/str.h"
 
@@ -56,7 +58,10 @@ MergeSortStage::MergeSortStage(OperationContext* opCtx,
       _pattern(params.pattern),
       _collator(params.collator),
       _dedup(params.dedup),
-      _merging(StageWithValueComparison(ws, params.pattern, params.collator)) {}
+      _useSortKeys(static_cast<size_t>(params.pattern.nFields()) <=
+                   Ordering::kMaxCompoundIndexKeys),
+      _ordering(_useSortKeys ? Ordering::make(params.pattern) : Ordering::make(BSONObj())),
+      _merging(StageWithValueComparison(ws, params.pattern, params.collator, _useSortKeys)) {}
 
 void MergeSortStage::addChild(PlanStage* child) {
     _children.emplace_back(child);
@@ -95,14 +100,13 @@ PlanStage::StageState MergeSortStage::doWork(WorkingSetID* out) {
                 } else {
                     ++_specificStats.dupsTested;
                     // ...and there's a RecordId and and we've seen the RecordId before
-                    if (_seen.end() != _seen.find(member->recordId)) {
+                    // (otherwise this notes that we've seen it)
+                    if (!_seen.insert(member->recordId)) {
                         // ...drop it.
                         _ws->free(id);
                         ++_specificStats.dupsDropped;
                         return PlanStage::NEED_TIME;
                     } else {
-                        // Otherwise, note that we've seen it.
-                        _seen.insert(member->recordId);
                         // We're going to use the result from the child, so we remove it from
                         // the queue of children without a result.
                         _noResultToMerge.pop();
@@ -120,7 +124,10 @@ PlanStage::StageState MergeSortStage::doWork(WorkingSetID* out) {
             value.stage = child;
             // Ensure that the BSONObj underlying the WorkingSetMember is owned in case we yield.
             member->makeObjOwnedIfNeeded();
-            _mergingData.push_front(value);
+            if (_useSortKeys) {
+                value.sortKey = makeSortKey(*member);
+            }
+            _mergingData.push_front(std::move(value));
 
             // Insert the result (indirectly) into our priority queue.
             _merging.push(_mergingData.begin());
@@ -170,6 +177,10 @@ PlanStage::StageState MergeSortStage::doWork(WorkingSetID* out) {
 // the return from the expected value.
 bool MergeSortStage::StageWithValueComparison::operator()(const MergingRef& lhs,
                                                           const MergingRef& rhs) {
+    if (_useSortKeys) {
+        return lhs->sortKey.compare(rhs->sortKey) > 0;
+    }
+
     WorkingSetMember* lhsMember = _ws->get(lhs->id);
     WorkingSetMember* rhsMember = _ws->get(rhs->id);
 
@@ -200,6 +211,20 @@ bool MergeSortStage::StageWithValueComparison::operator()(const MergingRef& lhs,
     return false;
 }
 
+std::string MergeSortStage::makeSortKey(const WorkingSetMember& member) const {
+    BSONObjBuilder keyBob;
+    for (auto&& patternElt : _pattern) {
+        BSONElement elt;
+        verify(member.getFieldDotted(patternElt.fieldName(), &elt));
+        // Comparing collation keys as binary strings matches comparing the strings with
+        // '_collator'.
+        CollationIndexKey::collationAwareIndexKeyAppend(elt, _collator, &keyBob);
+    }
+
+    KeyString keyString(KeyString::Version::V1, keyBob.done(), _ordering);
+    return std::string(keyString.getBuffer(), keyString.getSize());
+}
+
 unique_ptr<PlanStageStats> MergeSortStage::getStats() {
     _commonStats.isEOF = isEOF();
 
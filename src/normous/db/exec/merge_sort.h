@@ -30,9 +30,11 @@
 
 #include <list>
 #include <queue>
+#include <string>
 #include <vector>
 
 #include "mongo/db/exec/plan_stage.h"
+#include "mongo/db/exec/record_id_bitmap.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/record_id.h"
@@ -81,6 +83,10 @@ private:
         StageWithValue() : id(WorkingSet::INVALID_ID), stage(NULL) {}
         WorkingSetID id;
         PlanStage* stage;
+        // The values of the sort pattern's fields in the result, with strings replaced by their
+        // collation keys, encoded once as a KeyString so that results compare with memcmp().
+        // Empty if the pattern has too many fields to be described by an Ordering.
+        std::string sortKey;
     };
 
     // This stage maintains a priority queue of results from each child stage so that it can quickly
@@ -91,8 +97,11 @@ private:
     // The comparison function used in our priority queue.
     class StageWithValueComparison {
     public:
-        StageWithValueComparison(WorkingSet* ws, BSONObj pattern, const CollatorInterface* collator)
-            : _ws(ws), _pattern(pattern), _collator(collator) {}
+        StageWithValueComparison(WorkingSet* ws,
+                                 BSONObj pattern,
+                                 const CollatorInterface* collator,
+                                 bool useSortKeys)
+            : _ws(ws), _pattern(pattern), _collator(collator), _useSortKeys(useSortKeys) {}
 
         // Is lhs less than rhs?  Note that priority_queue is a max heap by default so we invert
         // the return from the expected value.
@@ -102,8 +111,16 @@ private:
         WorkingSet* _ws;
         BSONObj _pattern;
         const CollatorInterface* _collator;
+        // Whether to compare the precomputed StageWithValue::sortKey rather than the fields of
+        // the working set members.
+        bool _useSortKeys;
     };
 
+    /**
+     * Builds the normalized sort key of 'member' for StageWithValue::sortKey.
+     */
+    std::string makeSortKey(const WorkingSetMember& member) const;
+
     // Not owned by us.
     const Collection* _collection;
 
@@ -120,8 +137,12 @@ private:
     // Are we deduplicating on RecordId?
     const bool _dedup;
 
+    // Whether results are compared by normalized sort keys, and the Ordering used to build them.
+    const bool _useSortKeys;
+    const Ordering _ordering;
+
     // Which RecordIds have we seen?
-    stdx::unordered_set<RecordId, RecordId::Hasher> _seen;
+    RecordIdBitmap _seen;
 
     // In order to pick the next smallest value, we need each child work(...) until it produces
     // a result.  This is the queue of children that haven't given us a result yet.
@@ -45,6 +45,7 @@
 #include "mongo/db/query/explain.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/plan_ranker.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
@@ -205,6 +206,11 @@ Status MultiPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
     size_t numWorks = getTrialPeriodWorks(getOpCtx(), _collection);
     size_t numResults = getTrialPeriodNumToReturn(*_query);
 
+    // If enabled, the trial period may also end early once a single plan is the only one making
+    // progress. This bounds the cost of plan cache misses when there are many candidate indexes.
+    const size_t earlyExitWorks =
+        static_cast<size_t>(std::max(0, internalQueryPlanEvaluationEarlyExitWorks.load()));
+
     // Work the plans, stopping when a plan hits EOF or returns some
     // fixed number of results.
     for (size_t ix = 0; ix < numWorks; ++ix) {
@@ -212,6 +218,12 @@ Status MultiPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
         if (!moreToDo) {
             break;
         }
+
+        if (earlyExitWorks && ix + 1 >= earlyExitWorks && onlyOneCandidateProductive()) {
+            LOG(2) << "Ending plan trial period after " << (ix + 1)
+                   << " works; only one candidate plan has produced results";
+            break;
+        }
     }
 
     if (_failure) {
@@ -335,17 +347,18 @@ Status MultiPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
 bool MultiPlanStage::workAllPlans(size_t numResults, PlanYieldPolicy* yieldPolicy) {
     bool doneWorking = false;
 
+    // Might need to yield between rounds of work due to the timer elapsing. Checking once per
+    // round rather than before every candidate keeps the overhead flat as candidates are added.
+    if (!(tryYield(yieldPolicy)).isOK()) {
+        return false;
+    }
+
     for (size_t ix = 0; ix < _candidates.size(); ++ix) {
         CandidatePlan& candidate = _candidates[ix];
         if (candidate.failed) {
             continue;
         }
 
-        // Might need to yield between calls to work due to the timer elapsing.
-        if (!(tryYield(yieldPolicy)).isOK()) {
-            return false;
-        }
-
         WorkingSetID id = WorkingSet::INVALID_ID;
         PlanStage::StageState state = candidate.root->work(&id);
 
@@ -400,6 +413,16 @@ bool MultiPlanStage::workAllPlans(size_t numResults, PlanYieldPolicy* yieldPolic
     return !doneWorking;
 }
 
+bool MultiPlanStage::onlyOneCandidateProductive() const {
+    size_t numProductive = 0;
+    for (auto&& candidate : _candidates) {
+        if (!candidate.failed && !candidate.results.empty()) {
+            ++numProductive;
+        }
+    }
+    return 1U == numProductive && _candidates.size() - _failureCount > 1U;
+}
+
 bool MultiPlanStage::hasBackupPlan() const {
     return kNoSuchPlan != _backupPlanIdx;
 }
@@ -166,6 +166,13 @@ private:
      */
     bool workAllPlans(size_t numResults, PlanYieldPolicy* yieldPolicy);
 
+    /**
+     * Returns true if exactly one candidate plan has produced results so far. Once every
+     * candidate has had a reasonable number of work() calls, such a plan is the clear winner and
+     * the remaining trial period can be skipped.
+     */
+    bool onlyOneCandidateProductive() const;
+
     /**
      * Checks whether we need to perform either a timing-based yield or a yield for a document
      * fetch. If so, then uses 'yieldPolicy' to actually perform the yield.
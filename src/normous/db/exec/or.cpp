@@ -75,15 +75,12 @@ PlanStage::StageState OrStage::doWork(WorkingSetID* out) {
         if (_dedup && member->hasRecordId()) {
             ++_specificStats.dupsTested;
 
-            // ...and we've seen the RecordId before
-            if (_seen.end() != _seen.find(member->recordId)) {
+            // ...and we've seen the RecordId before (otherwise this notes that we've seen it)
+            if (!_seen.insert(member->recordId)) {
                 // ...drop it.
                 ++_specificStats.dupsDropped;
                 _ws->free(id);
                 return PlanStage::NEED_TIME;
-            } else {
-                // Otherwise, note that we've seen it.
-                _seen.insert(member->recordId);
             }
         }
 
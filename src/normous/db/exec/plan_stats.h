@@ -37,6 +37,7 @@
 #include "mongo/db/index/multikey_paths.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/query/stage_types.h"
+#include "mongo/db/record_id.h"
 #include "mongo/util/time_support.h"
 
 namespace mongo {
@@ -51,6 +52,11 @@ struct SpecificStats {
      * Make a deep copy.
      */
     virtual SpecificStats* clone() const = 0;
+
+    /**
+     * Returns an estimate of the memory used by this object, including the heap memory it owns.
+     */
+    virtual uint64_t estimateObjectSizeInBytes() const = 0;
 };
 
 // Every stage has CommonStats.
@@ -119,6 +125,21 @@ struct PlanStageStats {
         return stats;
     }
 
+    /**
+     * Returns an estimate of the memory used by this tree of stats, including its children.
+     */
+    uint64_t estimateObjectSizeInBytes() const {
+        uint64_t size = sizeof(*this) + common.filter.objsize() +
+            children.capacity() * sizeof(std::unique_ptr<PlanStageStats>);
+        if (specific) {
+            size += specific->estimateObjectSizeInBytes();
+        }
+        for (auto&& child : children) {
+            size += child->estimateObjectSizeInBytes();
+        }
+        return size;
+    }
+
     // See query/stage_type.h
     StageType stageType;
 
@@ -143,6 +164,10 @@ struct AndHashStats : public SpecificStats {
         return specific;
     }
 
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this) + mapAfterChild.capacity() * sizeof(size_t);
+    }
+
     // How many entries are in the map after each child?
     // child 'i' produced children[i].common.advanced RecordIds, of which mapAfterChild[i] were
     // intersections.
@@ -156,6 +181,16 @@ struct AndHashStats : public SpecificStats {
 
     // What's our memory limit?
     size_t memLimit = 0u;
+
+    // The size of the Bloom filter most recently built over the hash table, or zero if the table
+    // was never large enough for one.
+    size_t bloomFilterBits = 0u;
+
+    // How many RecordIds were checked against the Bloom filter, how many of those it ruled out
+    // without a hash table lookup, and how many it let through that were not in the table.
+    size_t bloomFilterProbes = 0u;
+    size_t bloomFilterRejected = 0u;
+    size_t bloomFilterFalsePositives = 0u;
 };
 
 struct AndSortedStats : public SpecificStats {
@@ -166,6 +201,10 @@ struct AndSortedStats : public SpecificStats {
         return specific;
     }
 
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this) + failedAnd.capacity() * sizeof(size_t);
+    }
+
     // How many results from each child did not pass the AND?
     std::vector<size_t> failedAnd;
 };
@@ -177,6 +216,10 @@ struct CachedPlanStats : public SpecificStats {
         return new CachedPlanStats(*this);
     }
 
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this);
+    }
+
     bool replanned;
 };
 
@@ -188,6 +231,10 @@ struct CollectionScanStats : public SpecificStats {
         return specific;
     }
 
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this);
+    }
+
     // How many documents did we check against our filter?
     size_t docsTested;
 
@@ -199,6 +246,40 @@ struct CollectionScanStats : public SpecificStats {
     // sees a document that does not pass the filter and has a "ts" Timestamp field greater than
     // 'maxTs'.
     boost::optional<Timestamp> maxTs;
+
+    // The bounds on the RecordIds of the records the scan returns, if any.
+    boost::optional<RecordId> minRecord;
+    boost::optional<RecordId> maxRecord;
+};
+
+struct ColumnScanStats : public SpecificStats {
+    SpecificStats* clone() const final {
+        ColumnScanStats* specific = new ColumnScanStats(*this);
+        // BSON objects have to be explicitly copied.
+        specific->keyPattern = keyPattern.getOwned();
+        return specific;
+    }
+
+    uint64_t estimateObjectSizeInBytes() const final {
+        uint64_t size = sizeof(*this) + indexName.capacity() + keyPattern.objsize();
+        for (auto&& field : fields) {
+            size += sizeof(field) + field.capacity();
+        }
+        return size;
+    }
+
+    std::string indexName;
+
+    BSONObj keyPattern;
+
+    // The columns read, besides the _id column which every row is read from.
+    std::vector<std::string> fields;
+
+    // The number of index keys read across all of the columns.
+    size_t keysExamined = 0;
+
+    // The number of rows checked against the filter.
+    size_t rowsTested = 0;
 };
 
 struct CountStats : public SpecificStats {
@@ -209,6 +290,10 @@ struct CountStats : public SpecificStats {
         return specific;
     }
 
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this);
+    }
+
     // The result of the count.
     long long nCounted;
 
@@ -238,6 +323,11 @@ struct CountScanStats : public SpecificStats {
         return specific;
     }
 
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this) + indexName.capacity() + keyPattern.objsize() + collation.objsize() +
+               startKey.objsize() + endKey.objsize();
+    }
+
     std::string indexName;
 
     BSONObj keyPattern;
@@ -266,6 +356,10 @@ struct CountScanStats : public SpecificStats {
     bool isUnique;
 
     size_t keysExamined;
+
+    // True if the count was taken from the index's cache of range counts rather than by walking
+    // the index.
+    bool countFromCache = false;
 };
 
 struct DeleteStats : public SpecificStats {
@@ -275,6 +369,10 @@ struct DeleteStats : public SpecificStats {
         return new DeleteStats(*this);
     }
 
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this);
+    }
+
     size_t docsDeleted = 0u;
 };
 
@@ -288,6 +386,11 @@ struct DistinctScanStats : public SpecificStats {
         return specific;
     }
 
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this) + keyPattern.objsize() + collation.objsize() + indexName.capacity() +
+               indexBounds.objsize();
+    }
+
     // How many keys did we look at while distinct-ing?
     size_t keysExamined = 0;
 
@@ -324,6 +427,10 @@ struct EnsureSortedStats : public SpecificStats {
         return specific;
     }
 
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this);
+    }
+
     // The number of out-of-order results that were dropped.
     long long nDropped;
 };
@@ -336,6 +443,10 @@ struct FetchStats : public SpecificStats {
         return specific;
     }
 
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this);
+    }
+
     // Have we seen anything that already had an object?
     size_t alreadyHasObj = 0u;
 
@@ -351,6 +462,10 @@ struct GroupStats : public SpecificStats {
         return specific;
     }
 
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this);
+    }
+
     // The total number of groups.
     size_t nGroups;
 };
@@ -363,6 +478,10 @@ struct IDHackStats : public SpecificStats {
         return specific;
     }
 
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this) + indexName.capacity();
+    }
+
     std::string indexName;
 
     // Number of entries retrieved from the index while executing the idhack.
@@ -370,6 +489,10 @@ struct IDHackStats : public SpecificStats {
 
     // Number of documents retrieved from the collection while executing the idhack.
     size_t docsExamined;
+
+    // True if the document was taken from the collection's cache of recently read documents
+    // rather than looked up in the index and the record store.
+    bool docFromCache = false;
 };
 
 struct IndexScanStats : public SpecificStats {
@@ -394,6 +517,11 @@ struct IndexScanStats : public SpecificStats {
         return specific;
     }
 
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this) + indexType.capacity() + indexName.capacity() + keyPattern.objsize() +
+               collation.objsize() + indexBounds.objsize();
+    }
+
     // Index type being used.
     std::string indexType;
 
@@ -443,6 +571,10 @@ struct LimitStats : public SpecificStats {
         return specific;
     }
 
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this);
+    }
+
     size_t limit;
 };
 
@@ -452,6 +584,10 @@ struct MockStats : public SpecificStats {
     SpecificStats* clone() const final {
         return new MockStats(*this);
     }
+
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this);
+    }
 };
 
 struct MultiPlanStats : public SpecificStats {
@@ -460,6 +596,38 @@ struct MultiPlanStats : public SpecificStats {
     SpecificStats* clone() const final {
         return new MultiPlanStats(*this);
     }
+
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this);
+    }
+};
+
+// How the SubplanStage arrived at the winning plan for one branch of a rooted $or.
+struct SubplanBranchStats {
+    // One of "cache", "singleSolution", "multiPlanner" or "reusedBranch".
+    std::string planSource;
+    // Number of candidate plans the planner generated for the branch. Zero if the branch was
+    // planned from the plan cache.
+    size_t numCandidates = 0;
+    // Time spent canonicalizing, enumerating and ranking plans for the branch.
+    long long planningTimeMicros = 0;
+};
+
+struct SubplanStats : public SpecificStats {
+    SubplanStats() = default;
+
+    SpecificStats* clone() const final {
+        return new SubplanStats(*this);
+    }
+
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this) + branchStats.capacity() * sizeof(SubplanBranchStats);
+    }
+
+    std::vector<SubplanBranchStats> branchStats;
+    // Number of branches whose winner was taken from an earlier branch of the same shape rather
+    // than by running a separate plan ranking trial.
+    size_t branchesReused = 0u;
 };
 
 struct OrStats : public SpecificStats {
@@ -470,6 +638,10 @@ struct OrStats : public SpecificStats {
         return specific;
     }
 
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this);
+    }
+
     size_t dupsTested = 0u;
     size_t dupsDropped = 0u;
 };
@@ -482,6 +654,10 @@ struct ProjectionStats : public SpecificStats {
         return specific;
     }
 
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this) + projObj.objsize();
+    }
+
     // Object specifying the projection transformation to apply.
     BSONObj projObj;
 };
@@ -494,6 +670,10 @@ struct SortStats : public SpecificStats {
         return specific;
     }
 
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this) + sortPattern.objsize();
+    }
+
     // What's our current memory usage?
     size_t memUsage = 0u;
 
@@ -515,6 +695,10 @@ struct MergeSortStats : public SpecificStats {
         return specific;
     }
 
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this) + sortPattern.objsize();
+    }
+
     size_t dupsTested = 0u;
     size_t dupsDropped = 0u;
 
@@ -530,6 +714,10 @@ struct ShardingFilterStats : public SpecificStats {
         return specific;
     }
 
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this);
+    }
+
     size_t chunkSkips;
 };
 
@@ -541,6 +729,10 @@ struct SkipStats : public SpecificStats {
         return specific;
     }
 
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this);
+    }
+
     size_t skip;
 };
 
@@ -565,6 +757,11 @@ struct NearStats : public SpecificStats {
         return new NearStats(*this);
     }
 
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this) + intervalStats.capacity() * sizeof(IntervalStats) +
+               indexName.capacity() + keyPattern.objsize();
+    }
+
     std::vector<IntervalStats> intervalStats;
     std::string indexName;
     // btree index version, not geo index version
@@ -584,6 +781,10 @@ struct UpdateStats : public SpecificStats {
         return new UpdateStats(*this);
     }
 
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this) + objInserted.objsize();
+    }
+
     // The number of documents which match the query part of the update.
     size_t nMatched;
 
@@ -613,6 +814,11 @@ struct TextStats : public SpecificStats {
         return specific;
     }
 
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this) + indexName.capacity() + parsedTextQuery.objsize() +
+               indexPrefix.objsize();
+    }
+
     std::string indexName;
 
     // Human-readable form of the FTSQuery associated with the text stage.
@@ -632,6 +838,10 @@ struct TextMatchStats : public SpecificStats {
         return specific;
     }
 
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this);
+    }
+
     size_t docsRejected;
 };
 
@@ -643,7 +853,17 @@ struct TextOrStats : public SpecificStats {
         return specific;
     }
 
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this);
+    }
+
     size_t fetches;
+
+    // The number of results requested in top-k mode, or zero if all results were requested.
+    size_t topK = 0;
+
+    // Whether top-k mode stopped reading before its children reached EOF.
+    bool stoppedEarly = false;
 };
 
 }  // namespace mongo
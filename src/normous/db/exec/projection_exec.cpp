@@ -264,7 +264,9 @@ Status ProjectionExec::transform(WorkingSetMember* member) const {
         return Status::OK();
     }
 
-    BSONObjBuilder bob;
+    // Projections of successive documents tend to have similar sizes, so start from the size of the
+    // previous result rather than growing a default-sized buffer each time.
+    BSONObjBuilder bob(_lastResultSize + kResultSizeSlack);
     if (member->hasObj()) {
         MatchDetails matchDetails;
 
@@ -368,6 +370,7 @@ Status ProjectionExec::transform(WorkingSetMember* member) const {
     }
 
     BSONObj newObj = bob.obj();
+    _lastResultSize = newObj.objsize();
     member->obj = Snapshotted<BSONObj>(SnapshotId(), newObj);
     member->keyData.clear();
     member->recordId = RecordId();
@@ -394,7 +397,8 @@ Status ProjectionExec::transform(const BSONObj& in,
         }
 
         // Case 2: no array projection for this field.
-        Matchers::const_iterator matcher = _matchers.find(elt.fieldName());
+        Matchers::const_iterator matcher =
+            _matchers.empty() ? _matchers.end() : _matchers.find(elt.fieldNameStringData());
         if (_matchers.end() == matcher) {
             Status s = append(bob, elt, details, arrayOpType);
             if (!s.isOK()) {
@@ -468,18 +472,15 @@ void ProjectionExec::appendArray(BSONObjBuilder* bob, const BSONObj& array, bool
 
         switch (elt.type()) {
             case Array: {
-                BSONObjBuilder subBob;
+                BSONObjBuilder subBob(bob->subarrayStart(bob->numStr(index++)));
                 appendArray(&subBob, elt.embeddedObject(), true);
-                bob->appendArray(bob->numStr(index++), subBob.obj());
                 break;
             }
             case Object: {
-                BSONObjBuilder subBob;
-                BSONObjIterator jt(elt.embeddedObject());
-                while (jt.more()) {
-                    append(&subBob, jt.next()).transitional_ignore();
+                BSONObjBuilder subBob(bob->subobjStart(bob->numStr(index++)));
+                for (auto&& subElt : elt.embeddedObject()) {
+                    append(&subBob, subElt).transitional_ignore();
                 }
-                bob->append(bob->numStr(index++), subBob.obj());
                 break;
             }
             default:
@@ -494,14 +495,16 @@ Status ProjectionExec::append(BSONObjBuilder* bob,
                               const BSONElement& elt,
                               const MatchDetails* details,
                               const ArrayOpType arrayOpType) const {
+    const StringData fieldName = elt.fieldNameStringData();
+
     // Skip if the field name matches a computed $meta field.
     // $meta projection fields can exist at the top level of
     // the result document and the field names cannot be dotted.
-    if (_meta.find(elt.fieldName()) != _meta.end()) {
+    if (!_meta.empty() && _meta.find(fieldName) != _meta.end()) {
         return Status::OK();
     }
 
-    FieldMap::const_iterator field = _fields.find(elt.fieldName());
+    FieldMap::const_iterator field = _fields.empty() ? _fields.end() : _fields.find(fieldName);
     if (field == _fields.end()) {
         if (_include) {
             bob->append(elt);
@@ -517,15 +520,13 @@ Status ProjectionExec::append(BSONObjBuilder* bob,
             bob->append(elt);
         }
     } else if (elt.type() == Object) {
-        BSONObjBuilder subBob;
-        BSONObjIterator it(elt.embeddedObject());
-        while (it.more()) {
-            subfm.append(&subBob, it.next(), details, arrayOpType).transitional_ignore();
+        // Sub-objects are built in place in the parent's buffer rather than copied into it.
+        BSONObjBuilder subBob(bob->subobjStart(fieldName));
+        for (auto&& subElt : elt.embeddedObject()) {
+            subfm.append(&subBob, subElt, details, arrayOpType).transitional_ignore();
         }
-        bob->append(elt.fieldName(), subBob.obj());
     } else {
         // Array
-        BSONObjBuilder matchedBuilder;
         if (details && arrayOpType == ARRAY_OP_POSITIONAL) {
             // $ positional operator specified
             if (!details->hasElemMatchKey()) {
@@ -536,17 +537,19 @@ Status ProjectionExec::append(BSONObjBuilder* bob,
                 return Status(ErrorCodes::BadValue, error);
             }
 
-            if (elt.embeddedObject()[details->elemMatchKey()].eoo()) {
+            BSONElement matched = elt.embeddedObject()[details->elemMatchKey()];
+            if (matched.eoo()) {
                 return Status(ErrorCodes::BadValue, "positional operator element mismatch");
             }
 
             // append as the first and only element in the projected array
-            matchedBuilder.appendAs(elt.embeddedObject()[details->elemMatchKey()], "0");
+            BSONArrayBuilder matchedBuilder(bob->subarrayStart(fieldName));
+            matchedBuilder.append(matched);
         } else {
             // append exact array; no subarray matcher specified
+            BSONObjBuilder matchedBuilder(bob->subarrayStart(fieldName));
             subfm.appendArray(&matchedBuilder, elt.embeddedObject());
         }
-        bob->appendArray(elt.fieldName(), matchedBuilder.obj());
     }
 
     return Status::OK();
@@ -184,6 +184,13 @@ private:
     // that perform matching (e.g. elemMatch projection). If null, the collation is a simple binary
     // compare.
     const CollatorInterface* _collator = nullptr;
+
+    // Extra room given to the result buffer beyond the size of the previous result.
+    static constexpr int kResultSizeSlack = 64;
+
+    // The size of the last document this projection produced, used to size the buffer for the
+    // next one.
+    mutable int _lastResultSize = 0;
 };
 
 }  // namespace mongo
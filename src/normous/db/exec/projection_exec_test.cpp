@@ -284,6 +284,46 @@ TEST(ProjectionExecTest, TransformNonCoveredDottedProjection) {
                   "{b: {c: 2, d: 3, f: {g: 4, h: 5}}}");
 }
 
+TEST(ProjectionExecTest, TransformDottedProjectionThroughArrays) {
+    testTransform("{'a.b': 1, 'a.c.d': 1, e: 1}",
+                  "{}",
+                  "{a: [{b: 1, x: 1}, {c: [{d: 2, y: 2}, 3]}, 4, [{b: 5}]], e: {f: 6}, g: 7}",
+                  true,
+                  "{a: [{b: 1}, {c: [{d: 2}]}, [{b: 5}]], e: {f: 6}}");
+    testTransform("{'a.b': 1}", "{}", "{a: {x: 1}}", true, "{a: {}}");
+}
+
+TEST(ProjectionExecTest, TransformNestedSliceAndPositional) {
+    testTransform("{'a.b': {$slice: -1}, 'a.c': 1}",
+                  "{}",
+                  "{a: {b: [1, 2, 3], c: 4, d: 5}}",
+                  true,
+                  "{a: {b: [3], c: 4}}");
+    testTransform("{'a.b': 1, 'c.$': 1}",
+                  "{c: 20}",
+                  "{a: {b: 1, x: 2}, c: [10, 20, 30]}",
+                  true,
+                  "{a: {b: 1}, c: [20]}");
+}
+
+TEST(ProjectionExecTest, TransformDocumentsOfDifferentSizes) {
+    QueryTestServiceContext serviceCtx;
+    auto opCtx = serviceCtx.makeOperationContext();
+    ProjectionExec exec(opCtx.get(), fromjson("{'a.b': 1}"), nullptr, nullptr);
+
+    // Each result is built in a buffer sized after the previous one.
+    const std::string large(1000, 'x');
+    for (auto&& input : {BSON("a" << BSON("b" << large)),
+                         BSON("a" << BSON("b" << 1)),
+                         BSON("a" << BSON("b" << large << "c" << 2))}) {
+        WorkingSetMember wsm;
+        wsm.obj = Snapshotted<BSONObj>(SnapshotId(), input);
+        wsm.transitionToOwnedObj();
+        ASSERT_OK(exec.transform(&wsm));
+        ASSERT_BSONOBJ_EQ(BSON("a" << BSON("b" << input["a"]["b"])), wsm.obj.value());
+    }
+}
+
 //
 // $meta
 // $meta projections add computed values to the projected object.
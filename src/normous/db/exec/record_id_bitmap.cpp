@@ -0,0 +1,121 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/record_id_bitmap.h"
+
+#include <algorithm>
+
+namespace mongo {
+
+bool RecordIdBitmap::Container::insert(uint16_t low) {
+    if (!_bitmap.empty()) {
+        uint64_t& word = _bitmap[low / 64];
+        const uint64_t bit = uint64_t(1) << (low % 64);
+        if (word & bit) {
+            return false;
+        }
+        word |= bit;
+        return true;
+    }
+
+    auto it = std::lower_bound(_array.begin(), _array.end(), low);
+    if (it != _array.end() && *it == low) {
+        return false;
+    }
+    if (_array.size() < kMaxArraySize) {
+        _array.insert(it, low);
+        return true;
+    }
+
+    _convertToBitmap();
+    return insert(low);
+}
+
+bool RecordIdBitmap::Container::contains(uint16_t low) const {
+    if (!_bitmap.empty()) {
+        return _bitmap[low / 64] & (uint64_t(1) << (low % 64));
+    }
+    return std::binary_search(_array.begin(), _array.end(), low);
+}
+
+void RecordIdBitmap::Container::_convertToBitmap() {
+    _bitmap.assign(kBitmapWords, 0);
+    for (uint16_t low : _array) {
+        _bitmap[low / 64] |= uint64_t(1) << (low % 64);
+    }
+    std::vector<uint16_t>().swap(_array);
+}
+
+const RecordIdBitmap::Container* RecordIdBitmap::_findContainer(uint64_t high) const {
+    if (_lastContainer && _lastHigh == high) {
+        return _lastContainer;
+    }
+    auto it = _containers.find(high);
+    if (it == _containers.end()) {
+        return nullptr;
+    }
+    _lastContainer = &it->second;
+    _lastHigh = high;
+    return _lastContainer;
+}
+
+bool RecordIdBitmap::insert(const RecordId& rid) {
+    const uint64_t high = _highBits(rid);
+    auto container = const_cast<Container*>(_findContainer(high));
+    if (!container) {
+        container = &_containers[high];
+        _lastContainer = container;
+        _lastHigh = high;
+        _memUsage += kPerContainerOverhead;
+    }
+
+    const size_t memUsageBefore = container->getMemUsage();
+    if (!container->insert(_lowBits(rid))) {
+        return false;
+    }
+    _memUsage += container->getMemUsage();
+    _memUsage -= memUsageBefore;
+    ++_size;
+    return true;
+}
+
+bool RecordIdBitmap::contains(const RecordId& rid) const {
+    const Container* container = _findContainer(_highBits(rid));
+    return container && container->contains(_lowBits(rid));
+}
+
+void RecordIdBitmap::clear() {
+    ContainerMap().swap(_containers);
+    _lastContainer = nullptr;
+    _size = 0;
+    _memUsage = 0;
+}
+
+}  // namespace mongo
@@ -0,0 +1,133 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "mongo/db/record_id.h"
+#include "mongo/stdx/unordered_map.h"
+
+namespace mongo {
+
+/**
+ * A set of RecordIds used by stages which drop RecordIds they have already produced. It splits
+ * each RecordId into its high 48 bits, which select a container, and its low 16 bits, which are
+ * stored in that container. A container starts as a sorted array of the low bits and turns into a
+ * 65536-bit bitmap once the array would be bigger than the bitmap, so that a run of dense RecordIds
+ * costs about one bit each rather than the several dozen bytes of a hash set node.
+ *
+ * Scans usually produce RecordIds which are close to each other, so the most recently used
+ * container is remembered and looked up without hashing.
+ */
+class RecordIdBitmap {
+public:
+    RecordIdBitmap() = default;
+
+    RecordIdBitmap(const RecordIdBitmap&) = delete;
+    RecordIdBitmap& operator=(const RecordIdBitmap&) = delete;
+
+    /**
+     * Adds 'rid' to the set. Returns true if it was not already present.
+     */
+    bool insert(const RecordId& rid);
+
+    bool contains(const RecordId& rid) const;
+
+    /**
+     * Removes all RecordIds and releases the memory held by the set.
+     */
+    void clear();
+
+    size_t size() const {
+        return _size;
+    }
+
+    bool empty() const {
+        return _size == 0;
+    }
+
+    /**
+     * Returns an estimate, in bytes, of the memory held by the set.
+     */
+    size_t getMemUsage() const {
+        return _memUsage;
+    }
+
+private:
+    class Container {
+    public:
+        // Beyond this many entries the sorted array would take more memory than the bitmap.
+        static constexpr size_t kMaxArraySize = 4096;
+        static constexpr size_t kBitmapWords = (1 << 16) / 64;
+
+        bool insert(uint16_t low);
+        bool contains(uint16_t low) const;
+
+        size_t getMemUsage() const {
+            return _array.capacity() * sizeof(uint16_t) + _bitmap.capacity() * sizeof(uint64_t);
+        }
+
+    private:
+        void _convertToBitmap();
+
+        // Sorted low bits, used until the container turns into a bitmap.
+        std::vector<uint16_t> _array;
+
+        // Empty until more than kMaxArraySize entries have been inserted.
+        std::vector<uint64_t> _bitmap;
+    };
+
+    using ContainerMap = stdx::unordered_map<uint64_t, Container>;
+
+    // Rough per-container cost of a node of '_containers', beyond the container's own buffers.
+    static constexpr size_t kPerContainerOverhead = sizeof(ContainerMap::value_type) + 32;
+
+    static uint64_t _highBits(const RecordId& rid) {
+        return static_cast<uint64_t>(rid.repr()) >> 16;
+    }
+
+    static uint16_t _lowBits(const RecordId& rid) {
+        return static_cast<uint16_t>(static_cast<uint64_t>(rid.repr()) & 0xffff);
+    }
+
+    const Container* _findContainer(uint64_t high) const;
+
+    ContainerMap _containers;
+
+    // The container which was used last, or null. Nodes of '_containers' never move, so this
+    // stays valid until the container is erased.
+    mutable const Container* _lastContainer = nullptr;
+    mutable uint64_t _lastHigh = 0;
+
+    size_t _size = 0;
+    size_t _memUsage = 0;
+};
+
+}  // namespace mongo
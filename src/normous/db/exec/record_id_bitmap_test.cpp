@@ -0,0 +1,102 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/record_id_bitmap.h"
+
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(RecordIdBitmapTest, InsertReportsDuplicates) {
+    RecordIdBitmap set;
+    ASSERT_TRUE(set.empty());
+    ASSERT_TRUE(set.insert(RecordId(42)));
+    ASSERT_FALSE(set.insert(RecordId(42)));
+    ASSERT_TRUE(set.insert(RecordId(43)));
+    ASSERT_EQ(2U, set.size());
+    ASSERT_TRUE(set.contains(RecordId(42)));
+    ASSERT_TRUE(set.contains(RecordId(43)));
+    ASSERT_FALSE(set.contains(RecordId(44)));
+}
+
+TEST(RecordIdBitmapTest, SeparatesRecordIdsWithTheSameLowBits) {
+    RecordIdBitmap set;
+    const int64_t low = 7;
+    ASSERT_TRUE(set.insert(RecordId(low)));
+    ASSERT_TRUE(set.insert(RecordId((int64_t(1) << 16) + low)));
+    ASSERT_TRUE(set.insert(RecordId((int64_t(1) << 40) + low)));
+    ASSERT_TRUE(set.insert(RecordId(-low)));
+    ASSERT_TRUE(set.insert(RecordId::max()));
+    ASSERT_TRUE(set.insert(RecordId::min()));
+    ASSERT_EQ(6U, set.size());
+
+    ASSERT_TRUE(set.contains(RecordId((int64_t(1) << 40) + low)));
+    ASSERT_TRUE(set.contains(RecordId(-low)));
+    ASSERT_TRUE(set.contains(RecordId::min()));
+    ASSERT_FALSE(set.contains(RecordId((int64_t(1) << 32) + low)));
+}
+
+TEST(RecordIdBitmapTest, DenseRecordIdsUseABitmap) {
+    RecordIdBitmap set;
+    const int64_t numRecordIds = 1 << 16;
+
+    // Insert in an order which is not sorted, to exercise both the array and the bitmap.
+    for (int64_t i = 0; i < numRecordIds; ++i) {
+        ASSERT_TRUE(set.insert(RecordId((i * 7919) % numRecordIds)));
+    }
+    ASSERT_EQ(size_t(numRecordIds), set.size());
+    for (int64_t i = 0; i < numRecordIds; ++i) {
+        ASSERT_TRUE(set.contains(RecordId(i)));
+        ASSERT_FALSE(set.insert(RecordId(i)));
+    }
+    ASSERT_FALSE(set.contains(RecordId(numRecordIds)));
+
+    // One bitmap of 2^16 bits, plus the bookkeeping for its container.
+    ASSERT_GTE(set.getMemUsage(), size_t(numRecordIds / 8));
+    ASSERT_LT(set.getMemUsage(), size_t(numRecordIds / 8 + 1024));
+}
+
+TEST(RecordIdBitmapTest, ClearReleasesMemory) {
+    RecordIdBitmap set;
+    for (int64_t i = 0; i < 100; ++i) {
+        set.insert(RecordId(i << 20));
+    }
+    ASSERT_GT(set.getMemUsage(), 0U);
+
+    set.clear();
+    ASSERT_TRUE(set.empty());
+    ASSERT_EQ(0U, set.getMemUsage());
+    ASSERT_FALSE(set.contains(RecordId(0)));
+    ASSERT_TRUE(set.insert(RecordId(0)));
+}
+
+}  // namespace
+}  // namespace mongo
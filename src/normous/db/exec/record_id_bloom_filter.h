@@ -0,0 +1,122 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "mongo/db/record_id.h"
+
+namespace mongo {
+
+/**
+ * A fixed-size Bloom filter over RecordIds. mayContain() never returns false for a RecordId which
+ * was inserted, and returns true for one which was not with a probability of roughly 1% when the
+ * filter was sized for the number of RecordIds inserted into it.
+ *
+ * A default-constructed or cleared filter has no bits and must be reset() before use.
+ */
+class RecordIdBloomFilter {
+public:
+    static constexpr size_t kBitsPerEntry = 10;
+    static constexpr size_t kNumHashes = 7;
+
+    /**
+     * Discards the contents of the filter and sizes it to hold 'numEntries' RecordIds.
+     */
+    void reset(size_t numEntries) {
+        size_t numWords = 1;
+        while (numWords * 64 < numEntries * kBitsPerEntry) {
+            numWords *= 2;
+        }
+        _words.assign(numWords, 0);
+        _mask = numWords * 64 - 1;
+    }
+
+    /**
+     * Releases the memory held by the filter.
+     */
+    void clear() {
+        std::vector<uint64_t>().swap(_words);
+        _mask = 0;
+    }
+
+    bool isEmpty() const {
+        return _words.empty();
+    }
+
+    size_t numBits() const {
+        return _words.size() * 64;
+    }
+
+    void insert(const RecordId& rid) {
+        uint64_t h1, h2;
+        _hash(rid, &h1, &h2);
+        for (size_t i = 0; i < kNumHashes; ++i) {
+            const uint64_t bit = (h1 + i * h2) & _mask;
+            _words[bit / 64] |= uint64_t(1) << (bit % 64);
+        }
+    }
+
+    bool mayContain(const RecordId& rid) const {
+        uint64_t h1, h2;
+        _hash(rid, &h1, &h2);
+        for (size_t i = 0; i < kNumHashes; ++i) {
+            const uint64_t bit = (h1 + i * h2) & _mask;
+            if (!(_words[bit / 64] & (uint64_t(1) << (bit % 64)))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    /**
+     * Derives the two hashes combined to choose each probed bit. RecordIds are usually dense
+     * integers, so their bits are mixed thoroughly first.
+     */
+    static void _hash(const RecordId& rid, uint64_t* h1, uint64_t* h2) {
+        uint64_t h = static_cast<uint64_t>(rid.repr());
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        *h1 = h;
+        // The step must be independent of 'h1'. Making it odd means the probes visit distinct bits
+        // of the power-of-two sized table.
+        h = (h ^ (h >> 31)) * 0xbf58476d1ce4e5b9ULL;
+        *h2 = (h ^ (h >> 32)) | 1;
+    }
+
+    std::vector<uint64_t> _words;
+    uint64_t _mask = 0;
+};
+
+}  // namespace mongo
@@ -35,7 +35,7 @@
 #include "mongo/db/exec/filter.h"
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set_common.h"
-#include "mongo/s/shard_key_pattern.h"
+#include "mongo/s/chunk_manager.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/log.h"
 
@@ -55,6 +55,10 @@ ShardFilterStage::ShardFilterStage(OperationContext* opCtx,
                                    PlanStage* child)
     : PlanStage(kStageType, opCtx), _ws(ws), _metadata(std::move(metadata)) {
     _children.emplace_back(child);
+
+    if (_metadata->isSharded() && !_metadata->ownsAllChunks()) {
+        _shardKeyPattern.emplace(_metadata->getKeyPattern());
+    }
 }
 
 ShardFilterStage::~ShardFilterStage() {}
@@ -75,11 +79,10 @@ PlanStage::StageState ShardFilterStage::doWork(WorkingSetID* out) {
         // If we're sharded make sure that we don't return data that is not owned by us,
         // including pending documents from in-progress migrations and orphaned documents from
         // aborted migrations
-        if (_metadata->isSharded()) {
-            ShardKeyPattern shardKeyPattern(_metadata->getKeyPattern());
+        if (_shardKeyPattern) {
             WorkingSetMember* member = _ws->get(*out);
             WorkingSetMatchableDocument matchable(member);
-            BSONObj shardKey = shardKeyPattern.extractShardKeyFromMatchable(matchable);
+            BSONObj shardKey = _shardKeyPattern->extractShardKeyFromMatchable(matchable);
 
             if (shardKey.isEmpty()) {
                 // We can't find a shard key for this document - this should never happen with
@@ -105,7 +108,7 @@ PlanStage::StageState ShardFilterStage::doWork(WorkingSetID* out) {
                           << "document may have been inserted manually into shard";
             }
 
-            if (!_metadata->keyBelongsToMe(shardKey)) {
+            if (!_keyBelongsToMe(shardKey)) {
                 _ws->free(*out);
                 ++_specificStats.chunkSkips;
                 return PlanStage::NEED_TIME;
@@ -120,6 +123,21 @@ PlanStage::StageState ShardFilterStage::doWork(WorkingSetID* out) {
     return status;
 }
 
+bool ShardFilterStage::_keyBelongsToMe(const BSONObj& shardKey) {
+    if (shardKey.isEmpty()) {
+        return false;
+    }
+
+    if (_lastChunk && _lastChunk->containsKey(shardKey)) {
+        return _lastChunkBelongsToMe;
+    }
+
+    _lastChunk.emplace(
+        _metadata->getChunkManager()->findIntersectingChunkWithSimpleCollation(shardKey));
+    _lastChunkBelongsToMe = _lastChunk->getShardId() == _metadata->shardId();
+    return _lastChunkBelongsToMe;
+}
+
 unique_ptr<PlanStageStats> ShardFilterStage::getStats() {
     _commonStats.isEOF = isEOF();
     unique_ptr<PlanStageStats> ret =
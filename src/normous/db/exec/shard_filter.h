@@ -28,8 +28,12 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+
 #include "mongo/db/exec/plan_stage.h"
 #include "mongo/db/s/scoped_collection_metadata.h"
+#include "mongo/s/chunk.h"
+#include "mongo/s/shard_key_pattern.h"
 
 namespace mongo {
 
@@ -90,6 +94,13 @@ public:
     static const char* kStageType;
 
 private:
+    /**
+     * Returns true if the document with the given shard key belongs to this shard. Remembers the
+     * chunk of the last key looked up, so that ordered scans only search the routing table when
+     * they cross into another chunk.
+     */
+    bool _keyBelongsToMe(const BSONObj& shardKey);
+
     WorkingSet* _ws;
 
     // Stats
@@ -98,6 +109,15 @@ private:
     // Note: it is important that this is the metadata from the time this stage is constructed.
     // See class comment for details.
     ScopedCollectionMetadata _metadata;
+
+    // Shard key pattern of the collection, extracted once for all documents. Not set if every
+    // document belongs to this shard, either because the collection is unsharded or because this
+    // shard owns all of its chunks, in which case no filtering is needed.
+    boost::optional<ShardKeyPattern> _shardKeyPattern;
+
+    // The chunk which contained the last shard key looked up and whether it is owned by this shard.
+    boost::optional<Chunk> _lastChunk;
+    bool _lastChunkBelongsToMe{false};
 };
 
 }  // namespace mongo
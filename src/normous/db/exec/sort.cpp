@@ -41,6 +41,7 @@
 #include "mongo/db/query/find_common.h"
 #include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_planner.h"
+#include "mongo/db/storage/key_string.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/log.h"
 
@@ -54,19 +55,50 @@ using stdx::make_unique;
 // static
 const char* SortStage::kStageType = "SORT";
 
-SortStage::WorkingSetComparator::WorkingSetComparator(BSONObj p) : pattern(p) {}
+SortStage::WorkingSetComparator::WorkingSetComparator(BSONObj p)
+    : pattern(p),
+      useNormalizedKeys(static_cast<size_t>(p.nFields()) <= Ordering::kMaxCompoundIndexKeys),
+      ordering(Ordering::make(useNormalizedKeys ? p : BSONObj())) {}
 
 bool SortStage::WorkingSetComparator::operator()(const SortableDataItem& lhs,
                                                  const SortableDataItem& rhs) const {
+    if (!useNormalizedKeys) {
+        return lessBySortKey(lhs, rhs);
+    }
+    int result = lhs.normalizedKey.compare(rhs.normalizedKey);
+    if (0 != result) {
+        return result < 0;
+    }
+    // Indices use RecordId as an additional sort key so we must as well.
+    return lhs.recordId < rhs.recordId;
+}
+
+bool SortStage::WorkingSetComparator::lessBySortKey(const SortableDataItem& lhs,
+                                                    const SortableDataItem& rhs) const {
     // False means ignore field names.
     int result = lhs.sortKey.woCompare(rhs.sortKey, pattern, false);
     if (0 != result) {
         return result < 0;
     }
-    // Indices use RecordId as an additional sort key so we must as well.
     return lhs.recordId < rhs.recordId;
 }
 
+int SortStage::WorkingSetComparator::compareSortKeyPrefix(const BSONObj& lhs,
+                                                          const BSONObj& rhs,
+                                                          size_t numFields) const {
+    BSONObjIterator lhsIt(lhs);
+    BSONObjIterator rhsIt(rhs);
+    BSONObjIterator patternIt(pattern);
+    for (size_t i = 0; i < numFields && lhsIt.more() && rhsIt.more() && patternIt.more(); ++i) {
+        int result = lhsIt.next().woCompare(rhsIt.next(), false);
+        const bool descending = patternIt.next().number() < 0;
+        if (0 != result) {
+            return descending ? -result : result;
+        }
+    }
+    return 0;
+}
+
 SortStage::SortStage(OperationContext* opCtx,
                      const SortStageParams& params,
                      WorkingSet* ws,
@@ -76,6 +108,7 @@ SortStage::SortStage(OperationContext* opCtx,
       _ws(ws),
       _pattern(params.pattern),
       _limit(params.limit),
+      _orderedPrefixLength(params.orderedPrefixLength),
       _sorted(false),
       _resultIterator(_data.end()),
       _memUsage(0) {
@@ -83,21 +116,14 @@ SortStage::SortStage(OperationContext* opCtx,
 
     BSONObj sortComparator = FindCommon::transformSortSpec(_pattern);
     _sortKeyComparator = stdx::make_unique<WorkingSetComparator>(sortComparator);
-
-    // If limit > 1, we need to initialize _dataSet here to maintain ordered set of data items while
-    // fetching from the child stage.
-    if (_limit > 1) {
-        const WorkingSetComparator& cmp = *_sortKeyComparator;
-        _dataSet.reset(new SortableDataItemSet(cmp));
-    }
 }
 
 SortStage::~SortStage() {}
 
 bool SortStage::isEOF() {
-    // We're done when our child has no more results, we've sorted the child's results, and
-    // we've returned all sorted results.
-    return child()->isEOF() && _sorted && (_data.end() == _resultIterator);
+    // We're done when we've sorted the child's results and returned all of them. Sorting happens
+    // once the child is EOF, or once none of its remaining results could be returned.
+    return _sorted && (_data.end() == _resultIterator);
 }
 
 PlanStage::StageState SortStage::doWork(WorkingSetID* out) {
@@ -140,8 +166,15 @@ PlanStage::StageState SortStage::doWork(WorkingSetID* out) {
                 item.recordId = member->recordId;
             }
 
-            addToBuffer(item);
+            if (!addToBuffer(std::move(item))) {
+                return PlanStage::NEED_TIME;
+            }
 
+            // The child returns results in an order such that none of the rest could make the
+            // top '_limit', so there is no need to read them.
+            sortBuffer();
+            _resultIterator = _data.begin();
+            _sorted = true;
             return PlanStage::NEED_TIME;
         } else if (PlanStage::IS_EOF == code) {
             // TODO: We don't need the lock for this.  We could ask for a yield and do this work
@@ -199,96 +232,62 @@ const SpecificStats* SortStage::getSpecificStats() const {
  * limit == 0:
  *     addToBuffer() - Adds item to vector.
  *     sortBuffer() - Sorts vector.
- * limit == 1:
- *     addToBuffer() - Replaces first item in vector with max of
- *                     current and new item.
- *                     Updates memory usage if item was replaced.
- *     sortBuffer() - Does nothing.
- * limit > 1:
- *     addToBuffer() - Does not update vector. Adds item to set.
- *                     If size of set exceeds limit, remove item from set
- *                     with lowest key. Updates memory usage accordingly.
- *     sortBuffer() - Copies items from set to vectors.
+ * limit > 0:
+ *     addToBuffer() - Pushes item onto a max-heap of at most 'limit' items. Once the heap is
+ *                     full, an item displaces the top of the heap if it sorts before it, and is
+ *                     discarded otherwise. Updates memory usage accordingly.
+ *     sortBuffer() - Sorts the heap in place.
+ *
+ * Every buffered item carries its sort key encoded as a KeyString, so that comparisons between
+ * buffered items are plain byte comparisons. With a limit, an incoming item is first compared
+ * against the top of the heap using its BSON sort key, so items which are discarded straight away
+ * are never encoded.
  */
-void SortStage::addToBuffer(const SortableDataItem& item) {
-    // Holds ID of working set member to be freed at end of this function.
-    WorkingSetID wsidToFree = WorkingSet::INVALID_ID;
-
+bool SortStage::addToBuffer(SortableDataItem item) {
+    const WorkingSetComparator& cmp = *_sortKeyComparator;
     WorkingSetMember* member = _ws->get(item.wsid);
-    if (_limit == 0) {
-        // Ensure that the BSONObj underlying the WorkingSetMember is owned in case we yield.
-        member->makeObjOwnedIfNeeded();
-        _data.push_back(item);
-        _memUsage += member->getMemUsage();
-    } else if (_limit == 1) {
-        if (_data.empty()) {
-            member->makeObjOwnedIfNeeded();
-            _data.push_back(item);
-            _memUsage = member->getMemUsage();
-            return;
-        }
-        wsidToFree = item.wsid;
-        const WorkingSetComparator& cmp = *_sortKeyComparator;
-        // Compare new item with existing item in vector.
-        if (cmp(item, _data[0])) {
-            wsidToFree = _data[0].wsid;
-            member->makeObjOwnedIfNeeded();
-            _data[0] = item;
-            _memUsage = member->getMemUsage();
-        }
-    } else {
-        // Update data item set instead of vector
-        // Limit not reached - insert and return
-        vector<SortableDataItem>::size_type limit(_limit);
-        if (_dataSet->size() < limit) {
-            member->makeObjOwnedIfNeeded();
-            _dataSet->insert(item);
-            _memUsage += member->getMemUsage();
-            return;
-        }
-        // Limit will be exceeded - compare with item with lowest key
-        // If new item does not have a lower key value than last item,
-        // do nothing.
-        wsidToFree = item.wsid;
-        SortableDataItemSet::const_iterator lastItemIt = --(_dataSet->end());
-        const SortableDataItem& lastItem = *lastItemIt;
-        const WorkingSetComparator& cmp = *_sortKeyComparator;
-        if (cmp(item, lastItem)) {
-            _memUsage -= _ws->get(lastItem.wsid)->getMemUsage();
-            _memUsage += member->getMemUsage();
-            wsidToFree = lastItem.wsid;
-            // According to std::set iterator validity rules,
-            // it does not matter which of erase()/insert() happens first.
-            // Here, we choose to erase first to release potential resources
-            // used by the last item and to keep the scope of the iterator to a minimum.
-            _dataSet->erase(lastItemIt);
-            member->makeObjOwnedIfNeeded();
-            _dataSet->insert(item);
+
+    if (_limit > 0 && _data.size() >= _limit) {
+        const SortableDataItem& lastItem = _data.front();
+        if (!cmp.lessBySortKey(item, lastItem)) {
+            // Not in the top '_limit' so far. If the child's order shows that this item sorts
+            // after the current top '_limit' before we even reach its unordered suffix, so will
+            // every result still to come.
+            const bool noneRemainingCanEnter = _orderedPrefixLength > 0 &&
+                cmp.compareSortKeyPrefix(item.sortKey, lastItem.sortKey, _orderedPrefixLength) > 0;
+            _ws->free(item.wsid);
+            return noneRemainingCanEnter;
         }
+
+        // Evict the item with the highest key to make room.
+        _memUsage -= _ws->get(lastItem.wsid)->getMemUsage() + lastItem.normalizedKey.capacity();
+        _ws->free(lastItem.wsid);
+        std::pop_heap(_data.begin(), _data.end(), cmp);
+        _data.pop_back();
+    }
+
+    // Ensure that the BSONObj underlying the WorkingSetMember is owned in case we yield.
+    member->makeObjOwnedIfNeeded();
+
+    if (cmp.useNormalizedKeys) {
+        KeyString normalizedKey(KeyString::Version::V1, item.sortKey, cmp.ordering);
+        item.normalizedKey.assign(normalizedKey.getBuffer(), normalizedKey.getSize());
     }
+    _memUsage += member->getMemUsage() + item.normalizedKey.capacity();
 
-    // There was a buffered result which we can throw out because we are executing a sort with a
-    // limit, and the result is now known not to be in the top k set. Free the working set member
-    // associated with 'wsidToFree'.
-    if (wsidToFree != WorkingSet::INVALID_ID) {
-        _ws->free(wsidToFree);
+    _data.push_back(std::move(item));
+    if (_limit > 0) {
+        std::push_heap(_data.begin(), _data.end(), cmp);
     }
+    return false;
 }
 
 void SortStage::sortBuffer() {
+    const WorkingSetComparator& cmp = *_sortKeyComparator;
     if (_limit == 0) {
-        const WorkingSetComparator& cmp = *_sortKeyComparator;
         std::sort(_data.begin(), _data.end(), cmp);
-    } else if (_limit == 1) {
-        // Buffer contains either 0 or 1 item so it is already in a sorted state.
-        return;
     } else {
-        // Set already contains items in sorted order, so we simply copy the items
-        // from the set to the vector.
-        // Release the memory for the set after the copy.
-        vector<SortableDataItem> newData(_dataSet->begin(), _dataSet->end());
-        _data.swap(newData);
-        _dataSet.reset();
+        std::sort_heap(_data.begin(), _data.end(), cmp);
     }
 }
 
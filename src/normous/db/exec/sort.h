@@ -28,9 +28,10 @@
 
 #pragma once
 
-#include <set>
+#include <string>
 #include <vector>
 
+#include "mongo/bson/ordering.h"
 #include "mongo/db/exec/plan_stage.h"
 #include "mongo/db/exec/sort_key_generator.h"
 #include "mongo/db/exec/working_set.h"
@@ -46,7 +47,7 @@ class BtreeKeyGenerator;
 // Parameters that must be provided to a SortStage
 class SortStageParams {
 public:
-    SortStageParams() : collection(NULL), limit(0) {}
+    SortStageParams() : collection(NULL), limit(0), orderedPrefixLength(0) {}
 
     // Used for resolving RecordIds to BSON
     const Collection* collection;
@@ -56,6 +57,11 @@ public:
 
     // Equal to 0 for no limit.
     size_t limit;
+
+    // The number of leading fields of 'pattern' by which the child already returns its results in
+    // order. With a limit, this lets the sort stop reading its child once no later result can
+    // make the top 'limit'.
+    size_t orderedPrefixLength;
 };
 
 /**
@@ -104,6 +110,9 @@ private:
     // Equal to 0 for no limit.
     size_t _limit;
 
+    // See SortStageParams::orderedPrefixLength.
+    size_t _orderedPrefixLength;
+
     //
     // Data storage
     //
@@ -116,37 +125,58 @@ private:
     struct SortableDataItem {
         WorkingSetID wsid;
         BSONObj sortKey;
+        // 'sortKey' encoded as a KeyString, so that buffered items compare with memcmp(). Computed
+        // once the item is known to be buffered. See WorkingSetComparator::useNormalizedKeys.
+        std::string normalizedKey;
         // Since we must replicate the behavior of a covered sort as much as possible we use the
         // RecordId to break sortKey ties.
         // See sorta.js.
         RecordId recordId;
     };
 
-    // Comparison object for data buffers (vector and set). Items are compared on (sortKey, loc).
-    // This is also how the items are ordered in the indices. Keys are compared using
-    // BSONObj::woCompare() with RecordId as a tie-breaker.
+    // Comparison object for the data buffer. Items are compared on (sortKey, loc). This is also
+    // how the items are ordered in the indices.
     //
     // We are comparing keys generated by the SortKeyGenerator, which are already ordered with
     // respect the collation. Therefore, we explicitly avoid comparing using a collator here.
     struct WorkingSetComparator {
         explicit WorkingSetComparator(BSONObj p);
 
+        /**
+         * Compares buffered items by their normalized keys, with RecordId as a tie-breaker.
+         */
         bool operator()(const SortableDataItem& lhs, const SortableDataItem& rhs) const;
 
+        /**
+         * Orders items the same way as operator(), but by their BSON sort keys using
+         * BSONObj::woCompare(). Used for items which have no normalized key yet.
+         */
+        bool lessBySortKey(const SortableDataItem& lhs, const SortableDataItem& rhs) const;
+
+        /**
+         * Compares the first 'numFields' fields of two sort keys, returning a value less than,
+         * equal to or greater than zero as 'lhs' sorts before, with or after 'rhs'.
+         */
+        int compareSortKeyPrefix(const BSONObj& lhs, const BSONObj& rhs, size_t numFields) const;
+
         BSONObj pattern;
+
+        // Sort patterns with more fields than an Ordering can describe are compared as BSON, and
+        // items are buffered without a normalized key.
+        bool useNormalizedKeys;
+        Ordering ordering;
     };
 
     /**
-     * Inserts one item into data buffer (vector or set).
-     * If limit is exceeded, remove item with lowest key.
+     * Inserts one item into the data buffer. If limit is exceeded, removes the item with the
+     * highest key. Returns true if the child is ordered such that none of its remaining results
+     * could enter the buffer.
      */
-    void addToBuffer(const SortableDataItem& item);
+    bool addToBuffer(SortableDataItem item);
 
     /**
      * Sorts data buffer.
      * Assumes no more items will be added to buffer.
-     * If data is stored in set, copy set
-     * contents to vector and clear set.
      */
     void sortBuffer();
 
@@ -154,16 +184,10 @@ private:
     // Initialization follows sort key generator
     std::unique_ptr<WorkingSetComparator> _sortKeyComparator;
 
-    // The data we buffer and sort.
-    // _data will contain sorted data when all data is gathered
-    // and sorted.
-    // When _limit is greater than 1 and not all data has been gathered from child stage,
-    // _dataSet is used instead to maintain an ordered set of the incomplete data set.
-    // When the data set is complete, we copy the items from _dataSet to _data which will
-    // be used to provide the results of this stage through _resultIterator.
+    // The data we buffer and sort. Without a limit, items are appended and then sorted once all
+    // data is gathered. With a limit, _data is a max-heap of at most '_limit' items, so that the
+    // item with the highest key is at the front and is the one evicted by a better item.
     std::vector<SortableDataItem> _data;
-    typedef std::set<SortableDataItem, WorkingSetComparator> SortableDataItemSet;
-    std::unique_ptr<SortableDataItemSet> _dataSet;
 
     // Iterates through _data post-sort returning it.
     std::vector<SortableDataItem>::iterator _resultIterator;
@@ -289,4 +289,62 @@ TEST_F(SortStageTest, SortDescendingWithCollation) {
              "{input: [{a: 'ba'}, {a: 'aa'}, {a: 'ab'}]}",
              "{output: [{a: 'ab'}, {a: 'ba'}, {a: 'aa'}]}");
 }
+
+//
+// Sorting with a limit keeps the top items in a heap ordered by normalized keys, which must order
+// mixed types exactly as BSON comparison does.
+//
+
+TEST_F(SortStageTest, SortMixedTypesWithLimit) {
+    testWork("{a: 1, b: -1}",
+             nullptr,
+             4,
+             "{input: [{a: 'x', b: 1}, {a: 2.5, b: 1}, {a: 2, b: 1}, {a: 2, b: 2}, "
+             "{a: null, b: 1}, {b: 3}, {a: {c: 1}, b: 1}, {a: NumberLong(1), b: 1}]}",
+             "{output: [{b: 3}, {a: null, b: 1}, {a: NumberLong(1), b: 1}, {a: 2, b: 2}]}");
+}
+
+TEST_F(SortStageTest, SortWithLimitStopsReadingChildOrderedOnPrefix) {
+    WorkingSet ws;
+    auto queuedDataStage = stdx::make_unique<QueuedDataStage>(getOpCtx(), &ws);
+    for (auto&& json : {"{a: 1, b: 3}",
+                        "{a: 1, b: 1}",
+                        "{a: 2, b: 2}",
+                        "{a: 2, b: 1}",
+                        "{a: 3, b: 0}",
+                        "{a: 4, b: 0}"}) {
+        WorkingSetID id = ws.allocate();
+        WorkingSetMember* wsm = ws.get(id);
+        wsm->obj = Snapshotted<BSONObj>(SnapshotId(), fromjson(json));
+        wsm->transitionToOwnedObj();
+        queuedDataStage->pushBack(id);
+    }
+    QueuedDataStage* queued = queuedDataStage.get();
+
+    // The input is ordered by 'a', the first field of the sort pattern.
+    SortStageParams params;
+    params.pattern = fromjson("{a: 1, b: 1}");
+    params.limit = 3;
+    params.orderedPrefixLength = 1;
+
+    auto sortKeyGen = stdx::make_unique<SortKeyGeneratorStage>(
+        getOpCtx(), queuedDataStage.release(), &ws, params.pattern, nullptr);
+    SortStage sort(getOpCtx(), params, &ws, sortKeyGen.release());
+
+    std::vector<BSONObj> results;
+    while (!sort.isEOF()) {
+        WorkingSetID id = WorkingSet::INVALID_ID;
+        if (PlanStage::ADVANCED == sort.work(&id)) {
+            results.push_back(ws.get(id)->obj.value());
+        }
+    }
+
+    ASSERT_EQ(results.size(), 3U);
+    ASSERT_BSONOBJ_EQ(results[0], fromjson("{a: 1, b: 1}"));
+    ASSERT_BSONOBJ_EQ(results[1], fromjson("{a: 1, b: 3}"));
+    ASSERT_BSONOBJ_EQ(results[2], fromjson("{a: 2, b: 1}"));
+
+    // {a: 3, b: 0} sorts after all of the top three on 'a' alone, so {a: 4, b: 0} is never read.
+    ASSERT_FALSE(queued->isEOF());
+}
 }  // namespace
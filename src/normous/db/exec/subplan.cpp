@@ -42,11 +42,13 @@
 #include "mongo/db/query/planner_access.h"
 #include "mongo/db/query/planner_analysis.h"
 #include "mongo/db/query/query_planner.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_planner_common.h"
 #include "mongo/db/query/stage_builder.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/log.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
 #include "mongo/util/transitional_tools_do_not_use/vector_spooling.h"
 
 namespace mongo {
@@ -114,10 +116,16 @@ Status SubplanStage::planSubqueries() {
         LOG(5) << "Subplanner: index " << i << " is " << ie;
     }
 
+    _specificStats.branchStats.clear();
+    _specificStats.branchStats.resize(_orExpression->numChildren());
+
     for (size_t i = 0; i < _orExpression->numChildren(); ++i) {
         // We need a place to shove the results from planning this branch.
         _branchResults.push_back(stdx::make_unique<BranchPlanningResult>());
         BranchPlanningResult* branchResult = _branchResults.back().get();
+        SubplanBranchStats* branchStats = &_specificStats.branchStats[i];
+        Timer branchTimer;
+        ON_BLOCK_EXIT([&] { branchStats->planningTimeMicros += branchTimer.micros(); });
 
         MatchExpression* orChild = _orExpression->getChild(i);
 
@@ -138,13 +146,14 @@ Status SubplanStage::planSubqueries() {
 
         // Populate branchResult->cachedSolution if an active cachedSolution entry exists.
         if (planCache->shouldCacheQuery(*branchResult->canonicalQuery)) {
-            auto planCacheKey = planCache->computeKey(*branchResult->canonicalQuery);
-            if (auto cachedSol = planCache->getCacheEntryIfActive(planCacheKey)) {
+            branchResult->planCacheKey = planCache->computeKey(*branchResult->canonicalQuery);
+            if (auto cachedSol = planCache->getCacheEntryIfActive(branchResult->planCacheKey)) {
                 // We have a CachedSolution. Store it for later.
                 LOG(5) << "Subplanner: cached plan found for child " << i << " of "
                        << _orExpression->numChildren();
 
                 branchResult->cachedSolution = std::move(cachedSol);
+                branchStats->planSource = "cache";
             }
         }
 
@@ -163,6 +172,7 @@ Status SubplanStage::planSubqueries() {
                 return Status(ErrorCodes::BadValue, ss);
             }
             branchResult->solutions = std::move(solutions.getValue());
+            branchStats->numCandidates = branchResult->solutions.size();
 
             LOG(5) << "Subplanner: got " << branchResult->solutions.size() << " solutions";
 
@@ -225,10 +235,21 @@ Status tagOrChildAccordingToCache(PlanCacheIndexTree* compositeCacheData,
 Status SubplanStage::choosePlanForSubqueries(PlanYieldPolicy* yieldPolicy) {
     // This is the skeleton of index selections that is inserted into the cache.
     std::unique_ptr<PlanCacheIndexTree> cacheData(new PlanCacheIndexTree());
+    _winnersByShape.clear();
+    _specificStats.branchesReused = 0;
 
     for (size_t i = 0; i < _orExpression->numChildren(); ++i) {
         MatchExpression* orChild = _orExpression->getChild(i);
         BranchPlanningResult* branchResult = _branchResults[i].get();
+        SubplanBranchStats* branchStats = &_specificStats.branchStats[i];
+        Timer branchTimer;
+        ON_BLOCK_EXIT([&] { branchStats->planningTimeMicros += branchTimer.micros(); });
+
+        // If an earlier branch of the same shape was ranked by a MultiPlanStage, reuse its winner
+        // rather than running another trial.
+        auto reusableWinner = branchResult->planCacheKey.empty()
+            ? _winnersByShape.end()
+            : _winnersByShape.find(branchResult->planCacheKey);
 
         if (branchResult->cachedSolution.get()) {
             // We can get the index tags we need out of the cache.
@@ -244,6 +265,22 @@ Status SubplanStage::choosePlanForSubqueries(PlanYieldPolicy* yieldPolicy) {
             if (!tagStatus.isOK()) {
                 return tagStatus;
             }
+            branchStats->planSource = "singleSolution";
+        } else if (reusableWinner != _winnersByShape.end()) {
+            LOG(5) << "Subplanner: reusing winning plan of an earlier branch for child " << i
+                   << " of " << _orExpression->numChildren();
+
+            Status tagStatus = QueryPlanner::tagAccordingToCache(
+                orChild, reusableWinner->second.get(), _indexMap);
+            if (!tagStatus.isOK()) {
+                mongoutils::str::stream ss;
+                ss << "Failed to extract indices from subchild " << orChild->toString();
+                return Status(ErrorCodes::BadValue, ss);
+            }
+
+            cacheData->children.push_back(reusableWinner->second->clone());
+            branchStats->planSource = "reusedBranch";
+            ++_specificStats.branchesReused;
         } else {
             // N solutions, rank them.
 
@@ -322,6 +359,13 @@ Status SubplanStage::choosePlanForSubqueries(PlanYieldPolicy* yieldPolicy) {
             }
 
             cacheData->children.push_back(bestSoln->cacheData->tree->clone());
+            branchStats->planSource = "multiPlanner";
+
+            if (internalQuerySubplanReuseBranchWinners.load() &&
+                !branchResult->planCacheKey.empty()) {
+                _winnersByShape[branchResult->planCacheKey].reset(
+                    bestSoln->cacheData->tree->clone());
+            }
         }
     }
 
@@ -475,6 +519,7 @@ PlanStage::StageState SubplanStage::doWork(WorkingSetID* out) {
 unique_ptr<PlanStageStats> SubplanStage::getStats() {
     _commonStats.isEOF = isEOF();
     unique_ptr<PlanStageStats> ret = make_unique<PlanStageStats>(_commonStats, STAGE_SUBPLAN);
+    ret->specific = make_unique<SubplanStats>(_specificStats);
     ret->children.emplace_back(child()->getStats());
     return ret;
 }
@@ -484,7 +529,7 @@ bool SubplanStage::branchPlannedFromCache(size_t i) const {
 }
 
 const SpecificStats* SubplanStage::getSpecificStats() const {
-    return NULL;
+    return &_specificStats;
 }
 
 }  // namespace mongo
@@ -65,6 +65,9 @@ class OperationContext;
  *   executions of C. These subsequent executions of shape C could be either as a clause in
  *   another rooted $or query, or shape C as its own query.
  *
+ *   --Within a single rooted $or, clauses that share a shape are ranked only once. The winning
+ *   index tags for the first such clause are applied to the others without another trial.
+ *
  *   --Plans for entire rooted $or queries are neither written to nor read from the plan cache.
  */
 class SubplanStage final : public PlanStage {
@@ -147,6 +150,10 @@ private:
 
         // Query solutions resulting from planning the $or branch.
         std::vector<std::unique_ptr<QuerySolution>> solutions;
+
+        // The plan cache key of 'canonicalQuery', or empty if the branch is not cacheable.
+        // Branches with equal keys share a shape and are planned only once.
+        PlanCacheKey planCacheKey;
     };
 
     /**
@@ -197,6 +204,12 @@ private:
 
     // We need this to extract cache-friendly index data from the index assignments.
     std::map<IndexEntry::Identifier, size_t> _indexMap;
+
+    // Index tags of the winning plan for each branch shape ranked by a MultiPlanStage, keyed by
+    // plan cache key. Lets later branches of the same shape skip their own ranking trial.
+    std::map<PlanCacheKey, std::unique_ptr<PlanCacheIndexTree>> _winnersByShape;
+
+    SubplanStats _specificStats;
 };
 
 }  // namespace mongo
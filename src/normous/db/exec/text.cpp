@@ -122,6 +122,16 @@ unique_ptr<PlanStage> TextStage::buildTextTree(OperationContext* opCtx,
         // compute their text scores. This is a blocking operation.
         auto textScorer = make_unique<TextOrStage>(opCtx, _params.spec, ws, filter, _params.index);
 
+        // The TEXT_MATCH stage passes every document that contains a positive term when the query
+        // has no negations or phrases and is neither case nor diacritic sensitive. Only then is
+        // the top of the TEXT_OR stage's results also the top of ours.
+        const auto& query = _params.query;
+        if (_params.topK && query.getNegatedTerms().empty() && query.getPositivePhr().empty() &&
+            query.getNegatedPhr().empty() && !query.getCaseSensitive() &&
+            !query.getDiacriticSensitive()) {
+            textScorer->setTopK(_params.topK, query.getTermsForBounds());
+        }
+
         textScorer->addChildren(std::move(indexScanList));
 
         textMatchStage = make_unique<TextMatchStage>(
@@ -63,6 +63,9 @@ struct TextStageParams {
     // True if we need the text score in the output, because the projection includes the 'textScore'
     // metadata field.
     bool wantTextScore = true;
+
+    // When non-zero, only the 'topK' results with the highest text score are needed.
+    size_t topK = 0;
 };
 
 /**
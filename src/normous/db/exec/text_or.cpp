@@ -28,6 +28,8 @@
 
 #include "mongo/db/exec/text_or.h"
 
+#include <algorithm>
+#include <limits>
 #include <map>
 #include <vector>
 
@@ -52,6 +54,26 @@ using stdx::make_unique;
 using fts::FTSSpec;
 
 const char* TextOrStage::kStageType = "TEXT_OR";
+constexpr double TextOrStage::kChildAtEOF;
+
+namespace {
+
+/**
+ * Returns the score of the text index key 'keyData', a key of the form {prefix,term,score,suffix}.
+ */
+double getKeyScore(const FTSSpec& ftsSpec, const BSONObj& keyData) {
+    BSONObjIterator keyIt(keyData);
+    for (unsigned i = 0; i < ftsSpec.numExtraBefore(); i++) {
+        keyIt.next();
+    }
+
+    keyIt.next();  // Skip past 'term'.
+
+    BSONElement scoreElement = keyIt.next();
+    return scoreElement.number();
+}
+
+}  // namespace
 
 TextOrStage::TextOrStage(OperationContext* opCtx,
                          const FTSSpec& ftsSpec,
@@ -78,6 +100,14 @@ void TextOrStage::addChildren(Children childrenToAdd) {
                      std::make_move_iterator(childrenToAdd.end()));
 }
 
+void TextOrStage::setTopK(size_t k, std::set<std::string> terms) {
+    invariant(_internalState == State::kInit);
+    invariant(k > 0);
+    _topK = k;
+    _topKTerms = std::move(terms);
+    _specificStats.topK = k;
+}
+
 bool TextOrStage::isEOF() {
     return _internalState == State::kDone;
 }
@@ -158,6 +188,9 @@ PlanStage::StageState TextOrStage::initStage(WorkingSetID* out) {
     try {
         _recordCursor = _index->getCollection()->getCursor(getOpCtx());
         _internalState = State::kReadingTerms;
+        if (_topK) {
+            _childBounds.assign(_children.size(), std::numeric_limits<double>::infinity());
+        }
         return PlanStage::NEED_TIME;
     } catch (const WriteConflictException&) {
         invariant(_internalState == State::kInit);
@@ -177,7 +210,8 @@ PlanStage::StageState TextOrStage::readFromChildren(WorkingSetID* out) {
     // Either retry the last WSM we worked on or get a new one from our current child.
     WorkingSetID id;
     StageState childState;
-    if (_idRetrying == WorkingSet::INVALID_ID) {
+    const bool retrying = _idRetrying != WorkingSet::INVALID_ID;
+    if (!retrying) {
         childState = _children[_currentChild]->work(&id);
     } else {
         childState = ADVANCED;
@@ -185,6 +219,27 @@ PlanStage::StageState TextOrStage::readFromChildren(WorkingSetID* out) {
         _idRetrying = WorkingSet::INVALID_ID;
     }
 
+    if (_topK && (PlanStage::ADVANCED == childState || PlanStage::IS_EOF == childState)) {
+        StageState stageState = PlanStage::NEED_TIME;
+        if (PlanStage::IS_EOF == childState) {
+            _childBounds[_currentChild] = kChildAtEOF;
+        } else {
+            if (!retrying) {
+                // The child's postings are in descending order of score, so this posting's score
+                // bounds the scores of those yet to come.
+                WorkingSetMember* wsm = _ws->get(id);
+                invariant(1 == wsm->keyData.size());
+                _childBounds[_currentChild] = getKeyScore(_ftsSpec, wsm->keyData.back().keyData);
+            }
+            stageState = addTerm(id, out);
+        }
+
+        if (_idRetrying == WorkingSet::INVALID_ID) {
+            nextTopKChild();
+        }
+        return stageState;
+    }
+
     if (PlanStage::ADVANCED == childState) {
         return addTerm(id, out);
     } else if (PlanStage::IS_EOF == childState) {
@@ -289,6 +344,16 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
 
         // Ensure that the BSONObj underlying the WorkingSetMember is owned in case we yield.
         wsm->makeObjOwnedIfNeeded();
+
+        if (_topK) {
+            addTopKCandidate(wsid, wsm);
+            return NEED_TIME;
+        }
+    } else if (_topK) {
+        // In top-k mode the document was scored in full when first seen.
+        invariant(wsid != textRecordData->wsid);
+        _ws->free(wsid);
+        return NEED_TIME;
     } else {
         // We already have a working set member for this RecordId. Free the new WSM and retrieve the
         // old one. Note that since we don't keep all index keys, we could get a score that doesn't
@@ -299,20 +364,80 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
         wsm = _ws->get(textRecordData->wsid);
     }
 
-    // Locate score within possibly compound key: {prefix,term,score,suffix}.
-    BSONObjIterator keyIt(newKeyData.keyData);
-    for (unsigned i = 0; i < _ftsSpec.numExtraBefore(); i++) {
-        keyIt.next();
+    // Aggregate relevance score, term keys.
+    textRecordData->score += getKeyScore(_ftsSpec, newKeyData.keyData);
+    return NEED_TIME;
+}
+
+void TextOrStage::addTopKCandidate(WorkingSetID wsid, WorkingSetMember* wsm) {
+    TextRecordData* textRecordData = &_scores[wsm->recordId];
+
+    fts::TermFrequencyMap termFrequencies;
+    _ftsSpec.scoreDocument(wsm->obj.value(), &termFrequencies);
+    double score = 0;
+    for (auto&& term : _topKTerms) {
+        auto it = termFrequencies.find(term);
+        if (it != termFrequencies.end()) {
+            score += it->second;
+        }
     }
 
-    keyIt.next();  // Skip past 'term'.
+    if (_topKResults.size() == _topK && score <= _topKResults.top().first) {
+        // Like a document rejected by the filter, this document is never returned.
+        _ws->free(wsid);
+        textRecordData->wsid = WorkingSet::INVALID_ID;
+        textRecordData->score = -1;
+        return;
+    }
 
-    BSONElement scoreElement = keyIt.next();
-    double documentTermScore = scoreElement.number();
+    textRecordData->score = score;
+    _topKResults.emplace(score, wsid);
+    if (_topKResults.size() <= _topK) {
+        return;
+    }
 
-    // Aggregate relevance score, term keys.
-    textRecordData->score += documentTermScore;
-    return NEED_TIME;
+    const WorkingSetID evictedId = _topKResults.top().second;
+    _topKResults.pop();
+    auto evicted = _scores.find(_ws->get(evictedId)->recordId);
+    invariant(evicted != _scores.end());
+    evicted->second.wsid = WorkingSet::INVALID_ID;
+    evicted->second.score = -1;
+    _ws->free(evictedId);
+}
+
+bool TextOrStage::topKIsComplete() const {
+    if (_topKResults.size() < _topK) {
+        return false;
+    }
+
+    double bound = 0;
+    for (double childBound : _childBounds) {
+        if (childBound != kChildAtEOF) {
+            bound += childBound;
+        }
+    }
+    return _topKResults.top().first >= bound;
+}
+
+void TextOrStage::nextTopKChild() {
+    if (topKIsComplete()) {
+        _specificStats.stoppedEarly =
+            std::any_of(_childBounds.begin(), _childBounds.end(), [](double childBound) {
+                return childBound != kChildAtEOF;
+            });
+    } else {
+        for (size_t i = 1; i <= _children.size(); ++i) {
+            size_t child = (_currentChild + i) % _children.size();
+            if (_childBounds[child] != kChildAtEOF) {
+                _currentChild = child;
+                return;
+            }
+        }
+    }
+
+    // Either no unread document can enter the top k or every child is at EOF.
+    _scoreIterator = _scores.begin();
+    _internalState = State::kReturningResults;
 }
 
 }  // namespace mongo
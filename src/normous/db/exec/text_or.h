@@ -29,6 +29,10 @@
 #pragma once
 
 #include <memory>
+#include <queue>
+#include <set>
+#include <string>
+#include <vector>
 
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/exec/plan_stage.h"
@@ -48,6 +52,13 @@ class OperationContext;
  * the positive terms in the search query, as well as their scores.
  *
  * The WorkingSetMembers returned are fetched and in the LOC_AND_OBJ state.
+ *
+ * If setTopK() is called, the stage instead returns only the documents with the highest scores.
+ * Each child must then scan its term's postings in descending order of score, so that the score
+ * of the posting a child returned last bounds the scores of those it has yet to return. The
+ * children are read in turn, and each newly seen document is scored in full from its contents.
+ * Reading stops once the documents kept score no lower than the sum of these bounds, since no
+ * unread document can then score higher.
  */
 class TextOrStage final : public PlanStage {
 public:
@@ -79,6 +90,12 @@ public:
 
     void addChildren(Children childrenToAdd);
 
+    /**
+     * Limits the results to the 'k' documents with the highest scores, where a document's score is
+     * the sum of its scores for each of 'terms'. Must be called before the first call to work().
+     */
+    void setTopK(size_t k, std::set<std::string> terms);
+
     bool isEOF() final;
 
     StageState doWork(WorkingSetID* out) final;
@@ -117,6 +134,24 @@ private:
      */
     StageState addTerm(WorkingSetID wsid, WorkingSetID* out);
 
+    /**
+     * Helper called from addTerm in top-k mode to score a newly fetched document and keep it if it
+     * is among the best '_topK' seen so far.
+     */
+    void addTopKCandidate(WorkingSetID wsid, WorkingSetMember* wsm);
+
+    /**
+     * Returns whether, in top-k mode, no document that has yet to be read can score higher than
+     * the ones kept.
+     */
+    bool topKIsComplete() const;
+
+    /**
+     * Helper called from readFromChildren in top-k mode after each child is worked. Moves on to
+     * returning results if reading can stop, and otherwise to the next child not at EOF.
+     */
+    void nextTopKChild();
+
     /**
      * Worker for kReturningResults. Returns a wsm with RecordID and Score.
      */
@@ -149,6 +184,18 @@ private:
     ScoreMap _scores;
     ScoreMap::const_iterator _scoreIterator;
 
+    // Top-k mode. When '_topK' is non-zero, '_childBounds' holds the score of the last posting
+    // read from each child, +inf for a child not yet read, or kChildAtEOF for one at EOF. The
+    // documents kept are in '_topKResults', a min-heap on score.
+    static constexpr double kChildAtEOF = -1;
+
+    size_t _topK = 0;
+    std::set<std::string> _topKTerms;
+    std::vector<double> _childBounds;
+    using ScoredWsid = std::pair<double, WorkingSetID>;
+    std::priority_queue<ScoredWsid, std::vector<ScoredWsid>, std::greater<ScoredWsid>>
+        _topKResults;
+
     TextOrStats _specificStats;
 
     // Members needed only for using the TextMatchableDocument.
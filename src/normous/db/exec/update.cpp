@@ -43,6 +43,7 @@
 #include "mongo/db/op_observer.h"
 #include "mongo/db/ops/update_lifecycle.h"
 #include "mongo/db/query/explain.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/db/service_context.h"
@@ -50,6 +51,7 @@
 #include "mongo/stdx/memory.h"
 #include "mongo/util/log.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
 #include "mongo/util/transitional_tools_do_not_use/vector_spooling.h"
 
 namespace mongo {
@@ -196,17 +198,6 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
     // If asked to return new doc, default to the oldObj, in case nothing changes.
     BSONObj newObj = oldObj.value();
 
-    // Ask the driver to apply the mods. It may be that the driver can apply those "in
-    // place", that is, some values of the old document just get adjusted without any
-    // change to the binary layout on the bson layer. It may be that a whole new document
-    // is needed to accomodate the new bson layout of the resulting document. In any event,
-    // only enable in-place mutations if the underlying storage engine offers support for
-    // writing damage events.
-    _doc.reset(oldObj.value(),
-               (_collection->updateWithDamagesSupported()
-                    ? mutablebson::Document::kInPlaceEnabled
-                    : mutablebson::Document::kInPlaceDisabled));
-
     BSONObj logObj;
 
     bool docWasModified = false;
@@ -225,57 +216,89 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
         }
         immutablePaths.keepShortest(&idFieldRef);
     }
-    if (!driver->needMatchDetails()) {
-        // If we don't need match details, avoid doing the rematch
-        status = driver->update(
-            StringData(), &_doc, validateForStorage, immutablePaths, &logObj, &docWasModified);
-    } else {
-        // If there was a matched field, obtain it.
-        MatchDetails matchDetails;
-        matchDetails.requestElemMatchKey();
-
-        dassert(cq);
-        verify(cq->root()->matchesBSON(oldObj.value(), &matchDetails));
-
-        string matchedField;
-        if (matchDetails.hasElemMatchKey())
-            matchedField = matchDetails.elemMatchKey();
 
-        status = driver->update(
-            matchedField, &_doc, validateForStorage, immutablePaths, &logObj, &docWasModified);
-    }
+    // Simple $set and $inc updates are applied by copying the old document, without building a
+    // mutablebson document. If the new document has the old one's layout, the changes can still
+    // be written as damage events.
+    BSONObj simpleNewObj;
+    const char* source = NULL;
+    bool inPlace = false;
+    _damages.clear();
+    const bool updatedSimply = !driver->needMatchDetails() &&
+        driver->updateSimple(
+            oldObj.value(), immutablePaths, &simpleNewObj, &_damages, &logObj, &docWasModified);
+    if (updatedSimply) {
+        if (docWasModified && !_damages.empty() && _collection->updateWithDamagesSupported()) {
+            inPlace = true;
+            source = simpleNewObj.objdata();
+        }
+    } else {
+        // Ask the driver to apply the mods. It may be that the driver can apply those "in
+        // place", that is, some values of the old document just get adjusted without any
+        // change to the binary layout on the bson layer. It may be that a whole new document
+        // is needed to accomodate the new bson layout of the resulting document. In any event,
+        // only enable in-place mutations if the underlying storage engine offers support for
+        // writing damage events.
+        _doc.reset(oldObj.value(),
+                   (_collection->updateWithDamagesSupported()
+                        ? mutablebson::Document::kInPlaceEnabled
+                        : mutablebson::Document::kInPlaceDisabled));
+
+        if (!driver->needMatchDetails()) {
+            // If we don't need match details, avoid doing the rematch
+            status = driver->update(
+                StringData(), &_doc, validateForStorage, immutablePaths, &logObj, &docWasModified);
+        } else {
+            // If there was a matched field, obtain it.
+            MatchDetails matchDetails;
+            matchDetails.requestElemMatchKey();
+
+            dassert(cq);
+            verify(cq->root()->matchesBSON(oldObj.value(), &matchDetails));
+
+            string matchedField;
+            if (matchDetails.hasElemMatchKey())
+                matchedField = matchDetails.elemMatchKey();
+
+            status = driver->update(matchedField,
+                                    &_doc,
+                                    validateForStorage,
+                                    immutablePaths,
+                                    &logObj,
+                                    &docWasModified);
+        }
 
-    if (!status.isOK()) {
-        uasserted(16837, status.reason());
-    }
+        if (!status.isOK()) {
+            uasserted(16837, status.reason());
+        }
 
-    // Skip adding _id field if the collection is capped (since capped collection documents can
-    // neither grow nor shrink).
-    const auto createIdField = !_collection->isCapped();
+        // Skip adding _id field if the collection is capped (since capped collection documents
+        // can neither grow nor shrink).
+        const auto createIdField = !_collection->isCapped();
 
-    // Ensure if _id exists it is first
-    status = ensureIdFieldIsFirst(&_doc);
-    if (status.code() == ErrorCodes::InvalidIdField) {
-        // Create ObjectId _id field if we are doing that
-        if (createIdField) {
-            addObjectIDIdField(&_doc);
+        // Ensure if _id exists it is first
+        status = ensureIdFieldIsFirst(&_doc);
+        if (status.code() == ErrorCodes::InvalidIdField) {
+            // Create ObjectId _id field if we are doing that
+            if (createIdField) {
+                addObjectIDIdField(&_doc);
+            }
+        } else {
+            uassertStatusOK(status);
         }
-    } else {
-        uassertStatusOK(status);
-    }
-
-    // See if the changes were applied in place
-    const char* source = NULL;
-    const bool inPlace = _doc.getInPlaceUpdates(&_damages, &source);
 
-    if (inPlace && _damages.empty()) {
-        // An interesting edge case. A modifier didn't notice that it was really a no-op
-        // during its 'prepare' phase. That represents a missed optimization, but we still
-        // shouldn't do any real work. Toggle 'docWasModified' to 'false'.
-        //
-        // Currently, an example of this is '{ $push : { x : {$each: [], $sort: 1} } }' when the 'x'
-        // array exists and is already sorted.
-        docWasModified = false;
+        // See if the changes were applied in place
+        inPlace = _doc.getInPlaceUpdates(&_damages, &source);
+
+        if (inPlace && _damages.empty()) {
+            // An interesting edge case. A modifier didn't notice that it was really a no-op
+            // during its 'prepare' phase. That represents a missed optimization, but we still
+            // shouldn't do any real work. Toggle 'docWasModified' to 'false'.
+            //
+            // Currently, an example of this is '{ $push : { x : {$each: [], $sort: 1} } }' when
+            // the 'x' array exists and is already sorted.
+            docWasModified = false;
+        }
     }
 
     if (docWasModified) {
@@ -297,6 +320,7 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
                     !request->isMulti() || args.criteria.hasField("_id"_sd));
             args.fromMigrate = request->isFromMigration();
             args.storeDocOption = getStoreDocMode(*request);
+            args.modifiedIndexedPaths = driver->getModifiedIndexedPaths();
             if (args.storeDocOption == CollectionUpdateArgs::StoreDocOption::PreImage) {
                 args.preImageDoc = oldObj.value().getOwned();
             }
@@ -319,7 +343,7 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
         } else {
             // The updates were not in place. Apply them through the file manager.
 
-            newObj = _doc.getObject();
+            newObj = updatedSimply ? simpleNewObj : _doc.getObject();
             uassert(17419,
                     str::stream() << "Resulting document after update is larger than "
                                   << BSONObjMaxUserSize,
@@ -346,7 +370,8 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
         // it again.  For an example, see the comment above near declaration of
         // updatedRecordIds.
         //
-        // This must be done after the wunit commits so we are sure we won't be rolling back.
+        // This must be done after the wunit commits so we are sure we won't be rolling back. A
+        // batch of updates which is rolled back removes the RecordIds it inserted again.
         if (_updatedRecordIds && (newRecordId != recordId || driver->modsAffectIndices())) {
             _updatedRecordIds->insert(newRecordId);
         }
@@ -479,6 +504,7 @@ bool UpdateStage::doneUpdating() {
     // We're done updating if either the child has no more results to give us, or we've
     // already gotten a result back and we're not a multi-update.
     return _idRetrying == WorkingSet::INVALID_ID && _idReturning == WorkingSet::INVALID_ID &&
+        _idsToRetry.empty() &&
         (child()->isEOF() || (_specificStats.nMatched > 0 && !_params.request->isMulti()));
 }
 
@@ -551,12 +577,19 @@ PlanStage::StageState UpdateStage::doWork(WorkingSetID* out) {
     // Either retry the last WSM we worked on or get a new one from our child.
     WorkingSetID id;
     StageState status;
-    if (_idRetrying == WorkingSet::INVALID_ID) {
-        status = child()->work(&id);
-    } else {
+    if (_idRetrying != WorkingSet::INVALID_ID) {
         status = ADVANCED;
         id = _idRetrying;
         _idRetrying = WorkingSet::INVALID_ID;
+    } else if (!_idsToRetry.empty()) {
+        status = ADVANCED;
+        id = _idsToRetry.front();
+        _idsToRetry.pop_front();
+    } else if (shouldBatchUpdates()) {
+        status = doBatchedUpdates(&id);
+        invariant(status != ADVANCED);
+    } else {
+        status = child()->work(&id);
     }
 
     if (PlanStage::ADVANCED == status) {
@@ -767,4 +800,133 @@ PlanStage::StageState UpdateStage::prepareToRetryWSM(WorkingSetID idToRetry, Wor
     return NEED_YIELD;
 }
 
+bool UpdateStage::shouldBatchUpdates() {
+    // Documents which are returned to our caller must be written one at a time, and so must those
+    // of an update already running inside a WriteUnitOfWork, such as one in a multi-statement
+    // transaction, as committing our batch would not end its storage transaction anyway.
+    const UpdateRequest* request = _params.request;
+    return internalUpdateMultiMaxDocsPerWriteUnitOfWork.load() > 1 && request->isMulti() &&
+        !request->shouldReturnAnyDocs() && !request->isExplain() &&
+        !getOpCtx()->lockState()->inAWriteUnitOfWork();
+}
+
+PlanStage::StageState UpdateStage::doBatchedUpdates(WorkingSetID* out) {
+    // The batch must be committed before we return, as our caller may yield, which is not allowed
+    // inside a WriteUnitOfWork, between calls to work().
+    const size_t maxDocs = internalUpdateMultiMaxDocsPerWriteUnitOfWork.load();
+    const int maxBytes = internalUpdateMultiMaxBytesPerWriteUnitOfWork.load();
+    const int maxMillis = internalUpdateMultiMaxMillisPerWriteUnitOfWork.load();
+
+    const size_t nMatchedBefore = _specificStats.nMatched;
+    const size_t nModifiedBefore = _specificStats.nModified;
+    std::vector<WorkingSetID> batchIds;
+    int batchBytes = 0;
+    Timer batchTimer;
+    auto batchIsFull = [&] {
+        return batchIds.size() >= maxDocs || batchBytes >= maxBytes ||
+            batchTimer.millis() >= maxMillis;
+    };
+
+    WriteUnitOfWork wunit(getOpCtx());
+
+    // The member being updated when a write conflict aborted the batch, if any.
+    WorkingSetID updatingId = WorkingSet::INVALID_ID;
+
+    // Queues every document of the batch to be updated again, and reverts whatever the batch
+    // recorded about them. The caller returns, which rolls 'wunit' back.
+    auto rollBackBatch = [&] {
+        if (updatingId != WorkingSet::INVALID_ID) {
+            batchIds.push_back(updatingId);
+        }
+        for (auto&& id : batchIds) {
+            // Updates leave documents where they are, so this is the RecordId the batch may have
+            // added to '_updatedRecordIds', and which may not be skipped when it is retried.
+            _updatedRecordIds->erase(_ws->get(id)->recordId);
+            _idsToRetry.push_back(id);
+        }
+        _specificStats.nMatched = nMatchedBefore;
+        _specificStats.nModified = nModifiedBefore;
+    };
+
+    StageState status = NEED_TIME;
+    bool childIsSaved = false;
+    try {
+        while (!batchIsFull()) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            status = child()->work(&id);
+            if (NEED_TIME == status) {
+                continue;
+            }
+            if (ADVANCED != status) {
+                *out = id;
+                break;
+            }
+
+            WorkingSetMember* member = _ws->get(id);
+            invariant(member->hasRecordId());
+            invariant(member->hasObj());
+            RecordId recordId = member->recordId;
+
+            updatingId = id;
+            if (_updatedRecordIds->count(recordId) > 0 ||
+                !write_stage_common::ensureStillMatches(
+                    _collection, getOpCtx(), _ws, id, _params.canonicalQuery)) {
+                updatingId = WorkingSet::INVALID_ID;
+                _ws->free(id);
+                continue;
+            }
+
+            member->makeObjOwnedIfNeeded();
+            WorkingSetCommon::prepareForSnapshotChange(_ws);
+            try {
+                child()->saveState();
+            } catch (const WriteConflictException&) {
+                std::terminate();
+            }
+            childIsSaved = true;
+
+            batchBytes += transformAndUpdate(member->obj, recordId).objsize();
+            ++_specificStats.nMatched;
+            batchIds.push_back(id);
+            updatingId = WorkingSet::INVALID_ID;
+
+            // The last document's child state is restored after the batch commits, as it would
+            // be for a document written outside of a batch.
+            if (batchIsFull()) {
+                break;
+            }
+            child()->restoreState();
+            childIsSaved = false;
+        }
+    } catch (const WriteConflictException&) {
+        rollBackBatch();
+        *out = WorkingSet::INVALID_ID;
+        return NEED_YIELD;
+    }
+
+    if (NEED_YIELD == status) {
+        // Our child also yields after a write conflict, which has aborted the storage
+        // transaction the batch was written in.
+        rollBackBatch();
+        return NEED_YIELD;
+    }
+
+    wunit.commit();
+    for (auto&& id : batchIds) {
+        _ws->free(id);
+    }
+
+    if (childIsSaved) {
+        try {
+            child()->restoreState();
+        } catch (const WriteConflictException&) {
+            // The batch is already committed, so there is nothing to retry.
+            *out = WorkingSet::INVALID_ID;
+            return NEED_YIELD;
+        }
+    }
+
+    return ADVANCED == status ? NEED_TIME : status;
+}
+
 }  // namespace mongo
@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <deque>
 
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/exec/plan_stage.h"
@@ -176,6 +177,24 @@ private:
      */
     StageState prepareToRetryWSM(WorkingSetID idToRetry, WorkingSetID* out);
 
+    /**
+     * Returns whether the next documents of a multi-update should be written as a batch by
+     * doBatchedUpdates().
+     */
+    bool shouldBatchUpdates();
+
+    /**
+     * Updates the documents our child produces until it stops advancing or the batch reaches the
+     * internalUpdateMultiMax*PerWriteUnitOfWork budget, writing all of them under one
+     * WriteUnitOfWork so that the child's cursors are carried from one document to the next
+     * within a single storage transaction.
+     *
+     * Returns NEED_TIME once the batch is committed, or the IS_EOF or FAILURE state (with 'out')
+     * of the child that ended it. A write conflict rolls the whole batch back, queues its members
+     * in '_idsToRetry' and returns NEED_YIELD.
+     */
+    StageState doBatchedUpdates(WorkingSetID* out);
+
     UpdateStageParams _params;
 
     // Not owned by us.
@@ -187,6 +206,10 @@ private:
     // If not WorkingSet::INVALID_ID, we use this rather than asking our child what to do next.
     WorkingSetID _idRetrying;
 
+    // The members of a rolled back batch of updates. They are updated again, one at a time,
+    // before we ask our child for anything else.
+    std::deque<WorkingSetID> _idsToRetry;
+
     // If not WorkingSet::INVALID_ID, we return this member to our caller.
     WorkingSetID _idReturning;
 
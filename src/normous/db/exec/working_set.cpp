@@ -28,6 +28,9 @@
 
 #include "mongo/db/exec/working_set.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include "mongo/db/bson/dotted_path_support.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/service_context.h"
@@ -38,10 +41,26 @@ using std::string;
 
 namespace dps = ::mongo::dotted_path_support;
 
+namespace {
+
+// The smallest size of WorkingSet::_borrowedObjIds at which it gets purged.
+const size_t kMinBorrowedObjIdsLimit = 1024;
+
+// The size of each block of memory which WorkingSet::copyToArena() copies objects into. A block is
+// freed only once every object copied into it is gone, so blocks are kept small to bound the memory
+// that a few long-lived copies can pin.
+const size_t kArenaBlockSize = 4 * 1024;
+
+// Objects larger than this are copied into an allocation of their own rather than into the arena.
+const size_t kMaxArenaObjSize = kArenaBlockSize / 16;
+
+}  // namespace
+
 WorkingSet::MemberHolder::MemberHolder() : member(NULL) {}
 WorkingSet::MemberHolder::~MemberHolder() {}
 
-WorkingSet::WorkingSet() : _freeList(INVALID_ID) {}
+WorkingSet::WorkingSet()
+    : _freeList(INVALID_ID), _borrowedObjIdsLimit(kMinBorrowedObjIdsLimit) {}
 
 WorkingSet::~WorkingSet() {
     for (size_t i = 0; i < _data.size(); i++) {
@@ -58,9 +77,12 @@ WorkingSetID WorkingSet::allocate() {
         _data.resize(_data.size() + 1);
         _data.back().nextFreeOrSelf = id;
         _data.back().member = new WorkingSetMember();
+        ++_stats.membersCreated;
         return id;
     }
 
+    ++_stats.membersReused;
+
     // Pop the head off the free list and return it.
     WorkingSetID id = _freeList;
     _freeList = _data[id].nextFreeOrSelf;
@@ -90,6 +112,8 @@ void WorkingSet::clear() {
     _freeList = INVALID_ID;
 
     _yieldSensitiveIds.clear();
+    _borrowedObjIds.clear();
+    _borrowedObjIdsLimit = kMinBorrowedObjIdsLimit;
 }
 
 void WorkingSet::transitionToRecordIdAndIdx(WorkingSetID id) {
@@ -101,6 +125,22 @@ void WorkingSet::transitionToRecordIdAndIdx(WorkingSetID id) {
 void WorkingSet::transitionToRecordIdAndObj(WorkingSetID id) {
     WorkingSetMember* member = get(id);
     member->_state = WorkingSetMember::RID_AND_OBJ;
+
+    if (member->obj.value().isOwned()) {
+        return;
+    }
+
+    if (_borrowedObjIds.size() >= _borrowedObjIdsLimit) {
+        auto noLongerBorrowed = [this](WorkingSetID borrowedId) {
+            return isFree(borrowedId) || !get(borrowedId)->hasObj() ||
+                get(borrowedId)->hasOwnedObj();
+        };
+        _borrowedObjIds.erase(
+            std::remove_if(_borrowedObjIds.begin(), _borrowedObjIds.end(), noLongerBorrowed),
+            _borrowedObjIds.end());
+        _borrowedObjIdsLimit = std::max(kMinBorrowedObjIdsLimit, 2 * _borrowedObjIds.size());
+    }
+    _borrowedObjIds.push_back(id);
 }
 
 void WorkingSet::transitionToOwnedObj(WorkingSetID id) {
@@ -108,6 +148,47 @@ void WorkingSet::transitionToOwnedObj(WorkingSetID id) {
     member->transitionToOwnedObj();
 }
 
+void WorkingSet::makeBorrowedObjsOwned() {
+    for (auto id : _borrowedObjIds) {
+        // The member may have been freed, or freed and reallocated, since it was flagged. Making
+        // its obj owned is correct in either case.
+        if (!isFree(id)) {
+            get(id)->makeObjOwnedIfNeeded();
+        }
+    }
+    _borrowedObjIds.clear();
+    _borrowedObjIdsLimit = kMinBorrowedObjIdsLimit;
+}
+
+BSONObj WorkingSet::copyToArena(const BSONObj& obj) {
+    const size_t size = obj.objsize();
+    if (size > kMaxArenaObjSize) {
+        ++_stats.arenaObjsTooLarge;
+        return obj.getOwned();
+    }
+
+    // If the working set holds the only reference to the current block, then nothing points into
+    // it anymore and it can be filled again from the start.
+    if (_arenaOffset > 0 && !_arenaBlock.isShared()) {
+        _arenaOffset = 0;
+        ++_stats.arenaBlocksRewound;
+    }
+
+    if (!_arenaBlock || _arenaBlock.capacity() - _arenaOffset < size) {
+        _arenaBlock = SharedBuffer::allocate(kArenaBlockSize);
+        _arenaOffset = 0;
+        ++_stats.arenaBlocksAllocated;
+    }
+
+    char* copy = _arenaBlock.get() + _arenaOffset;
+    std::memcpy(copy, obj.objdata(), size);
+    _arenaOffset += size;
+
+    ++_stats.arenaObjsCopied;
+    _stats.arenaBytesCopied += size;
+    return BSONObj(copy).shareOwnershipWith(_arenaBlock);
+}
+
 std::vector<WorkingSetID> WorkingSet::getAndClearYieldSensitiveIds() {
     std::vector<WorkingSetID> out;
     // Clear '_yieldSensitiveIds' by swapping it into the set to be returned.
@@ -35,6 +35,7 @@
 #include "mongo/db/record_id.h"
 #include "mongo/db/storage/snapshot.h"
 #include "mongo/stdx/unordered_set.h"
+#include "mongo/util/shared_buffer.h"
 
 namespace mongo {
 
@@ -43,6 +44,27 @@ class WorkingSetMember;
 
 typedef size_t WorkingSetID;
 
+/**
+ * Counters describing where a WorkingSet got the memory backing its members.
+ */
+struct WorkingSetStats {
+    // The number of WorkingSetMembers constructed, and the number of allocations that were instead
+    // served by recycling a freed member.
+    size_t membersCreated = 0;
+    size_t membersReused = 0;
+
+    // The number of arena blocks obtained from the heap, and the number of times an arena block
+    // that no object referenced any longer was rewound in order to be filled again.
+    size_t arenaBlocksAllocated = 0;
+    size_t arenaBlocksRewound = 0;
+
+    // The number of objects copied into the arena and their total size, and the number of objects
+    // which were too large for the arena and got an allocation of their own.
+    size_t arenaObjsCopied = 0;
+    size_t arenaBytesCopied = 0;
+    size_t arenaObjsTooLarge = 0;
+};
+
 /**
  * All data in use by a query.  Data is passed through the stage tree by referencing the ID of
  * an element of the working set.  Stages can add elements to the working set, delete elements
@@ -112,6 +134,33 @@ public:
      */
     std::vector<WorkingSetID> getAndClearYieldSensitiveIds();
 
+    /**
+     * Makes the obj of every member that entered the RID_AND_OBJ state with an unowned obj since
+     * the last call owned, if the member still holds it.
+     *
+     * Unowned objs usually point into memory belonging to a storage engine cursor, which is only
+     * guaranteed to stay valid until the cursor is saved. This must therefore be called before
+     * the stages are saved, so that members which are held across a yield, but not across a
+     * movement of the cursor their obj came from, need not be copied eagerly.
+     */
+    void makeBorrowedObjsOwned();
+
+    /**
+     * Returns an owned copy of 'obj' for use as the data of a member, such as an index key.
+     *
+     * Small objects are copied into a block of memory shared with other copies made by this working
+     * set instead of into an allocation of their own. Each copy keeps a reference to its block, so
+     * it remains valid for as long as it is held, even after the member it was made for is freed
+     * or the working set is destroyed. Once no copy refers to the current block anymore, the block
+     * is rewound and reused, so a plan which frees its members as it returns them keeps refilling
+     * the same memory.
+     */
+    BSONObj copyToArena(const BSONObj& obj);
+
+    const WorkingSetStats& getStats() const {
+        return _stats;
+    }
+
 private:
     struct MemberHolder {
         MemberHolder();
@@ -135,6 +184,20 @@ private:
 
     // Contains ids of WSMs that may need to be adjusted when we next yield.
     std::vector<WorkingSetID> _yieldSensitiveIds;
+
+    // Contains ids of WSMs that were given an unowned obj since we last yielded. Plans that never
+    // yield would grow this without bound, so it is periodically purged of members that have
+    // since been freed or whose obj has become owned; '_borrowedObjIdsLimit' is the size which
+    // triggers the next purge.
+    std::vector<WorkingSetID> _borrowedObjIds;
+    size_t _borrowedObjIdsLimit;
+
+    // The arena block which copyToArena() is currently filling, and the offset of its first unused
+    // byte. Blocks that have been replaced are kept alive by the objects copied into them.
+    SharedBuffer _arenaBlock;
+    size_t _arenaOffset = 0;
+
+    WorkingSetStats _stats;
 };
 
 /**
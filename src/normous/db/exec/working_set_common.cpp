@@ -39,7 +39,57 @@
 
 namespace mongo {
 
+namespace {
+
+/**
+ * Installs 'data' as the document for the RID_AND_IDX member 'id', re-validating its index key data
+ * if the member has been marked suspicious by a snapshot change. Returns false if the document no
+ * longer matches the index entry that produced it.
+ */
+bool finishFetch(OperationContext* opCtx,
+                 WorkingSet* workingSet,
+                 WorkingSetID id,
+                 RecordData data) {
+    WorkingSetMember* member = workingSet->get(id);
+    member->obj = {opCtx->recoveryUnit()->getSnapshotId(), data.releaseToBson()};
+
+    if (member->isSuspicious) {
+        // Make sure that all of the keyData is still valid for this copy of the document.
+        // This ensures both that index-provided filters and sort orders still hold.
+        // TODO provide a way for the query planner to opt out of this checking if it is
+        // unneeded due to the structure of the plan.
+        invariant(!member->keyData.empty());
+        for (size_t i = 0; i < member->keyData.size(); i++) {
+            BSONObjSet keys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+            // There's no need to compute the prefixes of the indexed fields that cause the index to
+            // be multikey when ensuring the keyData is still valid.
+            BSONObjSet* multikeyMetadataKeys = nullptr;
+            MultikeyPaths* multikeyPaths = nullptr;
+            member->keyData[i].index->getKeys(member->obj.value(),
+                                              IndexAccessMethod::GetKeysMode::kEnforceConstraints,
+                                              &keys,
+                                              multikeyMetadataKeys,
+                                              multikeyPaths);
+            if (!keys.count(member->keyData[i].keyData)) {
+                // document would no longer be at this position in the index.
+                return false;
+            }
+        }
+
+        member->isSuspicious = false;
+    }
+
+    member->keyData.clear();
+    workingSet->transitionToRecordIdAndObj(id);
+    return true;
+}
+
+}  // namespace
+
 void WorkingSetCommon::prepareForSnapshotChange(WorkingSet* workingSet) {
+    // Objs borrowed from storage engine cursors don't survive the cursors being saved.
+    workingSet->makeBorrowedObjsOwned();
+
     for (auto id : workingSet->getAndClearYieldSensitiveIds()) {
         if (workingSet->isFree(id)) {
             continue;
@@ -70,37 +120,33 @@ bool WorkingSetCommon::fetch(OperationContext* opCtx,
         return false;
     }
 
-    member->obj = {opCtx->recoveryUnit()->getSnapshotId(), record->data.releaseToBson()};
-
-    if (member->isSuspicious) {
-        // Make sure that all of the keyData is still valid for this copy of the document.
-        // This ensures both that index-provided filters and sort orders still hold.
-        // TODO provide a way for the query planner to opt out of this checking if it is
-        // unneeded due to the structure of the plan.
-        invariant(!member->keyData.empty());
-        for (size_t i = 0; i < member->keyData.size(); i++) {
-            BSONObjSet keys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
-            // There's no need to compute the prefixes of the indexed fields that cause the index to
-            // be multikey when ensuring the keyData is still valid.
-            BSONObjSet* multikeyMetadataKeys = nullptr;
-            MultikeyPaths* multikeyPaths = nullptr;
-            member->keyData[i].index->getKeys(member->obj.value(),
-                                              IndexAccessMethod::GetKeysMode::kEnforceConstraints,
-                                              &keys,
-                                              multikeyMetadataKeys,
-                                              multikeyPaths);
-            if (!keys.count(member->keyData[i].keyData)) {
-                // document would no longer be at this position in the index.
-                return false;
-            }
-        }
+    return finishFetch(opCtx, workingSet, id, std::move(record->data));
+}
 
-        member->isSuspicious = false;
+// static
+std::vector<bool> WorkingSetCommon::fetchBatch(OperationContext* opCtx,
+                                               WorkingSet* workingSet,
+                                               const std::vector<WorkingSetID>& ids,
+                                               unowned_ptr<SeekableRecordCursor> cursor) {
+    std::vector<RecordId> recordIds;
+    recordIds.reserve(ids.size());
+    for (auto id : ids) {
+        WorkingSetMember* member = workingSet->get(id);
+        invariant(member->hasRecordId());
+        recordIds.push_back(member->recordId);
     }
 
-    member->keyData.clear();
-    workingSet->transitionToRecordIdAndObj(id);
-    return true;
+    auto records = cursor->seekExactBatch(recordIds);
+    invariant(records.size() == ids.size());
+
+    std::vector<bool> fetched(ids.size(), false);
+    for (size_t i = 0; i < ids.size(); ++i) {
+        workingSet->get(ids[i])->obj.reset();
+        if (records[i]) {
+            fetched[i] = finishFetch(opCtx, workingSet, ids[i], std::move(records[i]->data));
+        }
+    }
+    return fetched;
 }
 
 // static
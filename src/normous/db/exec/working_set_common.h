@@ -48,7 +48,8 @@ public:
      * that have transitioned into the RID_AND_IDX state since the previous yield.
      *
      * The RID_AND_IDX members are tagged as suspicious so that they can be handled properly in case
-     * the document keyed by the index key is deleted or updated during the yield.
+     * the document keyed by the index key is deleted or updated during the yield. Members holding
+     * an obj borrowed from a storage engine cursor are given an owned copy of it.
      */
     static void prepareForSnapshotChange(WorkingSet* workingSet);
 
@@ -66,6 +67,22 @@ public:
                       WorkingSetID id,
                       unowned_ptr<SeekableRecordCursor> cursor);
 
+    /**
+     * Batched version of fetch(). Transitions each of the members in 'ids' from the RID_AND_IDX
+     * state to the RID_AND_OBJ state, looking all of their documents up with a single call to
+     * SeekableRecordCursor::seekExactBatch(). The fetched objects are owned.
+     *
+     * Returns one entry per member of 'ids'. An entry is false if the corresponding document should
+     * not be considered for the result set, in which case it is the caller's responsibility to free
+     * that member.
+     *
+     * WriteConflict exceptions may be thrown. When they are, no member will have been modified.
+     */
+    static std::vector<bool> fetchBatch(OperationContext* opCtx,
+                                        WorkingSet* workingSet,
+                                        const std::vector<WorkingSetID>& ids,
+                                        unowned_ptr<SeekableRecordCursor> cursor);
+
     /**
      * Build a BSONObj which represents a Status to return in a WorkingSet.
      */
@@ -154,4 +154,72 @@ TEST_F(WorkingSetFixture, getDottedFieldFromIndex) {
     ASSERT_FALSE(member->getFieldDotted("y", &elt));
 }
 
+TEST_F(WorkingSetFixture, makeBorrowedObjsOwned) {
+    BSONObj obj = BSON("a" << 1);
+    BSONObj unowned(obj.objdata());
+    member->obj = Snapshotted<BSONObj>(SnapshotId(), unowned);
+    ws->transitionToRecordIdAndObj(id);
+    ASSERT_FALSE(member->hasOwnedObj());
+
+    // A member that is freed before the yield must be skipped.
+    WorkingSetID freedId = ws->allocate();
+    ws->get(freedId)->obj = Snapshotted<BSONObj>(SnapshotId(), unowned);
+    ws->transitionToRecordIdAndObj(freedId);
+    ws->free(freedId);
+
+    ws->makeBorrowedObjsOwned();
+    ASSERT_TRUE(member->hasOwnedObj());
+    ASSERT_BSONOBJ_EQ(obj, member->obj.value());
+}
+
+TEST_F(WorkingSetFixture, copyToArenaSharesAndRewindsBlocks) {
+    BSONObj key = BSON("" << 1 << "" << 2);
+
+    BSONObj first = ws->copyToArena(key);
+    BSONObj second = ws->copyToArena(key);
+    ASSERT_TRUE(first.isOwned());
+    ASSERT_BSONOBJ_EQ(key, first);
+    ASSERT_BSONOBJ_EQ(key, second);
+    ASSERT_NOT_EQUALS(key.objdata(), first.objdata());
+    ASSERT_EQUALS(first.objdata() + first.objsize(), second.objdata());
+    ASSERT_EQUALS(1U, ws->getStats().arenaBlocksAllocated);
+    ASSERT_EQUALS(2U, ws->getStats().arenaObjsCopied);
+
+    // While a copy is held the block cannot be rewound.
+    const char* firstData = first.objdata();
+    first = BSONObj();
+    BSONObj third = ws->copyToArena(key);
+    ASSERT_EQUALS(0U, ws->getStats().arenaBlocksRewound);
+    ASSERT_EQUALS(second.objdata() + second.objsize(), third.objdata());
+
+    // Once every copy is gone the block is filled again from the start.
+    second = BSONObj();
+    third = BSONObj();
+    BSONObj fourth = ws->copyToArena(key);
+    ASSERT_EQUALS(1U, ws->getStats().arenaBlocksRewound);
+    ASSERT_EQUALS(1U, ws->getStats().arenaBlocksAllocated);
+    ASSERT_EQUALS(firstData, fourth.objdata());
+
+    // Copies outlive the working set.
+    ws.reset();
+    ASSERT_BSONOBJ_EQ(key, fourth);
+}
+
+TEST_F(WorkingSetFixture, copyToArenaGivesLargeObjsTheirOwnAllocation) {
+    BSONObj large = BSON("a" << std::string(4096, 'x'));
+    BSONObj copy = ws->copyToArena(large);
+    ASSERT_TRUE(copy.isOwned());
+    ASSERT_BSONOBJ_EQ(large, copy);
+    ASSERT_EQUALS(1U, ws->getStats().arenaObjsTooLarge);
+    ASSERT_EQUALS(0U, ws->getStats().arenaBlocksAllocated);
+}
+
+TEST_F(WorkingSetFixture, freedMembersAreReused) {
+    ASSERT_EQUALS(1U, ws->getStats().membersCreated);
+    ws->free(id);
+    ASSERT_EQUALS(id, ws->allocate());
+    ASSERT_EQUALS(1U, ws->getStats().membersCreated);
+    ASSERT_EQUALS(1U, ws->getStats().membersReused);
+}
+
 }  // namespace
@@ -36,9 +36,11 @@
 
 namespace mongo {
 
-StatusWith<ConstDataRange> BlockCompressor::compress(ConstDataRange source) {
+StatusWith<ConstDataRange> BlockCompressor::compress(ConstDataRange source, int level) {
+    static_assert(kDefaultCompressionLevel == Z_DEFAULT_COMPRESSION,
+                  "kDefaultCompressionLevel must match zlib");
+
     z_stream stream;
-    int level = Z_DEFAULT_COMPRESSION;
 
     stream.next_in = reinterpret_cast<unsigned char*>(const_cast<char*>(source.data()));
     stream.avail_in = source.length();
@@ -44,15 +44,20 @@ class BlockCompressor {
     MONGO_DISALLOW_COPYING(BlockCompressor);
 
 public:
+    // Equivalent to Z_DEFAULT_COMPRESSION.
+    static constexpr int kDefaultCompressionLevel = -1;
+
     BlockCompressor() = default;
 
     /**
-     * Compress a buffer of data.
+     * Compress a buffer of data at the given zlib compression level. Lower levels trade
+     * compression ratio for speed.
      *
      * Returns a pointer to a buffer that BlockCompressor owns.
      * The returned buffer is valid until the next call to compress or uncompress.
      */
-    StatusWith<ConstDataRange> compress(ConstDataRange source);
+    StatusWith<ConstDataRange> compress(ConstDataRange source,
+                                        int level = kDefaultCompressionLevel);
 
     /**
      * Uncompress a buffer of data.
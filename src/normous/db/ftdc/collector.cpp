@@ -47,7 +47,8 @@ void FTDCCollectorCollection::add(std::unique_ptr<FTDCCollectorInterface> collec
     _collectors.emplace_back(std::move(collector));
 }
 
-std::tuple<BSONObj, Date_t> FTDCCollectorCollection::collect(Client* client) {
+std::tuple<BSONObj, Date_t> FTDCCollectorCollection::collect(Client* client,
+                                                             Milliseconds timeout) {
     // If there are no collectors, just return an empty BSONObj so that that are caller knows we did
     // not collect anything
     if (_collectors.empty()) {
@@ -62,17 +63,22 @@ std::tuple<BSONObj, Date_t> FTDCCollectorCollection::collect(Client* client) {
 
     builder.appendDate(kFTDCCollectStartField, start);
 
-    // All collectors should be ok seeing the inconsistent states in the middle of replication
-    // batches. This is desirable because we want to be able to collect data in the middle of
-    // batches that are taking a long time.
-    auto opCtx = client->makeOperationContext();
-    ShouldNotConflictWithSecondaryBatchApplicationBlock shouldNotConflictBlock(opCtx->lockState());
-    opCtx->lockState()->setShouldAcquireTicket(false);
-
-    // Explicitly start future read transactions without a timestamp.
-    opCtx->recoveryUnit()->setTimestampReadSource(RecoveryUnit::ReadSource::kNoTimestamp);
-
     for (auto& collector : _collectors) {
+        // All collectors should be ok seeing the inconsistent states in the middle of replication
+        // batches. This is desirable because we want to be able to collect data in the middle of
+        // batches that are taking a long time.
+        auto opCtx = client->makeOperationContext();
+        ShouldNotConflictWithSecondaryBatchApplicationBlock shouldNotConflictBlock(
+            opCtx->lockState());
+        opCtx->lockState()->setShouldAcquireTicket(false);
+
+        // Explicitly start future read transactions without a timestamp.
+        opCtx->recoveryUnit()->setTimestampReadSource(RecoveryUnit::ReadSource::kNoTimestamp);
+
+        if (timeout > Milliseconds(0)) {
+            opCtx->setDeadlineAfterNowBy(timeout, ErrorCodes::ExceededTimeLimit);
+        }
+
         BSONObjBuilder subObjBuilder(builder.subobjStart(collector->name()));
 
         // Add a Date_t before and after each BSON is collected so that we can track timing of the
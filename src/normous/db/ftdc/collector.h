@@ -33,6 +33,7 @@
 #include <vector>
 
 #include "mongo/base/disallow_copying.h"
+#include "mongo/util/duration.h"
 
 namespace mongo {
 
@@ -89,10 +90,21 @@ public:
      */
     void add(std::unique_ptr<FTDCCollectorInterface> collector);
 
+    /**
+     * Returns true if no collectors have been added.
+     */
+    bool empty() const {
+        return _collectors.empty();
+    }
+
     /**
      * Collect a sample from all collectors. Called after all adding is complete.
      * Returns a tuple of a sample, and the time at which collecting started.
      *
+     * Each collector runs on its own OperationContext. If timeout is non-zero, that
+     * OperationContext is interrupted once the collector has run for longer than timeout, so a
+     * collector stalled on a lock reports an error instead of delaying the rest of the sample.
+     *
      * Sample schema:
      * {
      *    "start" : Date_t,    <- Time at which all collecting started
@@ -105,7 +117,7 @@ public:
      *    "end" : Date_t,      <- Time at which all collecting ended
      * }
      */
-    std::tuple<BSONObj, Date_t> collect(Client* client);
+    std::tuple<BSONObj, Date_t> collect(Client* client, Milliseconds timeout = Milliseconds(0));
 
 private:
     // collection of collectors
@@ -198,7 +198,8 @@ StatusWith<std::tuple<ConstDataRange, Date_t>> FTDCCompressor::getCompressedSamp
     }
 
     auto swDest = _compressor.compress(
-        ConstDataRange(_uncompressedChunkBuffer.buf(), _uncompressedChunkBuffer.len()));
+        ConstDataRange(_uncompressedChunkBuffer.buf(), _uncompressedChunkBuffer.len()),
+        _config->compressionLevel);
 
     // The only way for compression to fail is if the buffer size calculations are wrong
     if (!swDest.isOK()) {
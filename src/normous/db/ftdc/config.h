@@ -46,7 +46,10 @@ struct FTDCConfig {
           maxFileSizeBytes(kMaxFileSizeBytesDefault),
           period(kPeriodMillisDefault),
           maxSamplesPerArchiveMetricChunk(kMaxSamplesPerArchiveMetricChunkDefault),
-          maxSamplesPerInterimMetricChunk(kMaxSamplesPerInterimMetricChunkDefault) {}
+          maxSamplesPerInterimMetricChunk(kMaxSamplesPerInterimMetricChunkDefault),
+          collectorTimeout(kCollectorTimeoutMillisDefault),
+          highFrequencyPeriod(kHighFrequencyPeriodMillisDefault),
+          compressionLevel(kCompressionLevelDefault) {}
 
     /**
      * True if FTDC is collecting data. False otherwise
@@ -83,6 +86,27 @@ struct FTDCConfig {
      */
     std::uint32_t maxSamplesPerInterimMetricChunk;
 
+    /**
+     * Maximum time a single periodic collector may run before it is interrupted. The interrupted
+     * collector reports an error in its place in the sample instead of delaying the others.
+     *
+     * Zero means collectors are never interrupted.
+     */
+    Milliseconds collectorTimeout;
+
+    /**
+     * Period at which to run the high frequency collectors on their own thread.
+     *
+     * Zero disables high frequency collection.
+     */
+    Milliseconds highFrequencyPeriod;
+
+    /**
+     * zlib compression level used for metric chunks, from 1 (fastest) to 9 (smallest), or -1
+     * for zlib's default.
+     */
+    int compressionLevel;
+
     static const bool kEnabledDefault = true;
 
     static const std::int64_t kPeriodMillisDefault;
@@ -93,6 +117,10 @@ struct FTDCConfig {
 
     static const std::uint32_t kMaxSamplesPerArchiveMetricChunkDefault = 300;
     static const std::uint32_t kMaxSamplesPerInterimMetricChunkDefault = 10;
+
+    static const std::int64_t kCollectorTimeoutMillisDefault;
+    static const std::int64_t kHighFrequencyPeriodMillisDefault;
+    static const int kCompressionLevelDefault = -1;
 };
 
 }  // namespace mongo
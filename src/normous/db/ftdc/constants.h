@@ -48,4 +48,7 @@ extern const char kFTDCCollectEndField[];
 
 constexpr StringData kFTDCDefaultDirectory = "diagnostic.data"_sd;
 
+// Subdirectory of the FTDC directory that holds the high frequency collectors' files.
+constexpr StringData kFTDCHighFrequencyDirectory = "highFrequency"_sd;
+
 }  // namespace mongo
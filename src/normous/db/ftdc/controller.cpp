@@ -34,6 +34,7 @@
 
 #include "mongo/db/client.h"
 #include "mongo/db/ftdc/collector.h"
+#include "mongo/db/ftdc/constants.h"
 #include "mongo/db/ftdc/util.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/stdx/condition_variable.h"
@@ -57,7 +58,7 @@ Status FTDCController::setEnabled(bool enabled) {
     }
 
     _configTemp.enabled = enabled;
-    _condvar.notify_one();
+    _condvar.notify_all();
 
     return Status::OK();
 }
@@ -65,31 +66,49 @@ Status FTDCController::setEnabled(bool enabled) {
 void FTDCController::setPeriod(Milliseconds millis) {
     stdx::lock_guard<stdx::mutex> lock(_mutex);
     _configTemp.period = millis;
-    _condvar.notify_one();
+    _condvar.notify_all();
 }
 
 void FTDCController::setMaxDirectorySizeBytes(std::uint64_t size) {
     stdx::lock_guard<stdx::mutex> lock(_mutex);
     _configTemp.maxDirectorySizeBytes = size;
-    _condvar.notify_one();
+    _condvar.notify_all();
 }
 
 void FTDCController::setMaxFileSizeBytes(std::uint64_t size) {
     stdx::lock_guard<stdx::mutex> lock(_mutex);
     _configTemp.maxFileSizeBytes = size;
-    _condvar.notify_one();
+    _condvar.notify_all();
 }
 
 void FTDCController::setMaxSamplesPerArchiveMetricChunk(size_t size) {
     stdx::lock_guard<stdx::mutex> lock(_mutex);
     _configTemp.maxSamplesPerArchiveMetricChunk = size;
-    _condvar.notify_one();
+    _condvar.notify_all();
 }
 
 void FTDCController::setMaxSamplesPerInterimMetricChunk(size_t size) {
     stdx::lock_guard<stdx::mutex> lock(_mutex);
     _configTemp.maxSamplesPerInterimMetricChunk = size;
-    _condvar.notify_one();
+    _condvar.notify_all();
+}
+
+void FTDCController::setCollectorTimeout(Milliseconds millis) {
+    stdx::lock_guard<stdx::mutex> lock(_mutex);
+    _configTemp.collectorTimeout = millis;
+    _condvar.notify_all();
+}
+
+void FTDCController::setHighFrequencyPeriod(Milliseconds millis) {
+    stdx::lock_guard<stdx::mutex> lock(_mutex);
+    _configTemp.highFrequencyPeriod = millis;
+    _condvar.notify_all();
+}
+
+void FTDCController::setCompressionLevel(int level) {
+    stdx::lock_guard<stdx::mutex> lock(_mutex);
+    _configTemp.compressionLevel = level;
+    _condvar.notify_all();
 }
 
 Status FTDCController::setDirectory(const boost::filesystem::path& path) {
@@ -127,6 +146,15 @@ void FTDCController::addOnRotateCollector(std::unique_ptr<FTDCCollectorInterface
     }
 }
 
+void FTDCController::addHighFrequencyCollector(std::unique_ptr<FTDCCollectorInterface> collector) {
+    {
+        stdx::lock_guard<stdx::mutex> lock(_mutex);
+        invariant(_state == State::kNotStarted);
+
+        _highFrequencyCollectors.add(std::move(collector));
+    }
+}
+
 BSONObj FTDCController::getMostRecentPeriodicDocument() {
     {
         stdx::lock_guard<stdx::mutex> lock(_mutex);
@@ -141,6 +169,10 @@ void FTDCController::start() {
     // Start the thread
     _thread = stdx::thread([this] { doLoop(); });
 
+    if (!_highFrequencyCollectors.empty()) {
+        _highFrequencyThread = stdx::thread([this] { doHighFrequencyLoop(); });
+    }
+
     {
         stdx::lock_guard<stdx::mutex> lock(_mutex);
 
@@ -168,11 +200,15 @@ void FTDCController::stop() {
         _state = State::kStopRequested;
 
         // Wake up the thread if sleeping so that it will check if we are done
-        _condvar.notify_one();
+        _condvar.notify_all();
     }
 
     _thread.join();
 
+    if (_highFrequencyThread.joinable()) {
+        _highFrequencyThread.join();
+    }
+
     _state = State::kDone;
 
     if (_mgr) {
@@ -181,6 +217,13 @@ void FTDCController::stop() {
             log() << "Failed to close full-time diagnostic data capture file manager: " << s;
         }
     }
+
+    if (_highFrequencyMgr) {
+        auto s = _highFrequencyMgr->close();
+        if (!s.isOK()) {
+            log() << "Failed to close high frequency diagnostic data capture file manager: " << s;
+        }
+    }
 }
 
 void FTDCController::doLoop() {
@@ -241,7 +284,8 @@ void FTDCController::doLoop() {
                     _mgr = uassertStatusOK(std::move(swMgr));
                 }
 
-                auto collectSample = _periodicCollectors.collect(client);
+                auto collectSample =
+                    _periodicCollectors.collect(client, _config.collectorTimeout);
 
                 Status s = _mgr->writeSampleAndRotateIfNeeded(
                     client, std::get<0>(collectSample), std::get<1>(collectSample));
@@ -262,4 +306,67 @@ void FTDCController::doLoop() {
     }
 }
 
+void FTDCController::doHighFrequencyLoop() {
+    try {
+        {
+            stdx::lock_guard<stdx::mutex> lock(_mutex);
+            _highFrequencyConfig = _configTemp;
+        }
+
+        Client::initThread("ftdcHighFrequency");
+        Client* client = &cc();
+
+        while (true) {
+            {
+                stdx::unique_lock<stdx::mutex> lock(_mutex);
+                MONGO_IDLE_THREAD_BLOCK;
+
+                auto status = stdx::cv_status::no_timeout;
+                auto period = _highFrequencyConfig.highFrequencyPeriod;
+                if (period > Milliseconds(0)) {
+                    auto now = getGlobalServiceContext()->getPreciseClockSource()->now();
+                    auto next_time = FTDCUtil::roundTime(now, period);
+                    status = _condvar.wait_until(lock, next_time.toSystemTimePoint());
+                } else {
+                    // Disabled, so sleep until the configuration changes or we are stopped.
+                    _condvar.wait(lock);
+                }
+
+                if (_state == State::kStopRequested) {
+                    break;
+                }
+
+                _highFrequencyConfig = _configTemp;
+
+                if (status == stdx::cv_status::no_timeout) {
+                    continue;
+                }
+            }
+
+            if (_highFrequencyConfig.enabled) {
+                if (!_highFrequencyMgr) {
+                    auto swMgr =
+                        FTDCFileManager::create(&_highFrequencyConfig,
+                                                _path / kFTDCHighFrequencyDirectory.toString(),
+                                                &_highFrequencyRotateCollectors,
+                                                client);
+
+                    _highFrequencyMgr = uassertStatusOK(std::move(swMgr));
+                }
+
+                auto collectSample = _highFrequencyCollectors.collect(client);
+
+                Status s = _highFrequencyMgr->writeSampleAndRotateIfNeeded(
+                    client, std::get<0>(collectSample), std::get<1>(collectSample));
+
+                uassertStatusOK(s);
+            }
+        }
+    } catch (...) {
+        warning() << "Uncaught exception in '" << exceptionToStatus()
+                  << "' in high frequency diagnostic data capture. Shutting down high frequency "
+                     "diagnostic data capture.";
+    }
+}
+
 }  // namespace mongo
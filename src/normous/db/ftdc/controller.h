@@ -56,7 +56,10 @@ class FTDCController {
 
 public:
     FTDCController(const boost::filesystem::path path, FTDCConfig config)
-        : _path(path), _config(std::move(config)), _configTemp(_config) {}
+        : _path(path),
+          _config(std::move(config)),
+          _configTemp(_config),
+          _highFrequencyConfig(_config) {}
 
     ~FTDCController() = default;
 
@@ -98,6 +101,21 @@ public:
      */
     void setMaxSamplesPerInterimMetricChunk(size_t size);
 
+    /**
+     * Set the maximum time a periodic collector may run before it is interrupted.
+     */
+    void setCollectorTimeout(Milliseconds millis);
+
+    /**
+     * Set the period for high frequency data collection. Zero disables it.
+     */
+    void setHighFrequencyPeriod(Milliseconds millis);
+
+    /**
+     * Set the zlib compression level for metric chunks.
+     */
+    void setCompressionLevel(int level);
+
     /*
      * Set the path to store FTDC files if not already set.
      *
@@ -117,10 +135,19 @@ public:
      */
     void addOnRotateCollector(std::unique_ptr<FTDCCollectorInterface> collector);
 
+    /**
+     * Add a metric collector to collect on the high frequency period, i.e. counters.
+     *
+     * High frequency collectors run on their own thread and are written to their own files in
+     * the kFTDCHighFrequencyDirectory subdirectory, so a slow periodic collector does not delay
+     * them. They must be cheap and must not take locks.
+     */
+    void addHighFrequencyCollector(std::unique_ptr<FTDCCollectorInterface> collector);
+
     /**
      * Start the controller.
      *
-     * Spawns a new thread.
+     * Spawns a new thread, and a second one if any high frequency collectors were added.
      */
     void start();
 
@@ -147,6 +174,11 @@ private:
      */
     void doLoop();
 
+    /**
+     * Do high frequency statistics collection on its own background thread.
+     */
+    void doHighFrequencyLoop();
+
 private:
     /**
     * Private enum to track state.
@@ -211,6 +243,23 @@ private:
 
     // Background collection and writing thread
     stdx::thread _thread;
+
+    // Config settings used by the high frequency thread and its file manager.
+    // Copied from _configTemp periodically, like _config.
+    FTDCConfig _highFrequencyConfig;
+
+    // Set of high frequency collectors
+    FTDCCollectorCollection _highFrequencyCollectors;
+
+    // The high frequency files are not stamped with any file rotation collectors, the periodic
+    // files already have them. Always empty.
+    FTDCCollectorCollection _highFrequencyRotateCollectors;
+
+    // File manager for the high frequency files
+    std::unique_ptr<FTDCFileManager> _highFrequencyMgr;
+
+    // Background high frequency collection and writing thread
+    stdx::thread _highFrequencyThread;
 };
 
 }  // namespace mongo
@@ -207,6 +207,63 @@ TEST_F(FTDCControllerTest, TestFull) {
     ValidateDocumentList(alog, allDocs, FTDCValidationMode::kStrict);
 }
 
+// Test the high frequency collectors run on their own thread and are logged to their own directory
+TEST_F(FTDCControllerTest, TestHighFrequency) {
+    unittest::TempDir tempdir("metrics_testpath");
+    boost::filesystem::path dir(tempdir.path());
+
+    createDirectoryClean(dir);
+
+    FTDCConfig config;
+    config.enabled = true;
+    config.period = Milliseconds(1);
+    config.highFrequencyPeriod = Milliseconds(1);
+    config.maxFileSizeBytes = FTDCConfig::kMaxFileSizeBytesDefault;
+    config.maxDirectorySizeBytes = FTDCConfig::kMaxDirectorySizeBytesDefault;
+
+    FTDCController c(dir, config);
+
+    auto c1 = stdx::make_unique<FTDCMetricsCollectorMock2>();
+    auto c2 = stdx::make_unique<FTDCMetricsCollectorMock2>();
+
+    auto c1Ptr = c1.get();
+    auto c2Ptr = c2.get();
+
+    c1Ptr->setSignalOnCount(50);
+    c2Ptr->setSignalOnCount(50);
+
+    c.addPeriodicCollector(std::move(c1));
+
+    c.addHighFrequencyCollector(std::move(c2));
+
+    c.start();
+
+    // Wait for 50 samples to have occured on both threads
+    c1Ptr->wait();
+    c2Ptr->wait();
+
+    c.stop();
+
+    auto docsPeriodic = c1Ptr->getDocs();
+    ASSERT_GREATER_THAN_OR_EQUALS(docsPeriodic.size(), 50UL);
+
+    auto docsHighFrequency = c2Ptr->getDocs();
+    ASSERT_GREATER_THAN_OR_EQUALS(docsHighFrequency.size(), 50UL);
+
+    // The directory holds the high frequency subdirectory and the periodic archive file
+    auto files = scanDirectory(dir);
+
+    ASSERT_EQUALS(files.size(), 2UL);
+
+    ValidateDocumentList(files[1], docsPeriodic, FTDCValidationMode::kStrict);
+
+    auto highFrequencyFiles = scanDirectory(dir / kFTDCHighFrequencyDirectory.toString());
+
+    ASSERT_EQUALS(highFrequencyFiles.size(), 1UL);
+
+    ValidateDocumentList(highFrequencyFiles[0], docsHighFrequency, FTDCValidationMode::kStrict);
+}
+
 // Test we can start and stop the controller in quick succession, make sure it succeeds without
 // assert or fault
 TEST_F(FTDCControllerTest, TestStartStop) {
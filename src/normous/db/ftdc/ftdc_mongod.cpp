@@ -35,12 +35,31 @@
 #include "mongo/db/ftdc/constants.h"
 #include "mongo/db/ftdc/controller.h"
 #include "mongo/db/ftdc/ftdc_server.h"
+#include "mongo/db/query/query_stats_store.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/storage/storage_options.h"
 
 namespace mongo {
 
 namespace {
+
+// The number of query shapes, by total execution time, whose statistics are recorded.
+const size_t kFTDCQueryStatsTopShapes = 10;
+
+/**
+ * Collects a summary of the QueryStatsStore and the statistics of its most expensive shapes.
+ */
+class FTDCQueryStatsCollector final : public FTDCCollectorInterface {
+public:
+    void collect(OperationContext* opCtx, BSONObjBuilder& builder) override {
+        QueryStatsStore::get(opCtx).appendSummary(kFTDCQueryStatsTopShapes, &builder);
+    }
+
+    std::string name() const override {
+        return "queryStats";
+    }
+};
+
 void registerMongoDCollectors(FTDCController* controller) {
     // These metrics are only collected if replication is enabled
     if (repl::ReplicationCoordinator::get(getGlobalServiceContext())->getReplicationMode() !=
@@ -57,6 +76,11 @@ void registerMongoDCollectors(FTDCController* controller) {
                                                                   BSON("collStats"
                                                                        << "oplog.rs")));
     }
+
+    // Query shape statistics are only collected while the store is enabled at startup.
+    if (QueryStatsStore::isEnabled()) {
+        controller->addPeriodicCollector(stdx::make_unique<FTDCQueryStatsCollector>());
+    }
 }
 
 }  // namespace
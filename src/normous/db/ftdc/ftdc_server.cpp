@@ -44,6 +44,7 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/stats/counters.h"
 #include "mongo/stdx/memory.h"
 
 namespace mongo {
@@ -241,6 +242,109 @@ public:
     }
 
 } exportedFTDCInterimChunkSizeParameter;
+
+AtomicInt32 localCollectorTimeoutMillis(FTDCConfig::kCollectorTimeoutMillisDefault);
+
+class ExportedFTDCCollectorTimeoutParameter
+    : public ExportedServerParameter<std::int32_t, ServerParameterType::kStartupAndRuntime> {
+public:
+    ExportedFTDCCollectorTimeoutParameter()
+        : ExportedServerParameter<std::int32_t, ServerParameterType::kStartupAndRuntime>(
+              ServerParameterSet::getGlobal(),
+              "diagnosticDataCollectionCollectorTimeoutMillis",
+              &localCollectorTimeoutMillis) {}
+
+    virtual Status validate(const std::int32_t& potentialNewValue) {
+        if (potentialNewValue < 0) {
+            return Status(ErrorCodes::BadValue,
+                          "diagnosticDataCollectionCollectorTimeoutMillis must be greater than or "
+                          "equal to 0");
+        }
+
+        auto controller = getGlobalFTDCController();
+        if (controller) {
+            controller->setCollectorTimeout(Milliseconds(potentialNewValue));
+        }
+
+        return Status::OK();
+    }
+
+} exportedFTDCCollectorTimeoutParameter;
+
+AtomicInt32 localHighFrequencyPeriodMillis(FTDCConfig::kHighFrequencyPeriodMillisDefault);
+
+class ExportedFTDCHighFrequencyPeriodParameter
+    : public ExportedServerParameter<std::int32_t, ServerParameterType::kStartupAndRuntime> {
+public:
+    ExportedFTDCHighFrequencyPeriodParameter()
+        : ExportedServerParameter<std::int32_t, ServerParameterType::kStartupAndRuntime>(
+              ServerParameterSet::getGlobal(),
+              "diagnosticDataCollectionHighFrequencyPeriodMillis",
+              &localHighFrequencyPeriodMillis) {}
+
+    virtual Status validate(const std::int32_t& potentialNewValue) {
+        if (potentialNewValue != 0 && potentialNewValue < 10) {
+            return Status(ErrorCodes::BadValue,
+                          "diagnosticDataCollectionHighFrequencyPeriodMillis must be 0 to disable "
+                          "high frequency collection, or greater than or equal to 10ms");
+        }
+
+        auto controller = getGlobalFTDCController();
+        if (controller) {
+            controller->setHighFrequencyPeriod(Milliseconds(potentialNewValue));
+        }
+
+        return Status::OK();
+    }
+
+} exportedFTDCHighFrequencyPeriodParameter;
+
+AtomicInt32 localCompressionLevel(FTDCConfig::kCompressionLevelDefault);
+
+class ExportedFTDCCompressionLevelParameter
+    : public ExportedServerParameter<std::int32_t, ServerParameterType::kStartupAndRuntime> {
+public:
+    ExportedFTDCCompressionLevelParameter()
+        : ExportedServerParameter<std::int32_t, ServerParameterType::kStartupAndRuntime>(
+              ServerParameterSet::getGlobal(),
+              "diagnosticDataCollectionCompressionLevel",
+              &localCompressionLevel) {}
+
+    virtual Status validate(const std::int32_t& potentialNewValue) {
+        if (potentialNewValue < -1 || potentialNewValue > 9) {
+            return Status(ErrorCodes::BadValue,
+                          "diagnosticDataCollectionCompressionLevel must be between -1 and 9");
+        }
+
+        auto controller = getGlobalFTDCController();
+        if (controller) {
+            controller->setCompressionLevel(potentialNewValue);
+        }
+
+        return Status::OK();
+    }
+
+} exportedFTDCCompressionLevelParameter;
+
+/**
+ * Collects the operation and network counters without running serverStatus, so it takes no locks
+ * and is cheap enough to run on the high frequency period.
+ */
+class FTDCCountersCollector final : public FTDCCollectorInterface {
+public:
+    void collect(OperationContext* opCtx, BSONObjBuilder& builder) override {
+        builder.append("opcounters", globalOpCounters.getObj());
+        builder.append("opcountersRepl", replOpCounters.getObj());
+
+        BSONObjBuilder networkBuilder(builder.subobjStart("network"));
+        networkCounter.append(networkBuilder);
+    }
+
+    std::string name() const override {
+        return "counters";
+    }
+};
+
 }  // namespace
 
 FTDCSimpleInternalCommandCollector::FTDCSimpleInternalCommandCollector(StringData command,
@@ -278,6 +382,9 @@ void startFTDC(boost::filesystem::path& path,
     config.maxDirectorySizeBytes = localMaxDirectorySizeMB.load() * 1024 * 1024;
     config.maxSamplesPerArchiveMetricChunk = localMaxSamplesPerArchiveMetricChunk.load();
     config.maxSamplesPerInterimMetricChunk = localMaxSamplesPerInterimMetricChunk.load();
+    config.collectorTimeout = Milliseconds(localCollectorTimeoutMillis.load());
+    config.highFrequencyPeriod = Milliseconds(localHighFrequencyPeriodMillis.load());
+    config.compressionLevel = localCompressionLevel.load();
 
     auto controller = stdx::make_unique<FTDCController>(path, config);
 
@@ -305,6 +412,10 @@ void startFTDC(boost::filesystem::path& path,
     // Install System Metric Collector as a periodic collector
     installSystemMetricsCollector(controller.get());
 
+    // Install high frequency collectors
+    // These are collected on the high frequency period in FTDCConfig, on their own thread.
+    controller->addHighFrequencyCollector(stdx::make_unique<FTDCCountersCollector>());
+
     // Install file rotation collectors
     // These are collected on each file rotation.
 
@@ -264,6 +264,8 @@ void FTSLanguage::registerLanguageAlias(const FTSLanguage* language,
 
 FTSLanguage::FTSLanguage() : _canonicalName() {}
 
+FTSLanguage::~FTSLanguage() = default;
+
 const std::string& FTSLanguage::str() const {
     verify(!_canonicalName.empty());
     return _canonicalName;
@@ -300,6 +302,26 @@ StatusWithFTSLanguage FTSLanguage::make(StringData langName, TextIndexVersion te
     }
 }
 
+PooledTokenizer FTSLanguage::borrowTokenizer() const {
+    {
+        stdx::lock_guard<stdx::mutex> lk(_tokenizerPoolMutex);
+        if (!_tokenizerPool.empty()) {
+            PooledTokenizer tokenizer(_tokenizerPool.back().release(), TokenizerReturner{this});
+            _tokenizerPool.pop_back();
+            return tokenizer;
+        }
+    }
+    return PooledTokenizer(createTokenizer().release(), TokenizerReturner{this});
+}
+
+void TokenizerReturner::operator()(FTSTokenizer* tokenizer) const {
+    std::unique_ptr<FTSTokenizer> owned(tokenizer);
+    stdx::lock_guard<stdx::mutex> lk(language->_tokenizerPoolMutex);
+    if (language->_tokenizerPool.size() < FTSLanguage::kMaxPooledTokenizers) {
+        language->_tokenizerPool.push_back(std::move(owned));
+    }
+}
+
 std::unique_ptr<FTSTokenizer> BasicFTSLanguage::createTokenizer() const {
     return stdx::make_unique<BasicFTSTokenizer>(this);
 }
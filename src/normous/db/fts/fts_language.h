@@ -35,15 +35,31 @@
 #include "mongo/db/fts/fts_phrase_matcher.h"
 #include "mongo/db/fts/fts_unicode_phrase_matcher.h"
 #include "mongo/db/fts/fts_util.h"
+#include "mongo/stdx/mutex.h"
 
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace mongo {
 
 namespace fts {
 
+class FTSLanguage;
 class FTSTokenizer;
 
+/**
+ * Deleter for tokenizers handed out by FTSLanguage::borrowTokenizer(), which returns them to the
+ * language's pool rather than destroying them.
+ */
+struct TokenizerReturner {
+    void operator()(FTSTokenizer* tokenizer) const;
+
+    const FTSLanguage* language;
+};
+
+using PooledTokenizer = std::unique_ptr<FTSTokenizer, TokenizerReturner>;
+
 // Legacy language initialization.
 #define MONGO_FTS_LANGUAGE_DECLARE(language, name, version)                                    \
     BasicFTSLanguage language;                                                                 \
@@ -76,7 +92,7 @@ public:
     /** Create an uninitialized language. */
     FTSLanguage();
 
-    virtual ~FTSLanguage() {}
+    virtual ~FTSLanguage();
 
     /**
      * Returns the language as a std::string in canonical form (lowercased English name).  It is
@@ -90,6 +106,13 @@ public:
      */
     virtual std::unique_ptr<FTSTokenizer> createTokenizer() const = 0;
 
+    /**
+     * Returns a tokenizer for this language taken from a pool of idle tokenizers, creating one if
+     * the pool is empty. The tokenizer goes back to the pool when the returned pointer is
+     * destroyed, so that the buffers and stem cache it built up are reused by the next document.
+     */
+    PooledTokenizer borrowTokenizer() const;
+
     /**
      * Returns a reference to the phrase matcher instance that this language owns.
      */
@@ -132,8 +155,16 @@ public:
                                                TextIndexVersion textIndexVersion);
 
 private:
+    friend struct TokenizerReturner;
+
+    // Maximum number of idle tokenizers kept by each language.
+    static const size_t kMaxPooledTokenizers = 16;
+
     // std::string representation of language in canonical form.
     std::string _canonicalName;
+
+    mutable stdx::mutex _tokenizerPoolMutex;
+    mutable std::vector<std::unique_ptr<FTSTokenizer>> _tokenizerPool;
 };
 
 typedef StatusWith<const FTSLanguage*> StatusWithFTSLanguage;
@@ -80,7 +80,7 @@ bool FTSMatcher::hasPositiveTerm(const BSONObj& obj) const {
 }
 
 bool FTSMatcher::_hasPositiveTerm_string(const FTSLanguage* language, const string& raw) const {
-    std::unique_ptr<FTSTokenizer> tokenizer(language->createTokenizer());
+    PooledTokenizer tokenizer = language->borrowTokenizer();
     tokenizer->reset(raw.c_str(), _getTokenizerOptions());
 
     while (tokenizer->moveNext()) {
@@ -110,7 +110,7 @@ bool FTSMatcher::hasNegativeTerm(const BSONObj& obj) const {
 }
 
 bool FTSMatcher::_hasNegativeTerm_string(const FTSLanguage* language, const string& raw) const {
-    std::unique_ptr<FTSTokenizer> tokenizer(language->createTokenizer());
+    PooledTokenizer tokenizer = language->borrowTokenizer();
     tokenizer->reset(raw.c_str(), _getTokenizerOptions());
 
     while (tokenizer->moveNext()) {
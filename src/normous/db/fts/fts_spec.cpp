@@ -183,7 +183,7 @@ void FTSSpec::scoreDocument(const BSONObj& obj, TermFrequencyMap* term_freqs) co
 
     while (it.more()) {
         FTSIteratorValue val = it.next();
-        std::unique_ptr<FTSTokenizer> tokenizer(val._language->createTokenizer());
+        PooledTokenizer tokenizer = val._language->borrowTokenizer();
         _scoreStringV2(tokenizer.get(), val._text, term_freqs, val._weight);
     }
 }
@@ -35,6 +35,7 @@
 #include "mongo/db/fts/stemmer.h"
 #include "mongo/db/fts/stop_words.h"
 #include "mongo/db/fts/tokenizer.h"
+#include "mongo/db/fts/unicode/byte_vector.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/stringutils.h"
@@ -52,12 +53,35 @@ UnicodeFTSTokenizer::UnicodeFTSTokenizer(const FTSLanguage* language)
                              ? unicode::DelimiterListLanguage::kEnglish
                              : unicode::DelimiterListLanguage::kNotEnglish),
       _caseFoldMode(_language->str() == "turkish" ? unicode::CaseFoldMode::kTurkish
-                                                  : unicode::CaseFoldMode::kNormal) {}
+                                                  : unicode::CaseFoldMode::kNormal) {
+    for (char32_t c = 0; c < _asciiDelimiters.size(); ++c) {
+        _asciiDelimiters[c] = unicode::codepointIsDelimiter(c, _delimListLanguage);
+    }
+}
 
 void UnicodeFTSTokenizer::reset(StringData document, Options options) {
     _options = options;
     _pos = 0;
-    _document.resetData(document);  // Validates that document is valid UTF8.
+
+    if (_document.size() * sizeof(char32_t) > kMaxRetainedBufferBytes) {
+        _document = unicode::String();
+    }
+    if (_asciiLowerDocument.capacity() > kMaxRetainedBufferBytes) {
+        std::string().swap(_asciiLowerDocument);
+    }
+    if (_asciiDocument.capacity() > kMaxRetainedBufferBytes) {
+        std::string().swap(_asciiDocument);
+    }
+
+    // Turkish lower cases 'I' to a non-ASCII character.
+    _isAscii = _caseFoldMode == unicode::CaseFoldMode::kNormal && _copyAsciiLowerCase(document);
+    if (_isAscii) {
+        if (_options & kGenerateCaseSensitiveTokens) {
+            _asciiDocument.assign(document.rawData(), document.size());
+        }
+    } else {
+        _document.resetData(document);  // Validates that document is valid UTF8.
+    }
 
     // Skip any leading delimiters (and handle the case where the document is entirely delimiters).
     _skipDelimiters();
@@ -65,15 +89,14 @@ void UnicodeFTSTokenizer::reset(StringData document, Options options) {
 
 bool UnicodeFTSTokenizer::moveNext() {
     while (true) {
-        if (_pos >= _document.size()) {
+        if (_pos >= _documentSize()) {
             _word = "";
             return false;
         }
 
         // Traverse through non-delimiters and build the next token.
         size_t start = _pos++;
-        while (_pos < _document.size() &&
-               (!unicode::codepointIsDelimiter(_document[_pos], _delimListLanguage))) {
+        while (_pos < _documentSize() && !_isDelimiterAt(_pos)) {
             ++_pos;
         }
         const size_t len = _pos - start;
@@ -83,14 +106,16 @@ bool UnicodeFTSTokenizer::moveNext() {
 
         // Stop words are case-sensitive and diacritic sensitive, so we need them to be lower cased
         // but with diacritics not removed to check against the stop word list.
-        _word = _document.toLowerToBuf(&_wordBuf, _caseFoldMode, start, len);
+        _word = _isAscii ? StringData(_asciiLowerDocument).substr(start, len)
+                         : _document.toLowerToBuf(&_wordBuf, _caseFoldMode, start, len);
 
         if ((_options & kFilterStopWords) && _stopWords->isStopWord(_word)) {
             continue;
         }
 
         if (_options & kGenerateCaseSensitiveTokens) {
-            _word = _document.substrToBuf(&_wordBuf, start, len);
+            _word = _isAscii ? StringData(_asciiDocument).substr(start, len)
+                             : _document.substrToBuf(&_wordBuf, start, len);
         }
 
         // The stemmer is diacritic sensitive, so stem the word before removing diacritics.
@@ -111,11 +136,40 @@ StringData UnicodeFTSTokenizer::get() const {
 }
 
 void UnicodeFTSTokenizer::_skipDelimiters() {
-    while (_pos < _document.size() &&
-           unicode::codepointIsDelimiter(_document[_pos], _delimListLanguage)) {
+    while (_pos < _documentSize() && _isDelimiterAt(_pos)) {
         ++_pos;
     }
 }
 
+bool UnicodeFTSTokenizer::_copyAsciiLowerCase(StringData document) {
+    const char* in = document.rawData();
+    const size_t size = document.size();
+    _asciiLowerDocument.resize(size);
+    char* out = &_asciiLowerDocument[0];
+
+    size_t i = 0;
+#ifdef MONGO_HAVE_FAST_BYTE_VECTOR
+    for (; i + unicode::ByteVector::size <= size; i += unicode::ByteVector::size) {
+        auto word = unicode::ByteVector::load(in + i);
+        if (word.maskHigh()) {
+            return false;
+        }
+
+        // 0xFF for each byte in word that is uppercase, 0x00 for all others.
+        auto uppercaseMask = word.compareGT('A' - 1) & word.compareLT('Z' + 1);
+        word |= (uppercaseMask & unicode::ByteVector(0x20));  // Set the ascii lowercase bit.
+        word.store(out + i);
+    }
+#endif
+    for (; i < size; ++i) {
+        const uint8_t c = in[i];
+        if (c > 0x7f) {
+            return false;
+        }
+        out[i] = (c >= 'A' && c <= 'Z') ? (c | 0x20) : c;
+    }
+    return true;
+}
+
 }  // namespace fts
 }  // namespace mongo
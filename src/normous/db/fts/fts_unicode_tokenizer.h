@@ -28,11 +28,15 @@
 
 #pragma once
 
+#include <array>
+#include <string>
+
 #include "mongo/base/disallow_copying.h"
 #include "mongo/base/string_data.h"
 #include "mongo/db/fts/fts_tokenizer.h"
 #include "mongo/db/fts/stemmer.h"
 #include "mongo/db/fts/tokenizer.h"
+#include "mongo/db/fts/unicode/codepoints.h"
 #include "mongo/db/fts/unicode/string.h"
 
 namespace mongo {
@@ -73,12 +77,43 @@ private:
      */
     void _skipDelimiters();
 
+    /**
+     * Copies 'document' lower cased into '_asciiLowerDocument', 16 bytes at a time where the
+     * platform allows. Returns false, leaving '_asciiLowerDocument' unspecified, if 'document' is
+     * not entirely ASCII.
+     */
+    bool _copyAsciiLowerCase(StringData document);
+
+    bool _isDelimiterAt(size_t pos) const {
+        return _isAscii ? _asciiDelimiters[static_cast<unsigned char>(_asciiLowerDocument[pos])]
+                        : unicode::codepointIsDelimiter(_document[pos], _delimListLanguage);
+    }
+
+    size_t _documentSize() const {
+        return _isAscii ? _asciiLowerDocument.size() : _document.size();
+    }
+
+    // Tokenizers are reused across documents, so buffers grown beyond this size by one document are
+    // released before tokenizing the next.
+    static const size_t kMaxRetainedBufferBytes = 1024 * 1024;
+
     const FTSLanguage* const _language;
     const Stemmer _stemmer;
     const StopWords* const _stopWords;
     const unicode::DelimiterListLanguage _delimListLanguage;
     const unicode::CaseFoldMode _caseFoldMode;
 
+    // Whether each ASCII character is a delimiter in '_delimListLanguage'.
+    std::array<bool, 128> _asciiDelimiters;
+
+    // Documents made up only of ASCII are tokenized bytewise, without being decoded into
+    // '_document', unless the language case folds ASCII specially. Such a document is kept lower
+    // cased in '_asciiLowerDocument' and, if case sensitive tokens are requested, as is in
+    // '_asciiDocument'.
+    bool _isAscii = false;
+    std::string _asciiDocument;
+    std::string _asciiLowerDocument;
+
     unicode::String _document;
     size_t _pos;
     StringData _word;
@@ -241,5 +241,66 @@ TEST(FtsUnicodeTokenizer, FrenchStopWordsAndDiacriticSensitive) {
     ASSERT_EQUALS("excit", terms[4]);
 }
 
+// Ensure that documents entirely made up of ASCII tokenize the same as documents that also contain
+// non-ASCII characters.
+TEST(FtsUnicodeTokenizer, AsciiAndNonAsciiDocumentsTokenizeAlike) {
+    std::vector<std::string> asciiTerms = tokenizeString(
+        "The QUICK brown Fox's runs_over^the `lazy` dog", "english", FTSTokenizer::kNone);
+    std::vector<std::string> mixedTerms = tokenizeString(
+        "The QUICK brown Fox's runs_over^the `lazy` dog é", "english", FTSTokenizer::kNone);
+
+    ASSERT_EQUALS(asciiTerms.size() + 1, mixedTerms.size());
+    for (size_t i = 0; i < asciiTerms.size(); ++i) {
+        ASSERT_EQUALS(asciiTerms[i], mixedTerms[i]);
+    }
+    ASSERT_EQUALS("e", mixedTerms.back());
+}
+
+// Ensure that case sensitive tokens keep their case for documents made up only of ASCII.
+TEST(FtsUnicodeTokenizer, AsciiCaseSensitive) {
+    std::vector<std::string> terms = tokenizeString(
+        "Do you see Mark's DOG running?", "english", FTSTokenizer::kGenerateCaseSensitiveTokens);
+
+    ASSERT_EQUALS(6U, terms.size());
+    ASSERT_EQUALS("Do", terms[0]);
+    ASSERT_EQUALS("you", terms[1]);
+    ASSERT_EQUALS("see", terms[2]);
+    ASSERT_EQUALS("Mark", terms[3]);
+    ASSERT_EQUALS("DOG", terms[4]);
+    ASSERT_EQUALS("run", terms[5]);
+}
+
+// Ensure that Turkish, which case folds 'I' outside of ASCII, does not take the ASCII path.
+TEST(FtsUnicodeTokenizer, TurkishAsciiDocument) {
+    std::vector<std::string> terms = tokenizeString("KIRMIZI", "turkish", FTSTokenizer::kNone);
+
+    ASSERT_EQUALS(1U, terms.size());
+    ASSERT_NOT_EQUALS("kirmizi", terms[0]);
+}
+
+// Ensure that a tokenizer reset between ASCII and non-ASCII documents tokenizes each correctly.
+TEST(FtsUnicodeTokenizer, ResetBetweenAsciiAndNonAsciiDocuments) {
+    StatusWithFTSLanguage swl = FTSLanguage::make("french", TEXT_INDEX_VERSION_3);
+    ASSERT_OK(swl);
+    UnicodeFTSTokenizer tokenizer(swl.getValue());
+
+    const std::vector<std::string> documents = {
+        "Chat NOIR", "énervé Chien", "Chat NOIR", std::string(100, 'B')};
+    std::vector<std::vector<std::string>> expected = {
+        {"chat", "noir"}, {"enerv", "chien"}, {"chat", "noir"}, {std::string(100, 'b')}};
+
+    for (size_t i = 0; i < documents.size(); ++i) {
+        tokenizer.reset(documents[i], FTSTokenizer::kNone);
+        std::vector<std::string> terms;
+        while (tokenizer.moveNext()) {
+            terms.push_back(tokenizer.get().toString());
+        }
+        ASSERT_EQUALS(expected[i].size(), terms.size());
+        for (size_t j = 0; j < terms.size(); ++j) {
+            ASSERT_EQUALS(expected[i][j], terms[j]);
+        }
+    }
+}
+
 }  // namespace fts
 }  // namespace mongo
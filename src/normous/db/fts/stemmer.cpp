@@ -37,7 +37,7 @@ namespace mongo {
 
 namespace fts {
 
-Stemmer::Stemmer(const FTSLanguage* language) {
+Stemmer::Stemmer(const FTSLanguage* language) : _stemCache(kStemCacheSize) {
     _stemmer = NULL;
     if (language->str() != "none")
         _stemmer = sb_stemmer_new(language->str().c_str(), "UTF_8");
@@ -54,6 +54,16 @@ StringData Stemmer::stem(StringData word) const {
     if (!_stemmer)
         return word;
 
+    const bool cacheable = word.size() <= kMaxCachedWordSize;
+    std::string key;
+    if (cacheable) {
+        key = word.toString();
+        auto it = _stemCache.find(key);
+        if (it != _stemCache.end()) {
+            return it->second;
+        }
+    }
+
     const sb_symbol* sb_sym =
         sb_stemmer_stem(_stemmer, (const sb_symbol*)word.rawData(), word.size());
 
@@ -62,7 +72,14 @@ StringData Stemmer::stem(StringData word) const {
         MONGO_UNREACHABLE;
     }
 
-    return StringData((const char*)(sb_sym), sb_stemmer_length(_stemmer));
+    StringData stemmed((const char*)(sb_sym), sb_stemmer_length(_stemmer));
+    if (!cacheable) {
+        return stemmed;
+    }
+
+    // The newest entry is at the front of the cache, and is not evicted by adding it.
+    _stemCache.add(std::move(key), stemmed.toString());
+    return _stemCache.begin()->second;
 }
 }
 }
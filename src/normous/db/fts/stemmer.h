@@ -31,8 +31,11 @@
 
 #pragma once
 
+#include <string>
+
 #include "mongo/base/string_data.h"
 #include "mongo/db/fts/fts_language.h"
+#include "mongo/util/lru_cache.h"
 #include "third_party/libstemmer_c/include/libstemmer.h"
 
 namespace mongo {
@@ -61,7 +64,15 @@ public:
     StringData stem(StringData word) const;
 
 private:
+    // The number of recently stemmed words to remember, and the longest word worth remembering.
+    static const size_t kStemCacheSize = 1024;
+    static const size_t kMaxCachedWordSize = 32;
+
     struct sb_stemmer* _stemmer;
+
+    // Maps recently stemmed words to their stems, since natural language text repeats a small
+    // vocabulary and stemming is much more expensive than a hash lookup.
+    mutable LRUCache<std::string, std::string> _stemCache;
 };
 }
 }
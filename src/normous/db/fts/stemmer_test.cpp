@@ -48,5 +48,18 @@ TEST(English, Caps) {
     ASSERT_EQUALS("unit", s.stem("united"));
     ASSERT_EQUALS("Unite", s.stem("United"));
 }
+
+TEST(English, CachedStems) {
+    Stemmer s(&languageEnglishV2);
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_EQUALS("run", s.stem("running"));
+        ASSERT_EQUALS("jump", s.stem("jumping"));
+    }
+
+    // Words too long to be cached are still stemmed.
+    const std::string longWord = std::string(64, 'a') + "ing";
+    ASSERT_EQUALS(std::string(64, 'a'), s.stem(longWord));
+    ASSERT_EQUALS(std::string(64, 'a'), s.stem(longWord));
+}
 }
 }
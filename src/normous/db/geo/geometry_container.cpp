@@ -30,7 +30,9 @@
 
 #include "mongo/db/geo/geoconstants.h"
 #include "mongo/db/geo/geoparser.h"
+#include "mongo/stdx/memory.h"
 #include "mongo/util/mongoutils/str.h"
+#include "third_party/s2/s2regioncoverer.h"
 #include "mongo/util/transitional_tools_do_not_use/vector_spooling.h"
 
 namespace mongo {
@@ -372,7 +374,78 @@ bool containsPoint(const S2Polygon& poly, const S2Cell& otherCell, const S2Point
     return poly.MayIntersect(otherCell);
 }
 
+namespace {
+
+// Polygons with fewer vertices than this are cheap enough to test edge by edge that building
+// coverings for them would not pay for itself.
+const int kMinVerticesForCoverings = 64;
+
+// The number of cells in each covering. The coverings are built once per query geometry, and
+// more cells make them hug the boundary more closely, so fewer points fall through to the exact
+// test.
+const int kMaxCoveringCells = 64;
+
+}  // namespace
+
+bool GeometryContainer::containsByCovering(const S2Cell& otherCell, bool* contained) const {
+    if (!_coveringsPrepared) {
+        _coveringsPrepared = true;
+
+        const S2Region* region = nullptr;
+        int numVertices = 0;
+        if (NULL != _polygon && NULL != _polygon->s2Polygon) {
+            region = _polygon->s2Polygon.get();
+            numVertices = _polygon->s2Polygon->num_vertices();
+        } else if (NULL != _multiPolygon) {
+            region = _s2Region.get();
+            for (const S2Polygon* poly : _multiPolygon->polygons.vector()) {
+                numVertices += poly->num_vertices();
+            }
+        }
+
+        if (region && numVertices >= kMinVerticesForCoverings) {
+            S2RegionCoverer coverer;
+            coverer.set_max_cells(kMaxCoveringCells);
+            _interiorCovering = stdx::make_unique<S2CellUnion>();
+            coverer.GetInteriorCellUnion(*region, _interiorCovering.get());
+            _exteriorCovering = stdx::make_unique<S2CellUnion>();
+            coverer.GetCellUnion(*region, _exteriorCovering.get());
+        }
+    }
+
+    if (!_exteriorCovering) {
+        return false;
+    }
+
+    const S2CellId cellId = otherCell.id();
+    if (_interiorCovering->Contains(cellId)) {
+        *contained = true;
+        return true;
+    }
+
+    // The exact test also accepts cells that merely touch a polygon's boundary, so a cell can only
+    // be rejected if neither it nor any of the cells touching it is in the exterior covering.
+    if (_exteriorCovering->Intersects(cellId)) {
+        return false;
+    }
+    std::vector<S2CellId> neighbors;
+    cellId.AppendAllNeighbors(cellId.level(), &neighbors);
+    for (const auto& neighbor : neighbors) {
+        if (_exteriorCovering->Intersects(neighbor)) {
+            return false;
+        }
+    }
+
+    *contained = false;
+    return true;
+}
+
 bool GeometryContainer::contains(const S2Cell& otherCell, const S2Point& otherPoint) const {
+    bool contained;
+    if (containsByCovering(otherCell, &contained)) {
+        return contained;
+    }
+
     if (NULL != _polygon && (NULL != _polygon->s2Polygon)) {
         return containsPoint(*_polygon->s2Polygon, otherCell, otherPoint);
     }
@@ -32,6 +32,7 @@
 
 #include "mongo/base/disallow_copying.h"
 #include "mongo/db/geo/shapes.h"
+#include "third_party/s2/s2cellunion.h"
 #include "third_party/s2/s2regionunion.h"
 
 namespace mongo {
@@ -143,6 +144,12 @@ private:
     bool contains(const S2Polyline& otherLine) const;
     bool contains(const S2Polygon& otherPolygon) const;
 
+    // Returns true and sets '*contained' if the coverings of a large polygon or multi-polygon
+    // settle whether it contains 'otherCell', so that the point need not be tested against every
+    // edge. The coverings are built by the first call for such a geometry, which makes this
+    // method, and so contains(), unsafe to call concurrently on the same container.
+    bool containsByCovering(const S2Cell& otherCell, bool* contained) const;
+
     // Only one of these shared_ptrs should be non-NULL.  S2Region is a
     // superclass but it only supports testing against S2Cells.  We need
     // the most specific class we can get.
@@ -160,6 +167,12 @@ private:
     // TODO: _s2Region is currently generated immediately - don't necessarily need to do this
     std::unique_ptr<S2RegionUnion> _s2Region;
     std::unique_ptr<R2Region> _r2Region;
+
+    // Cells contained in, and cells covering, the polygons of this geometry. Built lazily by
+    // containsByCovering().
+    mutable bool _coveringsPrepared = false;
+    mutable std::unique_ptr<S2CellUnion> _interiorCovering;
+    mutable std::unique_ptr<S2CellUnion> _exteriorCovering;
 };
 
 }  // namespace mongo
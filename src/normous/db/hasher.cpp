@@ -36,8 +36,10 @@
 
 
 #include "mongo/db/jsobj.h"
+#include "mongo/util/assert_util.h"
 #include "mongo/util/md5.hpp"
 #include "mongo/util/startup_test.h"
+#include "third_party/murmurhash3/MurmurHash3.h"
 
 namespace mongo {
 
@@ -54,6 +56,13 @@ public:
     explicit Hasher(HashSeed seed);
     ~Hasher(){};
 
+    // starts from a copy of another hasher's state, so a seeded state can be reused
+    explicit Hasher(const md5_state_t& state) : _md5State(state), _seed(0) {}
+
+    const md5_state_t& state() const {
+        return _md5State;
+    }
+
     // pointer to next part of input key, length in bytes to read
     void addData(const void* keyData, size_t numBytes);
 
@@ -79,7 +88,24 @@ void Hasher::finish(HashDigest out) {
     md5_finish(&_md5State, out);
 }
 
-void recursiveHash(Hasher* h, const BSONElement& e, bool includeFieldName) {
+// Collects the canonical representation of an element so that it can be hashed in one pass by
+// a non-streaming hash function.
+class BufferHasher {
+    MONGO_DISALLOW_COPYING(BufferHasher);
+
+public:
+    explicit BufferHasher(BufBuilder* buf) : _buf(buf) {}
+
+    void addData(const void* keyData, size_t numBytes) {
+        _buf->appendBuf(keyData, numBytes);
+    }
+
+private:
+    BufBuilder* _buf;
+};
+
+template <typename H>
+void recursiveHash(H* h, const BSONElement& e, bool includeFieldName) {
     int canonicalType = endian::nativeToLittle(e.canonicalType());
     h->addData(&canonicalType, sizeof(canonicalType));
 
@@ -117,11 +143,34 @@ void recursiveHash(Hasher* h, const BSONElement& e, bool includeFieldName) {
     }
 }
 
+long long int md5Hash64(Hasher* h, const BSONElement& e) {
+    recursiveHash(h, e, false);
+    HashDigest d;
+    h->finish(d);
+    // HashDigest is actually 16 bytes, but we just read 8 bytes
+    ConstDataView digestView(reinterpret_cast<const char*>(d));
+    return digestView.read<LittleEndian<long long int>>();
+}
+
+long long int murmur3Hash64(BufBuilder* buf, const BSONElement& e, HashSeed seed) {
+    buf->reset();
+    BufferHasher h(buf);
+    recursiveHash(&h, e, false);
+    // MurmurHash3 reads its input as little endian blocks and produces native words, so the
+    // first word is the same on every platform.
+    uint64_t out[2];
+    MurmurHash3_x64_128(buf->buf(), buf->len(), static_cast<uint32_t>(seed), out);
+    return static_cast<long long int>(out[0]);
+}
+
 struct HasherUnitTest : public StartupTest {
     void run() {
         // Hard-coded check to ensure the hash function is consistent across platforms
         BSONObj o = BSON("check" << 42);
         verify(BSONElementHasher::hash64(o.firstElement(), 0) == -944302157085130861LL);
+        verify(BSONElementHasher::hash64(
+                   o.firstElement(), 0, BSONElementHasher::MURMUR3_HASH_VERSION) ==
+               8715208212397937794LL);
     }
 } hasherUnitTest;
 
@@ -129,12 +178,39 @@ struct HasherUnitTest : public StartupTest {
 
 long long int BSONElementHasher::hash64(const BSONElement& e, HashSeed seed) {
     Hasher h(seed);
-    recursiveHash(&h, e, false);
-    HashDigest d;
-    h.finish(d);
-    // HashDigest is actually 16 bytes, but we just read 8 bytes
-    ConstDataView digestView(reinterpret_cast<const char*>(d));
-    return digestView.read<LittleEndian<long long int>>();
+    return md5Hash64(&h, e);
+}
+
+long long int BSONElementHasher::hash64(const BSONElement& e, HashSeed seed, int hashVersion) {
+    invariant(isSupportedHashVersion(hashVersion));
+    if (hashVersion == MD5_HASH_VERSION) {
+        return hash64(e, seed);
+    }
+
+    BufBuilder buf;
+    return murmur3Hash64(&buf, e, seed);
+}
+
+void BSONElementHasher::hash64Batch(const std::vector<BSONElement>& elements,
+                                    HashSeed seed,
+                                    int hashVersion,
+                                    std::vector<long long int>* out) {
+    invariant(isSupportedHashVersion(hashVersion));
+    out->reserve(out->size() + elements.size());
+
+    if (hashVersion == MD5_HASH_VERSION) {
+        const Hasher seeded(seed);
+        for (auto&& e : elements) {
+            Hasher h(seeded.state());
+            out->push_back(md5Hash64(&h, e));
+        }
+        return;
+    }
+
+    BufBuilder buf;
+    for (auto&& e : elements) {
+        out->push_back(murmur3Hash64(&buf, e, seed));
+    }
 }
 
 }  // namespace mongo
@@ -34,6 +34,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "mongo/base/disallow_copying.h"
 #include "mongo/bson/bsonelement.h"
 
@@ -54,6 +56,21 @@ public:
      */
     static const int DEFAULT_HASH_SEED = 0;
 
+    /* The hash function used is selected by the "hashVersion" of a hashed index.
+     * Version 0 is MD5 and is the only version hashed shard keys may use. Version 1
+     * is MurmurHash3 (x64_128), which is several times cheaper to compute. Both
+     * versions hash the same canonical representation of an element.
+     *
+     * WARNING: do not change the meaning of an existing version; indexes built with
+     * it must keep producing the same keys.
+     */
+    static const int MD5_HASH_VERSION = 0;
+    static const int MURMUR3_HASH_VERSION = 1;
+
+    static bool isSupportedHashVersion(int hashVersion) {
+        return hashVersion == MD5_HASH_VERSION || hashVersion == MURMUR3_HASH_VERSION;
+    }
+
     /* This computes a 64-bit hash of the value part of BSONElement "e",
      * preceded by the seed "seed".  Squashes element (and any sub-elements)
      * of the same canonical type, so hash({a:{b:4}}) will be the same
@@ -68,6 +85,18 @@ public:
      */
     static long long int hash64(const BSONElement& e, HashSeed seed);
 
+    /* As above, using the hash function of the given supported "hashVersion". */
+    static long long int hash64(const BSONElement& e, HashSeed seed, int hashVersion);
+
+    /* Hashes each of "elements" as hash64 would, appending the results to "out" in
+     * order. Seeding the hash state and sizing the buffers is done once for the whole
+     * batch, so callers hashing many values at once should prefer this.
+     */
+    static void hash64Batch(const std::vector<BSONElement>& elements,
+                            HashSeed seed,
+                            int hashVersion,
+                            std::vector<long long int>* out);
+
 private:
     BSONElementHasher();
 };
@@ -359,5 +359,58 @@ TEST(BSONElementHasher, HashCodeWScope) {
     ASSERT_EQUALS(hashIt(o), 501342939894575968LL);
 }
 
+long long hashMurmur3(const BSONObj& object, int seed = 0) {
+    return BSONElementHasher::hash64(
+        object.firstElement(), seed, BSONElementHasher::MURMUR3_HASH_VERSION);
+}
+
+TEST(BSONElementHasher, Murmur3HashIsStable) {
+    ASSERT_EQUALS(hashMurmur3(BSON("check" << 42)), 8715208212397937794LL);
+}
+
+TEST(BSONElementHasher, Murmur3HashDiffersFromMD5Hash) {
+    BSONObj o = BSON("check" << 42);
+    ASSERT_NOT_EQUALS(hashMurmur3(o), hashIt(o));
+}
+
+TEST(BSONElementHasher, Murmur3HashSquashesNumericTypes) {
+    ASSERT_EQUALS(hashMurmur3(BSON("a" << 3)), hashMurmur3(BSON("a" << 3LL)));
+    ASSERT_EQUALS(hashMurmur3(BSON("a" << 3)), hashMurmur3(BSON("a" << 3.1)));
+    ASSERT_NOT_EQUALS(hashMurmur3(BSON("a" << 3)), hashMurmur3(BSON("a" << 4)));
+    ASSERT_NOT_EQUALS(hashMurmur3(BSON("a" << 3)),
+                      hashMurmur3(BSON("a"
+                                       << "3")));
+}
+
+TEST(BSONElementHasher, Murmur3SeedMatters) {
+    ASSERT_NOT_EQUALS(hashMurmur3(BSON("a" << 4), 0), hashMurmur3(BSON("a" << 4), 1));
+}
+
+TEST(BSONElementHasher, BatchHashMatchesSingleHash) {
+    std::vector<BSONObj> objs{BSON("a" << 1),
+                              BSON("a"
+                                   << "str"),
+                              BSON("a" << BSON("b" << 2)),
+                              BSON("a" << BSON_ARRAY(1 << 2)),
+                              BSON("a" << BSONNULL)};
+    std::vector<BSONElement> elements;
+    for (auto&& obj : objs) {
+        elements.push_back(obj.firstElement());
+    }
+
+    for (int hashVersion :
+         {BSONElementHasher::MD5_HASH_VERSION, BSONElementHasher::MURMUR3_HASH_VERSION}) {
+        for (int seed : {0, 7}) {
+            std::vector<long long> hashes;
+            BSONElementHasher::hash64Batch(elements, seed, hashVersion, &hashes);
+            ASSERT_EQUALS(hashes.size(), elements.size());
+            for (size_t i = 0; i < elements.size(); ++i) {
+                ASSERT_EQUALS(hashes[i],
+                              BSONElementHasher::hash64(elements[i], seed, hashVersion));
+            }
+        }
+    }
+}
+
 }  // namespace
 }  // namespace mongo
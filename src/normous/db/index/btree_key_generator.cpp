@@ -35,6 +35,7 @@
 #include "mongo/db/field_ref.h"
 #include "mongo/db/query/collation/collation_index_key.h"
 #include "mongo/db/query/collation/collator_interface.h"
+#include "mongo/db/storage/key_string_set.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/mongoutils/str.h"
@@ -52,8 +53,35 @@ const BSONElement nullElt = nullObj.firstElement();
 const BSONObj undefinedObj = BSON("" << BSONUndefined);
 const BSONElement undefinedElt = undefinedObj.firstElement();
 
+/**
+ * Returns the number of components in the dotted path 'path', or zero if it is empty. Equivalent
+ * to FieldRef{path}.numParts(), without building a FieldRef.
+ */
+size_t numPathComponents(const char* path) {
+    if (*path == '\0')
+        return 0;
+
+    size_t numComponents = 1;
+    for (; *path; ++path) {
+        if (*path == '.')
+            ++numComponents;
+    }
+    return numComponents;
+}
+
 }  // namespace
 
+struct BtreeKeyGenerator::KeyStringOutput {
+    KeyStringOutput(KeyStringSet* keys, Ordering ord)
+        : keys(keys), ord(ord), scratch(keys->getVersion()) {}
+
+    KeyStringSet* const keys;
+    const Ordering ord;
+
+    // Reused to encode each key before it is copied into 'keys'.
+    KeyString scratch;
+};
+
 BtreeKeyGenerator::BtreeKeyGenerator(std::vector<const char*> fieldNames,
                                      std::vector<BSONElement> fixed,
                                      bool isSparse,
@@ -63,6 +91,11 @@ BtreeKeyGenerator::BtreeKeyGenerator(std::vector<const char*> fieldNames,
       _fixed(fixed),
       _emptyPositionalInfo(fieldNames.size()),
       _collator(collator) {
+    invariant(fieldNames.size() <= Ordering::kMaxCompoundIndexKeys);
+    invariant(fixed.size() == fieldNames.size());
+    std::copy(fieldNames.begin(), fieldNames.end(), _initialFieldNames.begin());
+    std::copy(fixed.begin(), fixed.end(), _initialFixed.begin());
+
     BSONObjBuilder nullKeyBuilder;
     for (size_t i = 0; i < fieldNames.size(); ++i) {
         nullKeyBuilder.appendNull("");
@@ -87,7 +120,8 @@ BSONElement BtreeKeyGenerator::_extractNextElement(const BSONObj& obj,
                                                    const PositionalPathInfo& positionalInfo,
                                                    const char** field,
                                                    bool* arrayNestedArray) const {
-    std::string firstField = mongoutils::str::before(*field, '.');
+    StringData firstField = *field;
+    firstField = firstField.substr(0, firstField.find('.'));
     bool haveObjField = !obj.getField(firstField).eoo();
     BSONElement arrField = positionalInfo.positionallyIndexedElt;
 
@@ -115,19 +149,20 @@ BSONElement BtreeKeyGenerator::_extractNextElement(const BSONObj& obj,
     return BSONElement();
 }
 
-void BtreeKeyGenerator::_getKeysArrEltFixed(std::vector<const char*>* fieldNames,
-                                            std::vector<BSONElement>* fixed,
+template <typename Output>
+void BtreeKeyGenerator::_getKeysArrEltFixed(FieldNames* fieldNames,
+                                            FixedElements* fixed,
                                             const BSONElement& arrEntry,
-                                            BSONObjSet* keys,
+                                            Output* keys,
                                             unsigned numNotFound,
                                             const BSONElement& arrObjElt,
-                                            const std::set<size_t>& arrIdxs,
+                                            const FieldSet& arrIdxs,
                                             bool mayExpandArrayUnembedded,
-                                            const std::vector<PositionalPathInfo>& positionalInfo,
+                                            const PositionalPathInfo* positionalInfo,
                                             MultikeyPaths* multikeyPaths) const {
     // Set up any terminal array values.
-    for (const auto idx : arrIdxs) {
-        if (*(*fieldNames)[idx] == '\0') {
+    for (size_t idx = 0; idx < _fieldNames.size(); ++idx) {
+        if (arrIdxs[idx] && *(*fieldNames)[idx] == '\0') {
             (*fixed)[idx] = mayExpandArrayUnembedded ? arrEntry : arrObjElt;
         }
     }
@@ -174,27 +209,98 @@ void BtreeKeyGenerator::getKeys(const BSONObj& obj,
             invariant(multikeyPaths->empty());
             multikeyPaths->resize(_fieldNames.size());
         }
-        // '_fieldNames' and '_fixed' are passed by value so that their copies can be mutated as
-        // part of the _getKeysWithArray method.
-        _getKeysWithArray(_fieldNames, _fixed, obj, keys, 0, _emptyPositionalInfo, multikeyPaths);
+        // The field names and fixed elements are passed by value so that their copies can be
+        // mutated as part of the _getKeysWithArray method.
+        _getKeysWithArray(_initialFieldNames,
+                          _initialFixed,
+                          obj,
+                          keys,
+                          0,
+                          _emptyPositionalInfo.data(),
+                          multikeyPaths);
     }
     if (keys->empty() && !_isSparse) {
         keys->insert(_nullKey);
     }
 }
 
-void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*> fieldNames,
-                                          std::vector<BSONElement> fixed,
+void BtreeKeyGenerator::getKeys(const BSONObj& obj,
+                                Ordering ord,
+                                KeyStringSet* keys,
+                                MultikeyPaths* multikeyPaths) const {
+    keys->clear();
+    KeyStringOutput output(keys, ord);
+
+    if (_isIdIndex) {
+        BSONElement e = obj["_id"];
+        FixedElements fixed;
+        fixed[0] = e.eoo() ? nullElt : e;
+        _addKey(fixed, &output);
+
+        // See the BSONObjSet overload.
+        if (multikeyPaths) {
+            multikeyPaths->resize(1);
+        }
+    } else {
+        if (multikeyPaths) {
+            invariant(multikeyPaths->empty());
+            multikeyPaths->resize(_fieldNames.size());
+        }
+        _getKeysWithArray(_initialFieldNames,
+                          _initialFixed,
+                          obj,
+                          &output,
+                          0,
+                          _emptyPositionalInfo.data(),
+                          multikeyPaths);
+    }
+    if (keys->empty() && !_isSparse) {
+        output.scratch.resetToKey(_nullKey, ord);
+        keys->add(output.scratch);
+    }
+    keys->finish();
+}
+
+void BtreeKeyGenerator::_addKey(const FixedElements& fixed, BSONObjSet* keys) const {
+    BSONObjBuilder b(_sizeTracker);
+    for (size_t i = 0; i < _fieldNames.size(); ++i) {
+        CollationIndexKey::collationAwareIndexKeyAppend(fixed[i], _collator, &b);
+    }
+    keys->insert(b.obj());
+}
+
+void BtreeKeyGenerator::_addKey(const FixedElements& fixed, KeyStringOutput* keys) const {
+    KeyString& keyString = keys->scratch;
+    keyString.resetToEmpty();
+    for (size_t i = 0; i < _fieldNames.size(); ++i) {
+        const bool invert = keys->ord.get(i) == -1;
+        if (_collator && CollationIndexKey::isCollatableType(fixed[i].type())) {
+            // Strings, including those nested in objects and arrays, are replaced by their
+            // collation comparison keys, which only the BSON form can express.
+            BSONObjBuilder b;
+            CollationIndexKey::collationAwareIndexKeyAppend(fixed[i], _collator, &b);
+            keyString.appendBSONElement(b.done().firstElement(), invert);
+        } else {
+            keyString.appendBSONElement(fixed[i], invert);
+        }
+    }
+    keys->keys->add(keyString);
+}
+
+template <typename Output>
+void BtreeKeyGenerator::_getKeysWithArray(FieldNames fieldNames,
+                                          FixedElements fixed,
                                           const BSONObj& obj,
-                                          BSONObjSet* keys,
+                                          Output* keys,
                                           unsigned numNotFound,
-                                          const std::vector<PositionalPathInfo>& positionalInfo,
+                                          const PositionalPathInfo* positionalInfo,
                                           MultikeyPaths* multikeyPaths) const {
+    const size_t numFields = _fieldNames.size();
     BSONElement arrElt;
 
     // A set containing the position of any indexed fields in the key pattern that traverse through
     // the 'arrElt' array value.
-    std::set<size_t> arrIdxs;
+    FieldSet arrIdxs;
 
     // A vector with size equal to the number of elements in the index key pattern. Each element in
     // the vector, if initialized, refers to the component within the indexed field that traverses
@@ -216,10 +322,10 @@ void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*> fieldNames,
     // path "a.b" causes the index to be multikey, but the key pattern "a.b.0" only indexes the
     // first element of the array, so we'd have a
     // std::vector<boost::optional<size_t>>{{1U}, boost::none}.
-    std::vector<boost::optional<size_t>> arrComponents(fieldNames.size());
+    std::array<boost::optional<size_t>, Ordering::kMaxCompoundIndexKeys> arrComponents;
 
     bool mayExpandArrayUnembedded = true;
-    for (size_t i = 0; i < fieldNames.size(); ++i) {
+    for (size_t i = 0; i < numFields; ++i) {
         if (*fieldNames[i] == '\0') {
             continue;
         }
@@ -236,7 +342,7 @@ void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*> fieldNames,
             fieldNames[i] = "";
             numNotFound++;
         } else if (e.type() == Array) {
-            arrIdxs.insert(i);
+            arrIdxs.set(i);
             if (arrElt.eoo()) {
                 // we only expand arrays on a single path -- track the path here
                 arrElt = e;
@@ -255,26 +361,25 @@ void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*> fieldNames,
 
     if (arrElt.eoo()) {
         // No array, so generate a single key.
-        if (_isSparse && numNotFound == fieldNames.size()) {
+        if (_isSparse && numNotFound == numFields) {
             return;
         }
-        BSONObjBuilder b(_sizeTracker);
-        for (std::vector<BSONElement>::iterator i = fixed.begin(); i != fixed.end(); ++i) {
-            CollationIndexKey::collationAwareIndexKeyAppend(*i, _collator, &b);
-        }
-        keys->insert(b.obj());
+        _addKey(fixed, keys);
     } else if (arrElt.embeddedObject().firstElement().eoo()) {
         // We've encountered an empty array.
         if (multikeyPaths && mayExpandArrayUnembedded) {
             // Any indexed path which traverses through the empty array must be recorded as an array
             // component.
-            for (auto i : arrIdxs) {
+            for (size_t i = 0; i < numFields; ++i) {
+                if (!arrIdxs[i])
+                    continue;
+
                 // We need to determine which component of the indexed field causes the index to be
                 // multikey as a result of the empty array. Indexed empty arrays are considered
                 // multikey and may occur mid-path. For instance, the indexed path "a.b.c" has
                 // multikey components {0, 1} given the document {a: [{b: []}, {b: 1}]}.
                 size_t fullPathLength = _pathLengths[i];
-                size_t suffixPathLength = FieldRef{fieldNames[i]}.numParts();
+                size_t suffixPathLength = numPathComponents(fieldNames[i]);
                 invariant(suffixPathLength < fullPathLength);
                 arrComponents[i] = fullPathLength - suffixPathLength - 1;
             }
@@ -289,7 +394,7 @@ void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*> fieldNames,
                             arrElt,
                             arrIdxs,
                             true,
-                            _emptyPositionalInfo,
+                            _emptyPositionalInfo.data(),
                             multikeyPaths);
     } else {
         BSONObj arrObj = arrElt.embeddedObject();
@@ -298,9 +403,9 @@ void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*> fieldNames,
         // and then traverse the remainder of the field path up front. This prevents us from
         // having to look up the indexed element again on each recursive call (i.e. once per
         // array element).
-        std::vector<PositionalPathInfo> subPositionalInfo(fixed.size());
-        for (size_t i = 0; i < fieldNames.size(); ++i) {
-            const bool fieldIsArray = arrIdxs.find(i) != arrIdxs.end();
+        std::array<PositionalPathInfo, Ordering::kMaxCompoundIndexKeys> subPositionalInfo;
+        for (size_t i = 0; i < numFields; ++i) {
+            const bool fieldIsArray = arrIdxs[i];
 
             if (*fieldNames[i] == '\0') {
                 // We've reached the end of the path.
@@ -342,7 +447,7 @@ void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*> fieldNames,
                     // latter from the former yields the number of components in the prefix "a.b",
                     // i.e. 2.
                     size_t fullPathLength = _pathLengths[i];
-                    size_t suffixPathLength = FieldRef{fieldNames[i]}.numParts();
+                    size_t suffixPathLength = numPathComponents(fieldNames[i]);
                     invariant(suffixPathLength < fullPathLength);
                     arrComponents[i] = fullPathLength - suffixPathLength - 1;
                 }
@@ -371,14 +476,14 @@ void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*> fieldNames,
                                 arrElt,
                                 arrIdxs,
                                 mayExpandArrayUnembedded,
-                                subPositionalInfo,
+                                subPositionalInfo.data(),
                                 multikeyPaths);
         }
     }
 
     // Record multikey path components.
     if (multikeyPaths) {
-        for (size_t i = 0; i < arrComponents.size(); ++i) {
+        for (size_t i = 0; i < numFields; ++i) {
             if (auto arrComponent = arrComponents[i]) {
                 (*multikeyPaths)[i].insert(*arrComponent);
             }
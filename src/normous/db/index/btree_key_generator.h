@@ -28,11 +28,13 @@
 
 #pragma once
 
+#include <array>
+#include <bitset>
 #include <memory>
-#include <set>
 #include <vector>
 
 #include "mongo/bson/bsonobj_comparator_interface.h"
+#include "mongo/bson/ordering.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index/multikey_paths.h"
 #include "mongo/db/jsobj.h"
@@ -40,6 +42,7 @@
 namespace mongo {
 
 class CollatorInterface;
+class KeyStringSet;
 
 /**
  * Internal class used by BtreeAccessMethod to generate keys for indexed documents.
@@ -67,7 +70,27 @@ public:
      */
     void getKeys(const BSONObj& obj, BSONObjSet* keys, MultikeyPaths* multikeyPaths) const;
 
+    /**
+     * Like getKeys() above, but encodes each key as a KeyString of the version of 'keys', ordered
+     * by 'ord', straight from the document's elements rather than building a BSONObj per key.
+     * 'keys' is cleared first and holds the same keys as the BSONObjSet would on return.
+     */
+    void getKeys(const BSONObj& obj,
+                 Ordering ord,
+                 KeyStringSet* keys,
+                 MultikeyPaths* multikeyPaths) const;
+
 private:
+    // Key generation state for each field of the key pattern. These are kept in fixed-size arrays
+    // so that each level of recursion into an array copies them on the stack instead of
+    // allocating.
+    using FieldNames = std::array<const char*, Ordering::kMaxCompoundIndexKeys>;
+    using FixedElements = std::array<BSONElement, Ordering::kMaxCompoundIndexKeys>;
+    using FieldSet = std::bitset<Ordering::kMaxCompoundIndexKeys>;
+
+    // Where _getKeysWithArray() emits keys to when generating KeyStrings.
+    struct KeyStringOutput;
+
     // These are used by getKeys below.
     std::vector<const char*> _fieldNames;
     bool _isIdIndex;
@@ -76,6 +99,10 @@ private:
     BSONSizeTracker _sizeTracker;
 
     std::vector<BSONElement> _fixed;
+
+    // '_fieldNames' and '_fixed' copied into the arrays _getKeysWithArray() starts from.
+    FieldNames _initialFieldNames;
+    FixedElements _initialFixed;
     /**
      * Stores info regarding traversal of a positional path. A path through a document is
      * considered positional if this path element names an array element. Generally this means
@@ -130,16 +157,24 @@ private:
     };
 
     /**
-     * This recursive method does the heavy-lifting for getKeys().
+     * This recursive method does the heavy-lifting for getKeys(). 'Output' is either BSONObjSet or
+     * KeyStringOutput. Only the first _fieldNames.size() entries of the arrays are used.
      */
-    void _getKeysWithArray(std::vector<const char*> fieldNames,
-                           std::vector<BSONElement> fixed,
+    template <typename Output>
+    void _getKeysWithArray(FieldNames fieldNames,
+                           FixedElements fixed,
                            const BSONObj& obj,
-                           BSONObjSet* keys,
+                           Output* keys,
                            unsigned numNotFound,
-                           const std::vector<PositionalPathInfo>& positionalInfo,
+                           const PositionalPathInfo* positionalInfo,
                            MultikeyPaths* multikeyPaths) const;
 
+    /**
+     * Adds the key made of the elements in 'fixed' to 'keys'.
+     */
+    void _addKey(const FixedElements& fixed, BSONObjSet* keys) const;
+    void _addKey(const FixedElements& fixed, KeyStringOutput* keys) const;
+
     /**
      * A call to _getKeysWithArray() begins by calling this for each field in the key pattern. It
      * traverses the path '*field' in 'obj' until either reaching the end of the path or an array
@@ -183,15 +218,16 @@ private:
      *
      * Then calls _getKeysWithArray() recursively.
      */
-    void _getKeysArrEltFixed(std::vector<const char*>* fieldNames,
-                             std::vector<BSONElement>* fixed,
+    template <typename Output>
+    void _getKeysArrEltFixed(FieldNames* fieldNames,
+                             FixedElements* fixed,
                              const BSONElement& arrEntry,
-                             BSONObjSet* keys,
+                             Output* keys,
                              unsigned numNotFound,
                              const BSONElement& arrObjElt,
-                             const std::set<size_t>& arrIdxs,
+                             const FieldSet& arrIdxs,
                              bool mayExpandArrayUnembedded,
-                             const std::vector<PositionalPathInfo>& positionalInfo,
+                             const PositionalPathInfo* positionalInfo,
                              MultikeyPaths* multikeyPaths) const;
 
     const std::vector<PositionalPathInfo> _emptyPositionalInfo;
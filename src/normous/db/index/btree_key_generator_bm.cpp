@@ -0,0 +1,103 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+#include <vector>
+
+#include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/db/index/btree_key_generator.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/db/storage/key_string.h"
+#include "mongo/db/storage/key_string_set.h"
+
+namespace mongo {
+namespace {
+
+const BSONObj kKeyPattern = BSON("a" << 1 << "b.c" << 1 << "d" << -1);
+
+// A document with a multikey first field and an array of subdocuments on the second, indexed by
+// kKeyPattern into 'arrayLength' * 'arrayLength' keys.
+BSONObj makeDocument(int arrayLength) {
+    BSONArrayBuilder a;
+    BSONArrayBuilder b;
+    for (int i = 0; i < arrayLength; ++i) {
+        a.append(i);
+        b.append(BSON("c"
+                      << "value" + std::to_string(i)));
+    }
+    return BSON("_id" << 1 << "a" << a.arr() << "b" << b.arr() << "d" << 3.5);
+}
+
+std::unique_ptr<BtreeKeyGenerator> makeKeyGenerator() {
+    std::vector<const char*> fieldNames;
+    std::vector<BSONElement> fixed;
+    for (auto&& elem : kKeyPattern) {
+        fieldNames.push_back(elem.fieldName());
+        fixed.push_back(BSONElement());
+    }
+    return std::make_unique<BtreeKeyGenerator>(fieldNames, fixed, false, nullptr);
+}
+
+// The existing write path: BSON keys, each re-encoded as a KeyString by the storage engine.
+void BM_GetKeysBSONThenKeyString(benchmark::State& state) {
+    const BSONObj doc = makeDocument(state.range(0));
+    const Ordering ord = Ordering::make(kKeyPattern);
+    auto keyGen = makeKeyGenerator();
+
+    for (auto keepRunning : state) {
+        BSONObjSet keys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+        MultikeyPaths multikeyPaths;
+        keyGen->getKeys(doc, &keys, &multikeyPaths);
+        for (const auto& key : keys) {
+            KeyString keyString(KeyString::Version::V1, key, ord);
+            benchmark::DoNotOptimize(keyString.getBuffer());
+        }
+    }
+}
+
+void BM_GetKeysKeyString(benchmark::State& state) {
+    const BSONObj doc = makeDocument(state.range(0));
+    const Ordering ord = Ordering::make(kKeyPattern);
+    auto keyGen = makeKeyGenerator();
+    KeyStringSet keys(KeyString::Version::V1);
+
+    for (auto keepRunning : state) {
+        keys.clear();
+        MultikeyPaths multikeyPaths;
+        keyGen->getKeys(doc, ord, &keys, &multikeyPaths);
+        benchmark::DoNotOptimize(keys.size());
+    }
+}
+
+BENCHMARK(BM_GetKeysBSONThenKeyString)->Arg(1)->Arg(10)->Arg(100);
+BENCHMARK(BM_GetKeysKeyString)->Arg(1)->Arg(10)->Arg(100);
+
+}  // namespace
+}  // namespace mongo
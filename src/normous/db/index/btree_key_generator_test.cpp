@@ -38,6 +38,7 @@
 #include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/json.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/db/storage/key_string_set.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/log.h"
 
@@ -95,6 +96,32 @@ bool keysetsEqual(const BSONObjSet& expectedKeys, const BSONObjSet& actualKeys)
     return true;
 }
 
+bool keyStringSetsEqual(const KeyStringSet& expectedKeys, const KeyStringSet& actualKeys) {
+    if (expectedKeys.size() != actualKeys.size()) {
+        return false;
+    }
+
+    for (size_t i = 0; i < expectedKeys.size(); ++i) {
+        auto expected = expectedKeys[i];
+        auto actual = actualKeys[i];
+        if (expected.getSize() != actual.getSize() ||
+            memcmp(expected.getBuffer(), actual.getBuffer(), expected.getSize()) != 0) {
+            return false;
+        }
+
+        auto expectedTypeBits = expected.getTypeBits();
+        auto actualTypeBits = actual.getTypeBits();
+        if (expectedTypeBits.getSize() != actualTypeBits.getSize() ||
+            memcmp(expectedTypeBits.getBuffer(),
+                   actualTypeBits.getBuffer(),
+                   expectedTypeBits.getSize()) != 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 bool testKeygen(const BSONObj& kp,
                 const BSONObj& obj,
                 const BSONObjSet& expectedKeys,
@@ -142,9 +169,49 @@ bool testKeygen(const BSONObj& kp,
     if (!match) {
         log() << "Expected: " << dumpMultikeyPaths(expectedMultikeyPaths) << ", "
               << "Actual: " << dumpMultikeyPaths(actualMultikeyPaths);
+        return false;
     }
 
-    return match;
+    //
+    // Step 4: generate the keys again, directly as KeyStrings, and check that they are the
+    // encodings of the expected BSON keys.
+    //
+    const Ordering ord = Ordering::make(kp);
+    for (auto version : {KeyString::Version::V0, KeyString::Version::V1}) {
+        KeyStringSet expectedKeyStrings(version);
+        for (const auto& key : expectedKeys) {
+            expectedKeyStrings.add(KeyString(version, key, ord));
+        }
+        expectedKeyStrings.finish();
+
+        KeyStringSet actualKeyStrings(version);
+        MultikeyPaths actualKeyStringMultikeyPaths;
+        keyGen->getKeys(obj, ord, &actualKeyStrings, &actualKeyStringMultikeyPaths);
+
+        match = keyStringSetsEqual(expectedKeyStrings, actualKeyStrings);
+        if (!match) {
+            std::stringstream ss;
+            ss << "[ ";
+            for (size_t i = 0; i < actualKeyStrings.size(); ++i) {
+                ss << actualKeyStrings[i].toBson(ord) << " ";
+            }
+            ss << "]";
+            log() << "KeyString version " << static_cast<int>(version) << ", "
+                  << "Expected: " << dumpKeyset(expectedKeys) << ", "
+                  << "Actual: " << ss.str();
+            return false;
+        }
+
+        match = (expectedMultikeyPaths == actualKeyStringMultikeyPaths);
+        if (!match) {
+            log() << "KeyString version " << static_cast<int>(version) << ", "
+                  << "Expected: " << dumpMultikeyPaths(expectedMultikeyPaths) << ", "
+                  << "Actual: " << dumpMultikeyPaths(actualKeyStringMultikeyPaths);
+            return false;
+        }
+    }
+
+    return true;
 }
 
 //
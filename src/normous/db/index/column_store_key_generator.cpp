@@ -0,0 +1,116 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/index/column_store_key_generator.h"
+
+#include <algorithm>
+#include <set>
+
+#include "mongo/bson/bsonobjbuilder.h"
+
+namespace mongo {
+
+constexpr StringData ColumnStoreKeyGenerator::kAllFieldsName;
+constexpr StringData ColumnStoreKeyGenerator::kRowIdColumn;
+
+ColumnStoreKeyGenerator::ColumnStoreKeyGenerator(const BSONObj& keyPattern) {
+    for (auto&& elem : keyPattern) {
+        const auto fieldName = elem.fieldNameStringData();
+        if (fieldName == kAllFieldsName) {
+            _storesAllFields = true;
+        } else if (fieldName != kRowIdColumn) {
+            _columns.push_back(fieldName.toString());
+        }
+    }
+}
+
+void ColumnStoreKeyGenerator::generateKeys(const BSONObj& doc, BSONObjSet* keys) const {
+    const BSONElement rowId = doc[kRowIdColumn];
+    if (!rowId) {
+        return;
+    }
+    _addKey(kRowIdColumn, rowId, rowId, keys);
+
+    if (!_storesAllFields) {
+        for (auto&& column : _columns) {
+            if (const BSONElement value = doc[column]) {
+                _addKey(column, rowId, value, keys);
+            }
+        }
+        return;
+    }
+
+    // Like a lookup by name, only the first of several fields of the same name is stored. Fields
+    // whose names contain a '.' cannot be queried, so they are not stored either.
+    std::set<StringData> seen;
+    for (auto&& elem : doc) {
+        const auto fieldName = elem.fieldNameStringData();
+        if (fieldName == kRowIdColumn || fieldName.find('.') != std::string::npos ||
+            !seen.insert(fieldName).second) {
+            continue;
+        }
+        _addKey(fieldName, rowId, elem, keys);
+    }
+}
+
+bool ColumnStoreKeyGenerator::isColumn(StringData fieldName) const {
+    return _storesAllFields || fieldName == kRowIdColumn ||
+        std::find(_columns.begin(), _columns.end(), fieldName) != _columns.end();
+}
+
+BSONObj ColumnStoreKeyGenerator::makeColumnStartKey(StringData column) {
+    return BSON("" << column << "" << MINKEY << "" << MINKEY);
+}
+
+BSONObj ColumnStoreKeyGenerator::makeColumnStartKey(StringData column,
+                                                    const BSONElement& rowId) {
+    BSONObjBuilder bob;
+    bob.append("", column);
+    bob.appendAs(rowId, "");
+    bob.appendMinKey("");
+    return bob.obj();
+}
+
+BSONObj ColumnStoreKeyGenerator::makeColumnEndKey(StringData column) {
+    return BSON("" << column << "" << MAXKEY << "" << MAXKEY);
+}
+
+void ColumnStoreKeyGenerator::_addKey(StringData column,
+                                      const BSONElement& rowId,
+                                      const BSONElement& value,
+                                      BSONObjSet* keys) const {
+    BSONObjBuilder bob;
+    bob.append("", column);
+    bob.appendAs(rowId, "");
+    bob.appendAs(value, "");
+    keys->insert(bob.obj());
+}
+
+}  // namespace mongo
@@ -0,0 +1,103 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/bsonobj_comparator_interface.h"
+
+namespace mongo {
+
+/**
+ * Generates the keys of a "columnstore" index, which stores the values of top-level fields as
+ * columns. The key pattern either lists the fields to store, as in {a: "columnstore", b:
+ * "columnstore"}, or is {"$**": "columnstore"} to store every top-level field.
+ *
+ * Each field present in a document contributes one key of the form
+ *      { '': 'fieldName', '': <_id>, '': <field value> }
+ * and each document also contributes a key to the '_id' column, so that every row can be found in
+ * it. Since the keys of a column are ordered by _id, scans over several columns can be merged into
+ * rows without buffering. Values are stored as they are, without collation or array expansion, so
+ * that the rows can be returned in place of the documents.
+ */
+class ColumnStoreKeyGenerator {
+public:
+    static constexpr StringData kAllFieldsName = "$**"_sd;
+    static constexpr StringData kRowIdColumn = "_id"_sd;
+
+    explicit ColumnStoreKeyGenerator(const BSONObj& keyPattern);
+
+    /**
+     * Adds the keys of 'doc' to 'keys'. A document without an _id cannot be stored as a row, and
+     * so has no keys.
+     */
+    void generateKeys(const BSONObj& doc, BSONObjSet* keys) const;
+
+    /**
+     * Returns whether the index stores the top-level field 'fieldName'.
+     */
+    bool isColumn(StringData fieldName) const;
+
+    /**
+     * Returns whether the index stores every top-level field.
+     */
+    bool storesAllFields() const {
+        return _storesAllFields;
+    }
+
+    /**
+     * Returns the fields listed in the key pattern, in its order, other than the _id column.
+     * Empty if the index stores every field.
+     */
+    const std::vector<std::string>& getColumns() const {
+        return _columns;
+    }
+
+    /**
+     * Returns the key at which the scan over 'column' in _id order starts, optionally at the
+     * row with the given _id, and the key at which it ends.
+     */
+    static BSONObj makeColumnStartKey(StringData column);
+    static BSONObj makeColumnStartKey(StringData column, const BSONElement& rowId);
+    static BSONObj makeColumnEndKey(StringData column);
+
+private:
+    void _addKey(StringData column,
+                 const BSONElement& rowId,
+                 const BSONElement& value,
+                 BSONObjSet* keys) const;
+
+    std::vector<std::string> _columns;
+    bool _storesAllFields = false;
+};
+
+}  // namespace mongo
@@ -0,0 +1,120 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/bson/json.h"
+#include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/db/index/column_store_key_generator.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+BSONObjSet makeKeySet(std::initializer_list<BSONObj> init = {}) {
+    return SimpleBSONObjComparator::kInstance.makeBSONObjSet(std::move(init));
+}
+
+BSONObjSet getKeys(const BSONObj& keyPattern, const BSONObj& doc) {
+    BSONObjSet keys = makeKeySet();
+    ColumnStoreKeyGenerator(keyPattern).generateKeys(doc, &keys);
+    return keys;
+}
+
+void assertKeysetsEqual(const BSONObjSet& expectedKeys, const BSONObjSet& actualKeys) {
+    ASSERT_EQ(expectedKeys.size(), actualKeys.size());
+    ASSERT(std::equal(expectedKeys.begin(),
+                      expectedKeys.end(),
+                      actualKeys.begin(),
+                      SimpleBSONObjComparator::kInstance.makeEqualTo()));
+}
+
+TEST(ColumnStoreKeyGeneratorTest, StoresListedFieldsAndRowId) {
+    auto keys = getKeys(fromjson("{a: 'columnstore', b: 'columnstore'}"),
+                        fromjson("{_id: 1, a: 2, b: [3, 4], c: 5}"));
+    assertKeysetsEqual(makeKeySet({fromjson("{'': '_id', '': 1, '': 1}"),
+                                   fromjson("{'': 'a', '': 1, '': 2}"),
+                                   fromjson("{'': 'b', '': 1, '': [3, 4]}")}),
+                       keys);
+}
+
+TEST(ColumnStoreKeyGeneratorTest, MissingFieldHasNoKey) {
+    auto keys = getKeys(fromjson("{a: 'columnstore', b: 'columnstore'}"),
+                        fromjson("{_id: 'x', b: null}"));
+    assertKeysetsEqual(makeKeySet({fromjson("{'': '_id', '': 'x', '': 'x'}"),
+                                   fromjson("{'': 'b', '': 'x', '': null}")}),
+                       keys);
+}
+
+TEST(ColumnStoreKeyGeneratorTest, DocumentWithoutIdHasNoKeys) {
+    auto keys = getKeys(fromjson("{a: 'columnstore'}"), fromjson("{a: 1}"));
+    ASSERT(keys.empty());
+}
+
+TEST(ColumnStoreKeyGeneratorTest, AllFieldsStoresEachTopLevelFieldOnce) {
+    auto keys = getKeys(fromjson("{'$**': 'columnstore'}"),
+                        fromjson("{a: {b: 1}, _id: 1, c: 2, a: 3, 'd.e': 4}"));
+    assertKeysetsEqual(makeKeySet({fromjson("{'': '_id', '': 1, '': 1}"),
+                                   fromjson("{'': 'a', '': 1, '': {b: 1}}"),
+                                   fromjson("{'': 'c', '': 1, '': 2}")}),
+                       keys);
+}
+
+TEST(ColumnStoreKeyGeneratorTest, IsColumn) {
+    ColumnStoreKeyGenerator listed(fromjson("{b: 'columnstore', a: 'columnstore'}"));
+    ASSERT_FALSE(listed.storesAllFields());
+    ASSERT(listed.isColumn("a"));
+    ASSERT(listed.isColumn("_id"));
+    ASSERT_FALSE(listed.isColumn("c"));
+    ASSERT(listed.getColumns() == std::vector<std::string>({"b", "a"}));
+
+    ColumnStoreKeyGenerator all(fromjson("{'$**': 'columnstore'}"));
+    ASSERT(all.storesAllFields());
+    ASSERT(all.isColumn("c"));
+    ASSERT(all.getColumns().empty());
+}
+
+TEST(ColumnStoreKeyGeneratorTest, ColumnBoundsContainOnlyThatColumn) {
+    const BSONObj rowKey = fromjson("{'': 'b', '': 5, '': 'value'}");
+    const BSONObj startKey = ColumnStoreKeyGenerator::makeColumnStartKey("b");
+    const BSONObj endKey = ColumnStoreKeyGenerator::makeColumnEndKey("b");
+    ASSERT_BSONOBJ_LT(startKey, rowKey);
+    ASSERT_BSONOBJ_GT(endKey, rowKey);
+    ASSERT_BSONOBJ_LT(ColumnStoreKeyGenerator::makeColumnEndKey("a"), startKey);
+    ASSERT_BSONOBJ_GT(ColumnStoreKeyGenerator::makeColumnStartKey("c"), endKey);
+
+    const BSONObj rowIdObj = BSON("" << 5);
+    const BSONObj rowStartKey =
+        ColumnStoreKeyGenerator::makeColumnStartKey("b", rowIdObj.firstElement());
+    ASSERT_BSONOBJ_LT(rowStartKey, rowKey);
+    ASSERT_BSONOBJ_GT(rowStartKey, fromjson("{'': 'b', '': 4, '': 'value'}"));
+}
+
+}  // namespace
+}  // namespace mongo
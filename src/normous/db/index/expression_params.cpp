@@ -68,10 +68,9 @@ void ExpressionParams::parseTwoDParams(const BSONObj& infoObj, TwoDIndexingParam
     out->geoHashConverter.reset(new GeoHashConverter(hashParams));
 }
 
-void ExpressionParams::parseHashParams(const BSONObj& infoObj,
-                                       HashSeed* seedOut,
-                                       int* versionOut,
-                                       std::string* fieldOut) {
+void ExpressionParams::parseHashFunctionParams(const BSONObj& infoObj,
+                                               HashSeed* seedOut,
+                                               int* versionOut) {
     // Default _seed to DEFAULT_HASH_SEED if "seed" is not included in the index spec
     // or if the value of "seed" is not a number
 
@@ -89,6 +88,13 @@ void ExpressionParams::parseHashParams(const BSONObj& infoObj,
     // accordingly.  Defaults to 0 if "hashVersion" is not included in the index spec or if
     // the value of "hashversion" is not a number
     *versionOut = infoObj["hashVersion"].numberInt();
+}
+
+void ExpressionParams::parseHashParams(const BSONObj& infoObj,
+                                       HashSeed* seedOut,
+                                       int* versionOut,
+                                       std::string* fieldOut) {
+    parseHashFunctionParams(infoObj, seedOut, versionOut);
 
     // Get the hashfield name
     BSONElement firstElt = infoObj.getObjectField("key").firstElement();
@@ -44,6 +44,11 @@ namespace ExpressionParams {
 
 void parseTwoDParams(const BSONObj& infoObj, TwoDIndexingParams* out);
 
+/**
+ * Parses the seed and hash version of a hashed index, which together select its hash function.
+ */
+void parseHashFunctionParams(const BSONObj& infoObj, HashSeed* seedOut, int* versionOut);
+
 void parseHashParams(const BSONObj& infoObj,
                      HashSeed* seedOut,
                      int* versionOut,
@@ -97,6 +97,26 @@ TEST(HashKeyGeneratorTest, CollationAppliedBeforeHashing) {
     ASSERT(assertKeysetsEqual(expectedKeys, actualKeys));
 }
 
+TEST(HashKeyGeneratorTest, HashVersionSelectsHashFunction) {
+    BSONObj obj = fromjson("{a: 5}");
+    BSONObjSet actualKeys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+    ExpressionKeysPrivate::getHashKeys(obj,
+                                       "a",
+                                       kHashSeed,
+                                       BSONElementHasher::MURMUR3_HASH_VERSION,
+                                       false,
+                                       nullptr,
+                                       &actualKeys);
+
+    BSONObjSet expectedKeys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+    expectedKeys.insert(BSON("" << BSONElementHasher::hash64(
+                                 obj["a"], kHashSeed, BSONElementHasher::MURMUR3_HASH_VERSION)));
+
+    ASSERT(assertKeysetsEqual(expectedKeys, actualKeys));
+    ASSERT_FALSE(SimpleBSONObjComparator::kInstance.evaluate(*actualKeys.begin() ==
+                                                             makeHashKey(obj["a"])));
+}
+
 TEST(HashKeyGeneratorTest, CollationDoesNotAffectNonStringFields) {
     BSONObj obj = fromjson("{a: 5}");
     BSONObjSet actualKeys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
@@ -32,6 +32,7 @@
 
 #include "mongo/db/index/btree_access_method.h"
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 
@@ -44,9 +45,12 @@
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/index/index_key_histogram.h"
+#include "mongo/db/index/index_range_count_cache.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/keypattern.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/timestamp_block.h"
 #include "mongo/db/server_parameters.h"
@@ -113,26 +117,28 @@ bool failIndexKeyTooLongParam() {
     return failIndexKeyTooLong.load();
 }
 
-class BtreeExternalSortComparison {
+/**
+ * Orders bulk build keys by their KeyString bytes. The RecordId is encoded at the end of each
+ * KeyString, so this is the same order as comparing the BSON keys under the index's Ordering and
+ * breaking ties by RecordId.
+ */
+class KeyStringExternalSortComparison {
 public:
-    BtreeExternalSortComparison(const BSONObj& ordering, IndexVersion version)
-        : _ordering(Ordering::make(ordering)), _version(version) {
-        invariant(IndexDescriptor::isIndexVersionSupported(version));
-    }
-
-    typedef std::pair<BSONObj, RecordId> Data;
+    typedef std::pair<KeyStringSortKey, RecordId> Data;
 
     int operator()(const Data& l, const Data& r) const {
-        if (int x = l.first.woCompare(r.first, _ordering, /*considerfieldname*/ false))
-            return x;
-        return l.second.compare(r.second);
+        return l.first.compare(r.first);
     }
-
-private:
-    const Ordering _ordering;
-    const IndexVersion _version;
 };
 
+/**
+ * Returns the KeyString version in which the storage engines store keys of an index of 'version'.
+ */
+KeyString::Version keyStringVersionForIndex(IndexVersion version) {
+    invariant(IndexDescriptor::isIndexVersionSupported(version));
+    return version >= IndexVersion::kV2 ? KeyString::Version::V1 : KeyString::Version::V0;
+}
+
 AbstractIndexAccessMethod::AbstractIndexAccessMethod(IndexCatalogEntry* btreeState,
                                                      SortedDataInterface* btree)
     : _btreeState(btreeState), _descriptor(btreeState->descriptor()), _newInterface(btree) {
@@ -184,13 +190,30 @@ Status AbstractIndexAccessMethod::insert(OperationContext* opCtx,
                                          int64_t* numInserted) {
     invariant(numInserted);
     *numInserted = 0;
-    bool checkIndexKeySize = shouldCheckIndexKeySize(opCtx);
     BSONObjSet multikeyMetadataKeys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
     BSONObjSet keys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
     MultikeyPaths multikeyPaths;
     // Delegate to the subclass.
     getKeys(obj, options.getKeysMode, &keys, &multikeyMetadataKeys, &multikeyPaths);
 
+    return insertKeys(opCtx, keys, multikeyMetadataKeys, multikeyPaths, loc, options, numInserted);
+}
+
+Status AbstractIndexAccessMethod::insertKeys(OperationContext* opCtx,
+                                             const BSONObjSet& keys,
+                                             const BSONObjSet& multikeyMetadataKeys,
+                                             const MultikeyPaths& multikeyPaths,
+                                             const RecordId& loc,
+                                             const InsertDeleteOptions& options,
+                                             int64_t* numInserted) {
+    invariant(numInserted);
+    *numInserted = 0;
+    bool checkIndexKeySize = shouldCheckIndexKeySize(opCtx);
+
+    if (!keys.empty() || !multikeyMetadataKeys.empty()) {
+        invalidateRangeCounts(opCtx);
+    }
+
     // Add all new data keys, and all new multikey metadata keys, into the index. When iterating
     // over the data keys, each of them should point to the doc's RecordId. When iterating over
     // the multikey metadata keys, they should point to the reserved 'kMultikeyMetadataKeyId'.
@@ -220,6 +243,87 @@ Status AbstractIndexAccessMethod::insert(OperationContext* opCtx,
     return Status::OK();
 }
 
+Status AbstractIndexAccessMethod::insertKeysInOrder(OperationContext* opCtx,
+                                                    const std::vector<DocumentKeys>& documents,
+                                                    const InsertDeleteOptions& options,
+                                                    int64_t* numInserted) {
+    invariant(numInserted);
+    *numInserted = 0;
+    bool checkIndexKeySize = shouldCheckIndexKeySize(opCtx);
+
+    struct KeyToInsert {
+        const BSONObj* key;
+        const RecordId* loc;
+        const Timestamp* ts;
+    };
+    std::vector<KeyToInsert> keysToInsert;
+    for (const auto& document : documents) {
+        invariant(document.loc != RecordId());
+        for (const auto& key : *document.keys) {
+            keysToInsert.push_back({&key, &document.loc, &document.ts});
+        }
+        for (const auto& key : *document.multikeyMetadataKeys) {
+            keysToInsert.push_back({&key, &kMultikeyMetadataKeyId, &document.ts});
+        }
+    }
+    if (keysToInsert.empty()) {
+        return Status::OK();
+    }
+    invalidateRangeCounts(opCtx);
+
+    const Ordering ordering = Ordering::make(_descriptor->keyPattern());
+    std::stable_sort(keysToInsert.begin(),
+                     keysToInsert.end(),
+                     [&](const KeyToInsert& lhs, const KeyToInsert& rhs) {
+                         int cmp = lhs.key->woCompare(*rhs.key, ordering, false);
+                         return cmp != 0 ? cmp < 0 : *lhs.loc < *rhs.loc;
+                     });
+
+    // Documents of one batch usually share few timestamps, so only set it when it changes.
+    Timestamp currentTs;
+    auto setTimestamp = [&](const Timestamp& ts) {
+        if (ts.isNull() || ts == currentTs) {
+            return Status::OK();
+        }
+        currentTs = ts;
+        return opCtx->recoveryUnit()->setTimestamp(ts);
+    };
+
+    for (const auto& keyToInsert : keysToInsert) {
+        Status status = setTimestamp(*keyToInsert.ts);
+        if (!status.isOK()) {
+            return status;
+        }
+        status = checkIndexKeySize ? checkKeySize(*keyToInsert.key) : Status::OK();
+        if (status.isOK()) {
+            StatusWith<SpecialFormatInserted> ret = _newInterface->insert(
+                opCtx, *keyToInsert.key, *keyToInsert.loc, options.dupsAllowed);
+            status = ret.getStatus();
+            if (status.isOK() && ret.getValue() == SpecialFormatInserted::LongTypeBitsInserted)
+                _btreeState->setIndexKeyStringWithLongTypeBitsExistsOnDisk(opCtx);
+        }
+        if (isFatalError(opCtx, status, *keyToInsert.key)) {
+            return status;
+        }
+    }
+
+    *numInserted = keysToInsert.size();
+
+    // Mark the index multikey at the timestamp of a document which makes it multikey, as
+    // insertKeys() does, and leave the recovery unit at the timestamp of the last document.
+    for (const auto& document : documents) {
+        if (shouldMarkIndexAsMultikey(
+                *document.keys, *document.multikeyMetadataKeys, *document.multikeyPaths)) {
+            Status status = setTimestamp(document.ts);
+            if (!status.isOK()) {
+                return status;
+            }
+            _btreeState->setMultikey(opCtx, *document.multikeyPaths);
+        }
+    }
+    return setTimestamp(documents.back().ts);
+}
+
 void AbstractIndexAccessMethod::removeOneKey(OperationContext* opCtx,
                                              const BSONObj& key,
                                              const RecordId& loc,
@@ -235,6 +339,12 @@ void AbstractIndexAccessMethod::removeOneKey(OperationContext* opCtx,
     }
 }
 
+void AbstractIndexAccessMethod::invalidateRangeCounts(OperationContext* opCtx) {
+    if (auto rangeCountCache = _btreeState->getRangeCountCache()) {
+        rangeCountCache->notifyOfWrite(opCtx);
+    }
+}
+
 std::unique_ptr<SortedDataInterface::Cursor> AbstractIndexAccessMethod::newCursor(
     OperationContext* opCtx, bool isForward) const {
     return _newInterface->newCursor(opCtx, isForward);
@@ -265,6 +375,10 @@ Status AbstractIndexAccessMethod::remove(OperationContext* opCtx,
     getKeys(
         obj, GetKeysMode::kRelaxConstraintsUnfiltered, &keys, multikeyMetadataKeys, multikeyPaths);
 
+    if (!keys.empty()) {
+        invalidateRangeCounts(opCtx);
+    }
+
     for (const auto& key : keys) {
         removeOneKey(opCtx, key, loc, options.dupsAllowed);
     }
@@ -438,6 +552,11 @@ Status AbstractIndexAccessMethod::update(OperationContext* opCtx,
         return Status(ErrorCodes::InternalError, "Invalid UpdateTicket in update");
     }
 
+    if (!ticket.removed.empty() || !ticket.added.empty() ||
+        !ticket.newMultikeyMetadataKeys.empty()) {
+        invalidateRangeCounts(opCtx);
+    }
+
     for (const auto& remKey : ticket.removed) {
         _newInterface->unindex(opCtx, remKey, ticket.loc, ticket.dupsAllowed);
     }
@@ -488,13 +607,22 @@ std::unique_ptr<IndexAccessMethod::BulkBuilder> AbstractIndexAccessMethod::initi
 IndexAccessMethod::BulkBuilder::BulkBuilder(const IndexAccessMethod* index,
                                             const IndexDescriptor* descriptor,
                                             size_t maxMemoryUsageBytes)
-    : _sorter(Sorter::make(
-          SortOptions()
-              .TempDir(storageGlobalParams.dbpath + "/_tmp")
-              .ExtSortAllowed()
-              .MaxMemoryUsageBytes(maxMemoryUsageBytes),
-          BtreeExternalSortComparison(descriptor->keyPattern(), descriptor->version()))),
-      _real(index) {}
+    : _sortOptions(SortOptions()
+                       .TempDir(storageGlobalParams.getTmpDirectory())
+                       .ExtSortAllowed()
+                       .MaxMemoryUsageBytes(maxMemoryUsageBytes)
+                       .SortThreads(internalQueryExecSortThreads.load())
+                       .SpillStats(&_spillStats)),
+      _sorter(Sorter::make(_sortOptions, KeyStringExternalSortComparison())),
+      _real(index),
+      _descriptor(descriptor),
+      _ordering(Ordering::make(descriptor->keyPattern())),
+      _keyStringVersion(keyStringVersionForIndex(descriptor->version())) {}
+
+void IndexAccessMethod::BulkBuilder::_addToSorter(const BSONObj& key, const RecordId& loc) {
+    _sorter->add(KeyStringSortKey(KeyString(_keyStringVersion, key, _ordering, loc)), loc);
+    ++_keysInserted;
+}
 
 Status IndexAccessMethod::BulkBuilder::insert(OperationContext* opCtx,
                                               const BSONObj& obj,
@@ -517,8 +645,7 @@ Status IndexAccessMethod::BulkBuilder::insert(OperationContext* opCtx,
     }
 
     for (const auto& key : keys) {
-        _sorter->add(key, loc);
-        ++_keysInserted;
+        _addToSorter(key, loc);
     }
 
     _isMultiKey =
@@ -527,12 +654,48 @@ Status IndexAccessMethod::BulkBuilder::insert(OperationContext* opCtx,
     return Status::OK();
 }
 
+void IndexAccessMethod::BulkBuilder::addPartition(std::unique_ptr<BulkBuilder> partition) {
+    invariant(partition->_real == _real);
+    invariant(partition->_partitions.empty());
+
+    if (!partition->_indexMultikeyPaths.empty()) {
+        if (_indexMultikeyPaths.empty()) {
+            _indexMultikeyPaths = std::move(partition->_indexMultikeyPaths);
+        } else {
+            invariant(_indexMultikeyPaths.size() == partition->_indexMultikeyPaths.size());
+            for (size_t i = 0; i < _indexMultikeyPaths.size(); ++i) {
+                _indexMultikeyPaths[i].insert(partition->_indexMultikeyPaths[i].begin(),
+                                              partition->_indexMultikeyPaths[i].end());
+            }
+        }
+    }
+
+    // The metadata keys are added to our own sorter by done(), which also dedupes them across
+    // partitions.
+    _multikeyMetadataKeys.insert(partition->_multikeyMetadataKeys.begin(),
+                                 partition->_multikeyMetadataKeys.end());
+    partition->_multikeyMetadataKeys.clear();
+
+    _isMultiKey = _isMultiKey || partition->_isMultiKey;
+    _keysInserted += partition->_keysInserted;
+    _partitions.push_back(std::move(partition));
+}
+
 IndexAccessMethod::BulkBuilder::Sorter::Iterator* IndexAccessMethod::BulkBuilder::done() {
     for (const auto& key : _multikeyMetadataKeys) {
-        _sorter->add(key, kMultikeyMetadataKeyId);
-        ++_keysInserted;
+        _addToSorter(key, kMultikeyMetadataKeyId);
+    }
+
+    if (_partitions.empty()) {
+        return _sorter->done();
     }
-    return _sorter->done();
+
+    std::vector<std::shared_ptr<Sorter::Iterator>> iters;
+    iters.emplace_back(_sorter->done());
+    for (auto&& partition : _partitions) {
+        iters.emplace_back(partition->_sorter->done());
+    }
+    return Sorter::Iterator::merge(iters, _sortOptions, KeyStringExternalSortComparison());
 }
 
 Status AbstractIndexAccessMethod::commitBulk(OperationContext* opCtx,
@@ -544,6 +707,12 @@ Status AbstractIndexAccessMethod::commitBulk(OperationContext* opCtx,
 
     std::unique_ptr<BulkBuilder::Sorter::Iterator> it(bulk->done());
 
+    auto& opDebug = CurOp::get(opCtx)->debug();
+    opDebug.addSortSpill(bulk->_spillStats);
+    for (auto&& partition : bulk->_partitions) {
+        opDebug.addSortSpill(partition->_spillStats);
+    }
+
     stdx::unique_lock<Client> lk(*opCtx->getClient());
     ProgressMeterHolder pm(
         CurOp::get(opCtx)->setMessage_inlock("Index Bulk Build: (2/3) btree bottom up",
@@ -557,6 +726,13 @@ Status AbstractIndexAccessMethod::commitBulk(OperationContext* opCtx,
 
     bool checkIndexKeySize = shouldCheckIndexKeySize(opCtx);
 
+    // The keys come out of the sorter in index order, so statistics about their leading values for
+    // query planning can be gathered on the way. These are only meaningful for btree indexes.
+    boost::optional<IndexKeyHistogram::Builder> histogramBuilder;
+    if (_descriptor->getIndexType() == IndexType::INDEX_BTREE) {
+        histogramBuilder.emplace(_descriptor->keyPattern().firstElement().numberInt());
+    }
+
     while (it->more()) {
         if (mayInterrupt) {
             opCtx->checkForInterrupt();
@@ -564,12 +740,15 @@ Status AbstractIndexAccessMethod::commitBulk(OperationContext* opCtx,
 
         WriteUnitOfWork wunit(opCtx);
 
-        // Get the next datum and add it to the builder.
+        // Get the next datum and add it to the builder. The key is decoded back to BSON once for
+        // the key size check, error reporting and builders that do not consume KeyStrings.
         BulkBuilder::Sorter::Data data = it->next();
+        const BSONObj key = data.first.toBson(bulk->_ordering);
 
-        Status status = checkIndexKeySize ? checkKeySize(data.first) : Status::OK();
+        Status status = checkIndexKeySize ? checkKeySize(key) : Status::OK();
         if (status.isOK()) {
-            StatusWith<SpecialFormatInserted> ret = builder->addKey(data.first, data.second);
+            StatusWith<SpecialFormatInserted> ret =
+                builder->addKeyString(data.first, key, data.second);
             status = ret.getStatus();
             if (status.isOK() && ret.getValue() == SpecialFormatInserted::LongTypeBitsInserted)
                 _btreeState->setIndexKeyStringWithLongTypeBitsExistsOnDisk(opCtx);
@@ -596,6 +775,9 @@ Status AbstractIndexAccessMethod::commitBulk(OperationContext* opCtx,
         }
 
         // If we're here either it's a dup and we're cool with it or the addKey went just fine.
+        if (histogramBuilder) {
+            histogramBuilder->addKey(key);
+        }
         pm.hit();
         wunit.commit();
     }
@@ -618,6 +800,10 @@ Status AbstractIndexAccessMethod::commitBulk(OperationContext* opCtx,
     if (specialFormatInserted == SpecialFormatInserted::LongTypeBitsInserted)
         _btreeState->setIndexKeyStringWithLongTypeBitsExistsOnDisk(opCtx);
     wunit.commit();
+
+    if (histogramBuilder) {
+        _btreeState->setKeyHistogram(histogramBuilder->done());
+    }
     return Status::OK();
 }
 
@@ -699,4 +885,6 @@ SortedDataInterface* AbstractIndexAccessMethod::getSortedDataInterface_forTest()
 }  // namespace mongo
 
 #include "mongo/db/sorter/sorter.cpp"
-MONGO_CREATE_SORTER(mongo::BSONObj, mongo::RecordId, mongo::BtreeExternalSortComparison);
+MONGO_CREATE_SORTER(mongo::KeyStringSortKey,
+                    mongo::RecordId,
+                    mongo::KeyStringExternalSortComparison);
@@ -31,6 +31,7 @@
 #include <atomic>
 #include <memory>
 #include <set>
+#include <vector>
 
 #include "mongo/base/disallow_copying.h"
 #include "mongo/bson/simple_bsonobj_comparator.h"
@@ -40,6 +41,7 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/record_id.h"
 #include "mongo/db/sorter/sorter.h"
+#include "mongo/db/storage/key_string_sort_key.h"
 #include "mongo/db/storage/sorted_data_interface.h"
 
 namespace mongo {
@@ -86,6 +88,41 @@ public:
                           const InsertDeleteOptions& options,
                           int64_t* numInserted) = 0;
 
+    /**
+     * Like insert(), but inserts the 'keys', 'multikeyMetadataKeys' and 'multikeyPaths' which
+     * getKeys() generated for the document at 'loc', so that they can be generated beforehand.
+     */
+    virtual Status insertKeys(OperationContext* opCtx,
+                              const BSONObjSet& keys,
+                              const BSONObjSet& multikeyMetadataKeys,
+                              const MultikeyPaths& multikeyPaths,
+                              const RecordId& loc,
+                              const InsertDeleteOptions& options,
+                              int64_t* numInserted) = 0;
+
+    /**
+     * The keys getKeys() generated for the document at 'loc', which is being written at 'ts'.
+     * A null 'ts' leaves the timestamp of the recovery unit unchanged.
+     */
+    struct DocumentKeys {
+        const BSONObjSet* keys;
+        const BSONObjSet* multikeyMetadataKeys;
+        const MultikeyPaths* multikeyPaths;
+        RecordId loc;
+        Timestamp ts;
+    };
+
+    /**
+     * Like calling insertKeys() for each of 'documents', but merges the keys of all of them and
+     * inserts them in index key order, which keeps consecutive writes close together in the
+     * index. Each key is written at the timestamp of the document it was generated for.
+     * 'numInserted' will be set to the total number of keys added to the index.
+     */
+    virtual Status insertKeysInOrder(OperationContext* opCtx,
+                                     const std::vector<DocumentKeys>& documents,
+                                     const InsertDeleteOptions& options,
+                                     int64_t* numInserted) = 0;
+
     /**
      * Analogous to above, but remove the records instead of inserting them.
      * 'numDeleted' will be set to the number of keys removed from the index for the document.
@@ -205,7 +242,8 @@ public:
 
     class BulkBuilder {
     public:
-        using Sorter = mongo::Sorter<BSONObj, RecordId>;
+        // Keys are sorted in their KeyString form, normalized once when they are inserted.
+        using Sorter = mongo::Sorter<KeyStringSortKey, RecordId>;
 
         /**
          * Insert into the BulkBuilder as-if inserting into an IndexAccessMethod.
@@ -223,6 +261,14 @@ public:
             return _isMultiKey;
         }
 
+        /**
+         * Takes over the keys gathered by 'partition', another BulkBuilder for the same index that
+         * was filled in parallel with this one, typically from a disjoint range of the collection.
+         * Its multikey state is folded into this builder's, and done() merges its sorted keys with
+         * this builder's own.
+         */
+        void addPartition(std::unique_ptr<BulkBuilder> partition);
+
         /**
          * Inserts all multikey metadata keys cached during the BulkBuilder's lifetime into the
          * underlying Sorter, finalizes it, and returns an iterator over the sorted dataset.
@@ -236,10 +282,20 @@ public:
                     const IndexDescriptor* descriptor,
                     size_t maxMemoryUsageBytes);
 
+        void _addToSorter(const BSONObj& key, const RecordId& loc);
+
+        SorterSpillStats _spillStats;  // Must be declared before _sortOptions, which points at it.
+        const SortOptions _sortOptions;
         std::unique_ptr<Sorter> _sorter;
         const IndexAccessMethod* _real;
+        const IndexDescriptor* _descriptor;
+        const Ordering _ordering;
+        const KeyString::Version _keyStringVersion;
         int64_t _keysInserted = 0;
 
+        // Builders whose keys are merged with ours by done(). See addPartition().
+        std::vector<std::unique_ptr<BulkBuilder>> _partitions;
+
         // Set to true if any document added to the BulkBuilder causes the index to become multikey.
         bool _isMultiKey = false;
 
@@ -419,6 +475,19 @@ public:
                   const InsertDeleteOptions& options,
                   int64_t* numInserted) final;
 
+    Status insertKeys(OperationContext* opCtx,
+                      const BSONObjSet& keys,
+                      const BSONObjSet& multikeyMetadataKeys,
+                      const MultikeyPaths& multikeyPaths,
+                      const RecordId& loc,
+                      const InsertDeleteOptions& options,
+                      int64_t* numInserted) final;
+
+    Status insertKeysInOrder(OperationContext* opCtx,
+                             const std::vector<DocumentKeys>& documents,
+                             const InsertDeleteOptions& options,
+                             int64_t* numInserted) final;
+
     Status remove(OperationContext* opCtx,
                   const BSONObj& obj,
                   const RecordId& loc,
@@ -536,6 +605,12 @@ private:
                       const RecordId& loc,
                       bool dupsAllowed);
 
+    /**
+     * Invalidates the cached range counts of this index, if any, because 'opCtx' is about to
+     * change its keys.
+     */
+    void invalidateRangeCounts(OperationContext* opCtx);
+
     const std::unique_ptr<SortedDataInterface> _newInterface;
 };
 
@@ -0,0 +1,200 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/index/index_key_histogram.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace mongo {
+
+IndexKeyHistogram::Builder::Builder(int direction) : _direction(direction < 0 ? -1 : 1) {}
+
+void IndexKeyHistogram::Builder::addKey(const BSONObj& key) {
+    ++_numKeys;
+
+    const BSONElement value = key.firstElement();
+    if (!_buckets.empty() && _buckets.back().bound.firstElement().woCompare(value, false) == 0) {
+        ++_buckets.back().boundKeys;
+        return;
+    }
+
+    if (_buckets.size() >= 2 * kMaxBuckets) {
+        _compact();
+    }
+
+    // Every distinct value starts out bounding a bucket of its own.
+    _buckets.push_back({value.wrap(""), 1, 0, 0});
+}
+
+void IndexKeyHistogram::Builder::_compact() {
+    const long long depth = (_numKeys + kMaxBuckets - 1) / kMaxBuckets;
+
+    std::vector<Bucket> compacted;
+    compacted.reserve(kMaxBuckets + 2);
+
+    // The first value stays a bucket bound, so that the range of every bucket is bounded below.
+    compacted.push_back(std::move(_buckets.front()));
+
+    Bucket* pending = nullptr;
+    for (size_t i = 1; i < _buckets.size(); ++i) {
+        Bucket& bucket = _buckets[i];
+        if (pending) {
+            bucket.rangeKeys += pending->rangeKeys + pending->boundKeys;
+            bucket.rangeDistinctValues += pending->rangeDistinctValues + 1;
+            pending = nullptr;
+        }
+
+        // The last bucket is kept since keys equal to its bound may still be added.
+        if (bucket.boundKeys + bucket.rangeKeys >= depth || i + 1 == _buckets.size()) {
+            compacted.push_back(std::move(bucket));
+        } else {
+            pending = &bucket;
+        }
+    }
+
+    _buckets = std::move(compacted);
+}
+
+std::shared_ptr<const IndexKeyHistogram> IndexKeyHistogram::Builder::done() {
+    if (_buckets.size() > kMaxBuckets) {
+        _compact();
+    }
+    return std::shared_ptr<const IndexKeyHistogram>(
+        new IndexKeyHistogram(_direction, _numKeys, std::move(_buckets)));
+}
+
+IndexKeyHistogram::IndexKeyHistogram(int direction,
+                                     long long numKeys,
+                                     std::vector<Bucket> buckets)
+    : _direction(direction), _numKeys(numKeys), _buckets(std::move(buckets)) {}
+
+long long IndexKeyHistogram::numDistinctValues() const {
+    long long numDistinct = 0;
+    for (auto&& bucket : _buckets) {
+        numDistinct += bucket.rangeDistinctValues + 1;
+    }
+    return numDistinct;
+}
+
+double IndexKeyHistogram::estimateKeysInInterval(const BSONElement& start,
+                                                 bool startInclusive,
+                                                 const BSONElement& end,
+                                                 bool endInclusive) const {
+    // Orient the interval the way the index is ordered.
+    BSONElement low = start;
+    BSONElement high = end;
+    bool lowInclusive = startInclusive;
+    bool highInclusive = endInclusive;
+    if (_compare(low, high) > 0) {
+        std::swap(low, high);
+        std::swap(lowInclusive, highInclusive);
+    }
+
+    const bool isPoint = _compare(low, high) == 0;
+    if (isPoint && !(lowInclusive && highInclusive)) {
+        return 0;
+    }
+
+    // Buckets hold the values after the bound of the previous bucket up to their own bound, so
+    // the first bucket which can overlap the interval is the first one bounded at or after 'low'.
+    auto it = std::lower_bound(
+        _buckets.begin(), _buckets.end(), low, [this](const Bucket& bucket, BSONElement value) {
+            return _compare(bucket.bound.firstElement(), value) < 0;
+        });
+
+    double estimate = 0;
+    for (; it != _buckets.end(); ++it) {
+        const BSONElement bound = it->bound.firstElement();
+        const int boundVsLow = _compare(bound, low);
+        const int boundVsHigh = _compare(bound, high);
+
+        // The range of the first bucket is always empty.
+        if (it->rangeKeys > 0 && boundVsLow > 0) {
+            const BSONElement prevBound = std::prev(it)->bound.firstElement();
+            const bool coversRangeStart = _compare(low, prevBound) <= 0;
+            const bool coversRangeEnd = boundVsHigh <= 0;
+            const double perValue =
+                static_cast<double>(it->rangeKeys) / std::max(it->rangeDistinctValues, 1LL);
+
+            if (coversRangeStart && coversRangeEnd) {
+                estimate += it->rangeKeys;
+            } else if (isPoint) {
+                estimate += perValue;
+            } else if (low.isNumber() && high.isNumber() && prevBound.isNumber() &&
+                       bound.isNumber() && prevBound.numberDouble() != bound.numberDouble()) {
+                // Interpolate over numeric ranges, assuming the values are spread evenly.
+                const double rangeStart = prevBound.numberDouble();
+                const double rangeEnd = bound.numberDouble();
+                const double from = coversRangeStart ? rangeStart : low.numberDouble();
+                const double to = coversRangeEnd ? rangeEnd : high.numberDouble();
+                const double fraction =
+                    std::min(std::max((to - from) / (rangeEnd - rangeStart), 0.0), 1.0);
+                estimate += std::max(perValue, it->rangeKeys * fraction);
+            } else if (coversRangeStart || coversRangeEnd) {
+                estimate += std::max(perValue, it->rangeKeys / 2.0);
+            } else {
+                estimate += perValue;
+            }
+        }
+
+        if ((boundVsLow > 0 || (boundVsLow == 0 && lowInclusive)) &&
+            (boundVsHigh < 0 || (boundVsHigh == 0 && highInclusive))) {
+            estimate += it->boundKeys;
+        }
+
+        if (boundVsHigh >= 0) {
+            break;
+        }
+    }
+
+    return estimate;
+}
+
+BSONObj IndexKeyHistogram::toBSON() const {
+    BSONObjBuilder bob;
+    bob.appendNumber("numKeys", _numKeys);
+    bob.appendNumber("numDistinctValues", numDistinctValues());
+
+    BSONArrayBuilder bucketsBob(bob.subarrayStart("buckets"));
+    for (auto&& bucket : _buckets) {
+        BSONObjBuilder bucketBob(bucketsBob.subobjStart());
+        bucketBob.appendAs(bucket.bound.firstElement(), "bound");
+        bucketBob.appendNumber("boundKeys", bucket.boundKeys);
+        bucketBob.appendNumber("rangeKeys", bucket.rangeKeys);
+        bucketBob.appendNumber("rangeDistinctValues", bucket.rangeDistinctValues);
+        bucketBob.doneFast();
+    }
+    bucketsBob.doneFast();
+
+    return bob.obj();
+}
+
+}  // namespace mongo
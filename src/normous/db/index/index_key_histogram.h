@@ -0,0 +1,133 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "mongo/db/jsobj.h"
+
+namespace mongo {
+
+/**
+ * Statistics about the values of the leading field of an index's keys: the number of keys, and an
+ * equi-depth histogram of the leading values they hold.
+ *
+ * Each bucket of the histogram is bounded by a leading value which is stored exactly, together with
+ * the number of keys holding it. The keys whose leading value falls between the bound of a bucket
+ * and that of the previous bucket are only counted. Frequent values therefore tend to become bucket
+ * bounds and are estimated precisely, while estimates for other values are averaged out over the
+ * bucket containing them.
+ *
+ * A histogram is immutable once built, so that it can be shared with query planning.
+ */
+class IndexKeyHistogram {
+public:
+    // The maximum number of buckets in a histogram.
+    static const size_t kMaxBuckets = 200;
+
+    struct Bucket {
+        // The leading value bounding this bucket, as the only element of this object.
+        BSONObj bound;
+
+        // The number of keys whose leading value equals 'bound'.
+        long long boundKeys;
+
+        // The number of keys whose leading value falls strictly between the bound of the previous
+        // bucket and 'bound', and the number of distinct leading values among them.
+        long long rangeKeys;
+        long long rangeDistinctValues;
+    };
+
+    /**
+     * Builds a histogram from the keys of an index, as they are returned by a scan of the index.
+     */
+    class Builder {
+    public:
+        /**
+         * 'direction' is the direction of the leading field of the index's key pattern, which is
+         * the order in which the keys will be added.
+         */
+        explicit Builder(int direction);
+
+        /**
+         * Adds the next key of the index. Only its first element is looked at.
+         */
+        void addKey(const BSONObj& key);
+
+        std::shared_ptr<const IndexKeyHistogram> done();
+
+    private:
+        // Merges buckets with too few keys into the bucket that follows them, until no more than
+        // about kMaxBuckets remain.
+        void _compact();
+
+        const int _direction;
+        long long _numKeys = 0;
+        std::vector<Bucket> _buckets;
+    };
+
+    long long numKeys() const {
+        return _numKeys;
+    }
+
+    long long numDistinctValues() const;
+
+    const std::vector<Bucket>& buckets() const {
+        return _buckets;
+    }
+
+    /**
+     * Estimates the number of keys whose leading value lies in the interval from 'start' to 'end'.
+     * The interval may be given in either direction.
+     */
+    double estimateKeysInInterval(const BSONElement& start,
+                                  bool startInclusive,
+                                  const BSONElement& end,
+                                  bool endInclusive) const;
+
+    /**
+     * Returns a description of this histogram such as reported by $indexStats.
+     */
+    BSONObj toBSON() const;
+
+private:
+    IndexKeyHistogram(int direction, long long numKeys, std::vector<Bucket> buckets);
+
+    // Compares two leading values in the order in which the index holds them.
+    int _compare(const BSONElement& lhs, const BSONElement& rhs) const {
+        return _direction * lhs.woCompare(rhs, false);
+    }
+
+    const int _direction;
+    const long long _numKeys;
+    const std::vector<Bucket> _buckets;
+};
+
+}  // namespace mongo
@@ -0,0 +1,165 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/index/index_key_histogram.h"
+
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+BSONObj key(int value) {
+    return BSON("" << value << "" << 1);
+}
+
+TEST(IndexKeyHistogramTest, EmptyHistogram) {
+    auto histogram = IndexKeyHistogram::Builder(1).done();
+    ASSERT_EQ(0, histogram->numKeys());
+    ASSERT_EQ(0, histogram->numDistinctValues());
+    ASSERT_EQ(0.0, histogram->estimateKeysInInterval(BSON("" << 1).firstElement(), true,
+                                                     BSON("" << 1).firstElement(), true));
+}
+
+TEST(IndexKeyHistogramTest, KeepsEveryValueWhileFewAreDistinct) {
+    IndexKeyHistogram::Builder builder(1);
+    for (int value = 0; value < 10; ++value) {
+        for (int i = 0; i <= value; ++i) {
+            builder.addKey(key(value));
+        }
+    }
+    auto histogram = builder.done();
+
+    ASSERT_EQ(55, histogram->numKeys());
+    ASSERT_EQ(10, histogram->numDistinctValues());
+    ASSERT_EQ(10U, histogram->buckets().size());
+
+    BSONObj seven = BSON("" << 7);
+    ASSERT_EQ(8.0,
+              histogram->estimateKeysInInterval(
+                  seven.firstElement(), true, seven.firstElement(), true));
+    ASSERT_EQ(0.0,
+              histogram->estimateKeysInInterval(
+                  seven.firstElement(), true, seven.firstElement(), false));
+
+    BSONObj bounds = BSON("" << 2 << "" << 4);
+    BSONObjIterator it(bounds);
+    BSONElement two = it.next();
+    BSONElement four = it.next();
+    ASSERT_EQ(12.0, histogram->estimateKeysInInterval(two, true, four, true));
+    ASSERT_EQ(4.0, histogram->estimateKeysInInterval(four, false, two, false));
+}
+
+TEST(IndexKeyHistogramTest, BoundsBucketCountAndEstimatesUniformValues) {
+    const int kNumValues = 100000;
+    IndexKeyHistogram::Builder builder(1);
+    for (int value = 0; value < kNumValues; ++value) {
+        builder.addKey(key(value));
+    }
+    auto histogram = builder.done();
+
+    ASSERT_EQ(kNumValues, histogram->numKeys());
+    ASSERT_EQ(kNumValues, histogram->numDistinctValues());
+    ASSERT_LTE(histogram->buckets().size(), IndexKeyHistogram::kMaxBuckets + 2);
+
+    BSONObj bounds = BSON("" << 25000 << "" << 75000 << "" << MINKEY << "" << MAXKEY);
+    BSONObjIterator it(bounds);
+    BSONElement quarter = it.next();
+    BSONElement threeQuarters = it.next();
+    BSONElement minKey = it.next();
+    BSONElement maxKey = it.next();
+
+    const double half = histogram->estimateKeysInInterval(quarter, true, threeQuarters, false);
+    ASSERT_GT(half, 0.45 * kNumValues);
+    ASSERT_LT(half, 0.55 * kNumValues);
+
+    ASSERT_EQ(double(kNumValues), histogram->estimateKeysInInterval(minKey, true, maxKey, true));
+
+    // A single value is estimated from the average number of keys per value of its bucket.
+    const double one = histogram->estimateKeysInInterval(quarter, true, quarter, true);
+    ASSERT_GTE(one, 1.0);
+    ASSERT_LT(one, 2.0);
+}
+
+TEST(IndexKeyHistogramTest, FrequentValueStaysExact) {
+    IndexKeyHistogram::Builder builder(1);
+    for (int value = 0; value < 10000; ++value) {
+        builder.addKey(key(value));
+        if (value == 5000) {
+            for (int i = 0; i < 20000; ++i) {
+                builder.addKey(key(value));
+            }
+        }
+    }
+    auto histogram = builder.done();
+
+    BSONObj frequent = BSON("" << 5000);
+    ASSERT_EQ(20001.0,
+              histogram->estimateKeysInInterval(
+                  frequent.firstElement(), true, frequent.firstElement(), true));
+}
+
+TEST(IndexKeyHistogramTest, DescendingIndex) {
+    IndexKeyHistogram::Builder builder(-1);
+    for (int value = 1000; value > 0; --value) {
+        builder.addKey(key(value));
+    }
+    auto histogram = builder.done();
+
+    BSONObj bounds = BSON("" << 900 << "" << 101);
+    BSONObjIterator it(bounds);
+    BSONElement high = it.next();
+    BSONElement low = it.next();
+    const double estimate = histogram->estimateKeysInInterval(high, true, low, true);
+    ASSERT_GT(estimate, 750.0);
+    ASSERT_LT(estimate, 850.0);
+    ASSERT_EQ(estimate, histogram->estimateKeysInInterval(low, true, high, true));
+}
+
+TEST(IndexKeyHistogramTest, ToBSON) {
+    IndexKeyHistogram::Builder builder(1);
+    builder.addKey(key(1));
+    builder.addKey(key(1));
+    builder.addKey(key(2));
+    ASSERT_BSONOBJ_EQ(BSON("numKeys" << 3 << "numDistinctValues" << 2 << "buckets"
+                                     << BSON_ARRAY(BSON("bound" << 1 << "boundKeys" << 2
+                                                                << "rangeKeys"
+                                                                << 0
+                                                                << "rangeDistinctValues"
+                                                                << 0)
+                                                   << BSON("bound" << 2 << "boundKeys" << 1
+                                                                   << "rangeKeys"
+                                                                   << 0
+                                                                   << "rangeDistinctValues"
+                                                                   << 0))),
+                      builder.done()->toBSON());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,133 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/index/index_range_count_cache.h"
+
+#include "mongo/db/operation_context.h"
+#include "mongo/db/storage/recovery_unit.h"
+
+namespace mongo {
+
+namespace {
+
+/**
+ * Invalidates the counts of an index once a write to it commits or rolls back. Holds a reference
+ * to the cache, since the index may be dropped before the write unit of work ends.
+ */
+class InvalidateRangeCountsChange final : public RecoveryUnit::Change {
+public:
+    explicit InvalidateRangeCountsChange(std::shared_ptr<IndexRangeCountCache> cache)
+        : _cache(std::move(cache)) {}
+
+    void commit(boost::optional<Timestamp>) final {
+        _cache->invalidate();
+    }
+
+    void rollback() final {
+        _cache->invalidate();
+    }
+
+private:
+    const std::shared_ptr<IndexRangeCountCache> _cache;
+};
+
+}  // namespace
+
+IndexRangeCountCache::IndexRangeCountCache(size_t maxEntries) : _entries(maxEntries) {}
+
+void IndexRangeCountCache::notifyOfWrite(OperationContext* opCtx) {
+    invalidate();
+    opCtx->recoveryUnit()->registerChange(new InvalidateRangeCountsChange(shared_from_this()));
+}
+
+void IndexRangeCountCache::invalidate() {
+    _generation.fetchAndAdd(1);
+}
+
+unsigned long long IndexRangeCountCache::getGeneration() const {
+    return _generation.load();
+}
+
+boost::optional<long long> IndexRangeCountCache::get(const BSONObj& startKey,
+                                                     bool startKeyInclusive,
+                                                     const BSONObj& endKey,
+                                                     bool endKeyInclusive) const {
+    const auto key = _makeKey(startKey, startKeyInclusive, endKey, endKeyInclusive);
+    const auto generation = getGeneration();
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    auto it = _entries.find(key);
+    if (it == _entries.end()) {
+        return boost::none;
+    }
+
+    if (it->second.generation != generation) {
+        _entries.erase(it);
+        return boost::none;
+    }
+
+    return it->second.count;
+}
+
+void IndexRangeCountCache::add(const BSONObj& startKey,
+                               bool startKeyInclusive,
+                               const BSONObj& endKey,
+                               bool endKeyInclusive,
+                               long long count,
+                               unsigned long long generation) {
+    if (generation != getGeneration()) {
+        return;
+    }
+
+    const auto key = _makeKey(startKey, startKeyInclusive, endKey, endKeyInclusive);
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _entries.add(key, Entry{count, generation});
+}
+
+size_t IndexRangeCountCache::size() const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return _entries.size();
+}
+
+std::string IndexRangeCountCache::_makeKey(const BSONObj& startKey,
+                                           bool startKeyInclusive,
+                                           const BSONObj& endKey,
+                                           bool endKeyInclusive) {
+    BSONObjBuilder bob;
+    bob.append("s", startKey);
+    bob.append("si", startKeyInclusive);
+    bob.append("e", endKey);
+    bob.append("ei", endKeyInclusive);
+    const BSONObj obj = bob.done();
+    return std::string(obj.objdata(), obj.objsize());
+}
+
+}  // namespace mongo
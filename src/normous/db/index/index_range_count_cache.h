@@ -0,0 +1,124 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <boost/optional.hpp>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/lru_cache.h"
+
+namespace mongo {
+
+class OperationContext;
+
+/**
+ * Remembers the number of keys an index held in recently counted key ranges, so that repeated
+ * counts over the same range can be answered without walking the index.
+ *
+ * Every change to the keys of the index invalidates all entries. Writers call notifyOfWrite(),
+ * which advances a generation number immediately and again once the write commits or rolls back.
+ * A count may only be added under the generation observed before the reader opened its snapshot,
+ * and only if the generation has not moved since, so a cached count never misses a write that was
+ * visible when it was served.
+ *
+ * All methods are thread-safe.
+ */
+class IndexRangeCountCache : public std::enable_shared_from_this<IndexRangeCountCache> {
+    MONGO_DISALLOW_COPYING(IndexRangeCountCache);
+
+public:
+    explicit IndexRangeCountCache(size_t maxEntries);
+
+    /**
+     * Invalidates every cached count on behalf of a write to the index by 'opCtx', and arranges
+     * for them to be invalidated again when that write commits or rolls back.
+     */
+    void notifyOfWrite(OperationContext* opCtx);
+
+    /**
+     * Invalidates every cached count.
+     */
+    void invalidate();
+
+    /**
+     * Returns the current generation. Counts computed from a snapshot opened after this call may
+     * be added under the returned value.
+     */
+    unsigned long long getGeneration() const;
+
+    /**
+     * Returns the cached number of keys between 'startKey' and 'endKey', if it is still valid.
+     */
+    boost::optional<long long> get(const BSONObj& startKey,
+                                   bool startKeyInclusive,
+                                   const BSONObj& endKey,
+                                   bool endKeyInclusive) const;
+
+    /**
+     * Caches 'count' as the number of keys between 'startKey' and 'endKey'. Ignored unless
+     * 'generation' is still the current generation.
+     */
+    void add(const BSONObj& startKey,
+             bool startKeyInclusive,
+             const BSONObj& endKey,
+             bool endKeyInclusive,
+             long long count,
+             unsigned long long generation);
+
+    /**
+     * Returns the number of entries, including ones that have been invalidated but not yet
+     * evicted.
+     */
+    size_t size() const;
+
+private:
+    struct Entry {
+        long long count;
+        unsigned long long generation;
+    };
+
+    static std::string _makeKey(const BSONObj& startKey,
+                                bool startKeyInclusive,
+                                const BSONObj& endKey,
+                                bool endKeyInclusive);
+
+    AtomicWord<unsigned long long> _generation{0};
+
+    // Entries of older generations are discarded lazily, so that writers never take the mutex.
+    mutable stdx::mutex _mutex;
+    mutable LRUCache<std::string, Entry> _entries;
+};
+
+}  // namespace mongo
@@ -0,0 +1,92 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/index/index_range_count_cache.h"
+
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+BSONObj key(int value) {
+    return BSON("" << value);
+}
+
+TEST(IndexRangeCountCacheTest, ReturnsCountForSameRange) {
+    auto cache = std::make_shared<IndexRangeCountCache>(10);
+    cache->add(key(1), true, key(5), false, 42, cache->getGeneration());
+
+    ASSERT_EQ(42, *cache->get(key(1), true, key(5), false));
+    ASSERT_FALSE(cache->get(key(1), true, key(5), true));
+    ASSERT_FALSE(cache->get(key(1), false, key(5), false));
+    ASSERT_FALSE(cache->get(key(1), true, key(6), false));
+}
+
+TEST(IndexRangeCountCacheTest, InvalidateDiscardsEveryCount) {
+    auto cache = std::make_shared<IndexRangeCountCache>(10);
+    cache->add(key(1), true, key(5), true, 4, cache->getGeneration());
+    cache->add(key(7), true, key(9), true, 2, cache->getGeneration());
+
+    cache->invalidate();
+
+    ASSERT_FALSE(cache->get(key(1), true, key(5), true));
+    ASSERT_FALSE(cache->get(key(7), true, key(9), true));
+    ASSERT_EQ(0U, cache->size());
+}
+
+TEST(IndexRangeCountCacheTest, IgnoresCountFromEarlierGeneration) {
+    auto cache = std::make_shared<IndexRangeCountCache>(10);
+    const auto generation = cache->getGeneration();
+
+    // A write happened while the count was being computed.
+    cache->invalidate();
+    cache->add(key(1), true, key(5), true, 4, generation);
+
+    ASSERT_FALSE(cache->get(key(1), true, key(5), true));
+    ASSERT_EQ(0U, cache->size());
+}
+
+TEST(IndexRangeCountCacheTest, EvictsLeastRecentlyUsedRange) {
+    auto cache = std::make_shared<IndexRangeCountCache>(2);
+    cache->add(key(1), true, key(2), true, 1, cache->getGeneration());
+    cache->add(key(3), true, key(4), true, 3, cache->getGeneration());
+
+    // Touch the first range so that the second is evicted next.
+    ASSERT_EQ(1, *cache->get(key(1), true, key(2), true));
+    cache->add(key(5), true, key(6), true, 5, cache->getGeneration());
+
+    ASSERT_EQ(2U, cache->size());
+    ASSERT_EQ(1, *cache->get(key(1), true, key(2), true));
+    ASSERT_FALSE(cache->get(key(3), true, key(4), true));
+    ASSERT_EQ(5, *cache->get(key(5), true, key(6), true));
+}
+
+}  // namespace
+}  // namespace mongo
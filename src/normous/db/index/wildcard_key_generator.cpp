@@ -30,8 +30,13 @@
 
 #include "mongo/db/index/wildcard_key_generator.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "mongo/db/jsobj.h"
 #include "mongo/db/query/collation/collation_index_key.h"
+#include "mongo/db/storage/key_string_set.h"
+#include "mongo/stdx/memory.h"
 
 namespace mongo {
 namespace {
@@ -40,36 +45,25 @@ namespace {
 // to prevent the _id field from being indexed, since it already has its own dedicated index.
 static const BSONObj kDefaultProjection = BSON("_id"_sd << 0);
 
-// If the enclosing object is an array, then the current element's fieldname is the array index, so
-// we omit this when computing the full path. Otherwise, the full path is the pathPrefix plus the
-// element's fieldname.
-void pushPathComponent(BSONElement elem, bool enclosingObjIsArray, FieldRef* pathPrefix) {
-    if (!enclosingObjIsArray) {
-        pathPrefix->appendPart(elem.fieldNameStringData());
-    }
-}
+// An object from which the projection removed every field is indexed as the empty object.
+const BSONObj kEmptyObj = BSON("" << BSONObj());
+const BSONElement kEmptyObjElt = kEmptyObj.firstElement();
 
-// If the enclosing object is not an array, then the final path component should be its field name.
-// Verify that this is the case and then pop it off the FieldRef.
-void popPathComponent(BSONElement elem, bool enclosingObjIsArray, FieldRef* pathToElem) {
-    if (!enclosingObjIsArray) {
-        invariant(pathToElem->getPart(pathToElem->numParts() - 1) == elem.fieldNameStringData());
-        pathToElem->removeLastPart();
-    }
-}
-}  // namespace
+const BSONObj kUndefinedObj = BSON("" << BSONUndefined);
+const BSONElement kUndefinedElt = kUndefinedObj.firstElement();
 
-constexpr StringData WildcardKeyGenerator::kSubtreeSuffix;
+// Projections with more fields than this below a single path are not compiled, so that the first
+// occurrence of each projected field in an object can be tracked in a bitmask.
+constexpr size_t kMaxCompiledProjectionFields = 64;
 
-std::unique_ptr<ProjectionExecAgg> WildcardKeyGenerator::createProjectionExec(
-    BSONObj keyPattern, BSONObj pathProjection) {
+BSONObj makeProjectionSpec(BSONObj keyPattern, BSONObj pathProjection) {
     // We should never have a key pattern that contains more than a single element.
     invariant(keyPattern.nFields() == 1);
 
     // The _keyPattern is either { "$**": ±1 } for all paths or { "path.$**": ±1 } for a single
     // subtree. If we are indexing a single subtree, then we will project just that path.
     auto indexRoot = keyPattern.firstElement().fieldNameStringData();
-    auto suffixPos = indexRoot.find(kSubtreeSuffix);
+    auto suffixPos = indexRoot.find(WildcardKeyGenerator::kSubtreeSuffix);
 
     // If we're indexing a single subtree, we can't also specify a path projection.
     invariant(suffixPos == std::string::npos || pathProjection.isEmpty());
@@ -77,15 +71,136 @@ std::unique_ptr<ProjectionExecAgg> WildcardKeyGenerator::createProjectionExec(
     // If this is a subtree projection, the projection spec is { "path.to.subtree": 1 }. Otherwise,
     // we use the path projection from the original command object. If the path projection is empty
     // we default to {_id: 0}, since empty projections are illegal and will be rejected when parsed.
-    auto projSpec = (suffixPos != std::string::npos
-                         ? BSON(indexRoot.substr(0, suffixPos) << 1)
-                         : pathProjection.isEmpty() ? kDefaultProjection : pathProjection);
+    return (suffixPos != std::string::npos
+                ? BSON(indexRoot.substr(0, suffixPos) << 1)
+                : pathProjection.isEmpty() ? kDefaultProjection : pathProjection);
+}
+}  // namespace
+
+/**
+ * The fields that a projection names at one depth of the document, each of which the projection
+ * either includes or excludes entirely, or projects further through a child node. This mirrors
+ * the tree of the parsed aggregation projection, but is evaluated directly against the BSON input
+ * document.
+ */
+struct WildcardKeyGenerator::ProjectionNode {
+    struct Entry {
+        std::string field;
+
+        // True if the projection names this field itself, rather than only paths below it.
+        bool isLeaf = false;
 
+        std::unique_ptr<ProjectionNode> child;
+    };
+
+    /**
+     * Returns the position in 'entries' of the entry for 'field', or -1 if there is none.
+     */
+    int find(StringData field) const {
+        auto it = std::lower_bound(
+            entries.begin(), entries.end(), field, [](const Entry& entry, StringData field) {
+                return StringData(entry.field) < field;
+            });
+        return (it != entries.end() && it->field == field) ? it - entries.begin() : -1;
+    }
+
+    /**
+     * Returns the entry for 'field', adding it if needed, or nullptr if the node already has the
+     * maximum number of entries.
+     */
+    Entry* findOrAdd(StringData field) {
+        auto it = std::lower_bound(
+            entries.begin(), entries.end(), field, [](const Entry& entry, StringData field) {
+                return StringData(entry.field) < field;
+            });
+        if (it != entries.end() && it->field == field) {
+            return &*it;
+        }
+        if (entries.size() == kMaxCompiledProjectionFields) {
+            return nullptr;
+        }
+        it = entries.insert(it, Entry());
+        it->field = field.toString();
+        return &*it;
+    }
+
+    /**
+     * Adds the fields of the projection 'spec', which has already been validated by the
+     * projection parser, below this node. Returns false if 'spec' uses anything besides field
+     * inclusions or exclusions, such as expressions, which are left to the projection executor.
+     */
+    bool add(const BSONObj& spec, bool isInclusion) {
+        for (auto&& elem : spec) {
+            StringData path = elem.fieldNameStringData();
+            ProjectionNode* node = this;
+            for (size_t dot = path.find('.'); dot != std::string::npos; dot = path.find('.')) {
+                Entry* entry = node->findOrAdd(path.substr(0, dot));
+                if (!entry || entry->isLeaf) {
+                    return false;
+                }
+                if (!entry->child) {
+                    entry->child = stdx::make_unique<ProjectionNode>();
+                }
+                node = entry->child.get();
+                path = path.substr(dot + 1);
+            }
+            if (path.empty() || path[0] == '$') {
+                return false;
+            }
+
+            if (elem.type() == BSONType::Object) {
+                Entry* entry = node->findOrAdd(path);
+                if (!entry || entry->isLeaf || elem.Obj().isEmpty()) {
+                    return false;
+                }
+                if (!entry->child) {
+                    entry->child = stdx::make_unique<ProjectionNode>();
+                }
+                if (!entry->child->add(elem.Obj(), isInclusion)) {
+                    return false;
+                }
+            } else if (elem.isNumber() || elem.isBoolean()) {
+                // The parser only lets _id be projected the opposite way to the other fields; the
+                // resulting output is the same as if it had not been named at all.
+                if (elem.trueValue() != isInclusion) {
+                    continue;
+                }
+                Entry* entry = node->findOrAdd(path);
+                if (!entry || entry->isLeaf || entry->child) {
+                    return false;
+                }
+                entry->isLeaf = true;
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Sorted by field name.
+    std::vector<Entry> entries;
+};
+
+struct WildcardKeyGenerator::KeyStringOutput {
+    KeyStringOutput(KeyStringSet* keys, Ordering ord)
+        : keys(keys), ord(ord), scratch(keys->getVersion()) {}
+
+    KeyStringSet* const keys;
+    const Ordering ord;
+
+    // Reused to encode each key before it is copied into 'keys'.
+    KeyString scratch;
+};
+
+constexpr StringData WildcardKeyGenerator::kSubtreeSuffix;
+
+std::unique_ptr<ProjectionExecAgg> WildcardKeyGenerator::createProjectionExec(
+    BSONObj keyPattern, BSONObj pathProjection) {
     // If the projection spec does not explicitly specify _id, we exclude it by default. We also
     // prevent the projection from recursing through nested arrays, in order to ensure that the
     // output document aligns with the match system's expectations.
     return ProjectionExecAgg::create(
-        projSpec,
+        makeProjectionSpec(keyPattern, pathProjection),
         ProjectionExecAgg::DefaultIdPolicy::kExcludeId,
         ProjectionExecAgg::ArrayRecursionPolicy::kDoNotRecurseNestedArrays);
 }
@@ -95,99 +210,224 @@ WildcardKeyGenerator::WildcardKeyGenerator(BSONObj keyPattern,
                                            const CollatorInterface* collator)
     : _collator(collator), _keyPattern(keyPattern) {
     _projExec = createProjectionExec(keyPattern, pathProjection);
+
+    // Compile the projection, so that keys can be generated in a single pass over the input
+    // document rather than by first building the projected document.
+    const auto projSpec = makeProjectionSpec(keyPattern, pathProjection);
+    _isInclusion =
+        _projExec->getType() == ProjectionExecAgg::ProjectionType::kInclusionProjection;
+
+    auto projection = stdx::make_unique<ProjectionNode>();
+    bool compiled = projection->add(projSpec, _isInclusion);
+
+    const bool idSpecified = std::any_of(projSpec.begin(), projSpec.end(), [](BSONElement elem) {
+        auto fieldName = elem.fieldNameStringData();
+        return fieldName == "_id"_sd || fieldName.startsWith("_id."_sd);
+    });
+    if (compiled && !_isInclusion && !idSpecified) {
+        // An exclusion which does not mention _id removes it, per the default _id policy.
+        auto entry = projection->findOrAdd("_id"_sd);
+        compiled = entry && !entry->child;
+        if (compiled) {
+            entry->isLeaf = true;
+        }
+    }
+
+    if (compiled) {
+        _projection = std::move(projection);
+    }
 }
 
+WildcardKeyGenerator::~WildcardKeyGenerator() = default;
+
 void WildcardKeyGenerator::generateKeys(BSONObj inputDoc,
                                         BSONObjSet* keys,
                                         BSONObjSet* multikeyPaths) const {
-    FieldRef rootPath;
-    _traverseWildcard(_projExec->applyProjection(inputDoc), false, &rootPath, keys, multikeyPaths);
+    std::string path;
+    if (_projection) {
+        _traverseWildcard(inputDoc, false, _projection.get(), &path, 0, keys, multikeyPaths);
+    } else {
+        _traverseWildcard(
+            _projExec->applyProjection(inputDoc), false, nullptr, &path, 0, keys, multikeyPaths);
+    }
 }
 
-void WildcardKeyGenerator::_traverseWildcard(BSONObj obj,
-                                             bool objIsArray,
-                                             FieldRef* path,
-                                             BSONObjSet* keys,
-                                             BSONObjSet* multikeyPaths) const {
+void WildcardKeyGenerator::generateKeys(BSONObj inputDoc,
+                                        Ordering ord,
+                                        KeyStringSet* keys,
+                                        BSONObjSet* multikeyPaths) const {
+    keys->clear();
+    KeyStringOutput output(keys, ord);
+
+    std::string path;
+    if (_projection) {
+        _traverseWildcard(inputDoc, false, _projection.get(), &path, 0, &output, multikeyPaths);
+    } else {
+        _traverseWildcard(_projExec->applyProjection(inputDoc),
+                          false,
+                          nullptr,
+                          &path,
+                          0,
+                          &output,
+                          multikeyPaths);
+    }
+    keys->finish();
+}
+
+template <typename Output>
+size_t WildcardKeyGenerator::_traverseWildcard(BSONObj obj,
+                                               bool objIsArray,
+                                               const ProjectionNode* node,
+                                               std::string* path,
+                                               size_t numPathParts,
+                                               Output* keys,
+                                               BSONObjSet* multikeyPaths) const {
+    size_t numPreserved = 0;
+
+    // An exclusion projection, like the aggregation projection it mirrors, only applies to the
+    // first field of each name in an object. These are the projected fields seen so far.
+    uint64_t seenEntries = 0;
+
+    const size_t pathSize = path->size();
+    const size_t numChildPathParts = objIsArray ? numPathParts : numPathParts + 1;
     for (const auto elem : obj) {
+        // Determine whether the projection preserves this element, and the projection node to
+        // apply below it.
+        const ProjectionNode* childNode = nullptr;
+        if (!node) {
+            // No projection applies; the whole subtree is preserved.
+        } else if (objIsArray) {
+            // The projection applies to each element of an array. An inclusion drops any scalars
+            // and nested arrays, while an exclusion leaves them as they are.
+            if (_isInclusion && elem.type() != BSONType::Object) {
+                continue;
+            }
+            childNode = node;
+        } else {
+            const int pos = node->find(elem.fieldNameStringData());
+            const bool firstOccurrence = pos >= 0 && !(seenEntries & (uint64_t{1} << pos));
+            if (pos >= 0) {
+                seenEntries |= uint64_t{1} << pos;
+            }
+
+            if (_isInclusion) {
+                if (pos < 0) {
+                    continue;
+                }
+                const auto& entry = node->entries[pos];
+                if (!entry.isLeaf) {
+                    // Only objects and arrays have the paths below this field.
+                    if (!elem.isABSONObj()) {
+                        continue;
+                    }
+                    childNode = entry.child.get();
+                }
+            } else if (firstOccurrence) {
+                const auto& entry = node->entries[pos];
+                if (entry.isLeaf) {
+                    continue;
+                }
+                childNode = entry.child.get();
+            }
+        }
+        ++numPreserved;
+
         // If the element's fieldName contains a ".", fast-path skip it because it's not queryable.
         if (elem.fieldNameStringData().find('.', 0) != std::string::npos)
             continue;
 
-        // Append the element's fieldname to the path, if the enclosing object is not an array.
-        pushPathComponent(elem, objIsArray, path);
+        // Append the element's fieldname to the path, if the enclosing object is not an array. If
+        // the enclosing object is an array, then the current element's fieldname is the array
+        // index, so we omit it when computing the full path.
+        if (!objIsArray) {
+            if (numPathParts > 0) {
+                path->push_back('.');
+            }
+            path->append(elem.fieldName(), elem.fieldNameSize() - 1);
+        }
 
         switch (elem.type()) {
             case BSONType::Array:
                 // If this is a nested array, we don't descend it but instead index it as a value.
-                if (_addKeyForNestedArray(elem, *path, objIsArray, keys))
+                if (objIsArray) {
+                    _addKey(elem, *path, keys);
                     break;
+                }
 
-                // Add an entry for the multi-key path, and then fall through to BSONType::Object.
+                // Add an entry for the multi-key path. In keeping with the behaviour of regular
+                // indexes, an empty array is indexed as 'undefined'.
                 _addMultiKey(*path, multikeyPaths);
+                if (_traverseWildcard(elem.Obj(),
+                                      true,
+                                      childNode,
+                                      path,
+                                      numChildPathParts,
+                                      keys,
+                                      multikeyPaths) == 0) {
+                    _addKey(kUndefinedElt, *path, keys);
+                }
+                break;
 
             case BSONType::Object:
-                if (_addKeyForEmptyLeaf(elem, *path, keys))
-                    break;
-
-                _traverseWildcard(
-                    elem.Obj(), elem.type() == BSONType::Array, path, keys, multikeyPaths);
+                // An empty object is indexed as-is.
+                if (_traverseWildcard(elem.Obj(),
+                                      false,
+                                      childNode,
+                                      path,
+                                      numChildPathParts,
+                                      keys,
+                                      multikeyPaths) == 0) {
+                    _addKey(kEmptyObjElt, *path, keys);
+                }
                 break;
 
             default:
                 _addKey(elem, *path, keys);
         }
 
-        // Remove the element's fieldname from the path, if it was pushed onto it earlier.
-        popPathComponent(elem, objIsArray, path);
-    }
-}
-
-bool WildcardKeyGenerator::_addKeyForNestedArray(BSONElement elem,
-                                                 const FieldRef& fullPath,
-                                                 bool enclosingObjIsArray,
-                                                 BSONObjSet* keys) const {
-    // If this element is an array whose parent is also an array, index it as a value.
-    if (enclosingObjIsArray && elem.type() == BSONType::Array) {
-        _addKey(elem, fullPath, keys);
-        return true;
+        // Remove the element's fieldname from the path, if it was appended earlier.
+        path->resize(pathSize);
     }
-    return false;
-}
 
-bool WildcardKeyGenerator::_addKeyForEmptyLeaf(BSONElement elem,
-                                               const FieldRef& fullPath,
-                                               BSONObjSet* keys) const {
-    invariant(elem.isABSONObj());
-    if (elem.embeddedObject().isEmpty()) {
-        // In keeping with the behaviour of regular indexes, an empty object is indexed as-is while
-        // empty arrays are indexed as 'undefined'.
-        _addKey(elem.type() == BSONType::Array ? BSONElement{} : elem, fullPath, keys);
-        return true;
-    }
-    return false;
+    return numPreserved;
 }
 
 void WildcardKeyGenerator::_addKey(BSONElement elem,
-                                   const FieldRef& fullPath,
+                                   StringData fullPath,
                                    BSONObjSet* keys) const {
     // Wildcard keys are of the form { "": "path.to.field", "": <collation-aware value> }.
     BSONObjBuilder bob;
-    bob.append("", fullPath.dottedField());
-    if (elem) {
-        CollationIndexKey::collationAwareIndexKeyAppend(elem, _collator, &bob);
+    bob.append("", fullPath);
+    CollationIndexKey::collationAwareIndexKeyAppend(elem, _collator, &bob);
+    keys->insert(bob.obj());
+}
+
+void WildcardKeyGenerator::_addKey(BSONElement elem,
+                                   StringData fullPath,
+                                   KeyStringOutput* keys) const {
+    KeyString& keyString = keys->scratch;
+    keyString.resetToEmpty();
+    keyString.appendString(fullPath, keys->ord.get(0) == -1);
+
+    const bool invert = keys->ord.get(1) == -1;
+    if (_collator && CollationIndexKey::isCollatableType(elem.type())) {
+        // Strings, including those nested in objects and arrays, are replaced by their collation
+        // comparison keys, which only the BSON form can express.
+        BSONObjBuilder b;
+        CollationIndexKey::collationAwareIndexKeyAppend(elem, _collator, &b);
+        keyString.appendBSONElement(b.done().firstElement(), invert);
     } else {
-        bob.appendUndefined("");
+        keyString.appendBSONElement(elem, invert);
     }
-    keys->insert(bob.obj());
+    keys->keys->add(keyString);
 }
 
-void WildcardKeyGenerator::_addMultiKey(const FieldRef& fullPath, BSONObjSet* multikeyPaths) const {
+void WildcardKeyGenerator::_addMultiKey(StringData fullPath, BSONObjSet* multikeyPaths) const {
     // Multikey paths are denoted by a key of the form { "": 1, "": "path.to.array" }. The argument
     // 'multikeyPaths' may be nullptr if the access method is being used in an operation which does
     // not require multikey path generation.
     if (multikeyPaths) {
-        multikeyPaths->insert(BSON("" << 1 << "" << fullPath.dottedField()));
+        multikeyPaths->insert(BSON("" << 1 << "" << fullPath));
     }
 }
 
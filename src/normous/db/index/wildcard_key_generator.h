@@ -28,12 +28,18 @@
 
 #pragma once
 
+#include <memory>
+#include <string>
+
+#include "mongo/bson/ordering.h"
 #include "mongo/db/exec/projection_exec_agg.h"
 #include "mongo/db/field_ref.h"
 #include "mongo/db/query/collation/collator_interface.h"
 
 namespace mongo {
 
+class KeyStringSet;
+
 /**
  * This class is responsible for generating an aggregation projection based on the keyPattern and
  * pathProjection specs, and for subsequently extracting the set of all path-value pairs for each
@@ -55,6 +61,8 @@ public:
                          BSONObj pathProjection,
                          const CollatorInterface* collator);
 
+    ~WildcardKeyGenerator();
+
     /**
      * Applies the appropriate Wildcard projection to the input doc, and then adds one key-value
      * pair to the BSONObjSet 'keys' for each leaf node in the post-projection document:
@@ -65,27 +73,47 @@ public:
      */
     void generateKeys(BSONObj inputDoc, BSONObjSet* keys, BSONObjSet* multikeyPaths) const;
 
+    /**
+     * Like the BSONObjSet overload, but replaces the contents of 'keys' with the KeyString
+     * encodings of the keys under ordering 'ord', built without materializing the BSON keys.
+     */
+    void generateKeys(BSONObj inputDoc,
+                      Ordering ord,
+                      KeyStringSet* keys,
+                      BSONObjSet* multikeyPaths) const;
+
 private:
-    // Traverses every path of the post-projection document, adding keys to the set as it goes.
-    void _traverseWildcard(BSONObj obj,
-                           bool objIsArray,
-                           FieldRef* path,
-                           BSONObjSet* keys,
-                           BSONObjSet* multikeyPaths) const;
+    // A node of the projection compiled into a trie of field names. Defined in the .cpp file.
+    struct ProjectionNode;
 
-    // Helper functions to format the entry appropriately before adding it to the key/path tracker.
-    void _addMultiKey(const FieldRef& fullPath, BSONObjSet* multikeyPaths) const;
-    void _addKey(BSONElement elem, const FieldRef& fullPath, BSONObjSet* keys) const;
+    // Where the KeyString overload of generateKeys() writes its keys.
+    struct KeyStringOutput;
 
-    // Helper to check whether the element is a nested array, and conditionally add it to 'keys'.
-    bool _addKeyForNestedArray(BSONElement elem,
-                               const FieldRef& fullPath,
-                               bool enclosingObjIsArray,
-                               BSONObjSet* keys) const;
-    bool _addKeyForEmptyLeaf(BSONElement elem, const FieldRef& fullPath, BSONObjSet* keys) const;
+    // Traverses every path of 'obj' that the projection rooted at 'node' preserves, adding keys
+    // as it goes, and returns the number of fields of 'obj' that the projection preserves. A null
+    // 'node' preserves every field. 'path' holds the dotted path to 'obj', made of 'numPathParts'
+    // field names, on entry and on return.
+    template <typename Output>
+    size_t _traverseWildcard(BSONObj obj,
+                             bool objIsArray,
+                             const ProjectionNode* node,
+                             std::string* path,
+                             size_t numPathParts,
+                             Output* keys,
+                             BSONObjSet* multikeyPaths) const;
+
+    // Helper functions to format the entry appropriately before adding it to the key/path tracker.
+    void _addMultiKey(StringData fullPath, BSONObjSet* multikeyPaths) const;
+    void _addKey(BSONElement elem, StringData fullPath, BSONObjSet* keys) const;
+    void _addKey(BSONElement elem, StringData fullPath, KeyStringOutput* keys) const;
 
     std::unique_ptr<ProjectionExecAgg> _projExec;
     const CollatorInterface* _collator;
     const BSONObj _keyPattern;
+
+    // The projection of '_projExec' compiled for use directly on the input document, or null if
+    // it could not be compiled, in which case documents are first projected by '_projExec'.
+    std::unique_ptr<ProjectionNode> _projection;
+    bool _isInclusion = false;
 };
 }  // namespace mongo
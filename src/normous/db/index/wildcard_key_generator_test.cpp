@@ -33,6 +33,7 @@
 #include "mongo/bson/json.h"
 #include "mongo/db/index/wildcard_key_generator.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/db/storage/key_string_set.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/log.h"
 
@@ -967,5 +968,132 @@ TEST(WildcardKeyGeneratorDottedFieldsTest, DoNotIndexDottedFieldsWithSimilarSubp
     ASSERT(assertKeysetsEqual(expectedMultikeyPaths, multikeyMetadataKeys));
 }
 
+// Tests that the projection compiled by the key generator produces the same keys as traversing
+// the document projected by the aggregation projection.
+
+void assertKeysMatchProjectedDocument(const BSONObj& keyPattern,
+                                      const BSONObj& pathProjection,
+                                      const BSONObj& inputDoc) {
+    WildcardKeyGenerator keyGen{keyPattern, pathProjection, nullptr};
+    auto outputKeys = makeKeySet();
+    auto multikeyMetadataKeys = makeKeySet();
+    keyGen.generateKeys(inputDoc, &outputKeys, &multikeyMetadataKeys);
+
+    // Index the whole projected document. The exclusion of a field which does not appear in any
+    // of the test documents preserves every field, including _id.
+    const auto projectedDoc =
+        WildcardKeyGenerator::createProjectionExec(keyPattern, pathProjection)
+            ->applyProjection(inputDoc);
+    WildcardKeyGenerator fullDocKeyGen{
+        fromjson("{'$**': 1}"), fromjson("{_id: 1, notInAnyDocument: 0}"), nullptr};
+    auto expectedKeys = makeKeySet();
+    auto expectedMultikeyPaths = makeKeySet();
+    fullDocKeyGen.generateKeys(projectedDoc, &expectedKeys, &expectedMultikeyPaths);
+
+    ASSERT(assertKeysetsEqual(expectedKeys, outputKeys))
+        << "key pattern " << keyPattern << ", projection " << pathProjection << ", document "
+        << inputDoc;
+    ASSERT(assertKeysetsEqual(expectedMultikeyPaths, multikeyMetadataKeys))
+        << "key pattern " << keyPattern << ", projection " << pathProjection << ", document "
+        << inputDoc;
+}
+
+TEST(WildcardKeyGeneratorCompiledProjectionTest, MatchesProjectedDocument) {
+    const std::vector<BSONObj> docs{
+        fromjson("{_id: 1, a: [1, [2, 3], {b: 1, c: 2}, {c: 3}, []], d: {b: {c: 1}}, e: 1}"),
+        fromjson("{a: {c: 1}, d: [[{b: 1}]], 'x.y': 1, e: [{}, {f: 1}]}"),
+        fromjson("{a: [{b: [1, {c: 2}, [3]]}, {b: {c: [3]}}], e: {}}"),
+        fromjson("{_id: {a: 1, b: 2}, a: {b: {}, c: {b: 1}}, d: {b: 1, c: []}}"),
+        fromjson("{'': {b: 1}, a: {'': 1, b: {'': 2}}}"),
+        // Projections only apply to the first of several fields of the same name.
+        BSON("a" << BSON("b" << 1 << "c" << 1) << "a" << BSON("b" << 2) << "e" << 1 << "e"
+                 << 2),
+    };
+    const std::vector<std::pair<const char*, const char*>> indexes{
+        {"{'$**': 1}", "{}"},
+        {"{'$**': 1}", "{a: 1}"},
+        {"{'$**': 1}", "{'a.b': 1}"},
+        {"{'$**': 1}", "{a: {b: 1}, e: 1}"},
+        {"{'$**': 1}", "{'a.c': 1, 'd.b': 1}"},
+        {"{'$**': 1}", "{_id: 1, 'a.b': 1}"},
+        {"{'$**': 1}", "{'_id.a': 1, d: true}"},
+        {"{'$**': 1}", "{_id: 0, a: 1}"},
+        {"{'$**': 1}", "{a: 0}"},
+        {"{'$**': 1}", "{'a.b': 0}"},
+        {"{'$**': 1}", "{a: {b: 0}, 'd.b': 0, e: false}"},
+        {"{'$**': 1}", "{_id: 1, 'a.c': 0}"},
+        {"{'$**': 1}", "{'_id.b': 0, a: 0}"},
+        {"{'a.$**': 1}", "{}"},
+        {"{'a.b.$**': 1}", "{}"},
+        {"{'d.$**': 1}", "{}"},
+    };
+
+    for (const auto& index : indexes) {
+        for (const auto& doc : docs) {
+            assertKeysMatchProjectedDocument(fromjson(index.first), fromjson(index.second), doc);
+        }
+    }
+}
+
+TEST(WildcardKeyGeneratorCompiledProjectionTest, InclusionOfSubpathDropsScalarArrayElements) {
+    WildcardKeyGenerator keyGen{fromjson("{'$**': 1}"), fromjson("{'a.b': 1}"), nullptr};
+    auto inputDoc = fromjson("{a: [1, [{b: 2}], {b: 3}]}");
+
+    auto expectedKeys = makeKeySet({fromjson("{'': 'a.b', '': 3}")});
+    auto expectedMultikeyPaths = makeKeySet({fromjson("{'': 1, '': 'a'}")});
+
+    auto outputKeys = makeKeySet();
+    auto multikeyMetadataKeys = makeKeySet();
+    keyGen.generateKeys(inputDoc, &outputKeys, &multikeyMetadataKeys);
+
+    ASSERT(assertKeysetsEqual(expectedKeys, outputKeys));
+    ASSERT(assertKeysetsEqual(expectedMultikeyPaths, multikeyMetadataKeys));
+}
+
+TEST(WildcardKeyGeneratorCompiledProjectionTest, ProjectedAwayContentsIndexedAsEmpty) {
+    WildcardKeyGenerator keyGen{fromjson("{'$**': 1}"), fromjson("{'a.b': 1, 'c.b': 1}"), nullptr};
+    auto inputDoc = fromjson("{a: {c: 1}, c: [1, 2]}");
+
+    auto expectedKeys =
+        makeKeySet({fromjson("{'': 'a', '': {}}"), fromjson("{'': 'c', '': undefined}")});
+    auto expectedMultikeyPaths = makeKeySet({fromjson("{'': 1, '': 'c'}")});
+
+    auto outputKeys = makeKeySet();
+    auto multikeyMetadataKeys = makeKeySet();
+    keyGen.generateKeys(inputDoc, &outputKeys, &multikeyMetadataKeys);
+
+    ASSERT(assertKeysetsEqual(expectedKeys, outputKeys));
+    ASSERT(assertKeysetsEqual(expectedMultikeyPaths, multikeyMetadataKeys));
+}
+
+TEST(WildcardKeyGeneratorKeyStringTest, MatchesBSONKeys) {
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kReverseString);
+    WildcardKeyGenerator keyGen{fromjson("{'$**': 1}"), fromjson("{b: 0}"), &collator};
+    auto inputDoc = fromjson("{a: [{c: 'x'}, 1, [2, 'y']], b: 1, d: {}, e: [], f: {g: 'z'}}");
+
+    auto bsonKeys = makeKeySet();
+    auto bsonMultikeyPaths = makeKeySet();
+    keyGen.generateKeys(inputDoc, &bsonKeys, &bsonMultikeyPaths);
+
+    const Ordering ord = Ordering::make(BSONObj());
+    KeyStringSet expectedKeys(KeyString::Version::V1);
+    for (const auto& key : bsonKeys) {
+        expectedKeys.add(KeyString(KeyString::Version::V1, key, ord));
+    }
+    expectedKeys.finish();
+
+    KeyStringSet keys(KeyString::Version::V1);
+    auto multikeyPaths = makeKeySet();
+    keyGen.generateKeys(inputDoc, ord, &keys, &multikeyPaths);
+
+    ASSERT(assertKeysetsEqual(bsonMultikeyPaths, multikeyPaths));
+    ASSERT_EQ(expectedKeys.size(), keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        ASSERT_BSONOBJ_EQ(expectedKeys[i].toBson(ord), keys[i].toBson(ord));
+        ASSERT_EQ(expectedKeys[i].getSize(), keys[i].getSize());
+        ASSERT_EQ(0, memcmp(expectedKeys[i].getBuffer(), keys[i].getBuffer(), keys[i].getSize()));
+    }
+}
+
 }  // namespace
 }  // namespace mongo
@@ -47,6 +47,7 @@ enum IndexType {
     INDEX_TEXT,
     INDEX_HASHED,
     INDEX_WILDCARD,
+    INDEX_COLUMN,
 };
 
 /**
@@ -62,6 +63,7 @@ public:
     static const std::string HASHED;
     static const std::string TEXT;
     static const std::string WILDCARD;
+    static const std::string COLUMN;
 
     /**
      * Return the first std::string value in the provided object.  For an index key pattern,
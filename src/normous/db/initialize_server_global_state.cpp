@@ -50,8 +50,11 @@
 #include "mongo/db/auth/internal_user_auth.h"
 #include "mongo/db/auth/sasl_command_constants.h"
 #include "mongo/db/auth/security_key.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/server_options.h"
 #include "mongo/db/server_parameters.h"
+#include "mongo/logger/async_file_appender.h"
+#include "mongo/logger/async_log_writer.h"
 #include "mongo/logger/console_appender.h"
 #include "mongo/logger/logger.h"
 #include "mongo/logger/message_event.h"
@@ -62,6 +65,7 @@
 #include "mongo/logger/rotatable_file_writer.h"
 #include "mongo/logger/syslog_appender.h"
 #include "mongo/platform/process_id.h"
+#include "mongo/util/exit.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/net/ssl_manager.h"
@@ -211,10 +215,25 @@ void forkServerOrDie() {
 }
 
 MONGO_EXPORT_SERVER_PARAMETER(maxLogSizeKB, int, logger::LogContext::kDefaultMaxLogSizeKB);
+
+namespace {
+
+// When logging to a file, whether messages are written to it from a background thread, and how
+// much formatted output may be waiting to be written before further messages are dropped.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(logWritesAsync, bool, false);
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(asyncLogMaxQueuedKB, int, 16 * 1024);
+
+ServerStatusMetricField<Counter64> displayDroppedLogMessages(
+    "log.droppedMessages", &logger::AsyncLogWriter::droppedMessages());
+
+}  // namespace
+
 MONGO_INITIALIZER_GENERAL(ServerLogRedirection,
                           ("GlobalLogManager", "EndStartupOptionHandling", "ForkServer"),
                           ("default"))
 (InitializerContext*) {
+    using logger::AsyncFileAppender;
+    using logger::AsyncLogWriter;
     using logger::LogManager;
     using logger::MessageEventEphemeral;
     using logger::MessageEventDetailsEncoder;
@@ -298,12 +317,32 @@ MONGO_INITIALIZER_GENERAL(ServerLogRedirection,
 
         LogManager* manager = logger::globalLogManager();
         manager->getGlobalDomain()->clearAppenders();
-        manager->getGlobalDomain()->attachAppender(
-            std::make_unique<RotatableFileAppender<MessageEventEphemeral>>(
-                std::make_unique<MessageEventDetailsEncoder>(), writer.getValue()));
-        manager->getNamedDomain("javascriptOutput")
-            ->attachAppender(std::make_unique<RotatableFileAppender<MessageEventEphemeral>>(
-                std::make_unique<MessageEventDetailsEncoder>(), writer.getValue()));
+        if (logWritesAsync) {
+            if (asyncLogMaxQueuedKB <= 0) {
+                return Status(ErrorCodes::BadValue, "asyncLogMaxQueuedKB must be positive");
+            }
+
+            // Never destroyed, as log messages may be written until the process exits. Once
+            // shutdown runs, it writes out what is queued and leaves later messages to be written
+            // synchronously.
+            auto asyncWriter = new AsyncLogWriter(writer.getValue(),
+                                                  static_cast<size_t>(asyncLogMaxQueuedKB) * 1024);
+            registerShutdownTask([asyncWriter] { asyncWriter->shutdown(); });
+
+            manager->getGlobalDomain()->attachAppender(
+                std::make_unique<AsyncFileAppender<MessageEventEphemeral>>(
+                    std::make_unique<MessageEventDetailsEncoder>(), asyncWriter));
+            manager->getNamedDomain("javascriptOutput")
+                ->attachAppender(std::make_unique<AsyncFileAppender<MessageEventEphemeral>>(
+                    std::make_unique<MessageEventDetailsEncoder>(), asyncWriter));
+        } else {
+            manager->getGlobalDomain()->attachAppender(
+                std::make_unique<RotatableFileAppender<MessageEventEphemeral>>(
+                    std::make_unique<MessageEventDetailsEncoder>(), writer.getValue()));
+            manager->getNamedDomain("javascriptOutput")
+                ->attachAppender(std::make_unique<RotatableFileAppender<MessageEventEphemeral>>(
+                    std::make_unique<MessageEventDetailsEncoder>(), writer.getValue()));
+        }
 
         if (serverGlobalParams.logAppend && exists) {
             log() << "***** SERVER RESTARTED *****";
@@ -50,11 +50,33 @@ MONGO_EXPORT_STARTUP_SERVER_PARAMETER(
     int,
     LogicalSessionCacheImpl::kLogicalSessionDefaultRefresh.count());
 
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(logicalSessionRefreshThresholdMillis, int, 10 * 60 * 1000);
+
 MONGO_EXPORT_STARTUP_SERVER_PARAMETER(disableLogicalSessionCacheRefresh, bool, false);
 
 MONGO_EXPORT_STARTUP_SERVER_PARAMETER(maxSessions, int, 1'000'000);
 
 constexpr Milliseconds LogicalSessionCacheImpl::kLogicalSessionDefaultRefresh;
+constexpr size_t LogicalSessionCacheImpl::kNumCacheShards;
+
+namespace {
+
+/**
+ * A session whose record was last written 'threshold' ago is written again by the next refresh at
+ * the latest, so its record is never older than the threshold plus two refresh intervals. Caps the
+ * threshold to keep that within the session timeout.
+ */
+Milliseconds capRefreshThreshold(Milliseconds threshold,
+                                 Milliseconds refreshInterval,
+                                 Minutes sessionTimeout) {
+    const Milliseconds limit = sessionTimeout - refreshInterval * 2;
+    if (limit <= Milliseconds(0) || threshold <= Milliseconds(0)) {
+        return Milliseconds(0);
+    }
+    return std::min(threshold, limit);
+}
+
+}  // namespace
 
 LogicalSessionCacheImpl::LogicalSessionCacheImpl(
     std::unique_ptr<ServiceLiaison> service,
@@ -63,6 +85,8 @@ LogicalSessionCacheImpl::LogicalSessionCacheImpl(
     Options options)
     : _refreshInterval(options.refreshInterval),
       _sessionTimeout(options.sessionTimeout),
+      _refreshThreshold(capRefreshThreshold(
+          options.refreshThreshold, options.refreshInterval, options.sessionTimeout)),
       _service(std::move(service)),
       _sessionsColl(std::move(collection)),
       _transactionReaper(std::move(transactionReaper)) {
@@ -92,9 +116,10 @@ LogicalSessionCacheImpl::~LogicalSessionCacheImpl() {
 }
 
 Status LogicalSessionCacheImpl::promote(LogicalSessionId lsid) {
-    stdx::lock_guard<stdx::mutex> lk(_cacheMutex);
-    auto it = _activeSessions.find(lsid);
-    if (it == _activeSessions.end()) {
+    auto& shard = _shardFor(lsid);
+    stdx::lock_guard<stdx::mutex> lk(shard.mutex);
+    auto it = shard.activeSessions.find(lsid);
+    if (it == shard.activeSessions.end()) {
         return {ErrorCodes::NoSuchSession, "no matching session record found in the cache"};
     }
 
@@ -167,8 +192,7 @@ Date_t LogicalSessionCacheImpl::now() {
 }
 
 size_t LogicalSessionCacheImpl::size() {
-    stdx::lock_guard<stdx::mutex> lock(_cacheMutex);
-    return _activeSessions.size();
+    return _numActiveSessions.load();
 }
 
 void LogicalSessionCacheImpl::_periodicRefresh(Client* client) {
@@ -264,6 +288,7 @@ void LogicalSessionCacheImpl::_refresh(Client* client) {
         // Clear the refresh-related stats with the beginning of our run.
         _stats.setLastSessionsCollectionJobDurationMillis(0);
         _stats.setLastSessionsCollectionJobEntriesRefreshed(0);
+        _stats.setLastSessionsCollectionJobEntriesSkipped(0);
         _stats.setLastSessionsCollectionJobEntriesEnded(0);
         _stats.setLastSessionsCollectionJobCursorsClosed(0);
 
@@ -298,62 +323,114 @@ void LogicalSessionCacheImpl::_refresh(Client* client) {
         return;
     }
 
-    LogicalSessionIdSet staleSessions;
     LogicalSessionIdSet explicitlyEndingSessions;
-    LogicalSessionIdMap<LogicalSessionRecord> activeSessions;
-
-    // backSwapper creates a guard that in the case of a exception
-    // replaces the ending or active sessions that swapped out of of LogicalSessionCache,
-    // and merges in any records that had been added since we swapped them
-    // out.
-    auto backSwapper = [this](auto& member, auto& temp) {
-        return MakeGuard([this, &member, &temp] {
-            stdx::lock_guard<stdx::mutex> lk(_cacheMutex);
-            using std::swap;
-            swap(member, temp);
-            for (const auto& it : temp) {
-                member.emplace(it);
-            }
-        });
-    };
+    std::array<LogicalSessionIdMap<LogicalSessionRecord>, kNumCacheShards> activeSessions;
 
     {
-        using std::swap;
         stdx::lock_guard<stdx::mutex> lk(_cacheMutex);
+        using std::swap;
         swap(explicitlyEndingSessions, _endingSessions);
-        swap(activeSessions, _activeSessions);
     }
-    auto activeSessionsBackSwapper = backSwapper(_activeSessions, activeSessions);
-    auto explicitlyEndingBackSwaper = backSwapper(_endingSessions, explicitlyEndingSessions);
+    for (size_t i = 0; i < kNumCacheShards; ++i) {
+        stdx::lock_guard<stdx::mutex> lk(_cacheShards[i].mutex);
+        using std::swap;
+        swap(activeSessions[i], _cacheShards[i].activeSessions);
+        _numActiveSessions.subtractAndFetch(activeSessions[i].size());
+    }
+
+    // In the case of an exception, these guards merge the ending and active sessions swapped out
+    // of the cache back into it, along with any records that had been added since.
+    auto activeSessionsBackSwapper = MakeGuard([this, &activeSessions] {
+        for (size_t i = 0; i < kNumCacheShards; ++i) {
+            stdx::lock_guard<stdx::mutex> lk(_cacheShards[i].mutex);
+            for (const auto& it : activeSessions[i]) {
+                if (_cacheShards[i].activeSessions.insert(it).second) {
+                    _numActiveSessions.addAndFetch(1);
+                }
+            }
+        }
+    });
+    auto explicitlyEndingBackSwaper = MakeGuard([this, &explicitlyEndingSessions] {
+        stdx::lock_guard<stdx::mutex> lk(_cacheMutex);
+        _endingSessions.insert(explicitlyEndingSessions.begin(), explicitlyEndingSessions.end());
+    });
 
-    // remove all explicitlyEndingSessions from activeSessions
+    // Group the ending sessions and the sessions attached to running ops by shard.
+    std::array<std::vector<LogicalSessionId>, kNumCacheShards> endingByShard;
     for (const auto& lsid : explicitlyEndingSessions) {
-        activeSessions.erase(lsid);
+        activeSessions[_shardIndex(lsid)].erase(lsid);
+        endingByShard[_shardIndex(lsid)].push_back(lsid);
     }
 
-    // refresh all recently active sessions as well as for sessions attached to running ops
+    std::array<std::vector<LogicalSessionId>, kNumCacheShards> runningByShard;
+    for (const auto& lsid : _service->getActiveOpSessions()) {
+        // if a running op is the cause of an upsert, we won't have a user name for the record
+        if (explicitlyEndingSessions.count(lsid) > 0) {
+            continue;
+        }
+        runningByShard[_shardIndex(lsid)].push_back(lsid);
+    }
 
+    // Refresh all recently active sessions as well as the sessions attached to running ops, except
+    // for those whose records were written recently enough not to need it yet.
+    const Date_t refreshTime = now();
     LogicalSessionRecordSet activeSessionRecords{};
+    std::array<std::vector<LogicalSessionId>, kNumCacheShards> refreshedByShard;
+    size_t numSkipped = 0;
+    for (size_t i = 0; i < kNumCacheShards; ++i) {
+        auto& shard = _cacheShards[i];
+        stdx::lock_guard<stdx::mutex> lk(shard.mutex);
+        for (const auto& lsid : endingByShard[i]) {
+            shard.recentlyRefreshed.erase(lsid);
+        }
 
-    auto runningOpSessions = _service->getActiveOpSessions();
+        auto addRecord = [&](const LogicalSessionRecord& record) {
+            auto it = shard.recentlyRefreshed.find(record.getId());
+            if (it != shard.recentlyRefreshed.end() &&
+                refreshTime - it->second < _refreshThreshold) {
+                ++numSkipped;
+                return;
+            }
+            if (activeSessionRecords.insert(record).second) {
+                refreshedByShard[i].push_back(record.getId());
+            }
+        };
 
-    for (const auto& it : runningOpSessions) {
-        // if a running op is the cause of an upsert, we won't have a user name for the record
-        if (explicitlyEndingSessions.count(it) > 0) {
-            continue;
+        for (const auto& lsid : runningByShard[i]) {
+            auto it = activeSessions[i].find(lsid);
+            if (it == activeSessions[i].end()) {
+                addRecord(makeLogicalSessionRecord(lsid, now()));
+            }
+        }
+        for (const auto& it : activeSessions[i]) {
+            addRecord(it.second);
         }
-        activeSessionRecords.insert(makeLogicalSessionRecord(it, now()));
-    }
-    for (const auto& it : activeSessions) {
-        activeSessionRecords.insert(it.second);
     }
 
     // Refresh the active sessions in the sessions collection.
     uassertStatusOK(_sessionsColl->refreshSessions(opCtx, activeSessionRecords));
     activeSessionsBackSwapper.Dismiss();
+    if (_refreshThreshold > Milliseconds(0)) {
+        for (size_t i = 0; i < kNumCacheShards; ++i) {
+            auto& shard = _cacheShards[i];
+            stdx::lock_guard<stdx::mutex> lk(shard.mutex);
+            for (auto it = shard.recentlyRefreshed.begin();
+                 it != shard.recentlyRefreshed.end();) {
+                if (refreshTime - it->second >= _refreshThreshold) {
+                    it = shard.recentlyRefreshed.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            for (const auto& lsid : refreshedByShard[i]) {
+                shard.recentlyRefreshed[lsid] = refreshTime;
+            }
+        }
+    }
     {
         stdx::lock_guard<stdx::mutex> lk(_cacheMutex);
         _stats.setLastSessionsCollectionJobEntriesRefreshed(activeSessionRecords.size());
+        _stats.setLastSessionsCollectionJobEntriesSkipped(numSkipped);
     }
 
     // Remove the ending sessions from the sessions collection.
@@ -370,12 +447,12 @@ void LogicalSessionCacheImpl::_refresh(Client* client) {
     KillAllSessionsByPatternSet patterns;
 
     auto openCursorSessions = _service->getOpenCursorSessions();
-    // Exclude sessions added to _activeSessions from the openCursorSession to avoid race between
+    // Exclude sessions added to the cache from the openCursorSession to avoid race between
     // killing cursors on the removed sessions and creating sessions.
-    {
-        stdx::lock_guard<stdx::mutex> lk(_cacheMutex);
+    for (const auto& shard : _cacheShards) {
+        stdx::lock_guard<stdx::mutex> lk(shard.mutex);
 
-        for (const auto& it : _activeSessions) {
+        for (const auto& it : shard.activeSessions) {
             auto newSessionIt = openCursorSessions.find(it.first);
             if (newSessionIt != openCursorSessions.end()) {
                 openCursorSessions.erase(newSessionIt);
@@ -415,37 +492,47 @@ void LogicalSessionCacheImpl::endSessions(const LogicalSessionIdSet& sessions) {
 
 LogicalSessionCacheStats LogicalSessionCacheImpl::getStats() {
     stdx::lock_guard<stdx::mutex> lk(_cacheMutex);
-    _stats.setActiveSessionsCount(_activeSessions.size());
+    _stats.setActiveSessionsCount(_numActiveSessions.load());
     return _stats;
 }
 
 Status LogicalSessionCacheImpl::_addToCache(LogicalSessionRecord record) {
-    stdx::lock_guard<stdx::mutex> lk(_cacheMutex);
-    if (_activeSessions.size() >= static_cast<size_t>(maxSessions)) {
+    // The limit is checked without holding every shard's lock, so concurrent insertions may
+    // overshoot it by a few sessions.
+    if (_numActiveSessions.load() >= maxSessions) {
         return {ErrorCodes::TooManyLogicalSessions, "cannot add session into the cache"};
     }
-    _activeSessions.insert(std::make_pair(record.getId(), record));
+
+    auto& shard = _shardFor(record.getId());
+    stdx::lock_guard<stdx::mutex> lk(shard.mutex);
+    if (shard.activeSessions.insert(std::make_pair(record.getId(), record)).second) {
+        _numActiveSessions.addAndFetch(1);
+    }
     return Status::OK();
 }
 
 std::vector<LogicalSessionId> LogicalSessionCacheImpl::listIds() const {
-    stdx::lock_guard<stdx::mutex> lk(_cacheMutex);
     std::vector<LogicalSessionId> ret;
-    ret.reserve(_activeSessions.size());
-    for (const auto& id : _activeSessions) {
-        ret.push_back(id.first);
+    ret.reserve(_numActiveSessions.load());
+    for (const auto& shard : _cacheShards) {
+        stdx::lock_guard<stdx::mutex> lk(shard.mutex);
+        for (const auto& id : shard.activeSessions) {
+            ret.push_back(id.first);
+        }
     }
     return ret;
 }
 
 std::vector<LogicalSessionId> LogicalSessionCacheImpl::listIds(
     const std::vector<SHA256Block>& userDigests) const {
-    stdx::lock_guard<stdx::mutex> lk(_cacheMutex);
     std::vector<LogicalSessionId> ret;
-    for (const auto& it : _activeSessions) {
-        if (std::find(userDigests.cbegin(), userDigests.cend(), it.first.getUid()) !=
-            userDigests.cend()) {
-            ret.push_back(it.first);
+    for (const auto& shard : _cacheShards) {
+        stdx::lock_guard<stdx::mutex> lk(shard.mutex);
+        for (const auto& it : shard.activeSessions) {
+            if (std::find(userDigests.cbegin(), userDigests.cend(), it.first.getUid()) !=
+                userDigests.cend()) {
+                ret.push_back(it.first);
+            }
         }
     }
     return ret;
@@ -453,9 +540,10 @@ std::vector<LogicalSessionId> LogicalSessionCacheImpl::listIds(
 
 boost::optional<LogicalSessionRecord> LogicalSessionCacheImpl::peekCached(
     const LogicalSessionId& id) const {
-    stdx::lock_guard<stdx::mutex> lk(_cacheMutex);
-    const auto it = _activeSessions.find(id);
-    if (it == _activeSessions.end()) {
+    const auto& shard = _shardFor(id);
+    stdx::lock_guard<stdx::mutex> lk(shard.mutex);
+    const auto it = shard.activeSessions.find(id);
+    if (it == shard.activeSessions.end()) {
         return boost::none;
     }
     return it->second;
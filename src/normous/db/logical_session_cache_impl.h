@@ -28,6 +28,8 @@
 
 #pragma once
 
+#include <array>
+
 #include "mongo/db/logical_session_cache.h"
 #include "mongo/db/logical_session_id.h"
 #include "mongo/db/refresh_sessions_gen.h"
@@ -46,6 +48,7 @@ class OperationContext;
 class ServiceContext;
 
 extern int logicalSessionRefreshMillis;
+extern int logicalSessionRefreshThresholdMillis;
 
 /**
  * A thread-safe cache structure for logical session records.
@@ -82,6 +85,17 @@ public:
          * May be set with --setParameter logicalSessionRefreshMillis=X.
          */
         Milliseconds refreshInterval = Milliseconds(logicalSessionRefreshMillis);
+
+        /**
+         * How long after a session record was written to the sessions collection a refresh may
+         * skip writing it again, for sessions in use across consecutive refreshes.
+         *
+         * By default, this is set to 10 minutes (600,000). It is capped so that a skipped record
+         * is always written again well before it could expire.
+         *
+         * May be set with --setParameter logicalSessionRefreshThresholdMillis=X.
+         */
+        Milliseconds refreshThreshold = Milliseconds(logicalSessionRefreshThresholdMillis);
     };
 
     /**
@@ -128,6 +142,34 @@ public:
     LogicalSessionCacheStats getStats() override;
 
 private:
+    /**
+     * The active sessions are split across several independently locked shards by the hash of
+     * their id, so that concurrent operations on different sessions don't contend on one mutex.
+     */
+    static constexpr size_t kNumCacheShards = 16;
+
+    struct CacheShard {
+        mutable stdx::mutex mutex;
+
+        LogicalSessionIdMap<LogicalSessionRecord> activeSessions;
+
+        // The sessions whose records were written to the sessions collection within the refresh
+        // threshold, with the time of the write. Only accessed by refreshes.
+        LogicalSessionIdMap<Date_t> recentlyRefreshed;
+    };
+
+    static size_t _shardIndex(const LogicalSessionId& lsid) {
+        return LogicalSessionIdHash{}(lsid) % kNumCacheShards;
+    }
+
+    CacheShard& _shardFor(const LogicalSessionId& lsid) {
+        return _cacheShards[_shardIndex(lsid)];
+    }
+
+    const CacheShard& _shardFor(const LogicalSessionId& lsid) const {
+        return _cacheShards[_shardIndex(lsid)];
+    }
+
     /**
      * Internal methods to handle scheduling and perform refreshes for active
      * session records contained within the cache.
@@ -150,8 +192,9 @@ private:
 
     const Milliseconds _refreshInterval;
     const Minutes _sessionTimeout;
+    const Milliseconds _refreshThreshold;
 
-    // This value is only modified under the lock, and is modified
+    // This value is only modified under _cacheMutex, and is modified
     // automatically by the background jobs.
     LogicalSessionCacheStats _stats;
 
@@ -161,9 +204,13 @@ private:
     mutable stdx::mutex _reaperMutex;
     std::shared_ptr<TransactionReaper> _transactionReaper;
 
+    // Guards _stats and _endingSessions.
     mutable stdx::mutex _cacheMutex;
 
-    LogicalSessionIdMap<LogicalSessionRecord> _activeSessions;
+    std::array<CacheShard, kNumCacheShards> _cacheShards;
+
+    // The total number of active sessions over all of the shards.
+    AtomicWord<long long> _numActiveSessions{0};
 
     LogicalSessionIdSet _endingSessions;
 
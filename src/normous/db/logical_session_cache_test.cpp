@@ -246,6 +246,73 @@ TEST_F(LogicalSessionCacheTest, ManySignedLsidsInCacheRefresh) {
     ASSERT(cache()->refreshNow(getClient()).isOK());
 }
 
+// Test that a session used across consecutive refreshes is only rewritten once its record was last
+// written longer than the refresh threshold ago
+TEST_F(LogicalSessionCacheTest, RecentlyRefreshedSessionsAreSkipped) {
+    auto lsid = makeLogicalSessionIdForTest();
+    size_t refreshed = 0;
+    sessions()->setRefreshHook([&refreshed](const LogicalSessionRecordSet& sessions) {
+        refreshed = sessions.size();
+        return Status::OK();
+    });
+
+    ASSERT_OK(cache()->vivify(opCtx(), lsid));
+    clearOpCtx();
+    ASSERT_OK(cache()->refreshNow(getClient()));
+    ASSERT_EQ(refreshed, 1U);
+
+    // Used again within the threshold, the session's record is fresh enough to skip.
+    setOpCtx();
+    ASSERT_OK(cache()->vivify(opCtx(), lsid));
+    clearOpCtx();
+    service()->fastForward(kForceRefresh);
+    ASSERT_OK(cache()->refreshNow(getClient()));
+    ASSERT_EQ(refreshed, 0U);
+    ASSERT_EQ(cache()->getStats().getLastSessionsCollectionJobEntriesSkipped(), 1);
+
+    // Once the threshold has passed the record is written again.
+    setOpCtx();
+    ASSERT_OK(cache()->vivify(opCtx(), lsid));
+    clearOpCtx();
+    service()->fastForward(kForceRefresh);
+    ASSERT_OK(cache()->refreshNow(getClient()));
+    ASSERT_EQ(refreshed, 1U);
+
+    // Ending a session forgets when it was written, so starting it again writes it right away.
+    cache()->endSessions({lsid});
+    ASSERT_OK(cache()->refreshNow(getClient()));
+    setOpCtx();
+    ASSERT_OK(cache()->vivify(opCtx(), lsid));
+    clearOpCtx();
+    ASSERT_OK(cache()->refreshNow(getClient()));
+    ASSERT_EQ(refreshed, 1U);
+}
+
+// Test that sessions spread over the shards of the cache are all listed and refreshed
+TEST_F(LogicalSessionCacheTest, SessionsInAllShardsAreListed) {
+    LogicalSessionIdSet lsids;
+    for (int i = 0; i < 100; ++i) {
+        auto lsid = makeLogicalSessionIdForTest();
+        ASSERT_OK(cache()->vivify(opCtx(), lsid));
+        lsids.insert(lsid);
+    }
+    ASSERT_EQ(cache()->size(), 100U);
+
+    auto listed = cache()->listIds();
+    ASSERT_EQ(listed.size(), 100U);
+    for (const auto& lsid : listed) {
+        ASSERT(lsids.count(lsid));
+        ASSERT(cache()->peekCached(lsid));
+    }
+
+    clearOpCtx();
+    ASSERT_OK(cache()->refreshNow(getClient()));
+    ASSERT_EQ(cache()->size(), 0U);
+    for (const auto& lsid : lsids) {
+        ASSERT(sessions()->has(lsid));
+    }
+}
+
 //
 TEST_F(LogicalSessionCacheTest, RefreshMatrixSessionState) {
     const std::vector<std::vector<std::string>> stateNames = {
@@ -0,0 +1,151 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/compiled_match_expression.h"
+
+#include "mongo/db/matcher/matchable.h"
+
+namespace mongo {
+
+/**
+ * A MatchableDocument over a BSONObj whose prefetched top-level fields have already been located.
+ */
+class CompiledMatchExpression::PrefetchedMatchableDocument final : public MatchableDocument {
+public:
+    PrefetchedMatchableDocument(const BSONObj& obj, const StringMap<size_t>& slots)
+        : _obj(obj), _slots(slots) {
+        size_t remaining = _slots.size();
+        BSONObjIterator it(_obj);
+        while (remaining && it.more()) {
+            BSONElement elem = it.next();
+            auto slot = _slots.find(elem.fieldNameStringData());
+            // Like BSONObj::getField(), only the first field with a given name is visible.
+            if (slot != _slots.end() && !_found[slot->second]) {
+                _elements[slot->second] = elem;
+                _found[slot->second] = true;
+                --remaining;
+            }
+        }
+    }
+
+    BSONObj toBSON() const final {
+        return _obj;
+    }
+
+    ElementIterator* allocateIterator(const ElementPath* path) const final {
+        const FieldRef& fieldRef = path->fieldRef();
+        auto slot = fieldRef.numParts() ? _slots.find(fieldRef.getPart(0)) : _slots.end();
+        if (slot == _slots.end()) {
+            if (_iteratorUsed)
+                return new BSONElementIterator(path, _obj);
+            _iteratorUsed = true;
+            _iterator.reset(path, _obj);
+            return &_iterator;
+        }
+
+        // Start below the first path component from its prefetched element. An EOO element stands
+        // in for a field which is absent, exactly as getField() would return.
+        const BSONElement& elem = _elements[slot->second];
+        const size_t suffixIndex = 1;
+        if (_iteratorUsed)
+            return new BSONElementIterator(path, suffixIndex, elem);
+        _iteratorUsed = true;
+        _iterator.reset(path, suffixIndex, elem);
+        return &_iterator;
+    }
+
+    void releaseIterator(ElementIterator* iterator) const final {
+        if (iterator == &_iterator) {
+            _iteratorUsed = false;
+        } else {
+            delete iterator;
+        }
+    }
+
+private:
+    const BSONObj& _obj;
+    const StringMap<size_t>& _slots;
+
+    std::array<BSONElement, kMaxPrefetchedFields> _elements;
+    std::array<bool, kMaxPrefetchedFields> _found{};
+
+    mutable BSONElementIterator _iterator;
+    mutable bool _iteratorUsed = false;
+};
+
+CompiledMatchExpression::CompiledMatchExpression(const MatchExpression* expr) : _expr(expr) {
+    invariant(_expr);
+
+    size_t numPaths = 0;
+    _addPaths(_expr, &numPaths);
+    if (numPaths < kMinPathsToPrefetch) {
+        _slots.clear();
+    }
+}
+
+void CompiledMatchExpression::_addPaths(const MatchExpression* expr, size_t* numPaths) {
+    switch (expr->matchType()) {
+        case MatchExpression::AND:
+        case MatchExpression::OR:
+        case MatchExpression::NOR:
+        case MatchExpression::NOT:
+            for (size_t i = 0; i < expr->numChildren(); ++i) {
+                _addPaths(expr->getChild(i), numPaths);
+            }
+            return;
+        default:
+            break;
+    }
+
+    // The children of any other node are evaluated relative to that node's path rather than to
+    // the root, so only the node's own path is recorded.
+    const FieldRef fieldRef(expr->path());
+    if (!fieldRef.numParts()) {
+        return;
+    }
+
+    ++*numPaths;
+    const StringData firstField = fieldRef.getPart(0);
+    if (_slots.size() < kMaxPrefetchedFields && _slots.find(firstField) == _slots.end()) {
+        const size_t slot = _slots.size();
+        _slots[firstField] = slot;
+    }
+}
+
+bool CompiledMatchExpression::matchesBSON(const BSONObj& doc, MatchDetails* details) const {
+    if (_slots.empty()) {
+        return _expr->matchesBSON(doc, details);
+    }
+
+    PrefetchedMatchableDocument matchable(doc, _slots);
+    return _expr->matches(&matchable, details);
+}
+
+}  // namespace mongo
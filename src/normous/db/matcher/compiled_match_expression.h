@@ -0,0 +1,89 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/matcher/expression.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+/**
+ * Evaluates a MatchExpression against BSON documents with the top-level fields it reads resolved
+ * up front. Constructing a CompiledMatchExpression walks the logical ($and, $or, $nor, $not)
+ * structure at the root of the expression and assigns a slot to the first component of every path
+ * found there. Matching a document then makes a single pass over its top-level fields to fill
+ * those slots, and path traversals which begin at the root start from the prefetched element
+ * rather than searching the document again. A filter with many predicates over the same or
+ * neighbouring paths therefore scans each document once rather than once per predicate.
+ *
+ * Paths whose first component has no slot are traversed as usual, so the results are always the
+ * same as MatchExpression::matchesBSON(). Prefetching is skipped for expressions with too few
+ * paths to benefit from it.
+ *
+ * The MatchExpression must outlive this object.
+ */
+class CompiledMatchExpression {
+    MONGO_DISALLOW_COPYING(CompiledMatchExpression);
+
+public:
+    // The most distinct top-level fields prefetched for one expression. Paths under any further
+    // fields are traversed as usual.
+    static constexpr size_t kMaxPrefetchedFields = 32;
+
+    // Expressions with fewer root-level paths than this are matched without prefetching.
+    static constexpr size_t kMinPathsToPrefetch = 4;
+
+    explicit CompiledMatchExpression(const MatchExpression* expr);
+
+    bool matchesBSON(const BSONObj& doc, MatchDetails* details = nullptr) const;
+
+    /**
+     * Returns the number of top-level fields resolved for each document, or zero if the expression
+     * is matched without prefetching.
+     */
+    size_t numPrefetchedFields() const {
+        return _slots.size();
+    }
+
+private:
+    class PrefetchedMatchableDocument;
+
+    void _addPaths(const MatchExpression* expr, size_t* numPaths);
+
+    const MatchExpression* const _expr;
+
+    // Maps the name of each prefetched top-level field to its slot.
+    StringMap<size_t> _slots;
+};
+
+}  // namespace mongo
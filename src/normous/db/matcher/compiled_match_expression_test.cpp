@@ -0,0 +1,126 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/compiled_match_expression.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+std::unique_ptr<MatchExpression> parse(const char* filter) {
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    auto statusWithMatcher = MatchExpressionParser::parse(fromjson(filter), expCtx);
+    ASSERT_OK(statusWithMatcher.getStatus());
+    return std::move(statusWithMatcher.getValue());
+}
+
+/**
+ * Asserts that 'filter' matches each of 'docs' exactly when the uncompiled expression does, and
+ * reports the same array offset.
+ */
+void assertSameResults(const char* filter, const std::vector<const char*>& docs) {
+    auto expr = parse(filter);
+    CompiledMatchExpression compiled(expr.get());
+    ASSERT_GT(compiled.numPrefetchedFields(), 0U);
+
+    for (auto&& json : docs) {
+        const BSONObj doc = fromjson(json);
+        MatchDetails expectedDetails;
+        expectedDetails.requestElemMatchKey();
+        MatchDetails details;
+        details.requestElemMatchKey();
+
+        const bool expected = expr->matchesBSON(doc, &expectedDetails);
+        ASSERT_EQ(expected, compiled.matchesBSON(doc, &details)) << filter << " on " << json;
+        ASSERT_EQ(expectedDetails.hasElemMatchKey(), details.hasElemMatchKey());
+        if (expectedDetails.hasElemMatchKey()) {
+            ASSERT_EQ(expectedDetails.elemMatchKey(), details.elemMatchKey());
+        }
+    }
+}
+
+TEST(CompiledMatchExpressionTest, FewPathsAreNotPrefetched) {
+    auto expr = parse("{a: 1, b: 2}");
+    CompiledMatchExpression compiled(expr.get());
+    ASSERT_EQ(compiled.numPrefetchedFields(), 0U);
+    ASSERT_TRUE(compiled.matchesBSON(BSON("a" << 1 << "b" << 2)));
+    ASSERT_FALSE(compiled.matchesBSON(BSON("a" << 1 << "b" << 3)));
+}
+
+TEST(CompiledMatchExpressionTest, SharedPrefixesUseOneSlot) {
+    auto expr = parse("{'a.b': 1, 'a.c': 2, 'a.d.e': 3, f: 4}");
+    CompiledMatchExpression compiled(expr.get());
+    ASSERT_EQ(compiled.numPrefetchedFields(), 2U);
+    ASSERT_TRUE(compiled.matchesBSON(fromjson("{a: {b: 1, c: 2, d: {e: 3}}, f: 4}")));
+    ASSERT_FALSE(compiled.matchesBSON(fromjson("{a: {b: 1, c: 2, d: {e: 4}}, f: 4}")));
+}
+
+TEST(CompiledMatchExpressionTest, MatchesLikeUncompiledOnScalarsAndMissingFields) {
+    assertSameResults("{a: 1, b: {$gt: 2}, c: {$exists: false}, d: null}",
+                      {"{a: 1, b: 3}",
+                       "{a: 1, b: 3, c: 1}",
+                       "{a: 1, b: 3, d: 1}",
+                       "{a: 2, b: 3}",
+                       "{b: 3, a: 1, d: null}",
+                       "{}"});
+}
+
+TEST(CompiledMatchExpressionTest, MatchesLikeUncompiledWithDuplicateFieldNames) {
+    assertSameResults("{a: 1, b: 1, c: 1, d: 1}",
+                      {"{a: 1, b: 1, c: 1, d: 1, a: 2}", "{a: 2, b: 1, c: 1, d: 1, a: 1}"});
+}
+
+TEST(CompiledMatchExpressionTest, MatchesLikeUncompiledOnArrays) {
+    assertSameResults("{'a.b': 1, 'a.0.c': 2, 'x.1': 5, y: {$size: 2}, z: [1, 2]}",
+                      {"{a: [{b: 1}, {b: 2}], x: [4, 5], y: [1, 1], z: [1, 2]}",
+                       "{a: [{c: 2}, {b: 1}], x: [4, 5], y: [1, 1], z: [[1, 2]]}",
+                       "{a: [{b: 1, c: 2}], x: [4, 5], y: [1, 1], z: [1, 2]}",
+                       "{a: [[{b: 1}], {c: 2}], x: [5, 4], y: [1], z: 1}",
+                       "{a: {b: 1, 0: {c: 2}}, x: {1: 5}, y: [1, 2], z: [1, 2]}"});
+}
+
+TEST(CompiledMatchExpressionTest, MatchesLikeUncompiledUnderLogicalOperators) {
+    assertSameResults(
+        "{$or: [{a: 1}, {'b.c': {$in: [2, 3]}}], $nor: [{d: 4}], e: {$not: {$lt: 5}}, "
+        "f: {$elemMatch: {g: 6}}}",
+        {"{a: 1, e: 5, f: [{g: 6}]}",
+         "{b: [{c: 3}], e: 7, f: [{g: 1}, {g: 6}]}",
+         "{a: 1, d: 4, e: 5, f: [{g: 6}]}",
+         "{a: 2, b: {c: 1}, e: 5, f: [{g: 6}]}",
+         "{a: 1, e: 4, f: [{g: 6}]}",
+         "{a: 1, f: [{g: 6}]}"});
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,156 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/bson/json.h"
+#include "mongo/db/matcher/compiled_match_expression.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace {
+
+// A document with a mix of scalar, nested and array fields, about the size of a typical record.
+BSONObj makeDocument() {
+    BSONObjBuilder builder;
+    builder.append("_id", 1);
+    for (int i = 0; i < 20; ++i) {
+        builder.append(str::stream() << "field" << i, i);
+    }
+    builder.append("name", "benchmark");
+    builder.append("nested", BSON("a" << 1 << "b" << BSON("c" << 2 << "d" << 3)));
+    builder.append("array", BSON_ARRAY(1 << 2 << 3 << 4 << 5 << 6 << 7 << 8 << 9 << 10));
+    builder.append("objects",
+                   BSON_ARRAY(BSON("x" << 1 << "y" << 2) << BSON("x" << 3 << "y" << 4)
+                                                         << BSON("x" << 5 << "y" << 6)));
+    return builder.obj();
+}
+
+std::unique_ptr<MatchExpression> parse(const BSONObj& filter) {
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    return uassertStatusOK(MatchExpressionParser::parse(filter, expCtx));
+}
+
+void runMatch(benchmark::State& state, const BSONObj& filter) {
+    const auto expr = parse(filter);
+    const auto doc = makeDocument();
+    for (auto keepRunning : state) {
+        benchmark::DoNotOptimize(expr->matchesBSON(doc));
+    }
+}
+
+void runCompiledMatch(benchmark::State& state, const BSONObj& filter) {
+    const auto expr = parse(filter);
+    const CompiledMatchExpression compiled(expr.get());
+    const auto doc = makeDocument();
+    for (auto keepRunning : state) {
+        benchmark::DoNotOptimize(compiled.matchesBSON(doc));
+    }
+}
+
+void BM_MatchEquality(benchmark::State& state) {
+    runMatch(state, fromjson("{field10: 10}"));
+}
+
+void BM_MatchLastField(benchmark::State& state) {
+    runMatch(state, fromjson("{objects: {$exists: true}}"));
+}
+
+void BM_MatchConjunction(benchmark::State& state) {
+    runMatch(state, fromjson("{field1: {$gt: 0}, field5: {$lt: 10}, name: 'benchmark'}"));
+}
+
+BSONObj manyPredicates() {
+    return fromjson("{field1: 1, field4: 4, field8: 8, field12: 12, field16: 16, field19: 19}");
+}
+
+void BM_MatchManyPredicates(benchmark::State& state) {
+    runMatch(state, manyPredicates());
+}
+
+void BM_MatchManyPredicatesCompiled(benchmark::State& state) {
+    runCompiledMatch(state, manyPredicates());
+}
+
+void BM_MatchDisjunction(benchmark::State& state) {
+    runMatch(state,
+             fromjson("{$or: [{field1: 5}, {field2: 5}, {field3: 5}, {name: 'benchmark'}]}"));
+}
+
+void BM_MatchLargeIn(benchmark::State& state) {
+    BSONArrayBuilder values;
+    for (int i = 0; i < 1000; ++i) {
+        values.append(i * 2 + 1);
+    }
+    runMatch(state, BSON("field10" << BSON("$in" << values.arr())));
+}
+
+void BM_MatchNestedPath(benchmark::State& state) {
+    runMatch(state, fromjson("{'nested.b.d': 3}"));
+}
+
+void BM_MatchArrayElement(benchmark::State& state) {
+    runMatch(state, fromjson("{array: 10}"));
+}
+
+void BM_MatchElemMatch(benchmark::State& state) {
+    runMatch(state, fromjson("{objects: {$elemMatch: {x: 5, y: {$gte: 6}}}}"));
+}
+
+void BM_MatchRegex(benchmark::State& state) {
+    runMatch(state, fromjson("{name: /^bench/}"));
+}
+
+void BM_ParseConjunction(benchmark::State& state) {
+    const auto filter = fromjson("{field1: {$gt: 0}, field5: {$lt: 10}, name: 'benchmark'}");
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    for (auto keepRunning : state) {
+        benchmark::DoNotOptimize(MatchExpressionParser::parse(filter, expCtx));
+    }
+}
+
+BENCHMARK(BM_MatchEquality);
+BENCHMARK(BM_MatchLastField);
+BENCHMARK(BM_MatchConjunction);
+BENCHMARK(BM_MatchManyPredicates);
+BENCHMARK(BM_MatchManyPredicatesCompiled);
+BENCHMARK(BM_MatchDisjunction);
+BENCHMARK(BM_MatchLargeIn);
+BENCHMARK(BM_MatchNestedPath);
+BENCHMARK(BM_MatchArrayElement);
+BENCHMARK(BM_MatchElemMatch);
+BENCHMARK(BM_MatchRegex);
+BENCHMARK(BM_ParseConjunction);
+
+}  // namespace
+}  // namespace mongo
@@ -32,6 +32,9 @@
 
 #include "mongo/unittest/unittest.h"
 
+#include <cmath>
+
+#include "mongo/db/geo/geoparser.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/json.h"
 #include "mongo/db/matcher/expression.h"
@@ -182,4 +185,47 @@ TEST(ExpressionGeoTest, GeoNearNotEquivalent) {
         gne2(makeGeoNearMatchExpression(query2));
     ASSERT(!gne1->equivalent(gne2.get()));
 }
+
+TEST(ExpressionGeoTest, GeoWithinLargePolygonAgreesWithExactTest) {
+    // A polygon with enough vertices that points are first checked against its coverings.
+    const int numVertices = 200;
+    BSONArrayBuilder ring;
+    for (int i = 0; i <= numVertices; ++i) {
+        const double angle = 2 * M_PI * (i % numVertices) / numVertices;
+        ring.append(BSON_ARRAY(std::cos(angle) << std::sin(angle)));
+    }
+    BSONObj polygonObj = BSON("type"
+                              << "Polygon"
+                              << "coordinates"
+                              << BSON_ARRAY(ring.arr()));
+    PolygonWithCRS polygon;
+    ASSERT_OK(GeoParser::parseGeoJSONPolygon(polygonObj, false, &polygon));
+    ASSERT(polygon.s2Polygon);
+
+    std::unique_ptr<GeoMatchExpression> ge =
+        makeGeoMatchExpression(BSON("$geoWithin" << BSON("$geometry" << polygonObj)));
+
+    // Test points inside, outside and close to the boundary, including the vertices themselves.
+    std::vector<BSONObj> points;
+    for (double x = -1.5; x <= 1.5; x += 0.05) {
+        for (double y = -1.5; y <= 1.5; y += 0.05) {
+            points.push_back(BSON_ARRAY(x << y));
+        }
+    }
+    for (auto&& vertex : polygonObj["coordinates"].Array()[0].Array()) {
+        points.push_back(vertex.Obj().getOwned());
+    }
+
+    for (auto&& coordinates : points) {
+        BSONObj pointObj = BSON("type"
+                                << "Point"
+                                << "coordinates"
+                                << coordinates);
+        PointWithCRS point;
+        ASSERT_OK(GeoParser::parseGeoJSONPoint(pointObj, &point));
+        const bool expected =
+            polygon.s2Polygon->Contains(point.point) || polygon.s2Polygon->MayIntersect(point.cell);
+        ASSERT_EQ(expected, ge->matchesBSON(BSON("a" << pointObj))) << coordinates;
+    }
+}
 }
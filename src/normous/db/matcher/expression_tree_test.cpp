@@ -155,6 +155,30 @@ TEST(AndOp, MatchesThreeClauses) {
     ASSERT(!andOp.matchesBSON(BSON("a" << 10 << "b" << 6), NULL));
 }
 
+TEST(AndOp, MatchesManyClausesAgainstWideDocument) {
+    // Enough top-level fields and clauses for the matcher to index the document's fields.
+    BSONObjBuilder docBuilder;
+    for (int i = 0; i < 20; ++i) {
+        docBuilder.append(str::stream() << "f" << i, i);
+    }
+    // Duplicate field names resolve to the first occurrence, as with BSONObj::getField().
+    docBuilder.append("f0", 100);
+    docBuilder.append("sub", BSON("x" << 1));
+    docBuilder.append("arr", BSON_ARRAY(BSON("y" << 2)));
+    BSONObj doc = docBuilder.obj();
+
+    BSONObj operands = BSON("f0" << 0 << "f19" << 19 << "sub.x" << 1 << "arr.y" << 2);
+    AndMatchExpression andOp;
+    andOp.add(new EqualityMatchExpression("f0", operands["f0"]));
+    andOp.add(new EqualityMatchExpression("f19", operands["f19"]));
+    andOp.add(new EqualityMatchExpression("sub.x", operands["sub.x"]));
+    andOp.add(new EqualityMatchExpression("arr.y", operands["arr.y"]));
+    ASSERT(andOp.matchesBSON(doc, NULL));
+
+    andOp.add(new ExistsMatchExpression("missing"));
+    ASSERT(!andOp.matchesBSON(doc, NULL));
+}
+
 TEST(AndOp, ElemMatchKey) {
     BSONObj baseOperand1 = BSON("a" << 1);
     BSONObj baseOperand2 = BSON("b" << 2);
@@ -32,11 +32,61 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+
 namespace mongo {
+namespace {
+
+// Documents with fewer top-level fields than this are scanned rather than indexed.
+const size_t kMinFieldsForIndex = 16;
+
+bool fieldNameLess(const std::pair<StringData, BSONElement>& entry, StringData name) {
+    return entry.first < name;
+}
+
+}  // namespace
 
 BSONMatchableDocument::BSONMatchableDocument(const BSONObj& obj) : _obj(obj) {
     _iteratorUsed = false;
 }
 
 BSONMatchableDocument::~BSONMatchableDocument() {}
+
+boost::optional<BSONElement> BSONMatchableDocument::lookUpTopLevelField(
+    const ElementPath* path) const {
+    const auto& fieldRef = path->fieldRef();
+    if (fieldRef.numParts() == 0) {
+        return boost::none;
+    }
+
+    if (!_fieldIndex) {
+        if (++_numLookups != 2) {
+            return boost::none;
+        }
+
+        FieldIndex index;
+        for (auto&& elem : _obj) {
+            index.emplace_back(elem.fieldNameStringData(), elem);
+        }
+        // Small documents stay unindexed; later lookups have moved past the count that builds
+        // the index, so they go straight back to scanning.
+        if (index.size() < kMinFieldsForIndex) {
+            return boost::none;
+        }
+
+        // A stable sort keeps duplicate field names in document order, so that the lookup, like
+        // BSONObj::getField(), finds the first of them.
+        std::stable_sort(index.begin(), index.end(), [](const auto& a, const auto& b) {
+            return a.first < b.first;
+        });
+        _fieldIndex = std::move(index);
+    }
+
+    const auto name = fieldRef.getPart(0);
+    auto it = std::lower_bound(_fieldIndex->begin(), _fieldIndex->end(), name, fieldNameLess);
+    if (it == _fieldIndex->end() || it->first != name) {
+        return BSONElement();
+    }
+    return it->second;
+}
 }
@@ -30,6 +30,10 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+#include <utility>
+#include <vector>
+
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/field_ref.h"
@@ -85,10 +89,17 @@ public:
     }
 
     virtual ElementIterator* allocateIterator(const ElementPath* path) const {
-        if (_iteratorUsed)
-            return new BSONElementIterator(path, _obj);
+        const auto topLevelField = lookUpTopLevelField(path);
+        if (_iteratorUsed) {
+            return topLevelField ? new BSONElementIterator(path, 1, *topLevelField)
+                                 : new BSONElementIterator(path, _obj);
+        }
         _iteratorUsed = true;
-        _iterator.reset(path, _obj);
+        if (topLevelField) {
+            _iterator.reset(path, 1, *topLevelField);
+        } else {
+            _iterator.reset(path, _obj);
+        }
         return &_iterator;
     }
 
@@ -101,9 +112,23 @@ public:
     }
 
 private:
+    using FieldIndex = std::vector<std::pair<StringData, BSONElement>>;
+
+    /**
+     * Returns the top-level element named by the first part of 'path' (EOO if there is none)
+     * using an index of the document's fields, or boost::none if the caller has to scan the
+     * document itself. Matching several predicates against one document looks up many of its
+     * fields, so the index is built on the second lookup into a document with enough fields for
+     * it to beat scanning.
+     */
+    boost::optional<BSONElement> lookUpTopLevelField(const ElementPath* path) const;
+
     BSONObj _obj;
     mutable BSONElementIterator _iterator;
     mutable bool _iteratorUsed;
+
+    mutable int _numLookups = 0;
+    mutable boost::optional<FieldIndex> _fieldIndex;
 };
 
 /**
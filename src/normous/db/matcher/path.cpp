@@ -85,7 +85,7 @@ BSONElementIterator::BSONElementIterator() {
 BSONElementIterator::BSONElementIterator(const ElementPath* path,
                                          size_t suffixIndex,
                                          BSONElement elementToIterate)
-    : _path(path), _state(BEGIN) {
+    : _path(path), _traversalStartIndex(0), _state(BEGIN) {
     _setTraversalStart(suffixIndex, elementToIterate);
 }
 
@@ -162,6 +162,12 @@ Status addMongodOptions(moe::OptionSection* options) {
                                           storageGlobalParams.kDefaultDbPath);
 
 #endif
+    storage_options.addOptionChaining(
+        "storage.tmpDirectory",
+        "tmpDirectory",
+        moe::String,
+        "directory under which sorts spill to disk - defaults to the dbpath");
+
     storage_options.addOptionChaining("storage.directoryPerDB",
                                       "directoryperdb",
                                       moe::Switch,
@@ -758,6 +764,16 @@ Status storeMongodOptions(const moe::Environment& params) {
             storageGlobalParams.dbpath = serverGlobalParams.cwd + "/" + storageGlobalParams.dbpath;
         }
     }
+
+    if (params.count("storage.tmpDirectory")) {
+        storageGlobalParams.tmpDirectory = params["storage.tmpDirectory"].as<std::string>();
+        if (params.count("processManagement.fork") && !storageGlobalParams.tmpDirectory.empty() &&
+            storageGlobalParams.tmpDirectory[0] != '/') {
+            // Like the dbpath, this is relative to the cwd we had before forking.
+            storageGlobalParams.tmpDirectory =
+                serverGlobalParams.cwd + "/" + storageGlobalParams.tmpDirectory;
+        }
+    }
 #ifdef _WIN32
     if (storageGlobalParams.dbpath.size() > 1 &&
         storageGlobalParams.dbpath[storageGlobalParams.dbpath.size() - 1] == '/') {
@@ -51,6 +51,7 @@ constexpr StringData NamespaceString::kConfigDb;
 constexpr StringData NamespaceString::kSystemDotViewsCollectionName;
 constexpr StringData NamespaceString::kOrphanCollectionPrefix;
 constexpr StringData NamespaceString::kOrphanCollectionDb;
+constexpr StringData NamespaceString::kTimeseriesBucketsCollectionPrefix;
 
 const NamespaceString NamespaceString::kServerConfigurationNamespace(NamespaceString::kAdminDb,
                                                                      "system.version");
@@ -80,6 +81,9 @@ bool NamespaceString::isCollectionlessAggregateNS() const {
 }
 
 bool NamespaceString::isLegalClientSystemNS() const {
+    if (isTimeseriesBucketsCollection())
+        return true;
+
     if (db() == "admin") {
         if (ns() == "admin.system.roles")
             return true;
@@ -152,6 +156,15 @@ boost::optional<NamespaceString> NamespaceString::getTargetNSForGloballyManagedN
     return NamespaceString{db(), coll().substr(indexOfNextDot + 1)};
 }
 
+NamespaceString NamespaceString::makeTimeseriesBucketsNamespace() const {
+    return {db(), kTimeseriesBucketsCollectionPrefix.toString() + coll()};
+}
+
+NamespaceString NamespaceString::getTimeseriesViewNamespace() const {
+    invariant(isTimeseriesBucketsCollection(), ns());
+    return {db(), coll().substr(kTimeseriesBucketsCollectionPrefix.size())};
+}
+
 bool NamespaceString::isDropPendingNamespace() const {
     return coll().startsWith(dropPendingNSPrefix);
 }
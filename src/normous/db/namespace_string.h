@@ -64,6 +64,9 @@ public:
     static constexpr StringData kOrphanCollectionPrefix = "orphan."_sd;
     static constexpr StringData kOrphanCollectionDb = "local"_sd;
 
+    // Prefix for the collections holding the buckets of time-series collections
+    static constexpr StringData kTimeseriesBucketsCollectionPrefix = "system.buckets."_sd;
+
     // Namespace for storing configuration data, which needs to be replicated if the server is
     // running as a replica set. Documents in this collection should represent some configuration
     // state of the server, which needs to be recovered/consulted at startup. Each document in this
@@ -264,6 +267,9 @@ public:
     bool isOrphanCollection() const {
         return db() == kOrphanCollectionDb && coll().startsWith(kOrphanCollectionPrefix);
     }
+    bool isTimeseriesBucketsCollection() const {
+        return coll().startsWith(kTimeseriesBucketsCollectionPrefix);
+    }
 
     /**
      * Returns whether the NamespaceString references a special collection that cannot be used for
@@ -304,6 +310,21 @@ public:
      */
     boost::optional<NamespaceString> getTargetNSForGloballyManagedNamespace() const;
 
+    /**
+     * Returns the namespace of the collection storing the buckets of the time-series collection
+     * with this namespace.
+     *
+     * Example:
+     *     test.foo -> test.system.buckets.foo
+     */
+    NamespaceString makeTimeseriesBucketsNamespace() const;
+
+    /**
+     * Returns the namespace of the time-series collection whose buckets are stored in this
+     * namespace. Must only be called if isTimeseriesBucketsCollection() is true.
+     */
+    NamespaceString getTimeseriesViewNamespace() const;
+
     /**
      * Returns true if this namespace refers to a drop-pending collection.
      */
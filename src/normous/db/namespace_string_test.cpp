@@ -240,6 +240,17 @@ TEST(NamespaceStringTest, MakeDropPendingNamespace) {
     ASSERT_EQUALS(std::size_t(NamespaceString::MaxNsCollectionLen), dropPendingNss.size());
 }
 
+TEST(NamespaceStringTest, TimeseriesBucketsNamespace) {
+    const NamespaceString nss("test.foo");
+    ASSERT_FALSE(nss.isTimeseriesBucketsCollection());
+
+    const auto bucketsNss = nss.makeTimeseriesBucketsNamespace();
+    ASSERT_EQUALS(NamespaceString("test.system.buckets.foo"), bucketsNss);
+    ASSERT_TRUE(bucketsNss.isTimeseriesBucketsCollection());
+    ASSERT_TRUE(bucketsNss.isLegalClientSystemNS());
+    ASSERT_EQUALS(nss, bucketsNss.getTimeseriesViewNamespace());
+}
+
 TEST(NamespaceStringTest, GetDropPendingNamespaceOpTime) {
     // Null optime is acceptable.
     ASSERT_EQUALS(
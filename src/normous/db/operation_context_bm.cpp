@@ -0,0 +1,62 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/client.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+
+namespace mongo {
+namespace {
+
+// Measures the per-operation setup cost: allocating an OperationContext and constructing and
+// destroying all of its registered decorations.
+void BM_MakeOperationContext(benchmark::State& state) {
+    auto client = getGlobalServiceContext()->makeClient("operation_context_bm");
+    for (auto keepRunning : state) {
+        auto opCtx = client->makeOperationContext();
+        benchmark::DoNotOptimize(opCtx.get());
+    }
+}
+
+// Same as above for a Client, which carries its own set of decorations.
+void BM_MakeClient(benchmark::State& state) {
+    for (auto keepRunning : state) {
+        auto client = getGlobalServiceContext()->makeClient("operation_context_bm");
+        benchmark::DoNotOptimize(client.get());
+    }
+}
+
+BENCHMARK(BM_MakeOperationContext);
+BENCHMARK(BM_MakeClient);
+
+}  // namespace
+}  // namespace mongo
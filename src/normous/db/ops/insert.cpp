@@ -229,6 +229,8 @@ Status userAllowedCreateNS(StringData db, StringData coll) {
             return Status::OK();
         if (coll == DurableViewCatalog::viewsCollectionName())
             return Status::OK();
+        if (coll.startsWith(NamespaceString::kTimeseriesBucketsCollectionPrefix))
+            return Status::OK();
         if (db == "admin") {
             if (coll == "system.version")
                 return Status::OK();
@@ -30,12 +30,15 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "mongo/base/checked_cast.h"
+#include "mongo/bson/simple_bsonelement_comparator.h"
 #include "mongo/db/audit.h"
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/collection_catalog_entry.h"
 #include "mongo/db/catalog/collection_options.h"
 #include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/catalog/document_validation.h"
@@ -44,6 +47,7 @@
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/curop_failpoint_helpers.h"
 #include "mongo/db/curop_metrics.h"
+#include "mongo/db/dbhelpers.h"
 #include "mongo/db/exec/delete.h"
 #include "mongo/db/exec/update.h"
 #include "mongo/db/introspect.h"
@@ -69,6 +73,10 @@
 #include "mongo/db/session_catalog.h"
 #include "mongo/db/stats/counters.h"
 #include "mongo/db/stats/top.h"
+#include "mongo/db/timeseries/bucket_catalog.h"
+#include "mongo/db/timeseries/bucket_compression.h"
+#include "mongo/db/timeseries/timeseries_constants.h"
+#include "mongo/db/timeseries/timeseries_options.h"
 #include "mongo/db/transaction_participant.h"
 #include "mongo/db/write_concern.h"
 #include "mongo/rpc/get_status_from_command_result.h"
@@ -330,6 +338,52 @@ void insertDocuments(OperationContext* opCtx,
     wuow.commit();
 }
 
+/**
+ * Returns which documents of 'batch', whose insert failed with a duplicate key error, may have
+ * caused the failure: those whose _id repeats an earlier one in the batch or is already in the _id
+ * index. This only decides how the batch is split up to insert it again, so a document it misses
+ * or flags wrongly merely costs an extra attempt at inserting part of the batch.
+ */
+std::vector<bool> findSuspectedDuplicateIds(OperationContext* opCtx,
+                                            Collection* collection,
+                                            const std::vector<InsertStatement>& batch) {
+    std::vector<bool> suspects(batch.size(), false);
+    auto idIndex = collection->getIndexCatalog()->findIdIndex(opCtx);
+    if (!idIndex) {
+        return suspects;
+    }
+
+    // The documents whose _id is new to the batch, to look up in the _id index in _id order.
+    std::vector<std::pair<BSONElement, size_t>> idsToLookUp;
+    auto idsInBatch = SimpleBSONElementComparator::kInstance.makeBSONEltUnorderedSet();
+    for (size_t i = 0; i < batch.size(); ++i) {
+        BSONElement id = batch[i].doc["_id"];
+        if (id.eoo()) {
+            continue;
+        }
+        if (!idsInBatch.insert(id).second) {
+            suspects[i] = true;
+            continue;
+        }
+        idsToLookUp.emplace_back(id, i);
+    }
+
+    std::sort(idsToLookUp.begin(),
+              idsToLookUp.end(),
+              [](const std::pair<BSONElement, size_t>& lhs,
+                 const std::pair<BSONElement, size_t>& rhs) {
+                  return SimpleBSONElementComparator::kInstance.evaluate(lhs.first < rhs.first);
+              });
+
+    auto idAccessMethod = collection->getIndexCatalog()->getIndex(idIndex);
+    for (auto&& idToLookUp : idsToLookUp) {
+        if (!idAccessMethod->findSingle(opCtx, idToLookUp.first.wrap()).isNull()) {
+            suspects[idToLookUp.second] = true;
+        }
+    }
+    return suspects;
+}
+
 /**
  * Returns true if caller should try to insert more documents. Does nothing else if batch is empty.
  */
@@ -369,70 +423,140 @@ bool insertBatchAndHandleErrors(OperationContext* opCtx,
         assertCanWrite_inlock(opCtx, wholeOp.getNamespace());
     };
 
-    try {
-        acquireCollection();
-        if (!collection->getCollection()->isCapped() && batch.size() > 1) {
-            // First try doing it all together. If all goes well, this is all we need to do.
-            // See Collection::_insertDocuments for why we do all capped inserts one-at-a-time.
+    using InsertIterator = std::vector<InsertStatement>::iterator;
+
+    // Inserts the documents in [begin, end) all together, returning the error which prevented
+    // inserting any of them, if any.
+    auto insertAllAtOnce = [&](InsertIterator begin, InsertIterator end) {
+        try {
+            if (!collection)
+                acquireCollection();
             lastOpFixer->startingOp();
-            insertDocuments(
-                opCtx, collection->getCollection(), batch.begin(), batch.end(), fromMigrate);
+            insertDocuments(opCtx, collection->getCollection(), begin, end, fromMigrate);
             lastOpFixer->finishedOpSuccessfully();
-            globalOpCounters.gotInserts(batch.size());
+            const auto numInserted = std::distance(begin, end);
+            globalOpCounters.gotInserts(numInserted);
             SingleWriteResult result;
             result.setN(1);
 
-            std::fill_n(std::back_inserter(out->results), batch.size(), std::move(result));
-            curOp.debug().additiveMetrics.incrementNinserted(batch.size());
-            return true;
+            std::fill_n(std::back_inserter(out->results), numInserted, std::move(result));
+            curOp.debug().additiveMetrics.incrementNinserted(numInserted);
+            return Status::OK();
+        } catch (const DBException& ex) {
+
+            // If we cannot abandon the current snapshot, we give up and rethrow the exception.
+            // No WCE retrying is attempted.  This code path is intended for snapshot read concern.
+            if (opCtx->lockState()->inAWriteUnitOfWork()) {
+                throw;
+            }
+
+            // Otherwise, ignore this failure and behave as-if we never tried to do the combined
+            // batch insert.  Inserting one-at-a-time will handle reporting any non-transient
+            // errors.
+            collection.reset();
+            return ex.toStatus();
         }
-    } catch (const DBException&) {
+    };
 
-        // If we cannot abandon the current snapshot, we give up and rethrow the exception.
-        // No WCE retrying is attempted.  This code path is intended for snapshot read concern.
+    // Try to insert documents one-at-a-time. This path is executed both for singular batches, and
+    // for batches that failed all-at-once inserting. Returns false if the caller should not try to
+    // insert any more documents.
+    auto insertOneAtATime = [&](InsertIterator begin, InsertIterator end) {
+        for (auto it = begin; it != end; ++it) {
+            globalOpCounters.gotInsert();
+            try {
+                writeConflictRetry(opCtx, "insert", wholeOp.getNamespace().ns(), [&] {
+                    try {
+                        if (!collection)
+                            acquireCollection();
+                        lastOpFixer->startingOp();
+                        insertDocuments(
+                            opCtx, collection->getCollection(), it, it + 1, fromMigrate);
+                        lastOpFixer->finishedOpSuccessfully();
+                        SingleWriteResult result;
+                        result.setN(1);
+                        out->results.emplace_back(std::move(result));
+                        curOp.debug().additiveMetrics.incrementNinserted(1);
+                    } catch (...) {
+                        // Release the lock following any error if we are not in multi-statement
+                        // transaction. Among other things, this ensures that we don't sleep in the
+                        // WCE retry loop with the lock held.
+                        // If we are in multi-statement transaction and under a under a WUOW, we
+                        // will not actually release the lock.
+                        collection.reset();
+                        throw;
+                    }
+                });
+            } catch (const DBException& ex) {
+                bool canContinue = handleError(
+                    opCtx, ex, wholeOp.getNamespace(), wholeOp.getWriteCommandBase(), out);
+                if (!canContinue)
+                    return false;
+            }
+        }
+        return true;
+    };
+
+    Status batchStatus = Status::OK();
+    try {
+        acquireCollection();
+        if (!collection->getCollection()->isCapped() && batch.size() > 1) {
+            // First try doing it all together. If all goes well, this is all we need to do.
+            // See Collection::_insertDocuments for why we do all capped inserts one-at-a-time.
+            batchStatus = insertAllAtOnce(batch.begin(), batch.end());
+            if (batchStatus.isOK()) {
+                return true;
+            }
+        }
+    } catch (const DBException&) {
         if (opCtx->lockState()->inAWriteUnitOfWork()) {
             throw;
         }
-
-        // Otherwise, ignore this failure and behave as-if we never tried to do the combined batch
-        // insert.  The loop below will handle reporting any non-transient errors.
         collection.reset();
     }
 
-    // Try to insert the batch one-at-a-time. This path is executed both for singular batches, and
-    // for batches that failed all-at-once inserting.
-    for (auto it = batch.begin(); it != batch.end(); ++it) {
-        globalOpCounters.gotInsert();
+    // A batch which failed on a duplicate key, typically only because of a few of its documents,
+    // inserts those with a suspect _id one-at-a-time and everything in between them all together,
+    // falling back to one-at-a-time only for the parts which fail again.
+    std::vector<bool> suspects;
+    if (batchStatus.code() == ErrorCodes::DuplicateKey) {
         try {
-            writeConflictRetry(opCtx, "insert", wholeOp.getNamespace().ns(), [&] {
-                try {
-                    if (!collection)
-                        acquireCollection();
-                    lastOpFixer->startingOp();
-                    insertDocuments(opCtx, collection->getCollection(), it, it + 1, fromMigrate);
-                    lastOpFixer->finishedOpSuccessfully();
-                    SingleWriteResult result;
-                    result.setN(1);
-                    out->results.emplace_back(std::move(result));
-                    curOp.debug().additiveMetrics.incrementNinserted(1);
-                } catch (...) {
-                    // Release the lock following any error if we are not in multi-statement
-                    // transaction. Among other things, this ensures that we don't sleep in the WCE
-                    // retry loop with the lock held.
-                    // If we are in multi-statement transaction and under a under a WUOW, we will
-                    // not actually release the lock.
-                    collection.reset();
-                    throw;
-                }
-            });
-        } catch (const DBException& ex) {
-            bool canContinue =
-                handleError(opCtx, ex, wholeOp.getNamespace(), wholeOp.getWriteCommandBase(), out);
-            if (!canContinue)
-                return false;
+            if (!collection)
+                acquireCollection();
+            suspects = findSuspectedDuplicateIds(opCtx, collection->getCollection(), batch);
+        } catch (const DBException&) {
+            collection.reset();
+            suspects.clear();
         }
     }
 
+    if (std::find(suspects.begin(), suspects.end(), true) == suspects.end()) {
+        return insertOneAtATime(batch.begin(), batch.end());
+    }
+
+    auto runBegin = batch.begin();
+    for (size_t i = 0; i <= batch.size(); ++i) {
+        if (i < batch.size() && !suspects[i]) {
+            continue;
+        }
+
+        const auto runEnd = batch.begin() + i;
+        if (std::distance(runBegin, runEnd) > 1 && insertAllAtOnce(runBegin, runEnd).isOK()) {
+            runBegin = runEnd;
+        }
+        if (!insertOneAtATime(runBegin, runEnd)) {
+            return false;
+        }
+
+        if (i == batch.size()) {
+            break;
+        }
+        if (!insertOneAtATime(runEnd, runEnd + 1)) {
+            return false;
+        }
+        runBegin = runEnd + 1;
+    }
+
     return true;
 }
 
@@ -449,6 +573,254 @@ SingleWriteResult makeWriteResultForInsertOrDeleteRetry() {
     return res;
 }
 
+/**
+ * Returns the options of the time-series collection whose view is 'nss', or boost::none if 'nss'
+ * is not the view of a time-series collection.
+ */
+boost::optional<timeseries::TimeseriesOptions> getTimeseriesOptions(OperationContext* opCtx,
+                                                                    const NamespaceString& nss) {
+    if (nss.isTimeseriesBucketsCollection()) {
+        return boost::none;
+    }
+
+    AutoGetCollection autoColl(opCtx, nss.makeTimeseriesBucketsNamespace(), MODE_IS);
+    auto collection = autoColl.getCollection();
+    if (!collection) {
+        return boost::none;
+    }
+
+    auto options = collection->getCatalogEntry()->getCollectionOptions(opCtx);
+    if (options.timeseries.isEmpty()) {
+        return boost::none;
+    }
+    return uassertStatusOK(timeseries::TimeseriesOptions::parse(options.timeseries));
+}
+
+/**
+ * Builds the upsert which adds the samples of 'write' to its bucket, creating the bucket if it
+ * does not exist yet.
+ */
+BSONObj makeBucketUpdate(const timeseries::BucketCatalog::BucketWrite& write,
+                         const std::vector<BSONObj>& measurements,
+                         const timeseries::TimeseriesOptions& options) {
+    using namespace timeseries;
+
+    BSONObjBuilder update;
+    {
+        BSONObjBuilder setOnInsert(update.subobjStart("$setOnInsert"));
+        setOnInsert.append(str::stream() << kBucketControlFieldName << "."
+                                         << kBucketControlVersionFieldName,
+                           kUncompressedBucketVersion);
+        if (!write.meta.isEmpty()) {
+            setOnInsert.appendAs(write.meta.firstElement(), kBucketMetaFieldName);
+        }
+    }
+    {
+        BSONObjBuilder set(update.subobjStart("$set"));
+        for (size_t i = 0; i < write.docIndexes.size(); ++i) {
+            for (auto&& elem : measurements[write.docIndexes[i]]) {
+                if (!options.metaField.empty() && elem.fieldNameStringData() == options.metaField) {
+                    continue;
+                }
+                set.appendAs(elem,
+                             str::stream() << kBucketDataFieldName << "." << elem.fieldName()
+                                           << "."
+                                           << write.sampleIndexes[i]);
+            }
+        }
+    }
+    {
+        BSONObjBuilder min(update.subobjStart("$min"));
+        for (auto&& elem : write.min) {
+            min.appendAs(elem,
+                         str::stream() << kBucketControlFieldName << "."
+                                       << kBucketControlMinFieldName
+                                       << "."
+                                       << elem.fieldName());
+        }
+    }
+    {
+        BSONObjBuilder max(update.subobjStart("$max"));
+        for (auto&& elem : write.max) {
+            max.appendAs(elem,
+                         str::stream() << kBucketControlFieldName << "."
+                                       << kBucketControlMaxFieldName
+                                       << "."
+                                       << elem.fieldName());
+        }
+        max.append(str::stream() << kBucketControlFieldName << "." << kBucketControlCountFieldName,
+                   write.count);
+    }
+    if (!write.newMixedFields.empty()) {
+        BSONObjBuilder addToSet(update.subobjStart("$addToSet"));
+        BSONObjBuilder mixed(addToSet.subobjStart(str::stream() << kBucketControlFieldName << "."
+                                                                << kBucketControlMixedFieldName));
+        BSONArrayBuilder each(mixed.subarrayStart("$each"));
+        for (auto&& field : write.newMixedFields) {
+            each.append(field);
+        }
+    }
+    return update.obj();
+}
+
+/**
+ * Performs a single update of a bucket, returning its error if it failed.
+ */
+Status updateBucket(OperationContext* opCtx,
+                    const NamespaceString& bucketsNs,
+                    const BSONObj& query,
+                    const BSONObj& update,
+                    bool upsert) {
+    write_ops::Update updateOp(bucketsNs);
+    updateOp.setUpdates({[&] {
+        write_ops::UpdateOpEntry entry;
+        entry.setQ(query);
+        entry.setU(update);
+        entry.setUpsert(upsert);
+        entry.setMulti(false);
+        return entry;
+    }()});
+
+    auto result = performUpdates(opCtx, updateOp);
+    invariant(result.results.size() == 1);
+    return result.results.front().getStatus();
+}
+
+/**
+ * Replaces the uncompressed bucket 'bucketId' by its compressed form. Leaves the bucket as it is
+ * if it does not compress, as uncompressed buckets can be read just as well.
+ */
+void compressClosedBucket(OperationContext* opCtx,
+                          const NamespaceString& bucketsNs,
+                          const OID& bucketId) {
+    BSONObj bucket;
+    {
+        AutoGetCollection autoColl(opCtx, bucketsNs, MODE_IS);
+        auto collection = autoColl.getCollection();
+        if (!collection || !Helpers::findOne(opCtx, collection, BSON("_id" << bucketId), bucket)) {
+            return;
+        }
+    }
+
+    auto compressed = timeseries::compressBucket(bucket);
+    if (!compressed) {
+        return;
+    }
+
+    // Only replace the bucket if it is still uncompressed.
+    BSONObjBuilder query;
+    query.append("_id", bucketId);
+    query.append(str::stream() << timeseries::kBucketControlFieldName << "."
+                               << timeseries::kBucketControlVersionFieldName,
+                 timeseries::kUncompressedBucketVersion);
+    Status status = updateBucket(opCtx, bucketsNs, query.obj(), *compressed, false);
+    if (!status.isOK()) {
+        LOG(1) << "Failed to compress bucket " << bucketId << " of " << bucketsNs << ": "
+               << redact(status);
+    }
+}
+
+/**
+ * Inserts the measurements of 'wholeOp' into the buckets of the time-series collection whose view
+ * is the namespace of the insert.
+ *
+ * The samples of a batch are grouped by bucket, and each bucket is written by a single upsert. A
+ * failed bucket write fails all of the samples of that bucket, even for ordered inserts.
+ */
+WriteResult performTimeseriesInserts(OperationContext* opCtx,
+                                     const write_ops::Insert& wholeOp,
+                                     const timeseries::TimeseriesOptions& options) {
+    auto txnParticipant = TransactionParticipant::get(opCtx);
+    uassert(ErrorCodes::OperationNotSupportedInTransaction,
+            str::stream() << "Cannot insert into a time-series collection in a multi-document "
+                             "transaction: "
+                          << wholeOp.getNamespace().ns(),
+            !(txnParticipant && txnParticipant->inMultiDocumentTransaction()));
+    uassert(ErrorCodes::IllegalOperation,
+            str::stream() << "Retryable writes are not supported on time-series collections: "
+                          << wholeOp.getNamespace().ns(),
+            !opCtx->getTxnNumber());
+
+    const auto bucketsNs = wholeOp.getNamespace().makeTimeseriesBucketsNamespace();
+    const auto& docs = wholeOp.getDocuments();
+    const bool ordered = wholeOp.getWriteCommandBase().getOrdered();
+
+    std::vector<Status> statuses(docs.size(), Status::OK());
+    std::vector<BSONObj> measurements;
+    std::vector<size_t> positions;
+    size_t numAttempted = docs.size();
+    for (size_t i = 0; i < docs.size(); ++i) {
+        auto fixedDoc = fixDocumentForInsert(opCtx->getServiceContext(), docs[i]);
+        if (fixedDoc.isOK() && docs[i][options.timeField].type() != BSONType::Date) {
+            fixedDoc = {ErrorCodes::BadValue,
+                        str::stream() << "'" << options.timeField
+                                      << "' must be present and contain a valid BSON UTC datetime "
+                                         "value"};
+        }
+        if (!fixedDoc.isOK()) {
+            statuses[i] = fixedDoc.getStatus();
+            if (ordered) {
+                numAttempted = i + 1;
+                break;
+            }
+            continue;
+        }
+        measurements.push_back(fixedDoc.getValue().isEmpty() ? docs[i]
+                                                             : std::move(fixedDoc.getValue()));
+        positions.push_back(i);
+    }
+
+    auto& catalog = timeseries::BucketCatalog::get(opCtx->getServiceContext());
+    auto insertResult = catalog.insert(bucketsNs, options, measurements);
+
+    std::vector<OID> bucketsToCompress = std::move(insertResult.bucketsToCompress);
+    for (auto&& write : insertResult.writes) {
+        Status status = Status::OK();
+        try {
+            const auto query = BSON("_id" << write.bucketId);
+            const auto update = makeBucketUpdate(write, measurements, options);
+            status = updateBucket(opCtx, bucketsNs, query, update, true);
+            if (status == ErrorCodes::DuplicateKey) {
+                // A concurrent upsert created the bucket first, so it now exists.
+                status = updateBucket(opCtx, bucketsNs, query, update, true);
+            }
+        } catch (const DBException& ex) {
+            status = ex.toStatus();
+        }
+
+        if (!status.isOK()) {
+            for (auto docIndex : write.docIndexes) {
+                statuses[positions[docIndex]] = status;
+            }
+            catalog.clear(bucketsNs);
+        }
+        if (catalog.finishWrite(bucketsNs, write.bucketId)) {
+            bucketsToCompress.push_back(write.bucketId);
+        }
+    }
+
+    for (auto&& bucketId : bucketsToCompress) {
+        compressClosedBucket(opCtx, bucketsNs, bucketId);
+    }
+
+    WriteResult out;
+    out.results.reserve(numAttempted);
+    for (size_t i = 0; i < numAttempted; ++i) {
+        if (!statuses[i].isOK()) {
+            out.results.emplace_back(std::move(statuses[i]));
+            if (ordered) {
+                break;
+            }
+            continue;
+        }
+        SingleWriteResult result;
+        result.setN(1);
+        out.results.emplace_back(std::move(result));
+        CurOp::get(opCtx)->debug().additiveMetrics.incrementNinserted(1);
+    }
+    return out;
+}
+
 }  // namespace
 
 WriteResult performInserts(OperationContext* opCtx,
@@ -485,6 +857,12 @@ WriteResult performInserts(OperationContext* opCtx,
 
     uassertStatusOK(userAllowedWriteNS(wholeOp.getNamespace()));
 
+    if (timeseries::mayHaveTimeseriesCollections()) {
+        if (auto options = getTimeseriesOptions(opCtx, wholeOp.getNamespace())) {
+            return performTimeseriesInserts(opCtx, wholeOp, *options);
+        }
+    }
+
     DisableDocumentValidationIfTrue docValidationDisabler(
         opCtx, wholeOp.getWriteCommandBase().getBypassDocumentValidation());
     LastOpFixer lastOpFixer(opCtx, wholeOp.getNamespace());
@@ -210,7 +210,15 @@ public:
     }
 
 private:
+    /**
+     * Moves 'integralTotal' into 'nonDecimalTotal'.
+     */
+    void foldIntegralTotal();
+
     BSONType totalType = NumberInt;
+    // Integral inputs are summed exactly here, and only added to the slower 'nonDecimalTotal'
+    // when the sum would overflow, a double is added, or the result is requested.
+    long long integralTotal = 0;
     DoubleDoubleSummation nonDecimalTotal;
     Decimal128 decimalTotal;
 };
@@ -296,7 +304,14 @@ private:
      */
     Decimal128 _getDecimalTotal() const;
 
+    /**
+     * Moves '_integralTotal' into '_nonDecimalTotal'.
+     */
+    void _foldIntegralTotal();
+
     bool _isDecimal;
+    // Summed exactly, like AccumulatorSum::integralTotal.
+    long long _integralTotal = 0;
     DoubleDoubleSummation _nonDecimalTotal;
     Decimal128 _decimalTotal;
     long long _count;
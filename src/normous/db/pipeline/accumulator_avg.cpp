@@ -36,6 +36,7 @@
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/value.h"
 #include "mongo/platform/decimal128.h"
+#include "mongo/platform/overflow_arithmetic.h"
 
 namespace mongo {
 
@@ -77,12 +78,20 @@ void AccumulatorAvg::processInternal(const Value& input, bool merging) {
             _decimalTotal = _decimalTotal.add(input.getDecimal());
             _isDecimal = true;
             break;
-        case NumberLong:
+        case NumberInt:
+        case NumberLong: {
             // Avoid summation using double as that loses precision.
-            _nonDecimalTotal.addLong(input.getLong());
+            long long newTotal;
+            if (mongoSignedAddOverflow64(_integralTotal, input.coerceToLong(), &newTotal)) {
+                _foldIntegralTotal();
+                _nonDecimalTotal.addLong(input.coerceToLong());
+            } else {
+                _integralTotal = newTotal;
+            }
             break;
-        case NumberInt:
+        }
         case NumberDouble:
+            _foldIntegralTotal();
             _nonDecimalTotal.addDouble(input.getDouble());
             break;
         default:
@@ -97,11 +106,19 @@ intrusive_ptr<Accumulator> AccumulatorAvg::create(
     return new AccumulatorAvg(expCtx);
 }
 
+void AccumulatorAvg::_foldIntegralTotal() {
+    if (_integralTotal != 0) {
+        _nonDecimalTotal.addLong(_integralTotal);
+        _integralTotal = 0;
+    }
+}
+
 Decimal128 AccumulatorAvg::_getDecimalTotal() const {
     return _decimalTotal.add(_nonDecimalTotal.getDecimal());
 }
 
 Value AccumulatorAvg::getValue(bool toBeMerged) {
+    _foldIntegralTotal();
     if (toBeMerged) {
         if (_isDecimal)
             return Value(Document{{subTotalName, _getDecimalTotal()}, {countName, _count}});
@@ -129,6 +146,7 @@ AccumulatorAvg::AccumulatorAvg(const boost::intrusive_ptr<ExpressionContext>& ex
 
 void AccumulatorAvg::reset() {
     _isDecimal = false;
+    _integralTotal = 0;
     _nonDecimalTotal = {};
     _decimalTotal = {};
     _count = 0;
@@ -36,6 +36,7 @@
 #include "mongo/db/pipeline/accumulation_statement.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/value.h"
+#include "mongo/platform/overflow_arithmetic.h"
 #include "mongo/util/summation.h"
 
 namespace mongo {
@@ -70,10 +71,18 @@ void AccumulatorSum::processInternal(const Value& input, bool merging) {
     totalType = Value::getWidestNumeric(totalType, input.getType());
     switch (input.getType()) {
         case NumberInt:
-        case NumberLong:
-            nonDecimalTotal.addLong(input.coerceToLong());
+        case NumberLong: {
+            long long newTotal;
+            if (mongoSignedAddOverflow64(integralTotal, input.coerceToLong(), &newTotal)) {
+                foldIntegralTotal();
+                nonDecimalTotal.addLong(input.coerceToLong());
+            } else {
+                integralTotal = newTotal;
+            }
             break;
+        }
         case NumberDouble:
+            foldIntegralTotal();
             nonDecimalTotal.addDouble(input.getDouble());
             break;
         case NumberDecimal:
@@ -89,7 +98,15 @@ intrusive_ptr<Accumulator> AccumulatorSum::create(
     return new AccumulatorSum(expCtx);
 }
 
+void AccumulatorSum::foldIntegralTotal() {
+    if (integralTotal != 0) {
+        nonDecimalTotal.addLong(integralTotal);
+        integralTotal = 0;
+    }
+}
+
 Value AccumulatorSum::getValue(bool toBeMerged) {
+    foldIntegralTotal();
     switch (totalType) {
         case NumberInt:
             if (nonDecimalTotal.fitsLong())
@@ -142,6 +159,7 @@ AccumulatorSum::AccumulatorSum(const boost::intrusive_ptr<ExpressionContext>& ex
 
 void AccumulatorSum::reset() {
     totalType = NumberInt;
+    integralTotal = 0;
     nonDecimalTotal = {};
     decimalTotal = {};
 }
@@ -312,6 +312,12 @@ TEST(Accumulators, Sum) {
          // Two longs overflow into a double.
          {{Value(numeric_limits<long long>::max()), Value(numeric_limits<long long>::max())},
           Value(static_cast<double>(numeric_limits<long long>::max()) * 2)},
+         // A long sum which overflows part way through is still exact.
+         {{Value(numeric_limits<long long>::max()), Value(1), Value(-2LL)},
+          Value(numeric_limits<long long>::max() - 1)},
+         // A long sum interrupted by doubles is still exact.
+         {{Value(numeric_limits<long long>::max()), Value(0.5), Value(-1LL), Value(0.5)},
+          Value(static_cast<double>(numeric_limits<long long>::max()))},
          // A long and a double do not trigger a long overflow.
          {{Value(numeric_limits<long long>::max()), Value(1.0)},
           Value(numeric_limits<long long>::max() + 1.0)},
@@ -222,8 +222,31 @@ std::vector<DepsTracker::MetadataType> DepsTracker::getAllRequiredMetadataTypes(
 }
 
 namespace {
+uint64_t fieldNameFilterBit(StringData fieldName) {
+    const size_t hash = fieldName.empty()
+        ? 0
+        : fieldName.size() * 31 + static_cast<unsigned char>(fieldName[0]) * 7 +
+            static_cast<unsigned char>(fieldName[fieldName.size() - 1]);
+    return uint64_t(1) << (hash % 64);
+}
+
+// Returns a filter with a bit set for each top-level field of 'neededFields'. A field of the input
+// whose bit is not set is certainly not needed, which lets wide documents be scanned without
+// looking most of their field names up in 'neededFields'.
+uint64_t fieldNameFilter(const Document& neededFields) {
+    uint64_t filter = 0;
+    FieldIterator it(neededFields);
+    while (it.more()) {
+        filter |= fieldNameFilterBit(it.next().first);
+    }
+    return filter;
+}
+
 // Mutually recursive with arrayHelper
-Document documentHelper(const BSONObj& bson, const Document& neededFields, int nFieldsNeeded = -1);
+Document documentHelper(const BSONObj& bson,
+                        const Document& neededFields,
+                        int nFieldsNeeded = -1,
+                        uint64_t neededFieldNameFilter = 0);
 
 // Handles array-typed values for ParsedDeps::extractFields
 Value arrayHelper(const BSONObj& bson, const Document& neededFields) {
@@ -246,11 +269,15 @@ Value arrayHelper(const BSONObj& bson, const Document& neededFields) {
 }
 
 // Handles object-typed values including the top-level for ParsedDeps::extractFields
-Document documentHelper(const BSONObj& bson, const Document& neededFields, int nFieldsNeeded) {
-    // We cache the number of top level fields, so don't need to re-compute it every time. For
-    // sub-documents, just scan for the number of fields.
+Document documentHelper(const BSONObj& bson,
+                        const Document& neededFields,
+                        int nFieldsNeeded,
+                        uint64_t neededFieldNameFilter) {
+    // We cache the number of top level fields and their filter, so don't need to re-compute them
+    // every time. For sub-documents, just scan the needed fields.
     if (nFieldsNeeded == -1) {
         nFieldsNeeded = neededFields.size();
+        neededFieldNameFilter = fieldNameFilter(neededFields);
     }
     MutableDocument md(nFieldsNeeded);
 
@@ -258,7 +285,10 @@ Document documentHelper(const BSONObj& bson, const Document& neededFields, int n
     while (it.more() && nFieldsNeeded > 0) {
         auto bsonElement = it.next();
         StringData fieldName = bsonElement.fieldNameStringData();
-        Value isNeeded = neededFields[fieldName];
+        if (!(neededFieldNameFilter & fieldNameFilterBit(fieldName)))
+            continue;
+
+        const Value& isNeeded = neededFields.peekField(fieldName);
 
         if (isNeeded.missing())
             continue;
@@ -284,7 +314,12 @@ Document documentHelper(const BSONObj& bson, const Document& neededFields, int n
 }
 }  // namespace
 
+ParsedDeps::ParsedDeps(Document&& fields)
+    : _fields(std::move(fields)),
+      _nFields(_fields.size()),
+      _fieldNameFilter(fieldNameFilter(_fields)) {}
+
 Document ParsedDeps::extractFields(const BSONObj& input) const {
-    return documentHelper(input, _fields, _nFields);
+    return documentHelper(input, _fields, _nFields, _fieldNameFilter);
 }
 }
@@ -199,9 +199,12 @@ public:
 
 private:
     friend struct DepsTracker;  // so it can call constructor
-    explicit ParsedDeps(Document&& fields) : _fields(std::move(fields)), _nFields(_fields.size()) {}
+    explicit ParsedDeps(Document&& fields);
 
     Document _fields;
     int _nFields;  // Cache the number of top-level fields needed.
+
+    // Cache a filter of the top-level field names needed. See fieldNameFilter() in the .cpp file.
+    uint64_t _fieldNameFilter;
 };
 }
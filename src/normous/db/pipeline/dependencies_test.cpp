@@ -34,9 +34,12 @@
 #include "mongo/bson/bsonmisc.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/bson/json.h"
 #include "mongo/db/pipeline/dependencies.h"
 #include "mongo/db/pipeline/document.h"
+#include "mongo/db/pipeline/document_value_test_util.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/mongoutils/str.h"
 
 namespace mongo {
 namespace {
@@ -159,5 +162,23 @@ TEST(DependenciesToProjectionTest,
     ASSERT_BSONOBJ_EQ(deps.toProjection(), BSON(Document::metaFieldTextScore << metaTextScore));
 }
 
+TEST(ParsedDepsTest, ShouldExtractOnlyNeededFieldsFromWideDocument) {
+    DepsTracker deps;
+    deps.fields = {"a", "f50", "sub.b", "arr.c"};
+    auto parsedDeps = deps.toParsedDeps();
+    ASSERT(parsedDeps);
+
+    BSONObjBuilder bob;
+    for (int i = 0; i < 300; ++i) {
+        bob.append(str::stream() << "f" << i, i);
+    }
+    bob.append("a", 1);
+    bob.append("sub", BSON("b" << 2 << "x" << 3));
+    bob.append("arr", BSON_ARRAY(BSON("c" << 4 << "d" << 5) << 6 << BSON("d" << 7)));
+
+    ASSERT_DOCUMENT_EQ(parsedDeps->extractFields(bob.obj()),
+                       Document(fromjson("{f50: 50, a: 1, sub: {b: 2}, arr: [{c: 4}, {}]}")));
+}
+
 }  // namespace
 }  // namespace mongo
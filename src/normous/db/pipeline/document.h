@@ -123,6 +123,15 @@ public:
         return storage().getField(key);
     }
 
+    /**
+     * Like getField(key), but returns a reference into this Document's storage rather than a copy,
+     * saving a refcount round trip when the caller only inspects the Value. The reference is valid
+     * only as long as this Document is.
+     */
+    const Value& peekField(StringData key) const {
+        return storage().peekField(key);
+    }
+
     /// Look up a field by Position. See positionOf and getNestedField.
     const Value operator[](Position pos) const {
         return getField(pos);
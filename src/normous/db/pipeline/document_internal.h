@@ -236,6 +236,13 @@ public:
             return Value();
         return getField(pos).val;
     }
+    const Value& peekField(StringData name) const {
+        static const Value kMissing;
+        Position pos = findField(name);
+        if (!pos.found())
+            return kMissing;
+        return getField(pos).val;
+    }
 
     // MutableDocument uses these
     ValueElement& getField(Position pos) {
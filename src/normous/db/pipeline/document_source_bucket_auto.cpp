@@ -31,6 +31,7 @@
 #include "mongo/db/pipeline/document_source_bucket_auto.h"
 
 #include "mongo/db/pipeline/accumulation_statement.h"
+#include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
 
 namespace mongo {
@@ -95,24 +96,61 @@ DocumentSource::GetNextResult DocumentSourceBucketAuto::populateSorter() {
             opts.extSortAllowed = true;
             opts.tempDir = pExpCtx->tempDir;
         }
-        const auto& valueCmp = pExpCtx->getValueComparator();
-        auto comparator = [valueCmp](const Sorter<Value, Document>::Data& lhs,
-                                     const Sorter<Value, Document>::Data& rhs) {
+        // Granularity only allows numeric boundaries, which the collation does not affect.
+        _sortByComparisonKey = pExpCtx->getCollator() && !_granularityRounder;
+        const auto valueCmp =
+            _sortByComparisonKey ? ValueComparator() : pExpCtx->getValueComparator();
+        auto comparator = [valueCmp](const Sorter<Value, Value>::Data& lhs,
+                                     const Sorter<Value, Value>::Data& rhs) {
             return valueCmp.compare(lhs.first, rhs.first);
         };
 
-        _sorter.reset(Sorter<Value, Document>::make(opts, comparator));
+        _sorter.reset(Sorter<Value, Value>::make(opts, comparator));
     }
 
     auto next = pSource->getNext();
     for (; next.isAdvanced(); next = pSource->getNext()) {
         auto nextDoc = next.releaseDocument();
-        _sorter->add(extractKey(nextDoc), nextDoc);
+        auto key = extractKey(nextDoc);
+        auto args = evaluateAccumulatorArgs(nextDoc);
+        if (_sortByComparisonKey) {
+            auto comparisonKey =
+                DocumentSourceSort::getCollationComparisonKey(key, pExpCtx->getCollator());
+            _sorter->add(comparisonKey, Value(vector<Value>{std::move(key), std::move(args)}));
+        } else {
+            _sorter->add(key, args);
+        }
         _nDocuments++;
     }
     return next;
 }
 
+pair<Value, Value> DocumentSourceBucketAuto::nextSortedEntry() {
+    auto entry = _sortedInput->next();
+    if (!_sortByComparisonKey) {
+        return entry;
+    }
+
+    const auto& keyAndArgs = entry.second.getArray();
+    return {keyAndArgs[0], keyAndArgs[1]};
+}
+
+Value DocumentSourceBucketAuto::evaluateAccumulatorArgs(const Document& doc) {
+    // The accumulators only ever see their arguments, so sorting those instead of the whole
+    // document keeps the sorter smaller, and makes it less likely to spill.
+    const size_t numAccumulators = _accumulatedFields.size();
+    if (numAccumulators == 1) {
+        return _accumulatedFields[0].expression->evaluate(doc);
+    }
+
+    vector<Value> args;
+    args.reserve(numAccumulators);
+    for (auto&& accumulatedField : _accumulatedFields) {
+        args.push_back(accumulatedField.expression->evaluate(doc));
+    }
+    return Value(std::move(args));
+}
+
 Value DocumentSourceBucketAuto::extractKey(const Document& doc) {
     if (!_groupByExpression) {
         return Value(BSONNULL);
@@ -144,14 +182,20 @@ Value DocumentSourceBucketAuto::extractKey(const Document& doc) {
     return key.missing() ? Value(BSONNULL) : std::move(key);
 }
 
-void DocumentSourceBucketAuto::addDocumentToBucket(const pair<Value, Document>& entry,
+void DocumentSourceBucketAuto::addDocumentToBucket(const pair<Value, Value>& entry,
                                                    Bucket& bucket) {
     invariant(pExpCtx->getValueComparator().evaluate(entry.first >= bucket._max));
     bucket._max = entry.first;
 
     const size_t numAccumulators = _accumulatedFields.size();
+    if (numAccumulators == 1) {
+        bucket._accums[0]->process(entry.second, false);
+        return;
+    }
+
+    const auto& args = entry.second.getArray();
     for (size_t k = 0; k < numAccumulators; k++) {
-        bucket._accums[k]->process(_accumulatedFields[k].expression->evaluate(entry.second), false);
+        bucket._accums[k]->process(args[k], false);
     }
 }
 
@@ -175,19 +219,19 @@ void DocumentSourceBucketAuto::populateBuckets() {
         approxBucketSize = 1;
     }
 
-    boost::optional<pair<Value, Document>> firstEntryInNextBucket;
+    boost::optional<pair<Value, Value>> firstEntryInNextBucket;
 
     // Start creating and populating the buckets.
     for (int i = 0; i < _nBuckets; i++) {
         bool isLastBucket = (i == _nBuckets - 1);
 
         // Get the first value to place in this bucket.
-        pair<Value, Document> currentValue;
+        pair<Value, Value> currentValue;
         if (firstEntryInNextBucket) {
             currentValue = *firstEntryInNextBucket;
             firstEntryInNextBucket = boost::none;
         } else if (_sortedInput->more()) {
-            currentValue = _sortedInput->next();
+            currentValue = nextSortedEntry();
         } else {
             // No more values to process.
             break;
@@ -203,22 +247,22 @@ void DocumentSourceBucketAuto::populateBuckets() {
             // If this is the last bucket allowed, we need to put any remaining documents in
             // the current bucket.
             while (_sortedInput->more()) {
-                addDocumentToBucket(_sortedInput->next(), currentBucket);
+                addDocumentToBucket(nextSortedEntry(), currentBucket);
             }
         } else {
             // We go to approxBucketSize - 1 because we already added the first value in order
             // to keep track of the minimum value.
             for (long long j = 0; j < approxBucketSize - 1; j++) {
                 if (_sortedInput->more()) {
-                    addDocumentToBucket(_sortedInput->next(), currentBucket);
+                    addDocumentToBucket(nextSortedEntry(), currentBucket);
                 } else {
                     // No more values to process.
                     break;
                 }
             }
 
-            boost::optional<pair<Value, Document>> nextValue = _sortedInput->more()
-                ? boost::optional<pair<Value, Document>>(_sortedInput->next())
+            boost::optional<pair<Value, Value>> nextValue = _sortedInput->more()
+                ? boost::optional<pair<Value, Value>>(nextSortedEntry())
                 : boost::none;
 
             if (_granularityRounder) {
@@ -229,7 +273,7 @@ void DocumentSourceBucketAuto::populateBuckets() {
                        pExpCtx->getValueComparator().evaluate(boundaryValue > nextValue->first)) {
                     addDocumentToBucket(*nextValue, currentBucket);
                     nextValue = _sortedInput->more()
-                        ? boost::optional<pair<Value, Document>>(_sortedInput->next())
+                        ? boost::optional<pair<Value, Value>>(nextSortedEntry())
                         : boost::none;
                 }
                 if (nextValue) {
@@ -243,7 +287,7 @@ void DocumentSourceBucketAuto::populateBuckets() {
                                                               nextValue->first)) {
                     addDocumentToBucket(*nextValue, currentBucket);
                     nextValue = _sortedInput->more()
-                        ? boost::optional<pair<Value, Document>>(_sortedInput->next())
+                        ? boost::optional<pair<Value, Value>>(nextSortedEntry())
                         : boost::none;
                 }
             }
@@ -113,7 +113,8 @@ private:
 
     /**
      * Consumes all of the documents from the source in the pipeline and sorts them by their
-     * 'groupBy' value. This method might not be able to finish populating the sorter in a single
+     * 'groupBy' value. Only the accumulator arguments of each document are sorted, rather than the
+     * whole document. This method might not be able to finish populating the sorter in a single
      * call if 'pSource' returns a DocumentSource::GetNextResult::kPauseExecution, so this returns
      * the last GetNextResult encountered, which may be either kEOF or kPauseExecution.
      */
@@ -124,15 +125,28 @@ private:
      */
     Value extractKey(const Document& doc);
 
+    /**
+     * Evaluates the argument of each accumulator against 'doc'. Returns the argument itself when
+     * there is a single accumulator, or an array of the arguments otherwise.
+     */
+    Value evaluateAccumulatorArgs(const Document& doc);
+
     /**
      * Calculates the bucket boundaries for the input documents and places them into buckets.
      */
     void populateBuckets();
 
     /**
-     * Adds the document in 'entry' to 'bucket' by updating the accumulators in 'bucket'.
+     * Returns the next entry from '_sortedInput' as a pair of the 'groupBy' value and the
+     * accumulator arguments, unwrapping entries that were sorted by their comparison key.
      */
-    void addDocumentToBucket(const std::pair<Value, Document>& entry, Bucket& bucket);
+    std::pair<Value, Value> nextSortedEntry();
+
+    /**
+     * Adds the accumulator arguments in 'entry', as produced by evaluateAccumulatorArgs(), to
+     * 'bucket' by updating the accumulators in 'bucket'.
+     */
+    void addDocumentToBucket(const std::pair<Value, Value>& entry, Bucket& bucket);
 
     /**
      * Adds 'newBucket' to _buckets and updates any boundaries if necessary.
@@ -145,8 +159,13 @@ private:
      */
     Document makeDocument(const Bucket& bucket);
 
-    std::unique_ptr<Sorter<Value, Document>> _sorter;
-    std::unique_ptr<Sorter<Value, Document>::Iterator> _sortedInput;
+    std::unique_ptr<Sorter<Value, Value>> _sorter;
+    std::unique_ptr<Sorter<Value, Value>::Iterator> _sortedInput;
+
+    // With a non-simple collation, the sorter is keyed on the collation comparison key of each
+    // 'groupBy' value, so that sorting compares bytes instead of calling into the collator, and
+    // the 'groupBy' value itself travels with the accumulator arguments.
+    bool _sortByComparisonKey = false;
 
     std::vector<AccumulationStatement> _accumulatedFields;
 
@@ -45,6 +45,7 @@
 #include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/document_value_test_util.h"
 #include "mongo/db/pipeline/value.h"
+#include "mongo/db/query/collation/collator_interface_mock.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
 
@@ -313,6 +314,26 @@ TEST_F(BucketAutoTests, RespectsCanonicalTypeOrderingOfValues) {
     ASSERT_DOCUMENT_EQ(results[1], Document(fromjson("{_id : {min : 'a', max : 'b'}, count : 2}")));
 }
 
+TEST_F(BucketAutoTests, SortsByCollationAndReportsOriginalBoundaries) {
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kReverseString);
+    getExpCtx()->setCollator(&collator);
+
+    // Reversed, the values are 'az', 'ba', 'by' and 'cx', so this is the order they sort in.
+    auto bucketAutoSpec =
+        fromjson("{$bucketAuto : {groupBy : '$x', buckets : 2, output : {vs : {$push : '$v'}}}}");
+    auto results = getResults(bucketAutoSpec,
+                              {Document{{"x", "yb"_sd}, {"v", 3}},
+                               Document{{"x", "xc"_sd}, {"v", 4}},
+                               Document{{"x", "za"_sd}, {"v", 1}},
+                               Document{{"x", "ab"_sd}, {"v", 2}}});
+
+    ASSERT_EQUALS(results.size(), 2UL);
+    ASSERT_DOCUMENT_EQ(results[0],
+                       Document(fromjson("{_id : {min : 'za', max : 'yb'}, vs : [1, 2]}")));
+    ASSERT_DOCUMENT_EQ(results[1],
+                       Document(fromjson("{_id : {min : 'yb', max : 'xc'}, vs : [3, 4]}")));
+}
+
 TEST_F(BucketAutoTests, ShouldPropagatePauses) {
     auto bucketAutoSpec = fromjson("{$bucketAuto : {groupBy : '$x', buckets : 2}}");
     auto bucketAutoStage = createBucketAuto(bucketAutoSpec);
@@ -380,6 +401,60 @@ TEST_F(BucketAutoTests, ShouldBeAbleToCorrectlySpillToDisk) {
     ASSERT_TRUE(bucketAutoStage->getNext().isEOF());
 }
 
+TEST_F(BucketAutoTests, ShouldSpillAccumulatorArgumentsWithMultipleAccumulators) {
+    auto expCtx = getExpCtx();
+    unittest::TempDir tempDir("DocumentSourceBucketAutoTest");
+    expCtx->tempDir = tempDir.path();
+    expCtx->allowDiskUse = true;
+    const size_t maxMemoryUsageBytes = 1000;
+
+    VariablesParseState vps = expCtx->variablesParseState;
+    auto groupByExpression = ExpressionFieldPath::parse(expCtx, "$a", vps);
+
+    // Only the accumulator arguments are sorted, so make those large enough to force a spill. Most
+    // documents have no 'b', which checks that missing arguments survive the spill.
+    auto outputSpec = fromjson("{count: {$sum: 1}, strs: {$push: '$largeStr'}, m: {$max: '$b'}}");
+    std::vector<AccumulationStatement> accumulationStatements;
+    for (auto&& outputField : outputSpec) {
+        accumulationStatements.push_back(
+            AccumulationStatement::parseAccumulationStatement(expCtx, outputField, vps));
+    }
+
+    const int numBuckets = 2;
+    auto bucketAutoStage = DocumentSourceBucketAuto::create(expCtx,
+                                                            groupByExpression,
+                                                            numBuckets,
+                                                            std::move(accumulationStatements),
+                                                            nullptr,
+                                                            maxMemoryUsageBytes);
+
+    string largeStr(maxMemoryUsageBytes, 'x');
+    auto mock = DocumentSourceMock::create({Document{{"a", 3}, {"largeStr", largeStr}},
+                                            Document{{"a", 1}, {"largeStr", largeStr}, {"b", 7}},
+                                            Document{{"a", 2}, {"largeStr", largeStr}},
+                                            Document{{"a", 0}, {"largeStr", largeStr}}});
+    bucketAutoStage->setSource(mock.get());
+
+    const Value twoStrs(vector<Value>{Value(largeStr), Value(largeStr)});
+    auto next = bucketAutoStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       (Document{{"_id", Document{{"min", 0}, {"max", 2}}},
+                                 {"count", 2},
+                                 {"strs", twoStrs},
+                                 {"m", 7}}));
+
+    next = bucketAutoStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       (Document{{"_id", Document{{"min", 2}, {"max", 3}}},
+                                 {"count", 2},
+                                 {"strs", twoStrs},
+                                 {"m", BSONNULL}}));
+
+    ASSERT_TRUE(bucketAutoStage->getNext().isEOF());
+}
+
 TEST_F(BucketAutoTests, ShouldBeAbleToPauseLoadingWhileSpilled) {
     auto expCtx = getExpCtx();
 
@@ -43,7 +43,6 @@ namespace mongo {
 class Exchange : public RefCountable {
     static constexpr size_t kInvalidThreadId{std::numeric_limits<size_t>::max()};
     static constexpr size_t kMaxBufferSize = 100 * 1024 * 1024;  // 100 MB
-    static constexpr size_t kMaxNumberConsumers = 100;
 
     /**
      * Convert the BSON representation of boundaries (as deserialized off the wire) to the internal
@@ -70,6 +69,8 @@ class Exchange : public RefCountable {
     static std::vector<FieldPath> extractKeyPaths(const BSONObj& keyPattern);
 
 public:
+    static constexpr size_t kMaxNumberConsumers = 100;
+
     Exchange(ExchangeSpec spec, std::unique_ptr<Pipeline, PipelineDeleter> pipeline);
     DocumentSource::GetNextResult getNext(OperationContext* opCtx, size_t consumerId);
 
@@ -30,6 +30,7 @@
 
 #include "mongo/db/pipeline/document_source_facet.h"
 
+#include <deque>
 #include <memory>
 #include <vector>
 
@@ -44,7 +45,11 @@
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/pipeline/tee_buffer.h"
 #include "mongo/db/pipeline/value.h"
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/mongoutils/str.h"
 
@@ -158,6 +163,7 @@ intrusive_ptr<DocumentSourceFacet> DocumentSourceFacet::create(
 }
 
 void DocumentSourceFacet::setSource(DocumentSource* source) {
+    DocumentSource::setSource(source);
     _teeBuffer->setSource(source);
 }
 
@@ -168,6 +174,273 @@ void DocumentSourceFacet::doDispose() {
     }
 }
 
+namespace {
+
+// Stages which only compute over their input and their own ExpressionContext, without touching the
+// OperationContext or any collection. Sub-pipelines made up of these alone may run on a thread
+// other than the one running the operation.
+const StringData kParallelSafeStages[] = {"$addFields"_sd,
+                                          "$bucketAuto"_sd,
+                                          "$group"_sd,
+                                          "$limit"_sd,
+                                          "$match"_sd,
+                                          "$project"_sd,
+                                          "$replaceRoot"_sd,
+                                          "$skip"_sd,
+                                          "$sort"_sd,
+                                          "$unwind"_sd};
+
+/**
+ * Runs one $facet sub-pipeline on its own thread. The thread running the $facet pushes batches of
+ * input documents, which are shared between all of the workers, and the worker's pipeline reads
+ * them through a FacetWorkerInput stage.
+ */
+class FacetWorker {
+public:
+    using Batch = std::shared_ptr<const vector<Document>>;
+
+    FacetWorker(const intrusive_ptr<ExpressionContext>& parentExpCtx, const Pipeline& pipeline);
+    ~FacetWorker();
+
+    void start();
+
+    /**
+     * Queues 'batch' for the worker, waiting while the worker is too far behind. Throws the error
+     * which stopped the worker, if there was one.
+     */
+    void push(Batch batch);
+
+    /**
+     * Waits for the worker to consume all of its input, and returns the documents its pipeline
+     * produced. Throws the error which stopped the worker, if there was one.
+     */
+    vector<Value> finish();
+
+    /**
+     * Returns the next input document, or boost::none once the input is exhausted. Called on the
+     * worker's thread by its pipeline.
+     */
+    boost::optional<Document> nextInput();
+
+private:
+    // The thread running the $facet waits once this many batches are queued for a worker.
+    static constexpr size_t kMaxQueuedBatches = 8;
+
+    void _run();
+
+    OperationContext* const _opCtx;
+    const intrusive_ptr<ExpressionContext> _expCtx;
+    std::unique_ptr<Pipeline, PipelineDeleter> _pipeline;
+    vector<Value> _results;
+
+    // The batch the worker's pipeline is reading from. Only used by the worker's thread.
+    Batch _current;
+    size_t _currentIndex = 0;
+
+    stdx::mutex _mutex;
+    stdx::condition_variable _queueChanged;
+
+    // The following are protected by '_mutex' while the thread is running.
+    std::deque<Batch> _queue;
+    bool _inputDone = false;
+    bool _stopRequested = false;
+    Status _status = Status::OK();
+
+    stdx::thread _thread;
+};
+
+class FacetWorkerInput final : public DocumentSource {
+public:
+    FacetWorkerInput(const intrusive_ptr<ExpressionContext>& expCtx, FacetWorker* worker)
+        : DocumentSource(expCtx), _worker(worker) {}
+
+    GetNextResult getNext() final {
+        if (auto next = _worker->nextInput()) {
+            return std::move(*next);
+        }
+        return GetNextResult::makeEOF();
+    }
+
+    const char* getSourceName() const final {
+        return "$facetWorkerInput";
+    }
+
+    StageConstraints constraints(Pipeline::SplitState pipeState) const final {
+        return {StreamType::kStreaming,
+                PositionRequirement::kFirst,
+                HostTypeRequirement::kNone,
+                DiskUseRequirement::kNoDiskUse,
+                FacetRequirement::kAllowed,
+                TransactionRequirement::kAllowed};
+    }
+
+    Value serialize(boost::optional<ExplainOptions::Verbosity> explain) const final {
+        return Value();
+    }
+
+private:
+    FacetWorker* const _worker;
+};
+
+FacetWorker::FacetWorker(const intrusive_ptr<ExpressionContext>& parentExpCtx,
+                         const Pipeline& pipeline)
+    : _opCtx(parentExpCtx->opCtx), _expCtx(parentExpCtx->copyWith(parentExpCtx->ns)) {
+    _expCtx->variables = parentExpCtx->variables;
+    _expCtx->variablesParseState =
+        parentExpCtx->variablesParseState.copyWith(_expCtx->variables.useIdGenerator());
+
+    // Give the worker its own copy of the sub-pipeline, so that neither the stages nor the
+    // expressions within them are shared between threads.
+    vector<BSONObj> rawPipeline;
+    for (auto&& stage : pipeline.serialize()) {
+        rawPipeline.push_back(stage.getDocument().toBson());
+    }
+    _pipeline = uassertStatusOK(Pipeline::parseFacetPipeline(rawPipeline, _expCtx));
+    _pipeline->optimizePipeline();
+    _pipeline->addInitialSource(new FacetWorkerInput(_expCtx, this));
+
+    // The OperationContext belongs to the thread running the $facet, which checks for interrupts on
+    // behalf of the worker.
+    _expCtx->opCtx = nullptr;
+}
+
+FacetWorker::~FacetWorker() {
+    if (_thread.joinable()) {
+        {
+            stdx::lock_guard<stdx::mutex> lk(_mutex);
+            _stopRequested = true;
+        }
+        _queueChanged.notify_all();
+        _thread.join();
+    }
+    _expCtx->opCtx = _opCtx;
+}
+
+void FacetWorker::start() {
+    _thread = stdx::thread([this] { _run(); });
+}
+
+void FacetWorker::push(Batch batch) {
+    {
+        stdx::unique_lock<stdx::mutex> lk(_mutex);
+        _queueChanged.wait(lk,
+                           [&] { return _queue.size() < kMaxQueuedBatches || !_status.isOK(); });
+        uassertStatusOK(_status);
+        _queue.push_back(std::move(batch));
+    }
+    _queueChanged.notify_all();
+}
+
+vector<Value> FacetWorker::finish() {
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _inputDone = true;
+    }
+    _queueChanged.notify_all();
+    _thread.join();
+    uassertStatusOK(_status);
+    return std::move(_results);
+}
+
+boost::optional<Document> FacetWorker::nextInput() {
+    while (!_current || _currentIndex == _current->size()) {
+        {
+            stdx::unique_lock<stdx::mutex> lk(_mutex);
+            _queueChanged.wait(lk, [&] { return _stopRequested || _inputDone || !_queue.empty(); });
+            uassert(ErrorCodes::Interrupted, "$facet was stopped", !_stopRequested);
+            if (_queue.empty()) {
+                return boost::none;
+            }
+            _current = std::move(_queue.front());
+            _queue.pop_front();
+        }
+        _queueChanged.notify_all();
+        _currentIndex = 0;
+    }
+    return (*_current)[_currentIndex++];
+}
+
+void FacetWorker::_run() {
+    try {
+        while (auto next = _pipeline->getNext()) {
+            _results.emplace_back(std::move(*next));
+        }
+    } catch (...) {
+        Status status = exceptionToStatus();
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _status = std::move(status);
+        _queueChanged.notify_all();
+    }
+}
+
+}  // namespace
+
+bool DocumentSourceFacet::shouldRunInParallel() const {
+    if (_facets.size() < 2 ||
+        _facets.size() > static_cast<size_t>(internalQueryFacetParallelism.load()) ||
+        pExpCtx->explain || !pExpCtx->opCtx) {
+        return false;
+    }
+    for (auto&& facet : _facets) {
+        const auto& sources = facet.pipeline->getSources();
+        // The first stage of each sub-pipeline is the DocumentSourceTeeConsumer, which the workers
+        // replace.
+        for (auto it = std::next(sources.begin()); it != sources.end(); ++it) {
+            const StringData name = (*it)->getSourceName();
+            if (std::find(std::begin(kParallelSafeStages), std::end(kParallelSafeStages), name) ==
+                std::end(kParallelSafeStages)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+Document DocumentSourceFacet::runInParallel() {
+    // Documents are handed to the workers in batches of this many.
+    static constexpr size_t kBatchSize = 128;
+
+    vector<std::unique_ptr<FacetWorker>> workers;
+    for (auto&& facet : _facets) {
+        workers.push_back(stdx::make_unique<FacetWorker>(pExpCtx, *facet.pipeline));
+    }
+    for (auto&& worker : workers) {
+        worker->start();
+    }
+
+    auto pushBatch = [&](vector<Document>* batch) {
+        FacetWorker::Batch shared = std::make_shared<const vector<Document>>(std::move(*batch));
+        for (auto&& worker : workers) {
+            worker->push(shared);
+        }
+        batch->clear();
+        batch->reserve(kBatchSize);
+    };
+
+    vector<Document> batch;
+    batch.reserve(kBatchSize);
+    auto input = pSource->getNext();
+    for (; input.isAdvanced(); input = pSource->getNext()) {
+        pExpCtx->checkForInterrupt();
+        batch.push_back(input.releaseDocument());
+        if (batch.size() == kBatchSize) {
+            pushBatch(&batch);
+        }
+    }
+
+    // As with the TeeBuffer, nothing below a $facet can pause.
+    invariant(!input.isPaused());
+    if (!batch.empty()) {
+        pushBatch(&batch);
+    }
+
+    MutableDocument resultDoc;
+    for (size_t facetId = 0; facetId < _facets.size(); ++facetId) {
+        resultDoc[_facets[facetId].name] = Value(workers[facetId]->finish());
+    }
+    return resultDoc.freeze();
+}
+
 DocumentSource::GetNextResult DocumentSourceFacet::getNext() {
     pExpCtx->checkForInterrupt();
 
@@ -175,6 +448,11 @@ DocumentSource::GetNextResult DocumentSourceFacet::getNext() {
         return GetNextResult::makeEOF();
     }
 
+    if (shouldRunInParallel()) {
+        _done = true;  // We will only ever produce one result.
+        return runInParallel();
+    }
+
     vector<vector<Value>> results(_facets.size());
     bool allPipelinesEOF = false;
     while (!allPipelinesEOF) {
@@ -151,6 +151,19 @@ private:
 
     Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
 
+    /**
+     * Returns true if each sub-pipeline should run on its own thread. This requires there to be no
+     * more sub-pipelines than 'internalQueryFacetParallelism', and every stage within them to be
+     * safe to run away from the thread which owns the OperationContext.
+     */
+    bool shouldRunInParallel() const;
+
+    /**
+     * Runs every sub-pipeline on its own thread, feeding them all this stage's input, and returns
+     * the single output document.
+     */
+    Document runInParallel();
+
     boost::intrusive_ptr<TeeBuffer> _teeBuffer;
     std::vector<FacetPipeline> _facets;
 
@@ -43,8 +43,10 @@
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/document_source_skip.h"
 #include "mongo/db/pipeline/document_value_test_util.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 using std::deque;
@@ -406,6 +408,45 @@ TEST_F(DocumentSourceFacetTest, ShouldBeAbleToEvaluateMultipleStagesWithinOneSub
     ASSERT_DOCUMENT_EQ(output.getDocument(), Document(fromjson("{subPipe: [{_id: 0}, {_id: 1}]}")));
 }
 
+TEST_F(DocumentSourceFacetTest, ParallelSubPipelinesShouldProduceSameResultAsSequential) {
+    auto ctx = getExpCtx();
+
+    const auto oldParallelism = internalQueryFacetParallelism.load();
+    ON_BLOCK_EXIT([&] { internalQueryFacetParallelism.store(oldParallelism); });
+
+    // Use enough documents that the input is handed to the sub-pipelines in several batches.
+    deque<DocumentSource::GetNextResult> inputs;
+    for (int i = 0; i < 1000; ++i) {
+        inputs.emplace_back(Document{{"_id", i}, {"a", i % 7}});
+    }
+
+    auto spec = fromjson(
+        "{$facet: {"
+        "  evens: [{$match: {$expr: {$eq: [{$mod: ['$_id', 2]}, 0]}}}, {$count: 'n'}],"
+        "  byA: [{$group: {_id: '$a', total: {$sum: '$_id'}}}, {$sort: {_id: 1}}],"
+        "  top: [{$sort: {_id: -1}}, {$limit: 3}, {$project: {_id: 1}}]"
+        "}}");
+    auto runFacet = [&](int parallelism) {
+        internalQueryFacetParallelism.store(parallelism);
+        auto mock = DocumentSourceMock::create(inputs);
+        auto facetStage = DocumentSourceFacet::createFromBson(spec.firstElement(), ctx);
+        facetStage->optimize();
+        facetStage->setSource(mock.get());
+
+        auto output = facetStage->getNext();
+        ASSERT(output.isAdvanced());
+        ASSERT(facetStage->getNext().isEOF());
+        return output.releaseDocument();
+    };
+
+    const auto sequential = runFacet(1);
+    const auto parallel = runFacet(4);
+    ASSERT_VALUE_EQ(sequential["evens"], Value(fromjson("{'': [{n: 500}]}").firstElement()));
+    ASSERT_VALUE_EQ(sequential["top"],
+                    Value(fromjson("{'': [{_id: 999}, {_id: 998}, {_id: 997}]}").firstElement()));
+    ASSERT_DOCUMENT_EQ(sequential, parallel);
+}
+
 TEST_F(DocumentSourceFacetTest, ShouldPropagateDisposeThroughToSource) {
     auto ctx = getExpCtx();
 
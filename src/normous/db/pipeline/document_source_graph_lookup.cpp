@@ -39,6 +39,7 @@
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/value.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_planner_common.h"
 #include "mongo/stdx/memory.h"
 
@@ -184,7 +185,7 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
 
         // Check whether each key in the frontier exists in the cache or needs to be queried.
         auto cached = pExpCtx->getDocumentComparator().makeUnorderedDocumentSet();
-        auto matchStage = makeMatchStageFromFrontier(&cached);
+        auto matchStages = makeMatchStagesFromFrontier(&cached);
 
         ValueUnorderedSet queried = pExpCtx->getValueComparator().makeUnorderedValueSet();
         _frontier.swap(queried);
@@ -199,12 +200,11 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
             checkMemoryUsage();
         }
 
-        if (matchStage) {
-            // Query for all keys that were in the frontier and not in the cache, populating
-            // '_frontier' for the next iteration of search.
-
+        // Query for all keys that were in the frontier and not in the cache, one batch at a time,
+        // populating '_frontier' for the next iteration of search.
+        for (auto&& matchStage : matchStages) {
             // We've already allocated space for the trailing $match stage in '_fromPipeline'.
-            _fromPipeline.back() = *matchStage;
+            _fromPipeline.back() = matchStage;
             auto pipeline = uassertStatusOK(
                 pExpCtx->mongoProcessInterface->makePipeline(_fromPipeline, _fromExpCtx));
             while (auto next = pipeline->getNext()) {
@@ -280,7 +280,7 @@ void DocumentSourceGraphLookUp::addToCache(const Document& result,
         });
 }
 
-boost::optional<BSONObj> DocumentSourceGraphLookUp::makeMatchStageFromFrontier(
+std::vector<BSONObj> DocumentSourceGraphLookUp::makeMatchStagesFromFrontier(
     DocumentUnorderedSet* cached) {
     // Add any cached values to 'cached' and remove them from '_frontier'.
     for (auto it = _frontier.begin(); it != _frontier.end();) {
@@ -298,6 +298,37 @@ boost::optional<BSONObj> DocumentSourceGraphLookUp::makeMatchStageFromFrontier(
         }
     }
 
+    // Split the remaining values into batches, so that a very wide frontier neither produces a
+    // query larger than the maximum BSON size nor a single $in with an unwieldy number of index
+    // intervals.
+    const size_t maxBatchValues =
+        static_cast<size_t>(internalDocumentSourceGraphLookupFrontierBatchSize.load());
+    const size_t maxBatchBytes = BSONObjMaxUserSize / 2;
+
+    std::vector<BSONObj> matchStages;
+    auto batchBegin = _frontier.cbegin();
+    size_t batchValues = 0;
+    size_t batchBytes = 0;
+    for (auto it = _frontier.cbegin(); it != _frontier.cend(); ++it) {
+        const size_t valueSize = it->getApproximateSize();
+        if (batchValues > 0 &&
+            (batchValues >= maxBatchValues || batchBytes + valueSize > maxBatchBytes)) {
+            matchStages.push_back(makeMatchStage(batchBegin, it));
+            batchBegin = it;
+            batchValues = 0;
+            batchBytes = 0;
+        }
+        ++batchValues;
+        batchBytes += valueSize;
+    }
+    if (batchValues > 0) {
+        matchStages.push_back(makeMatchStage(batchBegin, _frontier.cend()));
+    }
+    return matchStages;
+}
+
+BSONObj DocumentSourceGraphLookUp::makeMatchStage(ValueUnorderedSet::const_iterator begin,
+                                                  ValueUnorderedSet::const_iterator end) const {
     // Create a query of the form {$and: [_additionalFilter, {_connectToField: {$in: [...]}}]}.
     //
     // We wrap the query in a $match so that it can be parsed into a DocumentSourceMatch when
@@ -317,8 +348,8 @@ boost::optional<BSONObj> DocumentSourceGraphLookUp::makeMatchStageFromFrontier(
                     BSONObjBuilder subObj(connectToObj.subobjStart(_connectToField.fullPath()));
                     {
                         BSONArrayBuilder in(subObj.subarrayStart("$in"));
-                        for (auto&& value : _frontier) {
-                            in << value;
+                        for (auto it = begin; it != end; ++it) {
+                            in << *it;
                         }
                     }
                 }
@@ -326,7 +357,7 @@ boost::optional<BSONObj> DocumentSourceGraphLookUp::makeMatchStageFromFrontier(
         }
     }
 
-    return _frontier.empty() ? boost::none : boost::optional<BSONObj>(match.obj());
+    return match.obj();
 }
 
 void DocumentSourceGraphLookUp::performSearch() {
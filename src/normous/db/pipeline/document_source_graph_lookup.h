@@ -121,15 +121,23 @@ private:
     }
 
     /**
-     * Prepares the query to execute on the 'from' collection wrapped in a $match by using the
-     * contents of '_frontier'.
+     * Prepares the queries to execute on the 'from' collection, each wrapped in a $match, by using
+     * the contents of '_frontier'. Each query covers at most
+     * 'internalDocumentSourceGraphLookupFrontierBatchSize' frontier values, and is kept well below
+     * the maximum BSON size.
      *
      * Fills 'cached' with any values that were retrieved from the cache.
      *
-     * Returns boost::none if no query is necessary, i.e., all values were retrieved from the cache.
-     * Otherwise, returns a query object.
+     * Returns an empty vector if no query is necessary, i.e., all values were retrieved from the
+     * cache.
      */
-    boost::optional<BSONObj> makeMatchStageFromFrontier(DocumentUnorderedSet* cached);
+    std::vector<BSONObj> makeMatchStagesFromFrontier(DocumentUnorderedSet* cached);
+
+    /**
+     * Builds a $match on the 'from' collection for the frontier values in the range [begin, end).
+     */
+    BSONObj makeMatchStage(ValueUnorderedSet::const_iterator begin,
+                           ValueUnorderedSet::const_iterator end) const;
 
     /**
      * If we have internalized a $unwind, getNext() dispatches to this function.
@@ -37,9 +37,11 @@
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/document_value_test_util.h"
 #include "mongo/db/pipeline/stub_mongo_process_interface.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/mongoutils/str.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -84,11 +86,17 @@ public:
     Status attachCursorSourceToPipeline(const boost::intrusive_ptr<ExpressionContext>& expCtx,
                                         Pipeline* pipeline) final {
         pipeline->addInitialSource(DocumentSourceMock::create(_results));
+        ++_numPipelinesAttached;
         return Status::OK();
     }
 
+    int numPipelinesAttached() const {
+        return _numPipelinesAttached;
+    }
+
 private:
     std::deque<DocumentSource::GetNextResult> _results;
+    int _numPipelinesAttached = 0;
 };
 
 TEST_F(DocumentSourceGraphLookUpTest,
@@ -544,6 +552,65 @@ TEST_F(DocumentSourceGraphLookUpTest, ShouldExpandArraysAtEndOfConnectFromField)
     ASSERT(graphLookupStage->getNext().isEOF());
 }
 
+TEST_F(DocumentSourceGraphLookUpTest, ShouldQueryWideFrontierInBatches) {
+    auto expCtx = getExpCtx();
+
+    const auto oldBatchSize = internalDocumentSourceGraphLookupFrontierBatchSize.load();
+    ON_BLOCK_EXIT([&] { internalDocumentSourceGraphLookupFrontierBatchSize.store(oldBatchSize); });
+    internalDocumentSourceGraphLookupFrontierBatchSize.store(2);
+
+    std::deque<DocumentSource::GetNextResult> inputs{Document{{"_id", 0}, {"startVal", 0}}};
+    auto inputMock = DocumentSourceMock::create(std::move(inputs));
+
+    // Make a graph where 0 connects to 1, 2 and 3, which all connect to 4. The frontier after the
+    // first level holds three values, which must be looked up in two batches.
+    Document startDoc{{"_id", 0}, {"to", std::vector<Value>{Value(1), Value(2), Value(3)}}};
+    Document middle1{{"_id", 1}, {"to", 4}};
+    Document middle2{{"_id", 2}, {"to", 4}};
+    Document middle3{{"_id", 3}, {"to", 4}};
+    Document sinkDoc{{"_id", 4}};
+
+    std::deque<DocumentSource::GetNextResult> fromContents{Document(startDoc),
+                                                           Document(middle1),
+                                                           Document(middle2),
+                                                           Document(middle3),
+                                                           Document(sinkDoc)};
+
+    NamespaceString fromNs("test", "graph_lookup");
+    expCtx->setResolvedNamespace_forTest(fromNs, {fromNs, std::vector<BSONObj>{}});
+    auto mongoProcessInterface = std::make_shared<MockMongoInterface>(std::move(fromContents));
+    expCtx->mongoProcessInterface = mongoProcessInterface;
+    auto graphLookupStage =
+        DocumentSourceGraphLookUp::create(expCtx,
+                                          fromNs,
+                                          "results",
+                                          "to",
+                                          "_id",
+                                          ExpressionFieldPath::create(expCtx, "startVal"),
+                                          boost::none,
+                                          boost::none,
+                                          boost::none,
+                                          boost::none);
+    graphLookupStage->setSource(inputMock.get());
+
+    auto next = graphLookupStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+
+    auto resultsValue = next.getDocument().getField("results");
+    ASSERT(resultsValue.isArray());
+    auto resultsArray = resultsValue.getArray();
+    ASSERT_EQ(5U, resultsArray.size());
+    ASSERT(arrayContains(expCtx, resultsArray, Value(startDoc)));
+    ASSERT(arrayContains(expCtx, resultsArray, Value(middle1)));
+    ASSERT(arrayContains(expCtx, resultsArray, Value(middle2)));
+    ASSERT(arrayContains(expCtx, resultsArray, Value(middle3)));
+    ASSERT(arrayContains(expCtx, resultsArray, Value(sinkDoc)));
+    ASSERT(graphLookupStage->getNext().isEOF());
+
+    // One query for {0}, two for {1, 2, 3} and one for {4}.
+    ASSERT_EQ(4, mongoProcessInterface->numPipelinesAttached());
+}
+
 TEST_F(DocumentSourceGraphLookUpTest, ShouldNotExpandArraysWithinArraysAtEndOfConnectFromField) {
     auto expCtx = getExpCtx();
 
@@ -28,6 +28,9 @@
 
 #include "mongo/platform/basic.h"
 
+#include <deque>
+
+#include "mongo/db/curop.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/pipeline/accumulation_statement.h"
 #include "mongo/db/pipeline/accumulator.h"
@@ -38,7 +41,11 @@
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
 #include "mongo/db/pipeline/value.h"
 #include "mongo/db/pipeline/value_comparator.h"
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
 
 namespace mongo {
 
@@ -95,9 +102,10 @@ DocumentSource::GetModPathsReturn GroupFromFirstDocumentTransformation::getModif
 std::unique_ptr<GroupFromFirstDocumentTransformation> GroupFromFirstDocumentTransformation::create(
     const intrusive_ptr<ExpressionContext>& expCtx,
     const std::string& groupId,
-    vector<pair<std::string, intrusive_ptr<Expression>>> accumulatorExprs) {
-    return std::make_unique<GroupFromFirstDocumentTransformation>(groupId,
-                                                                  std::move(accumulatorExprs));
+    vector<pair<std::string, intrusive_ptr<Expression>>> accumulatorExprs,
+    ExpectedInput expectedInput) {
+    return std::make_unique<GroupFromFirstDocumentTransformation>(
+        groupId, std::move(accumulatorExprs), expectedInput);
 }
 
 constexpr StringData DocumentSourceGroup::kStageName;
@@ -169,13 +177,19 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextSpilled() {
 }
 
 DocumentSource::GetNextResult DocumentSourceGroup::getNextStandard() {
-    // Not spilled, and not streaming.
-    if (_groups->empty())
-        return GetNextResult::makeEOF();
+    // Not spilled, and not streaming. After a parallel $group, the groups of each partition are
+    // returned in turn.
+    while (groupsIterator == _groups->end()) {
+        if (_pendingGroups.empty())
+            return GetNextResult::makeEOF();
+        _groups = std::move(_pendingGroups.back());
+        _pendingGroups.pop_back();
+        groupsIterator = _groups->begin();
+    }
 
     Document out = makeDocument(groupsIterator->first, groupsIterator->second, pExpCtx->needsMerge);
 
-    if (++groupsIterator == _groups->end())
+    if (++groupsIterator == _groups->end() && _pendingGroups.empty())
         dispose();
 
     return std::move(out);
@@ -221,6 +235,8 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextStreaming() {
 
 void DocumentSourceGroup::doDispose() {
     // Free our resources.
+    _partitions.clear();
+    _pendingGroups.clear();
     _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
     _sorterIterator.reset();
 
@@ -462,6 +478,114 @@ private:
     ValueComparator _valueComparator;
 };
 
+/**
+ * Adds 'root' to the group for 'id' in 'groups', creating the group's accumulators with 'expCtx' if
+ * it is new, and keeps '*memoryUsageBytes' up to date. 'getExpression(i)' returns the expression
+ * whose value for 'root' is passed to the i-th accumulator. Returns true if the group is new.
+ */
+template <typename GetExpression>
+bool accumulateIntoGroups(GroupsMap* groups,
+                          size_t* memoryUsageBytes,
+                          const Value& id,
+                          const Document& root,
+                          const vector<AccumulationStatement>& accumulatedFields,
+                          const intrusive_ptr<ExpressionContext>& expCtx,
+                          bool doingMerge,
+                          GetExpression getExpression) {
+    const size_t numAccumulators = accumulatedFields.size();
+
+    // Look for the _id value in the map. If it's not there, add a new entry with a blank
+    // accumulator. This is done in a somewhat odd way in order to avoid hashing 'id' and
+    // looking it up in 'groups' multiple times.
+    const size_t oldSize = groups->size();
+    vector<intrusive_ptr<Accumulator>>& group = (*groups)[id];
+    const bool inserted = groups->size() != oldSize;
+
+    if (inserted) {
+        *memoryUsageBytes += id.getApproximateSize();
+
+        // Add the accumulators
+        group.reserve(numAccumulators);
+        for (auto&& accumulatedField : accumulatedFields) {
+            group.push_back(accumulatedField.makeAccumulator(expCtx));
+        }
+    } else {
+        for (auto&& groupObj : group) {
+            // subtract old mem usage. New usage added back after processing.
+            *memoryUsageBytes -= groupObj->memUsageForSorter();
+        }
+    }
+
+    /* tickle all the accumulators for the group we found */
+    dassert(numAccumulators == group.size());
+
+    for (size_t i = 0; i < numAccumulators; i++) {
+        group[i]->process(getExpression(i)->evaluate(root), doingMerge);
+
+        *memoryUsageBytes += group[i]->memUsageForSorter();
+    }
+
+    return inserted;
+}
+
+/**
+ * Writes the contents of 'groups' to a sorted file in 'tempDir' and clears it. Returns an iterator
+ * over the file, which is ordered by group key.
+ */
+shared_ptr<Sorter<Value, Value>::Iterator> spillGroups(GroupsMap* groups,
+                                                       size_t numAccumulators,
+                                                       const ValueComparator& valueComparator,
+                                                       const std::string& tempDir,
+                                                       SorterSpillStats* spillStats) {
+    vector<const GroupsMap::value_type*> ptrs;  // using pointers to speed sorting
+    ptrs.reserve(groups->size());
+    for (GroupsMap::const_iterator it = groups->begin(), end = groups->end(); it != end; ++it) {
+        ptrs.push_back(&*it);
+    }
+
+    stable_sort(ptrs.begin(), ptrs.end(), SpillSTLComparator(valueComparator));
+
+    SortedFileWriter<Value, Value> writer(SortOptions().TempDir(tempDir).SpillStats(spillStats));
+    switch (numAccumulators) {  // same as ptrs[i]->second.size() for all i.
+        case 0:                 // no values, essentially a distinct
+            for (size_t i = 0; i < ptrs.size(); i++) {
+                writer.addAlreadySorted(ptrs[i]->first, Value());
+            }
+            break;
+
+        case 1:  // just one value, use optimized serialization as single Value
+            for (size_t i = 0; i < ptrs.size(); i++) {
+                writer.addAlreadySorted(ptrs[i]->first,
+                                        ptrs[i]->second[0]->getValue(/*toBeMerged=*/true));
+            }
+            break;
+
+        default:  // multiple values, serialize as array-typed Value
+            for (size_t i = 0; i < ptrs.size(); i++) {
+                vector<Value> accums;
+                for (size_t j = 0; j < ptrs[i]->second.size(); j++) {
+                    accums.push_back(ptrs[i]->second[j]->getValue(/*toBeMerged=*/true));
+                }
+                writer.addAlreadySorted(ptrs[i]->first, Value(std::move(accums)));
+            }
+            break;
+    }
+
+    groups->clear();
+
+    return shared_ptr<Sorter<Value, Value>::Iterator>(writer.done());
+}
+
+/**
+ * Returns the partition of a parallel $group which accumulates the group 'id'. Each partition
+ * hashes its keys again with the same hash function as 'groups', so the partition is chosen by the
+ * high bits of a remix of the hash, leaving the low bits spread across the partition's buckets.
+ */
+size_t choosePartition(const GroupsMap& groups, const Value& id, size_t numPartitions) {
+    const uint64_t hash = static_cast<uint64_t>(groups.hash_function()(id));
+    return ((hash * 0x9e3779b97f4a7c15ULL) >> 32) % numPartitions;
+}
+
 bool containsOnlyFieldPathsAndConstants(ExpressionObject* expressionObj) {
     for (auto&& it : expressionObj->getChildExpressions()) {
         const intrusive_ptr<Expression>& childExp = it.second;
@@ -525,6 +649,289 @@ void getFieldPathListForSpilled(ExpressionObject* expressionObj,
 }
 }  // namespace
 
+/**
+ * Accumulates, on a thread of its own, the groups of an unsorted $group whose _id hashes to one
+ * partition. The thread running the pipeline computes the _id of each input document and hands the
+ * document to the partition of that _id with push().
+ *
+ * Expressions keep the values of variables in their ExpressionContext, so each partition evaluates
+ * the accumulator arguments with copies of the expressions parsed into an ExpressionContext of its
+ * own. The partition's thread never uses the OperationContext.
+ */
+class DocumentSourceGroup::Partition {
+public:
+    Partition(const DocumentSourceGroup& group, size_t maxMemoryUsageBytes);
+    ~Partition();
+
+    /**
+     * Adds an already accumulated group. May only be called before start().
+     */
+    void adoptGroup(const Value& id, Accumulators accumulators);
+
+    void start();
+
+    /**
+     * Queues 'root', whose group key is 'id', to be accumulated by this partition's thread. Throws
+     * the error which stopped the thread, if there was one.
+     */
+    void push(Value id, Document root);
+
+    /**
+     * Waits for the thread to accumulate everything pushed to it. Throws the error which stopped
+     * the thread, if there was one.
+     */
+    void finish();
+
+    /**
+     * Writes the groups held in memory to a sorted file. May only be called by the partition's
+     * thread, or while that thread is not running.
+     */
+    void spill();
+
+    GroupsMap* groups() {
+        return &_groups;
+    }
+
+    const std::vector<shared_ptr<Sorter<Value, Value>::Iterator>>& sortedFiles() const {
+        return _sortedFiles;
+    }
+
+    const SorterSpillStats& spillStats() const {
+        return _spillStats;
+    }
+
+private:
+    using Batch = vector<pair<Value, Document>>;
+
+    // Documents are handed to the thread in batches of this many, and the thread running the
+    // pipeline waits once this many batches are queued.
+    static constexpr size_t kBatchSize = 128;
+    static constexpr size_t kMaxQueuedBatches = 8;
+
+    void _run();
+    void _accumulate(const Value& id, const Document& root);
+    void _flushBatch();
+
+    const DocumentSourceGroup& _group;
+    const intrusive_ptr<ExpressionContext> _expCtx;
+
+    // The argument of each accumulator of '_group', parsed into '_expCtx'.
+    vector<intrusive_ptr<Expression>> _expressions;
+
+    const size_t _maxMemoryUsageBytes;
+    size_t _memoryUsageBytes = 0;
+    GroupsMap _groups;
+    vector<shared_ptr<Sorter<Value, Value>::Iterator>> _sortedFiles;
+    SorterSpillStats _spillStats;
+
+    // The batch being filled by the thread running the pipeline.
+    Batch _batch;
+
+    stdx::mutex _mutex;
+    stdx::condition_variable _queueChanged;
+
+    // The following are protected by '_mutex' while the thread is running.
+    std::deque<Batch> _queue;
+    bool _inputDone = false;
+    bool _stopRequested = false;
+    Status _status = Status::OK();
+
+    stdx::thread _thread;
+};
+
+DocumentSourceGroup::Partition::Partition(const DocumentSourceGroup& group,
+                                          size_t maxMemoryUsageBytes)
+    : _group(group),
+      _expCtx(group.pExpCtx->copyWith(group.pExpCtx->ns)),
+      _maxMemoryUsageBytes(maxMemoryUsageBytes),
+      _groups(group.pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>()) {
+    _expCtx->variables = group.pExpCtx->variables;
+    _expCtx->variablesParseState =
+        group.pExpCtx->variablesParseState.copyWith(_expCtx->variables.useIdGenerator());
+
+    for (auto&& accumulatedField : group._accumulatedFields) {
+        const BSONObj serialized = BSON("" << accumulatedField.expression->serialize(false));
+        _expressions.push_back(Expression::parseOperand(
+            _expCtx, serialized.firstElement(), _expCtx->variablesParseState));
+    }
+    _batch.reserve(kBatchSize);
+}
+
+DocumentSourceGroup::Partition::~Partition() {
+    if (_thread.joinable()) {
+        {
+            stdx::lock_guard<stdx::mutex> lk(_mutex);
+            _stopRequested = true;
+        }
+        _queueChanged.notify_all();
+        _thread.join();
+    }
+}
+
+void DocumentSourceGroup::Partition::adoptGroup(const Value& id, Accumulators accumulators) {
+    invariant(!_thread.joinable());
+    _memoryUsageBytes += id.getApproximateSize();
+    for (auto&& accumulator : accumulators) {
+        _memoryUsageBytes += accumulator->memUsageForSorter();
+    }
+    _groups.emplace(id, std::move(accumulators));
+}
+
+void DocumentSourceGroup::Partition::start() {
+    _thread = stdx::thread([this] { _run(); });
+}
+
+void DocumentSourceGroup::Partition::push(Value id, Document root) {
+    _batch.emplace_back(std::move(id), std::move(root));
+    if (_batch.size() == kBatchSize) {
+        _flushBatch();
+    }
+}
+
+void DocumentSourceGroup::Partition::finish() {
+    _flushBatch();
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _inputDone = true;
+    }
+    _queueChanged.notify_all();
+    _thread.join();
+    uassertStatusOK(_status);
+}
+
+void DocumentSourceGroup::Partition::spill() {
+    _sortedFiles.push_back(spillGroups(&_groups,
+                                       _group._accumulatedFields.size(),
+                                       _expCtx->getValueComparator(),
+                                       _expCtx->tempDir,
+                                       &_spillStats));
+    _memoryUsageBytes = 0;
+}
+
+void DocumentSourceGroup::Partition::_flushBatch() {
+    if (_batch.empty()) {
+        return;
+    }
+    {
+        stdx::unique_lock<stdx::mutex> lk(_mutex);
+        _queueChanged.wait(
+            lk, [&] { return _queue.size() < kMaxQueuedBatches || !_status.isOK(); });
+        uassertStatusOK(_status);
+        _queue.push_back(std::move(_batch));
+    }
+    _queueChanged.notify_all();
+    _batch.clear();
+    _batch.reserve(kBatchSize);
+}
+
+void DocumentSourceGroup::Partition::_run() {
+    try {
+        while (true) {
+            Batch batch;
+            {
+                stdx::unique_lock<stdx::mutex> lk(_mutex);
+                _queueChanged.wait(
+                    lk, [&] { return _stopRequested || _inputDone || !_queue.empty(); });
+                if (_stopRequested || _queue.empty()) {
+                    return;
+                }
+                batch = std::move(_queue.front());
+                _queue.pop_front();
+            }
+            _queueChanged.notify_all();
+
+            for (auto&& entry : batch) {
+                _accumulate(entry.first, entry.second);
+            }
+        }
+    } catch (...) {
+        Status status = exceptionToStatus();
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _status = std::move(status);
+        _queueChanged.notify_all();
+    }
+}
+
+void DocumentSourceGroup::Partition::_accumulate(const Value& id, const Document& root) {
+    if (_memoryUsageBytes > _maxMemoryUsageBytes) {
+        uassert(16945,
+                "Exceeded memory limit for $group, but didn't allow external sort."
+                " Pass allowDiskUse:true to opt in.",
+                _group._allowDiskUse);
+        spill();
+    }
+
+    accumulateIntoGroups(&_groups,
+                         &_memoryUsageBytes,
+                         id,
+                         root,
+                         _group._accumulatedFields,
+                         _expCtx,
+                         _group._doingMerge,
+                         [&](size_t i) { return _expressions[i].get(); });
+}
+
+DocumentSourceGroup::~DocumentSourceGroup() = default;
+
+bool DocumentSourceGroup::shouldStartPartitions() const {
+    return _partitions.empty() && !pExpCtx->inMongos &&
+        internalDocumentSourceGroupParallelism.load() > 1 &&
+        _numInputDocsGrouped >= internalDocumentSourceGroupParallelMinInputDocs.load();
+}
+
+void DocumentSourceGroup::startPartitions() {
+    const size_t numPartitions = internalDocumentSourceGroupParallelism.load();
+    for (size_t i = 0; i < numPartitions; ++i) {
+        _partitions.push_back(
+            stdx::make_unique<Partition>(*this, _maxMemoryUsageBytes / numPartitions));
+    }
+
+    for (auto&& group : *_groups) {
+        _partitions[choosePartition(*_groups, group.first, numPartitions)]->adoptGroup(
+            group.first, std::move(group.second));
+    }
+    _groups->clear();
+    _memoryUsageBytes = 0;
+
+    for (auto&& partition : _partitions) {
+        partition->start();
+    }
+}
+
+void DocumentSourceGroup::finishPartitions() {
+    for (auto&& partition : _partitions) {
+        partition->finish();
+    }
+
+    // Spilled groups can only be merged with the rest once they are all sorted, so if any
+    // partition spilled, all of them spill what they still hold.
+    bool spilled = !_sortedFiles.empty();
+    for (auto&& partition : _partitions) {
+        spilled = spilled || !partition->sortedFiles().empty();
+    }
+
+    for (auto&& partition : _partitions) {
+        if (!spilled) {
+            _pendingGroups.push_back(std::move(*partition->groups()));
+            continue;
+        }
+
+        if (!partition->groups()->empty()) {
+            partition->spill();
+        }
+        if (!partition->sortedFiles().empty()) {
+            _usedDisk = true;
+            _sortedFiles.insert(_sortedFiles.end(),
+                                partition->sortedFiles().begin(),
+                                partition->sortedFiles().end());
+            if (pExpCtx->opCtx) {
+                CurOp::get(pExpCtx->opCtx)->debug().addSortSpill(partition->spillStats());
+            }
+        }
+    }
+    _partitions.clear();
+}
+
 DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
     const size_t numAccumulators = _accumulatedFields.size();
 
@@ -558,6 +965,18 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
     // Barring any pausing, this loop exhausts 'pSource' and populates '_groups'.
     GetNextResult input = pSource->getNext();
     for (; input.isAdvanced(); input = pSource->getNext()) {
+        if (shouldStartPartitions()) {
+            startPartitions();
+        }
+        if (!_partitions.empty()) {
+            auto rootDocument = input.releaseDocument();
+            Value id = computeId(rootDocument);
+            const size_t partition = choosePartition(*_groups, id, _partitions.size());
+            _partitions[partition]->push(std::move(id), std::move(rootDocument));
+            continue;
+        }
+        ++_numInputDocsGrouped;
+
         if (_memoryUsageBytes > _maxMemoryUsageBytes) {
             uassert(16945,
                     "Exceeded memory limit for $group, but didn't allow external sort."
@@ -572,37 +991,15 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
         auto rootDocument = input.releaseDocument();
         Value id = computeId(rootDocument);
 
-        // Look for the _id value in the map. If it's not there, add a new entry with a blank
-        // accumulator. This is done in a somewhat odd way in order to avoid hashing 'id' and
-        // looking it up in '_groups' multiple times.
-        const size_t oldSize = _groups->size();
-        vector<intrusive_ptr<Accumulator>>& group = (*_groups)[id];
-        const bool inserted = _groups->size() != oldSize;
-
-        if (inserted) {
-            _memoryUsageBytes += id.getApproximateSize();
-
-            // Add the accumulators
-            group.reserve(numAccumulators);
-            for (auto&& accumulatedField : _accumulatedFields) {
-                group.push_back(accumulatedField.makeAccumulator(pExpCtx));
-            }
-        } else {
-            for (auto&& groupObj : group) {
-                // subtract old mem usage. New usage added back after processing.
-                _memoryUsageBytes -= groupObj->memUsageForSorter();
-            }
-        }
-
-        /* tickle all the accumulators for the group we found */
-        dassert(numAccumulators == group.size());
-
-        for (size_t i = 0; i < numAccumulators; i++) {
-            group[i]->process(_accumulatedFields[i].expression->evaluate(rootDocument),
-                              _doingMerge);
-
-            _memoryUsageBytes += group[i]->memUsageForSorter();
-        }
+        const bool inserted = accumulateIntoGroups(
+            _groups.get_ptr(),
+            &_memoryUsageBytes,
+            id,
+            rootDocument,
+            _accumulatedFields,
+            pExpCtx,
+            _doingMerge,
+            [&](size_t i) { return _accumulatedFields[i].expression.get(); });
 
         if (kDebugBuild && !storageGlobalParams.readOnly) {
             // In debug mode, spill every time we have a duplicate id to stress merge logic.
@@ -625,6 +1022,10 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
         }
         case DocumentSource::GetNextResult::ReturnStatus::kEOF: {
             // Do any final steps necessary to prepare to output results.
+            if (!_partitions.empty()) {
+                finishPartitions();
+            }
+
             if (!_sortedFiles.empty()) {
                 _spilled = true;
                 if (!_groups->empty()) {
@@ -665,43 +1066,16 @@ bool DocumentSourceGroup::usedDisk() {
 
 shared_ptr<Sorter<Value, Value>::Iterator> DocumentSourceGroup::spill() {
     _usedDisk = true;
-    vector<const GroupsMap::value_type*> ptrs;  // using pointers to speed sorting
-    ptrs.reserve(_groups->size());
-    for (GroupsMap::const_iterator it = _groups->begin(), end = _groups->end(); it != end; ++it) {
-        ptrs.push_back(&*it);
+    SorterSpillStats spillStats;
+    auto iterator = spillGroups(_groups.get_ptr(),
+                                _accumulatedFields.size(),
+                                pExpCtx->getValueComparator(),
+                                pExpCtx->tempDir,
+                                &spillStats);
+    if (pExpCtx->opCtx) {
+        CurOp::get(pExpCtx->opCtx)->debug().addSortSpill(spillStats);
     }
-
-    stable_sort(ptrs.begin(), ptrs.end(), SpillSTLComparator(pExpCtx->getValueComparator()));
-
-    SortedFileWriter<Value, Value> writer(SortOptions().TempDir(pExpCtx->tempDir));
-    switch (_accumulatedFields.size()) {  // same as ptrs[i]->second.size() for all i.
-        case 0:                           // no values, essentially a distinct
-            for (size_t i = 0; i < ptrs.size(); i++) {
-                writer.addAlreadySorted(ptrs[i]->first, Value());
-            }
-            break;
-
-        case 1:  // just one value, use optimized serialization as single Value
-            for (size_t i = 0; i < ptrs.size(); i++) {
-                writer.addAlreadySorted(ptrs[i]->first,
-                                        ptrs[i]->second[0]->getValue(/*toBeMerged=*/true));
-            }
-            break;
-
-        default:  // multiple values, serialize as array-typed Value
-            for (size_t i = 0; i < ptrs.size(); i++) {
-                vector<Value> accums;
-                for (size_t j = 0; j < ptrs[i]->second.size(); j++) {
-                    accums.push_back(ptrs[i]->second[j]->getValue(/*toBeMerged=*/true));
-                }
-                writer.addAlreadySorted(ptrs[i]->first, Value(std::move(accums)));
-            }
-            break;
-    }
-
-    _groups->clear();
-
-    return shared_ptr<Sorter<Value, Value>::Iterator>(writer.done());
+    return iterator;
 }
 
 boost::optional<BSONObj> DocumentSourceGroup::findRelevantInputSort() const {
@@ -996,14 +1370,21 @@ DocumentSourceGroup::rewriteGroupAsTransformOnFirstDocument() const {
 
     const auto groupId = fieldPath.tail().fullPath();
 
-    // We can't do this transformation if there are any non-$first accumulators.
+    // We can't do this transformation unless the accumulators are either all $first or all $last.
+    boost::optional<AccumulatorDocumentsNeeded> documentsNeeded;
     for (auto&& accumulator : _accumulatedFields) {
-        if (AccumulatorDocumentsNeeded::kFirstDocument !=
-            accumulator.makeAccumulator(pExpCtx)->documentsNeeded()) {
+        const auto needed = accumulator.makeAccumulator(pExpCtx)->documentsNeeded();
+        if (needed == AccumulatorDocumentsNeeded::kAllDocuments ||
+            (documentsNeeded && *documentsNeeded != needed)) {
             return nullptr;
         }
+        documentsNeeded = needed;
     }
 
+    const auto expectedInput = documentsNeeded == AccumulatorDocumentsNeeded::kLastDocument
+        ? GroupFromFirstDocumentTransformation::ExpectedInput::kLastDocument
+        : GroupFromFirstDocumentTransformation::ExpectedInput::kFirstDocument;
+
     std::vector<std::pair<std::string, boost::intrusive_ptr<Expression>>> fields;
     fields.push_back(std::make_pair("_id", ExpressionFieldPath::create(pExpCtx, groupId)));
 
@@ -1011,7 +1392,8 @@ DocumentSourceGroup::rewriteGroupAsTransformOnFirstDocument() const {
         fields.push_back(std::make_pair(accumulator.fieldName, accumulator.expression));
     }
 
-    return GroupFromFirstDocumentTransformation::create(pExpCtx, groupId, std::move(fields));
+    return GroupFromFirstDocumentTransformation::create(
+        pExpCtx, groupId, std::move(fields), expectedInput);
 }
 }  // namespace mongo
 
@@ -30,6 +30,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "mongo/db/pipeline/accumulation_statement.h"
 #include "mongo/db/pipeline/accumulator.h"
@@ -43,14 +44,30 @@ namespace mongo {
  * GroupFromFirstTransformation consists of a list of (field name, expression pairs). It returns a
  * document synthesized by assigning each field name in the output document to the result of
  * evaluating the corresponding expression. If the expression evaluates to missing, we assign a
- * value of BSONNULL. This is necessary to match the semantics of $first for missing fields.
+ * value of BSONNULL. This is necessary to match the semantics of $first and $last for missing
+ * fields.
  */
 class GroupFromFirstDocumentTransformation final : public TransformerInterface {
 public:
+    /**
+     * Which document of each group, in the order the $group stage would have seen them, the
+     * transformation must be applied to.
+     */
+    enum class ExpectedInput {
+        // The group consisted of $first accumulators.
+        kFirstDocument,
+        // The group consisted of $last accumulators. The caller must supply each group's documents
+        // in the reverse order, so that the last one arrives first.
+        kLastDocument,
+    };
+
     GroupFromFirstDocumentTransformation(
         const std::string& groupId,
-        std::vector<std::pair<std::string, boost::intrusive_ptr<Expression>>> accumulatorExprs)
-        : _accumulatorExprs(std::move(accumulatorExprs)), _groupId(groupId) {}
+        std::vector<std::pair<std::string, boost::intrusive_ptr<Expression>>> accumulatorExprs,
+        ExpectedInput expectedInput = ExpectedInput::kFirstDocument)
+        : _accumulatorExprs(std::move(accumulatorExprs)),
+          _groupId(groupId),
+          _expectedInput(expectedInput) {}
 
     TransformerType getType() const final {
         return TransformerType::kGroupFromFirstDocument;
@@ -64,6 +81,10 @@ public:
         return _groupId;
     }
 
+    ExpectedInput expectedInput() const {
+        return _expectedInput;
+    }
+
     Document applyTransformation(const Document& input) final;
 
     void optimize() final;
@@ -78,11 +99,13 @@ public:
     static std::unique_ptr<GroupFromFirstDocumentTransformation> create(
         const boost::intrusive_ptr<ExpressionContext>& expCtx,
         const std::string& groupId,
-        std::vector<std::pair<std::string, boost::intrusive_ptr<Expression>>> accumulatorExprs);
+        std::vector<std::pair<std::string, boost::intrusive_ptr<Expression>>> accumulatorExprs,
+        ExpectedInput expectedInput = ExpectedInput::kFirstDocument);
 
 private:
     std::vector<std::pair<std::string, boost::intrusive_ptr<Expression>>> _accumulatorExprs;
     std::string _groupId;
+    ExpectedInput _expectedInput;
 };
 
 class DocumentSourceGroup final : public DocumentSource, public NeedsMergerDocumentSource {
@@ -92,6 +115,8 @@ public:
 
     static constexpr StringData kStageName = "$group"_sd;
 
+    ~DocumentSourceGroup();
+
     boost::intrusive_ptr<DocumentSource> optimize() final;
     DepsTracker::State getDependencies(DepsTracker* deps) const final;
     Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
@@ -169,7 +194,9 @@ public:
     /**
      * When possible, creates a document transformer that transforms the first document in a group
      * into one of the output documents of the $group stage. This is possible when we are grouping
-     * on a single field and all accumulators are $first (or there are no accumluators).
+     * on a single field and all accumulators are $first (or there are no accumluators). When all
+     * accumulators are instead $last, the transformation applies to the last document of each
+     * group, as reported by its expectedInput().
      *
      * It is sometimes possible to use a DISTINCT_SCAN to scan the first document of each group,
      * in which case this transformation can replace the actual $group stage in the pipeline
@@ -182,6 +209,8 @@ protected:
     void doDispose() final;
 
 private:
+    class Partition;
+
     explicit DocumentSourceGroup(const boost::intrusive_ptr<ExpressionContext>& pExpCtx,
                                  boost::optional<size_t> maxMemoryUsageBytes = boost::none);
 
@@ -219,6 +248,25 @@ private:
      */
     std::shared_ptr<Sorter<Value, Value>::Iterator> spill();
 
+    /**
+     * Returns true if the rest of the input to an unsorted $group should be grouped in parallel by
+     * '_partitions'.
+     */
+    bool shouldStartPartitions() const;
+
+    /**
+     * Starts the threads of '_partitions', handing each of them the groups in '_groups' which hash
+     * to its partition.
+     */
+    void startPartitions();
+
+    /**
+     * Waits for '_partitions' to group all the input handed to them, and collects their groups
+     * into '_pendingGroups', or their spilled groups into '_sortedFiles' if any of the groups had
+     * to be spilled.
+     */
+    void finishPartitions();
+
     Document makeDocument(const Value& id, const Accumulators& accums, bool mergeableOutput);
 
     /**
@@ -261,6 +309,17 @@ private:
     std::vector<std::shared_ptr<Sorter<Value, Value>::Iterator>> _sortedFiles;
     bool _spilled;
 
+    // The number of input documents grouped by this thread so far.
+    long long _numInputDocsGrouped = 0;
+
+    // Non-empty while the input of an unsorted $group is being grouped in parallel. The groups in
+    // different partitions are disjoint.
+    std::vector<std::unique_ptr<Partition>> _partitions;
+
+    // The groups of the partitions that have not been returned yet, once parallel grouping has
+    // finished without spilling. Their contents are moved to '_groups' one by one.
+    std::vector<GroupsMap> _pendingGroups;
+
     // Only used when '_spilled' is false.
     GroupsMap::iterator groupsIterator;
 
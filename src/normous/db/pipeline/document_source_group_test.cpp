@@ -47,12 +47,14 @@
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
 #include "mongo/db/pipeline/value_comparator.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_test_service_context.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/stdx/unordered_set.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -189,6 +191,95 @@ TEST_F(DocumentSourceGroupTest, ShouldCorrectlyTrackMemoryUsageBetweenPauses) {
     ASSERT_THROWS_CODE(group->getNext(), AssertionException, 16945);
 }
 
+/**
+ * Groups 'numDocs' documents {k: i % numGroups, v: i} by 'k' with 'group', computing the sum of 'v'
+ * and the number of documents of each group, and checks the results.
+ */
+void assertGroupsSumsCorrectly(const intrusive_ptr<DocumentSource>& group,
+                               int numDocs,
+                               int numGroups) {
+    deque<DocumentSource::GetNextResult> inputs;
+    for (int i = 0; i < numDocs; ++i) {
+        inputs.emplace_back(Document{{"k", i % numGroups}, {"v", i}});
+        if (i == numDocs / 2) {
+            inputs.emplace_back(DocumentSource::GetNextResult::makePauseExecution());
+        }
+    }
+    auto mock = DocumentSourceMock::create(std::move(inputs));
+    group->setSource(mock.get());
+
+    ASSERT_TRUE(group->getNext().isPaused());
+
+    map<int, std::pair<long long, long long>> results;
+    for (auto result = group->getNext(); result.isAdvanced(); result = group->getNext()) {
+        auto doc = result.releaseDocument();
+        ASSERT_TRUE(results
+                        .emplace(doc["_id"].coerceToInt(),
+                                 std::make_pair(doc["total"].coerceToLong(),
+                                                doc["count"].coerceToLong()))
+                        .second);
+    }
+    ASSERT_TRUE(group->getNext().isEOF());
+
+    ASSERT_EQ(results.size(), size_t(numGroups));
+    for (int k = 0; k < numGroups; ++k) {
+        long long total = 0;
+        long long count = 0;
+        for (int i = k; i < numDocs; i += numGroups) {
+            total += i;
+            ++count;
+        }
+        ASSERT_EQ(results[k].first, total);
+        ASSERT_EQ(results[k].second, count);
+    }
+}
+
+TEST_F(DocumentSourceGroupTest, ParallelGroupReturnsSameGroupsAsSerialGroup) {
+    const auto oldParallelism = internalDocumentSourceGroupParallelism.load();
+    const auto oldMinInputDocs = internalDocumentSourceGroupParallelMinInputDocs.load();
+    ON_BLOCK_EXIT([&] {
+        internalDocumentSourceGroupParallelism.store(oldParallelism);
+        internalDocumentSourceGroupParallelMinInputDocs.store(oldMinInputDocs);
+    });
+    internalDocumentSourceGroupParallelism.store(4);
+    internalDocumentSourceGroupParallelMinInputDocs.store(100);
+
+    auto spec = fromjson("{$group: {_id: '$k', total: {$sum: '$v'}, count: {$sum: 1}}}");
+    auto group = DocumentSourceGroup::createFromBson(spec.firstElement(), getExpCtx());
+    assertGroupsSumsCorrectly(group, 10000, 97);
+}
+
+TEST_F(DocumentSourceGroupTest, ParallelGroupSpillsEachPartitionAndMergesThem) {
+    const auto oldParallelism = internalDocumentSourceGroupParallelism.load();
+    const auto oldMinInputDocs = internalDocumentSourceGroupParallelMinInputDocs.load();
+    ON_BLOCK_EXIT([&] {
+        internalDocumentSourceGroupParallelism.store(oldParallelism);
+        internalDocumentSourceGroupParallelMinInputDocs.store(oldMinInputDocs);
+    });
+    internalDocumentSourceGroupParallelism.store(3);
+    internalDocumentSourceGroupParallelMinInputDocs.store(0);
+
+    auto expCtx = getExpCtx();
+    TempDir tempDir("DocumentSourceGroupTest");
+    expCtx->tempDir = tempDir.path();
+    expCtx->allowDiskUse = true;
+
+    VariablesParseState vps = expCtx->variablesParseState;
+    AccumulationStatement totalStatement{"total",
+                                         ExpressionFieldPath::parse(expCtx, "$v", vps),
+                                         AccumulationStatement::getFactory("$sum")};
+    AccumulationStatement countStatement{
+        "count",
+        ExpressionConstant::create(expCtx, Value(1)),
+        AccumulationStatement::getFactory("$sum")};
+    auto group = DocumentSourceGroup::create(expCtx,
+                                             ExpressionFieldPath::parse(expCtx, "$k", vps),
+                                             {totalStatement, countStatement},
+                                             3000);
+    assertGroupsSumsCorrectly(group, 10000, 500);
+    ASSERT_TRUE(group->usedDisk());
+}
+
 TEST_F(DocumentSourceGroupTest, ShouldReportSingleFieldGroupKeyAsARename) {
     auto expCtx = getExpCtx();
     VariablesParseState vps = expCtx->variablesParseState;
@@ -227,6 +318,42 @@ TEST_F(DocumentSourceGroupTest, ShouldNotReportDottedGroupKeyAsARename) {
     ASSERT_EQ(modifiedPathsRet.renames.size(), 0UL);
 }
 
+std::unique_ptr<GroupFromFirstDocumentTransformation> rewriteGroup(
+    const intrusive_ptr<ExpressionContext>& expCtx, const BSONObj& spec) {
+    auto source = DocumentSourceGroup::createFromBson(spec.firstElement(), expCtx);
+    auto group = dynamic_cast<DocumentSourceGroup*>(source.get());
+    ASSERT(group);
+    return group->rewriteGroupAsTransformOnFirstDocument();
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldRewriteGroupOfFirstAccumulators) {
+    auto rewritten =
+        rewriteGroup(getExpCtx(), fromjson("{$group: {_id: '$a', x: {$first: '$b'}}}"));
+    ASSERT(rewritten);
+    ASSERT_EQ(rewritten->groupId(), "a");
+    ASSERT(rewritten->expectedInput() ==
+           GroupFromFirstDocumentTransformation::ExpectedInput::kFirstDocument);
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldRewriteGroupOfLastAccumulatorsToReadLastDocument) {
+    auto rewritten = rewriteGroup(
+        getExpCtx(), fromjson("{$group: {_id: '$a', x: {$last: '$b'}, y: {$last: '$c'}}}"));
+    ASSERT(rewritten);
+    ASSERT_EQ(rewritten->groupId(), "a");
+    ASSERT(rewritten->expectedInput() ==
+           GroupFromFirstDocumentTransformation::ExpectedInput::kLastDocument);
+
+    ASSERT_DOCUMENT_EQ(rewritten->applyTransformation(Document{{"a", 1}, {"b", 2}}),
+                       (Document{{"_id", 1}, {"x", 2}, {"y", BSONNULL}}));
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldNotRewriteGroupMixingFirstAndLastAccumulators) {
+    ASSERT_FALSE(rewriteGroup(
+        getExpCtx(), fromjson("{$group: {_id: '$a', x: {$first: '$b'}, y: {$last: '$c'}}}")));
+    ASSERT_FALSE(rewriteGroup(
+        getExpCtx(), fromjson("{$group: {_id: '$a', x: {$last: '$b'}, n: {$sum: 1}}}")));
+}
+
 BSONObj toBson(const intrusive_ptr<DocumentSource>& source) {
     vector<Value> arr;
     source->serializeToArray(arr);
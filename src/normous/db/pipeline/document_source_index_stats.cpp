@@ -62,6 +62,9 @@ DocumentSource::GetNextResult DocumentSourceIndexStats::getNext() {
         doc["host"] = Value(_processName);
         doc["accesses"]["ops"] = Value(stats.accesses.loadRelaxed());
         doc["accesses"]["since"] = Value(stats.trackerStartTime);
+        if (!stats.keyStatistics.isEmpty()) {
+            doc["keyStatistics"] = Value(stats.keyStatistics);
+        }
         ++_indexStatsIter;
         return doc.freeze();
     }
@@ -0,0 +1,291 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document_source_internal_unpack_bucket.h"
+
+#include <cmath>
+
+#include "mongo/base/parse_number.h"
+#include "mongo/db/pipeline/document.h"
+#include "mongo/db/pipeline/document_source_match.h"
+#include "mongo/db/pipeline/lite_parsed_document_source.h"
+#include "mongo/db/timeseries/bucket_catalog.h"
+#include "mongo/db/timeseries/bucket_compression.h"
+#include "mongo/db/timeseries/timeseries_constants.h"
+
+namespace mongo {
+
+REGISTER_DOCUMENT_SOURCE(_internalUnpackBucket,
+                         LiteParsedDocumentSourceDefault::parse,
+                         DocumentSourceInternalUnpackBucket::createFromBson);
+
+constexpr StringData DocumentSourceInternalUnpackBucket::kStageName;
+
+namespace {
+
+/**
+ * Returns true if comparisons of a field to 'operand' can be bounded by the minimum and maximum of
+ * the field.
+ */
+bool isBoundableOperand(const BSONElement& operand, bool hasCollator) {
+    switch (operand.type()) {
+        case NumberInt:
+        case NumberLong:
+        case Date:
+        case bsonTimestamp:
+        case jstOID:
+        case Bool:
+            return true;
+        case NumberDouble:
+        case NumberDecimal:
+            return !std::isnan(operand.numberDouble());
+        case String:
+            // The bucket summaries are ordered by simple binary comparison.
+            return !hasCollator;
+        default:
+            return false;
+    }
+}
+
+}  // namespace
+
+boost::intrusive_ptr<DocumentSource> DocumentSourceInternalUnpackBucket::createFromBson(
+    BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+    uassert(ErrorCodes::TypeMismatch,
+            str::stream() << kStageName << " must take a nested object but found: " << elem,
+            elem.type() == BSONType::Object);
+
+    auto options = uassertStatusOK(timeseries::TimeseriesOptions::parse(elem.embeddedObject()));
+    return new DocumentSourceInternalUnpackBucket(expCtx, std::move(options));
+}
+
+DocumentSourceInternalUnpackBucket::DocumentSourceInternalUnpackBucket(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx, timeseries::TimeseriesOptions options)
+    : DocumentSource(expCtx), _options(std::move(options)) {}
+
+DocumentSource::GetNextResult DocumentSourceInternalUnpackBucket::getNext() {
+    pExpCtx->checkForInterrupt();
+
+    while (true) {
+        while (_nextSample < _numSamples) {
+            const size_t sampleIndex = _nextSample++;
+            MutableDocument sample;
+            bool hasFields = false;
+            for (auto&& column : _columns) {
+                if (sampleIndex < column.values.size() && column.values[sampleIndex].ok()) {
+                    sample.addField(column.fieldName, Value(column.values[sampleIndex]));
+                    hasFields = true;
+                }
+            }
+            // An index may be missing from every column if its write to the bucket failed.
+            if (!hasFields) {
+                continue;
+            }
+            if (_meta.ok()) {
+                sample.addField(_options.metaField, Value(_meta));
+            }
+            return sample.freeze();
+        }
+
+        auto nextBucket = pSource->getNext();
+        if (!nextBucket.isAdvanced()) {
+            return nextBucket;
+        }
+        _setBucket(nextBucket.releaseDocument().toBson());
+    }
+}
+
+void DocumentSourceInternalUnpackBucket::_setBucket(BSONObj bucket) {
+    _bucket = timeseries::decompressBucket(bucket);
+    _meta = _options.metaField.empty() ? BSONElement() : _bucket[timeseries::kBucketMetaFieldName];
+    _columns.clear();
+    _numSamples = 0;
+    _nextSample = 0;
+
+    const BSONElement data = _bucket[timeseries::kBucketDataFieldName];
+    uassert(50979,
+            str::stream() << "time-series bucket " << _bucket["_id"] << " has no data object",
+            data.type() == Object);
+    for (auto&& columnElem : data.Obj()) {
+        uassert(50980,
+                str::stream() << "time-series bucket " << _bucket["_id"] << " has a column of type "
+                              << typeName(columnElem.type()),
+                columnElem.type() == Object);
+
+        // Values are added in index order, but a single write of several samples adds them in
+        // lexicographic order.
+        Column column{columnElem.fieldName(), {}};
+        for (auto&& valueElem : columnElem.Obj()) {
+            size_t index;
+            uassert(50981,
+                    str::stream() << "time-series bucket " << _bucket["_id"]
+                                  << " has an invalid sample index: "
+                                  << valueElem.fieldNameStringData(),
+                    parseNumberFromStringWithBase(valueElem.fieldNameStringData(), 10, &index)
+                            .isOK() &&
+                        index < static_cast<size_t>(timeseries::BucketCatalog::kMaxBucketCount));
+            if (index >= column.values.size()) {
+                column.values.resize(index + 1);
+            }
+            column.values[index] = valueElem;
+        }
+        _numSamples = std::max(_numSamples, column.values.size());
+        _columns.push_back(std::move(column));
+    }
+}
+
+Value DocumentSourceInternalUnpackBucket::serialize(
+    boost::optional<ExplainOptions::Verbosity> explain) const {
+    return Value(Document{{getSourceName(), Document(_options.toBSON())}});
+}
+
+Pipeline::SourceContainer::iterator DocumentSourceInternalUnpackBucket::doOptimizeAt(
+    Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
+    invariant(*itr == this);
+
+    if (_triedBucketLevelPredicates) {
+        return std::next(itr);
+    }
+    _triedBucketLevelPredicates = true;
+
+    // The $match on the samples stays in place, so the bucket-level $match may match too much, but
+    // never too little.
+    auto nextMatch = dynamic_cast<DocumentSourceMatch*>(std::next(itr)->get());
+    if (!nextMatch || nextMatch->isTextQuery()) {
+        return std::next(itr);
+    }
+    const BSONObj bucketPredicates = createPredicatesOnBucketLevelFields(nextMatch->getQuery());
+    if (bucketPredicates.isEmpty()) {
+        return std::next(itr);
+    }
+
+    container->insert(itr, DocumentSourceMatch::create(bucketPredicates, pExpCtx));
+
+    // Give the new $match a chance to be optimized too.
+    return std::prev(itr);
+}
+
+BSONObj DocumentSourceInternalUnpackBucket::createPredicatesOnBucketLevelFields(
+    const BSONObj& query) const {
+    BSONArrayBuilder predicates;
+    for (auto&& elem : query) {
+        _appendBucketLevelPredicates(elem, &predicates);
+    }
+    if (predicates.arrSize() == 0) {
+        return BSONObj();
+    }
+    return BSON("$and" << predicates.arr());
+}
+
+void DocumentSourceInternalUnpackBucket::_appendBucketLevelPredicates(
+    const BSONElement& elem, BSONArrayBuilder* predicates) const {
+    const auto fieldName = elem.fieldNameStringData();
+    if (fieldName == "$and") {
+        if (elem.type() == Array) {
+            for (auto&& conjunct : elem.Obj()) {
+                if (conjunct.type() == Object) {
+                    for (auto&& child : conjunct.Obj()) {
+                        _appendBucketLevelPredicates(child, predicates);
+                    }
+                }
+            }
+        }
+        return;
+    }
+    if (fieldName.startsWith("$")) {
+        return;
+    }
+
+    // Every sample of a bucket has the metadata of the bucket, so a predicate on the metadata
+    // field applies to the bucket as it is.
+    const StringData metaField = _options.metaField;
+    if (!metaField.empty() &&
+        (fieldName == metaField ||
+         (fieldName.startsWith(metaField) && fieldName[metaField.size()] == '.'))) {
+        BSONObjBuilder predicate(predicates->subobjStart());
+        predicate.appendAs(elem,
+                           timeseries::kBucketMetaFieldName.toString() +
+                               fieldName.substr(metaField.size()).toString());
+        return;
+    }
+
+    // The bucket summaries only cover top-level fields.
+    if (fieldName.find('.') != std::string::npos) {
+        return;
+    }
+
+    // A predicate like {a: {$gt: 1, $lt: 5}}, or the equality {a: 1}.
+    if (elem.type() == Object && StringData(elem.Obj().firstElementFieldName()).startsWith("$")) {
+        for (auto&& opElem : elem.Obj()) {
+            _appendComparisonPredicate(fieldName, opElem.fieldNameStringData(), opElem, predicates);
+        }
+    } else {
+        _appendComparisonPredicate(fieldName, "$eq"_sd, elem, predicates);
+    }
+}
+
+void DocumentSourceInternalUnpackBucket::_appendComparisonPredicate(
+    StringData fieldName,
+    StringData op,
+    const BSONElement& operand,
+    BSONArrayBuilder* predicates) const {
+    if (!isBoundableOperand(operand, pExpCtx->getCollator() != nullptr)) {
+        return;
+    }
+
+    const std::string controlPrefix = timeseries::kBucketControlFieldName + ".";
+    const std::string minPath =
+        controlPrefix + timeseries::kBucketControlMinFieldName + "." + fieldName;
+    const std::string maxPath =
+        controlPrefix + timeseries::kBucketControlMaxFieldName + "." + fieldName;
+
+    BSONObjBuilder bounds;
+    if (op == "$gt" || op == "$gte") {
+        bounds.append(maxPath, BSON(op << operand));
+    } else if (op == "$lt" || op == "$lte") {
+        bounds.append(minPath, BSON(op << operand));
+    } else if (op == "$eq") {
+        bounds.append(minPath, BSON("$lte" << operand));
+        bounds.append(maxPath, BSON("$gte" << operand));
+    } else {
+        return;
+    }
+
+    // The time of every sample is a date, so only other fields can have values that the summaries
+    // of a bucket don't bound.
+    if (fieldName == _options.timeField) {
+        predicates->append(bounds.obj());
+        return;
+    }
+    const std::string mixedPath = controlPrefix + timeseries::kBucketControlMixedFieldName;
+    predicates->append(BSON("$or" << BSON_ARRAY(bounds.obj() << BSON(mixedPath << fieldName))));
+}
+
+}  // namespace mongo
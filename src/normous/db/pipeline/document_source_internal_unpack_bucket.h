@@ -0,0 +1,131 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/timeseries/timeseries_options.h"
+
+namespace mongo {
+
+/**
+ * An internal stage which unpacks the bucket documents of a time-series collection into the
+ * samples they hold. It is the stage of the view through which a time-series collection is read.
+ *
+ * When followed by a $match, the stage adds before itself a $match on the bucket-level fields
+ * which skips the buckets that can't hold a matching sample: predicates on the metadata field apply
+ * to the 'meta' of the bucket, and comparisons of other top-level fields to the 'control.min' and
+ * 'control.max' summaries of the bucket.
+ */
+class DocumentSourceInternalUnpackBucket final : public DocumentSource {
+public:
+    static constexpr StringData kStageName = "$_internalUnpackBucket"_sd;
+
+    static boost::intrusive_ptr<DocumentSource> createFromBson(
+        BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& expCtx);
+
+    DocumentSourceInternalUnpackBucket(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                       timeseries::TimeseriesOptions options);
+
+    GetNextResult getNext() final;
+
+    const char* getSourceName() const final {
+        return kStageName.rawData();
+    }
+
+    Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
+
+    StageConstraints constraints(Pipeline::SplitState pipeState) const final {
+        return {StreamType::kStreaming,
+                PositionRequirement::kNone,
+                HostTypeRequirement::kNone,
+                DiskUseRequirement::kNoDiskUse,
+                FacetRequirement::kAllowed,
+                TransactionRequirement::kAllowed};
+    }
+
+    GetModPathsReturn getModifiedPaths() const final {
+        return {GetModPathsReturn::Type::kAllPaths, std::set<std::string>{}, {}};
+    }
+
+    DepsTracker::State getDependencies(DepsTracker* deps) const final {
+        deps->needWholeDocument = true;
+        return DepsTracker::State::EXHAUSTIVE_FIELDS;
+    }
+
+    /**
+     * Returns a predicate on the bucket-level fields which every bucket holding a sample matching
+     * 'query' matches, or an empty object if no such predicate can be derived.
+     */
+    BSONObj createPredicatesOnBucketLevelFields(const BSONObj& query) const;
+
+protected:
+    Pipeline::SourceContainer::iterator doOptimizeAt(Pipeline::SourceContainer::iterator itr,
+                                                     Pipeline::SourceContainer* container) final;
+
+private:
+    struct Column {
+        std::string fieldName;
+        std::vector<BSONElement> values;
+    };
+
+    /**
+     * Appends to 'predicates' the bucket-level predicates implied by the predicate 'elem' of a
+     * $match on the samples.
+     */
+    void _appendBucketLevelPredicates(const BSONElement& elem,
+                                      BSONArrayBuilder* predicates) const;
+
+    void _appendComparisonPredicate(StringData fieldName,
+                                    StringData op,
+                                    const BSONElement& operand,
+                                    BSONArrayBuilder* predicates) const;
+
+    /**
+     * Makes 'bucket' the bucket whose samples are returned next.
+     */
+    void _setBucket(BSONObj bucket);
+
+    const timeseries::TimeseriesOptions _options;
+
+    // Whether the bucket-level $match was already derived from the $match following this stage.
+    bool _triedBucketLevelPredicates = false;
+
+    // The bucket being unpacked, in its uncompressed layout, and the values of each of its columns
+    // by sample index.
+    BSONObj _bucket;
+    BSONElement _meta;
+    std::vector<Column> _columns;
+    size_t _numSamples = 0;
+    size_t _nextSample = 0;
+};
+
+}  // namespace mongo
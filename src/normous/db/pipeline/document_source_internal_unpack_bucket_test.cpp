@@ -0,0 +1,163 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document_source_internal_unpack_bucket.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/json.h"
+#include "mongo/db/pipeline/aggregation_context_fixture.h"
+#include "mongo/db/pipeline/document.h"
+#include "mongo/db/pipeline/document_source_match.h"
+#include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/document_value_test_util.h"
+#include "mongo/db/timeseries/bucket_compression.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using InternalUnpackBucketTest = AggregationContextFixture;
+
+boost::intrusive_ptr<DocumentSourceInternalUnpackBucket> makeUnpackStage(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+    auto spec = BSON("$_internalUnpackBucket" << BSON("timeField"
+                                                      << "time"
+                                                      << "metaField"
+                                                      << "sensor"));
+    auto stage = DocumentSourceInternalUnpackBucket::createFromBson(spec.firstElement(), expCtx);
+    return static_cast<DocumentSourceInternalUnpackBucket*>(stage.get());
+}
+
+TEST_F(InternalUnpackBucketTest, UnpacksSamplesOfEachBucket) {
+    auto unpack = makeUnpackStage(getExpCtx());
+    auto mock = DocumentSourceMock::create(
+        {Document(fromjson("{_id: 1, control: {version: 1, count: 2}, meta: 'a', data: "
+                           "{time: {'0': 1, '1': 2}, x: {'1': 10, '0': 5}}}")),
+         Document(fromjson("{_id: 2, control: {version: 1, count: 1}, data: {time: {'0': 3}}}"))});
+    unpack->setSource(mock.get());
+
+    auto next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(), Document(fromjson("{time: 1, x: 5, sensor: 'a'}")));
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       Document(fromjson("{time: 2, x: 10, sensor: 'a'}")));
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(), Document(fromjson("{time: 3}")));
+    ASSERT_TRUE(unpack->getNext().isEOF());
+}
+
+TEST_F(InternalUnpackBucketTest, UnpacksCompressedBuckets) {
+    BSONObjBuilder bucket;
+    bucket.append("_id", 1);
+    bucket.append("control", BSON("version" << 1 << "count" << 2));
+    bucket.append("data",
+                  BSON("time" << BSON("0" << Date_t::fromMillisSinceEpoch(1000) << "1"
+                                          << Date_t::fromMillisSinceEpoch(2000))
+                              << "x"
+                              << BSON("0" << 1.5 << "1" << 2.5)));
+    auto compressed = timeseries::compressBucket(bucket.obj());
+    ASSERT(compressed);
+
+    auto unpack = makeUnpackStage(getExpCtx());
+    auto mock = DocumentSourceMock::create({Document(*compressed)});
+    unpack->setSource(mock.get());
+
+    auto next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       Document(BSON("time" << Date_t::fromMillisSinceEpoch(1000) << "x" << 1.5)));
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       Document(BSON("time" << Date_t::fromMillisSinceEpoch(2000) << "x" << 2.5)));
+    ASSERT_TRUE(unpack->getNext().isEOF());
+}
+
+TEST_F(InternalUnpackBucketTest, SkipsSampleIndexesMissingFromEveryColumn) {
+    auto unpack = makeUnpackStage(getExpCtx());
+    auto mock = DocumentSourceMock::create(
+        {Document(fromjson("{_id: 1, control: {version: 1, count: 3}, data: "
+                           "{time: {'0': 1, '2': 3}}}"))});
+    unpack->setSource(mock.get());
+
+    ASSERT_DOCUMENT_EQ(unpack->getNext().releaseDocument(), Document(fromjson("{time: 1}")));
+    ASSERT_DOCUMENT_EQ(unpack->getNext().releaseDocument(), Document(fromjson("{time: 3}")));
+    ASSERT_TRUE(unpack->getNext().isEOF());
+}
+
+TEST_F(InternalUnpackBucketTest, BadSampleIndexFails) {
+    auto unpack = makeUnpackStage(getExpCtx());
+    auto mock = DocumentSourceMock::create(
+        {Document(fromjson("{_id: 1, control: {version: 1, count: 1}, data: {time: {a: 1}}}"))});
+    unpack->setSource(mock.get());
+    ASSERT_THROWS_CODE(unpack->getNext(), AssertionException, 50981);
+}
+
+TEST_F(InternalUnpackBucketTest, CreatesPredicatesOnMetaAndSummaries) {
+    auto unpack = makeUnpackStage(getExpCtx());
+    ASSERT_BSONOBJ_EQ(
+        unpack->createPredicatesOnBucketLevelFields(
+            fromjson("{'sensor.id': 5, time: {$gte: 10}, x: {$lt: 3}, y: 4}")),
+        fromjson("{$and: [{'meta.id': 5}, {'control.max.time': {$gte: 10}}, "
+                 "{$or: [{'control.min.x': {$lt: 3}}, {'control.mixed': 'x'}]}, "
+                 "{$or: [{'control.min.y': {$lte: 4}, 'control.max.y': {$gte: 4}}, "
+                 "{'control.mixed': 'y'}]}]}"));
+}
+
+TEST_F(InternalUnpackBucketTest, DoesNotCreatePredicatesItCannotBound) {
+    auto unpack = makeUnpackStage(getExpCtx());
+    ASSERT_BSONOBJ_EQ(unpack->createPredicatesOnBucketLevelFields(
+                          fromjson("{'a.b': 1, c: {$ne: 1}, d: {$in: [1, 2]}, e: [1], "
+                                   "$or: [{f: 1}, {g: 1}]}")),
+                      BSONObj());
+}
+
+TEST_F(InternalUnpackBucketTest, AddsBucketLevelMatchBeforeItself) {
+    auto unpack = makeUnpackStage(getExpCtx());
+    auto match = DocumentSourceMatch::create(fromjson("{sensor: 'a'}"), getExpCtx());
+    Pipeline::SourceContainer container{unpack, match};
+
+    unpack->optimizeAt(container.begin(), &container);
+    ASSERT_EQ(container.size(), 3U);
+    auto bucketMatch = dynamic_cast<DocumentSourceMatch*>(container.front().get());
+    ASSERT(bucketMatch);
+    ASSERT_BSONOBJ_EQ(bucketMatch->getQuery(), fromjson("{$and: [{meta: 'a'}]}"));
+
+    // The stage only adds a bucket-level $match once.
+    auto itr = std::next(container.begin());
+    unpack->optimizeAt(itr, &container);
+    ASSERT_EQ(container.size(), 3U);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,128 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/db/pipeline/aggregation_context_fixture.h"
+#include "mongo/db/pipeline/document_source_lock_contention.h"
+#include "mongo/db/pipeline/document_value_test_util.h"
+#include "mongo/db/pipeline/stub_mongo_process_interface.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+class DocumentSourceLockContentionTest : public AggregationContextFixture {
+public:
+    DocumentSourceLockContentionTest()
+        : AggregationContextFixture(
+              NamespaceString::makeCollectionlessAggregateNSS(NamespaceString::kAdminDb)) {}
+};
+
+/**
+ * A MongoProcessInterface used for testing which returns an artificial lock contention sample.
+ */
+class LockContentionMongoProcessInterface final : public StubMongoProcessInterface {
+public:
+    LockContentionMongoProcessInterface(std::vector<BSONObj> sample)
+        : _sample(std::move(sample)) {}
+
+    std::vector<BSONObj> getLockContentionSample(OperationContext* opCtx) const override {
+        return _sample;
+    }
+
+private:
+    std::vector<BSONObj> _sample;
+};
+
+TEST_F(DocumentSourceLockContentionTest, ShouldFailToParseIfSpecIsNotObject) {
+    const auto specObj = fromjson("{$lockContention: 1}");
+    ASSERT_THROWS_CODE(
+        DocumentSourceLockContention::createFromBson(specObj.firstElement(), getExpCtx()),
+        AssertionException,
+        ErrorCodes::FailedToParse);
+}
+
+TEST_F(DocumentSourceLockContentionTest, ShouldFailToParseIfSpecIsANonEmptyObject) {
+    const auto specObj = fromjson("{$lockContention: {unknownOption: 1}}");
+    ASSERT_THROWS_CODE(
+        DocumentSourceLockContention::createFromBson(specObj.firstElement(), getExpCtx()),
+        AssertionException,
+        ErrorCodes::FailedToParse);
+}
+
+TEST_F(DocumentSourceLockContentionTest, ShouldFailToParseIfNotRunOnAdmin) {
+    getExpCtx()->ns = NamespaceString::makeCollectionlessAggregateNSS("test");
+    const auto specObj = fromjson("{$lockContention: {}}");
+    ASSERT_THROWS_CODE(
+        DocumentSourceLockContention::createFromBson(specObj.firstElement(), getExpCtx()),
+        AssertionException,
+        ErrorCodes::InvalidNamespace);
+}
+
+TEST_F(DocumentSourceLockContentionTest, CannotCreateWhenInMongos) {
+    const auto specObj = fromjson("{$lockContention: {}}");
+    getExpCtx()->inMongos = true;
+    ASSERT_THROWS_CODE(
+        DocumentSourceLockContention::createFromBson(specObj.firstElement(), getExpCtx()),
+        AssertionException,
+        50973);
+}
+
+TEST_F(DocumentSourceLockContentionTest, CanParseAndSerializeSuccessfully) {
+    const auto specObj = fromjson("{$lockContention: {}}");
+    auto stage = DocumentSourceLockContention::createFromBson(specObj.firstElement(), getExpCtx());
+    std::vector<Value> serialized;
+    stage->serializeToArray(serialized);
+    ASSERT_EQ(1u, serialized.size());
+    ASSERT_BSONOBJ_EQ(specObj, serialized[0].getDocument().toBson());
+}
+
+TEST_F(DocumentSourceLockContentionTest, ReturnsSampleFromProcessInterface) {
+    std::vector<BSONObj> sample{fromjson("{resourceId: 'a', numWaiting: 2}"),
+                                fromjson("{resourceId: 'b', numWaiting: 1}")};
+    getExpCtx()->mongoProcessInterface =
+        std::make_shared<LockContentionMongoProcessInterface>(sample);
+
+    const auto specObj = fromjson("{$lockContention: {}}");
+    auto stage = DocumentSourceLockContention::createFromBson(specObj.firstElement(), getExpCtx());
+
+    auto next = stage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(Document(sample[0]), next.releaseDocument());
+
+    next = stage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(Document(sample[1]), next.releaseDocument());
+
+    ASSERT_TRUE(stage->getNext().isEOF());
+}
+
+}  // namespace
+}  // namespace mongo
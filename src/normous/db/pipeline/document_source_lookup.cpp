@@ -30,6 +30,8 @@
 
 #include "mongo/db/pipeline/document_source_lookup.h"
 
+#include <algorithm>
+
 #include "mongo/base/init.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression_algo.h"
@@ -40,6 +42,7 @@
 #include "mongo/db/pipeline/value.h"
 #include "mongo/db/query/query_knobs.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/util/stringutils.h"
 
 namespace mongo {
 
@@ -247,6 +250,12 @@ DocumentSource::GetNextResult DocumentSourceLookUp::getNext() {
     invariant(!_matchSrc);
 
     if (!wasConstructedWithPipelineSyntax()) {
+        if (auto results = lookUpInHashJoinTable(inputDoc)) {
+            MutableDocument output(std::move(inputDoc));
+            output.setNestedField(_as, Value(std::move(*results)));
+            return output.freeze();
+        }
+
         auto matchStage =
             makeMatchStageFromInput(inputDoc, *_localField, _foreignField->fullPath(), BSONObj());
         // We've already allocated space for the trailing $match stage in '_resolvedPipeline'.
@@ -277,6 +286,131 @@ DocumentSource::GetNextResult DocumentSourceLookUp::getNext() {
     return output.freeze();
 }
 
+boost::optional<std::vector<Value>> DocumentSourceLookUp::lookUpInHashJoinTable(
+    const Document& inputDoc) {
+    invariant(!wasConstructedWithPipelineSyntax() && !_unwindSrc);
+
+    if (_hashJoinState == HashJoinState::kNotBuilt) {
+        if (_numLookupsByQuery < internalDocumentSourceLookupHashJoinMinInputDocs.load()) {
+            ++_numLookupsByQuery;
+            return boost::none;
+        }
+        buildHashJoinTable();
+    }
+    if (_hashJoinState != HashJoinState::kBuilt) {
+        return boost::none;
+    }
+
+    // A null or missing local value also matches foreign documents which have no value at
+    // 'foreignField', and an array local value also matches foreign arrays as a whole. Neither is
+    // indexed by the hash table, so such input documents are still looked up by a query.
+    std::vector<Value> localValues;
+    bool canProbe = true;
+    document_path_support::visitAllValuesAtPath(
+        inputDoc, *_localField, [&](const Value& nextValue) {
+            if (nextValue.nullish() || nextValue.isArray()) {
+                canProbe = false;
+            } else {
+                localValues.push_back(nextValue);
+            }
+        });
+    if (!canProbe || localValues.empty()) {
+        return boost::none;
+    }
+
+    std::vector<size_t> matches;
+    for (auto&& localValue : localValues) {
+        auto it = _hashJoinTable->find(localValue);
+        if (it != _hashJoinTable->end()) {
+            matches.insert(matches.end(), it->second.begin(), it->second.end());
+        }
+    }
+    if (localValues.size() > 1) {
+        // A foreign document matching several of the local values is only returned once.
+        std::sort(matches.begin(), matches.end());
+        matches.erase(std::unique(matches.begin(), matches.end()), matches.end());
+    }
+
+    std::vector<Value> results;
+    results.reserve(matches.size());
+    int objsize = 0;
+    for (auto&& match : matches) {
+        objsize += _hashJoinDocs[match].getApproximateSize();
+        uassert(4568,
+                str::stream() << "Total size of documents in " << _fromNs.coll()
+                              << " matching pipeline "
+                              << makeMatchStageFromInput(inputDoc,
+                                                         *_localField,
+                                                         _foreignField->fullPath(),
+                                                         BSONObj())
+                                     .toString()
+                              << " exceeds maximum document size",
+                objsize <= BSONObjMaxInternalSize);
+        results.emplace_back(_hashJoinDocs[match]);
+    }
+    return results;
+}
+
+void DocumentSourceLookUp::buildHashJoinTable() {
+    invariant(_hashJoinState == HashJoinState::kNotBuilt);
+
+    // Numeric path components may also name array positions, which the values visited below would
+    // not account for.
+    for (size_t i = 0; i < _foreignField->getPathLength(); ++i) {
+        if (parseUnsignedBase10Integer(_foreignField->getFieldName(i))) {
+            abandonHashJoin();
+            return;
+        }
+    }
+
+    const long long maxMemoryBytes = internalDocumentSourceLookupHashJoinMaxMemoryBytes.load();
+    if (maxMemoryBytes == 0) {
+        abandonHashJoin();
+        return;
+    }
+
+    // Rough cost of a hash table entry beyond the Value used as its key.
+    const long long kPerEntryOverheadBytes = 64;
+
+    // The foreign pipeline is the resolved view pipeline, if any, without the trailing $match
+    // placeholder which is otherwise filled in for each input document.
+    std::vector<BSONObj> foreignPipeline(_resolvedPipeline.begin(), _resolvedPipeline.end() - 1);
+    auto pipeline = uassertStatusOK(
+        pExpCtx->mongoProcessInterface->makePipeline(foreignPipeline, _fromExpCtx));
+
+    _hashJoinTable.emplace(
+        _fromExpCtx->getValueComparator().makeUnorderedValueMap<std::vector<size_t>>());
+    long long memoryBytes = 0;
+    while (auto foreignDoc = pipeline->getNext()) {
+        pExpCtx->checkForInterrupt();
+
+        const size_t position = _hashJoinDocs.size();
+        memoryBytes += foreignDoc->getApproximateSize();
+        document_path_support::visitAllValuesAtPath(
+            *foreignDoc, *_foreignField, [&](const Value& nextValue) {
+                auto& positions = (*_hashJoinTable)[nextValue];
+                if (positions.empty() || positions.back() != position) {
+                    positions.push_back(position);
+                    memoryBytes += kPerEntryOverheadBytes;
+                }
+            });
+        if (memoryBytes > maxMemoryBytes) {
+            abandonHashJoin();
+            return;
+        }
+        _hashJoinDocs.push_back(std::move(*foreignDoc));
+    }
+
+    _usedDisk = _usedDisk || pipeline->usedDisk();
+    _hashJoinState = HashJoinState::kBuilt;
+}
+
+void DocumentSourceLookUp::abandonHashJoin() {
+    _hashJoinState = HashJoinState::kAbandoned;
+    _hashJoinTable = boost::none;
+    std::vector<Document>().swap(_hashJoinDocs);
+}
+
 std::unique_ptr<Pipeline, PipelineDeleter> DocumentSourceLookUp::buildPipeline(
     const Document& inputDoc) {
     // Copy all 'let' variables into the foreign pipeline's expression context.
@@ -463,6 +597,10 @@ bool DocumentSourceLookUp::usedDisk() {
 }
 
 void DocumentSourceLookUp::doDispose() {
+    if (_hashJoinState == HashJoinState::kBuilt) {
+        // The table holds the results for the remaining input, of which there is none.
+        abandonHashJoin();
+    }
     if (_pipeline) {
         _usedDisk = _usedDisk || _pipeline->usedDisk();
         _pipeline->dispose(pExpCtx->opCtx);
@@ -238,6 +238,23 @@ private:
 
     GetNextResult unwindResult();
 
+    /**
+     * Returns the foreign documents matching 'inputDoc' from the hash join table, building the
+     * table first once enough input documents have been looked up by querying the foreign
+     * collection. Returns boost::none if the table is not available, or if 'inputDoc' must be
+     * looked up by a query because the hash table cannot reproduce the query's semantics for its
+     * local values.
+     */
+    boost::optional<std::vector<Value>> lookUpInHashJoinTable(const Document& inputDoc);
+
+    /**
+     * Reads the foreign collection into '_hashJoinDocs' and indexes it by '_foreignField' in
+     * '_hashJoinTable'. Abandons the hash join if the table exceeds its memory budget.
+     */
+    void buildHashJoinTable();
+
+    void abandonHashJoin();
+
     /**
      * Copies 'vars' and 'vps' to the Variables and VariablesParseState objects in 'expCtx'. These
      * copies provide access to 'let' defined variables in sub-pipeline execution.
@@ -320,6 +337,17 @@ private:
     boost::intrusive_ptr<DocumentSourceMatch> _matchSrc;
     boost::intrusive_ptr<DocumentSourceUnwind> _unwindSrc;
 
+    // A localField/foreignField $lookup which does not absorb an $unwind first queries the foreign
+    // collection once per input document. After internalDocumentSourceLookupHashJoinMinInputDocs
+    // such queries it switches to a hash join: every foreign document is kept in '_hashJoinDocs',
+    // and '_hashJoinTable' maps each value at '_foreignField' to the positions of the documents
+    // holding it, in the order they were read.
+    enum class HashJoinState { kNotBuilt, kBuilt, kAbandoned };
+    HashJoinState _hashJoinState = HashJoinState::kNotBuilt;
+    long long _numLookupsByQuery = 0;
+    std::vector<Document> _hashJoinDocs;
+    boost::optional<ValueUnorderedMap<std::vector<size_t>>> _hashJoinTable;
+
     // The following members are used to hold onto state across getNext() calls when '_unwindSrc' is
     // not null.
     long long _cursorIndex = 0;
@@ -31,6 +31,7 @@
 #include "mongo/db/pipeline/document_source_lookup_change_post_image.h"
 
 #include "mongo/bson/simple_bsonelement_comparator.h"
+#include "mongo/db/query/query_knobs.h"
 
 namespace mongo {
 
@@ -53,12 +54,32 @@ Value assertFieldHasType(const Document& fullDoc, StringData fieldName, BSONType
             val.getType() == expectedType);
     return val;
 }
+
+/**
+ * Returns true if 'event' is an insert, update, replace or delete event. The stream never ends
+ * directly after one of these, so it is always safe to read ahead past them.
+ */
+bool isCrudEvent(const Document& event) {
+    auto opType = event[DocumentSourceChangeStream::kOperationTypeField];
+    if (opType.getType() != BSONType::String) {
+        return false;
+    }
+    auto opTypeStr = opType.getStringData();
+    return opTypeStr == DocumentSourceChangeStream::kInsertOpType ||
+        opTypeStr == DocumentSourceChangeStream::kUpdateOpType ||
+        opTypeStr == DocumentSourceChangeStream::kReplaceOpType ||
+        opTypeStr == DocumentSourceChangeStream::kDeleteOpType;
+}
 }  // namespace
 
 DocumentSource::GetNextResult DocumentSourceLookupChangePostImage::getNext() {
     pExpCtx->checkForInterrupt();
 
-    auto input = pSource->getNext();
+    if (_window.empty()) {
+        fillWindow();
+    }
+    auto input = std::move(_window.front());
+    _window.pop_front();
     if (!input.isAdvanced()) {
         return input;
     }
@@ -73,6 +94,53 @@ DocumentSource::GetNextResult DocumentSourceLookupChangePostImage::getNext() {
     return output.freeze();
 }
 
+void DocumentSourceLookupChangePostImage::fillWindow() {
+    _lookedUp.clear();
+
+    const auto windowSize =
+        static_cast<size_t>(internalDocumentSourceLookupChangePostImageWindowSize.load());
+    do {
+        _window.push_back(pSource->getNext());
+        if (!_window.back().isAdvanced() || !isCrudEvent(_window.back().getDocument())) {
+            break;
+        }
+    } while (_window.size() < windowSize);
+}
+
+boost::optional<DocumentSourceLookupChangePostImage::LookupTarget>
+DocumentSourceLookupChangePostImage::peekLookupTarget(const Document& event) const {
+    auto opType = event[DocumentSourceChangeStream::kOperationTypeField];
+    auto nsField = event[DocumentSourceChangeStream::kNamespaceField];
+    auto documentKey = event[DocumentSourceChangeStream::kDocumentKeyField];
+    auto id = event[DocumentSourceChangeStream::kIdField];
+    if (opType.getType() != BSONType::String ||
+        opType.getStringData() != DocumentSourceChangeStream::kUpdateOpType ||
+        nsField.getType() != BSONType::Object || documentKey.getType() != BSONType::Object ||
+        id.getType() != BSONType::Object) {
+        return boost::none;
+    }
+
+    auto dbName = nsField.getDocument()["db"_sd];
+    auto collectionName = nsField.getDocument()["coll"_sd];
+    if (dbName.getType() != BSONType::String || collectionName.getType() != BSONType::String) {
+        return boost::none;
+    }
+
+    try {
+        auto tokenData = ResumeToken::parse(id.getDocument()).getData();
+        if (!tokenData.uuid) {
+            return boost::none;
+        }
+        return LookupTarget{NamespaceString(dbName.getString(), collectionName.getString()),
+                            *tokenData.uuid,
+                            documentKey.getDocument(),
+                            tokenData.clusterTime,
+                            Value()};
+    } catch (const DBException&) {
+        return boost::none;
+    }
+}
+
 NamespaceString DocumentSourceLookupChangePostImage::assertValidNamespace(
     const Document& inputDoc) const {
     auto namespaceObject =
@@ -95,7 +163,7 @@ NamespaceString DocumentSourceLookupChangePostImage::assertValidNamespace(
     return nss;
 }
 
-Value DocumentSourceLookupChangePostImage::lookupPostImage(const Document& updateOp) const {
+Value DocumentSourceLookupChangePostImage::lookupPostImage(const Document& updateOp) {
     // Make sure we have a well-formed input.
     auto nss = assertValidNamespace(updateOp);
 
@@ -108,19 +176,45 @@ Value DocumentSourceLookupChangePostImage::lookupPostImage(const Document& updat
     auto resumeToken =
         ResumeToken::parse(updateOp[DocumentSourceChangeStream::kIdField].getDocument());
 
+    invariant(resumeToken.getData().uuid);
+    const auto& uuid = *resumeToken.getData().uuid;
+
+    auto sameTarget = [&](const LookupTarget& target) {
+        return target.nss == nss && target.uuid == uuid &&
+            Document::compare(target.documentKey, documentKey, nullptr) == 0;
+    };
+    for (auto&& target : _lookedUp) {
+        if (sameTarget(target)) {
+            return target.postImage;
+        }
+    }
+
+    // The lookup must observe the latest buffered update to this document.
+    auto clusterTime = resumeToken.getData().clusterTime;
+    for (auto&& result : _window) {
+        if (!result.isAdvanced()) {
+            continue;
+        }
+        auto target = peekLookupTarget(result.getDocument());
+        if (target && sameTarget(*target)) {
+            clusterTime = std::max(clusterTime, target->clusterTime);
+        }
+    }
+
     const auto readConcern = pExpCtx->inMongos
         ? boost::optional<BSONObj>(BSON("level"
                                         << "majority"
                                         << "afterClusterTime"
-                                        << resumeToken.getData().clusterTime))
+                                        << clusterTime))
         : boost::none;
-    invariant(resumeToken.getData().uuid);
     auto lookedUpDoc = pExpCtx->mongoProcessInterface->lookupSingleDocument(
-        pExpCtx, nss, *resumeToken.getData().uuid, documentKey, readConcern);
+        pExpCtx, nss, uuid, documentKey, readConcern);
 
     // Check whether the lookup returned any documents. Even if the lookup itself succeeded, it may
     // not have returned any results if the document was deleted in the time since the update op.
-    return (lookedUpDoc ? Value(*lookedUpDoc) : Value(BSONNULL));
+    auto postImage = (lookedUpDoc ? Value(*lookedUpDoc) : Value(BSONNULL));
+    _lookedUp.push_back({nss, uuid, documentKey, clusterTime, postImage});
+    return postImage;
 }
 
 }  // namespace mongo
@@ -28,6 +28,9 @@
 
 #pragma once
 
+#include <deque>
+#include <vector>
+
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_change_stream.h"
 
@@ -107,11 +110,41 @@ private:
     DocumentSourceLookupChangePostImage(const boost::intrusive_ptr<ExpressionContext>& expCtx)
         : DocumentSource(expCtx) {}
 
+    /**
+     * The document a post image lookup targets, along with the looked up post image once it is
+     * known.
+     */
+    struct LookupTarget {
+        NamespaceString nss;
+        UUID uuid;
+        Document documentKey;
+        Timestamp clusterTime;
+        Value postImage;
+    };
+
+    /**
+     * Pulls up to 'internalDocumentSourceLookupChangePostImageWindowSize' results which are ready
+     * from our source into '_window', stopping early at a non-advanced result or at an event which
+     * is not a CRUD event, since the stream may end after such an event.
+     */
+    void fillWindow();
+
+    /**
+     * Builds the LookupTarget for the well-formed update event 'event', or returns boost::none if
+     * 'event' is not one. Never throws, so that errors are only raised for malformed events when
+     * they are returned.
+     */
+    boost::optional<LookupTarget> peekLookupTarget(const Document& event) const;
+
     /**
      * Uses the "documentKey" field from 'updateOp' to look up the current version of the document.
      * Returns Value(BSONNULL) if the document couldn't be found.
+     *
+     * The lookup is shared with all update events in '_window' which target the same document: it
+     * is performed once, at or after the cluster time of the latest of them, and any current
+     * version of the document at that point is a valid post image for each of those events.
      */
-    Value lookupPostImage(const Document& updateOp) const;
+    Value lookupPostImage(const Document& updateOp);
 
     /**
      * Throws a AssertionException if the namespace found in 'inputDoc' doesn't match the one on the
@@ -119,6 +152,12 @@ private:
      * function verifies that the only the database names match.
      */
     NamespaceString assertValidNamespace(const Document& inputDoc) const;
+
+    // Results pulled from our source but not yet returned, in order.
+    std::deque<GetNextResult> _window;
+
+    // Post images looked up for the events in the current '_window'.
+    std::vector<LookupTarget> _lookedUp;
 };
 
 }  // namespace mongo
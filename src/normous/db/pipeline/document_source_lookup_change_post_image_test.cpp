@@ -119,6 +119,8 @@ public:
         UUID collectionUUID,
         const Document& documentKey,
         boost::optional<BSONObj> readConcern) {
+        ++_numLookups;
+
         // The namespace 'nss' may be different than the namespace on the ExpressionContext in the
         // case of a change stream on a whole database so we need to make a copy of the
         // ExpressionContext with the new namespace.
@@ -143,8 +145,13 @@ public:
         return lookedUpDocument;
     }
 
+    int numLookups() const {
+        return _numLookups;
+    }
+
 private:
     deque<DocumentSource::GetNextResult> _mockResults;
+    int _numLookups = 0;
 };
 
 TEST_F(DocumentSourceLookupChangePostImageTest, ShouldErrorIfMissingDocumentKeyOnUpdate) {
@@ -393,5 +400,40 @@ TEST_F(DocumentSourceLookupChangePostImageTest, ShouldPropagatePauses) {
     ASSERT_TRUE(lookupChangeStage->getNext().isEOF());
 }
 
+TEST_F(DocumentSourceLookupChangePostImageTest, ShouldLookUpRepeatedlyUpdatedDocumentOnce) {
+    auto expCtx = getExpCtx();
+
+    auto lookupChangeStage = DocumentSourceLookupChangePostImage::create(expCtx);
+
+    // Mock its input with two updates to the document with _id 0, around an update to another.
+    auto makeUpdate = [&](int id) {
+        return Document{{"_id", makeResumeToken(id)},
+                        {"documentKey", Document{{"_id", id}}},
+                        {"operationType", "update"_sd},
+                        {"ns", Document{{"db", expCtx->ns.db()}, {"coll", expCtx->ns.coll()}}}};
+    };
+    auto mockLocalSource =
+        DocumentSourceMock::create({makeUpdate(0), makeUpdate(1), makeUpdate(0)});
+    lookupChangeStage->setSource(mockLocalSource.get());
+
+    // Mock out the foreign collection.
+    deque<DocumentSource::GetNextResult> mockForeignContents{Document{{"_id", 0}, {"x", 0}},
+                                                             Document{{"_id", 1}, {"x", 1}}};
+    auto mockInterface = stdx::make_unique<MockMongoInterface>(std::move(mockForeignContents));
+    auto mockInterfacePtr = mockInterface.get();
+    getExpCtx()->mongoProcessInterface = std::move(mockInterface);
+
+    for (int id : {0, 1, 0}) {
+        auto next = lookupChangeStage->getNext();
+        ASSERT_TRUE(next.isAdvanced());
+        MutableDocument expected(makeUpdate(id));
+        expected["fullDocument"] = Value(Document{{"_id", id}, {"x", id}});
+        ASSERT_DOCUMENT_EQ(next.releaseDocument(), expected.freeze());
+    }
+    ASSERT_TRUE(lookupChangeStage->getNext().isEOF());
+
+    ASSERT_EQ(mockInterfacePtr->numLookups(), 2);
+}
+
 }  // namespace
 }  // namespace mongo
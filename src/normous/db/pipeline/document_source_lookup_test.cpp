@@ -30,6 +30,7 @@
 
 #include <boost/intrusive_ptr.hpp>
 #include <deque>
+#include <limits>
 #include <vector>
 
 #include "mongo/bson/bsonmisc.h"
@@ -47,6 +48,7 @@
 #include "mongo/db/repl/replication_coordinator_mock.h"
 #include "mongo/db/repl/storage_interface_mock.h"
 #include "mongo/db/server_options.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -685,6 +687,86 @@ TEST_F(DocumentSourceLookUpTest, ShouldPropagatePausesWhileUnwinding) {
     lookup->dispose();
 }
 
+/**
+ * Runs a localField/foreignField $lookup of 'localField' against 'foreignField' over
+ * 'localDocs', with 'foreignDocs' as the contents of the foreign collection, and returns its
+ * output.
+ */
+vector<Document> runLocalFieldForeignFieldLookup(const intrusive_ptr<ExpressionContext>& expCtx,
+                                                 deque<DocumentSource::GetNextResult> localDocs,
+                                                 deque<DocumentSource::GetNextResult> foreignDocs) {
+    NamespaceString fromNs("test", "foreign");
+    expCtx->setResolvedNamespace_forTest(fromNs, {fromNs, std::vector<BSONObj>{}});
+    auto parsed = DocumentSourceLookUp::createFromBson(
+        fromjson("{$lookup: {from: 'foreign', localField: 'a', foreignField: 'b', as: 'as'}}")
+            .firstElement(),
+        expCtx);
+
+    auto mockLocalSource = DocumentSourceMock::create(std::move(localDocs));
+    parsed->setSource(mockLocalSource.get());
+    expCtx->mongoProcessInterface = std::make_shared<MockMongoInterface>(std::move(foreignDocs));
+
+    vector<Document> results;
+    for (auto next = parsed->getNext(); next.isAdvanced(); next = parsed->getNext()) {
+        results.push_back(next.releaseDocument());
+    }
+    parsed->dispose();
+    return results;
+}
+
+void assertHashJoinMatchesQueries(const intrusive_ptr<ExpressionContext>& expCtx) {
+    auto results = runLocalFieldForeignFieldLookup(
+        expCtx,
+        {Document{{"a", 1}},
+         Document{{"a", vector<Value>{Value(1), Value(2)}}},
+         Document{{"a", 3}},
+         Document{{"_id", "nullish"_sd}}},
+        {Document{{"_id", 0}, {"b", 1}},
+         Document{{"_id", 1}, {"b", vector<Value>{Value(1), Value(2)}}},
+         Document{{"_id", 2}, {"b", 2.0}},
+         Document{{"_id", 3}}});
+
+    ASSERT_EQ(4U, results.size());
+    ASSERT_VALUE_EQ(results[0]["as"], Value(BSON_ARRAY(BSON("_id" << 0 << "b" << 1)
+                                                       << BSON("_id" << 1 << "b"
+                                                                     << BSON_ARRAY(1 << 2)))));
+    ASSERT_VALUE_EQ(results[1]["as"],
+                    Value(BSON_ARRAY(BSON("_id" << 0 << "b" << 1)
+                                     << BSON("_id" << 1 << "b" << BSON_ARRAY(1 << 2))
+                                     << BSON("_id" << 2 << "b" << 2.0))));
+    ASSERT_VALUE_EQ(results[2]["as"], Value(BSONArray()));
+
+    // A missing local value matches the foreign document without 'b'.
+    ASSERT_VALUE_EQ(results[3]["as"], Value(BSON_ARRAY(BSON("_id" << 3))));
+}
+
+TEST_F(DocumentSourceLookUpTest, HashJoinReturnsSameResultsAsQueries) {
+    const auto oldMinInputDocs = internalDocumentSourceLookupHashJoinMinInputDocs.load();
+    ON_BLOCK_EXIT(
+        [&] { internalDocumentSourceLookupHashJoinMinInputDocs.store(oldMinInputDocs); });
+
+    // Without a hash join, every input document is looked up by a query.
+    internalDocumentSourceLookupHashJoinMinInputDocs.store(std::numeric_limits<int>::max());
+    assertHashJoinMatchesQueries(getExpCtx());
+
+    // Build the hash table before looking anything up.
+    internalDocumentSourceLookupHashJoinMinInputDocs.store(0);
+    assertHashJoinMatchesQueries(getExpCtx());
+}
+
+TEST_F(DocumentSourceLookUpTest, HashJoinFallsBackToQueriesWhenOverMemoryBudget) {
+    const auto oldMinInputDocs = internalDocumentSourceLookupHashJoinMinInputDocs.load();
+    const auto oldMaxMemoryBytes = internalDocumentSourceLookupHashJoinMaxMemoryBytes.load();
+    ON_BLOCK_EXIT([&] {
+        internalDocumentSourceLookupHashJoinMinInputDocs.store(oldMinInputDocs);
+        internalDocumentSourceLookupHashJoinMaxMemoryBytes.store(oldMaxMemoryBytes);
+    });
+
+    internalDocumentSourceLookupHashJoinMinInputDocs.store(0);
+    internalDocumentSourceLookupHashJoinMaxMemoryBytes.store(1);
+    assertHashJoinMatchesQueries(getExpCtx());
+}
+
 TEST_F(DocumentSourceLookUpTest, LookupReportsAsFieldIsModified) {
     auto expCtx = getExpCtx();
     NamespaceString fromNs("test", "foreign");
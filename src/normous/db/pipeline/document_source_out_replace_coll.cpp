@@ -74,10 +74,18 @@ void DocumentSourceOutReplaceColl::initializeWriteNs() {
                 conn->runCommand(outputNs.db().toString(), cmd.done(), info));
     }
 
+    // The indexes of the output collection are copied to the temp collection in finalize(), once
+    // all of the documents are in. Building each index in bulk from the loaded collection is much
+    // cheaper than maintaining it on every insert.
+};
+
+void DocumentSourceOutReplaceColl::copyIndexesToTempNs() {
     if (_originalIndexes.empty()) {
         return;
     }
 
+    DBClientBase* conn = pExpCtx->mongoProcessInterface->directClient();
+
     // Copy the indexes of the output collection to the temp collection.
     std::vector<BSONObj> tempNsIndexes;
     for (const auto& indexSpec : _originalIndexes) {
@@ -91,9 +99,11 @@ void DocumentSourceOutReplaceColl::initializeWriteNs() {
         ex.addContext("Copying indexes for $out failed");
         throw;
     }
-};
+}
 
 void DocumentSourceOutReplaceColl::finalize() {
+    copyIndexesToTempNs();
+
     const auto& outputNs = getOutputNs();
     auto renameCommandObj =
         BSON("renameCollection" << _tempNs.ns() << "to" << outputNs.ns() << "dropTarget" << true);
@@ -0,0 +1,126 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/db/pipeline/aggregation_context_fixture.h"
+#include "mongo/db/pipeline/document_source_query_stats.h"
+#include "mongo/db/pipeline/document_value_test_util.h"
+#include "mongo/db/pipeline/stub_mongo_process_interface.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using DocumentSourceQueryStatsTest = AggregationContextFixture;
+
+/**
+ * A MongoProcessInterface used for testing which returns artificial query shape statistics.
+ */
+class QueryStatsMongoProcessInterface final : public StubMongoProcessInterface {
+public:
+    QueryStatsMongoProcessInterface(std::vector<BSONObj> stats) : _stats(std::move(stats)) {}
+
+    std::vector<BSONObj> getQueryStats(OperationContext* opCtx,
+                                       const NamespaceString& nss) const override {
+        std::vector<BSONObj> results;
+        for (const auto& shape : _stats) {
+            if (shape["ns"].str() == nss.ns()) {
+                results.push_back(shape);
+            }
+        }
+        return results;
+    }
+
+private:
+    std::vector<BSONObj> _stats;
+};
+
+TEST_F(DocumentSourceQueryStatsTest, ShouldFailToParseIfSpecIsNotObject) {
+    const auto specObj = fromjson("{$queryStats: 1}");
+    ASSERT_THROWS_CODE(
+        DocumentSourceQueryStats::createFromBson(specObj.firstElement(), getExpCtx()),
+        AssertionException,
+        ErrorCodes::FailedToParse);
+}
+
+TEST_F(DocumentSourceQueryStatsTest, ShouldFailToParseIfSpecIsANonEmptyObject) {
+    const auto specObj = fromjson("{$queryStats: {unknownOption: 1}}");
+    ASSERT_THROWS_CODE(
+        DocumentSourceQueryStats::createFromBson(specObj.firstElement(), getExpCtx()),
+        AssertionException,
+        ErrorCodes::FailedToParse);
+}
+
+TEST_F(DocumentSourceQueryStatsTest, CannotCreateWhenInMongos) {
+    const auto specObj = fromjson("{$queryStats: {}}");
+    getExpCtx()->inMongos = true;
+    ASSERT_THROWS_CODE(
+        DocumentSourceQueryStats::createFromBson(specObj.firstElement(), getExpCtx()),
+        AssertionException,
+        50992);
+}
+
+TEST_F(DocumentSourceQueryStatsTest, CanParseAndSerializeSuccessfully) {
+    const auto specObj = fromjson("{$queryStats: {}}");
+    auto stage = DocumentSourceQueryStats::createFromBson(specObj.firstElement(), getExpCtx());
+    std::vector<Value> serialized;
+    stage->serializeToArray(serialized);
+    ASSERT_EQ(1u, serialized.size());
+    ASSERT_BSONOBJ_EQ(specObj, serialized[0].getDocument().toBson());
+}
+
+TEST_F(DocumentSourceQueryStatsTest, ReturnsStatsOfAggregatedCollection) {
+    const auto ns = getExpCtx()->ns.ns();
+    std::vector<BSONObj> stats{BSON("ns" << ns << "queryHash"
+                                         << "0000ABCD"),
+                               BSON("ns"
+                                    << "other.coll"
+                                    << "queryHash"
+                                    << "00001234"),
+                               BSON("ns" << ns << "queryHash"
+                                         << "00005678")};
+    getExpCtx()->mongoProcessInterface = std::make_shared<QueryStatsMongoProcessInterface>(stats);
+
+    const auto specObj = fromjson("{$queryStats: {}}");
+    auto stage = DocumentSourceQueryStats::createFromBson(specObj.firstElement(), getExpCtx());
+
+    auto next = stage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(Document(stats[0]), next.releaseDocument());
+
+    next = stage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(Document(stats[2]), next.releaseDocument());
+
+    ASSERT_TRUE(stage->getNext().isEOF());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -60,8 +60,18 @@ DocumentSource::GetNextResult DocumentSourceSample::getNext() {
         PseudoRandom& prng = pExpCtx->opCtx->getClient()->getPrng();
         auto nextInput = pSource->getNext();
         for (; nextInput.isAdvanced(); nextInput = pSource->getNext()) {
+            const double randVal = prng.nextCanonicalDouble();
+            if (_largestRandVals.size() < static_cast<size_t>(_size)) {
+                _largestRandVals.push(randVal);
+            } else if (randVal > _largestRandVals.top()) {
+                _largestRandVals.pop();
+                _largestRandVals.push(randVal);
+            } else {
+                continue;
+            }
+
             MutableDocument doc(nextInput.releaseDocument());
-            doc.setRandMetaField(prng.nextCanonicalDouble());
+            doc.setRandMetaField(randVal);
             _sortStage->loadDocument(doc.freeze());
         }
         switch (nextInput.getStatus()) {
@@ -72,6 +82,7 @@ DocumentSource::GetNextResult DocumentSourceSample::getNext() {
                 return nextInput;  // Propagate the pause.
             }
             case GetNextResult::ReturnStatus::kEOF: {
+                _largestRandVals = {};
                 _sortStage->loadingDone();
             }
         }
@@ -28,6 +28,10 @@
 
 #pragma once
 
+#include <functional>
+#include <queue>
+#include <vector>
+
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_sort.h"
 
@@ -73,6 +77,11 @@ private:
 
     // Uses a $sort stage to randomly sort the documents.
     boost::intrusive_ptr<DocumentSourceSort> _sortStage;
+
+    // The '_size' largest random values assigned so far, smallest on top. Once it is full, an input
+    // document whose random value is not above the top cannot be in the sample, and is dropped
+    // before it reaches '_sortStage'.
+    std::priority_queue<double, std::vector<double>, std::greater<double>> _largestRandVals;
 };
 
 }  // namespace mongo
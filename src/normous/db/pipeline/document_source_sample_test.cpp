@@ -30,6 +30,7 @@
 
 #include <boost/intrusive_ptr.hpp>
 #include <memory>
+#include <set>
 
 #include "mongo/bson/bsonelement.h"
 #include "mongo/bson/bsonobj.h"
@@ -154,6 +155,23 @@ TEST_F(SampleBasics, SampleEOFBeforeSource) {
     checkResults(5, 5);
 }
 
+/**
+ * A $sample stage much smaller than its input should return distinct documents.
+ */
+TEST_F(SampleBasics, SampleMuchSmallerThanSourceReturnsDistinctDocs) {
+    loadDocuments(1000);
+    createSample(10);
+
+    std::set<int> ids;
+    for (int i = 0; i < 10; i++) {
+        auto next = sample()->getNext();
+        ASSERT_TRUE(next.isAdvanced());
+        ids.insert(next.releaseDocument()["_id"].getInt());
+    }
+    ASSERT_EQ(ids.size(), 10U);
+    assertEOF();
+}
+
 /**
  * The incoming documents should not be modified by a $sample stage (except their metadata).
  */
@@ -30,6 +30,7 @@
 
 #include "mongo/db/pipeline/document_source_sort.h"
 
+#include "mongo/db/curop.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/pipeline/document.h"
 #include "mongo/db/pipeline/document_path_support.h"
@@ -307,6 +308,8 @@ SortOptions DocumentSourceSort::makeSortOptions() const {
         opts.limit = _limitSrc->getLimit();
 
     opts.maxMemoryUsageBytes = _maxMemoryUsageBytes;
+    opts.sortThreads = internalQueryExecSortThreads.load();
+    opts.spillStats = &_spillStats;
     if (pExpCtx->allowDiskUse && !pExpCtx->inMongos) {
         opts.extSortAllowed = true;
         opts.tempDir = pExpCtx->tempDir;
@@ -349,15 +352,18 @@ void DocumentSourceSort::loadingDone() {
     _usedDisk = _sorter->usedDisk() || _usedDisk;
     _sorter.reset();
     _populated = true;
+
+    if (_usedDisk && pExpCtx->opCtx) {
+        CurOp::get(pExpCtx->opCtx)->debug().addSortSpill(_spillStats);
+    }
 }
 
 bool DocumentSourceSort::usedDisk() {
     return _usedDisk;
 }
 
-Value DocumentSourceSort::getCollationComparisonKey(const Value& val) const {
-    const auto collator = pExpCtx->getCollator();
-
+Value DocumentSourceSort::getCollationComparisonKey(const Value& val,
+                                                    const CollatorInterface* collator) {
     // If the collation is the simple collation, the value itself is the comparison key.
     if (!collator) {
         return val;
@@ -400,7 +406,7 @@ StatusWith<Value> DocumentSourceSort::extractKeyPart(const Document& doc,
         plainKey = patternPart.expression->evaluate(doc);
     }
 
-    return getCollationComparisonKey(plainKey);
+    return getCollationComparisonKey(plainKey, pExpCtx->getCollator());
 }
 
 StatusWith<Value> DocumentSourceSort::extractKeyFast(const Document& doc) const {
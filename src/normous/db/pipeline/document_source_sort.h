@@ -107,6 +107,13 @@ public:
         long long limit = -1,
         boost::optional<uint64_t> maxMemoryUsageBytes = boost::none);
 
+    /**
+     * Returns the comparison key used to sort 'val' with the collation 'collator', or 'val' itself
+     * if 'collator' is null. Note that these comparison keys should always be sorted with the
+     * simple (i.e. binary) collation, which is much cheaper than comparing under the collation.
+     */
+    static Value getCollationComparisonKey(const Value& val, const CollatorInterface* collator);
+
     /**
      * Returns -1 for no limit.
      */
@@ -225,13 +232,6 @@ private:
      */
     BSONObj extractKeyWithArray(const Document& doc) const;
 
-    /**
-     * Returns the comparison key used to sort 'val' with the collation of the ExpressionContext.
-     * Note that these comparison keys should always be sorted with the simple (i.e. binary)
-     * collation.
-     */
-    Value getCollationComparisonKey(const Value& val) const;
-
     int compare(const Value& lhs, const Value& rhs) const;
 
     /**
@@ -262,6 +262,10 @@ private:
     std::unique_ptr<MySorter> _sorter;
     std::unique_ptr<MySorter::Iterator> _output;
     bool _usedDisk = false;
+
+    // Counts what '_sorter' spills, for reporting in CurOp. Mutable so that makeSortOptions() can
+    // hand out a pointer to it.
+    mutable SorterSpillStats _spillStats;
 };
 
 }  // namespace mongo
@@ -0,0 +1,152 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/pipeline/document.h"
+#include "mongo/db/pipeline/field_path.h"
+#include "mongo/db/pipeline/value.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace {
+
+BSONObj makeBson(int numFields) {
+    BSONObjBuilder builder;
+    builder.append("_id", 1);
+    for (int i = 0; i < numFields; ++i) {
+        builder.append(str::stream() << "field" << i, i);
+    }
+    builder.append("nested", BSON("a" << 1 << "b" << BSON("c" << 2 << "d" << 3)));
+    builder.append("array", BSON_ARRAY(1 << 2 << 3 << 4 << 5));
+    return builder.obj();
+}
+
+// Converting a BSON document is lazy, so this only measures wrapping the buffer.
+void BM_DocumentFromBson(benchmark::State& state) {
+    const auto bson = makeBson(state.range(0));
+    for (auto keepRunning : state) {
+        Document doc(bson);
+        benchmark::DoNotOptimize(doc);
+    }
+}
+
+// Looks up the last top-level field, which materializes every field before it.
+void BM_DocumentGetLastField(benchmark::State& state) {
+    const auto bson = makeBson(state.range(0));
+    for (auto keepRunning : state) {
+        Document doc(bson);
+        benchmark::DoNotOptimize(doc["array"]);
+    }
+}
+
+void BM_DocumentGetNestedField(benchmark::State& state) {
+    const Document doc(makeBson(20));
+    const FieldPath path("nested.b.d");
+    for (auto keepRunning : state) {
+        benchmark::DoNotOptimize(doc.getNestedField(path));
+    }
+}
+
+void BM_DocumentToBson(benchmark::State& state) {
+    const auto bson = makeBson(state.range(0));
+    for (auto keepRunning : state) {
+        Document doc(bson);
+        benchmark::DoNotOptimize(doc.toBson());
+    }
+}
+
+void BM_MutableDocumentBuild(benchmark::State& state) {
+    const int numFields = state.range(0);
+    std::vector<std::string> names;
+    for (int i = 0; i < numFields; ++i) {
+        names.push_back(str::stream() << "field" << i);
+    }
+    for (auto keepRunning : state) {
+        MutableDocument doc(numFields);
+        for (int i = 0; i < numFields; ++i) {
+            doc.addField(names[i], Value(i));
+        }
+        benchmark::DoNotOptimize(doc.freeze());
+    }
+}
+
+// Overwrites a field of an existing document, the pattern used by $addFields and $set.
+void BM_MutableDocumentSetField(benchmark::State& state) {
+    const Document base(makeBson(20));
+    for (auto keepRunning : state) {
+        MutableDocument doc(base);
+        doc.setField("field10", Value(42));
+        benchmark::DoNotOptimize(doc.freeze());
+    }
+}
+
+void BM_ValueString(benchmark::State& state) {
+    const std::string str(state.range(0), 'x');
+    for (auto keepRunning : state) {
+        Value value(StringData{str});
+        benchmark::DoNotOptimize(value);
+    }
+}
+
+void BM_ValueArray(benchmark::State& state) {
+    const int numElements = state.range(0);
+    for (auto keepRunning : state) {
+        std::vector<Value> values;
+        values.reserve(numElements);
+        for (int i = 0; i < numElements; ++i) {
+            values.emplace_back(i);
+        }
+        Value value(std::move(values));
+        benchmark::DoNotOptimize(value);
+    }
+}
+
+void BM_ValueCompare(benchmark::State& state) {
+    const Value lhs(Document(makeBson(20)));
+    const Value rhs(Document(makeBson(20)));
+    for (auto keepRunning : state) {
+        benchmark::DoNotOptimize(Value::compare(lhs, rhs, nullptr));
+    }
+}
+
+BENCHMARK(BM_DocumentFromBson)->Arg(10)->Arg(100);
+BENCHMARK(BM_DocumentGetLastField)->Arg(10)->Arg(100);
+BENCHMARK(BM_DocumentGetNestedField);
+BENCHMARK(BM_DocumentToBson)->Arg(10)->Arg(100);
+BENCHMARK(BM_MutableDocumentBuild)->Arg(10)->Arg(100);
+BENCHMARK(BM_MutableDocumentSetField);
+BENCHMARK(BM_ValueString)->Arg(8)->Arg(1024);
+BENCHMARK(BM_ValueArray)->Arg(10)->Arg(1000);
+BENCHMARK(BM_ValueCompare);
+
+}  // namespace
+}  // namespace mongo
@@ -111,6 +111,15 @@ TEST(DocumentConstruction, FromEmptyDocumentClone) {
     ASSERT_DOCUMENT_EQ(document, documentClone);
 }
 
+TEST(DocumentPeekField, ReturnsReferenceToStoredValue) {
+    auto document = Document{{"a", 1}, {"b", Document{{"c", 2}}}, {"d", 3}, {"e", 4}, {"f", 5}};
+    ASSERT_VALUE_EQ(Value(1), document.peekField("a"));
+    ASSERT_VALUE_EQ(Value(5), document.peekField("f"));
+    ASSERT_VALUE_EQ(document["b"], document.peekField("b"));
+    ASSERT_EQ(&document.peekField("b"), &document.peekField("b"));
+    ASSERT_TRUE(document.peekField("missing").missing());
+}
+
 /**
  * Appends to 'builder' an object nested 'depth' levels deep.
  */
@@ -273,6 +273,27 @@ Value ExpressionAdd::evaluate(const Document& root) const {
     BSONType totalType = NumberInt;
     bool haveDate = false;
 
+    // The common case is summing ints and longs, so keep an exact 64-bit integral sum while every
+    // non-decimal operand is integral and the sum does not overflow, and only hand it over to the
+    // (considerably slower) compensated sum once that stops being true.
+    long long integralTotal = 0;
+    bool summingIntegral = true;
+    auto stopSummingIntegral = [&] {
+        if (summingIntegral) {
+            nonDecimalTotal.addLong(integralTotal);
+            summingIntegral = false;
+        }
+    };
+    auto addIntegral = [&](long long addend) {
+        long long sum;
+        if (summingIntegral && !mongoSignedAddOverflow64(integralTotal, addend, &sum)) {
+            integralTotal = sum;
+            return;
+        }
+        stopSummingIntegral();
+        nonDecimalTotal.addLong(addend);
+    };
+
     const size_t n = vpOperand.size();
     for (size_t i = 0; i < n; ++i) {
         Value val = vpOperand[i]->evaluate(root);
@@ -283,21 +304,23 @@ Value ExpressionAdd::evaluate(const Document& root) const {
                 totalType = NumberDecimal;
                 break;
             case NumberDouble:
+                stopSummingIntegral();
                 nonDecimalTotal.addDouble(val.getDouble());
                 if (totalType != NumberDecimal)
                     totalType = NumberDouble;
                 break;
             case NumberLong:
-                nonDecimalTotal.addLong(val.getLong());
+                addIntegral(val.getLong());
                 if (totalType == NumberInt)
                     totalType = NumberLong;
                 break;
             case NumberInt:
-                nonDecimalTotal.addDouble(val.getInt());
+                addIntegral(val.getInt());
                 break;
             case Date:
                 uassert(16612, "only one date allowed in an $add expression", !haveDate);
                 haveDate = true;
+                stopSummingIntegral();
                 nonDecimalTotal.addLong(val.getDate().toMillisSinceEpoch());
                 break;
             default:
@@ -309,6 +332,14 @@ Value ExpressionAdd::evaluate(const Document& root) const {
         }
     }
 
+    if (summingIntegral) {
+        if (totalType == NumberLong)
+            return Value(integralTotal);
+        if (totalType == NumberInt)
+            return Value::createIntOrLong(integralTotal);
+        stopSummingIntegral();
+    }
+
     if (haveDate) {
         int64_t longTotal;
         if (totalType == NumberDecimal) {
@@ -1998,6 +2029,7 @@ Value ExpressionFieldPath::evaluatePathArray(size_t index, const Value& input) c
     // Check for remaining path in each element of array
     vector<Value> result;
     const vector<Value>& array = input.getArray();
+    result.reserve(array.size());
     for (size_t i = 0; i < array.size(); i++) {
         if (array[i].getType() != Object)
             continue;
@@ -2017,8 +2049,8 @@ Value ExpressionFieldPath::evaluatePath(size_t index, const Document& input) con
     if (index == _fieldPath.getPathLength() - 1)
         return input[_fieldPath.getFieldName(index)];
 
-    // Try to dive deeper
-    const Value val = input[_fieldPath.getFieldName(index)];
+    // Try to dive deeper. The intermediate value is only inspected, so avoid copying it.
+    const Value& val = input.peekField(_fieldPath.getFieldName(index));
     switch (val.getType()) {
         case Object:
             return evaluatePath(index + 1, val.getDocument());
@@ -0,0 +1,122 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/bson/json.h"
+#include "mongo/db/pipeline/document.h"
+#include "mongo/db/pipeline/expression.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+
+namespace mongo {
+namespace {
+
+Document makeDocument() {
+    return Document(fromjson(
+        "{_id: 1, a: 10, b: 20, c: 1.5, name: 'benchmark', date: {$date: 1500000000000}, "
+        "nested: {x: 1, y: {z: 2}}, array: [1, 2, 3, 4, 5, 6, 7, 8, 9, 10], "
+        "objects: [{v: 1}, {v: 2}, {v: 3}, {v: 4}]}"));
+}
+
+// Parses and optimizes the expression in 'spec', then evaluates it against a fixed document.
+void runExpression(benchmark::State& state, const BSONObj& spec) {
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    auto expr = Expression::parseOperand(expCtx, spec.firstElement(), expCtx->variablesParseState)
+                    ->optimize();
+    const auto doc = makeDocument();
+    for (auto keepRunning : state) {
+        benchmark::DoNotOptimize(expr->evaluate(doc));
+    }
+}
+
+void BM_ExpressionFieldPath(benchmark::State& state) {
+    runExpression(state, fromjson("{expr: '$nested.y.z'}"));
+}
+
+void BM_ExpressionArithmetic(benchmark::State& state) {
+    runExpression(state,
+                  fromjson("{expr: {$add: [{$multiply: ['$a', '$c']}, {$subtract: ['$b', 5]}]}}"));
+}
+
+void BM_ExpressionComparison(benchmark::State& state) {
+    runExpression(state, fromjson("{expr: {$and: [{$gt: ['$a', 5]}, {$lte: ['$b', 20]}]}}"));
+}
+
+void BM_ExpressionCond(benchmark::State& state) {
+    runExpression(state, fromjson("{expr: {$cond: [{$eq: ['$name', 'benchmark']}, '$a', '$b']}}"));
+}
+
+void BM_ExpressionConcat(benchmark::State& state) {
+    runExpression(state, fromjson("{expr: {$concat: ['$name', '-', {$toUpper: '$name'}]}}"));
+}
+
+void BM_ExpressionDateToParts(benchmark::State& state) {
+    runExpression(state, fromjson("{expr: {$dateToParts: {date: '$date'}}}"));
+}
+
+void BM_ExpressionMap(benchmark::State& state) {
+    runExpression(state,
+                  fromjson("{expr: {$map: {input: '$array', as: 'x', in: {$add: ['$$x', 1]}}}}"));
+}
+
+void BM_ExpressionFilter(benchmark::State& state) {
+    runExpression(
+        state,
+        fromjson("{expr: {$filter: {input: '$objects', as: 'o', cond: {$gt: ['$$o.v', 2]}}}}"));
+}
+
+void BM_ExpressionObject(benchmark::State& state) {
+    runExpression(state, fromjson("{expr: {a: '$a', sum: {$add: ['$a', '$b']}, name: '$name'}}"));
+}
+
+void BM_ExpressionParse(benchmark::State& state) {
+    const auto spec =
+        fromjson("{expr: {$add: [{$multiply: ['$a', '$c']}, {$subtract: ['$b', 5]}]}}");
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    for (auto keepRunning : state) {
+        benchmark::DoNotOptimize(
+            Expression::parseOperand(expCtx, spec.firstElement(), expCtx->variablesParseState));
+    }
+}
+
+BENCHMARK(BM_ExpressionFieldPath);
+BENCHMARK(BM_ExpressionArithmetic);
+BENCHMARK(BM_ExpressionComparison);
+BENCHMARK(BM_ExpressionCond);
+BENCHMARK(BM_ExpressionConcat);
+BENCHMARK(BM_ExpressionDateToParts);
+BENCHMARK(BM_ExpressionMap);
+BENCHMARK(BM_ExpressionFilter);
+BENCHMARK(BM_ExpressionObject);
+BENCHMARK(BM_ExpressionParse);
+
+}  // namespace
+}  // namespace mongo
@@ -84,9 +84,12 @@ ExpressionContext::ExpressionContext(NamespaceString nss,
 void ExpressionContext::checkForInterrupt() {
     // This check could be expensive, at least in relative terms, so don't check every time.
     if (--_interruptCounter == 0) {
-        invariant(opCtx);
         _interruptCounter = kInterruptCheckPeriod;
-        opCtx->checkForInterrupt();
+        // Copies running on a helper thread, such as those of parallel $facet sub-pipelines, have
+        // no OperationContext; the thread which owns the operation checks on their behalf.
+        if (opCtx) {
+            opCtx->checkForInterrupt();
+        }
     }
 }
 
@@ -1243,6 +1243,20 @@ class LongDoubleNoOverflow : public TwoOperandBase {
     }
 };
 
+/** An intermediate sum of longs may overflow as long as the final sum fits in a NumberLong. */
+class LongOverflowBackIntoRange : public ExpectedResultBase {
+    void populateOperands(intrusive_ptr<ExpressionNary>& expression) {
+        intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+        expression->addOperand(
+            ExpressionConstant::create(expCtx, Value(numeric_limits<long long>::max())));
+        expression->addOperand(ExpressionConstant::create(expCtx, Value(10LL)));
+        expression->addOperand(ExpressionConstant::create(expCtx, Value(-20)));
+    }
+    BSONObj expectedResult() {
+        return BSON("" << numeric_limits<long long>::max() - 10);
+    }
+};
+
 /** Adding an int and null. */
 class IntNull : public TwoOperandBase {
     BSONObj operand1() {
@@ -5548,6 +5562,7 @@ public:
         add<Add::IntDate>();
         add<Add::LongDouble>();
         add<Add::LongDoubleNoOverflow>();
+        add<Add::LongOverflowBackIntoRange>();
         add<Add::IntNull>();
         add<Add::LongUndefined>();
 
@@ -241,7 +241,8 @@ public:
     /**
      * The following methods forward to the BackupCursorHooks decorating the ServiceContext.
      */
-    virtual BackupCursorState openBackupCursor(OperationContext* opCtx) = 0;
+    virtual BackupCursorState openBackupCursor(OperationContext* opCtx,
+                                               const StorageEngine::BackupOptions& options) = 0;
 
     virtual void closeBackupCursor(OperationContext* opCtx, std::uint64_t cursorId) = 0;
 
@@ -254,6 +255,20 @@ public:
                                                                 const NamespaceString&,
                                                                 const MatchExpression*) const = 0;
 
+    /**
+     * Returns a vector of BSON objects, where each entry describes a lock resource which currently
+     * has waiters, along with the wait-for edges between its lockers. See
+     * LockManager::getLockContentionSample().
+     */
+    virtual std::vector<BSONObj> getLockContentionSample(OperationContext* opCtx) const = 0;
+
+    /**
+     * Returns a vector of BSON objects, where each entry describes the execution statistics of a
+     * query shape on 'nss' tracked by the QueryStatsStore.
+     */
+    virtual std::vector<BSONObj> getQueryStats(OperationContext* opCtx,
+                                               const NamespaceString& nss) const = 0;
+
     /**
      * Returns true if there is an index on 'nss' with properties that will guarantee that a
      * document with non-array values for each of 'uniqueKeyPaths' will have at most one matching
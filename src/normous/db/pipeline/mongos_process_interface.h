@@ -136,7 +136,8 @@ public:
      * The following methods only make sense for data-bearing nodes and should never be called on
      * a mongos.
      */
-    BackupCursorState openBackupCursor(OperationContext* opCtx) final {
+    BackupCursorState openBackupCursor(OperationContext* opCtx,
+                                       const StorageEngine::BackupOptions& options) final {
         MONGO_UNREACHABLE;
     }
 
@@ -155,6 +156,25 @@ public:
         MONGO_UNREACHABLE;
     }
 
+    /**
+     * Mongos does not take collection locks, so this method should never be called on mongos.
+     * Upstream checks are responsible for generating an error if a user attempts to sample lock
+     * contention on mongos.
+     */
+    std::vector<BSONObj> getLockContentionSample(OperationContext* opCtx) const final {
+        MONGO_UNREACHABLE;
+    }
+
+    /**
+     * Query shape statistics are collected by each mongod, so this method should never be called
+     * on mongos. Upstream checks are responsible for generating an error if a user attempts to
+     * read them on mongos.
+     */
+    std::vector<BSONObj> getQueryStats(OperationContext* opCtx,
+                                       const NamespaceString& nss) const final {
+        MONGO_UNREACHABLE;
+    }
+
     bool uniqueKeyIsSupportedByIndex(const boost::intrusive_ptr<ExpressionContext>&,
                                      const NamespaceString&,
                                      const std::set<FieldPath>& uniqueKeyPaths) const final;
@@ -124,7 +124,7 @@ void InclusionNode::applyInclusions(const Document& inputDoc, MutableDocument* o
 
 Value InclusionNode::applyInclusionsToValue(Value inputValue) const {
     if (inputValue.getType() == BSONType::Object) {
-        MutableDocument output;
+        MutableDocument output(maxOutputFields());
         applyInclusions(inputValue.getDocument(), &output);
         return output.freezeToValue();
     } else if (inputValue.getType() == BSONType::Array) {
@@ -350,7 +350,7 @@ void ParsedInclusionProjection::parse(const BSONObj& spec) {
 Document ParsedInclusionProjection::applyProjection(const Document& inputDoc) const {
     // All expressions will be evaluated in the context of the input document, before any
     // transformations have been applied.
-    MutableDocument output;
+    MutableDocument output(_root->maxOutputFields());
     _root->applyInclusions(inputDoc, &output);
     _root->addComputedFields(&output, inputDoc);
 
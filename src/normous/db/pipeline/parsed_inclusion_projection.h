@@ -122,6 +122,14 @@ public:
         return _pathToNode;
     }
 
+    /**
+     * Returns an upper bound on the number of fields this node can produce in its output document,
+     * used to size the output up front rather than growing it field by field.
+     */
+    size_t maxOutputFields() const {
+        return _inclusions.size() + _children.size() + _expressions.size();
+    }
+
     /**
      * Recursively add all paths that are preserved by this inclusion projection.
      */
@@ -212,6 +212,25 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> attemptToGetExe
     return getExecutorFind(opCtx, collection, nss, std::move(cq.getValue()), plannerOpts);
 }
 
+/**
+ * Returns 'sortPattern' with every direction reversed, or boost::none if it is empty or sorts on
+ * anything but ascending or descending field values.
+ */
+boost::optional<BSONObj> reverseSortPattern(const BSONObj& sortPattern) {
+    if (sortPattern.isEmpty()) {
+        return boost::none;
+    }
+
+    BSONObjBuilder reversed;
+    for (auto&& elem : sortPattern) {
+        if (!elem.isNumber()) {
+            return boost::none;
+        }
+        reversed.append(elem.fieldNameStringData(), elem.number() > 0 ? -1 : 1);
+    }
+    return reversed.obj();
+}
+
 BSONObj removeSortKeyMetaProjection(BSONObj projectionObj) {
     if (!projectionObj[Document::metaFieldSortKey]) {
         return projectionObj;
@@ -401,6 +420,15 @@ void PipelineD::prepareGenericCursorSource(Collection* collection,
     std::unique_ptr<GroupFromFirstDocumentTransformation> rewrittenGroupStage;
     if (groupStage) {
         rewrittenGroupStage = groupStage->rewriteGroupAsTransformOnFirstDocument();
+
+        // A $last group can only be answered by reading each group backwards, which requires a
+        // sort that can be reversed.
+        if (rewrittenGroupStage &&
+            rewrittenGroupStage->expectedInput() ==
+                GroupFromFirstDocumentTransformation::ExpectedInput::kLastDocument &&
+            !reverseSortPattern(sortObj)) {
+            rewrittenGroupStage.reset();
+        }
     }
 
     // Create the PlanExecutor.
@@ -545,6 +573,15 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::prep
 
     if (rewrittenGroupStage) {
         BSONObj emptySort;
+        BSONObj distinctSort = sortObj ? *sortObj : emptySort;
+
+        // The last document of each group in the requested order is the first one when scanning
+        // in the reverse order, so a group of $last accumulators can use the same DISTINCT_SCAN.
+        const bool readsLastDocument = rewrittenGroupStage->expectedInput() ==
+            GroupFromFirstDocumentTransformation::ExpectedInput::kLastDocument;
+        if (readsLastDocument) {
+            distinctSort = *reverseSortPattern(distinctSort);
+        }
 
         // See if the query system can handle the $group and $sort stage using a DISTINCT_SCAN
         // (SERVER-9507). Note that passing the empty projection (as we do for some of the
@@ -558,7 +595,7 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::prep
                                                       oplogReplay,
                                                       queryObj,
                                                       *projectionObj,
-                                                      sortObj ? *sortObj : emptySort,
+                                                      distinctSort,
                                                       rewrittenGroupStage->groupId(),
                                                       aggRequest,
                                                       plannerOpts,
@@ -575,6 +612,11 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::prep
             pipeline->popFrontWithName(DocumentSourceSort::kStageName);
             pipeline->popFrontWithName(DocumentSourceGroup::kStageName);
 
+            // The executor now produces documents in the order of the distinct scan.
+            if (sortObj) {
+                *sortObj = distinctSort;
+            }
+
             boost::intrusive_ptr<DocumentSource> groupTransform(
                 new DocumentSourceSingleDocumentTransformation(
                     expCtx,
@@ -36,12 +36,17 @@
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/catalog/document_validation.h"
+#include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/catalog/index_catalog_entry.h"
 #include "mongo/db/catalog/uuid_catalog.h"
 #include "mongo/db/concurrency/d_concurrency.h"
+#include "mongo/db/concurrency/lock_state.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/db_raii.h"
+#include "mongo/db/index/index_key_histogram.h"
 #include "mongo/db/pipeline/document_source_cursor.h"
 #include "mongo/db/pipeline/pipeline_d.h"
+#include "mongo/db/query/query_stats_store.h"
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/db/session_catalog.h"
@@ -209,7 +214,18 @@ CollectionIndexUsageMap MongoInterfaceStandalone::getIndexStats(OperationContext
         return CollectionIndexUsageMap();
     }
 
-    return collection->infoCache()->getIndexUsageStats();
+    CollectionIndexUsageMap indexStats = collection->infoCache()->getIndexUsageStats();
+    const IndexCatalog* indexCatalog = collection->getIndexCatalog();
+    for (auto&& indexStat : indexStats) {
+        const IndexDescriptor* desc = indexCatalog->findIndexByName(opCtx, indexStat.first);
+        if (!desc) {
+            continue;
+        }
+        if (auto histogram = indexCatalog->getEntry(desc)->getKeyHistogram()) {
+            indexStat.second.keyStatistics = histogram->toBSON();
+        }
+    }
+    return indexStats;
 }
 
 void MongoInterfaceStandalone::appendLatencyStats(OperationContext* opCtx,
@@ -382,10 +398,11 @@ boost::optional<Document> MongoInterfaceStandalone::lookupSingleDocument(
     return lookedUpDocument;
 }
 
-BackupCursorState MongoInterfaceStandalone::openBackupCursor(OperationContext* opCtx) {
+BackupCursorState MongoInterfaceStandalone::openBackupCursor(
+    OperationContext* opCtx, const StorageEngine::BackupOptions& options) {
     auto backupCursorHooks = BackupCursorHooks::get(opCtx->getServiceContext());
     if (backupCursorHooks->enabled()) {
-        return backupCursorHooks->openBackupCursor(opCtx);
+        return backupCursorHooks->openBackupCursor(opCtx, options);
     } else {
         uasserted(50956, "Backup cursors are an enterprise only feature.");
     }
@@ -425,6 +442,16 @@ std::vector<BSONObj> MongoInterfaceStandalone::getMatchingPlanCacheEntryStats(
     return planCache->getMatchingStats(serializer, predicate);
 }
 
+std::vector<BSONObj> MongoInterfaceStandalone::getLockContentionSample(
+    OperationContext* opCtx) const {
+    return getGlobalLockManager()->getLockContentionSample();
+}
+
+std::vector<BSONObj> MongoInterfaceStandalone::getQueryStats(OperationContext* opCtx,
+                                                             const NamespaceString& nss) const {
+    return QueryStatsStore::get(opCtx).report(nss);
+}
+
 bool MongoInterfaceStandalone::uniqueKeyIsSupportedByIndex(
     const boost::intrusive_ptr<ExpressionContext>& expCtx,
     const NamespaceString& nss,
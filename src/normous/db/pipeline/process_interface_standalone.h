@@ -98,13 +98,19 @@ public:
         boost::optional<BSONObj> readConcern) final;
     std::vector<GenericCursor> getIdleCursors(const boost::intrusive_ptr<ExpressionContext>& expCtx,
                                               CurrentOpUserMode userMode) const final;
-    BackupCursorState openBackupCursor(OperationContext* opCtx) final;
+    BackupCursorState openBackupCursor(OperationContext* opCtx,
+                                       const StorageEngine::BackupOptions& options) final;
     void closeBackupCursor(OperationContext* opCtx, std::uint64_t cursorId) final;
 
     std::vector<BSONObj> getMatchingPlanCacheEntryStats(OperationContext*,
                                                         const NamespaceString&,
                                                         const MatchExpression*) const final;
 
+    std::vector<BSONObj> getLockContentionSample(OperationContext* opCtx) const final;
+
+    std::vector<BSONObj> getQueryStats(OperationContext* opCtx,
+                                       const NamespaceString& nss) const final;
+
     bool uniqueKeyIsSupportedByIndex(const boost::intrusive_ptr<ExpressionContext>& expCtx,
                                      const NamespaceString& nss,
                                      const std::set<FieldPath>& uniqueKeyPaths) const final;
@@ -154,7 +154,8 @@ public:
         MONGO_UNREACHABLE;
     }
 
-    BackupCursorState openBackupCursor(OperationContext* opCtx) final {
+    BackupCursorState openBackupCursor(OperationContext* opCtx,
+                                       const StorageEngine::BackupOptions& options) final {
         MONGO_UNREACHABLE;
     }
 
@@ -168,6 +169,15 @@ public:
         MONGO_UNREACHABLE;
     }
 
+    std::vector<BSONObj> getLockContentionSample(OperationContext* opCtx) const override {
+        MONGO_UNREACHABLE;
+    }
+
+    std::vector<BSONObj> getQueryStats(OperationContext* opCtx,
+                                       const NamespaceString& nss) const override {
+        MONGO_UNREACHABLE;
+    }
+
     bool uniqueKeyIsSupportedByIndex(const boost::intrusive_ptr<ExpressionContext>& expCtx,
                                      const NamespaceString& nss,
                                      const std::set<FieldPath>& uniqueKeyPaths) const override {
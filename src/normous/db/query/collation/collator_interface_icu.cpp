@@ -30,8 +30,8 @@
 
 #include "mongo/db/query/collation/collator_interface_icu.h"
 
+#include <array>
 #include <unicode/coll.h>
-#include <unicode/sortkey.h>
 
 #include "mongo/stdx/memory.h"
 #include "mongo/util/assert_util.h"
@@ -76,19 +76,26 @@ CollatorInterface::ComparisonKey CollatorInterfaceICU::getComparisonKey(
     // A StringPiece is ICU's StringData. They are logically the same abstraction.
     const icu::StringPiece stringPiece(stringData.rawData(), stringData.size());
 
-    UErrorCode status = U_ZERO_ERROR;
-    icu::CollationKey icuKey;
-    _collator->getCollationKey(icu::UnicodeString::fromUTF8(stringPiece), icuKey, status);
+    const icu::UnicodeString unicodeString = icu::UnicodeString::fromUTF8(stringPiece);
+
+    // Sort keys are generated for every string that is sorted or indexed with a collation, so
+    // write them straight into a stack buffer rather than through an icu::CollationKey, which
+    // costs a heap allocation and a copy per key. Only unusually long keys need a second pass.
+    std::array<uint8_t, 256> stackBuffer;
+    std::unique_ptr<uint8_t[]> heapBuffer;
+    const uint8_t* keyBuffer = stackBuffer.data();
+    int32_t keyLength =
+        _collator->getSortKey(unicodeString, stackBuffer.data(), stackBuffer.size());
+    if (keyLength > static_cast<int32_t>(stackBuffer.size())) {
+        heapBuffer.reset(new uint8_t[keyLength]);
+        keyBuffer = heapBuffer.get();
+        keyLength = _collator->getSortKey(unicodeString, heapBuffer.get(), keyLength);
+    }
 
     // Any sequence of bytes, even invalid UTF-8, has defined comparison behavior in ICU (invalid
-    // subsequences are weighted as the replacement character, U+FFFD). A non-ok error code is only
+    // subsequences are weighted as the replacement character, U+FFFD). A zero length is only
     // expected when a memory allocation fails inside ICU, which we consider fatal to the process.
-    fassert(34439, U_SUCCESS(status));
-
-    int32_t keyLength;
-    const uint8_t* keyBuffer = icuKey.getByteArray(keyLength);
-    invariant(keyLength > 0);
-    invariant(keyBuffer);
+    fassert(34439, keyLength > 0);
 
     // The last byte of the sort key should always be null. When we construct the comparison key, we
     // omit the trailing null byte.
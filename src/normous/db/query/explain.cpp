@@ -152,6 +152,9 @@ size_t getKeysExamined(StageType type, const SpecificStats* specific) {
     } else if (STAGE_COUNT_SCAN == type) {
         const CountScanStats* spec = static_cast<const CountScanStats*>(specific);
         return spec->keysExamined;
+    } else if (STAGE_COLUMN_SCAN == type) {
+        const ColumnScanStats* spec = static_cast<const ColumnScanStats*>(specific);
+        return spec->keysExamined;
     } else if (STAGE_DISTINCT_SCAN == type) {
         const DistinctScanStats* spec = static_cast<const DistinctScanStats*>(specific);
         return spec->keysExamined;
@@ -201,6 +204,10 @@ void addStageSummaryStr(const PlanStage* stage, StringBuilder& sb) {
         const CountScanStats* spec = static_cast<const CountScanStats*>(specific);
         const KeyPattern keyPattern{spec->keyPattern};
         sb << " " << keyPattern;
+    } else if (STAGE_COLUMN_SCAN == stage->stageType()) {
+        const ColumnScanStats* spec = static_cast<const ColumnScanStats*>(specific);
+        const KeyPattern keyPattern{spec->keyPattern};
+        sb << " " << keyPattern;
     } else if (STAGE_DISTINCT_SCAN == stage->stageType()) {
         const DistinctScanStats* spec = static_cast<const DistinctScanStats*>(specific);
         const KeyPattern keyPattern{spec->keyPattern};
@@ -339,6 +346,10 @@ void Explain::statsToBSON(const PlanStageStats& stats,
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
             bob->appendNumber("memUsage", spec->memUsage);
             bob->appendNumber("memLimit", spec->memLimit);
+            bob->appendNumber("bloomFilterBits", spec->bloomFilterBits);
+            bob->appendNumber("bloomFilterProbes", spec->bloomFilterProbes);
+            bob->appendNumber("bloomFilterRejected", spec->bloomFilterRejected);
+            bob->appendNumber("bloomFilterFalsePositives", spec->bloomFilterFalsePositives);
 
             for (size_t i = 0; i < spec->mapAfterChild.size(); ++i) {
                 bob->appendNumber(string(stream() << "mapAfterChild_" << i),
@@ -359,9 +370,26 @@ void Explain::statsToBSON(const PlanStageStats& stats,
         if (spec->maxTs) {
             bob->append("maxTs", *(spec->maxTs));
         }
+        if (spec->minRecord) {
+            bob->append("minRecord", spec->minRecord->repr());
+        }
+        if (spec->maxRecord) {
+            bob->append("maxRecord", spec->maxRecord->repr());
+        }
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
             bob->appendNumber("docsExamined", spec->docsTested);
         }
+    } else if (STAGE_COLUMN_SCAN == stats.stageType) {
+        ColumnScanStats* spec = static_cast<ColumnScanStats*>(stats.specific.get());
+
+        bob->append("keyPattern", spec->keyPattern);
+        bob->append("indexName", spec->indexName);
+        bob->append("fields", spec->fields);
+
+        if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
+            bob->appendNumber("keysExamined", spec->keysExamined);
+            bob->appendNumber("rowsTested", spec->rowsTested);
+        }
     } else if (STAGE_COUNT == stats.stageType) {
         CountStats* spec = static_cast<CountStats*>(stats.specific.get());
 
@@ -374,6 +402,7 @@ void Explain::statsToBSON(const PlanStageStats& stats,
 
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
             bob->appendNumber("keysExamined", spec->keysExamined);
+            bob->appendBool("countFromCache", spec->countFromCache);
         }
 
         bob->append("keyPattern", spec->keyPattern);
@@ -472,6 +501,7 @@ void Explain::statsToBSON(const PlanStageStats& stats,
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
             bob->appendNumber("keysExamined", spec->keysExamined);
             bob->appendNumber("docsExamined", spec->docsExamined);
+            bob->appendBool("docFromCache", spec->docFromCache);
         }
     } else if (STAGE_IXSCAN == stats.stageType) {
         IndexScanStats* spec = static_cast<IndexScanStats*>(stats.specific.get());
@@ -545,6 +575,20 @@ void Explain::statsToBSON(const PlanStageStats& stats,
             bob->appendNumber("dupsTested", spec->dupsTested);
             bob->appendNumber("dupsDropped", spec->dupsDropped);
         }
+    } else if (STAGE_SUBPLAN == stats.stageType) {
+        SubplanStats* spec = static_cast<SubplanStats*>(stats.specific.get());
+
+        if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
+            bob->appendNumber("branchesReused", spec->branchesReused);
+            BSONArrayBuilder branchesBob(bob->subarrayStart("branches"));
+            for (const auto& branch : spec->branchStats) {
+                BSONObjBuilder branchBob(branchesBob.subobjStart());
+                branchBob.append("planSource", branch.planSource);
+                branchBob.appendNumber("numCandidates", branch.numCandidates);
+                branchBob.appendNumber("planningTimeMicros", branch.planningTimeMicros);
+            }
+            branchesBob.doneFast();
+        }
     } else if (STAGE_TEXT == stats.stageType) {
         TextStats* spec = static_cast<TextStats*>(stats.specific.get());
 
@@ -564,6 +608,13 @@ void Explain::statsToBSON(const PlanStageStats& stats,
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
             bob->appendNumber("docsExamined", spec->fetches);
         }
+
+        if (spec->topK) {
+            bob->appendNumber("topK", spec->topK);
+            if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
+                bob->appendBool("stoppedEarly", spec->stoppedEarly);
+            }
+        }
     } else if (STAGE_UPDATE == stats.stageType) {
         UpdateStats* spec = static_cast<UpdateStats*>(stats.specific.get());
 
@@ -780,6 +831,19 @@ void Explain::generateExecutionInfo(PlanExecutor* exec,
     const auto winningExecStats = getWinningPlanStatsTree(exec);
     generateSinglePlanExecutionInfo(winningExecStats.get(), verbosity, totalTimeMillis, &execBob);
 
+    if (const WorkingSet* ws = exec->getWorkingSet()) {
+        const WorkingSetStats& wsStats = ws->getStats();
+        BSONObjBuilder wsBob(execBob.subobjStart("workingSet"));
+        wsBob.appendNumber("membersCreated", wsStats.membersCreated);
+        wsBob.appendNumber("membersReused", wsStats.membersReused);
+        wsBob.appendNumber("arenaBlocksAllocated", wsStats.arenaBlocksAllocated);
+        wsBob.appendNumber("arenaBlocksRewound", wsStats.arenaBlocksRewound);
+        wsBob.appendNumber("arenaObjsCopied", wsStats.arenaObjsCopied);
+        wsBob.appendNumber("arenaBytesCopied", wsStats.arenaBytesCopied);
+        wsBob.appendNumber("arenaObjsTooLarge", wsStats.arenaObjsTooLarge);
+        wsBob.doneFast();
+    }
+
     // Also generate exec stats for all plans, if the verbosity level is high enough.
     // These stats reflect what happened during the trial period that ranked the plans.
     if (verbosity >= ExplainOptions::Verbosity::kExecAllPlans) {
@@ -955,6 +1019,10 @@ void Explain::getSummaryStats(const PlanExecutor& exec, PlanSummaryStats* statsO
             const CountScanStats* countScanStats =
                 static_cast<const CountScanStats*>(countScan->getSpecificStats());
             statsOut->indexesUsed.insert(countScanStats->indexName);
+        } else if (STAGE_COLUMN_SCAN == stages[i]->stageType()) {
+            const ColumnScanStats* columnScanStats =
+                static_cast<const ColumnScanStats*>(stages[i]->getSpecificStats());
+            statsOut->indexesUsed.insert(columnScanStats->indexName);
         } else if (STAGE_IDHACK == stages[i]->stageType()) {
             const IDHackStage* idHackStage = static_cast<const IDHackStage*>(stages[i]);
             const IDHackStats* idHackStats =
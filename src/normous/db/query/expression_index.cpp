@@ -51,6 +51,16 @@ BSONObj ExpressionMapping::hash(const BSONElement& value) {
     return bob.obj();
 }
 
+BSONObj ExpressionMapping::hash(const BSONElement& value, const BSONObj& indexInfoObj) {
+    HashSeed seed;
+    int hashVersion;
+    ExpressionParams::parseHashFunctionParams(indexInfoObj, &seed, &hashVersion);
+
+    BSONObjBuilder bob;
+    bob.append("", BSONElementHasher::hash64(value, seed, hashVersion));
+    return bob.obj();
+}
+
 // For debugging only
 static std::string toCoveringString(const GeoHashConverter& hashConverter,
                                     const set<GeoHash>& covering) {
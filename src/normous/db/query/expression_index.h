@@ -50,6 +50,12 @@ class ExpressionMapping {
 public:
     static BSONObj hash(const BSONElement& value);
 
+    /**
+     * Hashes 'value' with the seed and hash version of the hashed index described by
+     * 'indexInfoObj'.
+     */
+    static BSONObj hash(const BSONElement& value, const BSONObj& indexInfoObj);
+
     static std::vector<GeoHash> get2dCovering(const R2Region& region,
                                               const BSONObj& indexInfoObj,
                                               int maxCoveringCells);
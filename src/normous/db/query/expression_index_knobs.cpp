@@ -41,4 +41,13 @@ MONGO_EXPORT_SERVER_PARAMETER(internalQueryS2GeoFinestLevel, int, 23);
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryS2GeoCoarsestLevel, int, 0);
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryS2GeoMaxCells, int, 20);
 
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(internalQueryS2GeoNearCoveringCacheSize, int, 1024)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0) {
+            return Status(ErrorCodes::BadValue,
+                          "internalQueryS2GeoNearCoveringCacheSize must be non-negative");
+        }
+        return Status::OK();
+    });
+
 }  // namespace mongo
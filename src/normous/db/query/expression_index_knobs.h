@@ -59,4 +59,8 @@ extern AtomicInt32 internalQueryS2GeoCoarsestLevel;
 // What is the maximum cell count that we want? (advisory, not a hard threshold)
 extern AtomicInt32 internalQueryS2GeoMaxCells;
 
+// How many $geoNear search annulus coverings do we remember across queries? Zero disables the
+// cache. Can only be set at startup.
+extern int internalQueryS2GeoNearCoveringCacheSize;
+
 }  // namespace mongo
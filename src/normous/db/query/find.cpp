@@ -398,6 +398,9 @@ Message getMore(OperationContext* opCtx,
         exec->reattachToOperationContext(opCtx);
         uassertStatusOK(exec->restoreState());
 
+        // Add this getMore's statistics to those of the shape of the cursor's query.
+        curOp.debug().queryStatsKey = cc->getQueryStatsKey();
+
         auto planSummary = Explain::getPlanSummary(exec);
         {
             stdx::lock_guard<Client> lk(*opCtx->getClient());
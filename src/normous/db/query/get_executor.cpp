@@ -64,6 +64,7 @@
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/plan_executor.h"
+#include "mongo/db/query/plan_pruner.h"
 #include "mongo/db/query/planner_access.h"
 #include "mongo/db/query/planner_analysis.h"
 #include "mongo/db/query/planner_wildcard_helpers.h"
@@ -71,6 +72,7 @@
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/query_planner_common.h"
 #include "mongo/db/query/query_settings.h"
+#include "mongo/db/query/query_stats_store.h"
 #include "mongo/db/query/stage_builder.h"
 #include "mongo/db/repl/optime.h"
 #include "mongo/db/repl/replication_coordinator.h"
@@ -132,22 +134,24 @@ IndexEntry indexEntryFromIndexCatalogEntry(OperationContext* opCtx, const IndexC
 
     const bool isMultikey = desc->isMultikey(opCtx);
 
-    return {desc->keyPattern(),
-            desc->getIndexType(),
-            isMultikey,
-            // The fixed-size vector of multikey paths stored in the index catalog.
-            ice.getMultikeyPaths(opCtx),
-            // The set of multikey paths from special metadata keys stored in the index itself.
-            // Indexes that have these metadata keys do not store a fixed-size vector of multikey
-            // metadata in the index catalog. Depending on the index type, an index uses one of
-            // these mechanisms (or neither), but not both.
-            isMultikey ? accessMethod->getMultikeyPathSet(opCtx) : std::set<FieldRef>{},
-            desc->isSparse(),
-            desc->unique(),
-            IndexEntry::Identifier{desc->indexName()},
-            ice.getFilterExpression(),
-            desc->infoObj(),
-            ice.getCollator()};
+    IndexEntry entry{desc->keyPattern(),
+                     desc->getIndexType(),
+                     isMultikey,
+                     // The fixed-size vector of multikey paths stored in the index catalog.
+                     ice.getMultikeyPaths(opCtx),
+                     // The set of multikey paths from special metadata keys stored in the index
+                     // itself. Indexes that have these metadata keys do not store a fixed-size
+                     // vector of multikey metadata in the index catalog. Depending on the index
+                     // type, an index uses one of these mechanisms (or neither), but not both.
+                     isMultikey ? accessMethod->getMultikeyPathSet(opCtx) : std::set<FieldRef>{},
+                     desc->isSparse(),
+                     desc->unique(),
+                     IndexEntry::Identifier{desc->indexName()},
+                     ice.getFilterExpression(),
+                     desc->infoObj(),
+                     ice.getCollator()};
+    entry.keyHistogram = ice.getKeyHistogram();
+    return entry;
 }
 
 void fillOutPlannerParams(OperationContext* opCtx,
@@ -208,6 +212,10 @@ void fillOutPlannerParams(OperationContext* opCtx,
         plannerParams->options |= QueryPlannerParams::INDEX_INTERSECTION;
     }
 
+    if (internalQueryPlannerEnableIndexSkipScan.load()) {
+        plannerParams->options |= QueryPlannerParams::INDEX_SKIP_SCAN;
+    }
+
     if (internalQueryPlannerGenerateCoveredWholeIndexScans.load()) {
         plannerParams->options |= QueryPlannerParams::GENERATE_COVERED_IXSCANS;
     }
@@ -218,6 +226,10 @@ void fillOutPlannerParams(OperationContext* opCtx,
             opCtx, collection, canonicalQuery->getQueryRequest().isTailable())) {
         plannerParams->options |= QueryPlannerParams::OPLOG_SCAN_WAIT_FOR_VISIBLE;
     }
+
+    if (collection->getRecordStore()->isClustered()) {
+        plannerParams->options |= QueryPlannerParams::CLUSTERED_COLLECTION;
+    }
 }
 
 bool shouldWaitForOplogVisibility(OperationContext* opCtx,
@@ -305,10 +317,41 @@ StatusWith<PrepareExecutionResult> prepareExecution(OperationContext* opCtx,
         canonicalQuery->setCollator(collection->getDefaultCollator()->clone());
     }
 
+    // Attribute this operation, and any getMores on its cursor, to the shape of its query. Only the
+    // outermost query of an operation is tracked.
+    auto& opDebug = CurOp::get(opCtx)->debug();
+    if (QueryStatsStore::isEnabled() && opDebug.queryStatsKey.empty()) {
+        const auto planCacheKey =
+            collection->infoCache()->getPlanCache()->computeKey(*canonicalQuery);
+        opDebug.queryStatsKey = QueryStatsStore::makeKey(canonicalQuery->nss(), planCacheKey);
+
+        const auto& qr = canonicalQuery->getQueryRequest();
+        QueryStatsStore::get(opCtx).registerShape(
+            opDebug.queryStatsKey,
+            canonicalQuery->nss(),
+            PlanCache::computeQueryHash(planCacheKey),
+            opCtx->getServiceContext()->getFastClockSource()->now(),
+            [&qr] {
+                BSONObjBuilder bob;
+                bob.append("filter", qr.getFilter());
+                if (!qr.getSort().isEmpty()) {
+                    bob.append("sort", qr.getSort());
+                }
+                if (!qr.getProj().isEmpty()) {
+                    bob.append("projection", qr.getProj());
+                }
+                if (!qr.getCollation().isEmpty()) {
+                    bob.append("collation", qr.getCollation());
+                }
+                return bob.obj();
+            });
+    }
+
     const IndexDescriptor* descriptor = collection->getIndexCatalog()->findIdIndex(opCtx);
+    const bool isClustered = collection->getRecordStore()->isClustered();
 
-    // If we have an _id index we can use an idhack plan.
-    if (descriptor && IDHackStage::supportsQuery(collection, *canonicalQuery)) {
+    // If we have an _id index, or the records are keyed by _id, we can use an idhack plan.
+    if ((descriptor || isClustered) && IDHackStage::supportsQuery(collection, *canonicalQuery)) {
         LOG(2) << "Using idhack: " << redact(canonicalQuery->toStringShort());
 
         root = make_unique<IDHackStage>(opCtx, collection, canonicalQuery.get(), ws, descriptor);
@@ -366,6 +409,10 @@ StatusWith<PrepareExecutionResult> prepareExecution(OperationContext* opCtx,
         }
     }
 
+    // Everything from here on is plan selection; candidate plans' trial runs are timed separately
+    // by PlanExecutor::pickBestPlan().
+    CurOp::PhaseTimer planningTimer(opCtx, CurOp::Phase::kPlanning);
+
     // Check that the query should be cached.
     if (collection->infoCache()->getPlanCache()->shouldCacheQuery(*canonicalQuery)) {
         auto planCacheKey = collection->infoCache()->getPlanCache()->computeKey(*canonicalQuery);
@@ -451,6 +498,19 @@ StatusWith<PrepareExecutionResult> prepareExecution(OperationContext* opCtx,
         }
     }
 
+    // Drop the candidates which the index statistics show to be much worse than another one, which
+    // may leave too few to need multi-planning.
+    const double pruneRatio = internalQueryPlannerStatisticsPruneRatio.load();
+    if (solutions.size() > 1 && pruneRatio > 0) {
+        const size_t numPruned = PlanPruner::prune(
+            *canonicalQuery, collection->numRecords(opCtx), pruneRatio, &solutions);
+        if (numPruned > 0) {
+            LOG(2) << "Pruned " << numPruned << " of " << (solutions.size() + numPruned)
+                   << " candidate plans using index statistics: "
+                   << redact(canonicalQuery->toStringShort());
+        }
+    }
+
     if (1 == solutions.size()) {
         // Only one possible plan.  Run it.  Build the stages from the solution.
         PlanStage* rawRoot;
@@ -804,6 +864,7 @@ StatusWith<unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorDelete(
         }
 
         const IndexDescriptor* descriptor = collection->getIndexCatalog()->findIdIndex(opCtx);
+        const bool isClustered = collection->getRecordStore()->isClustered();
 
         // Construct delete request collator.
         std::unique_ptr<CollatorInterface> collator;
@@ -818,7 +879,7 @@ StatusWith<unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorDelete(
         const bool hasCollectionDefaultCollation = request->getCollation().isEmpty() ||
             CollatorInterface::collatorsMatch(collator.get(), collection->getDefaultCollator());
 
-        if (descriptor && CanonicalQuery::isSimpleIdQuery(unparsedQuery) &&
+        if ((descriptor || isClustered) && CanonicalQuery::isSimpleIdQuery(unparsedQuery) &&
             request->getProj().isEmpty() && hasCollectionDefaultCollation) {
             LOG(2) << "Using idhack: " << redact(unparsedQuery);
 
@@ -952,11 +1013,12 @@ StatusWith<unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorUpdate(
         }
 
         const IndexDescriptor* descriptor = collection->getIndexCatalog()->findIdIndex(opCtx);
+        const bool isClustered = collection->getRecordStore()->isClustered();
 
         const bool hasCollectionDefaultCollation = CollatorInterface::collatorsMatch(
             parsedUpdate->getCollator(), collection->getDefaultCollator());
 
-        if (descriptor && CanonicalQuery::isSimpleIdQuery(unparsedQuery) &&
+        if ((descriptor || isClustered) && CanonicalQuery::isSimpleIdQuery(unparsedQuery) &&
             request->getProj().isEmpty() && hasCollectionDefaultCollation) {
             LOG(2) << "Using idhack: " << redact(unparsedQuery);
 
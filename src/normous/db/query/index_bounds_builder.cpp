@@ -36,6 +36,7 @@
 #include "mongo/base/string_data.h"
 #include "mongo/db/geo/geoconstants.h"
 #include "mongo/db/geo/s2.h"
+#include "mongo/db/hasher.h"
 #include "mongo/db/index/expression_params.h"
 #include "mongo/db/index/s2_common.h"
 #include "mongo/db/matcher/expression_geo.h"
@@ -119,6 +120,28 @@ const Interval kHashedUndefinedInterval = IndexBoundsBuilder::makePointInterval(
 const Interval kHashedNullInterval =
     IndexBoundsBuilder::makePointInterval(ExpressionMapping::hash(kNullElementObj.firstElement()));
 
+/**
+ * Returns true if 'index' hashes its keys with the default seed and hash version, so that the
+ * precomputed hashed intervals above apply to it.
+ */
+bool usesDefaultHashFunction(const IndexEntry& index) {
+    HashSeed seed;
+    int hashVersion;
+    ExpressionParams::parseHashFunctionParams(index.infoObj, &seed, &hashVersion);
+    return seed == BSONElementHasher::DEFAULT_HASH_SEED &&
+        hashVersion == BSONElementHasher::MD5_HASH_VERSION;
+}
+
+Interval makeHashedPointInterval(const BSONObj& elementObj,
+                                 const Interval& defaultHashedInterval,
+                                 const IndexEntry& index) {
+    if (usesDefaultHashFunction(index)) {
+        return defaultHashedInterval;
+    }
+    return IndexBoundsBuilder::makePointInterval(
+        ExpressionMapping::hash(elementObj.firstElement(), index.infoObj));
+}
+
 void makeNullEqualityBounds(const IndexEntry& index,
                             bool isHashed,
                             OrderedIntervalList* oil,
@@ -128,11 +151,12 @@ void makeNullEqualityBounds(const IndexEntry& index,
     *tightnessOut = IndexBoundsBuilder::INEXACT_FETCH;
 
     // There are two values that could possibly be equal to null in an index: undefined and null.
-    oil->intervals.push_back(isHashed
-                                 ? kHashedUndefinedInterval
-                                 : IndexBoundsBuilder::makePointInterval(kUndefinedElementObj));
-    oil->intervals.push_back(isHashed ? kHashedNullInterval
-                                      : IndexBoundsBuilder::makePointInterval(kNullElementObj));
+    oil->intervals.push_back(
+        isHashed ? makeHashedPointInterval(kUndefinedElementObj, kHashedUndefinedInterval, index)
+                 : IndexBoundsBuilder::makePointInterval(kUndefinedElementObj));
+    oil->intervals.push_back(
+        isHashed ? makeHashedPointInterval(kNullElementObj, kHashedNullInterval, index)
+                 : IndexBoundsBuilder::makePointInterval(kNullElementObj));
     // Just to be sure, make sure the bounds are in the right order if the hash values are opposite.
     IndexBoundsBuilder::unionize(oil);
 }
@@ -948,7 +972,7 @@ void IndexBoundsBuilder::translateEquality(const BSONElement& data,
     if (BSONType::Array != data.type()) {
         BSONObj dataObj = objFromElement(data, index.collator);
         if (isHashed) {
-            dataObj = ExpressionMapping::hash(dataObj.firstElement());
+            dataObj = ExpressionMapping::hash(dataObj.firstElement(), index.infoObj);
         }
 
         verify(dataObj.isOwned());
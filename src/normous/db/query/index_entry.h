@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <memory>
 #include <set>
 #include <string>
 
@@ -40,6 +41,7 @@
 namespace mongo {
 
 class CollatorInterface;
+class IndexKeyHistogram;
 class MatchExpression;
 
 /**
@@ -217,6 +219,10 @@ struct IndexEntry {
     // Null if this index orders strings according to the simple binary compare. If non-null,
     // represents the collator used to generate index keys for indexed strings.
     const CollatorInterface* collator = nullptr;
+
+    // Statistics about the keys of the index, if any were gathered. Used to estimate how many keys
+    // a scan over the index examines.
+    std::shared_ptr<const IndexKeyHistogram> keyHistogram;
 };
 
 std::ostream& operator<<(std::ostream& stream, const IndexEntry::Identifier& ident);
@@ -169,6 +169,21 @@ public:
         return Status::OK();
     }
 
+    /**
+     * Removes the least recently used entry and passes ownership of it to the caller. Returns
+     * nullptr if the kv-store is empty.
+     */
+    std::unique_ptr<V> removeLeastRecentlyUsed() {
+        if (_kvList.empty()) {
+            return std::unique_ptr<V>();
+        }
+        std::unique_ptr<V> evictedEntry(_kvList.back().second);
+        _kvMap.erase(_kvList.back().first);
+        _kvList.pop_back();
+        _currentSize--;
+        return evictedEntry;
+    }
+
     /**
      * Deletes all entries in the kv-store.
      */
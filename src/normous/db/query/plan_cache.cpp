@@ -382,6 +382,20 @@ void encodeRegexFlagsForMatch(const std::vector<const RegexMatchExpression*>& re
                               StringBuilder* keyBuilder) {
     encodeRegexFlagsForMatch(regexes.begin(), regexes.end(), keyBuilder);
 }
+/**
+ * Returns an estimate of the memory used by 'entry'. The collator and partial filter expression
+ * are owned by the index catalog rather than by the copy, so they are not counted.
+ */
+uint64_t estimateIndexEntrySizeInBytes(const IndexEntry& entry) {
+    return sizeof(entry) + entry.keyPattern.objsize() + entry.infoObj.objsize() +
+        entry.identifier.catalogName.capacity() + entry.identifier.disambiguator.capacity() +
+        entry.multikeyPaths.capacity() * sizeof(MultikeyPaths::value_type) +
+        entry.multikeyPathSet.size() * sizeof(FieldRef);
+}
+
+// Estimated bytes used by the entries of every plan cache in the process.
+Counter64 planCacheTotalSizeEstimateBytes;
+
 }  // namespace
 
 //
@@ -513,6 +527,19 @@ PlanCacheEntry* PlanCacheEntry::clone() const {
     return entry;
 }
 
+uint64_t PlanCacheEntry::estimateObjectSizeInBytes() const {
+    uint64_t size = sizeof(*this) + query.objsize() + sort.objsize() + projection.objsize() +
+        collation.objsize() + plannerData.capacity() * sizeof(SolutionCacheData*) +
+        feedback.capacity() * sizeof(double);
+    for (auto&& data : plannerData) {
+        size += data->estimateObjectSizeInBytes();
+    }
+    if (decision) {
+        size += decision->estimateObjectSizeInBytes();
+    }
+    return size;
+}
+
 std::string PlanCacheEntry::toString() const {
     return str::stream() << "(query: " << query.toString() << ";sort: " << sort.toString()
                          << ";projection: " << projection.toString()
@@ -551,6 +578,23 @@ PlanCacheIndexTree* PlanCacheIndexTree::clone() const {
     return root;
 }
 
+uint64_t PlanCacheIndexTree::estimateObjectSizeInBytes() const {
+    uint64_t size = sizeof(*this) + children.capacity() * sizeof(PlanCacheIndexTree*) +
+        orPushdowns.capacity() * sizeof(OrPushdown);
+    if (entry) {
+        size += estimateIndexEntrySizeInBytes(*entry);
+    }
+    for (auto&& orPushdown : orPushdowns) {
+        size += orPushdown.indexEntryId.catalogName.capacity() +
+            orPushdown.indexEntryId.disambiguator.capacity() +
+            orPushdown.route.size() * sizeof(size_t);
+    }
+    for (auto&& child : children) {
+        size += child->estimateObjectSizeInBytes();
+    }
+    return size;
+}
+
 std::string PlanCacheIndexTree::toString(int indents) const {
     StringBuilder result;
     if (!children.empty()) {
@@ -603,6 +647,10 @@ SolutionCacheData* SolutionCacheData::clone() const {
     return other;
 }
 
+uint64_t SolutionCacheData::estimateObjectSizeInBytes() const {
+    return sizeof(*this) + (tree ? tree->estimateObjectSizeInBytes() : 0);
+}
+
 std::string SolutionCacheData::toString() const {
     switch (this->solnType) {
         case WHOLE_IXSCAN_SOLN:
@@ -630,7 +678,20 @@ PlanCache::PlanCache(size_t size) : _cache(size) {}
 
 PlanCache::PlanCache(const std::string& ns) : _cache(internalQueryCacheSize.load()), _ns(ns) {}
 
-PlanCache::~PlanCache() {}
+PlanCache::~PlanCache() {
+    planCacheTotalSizeEstimateBytes.decrement(_sizeBytes);
+}
+
+void PlanCache::_addToSize_inlock(uint64_t bytes) {
+    _sizeBytes += bytes;
+    planCacheTotalSizeEstimateBytes.increment(bytes);
+}
+
+void PlanCache::_subtractFromSize_inlock(uint64_t bytes) {
+    invariant(bytes <= _sizeBytes);
+    _sizeBytes -= bytes;
+    planCacheTotalSizeEstimateBytes.decrement(bytes);
+}
 
 std::unique_ptr<CachedSolution> PlanCache::getCacheEntryIfActive(const PlanCacheKey& key) const {
 
@@ -932,13 +993,38 @@ Status PlanCache::set(const CanonicalQuery& query,
     }
     newEntry->projection = projBuilder.obj();
 
+    // Feedback is appended to the entry after it is cached, so account for all of it up front.
+    newEntry->feedback.reserve(std::max(0, internalQueryCacheFeedbacksStored.load()));
+    newEntry->estimatedEntrySizeBytes = newEntry->estimateObjectSizeInBytes();
+
+    // Adding an entry under an existing key replaces (and frees) the existing entry.
+    PlanCacheEntry* replacedEntry = nullptr;
+    if (_cache.get(key, &replacedEntry).isOK()) {
+        _subtractFromSize_inlock(replacedEntry->estimatedEntrySizeBytes);
+    }
+
+    _addToSize_inlock(newEntry->estimatedEntrySizeBytes);
     std::unique_ptr<PlanCacheEntry> evictedEntry = _cache.add(key, newEntry.release());
 
     if (NULL != evictedEntry.get()) {
+        _subtractFromSize_inlock(evictedEntry->estimatedEntrySizeBytes);
         LOG(1) << _ns << ": plan cache maximum size exceeded - "
                << "removed least recently used entry " << redact(evictedEntry->toString());
     }
 
+    // Enforce the budget shared by all plan caches by evicting this cache's least recently used
+    // entries. The entry just added is always kept.
+    const uint64_t budgetBytes =
+        static_cast<uint64_t>(internalQueryCacheTotalSizeBudgetMegabytes.load()) * 1024 * 1024;
+    while (budgetBytes && planCacheTotalSizeEstimateBytes.get() > budgetBytes &&
+           _cache.size() > 1) {
+        std::unique_ptr<PlanCacheEntry> lruEntry = _cache.removeLeastRecentlyUsed();
+        invariant(lruEntry);
+        _subtractFromSize_inlock(lruEntry->estimatedEntrySizeBytes);
+        LOG(1) << _ns << ": plan cache memory budget exceeded - "
+               << "removed least recently used entry " << redact(lruEntry->toString());
+    }
+
     return Status::OK();
 }
 
@@ -1000,13 +1086,21 @@ Status PlanCache::feedback(const CanonicalQuery& cq, double score) {
 }
 
 Status PlanCache::remove(const CanonicalQuery& canonicalQuery) {
+    const auto key = computeKey(canonicalQuery);
     stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
-    return _cache.remove(computeKey(canonicalQuery));
+    PlanCacheEntry* entry = nullptr;
+    Status cacheStatus = _cache.get(key, &entry);
+    if (!cacheStatus.isOK()) {
+        return cacheStatus;
+    }
+    _subtractFromSize_inlock(entry->estimatedEntrySizeBytes);
+    return _cache.remove(key);
 }
 
 void PlanCache::clear() {
     stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
     _cache.clear();
+    _subtractFromSize_inlock(_sizeBytes);
 }
 
 PlanCacheKey PlanCache::computeKey(const CanonicalQuery& cq) const {
@@ -1052,6 +1146,16 @@ size_t PlanCache::size() const {
     return _cache.size();
 }
 
+uint64_t PlanCache::sizeBytes() const {
+    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
+    return _sizeBytes;
+}
+
+// static
+const Counter64& PlanCache::getTotalSizeEstimateBytes() {
+    return planCacheTotalSizeEstimateBytes;
+}
+
 void PlanCache::notifyOfIndexEntries(const std::vector<IndexEntry>& indexEntries) {
     _indexabilityState.updateDiscriminators(indexEntries);
 }
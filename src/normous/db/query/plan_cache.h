@@ -31,6 +31,7 @@
 #include <boost/optional/optional.hpp>
 #include <set>
 
+#include "mongo/base/counter.h"
 #include "mongo/db/exec/plan_stats.h"
 #include "mongo/db/query/canonical_query.h"
 #include "mongo/db/query/index_tag.h"
@@ -108,6 +109,11 @@ struct PlanCacheIndexTree {
      */
     std::string toString(int indents = 0) const;
 
+    /**
+     * Returns an estimate of the memory used by this tree, including its children.
+     */
+    uint64_t estimateObjectSizeInBytes() const;
+
     // Children owned here.
     std::vector<PlanCacheIndexTree*> children;
 
@@ -143,6 +149,9 @@ struct SolutionCacheData {
     // For debugging.
     std::string toString() const;
 
+    // Returns an estimate of the memory used by this object, including the tree it owns.
+    uint64_t estimateObjectSizeInBytes() const;
+
     // Owned here. If 'wholeIXSoln' is false, then 'tree'
     // can be used to tag an isomorphic match expression. If 'wholeIXSoln'
     // is true, then 'tree' is used to store the relevant IndexEntry.
@@ -235,6 +244,12 @@ public:
     // For debugging.
     std::string toString() const;
 
+    /**
+     * Returns an estimate of the memory used by this entry, including its planner data, the
+     * example query and the ranking decision's stats.
+     */
+    uint64_t estimateObjectSizeInBytes() const;
+
     //
     // Planner data
     //
@@ -279,6 +294,10 @@ public:
     // trigger a replan. Running a query of the same shape while this cache entry is inactive may
     // cause this value to be increased.
     size_t works = 0;
+
+    // The estimated size of this entry, as computed when it was added to the cache and accounted
+    // against the plan cache memory budget.
+    uint64_t estimatedEntrySizeBytes = 0;
 };
 
 /**
@@ -450,6 +469,17 @@ public:
      */
     size_t size() const;
 
+    /**
+     * Returns the estimated number of bytes used by the entries in this cache.
+     */
+    uint64_t sizeBytes() const;
+
+    /**
+     * Returns the estimated number of bytes used by the entries of every plan cache in the
+     * process. Entries are evicted once this exceeds internalQueryCacheTotalSizeBudgetMegabytes.
+     */
+    static const Counter64& getTotalSizeEstimateBytes();
+
     /**
      * Updates internal state kept about the collection's indexes.  Must be called when the set
      * of indexes on the associated collection have changed.
@@ -482,11 +512,19 @@ private:
     void encodeKeyForSort(const BSONObj& sortObj, StringBuilder* keyBuilder) const;
     void encodeKeyForProj(const BSONObj& projObj, StringBuilder* keyBuilder) const;
 
+    // Adjusts both this cache's and the process-wide size accounting. Callers must hold
+    // '_cacheMutex'.
+    void _addToSize_inlock(uint64_t bytes);
+    void _subtractFromSize_inlock(uint64_t bytes);
+
     LRUKeyValue<PlanCacheKey, PlanCacheEntry> _cache;
 
-    // Protects _cache.
+    // Protects _cache and _sizeBytes.
     mutable stdx::mutex _cacheMutex;
 
+    // Sum of 'estimatedEntrySizeBytes' over the entries in '_cache'.
+    uint64_t _sizeBytes = 0;
+
     // Full namespace of collection.
     std::string _ns;
 
@@ -0,0 +1,159 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/matcher/extensions_callback_noop.h"
+#include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/plan_cache.h"
+#include "mongo/db/query/plan_ranker.h"
+#include "mongo/db/query/query_solution.h"
+#include "mongo/db/query/query_test_service_context.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString nss("test.collection");
+
+std::unique_ptr<CanonicalQuery> canonicalize(OperationContext* opCtx,
+                                             const BSONObj& filter,
+                                             const BSONObj& sort = BSONObj()) {
+    auto qr = stdx::make_unique<QueryRequest>(nss);
+    qr->setFilter(filter);
+    qr->setSort(sort);
+    const boost::intrusive_ptr<ExpressionContext> expCtx;
+    return uassertStatusOK(
+        CanonicalQuery::canonicalize(opCtx,
+                                     std::move(qr),
+                                     expCtx,
+                                     ExtensionsCallbackNoop(),
+                                     MatchExpressionParser::kAllowAllSpecialFeatures));
+}
+
+std::unique_ptr<PlanRankingDecision> createDecision() {
+    auto why = stdx::make_unique<PlanRankingDecision>();
+    CommonStats common("COLLSCAN");
+    auto stats = stdx::make_unique<PlanStageStats>(common, STAGE_COLLSCAN);
+    stats->specific.reset(new CollectionScanStats());
+    why->stats.push_back(std::move(stats));
+    why->scores.push_back(0U);
+    why->candidateOrder.push_back(0);
+    return why;
+}
+
+// Caches a collection scan plan for the shape of 'cq'.
+void addEntry(PlanCache* planCache, const CanonicalQuery& cq) {
+    QuerySolution qs;
+    qs.cacheData.reset(new SolutionCacheData());
+    qs.cacheData->solnType = SolutionCacheData::COLLSCAN_SOLN;
+    qs.cacheData->tree.reset(new PlanCacheIndexTree());
+    std::vector<QuerySolution*> solns = {&qs};
+    uassertStatusOK(planCache->set(cq, solns, createDecision(), Date_t{}));
+}
+
+// A shape with several predicates and a sort, so computing its key walks a non-trivial tree.
+BSONObj makeFilter(int shape) {
+    BSONObjBuilder builder;
+    builder.append(str::stream() << "a" << shape, 1);
+    builder.append("b", BSON("$gt" << 5));
+    builder.append("c", BSON("$in" << BSON_ARRAY(1 << 2 << 3)));
+    return builder.obj();
+}
+
+void BM_CanonicalizeQuery(benchmark::State& state) {
+    QueryTestServiceContext serviceContext;
+    auto opCtx = serviceContext.makeOperationContext();
+    const auto filter = makeFilter(0);
+    for (auto keepRunning : state) {
+        benchmark::DoNotOptimize(canonicalize(opCtx.get(), filter, BSON("d" << 1)));
+    }
+}
+
+void BM_PlanCacheComputeKey(benchmark::State& state) {
+    QueryTestServiceContext serviceContext;
+    auto opCtx = serviceContext.makeOperationContext();
+    const auto cq = canonicalize(opCtx.get(), makeFilter(0), BSON("d" << 1));
+    PlanCache planCache;
+    for (auto keepRunning : state) {
+        benchmark::DoNotOptimize(planCache.computeKey(*cq));
+    }
+}
+
+// Looks up a cached shape in a cache holding 'state.range(0)' entries.
+void BM_PlanCacheGetHit(benchmark::State& state) {
+    QueryTestServiceContext serviceContext;
+    auto opCtx = serviceContext.makeOperationContext();
+    PlanCache planCache;
+    for (int i = 0; i < state.range(0); ++i) {
+        addEntry(&planCache, *canonicalize(opCtx.get(), makeFilter(i)));
+    }
+    const auto cq = canonicalize(opCtx.get(), makeFilter(state.range(0) / 2));
+    for (auto keepRunning : state) {
+        benchmark::DoNotOptimize(planCache.get(*cq));
+    }
+}
+
+void BM_PlanCacheGetMiss(benchmark::State& state) {
+    QueryTestServiceContext serviceContext;
+    auto opCtx = serviceContext.makeOperationContext();
+    PlanCache planCache;
+    for (int i = 0; i < state.range(0); ++i) {
+        addEntry(&planCache, *canonicalize(opCtx.get(), makeFilter(i)));
+    }
+    const auto cq = canonicalize(opCtx.get(), makeFilter(-1));
+    for (auto keepRunning : state) {
+        benchmark::DoNotOptimize(planCache.get(*cq));
+    }
+}
+
+// Looks up by a precomputed key, as the planner does after computing the key once per query.
+void BM_PlanCacheGetByKey(benchmark::State& state) {
+    QueryTestServiceContext serviceContext;
+    auto opCtx = serviceContext.makeOperationContext();
+    PlanCache planCache;
+    for (int i = 0; i < state.range(0); ++i) {
+        addEntry(&planCache, *canonicalize(opCtx.get(), makeFilter(i)));
+    }
+    const auto key = planCache.computeKey(*canonicalize(opCtx.get(), makeFilter(0)));
+    for (auto keepRunning : state) {
+        benchmark::DoNotOptimize(planCache.get(key));
+    }
+}
+
+BENCHMARK(BM_CanonicalizeQuery);
+BENCHMARK(BM_PlanCacheComputeKey);
+BENCHMARK(BM_PlanCacheGetHit)->Arg(10)->Arg(1000);
+BENCHMARK(BM_PlanCacheGetMiss)->Arg(10)->Arg(1000);
+BENCHMARK(BM_PlanCacheGetByKey)->Arg(1000);
+
+}  // namespace
+}  // namespace mongo
@@ -554,6 +554,62 @@ TEST(PlanCacheTest, PlanCacheFlushDeletesInactiveEntries) {
     ASSERT_EQ(planCache.get(*cq).state, PlanCache::CacheEntryState::kNotPresent);
 }
 
+TEST(PlanCacheTest, SizeEstimateTracksAddRemoveAndClear) {
+    PlanCache planCache;
+    QueryTestServiceContext serviceContext;
+    const auto totalBefore = PlanCache::getTotalSizeEstimateBytes().get();
+    ASSERT_EQ(planCache.sizeBytes(), 0U);
+
+    unique_ptr<CanonicalQuery> cqA(canonicalize("{a: 1}"));
+    addCacheEntryForShape(*cqA.get(), &planCache);
+    const auto sizeAfterOneEntry = planCache.sizeBytes();
+    ASSERT_GT(sizeAfterOneEntry, 0U);
+
+    // Replacing the entry for an existing shape must not double count it.
+    addCacheEntryForShape(*cqA.get(), &planCache);
+    ASSERT_EQ(planCache.sizeBytes(), sizeAfterOneEntry);
+
+    unique_ptr<CanonicalQuery> cqB(canonicalize("{b: 1}"));
+    addCacheEntryForShape(*cqB.get(), &planCache);
+    ASSERT_GT(planCache.sizeBytes(), sizeAfterOneEntry);
+    ASSERT_EQ(PlanCache::getTotalSizeEstimateBytes().get(), totalBefore + planCache.sizeBytes());
+
+    ASSERT_OK(planCache.remove(*cqB));
+    ASSERT_EQ(planCache.sizeBytes(), sizeAfterOneEntry);
+
+    planCache.clear();
+    ASSERT_EQ(planCache.sizeBytes(), 0U);
+    ASSERT_EQ(PlanCache::getTotalSizeEstimateBytes().get(), totalBefore);
+}
+
+TEST(PlanCacheTest, TotalSizeBudgetEvictsLeastRecentlyUsedEntries) {
+    const auto oldBudget = internalQueryCacheTotalSizeBudgetMegabytes.load();
+    ON_BLOCK_EXIT([&] { internalQueryCacheTotalSizeBudgetMegabytes.store(oldBudget); });
+    internalQueryCacheTotalSizeBudgetMegabytes.store(1);
+    const uint64_t kBudgetBytes = 1024 * 1024;
+
+    PlanCache planCache(100000);
+    QueryTestServiceContext serviceContext;
+    ASSERT_LT(PlanCache::getTotalSizeEstimateBytes().get(), kBudgetBytes);
+
+    unique_ptr<CanonicalQuery> cqFirst(canonicalize("{a0: 1}"));
+    addCacheEntryForShape(*cqFirst.get(), &planCache);
+    const auto entrySize = planCache.sizeBytes();
+
+    // Add enough distinct shapes to overflow the budget.
+    const size_t numEntries = kBudgetBytes / entrySize + 10;
+    for (size_t i = 1; i < numEntries; ++i) {
+        unique_ptr<CanonicalQuery> cq(canonicalize(BSON("a" + std::to_string(i) << 1)));
+        addCacheEntryForShape(*cq.get(), &planCache);
+    }
+
+    ASSERT_LT(planCache.size(), numEntries);
+    ASSERT_LTE(PlanCache::getTotalSizeEstimateBytes().get(), kBudgetBytes);
+
+    // The first entry added was the least recently used, so it was evicted first.
+    ASSERT_EQ(planCache.get(*cqFirst).state, PlanCache::CacheEntryState::kNotPresent);
+}
+
 TEST(PlanCacheTest, AddActiveCacheEntry) {
     PlanCache planCache;
     unique_ptr<CanonicalQuery> cq(canonicalize("{a: 1}"));
@@ -1178,6 +1234,46 @@ TEST_F(CachePlanSelectionTest, EqualityIndexScanWithTrailingFields) {
         BSON("x" << 5), "{fetch: {filter: null, node: {ixscan: {pattern: {x: 1, y: 1}}}}}");
 }
 
+TEST_F(CachePlanSelectionTest, EqualityIndexScanBindsNewConstant) {
+    addIndex(BSON("x" << 1), "x_1");
+    runQuery(BSON("x" << 5));
+
+    auto bestSoln =
+        firstMatchingSolution("{fetch: {filter: null, node: {ixscan: {pattern: {x: 1}}}}}");
+    auto planSoln = planQueryFromCache(BSON("x" << 7), BSONObj(), BSONObj(), BSONObj(), *bestSoln);
+    assertSolutionMatches(planSoln.get(),
+                          "{fetch: {filter: null, node: {ixscan: {pattern: {x: 1}, "
+                          "bounds: {x: [[7, 7, true, true]]}}}}}");
+}
+
+TEST_F(CachePlanSelectionTest, CompoundEqualityIndexScanBindsNewConstants) {
+    addIndex(BSON("x" << 1 << "y" << -1 << "z" << 1), "x_1_y_-1_z_1");
+    runQuery(BSON("x" << 5 << "y" << "a"));
+
+    auto bestSoln = firstMatchingSolution(
+        "{fetch: {filter: null, node: {ixscan: {pattern: {x: 1, y: -1, z: 1}}}}}");
+    auto planSoln = planQueryFromCache(
+        BSON("x" << 6 << "y" << "b"), BSONObj(), BSONObj(), BSONObj(), *bestSoln);
+    assertSolutionMatches(planSoln.get(),
+                          "{fetch: {filter: null, node: {ixscan: {pattern: {x: 1, y: -1, z: 1}, "
+                          "bounds: {x: [[6, 6, true, true]], y: [['b', 'b', true, true]], "
+                          "z: [['MinKey', 'MaxKey', true, true]]}}}}}");
+}
+
+TEST_F(CachePlanSelectionTest, EqualityToNullFromCacheKeepsFilter) {
+    addIndex(BSON("x" << 1), "x_1");
+    runQuery(BSON("x" << 5));
+
+    // Equality to null does not produce exact bounds, so the cached plan must be re-planned from
+    // its index tags and keep a residual filter.
+    auto bestSoln =
+        firstMatchingSolution("{fetch: {filter: null, node: {ixscan: {pattern: {x: 1}}}}}");
+    auto planSoln =
+        planQueryFromCache(BSON("x" << BSONNULL), BSONObj(), BSONObj(), BSONObj(), *bestSoln);
+    assertSolutionMatches(planSoln.get(),
+                          "{fetch: {filter: {x: null}, node: {ixscan: {pattern: {x: 1}}}}}");
+}
+
 //
 // Geo
 //
@@ -34,6 +34,7 @@
 
 #include "mongo/db/query/index_tag.h"
 #include "mongo/db/query/indexability.h"
+#include "mongo/db/query/planner_ixselect.h"
 #include "mongo/util/log.h"
 #include "mongo/util/string_map.h"
 
@@ -260,6 +261,7 @@ PlanEnumerator::PlanEnumerator(const PlanEnumeratorParams& params)
     : _root(params.root),
       _indices(params.indices),
       _ixisect(params.intersect),
+      _skipScan(params.skipScan),
       _orLimit(params.maxSolutionsPerOr),
       _intersectLimit(params.maxIntersectPerAnd) {}
 
@@ -983,6 +985,42 @@ void PlanEnumerator::enumerateOneIndex(
             andAssignment->choices.push_back(std::move(state));
         }
     }
+
+    if (!_skipScan) {
+        return;
+    }
+
+    // An index with predicates over its second field but none over its leading field can still
+    // be used by scanning all values of the leading field, seeking from each leading value to the
+    // range of the second field. How cheap that is depends on the number of distinct leading
+    // values, so the planner lets these plans compete against a collection scan.
+    for (IndexToPredMap::const_iterator it = idxToNotFirst.begin(); it != idxToNotFirst.end();
+         ++it) {
+        const IndexEntry& thisIndex = (*_indices)[it->first];
+        if (idxToFirst.find(it->first) != idxToFirst.end() ||
+            !QueryPlannerIXSelect::canUseForSkipScan(thisIndex)) {
+            continue;
+        }
+
+        OneIndexAssignment indexAssign;
+        indexAssign.index = it->first;
+
+        bool hasPredOverSecondField = false;
+        for (auto pred : it->second) {
+            const size_t position = getPosition(thisIndex, pred);
+            hasPredOverSecondField = hasPredOverSecondField || (1U == position);
+            assignPredicate(outsidePreds, pred, position, &indexAssign);
+        }
+
+        // Do not output this assignment if it consists only of outside predicates, or if more than
+        // the leading field would have to be skipped over.
+        if (hasPredOverSecondField && !indexAssign.preds.empty()) {
+            AndEnumerableState state;
+            state.assignments.push_back(std::move(indexAssign));
+            andAssignment->choices.push_back(std::move(state));
+            _hasSkipScanAssignments = true;
+        }
+    }
 }
 
 void PlanEnumerator::enumerateAndIntersect(const IndexToPredMap& idxToFirst,
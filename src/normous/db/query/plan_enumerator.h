@@ -43,6 +43,7 @@ namespace mongo {
 struct PlanEnumeratorParams {
     PlanEnumeratorParams()
         : intersect(false),
+          skipScan(false),
           maxSolutionsPerOr(internalQueryEnumerationMaxOrSolutions.load()),
           maxIntersectPerAnd(internalQueryEnumerationMaxIntersectPerAnd.load()) {}
 
@@ -50,6 +51,10 @@ struct PlanEnumeratorParams {
     // an indexed solution?
     bool intersect;
 
+    // Do we provide solutions that skip scan a compound index whose leading field has no
+    // predicates over it?
+    bool skipScan;
+
     // Not owned here.
     MatchExpression* root;
 
@@ -107,6 +112,14 @@ public:
      */
     std::unique_ptr<MatchExpression> getNext();
 
+    /**
+     * Returns true if some of the outputs of getNext() may skip scan an index. Only valid after
+     * init() has been called.
+     */
+    bool hasSkipScanAssignments() const {
+        return _hasSkipScanAssignments;
+    }
+
 private:
     //
     // Memoization strategy
@@ -544,6 +557,12 @@ private:
     // Do we output >1 index per AND (index intersection)?
     bool _ixisect;
 
+    // Do we output assignments which skip scan an index over its unconstrained leading field?
+    bool _skipScan;
+
+    // Set once the memo contains at least one skip scan assignment.
+    bool _hasSkipScanAssignments = false;
+
     // How many enumerations are we willing to produce from each OR?
     size_t _orLimit;
 
@@ -252,6 +252,7 @@ Status PlanExecutor::pickBestPlan(const Collection* collection) {
     PlanStage* foundStage = getStageByType(_root.get(), STAGE_SUBPLAN);
     if (foundStage) {
         SubplanStage* subplan = static_cast<SubplanStage*>(foundStage);
+        CurOp::PhaseTimer planningTimer(_opCtx, CurOp::Phase::kPlanning);
         return subplan->pickBestPlan(_yieldPolicy.get());
     }
 
@@ -260,6 +261,7 @@ Status PlanExecutor::pickBestPlan(const Collection* collection) {
     foundStage = getStageByType(_root.get(), STAGE_MULTI_PLAN);
     if (foundStage) {
         MultiPlanStage* mps = static_cast<MultiPlanStage*>(foundStage);
+        CurOp::PhaseTimer planningTimer(_opCtx, CurOp::Phase::kPlanning);
         return mps->pickBestPlan(_yieldPolicy.get());
     }
 
@@ -268,6 +270,7 @@ Status PlanExecutor::pickBestPlan(const Collection* collection) {
     foundStage = getStageByType(_root.get(), STAGE_CACHED_PLAN);
     if (foundStage) {
         CachedPlanStage* cachedPlan = static_cast<CachedPlanStage*>(foundStage);
+        CurOp::PhaseTimer planningTimer(_opCtx, CurOp::Phase::kPlanning);
         return cachedPlan->pickBestPlan(_yieldPolicy.get());
     }
 
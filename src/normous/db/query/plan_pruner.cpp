@@ -0,0 +1,178 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kQuery
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/plan_pruner.h"
+
+#include <algorithm>
+
+#include "mongo/db/index/index_key_histogram.h"
+#include "mongo/util/log.h"
+
+namespace mongo {
+
+namespace {
+
+// Estimates are coarse, so a candidate is only dropped if it is also estimated to examine at least
+// this many more keys and documents than the best candidate. This is about what a trial period
+// takes to tell two candidates apart.
+const double kMinWorksDifference = 100;
+
+struct Estimate {
+    // The number of index keys and documents examined.
+    double works;
+
+    // The number of results produced.
+    double results;
+};
+
+boost::optional<Estimate> estimate(const QuerySolutionNode* node, double numRecords) {
+    switch (node->getType()) {
+        case STAGE_COLLSCAN:
+            return Estimate{numRecords, numRecords};
+
+        case STAGE_IXSCAN: {
+            const IndexScanNode* ixscan = static_cast<const IndexScanNode*>(node);
+            const IndexKeyHistogram* histogram = ixscan->index.keyHistogram.get();
+            if (!histogram || ixscan->bounds.isSimpleRange || ixscan->bounds.fields.empty()) {
+                return boost::none;
+            }
+
+            double keys = 0;
+            for (auto&& interval : ixscan->bounds.fields[0].intervals) {
+                keys += histogram->estimateKeysInInterval(
+                    interval.start, interval.startInclusive, interval.end, interval.endInclusive);
+            }
+
+            // The histogram was built along with the index, so scale the fraction of keys it
+            // predicts by the current size of the collection.
+            const double works = numRecords * keys / std::max(histogram->numKeys(), 1LL);
+            return Estimate{works, works};
+        }
+
+        case STAGE_FETCH: {
+            auto child = estimate(node->children[0], numRecords);
+            if (!child) {
+                return boost::none;
+            }
+            return Estimate{child->works + child->results, child->results};
+        }
+
+        case STAGE_AND_HASH:
+        case STAGE_AND_SORTED:
+        case STAGE_OR:
+        case STAGE_SORT_MERGE: {
+            const bool isAnd = node->getType() == STAGE_AND_HASH ||
+                node->getType() == STAGE_AND_SORTED;
+            Estimate total{0, isAnd ? numRecords : 0};
+            for (auto&& childNode : node->children) {
+                auto child = estimate(childNode, numRecords);
+                if (!child) {
+                    return boost::none;
+                }
+                total.works += child->works;
+                if (isAnd) {
+                    total.results = std::min(total.results, child->results);
+                } else {
+                    total.results += child->results;
+                }
+            }
+            return total;
+        }
+
+        case STAGE_ENSURE_SORTED:
+        case STAGE_PROJECTION:
+        case STAGE_SHARDING_FILTER:
+        case STAGE_SKIP:
+            return estimate(node->children[0], numRecords);
+
+        default:
+            return boost::none;
+    }
+}
+
+}  // namespace
+
+// static
+boost::optional<double> PlanPruner::estimateWorks(const QuerySolutionNode* root,
+                                                  double numRecords) {
+    auto rootEstimate = estimate(root, numRecords);
+    if (!rootEstimate) {
+        return boost::none;
+    }
+    return rootEstimate->works;
+}
+
+// static
+size_t PlanPruner::prune(const CanonicalQuery& query,
+                         double numRecords,
+                         double ratio,
+                         std::vector<std::unique_ptr<QuerySolution>>* solutions) {
+    if (solutions->size() < 2) {
+        return 0;
+    }
+
+    // A plan which can stop early, or which has to order its results, may well be the best even
+    // though it would examine more when run to completion.
+    const QueryRequest& qr = query.getQueryRequest();
+    if (!qr.getSort().isEmpty() || qr.getLimit() || qr.getNToReturn() || qr.isTailable()) {
+        return 0;
+    }
+
+    std::vector<double> works;
+    for (auto&& solution : *solutions) {
+        auto solutionWorks = estimateWorks(solution->root.get(), numRecords);
+        if (!solutionWorks) {
+            return 0;
+        }
+        works.push_back(*solutionWorks);
+    }
+
+    const double best = *std::min_element(works.begin(), works.end());
+    const double limit = std::max(best * ratio, best + kMinWorksDifference);
+
+    size_t kept = 0;
+    for (size_t i = 0; i < solutions->size(); ++i) {
+        if (works[i] > limit) {
+            LOG(2) << "Pruning candidate plan estimated to examine " << works[i]
+                   << " keys and documents, the best candidate is estimated to examine " << best
+                   << ": " << redact((*solutions)[i]->toString());
+            continue;
+        }
+        (*solutions)[kept++] = std::move((*solutions)[i]);
+    }
+
+    const size_t numPruned = solutions->size() - kept;
+    solutions->resize(kept);
+    return numPruned;
+}
+
+}  // namespace mongo
@@ -0,0 +1,67 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <memory>
+#include <vector>
+
+#include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/query_solution.h"
+
+namespace mongo {
+
+/**
+ * Estimates the cost of candidate plans from the statistics gathered about the keys of indexes, so
+ * that candidates which are clearly worse than another one can be dropped without being run.
+ */
+class PlanPruner {
+public:
+    /**
+     * Estimates the number of index keys and documents that the plan rooted at 'root' examines,
+     * given that the collection holds 'numRecords' documents. Returns boost::none if the plan
+     * uses a stage whose cost cannot be estimated, such as a scan over an index without
+     * statistics.
+     */
+    static boost::optional<double> estimateWorks(const QuerySolutionNode* root, double numRecords);
+
+    /**
+     * Removes from 'solutions' every solution whose estimated works exceed 'ratio' times those of
+     * the best solution. Only queries which run to completion are pruned, so that the estimates
+     * are comparable, and only if every solution can be estimated. Never removes all solutions.
+     *
+     * Returns the number of solutions removed.
+     */
+    static size_t prune(const CanonicalQuery& query,
+                        double numRecords,
+                        double ratio,
+                        std::vector<std::unique_ptr<QuerySolution>>* solutions);
+};
+
+}  // namespace mongo
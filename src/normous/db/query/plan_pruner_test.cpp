@@ -0,0 +1,116 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/plan_pruner.h"
+
+#include "mongo/db/index/index_key_histogram.h"
+#include "mongo/db/query/query_planner_test_fixture.h"
+
+namespace mongo {
+namespace {
+
+const double kNumRecords = 1000;
+
+std::shared_ptr<const IndexKeyHistogram> uniformHistogram() {
+    IndexKeyHistogram::Builder builder(1);
+    for (int value = 0; value < kNumRecords; ++value) {
+        builder.addKey(BSON("" << value));
+    }
+    return builder.done();
+}
+
+class PlanPrunerTest : public QueryPlannerTest {
+protected:
+    void addIndexWithHistogram(BSONObj keyPattern, std::string name) {
+        IndexEntry entry(keyPattern, name);
+        entry.keyHistogram = uniformHistogram();
+        addIndex(entry);
+    }
+};
+
+TEST_F(PlanPrunerTest, PrunesPlansEstimatedToExamineFarMore) {
+    params.options = QueryPlannerParams::DEFAULT;
+    addIndexWithHistogram(BSON("a" << 1), "a_1");
+    addIndexWithHistogram(BSON("b" << 1), "b_1");
+    runQuery(fromjson("{a: 5, b: {$gte: 10}}"));
+    assertNumSolutions(2U);
+
+    ASSERT_EQ(1U, PlanPruner::prune(*cq, kNumRecords, 10.0, &solns));
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{fetch: {filter: {b: {$gte: 10}}, node: {ixscan: {filter: null, pattern: {a: 1}}}}}");
+}
+
+TEST_F(PlanPrunerTest, PrunesCollectionScan) {
+    addIndexWithHistogram(BSON("a" << 1), "a_1");
+    runQuery(fromjson("{a: 5}"));
+    assertNumSolutions(2U);
+
+    ASSERT_EQ(1U, PlanPruner::prune(*cq, kNumRecords, 10.0, &solns));
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {ixscan: {filter: null, pattern: {a: 1}}}}}");
+}
+
+TEST_F(PlanPrunerTest, KeepsPlansWithComparableEstimates) {
+    addIndexWithHistogram(BSON("a" << 1), "a_1");
+    runQuery(fromjson("{a: {$gte: 0}}"));
+    assertNumSolutions(2U);
+
+    ASSERT_EQ(0U, PlanPruner::prune(*cq, kNumRecords, 10.0, &solns));
+    assertNumSolutions(2U);
+}
+
+TEST_F(PlanPrunerTest, DoesNotPruneWithoutStatistics) {
+    params.options = QueryPlannerParams::DEFAULT;
+    addIndexWithHistogram(BSON("a" << 1), "a_1");
+    addIndex(BSON("b" << 1));
+    runQuery(fromjson("{a: 5, b: {$gte: 10}}"));
+    assertNumSolutions(2U);
+
+    ASSERT_FALSE(PlanPruner::estimateWorks(solns[0]->root.get(), kNumRecords) &&
+                 PlanPruner::estimateWorks(solns[1]->root.get(), kNumRecords));
+    ASSERT_EQ(0U, PlanPruner::prune(*cq, kNumRecords, 10.0, &solns));
+    assertNumSolutions(2U);
+}
+
+TEST_F(PlanPrunerTest, DoesNotPruneSortedQueries) {
+    params.options = QueryPlannerParams::DEFAULT;
+    addIndexWithHistogram(BSON("a" << 1), "a_1");
+    addIndexWithHistogram(BSON("b" << 1), "b_1");
+    runQuerySortProj(fromjson("{a: 5, b: {$gte: 10}}"), BSON("b" << 1), BSONObj());
+    assertNumSolutions(2U);
+
+    ASSERT_EQ(0U, PlanPruner::prune(*cq, kNumRecords, 10.0, &solns));
+    assertNumSolutions(2U);
+}
+
+}  // namespace
+}  // namespace mongo
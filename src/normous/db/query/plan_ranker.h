@@ -104,6 +104,18 @@ struct PlanRankingDecision {
         return decision;
     }
 
+    /**
+     * Returns an estimate of the memory used by this decision, including the stats it owns.
+     */
+    uint64_t estimateObjectSizeInBytes() const {
+        uint64_t size = sizeof(*this) + stats.capacity() * sizeof(std::unique_ptr<PlanStageStats>) +
+            scores.capacity() * sizeof(double) + candidateOrder.capacity() * sizeof(size_t);
+        for (auto&& stat : stats) {
+            size += stat->estimateObjectSizeInBytes();
+        }
+        return size;
+    }
+
     // Stats of all plans sorted in descending order by score.
     // Owned by us.
     std::vector<std::unique_ptr<PlanStageStats>> stats;
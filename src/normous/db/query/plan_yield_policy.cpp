@@ -30,6 +30,7 @@
 
 #include "mongo/db/query/plan_yield_policy.h"
 
+#include "mongo/db/concurrency/lock_manager.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/curop_failpoint_helpers.h"
@@ -37,6 +38,7 @@
 #include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_yield.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/storage/storage_engine.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/time_support.h"
@@ -78,7 +80,29 @@ bool PlanYieldPolicy::shouldYield() {
     invariant(!_planYielding->getOpCtx()->lockState()->inAWriteUnitOfWork());
     if (_forceYield)
         return true;
-    return _elapsedTracker.intervalHasElapsed();
+    if (!_elapsedTracker.intervalHasElapsed())
+        return false;
+    if (canSkipYield()) {
+        ++_consecutiveSkippedYields;
+        CurOp::get(_planYielding->getOpCtx())->yieldSkipped();
+        return false;
+    }
+    return true;
+}
+
+bool PlanYieldPolicy::canSkipYield() {
+    if (_policy != PlanExecutor::YIELD_AUTO)
+        return false;
+    if (_consecutiveSkippedYields + 1 >= internalQueryExecYieldUncontendedPeriodFactor.load())
+        return false;
+    if (LockManager::getNumWaitingRequests() > 0)
+        return false;
+
+    // Checking the cache is more expensive than reading the lock manager's counter, so it is only
+    // done once contention on locks has been ruled out.
+    OperationContext* opCtx = _planYielding->getOpCtx();
+    StorageEngine* storageEngine = opCtx->getServiceContext()->getStorageEngine();
+    return storageEngine && !storageEngine->isCacheUnderPressure(opCtx);
 }
 
 void PlanYieldPolicy::resetTimer() {
@@ -117,6 +141,7 @@ Status PlanYieldPolicy::yield(stdx::function<void()> whileYieldingFn) {
     ON_BLOCK_EXIT([this]() { resetTimer(); });
 
     _forceYield = false;
+    _consecutiveSkippedYields = 0;
 
     OperationContext* opCtx = _planYielding->getOpCtx();
     invariant(opCtx);
@@ -143,9 +143,19 @@ private:
     // not outlive the plan executor.
     PlanExecutor* const _planYielding;
 
+    // Number of yield points in a row at which shouldYield() declined to yield because nothing
+    // was contending for this plan's locks or storage engine state.
+    int _consecutiveSkippedYields = 0;
+
     // Returns true to indicate it's time to release locks or storage engine state.
     bool shouldYield();
 
+    // Called once a yield period has elapsed. Returns true if the plan may keep running instead
+    // of yielding, because no lock request is waiting and the storage engine cache is not under
+    // pressure. Never skips more than internalQueryExecYieldUncontendedPeriodFactor - 1 periods
+    // in a row, so that interrupts and snapshot releases still happen regularly.
+    bool canSkipYield();
+
     // Releases locks or storage engine state.
     Status yield(stdx::function<void()> whileYieldingFn);
 };
@@ -49,6 +49,7 @@
 #include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/query_planner_common.h"
+#include "mongo/db/storage/clustered_record_id.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/log.h"
 #include "mongo/util/transitional_tools_do_not_use/vector_spooling.h"
@@ -97,6 +98,41 @@ const IndexScanNode* getIndexScanNode(const QuerySolutionNode* node) {
     return nullptr;
 }
 
+/**
+ * Limits 'csn', a scan of a clustered collection, to the RecordIds which the comparisons of _id
+ * with numbers in 'root', or in its top-level $and, permit. The filter is still applied to every
+ * record, so the bounds only need to include all the records it may match.
+ */
+void setClusteredCollectionBounds(const MatchExpression* root, CollectionScanNode* csn) {
+    auto narrowBounds = [csn](const MatchExpression* me) {
+        if (!ComparisonMatchExpression::isComparisonMatchExpression(me) || me->path() != "_id") {
+            return;
+        }
+
+        const BSONElement bound = static_cast<const ComparisonMatchExpression*>(me)->getData();
+        if (me->matchType() != MatchExpression::LT && me->matchType() != MatchExpression::LTE) {
+            auto minRecord = clustered_record_id::lowerBoundForId(bound);
+            if (minRecord && (!csn->minRecord || *minRecord > *csn->minRecord)) {
+                csn->minRecord = minRecord;
+            }
+        }
+        if (me->matchType() != MatchExpression::GT && me->matchType() != MatchExpression::GTE) {
+            auto maxRecord = clustered_record_id::upperBoundForId(bound);
+            if (maxRecord && (!csn->maxRecord || *maxRecord < *csn->maxRecord)) {
+                csn->maxRecord = maxRecord;
+            }
+        }
+    };
+
+    if (root->matchType() == MatchExpression::AND) {
+        for (size_t i = 0; i < root->numChildren(); ++i) {
+            narrowBounds(root->getChild(i));
+        }
+    } else {
+        narrowBounds(root);
+    }
+}
+
 /**
  * Takes as input two query solution nodes returned by processIndexScans(). If both are
  * IndexScanNode or FetchNode with an IndexScanNode child and the index scan nodes are identical
@@ -175,6 +211,10 @@ std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::makeCollectionScan(
         }
     }
 
+    if (params.options & QueryPlannerParams::CLUSTERED_COLLECTION) {
+        setClusteredCollectionBounds(query.root(), csn.get());
+    }
+
     return std::move(csn);
 }
 
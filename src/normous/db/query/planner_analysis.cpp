@@ -40,6 +40,7 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression_geo.h"
 #include "mongo/db/query/query_planner.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_planner_common.h"
 #include "mongo/util/log.h"
 
@@ -289,6 +290,20 @@ void geoSkipValidationOn(const std::set<StringData>& twoDSphereFields,
     }
 }
 
+/**
+ * If 'sort' orders the results of a TEXT node by text score alone and keeps only its first
+ * 'sort->limit' results, tells the TEXT node that it need only produce those results. 'sortInput'
+ * is the node whose results 'sort' orders.
+ */
+void pushLimitIntoText(const SortNode* sort, QuerySolutionNode* sortInput) {
+    if (!internalQueryPlannerEnableTextTopK.load() || !sort->limit ||
+        STAGE_TEXT != sortInput->getType() || sort->pattern.nFields() != 1 ||
+        !QueryRequest::isTextScoreMeta(sort->pattern.firstElement())) {
+        return;
+    }
+    static_cast<TextNode*>(sortInput)->topK = sort->limit;
+}
+
 }  // namespace
 
 // static
@@ -551,6 +566,7 @@ QuerySolutionNode* QueryPlannerAnalysis::analyzeSort(const CanonicalQuery& query
         // We have a true limit. The limit can be combined with the SORT stage.
         sort->limit =
             static_cast<size_t>(*qr.getLimit()) + static_cast<size_t>(qr.getSkip().value_or(0));
+        pushLimitIntoText(sort, keyGenNode->children[0]);
     } else if (qr.getNToReturn()) {
         // We have an ntoreturn specified by an OP_QUERY style find. This is used
         // by clients to mean both batchSize and limit.
@@ -288,7 +288,9 @@ std::vector<IndexEntry> QueryPlannerIXSelect::findIndexesByHint(
 
 // static
 std::vector<IndexEntry> QueryPlannerIXSelect::findRelevantIndices(
-    const stdx::unordered_set<std::string>& fields, const std::vector<IndexEntry>& allIndices) {
+    const stdx::unordered_set<std::string>& fields,
+    const std::vector<IndexEntry>& allIndices,
+    bool includeSkipScanIndices) {
 
     std::vector<IndexEntry> out;
     for (auto&& entry : allIndices) {
@@ -296,12 +298,22 @@ std::vector<IndexEntry> QueryPlannerIXSelect::findRelevantIndices(
         BSONElement elt = it.next();
         if (fields.end() != fields.find(elt.fieldName())) {
             out.push_back(entry);
+        } else if (includeSkipScanIndices && canUseForSkipScan(entry) &&
+                   fields.end() != fields.find(it.next().fieldName())) {
+            out.push_back(entry);
         }
     }
 
     return out;
 }
 
+bool QueryPlannerIXSelect::canUseForSkipScan(const IndexEntry& index) {
+    // Multikey indices are excluded so that the predicates over the trailing fields can always be
+    // compounded, whichever of them are present.
+    return index.type == IndexType::INDEX_BTREE && !index.multikey &&
+        index.keyPattern.nFields() > 1;
+}
+
 std::vector<IndexEntry> QueryPlannerIXSelect::expandIndexes(
     const stdx::unordered_set<std::string>& fields,
     const std::vector<IndexEntry>& relevantIndices) {
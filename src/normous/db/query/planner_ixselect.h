@@ -69,9 +69,20 @@ public:
     /**
      * Finds all indices prefixed by fields we have predicates over.  Only these indices are
      * useful in answering the query.
+     *
+     * If 'includeSkipScanIndices' is true, indices which can be skip scanned (see
+     * canUseForSkipScan()) are also relevant when we have predicates over their second field.
      */
     static std::vector<IndexEntry> findRelevantIndices(
-        const stdx::unordered_set<std::string>& fields, const std::vector<IndexEntry>& allIndices);
+        const stdx::unordered_set<std::string>& fields,
+        const std::vector<IndexEntry>& allIndices,
+        bool includeSkipScanIndices = false);
+
+    /**
+     * Returns true if 'index' can answer predicates over its second field alone by scanning every
+     * value of its leading field, seeking from one leading value to the next.
+     */
+    static bool canUseForSkipScan(const IndexEntry& index);
 
     /**
      * Determine how useful all of our relevant 'indices' are to all predicates in the subtree
@@ -48,6 +48,14 @@ extern AtomicDouble internalQueryPlanEvaluationCollFraction;
 // Stop working plans once a plan returns this many results.
 extern AtomicInt32 internalQueryPlanEvaluationMaxResults;
 
+// If positive, stop working plans after this many works per plan if only one plan has returned
+// any results. Zero disables the early exit.
+extern AtomicInt32 internalQueryPlanEvaluationEarlyExitWorks;
+
+// When true, the SubplanStage ranks plans only once per distinct branch shape of a rooted $or and
+// applies the winner to every other branch of that shape.
+extern AtomicBool internalQuerySubplanReuseBranchWinners;
+
 // Do we give a big ranking bonus to intersection plans?
 extern AtomicBool internalQueryForceIntersectionPlans;
 
@@ -57,6 +65,17 @@ extern AtomicBool internalQueryPlannerEnableIndexIntersection;
 // Do we use hash-based intersection for rooted $and queries?
 extern AtomicBool internalQueryPlannerEnableHashIntersection;
 
+// Do we consider skip scanning compound indices whose leading field is unconstrained?
+extern AtomicBool internalQueryPlannerEnableIndexSkipScan;
+
+// When a $text query is sorted by text score alone and limited, do we let the TEXT stage stop
+// reading postings once no unread document can enter the top results?
+extern AtomicBool internalQueryPlannerEnableTextTopK;
+
+// A candidate plan whose works, as estimated from index statistics, exceed this many times the
+// estimate of the best candidate is dropped before multi-planning. 0 disables pruning.
+extern AtomicDouble internalQueryPlannerStatisticsPruneRatio;
+
 //
 // plan cache
 //
@@ -64,6 +83,11 @@ extern AtomicBool internalQueryPlannerEnableHashIntersection;
 // How many entries in the cache?
 extern AtomicInt32 internalQueryCacheSize;
 
+// Total estimated size, in megabytes, of the entries of all plan caches in the process. Inserting
+// into a plan cache while over this budget evicts that cache's least recently used entries. Zero
+// disables the budget.
+extern AtomicInt32 internalQueryCacheTotalSizeBudgetMegabytes;
+
 // How many feedback entries do we collect before possibly evicting from the cache based on bad
 // performance?
 extern AtomicInt32 internalQueryCacheFeedbacksStored;
@@ -98,6 +122,9 @@ extern AtomicInt32 internalQueryEnumerationMaxIntersectPerAnd;
 // Do we want to plan each child of the OR independently?
 extern AtomicBool internalQueryPlanOrChildrenIndependently;
 
+// Do we build cached single-index equality plans directly from the new query's constants?
+extern AtomicBool internalQueryPlanCacheBindEqualityBounds;
+
 // How many index scans are we willing to produce in order to obtain a sort order
 // during explodeForSort?
 extern AtomicInt32 internalQueryMaxScansToExplode;
@@ -114,27 +141,106 @@ extern AtomicBool internalQueryIgnoreUnknownJSONSchemaKeywords;
 
 extern AtomicInt32 internalQueryExecMaxBlockingSortBytes;
 
+// The most memory, in bytes, an AND_HASH stage may use to buffer the results of its children
+// before failing.
+extern AtomicInt32 internalQueryMaxAndHashBufferSizeBytes;
+
+// An AND_HASH stage summarizes its hash table with a Bloom filter, so that most RecordIds outside
+// the intersection are rejected without a hash table lookup, once the table holds at least this
+// many entries.
+extern AtomicInt32 internalQueryAndHashBloomFilterMinEntries;
+
 // Yield after this many "should yield?" checks.
 extern AtomicInt32 internalQueryExecYieldIterations;
 
 // Yield if it's been at least this many milliseconds since we last yielded.
 extern AtomicInt32 internalQueryExecYieldPeriodMS;
 
+// When an auto-yielding plan reaches a yield point while no lock request is waiting and the
+// storage engine cache is not under pressure, it may skip the yield and keep running, up to this
+// many yield periods in a row. A value of 1 yields at every yield point.
+extern AtomicInt32 internalQueryExecYieldUncontendedPeriodFactor;
+
+// How many RecordIds a FETCH stage accumulates from its child before looking them all up in the
+// record store at once. A value of 1 disables batching.
+extern AtomicInt32 internalQueryExecFetchBatchSize;
+
+// How many records a COLLSCAN stage examines in a single call to work() while looking for one which
+// passes its filter. Records which are filtered out are never placed in the WorkingSet. A value of
+// 1 examines one record per call.
+extern AtomicInt32 internalQueryExecCollectionScanBatchSize;
+
+// The maximum number of threads an external sort (index builds, $sort) uses to sort each batch of
+// in-memory data before returning or spilling it.
+extern AtomicInt32 internalQueryExecSortThreads;
+
+// The number of key ranges per index whose COUNT_SCAN results are remembered until the next write
+// to the index. Zero disables the cache. Can only be set at startup.
+extern int internalQueryCountScanCacheSize;
+
+// The number of documents per collection which IDHACK plans remember by _id until the next write
+// to them. Zero disables the cache. Can only be set at startup.
+extern int internalQueryIdHackCacheSize;
+
+// The largest number of query shapes whose execution statistics are accumulated for $queryStats.
+// Zero disables collection. Can only be set at startup.
+extern int internalQueryStatsMaxShapes;
+
+// After a getMore on a find cursor returns, the server fills up to this many bytes of the cursor's
+// next batch in the background. Zero disables prefetching.
+extern AtomicInt32 internalQueryGetMorePrefetchBytes;
+
 // Limit the size that we write without yielding to 16MB / 64 (max expected number of indexes)
 const int64_t insertVectorMaxBytes = 256 * 1024;
 
 // The number of bytes to buffer at once during a $facet stage.
 extern AtomicInt32 internalQueryFacetBufferSizeBytes;
 
+// A $facet with at least two and at most this many sub-pipelines runs each one on its own thread,
+// provided every stage within them is safe to run off the operation's thread. A value of 1 runs all
+// sub-pipelines on the thread running the pipeline.
+extern AtomicInt32 internalQueryFacetParallelism;
+
 extern AtomicInt64 internalDocumentSourceSortMaxBlockingSortBytes;
 
 extern AtomicInt64 internalDocumentSourceGroupMaxMemoryBytes;
 
+// A blocking $group which has grouped this many input documents hands the rest of its input to
+// internalDocumentSourceGroupParallelism threads, each accumulating the groups whose _id hashes to
+// its partition. A parallelism of 1 groups everything on the thread running the pipeline.
+extern AtomicInt32 internalDocumentSourceGroupParallelism;
+extern AtomicInt32 internalDocumentSourceGroupParallelMinInputDocs;
+
 extern AtomicInt32 internalInsertMaxBatchSize;
 
+// A multi-update which returns no documents writes up to this many documents, of at most this many
+// bytes in total and for at most this many milliseconds, under a single WriteUnitOfWork. A limit
+// of one document writes each document under its own WriteUnitOfWork.
+extern AtomicInt32 internalUpdateMultiMaxDocsPerWriteUnitOfWork;
+extern AtomicInt32 internalUpdateMultiMaxBytesPerWriteUnitOfWork;
+extern AtomicInt32 internalUpdateMultiMaxMillisPerWriteUnitOfWork;
+
 extern AtomicInt32 internalDocumentSourceCursorBatchSizeBytes;
 
 extern AtomicInt32 internalDocumentSourceLookupCacheSizeBytes;
 
+// A localField/foreignField $lookup which has queried the foreign collection for this many input
+// documents reads the foreign collection once into a hash table keyed on 'foreignField', and
+// probes it for the remaining input documents.
+extern AtomicInt32 internalDocumentSourceLookupHashJoinMinInputDocs;
+
+// A $lookup gives up on building its hash table, and keeps querying the foreign collection for
+// each input document, once the table would exceed this many bytes. Zero disables hash joins.
+extern AtomicInt64 internalDocumentSourceLookupHashJoinMaxMemoryBytes;
+
+// The maximum number of frontier values a $graphLookup looks up with a single query against the
+// 'from' collection. Wider frontiers are queried in several batches.
+extern AtomicInt32 internalDocumentSourceGraphLookupFrontierBatchSize;
+
+// The maximum number of ready change stream events a $changeStream with 'fullDocument:
+// "updateLookup"' reads ahead, so that it looks up the post image of a document updated several
+// times within them only once.
+extern AtomicInt32 internalDocumentSourceLookupChangePostImageWindowSize;
+
 extern AtomicBool internalQueryProhibitBlockingMergeOnMongoS;
 }  // namespace mongo
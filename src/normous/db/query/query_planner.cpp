@@ -32,25 +32,31 @@
 
 #include "mongo/db/query/query_planner.h"
 
+#include <algorithm>
 #include <boost/optional.hpp>
+#include <set>
 #include <vector>
 
 #include "mongo/base/string_data.h"
 #include "mongo/bson/simple_bsonelement_comparator.h"
 #include "mongo/db/bson/dotted_path_support.h"
+#include "mongo/db/index/column_store_key_generator.h"
 #include "mongo/db/index/wildcard_key_generator.h"
 #include "mongo/db/index_names.h"
 #include "mongo/db/matcher/expression_algo.h"
 #include "mongo/db/matcher/expression_geo.h"
 #include "mongo/db/matcher/expression_text.h"
+#include "mongo/db/pipeline/dependencies.h"
 #include "mongo/db/query/canonical_query.h"
 #include "mongo/db/query/collation/collation_index_key.h"
 #include "mongo/db/query/collation/collator_interface.h"
+#include "mongo/db/query/index_bounds_builder.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/plan_enumerator.h"
 #include "mongo/db/query/planner_access.h"
 #include "mongo/db/query/planner_analysis.h"
 #include "mongo/db/query/planner_ixselect.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_planner_common.h"
 #include "mongo/db/query/query_solution.h"
 #include "mongo/util/log.h"
@@ -134,6 +140,9 @@ string optionString(size_t options) {
             case QueryPlannerParams::STRICT_DISTINCT_ONLY:
                 ss << "STRICT_DISTINCT_ONLY ";
                 break;
+            case QueryPlannerParams::INDEX_SKIP_SCAN:
+                ss << "INDEX_SKIP_SCAN ";
+                break;
             case QueryPlannerParams::DEFAULT:
                 MONGO_UNREACHABLE;
                 break;
@@ -279,6 +288,129 @@ std::unique_ptr<QuerySolution> buildCollscanSoln(const CanonicalQuery& query,
     return QueryPlannerAnalysis::analyzeDataAccess(query, params, std::move(solnRoot));
 }
 
+/**
+ * Returns the top-level fields which 'query' needs from each document, or none if it needs the
+ * whole documents or anything else about them, such as their RecordIds.
+ */
+boost::optional<std::set<std::string>> getRequiredTopLevelFields(
+    const CanonicalQuery& query, const QueryPlannerParams& params) {
+    const QueryRequest& qr = query.getQueryRequest();
+    if (qr.returnKey() || qr.showRecordId() || qr.isTailable()) {
+        return boost::none;
+    }
+
+    std::set<std::string> fields;
+    auto addPath = [&fields](StringData path) {
+        fields.insert(path.substr(0, path.find('.')).toString());
+    };
+
+    // Only a projection which includes fields, other than by a positional operator, is computed
+    // from the fields alone.
+    bool hasInclusion = false;
+    for (auto&& elem : qr.getProj()) {
+        const auto fieldName = elem.fieldNameStringData();
+        if ((!elem.isNumber() && !elem.isBoolean()) || fieldName.find('$') != std::string::npos) {
+            return boost::none;
+        }
+        if (elem.trueValue()) {
+            addPath(fieldName);
+            hasInclusion = true;
+        } else if (fieldName != "_id") {
+            return boost::none;
+        }
+    }
+    if (!hasInclusion) {
+        return boost::none;
+    }
+
+    // A $where predicate is run against the whole document, but does not report it as a
+    // dependency.
+    if (QueryPlannerCommon::hasNode(query.root(), MatchExpression::WHERE)) {
+        return boost::none;
+    }
+
+    DepsTracker deps;
+    query.root()->addDependencies(&deps);
+    if (deps.needWholeDocument) {
+        return boost::none;
+    }
+    for (auto&& path : deps.fields) {
+        addPath(path);
+    }
+
+    for (auto&& elem : qr.getSort()) {
+        if (elem.type() == BSONType::Object) {
+            // A $meta sort.
+            return boost::none;
+        }
+        addPath(elem.fieldNameStringData());
+    }
+
+    if (params.options & QueryPlannerParams::INCLUDE_SHARD_FILTER) {
+        for (auto&& elem : params.shardKey) {
+            addPath(elem.fieldNameStringData());
+        }
+    }
+
+    return fields;
+}
+
+/**
+ * Builds a solution which reads the rows of the fields 'query' needs from the first columnstore
+ * index in 'indices' which stores all of them, in place of scanning the collection. Returns
+ * nullptr if there is no such index, or if the query needs whole documents.
+ */
+std::unique_ptr<QuerySolution> buildColumnScanSoln(const CanonicalQuery& query,
+                                                   const QueryPlannerParams& params,
+                                                   const std::vector<IndexEntry>& indices) {
+    // Most collections have no columnstore index, so check for one before analyzing the query.
+    if (std::none_of(indices.begin(), indices.end(), [](const IndexEntry& index) {
+            return index.type == INDEX_COLUMN;
+        })) {
+        return nullptr;
+    }
+
+    const auto fields = getRequiredTopLevelFields(query, params);
+    if (!fields) {
+        return nullptr;
+    }
+
+    for (auto&& index : indices) {
+        if (index.type != INDEX_COLUMN) {
+            continue;
+        }
+
+        const ColumnStoreKeyGenerator keyGen(index.keyPattern);
+        if (!std::all_of(fields->begin(), fields->end(), [&keyGen](const std::string& field) {
+                return keyGen.isColumn(field);
+            })) {
+            continue;
+        }
+
+        // The fields of the rows follow the order of the key pattern, which is the best guess at
+        // the order of the fields in the documents.
+        auto csn = stdx::make_unique<ColumnScanNode>(index);
+        if (keyGen.storesAllFields()) {
+            for (auto&& field : *fields) {
+                if (field != ColumnStoreKeyGenerator::kRowIdColumn) {
+                    csn->fields.push_back(field);
+                }
+            }
+        } else {
+            for (auto&& column : keyGen.getColumns()) {
+                if (fields->count(column)) {
+                    csn->fields.push_back(column);
+                }
+            }
+        }
+        csn->filter = query.root()->shallowClone();
+
+        return QueryPlannerAnalysis::analyzeDataAccess(query, params, std::move(csn));
+    }
+
+    return nullptr;
+}
+
 std::unique_ptr<QuerySolution> buildWholeIXSoln(const IndexEntry& index,
                                                 const CanonicalQuery& query,
                                                 const QueryPlannerParams& params,
@@ -292,6 +424,92 @@ bool providesSort(const CanonicalQuery& query, const BSONObj& kp) {
     return query.getQueryRequest().getSort().isPrefixOf(kp, SimpleBSONElementComparator::kInstance);
 }
 
+/**
+ * Attempts to build the solution for a cached plan whose winner is a single scan over one btree
+ * index, answering a query which is an equality or a conjunction of equalities, without tagging
+ * and re-planning a copy of the filter. Every equality must be assigned to a distinct position of
+ * that index and the new query's constants must translate to exact bounds, so that the scan needs
+ * no filter, exactly as QueryPlannerAccess would have built it.
+ *
+ * Returns nullptr if the cached plan or the new constants do not fit, in which case the caller
+ * falls back to planning from the cached index tags.
+ */
+static std::unique_ptr<QuerySolution> bindEqualityIxscanFromCache(
+    const CanonicalQuery& query,
+    const QueryPlannerParams& params,
+    const PlanCacheIndexTree& cachedTree) {
+    const MatchExpression* root = query.root();
+
+    std::vector<std::pair<const MatchExpression*, const PlanCacheIndexTree*>> predicates;
+    if (MatchExpression::EQ == root->matchType()) {
+        predicates.emplace_back(root, &cachedTree);
+    } else if (MatchExpression::AND == root->matchType() && !cachedTree.entry &&
+               cachedTree.orPushdowns.empty() &&
+               root->numChildren() == cachedTree.children.size()) {
+        for (size_t i = 0; i < root->numChildren(); ++i) {
+            predicates.emplace_back(root->getChild(i), cachedTree.children[i]);
+        }
+    } else {
+        return nullptr;
+    }
+
+    const IndexEntry::Identifier* identifier = nullptr;
+    for (auto&& predicate : predicates) {
+        const PlanCacheIndexTree* tree = predicate.second;
+        if (MatchExpression::EQ != predicate.first->matchType() || !tree->entry ||
+            !tree->children.empty() || !tree->orPushdowns.empty() || !tree->canCombineBounds) {
+            return nullptr;
+        }
+        if (identifier && *identifier != tree->entry->identifier) {
+            return nullptr;
+        }
+        identifier = &tree->entry->identifier;
+    }
+
+    // Use the catalog's current view of the index rather than the copy in the cache entry.
+    auto index = std::find_if(params.indices.begin(),
+                              params.indices.end(),
+                              [&](const IndexEntry& ie) { return ie.identifier == *identifier; });
+    if (index == params.indices.end() || INDEX_BTREE != index->type || index->multikey ||
+        index->filterExpr ||
+        !CollatorInterface::collatorsMatch(query.getCollator(), index->collator)) {
+        return nullptr;
+    }
+
+    std::vector<BSONElement> keyElts;
+    for (auto&& keyElt : index->keyPattern) {
+        keyElts.push_back(keyElt);
+    }
+
+    auto isn = stdx::make_unique<IndexScanNode>(*index);
+    isn->bounds.fields.resize(keyElts.size());
+    isn->addKeyMetadata = query.getQueryRequest().returnKey();
+    isn->queryCollator = query.getCollator();
+
+    for (auto&& predicate : predicates) {
+        const size_t pos = predicate.second->index_pos;
+        if (pos >= keyElts.size() || !isn->bounds.fields[pos].name.empty()) {
+            return nullptr;
+        }
+
+        IndexBoundsBuilder::BoundsTightness tightness;
+        IndexBoundsBuilder::translate(
+            predicate.first, keyElts[pos], *index, &isn->bounds.fields[pos], &tightness);
+        if (IndexBoundsBuilder::EXACT != tightness) {
+            return nullptr;
+        }
+    }
+
+    for (size_t pos = 0; pos < keyElts.size(); ++pos) {
+        if (isn->bounds.fields[pos].name.empty()) {
+            IndexBoundsBuilder::allValuesForField(keyElts[pos], &isn->bounds.fields[pos]);
+        }
+    }
+    IndexBoundsBuilder::alignBounds(&isn->bounds, index->keyPattern);
+
+    return QueryPlannerAnalysis::analyzeDataAccess(query, params, std::move(isn));
+}
+
 // static
 const int QueryPlanner::kPlannerVersion = 1;
 
@@ -470,7 +688,16 @@ StatusWith<std::unique_ptr<QuerySolution>> QueryPlanner::planFromCache(
 
     // SolutionCacheData::USE_TAGS_SOLN == cacheData->solnType
     // If we're here then this is neither the whole index scan or collection scan
-    // cases, and we proceed by using the PlanCacheIndexTree to tag the query tree.
+    // cases. Point lookups are answered by binding the new constants straight into an index
+    // scan when possible; otherwise, we proceed by using the PlanCacheIndexTree to tag the query
+    // tree.
+    if (internalQueryPlanCacheBindEqualityBounds.load()) {
+        if (auto soln = bindEqualityIxscanFromCache(query, params, *winnerCacheData.tree)) {
+            LOG(5) << "Planner: solution bound from the cached equality index scan:\n"
+                   << redact(soln->toString());
+            return {std::move(soln)};
+        }
+    }
 
     // Create a copy of the expression tree.  We use cachedSoln to annotate this with indices.
     unique_ptr<MatchExpression> clone = query.root()->shallowClone();
@@ -612,8 +839,28 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
                                         << " and "
                                         << fullIndexList[1].toString());
         }
+
+        if (fullIndexList.front().type == INDEX_COLUMN) {
+            auto soln = buildColumnScanSoln(query, params, fullIndexList);
+            if (!soln) {
+                return Status(ErrorCodes::BadValue,
+                              "hinted columnstore index cannot provide the fields of the query");
+            }
+            LOG(5) << "Planner: outputting soln that uses hinted columnstore index.";
+            out.push_back(std::move(soln));
+            return {std::move(out)};
+        }
     }
 
+    // A columnstore index cannot be scanned for the values of predicates, only in place of the
+    // collection, as considered below.
+    fullIndexList.erase(std::remove_if(fullIndexList.begin(),
+                                       fullIndexList.end(),
+                                       [](const IndexEntry& index) {
+                                           return index.type == INDEX_COLUMN;
+                                       }),
+                        fullIndexList.end());
+
     // Figure out what fields we care about.
     stdx::unordered_set<string> fields;
     QueryPlannerIXSelect::getFields(query.root(), &fields);
@@ -626,7 +873,8 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
     std::vector<IndexEntry> relevantIndices;
 
     if (hintedIndex.isEmpty()) {
-        relevantIndices = QueryPlannerIXSelect::findRelevantIndices(fields, fullIndexList);
+        relevantIndices = QueryPlannerIXSelect::findRelevantIndices(
+            fields, fullIndexList, params.options & QueryPlannerParams::INDEX_SKIP_SCAN);
     } else {
         relevantIndices = fullIndexList;
 
@@ -779,16 +1027,22 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
         LOG(5) << "Rated tree after text processing:" << redact(query.root()->toString());
     }
 
+    // Set if any of the indexed plans may skip scan an index, in which case a collection scan
+    // competes against them.
+    bool hasSkipScanPlans = false;
+
     // If we have any relevant indices, we try to create indexed plans.
     if (0 < relevantIndices.size()) {
         // The enumerator spits out trees tagged with IndexTag(s).
         PlanEnumeratorParams enumParams;
         enumParams.intersect = params.options & QueryPlannerParams::INDEX_INTERSECTION;
+        enumParams.skipScan = params.options & QueryPlannerParams::INDEX_SKIP_SCAN;
         enumParams.root = query.root();
         enumParams.indices = &relevantIndices;
 
         PlanEnumerator isp(enumParams);
         isp.init().transitional_ignore();
+        hasSkipScanPlans = isp.hasSkipScanAssignments();
 
         unique_ptr<MatchExpression> nextTaggedTree;
         while ((nextTaggedTree = isp.getNext()) && (out.size() < params.maxIndexedSolutions)) {
@@ -1000,8 +1254,22 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
         !QueryPlannerCommon::hasNode(query.root(), MatchExpression::GEO_NEAR) &&
         !QueryPlannerCommon::hasNode(query.root(), MatchExpression::TEXT) && hintedIndex.isEmpty();
 
-    // The caller can explicitly ask for a collscan.
-    bool collscanRequested = (params.options & QueryPlannerParams::INCLUDE_COLLSCAN);
+    // The caller can explicitly ask for a collscan. A skip scan is only better than a collscan
+    // when the leading field of the index has few distinct values, so we let them compete.
+    bool collscanRequested = (params.options & QueryPlannerParams::INCLUDE_COLLSCAN) ||
+        (hasSkipScanPlans && canTableScan);
+
+    // No indexed plans? A columnstore index which stores every field the query needs can be read
+    // in place of the collection.
+    if (possibleToCollscan && 0 == out.size() &&
+        !(params.options & QueryPlannerParams::INCLUDE_COLLSCAN)) {
+        auto soln = buildColumnScanSoln(query, params, params.indices);
+        if (soln) {
+            LOG(5) << "Planner: outputting a column scan:" << endl << redact(soln->toString());
+            out.push_back(std::move(soln));
+            return {std::move(out)};
+        }
+    }
 
     // No indexed plans?  We must provide a collscan if possible or else we can't run the query.
     bool collscanNeeded = (0 == out.size() && canTableScan);
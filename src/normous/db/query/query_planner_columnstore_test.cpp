@@ -0,0 +1,171 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/query_planner.h"
+#include "mongo/db/query/query_planner_test_fixture.h"
+
+namespace mongo {
+namespace {
+
+class QueryPlannerColumnStoreTest : public QueryPlannerTest {
+protected:
+    void setUp() final {
+        QueryPlannerTest::setUp();
+        addIndex(BSON("a"
+                      << "columnstore"
+                      << "b"
+                      << "columnstore"
+                      << "c"
+                      << "columnstore"));
+    }
+};
+
+TEST_F(QueryPlannerColumnStoreTest, InclusionProjectionUsesColumnScan) {
+    runQuerySortProj(fromjson("{b: {$gt: 3}}"), BSONObj(), fromjson("{a: 1}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{proj: {spec: {a: 1}, node: {column_scan: "
+        "{fields: ['a', 'b'], filter: {b: {$gt: 3}}}}}}");
+}
+
+TEST_F(QueryPlannerColumnStoreTest, FieldsFollowKeyPatternOrder) {
+    runQuerySortProj(fromjson("{a: 1}"), BSONObj(), fromjson("{_id: 0, c: 1, b: 1}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, c: 1, b: 1}, node: {column_scan: "
+        "{fields: ['a', 'b', 'c'], filter: {a: 1}}}}}");
+}
+
+TEST_F(QueryPlannerColumnStoreTest, DottedPathsReadTopLevelColumn) {
+    runQuerySortProj(fromjson("{'b.x': 1}"), BSONObj(), fromjson("{'a.y': 1}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{proj: {spec: {'a.y': 1}, node: {column_scan: "
+        "{fields: ['a', 'b'], filter: {'b.x': 1}}}}}");
+}
+
+TEST_F(QueryPlannerColumnStoreTest, SortIsBlockingOverColumnScan) {
+    runQuerySortProj(BSONObj(), fromjson("{c: 1}"), fromjson("{a: 1}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{proj: {spec: {a: 1}, node: {sort: {pattern: {c: 1}, limit: 0, node: "
+        "{sortKeyGen: {node: {column_scan: {fields: ['a', 'c']}}}}}}}}");
+}
+
+TEST_F(QueryPlannerColumnStoreTest, NoProjectionUsesCollScan) {
+    runQuery(fromjson("{a: 1}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1, filter: {a: 1}}}");
+}
+
+TEST_F(QueryPlannerColumnStoreTest, ExclusionProjectionUsesCollScan) {
+    runQuerySortProj(fromjson("{a: 1}"), BSONObj(), fromjson("{b: 0}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists("{proj: {spec: {b: 0}, node: {cscan: {dir: 1, filter: {a: 1}}}}}");
+}
+
+TEST_F(QueryPlannerColumnStoreTest, FieldNotStoredUsesCollScan) {
+    runQuerySortProj(fromjson("{d: 1}"), BSONObj(), fromjson("{a: 1}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists("{proj: {spec: {a: 1}, node: {cscan: {dir: 1, filter: {d: 1}}}}}");
+}
+
+TEST_F(QueryPlannerColumnStoreTest, WholeDocumentPredicateUsesCollScan) {
+    runQuerySortProj(fromjson("{$where: 'this.a == 1'}"), BSONObj(), fromjson("{a: 1}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{proj: {spec: {a: 1}, node: {cscan: {dir: 1, filter: {$where: 'this.a == 1'}}}}}");
+}
+
+TEST_F(QueryPlannerColumnStoreTest, IndexedPlanIsPreferred) {
+    addIndex(BSON("b" << 1));
+    runQuerySortProj(fromjson("{b: 1}"), BSONObj(), fromjson("{a: 1}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{proj: {spec: {a: 1}, node: {fetch: {filter: null, node: "
+        "{ixscan: {filter: null, pattern: {b: 1}}}}}}}");
+}
+
+TEST_F(QueryPlannerColumnStoreTest, AllFieldsIndexStoresAnyField) {
+    params.indices.clear();
+    addIndex(BSON("$**"
+                  << "columnstore"));
+    runQuerySortProj(fromjson("{z: 1}"), BSONObj(), fromjson("{y: 1, x: 1}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{proj: {spec: {y: 1, x: 1}, node: {column_scan: "
+        "{pattern: {'$**': 'columnstore'}, fields: ['x', 'y', 'z'], filter: {z: 1}}}}}");
+}
+
+TEST_F(QueryPlannerColumnStoreTest, HintedColumnStoreIndexIsUsed) {
+    addIndex(BSON("b" << 1));
+    runQuerySortProjSkipNToReturnHint(fromjson("{b: 1}"),
+                                      BSONObj(),
+                                      fromjson("{a: 1}"),
+                                      0,
+                                      0,
+                                      BSON("a"
+                                           << "columnstore"
+                                           << "b"
+                                           << "columnstore"
+                                           << "c"
+                                           << "columnstore"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{proj: {spec: {a: 1}, node: {column_scan: {fields: ['a', 'b'], filter: {b: 1}}}}}");
+}
+
+TEST_F(QueryPlannerColumnStoreTest, HintedColumnStoreIndexMustStoreQueryFields) {
+    runInvalidQuerySortProjSkipNToReturnHint(fromjson("{d: 1}"),
+                                             BSONObj(),
+                                             fromjson("{a: 1}"),
+                                             0,
+                                             0,
+                                             BSON("a"
+                                                  << "columnstore"
+                                                  << "b"
+                                                  << "columnstore"
+                                                  << "c"
+                                                  << "columnstore"));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -96,6 +96,16 @@ struct QueryPlannerParams {
         // return exactly one document per value of the distinct field. See the comments above the
         // declaration of getExecutorDistinct() for more detail.
         STRICT_DISTINCT_ONLY = 1 << 11,
+
+        // Set this to also consider compound indices whose leading field has no predicates over
+        // it, by skip scanning them. A collection scan is then generated as well, so that the
+        // multi-planner can choose based on how many distinct leading values there are.
+        INDEX_SKIP_SCAN = 1 << 12,
+
+        // Set this if the collection is clustered, so that its records are in _id order and
+        // collection scans can be limited to the RecordIds between the bounds of a predicate on
+        // _id.
+        CLUSTERED_COLLECTION = 1 << 13,
     };
 
     // See Options enum above.
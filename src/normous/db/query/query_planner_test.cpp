@@ -1500,6 +1500,46 @@ TEST_F(QueryPlannerTest, ProjNonCovering) {
         "{ixscan: {filter: null, pattern: {x: 1}}}}}}}");
 }
 
+//
+// Clustered collections
+//
+
+TEST_F(QueryPlannerTest, ClusteredCollectionScanIsBoundedByIdRange) {
+    params.options |= QueryPlannerParams::CLUSTERED_COLLECTION;
+    runQuery(fromjson("{_id: {$gt: 2.5, $lte: 10}, a: 1}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{cscan: {dir: 1, minRecord: 3, maxRecord: 10, "
+        "filter: {_id: {$gt: 2.5, $lte: 10}, a: 1}}}");
+}
+
+TEST_F(QueryPlannerTest, ClusteredCollectionScanUsesTightestBounds) {
+    params.options |= QueryPlannerParams::CLUSTERED_COLLECTION;
+    runQuery(fromjson("{$and: [{_id: {$gte: 4}}, {_id: {$gte: 7}}, {_id: {$lt: 20}}]}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1, minRecord: 7, maxRecord: 20}}");
+}
+
+TEST_F(QueryPlannerTest, ClusteredCollectionScanIgnoresNonNumericAndNestedBounds) {
+    params.options |= QueryPlannerParams::CLUSTERED_COLLECTION;
+    runQuery(fromjson("{$or: [{_id: 1}, {_id: 2}], a: {$gt: 5}}"));
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1, minRecord: null, maxRecord: null}}");
+
+    runQuery(fromjson("{_id: {$gt: 'a'}}"));
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1, minRecord: null, maxRecord: null}}");
+}
+
+TEST_F(QueryPlannerTest, UnclusteredCollectionScanHasNoBounds) {
+    runQuery(fromjson("{_id: {$gt: 2, $lt: 4}}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1, minRecord: null, maxRecord: null}}");
+}
+
 //
 // Basic sort
 //
@@ -1754,6 +1794,49 @@ TEST_F(QueryPlannerTest, CantUseCompound) {
     assertSolutionExists("{cscan: {dir: 1, filter: {y: 10}}}");
 }
 
+TEST_F(QueryPlannerTest, SkipScanCompoundOverUnconstrainedLeadingField) {
+    params.options = QueryPlannerParams::INDEX_SKIP_SCAN;
+    addIndex(BSON("x" << 1 << "y" << 1));
+    runQuery(fromjson("{y: 10}"));
+
+    // The collection scan is generated even though INCLUDE_COLLSCAN is not set.
+    ASSERT_EQUALS(getNumSolutions(), 2U);
+    assertSolutionExists("{cscan: {dir: 1, filter: {y: 10}}}");
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {ixscan: {filter: null, pattern: {x: 1, y: 1}, "
+        "bounds: {x: [['MinKey','MaxKey',true,true]], y: [[10,10,true,true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, SkipScanCompoundWithNoTableScan) {
+    params.options = QueryPlannerParams::INDEX_SKIP_SCAN | QueryPlannerParams::NO_TABLE_SCAN;
+    addIndex(BSON("x" << 1 << "y" << 1 << "z" << 1));
+    runQuery(fromjson("{y: {$gt: 1}, z: 5}"));
+
+    ASSERT_EQUALS(getNumSolutions(), 1U);
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {ixscan: {filter: null, pattern: {x: 1, y: 1, z: 1}, "
+        "bounds: {x: [['MinKey','MaxKey',true,true]], y: [[1,Infinity,false,true]], "
+        "z: [[5,5,true,true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, SkipScanRequiresPredicateOverSecondField) {
+    params.options = QueryPlannerParams::INDEX_SKIP_SCAN;
+    addIndex(BSON("x" << 1 << "y" << 1 << "z" << 1));
+    runQuery(fromjson("{z: 10}"));
+
+    ASSERT_EQUALS(getNumSolutions(), 1U);
+    assertSolutionExists("{cscan: {dir: 1, filter: {z: 10}}}");
+}
+
+TEST_F(QueryPlannerTest, SkipScanNotUsedForMultikeyIndex) {
+    params.options = QueryPlannerParams::INDEX_SKIP_SCAN;
+    addIndex(BSON("x" << 1 << "y" << 1), true);
+    runQuery(fromjson("{y: 10}"));
+
+    ASSERT_EQUALS(getNumSolutions(), 1U);
+    assertSolutionExists("{cscan: {dir: 1, filter: {y: 10}}}");
+}
+
 //
 // $in
 //
@@ -265,7 +265,8 @@ bool QueryPlannerTestLib::solutionMatches(const BSONObj& testSoln,
             return false;
         }
         BSONObj csObj = el.Obj();
-        invariant(bsonObjFieldsAreInSet(csObj, {"dir", "filter", "collation"}));
+        invariant(bsonObjFieldsAreInSet(
+            csObj, {"dir", "filter", "collation", "minRecord", "maxRecord"}));
 
         BSONElement dir = csObj["dir"];
         if (dir.eoo() || !dir.isNumber()) {
@@ -275,6 +276,21 @@ bool QueryPlannerTestLib::solutionMatches(const BSONObj& testSoln,
             return false;
         }
 
+        // A null bound requires the scan to have none.
+        auto boundMatches = [](const BSONElement& expected,
+                               const boost::optional<RecordId>& actual) {
+            if (expected.eoo()) {
+                return true;
+            } else if (expected.isNull()) {
+                return !actual;
+            }
+            return expected.isNumber() && actual && expected.numberLong() == actual->repr();
+        };
+        if (!boundMatches(csObj["minRecord"], csn->minRecord) ||
+            !boundMatches(csObj["maxRecord"], csn->maxRecord)) {
+            return false;
+        }
+
         BSONElement filter = csObj["filter"];
         if (filter.eoo()) {
             return true;
@@ -293,6 +309,44 @@ bool QueryPlannerTestLib::solutionMatches(const BSONObj& testSoln,
         }
 
         return filterMatches(filter.Obj(), collation, trueSoln);
+    } else if (STAGE_COLUMN_SCAN == trueSoln->getType()) {
+        const ColumnScanNode* csn = static_cast<const ColumnScanNode*>(trueSoln);
+        BSONElement el = testSoln["column_scan"];
+        if (el.eoo() || !el.isABSONObj()) {
+            return false;
+        }
+        BSONObj csObj = el.Obj();
+        invariant(bsonObjFieldsAreInSet(csObj, {"pattern", "fields", "filter"}));
+
+        BSONElement pattern = csObj["pattern"];
+        if (!pattern.eoo() &&
+            (!pattern.isABSONObj() ||
+             SimpleBSONObjComparator::kInstance.evaluate(pattern.Obj() !=
+                                                         csn->index.keyPattern))) {
+            return false;
+        }
+
+        BSONElement fields = csObj["fields"];
+        if (fields.eoo() || fields.type() != BSONType::Array) {
+            return false;
+        }
+        std::vector<std::string> expectedFields;
+        for (auto&& field : fields.Obj()) {
+            expectedFields.push_back(field.str());
+        }
+        if (expectedFields != csn->fields) {
+            return false;
+        }
+
+        BSONElement filter = csObj["filter"];
+        if (filter.eoo()) {
+            return true;
+        } else if (filter.isNull()) {
+            return NULL == csn->filter;
+        } else if (!filter.isABSONObj()) {
+            return false;
+        }
+        return filterMatches(filter.Obj(), BSONObj(), trueSoln);
     } else if (STAGE_IXSCAN == trueSoln->getType()) {
         const IndexScanNode* ixn = static_cast<const IndexScanNode*>(trueSoln);
         BSONElement el = testSoln["ixscan"];
@@ -413,7 +467,8 @@ bool QueryPlannerTestLib::solutionMatches(const BSONObj& testSoln,
                                          "diacriticSensitive",
                                          "prefix",
                                          "collation",
-                                         "filter"}));
+                                         "filter",
+                                         "topK"}));
 
         BSONElement searchElt = textObj["search"];
         if (!searchElt.eoo()) {
@@ -454,6 +509,13 @@ bool QueryPlannerTestLib::solutionMatches(const BSONObj& testSoln,
             }
         }
 
+        BSONElement topK = textObj["topK"];
+        if (!topK.eoo()) {
+            if (!topK.isNumber() || static_cast<size_t>(topK.numberLong()) != node->topK) {
+                return false;
+            }
+        }
+
         BSONObj collation;
         if (BSONElement collationElt = textObj["collation"]) {
             if (!collationElt.isABSONObj()) {
@@ -472,6 +472,40 @@ TEST_F(QueryPlannerTest, SortKeyMetaProjectionWithTextScoreMetaSort) {
         "{sortKeyGen: {node: {text: {search: 'foo'}}}}}}}}");
 }
 
+TEST_F(QueryPlannerTest, TextScoreSortWithLimitPushesTopKIntoText) {
+    addIndex(BSON("_fts"
+                  << "text"
+                  << "_ftsx"
+                  << 1));
+
+    runQueryAsCommand(
+        fromjson("{find: 'testns', filter: {$text: {$search: 'foo'}}, projection: {a: {$meta: "
+                 "'textScore'}}, sort: {a: {$meta: 'textScore'}}, skip: 5, limit: 10}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{proj: {spec: {a: {$meta: 'textScore'}}, node: {skip: {n: 5, node: "
+        "{sort: {limit: 15, pattern: {a: {$meta: 'textScore'}}, node: "
+        "{sortKeyGen: {node: {text: {search: 'foo', topK: 15}}}}}}}}}}");
+}
+
+TEST_F(QueryPlannerTest, CompoundSortWithLimitDoesNotPushTopKIntoText) {
+    addIndex(BSON("_fts"
+                  << "text"
+                  << "_ftsx"
+                  << 1));
+
+    runQueryAsCommand(
+        fromjson("{find: 'testns', filter: {$text: {$search: 'foo'}}, projection: {a: {$meta: "
+                 "'textScore'}}, sort: {a: {$meta: 'textScore'}, b: 1}, limit: 10}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{proj: {spec: {a: {$meta: 'textScore'}}, node: "
+        "{sort: {limit: 10, pattern: {a: {$meta: 'textScore'}, b: 1}, node: "
+        "{sortKeyGen: {node: {text: {search: 'foo', topK: 0}}}}}}}}");
+}
+
 TEST_F(QueryPlannerTest, PredicatesOverLeadingFieldsWithSharedPathPrefixHandledCorrectly) {
     const bool multikey = true;
     addIndex(BSON("a.x" << 1 << "a.y" << 1 << "b.x" << 1 << "b.y" << 1 << "_fts"
@@ -202,6 +202,10 @@ void TextNode::appendToString(mongoutils::str::stream* ss, int indent) const {
     *ss << "diacriticSensitive= " << ftsQuery->getDiacriticSensitive() << '\n';
     addIndent(ss, indent + 1);
     *ss << "indexPrefix = " << indexPrefix.toString() << '\n';
+    if (topK) {
+        addIndent(ss, indent + 1);
+        *ss << "topK = " << topK << '\n';
+    }
     if (NULL != filter) {
         addIndent(ss, indent + 1);
         *ss << " filter = " << filter->toString();
@@ -216,6 +220,7 @@ QuerySolutionNode* TextNode::clone() const {
     copy->_sort = this->_sort;
     copy->ftsQuery = this->ftsQuery->clone();
     copy->indexPrefix = this->indexPrefix;
+    copy->topK = this->topK;
 
     return copy;
 }
@@ -232,6 +237,14 @@ void CollectionScanNode::appendToString(mongoutils::str::stream* ss, int indent)
     *ss << "COLLSCAN\n";
     addIndent(ss, indent + 1);
     *ss << "ns = " << name << '\n';
+    if (minRecord) {
+        addIndent(ss, indent + 1);
+        *ss << "minRecord = " << *minRecord << '\n';
+    }
+    if (maxRecord) {
+        addIndent(ss, indent + 1);
+        *ss << "maxRecord = " << *maxRecord << '\n';
+    }
     if (NULL != filter) {
         addIndent(ss, indent + 1);
         *ss << "filter = " << filter->toString();
@@ -249,6 +262,42 @@ QuerySolutionNode* CollectionScanNode::clone() const {
     copy->direction = this->direction;
     copy->shouldTrackLatestOplogTimestamp = this->shouldTrackLatestOplogTimestamp;
     copy->shouldWaitForOplogVisibility = this->shouldWaitForOplogVisibility;
+    copy->minRecord = this->minRecord;
+    copy->maxRecord = this->maxRecord;
+
+    return copy;
+}
+
+//
+// ColumnScanNode
+//
+
+void ColumnScanNode::appendToString(mongoutils::str::stream* ss, int indent) const {
+    addIndent(ss, indent);
+    *ss << "COLUMN_SCAN\n";
+    addIndent(ss, indent + 1);
+    *ss << "name = " << index.identifier.catalogName << '\n';
+    addIndent(ss, indent + 1);
+    *ss << "keyPattern = " << index.keyPattern << '\n';
+    addIndent(ss, indent + 1);
+    *ss << "fields = [";
+    for (size_t i = 0; i < fields.size(); ++i) {
+        *ss << (i == 0 ? "" : ", ") << fields[i];
+    }
+    *ss << "]\n";
+    if (NULL != filter) {
+        addIndent(ss, indent + 1);
+        *ss << "filter = " << filter->toString();
+    }
+    addCommon(ss, indent);
+}
+
+QuerySolutionNode* ColumnScanNode::clone() const {
+    ColumnScanNode* copy = new ColumnScanNode(this->index);
+    cloneBaseData(copy);
+
+    copy->sorts = this->sorts;
+    copy->fields = this->fields;
 
     return copy;
 }
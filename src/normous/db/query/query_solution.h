@@ -277,6 +277,10 @@ struct TextNode : public QuerySolutionNode {
     // text node while creating the text leaf node and convert them into a BSONObj index prefix
     // when we finish the text leaf node.
     BSONObj indexPrefix;
+
+    // When non-zero, the parent of this node only keeps the 'topK' results with the highest text
+    // score, so the node may return just those.
+    size_t topK = 0;
 };
 
 struct CollectionScanNode : public QuerySolutionNode {
@@ -321,6 +325,49 @@ struct CollectionScanNode : public QuerySolutionNode {
 
     // Whether or not to wait for oplog visibility on oplog collection scans.
     bool shouldWaitForOplogVisibility = false;
+
+    // The bounds on the RecordIds of a clustered collection which 'filter' implies, if any.
+    boost::optional<RecordId> minRecord;
+    boost::optional<RecordId> maxRecord;
+};
+
+/**
+ * Reads the rows of a query's top-level fields from a columnstore index. The rows stand in for
+ * the documents, which are never fetched.
+ */
+struct ColumnScanNode : public QuerySolutionNode {
+    explicit ColumnScanNode(IndexEntry index)
+        : sorts(SimpleBSONObjComparator::kInstance.makeBSONObjSet()), index(std::move(index)) {}
+
+    virtual ~ColumnScanNode() {}
+
+    virtual StageType getType() const {
+        return STAGE_COLUMN_SCAN;
+    }
+
+    virtual void appendToString(mongoutils::str::stream* ss, int indent) const;
+
+    bool fetched() const {
+        return true;
+    }
+    bool hasField(const std::string& field) const {
+        return true;
+    }
+    bool sortedByDiskLoc() const {
+        return false;
+    }
+    const BSONObjSet& getSort() const {
+        return sorts;
+    }
+
+    QuerySolutionNode* clone() const;
+
+    BSONObjSet sorts;
+
+    IndexEntry index;
+
+    // The top-level fields read into each row besides _id, in the order of the row.
+    std::vector<std::string> fields;
 };
 
 struct AndHashNode : public QuerySolutionNode {
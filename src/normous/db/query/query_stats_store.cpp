@@ -0,0 +1,296 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/query_stats_store.h"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+
+#include "mongo/db/operation_context.h"
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/db/service_context.h"
+#include "mongo/util/hex.h"
+
+namespace mongo {
+
+constexpr size_t QueryStatsStore::kNumPartitions;
+constexpr size_t QueryStatsStore::kNumLatencyBuckets;
+
+namespace {
+
+const auto getQueryStatsStore = ServiceContext::declareDecoration<QueryStatsStore>();
+
+// Example queries larger than this are not kept, to bound the memory held by each shape.
+const int kMaxExampleQueryBytes = 4 * 1024;
+
+}  // namespace
+
+QueryStatsStore& QueryStatsStore::get(ServiceContext* svcCtx) {
+    return getQueryStatsStore(svcCtx);
+}
+
+QueryStatsStore& QueryStatsStore::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+bool QueryStatsStore::isEnabled() {
+    return internalQueryStatsMaxShapes > 0;
+}
+
+std::string QueryStatsStore::makeKey(const NamespaceString& nss, StringData planCacheKey) {
+    // Namespaces cannot contain NUL, so the key splits unambiguously.
+    std::string key;
+    key.reserve(nss.size() + 1 + planCacheKey.size());
+    key.append(nss.ns());
+    key.push_back('\0');
+    key.append(planCacheKey.rawData(), planCacheKey.size());
+    return key;
+}
+
+size_t QueryStatsStore::latencyBucket(long long micros) {
+    size_t bucket = 0;
+    while (micros > 0 && bucket < kNumLatencyBuckets - 1) {
+        micros >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+void QueryStatsStore::registerShape(const std::string& key,
+                                    const NamespaceString& nss,
+                                    uint32_t queryHash,
+                                    Date_t now,
+                                    const stdx::function<BSONObj()>& makeExampleQuery) {
+    auto& partition = _partitionFor(key);
+    stdx::lock_guard<stdx::mutex> lk(partition.mutex);
+    if (partition.shapes && partition.shapes->hasKey(key)) {
+        return;
+    }
+
+    auto& shape = _getOrCreate(lk, &partition, key, nss, now);
+    shape.queryHash = queryHash;
+
+    BSONObj exampleQuery = makeExampleQuery();
+    if (exampleQuery.objsize() <= kMaxExampleQueryBytes) {
+        shape.exampleQuery = exampleQuery.getOwned();
+    }
+}
+
+void QueryStatsStore::record(const std::string& key, const Execution& execution, Date_t now) {
+    // The namespace is the part of the key before the first NUL.
+    const NamespaceString nss(StringData(key.c_str()));
+
+    auto& partition = _partitionFor(key);
+    stdx::lock_guard<stdx::mutex> lk(partition.mutex);
+    auto& shape = _getOrCreate(lk, &partition, key, nss, now);
+
+    shape.lastSeen = now;
+    if (execution.isGetMore) {
+        ++shape.getMoreCount;
+    } else {
+        ++shape.execCount;
+    }
+    shape.totalExecMicros += execution.micros;
+    shape.maxExecMicros = std::max(shape.maxExecMicros, execution.micros);
+    shape.keysExamined += execution.keysExamined;
+    shape.docsExamined += execution.docsExamined;
+    shape.nreturned += execution.nreturned;
+    shape.bytesReturned += execution.bytesReturned;
+    ++shape.latencyBuckets[latencyBucket(execution.micros)];
+}
+
+std::vector<BSONObj> QueryStatsStore::report(const NamespaceString& nss) const {
+    std::vector<BSONObj> results;
+    for (const auto& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> lk(partition.mutex);
+        if (!partition.shapes) {
+            continue;
+        }
+
+        for (const auto& entry : *partition.shapes) {
+            if (entry.second.nss != nss) {
+                continue;
+            }
+
+            BSONObjBuilder bob;
+            entry.second.appendTo(&bob);
+            results.push_back(bob.obj());
+        }
+    }
+    return results;
+}
+
+void QueryStatsStore::appendSummary(size_t maxShapes, BSONObjBuilder* builder) const {
+    struct Summary {
+        long long queryHash;
+        long long execCount;
+        long long getMoreCount;
+        long long totalExecMicros;
+        long long keysExamined;
+        long long docsExamined;
+        long long nreturned;
+    };
+
+    std::vector<Summary> summaries;
+    for (const auto& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> lk(partition.mutex);
+        if (!partition.shapes) {
+            continue;
+        }
+
+        for (const auto& entry : *partition.shapes) {
+            const auto& shape = entry.second;
+            summaries.push_back({shape.queryHash.value_or(0),
+                                 shape.execCount,
+                                 shape.getMoreCount,
+                                 shape.totalExecMicros,
+                                 shape.keysExamined,
+                                 shape.docsExamined,
+                                 shape.nreturned});
+        }
+    }
+
+    builder->appendNumber("shapes", static_cast<long long>(summaries.size()));
+    builder->appendNumber("evictedShapes", _evictedShapes.load());
+
+    const auto top = std::min(maxShapes, summaries.size());
+    std::partial_sort(summaries.begin(),
+                      summaries.begin() + top,
+                      summaries.end(),
+                      [](const Summary& lhs, const Summary& rhs) {
+                          return lhs.totalExecMicros > rhs.totalExecMicros;
+                      });
+
+    // Hashes are reported as numbers, since FTDC only records numeric values.
+    BSONArrayBuilder topBuilder(builder->subarrayStart("top"));
+    for (size_t i = 0; i < top; ++i) {
+        const auto& summary = summaries[i];
+        BSONObjBuilder shapeBuilder(topBuilder.subobjStart());
+        shapeBuilder.appendNumber("queryHash", summary.queryHash);
+        shapeBuilder.appendNumber("execCount", summary.execCount);
+        shapeBuilder.appendNumber("getMoreCount", summary.getMoreCount);
+        shapeBuilder.appendNumber("totalExecMicros", summary.totalExecMicros);
+        shapeBuilder.appendNumber("keysExamined", summary.keysExamined);
+        shapeBuilder.appendNumber("docsExamined", summary.docsExamined);
+        shapeBuilder.appendNumber("nreturned", summary.nreturned);
+    }
+}
+
+size_t QueryStatsStore::size() const {
+    size_t total = 0;
+    for (const auto& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> lk(partition.mutex);
+        if (partition.shapes) {
+            total += partition.shapes->size();
+        }
+    }
+    return total;
+}
+
+void QueryStatsStore::clear() {
+    for (auto& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> lk(partition.mutex);
+        if (partition.shapes) {
+            partition.shapes->clear();
+        }
+    }
+}
+
+QueryStatsStore::Partition& QueryStatsStore::_partitionFor(const std::string& key) {
+    return _partitions[std::hash<std::string>()(key) % kNumPartitions];
+}
+
+QueryStatsStore::ShapeStats& QueryStatsStore::_getOrCreate(WithLock,
+                                                           Partition* partition,
+                                                           const std::string& key,
+                                                           const NamespaceString& nss,
+                                                           Date_t now) {
+    if (!partition->shapes) {
+        const size_t maxShapes = std::max(internalQueryStatsMaxShapes, 1);
+        partition->shapes.emplace((maxShapes + kNumPartitions - 1) / kNumPartitions);
+    }
+
+    auto it = partition->shapes->find(key);
+    if (it != partition->shapes->end()) {
+        return it->second;
+    }
+
+    ShapeStats shape;
+    shape.nss = nss;
+    shape.firstSeen = now;
+    shape.lastSeen = now;
+    if (partition->shapes->add(key, std::move(shape))) {
+        _evictedShapes.fetchAndAdd(1);
+    }
+    return partition->shapes->begin()->second;
+}
+
+long long QueryStatsStore::ShapeStats::latencyPercentile(double percentile) const {
+    const long long count = std::accumulate(latencyBuckets.begin(), latencyBuckets.end(), 0LL);
+    const long long rank = static_cast<long long>(percentile * count);
+
+    long long seen = 0;
+    for (size_t i = 0; i < kNumLatencyBuckets - 1; ++i) {
+        seen += latencyBuckets[i];
+        if (seen > rank) {
+            return std::min(1LL << i, maxExecMicros);
+        }
+    }
+    return maxExecMicros;
+}
+
+void QueryStatsStore::ShapeStats::appendTo(BSONObjBuilder* builder) const {
+    builder->append("ns", nss.ns());
+    if (queryHash) {
+        builder->append("queryHash", unsignedIntToFixedLengthHex(*queryHash));
+    }
+    if (!exampleQuery.isEmpty()) {
+        builder->append("exampleQuery", exampleQuery);
+    }
+    builder->append("firstSeen", firstSeen);
+    builder->append("lastSeen", lastSeen);
+    builder->appendNumber("execCount", execCount);
+    builder->appendNumber("getMoreCount", getMoreCount);
+    builder->appendNumber("totalExecMicros", totalExecMicros);
+    builder->appendNumber("maxExecMicros", maxExecMicros);
+    {
+        BSONObjBuilder percentiles(builder->subobjStart("execMicrosPercentiles"));
+        percentiles.appendNumber("p50", latencyPercentile(0.5));
+        percentiles.appendNumber("p90", latencyPercentile(0.9));
+        percentiles.appendNumber("p99", latencyPercentile(0.99));
+    }
+    builder->appendNumber("keysExamined", keysExamined);
+    builder->appendNumber("docsExamined", docsExamined);
+    builder->appendNumber("nreturned", nreturned);
+    builder->appendNumber("bytesReturned", bytesReturned);
+}
+
+}  // namespace mongo
@@ -0,0 +1,196 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/base/string_data.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/functional.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/lru_cache.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Accumulates execution statistics per query shape, so that the queries which cost the most in
+ * aggregate can be found without profiling every operation.
+ *
+ * A shape is a namespace together with the plan cache key of a query against it. Shapes are
+ * spread over partitions by hash, each with its own mutex and its own LRU list, so concurrent
+ * operations rarely contend and the store never holds more than 'internalQueryStatsMaxShapes'
+ * shapes. The store is disabled while that knob is 0.
+ *
+ * All methods are thread-safe.
+ */
+class QueryStatsStore {
+    MONGO_DISALLOW_COPYING(QueryStatsStore);
+
+public:
+    static constexpr size_t kNumPartitions = 16;
+
+    // Execution times are counted in buckets of powers of two microseconds. Bucket i holds times in
+    // [2^(i-1), 2^i), bucket 0 holds times under a microsecond, and the last bucket is unbounded.
+    static constexpr size_t kNumLatencyBuckets = 32;
+
+    /**
+     * The metrics of one operation on a query shape: the operation which planned the query, or a
+     * getMore on its cursor.
+     */
+    struct Execution {
+        bool isGetMore = false;
+        long long micros = 0;
+        long long keysExamined = 0;
+        long long docsExamined = 0;
+        long long nreturned = 0;
+        long long bytesReturned = 0;
+    };
+
+    QueryStatsStore() = default;
+
+    static QueryStatsStore& get(ServiceContext* svcCtx);
+    static QueryStatsStore& get(OperationContext* opCtx);
+
+    /**
+     * Returns true if statistics are being collected.
+     */
+    static bool isEnabled();
+
+    /**
+     * Returns the key of the shape of queries against 'nss' with plan cache key 'planCacheKey'.
+     */
+    static std::string makeKey(const NamespaceString& nss, StringData planCacheKey);
+
+    /**
+     * Returns the index of the latency bucket that counts an execution of 'micros'.
+     */
+    static size_t latencyBucket(long long micros);
+
+    /**
+     * Starts tracking the shape with 'key' unless it is already tracked. 'makeExampleQuery' is
+     * called only for a new shape, to produce a query of that shape to report alongside it.
+     */
+    void registerShape(const std::string& key,
+                       const NamespaceString& nss,
+                       uint32_t queryHash,
+                       Date_t now,
+                       const stdx::function<BSONObj()>& makeExampleQuery);
+
+    /**
+     * Adds 'execution' to the statistics of the shape with 'key', tracking the shape if it had
+     * been evicted since it was registered.
+     */
+    void record(const std::string& key, const Execution& execution, Date_t now);
+
+    /**
+     * Returns one document per tracked shape of queries against 'nss', as reported by $queryStats.
+     */
+    std::vector<BSONObj> report(const NamespaceString& nss) const;
+
+    /**
+     * Appends the number of tracked and evicted shapes, followed by the statistics of the
+     * 'maxShapes' shapes with the largest total execution time, in a form suitable for FTDC.
+     */
+    void appendSummary(size_t maxShapes, BSONObjBuilder* builder) const;
+
+    /**
+     * Returns the number of tracked shapes.
+     */
+    size_t size() const;
+
+    /**
+     * Stops tracking every shape.
+     */
+    void clear();
+
+private:
+    struct ShapeStats {
+        NamespaceString nss;
+        boost::optional<uint32_t> queryHash;
+        BSONObj exampleQuery;
+        Date_t firstSeen;
+        Date_t lastSeen;
+
+        long long execCount = 0;
+        long long getMoreCount = 0;
+        long long totalExecMicros = 0;
+        long long maxExecMicros = 0;
+        long long keysExamined = 0;
+        long long docsExamined = 0;
+        long long nreturned = 0;
+        long long bytesReturned = 0;
+        std::array<long long, kNumLatencyBuckets> latencyBuckets{};
+
+        /**
+         * Returns an upper bound on the execution time of the fraction 'percentile' of operations.
+         */
+        long long latencyPercentile(double percentile) const;
+
+        void appendTo(BSONObjBuilder* builder) const;
+    };
+
+    using Shapes = LRUCache<std::string, ShapeStats>;
+
+    struct Partition {
+        mutable stdx::mutex mutex;
+
+        // Created on first use, once the knob bounding its size has been set.
+        boost::optional<Shapes> shapes;
+    };
+
+    Partition& _partitionFor(const std::string& key);
+
+    /**
+     * Returns the shape with 'key' in 'partition', tracking it if it is not tracked yet. Must be
+     * called with the partition's mutex held.
+     */
+    ShapeStats& _getOrCreate(WithLock,
+                             Partition* partition,
+                             const std::string& key,
+                             const NamespaceString& nss,
+                             Date_t now);
+
+    std::array<Partition, kNumPartitions> _partitions;
+
+    AtomicWord<long long> _evictedShapes{0};
+};
+
+}  // namespace mongo
@@ -0,0 +1,212 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/query_stats_store.h"
+
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kNss("test.coll");
+
+QueryStatsStore::Execution makeExecution(long long micros, bool isGetMore = false) {
+    QueryStatsStore::Execution execution;
+    execution.isGetMore = isGetMore;
+    execution.micros = micros;
+    execution.keysExamined = 2;
+    execution.docsExamined = 3;
+    execution.nreturned = 1;
+    execution.bytesReturned = 100;
+    return execution;
+}
+
+class QueryStatsStoreTest : public unittest::Test {
+protected:
+    void setMaxShapes(int maxShapes) {
+        internalQueryStatsMaxShapes = maxShapes;
+    }
+
+    void registerShape(const std::string& key, uint32_t queryHash) {
+        _store.registerShape(
+            key, kNss, queryHash, _now, [] { return BSON("filter" << BSON("a" << 1)); });
+    }
+
+    QueryStatsStore _store;
+    const Date_t _now = Date_t::fromMillisSinceEpoch(1000);
+
+private:
+    const int _oldMaxShapes = internalQueryStatsMaxShapes;
+    ScopeGuard _restoreMaxShapes =
+        MakeGuard([this] { internalQueryStatsMaxShapes = _oldMaxShapes; });
+};
+
+TEST_F(QueryStatsStoreTest, DisabledByDefault) {
+    setMaxShapes(0);
+    ASSERT_FALSE(QueryStatsStore::isEnabled());
+    setMaxShapes(10);
+    ASSERT_TRUE(QueryStatsStore::isEnabled());
+}
+
+TEST_F(QueryStatsStoreTest, KeysOfDifferentNamespacesDiffer) {
+    ASSERT_NE(QueryStatsStore::makeKey(NamespaceString("test.a"), "eqa"),
+              QueryStatsStore::makeKey(NamespaceString("test.b"), "eqa"));
+    ASSERT_NE(QueryStatsStore::makeKey(kNss, "eqa"), QueryStatsStore::makeKey(kNss, "eqb"));
+}
+
+TEST_F(QueryStatsStoreTest, LatencyBuckets) {
+    ASSERT_EQ(0U, QueryStatsStore::latencyBucket(0));
+    ASSERT_EQ(1U, QueryStatsStore::latencyBucket(1));
+    ASSERT_EQ(2U, QueryStatsStore::latencyBucket(2));
+    ASSERT_EQ(2U, QueryStatsStore::latencyBucket(3));
+    ASSERT_EQ(11U, QueryStatsStore::latencyBucket(1024));
+    const size_t lastBucket = QueryStatsStore::kNumLatencyBuckets - 1;
+    ASSERT_EQ(lastBucket, QueryStatsStore::latencyBucket(std::numeric_limits<long long>::max()));
+}
+
+TEST_F(QueryStatsStoreTest, AccumulatesExecutionsOfAShape) {
+    setMaxShapes(10);
+    const auto key = QueryStatsStore::makeKey(kNss, "eqa");
+    registerShape(key, 0xabcd);
+    _store.record(key, makeExecution(10), _now);
+    _store.record(key, makeExecution(30, true), _now + Seconds(1));
+
+    auto report = _store.report(kNss);
+    ASSERT_EQ(1U, report.size());
+    const auto& shape = report[0];
+    ASSERT_EQ(kNss.ns(), shape["ns"].str());
+    ASSERT_EQ("0000ABCD", shape["queryHash"].str());
+    ASSERT_BSONOBJ_EQ(BSON("filter" << BSON("a" << 1)), shape["exampleQuery"].Obj());
+    ASSERT_EQ(_now, shape["firstSeen"].Date());
+    ASSERT_EQ(_now + Seconds(1), shape["lastSeen"].Date());
+    ASSERT_EQ(1, shape["execCount"].numberLong());
+    ASSERT_EQ(1, shape["getMoreCount"].numberLong());
+    ASSERT_EQ(40, shape["totalExecMicros"].numberLong());
+    ASSERT_EQ(30, shape["maxExecMicros"].numberLong());
+    ASSERT_EQ(4, shape["keysExamined"].numberLong());
+    ASSERT_EQ(6, shape["docsExamined"].numberLong());
+    ASSERT_EQ(2, shape["nreturned"].numberLong());
+    ASSERT_EQ(200, shape["bytesReturned"].numberLong());
+}
+
+TEST_F(QueryStatsStoreTest, RegisteringAgainKeepsStatistics) {
+    setMaxShapes(10);
+    const auto key = QueryStatsStore::makeKey(kNss, "eqa");
+    registerShape(key, 1);
+    _store.record(key, makeExecution(10), _now);
+
+    bool called = false;
+    _store.registerShape(key, kNss, 1, _now, [&] {
+        called = true;
+        return BSONObj();
+    });
+    ASSERT_FALSE(called);
+
+    auto report = _store.report(kNss);
+    ASSERT_EQ(1U, report.size());
+    ASSERT_EQ(1, report[0]["execCount"].numberLong());
+}
+
+TEST_F(QueryStatsStoreTest, PercentilesAreBoundedByBuckets) {
+    setMaxShapes(10);
+    const auto key = QueryStatsStore::makeKey(kNss, "eqa");
+    registerShape(key, 1);
+    for (int i = 0; i < 98; ++i) {
+        _store.record(key, makeExecution(100), _now);
+    }
+    _store.record(key, makeExecution(5000), _now);
+    _store.record(key, makeExecution(6000), _now);
+
+    auto report = _store.report(kNss);
+    ASSERT_EQ(1U, report.size());
+    auto percentiles = report[0]["execMicrosPercentiles"].Obj();
+    ASSERT_EQ(128, percentiles["p50"].numberLong());
+    ASSERT_EQ(128, percentiles["p90"].numberLong());
+    ASSERT_EQ(6000, percentiles["p99"].numberLong());
+}
+
+TEST_F(QueryStatsStoreTest, ReportsOnlyShapesOfRequestedNamespace) {
+    setMaxShapes(10);
+    const NamespaceString otherNss("test.other");
+    registerShape(QueryStatsStore::makeKey(kNss, "eqa"), 1);
+    _store.registerShape(
+        QueryStatsStore::makeKey(otherNss, "eqa"), otherNss, 1, _now, [] { return BSONObj(); });
+
+    ASSERT_EQ(2U, _store.size());
+    ASSERT_EQ(1U, _store.report(kNss).size());
+    ASSERT_EQ(1U, _store.report(otherNss).size());
+    ASSERT_EQ(0U, _store.report(NamespaceString("test.none")).size());
+}
+
+TEST_F(QueryStatsStoreTest, NumberOfShapesIsBounded) {
+    setMaxShapes(static_cast<int>(QueryStatsStore::kNumPartitions));
+    for (int i = 0; i < 1000; ++i) {
+        registerShape(QueryStatsStore::makeKey(kNss, std::to_string(i)), i);
+    }
+    ASSERT_LTE(_store.size(), QueryStatsStore::kNumPartitions);
+
+    BSONObjBuilder builder;
+    _store.appendSummary(5, &builder);
+    auto summary = builder.obj();
+    ASSERT_EQ(static_cast<long long>(_store.size()), summary["shapes"].numberLong());
+    ASSERT_EQ(1000 - summary["shapes"].numberLong(), summary["evictedShapes"].numberLong());
+    ASSERT_EQ(5U, summary["top"].Array().size());
+}
+
+TEST_F(QueryStatsStoreTest, SummaryIsOrderedByTotalExecutionTime) {
+    setMaxShapes(10);
+    for (int i = 1; i <= 3; ++i) {
+        const auto key = QueryStatsStore::makeKey(kNss, std::to_string(i));
+        registerShape(key, i);
+        _store.record(key, makeExecution(i * 100), _now);
+    }
+
+    BSONObjBuilder builder;
+    _store.appendSummary(2, &builder);
+    auto top = builder.obj()["top"].Array();
+    ASSERT_EQ(2U, top.size());
+    ASSERT_EQ(3, top[0]["queryHash"].numberLong());
+    ASSERT_EQ(300, top[0]["totalExecMicros"].numberLong());
+    ASSERT_EQ(2, top[1]["queryHash"].numberLong());
+}
+
+TEST_F(QueryStatsStoreTest, ClearStopsTrackingShapes) {
+    setMaxShapes(10);
+    registerShape(QueryStatsStore::makeKey(kNss, "eqa"), 1);
+    ASSERT_EQ(1U, _store.size());
+    _store.clear();
+    ASSERT_EQ(0U, _store.size());
+    ASSERT_EQ(0U, _store.report(kNss).size());
+}
+
+}  // namespace
+}  // namespace mongo
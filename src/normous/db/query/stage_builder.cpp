@@ -39,6 +39,7 @@
 #include "mongo/db/exec/and_hash.h"
 #include "mongo/db/exec/and_sorted.h"
 #include "mongo/db/exec/collection_scan.h"
+#include "mongo/db/exec/column_scan.h"
 #include "mongo/db/exec/count_scan.h"
 #include "mongo/db/exec/distinct_scan.h"
 #include "mongo/db/exec/ensure_sorted.h"
@@ -81,8 +82,26 @@ PlanStage* buildStages(OperationContext* opCtx,
             params.direction = (csn->direction == 1) ? CollectionScanParams::FORWARD
                                                      : CollectionScanParams::BACKWARD;
             params.shouldWaitForOplogVisibility = csn->shouldWaitForOplogVisibility;
+            params.minRecord = csn->minRecord;
+            params.maxRecord = csn->maxRecord;
             return new CollectionScan(opCtx, params, ws, csn->filter.get());
         }
+        case STAGE_COLUMN_SCAN: {
+            const ColumnScanNode* csn = static_cast<const ColumnScanNode*>(root);
+
+            if (nullptr == collection) {
+                warning() << "Can't column scan null namespace";
+                return nullptr;
+            }
+
+            auto descriptor = collection->getIndexCatalog()->findIndexByName(
+                opCtx, csn->index.identifier.catalogName);
+            invariant(descriptor);
+
+            ColumnScanParams params{*descriptor};
+            params.fields = csn->fields;
+            return new ColumnScanStage(opCtx, std::move(params), ws, csn->filter.get());
+        }
         case STAGE_IXSCAN: {
             const IndexScanNode* ixn = static_cast<const IndexScanNode*>(root);
 
@@ -126,6 +145,17 @@ PlanStage* buildStages(OperationContext* opCtx,
             params.collection = collection;
             params.pattern = sn->pattern;
             params.limit = sn->limit;
+            // Find the longest prefix of the sort pattern which the child already provides.
+            const BSONObjSet& childSorts = sn->children[0]->getSort();
+            BSONObjBuilder prefixBob;
+            size_t prefixLength = 0;
+            for (auto&& elem : sn->pattern) {
+                prefixBob.append(elem);
+                ++prefixLength;
+                if (childSorts.find(prefixBob.asTempObj()) != childSorts.end()) {
+                    params.orderedPrefixLength = prefixLength;
+                }
+            }
             return new SortStage(opCtx, params, ws, childStage);
         }
         case STAGE_SORT_KEY_GENERATOR: {
@@ -290,6 +320,7 @@ PlanStage* buildStages(OperationContext* opCtx,
             // fail in this case (this improvement is being tracked by SERVER-21510).
             params.query = static_cast<FTSQueryImpl&>(*node->ftsQuery);
             params.wantTextScore = (cq.getProj() && cq.getProj()->wantTextScore());
+            params.topK = node->topK;
             return new TextStage(opCtx, params, ws, node->filter.get());
         }
         case STAGE_SHARDING_FILTER: {
@@ -32,12 +32,17 @@
 
 #include "repair_database_and_check_version.h"
 
+#include <algorithm>
+#include <iterator>
+#include <map>
+
 #include "mongo/db/catalog/create_collection.h"
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/catalog/database_catalog_entry.h"
 #include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/catalog/drop_collection.h"
 #include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/client.h"
 #include "mongo/db/commands/feature_compatibility_version.h"
 #include "mongo/db/commands/feature_compatibility_version_documentation.h"
 #include "mongo/db/commands/feature_compatibility_version_parser.h"
@@ -50,7 +55,10 @@
 #include "mongo/db/repl/drop_pending_collection_reaper.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/storage/storage_repair_observer.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/exit.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/log.h"
@@ -71,6 +79,18 @@ MONGO_FAIL_POINT_DEFINE(exitBeforeDataRepair);
 // Exit after repairing data, but before the replica set configuration is invalidated.
 MONGO_FAIL_POINT_DEFINE(exitBeforeRepairInvalidatesConfig);
 
+// Number of threads used to rebuild missing or unfinished indexes at startup. Databases are
+// rebuilt in parallel, one per thread. Each collection rebuild may use up to
+// maxIndexBuildMemoryUsageMegabytes, so more threads also means more memory during startup.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(startupIndexRebuildThreads, int, 4)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 1) {
+            return Status(ErrorCodes::BadValue,
+                          "startupIndexRebuildThreads must be greater than or equal to 1");
+        }
+        return Status::OK();
+    });
+
 namespace {
 
 const std::string mustDowngradeErrorMsg = str::stream()
@@ -183,68 +203,137 @@ void checkForCappedOplog(OperationContext* opCtx, Database* db) {
     }
 }
 
-void rebuildIndexes(OperationContext* opCtx, StorageEngine* storageEngine) {
-    std::vector<StorageEngine::CollectionIndexNamePair> indexesToRebuild =
-        fassert(40593, storageEngine->reconcileCatalogAndIdents(opCtx));
+using CollectionIndexNameObjMap = StringMap<IndexNameObjs>;
 
-    if (!indexesToRebuild.empty() && serverGlobalParams.indexBuildRetry) {
-        log() << "note: restart the server with --noIndexBuildRetry "
-              << "to skip index rebuilds";
-    }
+/**
+ * Rebuilds the indexes in 'collections', all of which belong to database 'dbName', on the
+ * current thread while holding an exclusive lock on that database. Reports progress against the
+ * 'totalCollections' being rebuilt across all databases.
+ */
+void rebuildIndexesOnDatabase(StorageEngine* storageEngine,
+                              const std::string& dbName,
+                              const CollectionIndexNameObjMap& collections,
+                              AtomicInt64* collectionsRebuilt,
+                              long long totalCollections) {
+    auto opCtx = cc().makeOperationContext();
+    Lock::DBLock dbLock(opCtx.get(), dbName, MODE_X);
+
+    auto dbCatalogEntry = storageEngine->getDatabaseCatalogEntry(opCtx.get(), dbName);
+    for (const auto& entry : collections) {
+        NamespaceString collNss(entry.first);
 
-    if (!serverGlobalParams.indexBuildRetry) {
-        log() << "  not rebuilding interrupted indexes";
-        return;
+        auto collCatalogEntry = dbCatalogEntry->getCollectionCatalogEntry(collNss.toString());
+        for (const auto& indexName : entry.second.first) {
+            log() << "Rebuilding index. Collection: " << collNss << " Index: " << indexName;
+        }
+        fassert(40592,
+                rebuildIndexesOnCollection(
+                    opCtx.get(), dbCatalogEntry, collCatalogEntry, entry.second));
+
+        log() << "Finished rebuilding indexes on " << collNss << " ("
+              << collectionsRebuilt->addAndFetch(1) << "/" << totalCollections
+              << " collections)";
     }
+}
 
+void rebuildIndexes(OperationContext* opCtx, StorageEngine* storageEngine) {
     // Determine which indexes need to be rebuilt. rebuildIndexesOnCollection() requires that all
-    // indexes on that collection are done at once, so we use a map to group them together.
-    StringMap<IndexNameObjs> nsToIndexNameObjMap;
-    for (auto&& indexNamespace : indexesToRebuild) {
-        NamespaceString collNss(indexNamespace.first);
-        const std::string& indexName = indexNamespace.second;
-
-        DatabaseCatalogEntry* dbce = storageEngine->getDatabaseCatalogEntry(opCtx, collNss.db());
-        invariant(dbce,
-                  str::stream() << "couldn't get database catalog entry for database "
-                                << collNss.db());
-        CollectionCatalogEntry* cce = dbce->getCollectionCatalogEntry(collNss.ns());
-        invariant(cce,
-                  str::stream() << "couldn't get collection catalog entry for collection "
-                                << collNss.toString());
-
-        auto swIndexSpecs = getIndexNameObjs(
-            opCtx, dbce, cce, [&indexName](const std::string& name) { return name == indexName; });
-        if (!swIndexSpecs.isOK() || swIndexSpecs.getValue().first.empty()) {
-            fassert(40590,
-                    {ErrorCodes::InternalError,
-                     str::stream() << "failed to get index spec for index " << indexName
-                                   << " in collection "
-                                   << collNss.toString()});
+    // indexes on that collection are done at once, so we use a map to group them together. The
+    // collections are further grouped by database so that each database can be rebuilt
+    // independently.
+    std::map<std::string, CollectionIndexNameObjMap> dbToCollectionsMap;
+    {
+        Lock::GlobalWrite lk(opCtx);
+
+        std::vector<StorageEngine::CollectionIndexNamePair> indexesToRebuild =
+            fassert(40593, storageEngine->reconcileCatalogAndIdents(opCtx));
+
+        if (!indexesToRebuild.empty() && serverGlobalParams.indexBuildRetry) {
+            log() << "note: restart the server with --noIndexBuildRetry "
+                  << "to skip index rebuilds";
         }
 
-        auto& indexesToRebuild = swIndexSpecs.getValue();
-        invariant(indexesToRebuild.first.size() == 1 && indexesToRebuild.second.size() == 1,
-                  str::stream() << "Num Index Names: " << indexesToRebuild.first.size()
-                                << " Num Index Objects: "
-                                << indexesToRebuild.second.size());
-        auto& ino = nsToIndexNameObjMap[collNss.ns()];
-        ino.first.emplace_back(std::move(indexesToRebuild.first.back()));
-        ino.second.emplace_back(std::move(indexesToRebuild.second.back()));
-    }
+        if (!serverGlobalParams.indexBuildRetry) {
+            log() << "  not rebuilding interrupted indexes";
+            return;
+        }
 
-    for (const auto& entry : nsToIndexNameObjMap) {
-        NamespaceString collNss(entry.first);
+        for (auto&& indexNamespace : indexesToRebuild) {
+            NamespaceString collNss(indexNamespace.first);
+            const std::string& indexName = indexNamespace.second;
+
+            DatabaseCatalogEntry* dbce =
+                storageEngine->getDatabaseCatalogEntry(opCtx, collNss.db());
+            invariant(dbce,
+                      str::stream() << "couldn't get database catalog entry for database "
+                                    << collNss.db());
+            CollectionCatalogEntry* cce = dbce->getCollectionCatalogEntry(collNss.ns());
+            invariant(cce,
+                      str::stream() << "couldn't get collection catalog entry for collection "
+                                    << collNss.toString());
+
+            auto swIndexSpecs =
+                getIndexNameObjs(opCtx, dbce, cce, [&indexName](const std::string& name) {
+                    return name == indexName;
+                });
+            if (!swIndexSpecs.isOK() || swIndexSpecs.getValue().first.empty()) {
+                fassert(40590,
+                        {ErrorCodes::InternalError,
+                         str::stream() << "failed to get index spec for index " << indexName
+                                       << " in collection "
+                                       << collNss.toString()});
+            }
 
-        auto dbCatalogEntry = storageEngine->getDatabaseCatalogEntry(opCtx, collNss.db());
-        auto collCatalogEntry = dbCatalogEntry->getCollectionCatalogEntry(collNss.toString());
-        for (const auto& indexName : entry.second.first) {
-            log() << "Rebuilding index. Collection: " << collNss << " Index: " << indexName;
+            auto& indexesToRebuild = swIndexSpecs.getValue();
+            invariant(indexesToRebuild.first.size() == 1 && indexesToRebuild.second.size() == 1,
+                      str::stream() << "Num Index Names: " << indexesToRebuild.first.size()
+                                    << " Num Index Objects: "
+                                    << indexesToRebuild.second.size());
+            auto& ino = dbToCollectionsMap[collNss.db().toString()][collNss.ns()];
+            ino.first.emplace_back(std::move(indexesToRebuild.first.back()));
+            ino.second.emplace_back(std::move(indexesToRebuild.second.back()));
         }
-        fassert(40592,
-                rebuildIndexesOnCollection(
-                    opCtx, dbCatalogEntry, collCatalogEntry, std::move(entry.second)));
     }
+
+    if (dbToCollectionsMap.empty()) {
+        return;
+    }
+
+    long long totalCollections = 0;
+    for (const auto& dbEntry : dbToCollectionsMap) {
+        totalCollections += dbEntry.second.size();
+    }
+
+    // Nothing else runs against the catalog this early in startup, so the global lock is not
+    // needed while the rebuilds run, and each database is rebuilt under its own exclusive lock.
+    const size_t numThreads = std::min(static_cast<size_t>(startupIndexRebuildThreads),
+                                       dbToCollectionsMap.size());
+    log() << "Rebuilding indexes on " << totalCollections << " collection(s) in "
+          << dbToCollectionsMap.size() << " database(s) using " << numThreads << " thread(s)";
+
+    ThreadPool::Options options;
+    options.poolName = "StartupIndexRebuild";
+    options.threadNamePrefix = "startupIndexRebuild-";
+    options.minThreads = options.maxThreads = numThreads;
+    options.onCreateThread = [](const std::string& threadName) { Client::initThread(threadName); };
+    ThreadPool pool(options);
+    pool.startup();
+
+    AtomicInt64 collectionsRebuilt;
+    for (const auto& dbEntry : dbToCollectionsMap) {
+        fassert(51212,
+                pool.schedule([&] {
+                    rebuildIndexesOnDatabase(storageEngine,
+                                             dbEntry.first,
+                                             dbEntry.second,
+                                             &collectionsRebuilt,
+                                             totalCollections);
+                }));
+    }
+
+    pool.waitForIdle();
+    pool.shutdown();
+    pool.join();
 }
 
 }  // namespace
@@ -253,19 +342,28 @@ void rebuildIndexes(OperationContext* opCtx, StorageEngine* storageEngine) {
  * Return an error status if the wrong mongod version was used for these datafiles. The boolean
  * represents whether there are non-local databases.
  */
-StatusWith<bool> repairDatabasesAndCheckVersion(OperationContext* opCtx) {
+StatusWith<bool> repairDatabasesAndCheckVersion(OperationContext* opCtx, bool openAllDatabases) {
     auto const storageEngine = opCtx->getServiceContext()->getStorageEngine();
-    Lock::GlobalWrite lk(opCtx);
 
-    std::vector<std::string> dbNames;
-    storageEngine->listDatabases(&dbNames);
+    if (storageGlobalParams.repair) {
+        openAllDatabases = true;
+    }
+    auto mustOpenDatabase = [openAllDatabases](const std::string& dbName) {
+        return openAllDatabases || dbName == "admin" || dbName == "local";
+    };
 
     // Rebuilding indexes must be done before a database can be opened, except when using repair,
-    // which rebuilds all indexes when it is done.
+    // which rebuilds all indexes when it is done. The rebuild takes its own locks so that
+    // independent databases can be rebuilt in parallel.
     if (!storageGlobalParams.readOnly && !storageGlobalParams.repair) {
         rebuildIndexes(opCtx, storageEngine);
     }
 
+    Lock::GlobalWrite lk(opCtx);
+
+    std::vector<std::string> dbNames;
+    storageEngine->listDatabases(&dbNames);
+
     bool repairVerifiedAllCollectionsHaveUUIDs = false;
 
     // Repair all databases first, so that we do not try to open them if they are in bad shape
@@ -310,7 +408,12 @@ StatusWith<bool> repairDatabasesAndCheckVersion(OperationContext* opCtx) {
 
     // All collections must have UUIDs.
     if (!repairVerifiedAllCollectionsHaveUUIDs) {
-        Status uuidsStatus = ensureAllCollectionsHaveUUIDs(opCtx, dbNames);
+        std::vector<std::string> dbNamesToOpen;
+        std::copy_if(dbNames.begin(),
+                     dbNames.end(),
+                     std::back_inserter(dbNamesToOpen),
+                     mustOpenDatabase);
+        Status uuidsStatus = ensureAllCollectionsHaveUUIDs(opCtx, dbNamesToOpen);
         if (!uuidsStatus.isOK()) {
             return uuidsStatus;
         }
@@ -372,6 +475,10 @@ StatusWith<bool> repairDatabasesAndCheckVersion(OperationContext* opCtx) {
         if (dbName != "local") {
             nonLocalDatabases = true;
         }
+        if (!mustOpenDatabase(dbName)) {
+            LOG(1) << "    Deferring opening database: " << dbName;
+            continue;
+        }
         LOG(1) << "    Recovering database: " << dbName;
 
         Database* db = DatabaseHolder::getDatabaseHolder().openDb(opCtx, dbName);
@@ -517,7 +624,7 @@ void checkForIdIndexesAndDropPendingCollections(OperationContext* opCtx, Databas
         if (!coll)
             continue;
 
-        if (coll->getIndexCatalog()->findIdIndex(opCtx))
+        if (coll->getIndexCatalog()->findIdIndex(opCtx) || !coll->requiresIdIndex())
             continue;
 
         log() << "WARNING: the collection '" << collectionName << "' lacks a unique index on _id."
@@ -37,8 +37,13 @@ class OperationContext;
 /**
 * Return an error status if the wrong mongod version was used for these datafiles. The boolean
 * represents whether there are non-local databases.
+*
+* If "openAllDatabases" is false and this is not a repair, only the "admin" and "local" databases
+* are opened and checked. Other databases are opened on first use, and their temporary collections
+* are left in place.
 */
-StatusWith<bool> repairDatabasesAndCheckVersion(OperationContext* opCtx);
+StatusWith<bool> repairDatabasesAndCheckVersion(OperationContext* opCtx,
+                                                bool openAllDatabases = true);
 
 /**
  * If we are in a replset, every replicated collection must have an _id index.  As we scan each
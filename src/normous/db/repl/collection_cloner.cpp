@@ -32,6 +32,7 @@
 
 #include "mongo/db/repl/collection_cloner.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "mongo/base/string_data.h"
@@ -39,6 +40,7 @@
 #include "mongo/client/dbclient_connection.h"
 #include "mongo/client/remote_command_retry_scheduler.h"
 #include "mongo/db/catalog/collection_options.h"
+#include "mongo/db/client.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/query/cursor_response.h"
 #include "mongo/db/repl/oplogreader.h"
@@ -46,6 +48,7 @@
 #include "mongo/db/repl/storage_interface_mock.h"
 #include "mongo/db/server_parameters.h"
 #include "mongo/rpc/get_status_from_command_result.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/destructor_guard.h"
 #include "mongo/util/fail_point_service.h"
@@ -65,6 +68,12 @@ constexpr auto kCountResponseDocumentCountFieldName = "n"_sd;
 const int kProgressMeterSecondsBetween = 60;
 const int kProgressMeterCheckInterval = 128;
 
+// Collections with fewer documents than this per stream are always cloned with a single query.
+const long long kMinDocumentsPerCloningStream = 10000;
+// The number of _id values sampled from the sync source for each stream when choosing the split
+// points of a partitioned clone.
+const int kSampledIdsPerCloningStream = 20;
+
 // The number of attempts for the count command, which gets the document count.
 MONGO_EXPORT_SERVER_PARAMETER(numInitialSyncCollectionCountAttempts, int, 3);
 // The number of attempts for the listIndexes commands.
@@ -73,6 +82,16 @@ MONGO_EXPORT_SERVER_PARAMETER(numInitialSyncListIndexesAttempts, int, 3);
 MONGO_EXPORT_SERVER_PARAMETER(numInitialSyncCollectionFindAttempts, int, 3);
 // Whether to use the "exhaust cursor" feature when retrieving collection data.
 MONGO_EXPORT_STARTUP_SERVER_PARAMETER(collectionClonerUsesExhaust, bool, true);
+// The number of concurrent range queries on _id used to retrieve the data of a single collection.
+// All streams feed the same bulk loader, so index builds still wait for the last document.
+MONGO_EXPORT_SERVER_PARAMETER(numInitialSyncCollectionClonerStreams, int, 1)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 1 || newVal > 16) {
+            return Status(ErrorCodes::BadValue,
+                          "numInitialSyncCollectionClonerStreams must be between 1 and 16");
+        }
+        return Status::OK();
+    });
 }  // namespace
 
 // Failpoint which causes initial sync to hang before establishing its cursor to clone the
@@ -264,6 +283,9 @@ void CollectionCloner::_cancelRemainingWork_inlock() {
     if (_queryState == QueryState::kRunning) {
         _queryState = QueryState::kCanceling;
         _clientConnection->shutdownAndDisallowReconnect();
+        for (auto&& connection : _extraClientConnections) {
+            connection->shutdownAndDisallowReconnect();
+        }
     } else {
         _queryState = QueryState::kFinished;
     }
@@ -490,6 +512,7 @@ void CollectionCloner::_beginCollectionCallback(const executor::TaskExecutor::Ca
                     stdx::lock_guard<stdx::mutex> lock(_mutex);
                     _queryState = QueryState::kFinished;
                     _clientConnection.reset();
+                    _extraClientConnections.clear();
                 }
                 _condition.notify_all();
             });
@@ -550,13 +573,154 @@ void CollectionCloner::_runQuery(const executor::TaskExecutor::CallbackArgs& cal
     auto onCompletionGuard =
         std::make_shared<OnCompletionGuard>(cancelRemainingWorkInLock, finishCallbackFn);
 
+    const auto splitPoints = _getQuerySplitPoints();
+    const bool queryFinished = splitPoints.empty()
+        ? _runRangeQuery(_clientConnection.get(), BSONObj(), BSONObj(), onCompletionGuard)
+        : _runPartitionedQuery(splitPoints, onCompletionGuard);
+    if (!queryFinished) {
+        return;
+    }
+    waitForDbWorker();
+    stdx::lock_guard<stdx::mutex> lock(_mutex);
+    onCompletionGuard->setResultAndCancelRemainingWork_inlock(lock, Status::OK());
+}
+
+std::vector<BSONObj> CollectionCloner::_getQuerySplitPoints() {
+    const int numStreams = numInitialSyncCollectionClonerStreams.load();
+    {
+        stdx::lock_guard<stdx::mutex> lock(_mutex);
+        // Capped collections must be cloned in natural order, and range bounds on a collated _id
+        // index would have to be expressed as collation keys.
+        if (numStreams <= 1 || _options.capped || !_options.collation.isEmpty() ||
+            _idIndexSpec.isEmpty() ||
+            static_cast<long long>(_stats.documentToCopy) <
+                numStreams * kMinDocumentsPerCloningStream) {
+            return {};
+        }
+    }
+
+    // splitVector is not available on secondaries, so sample the _id values instead.
+    const int sampleSize = numStreams * kSampledIdsPerCloningStream;
+    // The cursor response refers to 'sampleReply', so it must outlive the sampled _id values.
+    BSONObj sampleReply;
+    auto cursorResponse = [&]() -> StatusWith<CursorResponse> {
+        try {
+            _clientConnection->runCommand(
+                _sourceNss.db().toString(),
+                BSON("aggregate" << _sourceNss.coll() << "pipeline"
+                                 << BSON_ARRAY(BSON("$sample" << BSON("size" << sampleSize))
+                                               << BSON("$project" << BSON("_id" << 1)))
+                                 << "cursor"
+                                 << BSON("batchSize" << sampleSize)),
+                sampleReply,
+                QueryOption_SlaveOk);
+            return CursorResponse::parseFromBSON(sampleReply);
+        } catch (const DBException& e) {
+            return e.toStatus();
+        }
+    }();
+    if (!cursorResponse.isOK()) {
+        LOG(1) << "CollectionCloner ns:" << _destNss
+               << " failed to sample _id values, cloning with a single query: "
+               << redact(cursorResponse.getStatus());
+        return {};
+    }
+
+    std::vector<BSONElement> ids;
+    for (auto&& doc : cursorResponse.getValue().getBatch()) {
+        auto id = doc["_id"];
+        if (!id.eoo()) {
+            ids.push_back(id);
+        }
+    }
+    auto idLessThan = [](const BSONElement& lhs, const BSONElement& rhs) {
+        return lhs.woCompare(rhs, false) < 0;
+    };
+    auto idEqual = [](const BSONElement& lhs, const BSONElement& rhs) {
+        return lhs.woCompare(rhs, false) == 0;
+    };
+    std::sort(ids.begin(), ids.end(), idLessThan);
+    ids.erase(std::unique(ids.begin(), ids.end(), idEqual), ids.end());
+    if (ids.size() < static_cast<size_t>(numStreams)) {
+        return {};
+    }
+
+    // Since the sampled values are distinct, the quantiles are strictly increasing.
+    std::vector<BSONObj> splitPoints;
+    for (int i = 1; i < numStreams; ++i) {
+        splitPoints.push_back(BSON("_id" << ids[i * ids.size() / numStreams]));
+    }
+    return splitPoints;
+}
+
+bool CollectionCloner::_runPartitionedQuery(const std::vector<BSONObj>& splitPoints,
+                                            std::shared_ptr<OnCompletionGuard> onCompletionGuard) {
+    log() << "CollectionCloner ns:" << _destNss << " cloning with " << splitPoints.size() + 1
+          << " concurrent range queries on _id";
+
+    // The first range is read on '_clientConnection', every other range on its own connection.
+    std::vector<DBClientConnection*> connections{_clientConnection.get()};
+    for (size_t i = 0; i < splitPoints.size(); ++i) {
+        auto connection = _createClientFn();
+        Status connectionStatus = connection->connect(_source, StringData());
+        if (connectionStatus.isOK() && !replAuthenticate(connection.get())) {
+            connectionStatus = {ErrorCodes::AuthenticationFailed,
+                                str::stream() << "Failed to authenticate to " << _source};
+        }
+        stdx::unique_lock<stdx::mutex> lock(_mutex);
+        if (!connectionStatus.isOK()) {
+            onCompletionGuard->setResultAndCancelRemainingWork_inlock(lock, connectionStatus);
+            return false;
+        }
+        if (_queryState == QueryState::kCanceling) {
+            return false;
+        }
+        connections.push_back(connection.get());
+        _extraClientConnections.push_back(std::move(connection));
+    }
+
+    auto rangeMin = [&](size_t i) { return i == 0 ? BSONObj() : splitPoints[i - 1]; };
+    auto rangeMax = [&](size_t i) { return i == splitPoints.size() ? BSONObj() : splitPoints[i]; };
+
+    // std::vector<bool> packs its elements, so concurrent writes to it would race.
+    std::vector<char> rangeFinished(connections.size(), false);
+    std::vector<stdx::thread> streams;
+    for (size_t i = 1; i < connections.size(); ++i) {
+        streams.emplace_back([&, i] {
+            Client::initThread(str::stream() << "CollectionClonerStream-" << i);
+            rangeFinished[i] =
+                _runRangeQuery(connections[i], rangeMin(i), rangeMax(i), onCompletionGuard);
+        });
+    }
+    rangeFinished[0] = _runRangeQuery(connections[0], rangeMin(0), rangeMax(0), onCompletionGuard);
+    for (auto&& stream : streams) {
+        stream.join();
+    }
+    return std::all_of(
+        rangeFinished.begin(), rangeFinished.end(), [](char finished) { return finished; });
+}
+
+bool CollectionCloner::_runRangeQuery(DBClientConnection* connection,
+                                      const BSONObj& min,
+                                      const BSONObj& max,
+                                      std::shared_ptr<OnCompletionGuard> onCompletionGuard) {
+    Query query;
+    if (!min.isEmpty() || !max.isEmpty()) {
+        query.hint(BSON("_id" << 1));
+        if (!min.isEmpty()) {
+            query.minKey(min);
+        }
+        if (!max.isEmpty()) {
+            query.maxKey(max);
+        }
+    }
     try {
-        _clientConnection->query(
+        connection->query(
             [this, onCompletionGuard](DBClientCursorBatchIterator& iter) {
                 _handleNextBatch(onCompletionGuard, iter);
             },
             NamespaceStringOrUUID(_sourceNss.db().toString(), *_options.uuid),
-            Query(),
+            query,
             nullptr /* fieldsToReturn */,
             QueryOption_NoCursorTimeout | QueryOption_SlaveOk |
                 (collectionClonerUsesExhaust ? QueryOption_Exhaust : 0),
@@ -571,24 +735,22 @@ void CollectionCloner::_runQuery(const executor::TaskExecutor::CallbackArgs& cal
             // cloning.  If so, we'll execute the drop during oplog application, so it's OK to
             // just stop cloning.
             _verifyCollectionWasDropped(lock, queryStatus, onCompletionGuard);
-            return;
+            return false;
         } else if (queryStatus.code() != ErrorCodes::NamespaceNotFound) {
             // NamespaceNotFound means the collection was dropped before we started cloning, so
             // we're OK to ignore the error.  Any other error we must report.
             onCompletionGuard->setResultAndCancelRemainingWork_inlock(lock, queryStatus);
-            return;
+            return false;
         }
     }
-    waitForDbWorker();
-    stdx::lock_guard<stdx::mutex> lock(_mutex);
-    onCompletionGuard->setResultAndCancelRemainingWork_inlock(lock, Status::OK());
+    return true;
 }
 
 void CollectionCloner::_handleNextBatch(std::shared_ptr<OnCompletionGuard> onCompletionGuard,
                                         DBClientCursorBatchIterator& iter) {
-    _stats.receivedBatches++;
     {
         stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _stats.receivedBatches++;
         uassert(ErrorCodes::CallbackCanceled,
                 "Collection cloning cancelled.",
                 _queryState != QueryState::kCanceling);
@@ -217,6 +217,31 @@ private:
      */
     void _runQuery(const executor::TaskExecutor::CallbackArgs& callbackData);
 
+    /**
+     * Returns the _id values at which to split the query of _runQuery into concurrent range
+     * queries, chosen from a sample of the source collection. Returns an empty vector if the
+     * collection should be read with a single query.
+     */
+    std::vector<BSONObj> _getQuerySplitPoints();
+
+    /**
+     * Reads each of the ranges delimited by 'splitPoints' on its own connection and thread.
+     * Returns true if every range query finished without reporting an error to
+     * 'onCompletionGuard'.
+     */
+    bool _runPartitionedQuery(const std::vector<BSONObj>& splitPoints,
+                              std::shared_ptr<OnCompletionGuard> onCompletionGuard);
+
+    /**
+     * Retrieves the documents whose _id is in ['min', 'max') using 'connection'. An empty bound
+     * leaves that side of the range open. Returns false if an error was reported to
+     * 'onCompletionGuard'.
+     */
+    bool _runRangeQuery(DBClientConnection* connection,
+                        const BSONObj& min,
+                        const BSONObj& max,
+                        std::shared_ptr<OnCompletionGuard> onCompletionGuard);
+
     /**
      * Put all results from a query batch into a buffer to be inserted, and schedule
      * it to be inserted.
@@ -297,6 +322,9 @@ private:
     // (M) Client connection used for query.
     std::unique_ptr<DBClientConnection> _clientConnection;
 
+    // (M) Additional client connections used when the query is split into ranges on _id.
+    std::vector<std::unique_ptr<DBClientConnection>> _extraClientConnections;
+
     // State transitions:
     // PreStart --> Running --> ShuttingDown --> Complete
     // It is possible to skip intermediate states. For example,
@@ -37,11 +37,13 @@
 #include "mongo/db/repl/collection_cloner.h"
 #include "mongo/db/repl/storage_interface.h"
 #include "mongo/db/repl/storage_interface_mock.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/dbtests/mock/mock_dbclient_connection.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/unittest/task_executor_proxy.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/mongoutils/str.h"
+#include "mongo/util/scopeguard.h"
 
 namespace {
 
@@ -1055,6 +1057,51 @@ TEST_F(CollectionClonerTest, InsertDocumentsMultipleBatches) {
     ASSERT_FALSE(collectionCloner->isActive());
 }
 
+TEST_F(CollectionClonerTest, InsertDocumentsWithConcurrentRangeQueries) {
+    auto streamsParameter = ServerParameterSet::getGlobal()
+                                ->getMap()
+                                .find("numInitialSyncCollectionClonerStreams")
+                                ->second;
+    ASSERT_OK(streamsParameter->setFromString("2"));
+    ON_BLOCK_EXIT([&] { ASSERT_OK(streamsParameter->setFromString("1")); });
+
+    // Set up documents to be returned from upstream node.
+    for (int i = 1; i <= 6; ++i) {
+        _server->insert(nss.ns(), BSON("_id" << i));
+    }
+    // The sampled _id values split the collection at {_id: 5}.
+    _server->setCommandReply("aggregate",
+                             BSON("cursor" << BSON("id" << 0LL << "ns" << nss.ns() << "firstBatch"
+                                                        << BSON_ARRAY(BSON("_id" << 5)
+                                                                      << BSON("_id" << 2)
+                                                                      << BSON("_id" << 4)
+                                                                      << BSON("_id" << 6)))
+                                           << "ok"
+                                           << 1));
+    // Each range query needs its own connection.
+    collectionCloner->setCreateClientFn_forTest([this]() {
+        return std::unique_ptr<DBClientConnection>(new MockDBClientConnection(_server.get()));
+    });
+
+    ASSERT_OK(collectionCloner->startup());
+    ASSERT_TRUE(collectionCloner->isActive());
+
+    {
+        executor::NetworkInterfaceMock::InNetworkGuard guard(getNet());
+        processNetworkResponse(createCountResponse(100000));
+        processNetworkResponse(createListIndexesResponse(0, BSON_ARRAY(idIndexSpec)));
+    }
+    collectionCloner->join();
+    ASSERT_EQUALS(6, collectionStats.insertCount);
+    ASSERT_TRUE(collectionStats.commitCalled);
+    ASSERT_EQUALS(2U, _server->getQueryCount());
+    auto stats = collectionCloner->getStats();
+    ASSERT_EQUALS(2u, stats.receivedBatches);
+
+    ASSERT_OK(getStatus());
+    ASSERT_FALSE(collectionCloner->isActive());
+}
+
 TEST_F(CollectionClonerTest, CollectionClonerTransitionsToCompleteIfShutdownBeforeStartup) {
     collectionCloner->shutdown();
     ASSERT_EQUALS(ErrorCodes::ShutdownInProgress, collectionCloner->startup());
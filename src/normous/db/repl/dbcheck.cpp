@@ -108,6 +108,10 @@ std::string renderForHealthLog(OplogEntriesEnum op) {
             return "dbCheckBatch";
         case OplogEntriesEnum::Collection:
             return "dbCheckCollection";
+        case OplogEntriesEnum::DigestBatch:
+            return "dbCheckDigestBatch";
+        case OplogEntriesEnum::Digest:
+            return "dbCheckDigest";
     }
 
     MONGO_UNREACHABLE;
@@ -176,6 +180,48 @@ std::unique_ptr<HealthLogEntry> dbCheckBatchEntry(const NamespaceString& nss,
     return dbCheckHealthLogEntry(nss, severity, msg, OplogEntriesEnum::Batch, data);
 }
 
+std::unique_ptr<HealthLogEntry> dbCheckDigestEntry(
+    const NamespaceString& nss,
+    const std::string& expectedRoot,
+    const DbCheckCollectionDigest::Buckets& expected,
+    const DbCheckCollectionDigest::Buckets& found,
+    const repl::OpTime& optime) {
+    // Only report the first few differing buckets; the root and the total are enough to tell how
+    // widespread an inconsistency is.
+    const size_t kMaxReportedBuckets = 100;
+
+    auto roots = expectedFound(expectedRoot, DbCheckCollectionDigest::rootHash(found));
+    auto differing = DbCheckCollectionDigest::differingBuckets(expected, found);
+
+    int64_t count = 0;
+    for (const auto& bucket : found) {
+        count += bucket.count;
+    }
+
+    BSONArrayBuilder buckets;
+    for (size_t i = 0; i < differing.size() && i < kMaxReportedBuckets; ++i) {
+        int bucket = differing[i];
+        buckets.append(BSON("bucket" << bucket << "count"
+                                     << BSON("expected" << expected[bucket].count << "found"
+                                                        << found[bucket].count)));
+    }
+
+    auto data = BSON("success" << true << "count" << count << "root" << roots.second
+                               << "nDifferingBuckets"
+                               << static_cast<int64_t>(differing.size())
+                               << "differingBuckets"
+                               << buckets.arr()
+                               << "optime"
+                               << optime);
+
+    bool match = roots.first && differing.empty();
+    auto severity = match ? SeverityEnum::Info : SeverityEnum::Error;
+    std::string msg =
+        "dbCheck digest " + (match ? std::string("consistent") : std::string("inconsistent"));
+
+    return dbCheckHealthLogEntry(nss, severity, msg, OplogEntriesEnum::Digest, data);
+}
+
 DbCheckHasher::DbCheckHasher(OperationContext* opCtx,
                              Collection* collection,
                              const BSONKey& start,
@@ -446,6 +492,73 @@ Status dbCheckBatchOnSecondary(OperationContext* opCtx,
     return Status::OK();
 }
 
+Status dbCheckDigestBatchOnSecondary(OperationContext* opCtx,
+                                     const repl::OpTime& optime,
+                                     const DbCheckOplogDigestBatch& entry) {
+    AutoGetCollectionForDbCheck agc(opCtx, entry.getNss(), entry.getType());
+    Collection* collection = agc.getCollection();
+
+    if (!collection || !DbCheckCollectionDigest::isSupported(collection)) {
+        return Status::OK();
+    }
+
+    // Build our digest over the same range the primary just did.
+    auto digest = DbCheckDigestCatalog::get(opCtx).getOrCreate(collection);
+    auto status = digest->extend(opCtx, collection, entry.getMaxKey()).getStatus();
+
+    if (!status.isOK()) {
+        auto logEntry = dbCheckErrorHealthLogEntry(
+            entry.getNss(), "dbCheck digest batch failed", OplogEntriesEnum::DigestBatch, status);
+        HealthLog::get(opCtx).log(*logEntry);
+    }
+
+    return Status::OK();
+}
+
+Status dbCheckDigestOnSecondary(OperationContext* opCtx,
+                                const repl::OpTime& optime,
+                                const DbCheckOplogDigest& entry) {
+    AutoGetCollectionForDbCheck agc(opCtx, entry.getNss(), entry.getType());
+    Collection* collection = agc.getCollection();
+    std::string msg = "replication consistency check";
+
+    if (!collection) {
+        return Status::OK();
+    }
+
+    auto expected = DbCheckCollectionDigest::parse(entry.getBuckets());
+    Status status = expected.getStatus();
+
+    if (status.isOK() && !DbCheckCollectionDigest::isSupported(collection)) {
+        status = Status(ErrorCodes::CommandNotSupported,
+                        "collection does not support dbCheck digests on this node");
+    }
+
+    boost::optional<DbCheckCollectionDigest::Buckets> found;
+    if (status.isOK()) {
+        // Normally the digest batches have already brought our digest up to date; if we lost it
+        // in the meantime (e.g. by restarting), finish building it now.
+        auto digest = DbCheckDigestCatalog::get(opCtx).getOrCreate(collection);
+        status = digest->extend(opCtx, collection, BSONKey::max()).getStatus();
+        if (status.isOK()) {
+            found = digest->buckets();
+        }
+    }
+
+    if (!status.isOK()) {
+        auto logEntry =
+            dbCheckErrorHealthLogEntry(entry.getNss(), msg, OplogEntriesEnum::Digest, status);
+        HealthLog::get(opCtx).log(*logEntry);
+        return Status::OK();
+    }
+
+    auto logEntry = dbCheckDigestEntry(
+        entry.getNss(), entry.getRoot().toString(), expected.getValue(), *found, optime);
+    HealthLog::get(opCtx).log(*logEntry);
+
+    return Status::OK();
+}
+
 Status dbCheckDatabaseOnSecondary(OperationContext* opCtx,
                                   const repl::OpTime& optime,
                                   const DbCheckOplogCollection& entry) {
@@ -518,6 +631,14 @@ Status dbCheckOplogCommand(OperationContext* opCtx,
             auto invocation = DbCheckOplogCollection::parse(ctx, cmd);
             return dbCheckDatabaseOnSecondary(opCtx, optime, invocation);
         }
+        case OplogEntriesEnum::DigestBatch: {
+            auto invocation = DbCheckOplogDigestBatch::parse(ctx, cmd);
+            return dbCheckDigestBatchOnSecondary(opCtx, optime, invocation);
+        }
+        case OplogEntriesEnum::Digest: {
+            auto invocation = DbCheckOplogDigest::parse(ctx, cmd);
+            return dbCheckDigestOnSecondary(opCtx, optime, invocation);
+        }
     }
 
     MONGO_UNREACHABLE;
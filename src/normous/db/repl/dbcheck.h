@@ -33,6 +33,7 @@
 #include "mongo/db/catalog/health_log_gen.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/query/plan_executor.h"
+#include "mongo/db/repl/dbcheck_digest.h"
 #include "mongo/db/repl/dbcheck_gen.h"
 #include "mongo/util/md5.hpp"
 
@@ -66,6 +67,16 @@ std::unique_ptr<HealthLogEntry> dbCheckBatchEntry(const NamespaceString& nss,
                                                   const BSONKey& maxKey,
                                                   const repl::OpTime& optime);
 
+/**
+ * Get a HealthLogEntry comparing the digest of a whole collection against the expected one.
+ */
+std::unique_ptr<HealthLogEntry> dbCheckDigestEntry(
+    const NamespaceString& nss,
+    const std::string& expectedRoot,
+    const DbCheckCollectionDigest::Buckets& expected,
+    const DbCheckCollectionDigest::Buckets& found,
+    const repl::OpTime& optime);
+
 /**
  * The collection metadata dbCheck sends between nodes.
  */
@@ -0,0 +1,362 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/dbcheck_digest.h"
+
+#include "mongo/base/data_view.h"
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/query/internal_plans.h"
+#include "mongo/db/service_context.h"
+#include "mongo/util/md5.hpp"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+
+namespace {
+
+const auto getDigestCatalog = ServiceContext::declareDecoration<DbCheckDigestCatalog>();
+
+// Each serialized bucket is its count followed by its low and high sums, little-endian.
+const size_t kSerializedBucketSize = 3 * sizeof(uint64_t);
+
+void writeBucket(const DbCheckCollectionDigest::Bucket& bucket, char* out) {
+    DataView(out)
+        .write(tagLittleEndian(bucket.count))
+        .write(tagLittleEndian(bucket.sumLow), sizeof(uint64_t))
+        .write(tagLittleEndian(bucket.sumHigh), 2 * sizeof(uint64_t));
+}
+
+DbCheckCollectionDigest::Bucket readBucket(const char* in) {
+    ConstDataView view(in);
+    DbCheckCollectionDigest::Bucket bucket;
+    bucket.count = view.read<LittleEndian<int64_t>>();
+    bucket.sumLow = view.read<LittleEndian<uint64_t>>(sizeof(uint64_t));
+    bucket.sumHigh = view.read<LittleEndian<uint64_t>>(2 * sizeof(uint64_t));
+    return bucket;
+}
+
+bool operator==(const DbCheckCollectionDigest::Bucket& lhs,
+                const DbCheckCollectionDigest::Bucket& rhs) {
+    return lhs.count == rhs.count && lhs.sumLow == rhs.sumLow && lhs.sumHigh == rhs.sumHigh;
+}
+
+void hashBucket(const DbCheckCollectionDigest::Bucket& bucket, md5digest out) {
+    char buf[kSerializedBucketSize];
+    writeBucket(bucket, buf);
+    md5(buf, sizeof(buf), out);
+}
+
+/**
+ * The interior nodes one level below the root: node `i` hashes the `kFanout` bucket hashes
+ * starting at bucket `i * kFanout`.
+ */
+std::vector<std::string> interiorNodes(const DbCheckCollectionDigest::Buckets& buckets) {
+    const int fanout = DbCheckCollectionDigest::kFanout;
+    std::vector<std::string> nodes;
+    nodes.reserve(buckets.size() / fanout);
+
+    for (size_t first = 0; first < buckets.size(); first += fanout) {
+        md5_state_t state;
+        md5_init(&state);
+        for (size_t i = first; i < first + fanout && i < buckets.size(); ++i) {
+            md5digest leaf;
+            hashBucket(buckets[i], leaf);
+            md5_append(&state, leaf, sizeof(leaf));
+        }
+        md5digest node;
+        md5_finish(&state, node);
+        nodes.push_back(std::string(reinterpret_cast<const char*>(node), sizeof(node)));
+    }
+
+    return nodes;
+}
+
+void add(DbCheckCollectionDigest::Bucket* bucket, const DbCheckCollectionDigest::Bucket& change) {
+    // The sums wrap around as 128-bit integers.
+    uint64_t low = bucket->sumLow + change.sumLow;
+    uint64_t carry = low < bucket->sumLow ? 1 : 0;
+    bucket->sumLow = low;
+    bucket->sumHigh += change.sumHigh + carry;
+    bucket->count += change.count;
+}
+
+void negate(DbCheckCollectionDigest::Bucket* bucket) {
+    // Two's complement over all 128 bits.
+    bucket->sumLow = ~bucket->sumLow + 1;
+    bucket->sumHigh = ~bucket->sumHigh + (bucket->sumLow == 0 ? 1 : 0);
+    bucket->count = -bucket->count;
+}
+
+}  // namespace
+
+DbCheckCollectionDigest::DbCheckCollectionDigest(CollectionUUID uuid)
+    : _uuid(std::move(uuid)), _buckets(kNumBuckets) {}
+
+bool DbCheckCollectionDigest::isSupported(Collection* collection) {
+    return collection->uuid() && !collection->isCapped() && !collection->getDefaultCollator();
+}
+
+DbCheckCollectionDigest::Delta DbCheckCollectionDigest::deltaFor(const BSONObj& doc, int sign) {
+    Delta delta;
+
+    // The bucket comes from the _id alone, so all versions of a document share one bucket.
+    md5digest idHash;
+    BSONElement id = doc["_id"];
+    md5(id.rawdata(), id.size(), idHash);
+    delta.bucket = ConstDataView(reinterpret_cast<const char*>(idHash))
+                       .read<LittleEndian<uint32_t>>() %
+        kNumBuckets;
+
+    md5digest docHash;
+    md5(doc.objdata(), doc.objsize(), docHash);
+    ConstDataView view(reinterpret_cast<const char*>(docHash));
+    delta.change.count = 1;
+    delta.change.sumLow = view.read<LittleEndian<uint64_t>>();
+    delta.change.sumHigh = view.read<LittleEndian<uint64_t>>(sizeof(uint64_t));
+
+    if (sign < 0) {
+        negate(&delta.change);
+    }
+
+    return delta;
+}
+
+DbCheckCollectionDigest::Delta DbCheckCollectionDigest::deltaForUpdate(const BSONObj& preImage,
+                                                                       const BSONObj& postImage) {
+    Delta delta = deltaFor(postImage, 1);
+    add(&delta.change, deltaFor(preImage, -1).change);
+    return delta;
+}
+
+bool DbCheckCollectionDigest::covers(const BSONObj& doc) const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return _complete || _builtThrough >= doc["_id"];
+}
+
+bool DbCheckCollectionDigest::isComplete() const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return _complete;
+}
+
+BSONKey DbCheckCollectionDigest::builtThrough() const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return _builtThrough;
+}
+
+void DbCheckCollectionDigest::apply(const std::vector<Delta>& deltas) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    for (const auto& delta : deltas) {
+        add(&_buckets[delta.bucket], delta.change);
+    }
+}
+
+StatusWith<int64_t> DbCheckCollectionDigest::extend(OperationContext* opCtx,
+                                                    Collection* collection,
+                                                    const BSONKey& through,
+                                                    int64_t maxDocs) {
+    BSONKey start = builtThrough();
+    if (isComplete() || start >= through) {
+        return 0;
+    }
+
+    IndexDescriptor* desc = collection->getIndexCatalog()->findIdIndex(opCtx);
+    if (!desc) {
+        return Status(ErrorCodes::IndexNotFound, "dbCheck needs _id index");
+    }
+
+    auto exec = InternalPlanner::indexScan(opCtx,
+                                           collection,
+                                           desc,
+                                           start.obj(),
+                                           through.obj(),
+                                           BoundInclusion::kIncludeEndKeyOnly,
+                                           PlanExecutor::NO_YIELD,
+                                           InternalPlanner::FORWARD,
+                                           InternalPlanner::IXSCAN_FETCH);
+
+    // Accumulate the batch separately, so the digest only ever reflects whole batches.
+    Buckets added(kNumBuckets);
+    BSONKey last = start;
+    int64_t docsSeen = 0;
+
+    BSONObj doc;
+    PlanExecutor::ExecState state = PlanExecutor::ADVANCED;
+    while (docsSeen < maxDocs &&
+           PlanExecutor::ADVANCED == (state = exec->getNext(&doc, nullptr))) {
+        if (!doc.hasField("_id")) {
+            return Status(ErrorCodes::NoSuchKey, "Document missing _id");
+        }
+
+        auto delta = deltaFor(doc, 1);
+        add(&added[delta.bucket], delta.change);
+        last = BSONKey::parseFromBSON(doc["_id"]);
+        ++docsSeen;
+    }
+
+    if (state != PlanExecutor::ADVANCED && state != PlanExecutor::IS_EOF) {
+        return Status(ErrorCodes::OperationFailed,
+                      "dbCheck digest scan failed with state " + PlanExecutor::statestr(state));
+    }
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    for (int i = 0; i < kNumBuckets; ++i) {
+        add(&_buckets[i], added[i]);
+    }
+
+    if (state == PlanExecutor::IS_EOF) {
+        // Everything up to `through` has been seen, whether or not it holds any documents.
+        _builtThrough = through;
+        _complete = through == BSONKey::max();
+    } else {
+        _builtThrough = last;
+    }
+
+    return docsSeen;
+}
+
+DbCheckCollectionDigest::Buckets DbCheckCollectionDigest::buckets() const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return _buckets;
+}
+
+std::string DbCheckCollectionDigest::rootHash(const Buckets& buckets) {
+    md5_state_t state;
+    md5_init(&state);
+    for (const auto& node : interiorNodes(buckets)) {
+        md5_append(&state, reinterpret_cast<const md5_byte_t*>(node.data()), node.size());
+    }
+
+    md5digest root;
+    md5_finish(&state, root);
+    return digestToString(root);
+}
+
+std::vector<int> DbCheckCollectionDigest::differingBuckets(const Buckets& expected,
+                                                           const Buckets& found) {
+    invariant(expected.size() == found.size());
+
+    std::vector<int> result;
+    auto expectedNodes = interiorNodes(expected);
+    auto foundNodes = interiorNodes(found);
+
+    for (size_t node = 0; node < expectedNodes.size(); ++node) {
+        if (expectedNodes[node] == foundNodes[node]) {
+            continue;
+        }
+
+        size_t first = node * kFanout;
+        for (size_t i = first; i < first + kFanout && i < expected.size(); ++i) {
+            if (!(expected[i] == found[i])) {
+                result.push_back(static_cast<int>(i));
+            }
+        }
+    }
+
+    return result;
+}
+
+std::vector<std::uint8_t> DbCheckCollectionDigest::serialize(const Buckets& buckets) {
+    std::vector<std::uint8_t> data(buckets.size() * kSerializedBucketSize);
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        writeBucket(buckets[i], reinterpret_cast<char*>(data.data() + i * kSerializedBucketSize));
+    }
+    return data;
+}
+
+StatusWith<DbCheckCollectionDigest::Buckets> DbCheckCollectionDigest::parse(
+    ConstDataRange data) {
+    if (data.length() != kNumBuckets * kSerializedBucketSize) {
+        return {ErrorCodes::BadValue,
+                str::stream() << "dbCheck digest has " << data.length() << " bytes, expected "
+                              << kNumBuckets * kSerializedBucketSize};
+    }
+
+    Buckets buckets;
+    buckets.reserve(kNumBuckets);
+    for (int i = 0; i < kNumBuckets; ++i) {
+        buckets.push_back(readBucket(data.data() + i * kSerializedBucketSize));
+    }
+    return buckets;
+}
+
+DbCheckDigestCatalog& DbCheckDigestCatalog::get(ServiceContext* svcCtx) {
+    return getDigestCatalog(svcCtx);
+}
+
+DbCheckDigestCatalog& DbCheckDigestCatalog::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+std::shared_ptr<DbCheckCollectionDigest> DbCheckDigestCatalog::lookup(
+    const NamespaceString& nss) const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    auto it = _digests.find(nss.ns());
+    return it == _digests.end() ? nullptr : it->second;
+}
+
+std::shared_ptr<DbCheckCollectionDigest> DbCheckDigestCatalog::getOrCreate(
+    Collection* collection) {
+    invariant(collection->uuid());
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    auto& digest = _digests[collection->ns().ns()];
+    if (!digest || digest->uuid() != *collection->uuid()) {
+        digest = std::make_shared<DbCheckCollectionDigest>(*collection->uuid());
+    }
+    return digest;
+}
+
+void DbCheckDigestCatalog::invalidate(const NamespaceString& nss) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _digests.erase(nss.ns());
+}
+
+void DbCheckDigestCatalog::invalidateDatabase(StringData dbName) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    std::vector<std::string> toErase;
+    for (const auto& entry : _digests) {
+        if (nsToDatabaseSubstring(entry.first) == dbName) {
+            toErase.push_back(entry.first);
+        }
+    }
+    for (const auto& ns : toErase) {
+        _digests.erase(ns);
+    }
+}
+
+void DbCheckDigestCatalog::invalidateAll() {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _digests.clear();
+}
+
+}  // namespace mongo
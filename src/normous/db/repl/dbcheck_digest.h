@@ -0,0 +1,196 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/base/data_range.h"
+#include "mongo/base/status_with.h"
+#include "mongo/base/string_data.h"
+#include "mongo/db/catalog/collection_options.h"
+#include "mongo/db/repl/dbcheck_idl.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+class Collection;
+class NamespaceString;
+class OperationContext;
+class ServiceContext;
+
+/**
+ * An incrementally maintained, order-independent digest of the documents in one collection.
+ *
+ * Documents are partitioned into a fixed number of buckets by a hash of their _id. Each bucket
+ * holds a document count and the 128-bit sum (modulo 2^128, in two 64-bit halves) of the MD5
+ * digests of its documents, so inserts, updates and deletes can be applied without rereading the
+ * rest of the collection. The buckets are the leaves of a Merkle tree of fan-out `kFanout`, which
+ * lets two nodes compare a single root and then drill down to the buckets that differ.
+ *
+ * A digest is built by scanning the _id index in batches (see `extend`); changes to documents at
+ * or before the build position are applied by the DbCheckDigestOpObserver as their writes commit.
+ * Digests are held in memory only, and are rebuilt after a restart.
+ *
+ * This class is thread-safe. Callers moving the build position must hold the collection lock in
+ * at least MODE_S, so that no write observed against the old position can still be uncommitted.
+ */
+class DbCheckCollectionDigest {
+public:
+    static const int kNumBuckets = 1024;
+    static const int kFanout = 32;
+
+    struct Bucket {
+        int64_t count = 0;
+        uint64_t sumLow = 0;
+        uint64_t sumHigh = 0;
+    };
+
+    using Buckets = std::vector<Bucket>;
+
+    /**
+     * The change one document write makes to its bucket.
+     */
+    struct Delta {
+        int bucket = 0;
+        Bucket change;
+    };
+
+    explicit DbCheckCollectionDigest(CollectionUUID uuid);
+
+    /**
+     * Digests are only kept for collections whose documents are all visible to OpObservers and
+     * whose _id index is in simple binary order: capped collections (whose deletes are not
+     * observed) and collections with a default collation fall back to batch hashing.
+     */
+    static bool isSupported(Collection* collection);
+
+    /**
+     * The delta that inserting (`sign` = 1) or removing (`sign` = -1) `doc` applies.
+     */
+    static Delta deltaFor(const BSONObj& doc, int sign);
+
+    /**
+     * The delta that replacing `preImage` by `postImage` applies. Both must have the same _id.
+     */
+    static Delta deltaForUpdate(const BSONObj& preImage, const BSONObj& postImage);
+
+    const CollectionUUID& uuid() const {
+        return _uuid;
+    }
+
+    /**
+     * Whether a write to `doc` must be applied to this digest, i.e. whether the build has already
+     * scanned past its _id.
+     */
+    bool covers(const BSONObj& doc) const;
+
+    bool isComplete() const;
+
+    /**
+     * The last _id the build has scanned through (inclusive); MaxKey once the digest is complete.
+     */
+    BSONKey builtThrough() const;
+
+    void apply(const std::vector<Delta>& deltas);
+
+    /**
+     * Scans documents after the build position up to and including `through`, adding at most
+     * `maxDocs` of them, and moves the build position past them. Scanning through MaxKey completes
+     * the digest. Returns the number of documents added. The caller must hold the collection lock
+     * in at least MODE_S.
+     */
+    StatusWith<int64_t> extend(OperationContext* opCtx,
+                               Collection* collection,
+                               const BSONKey& through,
+                               int64_t maxDocs = std::numeric_limits<int64_t>::max());
+
+    Buckets buckets() const;
+
+    /**
+     * The Merkle root over `buckets`, as a hex string.
+     */
+    static std::string rootHash(const Buckets& buckets);
+
+    /**
+     * The indexes of the buckets that differ between `expected` and `found`, found by comparing
+     * interior nodes first and only descending into those that differ.
+     */
+    static std::vector<int> differingBuckets(const Buckets& expected, const Buckets& found);
+
+    static std::vector<std::uint8_t> serialize(const Buckets& buckets);
+    static StatusWith<Buckets> parse(ConstDataRange data);
+
+private:
+    const CollectionUUID _uuid;
+
+    mutable stdx::mutex _mutex;
+    Buckets _buckets;
+    BSONKey _builtThrough = BSONKey::min();
+    bool _complete = false;
+};
+
+/**
+ * The digests currently being maintained, one per collection, keyed by namespace.
+ *
+ * Anything that replaces a collection's contents without going through the document-level
+ * OpObserver methods (drops, renames, emptycapped, rollback) invalidates the affected digests,
+ * which are then rebuilt on the next dbCheck.
+ */
+class DbCheckDigestCatalog {
+public:
+    static DbCheckDigestCatalog& get(ServiceContext* svcCtx);
+    static DbCheckDigestCatalog& get(OperationContext* opCtx);
+
+    /**
+     * The digest tracking `nss`, or nullptr if there is none.
+     */
+    std::shared_ptr<DbCheckCollectionDigest> lookup(const NamespaceString& nss) const;
+
+    /**
+     * The digest for `collection`, starting an empty one if none is tracked or the tracked one
+     * belongs to a different collection under the same name. The caller must hold the collection
+     * lock in at least MODE_S.
+     */
+    std::shared_ptr<DbCheckCollectionDigest> getOrCreate(Collection* collection);
+
+    void invalidate(const NamespaceString& nss);
+    void invalidateDatabase(StringData dbName);
+    void invalidateAll();
+
+private:
+    mutable stdx::mutex _mutex;
+    StringMap<std::shared_ptr<DbCheckCollectionDigest>> _digests;
+};
+
+}  // namespace mongo
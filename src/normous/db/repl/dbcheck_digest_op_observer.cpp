@@ -0,0 +1,205 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/dbcheck_digest_op_observer.h"
+
+#include "mongo/db/operation_context.h"
+#include "mongo/db/repl/dbcheck_digest.h"
+
+namespace mongo {
+namespace {
+
+struct PendingDelete {
+    std::shared_ptr<DbCheckCollectionDigest> digest;
+    DbCheckCollectionDigest::Delta delta;
+};
+
+// Carries the deleted document's delta from aboutToDelete, which sees the document, to onDelete,
+// which is called once it is gone.
+const auto getPendingDelete =
+    OperationContext::declareDecoration<boost::optional<PendingDelete>>();
+
+/**
+ * Returns the digest of `nss` if writes to it must be tracked, dropping it if it no longer
+ * belongs to the collection with `uuid`.
+ */
+std::shared_ptr<DbCheckCollectionDigest> trackedDigest(OperationContext* opCtx,
+                                                       const NamespaceString& nss,
+                                                       const OptionalCollectionUUID& uuid) {
+    auto& catalog = DbCheckDigestCatalog::get(opCtx);
+    auto digest = catalog.lookup(nss);
+    if (digest && uuid && digest->uuid() != *uuid) {
+        catalog.invalidate(nss);
+        return nullptr;
+    }
+    return digest;
+}
+
+void applyOnCommit(OperationContext* opCtx,
+                   std::shared_ptr<DbCheckCollectionDigest> digest,
+                   std::vector<DbCheckCollectionDigest::Delta> deltas) {
+    if (deltas.empty()) {
+        return;
+    }
+
+    opCtx->recoveryUnit()->onCommit(
+        [ digest = std::move(digest), deltas = std::move(deltas) ](boost::optional<Timestamp>) {
+            digest->apply(deltas);
+        });
+}
+
+}  // namespace
+
+DbCheckDigestOpObserver::DbCheckDigestOpObserver() = default;
+
+DbCheckDigestOpObserver::~DbCheckDigestOpObserver() = default;
+
+void DbCheckDigestOpObserver::onInserts(OperationContext* opCtx,
+                                        const NamespaceString& nss,
+                                        OptionalCollectionUUID uuid,
+                                        std::vector<InsertStatement>::const_iterator begin,
+                                        std::vector<InsertStatement>::const_iterator end,
+                                        bool fromMigrate) {
+    auto digest = trackedDigest(opCtx, nss, uuid);
+    if (!digest) {
+        return;
+    }
+
+    std::vector<DbCheckCollectionDigest::Delta> deltas;
+    for (auto it = begin; it != end; ++it) {
+        if (digest->covers(it->doc)) {
+            deltas.push_back(DbCheckCollectionDigest::deltaFor(it->doc, 1));
+        }
+    }
+
+    applyOnCommit(opCtx, std::move(digest), std::move(deltas));
+}
+
+void DbCheckDigestOpObserver::onUpdate(OperationContext* opCtx, const OplogUpdateEntryArgs& args) {
+    auto digest = trackedDigest(opCtx, args.nss, args.uuid);
+    if (!digest) {
+        return;
+    }
+
+    const auto& preImage = args.updateArgs.preImageDoc;
+    if (!preImage) {
+        // Without the old version of the document there is nothing to subtract.
+        DbCheckDigestCatalog::get(opCtx).invalidate(args.nss);
+        return;
+    }
+
+    if (digest->covers(args.updateArgs.updatedDoc)) {
+        applyOnCommit(opCtx,
+                      std::move(digest),
+                      {DbCheckCollectionDigest::deltaForUpdate(*preImage,
+                                                               args.updateArgs.updatedDoc)});
+    }
+}
+
+void DbCheckDigestOpObserver::aboutToDelete(OperationContext* opCtx,
+                                            const NamespaceString& nss,
+                                            const BSONObj& doc) {
+    auto& pending = getPendingDelete(opCtx);
+    pending = boost::none;
+
+    auto digest = trackedDigest(opCtx, nss, boost::none);
+    if (digest && digest->covers(doc)) {
+        pending = PendingDelete{std::move(digest), DbCheckCollectionDigest::deltaFor(doc, -1)};
+    }
+}
+
+void DbCheckDigestOpObserver::onDelete(OperationContext* opCtx,
+                                       const NamespaceString& nss,
+                                       OptionalCollectionUUID uuid,
+                                       StmtId stmtId,
+                                       bool fromMigrate,
+                                       const boost::optional<BSONObj>& deletedDoc) {
+    auto& pending = getPendingDelete(opCtx);
+    if (!pending) {
+        return;
+    }
+
+    applyOnCommit(opCtx, std::move(pending->digest), {pending->delta});
+    pending = boost::none;
+}
+
+void DbCheckDigestOpObserver::onCreateCollection(OperationContext* opCtx,
+                                                 Collection* coll,
+                                                 const NamespaceString& collectionName,
+                                                 const CollectionOptions& options,
+                                                 const BSONObj& idIndex,
+                                                 const OplogSlot& createOpTime) {
+    DbCheckDigestCatalog::get(opCtx).invalidate(collectionName);
+}
+
+void DbCheckDigestOpObserver::onDropDatabase(OperationContext* opCtx, const std::string& dbName) {
+    DbCheckDigestCatalog::get(opCtx).invalidateDatabase(dbName);
+}
+
+repl::OpTime DbCheckDigestOpObserver::onDropCollection(OperationContext* opCtx,
+                                                       const NamespaceString& collectionName,
+                                                       OptionalCollectionUUID uuid) {
+    DbCheckDigestCatalog::get(opCtx).invalidate(collectionName);
+    return {};
+}
+
+void DbCheckDigestOpObserver::onRenameCollection(OperationContext* opCtx,
+                                                 const NamespaceString& fromCollection,
+                                                 const NamespaceString& toCollection,
+                                                 OptionalCollectionUUID uuid,
+                                                 OptionalCollectionUUID dropTargetUUID,
+                                                 bool stayTemp) {
+    postRenameCollection(opCtx, fromCollection, toCollection, uuid, dropTargetUUID, stayTemp);
+}
+
+void DbCheckDigestOpObserver::postRenameCollection(OperationContext* opCtx,
+                                                   const NamespaceString& fromCollection,
+                                                   const NamespaceString& toCollection,
+                                                   OptionalCollectionUUID uuid,
+                                                   OptionalCollectionUUID dropTargetUUID,
+                                                   bool stayTemp) {
+    auto& catalog = DbCheckDigestCatalog::get(opCtx);
+    catalog.invalidate(fromCollection);
+    catalog.invalidate(toCollection);
+}
+
+void DbCheckDigestOpObserver::onEmptyCapped(OperationContext* opCtx,
+                                            const NamespaceString& collectionName,
+                                            OptionalCollectionUUID uuid) {
+    DbCheckDigestCatalog::get(opCtx).invalidate(collectionName);
+}
+
+void DbCheckDigestOpObserver::onReplicationRollback(OperationContext* opCtx,
+                                                    const RollbackObserverInfo& rbInfo) {
+    // Data on disk has been reverted underneath every digest.
+    DbCheckDigestCatalog::get(opCtx).invalidateAll();
+}
+
+}  // namespace mongo
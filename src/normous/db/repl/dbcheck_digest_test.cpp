@@ -0,0 +1,110 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/repl/dbcheck_digest.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using Digest = DbCheckCollectionDigest;
+
+Digest::Buckets digestOf(const std::vector<BSONObj>& docs) {
+    Digest digest(UUID::gen());
+    std::vector<Digest::Delta> deltas;
+    for (const auto& doc : docs) {
+        deltas.push_back(Digest::deltaFor(doc, 1));
+    }
+    digest.apply(deltas);
+    return digest.buckets();
+}
+
+TEST(DbCheckDigestTest, InsertAndDeleteCancelOut) {
+    auto doc = BSON("_id" << 1 << "x" << 2);
+
+    Digest digest(UUID::gen());
+    digest.apply({Digest::deltaFor(doc, 1), Digest::deltaFor(doc, -1)});
+
+    auto empty = Digest::Buckets(Digest::kNumBuckets);
+    ASSERT_EQ(Digest::rootHash(empty), Digest::rootHash(digest.buckets()));
+    ASSERT_TRUE(Digest::differingBuckets(empty, digest.buckets()).empty());
+}
+
+TEST(DbCheckDigestTest, DigestIsIndependentOfOrder) {
+    auto a = BSON("_id" << 1 << "x" << 1);
+    auto b = BSON("_id" << 2 << "x" << 2);
+    auto c = BSON("_id"
+                  << "three"
+                  << "x"
+                  << 3);
+
+    ASSERT_EQ(Digest::rootHash(digestOf({a, b, c})), Digest::rootHash(digestOf({c, a, b})));
+    ASSERT_NE(Digest::rootHash(digestOf({a, b, c})), Digest::rootHash(digestOf({a, b})));
+}
+
+TEST(DbCheckDigestTest, UpdateMatchesInsertOfNewVersion) {
+    auto before = BSON("_id" << 1 << "x" << 1);
+    auto after = BSON("_id" << 1 << "x" << 2);
+
+    Digest digest(UUID::gen());
+    digest.apply({Digest::deltaFor(before, 1)});
+    digest.apply({Digest::deltaForUpdate(before, after)});
+
+    ASSERT_EQ(Digest::rootHash(digestOf({after})), Digest::rootHash(digest.buckets()));
+}
+
+TEST(DbCheckDigestTest, DifferingBucketsFindsOnlyChangedBucket) {
+    auto a = BSON("_id" << 1);
+    auto b = BSON("_id" << 2);
+    auto changed = BSON("_id" << 2 << "y" << 1);
+
+    auto differing = Digest::differingBuckets(digestOf({a, b}), digestOf({a, changed}));
+    ASSERT_EQ(1U, differing.size());
+    ASSERT_EQ(Digest::deltaFor(b, 1).bucket, differing[0]);
+}
+
+TEST(DbCheckDigestTest, SerializeRoundTrips) {
+    auto buckets = digestOf({BSON("_id" << 1), BSON("_id" << 2)});
+    auto serialized = Digest::serialize(buckets);
+
+    auto parsed = Digest::parse(
+        ConstDataRange(reinterpret_cast<const char*>(serialized.data()), serialized.size()));
+    ASSERT_OK(parsed.getStatus());
+    ASSERT_EQ(Digest::rootHash(buckets), Digest::rootHash(parsed.getValue()));
+    ASSERT_TRUE(Digest::differingBuckets(buckets, parsed.getValue()).empty());
+
+    auto truncated = Digest::parse(
+        ConstDataRange(reinterpret_cast<const char*>(serialized.data()), serialized.size() - 1));
+    ASSERT_EQ(ErrorCodes::BadValue, truncated.getStatus());
+}
+
+}  // namespace
+}  // namespace mongo
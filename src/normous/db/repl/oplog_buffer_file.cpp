@@ -0,0 +1,224 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/oplog_buffer_file.h"
+
+#include <boost/filesystem/operations.hpp>
+
+#include "mongo/base/data_view.h"
+#include "mongo/bson/oid.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/mongoutils/str.h"
+#include "mongo/util/shared_buffer.h"
+
+namespace mongo {
+namespace repl {
+
+OplogBufferFile::OplogBufferFile(std::string fileName) : _fileName(std::move(fileName)) {}
+
+std::string OplogBufferFile::makeInitialSyncFileName() {
+    return str::stream() << storageGlobalParams.getTmpDirectory() << "/initialSyncOplogBuffer-"
+                         << OID::gen().toString();
+}
+
+void OplogBufferFile::startup(OperationContext*) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    const auto directory = boost::filesystem::path(_fileName).parent_path();
+    if (!directory.empty()) {
+        boost::filesystem::create_directories(directory);
+    }
+    _file.open(_fileName, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+    uassert(ErrorCodes::FileOpenFailed,
+            str::stream() << "Failed to open oplog buffer file " << _fileName,
+            _file.is_open());
+    _reset_inlock();
+}
+
+void OplogBufferFile::shutdown(OperationContext*) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _reset_inlock();
+    if (_file.is_open()) {
+        _file.close();
+    }
+    boost::system::error_code ec;
+    boost::filesystem::remove(_fileName, ec);
+}
+
+void OplogBufferFile::pushEvenIfFull(OperationContext* opCtx, const Value& value) {
+    Batch valueBatch = {value};
+    pushAllNonBlocking(opCtx, valueBatch.begin(), valueBatch.end());
+}
+
+void OplogBufferFile::push(OperationContext* opCtx, const Value& value) {
+    pushEvenIfFull(opCtx, value);
+}
+
+void OplogBufferFile::pushAllNonBlocking(OperationContext*,
+                                         Batch::const_iterator begin,
+                                         Batch::const_iterator end) {
+    if (begin == end) {
+        return;
+    }
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        for (auto it = begin; it != end; ++it) {
+            _push_inlock(*it);
+        }
+        _file.flush();
+        uassert(ErrorCodes::FileStreamFailed,
+                str::stream() << "Failed to write to oplog buffer file " << _fileName,
+                _file.good());
+    }
+    _cvNoLongerEmpty.notify_all();
+}
+
+void OplogBufferFile::waitForSpace(OperationContext*, std::size_t) {}
+
+bool OplogBufferFile::isEmpty() const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return _count == 0;
+}
+
+std::size_t OplogBufferFile::getMaxSize() const {
+    return 0;
+}
+
+std::size_t OplogBufferFile::getSize() const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return _size;
+}
+
+std::size_t OplogBufferFile::getCount() const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return _count;
+}
+
+void OplogBufferFile::clear(OperationContext*) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _reset_inlock();
+}
+
+bool OplogBufferFile::tryPop(OperationContext*, Value* value) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    if (_count == 0) {
+        return false;
+    }
+    if (_peeked) {
+        *value = std::move(*_peeked);
+        _peeked = boost::none;
+    } else {
+        *value = _readFront_inlock();
+    }
+    _readOffset += value->objsize();
+    _size -= std::size_t(value->objsize());
+    if (--_count == 0) {
+        // The popper has caught up, so the file can be written again from its start.
+        _readOffset = 0;
+        _writeOffset = 0;
+        _lastPushed = boost::none;
+    }
+    return true;
+}
+
+bool OplogBufferFile::waitForData(Seconds waitDuration) {
+    stdx::unique_lock<stdx::mutex> lk(_mutex);
+    if (!_cvNoLongerEmpty.wait_for(
+            lk, waitDuration.toSystemDuration(), [&]() { return _count != 0; })) {
+        return false;
+    }
+    return _count != 0;
+}
+
+bool OplogBufferFile::peek(OperationContext*, Value* value) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    if (_count == 0) {
+        return false;
+    }
+    if (!_peeked) {
+        _peeked = _readFront_inlock();
+    }
+    *value = *_peeked;
+    return true;
+}
+
+boost::optional<OplogBuffer::Value> OplogBufferFile::lastObjectPushed(OperationContext*) const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return _lastPushed;
+}
+
+const std::string& OplogBufferFile::getFileName() const {
+    return _fileName;
+}
+
+void OplogBufferFile::_push_inlock(const Value& value) {
+    _file.seekp(_writeOffset);
+    _file.write(value.objdata(), value.objsize());
+    uassert(ErrorCodes::FileStreamFailed,
+            str::stream() << "Failed to write to oplog buffer file " << _fileName,
+            _file.good());
+    _writeOffset += value.objsize();
+    _size += std::size_t(value.objsize());
+    ++_count;
+    _lastPushed = value.getOwned();
+}
+
+OplogBuffer::Value OplogBufferFile::_readFront_inlock() {
+    invariant(_readOffset < _writeOffset);
+    _file.seekg(_readOffset);
+    char sizeBytes[sizeof(int32_t)];
+    _file.read(sizeBytes, sizeof(sizeBytes));
+    const int32_t objSize = ConstDataView(sizeBytes).read<LittleEndian<int32_t>>();
+    uassert(ErrorCodes::FileStreamFailed,
+            str::stream() << "Failed to read from oplog buffer file " << _fileName,
+            _file.good() && objSize >= BSONObj::kMinBSONLength &&
+                _readOffset + objSize <= _writeOffset);
+
+    auto buffer = SharedBuffer::allocate(objSize);
+    memcpy(buffer.get(), sizeBytes, sizeof(sizeBytes));
+    _file.read(buffer.get() + sizeof(sizeBytes), objSize - sizeof(sizeBytes));
+    uassert(ErrorCodes::FileStreamFailed,
+            str::stream() << "Failed to read from oplog buffer file " << _fileName,
+            _file.good());
+    return BSONObj(std::move(buffer));
+}
+
+void OplogBufferFile::_reset_inlock() {
+    _readOffset = 0;
+    _writeOffset = 0;
+    _count = 0;
+    _size = 0;
+    _peeked = boost::none;
+    _lastPushed = boost::none;
+    _file.clear();
+}
+
+}  // namespace repl
+}  // namespace mongo
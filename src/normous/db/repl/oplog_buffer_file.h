@@ -0,0 +1,115 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <fstream>
+#include <string>
+
+#include "mongo/db/repl/oplog_buffer.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+
+namespace mongo {
+namespace repl {
+
+/**
+ * Oplog buffer backed by an append-only file. Entries are appended and read back in order, so
+ * buffering costs sequential writes and reads instead of a collection insert and delete each.
+ * Whenever the popper catches up with the pusher, the file is rewound and reused from its start.
+ *
+ * Like OplogBufferCollection, the contents are not recovered after a restart: initial sync starts
+ * over, and the file lives in the temporary directory, which is cleared on startup.
+ */
+class OplogBufferFile final : public OplogBuffer {
+public:
+    explicit OplogBufferFile(std::string fileName);
+
+    /**
+     * Returns a new file name for an initial sync oplog buffer in the temporary directory.
+     */
+    static std::string makeInitialSyncFileName();
+
+    void startup(OperationContext* opCtx) override;
+    void shutdown(OperationContext* opCtx) override;
+    void pushEvenIfFull(OperationContext* opCtx, const Value& value) override;
+    void push(OperationContext* opCtx, const Value& value) override;
+    void pushAllNonBlocking(OperationContext* opCtx,
+                            Batch::const_iterator begin,
+                            Batch::const_iterator end) override;
+    void waitForSpace(OperationContext* opCtx, std::size_t size) override;
+    bool isEmpty() const override;
+    std::size_t getMaxSize() const override;
+    std::size_t getSize() const override;
+    std::size_t getCount() const override;
+    void clear(OperationContext* opCtx) override;
+    bool tryPop(OperationContext* opCtx, Value* value) override;
+    bool waitForData(Seconds waitDuration) override;
+    bool peek(OperationContext* opCtx, Value* value) override;
+    boost::optional<Value> lastObjectPushed(OperationContext* opCtx) const override;
+
+    /**
+     * Returns the name of the backing file.
+     */
+    const std::string& getFileName() const;
+
+private:
+    void _push_inlock(const Value& value);
+
+    /**
+     * Reads the entry at '_readOffset' without consuming it.
+     */
+    Value _readFront_inlock();
+
+    void _reset_inlock();
+
+    const std::string _fileName;
+
+    // Protects member data below and synchronizes it with the underlying file.
+    mutable stdx::mutex _mutex;
+
+    stdx::condition_variable _cvNoLongerEmpty;
+
+    std::fstream _file;
+
+    // Offsets in '_file' of the next entry to pop and of the end of the last entry pushed.
+    std::streamoff _readOffset = 0;
+    std::streamoff _writeOffset = 0;
+
+    std::size_t _count = 0;
+    std::size_t _size = 0;
+
+    // The front entry, once read by peek(), so that the following tryPop() does not read it again.
+    boost::optional<Value> _peeked;
+
+    boost::optional<Value> _lastPushed;
+};
+
+}  // namespace repl
+}  // namespace mongo
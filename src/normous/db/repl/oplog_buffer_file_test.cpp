@@ -0,0 +1,150 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <boost/filesystem/operations.hpp>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/repl/oplog_buffer_file.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/temp_dir.h"
+#include "mongo/unittest/unittest.h"
+
+namespace {
+
+using namespace mongo;
+using namespace mongo::repl;
+
+class OplogBufferFileTest : public unittest::Test {
+protected:
+    void setUp() override {
+        _buffer = stdx::make_unique<OplogBufferFile>(_tempDir.path() + "/buffer");
+        _buffer->startup(nullptr);
+    }
+
+    void tearDown() override {
+        _buffer->shutdown(nullptr);
+    }
+
+    unittest::TempDir _tempDir{"oplog_buffer_file_test"};
+    std::unique_ptr<OplogBufferFile> _buffer;
+};
+
+BSONObj makeOplogEntry(int t) {
+    return BSON("ts" << Timestamp(t, t) << "h" << t << "ns"
+                     << "a.a"
+                     << "v"
+                     << 2
+                     << "op"
+                     << "i"
+                     << "o"
+                     << BSON("_id" << t << "a" << t));
+}
+
+TEST_F(OplogBufferFileTest, StartupCreatesFileAndShutdownRemovesIt) {
+    ASSERT_TRUE(boost::filesystem::exists(_buffer->getFileName()));
+    _buffer->shutdown(nullptr);
+    ASSERT_FALSE(boost::filesystem::exists(_buffer->getFileName()));
+}
+
+TEST_F(OplogBufferFileTest, PopAndPeekReturnDocumentsInOrder) {
+    OplogBuffer::Batch oplog = {makeOplogEntry(1), BSONObj(), makeOplogEntry(3)};
+    _buffer->pushAllNonBlocking(nullptr, oplog.begin(), oplog.end());
+    ASSERT_EQUALS(3U, _buffer->getCount());
+    ASSERT_EQUALS(std::size_t(oplog[0].objsize() + oplog[1].objsize() + oplog[2].objsize()),
+                  _buffer->getSize());
+    ASSERT_BSONOBJ_EQ(oplog[2], *_buffer->lastObjectPushed(nullptr));
+
+    for (const auto& expected : oplog) {
+        BSONObj peeked;
+        ASSERT_TRUE(_buffer->peek(nullptr, &peeked));
+        ASSERT_BSONOBJ_EQ(expected, peeked);
+
+        BSONObj popped;
+        ASSERT_TRUE(_buffer->tryPop(nullptr, &popped));
+        ASSERT_BSONOBJ_EQ(expected, popped);
+    }
+    BSONObj doc;
+    ASSERT_FALSE(_buffer->peek(nullptr, &doc));
+    ASSERT_FALSE(_buffer->tryPop(nullptr, &doc));
+    ASSERT_TRUE(_buffer->isEmpty());
+    ASSERT_EQUALS(0U, _buffer->getSize());
+    ASSERT_FALSE(_buffer->lastObjectPushed(nullptr));
+}
+
+TEST_F(OplogBufferFileTest, FileIsReusedOnceDrained) {
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 10; ++i) {
+            _buffer->push(nullptr, makeOplogEntry(round * 10 + i));
+        }
+        for (int i = 0; i < 10; ++i) {
+            BSONObj doc;
+            ASSERT_TRUE(_buffer->tryPop(nullptr, &doc));
+            ASSERT_BSONOBJ_EQ(makeOplogEntry(round * 10 + i), doc);
+        }
+    }
+    ASSERT_EQUALS(boost::filesystem::file_size(_buffer->getFileName()),
+                  10 * std::size_t(makeOplogEntry(0).objsize()));
+}
+
+TEST_F(OplogBufferFileTest, PushAfterPartialPopKeepsOrder) {
+    _buffer->push(nullptr, makeOplogEntry(1));
+    _buffer->push(nullptr, makeOplogEntry(2));
+    BSONObj doc;
+    ASSERT_TRUE(_buffer->tryPop(nullptr, &doc));
+    ASSERT_BSONOBJ_EQ(makeOplogEntry(1), doc);
+    ASSERT_TRUE(_buffer->peek(nullptr, &doc));
+    _buffer->push(nullptr, makeOplogEntry(3));
+
+    ASSERT_TRUE(_buffer->tryPop(nullptr, &doc));
+    ASSERT_BSONOBJ_EQ(makeOplogEntry(2), doc);
+    ASSERT_TRUE(_buffer->tryPop(nullptr, &doc));
+    ASSERT_BSONOBJ_EQ(makeOplogEntry(3), doc);
+}
+
+TEST_F(OplogBufferFileTest, ClearEmptiesBuffer) {
+    _buffer->push(nullptr, makeOplogEntry(1));
+    _buffer->clear(nullptr);
+    ASSERT_TRUE(_buffer->isEmpty());
+    ASSERT_EQUALS(0U, _buffer->getSize());
+    _buffer->push(nullptr, makeOplogEntry(2));
+    BSONObj doc;
+    ASSERT_TRUE(_buffer->tryPop(nullptr, &doc));
+    ASSERT_BSONOBJ_EQ(makeOplogEntry(2), doc);
+}
+
+TEST_F(OplogBufferFileTest, WaitForDataReturnsOnceDocumentIsPushed) {
+    ASSERT_FALSE(_buffer->waitForData(Seconds(0)));
+    stdx::thread pusher([this] { _buffer->push(nullptr, makeOplogEntry(1)); });
+    ASSERT_TRUE(_buffer->waitForData(Seconds(30)));
+    pusher.join();
+}
+
+}  // namespace
@@ -0,0 +1,247 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kReplication
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/oplog_prefetcher.h"
+
+#include <algorithm>
+
+#include "mongo/base/counter.h"
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/catalog_raii.h"
+#include "mongo/db/client.h"
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/concurrency/locker.h"
+#include "mongo/db/dbhelpers.h"
+#include "mongo/db/index/index_access_method.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/util/log.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+// Number of threads reading ahead of oplog application on secondaries. Zero, the default, disables
+// prefetching.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(replPrefetchThreadCount, int, 0)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0 || newVal > 256) {
+            return Status(ErrorCodes::BadValue,
+                          "replPrefetchThreadCount must be between 0 and 256");
+        }
+        return Status::OK();
+    });
+
+// Batches are not split into tasks smaller than this, so that small batches don't pay for waking
+// up every prefetch thread.
+constexpr size_t kMinTargetsPerTask = 16;
+
+// Batches prefetched, batches skipped because the previous prefetch was still running, and reads
+// issued for the prefetched batches.
+Counter64 prefetchedBatchesStats;
+ServerStatusMetricField<Counter64> displayPrefetchedBatches("repl.prefetch.batches",
+                                                            &prefetchedBatchesStats);
+Counter64 skippedBatchesStats;
+ServerStatusMetricField<Counter64> displaySkippedBatches("repl.prefetch.batchesSkipped",
+                                                         &skippedBatchesStats);
+Counter64 prefetchTargetsStats;
+ServerStatusMetricField<Counter64> displayPrefetchTargets("repl.prefetch.targets",
+                                                          &prefetchTargetsStats);
+
+void prefetchTarget(OperationContext* opCtx,
+                    Collection* collection,
+                    const OplogPrefetcher::Target& target) {
+    if (!target.idQuery.isEmpty()) {
+        const auto recordId = Helpers::findById(opCtx, collection, target.idQuery);
+        if (!recordId.isNull()) {
+            Snapshotted<BSONObj> doc;
+            collection->findDoc(opCtx, recordId, &doc);
+        }
+    }
+
+    if (!target.insertedDoc.isEmpty()) {
+        auto ii = collection->getIndexCatalog()->getIndexIterator(opCtx, false);
+        while (ii.more()) {
+            const auto desc = ii.next();
+            ii.accessMethod(desc)->touch(opCtx, target.insertedDoc).ignore();
+        }
+    }
+}
+
+}  // namespace
+
+std::unique_ptr<OplogPrefetcher> OplogPrefetcher::makeIfEnabled() {
+    if (replPrefetchThreadCount <= 0) {
+        return nullptr;
+    }
+    return stdx::make_unique<OplogPrefetcher>(static_cast<size_t>(replPrefetchThreadCount));
+}
+
+OplogPrefetcher::OplogPrefetcher(size_t threadCount) {
+    ThreadPool::Options options;
+    options.threadNamePrefix = "repl prefetch worker ";
+    options.poolName = "repl prefetch worker Pool";
+    options.maxThreads = options.minThreads = threadCount;
+    options.onCreateThread = [](const std::string&) {
+        Client::initThreadIfNotAlready();
+        AuthorizationSession::get(cc())->grantInternalAuthorization();
+    };
+    _pool = stdx::make_unique<ThreadPool>(options);
+    _pool->startup();
+}
+
+OplogPrefetcher::~OplogPrefetcher() {
+    _pool->shutdown();
+    _pool->join();
+}
+
+std::vector<OplogPrefetcher::Target> OplogPrefetcher::collectTargets(
+    const std::vector<OplogEntry>& ops, ReplSettings::IndexPrefetchConfig config) {
+    std::vector<Target> targets;
+    if (config == ReplSettings::IndexPrefetchConfig::PREFETCH_NONE) {
+        return targets;
+    }
+
+    for (const auto& op : ops) {
+        if (!op.isCrudOpType()) {
+            continue;
+        }
+
+        const auto id = op.getIdElement();
+        if (id.eoo()) {
+            continue;
+        }
+
+        Target target{op.getNss(), op.getUuid(), BSONObj(), BSONObj()};
+        if (op.getOpType() == OpTypeEnum::kInsert &&
+            config == ReplSettings::IndexPrefetchConfig::PREFETCH_ALL) {
+            // Touching the keys of the new document in every index covers the _id index too.
+            target.insertedDoc = op.getObject().getOwned();
+        } else {
+            target.idQuery = id.wrap();
+        }
+        targets.push_back(std::move(target));
+    }
+
+    // Keep the entries for each collection together so that a task locks each collection once.
+    std::stable_sort(targets.begin(), targets.end(), [](const Target& lhs, const Target& rhs) {
+        return lhs.nss < rhs.nss;
+    });
+    return targets;
+}
+
+bool OplogPrefetcher::prefetch(const std::vector<OplogEntry>& ops,
+                               ReplSettings::IndexPrefetchConfig config) {
+    if (config == ReplSettings::IndexPrefetchConfig::PREFETCH_NONE) {
+        return false;
+    }
+    if (_tasksInFlight.load() > 0) {
+        skippedBatchesStats.increment();
+        return false;
+    }
+
+    auto targets = std::make_shared<const std::vector<Target>>(collectTargets(ops, config));
+    if (targets->empty()) {
+        return false;
+    }
+
+    const auto numThreads = _pool->getStats().numThreads;
+    const auto numTasks = std::max<size_t>(
+        1, std::min(numThreads, targets->size() / kMinTargetsPerTask));
+    const auto targetsPerTask = (targets->size() + numTasks - 1) / numTasks;
+
+    for (size_t begin = 0; begin < targets->size(); begin += targetsPerTask) {
+        const auto end = std::min(begin + targetsPerTask, targets->size());
+        _tasksInFlight.addAndFetch(1);
+        auto status = _pool->schedule([this, targets, begin, end] {
+            ON_BLOCK_EXIT([this] { _tasksInFlight.subtractAndFetch(1); });
+            auto opCtx = cc().makeOperationContext();
+            _prefetchTargets(opCtx.get(), *targets, begin, end);
+        });
+        if (!status.isOK()) {
+            // The pool is shutting down.
+            _tasksInFlight.subtractAndFetch(1);
+            break;
+        }
+    }
+
+    prefetchedBatchesStats.increment();
+    prefetchTargetsStats.increment(targets->size());
+    return true;
+}
+
+void OplogPrefetcher::waitForIdle() {
+    _pool->waitForIdle();
+}
+
+void OplogPrefetcher::_prefetchTargets(OperationContext* opCtx,
+                                       const std::vector<Target>& targets,
+                                       size_t begin,
+                                       size_t end) {
+    // The reads only warm the cache, so they must not wait for the batch being applied.
+    ShouldNotConflictWithSecondaryBatchApplicationBlock noPBWMBlock(opCtx->lockState());
+
+    auto groupBegin = begin;
+    while (groupBegin < end) {
+        const auto& nss = targets[groupBegin].nss;
+        auto groupEnd = groupBegin + 1;
+        while (groupEnd < end && targets[groupEnd].nss == nss) {
+            ++groupEnd;
+        }
+
+        try {
+            const auto& uuid = targets[groupBegin].uuid;
+            AutoGetCollection autoColl(opCtx,
+                                       uuid ? NamespaceStringOrUUID(nss.db().toString(), *uuid)
+                                            : NamespaceStringOrUUID(nss),
+                                       MODE_IS);
+            if (auto collection = autoColl.getCollection()) {
+                for (auto i = groupBegin; i < groupEnd; ++i) {
+                    prefetchTarget(opCtx, collection, targets[i]);
+                }
+            }
+        } catch (const DBException& ex) {
+            // The collection may have been dropped or renamed by the batch being applied, in which
+            // case there is nothing to prefetch.
+            LOG(2) << "Failed to prefetch pages for " << nss << causedBy(ex);
+        }
+
+        groupBegin = groupEnd;
+    }
+}
+
+}  // namespace repl
+}  // namespace mongo
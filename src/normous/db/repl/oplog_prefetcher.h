@@ -0,0 +1,120 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <memory>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/repl/oplog_entry.h"
+#include "mongo/db/repl/repl_settings.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/uuid.h"
+
+namespace mongo {
+
+class OperationContext;
+
+namespace repl {
+
+/**
+ * Warms the storage engine cache for an oplog batch while the previous batch is still being
+ * applied, so that the writer threads find the pages they need already in cache.
+ *
+ * For every update and delete in the batch the _id index entry and the document are read, and for
+ * every insert the keys of the new document are touched in the collection's indexes (only the _id
+ * index in "_id_only" mode). The reads run on a dedicated pool without conflicting with batch
+ * application. They are purely advisory: failures are ignored, and a batch is skipped if the
+ * prefetch of the previous one has not finished yet, so that a slow prefetch never delays
+ * application.
+ */
+class OplogPrefetcher {
+    MONGO_DISALLOW_COPYING(OplogPrefetcher);
+
+public:
+    /**
+     * A read warming the pages a single oplog entry will need.
+     */
+    struct Target {
+        NamespaceString nss;
+        boost::optional<UUID> uuid;
+
+        // The {_id: ...} of the document the entry updates or deletes. Empty for inserts.
+        BSONObj idQuery;
+
+        // The document the entry inserts, whose index keys are touched. Empty otherwise.
+        BSONObj insertedDoc;
+    };
+
+    /**
+     * Returns a prefetcher with the configured number of threads, or nullptr if prefetching is
+     * disabled.
+     */
+    static std::unique_ptr<OplogPrefetcher> makeIfEnabled();
+
+    explicit OplogPrefetcher(size_t threadCount);
+    ~OplogPrefetcher();
+
+    /**
+     * Returns the reads warming the pages needed to apply 'ops', grouped by collection. Commands,
+     * no-ops and entries without an _id produce no targets.
+     */
+    static std::vector<Target> collectTargets(const std::vector<OplogEntry>& ops,
+                                              ReplSettings::IndexPrefetchConfig config);
+
+    /**
+     * Schedules the prefetch of 'ops' and returns without waiting for it. Returns false if nothing
+     * was scheduled because 'config' disables prefetching or the previous prefetch is still
+     * running.
+     */
+    bool prefetch(const std::vector<OplogEntry>& ops, ReplSettings::IndexPrefetchConfig config);
+
+    /**
+     * Blocks until every scheduled prefetch has finished. Used by tests.
+     */
+    void waitForIdle();
+
+private:
+    static void _prefetchTargets(OperationContext* opCtx,
+                                 const std::vector<Target>& targets,
+                                 size_t begin,
+                                 size_t end);
+
+    std::unique_ptr<ThreadPool> _pool;
+
+    // Number of scheduled tasks which have not finished yet.
+    AtomicWord<int> _tasksInFlight{0};
+};
+
+}  // namespace repl
+}  // namespace mongo
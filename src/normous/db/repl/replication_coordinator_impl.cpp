@@ -366,6 +366,10 @@ ReplicationCoordinatorImpl::ReplicationCoordinatorImpl(
 
     invariant(_service);
 
+    if (_settings.isPrefetchIndexModeSet()) {
+        _indexPrefetchConfig = _settings.getPrefetchIndexMode();
+    }
+
     if (!isReplEnabled()) {
         return;
     }
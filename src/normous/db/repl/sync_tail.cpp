@@ -33,8 +33,10 @@
 #include "mongo/db/repl/sync_tail.h"
 
 #include "third_party/murmurhash3/MurmurHash3.h"
+#include <algorithm>
 #include <boost/functional/hash.hpp>
 #include <memory>
+#include <numeric>
 
 #include "mongo/base/counter.h"
 #include "mongo/bson/bsonelement_comparator.h"
@@ -62,6 +64,7 @@
 #include "mongo/db/repl/bgsync.h"
 #include "mongo/db/repl/initial_syncer.h"
 #include "mongo/db/repl/multiapplier.h"
+#include "mongo/db/repl/oplog_prefetcher.h"
 #include "mongo/db/repl/oplogreader.h"
 #include "mongo/db/repl/repl_client_info.h"
 #include "mongo/db/repl/repl_set_config.h"
@@ -74,6 +77,7 @@
 #include "mongo/db/storage/recovery_unit.h"
 #include "mongo/db/transaction_participant.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/stdx/unordered_map.h"
 #include "mongo/util/exit.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/log.h"
@@ -100,6 +104,16 @@ ServerStatusMetricField<Counter64> displayAttemptsToBecomeSecondary(
 TimerStats applyBatchStats;
 ServerStatusMetricField<TimerStats> displayOpBatchesApplied("repl.apply.batches", &applyBatchStats);
 
+// The ops handed to writer threads, and for each batch the number of them handed to its busiest
+// writer. Their ratio, divided by the number of writers, is how much of the writer pool's capacity
+// batches keep busy.
+Counter64 writerOpsAssignedStats;
+ServerStatusMetricField<Counter64> displayWriterOpsAssigned("repl.apply.writers.opsAssigned",
+                                                            &writerOpsAssignedStats);
+Counter64 busiestWriterOpsStats;
+ServerStatusMetricField<Counter64> displayBusiestWriterOps("repl.apply.writers.busiestWriterOps",
+                                                           &busiestWriterOpsStats);
+
 class ApplyBatchFinalizer {
 public:
     ApplyBatchFinalizer(ReplicationCoordinator* replCoord) : _replCoord(replCoord) {}
@@ -225,17 +239,26 @@ NamespaceStringOrUUID getNsOrUUID(const NamespaceString& nss, const BSONObj& op)
     return nss;
 }
 
-}  // namespace
+NamespaceStringOrUUID getNsOrUUID(const OplogEntry& entry) {
+    if (auto& uuid = entry.getUuid()) {
+        return {entry.getNss().db().toString(), *uuid};
+    }
+    return entry.getNss();
+}
 
-// static
-Status SyncTail::syncApply(OperationContext* opCtx,
-                           const BSONObj& op,
-                           OplogApplication::Mode oplogApplicationMode) {
+/**
+ * Applies 'op', whose namespace and type have already been extracted. If 'entry' is not null, it
+ * must be the parsed form of 'op' and is used instead of looking fields up in 'op' again.
+ */
+Status syncApplyOperation(OperationContext* opCtx,
+                          const BSONObj& op,
+                          const NamespaceString& nss,
+                          OpTypeEnum opType,
+                          const OplogEntry* entry,
+                          OplogApplication::Mode oplogApplicationMode) {
     // Count each log op application as a separate operation, for reporting purposes
     CurOp individualOp(opCtx);
 
-    const NamespaceString nss(op.getStringField("ns"));
-
     auto incrementOpsAppliedStats = [] { opsAppliedStats.increment(1); };
 
     auto applyOp = [&](Database* db) {
@@ -261,8 +284,6 @@ Status SyncTail::syncApply(OperationContext* opCtx,
         return status;
     };
 
-    auto opType = OpType_parse(IDLParserErrorContext("syncApply"), op["op"].valuestrsafe());
-
     if (opType == OpTypeEnum::kNoop) {
         if (nss.db() == "") {
             return Status::OK();
@@ -274,7 +295,8 @@ Status SyncTail::syncApply(OperationContext* opCtx,
         return writeConflictRetry(opCtx, "syncApply_CRUD", nss.ns(), [&] {
             // Need to throw instead of returning a status for it to be properly ignored.
             try {
-                AutoGetCollection autoColl(opCtx, getNsOrUUID(nss, op), MODE_IX);
+                AutoGetCollection autoColl(
+                    opCtx, entry ? getNsOrUUID(*entry) : getNsOrUUID(nss, op), MODE_IX);
                 auto db = autoColl.getDb();
                 uassert(ErrorCodes::NamespaceNotFound,
                         str::stream() << "missing database (" << nss.db() << ")",
@@ -306,16 +328,19 @@ Status SyncTail::syncApply(OperationContext* opCtx,
             // Transactions have to acquire the same locks on secondaries as on primary.
             boost::optional<Lock::GlobalWrite> globalWriteLock;
 
-            // TODO SERVER-37180 Remove this double-parsing.
-            // The command entry has been parsed before, so it must be valid.
-            auto entry = uassertStatusOK(OplogEntry::parse(op));
-            const StringData commandName(op["o"].embeddedObject().firstElementFieldName());
+            // Callers applying raw BSON have not parsed the command entry yet.
+            boost::optional<OplogEntry> parsedEntry;
+            if (!entry) {
+                parsedEntry.emplace(uassertStatusOK(OplogEntry::parse(op)));
+            }
+            const OplogEntry& commandEntry = entry ? *entry : *parsedEntry;
+            const StringData commandName(commandEntry.getObject().firstElementFieldName());
             if (!op.getBoolField("prepare") && commandName != "abortTransaction") {
                 globalWriteLock.emplace(opCtx);
             }
 
             // special case apply for commands to avoid implicit database creation
-            Status status = applyCommand_inlock(opCtx, op, entry, oplogApplicationMode);
+            Status status = applyCommand_inlock(opCtx, op, commandEntry, oplogApplicationMode);
             incrementOpsAppliedStats();
             return status;
         });
@@ -324,6 +349,25 @@ Status SyncTail::syncApply(OperationContext* opCtx,
     MONGO_UNREACHABLE;
 }
 
+}  // namespace
+
+// static
+Status SyncTail::syncApply(OperationContext* opCtx,
+                           const BSONObj& op,
+                           OplogApplication::Mode oplogApplicationMode) {
+    const NamespaceString nss(op.getStringField("ns"));
+    auto opType = OpType_parse(IDLParserErrorContext("syncApply"), op["op"].valuestrsafe());
+    return syncApplyOperation(opCtx, op, nss, opType, nullptr, oplogApplicationMode);
+}
+
+// static
+Status SyncTail::syncApply(OperationContext* opCtx,
+                           const OplogEntry& entry,
+                           OplogApplication::Mode oplogApplicationMode) {
+    return syncApplyOperation(
+        opCtx, entry.raw, entry.getNss(), entry.getOpType(), &entry, oplogApplicationMode);
+}
+
 SyncTail::SyncTail(OplogApplier::Observer* observer,
                    ReplicationConsistencyMarkers* consistencyMarkers,
                    StorageInterface* storageInterface,
@@ -483,24 +527,74 @@ private:
     StringMap<CollectionProperties> _cache;
 };
 
+/**
+ * Groups the ops of a batch into chains which must be applied in order by a single writer, as
+ * their hashes say they may depend on one another, and spreads the chains over the writers.
+ */
+class DependencyChains {
+public:
+    void add(uint32_t hash, OplogEntry* op) {
+        auto insertResult = _chainIndexes.emplace(hash, _chains.size());
+        if (insertResult.second) {
+            _chains.emplace_back();
+        }
+        _chains[insertResult.first->second].push_back(op);
+    }
+
+    /**
+     * Assigns the chains, longest first, each to the writer with the fewest ops so far, so that a
+     * few long chains don't leave the other writers idle as assigning them by hash would.
+     */
+    void assignToWriters(std::vector<MultiApplier::OperationPtrs>* writerVectors) {
+        std::vector<size_t> chainOrder(_chains.size());
+        std::iota(chainOrder.begin(), chainOrder.end(), 0);
+        std::stable_sort(chainOrder.begin(), chainOrder.end(), [this](size_t lhs, size_t rhs) {
+            return _chains[lhs].size() > _chains[rhs].size();
+        });
+
+        size_t numOps = 0;
+        for (auto chainIndex : chainOrder) {
+            auto& chain = _chains[chainIndex];
+            auto& writer = *std::min_element(
+                writerVectors->begin(),
+                writerVectors->end(),
+                [](const MultiApplier::OperationPtrs& lhs,
+                   const MultiApplier::OperationPtrs& rhs) { return lhs.size() < rhs.size(); });
+            writer.insert(writer.end(), chain.begin(), chain.end());
+            numOps += chain.size();
+        }
+
+        size_t busiestWriterOps = 0;
+        for (auto&& writer : *writerVectors) {
+            busiestWriterOps = std::max(busiestWriterOps, writer.size());
+        }
+        writerOpsAssignedStats.increment(numOps);
+        busiestWriterOpsStats.increment(busiestWriterOps);
+    }
+
+private:
+    stdx::unordered_map<uint32_t, size_t> _chainIndexes;
+    std::vector<MultiApplier::OperationPtrs> _chains;
+};
+
 /**
  * ops - This only modifies the isForCappedCollection field on each op. It does not alter the ops
  *      vector in any other way.
- * writerVectors - Set of operations for each worker thread to apply.
+ * chains - The chains of operations to add each op to, keyed on its namespace and, where ops on
+ *      different documents of the collection may be applied in parallel, its document _id.
  * derivedOps - If provided, this function inserts a decomposition of applyOps operations
  *      and instructions for updating the transactions table.
  * sessionUpdateTracker - if provided, keeps track of session info from ops.
  */
-void fillWriterVectors(OperationContext* opCtx,
-                       MultiApplier::Operations* ops,
-                       std::vector<MultiApplier::OperationPtrs>* writerVectors,
-                       std::vector<MultiApplier::Operations>* derivedOps,
-                       SessionUpdateTracker* sessionUpdateTracker) {
+void fillDependencyChains(OperationContext* opCtx,
+                          MultiApplier::Operations* ops,
+                          DependencyChains* chains,
+                          std::vector<MultiApplier::Operations>* derivedOps,
+                          SessionUpdateTracker* sessionUpdateTracker) {
     const auto serviceContext = opCtx->getServiceContext();
     const auto storageEngine = serviceContext->getStorageEngine();
 
     const bool supportsDocLocking = storageEngine->supportsDocLocking();
-    const uint32_t numWriters = writerVectors->size();
 
     CachedCollectionProperties collPropertiesCache;
 
@@ -513,7 +607,7 @@ void fillWriterVectors(OperationContext* opCtx,
         if (sessionUpdateTracker) {
             if (auto newOplogWrites = sessionUpdateTracker->updateOrFlush(op)) {
                 derivedOps->emplace_back(std::move(*newOplogWrites));
-                fillWriterVectors(opCtx, &derivedOps->back(), writerVectors, derivedOps, nullptr);
+                fillDependencyChains(opCtx, &derivedOps->back(), chains, derivedOps, nullptr);
             }
         }
 
@@ -547,7 +641,7 @@ void fillWriterVectors(OperationContext* opCtx,
                 derivedOps->emplace_back(ApplyOps::extractOperations(op));
 
                 // Nested entries cannot have different session updates.
-                fillWriterVectors(opCtx, &derivedOps->back(), writerVectors, derivedOps, nullptr);
+                fillDependencyChains(opCtx, &derivedOps->back(), chains, derivedOps, nullptr);
             } catch (...) {
                 fassertFailedWithStatusNoTrace(
                     50711,
@@ -558,26 +652,28 @@ void fillWriterVectors(OperationContext* opCtx,
             continue;
         }
 
-        auto& writer = (*writerVectors)[hash % numWriters];
-        if (writer.empty()) {
-            writer.reserve(8);  // Skip a few growth rounds
-        }
-        writer.push_back(&op);
+        chains->add(hash, &op);
     }
 }
 
+/**
+ * writerVectors - Set of operations for each worker thread to apply.
+ */
 void fillWriterVectors(OperationContext* opCtx,
                        MultiApplier::Operations* ops,
                        std::vector<MultiApplier::OperationPtrs>* writerVectors,
                        std::vector<MultiApplier::Operations>* derivedOps) {
+    DependencyChains chains;
     SessionUpdateTracker sessionUpdateTracker;
-    fillWriterVectors(opCtx, ops, writerVectors, derivedOps, &sessionUpdateTracker);
+    fillDependencyChains(opCtx, ops, &chains, derivedOps, &sessionUpdateTracker);
 
     auto newOplogWrites = sessionUpdateTracker.flushAll();
     if (!newOplogWrites.empty()) {
         derivedOps->emplace_back(std::move(newOplogWrites));
-        fillWriterVectors(opCtx, &derivedOps->back(), writerVectors, derivedOps, nullptr);
+        fillDependencyChains(opCtx, &derivedOps->back(), &chains, derivedOps, nullptr);
     }
+
+    chains.assignToWriters(writerVectors);
 }
 
 }  // namespace
@@ -640,6 +736,7 @@ public:
           _storageInterface(storageInterface),
           _oplogBuffer(oplogBuffer),
           _ops(0),
+          _prefetcher(OplogPrefetcher::makeIfEnabled()),
           _thread([this] { run(); }) {}
     ~OpQueueBatcher() {
         invariant(_isDead);
@@ -703,6 +800,12 @@ private:
                 continue;  // Don't emit empty batches.
             }
 
+            if (_prefetcher && !ops.mustShutdown()) {
+                // Warm the cache for this batch while the previous one is still being applied.
+                auto replCoord = ReplicationCoordinator::get(cc().getServiceContext());
+                _prefetcher->prefetch(ops.getBatch(), replCoord->getIndexPrefetchConfig());
+            }
+
             stdx::unique_lock<stdx::mutex> lk(_mutex);
             // Block until the previous batch has been taken.
             _cv.wait(lk, [&] { return _ops.empty(); });
@@ -723,6 +826,9 @@ private:
     stdx::condition_variable _cv;
     OpQueue _ops;
 
+    // Null unless prefetching is enabled.
+    std::unique_ptr<OplogPrefetcher> _prefetcher;
+
     // This only exists so the destructor invariants rather than deadlocking.
     // TODO remove once we trust noexcept enough to mark oplogApplication() as noexcept.
     bool _isDead = false;
@@ -1140,6 +1246,8 @@ Status multiSyncApply(OperationContext* opCtx,
     // ShouldNotConflictWithSecondaryBatchApplicationBlock will touch the locker that has been
     // destroyed by unstash in its destructor. Thus we set the flag explicitly.
     opCtx->lockState()->setShouldConflictWithSecondaryBatchApplication(false);
+    // Applying the batch must not queue for tickets behind other operations on this node.
+    opCtx->lockState()->setPriorityTicketAdmission(true);
 
     // Explicitly start future read transactions without a timestamp.
     opCtx->recoveryUnit()->setTimestampReadSource(RecoveryUnit::ReadSource::kNoTimestamp);
@@ -1173,7 +1281,7 @@ Status multiSyncApply(OperationContext* opCtx,
 
             // If we didn't create a group, try to apply the op individually.
             try {
-                const Status status = SyncTail::syncApply(opCtx, entry.raw, oplogApplicationMode);
+                const Status status = SyncTail::syncApply(opCtx, entry, oplogApplicationMode);
 
                 if (!status.isOK()) {
                     // In initial sync, update operations can cause documents to be missed during
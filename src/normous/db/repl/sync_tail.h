@@ -79,6 +79,14 @@ public:
                             const BSONObj& o,
                             OplogApplication::Mode oplogApplicationMode);
 
+    /**
+     * Same as above, but reuses the fields already parsed into 'entry' instead of looking them up
+     * in its raw BSON again.
+     */
+    static Status syncApply(OperationContext* opCtx,
+                            const OplogEntry& entry,
+                            OplogApplication::Mode oplogApplicationMode);
+
     /**
      *
      * Constructs a SyncTail.
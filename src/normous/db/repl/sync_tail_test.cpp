@@ -55,6 +55,7 @@
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/oplog_buffer_blocking_queue.h"
 #include "mongo/db/repl/oplog_interface_local.h"
+#include "mongo/db/repl/oplog_prefetcher.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/replication_coordinator_mock.h"
 #include "mongo/db/repl/replication_process.h"
@@ -276,6 +277,15 @@ TEST_F(SyncTailTest, SyncApplyInsertDocumentCollectionLookupByUUIDFails) {
         ExceptionFor<ErrorCodes::NamespaceNotFound>);
 }
 
+TEST_F(SyncTailTest, SyncApplyParsedInsertDocumentCollectionLookupByUUIDFails) {
+    const NamespaceString nss("test.t");
+    createDatabase(_opCtx.get(), nss.db());
+    NamespaceString otherNss(nss.getSisterNS("othername"));
+    auto op = makeOplogEntry(OpTypeEnum::kInsert, otherNss, kUuid);
+    ASSERT_THROWS(SyncTail::syncApply(_opCtx.get(), op, OplogApplication::Mode::kSecondary),
+                  ExceptionFor<ErrorCodes::NamespaceNotFound>);
+}
+
 TEST_F(SyncTailTest, SyncApplyDeleteDocumentCollectionLookupByUUIDFails) {
     const NamespaceString nss("test.t");
     createDatabase(_opCtx.get(), nss.db());
@@ -453,11 +463,7 @@ TEST_F(SyncTailTest,
                                                      createOplogCollectionOptions()));
 }
 
-TEST_F(SyncTailTest, MultiApplyAssignsOperationsToWriterThreadsBasedOnNamespaceHash) {
-    // This test relies on implementation details of how multiApply uses hashing to distribute ops
-    // to threads. It is possible for this test to fail, even if the implementation of multiApply is
-    // correct. If it fails, consider adjusting the namespace names (to adjust the hash values) or
-    // the number of threads in the pool.
+TEST_F(SyncTailTest, MultiApplyAssignsIndependentOperationsToDifferentWriterThreads) {
     NamespaceString nss1("test.t0");
     NamespaceString nss2("test.t1");
     auto writerPool = OplogApplier::makeWriterPool(2);
@@ -523,6 +529,61 @@ TEST_F(SyncTailTest, MultiApplyAssignsOperationsToWriterThreadsBasedOnNamespaceH
     ASSERT_EQUALS(op2, lastEntry);
 }
 
+TEST_F(SyncTailTest, MultiApplyBalancesDependencyChainsAcrossWriterThreads) {
+    NamespaceString hotNss("test.hot");
+    auto writerPool = OplogApplier::makeWriterPool(2);
+
+    stdx::mutex mutex;
+    std::vector<MultiApplier::Operations> operationsApplied;
+    auto applyOperationFn =
+        [&mutex, &operationsApplied](OperationContext* opCtx,
+                                     MultiApplier::OperationPtrs* operationsForWriterThreadToApply,
+                                     SyncTail* st,
+                                     WorkerMultikeyPathInfo*) -> Status {
+        stdx::lock_guard<stdx::mutex> lock(mutex);
+        operationsApplied.emplace_back();
+        for (auto&& opPtr : *operationsForWriterThreadToApply) {
+            operationsApplied.back().push_back(*opPtr);
+        }
+        return Status::OK();
+    };
+
+    // Three ops on one document, which have to be applied in order by one writer, and three ops
+    // on other collections, which the other writer should be given instead of none or some of
+    // them.
+    MultiApplier::Operations ops;
+    for (int i = 0; i < 3; ++i) {
+        ops.push_back(makeInsertDocumentOplogEntry(
+            {Timestamp(Seconds(1), i), 1LL}, hotNss, BSON("_id" << 0 << "x" << i)));
+    }
+    for (int i = 0; i < 3; ++i) {
+        NamespaceString nss("test.cold" + std::to_string(i));
+        ops.push_back(makeInsertDocumentOplogEntry(
+            {Timestamp(Seconds(2), i), 1LL}, nss, BSON("_id" << 0 << "x" << i)));
+    }
+
+    SyncTail syncTail(nullptr,
+                      getConsistencyMarkers(),
+                      getStorageInterface(),
+                      applyOperationFn,
+                      writerPool.get());
+    auto lastOpTime = unittest::assertGet(syncTail.multiApply(_opCtx.get(), ops));
+    ASSERT_EQUALS(ops.back().getOpTime(), lastOpTime);
+
+    stdx::lock_guard<stdx::mutex> lock(mutex);
+    ASSERT_EQUALS(2U, operationsApplied.size());
+    auto hotWriterOps = std::find_if(
+        operationsApplied.begin(), operationsApplied.end(), [&](const MultiApplier::Operations& w) {
+            return w.front().getNss() == hotNss;
+        });
+    ASSERT(hotWriterOps != operationsApplied.end());
+    ASSERT_EQUALS(3U, hotWriterOps->size());
+    for (size_t i = 0; i < hotWriterOps->size(); ++i) {
+        ASSERT_EQUALS(ops[i], (*hotWriterOps)[i]);
+    }
+    ASSERT_EQUALS(3U, operationsApplied[hotWriterOps == operationsApplied.begin() ? 1 : 0].size());
+}
+
 TEST_F(SyncTailTest, MultiSyncApplyUsesSyncApplyToApplyOperation) {
     NamespaceString nss("local." + _agent.getSuiteName() + "_" + _agent.getTestName());
     auto op = makeCreateCollectionOplogEntry({Timestamp(Seconds(1), 0), 1LL}, nss);
@@ -1884,6 +1945,68 @@ TEST_F(IdempotencyTest, ConvertToCappedNamespaceNotFound) {
     ASSERT_FALSE(autoColl.getDb());
 }
 
+TEST_F(SyncTailTest, OplogPrefetcherCollectsTargetsForCrudOps) {
+    NamespaceString nss1("test.t1");
+    NamespaceString nss2("test.t2");
+    std::vector<OplogEntry> ops = {
+        makeInsertDocumentOplogEntry(nextOpTime(), nss2, BSON("_id" << 1 << "a" << 1)),
+        makeUpdateDocumentOplogEntry(
+            nextOpTime(), nss1, BSON("_id" << 2), BSON("$set" << BSON("a" << 2))),
+        makeDeleteDocumentOplogEntry(nextOpTime(), nss1, BSON("_id" << 3)),
+        makeCommandOplogEntry(nextOpTime(), nss1, BSON("create" << nss1.coll())),
+    };
+
+    // Targets are grouped by collection, keeping the batch order within each collection.
+    auto targets =
+        OplogPrefetcher::collectTargets(ops, ReplSettings::IndexPrefetchConfig::PREFETCH_ALL);
+    ASSERT_EQ(targets.size(), 3U);
+    ASSERT_EQ(targets[0].nss, nss1);
+    ASSERT_BSONOBJ_EQ(targets[0].idQuery, BSON("_id" << 2));
+    ASSERT_TRUE(targets[0].insertedDoc.isEmpty());
+    ASSERT_EQ(targets[1].nss, nss1);
+    ASSERT_BSONOBJ_EQ(targets[1].idQuery, BSON("_id" << 3));
+    ASSERT_EQ(targets[2].nss, nss2);
+    ASSERT_TRUE(targets[2].idQuery.isEmpty());
+    ASSERT_BSONOBJ_EQ(targets[2].insertedDoc, BSON("_id" << 1 << "a" << 1));
+
+    // Inserts only warm the _id index in "_id_only" mode.
+    targets =
+        OplogPrefetcher::collectTargets(ops, ReplSettings::IndexPrefetchConfig::PREFETCH_ID_ONLY);
+    ASSERT_EQ(targets.size(), 3U);
+    ASSERT_BSONOBJ_EQ(targets[2].idQuery, BSON("_id" << 1));
+    ASSERT_TRUE(targets[2].insertedDoc.isEmpty());
+
+    ASSERT_TRUE(
+        OplogPrefetcher::collectTargets(ops, ReplSettings::IndexPrefetchConfig::PREFETCH_NONE)
+            .empty());
+}
+
+TEST_F(SyncTailTest, OplogPrefetcherReadsAheadWithoutFailing) {
+    NamespaceString nss("test.t");
+    createCollection(_opCtx.get(), nss, {});
+    ASSERT_OK(_storageInterface->insertDocument(_opCtx.get(),
+                                                nss,
+                                                {BSON("_id" << 1 << "a" << 1), Timestamp()},
+                                                OpTime::kUninitializedTerm));
+
+    // Targets for missing documents and collections are ignored.
+    std::vector<OplogEntry> ops = {
+        makeUpdateDocumentOplogEntry(
+            nextOpTime(), nss, BSON("_id" << 1), BSON("$set" << BSON("a" << 2))),
+        makeDeleteDocumentOplogEntry(nextOpTime(), nss, BSON("_id" << 2)),
+        makeInsertDocumentOplogEntry(nextOpTime(), nss, BSON("_id" << 3 << "a" << 3)),
+        makeInsertDocumentOplogEntry(
+            nextOpTime(), NamespaceString("test.missing"), BSON("_id" << 1)),
+    };
+
+    OplogPrefetcher prefetcher(2);
+    ASSERT_FALSE(prefetcher.prefetch(ops, ReplSettings::IndexPrefetchConfig::PREFETCH_NONE));
+    ASSERT_TRUE(prefetcher.prefetch(ops, ReplSettings::IndexPrefetchConfig::PREFETCH_ALL));
+    prefetcher.waitForIdle();
+    ASSERT_TRUE(prefetcher.prefetch(ops, ReplSettings::IndexPrefetchConfig::PREFETCH_ID_ONLY));
+    prefetcher.waitForIdle();
+}
+
 }  // namespace
 }  // namespace repl
 }  // namespace mongo
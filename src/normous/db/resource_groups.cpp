@@ -0,0 +1,387 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/resource_groups.h"
+
+#include <algorithm>
+#include <climits>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/bson/json.h"
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/client.h"
+#include "mongo/db/commands/server_status.h"
+#include "mongo/db/curop.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/db/service_context.h"
+#include "mongo/rpc/metadata/client_metadata_ismaster.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+
+namespace {
+
+const auto getResourceGroups = ServiceContext::declareDecoration<ResourceGroups>();
+
+/**
+ * The last accepted 'resourceGroups' document. Kept outside of the ServiceContext since the
+ * parameter may be set from the command line before the ServiceContext exists.
+ */
+stdx::mutex resourceGroupsParameterMutex;
+BSONObj resourceGroupsParameterValue;
+
+Status parseStringArray(const BSONElement& elem, std::vector<std::string>* out) {
+    if (elem.type() != Array) {
+        return {ErrorCodes::TypeMismatch,
+                str::stream() << "'" << elem.fieldNameStringData() << "' must be an array"};
+    }
+    for (auto&& entry : elem.Obj()) {
+        if (entry.type() != String) {
+            return {ErrorCodes::TypeMismatch,
+                    str::stream() << "'" << elem.fieldNameStringData()
+                                  << "' must only contain strings"};
+        }
+        out->push_back(entry.str());
+    }
+    return Status::OK();
+}
+
+bool matchesAny(const std::vector<std::string>& criteria, StringData value) {
+    return criteria.empty() ||
+        std::find(criteria.begin(), criteria.end(), value) != criteria.end();
+}
+
+void appendStringArray(BSONObjBuilder* builder,
+                       StringData fieldName,
+                       const std::vector<std::string>& values) {
+    if (!values.empty())
+        builder->append(fieldName, values);
+}
+
+}  // namespace
+
+ResourceGroups::Group::Group(std::string name,
+                             std::vector<std::string> appNames,
+                             std::vector<std::string> users,
+                             std::vector<std::string> dbs,
+                             int maxConcurrency,
+                             Milliseconds maxQueueTime)
+    : _name(std::move(name)),
+      _appNames(std::move(appNames)),
+      _users(std::move(users)),
+      _dbs(std::move(dbs)),
+      _maxConcurrency(maxConcurrency),
+      _maxQueueTime(maxQueueTime),
+      _slots(maxConcurrency) {}
+
+bool ResourceGroups::Group::matches(StringData appName,
+                                    const std::vector<std::string>& users,
+                                    StringData dbName) const {
+    if (!matchesAny(_appNames, appName) || !matchesAny(_dbs, dbName))
+        return false;
+    if (_users.empty())
+        return true;
+    return std::any_of(users.begin(), users.end(), [&](const std::string& user) {
+        return std::find(_users.begin(), _users.end(), user) != _users.end();
+    });
+}
+
+bool ResourceGroups::Group::acquire(OperationContext* opCtx, Date_t until) {
+    if (_slots.tryAcquire()) {
+        _admitted.fetchAndAdd(1);
+        return true;
+    }
+
+    _queued.fetchAndAdd(1);
+    if (_maxQueueTime > Milliseconds(0))
+        until = std::min(until, Date_t::now() + _maxQueueTime);
+
+    if (!_slots.waitForTicketUntil(opCtx, until)) {
+        _timedOut.fetchAndAdd(1);
+        return false;
+    }
+    _admitted.fetchAndAdd(1);
+    return true;
+}
+
+void ResourceGroups::Group::release() {
+    _slots.release();
+}
+
+void ResourceGroups::Group::appendConfig(BSONObjBuilder* builder) const {
+    BSONObjBuilder groupBuilder(builder->subobjStart(_name));
+    appendStringArray(&groupBuilder, "appNames", _appNames);
+    appendStringArray(&groupBuilder, "users", _users);
+    appendStringArray(&groupBuilder, "dbs", _dbs);
+    groupBuilder.append("maxConcurrency", _maxConcurrency);
+    if (_maxQueueTime > Milliseconds(0))
+        groupBuilder.append("maxQueueTimeMS", durationCount<Milliseconds>(_maxQueueTime));
+}
+
+void ResourceGroups::Group::appendStats(BSONObjBuilder* builder) const {
+    BSONObjBuilder groupBuilder(builder->subobjStart(_name));
+    groupBuilder.append("maxConcurrency", _maxConcurrency);
+    groupBuilder.append("active", _slots.used());
+    groupBuilder.append("available", _slots.available());
+    groupBuilder.append("admitted", _admitted.load());
+    groupBuilder.append("queued", _queued.load());
+    groupBuilder.append("timedOut", _timedOut.load());
+}
+
+ResourceGroups::Admission& ResourceGroups::Admission::operator=(Admission&& other) {
+    if (_group)
+        _group->release();
+    _group = std::move(other._group);
+    return *this;
+}
+
+ResourceGroups::Admission::~Admission() {
+    if (_group)
+        _group->release();
+}
+
+ResourceGroups& ResourceGroups::get(ServiceContext* service) {
+    return getResourceGroups(service);
+}
+
+StatusWith<std::vector<std::shared_ptr<ResourceGroups::Group>>> ResourceGroups::parse(
+    const BSONObj& config) {
+    std::vector<std::shared_ptr<Group>> groups;
+
+    for (auto&& groupElem : config) {
+        const auto groupName = groupElem.fieldNameStringData();
+        if (groupElem.type() != Object) {
+            return {ErrorCodes::TypeMismatch,
+                    str::stream() << "resource group '" << groupName << "' must be an object"};
+        }
+
+        std::vector<std::string> appNames, users, dbs;
+        int maxConcurrency = 0;
+        Milliseconds maxQueueTime(0);
+
+        for (auto&& elem : groupElem.Obj()) {
+            const auto fieldName = elem.fieldNameStringData();
+            Status status = Status::OK();
+            if (fieldName == "appNames") {
+                status = parseStringArray(elem, &appNames);
+            } else if (fieldName == "users") {
+                status = parseStringArray(elem, &users);
+            } else if (fieldName == "dbs") {
+                status = parseStringArray(elem, &dbs);
+            } else if (fieldName == "maxConcurrency" || fieldName == "maxQueueTimeMS") {
+                if (!elem.isNumber()) {
+                    status = {ErrorCodes::TypeMismatch,
+                              str::stream() << "'" << fieldName << "' must be a number"};
+                } else if (elem.numberLong() < 0 || elem.numberLong() > INT_MAX) {
+                    status = {ErrorCodes::BadValue,
+                              str::stream() << "'" << fieldName << "' is out of range"};
+                } else if (fieldName == "maxConcurrency") {
+                    maxConcurrency = elem.numberInt();
+                } else {
+                    maxQueueTime = Milliseconds(elem.numberInt());
+                }
+            } else {
+                status = {ErrorCodes::BadValue,
+                          str::stream() << "unrecognized field '" << fieldName
+                                        << "' in resource group '"
+                                        << groupName
+                                        << "'"};
+            }
+            if (!status.isOK())
+                return status.withContext(str::stream() << "resource group '" << groupName << "'");
+        }
+
+        if (maxConcurrency <= 0) {
+            return {ErrorCodes::BadValue,
+                    str::stream() << "resource group '" << groupName
+                                  << "' requires a positive maxConcurrency"};
+        }
+
+        groups.push_back(std::make_shared<Group>(groupName.toString(),
+                                                 std::move(appNames),
+                                                 std::move(users),
+                                                 std::move(dbs),
+                                                 maxConcurrency,
+                                                 maxQueueTime));
+    }
+
+    return {std::move(groups)};
+}
+
+Status ResourceGroups::configure(const BSONObj& config) {
+    auto swGroups = parse(config);
+    if (!swGroups.isOK())
+        return swGroups.getStatus();
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _groups = std::move(swGroups.getValue());
+    _enabled.store(!_groups.empty());
+    return Status::OK();
+}
+
+BSONObj ResourceGroups::getConfig() const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    BSONObjBuilder builder;
+    for (auto&& group : _groups) {
+        group->appendConfig(&builder);
+    }
+    return builder.obj();
+}
+
+std::shared_ptr<ResourceGroups::Group> ResourceGroups::match(
+    StringData appName, const std::vector<std::string>& users, StringData dbName) const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    for (auto&& group : _groups) {
+        if (group->matches(appName, users, dbName))
+            return group;
+    }
+    return nullptr;
+}
+
+ResourceGroups::Admission ResourceGroups::admit(OperationContext* opCtx, StringData dbName) {
+    if (!_enabled.load())
+        return {};
+
+    auto client = opCtx->getClient();
+    if (client->isInDirectClient() || !client->session())
+        return {};
+
+    auto authSession = AuthorizationSession::get(client);
+    if (authSession->isAuthorizedForActionsOnResource(ResourcePattern::forClusterResource(),
+                                                      ActionType::internal)) {
+        // Never queue intra-cluster traffic, such as replication and migrations, behind a
+        // tenant's limit.
+        return {};
+    }
+
+    StringData appName;
+    const auto& clientMetadata = ClientMetadataIsMasterState::get(client).getClientMetadata();
+    if (clientMetadata) {
+        appName = clientMetadata.get().getApplicationName();
+    }
+
+    std::vector<std::string> users;
+    for (auto names = authSession->getAuthenticatedUserNames(); names.more(); names.next()) {
+        users.push_back(names->getFullName());
+    }
+
+    auto group = match(appName, users, dbName);
+    if (!group)
+        return {};
+
+    {
+        CurOp::PhaseTimer admissionTimer(opCtx, CurOp::Phase::kAdmissionWait);
+        uassert(ErrorCodes::ExceededTimeLimit,
+                str::stream() << "timed out waiting for admission to resource group '"
+                              << group->getName()
+                              << "'",
+                group->acquire(opCtx, opCtx->getDeadline()));
+    }
+    return Admission(std::move(group));
+}
+
+void ResourceGroups::appendStats(BSONObjBuilder* builder) const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    for (auto&& group : _groups) {
+        group->appendStats(builder);
+    }
+}
+
+namespace {
+
+ServiceContext::ConstructorActionRegisterer resourceGroupsRegisterer{
+    "ResourceGroups", [](ServiceContext* service) {
+        stdx::lock_guard<stdx::mutex> lk(resourceGroupsParameterMutex);
+        uassertStatusOK(ResourceGroups::get(service).configure(resourceGroupsParameterValue));
+    }};
+
+/**
+ * The 'resourceGroups' server parameter. See ResourceGroups for the document format.
+ */
+class ResourceGroupsParameter final : public ServerParameter {
+    MONGO_DISALLOW_COPYING(ResourceGroupsParameter);
+
+public:
+    ResourceGroupsParameter()
+        : ServerParameter(ServerParameterSet::getGlobal(), "resourceGroups", true, true) {}
+
+    void append(OperationContext* opCtx, BSONObjBuilder& b, const std::string& name) override {
+        b.append(name, ResourceGroups::get(opCtx->getServiceContext()).getConfig());
+    }
+
+    Status set(const BSONElement& newValueElement) override {
+        if (!newValueElement.isABSONObj()) {
+            return {ErrorCodes::TypeMismatch,
+                    str::stream() << name() << " must be an object: " << newValueElement};
+        }
+        return _set(newValueElement.Obj());
+    }
+
+    Status setFromString(const std::string& str) override {
+        try {
+            return _set(fromjson(str));
+        } catch (const DBException& ex) {
+            return ex.toStatus();
+        }
+    }
+
+private:
+    Status _set(const BSONObj& config) {
+        auto swGroups = ResourceGroups::parse(config);
+        if (!swGroups.isOK())
+            return swGroups.getStatus();
+
+        stdx::lock_guard<stdx::mutex> lk(resourceGroupsParameterMutex);
+        resourceGroupsParameterValue = config.getOwned();
+        if (hasGlobalServiceContext())
+            return ResourceGroups::get(getGlobalServiceContext()).configure(config);
+        return Status::OK();
+    }
+} resourceGroupsParameter;
+
+class ResourceGroupsServerStatusSection final : public ServerStatusSection {
+public:
+    ResourceGroupsServerStatusSection() : ServerStatusSection("resourceGroups") {}
+
+    bool includeByDefault() const override {
+        return true;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        BSONObjBuilder builder;
+        ResourceGroups::get(opCtx->getServiceContext()).appendStats(&builder);
+        return builder.obj();
+    }
+} resourceGroupsServerStatusSection;
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,193 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/base/status_with.h"
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/concurrency/ticketholder.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Admission control for commands by resource group. A resource group names a set of operations,
+ * selected by the client's application name, the authenticated user and the target database, and
+ * caps how many of them may run at once. Operations beyond the cap queue until a running one
+ * finishes, so one tenant's heavy workload queues behind its own limit instead of taking every
+ * storage engine ticket.
+ *
+ * Groups are configured through the 'resourceGroups' server parameter:
+ *
+ * {
+ *     reporting: {
+ *         appNames: ["reportingApp"],  <-- optional, any of these application names
+ *         users: ["report@admin"],     <-- optional, any of these authenticated users
+ *         dbs: ["sales"],              <-- optional, any of these databases
+ *         maxConcurrency: 4,           <-- required, operations admitted at once
+ *         maxQueueTimeMS: 1000         <-- optional, fail after queueing this long
+ *     }
+ * }
+ *
+ * An operation belongs to the first group, in configuration order, all of whose non-empty
+ * criteria it matches. Operations matching no group are not limited.
+ */
+class ResourceGroups {
+    MONGO_DISALLOW_COPYING(ResourceGroups);
+
+public:
+    class Group {
+        MONGO_DISALLOW_COPYING(Group);
+
+    public:
+        Group(std::string name,
+              std::vector<std::string> appNames,
+              std::vector<std::string> users,
+              std::vector<std::string> dbs,
+              int maxConcurrency,
+              Milliseconds maxQueueTime);
+
+        const std::string& getName() const {
+            return _name;
+        }
+
+        int getMaxConcurrency() const {
+            return _maxConcurrency;
+        }
+
+        /**
+         * Returns true if an operation with the given application name, authenticated users
+         * ("user@db") and target database belongs to this group.
+         */
+        bool matches(StringData appName,
+                     const std::vector<std::string>& users,
+                     StringData dbName) const;
+
+        /**
+         * Waits for one of the group's slots, up to 'until' or the group's maxQueueTimeMS,
+         * whichever is sooner. Returns false on timeout; throws if 'opCtx' is interrupted.
+         */
+        bool acquire(OperationContext* opCtx, Date_t until);
+
+        void release();
+
+        void appendConfig(BSONObjBuilder* builder) const;
+        void appendStats(BSONObjBuilder* builder) const;
+
+    private:
+        const std::string _name;
+        const std::vector<std::string> _appNames;
+        const std::vector<std::string> _users;
+        const std::vector<std::string> _dbs;
+        const int _maxConcurrency;
+        const Milliseconds _maxQueueTime;
+
+        TicketHolder _slots;
+
+        AtomicInt64 _admitted;
+        AtomicInt64 _queued;
+        AtomicInt64 _timedOut;
+    };
+
+    /**
+     * Holds a slot of a resource group for the scope of an operation. An Admission of an operation
+     * that matched no group holds nothing.
+     */
+    class Admission {
+        MONGO_DISALLOW_COPYING(Admission);
+
+    public:
+        Admission() = default;
+        explicit Admission(std::shared_ptr<Group> group) : _group(std::move(group)) {}
+        Admission(Admission&& other) = default;
+        Admission& operator=(Admission&& other);
+        ~Admission();
+
+        const Group* getGroup() const {
+            return _group.get();
+        }
+
+    private:
+        std::shared_ptr<Group> _group;
+    };
+
+    ResourceGroups() = default;
+
+    static ResourceGroups& get(ServiceContext* service);
+
+    /**
+     * Parses a 'resourceGroups' document into its groups, in configuration order.
+     */
+    static StatusWith<std::vector<std::shared_ptr<Group>>> parse(const BSONObj& config);
+
+    /**
+     * Replaces the configured groups. Operations already admitted keep, and on completion
+     * release, a slot of the group they were admitted to, so lowering a limit takes effect as the
+     * running operations drain.
+     */
+    Status configure(const BSONObj& config);
+
+    BSONObj getConfig() const;
+
+    /**
+     * Returns the group for an operation with the given attributes, or nullptr if it matches none.
+     */
+    std::shared_ptr<Group> match(StringData appName,
+                                 const std::vector<std::string>& users,
+                                 StringData dbName) const;
+
+    /**
+     * Admits the operation running on 'opCtx' against 'dbName' to its resource group, queueing
+     * until a slot frees up. Throws ExceededTimeLimit if the group's maxQueueTimeMS elapses, or
+     * the operation's own error if it is interrupted or exceeds its deadline while queued.
+     */
+    Admission admit(OperationContext* opCtx, StringData dbName);
+
+    void appendStats(BSONObjBuilder* builder) const;
+
+private:
+    // Lets operations skip classifying themselves when no groups are configured.
+    AtomicBool _enabled{false};
+
+    mutable stdx::mutex _mutex;
+    std::vector<std::shared_ptr<Group>> _groups;
+};
+
+}  // namespace mongo
@@ -0,0 +1,135 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/resource_groups.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(ResourceGroupsTest, ParseRejectsInvalidConfigs) {
+    ASSERT_EQ(ErrorCodes::TypeMismatch, ResourceGroups::parse(fromjson("{a: 1}")).getStatus());
+    ASSERT_EQ(ErrorCodes::BadValue, ResourceGroups::parse(fromjson("{a: {}}")).getStatus());
+    ASSERT_EQ(ErrorCodes::BadValue,
+              ResourceGroups::parse(fromjson("{a: {maxConcurrency: 0}}")).getStatus());
+    ASSERT_EQ(ErrorCodes::BadValue,
+              ResourceGroups::parse(fromjson("{a: {maxConcurrency: 1, cpuShares: 2}}"))
+                  .getStatus());
+    ASSERT_EQ(ErrorCodes::TypeMismatch,
+              ResourceGroups::parse(fromjson("{a: {maxConcurrency: 1, dbs: 'test'}}"))
+                  .getStatus());
+    ASSERT_EQ(ErrorCodes::TypeMismatch,
+              ResourceGroups::parse(fromjson("{a: {maxConcurrency: 1, users: [1]}}"))
+                  .getStatus());
+}
+
+TEST(ResourceGroupsTest, ConfigRoundTrips) {
+    ResourceGroups groups;
+    const auto config = fromjson(
+        "{reporting: {appNames: ['report'], dbs: ['sales'], maxConcurrency: 2, "
+        "maxQueueTimeMS: 100}, batch: {users: ['etl@admin'], maxConcurrency: 5}}");
+    ASSERT_OK(groups.configure(config));
+    ASSERT_BSONOBJ_EQ(config, groups.getConfig());
+
+    ASSERT_OK(groups.configure(BSONObj()));
+    ASSERT_BSONOBJ_EQ(BSONObj(), groups.getConfig());
+}
+
+TEST(ResourceGroupsTest, MatchRequiresEveryCriterion) {
+    ResourceGroups groups;
+    ASSERT_OK(groups.configure(
+        fromjson("{reporting: {appNames: ['report'], dbs: ['sales'], maxConcurrency: 2}}")));
+
+    ASSERT(groups.match("report", {}, "sales"));
+    ASSERT_FALSE(groups.match("report", {}, "inventory"));
+    ASSERT_FALSE(groups.match("shop", {}, "sales"));
+    ASSERT_FALSE(groups.match("", {}, "sales"));
+}
+
+TEST(ResourceGroupsTest, MatchUsesFirstMatchingGroup) {
+    ResourceGroups groups;
+    ASSERT_OK(groups.configure(
+        fromjson("{etl: {users: ['etl@admin'], maxConcurrency: 1}, "
+                 "sales: {dbs: ['sales'], maxConcurrency: 3}}")));
+
+    auto group = groups.match("", {"app@admin", "etl@admin"}, "sales");
+    ASSERT(group);
+    ASSERT_EQ("etl", group->getName());
+
+    group = groups.match("", {"app@admin"}, "sales");
+    ASSERT(group);
+    ASSERT_EQ("sales", group->getName());
+
+    ASSERT_FALSE(groups.match("", {"app@admin"}, "inventory"));
+}
+
+TEST(ResourceGroupsTest, AcquireTimesOutWhenGroupIsFull) {
+    ResourceGroups::Group group("reporting", {}, {}, {}, 2, Milliseconds(10));
+
+    ASSERT(group.acquire(nullptr, Date_t::max()));
+    ASSERT(group.acquire(nullptr, Date_t::max()));
+    ASSERT_FALSE(group.acquire(nullptr, Date_t::max()));
+
+    group.release();
+    ASSERT(group.acquire(nullptr, Date_t::max()));
+
+    BSONObjBuilder builder;
+    group.appendStats(&builder);
+    ASSERT_BSONOBJ_EQ(fromjson("{reporting: {maxConcurrency: 2, active: 2, available: 0, "
+                               "admitted: NumberLong(3), queued: NumberLong(1), "
+                               "timedOut: NumberLong(1)}}"),
+                      builder.obj());
+
+    group.release();
+    group.release();
+}
+
+TEST(ResourceGroupsTest, AdmissionReleasesItsSlot) {
+    auto group = std::make_shared<ResourceGroups::Group>("reporting",
+                                                         std::vector<std::string>{},
+                                                         std::vector<std::string>{},
+                                                         std::vector<std::string>{},
+                                                         1,
+                                                         Milliseconds(10));
+
+    {
+        ASSERT(group->acquire(nullptr, Date_t::max()));
+        ResourceGroups::Admission admission(group);
+        ASSERT_EQ(group.get(), admission.getGroup());
+        ASSERT_FALSE(group->acquire(nullptr, Date_t::max()));
+    }
+    ASSERT(group->acquire(nullptr, Date_t::max()));
+    group->release();
+}
+
+}  // namespace
+}  // namespace mongo
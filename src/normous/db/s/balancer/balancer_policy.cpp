@@ -242,6 +242,7 @@ ShardId BalancerPolicy::_getLeastLoadedReceiverShard(const ShardStatisticsVector
                                                      const set<ShardId>& excludedShards) {
     ShardId best;
     unsigned minChunks = numeric_limits<unsigned>::max();
+    double minOpLoad = 0;
 
     for (const auto& stat : shardStats) {
         if (excludedShards.count(stat.shardId))
@@ -252,13 +253,15 @@ ShardId BalancerPolicy::_getLeastLoadedReceiverShard(const ShardStatisticsVector
             continue;
         }
 
+        // Among the shards with the fewest chunks, prefer the one with the lowest operation load
         unsigned myChunks = distribution.numberOfChunksInShard(stat.shardId);
-        if (myChunks >= minChunks) {
+        if (myChunks > minChunks || (myChunks == minChunks && stat.opLoad >= minOpLoad)) {
             continue;
         }
 
         best = stat.shardId;
         minChunks = myChunks;
+        minOpLoad = stat.opLoad;
     }
 
     return best;
@@ -270,18 +273,22 @@ ShardId BalancerPolicy::_getMostOverloadedShard(const ShardStatisticsVector& sha
                                                 const set<ShardId>& excludedShards) {
     ShardId worst;
     unsigned maxChunks = 0;
+    double maxOpLoad = 0;
 
     for (const auto& stat : shardStats) {
         if (excludedShards.count(stat.shardId))
             continue;
 
+        // Among the shards with the most chunks, prefer the one with the highest operation load
         const unsigned shardChunkCount =
             distribution.numberOfChunksInShardWithTag(stat.shardId, chunkTag);
-        if (shardChunkCount <= maxChunks)
+        if (shardChunkCount == 0 || shardChunkCount < maxChunks ||
+            (shardChunkCount == maxChunks && stat.opLoad <= maxOpLoad))
             continue;
 
         worst = stat.shardId;
         maxChunks = shardChunkCount;
+        maxOpLoad = stat.opLoad;
     }
 
     return worst;
@@ -193,6 +193,34 @@ TEST(BalancerPolicy, ParallelBalancing) {
     ASSERT_BSONOBJ_EQ(cluster.second[kShardId1][0].getMax(), migrations[1].maxKey);
 }
 
+TEST(BalancerPolicy, ParallelBalancingBreaksTiesByOperationLoad) {
+    const auto makeStats = [](const ShardId& shardId, uint64_t currSizeMB, double opLoad) {
+        ShardStatistics stats(
+            shardId, kNoMaxSize, currSizeMB, false, emptyTagSet, emptyShardVersion);
+        stats.opLoad = opLoad;
+        return stats;
+    };
+
+    auto cluster = generateCluster({{makeStats(kShardId0, 4, 10), 4},
+                                    {makeStats(kShardId1, 4, 100), 4},
+                                    {makeStats(kShardId2, 0, 50), 0},
+                                    {makeStats(kShardId3, 0, 5), 0}});
+
+    const auto migrations(
+        balanceChunks(cluster.first, DistributionStatus(kNamespace, cluster.second), false));
+    ASSERT_EQ(2U, migrations.size());
+
+    ASSERT_EQ(kShardId1, migrations[0].from);
+    ASSERT_EQ(kShardId3, migrations[0].to);
+    ASSERT_BSONOBJ_EQ(cluster.second[kShardId1][0].getMin(), migrations[0].minKey);
+    ASSERT_BSONOBJ_EQ(cluster.second[kShardId1][0].getMax(), migrations[0].maxKey);
+
+    ASSERT_EQ(kShardId0, migrations[1].from);
+    ASSERT_EQ(kShardId2, migrations[1].to);
+    ASSERT_BSONOBJ_EQ(cluster.second[kShardId0][0].getMin(), migrations[1].minKey);
+    ASSERT_BSONOBJ_EQ(cluster.second[kShardId0][0].getMax(), migrations[1].maxKey);
+}
+
 TEST(BalancerPolicy, ParallelBalancingDoesNotPutChunksOnShardsAboveTheOptimal) {
     auto cluster = generateCluster(
         {{ShardStatistics(kShardId0, kNoMaxSize, 100, false, emptyTagSet, emptyShardVersion), 100},
@@ -72,6 +72,7 @@ BSONObj ClusterStatistics::ShardStatistics::toBSON() const {
     }
 
     builder.append("version", mongoVersion);
+    builder.append("opLoad", opLoad);
     return builder.obj();
 }
 
@@ -92,6 +92,10 @@ public:
 
         // Version of mongod, which runs on this shard's primary
         std::string mongoVersion;
+
+        // Weighted rate of operations per second on this shard's primary, measured between two
+        // consecutive statistics collections. Zero if it is not known yet.
+        double opLoad{0};
     };
 
     virtual ~ClusterStatistics();
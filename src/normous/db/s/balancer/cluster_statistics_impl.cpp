@@ -33,10 +33,12 @@
 #include "mongo/db/s/balancer/cluster_statistics_impl.h"
 
 #include <algorithm>
+#include <utility>
 
 #include "mongo/base/status_with.h"
 #include "mongo/bson/util/bson_extract.h"
 #include "mongo/client/read_preference.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/s/catalog/type_shard.h"
 #include "mongo/s/client/shard_registry.h"
 #include "mongo/s/grid.h"
@@ -48,16 +50,33 @@ namespace mongo {
 namespace {
 
 const char kVersionField[] = "version";
+const char kOpCountersField[] = "opcounters";
+
+// Weights given to the reads (queries and getMores) and to the writes (inserts, updates and
+// deletes) on a shard when computing its operation load
+MONGO_EXPORT_SERVER_PARAMETER(balancerReadLoadWeight, double, 1.0)
+    ->withValidator([](const double& newVal) {
+        if (newVal < 0) {
+            return Status(ErrorCodes::BadValue, "balancerReadLoadWeight must not be negative");
+        }
+        return Status::OK();
+    });
+
+MONGO_EXPORT_SERVER_PARAMETER(balancerWriteLoadWeight, double, 1.0)
+    ->withValidator([](const double& newVal) {
+        if (newVal < 0) {
+            return Status(ErrorCodes::BadValue, "balancerWriteLoadWeight must not be negative");
+        }
+        return Status::OK();
+    });
 
 /**
- * Executes the serverStatus command against the specified shard and obtains the version of the
- * running MongoD service.
+ * Executes the serverStatus command against the specified shard and returns its response.
  *
- * Returns the MongoD version in strig format or an error. Known error codes are:
+ * Known error codes are:
  *  ShardNotFound if shard by that id is not available on the registry
- *  NoSuchKey if the version could not be retrieved
  */
-StatusWith<std::string> retrieveShardMongoDVersion(OperationContext* opCtx, ShardId shardId) {
+StatusWith<BSONObj> retrieveShardServerStatus(OperationContext* opCtx, ShardId shardId) {
     auto shardRegistry = Grid::get(opCtx)->shardRegistry();
     auto shardStatus = shardRegistry->getShard(opCtx, shardId);
     if (!shardStatus.isOK()) {
@@ -78,8 +97,16 @@ StatusWith<std::string> retrieveShardMongoDVersion(OperationContext* opCtx, Shar
         return commandResponse.getValue().commandStatus;
     }
 
-    BSONObj serverStatus = std::move(commandResponse.getValue().response);
+    return std::move(commandResponse.getValue().response);
+}
 
+/**
+ * Obtains the version of the running MongoD service from its serverStatus response.
+ *
+ * Returns the MongoD version in strig format or an error. Known error codes are:
+ *  NoSuchKey if the version could not be retrieved
+ */
+StatusWith<std::string> extractShardMongoDVersion(const BSONObj& serverStatus) {
     std::string version;
     Status status = bsonExtractStringField(serverStatus, kVersionField, &version);
     if (!status.isOK()) {
@@ -89,6 +116,22 @@ StatusWith<std::string> retrieveShardMongoDVersion(OperationContext* opCtx, Shar
     return version;
 }
 
+/**
+ * Returns the total number of reads and of writes in the 'opcounters' section of a serverStatus
+ * response, or boost::none if the section is missing.
+ */
+boost::optional<std::pair<long long, long long>> extractOpCounters(const BSONObj& serverStatus) {
+    const auto opCounters = serverStatus[kOpCountersField];
+    if (opCounters.type() != Object) {
+        return boost::none;
+    }
+
+    const auto counter = [&](StringData name) { return opCounters.Obj()[name].safeNumberLong(); };
+
+    return std::make_pair(counter("query") + counter("getmore"),
+                          counter("insert") + counter("update") + counter("delete"));
+}
+
 }  // namespace
 
 using ShardStatistics = ClusterStatistics::ShardStatistics;
@@ -133,8 +176,12 @@ StatusWith<std::vector<ShardStatistics>> ClusterStatisticsImpl::getStats(Operati
         }
 
         std::string mongoDVersion;
+        double opLoad = 0;
 
-        auto mongoDVersionStatus = retrieveShardMongoDVersion(opCtx, shard.getName());
+        auto serverStatus = retrieveShardServerStatus(opCtx, shard.getName());
+        auto mongoDVersionStatus = serverStatus.isOK()
+            ? extractShardMongoDVersion(serverStatus.getValue())
+            : StatusWith<std::string>(serverStatus.getStatus());
         if (mongoDVersionStatus.isOK()) {
             mongoDVersion = std::move(mongoDVersionStatus.getValue());
         } else {
@@ -144,6 +191,15 @@ StatusWith<std::vector<ShardStatistics>> ClusterStatisticsImpl::getStats(Operati
                   << causedBy(mongoDVersionStatus.getStatus());
         }
 
+        if (serverStatus.isOK()) {
+            // The operation load is only used to break ties between shards, so it is left as
+            // unknown if the opcounters cannot be retrieved
+            if (auto opCounters = extractOpCounters(serverStatus.getValue())) {
+                opLoad = _updateOpLoad(shard.getName(),
+                                       {opCounters->first, opCounters->second, Date_t::now()});
+            }
+        }
+
         std::set<std::string> shardTags;
 
         for (const auto& shardTag : shard.getTags()) {
@@ -156,9 +212,35 @@ StatusWith<std::vector<ShardStatistics>> ClusterStatisticsImpl::getStats(Operati
                            shard.getDraining(),
                            std::move(shardTags),
                            std::move(mongoDVersion));
+        stats.back().opLoad = opLoad;
     }
 
     return stats;
 }
 
+double ClusterStatisticsImpl::_updateOpLoad(const ShardId& shardId, OpCountersSample sample) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+
+    auto it = _lastOpCounters.find(shardId);
+    if (it == _lastOpCounters.end()) {
+        _lastOpCounters.emplace(shardId, sample);
+        return 0;
+    }
+
+    const auto previous = it->second;
+    it->second = sample;
+
+    // The counters start over when the shard's primary restarts or changes
+    const auto elapsedMillis = durationCount<Milliseconds>(sample.takenAt - previous.takenAt);
+    if (sample.reads < previous.reads || sample.writes < previous.writes || elapsedMillis <= 0) {
+        return 0;
+    }
+
+    const double weightedOps =
+        balancerReadLoadWeight.load() * (sample.reads - previous.reads) +
+        balancerWriteLoadWeight.load() * (sample.writes - previous.writes);
+
+    return weightedOps * 1000 / elapsedMillis;
+}
+
 }  // namespace mongo
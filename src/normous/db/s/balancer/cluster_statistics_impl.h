@@ -28,8 +28,13 @@
 
 #pragma once
 
+#include <map>
+
 #include "mongo/db/s/balancer/balancer_random.h"
 #include "mongo/db/s/balancer/cluster_statistics.h"
+#include "mongo/s/shard_id.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
@@ -37,6 +42,9 @@ namespace mongo {
  * Default implementation for the cluster statistics gathering utility. Uses a blocking method to
  * fetch the statistics and does not perform any caching. If any of the shards fails to report
  * statistics fails the entire refresh.
+ *
+ * The operation load of each shard is derived from the difference between its serverStatus
+ * opcounters and those seen on the previous call, so it is only known from the second call on.
  */
 class ClusterStatisticsImpl final : public ClusterStatistics {
 public:
@@ -46,8 +54,27 @@ public:
     StatusWith<std::vector<ShardStatistics>> getStats(OperationContext* opCtx) override;
 
 private:
+    // A sample of the opcounters of a shard
+    struct OpCountersSample {
+        long long reads;
+        long long writes;
+        Date_t takenAt;
+    };
+
+    /**
+     * Records 'sample' as the latest one for 'shardId' and returns the weighted operation rate
+     * since the previous sample, or zero if there is no usable previous sample.
+     */
+    double _updateOpLoad(const ShardId& shardId, OpCountersSample sample);
+
     // Source of randomness when metadata needs to be randomized.
     BalancerRandomSource& _random;
+
+    // Protects '_lastOpCounters'
+    stdx::mutex _mutex;
+
+    // The opcounters sample from the last statistics collection for each shard
+    std::map<ShardId, OpCountersSample> _lastOpCounters;
 };
 
 }  // namespace mongo
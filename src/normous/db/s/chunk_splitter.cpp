@@ -42,6 +42,7 @@
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/db/s/split_chunk.h"
 #include "mongo/db/s/split_vector.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/s/balancer_configuration.h"
 #include "mongo/s/catalog/type_chunk.h"
@@ -56,6 +57,17 @@
 namespace mongo {
 namespace {
 
+// Number of documents sampled to estimate the split points of a chunk before falling back to
+// scanning its index range. Zero always scans the index.
+MONGO_EXPORT_SERVER_PARAMETER(autoSplitSampleSize, int, 1000)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0 || newVal > 100000) {
+            return Status(ErrorCodes::BadValue,
+                          "autoSplitSampleSize must be between 0 and 100000 inclusive");
+        }
+        return Status::OK();
+    });
+
 /**
  * Constructs the default options for the thread pool used to schedule splits.
  */
@@ -323,7 +335,8 @@ void ChunkSplitter::_runAutosplit(std::shared_ptr<ChunkSplitStateDriver> chunkSp
                                                        boost::none,
                                                        boost::none,
                                                        boost::none,
-                                                       maxChunkSizeBytes));
+                                                       maxChunkSizeBytes,
+                                                       autoSplitSampleSize.load()));
 
         if (splitPoints.size() <= 1) {
             LOG(1)
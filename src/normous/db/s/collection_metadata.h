@@ -129,6 +129,15 @@ public:
         return _cm->keyBelongsToShard(key, _thisShardId);
     }
 
+    /**
+     * Returns true if this shard owns every chunk of the collection, in which case there can be no
+     * orphaned or pending documents and keyBelongsToMe is true for any valid key.
+     */
+    bool ownsAllChunks() const {
+        invariant(isSharded());
+        return _cm->shardOwnsAllChunks(_thisShardId);
+    }
+
     /**
      * Given a key 'lookupKey' in the shard key range, get the next chunk which overlaps or is
      * greater than this key.  Returns true if a chunk exists, false otherwise.
@@ -390,5 +390,47 @@ TEST_F(StaleChunkFixture, KeyBelongsToMe) {
                        ErrorCodes::StaleChunkHistory);
 }
 
+/**
+ * Returns metadata for the latest routing table of a collection split at {a: 0}, with the chunk
+ * [0, MaxKey) owned by 'upperChunkShard' and the rest by "thisShard".
+ */
+std::unique_ptr<CollectionMetadata> makeLatestCollectionMetadata(const ShardId& upperChunkShard) {
+    const OID epoch = OID::gen();
+    const NamespaceString kNss("test.foo");
+    const ShardId kThisShard("thisShard");
+    const KeyPattern shardKeyPattern(BSON("a" << 1));
+
+    ChunkVersion version{1, 0, epoch};
+    std::vector<ChunkType> allChunks;
+    allChunks.emplace_back(
+        kNss, ChunkRange{shardKeyPattern.globalMin(), BSON("a" << 0)}, version, kThisShard);
+    version.incMajor();
+    allChunks.emplace_back(
+        kNss, ChunkRange{BSON("a" << 0), shardKeyPattern.globalMax()}, version, upperChunkShard);
+
+    auto rt = RoutingTableHistory::makeNew(
+        kNss, UUID::gen(), shardKeyPattern, nullptr, false, epoch, allChunks);
+    return stdx::make_unique<CollectionMetadata>(std::make_shared<ChunkManager>(rt, boost::none),
+                                                 kThisShard);
+}
+
+TEST(CollectionMetadataOwnershipTest, OwnsAllChunks) {
+    auto metadata = makeLatestCollectionMetadata(ShardId("thisShard"));
+    ASSERT(metadata->ownsAllChunks());
+    ASSERT(metadata->keyBelongsToMe(BSON("a" << -10)));
+    ASSERT(metadata->keyBelongsToMe(BSON("a" << 10)));
+}
+
+TEST(CollectionMetadataOwnershipTest, DoesNotOwnAllChunks) {
+    auto metadata = makeLatestCollectionMetadata(ShardId("otherShard"));
+    ASSERT(!metadata->ownsAllChunks());
+    ASSERT(metadata->keyBelongsToMe(BSON("a" << -10)));
+    ASSERT(!metadata->keyBelongsToMe(BSON("a" << 10)));
+}
+
+TEST_F(SingleChunkFixture, OwnsAllChunks) {
+    ASSERT(!makeCollectionMetadata()->ownsAllChunks());
+}
+
 }  // namespace
 }  // namespace mongo
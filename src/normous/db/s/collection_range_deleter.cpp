@@ -71,6 +71,21 @@ MONGO_EXPORT_SERVER_PARAMETER(rangeDeleterBatchDelayMS, int, 20)
 
 namespace {
 
+// Number of documents removed in each write unit of work. Grouping several deletes amortizes the
+// cost of committing a storage transaction over the whole group.
+MONGO_EXPORT_SERVER_PARAMETER(rangeDeleterDeletesPerWriteUnitOfWork, int, 1)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 1 || newVal > 1000) {
+            return Status(ErrorCodes::BadValue,
+                          "rangeDeleterDeletesPerWriteUnitOfWork must be between 1 and 1000");
+        }
+        return Status::OK();
+    });
+
+// Whether to wait for the deletions of each batch to be majority committed before deleting the next
+// batch, so that the range deleter does not run ahead of lagging secondaries
+MONGO_EXPORT_SERVER_PARAMETER(rangeDeleterWaitForMajorityBetweenBatches, bool, false);
+
 using Deletion = CollectionRangeDeleter::Deletion;
 using DeleteNotification = CollectionRangeDeleter::DeleteNotification;
 
@@ -297,6 +312,27 @@ boost::optional<Date_t> CollectionRangeDeleter::cleanUpNextRange(
     invariant(wrote.getValue() > 0);
 
     notification.abandon();
+
+    if (rangeDeleterWaitForMajorityBetweenBatches.load()) {
+        repl::ReplClientInfo::forClient(opCtx->getClient()).setLastOpToSystemLastOpTime(opCtx);
+        const auto clientOpTime = repl::ReplClientInfo::forClient(opCtx->getClient()).getLastOp();
+
+        // A failure here is not fatal to the range deletion, since the deletions are waited for
+        // again once the range is exhausted
+        try {
+            WriteConcernResult unusedWCResult;
+            const auto status =
+                waitForWriteConcern(opCtx, clientOpTime, kMajorityWriteConcern, &unusedWCResult);
+            if (!status.isOK()) {
+                LOG(1) << "Error when waiting for majority replication of deletions in " << nss
+                       << " range " << redact(range->toString()) << " : " << redact(status);
+            }
+        } catch (const DBException& e) {
+            LOG(1) << "Interrupted while waiting for majority replication of deletions in " << nss
+                   << " range " << redact(range->toString()) << " : " << redact(e.toStatus());
+        }
+    }
+
     return Date_t::now() + stdx::chrono::milliseconds{rangeDeleterBatchDelayMS.load()};
 }
 
@@ -354,32 +390,62 @@ StatusWith<int> CollectionRangeDeleter::_doDeletion(OperationContext* opCtx,
     auto exec = InternalPlanner::indexScan(
         opCtx, collection, descriptor, min, max, halfOpen, manual, forward, fetch);
 
+    const int deletesPerWriteUnitOfWork = rangeDeleterDeletesPerWriteUnitOfWork.load();
+
     int numDeleted = 0;
-    do {
-        RecordId rloc;
-        BSONObj obj;
-        PlanExecutor::ExecState state = exec->getNext(&obj, &rloc);
-        if (state == PlanExecutor::IS_EOF) {
-            break;
+    bool exhausted = false;
+    while (!exhausted && numDeleted < maxToDelete) {
+        // Collect the next group of documents, which will be deleted in a single write unit of
+        // work. They must be owned, because advancing the executor may invalidate earlier results.
+        const int groupSize = std::min(deletesPerWriteUnitOfWork, maxToDelete - numDeleted);
+        std::vector<std::pair<RecordId, BSONObj>> toDelete;
+        toDelete.reserve(groupSize);
+
+        while (static_cast<int>(toDelete.size()) < groupSize) {
+            RecordId rloc;
+            BSONObj obj;
+            PlanExecutor::ExecState state = exec->getNext(&obj, &rloc);
+            if (state == PlanExecutor::IS_EOF) {
+                exhausted = true;
+                break;
+            }
+            if (state == PlanExecutor::FAILURE || state == PlanExecutor::DEAD) {
+                warning() << PlanExecutor::statestr(state)
+                          << " - cursor error while trying to delete " << redact(min) << " to "
+                          << redact(max) << " in " << nss << ": "
+                          << redact(WorkingSetCommon::toStatusString(obj))
+                          << ", stats: " << Explain::getWinningPlanStats(exec.get());
+                exhausted = true;
+                break;
+            }
+            invariant(PlanExecutor::ADVANCED == state);
+
+            toDelete.emplace_back(rloc, obj.getOwned());
         }
-        if (state == PlanExecutor::FAILURE || state == PlanExecutor::DEAD) {
-            warning() << PlanExecutor::statestr(state) << " - cursor error while trying to delete "
-                      << redact(min) << " to " << redact(max) << " in " << nss << ": "
-                      << redact(WorkingSetCommon::toStatusString(obj))
-                      << ", stats: " << Explain::getWinningPlanStats(exec.get());
+
+        if (toDelete.empty()) {
             break;
         }
-        invariant(PlanExecutor::ADVANCED == state);
 
         exec->saveState();
         writeConflictRetry(opCtx, "delete range", nss.ns(), [&] {
             WriteUnitOfWork wuow(opCtx);
-            if (saver) {
-                uassertStatusOK(saver->goingToDelete(obj));
+            for (const auto& doc : toDelete) {
+                if (saver) {
+                    uassertStatusOK(saver->goingToDelete(doc.second));
+                }
+                collection->deleteDocument(opCtx, kUninitializedStmtId, doc.first, nullptr, true);
             }
-            collection->deleteDocument(opCtx, kUninitializedStmtId, rloc, nullptr, true);
             wuow.commit();
         });
+
+        numDeleted += toDelete.size();
+        ShardingStatistics::get(opCtx).countDocsDeletedOnDonor.addAndFetch(toDelete.size());
+
+        if (exhausted) {
+            break;
+        }
+
         auto restoreStateStatus = exec->restoreState();
         if (!restoreStateStatus.isOK()) {
             warning() << "error restoring cursor state while trying to delete " << redact(min)
@@ -388,9 +454,7 @@ StatusWith<int> CollectionRangeDeleter::_doDeletion(OperationContext* opCtx,
                       << redact(restoreStateStatus);
             break;
         }
-        ShardingStatistics::get(opCtx).countDocsDeletedOnDonor.addAndFetch(1);
-
-    } while (++numDeleted < maxToDelete);
+    }
 
     return numDeleted;
 }
@@ -40,11 +40,13 @@
 #include "mongo/db/repl/replication_coordinator_mock.h"
 #include "mongo/db/s/collection_sharding_runtime.h"
 #include "mongo/db/s/sharding_state.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/s/balancer_configuration.h"
 #include "mongo/s/chunk_version.h"
 #include "mongo/s/client/shard_registry.h"
 #include "mongo/s/shard_server_test_fixture.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -231,6 +233,37 @@ TEST_F(CollectionRangeDeleterTest, MultipleCleanupNextRangeCalls) {
     ASSERT_EQUALS(0ULL, dbclient.count(kAdminSysVer.ns(), BSON(kShardKey << "startRangeDeletion")));
 }
 
+// Tests that grouping several deletes in each write unit of work still honours the max deletion
+// rate of each run.
+TEST_F(CollectionRangeDeleterTest, MultipleDeletesPerWriteUnitOfWork) {
+    auto deletesPerWriteUnitOfWork =
+        ServerParameterSet::getGlobal()->getMap().find("rangeDeleterDeletesPerWriteUnitOfWork");
+    ASSERT_OK(deletesPerWriteUnitOfWork->second->setFromString("2"));
+    ON_BLOCK_EXIT([&] { ASSERT_OK(deletesPerWriteUnitOfWork->second->setFromString("1")); });
+
+    CollectionRangeDeleter rangeDeleter;
+    DBDirectClient dbclient(operationContext());
+    for (int i = 1; i <= 5; ++i) {
+        dbclient.insert(kNss.toString(), BSON(kShardKey << i));
+    }
+    ASSERT_EQUALS(5ULL, dbclient.count(kNss.toString(), BSON(kShardKey << LT << 10)));
+
+    std::list<Deletion> ranges;
+    auto deletion = Deletion{ChunkRange(BSON(kShardKey << 0), BSON(kShardKey << 10)), Date_t{}};
+    ranges.emplace_back(std::move(deletion));
+    auto when = rangeDeleter.add(std::move(ranges));
+    ASSERT(when && *when == Date_t{});
+
+    ASSERT_TRUE(next(rangeDeleter, 3));
+    ASSERT_EQUALS(2ULL, dbclient.count(kNss.toString(), BSON(kShardKey << LT << 10)));
+
+    ASSERT_TRUE(next(rangeDeleter, 3));
+    ASSERT_EQUALS(0ULL, dbclient.count(kNss.toString(), BSON(kShardKey << LT << 10)));
+
+    ASSERT_TRUE(next(rangeDeleter, 3));
+    ASSERT_FALSE(next(rangeDeleter, 3));
+}
+
 // Tests the case that there are two ranges to clean, each containing multiple documents.
 TEST_F(CollectionRangeDeleterTest, MultipleDocumentsInMultipleRangesToClean) {
     CollectionRangeDeleter rangeDeleter;
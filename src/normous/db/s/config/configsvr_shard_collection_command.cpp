@@ -364,6 +364,15 @@ void validateShardKeyAgainstExistingIndexes(OperationContext* opCtx,
                                   << idx["seed"].numberInt(),
                     !shardKeyPattern.isHashedPattern() || idx["seed"].eoo() ||
                         idx["seed"].numberInt() == BSONElementHasher::DEFAULT_HASH_SEED);
+            // Chunk ranges of hashed shard keys are defined in terms of the default hash function.
+            uassert(ErrorCodes::InvalidOptions,
+                    str::stream() << "can't shard collection " << nss.ns()
+                                  << " with hashed shard key "
+                                  << proposedKey
+                                  << " because the hashed index uses hashVersion "
+                                  << idx["hashVersion"].numberInt(),
+                    !shardKeyPattern.isHashedPattern() ||
+                        idx["hashVersion"].numberInt() == BSONElementHasher::MD5_HASH_VERSION);
             hasUsefulIndexForKey = true;
         }
     }
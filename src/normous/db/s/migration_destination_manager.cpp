@@ -53,6 +53,7 @@
 #include "mongo/db/s/move_timing_helper.h"
 #include "mongo/db/s/sharding_statistics.h"
 #include "mongo/db/s/start_chunk_clone_request.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/s/catalog/type_chunk.h"
 #include "mongo/s/client/shard_registry.h"
@@ -210,6 +211,17 @@ MONGO_FAIL_POINT_DEFINE(migrateThreadHangAtStep6);
 MONGO_FAIL_POINT_DEFINE(failMigrationLeaveOrphans);
 MONGO_FAIL_POINT_DEFINE(failMigrationReceivedOutOfRangeOperation);
 
+// Number of threads on the recipient, which insert the cloned batches in parallel. Each inserter
+// thread allows one more batch to be fetched from the donor ahead of the batches being inserted.
+MONGO_EXPORT_SERVER_PARAMETER(migrationCloneInsertionThreads, int, 1)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 1 || newVal > 16) {
+            return Status(ErrorCodes::BadValue,
+                          "migrationCloneInsertionThreads must be between 1 and 16");
+        }
+        return Status::OK();
+    });
+
 }  // namespace
 
 MigrationDestinationManager::MigrationDestinationManager() = default;
@@ -376,33 +388,48 @@ Status MigrationDestinationManager::start(OperationContext* opCtx,
 void MigrationDestinationManager::cloneDocumentsFromDonor(
     OperationContext* opCtx,
     stdx::function<void(OperationContext*, BSONObj)> insertBatchFn,
-    stdx::function<BSONObj(OperationContext*)> fetchBatchFn) {
+    stdx::function<BSONObj(OperationContext*)> fetchBatchFn,
+    int numInserterThreads) {
+    invariant(numInserterThreads >= 1);
 
-    ProducerConsumerQueue<BSONObj> batches(1);
-    stdx::thread inserterThread{[&] {
-        Client::initThreadIfNotAlready("chunkInserter");
-        auto inserterOpCtx = Client::getCurrent()->makeOperationContext();
-        auto consumerGuard = MakeGuard([&] { batches.closeConsumerEnd(); });
-        try {
-            while (true) {
-                auto nextBatch = batches.pop(inserterOpCtx.get());
-                auto arr = nextBatch["objects"].Obj();
-                if (arr.isEmpty()) {
-                    return;
-                }
-                insertBatchFn(inserterOpCtx.get(), arr);
-            }
-        } catch (...) {
-            stdx::lock_guard<Client> lk(*opCtx->getClient());
-            opCtx->getServiceContext()->killOperation(opCtx, exceptionToStatus().code());
-            log() << "Batch insertion failed " << causedBy(redact(exceptionToStatus()));
+    ProducerConsumerQueue<BSONObj> batches(numInserterThreads);
+
+    std::vector<stdx::thread> inserterThreads;
+    auto joinInserterThreads = [&] {
+        for (auto& inserterThread : inserterThreads) {
+            inserterThread.join();
         }
-    }};
+    };
+
     auto inserterThreadJoinGuard = MakeGuard([&] {
         batches.closeProducerEnd();
-        inserterThread.join();
+        joinInserterThreads();
     });
 
+    for (int i = 0; i < numInserterThreads; ++i) {
+        inserterThreads.emplace_back([&] {
+            Client::initThreadIfNotAlready("chunkInserter");
+            auto inserterOpCtx = Client::getCurrent()->makeOperationContext();
+            auto consumerGuard = MakeGuard([&] { batches.closeConsumerEnd(); });
+            try {
+                while (true) {
+                    auto nextBatch = batches.pop(inserterOpCtx.get());
+                    auto arr = nextBatch["objects"].Obj();
+                    if (arr.isEmpty()) {
+                        // The other inserter threads each receive their own empty batch
+                        consumerGuard.Dismiss();
+                        return;
+                    }
+                    insertBatchFn(inserterOpCtx.get(), arr);
+                }
+            } catch (...) {
+                stdx::lock_guard<Client> lk(*opCtx->getClient());
+                opCtx->getServiceContext()->killOperation(opCtx, exceptionToStatus().code());
+                log() << "Batch insertion failed " << causedBy(redact(exceptionToStatus()));
+            }
+        });
+    }
+
     while (true) {
         opCtx->checkForInterrupt();
 
@@ -412,8 +439,13 @@ void MigrationDestinationManager::cloneDocumentsFromDonor(
         batches.push(res.getOwned(), opCtx);
         auto arr = res["objects"].Obj();
         if (arr.isEmpty()) {
+            // Every inserter thread stops after popping one empty batch
+            for (int i = 1; i < numInserterThreads; ++i) {
+                batches.push(res.getOwned(), opCtx);
+            }
+
             inserterThreadJoinGuard.Dismiss();
-            inserterThread.join();
+            joinInserterThreads();
             opCtx->checkForInterrupt();
             break;
         }
@@ -831,7 +863,8 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* opCtx) {
             return res.response;
         };
 
-        cloneDocumentsFromDonor(opCtx, insertBatchFn, fetchBatchFn);
+        cloneDocumentsFromDonor(
+            opCtx, insertBatchFn, fetchBatchFn, migrationCloneInsertionThreads.load());
 
         timing.done(3);
         MONGO_FAIL_POINT_PAUSE_WHILE_SET(migrateThreadHangAtStep3);
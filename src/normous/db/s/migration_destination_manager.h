@@ -108,12 +108,16 @@ public:
                  const WriteConcernOptions& writeConcern);
 
     /**
-     * Clones documents from a donor shard.
+     * Clones documents from a donor shard. Batches are fetched on the calling thread and inserted
+     * by 'numInserterThreads' threads in parallel, so that up to that many batches can be in
+     * flight between the donor and the recipient at any time. An empty batch signals the end of
+     * the documents to clone.
      */
     static void cloneDocumentsFromDonor(
         OperationContext* opCtx,
         stdx::function<void(OperationContext*, BSONObj)> insertBatchFn,
-        stdx::function<BSONObj(OperationContext*)> fetchBatchFn);
+        stdx::function<BSONObj(OperationContext*)> fetchBatchFn,
+        int numInserterThreads = 1);
 
     /**
      * Idempotent method, which causes the current ongoing migration to abort only if it has the
@@ -28,8 +28,11 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+
 #include "mongo/db/s/migration_destination_manager.h"
 #include "mongo/s/shard_server_test_fixture.h"
+#include "mongo/stdx/mutex.h"
 #include "mongo/unittest/unittest.h"
 
 namespace mongo {
@@ -104,6 +107,48 @@ TEST_F(MigrationDestinationManagerTest, CloneDocumentsFromDonorWorksCorrectly) {
     }
 }
 
+// Tests that every batch is inserted exactly once when several threads insert in parallel.
+TEST_F(MigrationDestinationManagerTest, CloneDocumentsFromDonorWithMultipleInserterThreads) {
+    const int kNumBatches = 10;
+    int numBatchesFetched = 0;
+
+    auto fetchBatchFn = [&](OperationContext* opCtx) {
+        BSONObjBuilder fetchBatchResultBuilder;
+
+        if (numBatchesFetched == kNumBatches) {
+            fetchBatchResultBuilder.append("objects", BSONObj());
+        } else {
+            BSONArrayBuilder arrayBuilder;
+            arrayBuilder.append(createDocument(2 * numBatchesFetched));
+            arrayBuilder.append(createDocument(2 * numBatchesFetched + 1));
+            fetchBatchResultBuilder.append("objects", arrayBuilder.arr());
+            numBatchesFetched++;
+        }
+
+        return fetchBatchResultBuilder.obj();
+    };
+
+    stdx::mutex resultDocsMutex;
+    std::vector<int> resultIds;
+
+    auto insertBatchFn = [&](OperationContext* opCtx, BSONObj docs) {
+        stdx::lock_guard<stdx::mutex> lk(resultDocsMutex);
+        for (auto&& docToClone : docs) {
+            resultIds.push_back(docToClone.Obj()["_id"].numberInt());
+        }
+    };
+
+    MigrationDestinationManager::cloneDocumentsFromDonor(
+        operationContext(), insertBatchFn, fetchBatchFn, 4);
+
+    std::sort(resultIds.begin(), resultIds.end());
+
+    ASSERT_EQ(static_cast<size_t>(2 * kNumBatches), resultIds.size());
+    for (int i = 0; i < 2 * kNumBatches; ++i) {
+        ASSERT_EQ(i, resultIds[i]);
+    }
+}
+
 // Tests that an exception in the fetch logic will successfully throw an exception on the main
 // thread.
 TEST_F(MigrationDestinationManagerTest, CloneDocumentsThrowsFetchErrors) {
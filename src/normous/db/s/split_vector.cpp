@@ -43,6 +43,7 @@
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/query/plan_executor.h"
+#include "mongo/db/storage/record_store.h"
 #include "mongo/util/log.h"
 
 namespace mongo {
@@ -50,12 +51,117 @@ namespace {
 
 const int kMaxObjectPerChunk{250000};
 
+// How many random documents may be drawn for every sample requested, since the random cursor
+// walks the whole collection and only some of the documents it returns fall inside the chunk.
+const long long kMaxSampleAttemptsPerSample{10};
+
+// The fewest samples expected on each resulting chunk for the sampled split points to be used.
+// Sparser samples cannot place the split points reliably, so the exact index scan is used instead.
+const double kMinSamplesPerChunk{10};
+
 BSONObj prettyKey(const BSONObj& keyPattern, const BSONObj& key) {
     return key.replaceFieldNames(keyPattern).clientReadable();
 }
 
+/**
+ * Estimates the split points for the chunk [min, max) from a random sample of the documents in
+ * the collection, splitting roughly every 'keyCount' documents. Returns boost::none if the
+ * estimate cannot be made, in which case the caller must fall back to scanning the index.
+ */
+boost::optional<std::vector<BSONObj>> sampleSplitKeys(OperationContext* opCtx,
+                                                      Collection* collection,
+                                                      const BSONObj& keyPattern,
+                                                      const BSONObj& min,
+                                                      const BSONObj& max,
+                                                      long long keyCount,
+                                                      long long recCount,
+                                                      long long sampleSize) {
+    // The documents only contain the values of a hashed shard key, not the hashes which order the
+    // chunks, so sampled documents cannot be placed in a chunk.
+    for (const auto& elem : keyPattern) {
+        if (!elem.isNumber()) {
+            return boost::none;
+        }
+    }
+
+    auto cursor = collection->getRecordStore()->getRandomCursor(opCtx);
+    if (!cursor) {
+        return boost::none;
+    }
+
+    std::vector<BSONObj> samples;
+    long long numDrawn = 0;
+    const long long maxDrawn = sampleSize * kMaxSampleAttemptsPerSample;
+    while (static_cast<long long>(samples.size()) < sampleSize && numDrawn < maxDrawn) {
+        auto record = cursor->next();
+        if (!record) {
+            break;
+        }
+        numDrawn++;
+
+        auto key =
+            dotted_path_support::extractElementsBasedOnTemplate(record->data.toBson(), keyPattern);
+        if (key.nFields() != keyPattern.nFields()) {
+            // Documents missing shard key fields are stored as null in the index, which the
+            // extracted key does not reflect.
+            return boost::none;
+        }
+
+        if (key.woCompare(min) < 0 || (!max.isEmpty() && key.woCompare(max) >= 0)) {
+            continue;
+        }
+
+        samples.push_back(key.getOwned());
+    }
+
+    if (samples.empty()) {
+        return boost::none;
+    }
+
+    // Every sampled document stands for 'recCount / numDrawn' documents of the collection.
+    const double samplesPerChunk = static_cast<double>(keyCount) * numDrawn / recCount;
+    if (samplesPerChunk < kMinSamplesPerChunk) {
+        return boost::none;
+    }
+
+    LOG(1) << "estimating split points for chunk " << collection->ns() << " " << redact(min)
+           << " -->> " << redact(max) << " from " << samples.size() << " samples out of "
+           << numDrawn << " documents drawn";
+
+    return selectSplitPointsFromSamples(&samples, min, samplesPerChunk);
+}
+
 }  // namespace
 
+std::vector<BSONObj> selectSplitPointsFromSamples(std::vector<BSONObj>* samples,
+                                                  const BSONObj& min,
+                                                  double samplesPerChunk) {
+    std::sort(
+        samples->begin(), samples->end(), SimpleBSONObjComparator::kInstance.makeLessThan());
+
+    // Mirror the index scan below: use every 'samplesPerChunk'-th sample as a split point, unless
+    // it is the same key as the previous split point or as the beginning of the chunk.
+    std::vector<BSONObj> splitKeys;
+    double currCount = 0;
+    for (const auto& sample : *samples) {
+        currCount++;
+
+        if (currCount <= samplesPerChunk) {
+            continue;
+        }
+
+        const BSONObj& prevKey = splitKeys.empty() ? min : splitKeys.back();
+        if (sample.woCompare(prevKey) == 0) {
+            continue;
+        }
+
+        splitKeys.push_back(sample);
+        currCount = 0;
+    }
+
+    return splitKeys;
+}
+
 StatusWith<std::vector<BSONObj>> splitVector(OperationContext* opCtx,
                                              const NamespaceString& nss,
                                              const BSONObj& keyPattern,
@@ -65,7 +171,8 @@ StatusWith<std::vector<BSONObj>> splitVector(OperationContext* opCtx,
                                              boost::optional<long long> maxSplitPoints,
                                              boost::optional<long long> maxChunkObjects,
                                              boost::optional<long long> maxChunkSize,
-                                             boost::optional<long long> maxChunkSizeBytes) {
+                                             boost::optional<long long> maxChunkSizeBytes,
+                                             boost::optional<long long> sampleSize) {
     std::vector<BSONObj> splitKeys;
 
     // Always have a default value for maxChunkObjects
@@ -150,6 +257,24 @@ StatusWith<std::vector<BSONObj>> splitVector(OperationContext* opCtx,
             keyCount = maxChunkObjects.get();
         }
 
+        if (sampleSize && sampleSize.get() > 0 && !force) {
+            auto sampledSplitKeys = sampleSplitKeys(
+                opCtx, collection, keyPattern, min, max, keyCount, recCount, sampleSize.get());
+            if (sampledSplitKeys) {
+                splitKeys = std::move(sampledSplitKeys.get());
+                if (maxSplitPoints && maxSplitPoints.get() &&
+                    static_cast<long long>(splitKeys.size()) > maxSplitPoints.get()) {
+                    splitKeys.resize(maxSplitPoints.get());
+                }
+
+                return splitKeys;
+            }
+
+            LOG(1) << "could not estimate the split points of chunk " << nss.toString() << " "
+                   << redact(minKey) << " -->> " << redact(maxKey)
+                   << " from samples, scanning the index instead";
+        }
+
         //
         // Traverse the index and add the keyCount-th key to the result vector. If that key
         // appeared in the vector before, we omit it. The invariant here is that all the
@@ -54,6 +54,11 @@ class StatusWith;
  * be specified.
  * If force is set, split at the halfway point of the chunk. This also effectively
  * makes maxChunkSize equal the size of the chunk.
+ * If sampleSize is specified and force is not set, the split points are first estimated from up to
+ * "sampleSize" documents of the chunk drawn with the storage engine's random cursor, which avoids
+ * scanning the whole chunk range of the index. The exact index scan is still used whenever the
+ * storage engine does not support random cursors, the shard key is hashed, or the sample is too
+ * sparse to place the split points reliably.
  */
 StatusWith<std::vector<BSONObj>> splitVector(OperationContext* opCtx,
                                              const NamespaceString& nss,
@@ -64,6 +69,19 @@ StatusWith<std::vector<BSONObj>> splitVector(OperationContext* opCtx,
                                              boost::optional<long long> maxSplitPoints,
                                              boost::optional<long long> maxChunkObjects,
                                              boost::optional<long long> maxChunkSize,
-                                             boost::optional<long long> maxChunkSizeBytes);
+                                             boost::optional<long long> maxChunkSizeBytes,
+                                             boost::optional<long long> sampleSize = boost::none);
+
+/**
+ * Picks split points out of 'samples', the shard keys of randomly sampled documents from the chunk
+ * starting at 'min', so that consecutive split points are approximately 'samplesPerChunk' samples
+ * apart. Sorts 'samples' in place. Keys equal to 'min' or to the previously selected split point
+ * are never returned, so all the instances of a given key value end up in the same chunk.
+ *
+ * Exposed for unit testing.
+ */
+std::vector<BSONObj> selectSplitPointsFromSamples(std::vector<BSONObj>* samples,
+                                                  const BSONObj& min,
+                                                  double samplesPerChunk);
 
 }  // namespace mongo
@@ -300,5 +300,57 @@ TEST_F(SplitVectorTest, NoMaxChunkSize) {
     ASSERT_EQUALS(status.code(), ErrorCodes::InvalidOptions);
 }
 
+TEST_F(SplitVectorTest, SampledSplitFallsBackToIndexScanWithoutRandomCursor) {
+    // The storage engine used by the fixture does not support random cursors, so the split points
+    // must come from the exact index scan.
+    std::vector<BSONObj> splitKeys = unittest::assertGet(splitVector(operationContext(),
+                                                                     kNss,
+                                                                     BSON(kPattern << 1),
+                                                                     BSON(kPattern << 0),
+                                                                     BSON(kPattern << 100),
+                                                                     false,
+                                                                     boost::none,
+                                                                     boost::none,
+                                                                     boost::none,
+                                                                     getDocSizeBytes() * 100LL,
+                                                                     1000LL));
+    ASSERT_EQ(1UL, splitKeys.size());
+    ASSERT_BSONOBJ_EQ(BSON(kPattern << 50), splitKeys.front());
+}
+
+TEST(SelectSplitPointsFromSamplesTest, SplitsEveryNthSample) {
+    std::vector<BSONObj> samples;
+    for (int i = 99; i >= 0; i--) {
+        samples.push_back(BSON(kPattern << i));
+    }
+
+    auto splitKeys = selectSplitPointsFromSamples(&samples, BSON(kPattern << 0), 30);
+    std::vector<BSONObj> expected = {
+        BSON(kPattern << 30), BSON(kPattern << 61), BSON(kPattern << 92)};
+    ASSERT_EQ(expected.size(), splitKeys.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        ASSERT_BSONOBJ_EQ(expected[i], splitKeys[i]);
+    }
+}
+
+TEST(SelectSplitPointsFromSamplesTest, SkipsRepeatedKeys) {
+    // The first 20 samples all have the chunk's min key and the next 20 share a single key, so
+    // neither may be used as a split point on its own.
+    std::vector<BSONObj> samples;
+    for (int i = 0; i < 20; i++) {
+        samples.push_back(BSON(kPattern << 0));
+        samples.push_back(BSON(kPattern << 5));
+        samples.push_back(BSON(kPattern << (10 + i)));
+    }
+
+    auto splitKeys = selectSplitPointsFromSamples(&samples, BSON(kPattern << 0), 10);
+    std::vector<BSONObj> expected = {
+        BSON(kPattern << 5), BSON(kPattern << 10), BSON(kPattern << 21)};
+    ASSERT_EQ(expected.size(), splitKeys.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        ASSERT_BSONOBJ_EQ(expected[i], splitKeys[i]);
+    }
+}
+
 }  // namespace
 }  // namespace mongo
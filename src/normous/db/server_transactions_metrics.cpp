@@ -111,6 +111,30 @@ void ServerTransactionsMetrics::incrementTotalCommitted() {
     _totalCommitted.fetchAndAdd(1);
 }
 
+Microseconds ServerTransactionsMetrics::getTotalStashTime() const {
+    return Microseconds(static_cast<long long>(_totalStashMicros.load()));
+}
+
+void ServerTransactionsMetrics::addStashTime(Microseconds duration) {
+    _totalStashMicros.fetchAndAdd(durationCount<Microseconds>(duration));
+}
+
+Microseconds ServerTransactionsMetrics::getTotalUnstashTime() const {
+    return Microseconds(static_cast<long long>(_totalUnstashMicros.load()));
+}
+
+void ServerTransactionsMetrics::addUnstashTime(Microseconds duration) {
+    _totalUnstashMicros.fetchAndAdd(durationCount<Microseconds>(duration));
+}
+
+Microseconds ServerTransactionsMetrics::getTotalCommitTime() const {
+    return Microseconds(static_cast<long long>(_totalCommitMicros.load()));
+}
+
+void ServerTransactionsMetrics::addCommitTime(Microseconds duration) {
+    _totalCommitMicros.fetchAndAdd(durationCount<Microseconds>(duration));
+}
+
 boost::optional<Timestamp> ServerTransactionsMetrics::getOldestActiveTS() const {
     if (_oldestActiveOplogEntryTS.empty()) {
         return boost::none;
@@ -148,6 +172,9 @@ void ServerTransactionsMetrics::updateStats(TransactionsStats* stats) {
     stats->setTotalAborted(_totalAborted.load());
     stats->setTotalCommitted(_totalCommitted.load());
     stats->setTotalStarted(_totalStarted.load());
+    stats->setTotalStashMicros(_totalStashMicros.load());
+    stats->setTotalUnstashMicros(_totalUnstashMicros.load());
+    stats->setTotalCommitMicros(_totalCommitMicros.load());
 }
 
 class TransactionsSSS : public ServerStatusSection {
@@ -34,6 +34,7 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/transactions_stats_gen.h"
+#include "mongo/util/duration.h"
 
 namespace mongo {
 
@@ -70,6 +71,20 @@ public:
     unsigned long long getTotalCommitted() const;
     void incrementTotalCommitted();
 
+    /**
+     * Accumulate the time spent in each phase of a transaction's life: moving its resources off of
+     * an operation at the end of a statement, moving them back onto the next statement's
+     * operation, and committing.
+     */
+    Microseconds getTotalStashTime() const;
+    void addStashTime(Microseconds duration);
+
+    Microseconds getTotalUnstashTime() const;
+    void addUnstashTime(Microseconds duration);
+
+    Microseconds getTotalCommitTime() const;
+    void addCommitTime(Microseconds duration);
+
     /**
      * Returns the Timestamp of the oldest oplog entry written across all open transactions.
      * Returns boost::none if there are no transaction oplog entry Timestamps stored.
@@ -116,6 +131,11 @@ private:
     // The total number of multi-document transaction commits.
     AtomicUInt64 _totalCommitted{0};
 
+    // The total time, in microseconds, spent stashing, unstashing and committing transactions.
+    AtomicUInt64 _totalStashMicros{0};
+    AtomicUInt64 _totalUnstashMicros{0};
+    AtomicUInt64 _totalCommitMicros{0};
+
     // Maintain the oldest oplog entry Timestamp across all active transactions. Currently, we only
     // write an oplog entry for an ongoing transaction if it is in the `prepare` state. By
     // maintaining an ordered set of timestamps, the timestamp at the beginning will be the oldest.
@@ -65,6 +65,7 @@
 #include "mongo/db/repl/read_concern_args.h"
 #include "mongo/db/repl/repl_client_info.h"
 #include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/resource_groups.h"
 #include "mongo/db/s/operation_sharding_state.h"
 #include "mongo/db/s/sharded_connection_info.h"
 #include "mongo/db/s/sharding_state.h"
@@ -86,6 +87,7 @@
 #include "mongo/rpc/reply_builder_interface.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/log.h"
+#include "mongo/util/sampling_profiler.h"
 #include "mongo/util/scopeguard.h"
 
 namespace mongo {
@@ -578,6 +580,9 @@ void execCommandDatabase(OperationContext* opCtx,
     auto invocation = command->parse(opCtx, request);
     boost::optional<OperationSessionInfoFromClient> sessionOptions = boost::none;
 
+    SamplingProfiler::ScopedTag profilerTag(SamplingProfiler::TagKind::kCommand,
+                                            command->getName().c_str());
+
     try {
         {
             stdx::lock_guard<Client> lk(*opCtx->getClient());
@@ -824,6 +829,12 @@ void execCommandDatabase(OperationContext* opCtx,
 
         CurOp::get(opCtx)->ensureStarted();
 
+        // Queue behind the limit of the client's resource group, if it belongs to one. Commands
+        // that do not require authentication, such as isMaster, are never held back.
+        auto admission = command->requiresAuth()
+            ? ResourceGroups::get(opCtx->getServiceContext()).admit(opCtx, dbname)
+            : ResourceGroups::Admission();
+
         command->incrementCommandsExecuted();
 
         if (logger::globalLogDomain()->shouldLog(logger::LogComponent::kTracking,
@@ -1305,11 +1316,13 @@ DbResponse ServiceEntryPointCommon::handleRequest(OperationContext* opCtx,
     const bool shouldSample = currentOp.completeAndLogOperation(
         opCtx, MONGO_LOG_DEFAULT_COMPONENT, dbresponse.response.size(), slowMsOverride, forceLog);
 
+    const auto latencyMicros = durationCount<Microseconds>(currentOp.elapsedTimeExcludingPauses());
     Top::get(opCtx->getServiceContext())
-        .incrementGlobalLatencyStats(
-            opCtx,
-            durationCount<Microseconds>(currentOp.elapsedTimeExcludingPauses()),
-            currentOp.getReadWriteType());
+        .incrementGlobalLatencyStats(opCtx, latencyMicros, currentOp.getReadWriteType());
+
+    if (auto command = currentOp.getCommand()) {
+        command->recordLatency(latencyMicros);
+    }
 
     if (currentOp.shouldDBProfile(shouldSample)) {
         // Performance profiling is on
@@ -30,6 +30,9 @@
 
 #include "mongo/db/sessions_collection_sharded.h"
 
+#include <map>
+#include <vector>
+
 #include "mongo/db/matcher/extensions_callback_noop.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/query/canonical_query.h"
@@ -39,6 +42,7 @@
 #include "mongo/rpc/op_msg.h"
 #include "mongo/rpc/op_msg_rpc_impls.h"
 #include "mongo/s/catalog_cache.h"
+#include "mongo/s/chunk_manager.h"
 #include "mongo/s/grid.h"
 #include "mongo/s/query/cluster_find.h"
 #include "mongo/s/write_ops/batch_write_exec.h"
@@ -54,6 +58,47 @@ BSONObj lsidQuery(const LogicalSessionId& lsid) {
     return BSON(LogicalSessionRecord::kIdFieldName << lsid.toBSON());
 }
 
+const LogicalSessionId& getId(const LogicalSessionId& lsid) {
+    return lsid;
+}
+
+const LogicalSessionId& getId(const LogicalSessionRecord& record) {
+    return record.getId();
+}
+
+/**
+ * Splits 'items' into groups whose session records all live in chunks owned by the same shard, so
+ * that each batch of writes built from a group targets a single shard rather than spreading a few
+ * writes over every shard. Returns 'items' as the only group if the routing information of the
+ * sessions collection isn't available, in which case the writes are routed one by one as usual.
+ */
+template <typename Container>
+std::vector<Container> groupByOwningShard(OperationContext* opCtx, const Container& items) {
+    auto routingInfo = Grid::get(opCtx)->catalogCache()->getCollectionRoutingInfo(
+        opCtx, NamespaceString::kLogicalSessionsNamespace);
+    if (!routingInfo.isOK() || !routingInfo.getValue().cm()) {
+        return {items};
+    }
+
+    const auto cm = routingInfo.getValue().cm();
+    std::map<ShardId, Container> groups;
+    for (const auto& item : items) {
+        const auto shardKey =
+            cm->getShardKeyPattern().extractShardKeyFromDoc(lsidQuery(getId(item)));
+        if (shardKey.isEmpty()) {
+            return {items};
+        }
+        groups[cm->findIntersectingChunkWithSimpleCollation(shardKey).getShardId()].insert(item);
+    }
+
+    std::vector<Container> result;
+    result.reserve(groups.size());
+    for (auto& group : groups) {
+        result.push_back(std::move(group.second));
+    }
+    return result;
+}
+
 }  // namespace
 
 Status SessionsCollectionSharded::_checkCacheForSessionsCollection(OperationContext* opCtx) {
@@ -99,7 +144,13 @@ Status SessionsCollectionSharded::refreshSessions(OperationContext* opCtx,
         return response.toStatus();
     };
 
-    return doRefresh(NamespaceString::kLogicalSessionsNamespace, sessions, send);
+    for (const auto& group : groupByOwningShard(opCtx, sessions)) {
+        auto status = doRefresh(NamespaceString::kLogicalSessionsNamespace, group, send);
+        if (!status.isOK()) {
+            return status;
+        }
+    }
+    return Status::OK();
 }
 
 Status SessionsCollectionSharded::removeRecords(OperationContext* opCtx,
@@ -116,7 +167,13 @@ Status SessionsCollectionSharded::removeRecords(OperationContext* opCtx,
         return response.toStatus();
     };
 
-    return doRemove(NamespaceString::kLogicalSessionsNamespace, sessions, send);
+    for (const auto& group : groupByOwningShard(opCtx, sessions)) {
+        auto status = doRemove(NamespaceString::kLogicalSessionsNamespace, group, send);
+        if (!status.isOK()) {
+            return status;
+        }
+    }
+    return Status::OK();
 }
 
 StatusWith<LogicalSessionIdSet> SessionsCollectionSharded::findRemovedSessions(
@@ -165,6 +165,12 @@ MONGO_COMPILER_VARIABLE_UNUSED auto _exportedCheckCachePressurePeriodSeconds =
             return Status::OK();
         });
 
+MONGO_COMPILER_VARIABLE_UNUSED auto _exportedSnapshotHistoryPinnedByActiveReads =
+    new ExportedServerParameter<bool, ServerParameterType::kStartupAndRuntime>(
+        ServerParameterSet::getGlobal(),
+        "snapshotHistoryPinnedByActiveReads",
+        &snapshotWindowParams.snapshotHistoryPinnedByActiveReads);
+
 /**
  * After startup parameters have been initialized, set targetSnapshotHistoryWindowInSeconds to the
  * value of maxTargetSnapshotHistoryWindowInSeconds, in case the max has been altered. The cache
@@ -101,6 +101,15 @@ struct SnapshotWindowParams {
     // target window size setting must not be decreased too fast because time must be allowed for
     // the storage engine to attempt to act on the new setting.
     AtomicInt32 checkCachePressurePeriodSeconds{5};
+
+    // snapshotHistoryPinnedByActiveReads (startup & runtime server parameter).
+    //
+    // When true, oldest_timestamp is moved up to the stable_timestamp, or to the oldest read
+    // timestamp still pinned by an active reader if that is earlier, rather than trailing the
+    // stable_timestamp by targetSnapshotHistoryWindowInSeconds. History is then only retained for
+    // snapshots actually in use, and a new read at an older timestamp fails with SnapshotTooOld.
+    // Falls back on the window whenever some reader's timestamp could not be tracked.
+    AtomicBool snapshotHistoryPinnedByActiveReads{false};
 };
 
 extern SnapshotWindowParams snapshotWindowParams;
@@ -48,9 +48,12 @@
 #include "mongo/db/sorter/sorter.h"
 
 #include <boost/filesystem/operations.hpp>
+#include <cstring>
+#include <exception>
 #include <snappy.h>
 #include <vector>
 
+#include "mongo/base/checked_cast.h"
 #include "mongo/base/string_data.h"
 #include "mongo/config.h"
 #include "mongo/db/jsobj.h"
@@ -59,10 +62,14 @@
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/s/is_mongos.h"
+#include "mongo/stdx/functional.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/bufreader.h"
+#include "mongo/util/checksum.h"
 #include "mongo/util/destructor_guard.h"
 #include "mongo/util/mongoutils/str.h"
+#include "mongo/util/timer.h"
 #include "mongo/util/unowned_ptr.h"
 
 namespace mongo {
@@ -102,6 +109,77 @@ void dassertCompIsSane(const Comparator& comp, const Data& lhs, const Data& rhs)
 #endif
 }
 
+/**
+ * Runs work(0) through work(n - 1), each on its own thread, with work(0) on the calling thread.
+ * Rethrows the first exception thrown by any of them once they have all finished.
+ */
+inline void runInParallel(size_t n, const stdx::function<void(size_t)>& work) {
+    std::vector<std::exception_ptr> errors(n);
+    auto runOne = [&](size_t i) {
+        try {
+            work(i);
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+    };
+
+    std::vector<stdx::thread> threads;
+    for (size_t i = 1; i < n; i++) {
+        threads.emplace_back(runOne, i);
+    }
+    runOne(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (auto& error : errors) {
+        if (error)
+            std::rethrow_exception(error);
+    }
+}
+
+/**
+ * Stable sorts 'data' using up to 'maxThreads' threads. Each thread sorts a contiguous run, then
+ * neighbouring runs are merged pairwise, in parallel, until a single run is left. Batches too
+ * small to amortize starting threads are sorted on the calling thread.
+ */
+template <typename Container, typename Less>
+void parallelStableSort(Container& data, const Less& less, size_t maxThreads) {
+    const size_t kMinItemsPerThread = 16 * 1024;
+    const size_t numRuns = std::min(maxThreads, data.size() / kMinItemsPerThread);
+    if (numRuns <= 1) {
+        std::stable_sort(data.begin(), data.end(), less);
+        return;
+    }
+
+    // Run i is [bounds[i], bounds[i + 1]).
+    std::vector<size_t> bounds;
+    for (size_t i = 0; i <= numRuns; i++) {
+        bounds.push_back(data.size() * i / numRuns);
+    }
+
+    runInParallel(numRuns, [&](size_t i) {
+        std::stable_sort(data.begin() + bounds[i], data.begin() + bounds[i + 1], less);
+    });
+
+    while (bounds.size() > 2) {
+        runInParallel((bounds.size() - 1) / 2, [&](size_t i) {
+            std::inplace_merge(data.begin() + bounds[2 * i],
+                               data.begin() + bounds[2 * i + 1],
+                               data.begin() + bounds[2 * i + 2],
+                               less);
+        });
+
+        std::vector<size_t> merged;
+        for (size_t i = 0; i < bounds.size(); i += 2) {
+            merged.push_back(bounds[i]);
+        }
+        if (merged.back() != bounds.back())
+            merged.push_back(bounds.back());
+        bounds.swap(merged);
+    }
+}
+
 /** Ensures a named file is deleted when this object goes out of scope */
 class FileDeleter {
 public:
@@ -170,6 +248,15 @@ public:
                 boost::filesystem::file_size(_fileName) != 0);
     }
 
+    /**
+     * Reads the file 'bytes' at a time rather than a block at a time, so that merging many spill
+     * files does fewer, larger reads. Must be called before the first read.
+     */
+    void setReadAhead(size_t bytes) {
+        verify(!_reader);
+        _readAheadBytes = bytes;
+    }
+
     bool more() {
         if (!_done)
             fillIfNeeded();  // may change _done
@@ -204,10 +291,19 @@ private:
         const bool compressed = rawSize < 0;
         int32_t blockSize = std::abs(rawSize);
 
+        Checksum expectedChecksum;
+        read(expectedChecksum.bytes, sizeof(expectedChecksum.bytes));
+
         _buffer.reset(new char[blockSize]);
         read(_buffer.get(), blockSize);
         massert(16816, "file too short?", !_done);
 
+        Checksum checksum;
+        checksum.gen(_buffer.get(), blockSize);
+        massert(51210,
+                str::stream() << "checksum mismatch in sort spill file \"" << _fileName << "\"",
+                checksum == expectedChecksum);
+
         auto encryptionHooks = EncryptionHooks::get(getGlobalServiceContext());
         if (encryptionHooks->enabled()) {
             std::unique_ptr<char[]> out(new char[blockSize]);
@@ -249,6 +345,53 @@ private:
 
     // sets _done to true on EOF - asserts on any other error
     void read(void* out, size_t size) {
+        if (_readAheadBytes == 0) {
+            readFromFile(out, size);
+            return;
+        }
+
+        char* dest = reinterpret_cast<char*>(out);
+        while (size > 0) {
+            if (_readAheadPos == _readAheadEnd) {
+                if (size >= _readAheadBytes) {
+                    // Bigger than the buffer, so there is nothing to gain by copying through it.
+                    readFromFile(dest, size);
+                    return;
+                }
+                fillReadAhead();
+                if (_readAheadEnd == 0) {
+                    _done = true;
+                    return;
+                }
+            }
+
+            const size_t available = std::min(size, _readAheadEnd - _readAheadPos);
+            memcpy(dest, _readAheadBuffer.get() + _readAheadPos, available);
+            _readAheadPos += available;
+            dest += available;
+            size -= available;
+        }
+    }
+
+    void fillReadAhead() {
+        if (!_readAheadBuffer)
+            _readAheadBuffer.reset(new char[_readAheadBytes]);
+
+        _readAheadPos = 0;
+        _readAheadEnd = 0;
+        if (_file.eof())
+            return;
+
+        _file.read(_readAheadBuffer.get(), _readAheadBytes);
+        if (!_file.good() && !_file.eof()) {
+            msgasserted(16817,
+                        str::stream() << "error reading file \"" << _fileName << "\": "
+                                      << myErrnoWithDescription());
+        }
+        _readAheadEnd = _file.gcount();
+    }
+
+    void readFromFile(void* out, size_t size) {
         _file.read(reinterpret_cast<char*>(out), size);
         if (!_file.good()) {
             if (_file.eof()) {
@@ -267,12 +410,23 @@ private:
     bool _done;
     std::unique_ptr<char[]> _buffer;
     std::unique_ptr<BufReader> _reader;
+    size_t _readAheadBytes = 0;
+    std::unique_ptr<char[]> _readAheadBuffer;
+    size_t _readAheadPos = 0;  // Next unread byte in _readAheadBuffer.
+    size_t _readAheadEnd = 0;  // End of the valid bytes in _readAheadBuffer.
     std::string _fileName;
     std::shared_ptr<FileDeleter> _fileDeleter;  // Must outlive _file
     std::ifstream _file;
 };
 
-/** Merge-sorts results from 0 or more FileIterators */
+/**
+ * Merge-sorts results from 0 or more FileIterators.
+ *
+ * The inputs are merged with a tree of losers: every internal node of a complete binary tree over
+ * the inputs remembers the input that lost the match played there, and the overall winner is
+ * kept in _tree[0]. Advancing the winner only replays the matches on the path from its leaf to
+ * the root, which takes Log(N) comparisons rather than the up to 2 * Log(N) of a binary heap.
+ */
 template <typename Key, typename Value, typename Comparator>
 class MergeIterator : public SortIteratorInterface<Key, Value> {
 public:
@@ -286,32 +440,31 @@ public:
         : _opts(opts),
           _remaining(opts.limit ? opts.limit : std::numeric_limits<unsigned long long>::max()),
           _first(true),
-          _greater(comp) {
+          _comp(comp) {
         for (size_t i = 0; i < iters.size(); i++) {
             if (iters[i]->more()) {
-                _heap.push_back(std::make_shared<Stream>(i, iters[i]->next(), iters[i]));
+                _streams.push_back(std::make_shared<Stream>(i, iters[i]->next(), iters[i]));
             }
         }
 
-        if (_heap.empty()) {
+        if (_streams.empty()) {
             _remaining = 0;
             return;
         }
 
-        std::make_heap(_heap.begin(), _heap.end(), _greater);
-        std::pop_heap(_heap.begin(), _heap.end(), _greater);
-        _current = _heap.back();
-        _heap.pop_back();
+        _liveStreams = _streams.size();
+        _tree.resize(_streams.size());
+        _tree[0] = _buildTree(1);
     }
 
     bool more() {
-        if (_remaining > 0 && (_first || !_heap.empty() || _current->more()))
+        if (_remaining > 0 && (_first || _liveStreams > 1 || _streams[_tree[0]]->more()))
             return true;
 
         // We are done so clean up resources.
         // Can't do this in next() due to lifetime guarantees of unowned Data.
-        _heap.clear();
-        _current.reset();
+        _streams.clear();
+        _tree.clear();
         _remaining = 0;
 
         return false;
@@ -324,22 +477,24 @@ public:
 
         if (_first) {
             _first = false;
-            return _current->current();
+            return _streams[_tree[0]]->current();
         }
 
-        if (!_current->advance()) {
-            verify(!_heap.empty());
+        size_t winner = _tree[0];
+        if (!_streams[winner]->advance()) {
+            verify(_liveStreams > 1);
+            _streams[winner]->exhausted = true;
+            _liveStreams--;
+        }
 
-            std::pop_heap(_heap.begin(), _heap.end(), _greater);
-            _current = _heap.back();
-            _heap.pop_back();
-        } else if (!_heap.empty() && _greater(_current, _heap.front())) {
-            std::pop_heap(_heap.begin(), _heap.end(), _greater);
-            std::swap(_current, _heap.back());
-            std::push_heap(_heap.begin(), _heap.end(), _greater);
+        // Replay the matches on the path from the previous winner's leaf to the root.
+        for (size_t node = (winner + _streams.size()) / 2; node > 0; node /= 2) {
+            if (_beats(_tree[node], winner))
+                std::swap(_tree[node], winner);
         }
+        _tree[0] = winner;
 
-        return _current->current();
+        return _streams[winner]->current();
     }
 
 
@@ -364,38 +519,79 @@ private:
         }
 
         const size_t fileNum;
+        bool exhausted = false;  // Loses to every stream that isn't.
 
     private:
         Data _current;
         std::shared_ptr<Input> _rest;
     };
 
-    class STLComparator {  // uses greater rather than less-than to maintain a MinHeap
-    public:
-        explicit STLComparator(const Comparator& comp) : _comp(comp) {}
-        bool operator()(unowned_ptr<const Stream> lhs, unowned_ptr<const Stream> rhs) const {
-            // first compare data
-            dassertCompIsSane(_comp, lhs->current(), rhs->current());
-            int ret = _comp(lhs->current(), rhs->current());
-            if (ret)
-                return ret > 0;
-
-            // then compare fileNums to ensure stability
-            return lhs->fileNum > rhs->fileNum;
-        }
+    /**
+     * Returns true if the stream at 'lhs' must be returned before the one at 'rhs'.
+     */
+    bool _beats(size_t lhs, size_t rhs) const {
+        const Stream& left = *_streams[lhs];
+        const Stream& right = *_streams[rhs];
+        if (left.exhausted || right.exhausted)
+            return !left.exhausted;
+
+        // first compare data
+        dassertCompIsSane(_comp, left.current(), right.current());
+        int ret = _comp(left.current(), right.current());
+        if (ret)
+            return ret < 0;
+
+        // then compare fileNums to ensure stability
+        return left.fileNum < right.fileNum;
+    }
 
-    private:
-        const Comparator _comp;
-    };
+    /**
+     * Plays every match in the subtree rooted at 'node', recording the losers in _tree, and
+     * returns the winner. Leaves are numbered from _streams.size() to 2 * _streams.size() - 1.
+     */
+    size_t _buildTree(size_t node) {
+        if (node >= _streams.size())
+            return node - _streams.size();
+
+        size_t left = _buildTree(2 * node);
+        size_t right = _buildTree(2 * node + 1);
+        if (_beats(right, left))
+            std::swap(left, right);
+        _tree[node] = right;
+        return left;
+    }
 
     SortOptions _opts;
     unsigned long long _remaining;
     bool _first;
-    std::shared_ptr<Stream> _current;
-    std::vector<std::shared_ptr<Stream>> _heap;  // MinHeap
-    STLComparator _greater;                      // named so calls make sense
+    size_t _liveStreams = 0;
+    std::vector<std::shared_ptr<Stream>> _streams;
+    std::vector<size_t> _tree;  // Indexes into _streams. _tree[0] is the current winner.
+    const Comparator _comp;
 };
 
+/**
+ * Spreads the merge's read buffer budget of 'opts.maxMemoryUsageBytes' across the spill files in
+ * 'iters', all of which must come from SortedFileWriter::done().
+ */
+template <typename Key, typename Value>
+void setReadAheadForSpills(
+    const std::vector<std::shared_ptr<SortIteratorInterface<Key, Value>>>& iters,
+    const SortOptions& opts) {
+    // Smaller buffers than this do not save any reads, as blocks are written 64KB at a time.
+    const size_t kMinReadAheadBytes = 64 * 1024;
+    if (iters.empty())
+        return;
+
+    const size_t bytes = std::min(opts.maxReadAheadBytes, opts.maxMemoryUsageBytes / iters.size());
+    if (bytes < kMinReadAheadBytes)
+        return;
+
+    for (auto&& iter : iters) {
+        checked_cast<FileIterator<Key, Value>*>(iter.get())->setReadAhead(bytes);
+    }
+}
+
 template <typename Key, typename Value, typename Comparator>
 class NoLimitSorter : public Sorter<Key, Value> {
 public:
@@ -429,6 +625,7 @@ public:
         }
 
         spill();
+        setReadAheadForSpills(_iters, _opts);
         return Iterator::merge(_iters, _opts, _comp);
     }
 
@@ -455,7 +652,7 @@ private:
 
     void sort() {
         STLComparator less(_comp);
-        std::stable_sort(_data.begin(), _data.end(), less);
+        parallelStableSort(_data, less, _opts.sortThreads);
 
         // Does 2x more compares than stable_sort
         // TODO test on windows
@@ -629,6 +826,7 @@ public:
         }
 
         spill();
+        setReadAheadForSpills(_iters, _opts);
         return Iterator::merge(_iters, _opts, _comp);
     }
 
@@ -659,7 +857,7 @@ private:
         if (_data.size() == _opts.limit) {
             std::sort_heap(_data.begin(), _data.end(), less);
         } else {
-            std::stable_sort(_data.begin(), _data.end(), less);
+            parallelStableSort(_data, less, _opts.sortThreads);
         }
     }
 
@@ -808,7 +1006,7 @@ inline unsigned nextFileNumber() {
 
 template <typename Key, typename Value>
 SortedFileWriter<Key, Value>::SortedFileWriter(const SortOptions& opts, const Settings& settings)
-    : _settings(settings) {
+    : _settings(settings), _spillStats(opts.spillStats) {
     namespace str = mongoutils::str;
 
     // This should be checked by consumers, but if we get here don't allow writes.
@@ -858,6 +1056,7 @@ void SortedFileWriter<Key, Value>::spill() {
     if (size == 0)
         return;
 
+    Timer timer;
     std::string compressed;
     snappy::Compress(outBuffer, size, &compressed);
     verify(compressed.size() <= size_t(std::numeric_limits<int32_t>::max()));
@@ -886,11 +1085,18 @@ void SortedFileWriter<Key, Value>::spill() {
         size = resultLen;
     }
 
+    // Checksums cover the block as written, so that corruption is caught before decrypting or
+    // decompressing it.
+    Checksum checksum;
+    checksum.gen(outBuffer, size);
+
     // negative size means compressed
+    const int32_t writtenSize = size;
     size = shouldCompress ? -size : size;
     try {
         _file.write(reinterpret_cast<const char*>(&size), sizeof(size));
-        _file.write(outBuffer, std::abs(size));
+        _file.write(reinterpret_cast<const char*>(checksum.bytes), sizeof(checksum.bytes));
+        _file.write(outBuffer, writtenSize);
 
     } catch (const std::exception&) {
         msgasserted(16821,
@@ -899,6 +1105,16 @@ void SortedFileWriter<Key, Value>::spill() {
     }
 
     _buffer.reset();
+
+    const uint64_t bytes = sizeof(size) + sizeof(checksum.bytes) + writtenSize;
+    const uint64_t micros = timer.micros();
+    for (SorterSpillStats* stats : {&SorterSpillStats::global(), _spillStats}) {
+        if (!stats)
+            continue;
+        stats->spilledBytes.increment(bytes);
+        stats->spilledBlocks.increment();
+        stats->spillMicros.increment(micros);
+    }
 }
 
 template <typename Key, typename Value>
@@ -35,6 +35,7 @@
 #include <utility>
 #include <vector>
 
+#include "mongo/base/counter.h"
 #include "mongo/base/disallow_copying.h"
 #include "mongo/bson/util/builder.h"
 
@@ -89,6 +90,20 @@ namespace sorter {
 class FileDeleter;
 }
 
+/**
+ * Counters for the data that external sorts spill to disk.
+ */
+struct SorterSpillStats {
+    Counter64 spilledBytes;   // As written to disk, after compression.
+    Counter64 spilledBlocks;  // Each block is compressed and checksummed on its own.
+    Counter64 spillMicros;    // Time spent compressing, protecting and writing blocks.
+
+    /**
+     * The totals for every sort in this process, reported by serverStatus under metrics.sorter.
+     */
+    static SorterSpillStats& global();
+};
+
 /**
  * Runtime options that control the Sorter's behavior
  */
@@ -98,8 +113,17 @@ struct SortOptions {
     bool extSortAllowed;         /// If false, uassert if more mem needed than allowed.
     std::string tempDir;         /// Directory to directly place files in.
                                  /// Must be explicitly set if extSortAllowed is true.
-
-    SortOptions() : limit(0), maxMemoryUsageBytes(64 * 1024 * 1024), extSortAllowed(false) {}
+    size_t sortThreads;          /// Max threads used to sort a batch of in-memory data.
+    size_t maxReadAheadBytes;    /// Per spill file read buffer cap when merging. 0 to disable.
+    SorterSpillStats* spillStats;  /// If set, also counts this sort's spills. Must outlive it.
+
+    SortOptions()
+        : limit(0),
+          maxMemoryUsageBytes(64 * 1024 * 1024),
+          extSortAllowed(false),
+          sortThreads(1),
+          maxReadAheadBytes(1024 * 1024),
+          spillStats(nullptr) {}
 
     /// Fluent API to support expressions like SortOptions().Limit(1000).ExtSortAllowed(true)
 
@@ -122,6 +146,21 @@ struct SortOptions {
         tempDir = newTempDir;
         return *this;
     }
+
+    SortOptions& SortThreads(size_t newSortThreads) {
+        sortThreads = newSortThreads;
+        return *this;
+    }
+
+    SortOptions& MaxReadAheadBytes(size_t newMaxReadAheadBytes) {
+        maxReadAheadBytes = newMaxReadAheadBytes;
+        return *this;
+    }
+
+    SortOptions& SpillStats(SorterSpillStats* newSpillStats) {
+        spillStats = newSpillStats;
+        return *this;
+    }
 };
 
 /// This is the output from the sorting framework
@@ -204,6 +243,7 @@ private:
     void spill();
 
     const Settings _settings;
+    SorterSpillStats* const _spillStats;
     std::string _fileName;
     std::shared_ptr<sorter::FileDeleter> _fileDeleter;  // Must outlive _file
     std::ofstream _file;
@@ -0,0 +1,112 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/sorter/sorter.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/db/record_id.h"
+#include "mongo/platform/random.h"
+#include "mongo/unittest/temp_dir.h"
+
+// Need access to internal classes
+#include "mongo/db/sorter/sorter.cpp"
+
+namespace mongo {
+namespace {
+
+using BSONObjSorter = Sorter<BSONObj, RecordId>;
+
+// Orders index-key-like documents the way an index build's external sort does.
+class KeyComparator {
+public:
+    int operator()(const BSONObjSorter::Data& lhs, const BSONObjSorter::Data& rhs) const {
+        const int cmp = SimpleBSONObjComparator::kInstance.compare(lhs.first, rhs.first);
+        if (cmp != 0)
+            return cmp;
+        return lhs.second.compare(rhs.second);
+    }
+};
+
+std::vector<BSONObj> makeKeys(int numKeys) {
+    PseudoRandom random(1);
+    std::vector<BSONObj> keys;
+    keys.reserve(numKeys);
+    for (int i = 0; i < numKeys; ++i) {
+        keys.push_back(BSON("" << random.nextInt32() << "" << i));
+    }
+    return keys;
+}
+
+// Adds every key to a sorter built with 'opts' and drains the sorted output.
+void runSort(benchmark::State& state, const SortOptions& opts) {
+    const auto keys = makeKeys(state.range(0));
+    for (auto keepRunning : state) {
+        std::unique_ptr<BSONObjSorter> sorter(BSONObjSorter::make(opts, KeyComparator()));
+        for (size_t i = 0; i < keys.size(); ++i) {
+            sorter->add(keys[i], RecordId(i + 1));
+        }
+        std::unique_ptr<BSONObjSorter::Iterator> it(sorter->done());
+        while (it->more()) {
+            benchmark::DoNotOptimize(it->next());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+void BM_SortInMemory(benchmark::State& state) {
+    runSort(state, SortOptions());
+}
+
+void BM_SortTopK(benchmark::State& state) {
+    runSort(state, SortOptions().Limit(10));
+}
+
+void BM_SortLimitOne(benchmark::State& state) {
+    runSort(state, SortOptions().Limit(1));
+}
+
+// Spills to disk every 1MB, so large inputs exercise the file writer and the k-way merge.
+void BM_SortExternal(benchmark::State& state) {
+    unittest::TempDir tempDir("sorter_bm");
+    runSort(
+        state,
+        SortOptions().TempDir(tempDir.path()).MaxMemoryUsageBytes(1024 * 1024).ExtSortAllowed());
+}
+
+BENCHMARK(BM_SortInMemory)->Arg(1000)->Arg(100000);
+BENCHMARK(BM_SortTopK)->Arg(1000)->Arg(100000);
+BENCHMARK(BM_SortLimitOne)->Arg(100000);
+BENCHMARK(BM_SortExternal)->Arg(100000)->Arg(1000000);
+
+}  // namespace
+}  // namespace mongo
@@ -263,6 +263,36 @@ public:
             ASSERT_ITERATORS_EQUIVALENT(std::shared_ptr<IWIterator>(sorter.done()),
                                         make_shared<IntIterator>(0, 10 * 1000 * 1000));
         }
+        {  // spills are counted
+            SorterSpillStats spillStats;
+            SortedFileWriter<IntWrapper, IntWrapper> sorter(
+                SortOptions(opts).SpillStats(&spillStats));
+            for (int i = 0; i < 100 * 1000; i++)
+                sorter.addAlreadySorted(i, -i);
+            std::shared_ptr<IWIterator> iter(sorter.done());
+
+            ASSERT_GREATER_THAN(spillStats.spilledBlocks.get(), 1);
+            ASSERT_EQUALS(static_cast<uintmax_t>(spillStats.spilledBytes.get()),
+                          boost::filesystem::file_size(
+                              boost::filesystem::directory_iterator(tempDir.path())->path()));
+        }
+        {  // corrupt blocks are detected
+            SortedFileWriter<IntWrapper, IntWrapper> sorter(opts);
+            for (int i = 0; i < 1000; i++)
+                sorter.addAlreadySorted(i, -i);
+            std::shared_ptr<IWIterator> iter(sorter.done());
+
+            // Flip a byte of the first block's data, which follows its size and checksum.
+            const auto fileName = boost::filesystem::directory_iterator(tempDir.path())->path();
+            std::fstream file(fileName.string(), std::ios::in | std::ios::out | std::ios::binary);
+            file.seekg(24);
+            char byte = file.get();
+            file.seekp(24);
+            file.put(~byte);
+            file.close();
+
+            ASSERT_THROWS_CODE(iter->more(), AssertionException, 51210);
+        }
 
         ASSERT(boost::filesystem::is_empty(tempDir.path()));
     }
@@ -322,6 +352,39 @@ public:
                 mergeIterators(iterators, ASC, SortOptions().Limit(10)),
                 make_shared<LimitIterator>(10, make_shared<IntIterator>(0, 20, 1)));
         }
+        {  // test a number of sources that is not a power of two
+            std::shared_ptr<IWIterator> iterators[] = {make_shared<IntIterator>(0, 70, 7),
+                                                       make_shared<IntIterator>(1, 70, 7),
+                                                       make_shared<EmptyIterator>(),
+                                                       make_shared<IntIterator>(2, 70, 7),
+                                                       make_shared<IntIterator>(3, 70, 7),
+                                                       make_shared<IntIterator>(4, 70, 7),
+                                                       make_shared<IntIterator>(5, 70, 7),
+                                                       make_shared<IntIterator>(6, 70, 7)};
+
+            ASSERT_ITERATORS_EQUIVALENT(mergeIterators(iterators, ASC),
+                                        make_shared<IntIterator>(0, 70, 1));
+        }
+        {  // test that equal keys are returned in the order of their sources
+            typedef sorter::InMemIterator<IntWrapper, IntWrapper> IWInMemIterator;
+            std::vector<std::shared_ptr<IWIterator>> vec;
+            std::vector<IWPair> expected;
+            for (int i = 0; i < 5; i++) {
+                std::vector<IWPair> input;
+                input.push_back(IWPair(0, i));
+                input.push_back(IWPair(1, i));
+                vec.push_back(make_shared<IWInMemIterator>(input));
+            }
+            for (int key = 0; key < 2; key++) {
+                for (int i = 0; i < 5; i++) {
+                    expected.push_back(IWPair(key, i));
+                }
+            }
+
+            std::shared_ptr<IWIterator> mergeIter(
+                IWIterator::merge(vec, SortOptions(), IWComparator()));
+            ASSERT_ITERATORS_EQUIVALENT(mergeIter, make_shared<IWInMemIterator>(expected));
+        }
     }
 };
 
@@ -511,6 +574,20 @@ public:
 };
 
 
+template <bool Random = true>
+class LotsOfDataParallelSort : public LotsOfDataLittleMemory<Random> {
+    typedef LotsOfDataLittleMemory<Random> Parent;
+    SortOptions adjustSortOptions(SortOptions opts) {
+        // Make sure each batch is split across all of the threads, and that we still spill a few
+        // files so that the merge goes through the read-ahead buffers.
+        MONGO_STATIC_ASSERT(MEM_LIMIT / sizeof(IWPair) >= 4 * 16 * 1024);
+        MONGO_STATIC_ASSERT((Parent::NUM_ITEMS * sizeof(IWPair)) / MEM_LIMIT > 2);
+
+        return opts.MaxMemoryUsageBytes(MEM_LIMIT).ExtSortAllowed().SortThreads(4);
+    }
+    enum { MEM_LIMIT = 1024 * 1024 };
+};
+
 template <long long Limit, bool Random = true>
 class LotsOfDataWithLimit : public LotsOfDataLittleMemory<Random> {
     typedef LotsOfDataLittleMemory<Random> Parent;
@@ -549,6 +626,8 @@ public:
         add<SorterTests::Dupes>();
         add<SorterTests::LotsOfDataLittleMemory</*random=*/false>>();
         add<SorterTests::LotsOfDataLittleMemory</*random=*/true>>();
+        add<SorterTests::LotsOfDataParallelSort</*random=*/false>>();
+        add<SorterTests::LotsOfDataParallelSort</*random=*/true>>();
         add<SorterTests::LotsOfDataWithLimit<1, /*random=*/false>>();     // limit=1 is special case
         add<SorterTests::LotsOfDataWithLimit<1, /*random=*/true>>();      // limit=1 is special case
         add<SorterTests::LotsOfDataWithLimit<100, /*random=*/false>>();   // fits in mem
@@ -0,0 +1,155 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/hdr_latency_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/platform/bits.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+namespace {
+
+constexpr uint64_t kMaxLatency = (1ULL << HdrLatencyHistogram::kMaxLatencyBits) - 1;
+
+}  // namespace
+
+HdrLatencyHistogram::HdrLatencyHistogram(int significantBits)
+    : _significantBits(significantBits),
+      _subBucketCount(size_t(1) << significantBits),
+      // Values below 2 * _subBucketCount are recorded exactly, and every further power of two up
+      // to kMaxLatencyBits adds _subBucketCount buckets.
+      _numBuckets((kMaxLatencyBits - significantBits + 1) * _subBucketCount),
+      _buckets(new AtomicUInt64[_numBuckets]) {
+    invariant(significantBits >= 1 && significantBits <= kMaxSignificantBits);
+}
+
+size_t HdrLatencyHistogram::bucketFor(uint64_t latency) const {
+    latency = std::min(latency, kMaxLatency);
+    if (latency < _subBucketCount) {
+        return latency;
+    }
+
+    // The top '_significantBits + 1' bits of the value select the bucket: the position of the
+    // highest set bit picks the power of two and the bits below it pick the sub-bucket.
+    const int shift = (63 - countLeadingZeros64(latency)) - _significantBits;
+    return (shift + 1) * _subBucketCount + ((latency >> shift) - _subBucketCount);
+}
+
+uint64_t HdrLatencyHistogram::lowerBound(size_t bucket) const {
+    if (bucket < _subBucketCount) {
+        return bucket;
+    }
+    const int shift = bucket / _subBucketCount - 1;
+    return static_cast<uint64_t>(_subBucketCount + bucket % _subBucketCount) << shift;
+}
+
+uint64_t HdrLatencyHistogram::upperBound(size_t bucket) const {
+    return bucket + 1 == _numBuckets ? kMaxLatency : lowerBound(bucket + 1) - 1;
+}
+
+void HdrLatencyHistogram::increment(uint64_t latency) {
+    _buckets[bucketFor(latency)].fetchAndAdd(1);
+    _sum.fetchAndAdd(latency);
+}
+
+void HdrLatencyHistogram::merge(const HdrLatencyHistogram& other) {
+    invariant(_significantBits == other._significantBits);
+    for (size_t i = 0; i < _numBuckets; ++i) {
+        const uint64_t count = other._buckets[i].loadRelaxed();
+        if (count != 0) {
+            _buckets[i].fetchAndAdd(count);
+        }
+    }
+    _sum.fetchAndAdd(other._sum.loadRelaxed());
+}
+
+uint64_t HdrLatencyHistogram::getCount() const {
+    uint64_t count = 0;
+    for (size_t i = 0; i < _numBuckets; ++i) {
+        count += _buckets[i].loadRelaxed();
+    }
+    return count;
+}
+
+uint64_t HdrLatencyHistogram::getPercentile(double percentile) const {
+    invariant(percentile > 0 && percentile <= 100);
+
+    // Take one snapshot of the counts so the rank and the walk agree with each other.
+    std::unique_ptr<uint64_t[]> counts(new uint64_t[_numBuckets]);
+    uint64_t total = 0;
+    for (size_t i = 0; i < _numBuckets; ++i) {
+        counts[i] = _buckets[i].loadRelaxed();
+        total += counts[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    const uint64_t rank =
+        std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(percentile / 100 * total)));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < _numBuckets; ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            return upperBound(i);
+        }
+    }
+    return kMaxLatency;
+}
+
+void HdrLatencyHistogram::append(bool includeHistogram, BSONObjBuilder* builder) const {
+    builder->append("ops", static_cast<long long>(getCount()));
+    builder->append("latency", static_cast<long long>(getSum()));
+    builder->append("p50", static_cast<long long>(getPercentile(50)));
+    builder->append("p90", static_cast<long long>(getPercentile(90)));
+    builder->append("p99", static_cast<long long>(getPercentile(99)));
+    builder->append("p999", static_cast<long long>(getPercentile(99.9)));
+
+    if (includeHistogram) {
+        BSONArrayBuilder arrayBuilder(builder->subarrayStart("histogram"));
+        for (size_t i = 0; i < _numBuckets; ++i) {
+            const uint64_t count = _buckets[i].loadRelaxed();
+            if (count == 0)
+                continue;
+            BSONObjBuilder entryBuilder(arrayBuilder.subobjStart());
+            entryBuilder.append("micros", static_cast<long long>(lowerBound(i)));
+            entryBuilder.append("count", static_cast<long long>(count));
+            entryBuilder.doneFast();
+        }
+        arrayBuilder.doneFast();
+    }
+}
+
+}  // namespace mongo
@@ -0,0 +1,115 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/platform/atomic_word.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+
+/**
+ * A latency histogram with log-linear buckets, in the style of an HDR histogram: every power of
+ * two is split into 2^significantBits equally sized sub-buckets, so any recorded value lands in
+ * a bucket no wider than 1/2^significantBits of the value itself. With the default of 3 bits a
+ * 1.1ms latency and a 1.9ms latency fall in different buckets.
+ *
+ * Values are in microseconds and are clamped to 2^kMaxLatencyBits - 1 (about 12.7 days).
+ *
+ * Recording is lock-free and safe to call concurrently with other recorders and readers. Readers
+ * see a consistent-enough snapshot: counts are read individually, so a concurrent increment may
+ * or may not be reflected.
+ */
+class HdrLatencyHistogram {
+    MONGO_DISALLOW_COPYING(HdrLatencyHistogram);
+
+public:
+    static constexpr int kDefaultSignificantBits = 3;
+    static constexpr int kMaxSignificantBits = 7;
+    static constexpr int kMaxLatencyBits = 40;
+
+    explicit HdrLatencyHistogram(int significantBits = kDefaultSignificantBits);
+
+    /**
+     * Records one operation that took 'latency' microseconds.
+     */
+    void increment(uint64_t latency);
+
+    /**
+     * Adds everything recorded in 'other', which must use the same precision, into this
+     * histogram.
+     */
+    void merge(const HdrLatencyHistogram& other);
+
+    /**
+     * Returns the number of recorded operations and the sum of their latencies.
+     */
+    uint64_t getCount() const;
+    uint64_t getSum() const {
+        return _sum.loadRelaxed();
+    }
+
+    /**
+     * Returns the highest latency equivalent to the value at the given percentile, which must be
+     * in (0, 100]. Returns 0 if nothing has been recorded.
+     */
+    uint64_t getPercentile(double percentile) const;
+
+    /**
+     * Appends "ops", "latency" and fixed p50/p90/p99/p999 fields, so that the shape of the
+     * output does not depend on what was recorded. If 'includeHistogram' is set, also appends the
+     * non-empty buckets as a "histogram" array of {micros: <lower bound>, count: <count>}.
+     */
+    void append(bool includeHistogram, BSONObjBuilder* builder) const;
+
+    size_t getNumBuckets() const {
+        return _numBuckets;
+    }
+
+    /**
+     * Returns the index of the bucket that 'latency' is recorded in, and the inclusive lower and
+     * upper bounds of a bucket.
+     */
+    size_t bucketFor(uint64_t latency) const;
+    uint64_t lowerBound(size_t bucket) const;
+    uint64_t upperBound(size_t bucket) const;
+
+private:
+    const int _significantBits;
+    const size_t _subBucketCount;
+    const size_t _numBuckets;
+    const std::unique_ptr<AtomicUInt64[]> _buckets;
+    AtomicUInt64 _sum;
+};
+
+}  // namespace mongo
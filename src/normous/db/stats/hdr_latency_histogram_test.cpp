@@ -0,0 +1,126 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/hdr_latency_histogram.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(HdrLatencyHistogram, BucketsAreContiguousAndBoundTheirValues) {
+    for (int bits = 1; bits <= HdrLatencyHistogram::kMaxSignificantBits; ++bits) {
+        HdrLatencyHistogram hist(bits);
+        ASSERT_EQ(0U, hist.lowerBound(0));
+        for (size_t i = 0; i < hist.getNumBuckets(); ++i) {
+            ASSERT_LTE(hist.lowerBound(i), hist.upperBound(i));
+            ASSERT_EQ(i, hist.bucketFor(hist.lowerBound(i)));
+            ASSERT_EQ(i, hist.bucketFor(hist.upperBound(i)));
+            if (i + 1 < hist.getNumBuckets()) {
+                ASSERT_EQ(hist.upperBound(i) + 1, hist.lowerBound(i + 1));
+            }
+        }
+        ASSERT_EQ(hist.getNumBuckets() - 1, hist.bucketFor(~0ULL));
+    }
+}
+
+TEST(HdrLatencyHistogram, RelativeBucketWidthIsBoundedByPrecision) {
+    HdrLatencyHistogram hist(3);
+    for (size_t i = 0; i < hist.getNumBuckets(); ++i) {
+        const uint64_t width = hist.upperBound(i) - hist.lowerBound(i) + 1;
+        ASSERT_LTE(width * 8, std::max<uint64_t>(hist.lowerBound(i), 8));
+    }
+
+    // 1.1ms and 1.9ms must be distinguishable.
+    ASSERT_NE(hist.bucketFor(1100), hist.bucketFor(1900));
+}
+
+TEST(HdrLatencyHistogram, PercentilesAndTotals) {
+    HdrLatencyHistogram hist;
+    ASSERT_EQ(0U, hist.getPercentile(99));
+
+    uint64_t sum = 0;
+    for (uint64_t i = 1; i <= 1000; ++i) {
+        hist.increment(i * 10);
+        sum += i * 10;
+    }
+    ASSERT_EQ(1000U, hist.getCount());
+    ASSERT_EQ(sum, hist.getSum());
+
+    // Percentiles report the upper bound of the bucket holding the ranked value.
+    const uint64_t p50 = hist.getPercentile(50);
+    ASSERT_EQ(hist.upperBound(hist.bucketFor(5000)), p50);
+    ASSERT_EQ(hist.upperBound(hist.bucketFor(9900)), hist.getPercentile(99));
+    ASSERT_EQ(hist.upperBound(hist.bucketFor(10000)), hist.getPercentile(100));
+
+    BSONObjBuilder builder;
+    hist.append(true, &builder);
+    BSONObj out = builder.obj();
+    ASSERT_EQ(1000, out["ops"].Long());
+    ASSERT_EQ(static_cast<long long>(sum), out["latency"].Long());
+    ASSERT_EQ(static_cast<long long>(p50), out["p50"].Long());
+    ASSERT(out["p90"].isNumber());
+    ASSERT(out["p99"].isNumber());
+    ASSERT(out["p999"].isNumber());
+
+    long long histogramCount = 0;
+    for (auto&& entry : out["histogram"].Obj()) {
+        histogramCount += entry["count"].Long();
+    }
+    ASSERT_EQ(1000, histogramCount);
+
+    BSONObjBuilder noHistogramBuilder;
+    hist.append(false, &noHistogramBuilder);
+    ASSERT(noHistogramBuilder.obj()["histogram"].eoo());
+}
+
+TEST(HdrLatencyHistogram, MergeAddsCountsAndSums) {
+    HdrLatencyHistogram fast;
+    HdrLatencyHistogram slow;
+    for (uint64_t i = 0; i < 99; ++i) {
+        fast.increment(100);
+    }
+    slow.increment(50000);
+
+    HdrLatencyHistogram merged;
+    merged.merge(fast);
+    merged.merge(slow);
+    ASSERT_EQ(100U, merged.getCount());
+    ASSERT_EQ(fast.getSum() + slow.getSum(), merged.getSum());
+    ASSERT_EQ(merged.upperBound(merged.bucketFor(100)), merged.getPercentile(99));
+    ASSERT_EQ(merged.upperBound(merged.bucketFor(50000)), merged.getPercentile(100));
+
+    // Merging leaves the source untouched.
+    ASSERT_EQ(99U, fast.getCount());
+}
+
+}  // namespace
+}  // namespace mongo
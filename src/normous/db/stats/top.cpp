@@ -33,8 +33,11 @@
 
 #include "mongo/db/stats/top.h"
 
+#include <algorithm>
+
 #include "mongo/db/jsobj.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/storage/storage_operation_stats.h"
 #include "mongo/util/log.h"
 
 namespace mongo {
@@ -65,7 +68,9 @@ Top::CollectionData::CollectionData(const CollectionData& older, const Collectio
       insert(older.insert, newer.insert),
       update(older.update, newer.update),
       remove(older.remove, newer.remove),
-      commands(older.commands, newer.commands) {}
+      commands(older.commands, newer.commands),
+      storageBytesRead(std::max(newer.storageBytesRead - older.storageBytesRead, 0LL)),
+      storageBytesWritten(std::max(newer.storageBytesWritten - older.storageBytesWritten, 0LL)) {}
 
 // static
 Top& Top::get(ServiceContext* service) {
@@ -83,15 +88,15 @@ void Top::record(OperationContext* opCtx,
         return;
 
     auto hashedNs = UsageMap::HashedKey(ns);
-    stdx::lock_guard<SimpleMutex> lk(_lock);
+    auto& partition = _getPartition(hashedNs);
+    stdx::lock_guard<SimpleMutex> lk(partition.lock);
 
-    if ((command || logicalOp == LogicalOp::opQuery) &&
-        _collDropNs.find(ns.toString()) != _collDropNs.end()) {
-        _collDropNs.erase(ns.toString());
+    if ((command || logicalOp == LogicalOp::opQuery) && !partition.collDropNs.empty() &&
+        partition.collDropNs.erase(ns.toString())) {
         return;
     }
 
-    CollectionData& coll = _usage[hashedNs];
+    CollectionData& coll = partition.usage[hashedNs];
     _record(opCtx, coll, logicalOp, lockType, micros, readWriteType);
 }
 
@@ -106,6 +111,12 @@ void Top::_record(OperationContext* opCtx,
 
     c.total.inc(micros);
 
+    // An operation may be recorded more than once, so only attribute what is new since the last
+    // time it was recorded.
+    auto storageStats = StorageOperationStats::get(opCtx).takeUnrecorded();
+    c.storageBytesRead += storageStats.bytesRead;
+    c.storageBytesWritten += storageStats.bytesWritten;
+
     if (lockType == LockType::WriteLocked)
         c.writeLock.inc(micros);
     else if (lockType == LockType::ReadLocked)
@@ -141,24 +152,32 @@ void Top::_record(OperationContext* opCtx,
 }
 
 void Top::collectionDropped(StringData ns, bool databaseDropped) {
-    stdx::lock_guard<SimpleMutex> lk(_lock);
-    _usage.erase(ns);
+    auto hashedNs = UsageMap::HashedKey(ns);
+    auto& partition = _getPartition(hashedNs);
+    stdx::lock_guard<SimpleMutex> lk(partition.lock);
+    partition.usage.erase(hashedNs);
 
     if (!databaseDropped) {
         // If a collection drop occurred, there will be a subsequent call to record for this
         // collection namespace which must be ignored. This does not apply to a database drop.
-        _collDropNs.insert(ns.toString());
+        partition.collDropNs.insert(ns.toString());
     }
 }
 
 void Top::cloneMap(Top::UsageMap& out) const {
-    stdx::lock_guard<SimpleMutex> lk(_lock);
-    out = _usage;
+    out.clear();
+    for (auto& partition : _usagePartitions) {
+        stdx::lock_guard<SimpleMutex> lk(partition.lock);
+        for (auto&& entry : partition.usage) {
+            out.try_emplace(entry.first, entry.second);
+        }
+    }
 }
 
 void Top::append(BSONObjBuilder& b) {
-    stdx::lock_guard<SimpleMutex> lk(_lock);
-    _appendToUsageMap(b, _usage);
+    UsageMap usage;
+    cloneMap(usage);
+    _appendToUsageMap(b, usage);
 }
 
 void Top::_appendToUsageMap(BSONObjBuilder& b, const UsageMap& map) const {
@@ -188,6 +207,12 @@ void Top::_appendToUsageMap(BSONObjBuilder& b, const UsageMap& map) const {
         _appendStatsEntry(b, "remove", coll.remove);
         _appendStatsEntry(b, "commands", coll.commands);
 
+        {
+            BSONObjBuilder storage(bb.subobjStart("storage"));
+            storage.appendNumber("bytesRead", coll.storageBytesRead);
+            storage.appendNumber("bytesWritten", coll.storageBytesWritten);
+        }
+
         bb.done();
     }
 }
@@ -201,9 +226,10 @@ void Top::_appendStatsEntry(BSONObjBuilder& b, const char* statsName, const Usag
 
 void Top::appendLatencyStats(StringData ns, bool includeHistograms, BSONObjBuilder* builder) {
     auto hashedNs = UsageMap::HashedKey(ns);
-    stdx::lock_guard<SimpleMutex> lk(_lock);
+    auto& partition = _getPartition(hashedNs);
+    stdx::lock_guard<SimpleMutex> lk(partition.lock);
     BSONObjBuilder latencyStatsBuilder;
-    _usage[hashedNs].opLatencyHistogram.append(includeHistograms, &latencyStatsBuilder);
+    partition.usage[hashedNs].opLatencyHistogram.append(includeHistograms, &latencyStatsBuilder);
     builder->append("ns", ns);
     builder->append("latencyStats", latencyStatsBuilder.obj());
 }
@@ -211,17 +237,17 @@ void Top::appendLatencyStats(StringData ns, bool includeHistograms, BSONObjBuild
 void Top::incrementGlobalLatencyStats(OperationContext* opCtx,
                                       uint64_t latency,
                                       Command::ReadWriteType readWriteType) {
-    stdx::lock_guard<SimpleMutex> guard(_lock);
+    stdx::lock_guard<SimpleMutex> guard(_globalHistogramLock);
     _incrementHistogram(opCtx, latency, &_globalHistogramStats, readWriteType);
 }
 
 void Top::appendGlobalLatencyStats(bool includeHistograms, BSONObjBuilder* builder) {
-    stdx::lock_guard<SimpleMutex> guard(_lock);
+    stdx::lock_guard<SimpleMutex> guard(_globalHistogramLock);
     _globalHistogramStats.append(includeHistograms, builder);
 }
 
 void Top::incrementGlobalTransactionLatencyStats(uint64_t latency) {
-    stdx::lock_guard<SimpleMutex> guard(_lock);
+    stdx::lock_guard<SimpleMutex> guard(_globalHistogramLock);
     _globalHistogramStats.increment(latency, Command::ReadWriteType::kTransaction);
 }
 
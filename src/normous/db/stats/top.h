@@ -29,11 +29,13 @@
 
 #pragma once
 
+#include <boost/align/aligned_allocator.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 
 #include "mongo/db/commands.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/stats/operation_latency_histogram.h"
+#include "mongo/stdx/new.h"
 #include "mongo/util/concurrency/mutex.h"
 #include "mongo/util/string_map.h"
 
@@ -43,12 +45,16 @@ class ServiceContext;
 
 /**
  * tracks usage by collection
+ *
+ * Per-collection usage is split across a fixed number of partitions chosen by namespace hash, each
+ * with its own mutex, so that operations completing on different collections do not serialize on
+ * a single lock. Readers merge the partitions.
  */
 class Top {
 public:
     static Top& get(ServiceContext* service);
 
-    Top() = default;
+    Top() : _usagePartitions(kNumUsagePartitions) {}
 
     struct UsageData {
         UsageData() : time(0), count(0) {}
@@ -81,6 +87,11 @@ public:
         UsageData remove;
         UsageData commands;
         OperationLatencyHistogram opLatencyHistogram;
+
+        // Storage engine bytes read and written by the operations recorded against this
+        // collection. See StorageOperationStats.
+        long long storageBytesRead = 0;
+        long long storageBytesWritten = 0;
     };
 
     enum class LockType {
@@ -145,10 +156,27 @@ private:
                              OperationLatencyHistogram* histogram,
                              Command::ReadWriteType readWriteType);
 
-    mutable SimpleMutex _lock;
+    struct alignas(stdx::hardware_destructive_interference_size) UsagePartition {
+        SimpleMutex lock;
+        UsageMap usage;
+        std::set<std::string> collDropNs;
+    };
+
+    static constexpr size_t kNumUsagePartitions = 16;
+
+    UsagePartition& _getPartition(const UsageMap::HashedKey& hashedNs) {
+        // UsageMap picks buckets from the low bits of the hash, so partition on the high bits to
+        // keep each partition's table evenly populated.
+        return _usagePartitions[(hashedNs.hash() >> 24) % kNumUsagePartitions];
+    }
+
+    // Top lives in a ServiceContext decoration, whose storage is not over-aligned, so the
+    // partitions are allocated separately.
+    mutable std::vector<UsagePartition, boost::alignment::aligned_allocator<UsagePartition>>
+        _usagePartitions;
+
+    SimpleMutex _globalHistogramLock;
     OperationLatencyHistogram _globalHistogramStats;
-    UsageMap _usage;
-    std::set<std::string> _collDropNs;
 };
 
 }  // namespace mongo
@@ -61,7 +61,12 @@ public:
 
     virtual void fsyncUnlock(OperationContext* opCtx);
 
-    virtual BackupCursorState openBackupCursor(OperationContext* opCtx);
+    /**
+     * Opens a backup cursor. With `options.srcBackupName` set, only files changed since that named
+     * backup are marked as needing to be copied.
+     */
+    virtual BackupCursorState openBackupCursor(OperationContext* opCtx,
+                                               const StorageEngine::BackupOptions& options);
 
     virtual void closeBackupCursor(OperationContext* opCtx, std::uint64_t cursorId);
 };
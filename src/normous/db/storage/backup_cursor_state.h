@@ -33,13 +33,14 @@
 #include <vector>
 
 #include "mongo/db/pipeline/document.h"
+#include "mongo/db/storage/storage_engine.h"
 
 namespace mongo {
 
 struct BackupCursorState {
     std::uint64_t cursorId;
     boost::optional<Document> preamble;
-    std::vector<std::string> filenames;
+    std::vector<StorageEngine::BackupFile> files;
 };
 
 }  // namespace mongo
@@ -47,20 +47,20 @@ void RecoveryUnit::beginUnitOfWork(OperationContext* opCtx) {}
 
 void RecoveryUnit::commitUnitOfWork() {
     if (_dirty && _workingCopy) {
-        while (true) {
-            std::shared_ptr<StringStore> master = _KVEngine->getMaster();
-            try {
-                _workingCopy->merge3(*_mergeBase, *master);
-            } catch (const merge_conflict_exception&) {
-                throw WriteConflictException();
-            }
-            stdx::lock_guard<stdx::mutex> lkOnMaster(_KVEngine->getMasterLock());
-            if (_KVEngine->getMaster_inlock() == master) {
-                _KVEngine->setMaster_inlock(std::move(_workingCopy));
-                _mergeBase.reset();
-                break;
-            }
+        // Do the bulk of the merge against a snapshot of master without holding the master lock,
+        // so that writers committing at the same time merge in parallel.
+        _rebaseOnto(_KVEngine->getMaster());
+
+        stdx::lock_guard<stdx::mutex> lkOnMaster(_KVEngine->getMasterLock());
+        std::shared_ptr<StringStore> master = _KVEngine->getMaster_inlock();
+        if (master != _mergeBase) {
+            // Other writers committed in the meantime. Having rebased, only their changes are left
+            // to merge, and merge3 only descends into the subtrees that both sides modified. Doing
+            // this under the lock bounds every commit to a single retry.
+            _rebaseOnto(std::move(master));
         }
+        _KVEngine->setMaster_inlock(std::move(_workingCopy));
+        _mergeBase.reset();
         _dirty = false;
     }
     try {
@@ -89,6 +89,20 @@ void RecoveryUnit::abortUnitOfWork() {
     }
 }
 
+void RecoveryUnit::_rebaseOnto(std::shared_ptr<StringStore> master) {
+    if (master == _mergeBase) {
+        return;
+    }
+    try {
+        _workingCopy->merge3(*_mergeBase, *master);
+    } catch (const merge_conflict_exception&) {
+        throw WriteConflictException();
+    }
+    // '_workingCopy' now holds master's changes as well as this unit of work's, so later merges
+    // must not apply master's changes a second time.
+    _mergeBase = std::move(master);
+}
+
 bool RecoveryUnit::waitUntilDurable() {
     return true;  // This is an in-memory storage engine.
 }
@@ -80,6 +80,12 @@ public:
     bool forkIfNeeded();
 
 private:
+    /**
+     * Merges the changes made in '_workingCopy' relative to '_mergeBase' onto 'master', and makes
+     * 'master' the new merge base. Throws WriteConflictException on a conflicting change.
+     */
+    void _rebaseOnto(std::shared_ptr<StringStore> master);
+
     typedef std::shared_ptr<Change> ChangePtr;
     typedef std::vector<ChangePtr> Changes;
 
@@ -28,7 +28,6 @@
 
 #pragma once
 
-#include <array>
 #include <boost/optional.hpp>
 #include <cstring>
 #include <exception>
@@ -37,6 +36,14 @@
 #include <string.h>
 #include <vector>
 
+// TODO replace this with #if BOOST_HW_SIMD_X86 >= BOOST_HW_SIMD_X86_SSE2_VERSION in boost 1.60
+#if defined(_M_AMD64) || defined(__amd64__)
+#include <emmintrin.h>
+#define MONGO_BIGGIE_STORE_HAVE_SSE2
+#endif
+
+#include "mongo/platform/bits.h"
+
 namespace mongo {
 namespace biggie {
 
@@ -151,24 +158,22 @@ public:
 
                 // Check the children right of the node that the iterator was at already. This way,
                 // there will be no backtracking in the traversal.
-                for (auto iter = oldKey + 1 + node->children.begin(); iter != node->children.end();
-                     ++iter) {
-
-                    // If the node has a child, then the sub-tree must have a node with data that
-                    // has not yet been visited.
-                    if (*iter != nullptr) {
-
-                        // If the current node has data, return it and exit. If not, continue
-                        // following the nodes to find the next one with data. It is necessary to go
-                        // to the left-most node in this sub-tree.
-                        if ((*iter)->data != boost::none) {
-                            _current = iter->get();
-                            return;
-                        }
-                        _current = iter->get();
-                        _traverseLeftSubtree();
+                // If the node has such a child, then the sub-tree must have a node with data that
+                // has not yet been visited.
+                int nextKey = node->children.next(oldKey + 1);
+                if (nextKey >= 0) {
+                    Node* child = node->children[nextKey].get();
+
+                    // If the current node has data, return it and exit. If not, continue following
+                    // the nodes to find the next one with data. It is necessary to go to the
+                    // left-most node in this sub-tree.
+                    if (child->data != boost::none) {
+                        _current = child;
                         return;
                     }
+                    _current = child;
+                    _traverseLeftSubtree();
+                    return;
                 }
             }
             return;
@@ -179,12 +184,7 @@ public:
             // '_current' is root. However, it cannot return the root, and hence at least 1
             // iteration of the while loop is required.
             do {
-                for (auto child : _current->children) {
-                    if (child != nullptr) {
-                        _current = child.get();
-                        break;
-                    }
-                }
+                _current = _current->children.first().get();
             } while (_current->data == boost::none);
         }
 
@@ -301,14 +301,13 @@ public:
 
                 // After moving up in the tree, continue searching for neighboring nodes to see if
                 // they have data, moving from right to left.
-                for (int i = oldKey - 1; i >= 0; i--) {
-                    if (node->children[i] != nullptr) {
-                        // If there is a sub-tree found, it must have data, therefore it's necessary
-                        // to traverse to the right most node.
-                        _current = node->children[i].get();
-                        _traverseRightSubtree();
-                        return;
-                    }
+                int prevKey = node->children.prev(oldKey - 1);
+                if (prevKey >= 0) {
+                    // If there is a sub-tree found, it must have data, therefore it's necessary
+                    // to traverse to the right most node.
+                    _current = node->children[prevKey].get();
+                    _traverseRightSubtree();
+                    return;
                 }
 
                 // If there were no sub-trees that contained data, and the 'current' node has data,
@@ -323,15 +322,9 @@ public:
         void _traverseRightSubtree() {
             // This function traverses the given tree to the right most leaf of the subtree where
             // 'current' is the root.
-            do {
-                for (auto iter = _current->children.rbegin(); iter != _current->children.rend();
-                     ++iter) {
-                    if (*iter != nullptr) {
-                        _current = iter->get();
-                        break;
-                    }
-                }
-            } while (!_current->isLeaf());
+            while (!_current->isLeaf()) {
+                _current = _current->children.last().get();
+            }
         }
 
         // "_root" is a copy of the root of the tree over which this is iterating.
@@ -460,7 +453,7 @@ public:
             if (isUniquelyOwned) {
                 // If this node is uniquely owned, simply set that child node to null and
                 // "cut" off that branch of our tree
-                last->children[firstChar] = nullptr;
+                last->children.set(firstChar, nullptr);
                 last->_numSubtreeElems -= 1;
                 last->_sizeSubtreeElems -= sizeOfRemovedNode;
                 _compressOnlyChild(last);
@@ -477,7 +470,7 @@ public:
                 std::shared_ptr<Node> child = std::make_shared<Node>(*last);
                 child->_numSubtreeElems = last->_numSubtreeElems - 1;
                 child->_sizeSubtreeElems = last->_sizeSubtreeElems - sizeOfRemovedNode;
-                child->children[firstChar] = nullptr;
+                child->children.set(firstChar, nullptr);
 
                 // 'last' may only have one child, in which case we need to evaluate
                 // whether or not this node is redundant.
@@ -494,7 +487,7 @@ public:
                     node = std::make_shared<Node>(*last);
                     node->_numSubtreeElems = last->_numSubtreeElems - 1;
                     node->_sizeSubtreeElems = last->_sizeSubtreeElems - sizeOfRemovedNode;
-                    node->children[firstChar] = child;
+                    node->children.set(firstChar, child);
                     child = node;
                 }
                 _root = node;
@@ -512,7 +505,24 @@ public:
 
     void merge3(const RadixStore& base, const RadixStore& other) {
         std::vector<std::shared_ptr<Node>> context;
-        _merge3Helper(this->_root, base._root, other._root, context);
+        std::vector<Key> conflictPrefixes;
+        _merge3Helper(this->_root, base._root, other._root, context, conflictPrefixes);
+
+        // Subtrees whose shapes differ between the three trees are resolved element by element
+        // only once the structural merge is done, as it holds references into this tree.
+        std::vector<value_type> upserts;
+        std::vector<Key> erasures;
+        for (const Key& prefix : conflictPrefixes)
+            _mergeResolveConflict(prefix, base, other, upserts, erasures);
+
+        for (value_type& val : upserts) {
+            if (find(val.first) == end())
+                insert(std::move(val));
+            else
+                update(std::move(val));
+        }
+        for (const Key& key : erasures)
+            erase(key);
     }
 
     // Iterators
@@ -530,12 +540,7 @@ public:
 
         auto node = _root;
         while (!node->isLeaf()) {
-            for (auto iter = node->children.rbegin(); iter != node->children.rend(); ++iter) {
-                if (*iter != nullptr) {
-                    node = *iter;
-                    break;
-                }
-            }
+            node = node->children.last();
         }
         return RadixStore::const_reverse_iterator(_root, node.get());
     }
@@ -567,17 +572,17 @@ public:
         // When we search a child array, always search to the right of 'idx' so that
         // when we go back up the tree we never search anything less than something
         // we already examined.
-        uint8_t idx = '\0';
+        int idx = 0;
         size_t depth = 0;
 
         // Traverse the path given the key to see if the node exists.
         while (depth < key.size()) {
             idx = static_cast<uint8_t>(charKey[depth]);
-            if (node->children[idx] == nullptr) {
+            if (node->children[static_cast<uint8_t>(idx)] == nullptr) {
                 break;
             }
 
-            node = node->children[idx].get();
+            node = node->children[static_cast<uint8_t>(idx)].get();
             // We may eventually need to search this node's parent for larger children.
             idx += 1;
             size_t mismatchIdx = _comparePrefix(node->trieKey, charKey + depth, key.size() - depth);
@@ -598,7 +603,7 @@ public:
                     // If the current key has no value, place it in the context
                     // so that we can search its children.
                     context.push_back(node);
-                    idx = '\0';
+                    idx = 0;
                 } else {
                     // If the current key is less, we will need to go back up the
                     // tree and this node does not need to be pushed into the context.
@@ -617,7 +622,7 @@ public:
         } else if (depth == key.size()) {
             // The search key is an exact prefix, so we need to search all of this node's
             // children.
-            idx = '\0';
+            idx = 0;
         }
 
         // The node did not exist, so must find an node with the next largest key (if it exists).
@@ -627,22 +632,15 @@ public:
             node = context.back();
             context.pop_back();
 
-            for (auto iter = idx + node->children.begin(); iter != node->children.end(); ++iter) {
-                if (*iter != nullptr) {
-                    // There exists a node with a key larger than the one given, traverse to
-                    // this node which will be the left-most node in this sub-tree.
-                    node = iter->get();
-                    while (node->data == boost::none) {
-                        for (auto iter = node->children.begin(); iter != node->children.end();
-                             ++iter) {
-                            if (*iter != nullptr) {
-                                node = iter->get();
-                                break;
-                            }
-                        }
-                    }
-                    return const_iterator(_root, node);
+            int nextKey = node->children.next(idx);
+            if (nextKey >= 0) {
+                // There exists a node with a key larger than the one given, traverse to
+                // this node which will be the left-most node in this sub-tree.
+                node = node->children[nextKey].get();
+                while (node->data == boost::none) {
+                    node = node->children.first().get();
                 }
+                return const_iterator(_root, node);
             }
 
             if (node->trieKey.empty()) {
@@ -682,31 +680,348 @@ public:
     }
 
 private:
+    /**
+     * The child pointers of a Node, keyed by the first byte of each child's trieKey. The layout
+     * adapts to the number of children, as in an Adaptive Radix Tree:
+     *
+     *  - Node4 and Node16 keep up to 4 or 16 sorted key bytes next to a parallel array of child
+     *    pointers. Node16 lookups compare all 16 key bytes at once with SSE2 where available.
+     *  - Node48 keeps a 256-entry byte index where a non-zero entry is 1 + the slot of that key's
+     *    child in an array of 48 pointers.
+     *  - Node256 keeps a child pointer for every possible byte.
+     *
+     * Leaves, the vast majority of nodes, allocate nothing. Copies are deep with respect to the
+     * layout but share the children themselves, which is what copy-on-write relies on.
+     */
+    class Children {
+    public:
+        Children() = default;
+
+        Children(const Children& other) {
+            *this = other;
+        }
+
+        Children(Children&& other) = default;
+
+        Children& operator=(const Children& other) {
+            if (this == &other)
+                return *this;
+            _allocate(other._capacity);
+            _size = other._size;
+            if (other._keys) {
+                const size_t keyBytes = other._capacity == kNode48 ? 256 : other._capacity;
+                std::memcpy(_keys.get(), other._keys.get(), keyBytes);
+            }
+            for (size_t i = 0; i < _capacity; ++i) {
+                _ptrs[i] = other._ptrs[i];
+            }
+            return *this;
+        }
+
+        Children& operator=(Children&& other) = default;
+
+        /**
+         * Returns the child whose trieKey starts with 'c', or a null pointer if there is none.
+         */
+        const std::shared_ptr<Node>& operator[](uint8_t c) const {
+            static const std::shared_ptr<Node> kNoChild;
+            int slot = _find(c);
+            return slot < 0 ? kNoChild : _ptrs[slot];
+        }
+
+        /**
+         * Sets the child for 'c'. Setting a null pointer removes the child.
+         */
+        void set(uint8_t c, std::shared_ptr<Node> child) {
+            if (child == nullptr) {
+                _erase(c);
+                return;
+            }
+
+            int slot = _find(c);
+            if (slot >= 0) {
+                _ptrs[slot] = std::move(child);
+                return;
+            }
+
+            if (_size == _capacity) {
+                _resize(_nextCapacity(_capacity));
+            }
+
+            switch (_capacity) {
+                case kNode4:
+                case kNode16: {
+                    size_t pos = 0;
+                    while (pos < _size && _keys[pos] < c) {
+                        ++pos;
+                    }
+                    for (size_t i = _size; i > pos; --i) {
+                        _keys[i] = _keys[i - 1];
+                        _ptrs[i] = std::move(_ptrs[i - 1]);
+                    }
+                    _keys[pos] = c;
+                    _ptrs[pos] = std::move(child);
+                    break;
+                }
+                case kNode48:
+                    _keys[c] = static_cast<uint8_t>(_size + 1);
+                    _ptrs[_size] = std::move(child);
+                    break;
+                default:
+                    _ptrs[c] = std::move(child);
+                    break;
+            }
+            ++_size;
+        }
+
+        bool empty() const {
+            return _size == 0;
+        }
+
+        size_t size() const {
+            return _size;
+        }
+
+        /**
+         * Returns the smallest key byte that is at least 'from' and has a child, or -1.
+         */
+        int next(int from) const {
+            if (from < 0)
+                from = 0;
+            switch (_capacity) {
+                case 0:
+                    return -1;
+                case kNode4:
+                case kNode16:
+                    for (size_t i = 0; i < _size; ++i) {
+                        if (_keys[i] >= from)
+                            return _keys[i];
+                    }
+                    return -1;
+                case kNode48:
+                    for (int c = from; c < 256; ++c) {
+                        if (_keys[c])
+                            return c;
+                    }
+                    return -1;
+                default:
+                    for (int c = from; c < 256; ++c) {
+                        if (_ptrs[c])
+                            return c;
+                    }
+                    return -1;
+            }
+        }
+
+        /**
+         * Returns the largest key byte that is at most 'from' and has a child, or -1.
+         */
+        int prev(int from) const {
+            if (from > 255)
+                from = 255;
+            switch (_capacity) {
+                case 0:
+                    return -1;
+                case kNode4:
+                case kNode16:
+                    for (size_t i = _size; i > 0; --i) {
+                        if (_keys[i - 1] <= from)
+                            return _keys[i - 1];
+                    }
+                    return -1;
+                case kNode48:
+                    for (int c = from; c >= 0; --c) {
+                        if (_keys[c])
+                            return c;
+                    }
+                    return -1;
+                default:
+                    for (int c = from; c >= 0; --c) {
+                        if (_ptrs[c])
+                            return c;
+                    }
+                    return -1;
+            }
+        }
+
+        /**
+         * Returns the child with the smallest key byte, or a null pointer if there is none.
+         */
+        const std::shared_ptr<Node>& first() const {
+            int c = next(0);
+            return (*this)[static_cast<uint8_t>(c < 0 ? 0 : c)];
+        }
+
+        /**
+         * Returns the child with the largest key byte, or a null pointer if there is none.
+         */
+        const std::shared_ptr<Node>& last() const {
+            int c = prev(255);
+            return (*this)[static_cast<uint8_t>(c < 0 ? 0 : c)];
+        }
+
+    private:
+        static constexpr uint16_t kNode4 = 4;
+        static constexpr uint16_t kNode16 = 16;
+        static constexpr uint16_t kNode48 = 48;
+        static constexpr uint16_t kNode256 = 256;
+
+        static uint16_t _nextCapacity(uint16_t capacity) {
+            switch (capacity) {
+                case 0:
+                    return kNode4;
+                case kNode4:
+                    return kNode16;
+                case kNode16:
+                    return kNode48;
+                default:
+                    return kNode256;
+            }
+        }
+
+        /**
+         * Returns the slot in '_ptrs' holding the child for 'c', or -1.
+         */
+        int _find(uint8_t c) const {
+            switch (_capacity) {
+                case 0:
+                    return -1;
+                case kNode4:
+                    for (size_t i = 0; i < _size; ++i) {
+                        if (_keys[i] == c)
+                            return i;
+                    }
+                    return -1;
+                case kNode16: {
+#ifdef MONGO_BIGGIE_STORE_HAVE_SSE2
+                    const __m128i keys =
+                        _mm_loadu_si128(reinterpret_cast<const __m128i*>(_keys.get()));
+                    const __m128i matches = _mm_cmpeq_epi8(keys, _mm_set1_epi8(c));
+                    const unsigned mask = _mm_movemask_epi8(matches) & ((1u << _size) - 1);
+                    return mask ? countTrailingZeros64(mask) : -1;
+#else
+                    for (size_t i = 0; i < _size; ++i) {
+                        if (_keys[i] == c)
+                            return i;
+                    }
+                    return -1;
+#endif
+                }
+                case kNode48:
+                    return static_cast<int>(_keys[c]) - 1;
+                default:
+                    return _ptrs[c] ? c : -1;
+            }
+        }
+
+        void _erase(uint8_t c) {
+            int slot = _find(c);
+            if (slot < 0)
+                return;
+
+            switch (_capacity) {
+                case kNode4:
+                case kNode16:
+                    for (size_t i = slot; i + 1 < _size; ++i) {
+                        _keys[i] = _keys[i + 1];
+                        _ptrs[i] = std::move(_ptrs[i + 1]);
+                    }
+                    _ptrs[_size - 1] = nullptr;
+                    break;
+                case kNode48: {
+                    // Keep the slots dense by moving the last slot into the freed one.
+                    const size_t lastSlot = _size - 1;
+                    if (static_cast<size_t>(slot) != lastSlot) {
+                        for (int k = 0; k < 256; ++k) {
+                            if (_keys[k] == lastSlot + 1) {
+                                _keys[k] = static_cast<uint8_t>(slot + 1);
+                                break;
+                            }
+                        }
+                        _ptrs[slot] = std::move(_ptrs[lastSlot]);
+                    }
+                    _ptrs[lastSlot] = nullptr;
+                    _keys[c] = 0;
+                    break;
+                }
+                default:
+                    _ptrs[c] = nullptr;
+                    break;
+            }
+            --_size;
+
+            // Shrink with some hysteresis so that alternating inserts and erases around a
+            // boundary do not resize every time.
+            if (_size == 0) {
+                _allocate(0);
+            } else if (_capacity == kNode256 && _size <= kNode48 - 8) {
+                _resize(kNode48);
+            } else if (_capacity == kNode48 && _size <= kNode16 - 4) {
+                _resize(kNode16);
+            } else if (_capacity == kNode16 && _size <= kNode4 - 1) {
+                _resize(kNode4);
+            }
+        }
+
+        /**
+         * Replaces the storage with empty storage for 'capacity' children.
+         */
+        void _allocate(uint16_t capacity) {
+            _capacity = capacity;
+            _size = 0;
+            _keys.reset();
+            _ptrs.reset();
+            if (capacity == 0)
+                return;
+
+            _ptrs.reset(new std::shared_ptr<Node>[capacity]);
+            if (capacity != kNode256) {
+                const size_t keyBytes = capacity == kNode48 ? 256 : capacity;
+                _keys.reset(new uint8_t[keyBytes]);
+                std::memset(_keys.get(), 0, keyBytes);
+            }
+        }
+
+        /**
+         * Moves the children into storage for 'capacity' children, preserving their order.
+         */
+        void _resize(uint16_t capacity) {
+            std::vector<std::pair<uint8_t, std::shared_ptr<Node>>> entries;
+            entries.reserve(_size);
+            for (int c = next(0); c >= 0; c = next(c + 1)) {
+                entries.emplace_back(static_cast<uint8_t>(c), (*this)[static_cast<uint8_t>(c)]);
+            }
+
+            _allocate(capacity);
+            for (auto&& entry : entries) {
+                set(entry.first, std::move(entry.second));
+            }
+        }
+
+        uint16_t _capacity = 0;
+        uint16_t _size = 0;
+        std::unique_ptr<uint8_t[]> _keys;
+        std::unique_ptr<std::shared_ptr<Node>[]> _ptrs;
+    };
+
     class Node {
         friend class RadixStore;
 
     public:
-        Node() {
-            children.fill(nullptr);
-        }
+        Node() = default;
 
         Node(std::vector<uint8_t> key) : trieKey(key) {
-            children.fill(nullptr);
             _numSubtreeElems = 0;
             _sizeSubtreeElems = 0;
         }
 
         bool isLeaf() {
-            for (auto child : children) {
-                if (child != nullptr)
-                    return false;
-            }
-            return true;
+            return children.empty();
         }
 
         std::vector<uint8_t> trieKey;
         boost::optional<value_type> data;
-        std::array<std::shared_ptr<Node>, 256> children;
+        Children children;
 
     private:
         size_type _numSubtreeElems = 0;
@@ -738,10 +1053,8 @@ private:
         }
         ret.push_back('\n');
 
-        for (auto child : node->children) {
-            if (child != nullptr) {
-                ret.append(_walkTree(child.get(), depth + 1));
-            }
+        for (int c = node->children.next(0); c >= 0; c = node->children.next(c + 1)) {
+            ret.append(_walkTree(node->children[c].get(), depth + 1));
         }
         return ret;
     }
@@ -841,7 +1154,7 @@ private:
                 node = std::make_shared<Node>(*old.get());
                 node->_numSubtreeElems = old->_numSubtreeElems;
                 node->_sizeSubtreeElems = old->_sizeSubtreeElems;
-                prev->children[old->trieKey.front()] = node;
+                prev->children.set(old->trieKey.front(), node);
             }
 
             // 'node' is uniquely owned at this point, so we are free to modify it.
@@ -874,7 +1187,7 @@ private:
 
                 // Change the current node's trieKey and make a child of the new node.
                 newKey = _makeKey(node->trieKey, mismatchIdx, node->trieKey.size() - mismatchIdx);
-                newNode->children[newKey.front()] = node;
+                newNode->children.set(newKey.front(), node);
                 node->trieKey = newKey;
 
                 return std::pair<const_iterator, bool>(it, true);
@@ -953,7 +1266,7 @@ private:
             newNode->_numSubtreeElems = node->children[key.front()]->_numSubtreeElems;
             newNode->_sizeSubtreeElems = node->children[key.front()]->_sizeSubtreeElems;
         }
-        node->children[key.front()] = newNode;
+        node->children.set(key.front(), newNode);
         return newNode;
     }
 
@@ -1009,15 +1322,10 @@ private:
         }
 
         // Determine if this node has only one child.
-        std::shared_ptr<Node> onlyChild = nullptr;
-        for (size_t i = 0; i < node->children.size(); ++i) {
-            if (node->children[i] != nullptr) {
-                if (onlyChild != nullptr) {
-                    return;
-                }
-                onlyChild = node->children[i];
-            }
+        if (node->children.size() != 1) {
+            return;
         }
+        std::shared_ptr<Node> onlyChild = node->children.first();
 
         // Append the child's key onto the parent.
         for (char item : onlyChild->trieKey) {
@@ -1067,7 +1375,7 @@ private:
         for (; idx < context.size(); idx++) {
             node = context[idx];
             newNode = std::make_shared<Node>(*node.get());
-            parent->children[node->trieKey.front()] = newNode;
+            parent->children.set(node->trieKey.front(), newNode);
             parent = newNode;
             context[idx] = newNode;
         }
@@ -1077,25 +1385,21 @@ private:
 
     /**
      * Resolves conflicts within subtrees due to the complicated structure of path-compressed radix
-     * tries.
+     * tries. Every element under 'prefix' is compared between the three trees, and the changes
+     * needed to bring in the modifications from 'other' are appended to 'upserts' and 'erasures'
+     * rather than applied, so that no iterator over this tree is invalidated.
      */
-    void mergeResolveConflict(std::shared_ptr<Node> current,
-                              const std::shared_ptr<Node>& baseNode,
-                              const std::shared_ptr<Node>& otherNode) {
-
-        // Merges all differences between this and base, along with modifications from other.
-
-        // Find the first node with data in the sub-tree where current is root.
-        Node* node = _begin(current);
-        RadixStore::const_iterator iter = const_iterator(current, node);
-        RadixStore base, other;
-        base._root = baseNode;
-        other._root = otherNode;
-
-        while (iter != this->end()) {
-            const value_type val = *iter;
-            RadixStore::const_iterator baseIter = base.find(val.first);
-            RadixStore::const_iterator otherIter = other.find(val.first);
+    void _mergeResolveConflict(const Key& prefix,
+                               const RadixStore& base,
+                               const RadixStore& other,
+                               std::vector<value_type>& upserts,
+                               std::vector<Key>& erasures) const {
+        auto hasPrefix = [&](const Key& key) { return key.compare(0, prefix.size(), prefix) == 0; };
+
+        for (auto iter = lower_bound(prefix); iter != end() && hasPrefix(iter->first); ++iter) {
+            const value_type& val = *iter;
+            const_iterator baseIter = base.find(val.first);
+            const_iterator otherIter = other.find(val.first);
 
             if (baseIter != base.end() && otherIter != other.end()) {
                 if (val.second != baseIter->second && otherIter->second != baseIter->second) {
@@ -1103,12 +1407,9 @@ private:
                     throw merge_conflict_exception();
                 }
 
-                if (val.second != baseIter->second) {
-                    // Merges non-conflicting insertions from this.
-                    this->insert(RadixStore::value_type(val));
-                } else {
-                    // Merges non-conflicting modifications from other or no modifications.
-                    this->insert(RadixStore::value_type(*otherIter));
+                if (val.second == baseIter->second && otherIter->second != baseIter->second) {
+                    // Merges non-conflicting modifications from other.
+                    upserts.push_back(*otherIter);
                 }
             } else if (baseIter != base.end() && otherIter == other.end()) {
                 if (val.second != baseIter->second) {
@@ -1116,45 +1417,30 @@ private:
                     // other.
                     throw merge_conflict_exception();
                 }
-            } else if (baseIter == base.end()) {
-                if (otherIter != other.end()) {
-                    // Throws exception if insertions from this conflict with insertions from other.
-                    throw merge_conflict_exception();
-                }
 
-                // Merges insertions from this.
-                this->insert(RadixStore::value_type(val));
+                // Merges deletions from other.
+                erasures.push_back(val.first);
+            } else if (baseIter == base.end() && otherIter != other.end()) {
+                // Throws exception if insertions from this conflict with insertions from other.
+                throw merge_conflict_exception();
             }
-            iter++;
         }
 
-        // Merges insertions and deletions from other.
-        for (const value_type otherVal : other) {
-            RadixStore::const_iterator baseIter = base.find(otherVal.first);
-            RadixStore::const_iterator thisIter = this->find(otherVal.first);
+        for (auto otherIter = other.lower_bound(prefix);
+             otherIter != other.end() && hasPrefix(otherIter->first);
+             ++otherIter) {
+            const_iterator baseIter = base.find(otherIter->first);
 
             if (baseIter == base.end()) {
-                // Merges insertions from other.
-                this->insert(RadixStore::value_type(otherVal));
-            } else if (thisIter == this->end() && otherVal.second != baseIter->second) {
-                // Throws exception if modifications from this conflict with deletions from other.
+                // Merges insertions from other. Conflicting insertions were detected above.
+                upserts.push_back(*otherIter);
+            } else if (find(otherIter->first) == end() && otherIter->second != baseIter->second) {
+                // Throws exception if deletions from this conflict with modifications from other.
                 throw merge_conflict_exception();
             }
         }
-
-        // Merges insertions and deletions from other.
-        for (const value_type baseVal : base) {
-            RadixStore::const_iterator otherIter = other.find(baseVal.first);
-            RadixStore::const_iterator thisIter = this->find(baseVal.first);
-
-            if (otherIter == other.end() && thisIter != this->end()) {
-                // If 'base' and 'current' trees contain a node not present in 'other', erase it.
-                this->erase(baseVal.first);
-            }
-        }
     }
 
-
     /**
      * Returns a Store that has all changes from both 'this' and 'other' compared to base.
      * Throws merge_conflict_exception if there are merge conflicts.
@@ -1162,14 +1448,45 @@ private:
     std::pair<int, int> _merge3Helper(std::shared_ptr<Node> current,
                                       const std::shared_ptr<Node>& base,
                                       const std::shared_ptr<Node>& other,
-                                      std::vector<std::shared_ptr<Node>>& context) {
+                                      std::vector<std::shared_ptr<Node>>& context,
+                                      std::vector<Key>& conflictPrefixes) {
         // Remember the number of elements, and the size of the elements that changed to
         // properly update parent nodes in our recursive stack.
         int sizeDelta = 0;
         int numDelta = 0;
         context.push_back(current);
 
-        for (unsigned int key = 0; key < 256; ++key) {
+        // The element stored at this node itself, if any, must be merged as well as the children.
+        auto sameData = [](const Node* a, const Node* b) {
+            if (a->data == boost::none || b->data == boost::none)
+                return a->data == boost::none && b->data == boost::none;
+            return a->data->second == b->data->second;
+        };
+        if (!sameData(other.get(), base.get())) {
+            if (!sameData(current.get(), base.get()))
+                throw merge_conflict_exception();
+
+            numDelta += (other->data ? 1 : 0) - (current->data ? 1 : 0);
+            sizeDelta += static_cast<int>(other->data ? other->data->second.size() : 0) -
+                static_cast<int>(current->data ? current->data->second.size() : 0);
+
+            current = _makeBranchUnique(context);
+            current->data = boost::none;
+            if (other->data)
+                current->data.emplace(*other->data);
+        }
+
+        // Visit every key byte that has a child in at least one of the three trees, in order.
+        auto nextKey = [&](int from) {
+            int key = -1;
+            for (const Node* n : {current.get(), base.get(), other.get()}) {
+                int k = n->children.next(from);
+                if (k >= 0 && (key < 0 || k < key))
+                    key = k;
+            }
+            return key;
+        };
+        for (int key = nextKey(0); key >= 0; key = nextKey(key + 1)) {
             std::shared_ptr<Node> node = current->children[key];
             std::shared_ptr<Node> baseNode = base->children[key];
             std::shared_ptr<Node> otherNode = other->children[key];
@@ -1184,7 +1501,7 @@ private:
                     numDelta += other->children[key]->_numSubtreeElems;
 
                     current = _makeBranchUnique(context);
-                    current->children[key] = other->children[key];
+                    current->children.set(key, other->children[key]);
                 } else if (baseNode != nullptr && otherNode != nullptr && baseNode == otherNode) {
                     // Don't do anything since it means that master + base have a branch
                     // that current does not, indicnating that current removed that branch.
@@ -1208,7 +1525,7 @@ private:
                         numDelta -= current->children[key]->_numSubtreeElems;
 
                         current = _makeBranchUnique(context);
-                        current->children[key] = nullptr;
+                        current->children.set(key, nullptr);
 
                     } else if (baseNode != nullptr && otherNode != nullptr && baseNode == node) {
                         // If other and current point to the same node, then master changed
@@ -1219,7 +1536,7 @@ private:
                             current->children[key]->_numSubtreeElems;
 
                         current = _makeBranchUnique(context);
-                        current->children[key] = other->children[key];
+                        current->children.set(key, other->children[key]);
                     }
                 } else {
                     // Current node is a unique pointer.
@@ -1241,12 +1558,19 @@ private:
                         // element by element.
                         if (node->trieKey == baseNode->trieKey &&
                             baseNode->trieKey == otherNode->trieKey) {
-                            std::pair<int, int> diff =
-                                _merge3Helper(node, baseNode, otherNode, context);
+                            std::pair<int, int> diff = _merge3Helper(
+                                node, baseNode, otherNode, context, conflictPrefixes);
                             numDelta += diff.first;
                             sizeDelta += diff.second;
+
+                            // The recursion may have copied the path down to here.
+                            current = context.back();
                         } else {
-                            mergeResolveConflict(node, baseNode, otherNode);
+                            Key prefix;
+                            for (const auto& pathNode : context)
+                                prefix.append(pathNode->trieKey.begin(), pathNode->trieKey.end());
+                            prefix.push_back(static_cast<char>(key));
+                            conflictPrefixes.push_back(std::move(prefix));
                         }
 
                     } else if (baseNode != nullptr && otherNode == nullptr) {
@@ -1264,6 +1588,7 @@ private:
 
         current->_numSubtreeElems += numDelta;
         current->_sizeSubtreeElems += sizeDelta;
+        context.pop_back();
         return std::make_pair(numDelta, sizeDelta);
     }
 
@@ -1273,12 +1598,7 @@ private:
             if (node->children.empty())
                 return nullptr;
 
-            for (auto child : node->children) {
-                if (child != nullptr) {
-                    node = child;
-                    break;
-                }
-            }
+            node = node->children.first();
         }
         return node.get();
     }
@@ -1611,6 +1611,128 @@ TEST_F(RadixStoreTest, PathCompressionTest) {
               "\n food*"
               "\n  ie*\n");
 }
+
+TEST_F(RadixStoreTest, NodeGrowsAndShrinksThroughAllSizes) {
+    // Every child count up to 256 exercises each node layout and the transitions between them.
+    for (int i = 255; i >= 0; i--) {
+        std::string key = "k" + std::string(1, static_cast<char>(i));
+        ASSERT_TRUE(thisStore.insert(value_type(key, std::to_string(i))).second);
+
+        // The earlier snapshot must not see later inserts.
+        if (i == 200) {
+            otherStore = thisStore;
+        }
+    }
+    ASSERT_EQ(thisStore.size(), StringStore::size_type(256));
+    ASSERT_EQ(otherStore.size(), StringStore::size_type(56));
+
+    int expectedByte = 0;
+    for (auto&& item : thisStore) {
+        ASSERT_EQ(item.first, "k" + std::string(1, static_cast<char>(expectedByte)));
+        expectedByte++;
+    }
+    ASSERT_EQ(expectedByte, 256);
+
+    expectedByte = 255;
+    for (auto it = thisStore.rbegin(); it != thisStore.rend(); ++it) {
+        ASSERT_EQ(it->first, "k" + std::string(1, static_cast<char>(expectedByte)));
+        expectedByte--;
+    }
+    ASSERT_EQ(expectedByte, -1);
+
+    // Erase all but two children, in an order that leaves holes along the way.
+    for (int i = 0; i < 256; i += 2) {
+        ASSERT_EQ(thisStore.erase("k" + std::string(1, static_cast<char>(i))),
+                  StringStore::size_type(1));
+    }
+    for (int i = 1; i < 253; i += 2) {
+        ASSERT_EQ(thisStore.erase("k" + std::string(1, static_cast<char>(i))),
+                  StringStore::size_type(1));
+    }
+    ASSERT_EQ(thisStore.size(), StringStore::size_type(2));
+    auto it = thisStore.begin();
+    ASSERT_EQ(it->first, "k" + std::string(1, static_cast<char>(253)));
+    ++it;
+    ASSERT_EQ(it->first, "k" + std::string(1, static_cast<char>(255)));
+    ++it;
+    ASSERT_TRUE(it == thisStore.end());
+
+    ASSERT_EQ(otherStore.size(), StringStore::size_type(56));
+    ASSERT_TRUE(otherStore.find("k" + std::string(1, static_cast<char>(200))) != otherStore.end());
+}
+
+TEST_F(RadixStoreTest, LowerBoundAfterHighestByteChild) {
+    value_type value1 = std::make_pair("a", "1");
+    value_type value2 = std::make_pair("\xff\x01", "2");
+    value_type value3 = std::make_pair("\xff\x02", "3");
+
+    thisStore.insert(value_type(value1));
+    thisStore.insert(value_type(value2));
+    thisStore.insert(value_type(value3));
+
+    // The search continues past the 0xff child of the root rather than wrapping around to 'a'.
+    ASSERT_TRUE(thisStore.lower_bound("\xff\x03") == thisStore.end());
+    ASSERT_TRUE(*thisStore.lower_bound("\xff\x00") == value2);
+}
+
+TEST_F(RadixStoreTest, MergeWithWideNodes) {
+    for (int i = 0; i < 100; i++) {
+        baseStore.insert(value_type("base" + std::to_string(i), "b"));
+    }
+    thisStore = baseStore;
+    otherStore = baseStore;
+    expected = baseStore;
+
+    for (int i = 0; i < 100; i++) {
+        value_type mine("this" + std::to_string(i), "t");
+        value_type theirs("other" + std::to_string(i), "o");
+        thisStore.insert(value_type(mine));
+        otherStore.insert(value_type(theirs));
+        expected.insert(value_type(mine));
+        expected.insert(value_type(theirs));
+    }
+
+    thisStore.merge3(baseStore, otherStore);
+    ASSERT_TRUE(thisStore == expected);
+    ASSERT_EQ(baseStore.size(), StringStore::size_type(100));
+}
+
+TEST_F(RadixStoreTest, MergeRebasesOntoSuccessiveMasters) {
+    // 'thisStore' is merged with one master, then again with a later master using the first as
+    // its new base, the way a commit rebases when it loses a race for the master lock.
+    for (int i = 0; i < 300; i++) {
+        baseStore.insert(value_type("c1/" + std::to_string(i), "b"));
+    }
+    thisStore = baseStore;
+    otherStore = baseStore;
+
+    for (int i = 0; i < 50; i++) {
+        thisStore.insert(value_type("c1/w" + std::to_string(i), "w"));
+        otherStore.insert(value_type("c2/" + std::to_string(i), "o"));
+    }
+    thisStore.update(value_type("c1/7", "W"));
+    otherStore.erase("c1/9");
+
+    thisStore.merge3(baseStore, otherStore);
+    ASSERT_EQ(thisStore.size(), StringStore::size_type(399));
+    ASSERT_EQ(std::distance(thisStore.begin(), thisStore.end()), 399);
+    ASSERT_TRUE(thisStore.find("c1/9") == thisStore.end());
+
+    StringStore laterStore = otherStore;
+    laterStore.update(value_type("c1/70", "L"));
+    laterStore.erase("c2/1");
+
+    StringStore conflictStore = laterStore;
+    conflictStore.update(value_type("c1/7", "X"));
+    StringStore copy = thisStore;
+    ASSERT_THROWS(copy.merge3(otherStore, conflictStore), merge_conflict_exception);
+
+    thisStore.merge3(otherStore, laterStore);
+    ASSERT_EQ(thisStore.size(), StringStore::size_type(398));
+    ASSERT_EQ(thisStore.find("c1/7")->second, "W");
+    ASSERT_EQ(thisStore.find("c1/70")->second, "L");
+    ASSERT_TRUE(thisStore.find("c2/1") == thisStore.end());
+}
 }  // namespace
 }  // mongo namespace
 }  // biggie namespace
@@ -0,0 +1,157 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/clustered_record_id.h"
+
+#include <cmath>
+
+#include "mongo/bson/bson_validate.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/util/debug_util.h"
+
+namespace mongo {
+namespace clustered_record_id {
+namespace {
+
+const Status kBadIdStatus(ErrorCodes::BadValue,
+                          "the _id of a document in a clustered collection must be a positive "
+                          "integer");
+
+/**
+ * Returns 'value' as a RecordId if it is a normal, non-reserved, RecordId.
+ */
+StatusWith<RecordId> toNormalRecordId(long long value) {
+    const RecordId id(value);
+    if (!id.isNormal()) {
+        return kBadIdStatus;
+    }
+    return id;
+}
+
+}  // namespace
+
+StatusWith<RecordId> keyForId(const BSONElement& id) {
+    switch (id.type()) {
+        case NumberInt:
+        case NumberLong:
+            return toNormalRecordId(id.numberLong());
+        case NumberDouble: {
+            // The cast is only defined for doubles in range, which are checked first.
+            const double value = id.numberDouble();
+            if (!(value >= 1 && value < static_cast<double>(RecordId::kMinReservedRepr)) ||
+                value != std::floor(value)) {
+                return kBadIdStatus;
+            }
+            return toNormalRecordId(static_cast<long long>(value));
+        }
+        case NumberDecimal: {
+            std::uint32_t signalingFlags = Decimal128::kNoFlag;
+            const long long value = id.numberDecimal().toLongExact(&signalingFlags);
+            if (signalingFlags != Decimal128::kNoFlag) {
+                return kBadIdStatus;
+            }
+            return toNormalRecordId(value);
+        }
+        default:
+            return kBadIdStatus;
+    }
+}
+
+StatusWith<RecordId> extractKey(const char* data, int len) {
+    DEV invariant(validateBSON(data, len, BSONVersion::kLatest).isOK());
+
+    const BSONObj obj(data);
+    const BSONElement elem = obj["_id"];
+    if (elem.eoo()) {
+        return {ErrorCodes::BadValue, "a document in a clustered collection must have an _id"};
+    }
+    return keyForId(elem);
+}
+
+boost::optional<RecordId> lowerBoundForId(const BSONElement& bound) {
+    double value;
+    switch (bound.type()) {
+        case NumberInt:
+        case NumberLong: {
+            const long long longValue = bound.numberLong();
+            if (longValue <= 1) {
+                return boost::none;
+            }
+            if (longValue >= RecordId::kMinReservedRepr) {
+                return RecordId::minReserved();
+            }
+            return RecordId(longValue);
+        }
+        case NumberDouble:
+            value = std::ceil(bound.numberDouble());
+            break;
+        default:
+            // Bounds are only an optimization, which decimal bounds go without.
+            return boost::none;
+    }
+
+    if (!(value > 1)) {
+        return boost::none;
+    }
+    if (value >= static_cast<double>(RecordId::kMinReservedRepr)) {
+        return RecordId::minReserved();
+    }
+    return RecordId(static_cast<long long>(value));
+}
+
+boost::optional<RecordId> upperBoundForId(const BSONElement& bound) {
+    double value;
+    switch (bound.type()) {
+        case NumberInt:
+        case NumberLong: {
+            const long long longValue = bound.numberLong();
+            if (longValue >= RecordId::kMinReservedRepr) {
+                return boost::none;
+            }
+            return RecordId(longValue > 0 ? longValue : RecordId::kNullRepr);
+        }
+        case NumberDouble:
+            value = std::floor(bound.numberDouble());
+            break;
+        default:
+            return boost::none;
+    }
+
+    if (!(value < static_cast<double>(RecordId::kMinReservedRepr))) {
+        return boost::none;
+    }
+    if (value < 0) {
+        return RecordId(RecordId::kNullRepr);
+    }
+    return RecordId(static_cast<long long>(value));
+}
+
+}  // namespace clustered_record_id
+}  // namespace mongo
@@ -0,0 +1,67 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+
+#include "mongo/base/status_with.h"
+#include "mongo/db/record_id.h"
+
+namespace mongo {
+class BSONElement;
+
+/**
+ * The RecordIds of a clustered collection are its documents' _id values, so that the collection is
+ * kept in _id order and needs no separate _id index. Only positive integers below the reserved
+ * RecordId range can be stored this way. Numbers of different types which compare equal, such as
+ * 5 and 5.0, have the same RecordId, just as they would collide in an _id index.
+ */
+namespace clustered_record_id {
+
+/**
+ * Returns the RecordId of the document with the given _id in a clustered collection, or an error if
+ * no such document can exist.
+ */
+StatusWith<RecordId> keyForId(const BSONElement& id);
+
+/**
+ * data and len must be the arguments from RecordStore::insert() on a clustered collection.
+ */
+StatusWith<RecordId> extractKey(const char* data, int len);
+
+/**
+ * Returns the RecordIds below and above which no document whose _id is at least, or respectively at
+ * most, the number 'bound' can lie. Returns boost::none if 'bound' does not limit the RecordIds,
+ * including when it is not a number.
+ */
+boost::optional<RecordId> lowerBoundForId(const BSONElement& bound);
+boost::optional<RecordId> upperBoundForId(const BSONElement& bound);
+
+}  // namespace clustered_record_id
+}  // namespace mongo
@@ -0,0 +1,106 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/clustered_record_id.h"
+
+#include <limits>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(ClusteredRecordIdTest, EqualNumbersHaveTheSameKey) {
+    const auto obj =
+        BSON("int" << 5 << "long" << 5LL << "double" << 5.0 << "decimal" << Decimal128("5.00"));
+    for (auto&& elem : obj) {
+        auto key = clustered_record_id::keyForId(elem);
+        ASSERT_OK(key.getStatus());
+        ASSERT_EQ(RecordId(5), key.getValue());
+    }
+}
+
+TEST(ClusteredRecordIdTest, OnlyPositiveIntegersHaveKeys) {
+    const auto obj = BSON("zero" << 0 << "negative" << -1LL << "fraction" << 1.5 << "nan"
+                                 << std::numeric_limits<double>::quiet_NaN()
+                                 << "decimal"
+                                 << Decimal128("2.5")
+                                 << "reserved"
+                                 << static_cast<long long>(RecordId::kMinReservedRepr)
+                                 << "huge"
+                                 << 1e300
+                                 << "string"
+                                 << "1"
+                                 << "oid"
+                                 << OID::gen());
+    for (auto&& elem : obj) {
+        ASSERT_EQ(ErrorCodes::BadValue, clustered_record_id::keyForId(elem).getStatus()) << elem;
+    }
+}
+
+TEST(ClusteredRecordIdTest, ExtractKeyRequiresId) {
+    const auto doc = BSON("_id" << 7 << "a" << 1);
+    auto key = clustered_record_id::extractKey(doc.objdata(), doc.objsize());
+    ASSERT_OK(key.getStatus());
+    ASSERT_EQ(RecordId(7), key.getValue());
+
+    const auto noId = BSON("a" << 1);
+    ASSERT_EQ(ErrorCodes::BadValue,
+              clustered_record_id::extractKey(noId.objdata(), noId.objsize()).getStatus());
+}
+
+TEST(ClusteredRecordIdTest, BoundsRoundTowardsTheRange) {
+    const auto obj = BSON("" << 2.5 << "" << 7LL << "" << -3 << "" << 1e300 << "" << "a");
+
+    BSONObjIterator it(obj);
+    const auto fraction = it.next();
+    ASSERT_EQ(RecordId(3), *clustered_record_id::lowerBoundForId(fraction));
+    ASSERT_EQ(RecordId(2), *clustered_record_id::upperBoundForId(fraction));
+
+    const auto integer = it.next();
+    ASSERT_EQ(RecordId(7), *clustered_record_id::lowerBoundForId(integer));
+    ASSERT_EQ(RecordId(7), *clustered_record_id::upperBoundForId(integer));
+
+    const auto negative = it.next();
+    ASSERT_FALSE(clustered_record_id::lowerBoundForId(negative));
+    ASSERT_EQ(RecordId(RecordId::kNullRepr), *clustered_record_id::upperBoundForId(negative));
+
+    const auto huge = it.next();
+    ASSERT_EQ(RecordId::minReserved(), *clustered_record_id::lowerBoundForId(huge));
+    ASSERT_FALSE(clustered_record_id::upperBoundForId(huge));
+
+    const auto string = it.next();
+    ASSERT_FALSE(clustered_record_id::lowerBoundForId(string));
+    ASSERT_FALSE(clustered_record_id::upperBoundForId(string));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -273,9 +273,10 @@ void DevNullKVEngine::setCachePressureForTest(int pressure) {
     _cachePressureForTest = pressure;
 }
 
-StatusWith<std::vector<std::string>> DevNullKVEngine::beginNonBlockingBackup(
-    OperationContext* opCtx) {
-    std::vector<std::string> filesToCopy = {"filename.wt"};
+StatusWith<std::vector<StorageEngine::BackupFile>> DevNullKVEngine::beginNonBlockingBackup(
+    OperationContext* opCtx, const StorageEngine::BackupOptions& options) {
+    std::vector<StorageEngine::BackupFile> filesToCopy(1);
+    filesToCopy[0].filename = "filename.wt";
     return filesToCopy;
 }
 
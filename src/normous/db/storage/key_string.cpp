@@ -35,8 +35,15 @@
 #include "mongo/db/storage/key_string.h"
 
 #include <cmath>
+#include <cstring>
 #include <type_traits>
 
+// TODO replace this with #if BOOST_HW_SIMD_X86 >= BOOST_HW_SIMD_X86_SSE2_VERSION in boost 1.60
+#if defined(_M_AMD64) || defined(__amd64__)
+#include <emmintrin.h>
+#define MONGO_KEY_STRING_HAVE_SSE2
+#endif
+
 #include "mongo/base/data_cursor.h"
 #include "mongo/base/data_view.h"
 #include "mongo/platform/bits.h"
@@ -2136,6 +2143,77 @@ int KeyString::compare(const KeyString& other) const {
     return a < b ? -1 : 1;
 }
 
+// static
+size_t KeyString::commonPrefixSize(const void* lhsRaw, const void* rhsRaw, size_t size) {
+    const char* lhs = static_cast<const char*>(lhsRaw);
+    const char* rhs = static_cast<const char*>(rhsRaw);
+    size_t offset = 0;
+
+#ifdef MONGO_KEY_STRING_HAVE_SSE2
+    // Compare 16 bytes at a time. The movemask has a bit set for every equal byte, so the first
+    // clear bit identifies the first difference.
+    for (; offset + sizeof(__m128i) <= size; offset += sizeof(__m128i)) {
+        const __m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + offset));
+        const __m128i r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + offset));
+        const uint32_t equalMask = _mm_movemask_epi8(_mm_cmpeq_epi8(l, r));
+        if (equalMask != 0xFFFF) {
+            return offset + countTrailingZeros64(~equalMask & 0xFFFF);
+        }
+    }
+#endif
+
+    // Compare a word at a time, and fall back to bytes once a differing word has been found.
+    for (; offset + sizeof(uint64_t) <= size; offset += sizeof(uint64_t)) {
+        uint64_t l;
+        uint64_t r;
+        std::memcpy(&l, lhs + offset, sizeof(l));
+        std::memcpy(&r, rhs + offset, sizeof(r));
+        if (l != r) {
+            break;
+        }
+    }
+
+    for (; offset < size; ++offset) {
+        if (lhs[offset] != rhs[offset]) {
+            break;
+        }
+    }
+
+    return offset;
+}
+
+// static
+int KeyString::compareBuffers(const void* lhs,
+                              size_t lhsSize,
+                              const void* rhs,
+                              size_t rhsSize,
+                              size_t knownPrefixSize,
+                              size_t* commonPrefixSizeOut) {
+    const size_t minSize = std::min(lhsSize, rhsSize);
+    dassert(knownPrefixSize <= minSize);
+    dassert(std::memcmp(lhs, rhs, knownPrefixSize) == 0);
+
+    const size_t prefixSize = knownPrefixSize +
+        commonPrefixSize(static_cast<const char*>(lhs) + knownPrefixSize,
+                         static_cast<const char*>(rhs) + knownPrefixSize,
+                         minSize - knownPrefixSize);
+    if (commonPrefixSizeOut) {
+        *commonPrefixSizeOut = prefixSize;
+    }
+
+    if (prefixSize < minSize) {
+        const auto l = static_cast<const unsigned char*>(lhs)[prefixSize];
+        const auto r = static_cast<const unsigned char*>(rhs)[prefixSize];
+        return l < r ? -1 : 1;
+    }
+
+    // One key is a prefix of the other.
+    if (lhsSize == rhsSize)
+        return 0;
+
+    return lhsSize < rhsSize ? -1 : 1;
+}
+
 uint32_t KeyString::TypeBits::readSizeFromBuffer(BufReader* reader) {
     const uint8_t firstByte = reader->peek<uint8_t>();
 
@@ -360,6 +360,23 @@ public:
     void appendRecordId(RecordId loc);
     void appendTypeBits(const TypeBits& bits);
 
+    /**
+     * Appends the value of 'elem' as the next component of an index key, descending if 'invert'.
+     * Building a key this way is equivalent to resetToKey() on a BSONObj of the same elements,
+     * without materializing that BSONObj.
+     */
+    void appendBSONElement(const BSONElement& elem, bool invert) {
+        _appendBsonValue(elem, invert, nullptr);
+    }
+
+    /**
+     * Appends the string 'val' as the next component of an index key, as appendBSONElement() does
+     * for a String element of value 'val'.
+     */
+    void appendString(StringData val, bool invert) {
+        _appendString(val, invert);
+    }
+
     /**
      * Resets to an empty state.
      * Equivalent to but faster than *this = KeyString()
@@ -392,6 +409,40 @@ public:
 
     int compare(const KeyString& other) const;
 
+    /**
+     * Like compare(), but the caller guarantees that the first 'knownPrefixSize' bytes of both
+     * KeyStrings are equal, so only the remaining suffix needs to be examined. If
+     * 'commonPrefixSizeOut' is non-null, it is set to the size of the longest common prefix of the
+     * two KeyStrings, which can be passed back in as 'knownPrefixSize' by callers that repeatedly
+     * compare slowly-changing keys against the same bound.
+     */
+    int compareWithKnownPrefix(const KeyString& other,
+                               size_t knownPrefixSize,
+                               size_t* commonPrefixSizeOut) const {
+        return compareBuffers(getBuffer(),
+                              getSize(),
+                              other.getBuffer(),
+                              other.getSize(),
+                              knownPrefixSize,
+                              commonPrefixSizeOut);
+    }
+
+    /**
+     * Compares two raw KeyString buffers. See compareWithKnownPrefix().
+     */
+    static int compareBuffers(const void* lhs,
+                              size_t lhsSize,
+                              const void* rhs,
+                              size_t rhsSize,
+                              size_t knownPrefixSize,
+                              size_t* commonPrefixSizeOut);
+
+    /**
+     * Returns the number of leading bytes which are equal in 'lhs' and 'rhs', examining at most
+     * 'size' bytes. Uses vectorized comparisons where the platform supports them.
+     */
+    static size_t commonPrefixSize(const void* lhs, const void* rhs, size_t size);
+
     /**
      * @return a hex encoding of this key
      */
@@ -31,11 +31,13 @@
 #include "mongo/platform/basic.h"
 
 #include <benchmark/benchmark.h>
+#include <memory>
 #include <random>
 #include <vector>
 
 #include "mongo/db/storage/key_string.h"
 #include "mongo/platform/decimal128.h"
+#include "mongo/stdx/memory.h"
 #include "mongo/util/bufreader.h"
 #include "mongo/util/log.h"
 
@@ -52,6 +54,7 @@ const Ordering ALL_ASCENDING = Ordering::make(BSONObj());
 struct BsonsAndKeyStrings {
     int bsonSize = 0;
     int keystringSize = 0;
+    int typebitsSize = 0;
     BSONObj bsons[kSampleSize];
     SharedBuffer keystrings[kSampleSize];
     size_t keystringLens[kSampleSize];
@@ -61,6 +64,7 @@ struct BsonsAndKeyStrings {
 
 enum BsonValueType {
     INT,
+    LONG,
     DOUBLE,
     STRING,
     ARRAY,
@@ -75,6 +79,8 @@ BSONObj generateBson(BsonValueType bsonValueType) {
     switch (bsonValueType) {
         case INT:
             return BSON("" << static_cast<int>(expReal(gen)));
+        case LONG:
+            return BSON("" << static_cast<long long>(expReal(gen)));
         case DOUBLE:
             return BSON("" << expReal(gen));
         case STRING:
@@ -101,11 +107,13 @@ static BsonsAndKeyStrings generateBsonsAndKeyStrings(BsonValueType bsonValueType
     BsonsAndKeyStrings result;
     result.bsonSize = 0;
     result.keystringSize = 0;
+    result.typebitsSize = 0;
     for (int i = 0; i < kSampleSize; i++) {
         BSONObj bson = generateBson(bsonValueType);
         KeyString ks(version, bson, ALL_ASCENDING);
         result.bsonSize += bson.objsize();
         result.keystringSize += ks.getSize();
+        result.typebitsSize += ks.getTypeBits().getSize();
         result.bsons[i] = bson;
 
         result.keystrings[i] = SharedBuffer::allocate(ks.getSize());
@@ -114,7 +122,7 @@ static BsonsAndKeyStrings generateBsonsAndKeyStrings(BsonValueType bsonValueType
 
         result.typebits[i] = SharedBuffer::allocate(ks.getTypeBits().getSize());
         memcpy(result.typebits[i].get(), ks.getTypeBits().getBuffer(), ks.getTypeBits().getSize());
-        result.typebitsLens[i] = ks.getSize();
+        result.typebitsLens[i] = ks.getTypeBits().getSize();
     }
     return result;
 }
@@ -131,6 +139,11 @@ void BM_BSONToKeyString(benchmark::State& state,
     }
     state.SetBytesProcessed(state.iterations() * bsonsAndKeyStrings.bsonSize);
     state.SetItemsProcessed(state.iterations() * kSampleSize);
+
+    // The encoded footprint is what determines how much of an index fits in cache, so report it
+    // next to the throughput to make versions comparable on both axes.
+    state.counters["keyBytes"] = double(bsonsAndKeyStrings.keystringSize) / kSampleSize;
+    state.counters["typeBitsBytes"] = double(bsonsAndKeyStrings.typebitsSize) / kSampleSize;
 }
 
 void BM_KeyStringToBSON(benchmark::State& state,
@@ -152,8 +165,80 @@ void BM_KeyStringToBSON(benchmark::State& state,
     state.SetItemsProcessed(state.iterations() * kSampleSize);
 }
 
+/**
+ * Generates a sorted run of compound, string-heavy keys which share their leading fields, the way
+ * consecutive keys in a range scan over a reporting index do, plus an end bound just past them.
+ */
+std::vector<std::unique_ptr<KeyString>> generateCompoundKeyRun(KeyString::Version version,
+                                                               KeyString* endBound) {
+    const std::string region(24, 'r');
+    const std::string account(32, 'a');
+    const std::string product(40, 'p');
+    const std::string channel(16, 'c');
+
+    std::vector<std::unique_ptr<KeyString>> keys;
+    for (int i = 0; i < kSampleSize; i++) {
+        BSONObjBuilder bob;
+        bob.append("", region);
+        bob.append("", account);
+        bob.append("", product);
+        bob.append("", i / 50);
+        bob.append("", channel);
+        bob.append("", i);
+        keys.push_back(stdx::make_unique<KeyString>(version, bob.obj(), ALL_ASCENDING));
+    }
+
+    BSONObjBuilder bound;
+    bound.append("", region);
+    bound.append("", account);
+    bound.append("", product);
+    bound.append("", kSampleSize);
+    endBound->resetToKey(bound.obj(), ALL_ASCENDING, KeyString::kExclusiveBefore);
+    return keys;
+}
+
+void BM_KeyStringCompareToEndBound(benchmark::State& state, const KeyString::Version version) {
+    KeyString endBound(version);
+    const auto keys = generateCompoundKeyRun(version, &endBound);
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        for (auto&& key : keys) {
+            benchmark::DoNotOptimize(key->compare(endBound));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kSampleSize);
+}
+
+void BM_KeyStringCompareToEndBoundCachedPrefix(benchmark::State& state,
+                                               const KeyString::Version version) {
+    KeyString endBound(version);
+    const auto keys = generateCompoundKeyRun(version, &endBound);
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        // Mirrors WiredTigerIndexCursorBase: only the suffix which changed since the previous key
+        // is compared against the end bound.
+        size_t endPrefixSize = 0;
+        const KeyString* previous = nullptr;
+        for (auto&& key : keys) {
+            size_t sharedWithPrevious = 0;
+            if (previous) {
+                sharedWithPrevious =
+                    KeyString::commonPrefixSize(previous->getBuffer(),
+                                                key->getBuffer(),
+                                                std::min(previous->getSize(), key->getSize()));
+            }
+            benchmark::DoNotOptimize(key->compareWithKnownPrefix(
+                endBound, std::min(sharedWithPrevious, endPrefixSize), &endPrefixSize));
+            previous = key.get();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kSampleSize);
+}
+
 BENCHMARK_CAPTURE(BM_BSONToKeyString, V0_Int, KeyString::Version::V0, INT);
 BENCHMARK_CAPTURE(BM_BSONToKeyString, V1_Int, KeyString::Version::V1, INT);
+BENCHMARK_CAPTURE(BM_BSONToKeyString, V0_Long, KeyString::Version::V0, LONG);
+BENCHMARK_CAPTURE(BM_BSONToKeyString, V1_Long, KeyString::Version::V1, LONG);
 BENCHMARK_CAPTURE(BM_BSONToKeyString, V0_Double, KeyString::Version::V0, DOUBLE);
 BENCHMARK_CAPTURE(BM_BSONToKeyString, V1_Double, KeyString::Version::V1, DOUBLE);
 BENCHMARK_CAPTURE(BM_BSONToKeyString, V1_Decimal, KeyString::Version::V1, DECIMAL);
@@ -164,6 +249,8 @@ BENCHMARK_CAPTURE(BM_BSONToKeyString, V1_Array, KeyString::Version::V1, ARRAY);
 
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V0_Int, KeyString::Version::V0, INT);
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V1_Int, KeyString::Version::V1, INT);
+BENCHMARK_CAPTURE(BM_KeyStringToBSON, V0_Long, KeyString::Version::V0, LONG);
+BENCHMARK_CAPTURE(BM_KeyStringToBSON, V1_Long, KeyString::Version::V1, LONG);
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V0_Double, KeyString::Version::V0, DOUBLE);
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V1_Double, KeyString::Version::V1, DOUBLE);
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V1_Decimal, KeyString::Version::V1, DECIMAL);
@@ -171,5 +258,14 @@ BENCHMARK_CAPTURE(BM_KeyStringToBSON, V0_String, KeyString::Version::V0, STRING)
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V1_String, KeyString::Version::V1, STRING);
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V0_Array, KeyString::Version::V0, ARRAY);
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V1_Array, KeyString::Version::V1, ARRAY);
+
+BENCHMARK_CAPTURE(BM_KeyStringCompareToEndBound, V0_Compound, KeyString::Version::V0);
+BENCHMARK_CAPTURE(BM_KeyStringCompareToEndBound, V1_Compound, KeyString::Version::V1);
+BENCHMARK_CAPTURE(BM_KeyStringCompareToEndBoundCachedPrefix,
+                  V0_Compound,
+                  KeyString::Version::V0);
+BENCHMARK_CAPTURE(BM_KeyStringCompareToEndBoundCachedPrefix,
+                  V1_Compound,
+                  KeyString::Version::V1);
 }  // namespace
 }  // namespace mongo
@@ -0,0 +1,100 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/key_string_set.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "mongo/util/assert_util.h"
+#include "mongo/util/bufreader.h"
+
+namespace mongo {
+
+KeyString::TypeBits KeyStringSet::Entry::getTypeBits() const {
+    BufReader reader(_typeBits, _typeBitsSize);
+    return KeyString::TypeBits::fromBuffer(_version, &reader);
+}
+
+void KeyStringSet::add(const KeyString& keyString) {
+    invariant(keyString.version == _version);
+    const auto& typeBits = keyString.getTypeBits();
+
+    Slot slot;
+    slot.offset = _buffer.len();
+    slot.keySize = keyString.getSize();
+    slot.typeBitsSize = typeBits.getSize();
+    _buffer.appendBuf(keyString.getBuffer(), slot.keySize);
+    _buffer.appendBuf(typeBits.getBuffer(), slot.typeBitsSize);
+
+    _entries.push_back(slot);
+    _finished = false;
+}
+
+int KeyStringSet::_compare(const Slot& lhs, const Slot& rhs) const {
+    const char* base = _buffer.buf();
+    int cmp = KeyString::compareBuffers(
+        base + lhs.offset, lhs.keySize, base + rhs.offset, rhs.keySize, 0, nullptr);
+    if (cmp != 0)
+        return cmp;
+
+    const size_t typeBitsSize = std::min(lhs.typeBitsSize, rhs.typeBitsSize);
+    cmp = memcmp(base + lhs.offset + lhs.keySize, base + rhs.offset + rhs.keySize, typeBitsSize);
+    if (cmp != 0)
+        return cmp;
+    return lhs.typeBitsSize < rhs.typeBitsSize ? -1 : lhs.typeBitsSize > rhs.typeBitsSize;
+}
+
+void KeyStringSet::finish() {
+    if (_finished)
+        return;
+    _finished = true;
+
+    if (_entries.size() < 2)
+        return;
+
+    // Most documents generate a single key, or keys from an array that was already in order, so
+    // check before sorting.
+    auto less = [this](const Slot& lhs, const Slot& rhs) { return _compare(lhs, rhs) < 0; };
+    if (!std::is_sorted(_entries.begin(), _entries.end(), less))
+        std::sort(_entries.begin(), _entries.end(), less);
+
+    auto equal = [this](const Slot& lhs, const Slot& rhs) { return _compare(lhs, rhs) == 0; };
+    _entries.erase(std::unique(_entries.begin(), _entries.end(), equal), _entries.end());
+}
+
+KeyStringSet::Entry KeyStringSet::operator[](size_t i) const {
+    invariant(_finished);
+    const Slot& slot = _entries[i];
+    const char* key = _buffer.buf() + slot.offset;
+    return Entry(_version, key, slot.keySize, key + slot.keySize, slot.typeBitsSize);
+}
+
+}  // namespace mongo
@@ -0,0 +1,152 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/base/string_data.h"
+#include "mongo/bson/ordering.h"
+#include "mongo/bson/util/builder.h"
+#include "mongo/db/storage/key_string.h"
+
+namespace mongo {
+
+/**
+ * A sorted set of KeyStrings, and their TypeBits, stored back to back in a single buffer.
+ *
+ * This is the KeyString counterpart of the BSONObjSet filled by index key generation. A
+ * document's keys are appended with add(), then ordered and deduplicated once by finish(). Both
+ * the buffer and the entry table keep their capacity across clear(), so a set reused for every
+ * document of a write does not allocate once it has grown to fit the largest key set.
+ *
+ * Two keys are the same entry if both their KeyString bytes and their TypeBits are equal, which
+ * holds exactly when the BSON keys they encode are equal. Entries are ordered by KeyString bytes,
+ * the order in which the storage engine keeps them, and then by TypeBits.
+ */
+class KeyStringSet {
+    MONGO_DISALLOW_COPYING(KeyStringSet);
+
+public:
+    /**
+     * A view of one entry. Only valid until the set is next modified.
+     */
+    class Entry {
+    public:
+        Entry(KeyString::Version version,
+              const char* key,
+              size_t keySize,
+              const char* typeBits,
+              size_t typeBitsSize)
+            : _version(version),
+              _key(key),
+              _keySize(keySize),
+              _typeBits(typeBits),
+              _typeBitsSize(typeBitsSize) {}
+
+        const char* getBuffer() const {
+            return _key;
+        }
+
+        size_t getSize() const {
+            return _keySize;
+        }
+
+        KeyString::TypeBits getTypeBits() const;
+
+        /**
+         * Decodes the entry into the BSON key, without field names, that it encodes.
+         */
+        BSONObj toBson(Ordering ord) const {
+            return KeyString::toBson(_key, _keySize, ord, getTypeBits());
+        }
+
+    private:
+        KeyString::Version _version;
+        const char* _key;
+        size_t _keySize;
+        const char* _typeBits;
+        size_t _typeBitsSize;
+    };
+
+    explicit KeyStringSet(KeyString::Version version) : _version(version) {}
+
+    KeyString::Version getVersion() const {
+        return _version;
+    }
+
+    /**
+     * Appends a copy of 'keyString', which must be of this set's version. Call finish() before
+     * reading the set.
+     */
+    void add(const KeyString& keyString);
+
+    /**
+     * Sorts the entries added since the last call and removes duplicates.
+     */
+    void finish();
+
+    /**
+     * Removes all entries, keeping the allocated memory for reuse.
+     */
+    void clear() {
+        _buffer.reset();
+        _entries.clear();
+        _finished = true;
+    }
+
+    size_t size() const {
+        return _entries.size();
+    }
+
+    bool empty() const {
+        return _entries.empty();
+    }
+
+    Entry operator[](size_t i) const;
+
+private:
+    struct Slot {
+        uint32_t offset;
+        uint32_t keySize;
+        uint32_t typeBitsSize;
+    };
+
+    int _compare(const Slot& lhs, const Slot& rhs) const;
+
+    const KeyString::Version _version;
+
+    // The KeyString bytes of each entry, each followed by its TypeBits.
+    BufBuilder _buffer;
+    std::vector<Slot> _entries;
+    bool _finished = true;
+};
+
+}  // namespace mongo
@@ -0,0 +1,145 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+
+#include "mongo/db/storage/key_string.h"
+#include "mongo/platform/endian.h"
+#include "mongo/util/bufreader.h"
+#include "mongo/util/shared_buffer.h"
+
+namespace mongo {
+
+/**
+ * An owned, immutable copy of a KeyString and its TypeBits, laid out for the external Sorter.
+ *
+ * Index builds normalize each generated key into a KeyString once, when it is added to the
+ * Sorter, so every comparison made while sorting and merging is a memcmp of the encoded bytes
+ * rather than a type-aware BSONObj::woCompare() under an Ordering. The KeyString is expected to
+ * have the RecordId appended, which makes that byte order the total order needed by the index
+ * and lets storage engines that store KeyStrings insert the bytes without re-encoding them.
+ *
+ * The first bytes of the key are additionally cached in the object as a big-endian integer so
+ * that most comparisons are decided without touching the out-of-line buffer.
+ */
+class KeyStringSortKey {
+public:
+    KeyStringSortKey() = default;
+
+    explicit KeyStringSortKey(const KeyString& keyString)
+        : _keySize(keyString.getSize()),
+          _typeBitsSize(keyString.getTypeBits().getSize()),
+          _version(keyString.version),
+          _buffer(SharedBuffer::allocate(_keySize + _typeBitsSize)) {
+        memcpy(_buffer.get(), keyString.getBuffer(), _keySize);
+        memcpy(_buffer.get() + _keySize, keyString.getTypeBits().getBuffer(), _typeBitsSize);
+        _cachePrefix();
+    }
+
+    const char* getBuffer() const {
+        return _buffer.get();
+    }
+
+    size_t getSize() const {
+        return _keySize;
+    }
+
+    KeyString::Version getVersion() const {
+        return _version;
+    }
+
+    KeyString::TypeBits getTypeBits() const {
+        BufReader reader(_buffer.get() + _keySize, _typeBitsSize);
+        return KeyString::TypeBits::fromBuffer(_version, &reader);
+    }
+
+    /**
+     * Decodes the key back into the BSONObj the index key generator produced, minus field names.
+     */
+    BSONObj toBson(Ordering ord) const {
+        return KeyString::toBson(getBuffer(), getSize(), ord, getTypeBits());
+    }
+
+    int compare(const KeyStringSortKey& other) const {
+        if (_prefix != other._prefix)
+            return _prefix < other._prefix ? -1 : 1;
+
+        // Equal prefixes mean the bytes they cover are equal in both keys.
+        const size_t knownPrefixSize = std::min(kPrefixBytes, std::min(_keySize, other._keySize));
+        return KeyString::compareBuffers(
+            getBuffer(), _keySize, other.getBuffer(), other._keySize, knownPrefixSize, nullptr);
+    }
+
+    /// members for Sorter
+    struct SorterDeserializeSettings {};  // unused
+    void serializeForSorter(BufBuilder& buf) const {
+        buf.appendChar(static_cast<char>(_version));
+        buf.appendNum(static_cast<int>(_keySize));
+        buf.appendNum(static_cast<int>(_typeBitsSize));
+        buf.appendBuf(_buffer.get(), _keySize + _typeBitsSize);
+    }
+    static KeyStringSortKey deserializeForSorter(BufReader& buf, const SorterDeserializeSettings&) {
+        KeyStringSortKey out;
+        out._version = static_cast<KeyString::Version>(buf.read<char>());
+        out._keySize = buf.read<LittleEndian<int>>();
+        out._typeBitsSize = buf.read<LittleEndian<int>>();
+        const size_t totalSize = out._keySize + out._typeBitsSize;
+        out._buffer = SharedBuffer::allocate(totalSize);
+        memcpy(out._buffer.get(), buf.skip(totalSize), totalSize);
+        out._cachePrefix();
+        return out;
+    }
+    int memUsageForSorter() const {
+        return sizeof(KeyStringSortKey) + _keySize + _typeBitsSize;
+    }
+    KeyStringSortKey getOwned() const {
+        // The buffer is immutable and reference counted, so copies can share it.
+        return *this;
+    }
+
+private:
+    static constexpr size_t kPrefixBytes = sizeof(uint64_t);
+
+    void _cachePrefix() {
+        uint64_t prefix = 0;
+        memcpy(&prefix, _buffer.get(), std::min(kPrefixBytes, _keySize));
+        _prefix = endian::bigToNative(prefix);
+    }
+
+    uint64_t _prefix = 0;
+    size_t _keySize = 0;
+    size_t _typeBitsSize = 0;
+    KeyString::Version _version = KeyString::kLatestVersion;
+    SharedBuffer _buffer;
+};
+
+}  // namespace mongo
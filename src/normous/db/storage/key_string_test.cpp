@@ -34,9 +34,11 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <limits>
 #include <memory>
 #include <random>
+#include <set>
 #include <typeinfo>
 #include <vector>
 
@@ -46,6 +48,8 @@
 #include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/config.h"
 #include "mongo/db/storage/key_string.h"
+#include "mongo/db/storage/key_string_set.h"
+#include "mongo/db/storage/key_string_sort_key.h"
 #include "mongo/platform/decimal128.h"
 #include "mongo/stdx/functional.h"
 #include "mongo/stdx/future.h"
@@ -370,6 +374,43 @@ TEST_F(KeyStringTest, Undef1) {
     ROUNDTRIP(version, BSON("" << BSONUndefined));
 }
 
+TEST(KeyStringCommonPrefixTest, FindsFirstDifferenceAtEveryOffset) {
+    // Cover offsets inside and across the vectorized, word-sized and byte-sized comparison steps.
+    const size_t kSize = 70;
+    std::string lhs(kSize, 'a');
+    for (size_t i = 0; i < kSize; ++i) {
+        std::string rhs = lhs;
+        rhs[i] = 'b';
+        ASSERT_EQ(i, KeyString::commonPrefixSize(lhs.data(), rhs.data(), kSize));
+        ASSERT_EQ(std::min(i, size_t(5)), KeyString::commonPrefixSize(lhs.data(), rhs.data(), 5));
+    }
+    ASSERT_EQ(kSize, KeyString::commonPrefixSize(lhs.data(), lhs.data(), kSize));
+    ASSERT_EQ(0U, KeyString::commonPrefixSize(lhs.data(), lhs.data(), 0));
+}
+
+TEST_F(KeyStringTest, CompareWithKnownPrefixMatchesCompare) {
+    const std::string prefix(40, 'x');
+    std::vector<BSONObj> objs;
+    for (auto&& suffix : {"a", "ab", "b", "", "\xff"}) {
+        objs.push_back(BSON("" << prefix << "" << prefix + suffix << "" << 1));
+    }
+    objs.push_back(BSON("" << prefix));
+
+    for (auto&& lhsObj : objs) {
+        for (auto&& rhsObj : objs) {
+            const KeyString lhs(version, lhsObj, ALL_ASCENDING);
+            const KeyString rhs(version, rhsObj, ALL_ASCENDING);
+            size_t commonPrefix = 0;
+            const int cmp = lhs.compareWithKnownPrefix(rhs, 0, &commonPrefix);
+            ASSERT_EQ(lhs.compare(rhs), cmp);
+            ASSERT_EQ(0, std::memcmp(lhs.getBuffer(), rhs.getBuffer(), commonPrefix));
+
+            // Passing back the common prefix must not change the result.
+            ASSERT_EQ(cmp, lhs.compareWithKnownPrefix(rhs, commonPrefix, nullptr));
+        }
+    }
+}
+
 TEST_F(KeyStringTest, NumberLong0) {
     double d = (1ll << 52) - 1;
     long long ll = static_cast<long long>(d);
@@ -1629,6 +1670,117 @@ TEST_F(KeyStringTest, DecimalFromUniformDoublePerf) {
     perfTest(version, numbers);
 }
 
+TEST_F(KeyStringTest, SortKeyOrderMatchesBSONOrderThenRecordId) {
+    const Ordering ord = Ordering::make(BSON("a" << -1 << "b" << 1));
+    const std::vector<BSONObj> keys = {
+        BSON("" << MINKEY << "" << 1),
+        BSON("" << 1 << "" << 2),
+        BSON("" << 1LL << "" << 2.5),
+        BSON("" << 2.0 << "" << "a"),
+        BSON("" << "abcdefgh" << "" << "a"),
+        BSON("" << "abcdefgh" << "" << "ab"),
+        BSON("" << "abcdefghi" << "" << "a"),
+        BSON("" << "abc" << "" << BSONNULL),
+        BSON("" << BSON("x" << 1) << "" << MAXKEY),
+    };
+    const std::vector<RecordId> ids = {RecordId(1), RecordId(2), RecordId(1LL << 40)};
+
+    std::vector<std::pair<BSONObj, RecordId>> entries;
+    for (auto&& key : keys) {
+        for (auto&& id : ids) {
+            entries.emplace_back(key, id);
+        }
+    }
+
+    auto sign = [](int x) { return x < 0 ? -1 : (x > 0 ? 1 : 0); };
+    for (auto&& l : entries) {
+        KeyStringSortKey lhs(KeyString(version, l.first, ord, l.second));
+        for (auto&& r : entries) {
+            KeyStringSortKey rhs(KeyString(version, r.first, ord, r.second));
+            int expected = l.first.woCompare(r.first, ord, /*considerFieldName*/ false);
+            if (expected == 0)
+                expected = l.second.compare(r.second);
+            ASSERT_EQ(sign(expected), sign(lhs.compare(rhs))) << l.first << " " << r.first;
+        }
+    }
+}
+
+TEST_F(KeyStringTest, SortKeyRoundTripsThroughSorterFormat) {
+    const BSONObj key = BSON("" << 5LL << "" << "str" << "" << -0.0);
+    KeyString ks(version, key, ALL_ASCENDING, RecordId(42));
+    KeyStringSortKey original(ks);
+
+    BufBuilder buf;
+    original.serializeForSorter(buf);
+    BufReader reader(buf.buf(), buf.len());
+    KeyStringSortKey copy = KeyStringSortKey::deserializeForSorter(
+        reader, KeyStringSortKey::SorterDeserializeSettings());
+    ASSERT_EQ(0U, reader.remaining());
+
+    ASSERT(copy.getVersion() == version);
+    ASSERT_EQ(0, copy.compare(original));
+    ASSERT_EQ(ks.getSize(), copy.getSize());
+    ASSERT_EQ(0, memcmp(ks.getBuffer(), copy.getBuffer(), ks.getSize()));
+    ASSERT_EQ(RecordId(42), KeyString::decodeRecordIdAtEnd(copy.getBuffer(), copy.getSize()));
+
+    // The TypeBits travel with the key, so the decoded BSON keeps the original numeric types.
+    BSONObj decoded = copy.toBson(ALL_ASCENDING);
+    ASSERT_BSONOBJ_EQ(key, decoded);
+    ASSERT_EQ(NumberLong, decoded.firstElement().type());
+}
+
+TEST_F(KeyStringTest, KeyStringSetSortsAndDeduplicates) {
+    KeyStringSet set(version);
+    for (int i : {3, 1, 2, 3, 1}) {
+        set.add(KeyString(version, BSON("" << i), ALL_ASCENDING));
+    }
+    set.finish();
+
+    ASSERT_EQ(3U, set.size());
+    for (int i = 0; i < 3; ++i) {
+        KeyString expected(version, BSON("" << i + 1), ALL_ASCENDING);
+        ASSERT_EQ(expected.getSize(), set[i].getSize());
+        ASSERT_EQ(0, memcmp(expected.getBuffer(), set[i].getBuffer(), expected.getSize()));
+        ASSERT_BSONOBJ_EQ(BSON("" << i + 1), set[i].toBson(ALL_ASCENDING));
+    }
+}
+
+TEST_F(KeyStringTest, KeyStringSetKeepsKeysThatDifferOnlyInTypeBits) {
+    KeyStringSet set(version);
+    set.add(KeyString(version, BSON("" << 1), ALL_ASCENDING));
+    set.add(KeyString(version, BSON("" << 1.0), ALL_ASCENDING));
+    set.add(KeyString(version, BSON("" << 1LL), ALL_ASCENDING));
+    set.add(KeyString(version, BSON("" << 1.0), ALL_ASCENDING));
+    set.finish();
+
+    // The three keys compare equal as KeyStrings but decode to different numeric types.
+    ASSERT_EQ(3U, set.size());
+    std::set<BSONType> types;
+    for (size_t i = 0; i < set.size(); ++i) {
+        ASSERT_EQ(0,
+                  KeyString(version, BSON("" << 1), ALL_ASCENDING)
+                      .compare(KeyString(version, set[i].toBson(ALL_ASCENDING), ALL_ASCENDING)));
+        types.insert(set[i].toBson(ALL_ASCENDING).firstElement().type());
+    }
+    ASSERT_EQ(3U, types.size());
+}
+
+TEST_F(KeyStringTest, KeyStringSetCanBeReusedAfterClear) {
+    KeyStringSet set(version);
+    set.add(KeyString(version, BSON("" << "b"), ALL_ASCENDING));
+    set.add(KeyString(version, BSON("" << "a"), ALL_ASCENDING));
+    set.finish();
+    ASSERT_EQ(2U, set.size());
+
+    set.clear();
+    ASSERT(set.empty());
+
+    set.add(KeyString(version, BSON("" << "c"), ALL_ASCENDING));
+    set.finish();
+    ASSERT_EQ(1U, set.size());
+    ASSERT_BSONOBJ_EQ(BSON("" << "c"), set[0].toBson(ALL_ASCENDING));
+}
+
 DEATH_TEST(KeyStringTest, ToBsonPromotesAssertionsToTerminate, "terminate() called") {
     const char invalidString[] = {
         60,  // CType::kStringLike
@@ -244,6 +244,13 @@ Status KVDatabaseCatalogEntryBase::createCollection(OperationContext* opCtx,
 void KVDatabaseCatalogEntryBase::initCollection(OperationContext* opCtx,
                                                 const std::string& ns,
                                                 bool forRepair) {
+    initCollection(opCtx, ns, _engine->getCatalog()->getMetaData(opCtx, ns), forRepair);
+}
+
+void KVDatabaseCatalogEntryBase::initCollection(OperationContext* opCtx,
+                                                const std::string& ns,
+                                                const BSONCollectionCatalogEntry::MetaData& md,
+                                                bool forRepair) {
     invariant(!_collections.count(ns));
 
     const std::string ident = _engine->getCatalog()->getCollectionIdent(ns);
@@ -254,7 +261,6 @@ void KVDatabaseCatalogEntryBase::initCollection(OperationContext* opCtx,
         // repaired. This also ensures that if we try to use it, it will blow up.
         rs = nullptr;
     } else {
-        BSONCollectionCatalogEntry::MetaData md = _engine->getCatalog()->getMetaData(opCtx, ns);
         rs = _engine->getEngine()->getGroupedRecordStore(opCtx, ns, ident, md.options, md.prefix);
         invariant(rs);
     }
@@ -33,6 +33,7 @@
 #include <string>
 
 #include "mongo/db/catalog/database_catalog_entry.h"
+#include "mongo/db/storage/bson_collection_catalog_entry.h"
 
 namespace mongo {
 
@@ -82,6 +83,15 @@ public:
 
     void initCollection(OperationContext* opCtx, const std::string& ns, bool forRepair);
 
+    /**
+     * Same as above, but uses catalog metadata the caller has already read for 'ns' instead of
+     * parsing the catalog entry again.
+     */
+    void initCollection(OperationContext* opCtx,
+                        const std::string& ns,
+                        const BSONCollectionCatalogEntry::MetaData& md,
+                        bool forRepair);
+
     void initCollectionBeforeRepair(OperationContext* opCtx, const std::string& ns);
     void reinitCollectionAfterRepair(OperationContext* opCtx, const std::string& ns);
 
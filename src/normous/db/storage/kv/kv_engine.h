@@ -40,6 +40,7 @@
 #include "mongo/db/catalog/collection_options.h"
 #include "mongo/db/storage/kv/kv_prefix.h"
 #include "mongo/db/storage/record_store.h"
+#include "mongo/db/storage/storage_engine.h"
 
 namespace mongo {
 
@@ -218,7 +219,11 @@ public:
         MONGO_UNREACHABLE;
     }
 
-    virtual StatusWith<std::vector<std::string>> beginNonBlockingBackup(OperationContext* opCtx) {
+    /**
+     * See StorageEngine::beginNonBlockingBackup for details
+     */
+    virtual StatusWith<std::vector<StorageEngine::BackupFile>> beginNonBlockingBackup(
+        OperationContext* opCtx, const StorageEngine::BackupOptions& options) {
         return Status(ErrorCodes::CommandNotSupported,
                       "The current storage engine doesn't support backup mode");
     }
@@ -254,6 +259,14 @@ public:
         return true;
     }
 
+    /**
+     * Returns whether record stores created for CollectionOptions with 'clustered' set key their
+     * records by the documents' _id. This must not change over the lifetime of the engine.
+     */
+    virtual bool supportsClusteredCollections() const {
+        return false;
+    }
+
     /**
      * Returns true if storage engine supports --directoryperdb.
      * See:
@@ -238,9 +238,11 @@ void KVStorageEngine::loadCatalog(OperationContext* opCtx) {
             db = _databaseCatalogEntryFactory(dbName, this).release();
         }
 
-        db->initCollection(opCtx, coll, _options.forRepair);
-        auto maxPrefixForCollection = _catalog->getMetaData(opCtx, coll).getMaxPrefix();
-        maxSeenPrefix = std::max(maxSeenPrefix, maxPrefixForCollection);
+        // Parse the catalog entry once and share it between opening the record store and
+        // tracking the largest prefix; with many collections this parse dominates startup.
+        const BSONCollectionCatalogEntry::MetaData md = _catalog->getMetaData(opCtx, coll);
+        db->initCollection(opCtx, coll, md, _options.forRepair);
+        maxSeenPrefix = std::max(maxSeenPrefix, md.getMaxPrefix());
 
         if (nss.isOrphanCollection()) {
             log() << "Orphaned collection found: " << nss;
@@ -585,9 +587,9 @@ void KVStorageEngine::endBackup(OperationContext* opCtx) {
     _inBackupMode = false;
 }
 
-StatusWith<std::vector<std::string>> KVStorageEngine::beginNonBlockingBackup(
-    OperationContext* opCtx) {
-    return _engine->beginNonBlockingBackup(opCtx);
+StatusWith<std::vector<StorageEngine::BackupFile>> KVStorageEngine::beginNonBlockingBackup(
+    OperationContext* opCtx, const BackupOptions& options) {
+    return _engine->beginNonBlockingBackup(opCtx, options);
 }
 
 void KVStorageEngine::endNonBlockingBackup(OperationContext* opCtx) {
@@ -656,6 +658,10 @@ void KVStorageEngine::setCachePressureForTest(int pressure) {
     return _engine->setCachePressureForTest(pressure);
 }
 
+bool KVStorageEngine::supportsClusteredCollections() const {
+    return _engine->supportsClusteredCollections();
+}
+
 bool KVStorageEngine::supportsRecoverToStableTimestamp() const {
     return _engine->supportsRecoverToStableTimestamp();
 }
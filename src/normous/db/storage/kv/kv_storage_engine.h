@@ -100,6 +100,8 @@ public:
         return _supportsCappedCollections;
     }
 
+    bool supportsClusteredCollections() const override;
+
     virtual Status closeDatabase(OperationContext* opCtx, StringData db);
 
     virtual Status dropDatabase(OperationContext* opCtx, StringData db);
@@ -110,7 +112,8 @@ public:
 
     virtual void endBackup(OperationContext* opCtx);
 
-    virtual StatusWith<std::vector<std::string>> beginNonBlockingBackup(OperationContext* opCtx);
+    virtual StatusWith<std::vector<BackupFile>> beginNonBlockingBackup(
+        OperationContext* opCtx, const BackupOptions& options);
 
     virtual void endNonBlockingBackup(OperationContext* opCtx);
 
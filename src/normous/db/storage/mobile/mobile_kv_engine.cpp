@@ -37,7 +37,9 @@
 #include <vector>
 
 #include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/client.h"
 #include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/storage/mobile/mobile_index.h"
 #include "mongo/db/storage/mobile/mobile_kv_engine.h"
 #include "mongo/db/storage/mobile/mobile_record_store.h"
@@ -46,14 +48,78 @@
 #include "mongo/db/storage/mobile/mobile_sqlite_statement.h"
 #include "mongo/db/storage/mobile/mobile_util.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/util/background.h"
+#include "mongo/util/concurrency/idle_thread_block.h"
 #include "mongo/util/log.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
 class MobileSession;
 class SqliteStatement;
 
+namespace {
+
+// Number of idle prepared statements each SQLite connection keeps for reuse. 0 disables caching.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(mobileStatementCacheSize, int, 32)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0) {
+            return Status(ErrorCodes::BadValue,
+                          "mobileStatementCacheSize must be greater than or equal to 0");
+        }
+        return Status::OK();
+    });
+
+// When 0, every commit syncs the WAL. Otherwise commits are not synced individually, and the WAL
+// is checkpointed at this interval, so that a power loss loses at most about this much work.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(mobileDurabilityWindowMs, int, 0)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0) {
+            return Status(ErrorCodes::BadValue,
+                          "mobileDurabilityWindowMs must be greater than or equal to 0");
+        }
+        return Status::OK();
+    });
+
+}  // namespace
+
+class MobileKVEngine::MobileDurabilityFlusher : public BackgroundJob {
+public:
+    MobileDurabilityFlusher(MobileSessionPool* sessionPool, Milliseconds interval)
+        : BackgroundJob(false /* deleteSelf */), _sessionPool(sessionPool), _interval(interval) {}
+
+    std::string name() const override {
+        return "MobileDurabilityFlusher";
+    }
+
+    void run() override {
+        Client::initThread(name().c_str());
+        ON_BLOCK_EXIT([] { Client::destroy(); });
+
+        LOG(1) << "starting " << name() << " thread";
+
+        while (!_shuttingDown.load()) {
+            {
+                MONGO_IDLE_THREAD_BLOCK;
+                sleepFor(_interval);
+            }
+            _sessionPool->checkpointWAL();
+        }
+        LOG(1) << "stopping " << name() << " thread";
+    }
+
+    void shutdown() {
+        _shuttingDown.store(true);
+        wait();
+    }
+
+private:
+    MobileSessionPool* const _sessionPool;
+    const Milliseconds _interval;
+    AtomicBool _shuttingDown{false};
+};
+
 MobileKVEngine::MobileKVEngine(const std::string& path) {
     _initDBPath(path);
 
@@ -134,7 +200,39 @@ MobileKVEngine::MobileKVEngine(const std::string& path) {
                                   << ". Val: " << fullfsync_val;
     }
 
-    _sessionPool.reset(new MobileSessionPool(_path));
+    MobileSessionPool::Options options;
+    options.statementCacheSize = mobileStatementCacheSize;
+    options.syncEveryCommit = mobileDurabilityWindowMs == 0;
+    _sessionPool.reset(new MobileSessionPool(_path, options));
+
+    if (!options.syncEveryCommit) {
+        log() << "MobileSE: Commits are synced by WAL checkpoints every "
+              << mobileDurabilityWindowMs << "ms";
+        _durabilityFlusher = stdx::make_unique<MobileDurabilityFlusher>(
+            _sessionPool.get(), Milliseconds(mobileDurabilityWindowMs));
+        _durabilityFlusher->go();
+    }
+}
+
+MobileKVEngine::~MobileKVEngine() {
+    if (_durabilityFlusher) {
+        _durabilityFlusher->shutdown();
+    }
+}
+
+int MobileKVEngine::flushAllFiles(OperationContext* opCtx, bool sync) {
+    if (!_sessionPool->getOptions().syncEveryCommit) {
+        _sessionPool->checkpointWAL();
+    }
+    return 0;
+}
+
+void MobileKVEngine::cleanShutdown() {
+    if (_durabilityFlusher) {
+        _durabilityFlusher->shutdown();
+        _durabilityFlusher.reset();
+        _sessionPool->checkpointWAL();
+    }
 }
 
 void MobileKVEngine::_initDBPath(const std::string& path) {
@@ -44,6 +44,8 @@ class MobileKVEngine : public KVEngine {
 public:
     MobileKVEngine(const std::string& path);
 
+    ~MobileKVEngine() override;
+
     RecoveryUnit* newRecoveryUnit() override;
 
     Status createRecordStore(OperationContext* opCtx,
@@ -93,11 +95,10 @@ public:
     }
 
     /**
-     * Flush is a no-op since SQLite transactions are durable by default after each commit.
+     * SQLite transactions are durable after each commit by default, in which case this is a no-op.
+     * When commits are not synced, this checkpoints the WAL.
      */
-    int flushAllFiles(OperationContext* opCtx, bool sync) override {
-        return 0;
-    }
+    int flushAllFiles(OperationContext* opCtx, bool sync) override;
 
     bool isEphemeral() const override {
         return false;
@@ -109,7 +110,7 @@ public:
         return Status::OK();
     }
 
-    void cleanShutdown() override{};
+    void cleanShutdown() override;
 
     bool hasIdent(OperationContext* opCtx, StringData ident) const override;
 
@@ -125,11 +126,16 @@ public:
     }
 
 private:
+    class MobileDurabilityFlusher;
+
     mutable stdx::mutex _mutex;
     void _initDBPath(const std::string& path);
 
     std::unique_ptr<MobileSessionPool> _sessionPool;
 
+    // Bounds how long unsynced commits stay volatile. Only runs if mobileDurabilityWindowMs is set.
+    std::unique_ptr<MobileDurabilityFlusher> _durabilityFlusher;
+
     // Notified when we write as everything is considered "journalled" since repl depends on it.
     JournalListener* _journalListener = &NoOpJournalListener::instance;
 
@@ -125,6 +125,14 @@ void MobileRecoveryUnit::abortUnitOfWork() {
     _abort();
 }
 
+bool MobileRecoveryUnit::waitUntilDurable() {
+    // Unless commits are synced when they happen, they become durable at the next checkpoint.
+    if (!_sessionPool->getOptions().syncEveryCommit) {
+        _sessionPool->checkpointWAL();
+    }
+    return true;
+}
+
 void MobileRecoveryUnit::abandonSnapshot() {
     invariant(!_inUnitOfWork);
     if (_active) {
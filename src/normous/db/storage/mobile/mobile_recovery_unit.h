@@ -54,9 +54,7 @@ public:
     void commitUnitOfWork() override;
     void abortUnitOfWork() override;
 
-    bool waitUntilDurable() override {
-        return true;
-    }
+    bool waitUntilDurable() override;
 
     void abandonSnapshot() override;
 
@@ -70,7 +68,7 @@ public:
 
     MobileSession* getSessionNoTxn(OperationContext* opCtx);
 
-    bool inActiveTxn() const {
+    bool inActiveTxn() const override {
         return _active;
     }
 
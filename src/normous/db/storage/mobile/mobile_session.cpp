@@ -35,8 +35,10 @@
 
 namespace mongo {
 
-MobileSession::MobileSession(sqlite3* session, MobileSessionPool* sessionPool)
-    : _session(session), _sessionPool(sessionPool) {}
+MobileSession::MobileSession(sqlite3* session,
+                             MobileSessionPool* sessionPool,
+                             SqliteStatementCache* statementCache)
+    : _session(session), _sessionPool(sessionPool), _statementCache(statementCache) {}
 
 MobileSession::~MobileSession() {
     // Releases this session back to the session pool.
@@ -36,6 +36,7 @@
 
 namespace mongo {
 class MobileSessionPool;
+class SqliteStatementCache;
 
 /**
  * This class manages a SQLite database connection object.
@@ -44,7 +45,9 @@ class MobileSession final {
     MONGO_DISALLOW_COPYING(MobileSession);
 
 public:
-    MobileSession(sqlite3* session, MobileSessionPool* sessionPool);
+    MobileSession(sqlite3* session,
+                  MobileSessionPool* sessionPool,
+                  SqliteStatementCache* statementCache = nullptr);
 
     ~MobileSession();
 
@@ -53,8 +56,17 @@ public:
      */
     sqlite3* getSession() const;
 
+    /**
+     * Returns the prepared statement cache of the underlying connection, or nullptr if statements
+     * prepared with this session should not be cached.
+     */
+    SqliteStatementCache* getStatementCache() const {
+        return _statementCache;
+    }
+
 private:
     sqlite3* _session;
     MobileSessionPool* _sessionPool;
+    SqliteStatementCache* _statementCache;
 };
 }  // namespace mongo
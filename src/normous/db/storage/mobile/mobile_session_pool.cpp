@@ -95,7 +95,14 @@ bool MobileDelayedOpQueue::isEmpty() {
 }
 
 MobileSessionPool::MobileSessionPool(const std::string& path, std::uint64_t maxPoolSize)
-    : _path(path), _maxPoolSize(maxPoolSize) {}
+    : MobileSessionPool(path, [&] {
+          Options options;
+          options.maxPoolSize = maxPoolSize;
+          return options;
+      }()) {}
+
+MobileSessionPool::MobileSessionPool(const std::string& path, const Options& options)
+    : _path(path), _options(options) {}
 
 MobileSessionPool::~MobileSessionPool() {
     shutDown();
@@ -110,17 +117,14 @@ std::unique_ptr<MobileSession> MobileSessionPool::getSession(OperationContext* o
 
     // Checks if there is an open session available.
     if (!_sessions.empty()) {
-        sqlite3* session = _popSession_inlock();
-        return stdx::make_unique<MobileSession>(session, this);
+        return _makeSession_inlock(_popSession_inlock());
     }
 
     // Checks if a new session can be opened.
-    if (_curPoolSize < _maxPoolSize) {
-        sqlite3* session;
-        int status = sqlite3_open(_path.c_str(), &session);
-        checkStatus(status, SQLITE_OK, "sqlite3_open");
+    if (_curPoolSize < _options.maxPoolSize) {
+        sqlite3* session = _openSession_inlock();
         _curPoolSize++;
-        return stdx::make_unique<MobileSession>(session, this);
+        return _makeSession_inlock(session);
     }
 
     // There are no open sessions available and the maxPoolSize has been reached.
@@ -128,8 +132,7 @@ std::unique_ptr<MobileSession> MobileSessionPool::getSession(OperationContext* o
     opCtx->waitForConditionOrInterrupt(
         _releasedSessionNotifier, lk, [&] { return !_sessions.empty(); });
 
-    sqlite3* session = _popSession_inlock();
-    return stdx::make_unique<MobileSession>(session, this);
+    return _makeSession_inlock(_popSession_inlock());
 }
 
 void MobileSessionPool::releaseSession(MobileSession* session) {
@@ -172,11 +175,36 @@ void MobileSessionPool::shutDown() {
         sqlite3_close(session);
     }
 
+    {
+        stdx::lock_guard<stdx::mutex> checkpointLock(_checkpointMutex);
+        if (_checkpointSession) {
+            sqlite3_close(_checkpointSession);
+            _checkpointSession = nullptr;
+        }
+    }
+
+    // Cached statements must be finalized before their connections can be closed.
+    _statementCaches.clear();
     for (auto&& session : _sessions) {
         sqlite3_close(session);
     }
 }
 
+void MobileSessionPool::checkpointWAL() {
+    stdx::lock_guard<stdx::mutex> lk(_checkpointMutex);
+    if (!_checkpointSession) {
+        int status = sqlite3_open(_path.c_str(), &_checkpointSession);
+        checkStatus(status, SQLITE_OK, "sqlite3_open");
+    }
+
+    int status = sqlite3_wal_checkpoint_v2(
+        _checkpointSession, NULL, SQLITE_CHECKPOINT_PASSIVE, NULL, NULL);
+
+    // SQLITE_BUSY means another connection is checkpointing right now, which serves as well.
+    if (status != SQLITE_BUSY)
+        checkStatus(status, SQLITE_OK, "sqlite3_wal_checkpoint_v2");
+}
+
 // This method should only be called when _sessions is locked.
 sqlite3* MobileSessionPool::_popSession_inlock() {
     sqlite3* session = _sessions.back();
@@ -184,4 +212,31 @@ sqlite3* MobileSessionPool::_popSession_inlock() {
     return session;
 }
 
+sqlite3* MobileSessionPool::_openSession_inlock() {
+    sqlite3* session;
+    int status = sqlite3_open(_path.c_str(), &session);
+    checkStatus(status, SQLITE_OK, "sqlite3_open");
+
+    if (!_options.syncEveryCommit) {
+        // The synchronous setting is per connection. In WAL mode, NORMAL still keeps the database
+        // consistent across power loss, but only checkpoints sync the WAL.
+        char* errMsg = NULL;
+        status = sqlite3_exec(session, "PRAGMA synchronous = NORMAL;", NULL, NULL, &errMsg);
+        checkStatus(status, SQLITE_OK, "sqlite3_exec", errMsg);
+        sqlite3_free(errMsg);
+    }
+
+    if (_options.statementCacheSize > 0) {
+        _statementCaches[session] =
+            stdx::make_unique<SqliteStatementCache>(_options.statementCacheSize);
+    }
+    return session;
+}
+
+std::unique_ptr<MobileSession> MobileSessionPool::_makeSession_inlock(sqlite3* session) {
+    auto it = _statementCaches.find(session);
+    SqliteStatementCache* cache = it == _statementCaches.end() ? nullptr : it->second.get();
+    return stdx::make_unique<MobileSession>(session, this, cache);
+}
+
 }  // namespace mongo
@@ -37,9 +37,11 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/storage/mobile/mobile_session.h"
 #include "mongo/stdx/mutex.h"
+#include "mongo/stdx/unordered_map.h"
 
 namespace mongo {
 class MobileSession;
+class SqliteStatementCache;
 
 /**
  * This class manages a queue of operations delayed for some reason
@@ -67,8 +69,22 @@ class MobileSessionPool final {
     MONGO_DISALLOW_COPYING(MobileSessionPool);
 
 public:
+    struct Options {
+        std::uint64_t maxPoolSize = 80;
+
+        // Number of idle prepared statements kept per connection. 0 disables statement caching.
+        std::size_t statementCacheSize = 0;
+
+        // When false, connections run with "PRAGMA synchronous = NORMAL", so that committing a
+        // transaction does not fsync the WAL. Such commits only become durable at the next WAL
+        // checkpoint, which the owner of the pool is expected to run periodically.
+        bool syncEveryCommit = true;
+    };
+
     MobileSessionPool(const std::string& path, std::uint64_t maxPoolSize = 80);
 
+    MobileSessionPool(const std::string& path, const Options& options);
+
     ~MobileSessionPool();
 
     /**
@@ -87,6 +103,18 @@ public:
      */
     void shutDown();
 
+    const Options& getOptions() const {
+        return _options;
+    }
+
+    /**
+     * Runs a passive WAL checkpoint on a connection dedicated to this purpose. The checkpoint syncs
+     * the WAL before copying frames back into the database, so it makes commits that were not
+     * synced themselves durable. Frames still needed by an open read transaction are left to a
+     * later checkpoint.
+     */
+    void checkpointWAL();
+
     // Failed drops get queued here and get re-tried periodically
     MobileDelayedOpQueue failedDropsQueue;
 
@@ -96,6 +124,13 @@ private:
      */
     sqlite3* _popSession_inlock();
 
+    /**
+     * Opens a new connection to the database, configured according to _options.
+     */
+    sqlite3* _openSession_inlock();
+
+    std::unique_ptr<MobileSession> _makeSession_inlock(sqlite3* session);
+
     // This is used to lock the _sessions vector.
     stdx::mutex _mutex;
     stdx::condition_variable _releasedSessionNotifier;
@@ -105,11 +140,18 @@ private:
     /**
      * PoolSize is the number of open sessions associated with the session pool.
      */
-    std::uint64_t _maxPoolSize = 80;
+    const Options _options;
     std::uint64_t _curPoolSize = 0;
     bool _shuttingDown = false;
 
     using SessionPool = std::vector<sqlite3*>;
     SessionPool _sessions;
+
+    // Guards _checkpointSession, which is opened by the first call to checkpointWAL().
+    stdx::mutex _checkpointMutex;
+    sqlite3* _checkpointSession = nullptr;
+
+    // The statement cache of each open connection, if statement caching is enabled.
+    stdx::unordered_map<sqlite3*, std::unique_ptr<SqliteStatementCache>> _statementCaches;
 };
 }  // namespace mongo
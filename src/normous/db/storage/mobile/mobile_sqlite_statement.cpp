@@ -44,6 +44,36 @@
 
 namespace mongo {
 
+SqliteStatementCache::~SqliteStatementCache() {
+    clear();
+}
+
+sqlite3_stmt* SqliteStatementCache::take(const std::string& sqlQuery) {
+    for (auto it = _statements.begin(); it != _statements.end(); ++it) {
+        if (it->first == sqlQuery) {
+            sqlite3_stmt* stmt = it->second;
+            _statements.erase(it);
+            return stmt;
+        }
+    }
+    return nullptr;
+}
+
+void SqliteStatementCache::put(const std::string& sqlQuery, sqlite3_stmt* stmt) {
+    _statements.emplace_front(sqlQuery, stmt);
+    if (_statements.size() > _capacity) {
+        sqlite3_finalize(_statements.back().second);
+        _statements.pop_back();
+    }
+}
+
+void SqliteStatementCache::clear() {
+    for (auto&& entry : _statements) {
+        sqlite3_finalize(entry.second);
+    }
+    _statements.clear();
+}
+
 AtomicInt64 SqliteStatement::_nextID(0);
 
 SqliteStatement::SqliteStatement(const MobileSession& session, const std::string& sqlQuery) {
@@ -58,6 +88,16 @@ void SqliteStatement::finalize() {
     if (!_stmt) {
         return;
     }
+
+    // A statement that has not failed can be reused by later statements with the same query.
+    if (_cache && _exceptionStatus == SQLITE_OK && sqlite3_reset(_stmt) == SQLITE_OK &&
+        sqlite3_clear_bindings(_stmt) == SQLITE_OK) {
+        SQLITE_STMT_TRACE() << "Caching: " << _sqlQuery;
+        _cache->put(_sqlQuery, _stmt);
+        _stmt = NULL;
+        return;
+    }
+
     SQLITE_STMT_TRACE() << "Finalize: " << _sqlQuery;
 
     int status = sqlite3_finalize(_stmt);
@@ -66,6 +106,15 @@ void SqliteStatement::finalize() {
 }
 
 void SqliteStatement::prepare(const MobileSession& session) {
+    _cache = session.getStatementCache();
+    if (_cache) {
+        _stmt = _cache->take(_sqlQuery);
+        if (_stmt) {
+            SQLITE_STMT_TRACE() << "Reusing cached statement: " << _sqlQuery;
+            return;
+        }
+    }
+
     SQLITE_STMT_TRACE() << "Preparing: " << _sqlQuery;
 
     int status = sqlite3_prepare_v2(
@@ -28,14 +28,58 @@
 
 #pragma once
 
+#include <list>
 #include <sqlite3.h>
 #include <string>
 
 #include "mongo/db/storage/mobile/mobile_session.h"
+#include "mongo/base/disallow_copying.h"
 #include "mongo/platform/atomic_word.h"
 
 namespace mongo {
 
+/**
+ * SqliteStatementCache keeps idle prepared statements of one SQLite connection, keyed by their SQL
+ * text, so that statements which are executed over and over do not have to be re-prepared each
+ * time. Every MobileSession wraps the same connection for as long as it holds it, so a cache is
+ * only ever used by one thread at a time and is not synchronized. Statements that are in use are
+ * not in the cache; a query that is executed by several statements at once simply has several
+ * cache entries.
+ */
+class SqliteStatementCache final {
+    MONGO_DISALLOW_COPYING(SqliteStatementCache);
+
+public:
+    explicit SqliteStatementCache(size_t capacity) : _capacity(capacity) {}
+
+    /**
+     * Finalizes all cached statements. Must be called before the connection is closed.
+     */
+    ~SqliteStatementCache();
+
+    /**
+     * Removes and returns a cached statement for 'sqlQuery', or returns nullptr if there is none.
+     */
+    sqlite3_stmt* take(const std::string& sqlQuery);
+
+    /**
+     * Caches 'stmt', which must be reset and have no bindings, as a prepared statement for
+     * 'sqlQuery'. Once the cache is full, this finalizes the least recently cached statement.
+     */
+    void put(const std::string& sqlQuery, sqlite3_stmt* stmt);
+
+    /**
+     * Finalizes all cached statements.
+     */
+    void clear();
+
+private:
+    const size_t _capacity;
+
+    // Most recently cached statements first.
+    std::list<std::pair<std::string, sqlite3_stmt*>> _statements;
+};
+
 /**
  * SqliteStatement is a wrapper around the sqlite3_stmt object. All calls to the SQLite API that
  * involve a sqlite_stmt object are made in this class.
@@ -117,12 +161,14 @@ public:
     static void execQuery(MobileSession* session, const std::string& query);
 
     /**
-     * Finalizes a prepared statement.
+     * Finalizes a prepared statement. If it was prepared with a session that has a statement
+     * cache and it is not in an error state, it is reset and returned to that cache instead.
      */
     void finalize();
 
     /**
-     * Prepare a statement with the given mobile session.
+     * Prepare a statement with the given mobile session, reusing one from the session's statement
+     * cache if possible.
      */
     void prepare(const MobileSession& session);
 
@@ -133,6 +179,9 @@ private:
     sqlite3_stmt* _stmt;
     std::string _sqlQuery;
 
+    // The cache of the session this statement was prepared with, if any.
+    SqliteStatementCache* _cache = nullptr;
+
     // If the most recent call to sqlite3_step on this statement returned an error, the error is
     // returned again when the statement is finalized. This is used to verify that the last error
     // code returned matches the finalize error code, if there is any.
@@ -31,6 +31,7 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <vector>
 
 #include "mongo/base/owned_pointer_vector.h"
 #include "mongo/bson/mutable/damage_vector.h"
@@ -202,6 +203,29 @@ public:
      */
     virtual boost::optional<Record> seekExact(const RecordId& id) = 0;
 
+    /**
+     * Seeks to each of the Records with the provided ids. The returned vector has one entry per
+     * element of 'ids', in the same order, holding boost::none for ids that could not be found.
+     *
+     * Unlike seekExact(), the returned RecordData is always owned, so it remains valid after
+     * further calls on this cursor. The ids do not need to be sorted or unique; implementations
+     * are free to perform the underlying lookups in whichever order is cheapest.
+     *
+     * The resulting position of the cursor is unspecified.
+     */
+    virtual std::vector<boost::optional<Record>> seekExactBatch(const std::vector<RecordId>& ids) {
+        std::vector<boost::optional<Record>> out;
+        out.reserve(ids.size());
+        for (auto&& id : ids) {
+            auto record = seekExact(id);
+            if (record) {
+                record->data.makeOwned();
+            }
+            out.push_back(std::move(record));
+        }
+        return out;
+    }
+
     /**
      * Prepares for state changes in underlying data without necessarily saving the current
      * state.
@@ -264,6 +288,32 @@ public:
 
     virtual bool isCapped() const = 0;
 
+    /**
+     * Returns whether the records are keyed by the _id of their documents, as described in
+     * clustered_record_id.h.
+     */
+    virtual bool isClustered() const {
+        return false;
+    }
+
+    /**
+     * Returns whether this capped record store keys each record inserted with a timestamp by that
+     * timestamp. RecordIds then follow the order of the inserts' oplog entries even when the
+     * inserts run concurrently, so callers need not serialize them. Tailing readers must not read
+     * past getCappedVisibilityBound() to avoid skipping over inserts that are yet to commit.
+     */
+    virtual bool keysCappedInsertsByTimestamp() const {
+        return false;
+    }
+
+    /**
+     * Returns the RecordId at or below which every timestamped insert into this capped record
+     * store has committed, or boost::none if no RecordIds are hidden.
+     */
+    virtual boost::optional<RecordId> getCappedVisibilityBound(OperationContext* opCtx) const {
+        return boost::none;
+    }
+
     virtual void setCappedCallback(CappedCallback*) {
         MONGO_UNREACHABLE;
     }
@@ -530,8 +580,9 @@ public:
     }
 
     /**
-     * Return the RecordId of an oplog entry as close to startingPosition as possible without
-     * being higher. If there are no entries <= startingPosition, return RecordId().
+     * Return the RecordId of an oplog entry, or of a record in a clustered collection, as close to
+     * startingPosition as possible without being higher. If there are no entries <=
+     * startingPosition, return RecordId().
      *
      * If you don't implement the oplogStartHack, just use the default implementation which
      * returns boost::none.
@@ -33,6 +33,7 @@
 #include "mongo/db/storage/record_store_test_harness.h"
 
 #include <algorithm>
+#include <vector>
 
 #include "mongo/bson/util/builder.h"
 #include "mongo/db/record_id.h"
@@ -484,5 +485,68 @@ TEST(RecordStoreTestHarness, SeekExactForMissingRecordReturnsNone) {
     ASSERT_FALSE(recordStore->findRecord(opCtx.get(), recordIds[1], &outputData));
 }
 
+// seekExactBatch() must return owned data for every existing RecordId, in the order requested,
+// and boost::none for RecordIds that do not exist.
+TEST(RecordStoreTestHarness, SeekExactBatchReturnsRecordsInRequestedOrder) {
+    const auto harnessHelper{newRecordStoreHarnessHelper()};
+    auto recordStore = harnessHelper->newNonCappedRecordStore();
+    ServiceContext::UniqueOperationContext opCtx{harnessHelper->newOperationContext()};
+
+    const int nToInsert = 10;
+    RecordId recordIds[nToInsert];
+    std::string datas[nToInsert];
+    for (int i = 0; i < nToInsert; ++i) {
+        StringBuilder sb;
+        sb << "record " << i;
+        datas[i] = sb.str();
+
+        WriteUnitOfWork uow{opCtx.get()};
+        auto res = recordStore->insertRecord(
+            opCtx.get(), datas[i].c_str(), datas[i].size() + 1, Timestamp{});
+        ASSERT_OK(res.getStatus());
+        recordIds[i] = res.getValue();
+        uow.commit();
+    }
+
+    // Delete some records so that the batch contains both adjacent and missing ids.
+    {
+        WriteUnitOfWork uow{opCtx.get()};
+        recordStore->deleteRecord(opCtx.get(), recordIds[3]);
+        recordStore->deleteRecord(opCtx.get(), recordIds[9]);
+        uow.commit();
+    }
+
+    // Ask for the records out of order, with duplicates and missing ids.
+    std::vector<int> wanted = {7, 0, 3, 1, 2, 9, 4, 4, 8};
+    std::vector<RecordId> batch;
+    for (int i : wanted) {
+        batch.push_back(recordIds[i]);
+    }
+
+    for (bool direction : {true, false}) {
+        auto cursor = recordStore->getCursor(opCtx.get(), direction);
+        auto records = cursor->seekExactBatch(batch);
+        ASSERT_EQUALS(batch.size(), records.size());
+
+        for (size_t i = 0; i < wanted.size(); ++i) {
+            if (wanted[i] == 3 || wanted[i] == 9) {
+                ASSERT(!records[i]);
+                continue;
+            }
+            ASSERT(records[i]);
+            ASSERT_EQUALS(recordIds[wanted[i]], records[i]->id);
+            ASSERT(records[i]->data.isOwned());
+        }
+
+        // The data must still be valid after the cursor is used again.
+        ASSERT(cursor->seekExact(recordIds[5]));
+        for (size_t i = 0; i < wanted.size(); ++i) {
+            if (records[i]) {
+                ASSERT_EQUALS(datas[wanted[i]], records[i]->data.data());
+            }
+        }
+    }
+}
+
 }  // namespace
 }  // namespace mongo
@@ -135,6 +135,14 @@ public:
      */
     virtual void preallocateSnapshot() {}
 
+    /**
+     * Returns true if a snapshot is currently established, so that data read now may be older than
+     * the latest committed writes. Storage engines which cannot tell report true.
+     */
+    virtual bool inActiveTxn() const {
+        return true;
+    }
+
     /**
      * Obtains a majority committed snapshot. Snapshots should still be separately acquired and
      * newer committed snapshots should be used if available whenever implementations would normally
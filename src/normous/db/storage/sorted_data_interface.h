@@ -34,6 +34,7 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/record_id.h"
 #include "mongo/db/storage/index_entry_comparison.h"
+#include "mongo/db/storage/key_string_sort_key.h"
 
 #pragma once
 
@@ -388,6 +389,19 @@ public:
      */
     virtual StatusWith<SpecialFormatInserted> addKey(const BSONObj& key, const RecordId& loc) = 0;
 
+    /**
+     * Like addKey(), but also supplies 'keyString', the KeyString encoding of 'key' with 'loc'
+     * appended, as produced by the index build's sort phase. Implementations that store KeyStrings
+     * of the same version may insert its bytes directly instead of re-encoding 'key'.
+     *
+     * The default implementation ignores 'keyString' and calls addKey().
+     */
+    virtual StatusWith<SpecialFormatInserted> addKeyString(const KeyStringSortKey& keyString,
+                                                           const BSONObj& key,
+                                                           const RecordId& loc) {
+        return addKey(key, loc);
+    }
+
     /**
      * Do any necessary work to finish building the tree.
      *
@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
 #include <string>
 #include <vector>
 
@@ -197,6 +198,14 @@ public:
         return true;
     }
 
+    /**
+     * Returns whether the storage engine supports clustered collections, which store their
+     * documents keyed by _id.
+     */
+    virtual bool supportsClusteredCollections() const {
+        return false;
+    }
+
     /**
      * Returns whether the engine supports a journalling concept or not.
      */
@@ -266,7 +275,35 @@ public:
         return;
     }
 
-    virtual StatusWith<std::vector<std::string>> beginNonBlockingBackup(OperationContext* opCtx) {
+    /**
+     * Options for a non-blocking backup. Naming a backup lets a later backup be taken relative to
+     * it, so that only what changed in between needs to be copied.
+     */
+    struct BackupOptions {
+        // The name to remember this backup under.
+        boost::optional<std::string> thisBackupName;
+
+        // An earlier named backup to make this backup incremental to.
+        boost::optional<std::string> srcBackupName;
+    };
+
+    /**
+     * A file belonging to a non-blocking backup. In an incremental backup, `changed` is false for
+     * files whose contents the restored data does not depend on having been recopied: the copy
+     * taken for the source backup can be reused for them. Files of the source backup that are not
+     * listed at all no longer exist and must not be restored.
+     */
+    struct BackupFile {
+        std::string filename;
+        bool changed = true;
+    };
+
+    /**
+     * Begins a backup that lets writes continue, returning the files to copy. The files remain
+     * consistent to copy until `endNonBlockingBackup` is called.
+     */
+    virtual StatusWith<std::vector<BackupFile>> beginNonBlockingBackup(
+        OperationContext* opCtx, const BackupOptions& options) {
         return Status(ErrorCodes::CommandNotSupported,
                       "The current storage engine does not support a concurrent mode.");
     }
@@ -0,0 +1,94 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/platform/atomic_word.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+class OperationContext;
+
+/**
+ * Per-operation storage engine I/O counters. Storage engines add to these as an operation reads
+ * records and index keys through its cursors, or writes records, so that the operation can report
+ * how much data it pulled through the storage engine cache.
+ *
+ * The counters are updated by the thread running the operation and may be read concurrently by
+ * other threads holding the Client lock, e.g. for $currentOp.
+ */
+class StorageOperationStats {
+public:
+    /**
+     * A point in time copy of the counters, used to compute the share of a sub-operation or to
+     * report to Top only what has not been reported yet.
+     */
+    struct Snapshot {
+        long long bytesRead = 0;
+        long long bytesWritten = 0;
+
+        Snapshot operator-(const Snapshot& other) const {
+            return {bytesRead - other.bytesRead, bytesWritten - other.bytesWritten};
+        }
+
+        /**
+         * Appends 'bytesRead' and 'bytesWritten' to 'builder'.
+         */
+        void append(BSONObjBuilder* builder) const;
+    };
+
+    static StorageOperationStats& get(OperationContext* opCtx);
+
+    void incBytesRead(long long bytes) {
+        _bytesRead.fetchAndAdd(bytes);
+    }
+
+    void incBytesWritten(long long bytes) {
+        _bytesWritten.fetchAndAdd(bytes);
+    }
+
+    Snapshot snapshot() const {
+        return {_bytesRead.load(), _bytesWritten.load()};
+    }
+
+    /**
+     * Returns the counters accumulated since the previous call, for attributing them to a
+     * namespace in Top without counting them twice when an operation records more than once.
+     */
+    Snapshot takeUnrecorded();
+
+private:
+    AtomicInt64 _bytesRead{0};
+    AtomicInt64 _bytesWritten{0};
+
+    // Only touched by the thread running the operation.
+    Snapshot _recorded;
+};
+
+}  // namespace mongo
@@ -0,0 +1,84 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/storage/storage_operation_stats.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(StorageOperationStatsTest, CountersAccumulate) {
+    StorageOperationStats stats;
+    stats.incBytesRead(10);
+    stats.incBytesRead(5);
+    stats.incBytesWritten(7);
+
+    auto snapshot = stats.snapshot();
+    ASSERT_EQ(15, snapshot.bytesRead);
+    ASSERT_EQ(7, snapshot.bytesWritten);
+
+    BSONObjBuilder builder;
+    snapshot.append(&builder);
+    ASSERT_BSONOBJ_EQ(BSON("bytesRead" << 15LL << "bytesWritten" << 7LL), builder.obj());
+}
+
+TEST(StorageOperationStatsTest, SnapshotDifference) {
+    StorageOperationStats stats;
+    stats.incBytesRead(10);
+    auto base = stats.snapshot();
+
+    stats.incBytesRead(3);
+    stats.incBytesWritten(4);
+
+    auto delta = stats.snapshot() - base;
+    ASSERT_EQ(3, delta.bytesRead);
+    ASSERT_EQ(4, delta.bytesWritten);
+}
+
+TEST(StorageOperationStatsTest, TakeUnrecordedReturnsEachByteOnce) {
+    StorageOperationStats stats;
+    stats.incBytesRead(10);
+    stats.incBytesWritten(2);
+
+    auto first = stats.takeUnrecorded();
+    ASSERT_EQ(10, first.bytesRead);
+    ASSERT_EQ(2, first.bytesWritten);
+
+    auto empty = stats.takeUnrecorded();
+    ASSERT_EQ(0, empty.bytesRead);
+    ASSERT_EQ(0, empty.bytesWritten);
+
+    stats.incBytesRead(1);
+    ASSERT_EQ(1, stats.takeUnrecorded().bytesRead);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -44,6 +44,7 @@ void StorageGlobalParams::reset() {
     engine = "wiredTiger";
     engineSetByUser = false;
     dbpath = kDefaultDbPath;
+    tmpDirectory.clear();
     upgrade = false;
     repair = false;
 
@@ -57,6 +58,10 @@ void StorageGlobalParams::reset() {
     groupCollections = false;
 }
 
+std::string StorageGlobalParams::getTmpDirectory() const {
+    return (tmpDirectory.empty() ? dbpath : tmpDirectory) + "/_tmp";
+}
+
 StorageGlobalParams storageGlobalParams;
 
 /**
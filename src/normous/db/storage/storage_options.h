@@ -64,6 +64,18 @@ struct StorageGlobalParams {
     // The directory where the mongod instance stores its data.
     std::string dbpath;
 
+    // --tmpDirectory
+    // The directory under which external sorts, such as index builds and aggregations with
+    // allowDiskUse, spill their data. Defaults to the dbpath. Pointing it at a separate volume
+    // keeps large spills from competing with the data files for IOPS.
+    std::string tmpDirectory;
+
+    /**
+     * Returns the directory that external sorts spill to, which is cleared on startup: the _tmp
+     * subdirectory of 'tmpDirectory' if set, or of 'dbpath' otherwise.
+     */
+    std::string getTmpDirectory() const;
+
     // --upgrade
     // Upgrades the on-disk data format of the files specified by the --dbpath to the
     // latest version, if needed.
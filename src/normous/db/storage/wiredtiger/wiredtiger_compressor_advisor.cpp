@@ -0,0 +1,212 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_compressor_advisor.h"
+
+#include <algorithm>
+#include <snappy.h>
+#include <zlib.h>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/storage/record_store.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/timer.h"
+
+namespace mongo {
+
+constexpr StringData WiredTigerCompressorAdvisor::kNone;
+constexpr StringData WiredTigerCompressorAdvisor::kSnappy;
+constexpr StringData WiredTigerCompressorAdvisor::kZlib;
+constexpr StringData WiredTigerCompressorAdvisor::kDefaultCompressor;
+constexpr size_t WiredTigerCompressorAdvisor::kBlockSize;
+constexpr size_t WiredTigerCompressorAdvisor::kMaxSampleBytes;
+constexpr size_t WiredTigerCompressorAdvisor::kMinSampleBytes;
+constexpr double WiredTigerCompressorAdvisor::kMinUsefulRatio;
+constexpr double WiredTigerCompressorAdvisor::kZlibMinGainOverSnappy;
+constexpr double WiredTigerCompressorAdvisor::kZlibMinDecompressMBps;
+
+namespace {
+
+using Measurement = WiredTigerCompressorAdvisor::Measurement;
+
+std::vector<std::string> packIntoBlocks(const std::vector<std::string>& records) {
+    std::vector<std::string> blocks;
+    std::string current;
+    for (auto&& record : records) {
+        current.append(record);
+        if (current.size() >= WiredTigerCompressorAdvisor::kBlockSize) {
+            blocks.push_back(std::move(current));
+            current.clear();
+        }
+    }
+    if (!current.empty()) {
+        blocks.push_back(std::move(current));
+    }
+    return blocks;
+}
+
+double throughputMBps(size_t bytes, long long micros) {
+    // Guard against timer granularity on tiny samples.
+    return static_cast<double>(bytes) / std::max(micros, 1LL);
+}
+
+Measurement measureSnappy(const std::vector<std::string>& blocks, size_t totalBytes) {
+    std::vector<std::string> compressed(blocks.size());
+    size_t compressedBytes = 0;
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        snappy::Compress(blocks[i].data(), blocks[i].size(), &compressed[i]);
+        compressedBytes += compressed[i].size();
+    }
+
+    std::string out;
+    Timer timer;
+    for (auto&& block : compressed) {
+        invariant(snappy::Uncompress(block.data(), block.size(), &out));
+    }
+
+    Measurement m;
+    m.compressor = WiredTigerCompressorAdvisor::kSnappy.toString();
+    m.ratio = static_cast<double>(totalBytes) / std::max<size_t>(compressedBytes, 1);
+    m.decompressMBps = throughputMBps(totalBytes, timer.micros());
+    return m;
+}
+
+Measurement measureZlib(const std::vector<std::string>& blocks, size_t totalBytes) {
+    std::vector<std::string> compressed(blocks.size());
+    size_t compressedBytes = 0;
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        uLongf len = compressBound(blocks[i].size());
+        compressed[i].resize(len);
+        invariant(compress2(reinterpret_cast<Bytef*>(&compressed[i][0]),
+                            &len,
+                            reinterpret_cast<const Bytef*>(blocks[i].data()),
+                            blocks[i].size(),
+                            Z_DEFAULT_COMPRESSION) == Z_OK);
+        compressed[i].resize(len);
+        compressedBytes += len;
+    }
+
+    std::string out(WiredTigerCompressorAdvisor::kBlockSize * 2, '\0');
+    Timer timer;
+    for (size_t i = 0; i < compressed.size(); ++i) {
+        if (out.size() < blocks[i].size()) {
+            out.resize(blocks[i].size());
+        }
+        uLongf len = out.size();
+        invariant(uncompress(reinterpret_cast<Bytef*>(&out[0]),
+                             &len,
+                             reinterpret_cast<const Bytef*>(compressed[i].data()),
+                             compressed[i].size()) == Z_OK);
+    }
+
+    Measurement m;
+    m.compressor = WiredTigerCompressorAdvisor::kZlib.toString();
+    m.ratio = static_cast<double>(totalBytes) / std::max<size_t>(compressedBytes, 1);
+    m.decompressMBps = throughputMBps(totalBytes, timer.micros());
+    return m;
+}
+
+}  // namespace
+
+void WiredTigerCompressorAdvisor::Choice::appendToBSON(BSONObjBuilder* builder) const {
+    builder->append("choice", compressor);
+    builder->append("sampledBytes", sampledBytes);
+    BSONObjBuilder candidates(builder->subobjStart("candidates"));
+    for (auto&& m : measurements) {
+        BSONObjBuilder candidate(candidates.subobjStart(m.compressor));
+        candidate.append("ratio", m.ratio);
+        candidate.append("decompressMBps", m.decompressMBps);
+    }
+}
+
+WiredTigerCompressorAdvisor::Choice WiredTigerCompressorAdvisor::chooseForSample(
+    const std::vector<std::string>& records) {
+    Choice choice;
+    choice.compressor = kDefaultCompressor.toString();
+
+    const std::vector<std::string> blocks = packIntoBlocks(records);
+    size_t totalBytes = 0;
+    for (auto&& block : blocks) {
+        totalBytes += block.size();
+    }
+    choice.sampledBytes = static_cast<long long>(totalBytes);
+    if (totalBytes < kMinSampleBytes) {
+        return choice;
+    }
+
+    const Measurement snappy = measureSnappy(blocks, totalBytes);
+    const Measurement zlib = measureZlib(blocks, totalBytes);
+    Measurement none;
+    none.compressor = kNone.toString();
+    choice.measurements = {none, snappy, zlib};
+
+    if (std::max(snappy.ratio, zlib.ratio) < kMinUsefulRatio) {
+        choice.compressor = kNone.toString();
+    } else if (zlib.ratio >= snappy.ratio * kZlibMinGainOverSnappy &&
+               zlib.decompressMBps >= kZlibMinDecompressMBps) {
+        choice.compressor = kZlib.toString();
+    } else {
+        choice.compressor = kSnappy.toString();
+    }
+    return choice;
+}
+
+WiredTigerCompressorAdvisor::Choice WiredTigerCompressorAdvisor::chooseForRecordStore(
+    OperationContext* opCtx, const RecordStore* rs) {
+    std::vector<std::string> records;
+    size_t sampledBytes = 0;
+
+    auto collect = [&](RecordCursor* cursor, long long maxRecords) {
+        for (long long n = 0; n < maxRecords && sampledBytes < kMaxSampleBytes; ++n) {
+            auto record = cursor->next();
+            if (!record) {
+                break;
+            }
+            records.emplace_back(record->data.data(), record->data.size());
+            sampledBytes += record->data.size();
+        }
+    };
+
+    const long long numRecords = rs->numRecords(opCtx);
+    if (auto randomCursor = rs->getRandomCursor(opCtx)) {
+        // A random cursor may return the same record more than once; cap the number of draws so
+        // that small collections do not loop for the full sample size.
+        collect(randomCursor.get(), numRecords);
+    } else {
+        auto cursor = rs->getCursor(opCtx);
+        collect(cursor.get(), numRecords);
+    }
+    return chooseForSample(records);
+}
+
+}  // namespace mongo
@@ -0,0 +1,105 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "mongo/base/string_data.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+class OperationContext;
+class RecordStore;
+
+/**
+ * Samples collection data and picks the block compressor that suits it best. Used when the
+ * collection block compressor is configured as "auto".
+ *
+ * Sampled records are packed into blocks about the size of a WiredTiger leaf page. Each block is
+ * compressed with every candidate compressor, which gives a compression ratio and a decompression
+ * throughput per candidate. zlib wins when it saves noticeably more space than snappy and still
+ * decompresses fast enough; "none" wins when neither compressor saves enough to pay for the CPU.
+ */
+class WiredTigerCompressorAdvisor {
+public:
+    static constexpr StringData kNone = "none"_sd;
+    static constexpr StringData kSnappy = "snappy"_sd;
+    static constexpr StringData kZlib = "zlib"_sd;
+
+    // What new collections get in "auto" mode, before there is any data to sample.
+    static constexpr StringData kDefaultCompressor = kSnappy;
+
+    // Size of the blocks the sample is packed into; matches WiredTiger's default leaf_page_max.
+    static constexpr size_t kBlockSize = 32 * 1024;
+
+    // Upper bound on the amount of data sampled from a collection.
+    static constexpr size_t kMaxSampleBytes = 4 * 1024 * 1024;
+
+    // Below this many sampled bytes the measurements are noise and the default is kept.
+    static constexpr size_t kMinSampleBytes = 4 * kBlockSize;
+
+    // A compressor must shrink the data by at least this factor to be worth using at all.
+    static constexpr double kMinUsefulRatio = 1.1;
+
+    // zlib must produce blocks at least this much smaller than snappy to be preferred.
+    static constexpr double kZlibMinGainOverSnappy = 1.2;
+
+    // zlib is not chosen when it decompresses slower than this, in MB/s.
+    static constexpr double kZlibMinDecompressMBps = 100.0;
+
+    struct Measurement {
+        std::string compressor;
+        double ratio = 1.0;             // uncompressed bytes / compressed bytes
+        double decompressMBps = 0.0;  // 0 for "none"
+    };
+
+    struct Choice {
+        std::string compressor;
+        long long sampledBytes = 0;
+        std::vector<Measurement> measurements;
+
+        void appendToBSON(BSONObjBuilder* builder) const;
+    };
+
+    /**
+     * Packs 'records' into blocks, measures every candidate compressor and returns the choice.
+     */
+    static Choice chooseForSample(const std::vector<std::string>& records);
+
+    /**
+     * Samples up to kMaxSampleBytes of records from 'rs', using a random cursor when the record
+     * store provides one, and returns the choice for that sample.
+     */
+    static Choice chooseForRecordStore(OperationContext* opCtx, const RecordStore* rs);
+};
+
+}  // namespace mongo
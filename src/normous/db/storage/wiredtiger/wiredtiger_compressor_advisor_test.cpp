@@ -0,0 +1,95 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_compressor_advisor.h"
+
+#include "mongo/platform/random.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace {
+
+using Advisor = WiredTigerCompressorAdvisor;
+
+std::vector<std::string> makeLogLikeRecords(size_t count) {
+    std::vector<std::string> records;
+    for (size_t i = 0; i < count; ++i) {
+        records.push_back(str::stream() << "{ts: " << i << ", level: 'INFO', component: 'NETWORK', "
+                                        << "msg: 'connection accepted from 10.0.0." << (i % 16)
+                                        << ":27017 #" << i << " (12 connections now open)'}");
+    }
+    return records;
+}
+
+std::vector<std::string> makeRandomRecords(size_t count, size_t size) {
+    PseudoRandom random(7);
+    std::vector<std::string> records;
+    for (size_t i = 0; i < count; ++i) {
+        std::string record(size, '\0');
+        for (auto&& c : record) {
+            c = static_cast<char>(random.nextInt32(256));
+        }
+        records.push_back(std::move(record));
+    }
+    return records;
+}
+
+TEST(WiredTigerCompressorAdvisorTest, SmallSampleKeepsDefault) {
+    auto choice = Advisor::chooseForSample(makeRandomRecords(4, 100));
+    ASSERT_EQ(Advisor::kDefaultCompressor, choice.compressor);
+    ASSERT_EQ(400, choice.sampledBytes);
+    ASSERT_TRUE(choice.measurements.empty());
+}
+
+TEST(WiredTigerCompressorAdvisorTest, IncompressibleDataPicksNone) {
+    auto choice = Advisor::chooseForSample(makeRandomRecords(512, 1024));
+    ASSERT_EQ(Advisor::kNone, choice.compressor);
+    ASSERT_EQ(3U, choice.measurements.size());
+    for (auto&& m : choice.measurements) {
+        ASSERT_LT(m.ratio, Advisor::kMinUsefulRatio);
+    }
+}
+
+TEST(WiredTigerCompressorAdvisorTest, CompressibleDataPicksACompressor) {
+    auto choice = Advisor::chooseForSample(makeLogLikeRecords(20000));
+    ASSERT_NE(Advisor::kNone, choice.compressor);
+    ASSERT_EQ(3U, choice.measurements.size());
+    for (auto&& m : choice.measurements) {
+        if (m.compressor != Advisor::kNone) {
+            ASSERT_GT(m.ratio, 2.0);
+            ASSERT_GT(m.decompressMBps, 0.0);
+        }
+    }
+}
+
+}  // namespace
+}  // namespace mongo
@@ -49,6 +49,15 @@ Status WiredTigerGlobalOptions::add(moe::OptionSection* options) {
                                         moe::Double,
                                         "maximum amount of memory to allocate for cache; "
                                         "defaults to 1/2 of physical RAM");
+    wiredTigerOptions
+        .addOptionChaining("storage.wiredTiger.engineConfig.readOnlyCacheSizeGB",
+                           "wiredTigerReadOnlyCacheSizeGB",
+                           moe::Double,
+                           "maximum amount of memory to allocate for cache in queryableBackupMode; "
+                           "data files are read through mmap and cached by the operating system, "
+                           "so a small cache avoids holding the same pages twice. Defaults to "
+                           "wiredTigerCacheSizeGB")
+        .hidden();
     wiredTigerOptions
         .addOptionChaining("storage.wiredTiger.engineConfig.statisticsLogDelaySecs",
                            "wiredTigerStatisticsLogDelaySecs",
@@ -84,8 +93,9 @@ Status WiredTigerGlobalOptions::add(moe::OptionSection* options) {
                            "wiredTigerCollectionBlockCompressor",
                            moe::String,
                            "block compression algorithm for collection data "
-                           "[none|snappy|zlib]")
-        .format("(:?none)|(:?snappy)|(:?zlib)", "(none/snappy/zlib)")
+                           "[none|snappy|zlib|auto]; auto samples each collection on compact "
+                           "and records the compressor that suits its data")
+        .format("(:?none)|(:?snappy)|(:?zlib)|(:?auto)", "(none/snappy/zlib/auto)")
         .setDefault(moe::Value(std::string("snappy")));
     wiredTigerOptions
         .addOptionChaining("storage.wiredTiger.collectionConfig.configString",
@@ -119,6 +129,10 @@ Status WiredTigerGlobalOptions::store(const moe::Environment& params,
         wiredTigerGlobalOptions.cacheSizeGB =
             params["storage.wiredTiger.engineConfig.cacheSizeGB"].as<double>();
     }
+    if (params.count("storage.wiredTiger.engineConfig.readOnlyCacheSizeGB")) {
+        wiredTigerGlobalOptions.readOnlyCacheSizeGB =
+            params["storage.wiredTiger.engineConfig.readOnlyCacheSizeGB"].as<double>();
+    }
     if (params.count("storage.syncPeriodSecs")) {
         wiredTigerGlobalOptions.checkpointDelaySecs =
             static_cast<size_t>(params["storage.syncPeriodSecs"].as<double>());
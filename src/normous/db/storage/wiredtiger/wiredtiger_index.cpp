@@ -45,6 +45,7 @@
 #include "mongo/db/repl/repl_settings.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/key_string.h"
+#include "mongo/db/storage/storage_operation_stats.h"
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
@@ -605,34 +606,48 @@ public:
 
     StatusWith<SpecialFormatInserted> addKey(const BSONObj& key, const RecordId& id) override {
         KeyString data(_idx->keyStringVersion(), key, _idx->_ordering, id);
+        return insertKeyString(data.getBuffer(), data.getSize(), data.getTypeBits());
+    }
+
+    StatusWith<SpecialFormatInserted> addKeyString(const KeyStringSortKey& keyString,
+                                                   const BSONObj& key,
+                                                   const RecordId& id) override {
+        if (keyString.getVersion() != _idx->keyStringVersion())
+            return addKey(key, id);
+
+        return insertKeyString(keyString.getBuffer(), keyString.getSize(), keyString.getTypeBits());
+    }
+
+    SpecialFormatInserted commit(bool mayInterrupt) override {
+        // TODO do we still need this?
+        // this is bizarre, but required as part of the contract
+        WriteUnitOfWork uow(_opCtx);
+        uow.commit();
+        return SpecialFormatInserted::NoSpecialFormatInserted;
+    }
 
+private:
+    StatusWith<SpecialFormatInserted> insertKeyString(const char* buffer,
+                                                      size_t size,
+                                                      const KeyString::TypeBits& typeBits) {
         // Can't use WiredTigerCursor since we aren't using the cache.
-        WiredTigerItem item(data.getBuffer(), data.getSize());
+        WiredTigerItem item(buffer, size);
         setKey(_cursor, item.Get());
 
-        WiredTigerItem valueItem = data.getTypeBits().isAllZeros()
+        WiredTigerItem valueItem = typeBits.isAllZeros()
             ? emptyItem
-            : WiredTigerItem(data.getTypeBits().getBuffer(), data.getTypeBits().getSize());
+            : WiredTigerItem(typeBits.getBuffer(), typeBits.getSize());
 
         _cursor->set_value(_cursor, valueItem.Get());
 
         invariantWTOK(_cursor->insert(_cursor));
 
-        if (data.getTypeBits().isLongEncoding())
+        if (typeBits.isLongEncoding())
             return StatusWith<SpecialFormatInserted>(SpecialFormatInserted::LongTypeBitsInserted);
 
         return StatusWith<SpecialFormatInserted>(SpecialFormatInserted::NoSpecialFormatInserted);
     }
 
-    SpecialFormatInserted commit(bool mayInterrupt) override {
-        // TODO do we still need this?
-        // this is bizarre, but required as part of the contract
-        WriteUnitOfWork uow(_opCtx);
-        uow.commit();
-        return SpecialFormatInserted::NoSpecialFormatInserted;
-    }
-
-private:
     WiredTigerIndex* _idx;
 };
 
@@ -819,6 +834,7 @@ public:
         if (key.isEmpty()) {
             // This means scan to end of index.
             _endPosition.reset();
+            _endPrefixSize = 0;
             return;
         }
 
@@ -828,6 +844,7 @@ public:
             _forward == inclusive ? KeyString::kExclusiveAfter : KeyString::kExclusiveBefore;
         _endPosition = stdx::make_unique<KeyString>(_idx.keyStringVersion());
         _endPosition->resetToKey(stripFieldNames(key), _idx.ordering(), discriminator);
+        _endPrefixSize = 0;
     }
 
     boost::optional<IndexKeyEntry> seek(const BSONObj& key,
@@ -995,6 +1012,29 @@ protected:
         }
     }
 
+    /**
+     * Like atOrPastEndPointAfterSeeking(), but for use right after _key has been replaced with a
+     * key which shares its first 'sharedWithPreviousKey' bytes with the previous one. Combined with
+     * the common prefix the previous key had with the end bound, this lets us compare only the
+     * suffix of the new key. That matters for long compound keys, where consecutive keys in a range
+     * scan usually agree with each other and with the bound on most of their leading fields.
+     */
+    bool atOrPastEndPointAfterMoving(size_t sharedWithPreviousKey) {
+        if (_eof)
+            return true;
+        if (!_endPosition)
+            return false;
+
+        const size_t knownPrefixSize = std::min(sharedWithPreviousKey, _endPrefixSize);
+        const int cmp =
+            _key.compareWithKnownPrefix(*_endPosition, knownPrefixSize, &_endPrefixSize);
+
+        // See atOrPastEndPointAfterSeeking() for why these can never be equal.
+        dassert(cmp != 0);
+
+        return _forward ? cmp > 0 : cmp < 0;
+    }
+
     void advanceWTCursor() {
         WT_CURSOR* c = _cursor->get();
         int ret = wiredTigerPrepareConflictRetry(
@@ -1062,14 +1102,20 @@ protected:
         WT_CURSOR* c = _cursor->get();
         WT_ITEM item;
         getKey(c, &item);
+        StorageOperationStats::get(_opCtx).incBytesRead(item.size);
 
-        const auto isForwardNextCall = _forward && inNext && !_key.isEmpty();
+        // How many leading bytes the new key shares with the previous one. Only computed when
+        // stepping, since a seek can land anywhere.
+        size_t sharedWithPreviousKey = 0;
+        const bool isNextCall = inNext && !_key.isEmpty();
+
+        const auto isForwardNextCall = _forward && isNextCall;
         if (isForwardNextCall) {
             // Due to a bug in wired tiger (SERVER-21867) sometimes calling next
             // returns something prev.
-            const int cmp =
-                std::memcmp(_key.getBuffer(), item.data, std::min(_key.getSize(), item.size));
-            bool nextNotIncreasing = cmp > 0 || (cmp == 0 && _key.getSize() > item.size);
+            const int cmp = KeyString::compareBuffers(
+                _key.getBuffer(), _key.getSize(), item.data, item.size, 0, &sharedWithPreviousKey);
+            bool nextNotIncreasing = cmp > 0;
 
             if (MONGO_FAIL_POINT(WTEmulateOutOfOrderNextIndexKey)) {
                 log() << "WTIndex::updatePosition simulating next key not increasing.";
@@ -1086,12 +1132,15 @@ protected:
                 // we received a WT_ROLLBACK error.
                 throw WriteConflictException();
             }
+        } else if (isNextCall && _endPosition) {
+            sharedWithPreviousKey = KeyString::commonPrefixSize(
+                _key.getBuffer(), item.data, std::min(_key.getSize(), item.size));
         }
 
         // Store (a copy of) the new item data as the current key for this cursor.
         _key.resetFromBuffer(item.data, item.size);
 
-        if (atOrPastEndPointAfterSeeking()) {
+        if (atOrPastEndPointAfterMoving(sharedWithPreviousKey)) {
             _eof = true;
             return;
         }
@@ -1123,6 +1172,10 @@ protected:
     KVPrefix _prefix;
 
     std::unique_ptr<KeyString> _endPosition;
+
+    // The size of the common prefix of _key and *_endPosition as of the last end bound check. Zero
+    // is always a safe value, and is used whenever the bound changes.
+    size_t _endPrefixSize = 0;
 };
 
 // The Standard Cursor doesn't need anything more than the base has.
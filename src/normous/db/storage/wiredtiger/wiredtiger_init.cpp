@@ -86,7 +86,13 @@ public:
         }
 #endif
 
-        size_t cacheMB = WiredTigerUtil::getCacheSizeMB(wiredTigerGlobalOptions.cacheSizeGB);
+        // A read-only engine never dirties pages, so its cache only duplicates what the OS page
+        // cache already holds for the memory-mapped data files.
+        const double cacheSizeGB =
+            (params.readOnly && wiredTigerGlobalOptions.readOnlyCacheSizeGB > 0)
+            ? wiredTigerGlobalOptions.readOnlyCacheSizeGB
+            : wiredTigerGlobalOptions.cacheSizeGB;
+        size_t cacheMB = WiredTigerUtil::getCacheSizeMB(cacheSizeGB);
         const double memoryThresholdPercentage = 0.8;
         ProcessInfo p;
         if (p.supported()) {
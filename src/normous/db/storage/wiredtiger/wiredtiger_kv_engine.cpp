@@ -41,6 +41,7 @@
 #define NVALGRIND
 #endif
 
+#include <fstream>
 #include <memory>
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
@@ -425,6 +426,16 @@ TicketHolder openReadTransaction(128);
 TicketServerParameter openReadTransactionParam(&openReadTransaction,
                                                "wiredTigerConcurrentReadTransactions");
 
+// Tickets held back for operations with priority ticket admission, such as oplog application and
+// TTL deletes, once the tickets above are all in use.
+TicketHolder priorityWriteTransaction(8);
+TicketServerParameter priorityWriteTransactionParam(&priorityWriteTransaction,
+                                                    "wiredTigerPriorityWriteTransactions");
+
+TicketHolder priorityReadTransaction(8);
+TicketServerParameter priorityReadTransactionParam(&priorityReadTransaction,
+                                                   "wiredTigerPriorityReadTransactions");
+
 stdx::function<bool(StringData)> initRsOplogBackgroundThreadCallback = [](StringData) -> bool {
     fassertFailed(40358);
 };
@@ -492,6 +503,12 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
             ss << "verbose=(recovery),";
         }
     }
+    if (_readOnly) {
+        // Read data files through memory maps so that file pages are served from the OS page
+        // cache. Only clean pages are ever evicted, which a single eviction thread keeps up with.
+        ss << "mmap=true,";
+        ss << "eviction=(threads_min=1,threads_max=1),";
+    }
     ss << WiredTigerCustomizationHooks::get(getGlobalServiceContext())
               ->getTableCreateConfig("system");
     ss << WiredTigerExtensions::get(getGlobalServiceContext())->getOpenExtensionsConfig();
@@ -547,6 +564,11 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
 
     _sessionCache.reset(new WiredTigerSessionCache(this));
 
+    if (!_ephemeral) {
+        _readAhead = stdx::make_unique<WiredTigerReadAhead>(_sessionCache.get());
+        _readAhead->startup();
+    }
+
     if (_durable && !_ephemeral) {
         _journalFlusher = stdx::make_unique<WiredTigerJournalFlusher>(_sessionCache.get());
         _journalFlusher->go();
@@ -574,6 +596,7 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
     _sizeStorer = std::make_unique<WiredTigerSizeStorer>(_conn, _sizeStorerUri, _readOnly);
 
     Locker::setGlobalThrottling(&openReadTransaction, &openWriteTransaction);
+    Locker::setGlobalPriorityTicketReserves(&priorityReadTransaction, &priorityWriteTransaction);
 }
 
 
@@ -582,6 +605,7 @@ WiredTigerKVEngine::~WiredTigerKVEngine() {
         cleanShutdown();
     }
 
+    _readAhead.reset();
     _sessionCache.reset(NULL);
 }
 
@@ -601,6 +625,20 @@ void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
         bbb.append("totalTickets", openReadTransaction.outof());
         bbb.done();
     }
+    {
+        BSONObjBuilder bbb(bb.subobjStart("priorityWrite"));
+        bbb.append("out", priorityWriteTransaction.used());
+        bbb.append("available", priorityWriteTransaction.available());
+        bbb.append("totalTickets", priorityWriteTransaction.outof());
+        bbb.done();
+    }
+    {
+        BSONObjBuilder bbb(bb.subobjStart("priorityRead"));
+        bbb.append("out", priorityReadTransaction.used());
+        bbb.append("available", priorityReadTransaction.available());
+        bbb.append("totalTickets", priorityReadTransaction.outof());
+        bbb.done();
+    }
     bb.done();
 }
 
@@ -671,6 +709,11 @@ void WiredTigerKVEngine::cleanShutdown() {
     }
 
     // these must be the last things we do before _conn->close();
+    if (_readAhead) {
+        log() << "Shutting down cursor read-ahead threads";
+        _readAhead->shutdown();
+        log() << "Finished shutting down cursor read-ahead threads";
+    }
     if (_journalFlusher) {
         log() << "Shutting down journal flusher thread";
         _journalFlusher->shutdown();
@@ -870,8 +913,73 @@ void WiredTigerKVEngine::endBackup(OperationContext* opCtx) {
     _backupSession.reset();
 }
 
-StatusWith<std::vector<std::string>> WiredTigerKVEngine::beginNonBlockingBackup(
-    OperationContext* opCtx) {
+namespace {
+
+// How many named backups to remember. Keeping more than one lets an incremental backup still be
+// taken from the last complete backup when the most recent one was abandoned part way.
+const size_t kMaxNamedBackups = 2;
+
+/**
+ * Reads the checkpoint of each data file from the metadata snapshot that opening a backup cursor
+ * writes out. A restore opens every file at exactly its checkpoint in this snapshot, so a file
+ * whose checkpoint is unchanged since an earlier backup can be restored from that backup's copy.
+ * Files that have never been checkpointed are left out, and so always count as changed.
+ */
+StatusWith<std::map<std::string, std::string>> readBackupCheckpoints(
+    const boost::filesystem::path& metadataPath) {
+    std::ifstream metadata(metadataPath.string());
+    if (!metadata) {
+        return Status(ErrorCodes::FileNotOpen,
+                      str::stream() << "Unable to read backup metadata "
+                                    << metadataPath.string());
+    }
+
+    // The snapshot alternates lines holding a URI and its metadata.
+    std::map<std::string, std::string> checkpoints;
+    std::string uri;
+    std::string config;
+    while (std::getline(metadata, uri) && std::getline(metadata, config)) {
+        const StringData filePrefix = "file:"_sd;
+        if (!StringData(uri).startsWith(filePrefix)) {
+            continue;
+        }
+
+        WiredTigerConfigParser parser(config);
+        WT_CONFIG_ITEM checkpoint;
+        if (parser.get("checkpoint", &checkpoint) == 0) {
+            checkpoints[uri.substr(filePrefix.size())] =
+                std::string(checkpoint.str, checkpoint.len);
+        }
+    }
+
+    return checkpoints;
+}
+
+}  // namespace
+
+StatusWith<std::vector<StorageEngine::BackupFile>> WiredTigerKVEngine::beginNonBlockingBackup(
+    OperationContext* opCtx, const StorageEngine::BackupOptions& options) {
+    if (options.srcBackupName && options.srcBackupName == options.thisBackupName) {
+        return Status(ErrorCodes::BadValue,
+                      "An incremental backup cannot be taken relative to its own name");
+    }
+
+    boost::optional<BackupCheckpoints> srcCheckpoints;
+    if (options.srcBackupName) {
+        stdx::lock_guard<stdx::mutex> lk(_namedBackupsMutex);
+        auto it = std::find_if(_namedBackups.begin(), _namedBackups.end(), [&](const auto& entry) {
+            return entry.first == *options.srcBackupName;
+        });
+        if (it == _namedBackups.end()) {
+            return Status(ErrorCodes::NoSuchKey,
+                          str::stream() << "No backup named '" << *options.srcBackupName
+                                        << "' to take an incremental backup from; named backups "
+                                           "are not remembered across restarts, so take a full "
+                                           "backup instead");
+        }
+        srcCheckpoints = it->second;
+    }
+
     // This cursor will be freed by the backupSession being closed as the session is uncached
     auto sessionRaii = stdx::make_unique<WiredTigerSession>(_conn);
     WT_CURSOR* cursor = NULL;
@@ -881,10 +989,20 @@ StatusWith<std::vector<std::string>> WiredTigerKVEngine::beginNonBlockingBackup(
         return wtRCToStatus(wtRet);
     }
 
-    std::vector<std::string> filesToCopy;
+    const auto dbPath = boost::filesystem::path(_path);
+
+    BackupCheckpoints checkpoints;
+    if (options.thisBackupName || options.srcBackupName) {
+        auto swCheckpoints = readBackupCheckpoints(dbPath / "WiredTiger.backup");
+        if (!swCheckpoints.isOK()) {
+            return swCheckpoints.getStatus();
+        }
+        checkpoints = std::move(swCheckpoints.getValue());
+    }
+
+    std::vector<StorageEngine::BackupFile> filesToCopy;
 
     const char* filename;
-    const auto dbPath = boost::filesystem::path(_path);
     const auto wiredTigerLogFilePrefix = "WiredTigerLog";
     while ((wtRet = cursor->next(cursor)) == 0) {
         invariantWTOK(cursor->get_key(cursor, &filename));
@@ -898,12 +1016,32 @@ StatusWith<std::vector<std::string>> WiredTigerKVEngine::beginNonBlockingBackup(
         }
         filePath /= name;
 
-        filesToCopy.push_back(filePath.string());
+        StorageEngine::BackupFile file;
+        file.filename = filePath.string();
+        if (srcCheckpoints) {
+            // Journal files and WiredTiger's own files have no checkpoint, so are always copied.
+            auto previous = srcCheckpoints->find(name);
+            auto current = checkpoints.find(name);
+            file.changed = previous == srcCheckpoints->end() || current == checkpoints.end() ||
+                previous->second != current->second;
+        }
+
+        filesToCopy.push_back(std::move(file));
     }
     if (wtRet != WT_NOTFOUND) {
         return wtRCToStatus(wtRet, "Error opening backup cursor.");
     }
 
+    if (options.thisBackupName) {
+        stdx::lock_guard<stdx::mutex> lk(_namedBackupsMutex);
+        _namedBackups.remove_if(
+            [&](const auto& entry) { return entry.first == *options.thisBackupName; });
+        _namedBackups.emplace_back(*options.thisBackupName, std::move(checkpoints));
+        while (_namedBackups.size() > kMaxNamedBackups) {
+            _namedBackups.pop_front();
+        }
+    }
+
     _backupSession = std::move(sessionRaii);
     return filesToCopy;
 }
@@ -1041,6 +1179,7 @@ std::unique_ptr<RecordStore> WiredTigerKVEngine::getGroupedRecordStore(
     params.uri = _uri(ident);
     params.engineName = _canonicalName;
     params.isCapped = options.capped;
+    params.isClustered = options.clustered;
     params.isEphemeral = _ephemeral;
     params.cappedCallback = nullptr;
     params.sizeStorer = _sizeStorer.get();
@@ -1254,6 +1393,10 @@ bool WiredTigerKVEngine::supportsDocLocking() const {
     return true;
 }
 
+bool WiredTigerKVEngine::supportsClusteredCollections() const {
+    return true;
+}
+
 bool WiredTigerKVEngine::supportsDirectoryPerDB() const {
     return true;
 }
@@ -1514,6 +1657,24 @@ void WiredTigerKVEngine::setOldestTimestamp(Timestamp newOldestTimestamp, bool f
 }
 
 Timestamp WiredTigerKVEngine::_calculateHistoryLagFromStableTimestamp(Timestamp stableTimestamp) {
+    auto& snapshotManager = _sessionCache->snapshotManager();
+    if (snapshotWindowParams.snapshotHistoryPinnedByActiveReads.load() &&
+        snapshotManager.allReadTimestampsPinned()) {
+        // Keep history only as far back as the oldest read still in use. Readers with an open
+        // transaction are also protected by WiredTiger itself; the pins cover the gaps where a
+        // reader has released its snapshot but will reopen it at the same timestamp.
+        Timestamp calculatedOldestTimestamp = stableTimestamp;
+        auto oldestPinned = snapshotManager.getOldestPinnedReadTimestamp();
+        if (oldestPinned && *oldestPinned < calculatedOldestTimestamp) {
+            calculatedOldestTimestamp = *oldestPinned;
+        }
+
+        if (calculatedOldestTimestamp.asULL() <= _oldestTimestamp.load()) {
+            return Timestamp();
+        }
+        return calculatedOldestTimestamp;
+    }
+
     // The oldest_timestamp should lag behind the stable_timestamp by
     // 'targetSnapshotHistoryWindowInSeconds' seconds.
 
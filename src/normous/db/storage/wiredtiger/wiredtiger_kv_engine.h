@@ -32,6 +32,7 @@
 #pragma once
 
 #include <list>
+#include <map>
 #include <memory>
 #include <string>
 
@@ -42,6 +43,7 @@
 #include "mongo/bson/timestamp.h"
 #include "mongo/db/storage/kv/kv_engine.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_oplog_manager.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_read_ahead.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/stdx/functional.h"
@@ -84,6 +86,8 @@ public:
 
     virtual bool supportsDocLocking() const override;
 
+    bool supportsClusteredCollections() const override;
+
     virtual bool supportsDirectoryPerDB() const override;
 
     virtual bool isDurable() const override {
@@ -162,8 +166,8 @@ public:
 
     virtual void endBackup(OperationContext* opCtx) override;
 
-    virtual StatusWith<std::vector<std::string>> beginNonBlockingBackup(
-        OperationContext* opCtx) override;
+    virtual StatusWith<std::vector<StorageEngine::BackupFile>> beginNonBlockingBackup(
+        OperationContext* opCtx, const StorageEngine::BackupOptions& options) override;
 
     virtual void endNonBlockingBackup(OperationContext* opCtx) override;
 
@@ -281,6 +285,14 @@ public:
         return _oplogManager.get();
     }
 
+    /**
+     * Returns the pool used to warm the cache ahead of sequential scans, or nullptr if the engine
+     * does not perform read-ahead (e.g. it is running in-memory).
+     */
+    WiredTigerReadAhead* getReadAhead() const {
+        return _readAhead.get();
+    }
+
     /**
      * Sets the implementation for `initRsOplogBackgroundThread` (allowing tests to skip the
      * background job, for example). Intended to be called from a MONGO_INITIALIZER and therefore in
@@ -399,6 +411,7 @@ private:
     WiredTigerFileVersion _fileVersion;
     WiredTigerEventHandler _eventHandler;
     std::unique_ptr<WiredTigerSessionCache> _sessionCache;
+    std::unique_ptr<WiredTigerReadAhead> _readAhead;
     ClockSource* const _clockSource;
 
     // Mutex to protect use of _oplogManagerCount by this instance of KV engine.
@@ -439,6 +452,12 @@ private:
     mutable Date_t _previousCheckedDropsQueued;
 
     std::unique_ptr<WiredTigerSession> _backupSession;
+
+    // The checkpoint each file was backed up at, for the most recent named non-blocking backups,
+    // oldest first. Incremental backups compare against these to find the files that changed.
+    using BackupCheckpoints = std::map<std::string, std::string>;
+    stdx::mutex _namedBackupsMutex;
+    std::list<std::pair<std::string, BackupCheckpoints>> _namedBackups;
     Timestamp _recoveryTimestamp;
 
     // Tracks the stable and oldest timestamps we've set on the storage engine.
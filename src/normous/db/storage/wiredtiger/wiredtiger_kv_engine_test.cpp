@@ -34,18 +34,22 @@
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/path.hpp>
 
+#include "mongo/base/checked_cast.h"
 #include "mongo/base/init.h"
 #include "mongo/db/operation_context_noop.h"
 #include "mongo/db/repl/repl_settings.h"
 #include "mongo/db/repl/replication_coordinator_mock.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/snapshot_window_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_snapshot_manager.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -298,6 +302,103 @@ TEST_F(WiredTigerKVEngineTest, TestOplogTruncation) {
     assertPinnedMovesSoon(Timestamp(30, 1));
 }
 
+TEST_F(WiredTigerKVEngineTest, OldestTimestampFollowsPinnedReads) {
+    snapshotWindowParams.snapshotHistoryPinnedByActiveReads.store(true);
+    ON_BLOCK_EXIT([] { snapshotWindowParams.snapshotHistoryPinnedByActiveReads.store(false); });
+    auto& snapshotManager =
+        *checked_cast<WiredTigerSnapshotManager*>(_engine->getSnapshotManager());
+
+    // Nothing is pinned, so no history is kept behind stable.
+    _engine->setStableTimestamp(Timestamp(10, 1), boost::none);
+    ASSERT_EQ(Timestamp(10, 1), _engine->getOldestTimestamp());
+
+    // A pinned read holds the oldest timestamp back until it is released.
+    int pin = snapshotManager.pinReadTimestamp(Timestamp(12, 1));
+    _engine->setStableTimestamp(Timestamp(20, 1), boost::none);
+    ASSERT_EQ(Timestamp(12, 1), _engine->getOldestTimestamp());
+
+    snapshotManager.unpinReadTimestamp(pin);
+    _engine->setStableTimestamp(Timestamp(21, 1), boost::none);
+    ASSERT_EQ(Timestamp(21, 1), _engine->getOldestTimestamp());
+
+    // Once a reader cannot be tracked, fall back on the history window.
+    const int untracked = WiredTigerSnapshotManager::kUntrackedReadTimestampPin;
+    std::vector<int> pins;
+    for (int i = 0; i < WiredTigerSnapshotManager::kReadTimestampPinSlots; ++i) {
+        pins.push_back(snapshotManager.pinReadTimestamp(Timestamp(30, 1)));
+        ASSERT_NE(untracked, pins.back());
+    }
+    pins.push_back(snapshotManager.pinReadTimestamp(Timestamp(30, 1)));
+    ASSERT_EQ(untracked, pins.back());
+    ASSERT_FALSE(snapshotManager.allReadTimestampsPinned());
+
+    const auto window = snapshotWindowParams.targetSnapshotHistoryWindowInSeconds.load();
+    _engine->setStableTimestamp(Timestamp(40 + window, 1), boost::none);
+    ASSERT_EQ(Timestamp(40, 1), _engine->getOldestTimestamp());
+
+    for (auto handle : pins) {
+        snapshotManager.unpinReadTimestamp(handle);
+    }
+    ASSERT_TRUE(snapshotManager.allReadTimestampsPinned());
+    ASSERT_FALSE(snapshotManager.getOldestPinnedReadTimestamp());
+}
+
+TEST_F(WiredTigerKVEngineTest, IncrementalBackupOnlyMarksChangedFiles) {
+    auto opCtxPtr = makeOperationContext();
+
+    std::string ns = "a.b";
+    std::string ident = "collection-1234";
+    std::string record = "abcd";
+    CollectionOptions options;
+
+    std::unique_ptr<RecordStore> rs;
+    ASSERT_OK(_engine->createRecordStore(opCtxPtr.get(), ns, ident, options));
+    rs = _engine->getRecordStore(opCtxPtr.get(), ns, ident, options);
+    ASSERT(rs);
+
+    auto insertAndCheckpoint = [&] {
+        WriteUnitOfWork uow(opCtxPtr.get());
+        ASSERT_OK(
+            rs->insertRecord(opCtxPtr.get(), record.c_str(), record.length() + 1, Timestamp())
+                .getStatus());
+        uow.commit();
+        _engine->flushAllFiles(opCtxPtr.get(), true);
+    };
+
+    const auto dataFileName = _engine->getDataFilePathForIdent(ident)->filename();
+    auto backUp = [&](boost::optional<std::string> thisName, boost::optional<std::string> src) {
+        StorageEngine::BackupOptions backupOptions;
+        backupOptions.thisBackupName = thisName;
+        backupOptions.srcBackupName = src;
+        auto swFiles = _engine->beginNonBlockingBackup(opCtxPtr.get(), backupOptions);
+        ASSERT_OK(swFiles.getStatus());
+        _engine->endNonBlockingBackup(opCtxPtr.get());
+
+        for (const auto& file : swFiles.getValue()) {
+            if (boost::filesystem::path(file.filename).filename() == dataFileName) {
+                return file.changed;
+            }
+        }
+        FAIL("The data file is missing from the backup");
+        return false;
+    };
+
+    insertAndCheckpoint();
+    ASSERT_TRUE(backUp(std::string("full"), boost::none));
+
+    // Nothing was written since the full backup.
+    ASSERT_FALSE(backUp(std::string("first"), std::string("full")));
+
+    insertAndCheckpoint();
+    ASSERT_TRUE(backUp(std::string("second"), std::string("first")));
+
+    // Only the most recent named backups are remembered.
+    StorageEngine::BackupOptions forgotten;
+    forgotten.srcBackupName = std::string("full");
+    ASSERT_EQ(ErrorCodes::NoSuchKey,
+              _engine->beginNonBlockingBackup(opCtxPtr.get(), forgotten).getStatus());
+}
+
 std::unique_ptr<KVHarnessHelper> makeHelper() {
     return stdx::make_unique<WiredTigerKVHarnessHelper>();
 }
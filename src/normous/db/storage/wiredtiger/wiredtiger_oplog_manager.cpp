@@ -33,6 +33,8 @@
 
 #include <cstring>
 
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_oplog_manager.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
@@ -40,12 +42,17 @@
 #include "mongo/util/concurrency/idle_thread_block.h"
 #include "mongo/util/log.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 namespace {
 // This is the minimum valid timestamp; it can be used for reads that need to see all untimestamped
 // data but no timestamped data.  We cannot use 0 here because 0 means see all timestamped data.
 const uint64_t kMinimumTimestamp = 1;
+
+// When true, a committing thread advances oplog visibility itself if operations are waiting on it,
+// instead of waiting for the oplogJournal thread to wake up.
+MONGO_EXPORT_SERVER_PARAMETER(wiredTigerOplogInlineVisibility, bool, true);
 }  // namespace
 
 MONGO_FAIL_POINT_DEFINE(WTPausePrimaryOplogDurabilityLoop);
@@ -84,16 +91,26 @@ void WiredTigerOplogManager::start(OperationContext* opCtx,
                                        oplogRecordStore,
                                        updateOldestTimestamp);
 
+    _sessionCache = WiredTigerRecoveryUnit::get(opCtx)->getSessionCache();
+    _oplogRecordStore = oplogRecordStore;
+    _updateOldestTimestamp = updateOldestTimestamp;
+    _oldestPendingCommitMicros = 0;
     _isRunning = true;
     _shuttingDown = false;
 }
 
 void WiredTigerOplogManager::halt() {
     {
-        stdx::lock_guard<stdx::mutex> lk(_oplogVisibilityStateMutex);
+        stdx::unique_lock<stdx::mutex> lk(_oplogVisibilityStateMutex);
         invariant(_isRunning);
         _shuttingDown = true;
         _isRunning = false;
+
+        // The inline visibility path uses the session cache and the oplog record store outside of
+        // the mutex; both must stay valid until it is done.
+        _opsBecameVisibleCV.wait(lk, [&] { return !_inlineAdvanceActive; });
+        _sessionCache = nullptr;
+        _oplogRecordStore = nullptr;
     }
 
     if (_oplogJournalThread.joinable()) {
@@ -131,6 +148,12 @@ void WiredTigerOplogManager::waitForAllEarlierOplogWritesToBeVisible(
     invariant(_opsWaitingForVisibility > 0);
     auto exitGuard = MakeGuard([&] { _opsWaitingForVisibility--; });
 
+    // A journal flush may already be pending behind the journal delay; cut the delay short now
+    // rather than on the oplogJournal thread's next polling tick.
+    if (_opsWaitingForJournal) {
+        _opsWaitingForJournalCV.notify_one();
+    }
+
     opCtx->waitForConditionOrInterrupt(_opsBecameVisibleCV, lk, [&] {
         auto newLatestVisibleTimestamp = getOplogReadTimestamp();
         if (newLatestVisibleTimestamp < currentLatestVisibleTimestamp) {
@@ -157,12 +180,103 @@ void WiredTigerOplogManager::waitForAllEarlierOplogWritesToBeVisible(
 
 void WiredTigerOplogManager::triggerJournalFlush() {
     stdx::lock_guard<stdx::mutex> lk(_oplogVisibilityStateMutex);
+    if (!_oldestPendingCommitMicros) {
+        _oldestPendingCommitMicros = static_cast<long long>(curTimeMicros64());
+    }
     if (!_opsWaitingForJournal) {
         _opsWaitingForJournal = true;
         _opsWaitingForJournalCV.notify_one();
     }
 }
 
+void WiredTigerOplogManager::triggerOplogVisibilityUpdate() {
+    if (!wiredTigerOplogInlineVisibility.load() || !_tryAdvanceVisibilityInline()) {
+        triggerJournalFlush();
+    }
+}
+
+bool WiredTigerOplogManager::_tryAdvanceVisibilityInline() {
+    WiredTigerSessionCache* sessionCache;
+    WiredTigerRecordStore* oplogRecordStore;
+    bool updateOldestTimestamp;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_oplogVisibilityStateMutex);
+        // Only one committer advances visibility at a time; concurrent commits are covered by the
+        // oplogJournal thread, which batches them into a single update. Without waiters there is
+        // no latency to save, so leave the work to the oplogJournal thread as well.
+        if (!_isRunning || _shuttingDown || _inlineAdvanceActive || !_sessionCache) {
+            return false;
+        }
+        if (!_opsWaitingForVisibility && !_oplogRecordStore->haveCappedWaiters()) {
+            return false;
+        }
+        // Publishing a timestamp requires the oplog to be durable up to it. That is free for
+        // in-memory engines and a group-committed log flush with journaling enabled; without the
+        // journal it would be a full checkpoint, which does not belong on the commit path.
+        if (!_sessionCache->isEphemeral() && !_sessionCache->getKVEngine()->isDurable()) {
+            return false;
+        }
+        if (!_oldestPendingCommitMicros) {
+            _oldestPendingCommitMicros = static_cast<long long>(curTimeMicros64());
+        }
+        _inlineAdvanceActive = true;
+        sessionCache = _sessionCache;
+        oplogRecordStore = _oplogRecordStore;
+        updateOldestTimestamp = _updateOldestTimestamp;
+    }
+
+    bool advanced = false;
+    ON_BLOCK_EXIT([&] {
+        stdx::lock_guard<stdx::mutex> lk(_oplogVisibilityStateMutex);
+        _inlineAdvanceActive = false;
+        if (advanced) {
+            _inlineAdvances++;
+        }
+        // halt() may be waiting for the inline update to finish.
+        _opsBecameVisibleCV.notify_all();
+    });
+
+    const uint64_t newTimestamp = fetchAllCommittedValue(sessionCache->conn());
+    if (newTimestamp <= _oplogReadTimestamp.load()) {
+        // An earlier write is still uncommitted. Its own commit will advance visibility past this
+        // one.
+        return false;
+    }
+
+    try {
+        sessionCache->waitUntilDurable(/*forceCheckpoint=*/false, false);
+    } catch (const DBException& ex) {
+        LOG(2) << "inline oplog visibility update failed, deferring to the journal thread: "
+               << redact(ex);
+        return false;
+    }
+
+    advanced = _publishVisibleTimestamp(sessionCache, newTimestamp, updateOldestTimestamp);
+    if (advanced) {
+        oplogRecordStore->notifyCappedWaitersIfNeeded();
+    }
+    return advanced;
+}
+
+bool WiredTigerOplogManager::_publishVisibleTimestamp(WiredTigerSessionCache* sessionCache,
+                                                      uint64_t newTimestamp,
+                                                      bool updateOldestTimestamp) {
+    {
+        stdx::lock_guard<stdx::mutex> lk(_oplogVisibilityStateMutex);
+        // Publish the new timestamp value.  Avoid going backward.
+        if (newTimestamp <= getOplogReadTimestamp()) {
+            return false;
+        }
+        _setOplogReadTimestamp(lk, newTimestamp);
+    }
+
+    if (updateOldestTimestamp) {
+        const bool force = false;
+        sessionCache->getKVEngine()->setOldestTimestamp(Timestamp(newTimestamp), force);
+    }
+    return true;
+}
+
 void WiredTigerOplogManager::_oplogJournalThreadLoop(WiredTigerSessionCache* sessionCache,
                                                      WiredTigerRecordStore* oplogRecordStore,
                                                      const bool updateOldestTimestamp) noexcept {
@@ -234,17 +348,9 @@ void WiredTigerOplogManager::_oplogJournalThreadLoop(WiredTigerSessionCache* ses
         // oplog read timestamp's documents are durable before publishing that timestamp.
         sessionCache->waitUntilDurable(/*forceCheckpoint=*/false, false);
 
-        lk.lock();
-        // Publish the new timestamp value.  Avoid going backward.
-        auto oldTimestamp = getOplogReadTimestamp();
-        if (newTimestamp > oldTimestamp) {
-            _setOplogReadTimestamp(lk, newTimestamp);
-        }
-        lk.unlock();
-
-        if (updateOldestTimestamp) {
-            const bool force = false;
-            sessionCache->getKVEngine()->setOldestTimestamp(Timestamp(newTimestamp), force);
+        if (_publishVisibleTimestamp(sessionCache, newTimestamp, updateOldestTimestamp)) {
+            stdx::lock_guard<stdx::mutex> lk(_oplogVisibilityStateMutex);
+            _batchedAdvances++;
         }
 
         // Wake up any await_data cursors and tell them more data might be visible now.
@@ -263,10 +369,33 @@ void WiredTigerOplogManager::setOplogReadTimestamp(Timestamp ts) {
 
 void WiredTigerOplogManager::_setOplogReadTimestamp(WithLock, uint64_t newTimestamp) {
     _oplogReadTimestamp.store(newTimestamp);
+    if (_oldestPendingCommitMicros) {
+        const long long lag =
+            static_cast<long long>(curTimeMicros64()) - _oldestPendingCommitMicros;
+        _visibilityLagSamples++;
+        _visibilityLagTotalMicros += std::max(lag, 0LL);
+        _visibilityLagMaxMicros = std::max(_visibilityLagMaxMicros, lag);
+        _oldestPendingCommitMicros = 0;
+    }
     _opsBecameVisibleCV.notify_all();
     LOG(2) << "setting new oplogReadTimestamp: " << newTimestamp;
 }
 
+void WiredTigerOplogManager::appendStats(BSONObjBuilder* builder) const {
+    stdx::lock_guard<stdx::mutex> lk(_oplogVisibilityStateMutex);
+    BSONObjBuilder bob(builder->subobjStart("oplog visibility"));
+    bob.append("inline updates", _inlineAdvances);
+    bob.append("batched updates", _batchedAdvances);
+    bob.append("visibility lag samples", _visibilityLagSamples);
+    bob.append("visibility lag total micros", _visibilityLagTotalMicros);
+    bob.append("visibility lag max micros", _visibilityLagMaxMicros);
+    long long pendingMicros = 0;
+    if (_oldestPendingCommitMicros) {
+        pendingMicros = static_cast<long long>(curTimeMicros64()) - _oldestPendingCommitMicros;
+    }
+    bob.append("pending commit age micros", std::max(pendingMicros, 0LL));
+}
+
 uint64_t WiredTigerOplogManager::fetchAllCommittedValue(WT_CONNECTION* conn) {
     // Fetch the latest all_committed value from the storage engine.  This value will be a
     // timestamp that has no holes (uncommitted transactions with lower timestamps) behind it.
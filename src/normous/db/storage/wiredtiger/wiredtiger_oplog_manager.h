@@ -75,6 +75,13 @@ public:
     // Triggers the oplogJournal thread to update its oplog read timestamp, by flushing the journal.
     void triggerJournalFlush();
 
+    // Called after a timestamped, possibly out-of-order write commits. When operations are waiting
+    // for oplog visibility and the durability requirement can be met cheaply, the committing
+    // thread advances the oplog read timestamp itself. Otherwise this falls back to
+    // triggerJournalFlush(), which lets the oplogJournal thread batch the visibility update and
+    // the wakeup of waiters across many commits.
+    void triggerOplogVisibilityUpdate();
+
     // Waits until all committed writes at this point to become visible (that is, no holes exist in
     // the oplog.)
     void waitForAllEarlierOplogWritesToBeVisible(const WiredTigerRecordStore* oplogRecordStore,
@@ -84,7 +91,22 @@ public:
     // all committed timestamp are committed.
     uint64_t fetchAllCommittedValue(WT_CONNECTION* conn);
 
+    // Appends an "oplog visibility" subobject with counters for inline and batched visibility
+    // updates and the observed delay between a commit and its becoming visible.
+    void appendStats(BSONObjBuilder* builder) const;
+
 private:
+    // Attempts to advance the oplog read timestamp on the calling thread. Returns false if the
+    // caller should fall back to the oplogJournal thread.
+    bool _tryAdvanceVisibilityInline();
+
+    // Publishes `newTimestamp` if it is ahead of the current oplog read timestamp, records
+    // visibility lag, and updates the oldest timestamp when this manager is responsible for it.
+    // Returns true if the oplog read timestamp moved forward.
+    bool _publishVisibleTimestamp(WiredTigerSessionCache* sessionCache,
+                                  uint64_t newTimestamp,
+                                  bool updateOldestTimestamp);
+
     void _oplogJournalThreadLoop(WiredTigerSessionCache* sessionCache,
                                  WiredTigerRecordStore* oplogRecordStore,
                                  const bool updateOldestTimestamp) noexcept;
@@ -110,6 +132,26 @@ private:
     // journal flushing should not be delayed.
     std::int64_t _opsWaitingForVisibility = 0;  // Guarded by oplogVisibilityStateMutex.
 
+    // Set while a committing thread is advancing visibility inline. halt() waits for it to clear
+    // so that the session cache and the oplog record store outlive the inline update.
+    bool _inlineAdvanceActive = false;  // Guarded by oplogVisibilityStateMutex.
+
+    // Captured in start() for the inline visibility path.
+    WiredTigerSessionCache* _sessionCache = nullptr;     // Guarded by oplogVisibilityStateMutex.
+    WiredTigerRecordStore* _oplogRecordStore = nullptr;  // Guarded by oplogVisibilityStateMutex.
+    bool _updateOldestTimestamp = false;                 // Guarded by oplogVisibilityStateMutex.
+
+    // Wall clock time, in microseconds, of the earliest commit that has not been made visible yet;
+    // zero when nothing is pending.
+    long long _oldestPendingCommitMicros = 0;  // Guarded by oplogVisibilityStateMutex.
+
+    // Visibility metrics, guarded by oplogVisibilityStateMutex.
+    long long _inlineAdvances = 0;
+    long long _batchedAdvances = 0;
+    long long _visibilityLagSamples = 0;
+    long long _visibilityLagTotalMicros = 0;
+    long long _visibilityLagMaxMicros = 0;
+
     AtomicUInt64 _oplogReadTimestamp;
 };
 }  // namespace mongo
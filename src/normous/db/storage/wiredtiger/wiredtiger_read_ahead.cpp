@@ -0,0 +1,185 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_read_ahead.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
+#include "mongo/util/log.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+
+MONGO_EXPORT_SERVER_PARAMETER(wiredTigerCursorReadAheadBytes, int, 0)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0) {
+            return Status(ErrorCodes::BadValue,
+                          "wiredTigerCursorReadAheadBytes must be greater than or equal to 0");
+        }
+        return Status::OK();
+    });
+
+namespace {
+
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(wiredTigerReadAheadThreads, int, 4)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 1) {
+            return Status(ErrorCodes::BadValue, "wiredTigerReadAheadThreads must be at least 1");
+        }
+        return Status::OK();
+    });
+
+// Each thread may have this many further read-aheads queued behind the one it is running. Beyond
+// that, new requests are dropped: a read-ahead that starts late is of little use to a scan.
+const int kQueuedRequestsPerThread = 4;
+
+ThreadPool::Options makePoolOptions() {
+    ThreadPool::Options options;
+    options.poolName = "WTReadAhead";
+    options.minThreads = 0;
+    options.maxThreads = static_cast<size_t>(wiredTigerReadAheadThreads);
+    return options;
+}
+
+}  // namespace
+
+WiredTigerReadAhead::WiredTigerReadAhead(WiredTigerSessionCache* sessionCache)
+    : _sessionCache(sessionCache), _pool(makePoolOptions()) {}
+
+void WiredTigerReadAhead::startup() {
+    _pool.startup();
+}
+
+void WiredTigerReadAhead::shutdown() {
+    _shuttingDown.store(true);
+    _pool.shutdown();
+    _pool.join();
+}
+
+bool WiredTigerReadAhead::schedule(Request request) {
+    if (_shuttingDown.load() ||
+        _queued.load() >= wiredTigerReadAheadThreads * kQueuedRequestsPerThread ||
+        request.token->inFlight.swap(true)) {
+        _requestsSkipped.fetchAndAdd(1);
+        return false;
+    }
+
+    _queued.fetchAndAdd(1);
+    auto token = request.token;
+    Status status = _pool.schedule([ this, request = std::move(request) ] {
+        ON_BLOCK_EXIT([&] {
+            _queued.fetchAndSubtract(1);
+            request.token->inFlight.store(false);
+        });
+        _doReadAhead(request);
+    });
+
+    if (!status.isOK()) {
+        // The pool has been shut down underneath us.
+        _queued.fetchAndSubtract(1);
+        token->inFlight.store(false);
+        _requestsSkipped.fetchAndAdd(1);
+        return false;
+    }
+
+    _requestsScheduled.fetchAndAdd(1);
+    return true;
+}
+
+void WiredTigerReadAhead::_doReadAhead(const Request& request) {
+    if (_shuttingDown.load() || request.token->cancelled.load()) {
+        return;
+    }
+
+    auto session = _sessionCache->getSession();
+    WT_SESSION* s = session->getSession();
+
+    // Open the cursor directly rather than through the session's cursor cache: the table may have
+    // been dropped since the request was made, and that must end the read-ahead, not the process.
+    WT_CURSOR* c = nullptr;
+    if (s->open_cursor(s, request.uri.c_str(), nullptr, nullptr, &c) != 0) {
+        return;
+    }
+    ON_BLOCK_EXIT([c] { c->close(c); });
+
+    if (request.prefix) {
+        c->set_key(c, *request.prefix, request.startAfter.repr());
+    } else {
+        c->set_key(c, request.startAfter.repr());
+    }
+
+    int cmp;
+    int ret = c->search_near(c, &cmp);
+    if (ret == 0 && cmp <= 0) {
+        ret = c->next(c);
+    }
+
+    int64_t bytesRead = 0;
+    while (ret == 0 && bytesRead < request.maxBytes) {
+        if (request.token->cancelled.loadRelaxed() || _shuttingDown.loadRelaxed()) {
+            break;
+        }
+
+        if (request.prefix) {
+            int64_t prefix;
+            int64_t id;
+            if (c->get_key(c, &prefix, &id) != 0 || prefix != *request.prefix) {
+                break;
+            }
+        }
+
+        // Fetching the value is what forces the leaf page into the cache.
+        WT_ITEM value;
+        if (c->get_value(c, &value) != 0) {
+            break;
+        }
+        bytesRead += value.size;
+
+        ret = c->next(c);
+    }
+
+    _bytesRead.fetchAndAdd(bytesRead);
+    LOG(3) << "WiredTiger read-ahead on " << request.uri << " after " << request.startAfter
+           << " read " << bytesRead << " bytes";
+}
+
+void WiredTigerReadAhead::appendStats(BSONObjBuilder* builder) const {
+    BSONObjBuilder bob(builder->subobjStart("cursor read-ahead"));
+    bob.append("requests scheduled", _requestsScheduled.load());
+    bob.append("requests skipped", _requestsSkipped.load());
+    bob.append("bytes read", _bytesRead.load());
+    bob.done();
+}
+
+}  // namespace mongo
@@ -0,0 +1,124 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <boost/optional.hpp>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/db/record_id.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/concurrency/thread_pool.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+class WiredTigerSessionCache;
+
+/**
+ * Controls the read-ahead performed for forward collection scans. A value of 0 disables read-ahead;
+ * otherwise this is the number of bytes of record data that a single scanning cursor may have
+ * prefetched ahead of its current position.
+ */
+extern AtomicInt32 wiredTigerCursorReadAheadBytes;
+
+/**
+ * Warms the WiredTiger cache ahead of sequential record store scans.
+ *
+ * A forward cursor that has been observed to scan sequentially hands this class the position it
+ * has reached. A background thread then walks the table from that position with a cursor of its
+ * own, reading record values until a byte budget is exhausted, so that the leaf pages the scan is
+ * about to visit are already resident by the time it gets there. Read-ahead is purely an
+ * optimization: the background reads return nothing to the scan, and any error or contention
+ * simply ends the read-ahead early.
+ */
+class WiredTigerReadAhead {
+    MONGO_DISALLOW_COPYING(WiredTigerReadAhead);
+
+public:
+    /**
+     * State shared between a scanning cursor and the read-ahead it has in flight. The cursor marks
+     * it as cancelled when it is destroyed or repositioned, which ends the read-ahead early.
+     */
+    struct Token {
+        AtomicWord<bool> inFlight{false};
+        AtomicWord<bool> cancelled{false};
+    };
+
+    struct Request {
+        std::string uri;
+
+        // Set only for record stores sharing a table with other collections.
+        boost::optional<int64_t> prefix;
+
+        // The last record returned by the scan; read-ahead starts after it.
+        RecordId startAfter;
+
+        int64_t maxBytes;
+
+        std::shared_ptr<Token> token;
+    };
+
+    explicit WiredTigerReadAhead(WiredTigerSessionCache* sessionCache);
+
+    void startup();
+
+    /**
+     * Cancels any queued read-aheads and waits for running ones to finish. Must be called before
+     * the session cache is shut down.
+     */
+    void shutdown();
+
+    /**
+     * Queues 'request' for execution on the background pool. Returns false, without queueing
+     * anything, if the request's token already has a read-ahead in flight or the pool is
+     * saturated.
+     */
+    bool schedule(Request request);
+
+    void appendStats(BSONObjBuilder* builder) const;
+
+private:
+    void _doReadAhead(const Request& request);
+
+    WiredTigerSessionCache* const _sessionCache;
+    ThreadPool _pool;
+
+    AtomicWord<bool> _shuttingDown{false};
+    AtomicInt32 _queued;
+
+    AtomicInt64 _requestsScheduled;
+    AtomicInt64 _requestsSkipped;
+    AtomicInt64 _bytesRead;
+};
+
+}  // namespace mongo
@@ -37,6 +37,9 @@
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 
+#include <algorithm>
+#include <numeric>
+
 #include "mongo/base/checked_cast.h"
 #include "mongo/base/static_assert.h"
 #include "mongo/bson/util/builder.h"
@@ -49,7 +52,11 @@
 #include "mongo/db/repl/repl_settings.h"
 #include "mongo/db/server_recovery.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/storage/clustered_record_id.h"
+#include "mongo/db/storage/index_entry_comparison.h"
 #include "mongo/db/storage/oplog_hack.h"
+#include "mongo/db/storage/storage_operation_stats.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_compressor_advisor.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
@@ -87,6 +94,131 @@ void checkOplogFormatVersion(OperationContext* opCtx, const std::string& uri) {
 
     fassertNoTrace(39998, appMetadata.getValue().getIntField("oplogKeyExtractionVersion") == 1);
 }
+
+// The app_metadata key under which the compressor picked in "auto" mode is recorded.
+const char kBlockCompressorChoiceKey[] = "blockCompressorChoice";
+
+bool isAutoBlockCompressor() {
+    return wiredTigerGlobalOptions.collectionBlockCompressor == "auto";
+}
+
+/**
+ * Rewrites the app_metadata of 'uri' to record 'choice', keeping every other key as it is.
+ */
+Status recordBlockCompressorChoice(OperationContext* opCtx,
+                                   WT_CONNECTION* conn,
+                                   const std::string& uri,
+                                   StringData choice) {
+    StatusWith<std::string> metadata = WiredTigerUtil::getMetadata(opCtx, uri);
+    if (!metadata.isOK()) {
+        return metadata.getStatus();
+    }
+
+    str::stream appMetadata;
+    appMetadata << "app_metadata=(";
+    WiredTigerConfigParser topParser(metadata.getValue());
+    WT_CONFIG_ITEM existing;
+    if (topParser.get("app_metadata", &existing) == 0 && existing.len != 0) {
+        WiredTigerConfigParser parser(existing);
+        WT_CONFIG_ITEM keyItem;
+        WT_CONFIG_ITEM valueItem;
+        int ret;
+        while ((ret = parser.next(&keyItem, &valueItem)) == 0) {
+            const StringData key(keyItem.str, keyItem.len);
+            if (key == kBlockCompressorChoiceKey) {
+                continue;
+            }
+            const StringData value(valueItem.str, valueItem.len);
+            appMetadata << key << "=";
+            if (valueItem.type == WT_CONFIG_ITEM::WT_CONFIG_ITEM_STRING) {
+                appMetadata << '"' << value << '"';
+            } else {
+                appMetadata << value;
+            }
+            appMetadata << ",";
+        }
+        if (ret != WT_NOTFOUND) {
+            return wtRCToStatus(ret);
+        }
+    }
+    appMetadata << kBlockCompressorChoiceKey << "=" << choice << "),";
+
+    // Like KVEngine::alterIdentMetadata(), avoid taking an exclusive handle so that the alter does
+    // not conflict with cursors other operations have cached on this table.
+    const std::string alterString = std::string(appMetadata) + "exclusive_refreshed=false,";
+    WiredTigerSession session(conn);
+    return wtRCToStatus(
+        session.getSession()->alter(session.getSession(), uri.c_str(), alterString.c_str()));
+}
+
+// Updates of records at least this large are written as WT_CURSOR::modify() change records when
+// they touch few enough bytes of the record.
+const size_t kMinRecordLengthForModify = 1024;
+const size_t kMaxModifyEntries = 16;
+// Differing bytes separated by fewer equal bytes than this are replaced by a single entry.
+const size_t kModifyEntryMergeGap = 8;
+
+/**
+ * Fills 'entries' with modifications turning 'oldValue' into the 'newLen' bytes at 'newData', so
+ * that an update which only rewrites a few fields, or appends to or removes from the middle of a
+ * large record, does not have to store the complete new record. Regions at the same offset in both
+ * values become same-size replacements, and a single final entry inserts or removes the bytes by
+ * which the values differ in length, just before their common suffix. Returns false if that takes
+ * more than kMaxModifyEntries entries or replaces more than 'maxDiffBytes' bytes.
+ */
+bool calculateModify(const WT_ITEM& oldValue,
+                     const char* newData,
+                     size_t newLen,
+                     size_t maxDiffBytes,
+                     std::vector<WT_MODIFY>* entries) {
+    const char* oldData = static_cast<const char*>(oldValue.data);
+    const size_t oldLen = oldValue.size;
+
+    size_t suffixLen = 0;
+    const size_t maxSuffixLen = std::min(oldLen, newLen);
+    while (suffixLen < maxSuffixLen &&
+           oldData[oldLen - suffixLen - 1] == newData[newLen - suffixLen - 1]) {
+        ++suffixLen;
+    }
+    const size_t oldEnd = oldLen - suffixLen;
+    const size_t newEnd = newLen - suffixLen;
+    const size_t sameOffsetEnd = std::min(oldEnd, newEnd);
+
+    size_t diffBytes = 0;
+    auto addEntry = [&](size_t offset, size_t oldSize, size_t newSize) {
+        WT_MODIFY entry;
+        entry.data.data = newData + offset;
+        entry.data.size = newSize;
+        entry.offset = offset;
+        entry.size = oldSize;
+        entries->push_back(entry);
+        diffBytes += std::max(oldSize, newSize);
+        return entries->size() <= kMaxModifyEntries && diffBytes <= maxDiffBytes;
+    };
+
+    for (size_t pos = 0; pos < sameOffsetEnd; ++pos) {
+        if (oldData[pos] == newData[pos]) {
+            continue;
+        }
+        const size_t start = pos;
+        size_t lastDiff = pos;
+        for (++pos; pos < sameOffsetEnd && pos - lastDiff < kModifyEntryMergeGap; ++pos) {
+            if (oldData[pos] != newData[pos]) {
+                lastDiff = pos;
+            }
+        }
+        const size_t size = lastDiff + 1 - start;
+        if (!addEntry(start, size, size)) {
+            return false;
+        }
+        pos = lastDiff;
+    }
+
+    if (oldEnd != newEnd) {
+        return addEntry(sameOffsetEnd, oldEnd - sameOffsetEnd, newEnd - sameOffsetEnd);
+    }
+    return true;
+}
 }  // namespace
 
 MONGO_FAIL_POINT_DEFINE(WTWriteConflictException);
@@ -147,6 +279,7 @@ public:
 
         stdx::lock_guard<stdx::mutex> lk(_oplogStones->_mutex);
         _oplogStones->_stones.clear();
+        _oplogStones->_markNeedsPersist();
     }
 
     void rollback() final {}
@@ -171,7 +304,10 @@ WiredTigerRecordStore::OplogStones::OplogStones(OperationContext* opCtx, WiredTi
     _minBytesPerStone = maxSize / numStonesToKeep;
     invariant(_minBytesPerStone > 0);
 
-    _calculateStones(opCtx, numStonesToKeep);
+    if (!_loadPersistedStones(opCtx)) {
+        _calculateStones(opCtx, numStonesToKeep);
+        _markNeedsPersist();
+    }
     _pokeReclaimThreadIfNeeded();  // Reclaim stones if over the limit.
 }
 
@@ -189,12 +325,16 @@ void WiredTigerRecordStore::OplogStones::kill() {
 }
 
 void WiredTigerRecordStore::OplogStones::awaitHasExcessStonesOrDead() {
-    // Wait until kill() is called or there are too many oplog stones.
+    // Wait until kill() is called, there are too many oplog stones, or the oplog stones need to be
+    // persisted.
     stdx::unique_lock<stdx::mutex> lock(_oplogReclaimMutex);
     while (!_isDead) {
         {
             MONGO_IDLE_THREAD_BLOCK;
             stdx::lock_guard<stdx::mutex> lk(_mutex);
+            if (_needsPersist.load()) {
+                break;
+            }
             if (hasExcessStones_inlock()) {
                 // There are now excess oplog stones. However, there it may be necessary to keep
                 // additional oplog.
@@ -229,6 +369,28 @@ WiredTigerRecordStore::OplogStones::peekOldestStoneIfNeeded() const {
 void WiredTigerRecordStore::OplogStones::popOldestStone() {
     stdx::lock_guard<stdx::mutex> lk(_mutex);
     _stones.pop_front();
+    _markNeedsPersist();
+}
+
+void WiredTigerRecordStore::OplogStones::persistIfNeeded() {
+    if (!_needsPersist.swap(false) || !_rs->_sizeStorer) {
+        return;
+    }
+
+    BSONObjBuilder builder;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        builder.append("minBytesPerStone", static_cast<long long>(_minBytesPerStone));
+        BSONArrayBuilder stonesBuilder(builder.subarrayStart("stones"));
+        for (const auto& stone : _stones) {
+            stonesBuilder.append(BSON("records" << static_cast<long long>(stone.records) << "bytes"
+                                                << static_cast<long long>(stone.bytes)
+                                                << "lastRecord"
+                                                << stone.lastRecord.repr()));
+        }
+        stonesBuilder.done();
+    }
+    _rs->_sizeStorer->storeMetadata(persistedStonesKey(_rs->_uri), builder.obj());
 }
 
 void WiredTigerRecordStore::OplogStones::createNewStoneIfNeeded(RecordId lastRecord) {
@@ -254,6 +416,7 @@ void WiredTigerRecordStore::OplogStones::createNewStoneIfNeeded(RecordId lastRec
     LOG(2) << "create new oplogStone, current stones:" << _stones.size();
     OplogStones::Stone stone = {_currentRecords.swap(0), _currentBytes.swap(0), lastRecord};
     _stones.push_back(stone);
+    _markNeedsPersist();
 
     _pokeReclaimThreadIfNeeded();
 }
@@ -298,6 +461,10 @@ void WiredTigerRecordStore::OplogStones::updateStonesAfterCappedTruncateAfter(
     // being filled.
     _currentRecords.addAndFetch(recordsInStonesToRemove - recordsRemoved);
     _currentBytes.addAndFetch(bytesInStonesToRemove - bytesRemoved);
+
+    if (numStonesToRemove > 0) {
+        _markNeedsPersist();
+    }
 }
 
 void WiredTigerRecordStore::OplogStones::setMinBytesPerStone(int64_t size) {
@@ -448,6 +615,102 @@ void WiredTigerRecordStore::OplogStones::_calculateStonesBySampling(OperationCon
     _currentBytes.store(_rs->dataSize(opCtx) - estBytesPerStone * wholeStones);
 }
 
+bool WiredTigerRecordStore::OplogStones::_loadPersistedStones(OperationContext* opCtx) {
+    if (!_rs->_sizeStorer) {
+        return false;
+    }
+
+    BSONObj persisted = _rs->_sizeStorer->loadMetadata(persistedStonesKey(_rs->_uri));
+    if (persisted.isEmpty()) {
+        return false;
+    }
+
+    if (persisted["minBytesPerStone"].safeNumberLong() != _minBytesPerStone) {
+        log() << "Not reusing the persisted oplog stones because they were placed for a different "
+                 "oplog size";
+        return false;
+    }
+
+    BSONElement stonesElem = persisted["stones"];
+    if (stonesElem.type() != Array) {
+        return false;
+    }
+
+    // Only the stones that still fall within the oplog are reused. The ones before the first record
+    // were already truncated, and the ones after the last record were removed by a rollback or a
+    // truncation that was not persisted before shutdown.
+    RecordId earliest;
+    RecordId latest;
+    {
+        auto cursor = _rs->getCursor(opCtx, true);
+        auto record = cursor->next();
+        if (!record) {
+            return false;
+        }
+        earliest = record->id;
+    }
+    {
+        auto cursor = _rs->getCursor(opCtx, false);
+        auto record = cursor->next();
+        if (!record) {
+            return false;
+        }
+        latest = record->id;
+    }
+
+    std::deque<OplogStones::Stone> stones;
+    int64_t recordsInStones = 0;
+    int64_t bytesInStones = 0;
+    for (auto&& elem : stonesElem.Obj()) {
+        if (elem.type() != Object) {
+            return false;
+        }
+        BSONObj stoneObj = elem.Obj();
+        OplogStones::Stone stone = {stoneObj["records"].safeNumberLong(),
+                                    stoneObj["bytes"].safeNumberLong(),
+                                    RecordId(stoneObj["lastRecord"].safeNumberLong())};
+        if (!stone.lastRecord.isNormal() || stone.records < 0 || stone.bytes < 0 ||
+            (!stones.empty() && stone.lastRecord <= stones.back().lastRecord)) {
+            warning() << "Not reusing the persisted oplog stones because they are malformed: "
+                      << redact(persisted);
+            return false;
+        }
+        if (stone.lastRecord < earliest) {
+            continue;
+        }
+        if (stone.lastRecord > latest) {
+            break;
+        }
+        stones.push_back(stone);
+        recordsInStones += stone.records;
+        bytesInStones += stone.bytes;
+    }
+
+    // The stone being filled must only account for records inserted after the last persisted
+    // stone. If the persisted stones cover too little of the oplog, place new ones instead.
+    const int64_t numRecords = _rs->numRecords(opCtx);
+    const int64_t dataSize = _rs->dataSize(opCtx);
+    if (dataSize - bytesInStones >= 2 * _minBytesPerStone) {
+        log() << "Not reusing the persisted oplog stones because they cover " << bytesInStones
+              << " of the " << dataSize << " bytes in the oplog";
+        return false;
+    }
+
+    _stones = std::move(stones);
+    _currentRecords.store(std::max<int64_t>(0, numRecords - recordsInStones));
+    _currentBytes.store(std::max<int64_t>(0, dataSize - bytesInStones));
+
+    log() << "Reusing " << _stones.size() << " persisted oplog stones; the stone being filled "
+          << "contains approximately " << _currentRecords.load() << " records totaling to "
+          << _currentBytes.load() << " bytes";
+    return true;
+}
+
+void WiredTigerRecordStore::OplogStones::_markNeedsPersist() {
+    _needsPersist.store(true);
+    _oplogReclaimCv.notify_one();
+}
+
 void WiredTigerRecordStore::OplogStones::_pokeReclaimThreadIfNeeded() {
     if (hasExcessStones_inlock()) {
         _oplogReclaimCv.notify_one();
@@ -463,6 +726,7 @@ void WiredTigerRecordStore::OplogStones::adjust(int64_t maxSize) {
     size_t numStonesToKeep = std::min(kMaxStonesToKeep, std::max(kMinStonesToKeep, numStones));
     _minBytesPerStone = maxSize / numStonesToKeep;
     invariant(_minBytesPerStone > 0);
+    _markNeedsPersist();
     _pokeReclaimThreadIfNeeded();
 }
 
@@ -511,6 +775,7 @@ public:
 
         WT_ITEM value;
         invariantWTOK(_cursor->get_value(_cursor, &value));
+        StorageOperationStats::get(_opCtx).incBytesRead(value.size);
 
         return {{id, {static_cast<const char*>(value.data), static_cast<int>(value.size)}}};
     }
@@ -583,7 +848,12 @@ StatusWith<std::string> WiredTigerRecordStore::generateCreateString(
         ss << "prefix_compression,";
     }
 
-    ss << "block_compressor=" << wiredTigerGlobalOptions.collectionBlockCompressor << ",";
+    // In "auto" mode a new collection has no data to sample yet, so it starts out with the
+    // default compressor; compact() samples it later and records the compressor its data calls for.
+    ss << "block_compressor="
+       << (isAutoBlockCompressor() ? WiredTigerCompressorAdvisor::kDefaultCompressor.toString()
+                                   : wiredTigerGlobalOptions.collectionBlockCompressor)
+       << ",";
 
     ss << WiredTigerCustomizationHooks::get(getGlobalServiceContext())->getTableCreateConfig(ns);
 
@@ -638,8 +908,13 @@ WiredTigerRecordStore::WiredTigerRecordStore(WiredTigerKVEngine* kvEngine,
       _tableId(WiredTigerSession::genTableId()),
       _engineName(params.engineName),
       _isCapped(params.isCapped),
+      _isClustered(params.isClustered),
       _isEphemeral(params.isEphemeral),
       _isOplog(NamespaceString::oplog(params.ns)),
+      _isLogged(WiredTigerUtil::useTableLogging(
+          NamespaceString(params.ns),
+          getGlobalReplSettings().usingReplSets() ||
+              repl::ReplSettings::shouldRecoverFromOplogAsStandalone())),
       _cappedMaxSize(params.cappedMaxSize),
       _cappedMaxSizeSlack(std::min(params.cappedMaxSize / 10, int64_t(16 * 1024 * 1024))),
       _cappedMaxDocs(params.cappedMaxDocs),
@@ -831,7 +1106,9 @@ RecordData WiredTigerRecordStore::dataFor(OperationContext* opCtx, const RecordI
     int ret = wiredTigerPrepareConflictRetry(opCtx, [&] { return c->search(c); });
     massert(28556, "Didn't find RecordId in WiredTigerRecordStore", ret != WT_NOTFOUND);
     invariantWTOK(ret);
-    return _getData(curwrap);
+    auto data = _getData(curwrap);
+    StorageOperationStats::get(opCtx).incBytesRead(data.size());
+    return data;
 }
 
 bool WiredTigerRecordStore::findRecord(OperationContext* opCtx,
@@ -849,6 +1126,7 @@ bool WiredTigerRecordStore::findRecord(OperationContext* opCtx,
     }
     invariantWTOK(ret);
     *out = _getData(curwrap);
+    StorageOperationStats::get(opCtx).incBytesRead(out->size());
     return true;
 }
 
@@ -1173,12 +1451,13 @@ void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx) {
 
 void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx, Timestamp mayTruncateUpTo) {
     Timer timer;
+    int numStonesTruncated = 0;
     while (auto stone = _oplogStones->peekOldestStoneIfNeeded()) {
         invariant(stone->lastRecord.isValid());
 
         if (static_cast<std::uint64_t>(stone->lastRecord.repr()) >= mayTruncateUpTo.asULL()) {
             // Do not truncate oplogs needed for replication recovery.
-            return;
+            break;
         }
 
         LOG(1) << "Truncating the oplog between " << _oplogStones->firstRecord << " and "
@@ -1215,11 +1494,18 @@ void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx, Timestamp mayT
 
             // Stash the truncate point for next time to cleanly skip over tombstones, etc.
             _oplogStones->firstRecord = stone->lastRecord;
+            ++numStonesTruncated;
         } catch (const WriteConflictException&) {
             LOG(1) << "Caught WriteConflictException while truncating oplog entries, retrying";
         }
     }
 
+    _oplogStones->persistIfNeeded();
+
+    if (numStonesTruncated == 0) {
+        return;
+    }
+
     LOG(1) << "Finished truncating the oplog, it now contains approximately "
            << _sizeInfo->numRecords.load() << " records totaling to " << _sizeInfo->dataSize.load()
            << " bytes";
@@ -1263,13 +1549,21 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
             if (!status.isOK())
                 return status.getStatus();
             record.id = status.getValue();
-        } else if (_isCapped) {
-            record.id = _nextId();
+        } else if (_isClustered) {
+            StatusWith<RecordId> status =
+                clustered_record_id::extractKey(record.data.data(), record.data.size());
+            if (!status.isOK())
+                return status.getStatus();
+            record.id = status.getValue();
+        } else if (_isCapped && !timestamps[i].isNull()) {
+            record.id = _nextCappedIdForTimestamp(opCtx, c, timestamps[i]);
         } else {
             record.id = _nextId();
         }
-        dassert(record.id > highestId);
-        highestId = record.id;
+        // The RecordIds of a clustered collection follow the order of the documents' _id values,
+        // rather than the order of the inserts.
+        dassert(_isClustered || record.id > highestId);
+        highestId = std::max(highestId, record.id);
     }
 
     for (size_t i = 0; i < nRecords; i++) {
@@ -1291,12 +1585,28 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
             LOG(4) << "inserting record with timestamp " << ts;
             fassert(39001, opCtx->recoveryUnit()->setTimestamp(ts));
         }
+        if (_isClustered) {
+            // Record store cursors overwrite existing records, so the _id must be checked for a
+            // document already in the collection. An insert of the same _id by a concurrent
+            // transaction conflicts with this one.
+            setKey(c, record.id);
+            int ret = wiredTigerPrepareConflictRetry(opCtx, [&] { return c->search(c); });
+            if (ret == 0) {
+                return buildDupKeyErrorStatus(BSONObj(record.data.data())["_id"].wrap(""),
+                                              ns(),
+                                              "_id_",
+                                              BSON("_id" << 1));
+            }
+            if (ret != WT_NOTFOUND)
+                return wtRCToStatus(ret, "WiredTigerRecordStore::insertRecord");
+        }
         setKey(c, record.id);
         WiredTigerItem value(record.data.data(), record.data.size());
         c->set_value(c, value.Get());
         int ret = WT_OP_CHECK(c->insert(c));
         if (ret)
             return wtRCToStatus(ret, "WiredTigerRecordStore::insertRecord");
+        StorageOperationStats::get(opCtx).incBytesWritten(record.data.size());
     }
 
     _changeNumRecords(opCtx, nRecords);
@@ -1409,10 +1719,20 @@ Status WiredTigerRecordStore::updateRecord(OperationContext* opCtx,
         return {ErrorCodes::IllegalOperation, "Cannot change the size of a document in the oplog"};
     }
 
-    WiredTigerItem value(data, len);
-    c->set_value(c, value.Get());
-    ret = WT_OP_CHECK(c->insert(c));
+    // Write a change record rather than the whole record when only a small part of a large record
+    // changes. Logged tables are skipped: unlike complete values, replaying a change record which
+    // inserts or removes bytes is not idempotent.
+    std::vector<WT_MODIFY> entries;
+    if (!_isLogged && static_cast<size_t>(len) >= kMinRecordLengthForModify &&
+        calculateModify(old_value, data, len, len / 10, &entries) && !entries.empty()) {
+        ret = WT_OP_CHECK(c->modify(c, entries.data(), entries.size()));
+    } else {
+        WiredTigerItem value(data, len);
+        c->set_value(c, value.Get());
+        ret = WT_OP_CHECK(c->insert(c));
+    }
     invariantWTOK(ret);
+    StorageOperationStats::get(opCtx).incBytesWritten(len);
 
     _increaseDataSize(opCtx, len - old_length);
     if (!_oplogStones) {
@@ -1498,10 +1818,28 @@ Status WiredTigerRecordStore::compact(OperationContext* opCtx,
 
     WiredTigerSessionCache* cache = WiredTigerRecoveryUnit::get(opCtx)->getSessionCache();
     if (!cache->isEphemeral()) {
+        boost::optional<WiredTigerCompressorAdvisor::Choice> compressorChoice;
+        if (isAutoBlockCompressor()) {
+            compressorChoice = WiredTigerCompressorAdvisor::chooseForRecordStore(opCtx, this);
+        }
+
         WT_SESSION* s = WiredTigerRecoveryUnit::get(opCtx)->getSession()->getSession();
         opCtx->recoveryUnit()->abandonSnapshot();
         int ret = s->compact(s, getURI().c_str(), "timeout=0");
         invariantWTOK(ret);
+
+        if (compressorChoice) {
+            BSONObjBuilder details;
+            compressorChoice->appendToBSON(&details);
+            log() << "Block compressor choice for " << ns() << ": " << details.obj();
+
+            Status status = recordBlockCompressorChoice(
+                opCtx, cache->conn(), getURI(), compressorChoice->compressor);
+            if (!status.isOK()) {
+                warning() << "Failed to record the block compressor choice for " << ns() << ": "
+                          << redact(status);
+            }
+        }
     }
     return Status::OK();
 }
@@ -1610,6 +1948,15 @@ void WiredTigerRecordStore::appendCustomStats(OperationContext* opCtx,
         bob.append("creationString", metadataResult.getValue());
         // Type can be "lsm" or "file"
         bob.append("type", type);
+
+        // The compressor the table was created with. In "auto" mode, the compressor its sampled
+        // data calls for is reported under "metadata" as well.
+        WiredTigerConfigParser parser(metadataResult.getValue());
+        WT_CONFIG_ITEM compressor;
+        if (parser.get("block_compressor", &compressor) == 0) {
+            const StringData name(compressor.str, compressor.len);
+            bob.append("blockCompressor", name.empty() ? WiredTigerCompressorAdvisor::kNone : name);
+        }
     }
 
     Status status =
@@ -1640,11 +1987,24 @@ void WiredTigerRecordStore::waitForAllEarlierOplogWritesToBeVisible(OperationCon
     }
 }
 
+boost::optional<RecordId> WiredTigerRecordStore::getCappedVisibilityBound(
+    OperationContext* opCtx) const {
+    invariant(keysCappedInsertsByTimestamp());
+
+    // Timestamped inserts into a capped collection commit along with their oplog entries, so the
+    // oplog's visibility point also bounds the capped collection's committed prefix.
+    auto oplogManager = _kvEngine ? _kvEngine->getOplogManager() : nullptr;
+    if (!oplogManager || !oplogManager->isRunning()) {
+        return boost::none;
+    }
+    return RecordId(static_cast<int64_t>(oplogManager->getOplogReadTimestamp()));
+}
+
 boost::optional<RecordId> WiredTigerRecordStore::oplogStartHack(
     OperationContext* opCtx, const RecordId& startingPosition) const {
     dassert(opCtx->lockState()->isReadLocked());
 
-    if (!_isOplog)
+    if (!_isOplog && !_isClustered)
         return boost::none;
 
     if (_isOplog) {
@@ -1687,6 +2047,37 @@ RecordId WiredTigerRecordStore::_nextId() {
     return out;
 }
 
+RecordId WiredTigerRecordStore::_nextCappedIdForTimestamp(OperationContext* opCtx,
+                                                          WT_CURSOR* cursor,
+                                                          Timestamp ts) {
+    invariant(keysCappedInsertsByTimestamp());
+    RecordId id(static_cast<int64_t>(ts.asULL()));
+    invariant(id.isNormal());
+
+    // Untimestamped inserts keep drawing RecordIds from '_nextIdNum', so move it past this one.
+    int64_t next = _nextIdNum.load();
+    while (next <= id.repr()) {
+        const int64_t previous = _nextIdNum.compareAndSwap(next, id.repr() + 1);
+        if (previous == next) {
+            break;
+        }
+        next = previous;
+    }
+
+    // A record can only already exist under this timestamp if untimestamped inserts advanced
+    // '_nextIdNum' into the range of timestamps. Record store cursors overwrite existing records,
+    // so give this insert the next sequential RecordId instead.
+    setKey(cursor, id);
+    int ret = wiredTigerPrepareConflictRetry(opCtx, [&] { return cursor->search(cursor); });
+    if (ret == 0) {
+        return _nextId();
+    }
+    if (ret != WT_NOTFOUND) {
+        invariantWTOK(ret);
+    }
+    return id;
+}
+
 WiredTigerRecoveryUnit* WiredTigerRecordStore::_getRecoveryUnit(OperationContext* opCtx) {
     return checked_cast<WiredTigerRecoveryUnit*>(opCtx->recoveryUnit());
 }
@@ -1867,6 +2258,10 @@ WiredTigerRecordStoreCursorBase::WiredTigerRecordStoreCursorBase(OperationContex
     _cursor.emplace(rs.getURI(), rs.tableId(), true, opCtx);
 }
 
+WiredTigerRecordStoreCursorBase::~WiredTigerRecordStoreCursorBase() {
+    _resetReadAhead();
+}
+
 boost::optional<Record> WiredTigerRecordStoreCursorBase::next() {
     if (_eof)
         return {};
@@ -1907,12 +2302,67 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::next() {
 
     WT_ITEM value;
     invariantWTOK(c->get_value(c, &value));
+    StorageOperationStats::get(_opCtx).incBytesRead(value.size);
 
     _lastReturnedId = id;
+    if (_forward) {
+        _noteSequentialRead(value.size);
+    }
     return {{id, {static_cast<const char*>(value.data), static_cast<int>(value.size)}}};
 }
 
+void WiredTigerRecordStoreCursorBase::_noteSequentialRead(int64_t recordSize) {
+    const int64_t readAheadBytes = wiredTigerCursorReadAheadBytes.load();
+    if (readAheadBytes == 0 || _rs._isOplog || !_rs._kvEngine) {
+        return;
+    }
+
+    auto readAhead = _rs._kvEngine->getReadAhead();
+    if (!readAhead) {
+        return;
+    }
+
+    // Don't bother with read-ahead for short scans, e.g. ones satisfying a small limit, which would
+    // pay for prefetching they never use.
+    const int64_t kMinSequentialRecords = 128;
+
+    ++_sequentialRecords;
+    _readAheadBytesRemaining -= recordSize;
+    if (_sequentialRecords < kMinSequentialRecords ||
+        _readAheadBytesRemaining > readAheadBytes / 2) {
+        return;
+    }
+
+    if (!_readAheadToken) {
+        _readAheadToken = std::make_shared<WiredTigerReadAhead::Token>();
+    }
+
+    WiredTigerReadAhead::Request request;
+    request.uri = _rs.getURI();
+    if (getKeyPrefix().isPrefixed()) {
+        request.prefix = getKeyPrefix().repr();
+    }
+    request.startAfter = _lastReturnedId;
+    request.maxBytes = readAheadBytes;
+    request.token = _readAheadToken;
+
+    // If the request can't be scheduled, try again on the next record.
+    if (readAhead->schedule(std::move(request))) {
+        _readAheadBytesRemaining = readAheadBytes;
+    }
+}
+
+void WiredTigerRecordStoreCursorBase::_resetReadAhead() {
+    if (_readAheadToken) {
+        _readAheadToken->cancelled.store(true);
+        _readAheadToken.reset();
+    }
+    _sequentialRecords = 0;
+    _readAheadBytesRemaining = 0;
+}
+
 boost::optional<Record> WiredTigerRecordStoreCursorBase::seekExact(const RecordId& id) {
+    _resetReadAhead();
     _skipNextAdvance = false;
     WT_CURSOR* c = _cursor->get();
     setKey(c, id);
@@ -1927,12 +2377,93 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::seekExact(const RecordI
 
     WT_ITEM value;
     invariantWTOK(c->get_value(c, &value));
+    StorageOperationStats::get(_opCtx).incBytesRead(value.size);
 
     _lastReturnedId = id;
     _eof = false;
     return {{id, {static_cast<const char*>(value.data), static_cast<int>(value.size)}}};
 }
 
+std::vector<boost::optional<Record>> WiredTigerRecordStoreCursorBase::seekExactBatch(
+    const std::vector<RecordId>& ids) {
+    _resetReadAhead();
+    std::vector<boost::optional<Record>> out(ids.size());
+
+    // Visit the ids in key order so that consecutive lookups touch the same or neighbouring leaf
+    // pages. When the next wanted id immediately follows the current position, a single
+    // 'WT_CURSOR::next' is enough to find it (or to prove that it does not exist), which is much
+    // cheaper than a full search from the root of the tree.
+    std::vector<size_t> order(ids.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+        return ids[lhs] < ids[rhs];
+    });
+
+    _skipNextAdvance = false;
+    WT_CURSOR* c = _cursor->get();
+
+    // The id the cursor is currently positioned on, or null if it is unpositioned.
+    RecordId current;
+
+    auto& stats = StorageOperationStats::get(_opCtx);
+    auto readCurrent = [&](size_t idx) {
+        WT_ITEM value;
+        invariantWTOK(c->get_value(c, &value));
+        stats.incBytesRead(value.size);
+        RecordData data(static_cast<const char*>(value.data), static_cast<int>(value.size));
+        out[idx] = Record{current, data.getOwned()};
+    };
+
+    for (size_t idx : order) {
+        const RecordId& id = ids[idx];
+
+        if (!current.isNull() && current < id) {
+            // Nothing after the next line can throw WCEs.
+            int advanceRet = wiredTigerPrepareConflictRetry(_opCtx, [&] { return c->next(c); });
+            if (advanceRet == WT_NOTFOUND) {
+                // There is nothing after the previous id, so none of the remaining ids exist.
+                current = RecordId();
+                break;
+            }
+            invariantWTOK(advanceRet);
+
+            RecordId nextId;
+            if (hasWrongPrefix(c, &nextId)) {
+                current = RecordId();
+                break;
+            }
+            current = nextId.isValid() ? nextId : getKey(c);
+        }
+
+        if (!current.isNull() && current == id) {
+            readCurrent(idx);
+            continue;
+        }
+
+        if (!current.isNull() && id < current) {
+            // The record directly following the previous id is past this one, so it cannot exist.
+            continue;
+        }
+
+        setKey(c, id);
+        // Nothing after the next line can throw WCEs.
+        int seekRet = wiredTigerPrepareConflictRetry(_opCtx, [&] { return c->search(c); });
+        if (seekRet == WT_NOTFOUND) {
+            // A failed search leaves the cursor unpositioned.
+            current = RecordId();
+            continue;
+        }
+        invariantWTOK(seekRet);
+
+        current = id;
+        readCurrent(idx);
+    }
+
+    _lastReturnedId = current;
+    _eof = current.isNull();
+    return out;
+}
+
 
 void WiredTigerRecordStoreCursorBase::save() {
     try {
@@ -1945,6 +2476,7 @@ void WiredTigerRecordStoreCursorBase::save() {
 }
 
 void WiredTigerRecordStoreCursorBase::saveUnpositioned() {
+    _resetReadAhead();
     save();
     _lastReturnedId = RecordId();
 }
@@ -42,6 +42,7 @@
 #include "mongo/db/storage/record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_cursor.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_read_ahead.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_size_storer.h"
 #include "mongo/platform/atomic_word.h"
@@ -107,6 +108,7 @@ public:
         std::string uri;
         std::string engineName;
         bool isCapped;
+        bool isClustered = false;
         bool isEphemeral;
         int64_t cappedMaxSize;
         int64_t cappedMaxDocs;
@@ -130,6 +132,16 @@ public:
 
     virtual bool isCapped() const;
 
+    bool isClustered() const final {
+        return _isClustered;
+    }
+
+    bool keysCappedInsertsByTimestamp() const final {
+        return _isCapped && !_isOplog;
+    }
+
+    boost::optional<RecordId> getCappedVisibilityBound(OperationContext* opCtx) const final;
+
     virtual int64_t storageSize(OperationContext* opCtx,
                                 BSONObjBuilder* extraInfo = NULL,
                                 int infoLevel = 0) const;
@@ -298,6 +310,10 @@ private:
                           size_t nRecords);
 
     RecordId _nextId();
+
+    // Returns the RecordId for a timestamped insert into a capped collection, see
+    // keysCappedInsertsByTimestamp().
+    RecordId _nextCappedIdForTimestamp(OperationContext* opCtx, WT_CURSOR* cursor, Timestamp ts);
     void _setId(RecordId id);
     bool cappedAndNeedDelete() const;
     RecordData _getData(const WiredTigerCursor& cursor) const;
@@ -348,10 +364,14 @@ private:
     const std::string _engineName;
     // The capped settings should not be updated once operations have started
     const bool _isCapped;
+    // True if the records are keyed by the _id of their documents.
+    const bool _isClustered;
     // True if the storage engine is an in-memory storage engine
     const bool _isEphemeral;
     // True if the namespace of this record store starts with "local.oplog.", and false otherwise.
     const bool _isOplog;
+    // True if WiredTiger journals the writes to this record store.
+    const bool _isLogged;
     int64_t _cappedMaxSize;
     const int64_t _cappedMaxSizeSlack;  // when to start applying backpressure
     const int64_t _cappedMaxDocs;
@@ -427,10 +447,14 @@ public:
                                     const WiredTigerRecordStore& rs,
                                     bool forward);
 
+    ~WiredTigerRecordStoreCursorBase();
+
     boost::optional<Record> next();
 
     boost::optional<Record> seekExact(const RecordId& id);
 
+    std::vector<boost::optional<Record>> seekExactBatch(const std::vector<RecordId>& ids);
+
     void save();
 
     void saveUnpositioned();
@@ -460,6 +484,14 @@ protected:
      */
     virtual void initCursorToBeginning() = 0;
 
+    /**
+     * Returns the prefix of every key this cursor can return, if the table is shared with other
+     * record stores.
+     */
+    virtual KVPrefix getKeyPrefix() const {
+        return KVPrefix::kNotPrefixed;
+    }
+
     const WiredTigerRecordStore& _rs;
     OperationContext* _opCtx;
     const bool _forward;
@@ -470,6 +502,23 @@ protected:
 
 private:
     bool isVisible(const RecordId& id);
+
+    /**
+     * Called by forward scans for every record returned by next(). Once the scan has proven to be
+     * sequential, keeps up to 'wiredTigerCursorReadAheadBytes' of the records following it warm in
+     * the cache by scheduling background read-ahead.
+     */
+    void _noteSequentialRead(int64_t recordSize);
+
+    /**
+     * Stops any read-ahead in flight and forgets the scan history, e.g. after the cursor was
+     * repositioned.
+     */
+    void _resetReadAhead();
+
+    std::shared_ptr<WiredTigerReadAhead::Token> _readAheadToken;
+    int64_t _sequentialRecords = 0;
+    int64_t _readAheadBytesRemaining = 0;  // Estimate of prefetched bytes not yet returned.
 };
 
 class WiredTigerRecordStoreStandardCursor final : public WiredTigerRecordStoreCursorBase {
@@ -518,6 +567,10 @@ protected:
 
     virtual void initCursorToBeginning() override;
 
+    virtual KVPrefix getKeyPrefix() const override {
+        return _prefix;
+    }
+
 private:
     KVPrefix _prefix;
 };
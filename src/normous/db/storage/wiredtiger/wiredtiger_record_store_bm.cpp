@@ -0,0 +1,167 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/catalog/collection_options.h"
+#include "mongo/db/client.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/repl/repl_settings.h"
+#include "mongo/db/repl/replication_coordinator_mock.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/storage/record_store.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
+#include "mongo/platform/random.h"
+#include "mongo/unittest/temp_dir.h"
+#include "mongo/util/clock_source_mock.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * A WiredTiger engine on a temporary dbpath with one empty collection, and an operation context
+ * set up to write to it.
+ */
+class RecordStoreHarness {
+public:
+    RecordStoreHarness()
+        : _dbpath("wiredtiger_record_store_bm"),
+          _engine(kWiredTigerEngineName,
+                  _dbpath.path(),
+                  &_cs,
+                  "",
+                  256,
+                  false,
+                  false,
+                  false,
+                  false),
+          _client(getGlobalServiceContext()->makeClient("wiredtiger_record_store_bm")),
+          _opCtx(_client->makeOperationContext()) {
+        repl::ReplicationCoordinator::set(getGlobalServiceContext(),
+                                          std::make_unique<repl::ReplicationCoordinatorMock>(
+                                              getGlobalServiceContext(), repl::ReplSettings()));
+        _opCtx->setRecoveryUnit(std::unique_ptr<RecoveryUnit>(_engine.newRecoveryUnit()),
+                                WriteUnitOfWork::RecoveryUnitState::kNotInUnitOfWork);
+
+        const CollectionOptions options;
+        uassertStatusOK(_engine.createRecordStore(opCtx(), "bm.coll", "collection-bm", options));
+        _rs = _engine.getRecordStore(opCtx(), "bm.coll", "collection-bm", options);
+    }
+
+    OperationContext* opCtx() {
+        return _opCtx.get();
+    }
+
+    RecordStore* rs() {
+        return _rs.get();
+    }
+
+    /**
+     * Inserts 'numRecords' copies of 'doc' in batches of 'batchSize', one transaction per batch.
+     */
+    void insert(const BSONObj& doc, int numRecords, int batchSize = 1) {
+        for (int inserted = 0; inserted < numRecords;) {
+            WriteUnitOfWork wuow(opCtx());
+            for (int i = 0; i < batchSize && inserted < numRecords; ++i, ++inserted) {
+                uassertStatusOK(
+                    _rs->insertRecord(opCtx(), doc.objdata(), doc.objsize(), Timestamp()));
+            }
+            wuow.commit();
+        }
+    }
+
+private:
+    unittest::TempDir _dbpath;
+    ClockSourceMock _cs;
+    WiredTigerKVEngine _engine;
+    ServiceContext::UniqueClient _client;
+    ServiceContext::UniqueOperationContext _opCtx;
+    std::unique_ptr<RecordStore> _rs;
+};
+
+BSONObj makeDocument(int size) {
+    return BSON("_id" << 1 << "payload" << std::string(size, 'x'));
+}
+
+// One record per transaction, as with unbatched single-document inserts.
+void BM_RecordStoreInsert(benchmark::State& state) {
+    RecordStoreHarness harness;
+    const auto doc = makeDocument(state.range(0));
+    for (auto keepRunning : state) {
+        harness.insert(doc, 1);
+    }
+    state.SetBytesProcessed(state.iterations() * doc.objsize());
+}
+
+// 100 records per transaction, as with a batched insert command.
+void BM_RecordStoreInsertBatch(benchmark::State& state) {
+    RecordStoreHarness harness;
+    const auto doc = makeDocument(state.range(0));
+    for (auto keepRunning : state) {
+        harness.insert(doc, 100, 100);
+    }
+    state.SetItemsProcessed(state.iterations() * 100);
+    state.SetBytesProcessed(state.iterations() * 100 * doc.objsize());
+}
+
+// A forward scan of a collection of 'state.range(0)' records.
+void BM_RecordStoreScan(benchmark::State& state) {
+    RecordStoreHarness harness;
+    harness.insert(makeDocument(200), state.range(0), 1000);
+    for (auto keepRunning : state) {
+        auto cursor = harness.rs()->getCursor(harness.opCtx());
+        while (auto record = cursor->next()) {
+            benchmark::DoNotOptimize(record->data.data());
+        }
+        harness.opCtx()->recoveryUnit()->abandonSnapshot();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Point lookups by RecordId at random positions, as an index fetch does.
+void BM_RecordStoreSeekExact(benchmark::State& state) {
+    const int numRecords = 100000;
+    RecordStoreHarness harness;
+    harness.insert(makeDocument(200), numRecords, 1000);
+    PseudoRandom random(1);
+    auto cursor = harness.rs()->getCursor(harness.opCtx());
+    for (auto keepRunning : state) {
+        benchmark::DoNotOptimize(cursor->seekExact(RecordId(1 + random.nextInt32(numRecords))));
+    }
+}
+
+BENCHMARK(BM_RecordStoreInsert)->Arg(100)->Arg(10 * 1024);
+BENCHMARK(BM_RecordStoreInsertBatch)->Arg(100)->Arg(10 * 1024);
+BENCHMARK(BM_RecordStoreScan)->Arg(100000);
+BENCHMARK(BM_RecordStoreSeekExact);
+
+}  // namespace
+}  // namespace mongo
@@ -67,8 +67,14 @@ public:
         return total_bytes > _rs->cappedMaxSize();
     }
 
+    // Waits until kill() is called, there are too many oplog stones, or the set of oplog stones
+    // changed since it was last persisted.
     void awaitHasExcessStonesOrDead();
 
+    // Writes the current set of oplog stones to the size storer if it changed since the last call,
+    // so that the next startup can reuse them rather than sampling the oplog again.
+    void persistIfNeeded();
+
     boost::optional<OplogStones::Stone> peekOldestStoneIfNeeded() const;
 
     void popOldestStone();
@@ -113,6 +119,11 @@ public:
 
     void setMinBytesPerStone(int64_t size);
 
+    // Returns the size storer key under which the oplog stones for the table 'uri' are persisted.
+    static std::string persistedStonesKey(StringData uri) {
+        return "oplogStones:" + uri.toString();
+    }
+
 private:
     class InsertChange;
     class TruncateChange;
@@ -123,8 +134,15 @@ private:
                                     int64_t estRecordsPerStone,
                                     int64_t estBytesPerStone);
 
+    // Loads the oplog stones persisted by a previous persistIfNeeded() call. Returns false if there
+    // are none, or if they no longer describe the oplog well enough to be reused.
+    bool _loadPersistedStones(OperationContext* opCtx);
+
     void _pokeReclaimThreadIfNeeded();
 
+    // Records that the set of oplog stones changed and wakes the reclaim thread to persist it.
+    void _markNeedsPersist();
+
     static const uint64_t kRandomSamplesPerStone = 10;
 
     WiredTigerRecordStore* _rs;
@@ -143,6 +161,9 @@ private:
     AtomicInt64 _currentRecords;  // Number of records in the stone being filled.
     AtomicInt64 _currentBytes;    // Number of bytes in the stone being filled.
 
+    // True if the deque of oplog stones changed since it was last persisted.
+    AtomicWord<bool> _needsPersist{false};
+
     mutable stdx::mutex _mutex;  // Protects against concurrent access to the deque of oplog stones.
     std::deque<OplogStones::Stone> _stones;  // front = oldest, back = newest.
 };
@@ -75,6 +75,7 @@ WiredTigerRecoveryUnit::WiredTigerRecoveryUnit(WiredTigerSessionCache* sc,
 WiredTigerRecoveryUnit::~WiredTigerRecoveryUnit() {
     invariant(!_inUnitOfWork);
     _abort();
+    _unpinReadTimestamp();
 }
 
 void WiredTigerRecoveryUnit::_commit() {
@@ -270,7 +271,7 @@ void WiredTigerRecoveryUnit::_txnClose(bool commit) {
             // We only need to update oplog visibility where commits can be out-of-order with
             // respect to their assigned optime and such commits might otherwise be visible.
             // This should happen only on primary nodes.
-            _oplogManager->triggerJournalFlush();
+            _oplogManager->triggerOplogVisibilityUpdate();
         }
         _isTimestamped = false;
     }
@@ -404,10 +405,26 @@ void WiredTigerRecoveryUnit::_txnOpen() {
         }
     }
 
+    // These sources reuse _readAtTimestamp when the snapshot is reopened, for example after a
+    // yield, so keep its history from being discarded in between.
+    const bool reusesReadTimestamp = _timestampReadSource == ReadSource::kProvided ||
+        _timestampReadSource == ReadSource::kAllCommittedSnapshot ||
+        _timestampReadSource == ReadSource::kLastAppliedSnapshot;
+    if (reusesReadTimestamp && !_readAtTimestampPin && !_readAtTimestamp.isNull()) {
+        _readAtTimestampPin = _sessionCache->snapshotManager().pinReadTimestamp(_readAtTimestamp);
+    }
+
     LOG(3) << "WT begin_transaction for snapshot id " << _mySnapshotId;
     _active = true;
 }
 
+void WiredTigerRecoveryUnit::_unpinReadTimestamp() {
+    if (_readAtTimestampPin) {
+        _sessionCache->snapshotManager().unpinReadTimestamp(*_readAtTimestampPin);
+        _readAtTimestampPin = boost::none;
+    }
+}
+
 Timestamp WiredTigerRecoveryUnit::_beginTransactionAtAllCommittedTimestamp(WT_SESSION* session) {
     WiredTigerBeginTxnBlock txnOpen(session, _ignorePrepared);
     Timestamp txnTimestamp = Timestamp(_oplogManager->fetchAllCommittedValue(session->connection));
@@ -533,6 +550,7 @@ void WiredTigerRecoveryUnit::setTimestampReadSource(ReadSource readSource,
     invariant(!provided == (readSource != ReadSource::kProvided));
     invariant(!(provided && provided->isNull()));
 
+    _unpinReadTimestamp();
     _timestampReadSource = readSource;
     _readAtTimestamp = (provided) ? *provided : Timestamp();
 }
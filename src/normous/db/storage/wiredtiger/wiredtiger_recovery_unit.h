@@ -139,7 +139,7 @@ public:
     WiredTigerSessionCache* getSessionCache() {
         return _sessionCache;
     }
-    bool inActiveTxn() const {
+    bool inActiveTxn() const override {
         return _active;
     }
     void assertInActiveTxn() const;
@@ -164,6 +164,11 @@ private:
      */
     Timestamp _beginTransactionAtAllCommittedTimestamp(WT_SESSION* session);
 
+    /**
+     * Releases the pin on _readAtTimestamp taken by _txnOpen, if any.
+     */
+    void _unpinReadTimestamp();
+
     WiredTigerSessionCache* _sessionCache;  // not owned
     WiredTigerOplogManager* _oplogManager;  // not owned
     UniqueWiredTigerSession _session;
@@ -192,6 +197,9 @@ private:
     uint64_t _mySnapshotId;
     Timestamp _majorityCommittedSnapshot;
     Timestamp _readAtTimestamp;
+    // Handle from WiredTigerSnapshotManager::pinReadTimestamp while _readAtTimestamp is reused
+    // across transactions, so that history is retained for it between snapshots.
+    boost::optional<int> _readAtTimestampPin;
     std::unique_ptr<Timer> _timer;
     bool _isOplogReader = false;
     typedef std::vector<std::unique_ptr<Change>> Changes;
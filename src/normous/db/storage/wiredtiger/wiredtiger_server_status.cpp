@@ -78,6 +78,14 @@ BSONObj WiredTigerServerStatusSection::generateSection(OperationContext* opCtx,
 
     WiredTigerKVEngine::appendGlobalStats(bob);
 
+    WiredTigerRecoveryUnit::get(opCtx)->getSessionCache()->appendStats(&bob);
+
+    _engine->getOplogManager()->appendStats(&bob);
+
+    if (auto readAhead = _engine->getReadAhead()) {
+        readAhead->appendStats(&bob);
+    }
+
     WiredTigerUtil::appendSnapshotWindowSettings(_engine, session, &bob);
 
     return bob.obj();
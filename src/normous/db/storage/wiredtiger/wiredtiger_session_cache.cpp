@@ -36,6 +36,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 
 #include "mongo/base/error_codes.h"
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/global_settings.h"
 #include "mongo/db/repl/repl_settings.h"
@@ -46,7 +47,10 @@
 #include "mongo/stdx/memory.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
+#include "mongo/util/processinfo.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
@@ -86,6 +90,19 @@ ExportedServerParameter<std::int32_t, ServerParameterType::kStartupAndRuntime>
                                      "wiredTigerCursorCacheSize",
                                      &kWiredTigerCursorCacheSize);
 
+// How long, in microseconds, the thread that is about to flush the journal in waitUntilDurable()
+// waits for more durable-commit waiters to queue up behind it, so that a single log flush covers
+// all of them. Zero flushes immediately, which still coalesces waiters that arrive while a flush
+// is in progress.
+MONGO_EXPORT_SERVER_PARAMETER(wiredTigerGroupCommitWindowMicros, int, 0)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0 || newVal > 100 * 1000) {
+            return Status(ErrorCodes::BadValue,
+                          "wiredTigerGroupCommitWindowMicros must be between 0 and 100000");
+        }
+        return Status::OK();
+    });
+
 WiredTigerSession::WiredTigerSession(WT_CONNECTION* conn, uint64_t epoch, uint64_t cursorEpoch)
     : _epoch(epoch), _cursorEpoch(cursorEpoch), _session(NULL), _cursorGen(0), _cursorsOut(0) {
     invariantWTOK(conn->open_session(conn, NULL, "isolation=snapshot", &_session));
@@ -225,10 +242,27 @@ uint64_t WiredTigerSession::genTableId() {
 // -----------------------
 
 WiredTigerSessionCache::WiredTigerSessionCache(WiredTigerKVEngine* engine)
-    : _engine(engine), _conn(engine->getConnection()), _shuttingDown(0) {}
+    : _engine(engine),
+      _conn(engine->getConnection()),
+      _shuttingDown(0),
+      _shards(_numShardsToCreate()) {}
 
 WiredTigerSessionCache::WiredTigerSessionCache(WT_CONNECTION* conn)
-    : _engine(NULL), _conn(conn), _shuttingDown(0) {}
+    : _engine(NULL), _conn(conn), _shuttingDown(0), _shards(_numShardsToCreate()) {}
+
+size_t WiredTigerSessionCache::_numShardsToCreate() {
+    // One shard per core is plenty to make contention on any one shard rare, while keeping the
+    // cost of the operations which visit every shard (closeAll, stealing) bounded.
+    const size_t kMaxShards = 64;
+    return std::max(size_t(1), std::min(kMaxShards, size_t(ProcessInfo::getNumAvailableCores())));
+}
+
+size_t WiredTigerSessionCache::_homeShard() const {
+    // Threads are spread over the shards round-robin, in the order they first use the cache.
+    static AtomicUInt32 nextHomeShard;
+    thread_local const uint32_t homeShard = nextHomeShard.fetchAndAdd(1);
+    return homeShard % _shards.size();
+}
 
 WiredTigerSessionCache::~WiredTigerSessionCache() {
     shuttingDown();
@@ -293,6 +327,8 @@ void WiredTigerSessionCache::waitUntilDurable(bool forceCheckpoint, bool stableC
         return;
     }
 
+    // Every waiter that registers before the next flush starts is made durable by that flush.
+    _groupCommitWaiters.fetchAndAdd(1);
     uint32_t start = _lastSyncTime.load();
     // Do the remainder in a critical section that ensures only a single thread at a time
     // will attempt to synchronize.
@@ -302,7 +338,16 @@ void WiredTigerSessionCache::waitUntilDurable(bool forceCheckpoint, bool stableC
         // Someone else synced already since we read lastSyncTime, so we're done!
         return;
     }
+
+    // This thread leads the next flush. Give concurrent committers the group commit window to
+    // queue up on _lastSyncMutex; they read _lastSyncTime before it is bumped below, so they will
+    // find their commits covered by this flush once they get the mutex.
+    const int windowMicros = wiredTigerGroupCommitWindowMicros.load();
+    if (windowMicros > 0) {
+        sleepmicros(windowMicros);
+    }
     _lastSyncTime.store(current + 1);
+    _recordGroupCommit(_groupCommitWaiters.swap(0));
 
     // Nobody has synched yet, so we have to sync ourselves.
 
@@ -348,9 +393,11 @@ void WiredTigerSessionCache::notifyPreparedUnitOfWorkHasCommittedOrAborted() {
 
 
 void WiredTigerSessionCache::closeAllCursors(const std::string& uri) {
-    stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeAllCursors(uri);
+    for (auto&& shard : _shards) {
+        scoped_spinlock lock(shard.lock);
+        for (SessionCache::iterator i = shard.sessions.begin(); i != shard.sessions.end(); i++) {
+            (*i)->closeAllCursors(uri);
+        }
     }
 }
 
@@ -358,20 +405,26 @@ void WiredTigerSessionCache::closeCursorsForQueuedDrops() {
     // Increment the cursor epoch so that all cursors from this epoch are closed.
     _cursorEpoch.fetchAndAdd(1);
 
-    stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeCursorsForQueuedDrops(_engine);
+    for (auto&& shard : _shards) {
+        scoped_spinlock lock(shard.lock);
+        for (SessionCache::iterator i = shard.sessions.begin(); i != shard.sessions.end(); i++) {
+            (*i)->closeCursorsForQueuedDrops(_engine);
+        }
     }
 }
 
 void WiredTigerSessionCache::closeAll() {
-    // Increment the epoch as we are now closing all sessions with this epoch.
-    SessionCache swap;
+    // Increment the epoch as we are now closing all sessions with this epoch. This happens before
+    // any shard is emptied, so a session released concurrently either sees the new epoch when it
+    // rechecks it under its shard's lock, or lands in the shard before we empty it.
+    _epoch.fetchAndAdd(1);
 
-    {
-        stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-        _epoch.fetchAndAdd(1);
-        _sessions.swap(swap);
+    SessionCache swap;
+    for (auto&& shard : _shards) {
+        scoped_spinlock lock(shard.lock);
+        swap.insert(swap.end(), shard.sessions.begin(), shard.sessions.end());
+        shard.sessions.clear();
+        shard.numSessions.store(0);
     }
 
     for (SessionCache::iterator i = swap.begin(); i != swap.end(); i++) {
@@ -388,18 +441,31 @@ UniqueWiredTigerSession WiredTigerSessionCache::getSession() {
     // operations should be allowed to start.
     invariant(!(_shuttingDown.loadRelaxed() & kShuttingDownMask));
 
-    {
-        stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-        if (!_sessions.empty()) {
+    // Start with our home shard and fall back to stealing from the others, so that a thread only
+    // opens a new session when there are no idle sessions anywhere in the cache.
+    const size_t homeShard = _homeShard();
+    for (size_t i = 0; i < _shards.size(); ++i) {
+        auto& shard = _shards[(homeShard + i) % _shards.size()];
+        if (shard.numSessions.loadRelaxed() == 0) {
+            continue;
+        }
+
+        scoped_spinlock lock(shard.lock);
+        if (!shard.sessions.empty()) {
             // Get the most recently used session so that if we discard sessions, we're
             // discarding older ones
-            WiredTigerSession* cachedSession = _sessions.back();
-            _sessions.pop_back();
+            WiredTigerSession* cachedSession = shard.sessions.back();
+            shard.sessions.pop_back();
+            shard.numSessions.subtractAndFetch(1);
+            if (i != 0) {
+                _sessionsStolen.fetchAndAdd(1);
+            }
             return UniqueWiredTigerSession(cachedSession);
         }
     }
 
     // Outside of the cache partition lock, but on release will be put back on the cache
+    _sessionsCreated.fetchAndAdd(1);
     return UniqueWiredTigerSession(
         new WiredTigerSession(_conn, this, _epoch.load(), _cursorEpoch.load()));
 }
@@ -453,10 +519,12 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
     session->dropQueuedIdentsAtSessionEndAllowed(true);
 
     if (session->_getEpoch() == currentEpoch) {  // check outside of lock to reduce contention
-        stdx::lock_guard<stdx::mutex> lock(_cacheLock);
+        auto& shard = _shards[_homeShard()];
+        scoped_spinlock lock(shard.lock);
         if (session->_getEpoch() == _epoch.load()) {  // recheck inside the lock for correctness
             returnedToCache = true;
-            _sessions.push_back(session);
+            shard.sessions.push_back(session);
+            shard.numSessions.addAndFetch(1);
         }
     } else
         invariant(session->_getEpoch() < currentEpoch);
@@ -469,6 +537,48 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
 }
 
 
+void WiredTigerSessionCache::appendStats(BSONObjBuilder* builder) const {
+    long long cachedSessions = 0;
+    for (auto&& shard : _shards) {
+        cachedSessions += shard.numSessions.loadRelaxed();
+    }
+
+    BSONObjBuilder bob(builder->subobjStart("session cache"));
+    bob.append("shards", static_cast<long long>(_shards.size()));
+    bob.append("cached sessions", cachedSessions);
+    bob.append("sessions created", static_cast<long long>(_sessionsCreated.load()));
+    bob.append("sessions stolen from other shards", static_cast<long long>(_sessionsStolen.load()));
+
+    {
+        BSONObjBuilder groupCommit(bob.subobjStart("group commit"));
+        groupCommit.append("window micros", wiredTigerGroupCommitWindowMicros.load());
+        groupCommit.append("flushes", static_cast<long long>(_groupCommitFlushes.load()));
+        groupCommit.append("waiters", static_cast<long long>(_groupCommitWaitersTotal.load()));
+
+        // Bucket i counts flushes that covered [2^i, 2^(i+1)) waiters; the last bucket is open.
+        BSONObjBuilder histogram(groupCommit.subobjStart("batch size histogram"));
+        for (size_t i = 0; i < kGroupCommitHistogramBuckets; ++i) {
+            const std::string label = (i + 1 == kGroupCommitHistogramBuckets)
+                ? str::stream() << (1 << i) << "+"
+                : str::stream() << (1 << i) << "-" << ((1 << (i + 1)) - 1);
+            histogram.append(label, static_cast<long long>(_groupCommitBatchSizes[i].load()));
+        }
+    }
+    bob.done();
+}
+
+void WiredTigerSessionCache::_recordGroupCommit(uint64_t waiters) {
+    // The leader registered itself, but a preceding leader may have counted it already.
+    waiters = std::max<uint64_t>(waiters, 1);
+    size_t bucket = 0;
+    while (bucket + 1 < kGroupCommitHistogramBuckets && (waiters >> (bucket + 1)) != 0) {
+        ++bucket;
+    }
+    _groupCommitFlushes.fetchAndAdd(1);
+    _groupCommitWaitersTotal.fetchAndAdd(waiters);
+    _groupCommitBatchSizes[bucket].fetchAndAdd(1);
+}
+
 void WiredTigerSessionCache::setJournalListener(JournalListener* jl) {
     stdx::unique_lock<stdx::mutex> lk(_journalListenerMutex);
     _journalListener = jl;
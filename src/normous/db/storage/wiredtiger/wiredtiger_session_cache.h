@@ -31,8 +31,11 @@
 
 #pragma once
 
+#include <array>
+#include <boost/align/aligned_allocator.hpp>
 #include <list>
 #include <string>
+#include <vector>
 
 #include <wiredtiger.h>
 
@@ -41,9 +44,11 @@
 #include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/mutex.h"
 #include "mongo/util/concurrency/spin_lock.h"
+#include "mongo/util/with_alignment.h"
 
 namespace mongo {
 
+class BSONObjBuilder;
 class WiredTigerKVEngine;
 class WiredTigerSessionCache;
 
@@ -243,6 +248,11 @@ public:
      */
     void waitUntilDurable(bool forceCheckpoint, bool stableCheckpoint);
 
+    /**
+     * Number of buckets in the group commit batch size histogram reported by appendStats().
+     */
+    static constexpr size_t kGroupCommitHistogramBuckets = 8;
+
     /**
      * Waits until a prepared unit of work has ended (either been commited or aborted). This
      * should be used when encountering WT_PREPARE_CONFLICT errors. The caller is required to retry
@@ -284,7 +294,47 @@ public:
         return _engine;
     }
 
+    /**
+     * Appends statistics about the cached sessions and journal group commits, for reporting in
+     * serverStatus.
+     */
+    void appendStats(BSONObjBuilder* builder) const;
+
 private:
+    /**
+     * Released sessions are spread over a number of shards, each with its own lock, so that
+     * concurrent operations do not all serialize on a single mutex. Every thread is assigned a
+     * "home" shard on first use; it releases sessions into that shard and takes them from it first,
+     * only stealing from the other shards when its own is empty.
+     */
+    struct SessionShard {
+        SpinLock lock;
+        std::vector<WiredTigerSession*> sessions;
+
+        // Mirrors sessions.size() so that empty shards can be skipped without taking their lock.
+        AtomicUInt32 numSessions;
+    };
+
+    using CacheAlignedSessionShard = CacheAligned<SessionShard>;
+    using SessionShards =
+        std::vector<CacheAlignedSessionShard,
+                    boost::alignment::aligned_allocator<CacheAlignedSessionShard>>;
+
+    /**
+     * Returns the index of the calling thread's home shard.
+     */
+    size_t _homeShard() const;
+
+    /**
+     * Picks the number of shards to create, based on the number of available cores.
+     */
+    static size_t _numShardsToCreate();
+
+    /**
+     * Accounts for a log flush in waitUntilDurable() that covered 'waiters' callers.
+     */
+    void _recordGroupCommit(uint64_t waiters);
+
     WiredTigerKVEngine* _engine;  // not owned, might be NULL
     WT_CONNECTION* _conn;         // not owned
     WiredTigerSnapshotManager _snapshotManager;
@@ -295,9 +345,12 @@ private:
     AtomicUInt32 _shuttingDown;
     static const uint32_t kShuttingDownMask = 1 << 31;
 
-    stdx::mutex _cacheLock;
     typedef std::vector<WiredTigerSession*> SessionCache;
-    SessionCache _sessions;
+    SessionShards _shards;
+
+    // Counters reported by appendStats().
+    AtomicUInt64 _sessionsCreated;
+    AtomicUInt64 _sessionsStolen;
 
     // Bumped when all open sessions need to be closed
     AtomicUInt64 _epoch;  // atomic so we can check it outside of the lock
@@ -309,6 +362,13 @@ private:
     AtomicUInt32 _lastSyncTime;
     stdx::mutex _lastSyncMutex;
 
+    // Group commit accounting for waitUntilDurable. _groupCommitWaiters counts the callers that
+    // registered since the last log flush started; the others are reported by appendStats().
+    AtomicUInt64 _groupCommitWaiters;
+    AtomicUInt64 _groupCommitFlushes;
+    AtomicUInt64 _groupCommitWaitersTotal;
+    std::array<AtomicUInt64, kGroupCommitHistogramBuckets> _groupCommitBatchSizes;
+
     // Mutex and cond var for waiting on prepare commit or abort.
     stdx::mutex _prepareCommittedOrAbortedMutex;
     stdx::condition_variable _prepareCommittedOrAbortedCond;
@@ -33,6 +33,8 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+#include <vector>
 #include <wiredtiger.h>
 
 #include "mongo/bson/bsonobj.h"
@@ -46,9 +48,13 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/util/log.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
+constexpr size_t WiredTigerSizeStorer::kNumBufferShards;
+constexpr size_t WiredTigerSizeStorer::kFlushBatchSize;
+
 WiredTigerSizeStorer::WiredTigerSizeStorer(WT_CONNECTION* conn,
                                            const std::string& storageUri,
                                            bool readOnly)
@@ -76,8 +82,9 @@ void WiredTigerSizeStorer::store(StringData uri, std::shared_ptr<SizeInfo> sizeI
         return;
 
     // Ordering is important: as the entry may be flushed concurrently, set the dirty flag last.
-    stdx::lock_guard<stdx::mutex> lk(_bufferMutex);
-    auto& entry = _buffer[uri];
+    BufferShard& shard = _shardFor(uri);
+    stdx::lock_guard<stdx::mutex> lk(shard.mutex);
+    auto& entry = shard.buffer[uri];
     // During rollback it is possible to get a new SizeInfo. In that case clear the dirty flag,
     // so the SizeInfo can be destructed without triggering the dirty check invariant.
     if (entry && entry.get() != sizeInfo.get())
@@ -92,9 +99,10 @@ void WiredTigerSizeStorer::store(StringData uri, std::shared_ptr<SizeInfo> sizeI
 std::shared_ptr<WiredTigerSizeStorer::SizeInfo> WiredTigerSizeStorer::load(StringData uri) const {
     {
         // Check if we can satisfy the read from the buffer.
-        stdx::lock_guard<stdx::mutex> bufferLock(_bufferMutex);
-        Buffer::const_iterator it = _buffer.find(uri);
-        if (it != _buffer.end())
+        BufferShard& shard = _shardFor(uri);
+        stdx::lock_guard<stdx::mutex> bufferLock(shard.mutex);
+        Buffer::const_iterator it = shard.buffer.find(uri);
+        if (it != shard.buffer.end())
             return it->second;
     }
 
@@ -125,42 +133,57 @@ std::shared_ptr<WiredTigerSizeStorer::SizeInfo> WiredTigerSizeStorer::load(Strin
 }
 
 void WiredTigerSizeStorer::flush(bool syncToDisk) {
-    Buffer buffer;
-    {
-        stdx::lock_guard<stdx::mutex> bufferLock(_bufferMutex);
-        _buffer.swap(buffer);
+    std::vector<std::pair<std::string, std::shared_ptr<SizeInfo>>> entries;
+    for (auto& shard : _shards) {
+        Buffer buffer;
+        {
+            stdx::lock_guard<stdx::mutex> bufferLock(shard.mutex);
+            shard.buffer.swap(buffer);
+        }
+        for (auto& it : buffer)
+            entries.emplace_back(it.first, std::move(it.second));
     }
 
-    if (buffer.empty())
+    if (entries.empty())
         return;  // Nothing to do.
 
     Timer t;
-    stdx::lock_guard<stdx::mutex> cursorLock(_cursorMutex);
-    {
-        // On failure, place entries back into the map, unless a newer value already exists.
-        ON_BLOCK_EXIT([this, &buffer]() {
-            this->_cursor->reset(this->_cursor);
-            if (!buffer.empty()) {
-                stdx::lock_guard<stdx::mutex> bufferLock(this->_bufferMutex);
-                for (auto& it : buffer)
-                    this->_buffer.try_emplace(it.first, it.second);
-            }
-        });
+    size_t flushed = 0;
+
+    // On failure, place unwritten entries back into the buffer, unless a newer value already
+    // exists.
+    ON_BLOCK_EXIT([this, &entries, &flushed]() {
+        for (size_t i = flushed; i < entries.size(); ++i) {
+            BufferShard& shard = this->_shardFor(entries[i].first);
+            stdx::lock_guard<stdx::mutex> bufferLock(shard.mutex);
+            shard.buffer.try_emplace(entries[i].first, entries[i].second);
+        }
+    });
 
-        WT_SESSION* session = _session.getSession();
-        WiredTigerBeginTxnBlock txnOpen(session, syncToDisk ? "sync=true" : nullptr);
+    // Each batch is its own transaction and releases _cursorMutex when done, so that load() calls
+    // for entries that are not buffered can interleave with a large flush.
+    while (flushed < entries.size()) {
+        const size_t batchEnd = std::min(entries.size(), flushed + kFlushBatchSize);
+
+        // Commits are logged in order, so syncing the last batch makes all earlier ones durable.
+        const bool sync = syncToDisk && batchEnd == entries.size();
 
-        for (auto it = buffer.begin(); it != buffer.end(); ++it) {
+        stdx::lock_guard<stdx::mutex> cursorLock(_cursorMutex);
+        ON_BLOCK_EXIT([this]() { this->_cursor->reset(this->_cursor); });
 
+        WT_SESSION* session = _session.getSession();
+        WiredTigerBeginTxnBlock txnOpen(session, sync ? "sync=true" : nullptr);
+
+        for (size_t i = flushed; i < batchEnd; ++i) {
             // Ordering is important here: when the store method checks if the SizeInfo
             // is dirty and it returns true, the current values of numRecords and dataSize must
             // still be written back. So, the required order is to clear the dirty flag first.
-            SizeInfo& sizeInfo = *it->second;
+            SizeInfo& sizeInfo = *entries[i].second;
             sizeInfo._dirty.store(false);
             BSONObj data = BSON("numRecords" << sizeInfo.numRecords.load() << "dataSize"
                                              << sizeInfo.dataSize.load());
 
-            auto& uri = it->first;
+            auto& uri = entries[i].first;
             LOG(2) << "WiredTigerSizeStorer::flush " << uri << " -> " << redact(data);
             WiredTigerItem key(uri.c_str(), uri.size());
             WiredTigerItem value(data.objdata(), data.objsize());
@@ -170,10 +193,58 @@ void WiredTigerSizeStorer::flush(bool syncToDisk) {
         }
         txnOpen.done();
         invariantWTOK(session->commit_transaction(session, nullptr));
-        buffer.clear();
+        flushed = batchEnd;
     }
 
     auto micros = t.micros();
-    LOG(2) << "WiredTigerSizeStorer flush took " << micros << " µs";
+    LOG(2) << "WiredTigerSizeStorer flush of " << entries.size() << " entries took " << micros
+           << " µs";
+}
+
+void WiredTigerSizeStorer::storeMetadata(StringData key, const BSONObj& metadata) {
+    if (_readOnly)
+        return;
+
+    stdx::lock_guard<stdx::mutex> cursorLock(_cursorMutex);
+    ON_BLOCK_EXIT([this]() { this->_cursor->reset(this->_cursor); });
+
+    WT_SESSION* session = _session.getSession();
+    WiredTigerBeginTxnBlock txnOpen(session, nullptr);
+
+    LOG(2) << "WiredTigerSizeStorer::storeMetadata " << key << " -> " << redact(metadata);
+    WiredTigerItem wtKey(key.rawData(), key.size());
+    WiredTigerItem value(metadata.objdata(), metadata.objsize());
+    _cursor->set_key(_cursor, wtKey.Get());
+    _cursor->set_value(_cursor, value.Get());
+    invariantWTOK(_cursor->insert(_cursor));
+
+    txnOpen.done();
+    invariantWTOK(session->commit_transaction(session, nullptr));
+}
+
+BSONObj WiredTigerSizeStorer::loadMetadata(StringData key) const {
+    stdx::lock_guard<stdx::mutex> cursorLock(_cursorMutex);
+    // Intentionally ignoring return value.
+    ON_BLOCK_EXIT(_cursor->reset, _cursor);
+
+    _cursor->reset(_cursor);
+
+    WT_ITEM wtKey = {key.rawData(), key.size()};
+    _cursor->set_key(_cursor, &wtKey);
+    int ret = _cursor->search(_cursor);
+    if (ret == WT_NOTFOUND)
+        return BSONObj();
+    invariantWTOK(ret);
+
+    WT_ITEM value;
+    invariantWTOK(_cursor->get_value(_cursor, &value));
+    return BSONObj(reinterpret_cast<const char*>(value.data)).getOwned();
+}
+
+WiredTigerSizeStorer::BufferShard& WiredTigerSizeStorer::_shardFor(StringData uri) const {
+    // The buffers hash on the low bits of the same hash, so pick the shard from the high bits to
+    // keep each shard's keys spread over all of its buckets.
+    const uint32_t hash = StringMapTraits::hash(uri);
+    return _shards[(hash >> 16) % kNumBufferShards];
 }
 }  // namespace mongo
@@ -31,6 +31,7 @@
 
 #pragma once
 
+#include <array>
 #include <string>
 
 #include <wiredtiger.h>
@@ -53,6 +54,12 @@ namespace mongo {
  * in size updates to be lost, so size information is only approximate. Reads use the buffer for
  * pending stores, or otherwise read directly from the WiredTiger table using a dedicated session
  * and cursor.
+ *
+ * The buffer only ever holds dirty entries, so a flush costs time proportional to the number of
+ * collections whose sizes changed since the last flush, not the total number of collections. It
+ * is split into independently locked shards by URI so that collections being dirtied
+ * concurrently rarely contend, and flushes write in bounded batches so that loads that miss the
+ * buffer do not wait for a whole flush to finish.
  */
 class WiredTigerSizeStorer {
 public:
@@ -93,16 +100,37 @@ public:
      */
     void flush(bool syncToDisk);
 
+    /**
+     * Writes, or reads back, a small BSON document kept in the same table under 'key', which must
+     * not collide with any URI. Unlike sizes, these are written through immediately rather than
+     * buffered, so they suit metadata that changes rarely and from a single thread. Returns an
+     * empty document if nothing is stored under 'key'.
+     */
+    void storeMetadata(StringData key, const BSONObj& metadata);
+    BSONObj loadMetadata(StringData key) const;
+
 private:
     const WiredTigerSession _session;
     const bool _readOnly;
-    // Guards _cursor. Acquire *before* _bufferMutex.
+    // Guards _cursor. Acquire *before* any of the _shards mutexes.
     mutable stdx::mutex _cursorMutex;
     WT_CURSOR* _cursor;  // pointer is const after constructor
 
     using Buffer = StringMap<std::shared_ptr<SizeInfo>>;
 
-    mutable stdx::mutex _bufferMutex;  // Guards _buffer
-    Buffer _buffer;
+    struct BufferShard {
+        stdx::mutex mutex;  // Guards buffer
+        Buffer buffer;
+    };
+
+    static constexpr size_t kNumBufferShards = 16;
+
+    // Maximum number of entries written by flush() in a single transaction.
+    static constexpr size_t kFlushBatchSize = 1000;
+
+    BufferShard& _shardFor(StringData uri) const;
+
+    // Acquire a shard's mutex *after* _cursorMutex, and never hold two shard mutexes at once.
+    mutable std::array<BufferShard, kNumBufferShards> _shards;
 };
 }
@@ -102,4 +102,43 @@ Timestamp WiredTigerSnapshotManager::beginTransactionOnLocalSnapshot(
     return *_localSnapshot;
 }
 
+int WiredTigerSnapshotManager::pinReadTimestamp(const Timestamp& readTimestamp) {
+    invariant(!readTimestamp.isNull());
+    const auto start = _nextReadTimestampPinSlot.fetchAndAdd(1);
+    for (int i = 0; i < kReadTimestampPinSlots; ++i) {
+        const int slot = (start + i) % kReadTimestampPinSlots;
+        if (_readTimestampPins[slot].compareAndSwap(0, readTimestamp.asULL()) == 0) {
+            return slot;
+        }
+    }
+
+    _untrackedReadTimestampPins.fetchAndAdd(1);
+    return kUntrackedReadTimestampPin;
+}
+
+void WiredTigerSnapshotManager::unpinReadTimestamp(int handle) {
+    if (handle == kUntrackedReadTimestampPin) {
+        invariant(_untrackedReadTimestampPins.subtractAndFetch(1) >= 0);
+        return;
+    }
+
+    invariant(handle >= 0 && handle < kReadTimestampPinSlots);
+    invariant(_readTimestampPins[handle].swap(0) != 0);
+}
+
+boost::optional<Timestamp> WiredTigerSnapshotManager::getOldestPinnedReadTimestamp() const {
+    boost::optional<Timestamp> oldest;
+    for (const auto& pin : _readTimestampPins) {
+        const auto value = pin.load();
+        if (value != 0 && (!oldest || Timestamp(value) < *oldest)) {
+            oldest = Timestamp(value);
+        }
+    }
+    return oldest;
+}
+
+bool WiredTigerSnapshotManager::allReadTimestampsPinned() const {
+    return _untrackedReadTimestampPins.load() == 0;
+}
+
 }  // namespace mongo
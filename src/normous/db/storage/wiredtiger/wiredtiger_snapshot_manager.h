@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <array>
 #include <boost/optional.hpp>
 #include <wiredtiger.h>
 
@@ -36,6 +37,7 @@
 #include "mongo/bson/timestamp.h"
 #include "mongo/db/storage/snapshot_manager.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_begin_transaction_block.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/mutex.h"
 
 namespace mongo {
@@ -83,6 +85,25 @@ public:
      */
     boost::optional<Timestamp> getMinSnapshotForNextCommittedRead() const;
 
+    /**
+     * Records that a reader may reopen its snapshot at 'readTimestamp' until the returned handle
+     * is passed to unpinReadTimestamp, so that the oldest timestamp can be held back for it. This
+     * is lock-free. If every pin slot is taken the reader is only counted, and
+     * allReadTimestampsPinned() returns false until it is unpinned.
+     */
+    int pinReadTimestamp(const Timestamp& readTimestamp);
+    void unpinReadTimestamp(int handle);
+
+    /**
+     * Returns the oldest timestamp currently pinned by a reader, or boost::none if there is none.
+     * Only meaningful while allReadTimestampsPinned() is true.
+     */
+    boost::optional<Timestamp> getOldestPinnedReadTimestamp() const;
+    bool allReadTimestampsPinned() const;
+
+    static constexpr int kReadTimestampPinSlots = 1024;
+    static constexpr int kUntrackedReadTimestampPin = -1;
+
 private:
     // Snapshot to use for reads at a commit timestamp.
     mutable stdx::mutex _committedSnapshotMutex;  // Guards _committedSnapshot.
@@ -91,5 +112,13 @@ private:
     // Snapshot to use for reads at a local stable timestamp.
     mutable stdx::mutex _localSnapshotMutex;  // Guards _localSnapshot.
     boost::optional<Timestamp> _localSnapshot;
+
+    // Read timestamps pinned by active readers. A slot holds 0 when free and is claimed with a
+    // compare-and-swap, starting from a rotating position to spread contention.
+    std::array<AtomicUInt64, kReadTimestampPinSlots> _readTimestampPins;
+    AtomicUInt32 _nextReadTimestampPinSlot;
+
+    // Number of readers that found every slot taken and so are not reflected in the pins above.
+    AtomicInt64 _untrackedReadTimestampPins;
 };
 }
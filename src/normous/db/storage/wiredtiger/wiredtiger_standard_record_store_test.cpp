@@ -38,6 +38,7 @@
 #include "mongo/base/string_data.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/global_settings.h"
 #include "mongo/db/json.h"
 #include "mongo/db/operation_context_noop.h"
 #include "mongo/db/repl/repl_settings.h"
@@ -47,6 +48,7 @@
 #include "mongo/db/storage/kv/kv_prefix.h"
 #include "mongo/db/storage/record_store_test_harness.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_read_ahead.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store_oplog_stones.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
@@ -54,10 +56,12 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_size_storer.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/mongoutils/str.h"
 #include "mongo/util/scopeguard.h"
 
 namespace mongo {
@@ -94,6 +98,14 @@ public:
     }
 
     virtual std::unique_ptr<RecordStore> newNonCappedRecordStore(const std::string& ns) {
+        return _newNonCappedRecordStore(ns, false);
+    }
+
+    std::unique_ptr<RecordStore> newClusteredRecordStore(const std::string& ns) {
+        return _newNonCappedRecordStore(ns, true);
+    }
+
+    std::unique_ptr<RecordStore> _newNonCappedRecordStore(const std::string& ns, bool clustered) {
         WiredTigerRecoveryUnit* ru =
             dynamic_cast<WiredTigerRecoveryUnit*>(_engine.newRecoveryUnit());
         OperationContextNoop opCtx(ru);
@@ -117,6 +129,7 @@ public:
         params.uri = uri;
         params.engineName = kWiredTigerEngineName;
         params.isCapped = false;
+        params.isClustered = clustered;
         params.isEphemeral = false;
         params.cappedMaxSize = -1;
         params.cappedMaxDocs = -1;
@@ -185,6 +198,10 @@ public:
         return _engine.getConnection();
     }
 
+    WiredTigerKVEngine* engine() {
+        return &_engine;
+    }
+
 private:
     unittest::TempDir _dbpath;
     ClockSourceMock _cs;
@@ -209,6 +226,47 @@ TEST(WiredTigerRecordStoreTest, StorageSizeStatisticsDisabled) {
     ASSERT_THROWS(rs->storageSize(opCtx.get()), AssertionException);
 }
 
+TEST(WiredTigerRecordStoreTest, ClusteredRecordsAreKeyedById) {
+    WiredTigerHarnessHelper harnessHelper;
+    unique_ptr<RecordStore> rs(harnessHelper.newClusteredRecordStore("a.b"));
+    ASSERT(rs->isClustered());
+
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper.newOperationContext());
+    {
+        WriteUnitOfWork uow(opCtx.get());
+        for (auto&& id : {20, 5, 10}) {
+            const BSONObj doc = BSON("_id" << id);
+            auto res = rs->insertRecord(opCtx.get(), doc.objdata(), doc.objsize(), Timestamp());
+            ASSERT_OK(res.getStatus());
+            ASSERT_EQ(RecordId(id), res.getValue());
+        }
+        uow.commit();
+    }
+
+    {
+        WriteUnitOfWork uow(opCtx.get());
+        const BSONObj duplicate = BSON("_id" << 10.0);
+        ASSERT_EQ(ErrorCodes::DuplicateKey,
+                  rs->insertRecord(opCtx.get(), duplicate.objdata(), duplicate.objsize(), {})
+                      .getStatus());
+        const BSONObj badId = BSON("_id" << OID::gen());
+        ASSERT_EQ(ErrorCodes::BadValue,
+                  rs->insertRecord(opCtx.get(), badId.objdata(), badId.objsize(), {}).getStatus());
+    }
+
+    ASSERT_EQ(3, rs->numRecords(opCtx.get()));
+    ASSERT_EQ(RecordId(10), *rs->oplogStartHack(opCtx.get(), RecordId(15)));
+    ASSERT_EQ(RecordId(), *rs->oplogStartHack(opCtx.get(), RecordId(4)));
+
+    auto cursor = rs->getCursor(opCtx.get());
+    for (auto&& id : {5, 10, 20}) {
+        auto record = cursor->next();
+        ASSERT(record);
+        ASSERT_EQ(RecordId(id), record->id);
+    }
+    ASSERT_FALSE(cursor->next());
+}
+
 TEST(WiredTigerRecordStoreTest, SizeStorer1) {
     unique_ptr<WiredTigerHarnessHelper> harnessHelper(new WiredTigerHarnessHelper());
     unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
@@ -294,6 +352,243 @@ TEST(WiredTigerRecordStoreTest, SizeStorer1) {
     rs.reset(nullptr);  // this has to be deleted before ss
 }
 
+TEST(WiredTigerRecordStoreTest, SizeStorerFlushesManyCollections) {
+    unique_ptr<WiredTigerHarnessHelper> harnessHelper(new WiredTigerHarnessHelper());
+
+    const string sizeStorerUri = "table:sizeStorer";
+    WiredTigerSizeStorer ss(harnessHelper->conn(), sizeStorerUri);
+
+    // Enough entries to span several flush batches and every buffer shard.
+    const int N = 2500;
+    auto uriFor = [](int i) -> std::string { return str::stream() << "table:coll" << i; };
+    std::vector<std::shared_ptr<WiredTigerSizeStorer::SizeInfo>> infos;
+    for (int i = 0; i < N; i++) {
+        auto info = std::make_shared<WiredTigerSizeStorer::SizeInfo>();
+        info->numRecords.store(i);
+        info->dataSize.store(i * 10);
+        ss.store(uriFor(i), info);
+        infos.push_back(info);
+    }
+
+    // Buffered entries are visible before they are flushed.
+    ASSERT_EQUALS(infos[7].get(), ss.load("table:coll7").get());
+
+    ss.flush(true);
+
+    // Only the entries that were dirtied again are written by the next flush.
+    infos[42]->numRecords.store(4242);
+    ss.store("table:coll42", infos[42]);
+    ss.flush(true);
+
+    WiredTigerSizeStorer ss2(harnessHelper->conn(), sizeStorerUri);
+    for (int i = 0; i < N; i++) {
+        auto info = ss2.load(uriFor(i));
+        ASSERT_EQUALS(i == 42 ? 4242 : i, info->numRecords.load());
+        ASSERT_EQUALS(i * 10, info->dataSize.load());
+    }
+}
+
+TEST(WiredTigerRecordStoreTest, CappedInsertsAreKeyedByTimestamp) {
+    unique_ptr<WiredTigerHarnessHelper> harnessHelper(new WiredTigerHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newCappedRecordStore(100000, -1));
+    ASSERT_TRUE(rs->keysCappedInsertsByTimestamp());
+
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+
+    // Inserts that reach the record store out of timestamp order still get RecordIds in timestamp
+    // order.
+    const Timestamp first(1000, 1);
+    const Timestamp second(1000, 2);
+    for (auto ts : {second, first}) {
+        WriteUnitOfWork uow(opCtx.get());
+        StatusWith<RecordId> res = rs->insertRecord(opCtx.get(), "a", 2, ts);
+        ASSERT_OK(res.getStatus());
+        ASSERT_EQUALS(RecordId(static_cast<int64_t>(ts.asULL())), res.getValue());
+        uow.commit();
+    }
+
+    // Untimestamped inserts are placed after every timestamped one.
+    RecordId untimestamped;
+    {
+        WriteUnitOfWork uow(opCtx.get());
+        StatusWith<RecordId> res = rs->insertRecord(opCtx.get(), "b", 2, Timestamp());
+        ASSERT_OK(res.getStatus());
+        untimestamped = res.getValue();
+        ASSERT_GT(untimestamped, RecordId(static_cast<int64_t>(second.asULL())));
+        uow.commit();
+    }
+
+    // A timestamp that collides with an existing record does not overwrite it.
+    {
+        WriteUnitOfWork uow(opCtx.get());
+        StatusWith<RecordId> res =
+            rs->insertRecord(opCtx.get(), "c", 2, Timestamp(untimestamped.repr()));
+        ASSERT_OK(res.getStatus());
+        ASSERT_GT(res.getValue(), untimestamped);
+        uow.commit();
+    }
+    ASSERT_EQUALS(4, rs->numRecords(opCtx.get()));
+    ASSERT_EQUALS(std::string("b"), rs->dataFor(opCtx.get(), untimestamped).data());
+
+    // Without a running oplog there are no hidden inserts to bound tailing readers by.
+    ASSERT_FALSE(rs->getCappedVisibilityBound(opCtx.get()));
+}
+
+TEST(WiredTigerRecordStoreTest, SizeStorerPersistsMetadata) {
+    unique_ptr<WiredTigerHarnessHelper> harnessHelper(new WiredTigerHarnessHelper());
+
+    const string sizeStorerUri = "table:sizeStorer";
+    const string key = WiredTigerRecordStore::OplogStones::persistedStonesKey("table:oplog");
+    WiredTigerSizeStorer ss(harnessHelper->conn(), sizeStorerUri);
+
+    ASSERT_TRUE(ss.loadMetadata(key).isEmpty());
+
+    BSONObj stones = BSON("minBytesPerStone" << 1024LL << "stones"
+                                             << BSON_ARRAY(BSON("records" << 10LL << "bytes"
+                                                                          << 1100LL
+                                                                          << "lastRecord"
+                                                                          << 42LL)));
+    ss.storeMetadata(key, stones);
+    ASSERT_BSONOBJ_EQ(stones, ss.loadMetadata(key));
+
+    // Metadata is written directly rather than buffered, and does not need a flush to survive.
+    WiredTigerSizeStorer ss2(harnessHelper->conn(), sizeStorerUri);
+    ASSERT_BSONOBJ_EQ(stones, ss2.loadMetadata(key));
+
+    // Collection sizes stored under other keys are unaffected.
+    auto info = ss2.load("table:oplog");
+    ASSERT_EQUALS(0, info->numRecords.load());
+}
+
+TEST(WiredTigerRecordStoreTest, ForwardScanWithReadAhead) {
+    WiredTigerHarnessHelper harnessHelper;
+    unique_ptr<RecordStore> rs(harnessHelper.newNonCappedRecordStore());
+
+    const int N = 1000;
+    const std::string data(100, 'x');
+    std::vector<RecordId> ids;
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper.newOperationContext());
+        WriteUnitOfWork uow(opCtx.get());
+        for (int i = 0; i < N; i++) {
+            StatusWith<RecordId> res =
+                rs->insertRecord(opCtx.get(), data.c_str(), data.size() + 1, Timestamp());
+            ASSERT_OK(res.getStatus());
+            ids.push_back(res.getValue());
+        }
+        uow.commit();
+    }
+
+    const int oldReadAheadBytes = wiredTigerCursorReadAheadBytes.swap(4 * 1024);
+    ON_BLOCK_EXIT([&] { wiredTigerCursorReadAheadBytes.store(oldReadAheadBytes); });
+
+    // Read-ahead must not change what the scan returns.
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper.newOperationContext());
+        auto cursor = rs->getCursor(opCtx.get());
+        for (int i = 0; i < N; i++) {
+            auto record = cursor->next();
+            ASSERT(record);
+            ASSERT_EQ(ids[i], record->id);
+        }
+        ASSERT(!cursor->next());
+    }
+
+    BSONObjBuilder bob;
+    harnessHelper.engine()->getReadAhead()->appendStats(&bob);
+    ASSERT_GT(bob.obj()["cursor read-ahead"]["requests scheduled"].numberLong(), 0);
+}
+
+TEST(WiredTigerRecordStoreTest, UpdateOfLargeUnloggedRecordAppliesSmallChanges) {
+    // Replicated collections of a replica set are not logged, so their updates may be written as
+    // change records.
+    const repl::ReplSettings oldReplSettings = getGlobalReplSettings();
+    ON_BLOCK_EXIT([&] { setGlobalReplSettings(oldReplSettings); });
+    repl::ReplSettings replSettings;
+    replSettings.setReplSetString("rs");
+    setGlobalReplSettings(replSettings);
+
+    WiredTigerHarnessHelper harnessHelper;
+    unique_ptr<RecordStore> rs(harnessHelper.newNonCappedRecordStore("a.b"));
+
+    std::string data(4096, 'x');
+    RecordId id;
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper.newOperationContext());
+        WriteUnitOfWork uow(opCtx.get());
+        StatusWith<RecordId> res =
+            rs->insertRecord(opCtx.get(), data.c_str(), data.size(), Timestamp());
+        ASSERT_OK(res.getStatus());
+        id = res.getValue();
+        uow.commit();
+    }
+
+    auto updateAndCheck = [&](const std::string& newData) {
+        {
+            ServiceContext::UniqueOperationContext opCtx(harnessHelper.newOperationContext());
+            WriteUnitOfWork uow(opCtx.get());
+            ASSERT_OK(rs->updateRecord(opCtx.get(), id, newData.c_str(), newData.size()));
+            uow.commit();
+        }
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper.newOperationContext());
+        RecordData record = rs->dataFor(opCtx.get(), id);
+        ASSERT_EQ(newData, std::string(record.data(), record.size()));
+    };
+
+    // A change which keeps the size, in two places.
+    data[0] = 'a';
+    data.replace(2000, 3, "abc");
+    updateAndCheck(data);
+
+    // Growing the record in the middle.
+    data[1] = 'b';
+    data.insert(3000, "inserted");
+    updateAndCheck(data);
+
+    // Shrinking the record in the middle.
+    data[2] = 'c';
+    data.erase(1000, 100);
+    updateAndCheck(data);
+
+    // Rewriting most of the record.
+    data = std::string(4000, 'y');
+    updateAndCheck(data);
+}
+
+TEST(WiredTigerRecordStoreTest, GroupCommitCoversConcurrentDurableWaiters) {
+    WiredTigerHarnessHelper harnessHelper;
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper.newOperationContext());
+    WiredTigerSessionCache* sessionCache =
+        WiredTigerRecoveryUnit::get(opCtx.get())->getSessionCache();
+
+    const int kThreads = 8;
+    const int kCallsPerThread = 5;
+    std::vector<stdx::thread> threads;
+    for (int i = 0; i < kThreads; i++) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < kCallsPerThread; j++) {
+                sessionCache->waitUntilDurable(/*forceCheckpoint=*/false, false);
+            }
+        });
+    }
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+
+    BSONObjBuilder bob;
+    sessionCache->appendStats(&bob);
+    BSONObj groupCommit = bob.obj()["session cache"]["group commit"].Obj();
+    const long long flushes = groupCommit["flushes"].numberLong();
+    ASSERT_GT(flushes, 0);
+    ASSERT_LTE(flushes, kThreads * kCallsPerThread);
+
+    long long histogramTotal = 0;
+    for (auto&& bucket : groupCommit["batch size histogram"].Obj()) {
+        histogramTotal += bucket.numberLong();
+    }
+    ASSERT_EQ(flushes, histogramTotal);
+}
+
 class GoodValidateAdaptor : public ValidateAdaptor {
 public:
     virtual Status validate(const RecordId& recordId, const RecordData& record, size_t* dataSize) {
@@ -0,0 +1,232 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/timeseries/bucket_catalog.h"
+
+#include <cmath>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/timeseries/timeseries_constants.h"
+
+namespace mongo {
+namespace timeseries {
+namespace {
+
+const auto getBucketCatalog = ServiceContext::declareDecoration<BucketCatalog>();
+
+/**
+ * Returns true if the minimum and maximum of a field can't bound a value like 'elem': comparisons
+ * against arrays and objects match on their contents, and NaN compares neither above nor below
+ * other numbers.
+ */
+bool isUnboundable(const BSONElement& elem) {
+    return elem.type() == Array || elem.type() == Object ||
+        (elem.isNumber() && std::isnan(elem.numberDouble()));
+}
+
+/**
+ * The values of the samples of one BucketWrite, from which its minimum and maximum are built.
+ */
+struct WriteSummary {
+    std::vector<std::string> fields;
+    StringMap<std::pair<BSONElement, BSONElement>> minMax;
+
+    void add(const BSONElement& elem) {
+        auto it = minMax.find(elem.fieldNameStringData());
+        if (it == minMax.end()) {
+            fields.push_back(elem.fieldName());
+            minMax[elem.fieldNameStringData()] = std::make_pair(elem, elem);
+            return;
+        }
+        if (elem.woCompare(it->second.first, false) < 0) {
+            it->second.first = elem;
+        }
+        if (elem.woCompare(it->second.second, false) > 0) {
+            it->second.second = elem;
+        }
+    }
+
+    void finish(BucketCatalog::BucketWrite* write) const {
+        BSONObjBuilder minBuilder;
+        BSONObjBuilder maxBuilder;
+        for (auto&& field : fields) {
+            const auto& values = minMax.find(field)->second;
+            minBuilder.appendAs(values.first, field);
+            maxBuilder.appendAs(values.second, field);
+        }
+        write->min = minBuilder.obj();
+        write->max = maxBuilder.obj();
+    }
+};
+
+}  // namespace
+
+constexpr int BucketCatalog::kMaxBucketCount;
+constexpr int BucketCatalog::kMaxBucketSizeBytes;
+
+BucketCatalog& BucketCatalog::get(ServiceContext* serviceContext) {
+    return getBucketCatalog(serviceContext);
+}
+
+BucketCatalog::InsertResult BucketCatalog::insert(const NamespaceString& bucketsNs,
+                                                  const TimeseriesOptions& options,
+                                                  const std::vector<BSONObj>& docs) {
+    InsertResult result;
+    std::map<OID, size_t> writeIndexes;
+    std::vector<WriteSummary> summaries;
+    const Milliseconds bucketMaxSpan = Seconds(options.bucketMaxSpanSeconds);
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    auto& collectionBuckets = _collections[bucketsNs];
+    for (size_t docIndex = 0; docIndex < docs.size(); ++docIndex) {
+        const BSONObj& doc = docs[docIndex];
+        const Date_t time = doc[options.timeField].date();
+        const BSONElement metaElem =
+            options.metaField.empty() ? BSONElement() : doc[options.metaField];
+        const std::string metaKey = metaElem.ok()
+            ? std::string(1, static_cast<char>(metaElem.type())) +
+                std::string(metaElem.value(), metaElem.valuesize())
+            : std::string();
+        const int docSize = doc.objsize();
+
+        std::shared_ptr<Bucket> bucket;
+        auto openIt = collectionBuckets.openBuckets.find(metaKey);
+        if (openIt != collectionBuckets.openBuckets.end()) {
+            bucket = openIt->second;
+            if (time < bucket->minTime || time >= bucket->minTime + bucketMaxSpan ||
+                bucket->sizeBytes + docSize > kMaxBucketSizeBytes) {
+                _closeBucket(&collectionBuckets, bucket, &result.bucketsToCompress);
+                bucket.reset();
+            }
+        }
+        if (!bucket) {
+            bucket = std::make_shared<Bucket>();
+            bucket->id = OID::gen();
+            if (metaElem.ok()) {
+                bucket->meta = metaElem.wrap(kBucketMetaFieldName);
+            }
+            bucket->metaKey = metaKey;
+            bucket->minTime = time;
+            collectionBuckets.openBuckets[metaKey] = bucket;
+            collectionBuckets.buckets[bucket->id] = bucket;
+        }
+
+        auto writeIt = writeIndexes.find(bucket->id);
+        if (writeIt == writeIndexes.end()) {
+            writeIt = writeIndexes.emplace(bucket->id, result.writes.size()).first;
+            result.writes.emplace_back();
+            result.writes.back().bucketId = bucket->id;
+            result.writes.back().meta = bucket->meta;
+            summaries.emplace_back();
+            ++bucket->outstandingWrites;
+        }
+        auto& write = result.writes[writeIt->second];
+        auto& summary = summaries[writeIt->second];
+
+        write.docIndexes.push_back(docIndex);
+        write.sampleIndexes.push_back(bucket->count++);
+        write.count = bucket->count;
+        bucket->sizeBytes += docSize;
+
+        for (auto&& elem : doc) {
+            const auto fieldName = elem.fieldNameStringData();
+            if (!options.metaField.empty() && fieldName == options.metaField) {
+                continue;
+            }
+            summary.add(elem);
+
+            if (bucket->mixedFields.count(elem.fieldName())) {
+                continue;
+            }
+            auto typeIt = bucket->fieldTypes.find(fieldName);
+            if (isUnboundable(elem) ||
+                (typeIt != bucket->fieldTypes.end() && typeIt->second != elem.canonicalType())) {
+                bucket->mixedFields.insert(elem.fieldName());
+                write.newMixedFields.push_back(elem.fieldName());
+                if (typeIt != bucket->fieldTypes.end()) {
+                    bucket->fieldTypes.erase(typeIt);
+                }
+            } else if (typeIt == bucket->fieldTypes.end()) {
+                bucket->fieldTypes[fieldName] = elem.canonicalType();
+            }
+        }
+
+        if (bucket->count >= kMaxBucketCount || bucket->sizeBytes >= kMaxBucketSizeBytes) {
+            _closeBucket(&collectionBuckets, bucket, &result.bucketsToCompress);
+        }
+    }
+
+    for (size_t i = 0; i < result.writes.size(); ++i) {
+        summaries[i].finish(&result.writes[i]);
+    }
+    return result;
+}
+
+bool BucketCatalog::finishWrite(const NamespaceString& bucketsNs, const OID& bucketId) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    auto collectionIt = _collections.find(bucketsNs);
+    if (collectionIt == _collections.end()) {
+        return false;
+    }
+    auto& buckets = collectionIt->second.buckets;
+    auto bucketIt = buckets.find(bucketId);
+    if (bucketIt == buckets.end()) {
+        return false;
+    }
+
+    auto& bucket = *bucketIt->second;
+    --bucket.outstandingWrites;
+    if (!bucket.closed || bucket.outstandingWrites > 0) {
+        return false;
+    }
+    buckets.erase(bucketIt);
+    return true;
+}
+
+void BucketCatalog::clear(const NamespaceString& bucketsNs) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _collections.erase(bucketsNs);
+}
+
+void BucketCatalog::_closeBucket(CollectionBuckets* collectionBuckets,
+                                 const std::shared_ptr<Bucket>& bucket,
+                                 std::vector<OID>* bucketsToCompress) {
+    invariant(!bucket->closed);
+    bucket->closed = true;
+    collectionBuckets->openBuckets.erase(bucket->metaKey);
+    if (bucket->outstandingWrites == 0) {
+        bucketsToCompress->push_back(bucket->id);
+        collectionBuckets->buckets.erase(bucket->id);
+    }
+}
+
+}  // namespace timeseries
+}  // namespace mongo
@@ -0,0 +1,158 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/oid.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/timeseries/timeseries_options.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/string_map.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class ServiceContext;
+
+namespace timeseries {
+
+/**
+ * Tracks the open bucket of each metadata value of each time-series collection, and assigns
+ * inserted samples to buckets. A bucket is closed once it is full, or a sample arrives that falls
+ * outside its time window, and is compressed once the writes which were assigned to it finish.
+ *
+ * The catalog only lives in memory; after a restart, new samples go to new buckets.
+ *
+ * This class is thread safe.
+ */
+class BucketCatalog {
+public:
+    static constexpr int kMaxBucketCount = 1000;
+    static constexpr int kMaxBucketSizeBytes = 125 * 1024;
+
+    /**
+     * The samples of an insert batch which were assigned to the same bucket. Writing them must be
+     * followed by a call to finishWrite(), whether or not the write succeeded.
+     */
+    struct BucketWrite {
+        OID bucketId;
+
+        // The {meta: <value>} object of the bucket, or empty if its samples have no metadata.
+        BSONObj meta;
+
+        // The positions of the samples in the batch, and their indexes within the bucket.
+        std::vector<size_t> docIndexes;
+        std::vector<int> sampleIndexes;
+
+        // The minimum and maximum values of each field over the samples of this write.
+        BSONObj min;
+        BSONObj max;
+
+        // The fields of the bucket first found to have values which min and max can't bound.
+        std::vector<std::string> newMixedFields;
+
+        // The number of samples assigned to the bucket, including the ones of this write.
+        int count = 0;
+    };
+
+    struct InsertResult {
+        // One write per bucket samples were assigned to, in the order the buckets were first used.
+        std::vector<BucketWrite> writes;
+
+        // Buckets which were closed with no writes outstanding, and so can be compressed now.
+        std::vector<OID> bucketsToCompress;
+    };
+
+    static BucketCatalog& get(ServiceContext* serviceContext);
+
+    /**
+     * Assigns each of 'docs' to a bucket of the time-series collection whose buckets are stored in
+     * 'bucketsNs'. Each document must have a date in the 'timeField' of 'options'.
+     */
+    InsertResult insert(const NamespaceString& bucketsNs,
+                        const TimeseriesOptions& options,
+                        const std::vector<BSONObj>& docs);
+
+    /**
+     * Records that the write of a batch of samples to 'bucketId' finished. Returns true if the
+     * bucket is closed, and this was the last of its outstanding writes, in which case the caller
+     * is responsible for compressing it.
+     */
+    bool finishWrite(const NamespaceString& bucketsNs, const OID& bucketId);
+
+    /**
+     * Forgets the buckets of 'bucketsNs', so that later samples are assigned to new buckets. Used
+     * when a write to a bucket fails, as the catalog may no longer match the buckets collection.
+     */
+    void clear(const NamespaceString& bucketsNs);
+
+private:
+    struct Bucket {
+        OID id;
+        BSONObj meta;
+        std::string metaKey;
+        Date_t minTime;
+        int count = 0;
+        int sizeBytes = 0;
+
+        // The canonical type of the values of each field, for fields which aren't mixed.
+        StringMap<int> fieldTypes;
+        std::set<std::string> mixedFields;
+
+        int outstandingWrites = 0;
+        bool closed = false;
+    };
+
+    struct CollectionBuckets {
+        // The open bucket of each metadata value.
+        std::map<std::string, std::shared_ptr<Bucket>> openBuckets;
+
+        // The open buckets, and the closed buckets which have outstanding writes.
+        std::map<OID, std::shared_ptr<Bucket>> buckets;
+    };
+
+    /**
+     * Closes 'bucket', adding it to 'bucketsToCompress' if it has no outstanding writes.
+     */
+    static void _closeBucket(CollectionBuckets* collectionBuckets,
+                             const std::shared_ptr<Bucket>& bucket,
+                             std::vector<OID>* bucketsToCompress);
+
+    stdx::mutex _mutex;
+    std::map<NamespaceString, CollectionBuckets> _collections;
+};
+
+}  // namespace timeseries
+}  // namespace mongo
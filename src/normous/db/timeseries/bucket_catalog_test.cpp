@@ -0,0 +1,164 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/timeseries/bucket_catalog.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace timeseries {
+namespace {
+
+const NamespaceString kBucketsNs("test.system.buckets.weather");
+
+TimeseriesOptions makeOptions() {
+    TimeseriesOptions options;
+    options.timeField = "time";
+    options.metaField = "sensor";
+    options.bucketMaxSpanSeconds = 60;
+    return options;
+}
+
+BSONObj makeSample(long long seconds, int sensor, const BSONElement& value) {
+    BSONObjBuilder builder;
+    builder.append("time", Date_t::fromMillisSinceEpoch(seconds * 1000));
+    builder.append("sensor", sensor);
+    builder.appendAs(value, "value");
+    return builder.obj();
+}
+
+BSONObj makeSample(long long seconds, int sensor, int value) {
+    return makeSample(seconds, sensor, BSON("" << value).firstElement());
+}
+
+TEST(BucketCatalogTest, GroupsSamplesByMetadata) {
+    BucketCatalog catalog;
+    auto result = catalog.insert(
+        kBucketsNs,
+        makeOptions(),
+        {makeSample(0, 1, 10), makeSample(1, 2, 20), makeSample(2, 1, 5), makeSample(3, 2, 30)});
+
+    ASSERT_EQ(result.writes.size(), 2U);
+    ASSERT(result.bucketsToCompress.empty());
+
+    const auto& first = result.writes[0];
+    ASSERT_BSONOBJ_EQ(first.meta, BSON("meta" << 1));
+    ASSERT(first.docIndexes == std::vector<size_t>({0, 2}));
+    ASSERT(first.sampleIndexes == std::vector<int>({0, 1}));
+    ASSERT_EQ(first.count, 2);
+    ASSERT_BSONOBJ_EQ(first.min, BSON("time" << Date_t::fromMillisSinceEpoch(0) << "value" << 5));
+    ASSERT_BSONOBJ_EQ(first.max,
+                      BSON("time" << Date_t::fromMillisSinceEpoch(2000) << "value" << 10));
+    ASSERT(first.newMixedFields.empty());
+
+    const auto& second = result.writes[1];
+    ASSERT_BSONOBJ_EQ(second.meta, BSON("meta" << 2));
+    ASSERT(second.docIndexes == std::vector<size_t>({1, 3}));
+
+    ASSERT_FALSE(catalog.finishWrite(kBucketsNs, first.bucketId));
+    ASSERT_FALSE(catalog.finishWrite(kBucketsNs, second.bucketId));
+
+    // Later samples go on filling the open buckets.
+    auto next = catalog.insert(kBucketsNs, makeOptions(), {makeSample(4, 1, 7)});
+    ASSERT_EQ(next.writes.size(), 1U);
+    ASSERT_EQ(next.writes[0].bucketId, first.bucketId);
+    ASSERT(next.writes[0].sampleIndexes == std::vector<int>({2}));
+    ASSERT_EQ(next.writes[0].count, 3);
+}
+
+TEST(BucketCatalogTest, SampleOutsideTimeSpanClosesBucket) {
+    BucketCatalog catalog;
+    auto result = catalog.insert(kBucketsNs, makeOptions(), {makeSample(100, 1, 1)});
+    ASSERT_EQ(result.writes.size(), 1U);
+    const auto firstBucket = result.writes[0].bucketId;
+
+    // The bucket is closed while its write is outstanding, so it is compressed once that finishes.
+    auto later = catalog.insert(kBucketsNs, makeOptions(), {makeSample(160, 1, 2)});
+    ASSERT_EQ(later.writes.size(), 1U);
+    ASSERT_NE(later.writes[0].bucketId, firstBucket);
+    ASSERT(later.bucketsToCompress.empty());
+    ASSERT_TRUE(catalog.finishWrite(kBucketsNs, firstBucket));
+    ASSERT_FALSE(catalog.finishWrite(kBucketsNs, later.writes[0].bucketId));
+
+    // A sample older than the open bucket does not belong to it either.
+    auto earlier = catalog.insert(kBucketsNs, makeOptions(), {makeSample(150, 1, 3)});
+    ASSERT_EQ(earlier.writes.size(), 1U);
+    ASSERT_NE(earlier.writes[0].bucketId, later.writes[0].bucketId);
+    ASSERT(earlier.bucketsToCompress == std::vector<OID>({later.writes[0].bucketId}));
+}
+
+TEST(BucketCatalogTest, FullBucketIsClosed) {
+    BucketCatalog catalog;
+    std::vector<BSONObj> samples;
+    for (int i = 0; i < BucketCatalog::kMaxBucketCount + 1; ++i) {
+        samples.push_back(makeSample(0, 1, i));
+    }
+
+    auto result = catalog.insert(kBucketsNs, makeOptions(), samples);
+    ASSERT_EQ(result.writes.size(), 2U);
+    ASSERT_EQ(result.writes[0].count, BucketCatalog::kMaxBucketCount);
+    ASSERT_EQ(result.writes[1].count, 1);
+    ASSERT_TRUE(catalog.finishWrite(kBucketsNs, result.writes[0].bucketId));
+    ASSERT_FALSE(catalog.finishWrite(kBucketsNs, result.writes[1].bucketId));
+}
+
+TEST(BucketCatalogTest, FieldsOfDifferingTypesAreMixed) {
+    BucketCatalog catalog;
+    auto result = catalog.insert(kBucketsNs,
+                                 makeOptions(),
+                                 {makeSample(0, 1, 1),
+                                  makeSample(1, 1, BSON("" << 2.5).firstElement()),
+                                  makeSample(2, 1, BSON("" << "a").firstElement()),
+                                  makeSample(3, 1, BSON("" << BSON_ARRAY(1)).firstElement())});
+    ASSERT_EQ(result.writes.size(), 1U);
+    ASSERT(result.writes[0].newMixedFields == std::vector<std::string>({"value"}));
+    ASSERT_FALSE(catalog.finishWrite(kBucketsNs, result.writes[0].bucketId));
+
+    // A field is only reported as newly mixed once per bucket.
+    auto next = catalog.insert(
+        kBucketsNs, makeOptions(), {makeSample(4, 1, BSON("" << BSON("a" << 1)).firstElement())});
+    ASSERT(next.writes[0].newMixedFields.empty());
+}
+
+TEST(BucketCatalogTest, ClearForgetsOpenBuckets) {
+    BucketCatalog catalog;
+    auto result = catalog.insert(kBucketsNs, makeOptions(), {makeSample(0, 1, 1)});
+    catalog.clear(kBucketsNs);
+    ASSERT_FALSE(catalog.finishWrite(kBucketsNs, result.writes[0].bucketId));
+
+    auto next = catalog.insert(kBucketsNs, makeOptions(), {makeSample(1, 1, 2)});
+    ASSERT_NE(next.writes[0].bucketId, result.writes[0].bucketId);
+    ASSERT_EQ(next.writes[0].count, 1);
+}
+
+}  // namespace
+}  // namespace timeseries
+}  // namespace mongo
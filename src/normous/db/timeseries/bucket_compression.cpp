@@ -0,0 +1,354 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/timeseries/bucket_compression.h"
+
+#include <cmath>
+#include <vector>
+
+#include "mongo/base/parse_number.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/bson/util/builder.h"
+#include "mongo/db/timeseries/timeseries_constants.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace timeseries {
+namespace {
+
+/**
+ * A compressed column is a BinData holding:
+ *
+ *     <uint8 scheme> <uint8 BSON type> <uint8 decimal scale> <varint count> <varint values...>
+ *
+ * where the values are the zigzag encoded deltas (or deltas of deltas) of the integers the column
+ * values map to. The first value is encoded as its delta from zero, and, for kDeltaOfDelta, the
+ * second as its delta from the first.
+ */
+enum class Scheme : uint8_t { kDelta = 1, kDeltaOfDelta = 2 };
+
+// Doubles with more significant digits than this can't be scaled to integers exactly.
+constexpr long long kMaxExactDoubleInteger = 1LL << 53;
+
+uint64_t zigzagEncode(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t zigzagDecode(uint64_t value) {
+    return static_cast<int64_t>((value >> 1) ^ (~(value & 1) + 1));
+}
+
+void appendVarint(BufBuilder* buf, uint64_t value) {
+    while (value >= 0x80) {
+        buf->appendUChar(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    }
+    buf->appendUChar(static_cast<unsigned char>(value));
+}
+
+class ColumnReader {
+public:
+    ColumnReader(const char* data, int len) : _ptr(data), _end(data + len) {}
+
+    uint8_t readByte() {
+        uassert(50975, "corrupt compressed time-series column", _ptr < _end);
+        return static_cast<uint8_t>(*_ptr++);
+    }
+
+    uint64_t readVarint() {
+        uint64_t value = 0;
+        for (int shift = 0;; shift += 7) {
+            uassert(50976, "corrupt compressed time-series column", shift < 64);
+            const uint8_t byte = readByte();
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) {
+                return value;
+            }
+        }
+    }
+
+    bool atEnd() const {
+        return _ptr == _end;
+    }
+
+private:
+    const char* _ptr;
+    const char* const _end;
+};
+
+double scaleFactor(int scale) {
+    double factor = 1;
+    for (int i = 0; i < scale; ++i) {
+        factor *= 10;
+    }
+    return factor;
+}
+
+/**
+ * Returns the integer 'value' maps to when multiplied by 10^'scale', if it maps back to exactly
+ * 'value'.
+ */
+boost::optional<long long> scaleDouble(double value, double factor) {
+    const double scaled = value * factor;
+    if (!std::isfinite(scaled) || std::abs(scaled) >= kMaxExactDoubleInteger) {
+        return boost::none;
+    }
+    const long long integer = std::llround(scaled);
+    const double roundTripped = static_cast<double>(integer) / factor;
+    if (roundTripped != value || std::signbit(roundTripped) != std::signbit(value)) {
+        return boost::none;
+    }
+    return integer;
+}
+
+/**
+ * Returns the values of 'column' ordered by sample index, if it has exactly one value for each of
+ * the 'count' samples.
+ */
+boost::optional<std::vector<BSONElement>> orderColumn(const BSONObj& column, int count) {
+    if (column.nFields() != count) {
+        return boost::none;
+    }
+    std::vector<BSONElement> values(count);
+    for (auto&& elem : column) {
+        int index;
+        if (!parseNumberFromStringWithBase(elem.fieldNameStringData(), 10, &index).isOK() ||
+            index < 0 || index >= count || values[index].ok()) {
+            return boost::none;
+        }
+        values[index] = elem;
+    }
+    return values;
+}
+
+/**
+ * Appends the encoding of 'column' to 'builder' as a BinData named 'fieldName'. Returns false,
+ * appending nothing, if the column can't be encoded.
+ */
+bool appendCompressedColumn(BSONObjBuilder* builder,
+                            StringData fieldName,
+                            const BSONObj& column,
+                            int count) {
+    auto values = orderColumn(column, count);
+    if (!values || values->empty()) {
+        return false;
+    }
+
+    const BSONType type = values->front().type();
+    if (type != NumberInt && type != NumberLong && type != Date && type != NumberDouble) {
+        return false;
+    }
+    for (auto&& value : *values) {
+        if (value.type() != type) {
+            return false;
+        }
+    }
+
+    std::vector<long long> integers;
+    integers.reserve(values->size());
+    int scale = 0;
+    if (type == NumberDouble) {
+        // Find the smallest decimal scale at which every double is exactly an integer.
+        for (; scale <= kMaxDoubleScale; ++scale) {
+            const double factor = scaleFactor(scale);
+            integers.clear();
+            for (auto&& value : *values) {
+                auto integer = scaleDouble(value._numberDouble(), factor);
+                if (!integer) {
+                    break;
+                }
+                integers.push_back(*integer);
+            }
+            if (integers.size() == values->size()) {
+                break;
+            }
+        }
+        if (scale > kMaxDoubleScale) {
+            return false;
+        }
+    } else {
+        for (auto&& value : *values) {
+            integers.push_back(type == Date ? value.date().toMillisSinceEpoch()
+                                            : value.numberLong());
+        }
+    }
+
+    const Scheme scheme = type == Date ? Scheme::kDeltaOfDelta : Scheme::kDelta;
+    BufBuilder buf;
+    buf.appendUChar(static_cast<unsigned char>(scheme));
+    buf.appendUChar(static_cast<unsigned char>(type));
+    buf.appendUChar(static_cast<unsigned char>(scale));
+    appendVarint(&buf, integers.size());
+
+    // Deltas are computed with wrapping unsigned arithmetic, which decoding reverses exactly.
+    uint64_t previous = 0;
+    uint64_t previousDelta = 0;
+    for (size_t i = 0; i < integers.size(); ++i) {
+        const uint64_t current = static_cast<uint64_t>(integers[i]);
+        const uint64_t delta = current - previous;
+        const uint64_t encoded =
+            (scheme == Scheme::kDeltaOfDelta && i > 1) ? delta - previousDelta : delta;
+        appendVarint(&buf, zigzagEncode(static_cast<int64_t>(encoded)));
+        previous = current;
+        previousDelta = delta;
+    }
+
+    builder->appendBinData(fieldName, buf.len(), BinDataGeneral, buf.buf());
+    return true;
+}
+
+void appendDecompressedColumn(BSONObjBuilder* builder, const BSONElement& column) {
+    int len;
+    const char* data = column.binData(len);
+    ColumnReader reader(data, len);
+
+    const auto scheme = static_cast<Scheme>(reader.readByte());
+    const auto type = static_cast<BSONType>(reader.readByte());
+    const int scale = reader.readByte();
+    const uint64_t count = reader.readVarint();
+    uassert(50977,
+            "corrupt compressed time-series column",
+            (scheme == Scheme::kDelta || scheme == Scheme::kDeltaOfDelta) &&
+                (type == NumberInt || type == NumberLong || type == Date ||
+                 type == NumberDouble) &&
+                scale <= kMaxDoubleScale && count <= static_cast<uint64_t>(len));
+    const double factor = scaleFactor(scale);
+
+    BSONObjBuilder columnBuilder(builder->subobjStart(column.fieldNameStringData()));
+    uint64_t previous = 0;
+    uint64_t previousDelta = 0;
+    for (uint64_t i = 0; i < count; ++i) {
+        const uint64_t encoded = static_cast<uint64_t>(zigzagDecode(reader.readVarint()));
+        const uint64_t delta =
+            (scheme == Scheme::kDeltaOfDelta && i > 1) ? encoded + previousDelta : encoded;
+        const uint64_t current = previous + delta;
+        previous = current;
+        previousDelta = delta;
+
+        const auto fieldName = BSONObjBuilder::numStr(static_cast<int>(i));
+        const auto integer = static_cast<long long>(current);
+        switch (type) {
+            case NumberInt:
+                columnBuilder.append(fieldName, static_cast<int>(integer));
+                break;
+            case NumberLong:
+                columnBuilder.append(fieldName, integer);
+                break;
+            case Date:
+                columnBuilder.appendDate(fieldName, Date_t::fromMillisSinceEpoch(integer));
+                break;
+            default:
+                columnBuilder.append(fieldName, static_cast<double>(integer) / factor);
+                break;
+        }
+    }
+    uassert(50978, "corrupt compressed time-series column", reader.atEnd());
+}
+
+/**
+ * Appends a copy of the 'control' object of a bucket to 'builder', with its version replaced by
+ * 'version'.
+ */
+void appendControl(BSONObjBuilder* builder, const BSONObj& control, int version) {
+    BSONObjBuilder controlBuilder(builder->subobjStart(kBucketControlFieldName));
+    controlBuilder.append(kBucketControlVersionFieldName, version);
+    for (auto&& elem : control) {
+        if (elem.fieldNameStringData() != kBucketControlVersionFieldName) {
+            controlBuilder.append(elem);
+        }
+    }
+}
+
+}  // namespace
+
+boost::optional<BSONObj> compressBucket(const BSONObj& bucket) {
+    const BSONObj control = bucket[kBucketControlFieldName].Obj();
+    if (control[kBucketControlVersionFieldName].numberInt() == kCompressedBucketVersion) {
+        return boost::none;
+    }
+    const int count = control[kBucketControlCountFieldName].numberInt();
+
+    bool compressedAny = false;
+    BSONObjBuilder builder;
+    for (auto&& elem : bucket) {
+        const auto fieldName = elem.fieldNameStringData();
+        if (fieldName == kBucketControlFieldName) {
+            appendControl(&builder, control, kCompressedBucketVersion);
+        } else if (fieldName == kBucketDataFieldName) {
+            BSONObjBuilder dataBuilder(builder.subobjStart(kBucketDataFieldName));
+            for (auto&& column : elem.Obj()) {
+                if (column.type() == Object &&
+                    appendCompressedColumn(
+                        &dataBuilder, column.fieldNameStringData(), column.Obj(), count)) {
+                    compressedAny = true;
+                } else {
+                    dataBuilder.append(column);
+                }
+            }
+        } else {
+            builder.append(elem);
+        }
+    }
+
+    if (!compressedAny) {
+        return boost::none;
+    }
+    return builder.obj();
+}
+
+BSONObj decompressBucket(const BSONObj& bucket) {
+    const BSONObj control = bucket[kBucketControlFieldName].Obj();
+    if (control[kBucketControlVersionFieldName].numberInt() != kCompressedBucketVersion) {
+        return bucket;
+    }
+
+    BSONObjBuilder builder;
+    for (auto&& elem : bucket) {
+        const auto fieldName = elem.fieldNameStringData();
+        if (fieldName == kBucketControlFieldName) {
+            appendControl(&builder, control, kUncompressedBucketVersion);
+        } else if (fieldName == kBucketDataFieldName) {
+            BSONObjBuilder dataBuilder(builder.subobjStart(kBucketDataFieldName));
+            for (auto&& column : elem.Obj()) {
+                if (column.type() == BinData) {
+                    appendDecompressedColumn(&dataBuilder, column);
+                } else {
+                    dataBuilder.append(column);
+                }
+            }
+        } else {
+            builder.append(elem);
+        }
+    }
+    return builder.obj();
+}
+
+}  // namespace timeseries
+}  // namespace mongo
@@ -0,0 +1,61 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+
+#include "mongo/bson/bsonobj.h"
+
+namespace mongo {
+namespace timeseries {
+
+/**
+ * Returns 'bucket' with each of its data columns that can be delta encoded replaced by a BinData
+ * holding the encoding, and its control version set to kCompressedBucketVersion. Returns
+ * boost::none if 'bucket' is already compressed, or none of its columns can be encoded.
+ *
+ * A column can be encoded when it has a value for every sample of the bucket, and the values are
+ * all ints, all longs, all dates, or all doubles with at most kMaxDoubleScale decimal places.
+ * Dates are encoded as deltas of deltas, which are near zero for samples taken at regular
+ * intervals, and numbers as deltas.
+ */
+boost::optional<BSONObj> compressBucket(const BSONObj& bucket);
+
+/**
+ * Returns 'bucket' in the layout of an uncompressed bucket, with each compressed column decoded
+ * into an object keyed by sample index. Returns 'bucket' itself if it isn't compressed. Throws if
+ * a compressed column is corrupt.
+ */
+BSONObj decompressBucket(const BSONObj& bucket);
+
+// The largest number of decimal places of the doubles in a column that can be encoded.
+constexpr int kMaxDoubleScale = 9;
+
+}  // namespace timeseries
+}  // namespace mongo
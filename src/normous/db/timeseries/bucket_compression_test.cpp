@@ -0,0 +1,136 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/timeseries/bucket_compression.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/json.h"
+#include "mongo/db/timeseries/timeseries_constants.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace timeseries {
+namespace {
+
+BSONObj makeBucket(const BSONObj& data, int count) {
+    return BSON("_id" << OID::gen() << "control"
+                      << BSON("version" << kUncompressedBucketVersion << "count" << count)
+                      << "data"
+                      << data);
+}
+
+TEST(BucketCompressionTest, RoundTripsEncodableColumns) {
+    const auto bucket = makeBucket(
+        BSON("time" << BSON("0" << Date_t::fromMillisSinceEpoch(1000) << "1"
+                                << Date_t::fromMillisSinceEpoch(2000)
+                                << "2"
+                                << Date_t::fromMillisSinceEpoch(3000))
+                    << "i"
+                    << BSON("0" << 5 << "1" << -3 << "2" << 7)
+                    << "l"
+                    << BSON("0" << 1LL << "1" << (1LL << 40) << "2" << -(1LL << 40))
+                    << "d"
+                    << BSON("0" << 1.5 << "1" << 2.25 << "2" << -0.125)),
+        3);
+
+    auto compressed = compressBucket(bucket);
+    ASSERT(compressed);
+    ASSERT_EQ(compressed->getObjectField("control")["version"].numberInt(),
+              kCompressedBucketVersion);
+    for (auto&& column : compressed->getObjectField("data")) {
+        ASSERT_EQ(column.type(), BinData) << column.fieldName();
+    }
+
+    ASSERT_BSONOBJ_EQ(decompressBucket(*compressed), bucket);
+}
+
+TEST(BucketCompressionTest, LeavesUnencodableColumnsAsTheyAre) {
+    const auto bucket = makeBucket(BSON("time" << BSON("0" << Date_t::fromMillisSinceEpoch(1000)
+                                                           << "1"
+                                                           << Date_t::fromMillisSinceEpoch(2000))
+                                               << "s"
+                                               << BSON("0"
+                                                       << "a"
+                                                       << "1"
+                                                       << "b")
+                                               << "mixed"
+                                               << BSON("0" << 1 << "1" << 1.5)
+                                               << "sparse"
+                                               << BSON("1" << 4)
+                                               << "precise"
+                                               << BSON("0" << 0.1 << "1" << 1.0 / 3)),
+                                   2);
+
+    auto compressed = compressBucket(bucket);
+    ASSERT(compressed);
+    const auto data = compressed->getObjectField("data");
+    ASSERT_EQ(data["time"].type(), BinData);
+    ASSERT_BSONOBJ_EQ(data["s"].Obj(), bucket["data"]["s"].Obj());
+    ASSERT_BSONOBJ_EQ(data["mixed"].Obj(), bucket["data"]["mixed"].Obj());
+    ASSERT_BSONOBJ_EQ(data["sparse"].Obj(), bucket["data"]["sparse"].Obj());
+    ASSERT_BSONOBJ_EQ(data["precise"].Obj(), bucket["data"]["precise"].Obj());
+
+    ASSERT_BSONOBJ_EQ(decompressBucket(*compressed), bucket);
+}
+
+TEST(BucketCompressionTest, DoesNotCompressTwice) {
+    const auto bucket = makeBucket(BSON("time" << BSON("0" << Date_t::fromMillisSinceEpoch(1000))),
+                                   1);
+    auto compressed = compressBucket(bucket);
+    ASSERT(compressed);
+    ASSERT_FALSE(compressBucket(*compressed));
+}
+
+TEST(BucketCompressionTest, DoesNotCompressBucketWithoutEncodableColumns) {
+    const auto bucket = makeBucket(BSON("s" << BSON("0"
+                                                    << "a")),
+                                   1);
+    ASSERT_FALSE(compressBucket(bucket));
+}
+
+TEST(BucketCompressionTest, DecompressingUncompressedBucketReturnsIt) {
+    const auto bucket = makeBucket(BSON("x" << BSON("0" << 1)), 1);
+    ASSERT_BSONOBJ_EQ(decompressBucket(bucket), bucket);
+}
+
+TEST(BucketCompressionTest, CorruptColumnFailsToDecompress) {
+    const char garbage[] = {1, NumberInt, 0, 100};
+    BSONObjBuilder data;
+    data.appendBinData("x", sizeof(garbage), BinDataGeneral, garbage);
+    const auto bucket = BSON("_id" << OID::gen() << "control"
+                                   << BSON("version" << kCompressedBucketVersion << "count" << 1)
+                                   << "data"
+                                   << data.obj());
+    ASSERT_THROWS(decompressBucket(bucket), AssertionException);
+}
+
+}  // namespace
+}  // namespace timeseries
+}  // namespace mongo
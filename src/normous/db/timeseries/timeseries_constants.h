@@ -0,0 +1,66 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/base/string_data.h"
+
+namespace mongo {
+namespace timeseries {
+
+/**
+ * The layout of a bucket document:
+ *
+ * {
+ *     _id: <ObjectId>,
+ *     control: {
+ *         version: <1 while open, 2 once its columns are compressed>,
+ *         count: <upper bound on the number of samples>,
+ *         min: {<field>: <minimum value>, ...},
+ *         max: {<field>: <maximum value>, ...},
+ *         mixed: [<fields whose min and max can't bound their values>, ...],
+ *     },
+ *     meta: <the metadata value shared by the samples, if any>,
+ *     data: {<field>: {"<sample index>": <value>, ...} or <compressed column>, ...}
+ * }
+ */
+constexpr StringData kBucketControlFieldName = "control"_sd;
+constexpr StringData kBucketMetaFieldName = "meta"_sd;
+constexpr StringData kBucketDataFieldName = "data"_sd;
+
+constexpr StringData kBucketControlVersionFieldName = "version"_sd;
+constexpr StringData kBucketControlCountFieldName = "count"_sd;
+constexpr StringData kBucketControlMinFieldName = "min"_sd;
+constexpr StringData kBucketControlMaxFieldName = "max"_sd;
+constexpr StringData kBucketControlMixedFieldName = "mixed"_sd;
+
+constexpr int kUncompressedBucketVersion = 1;
+constexpr int kCompressedBucketVersion = 2;
+
+}  // namespace timeseries
+}  // namespace mongo
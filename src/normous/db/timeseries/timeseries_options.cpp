@@ -0,0 +1,135 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/timeseries/timeseries_options.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace timeseries {
+
+constexpr StringData TimeseriesOptions::kTimeFieldName;
+constexpr StringData TimeseriesOptions::kMetaFieldName;
+constexpr StringData TimeseriesOptions::kBucketMaxSpanSecondsFieldName;
+constexpr int TimeseriesOptions::kDefaultBucketMaxSpanSeconds;
+constexpr int TimeseriesOptions::kMaxBucketMaxSpanSeconds;
+
+namespace {
+
+AtomicWord<bool> timeseriesBucketsCollectionExists{false};
+
+Status validateFieldName(StringData optionName, const BSONElement& elem) {
+    if (elem.type() != BSONType::String) {
+        return {ErrorCodes::TypeMismatch,
+                str::stream() << "'" << optionName << "' must be a string, not "
+                              << typeName(elem.type())};
+    }
+    const auto fieldName = elem.valueStringData();
+    if (fieldName.empty() || fieldName[0] == '$' || fieldName.find('.') != std::string::npos ||
+        fieldName == "_id") {
+        return {ErrorCodes::BadValue,
+                str::stream() << "'" << optionName << "' must be a top-level field name other "
+                              << "than _id, not '"
+                              << fieldName
+                              << "'"};
+    }
+    return Status::OK();
+}
+
+}  // namespace
+
+StatusWith<TimeseriesOptions> TimeseriesOptions::parse(const BSONObj& obj) {
+    TimeseriesOptions options;
+    bool hasTimeField = false;
+    for (auto&& elem : obj) {
+        const auto fieldName = elem.fieldNameStringData();
+        if (fieldName == kTimeFieldName) {
+            auto status = validateFieldName(fieldName, elem);
+            if (!status.isOK()) {
+                return status;
+            }
+            options.timeField = elem.str();
+            hasTimeField = true;
+        } else if (fieldName == kMetaFieldName) {
+            auto status = validateFieldName(fieldName, elem);
+            if (!status.isOK()) {
+                return status;
+            }
+            options.metaField = elem.str();
+        } else if (fieldName == kBucketMaxSpanSecondsFieldName) {
+            if (!elem.isNumber() || elem.numberLong() <= 0 ||
+                elem.numberLong() > kMaxBucketMaxSpanSeconds ||
+                elem.numberDouble() != elem.numberLong()) {
+                return {ErrorCodes::BadValue,
+                        str::stream() << "'" << kBucketMaxSpanSecondsFieldName
+                                      << "' must be a positive number of seconds of at most "
+                                      << kMaxBucketMaxSpanSeconds};
+            }
+            options.bucketMaxSpanSeconds = elem.numberInt();
+        } else {
+            return {ErrorCodes::BadValue,
+                    str::stream() << "unknown time-series option '" << fieldName << "'"};
+        }
+    }
+
+    if (!hasTimeField) {
+        return {ErrorCodes::BadValue,
+                str::stream() << "time-series collections require a '" << kTimeFieldName << "'"};
+    }
+    if (options.metaField == options.timeField) {
+        return {ErrorCodes::BadValue,
+                str::stream() << "'" << kMetaFieldName << "' and '" << kTimeFieldName
+                              << "' must be different fields"};
+    }
+    return options;
+}
+
+BSONObj TimeseriesOptions::toBSON() const {
+    BSONObjBuilder builder;
+    builder.append(kTimeFieldName, timeField);
+    if (!metaField.empty()) {
+        builder.append(kMetaFieldName, metaField);
+    }
+    builder.append(kBucketMaxSpanSecondsFieldName, bucketMaxSpanSeconds);
+    return builder.obj();
+}
+
+void noteTimeseriesBucketsCollection() {
+    timeseriesBucketsCollectionExists.store(true);
+}
+
+bool mayHaveTimeseriesCollections() {
+    return timeseriesBucketsCollectionExists.load();
+}
+
+}  // namespace timeseries
+}  // namespace mongo
@@ -0,0 +1,82 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+
+#include "mongo/base/status_with.h"
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj.h"
+
+namespace mongo {
+namespace timeseries {
+
+/**
+ * The 'timeseries' options of a time-series collection, which is stored as a view over a
+ * collection of buckets. Each bucket groups the samples that share the value of 'metaField' and
+ * whose 'timeField' falls in a window of at most 'bucketMaxSpanSeconds'.
+ */
+struct TimeseriesOptions {
+    static constexpr StringData kTimeFieldName = "timeField"_sd;
+    static constexpr StringData kMetaFieldName = "metaField"_sd;
+    static constexpr StringData kBucketMaxSpanSecondsFieldName = "bucketMaxSpanSeconds"_sd;
+
+    static constexpr int kDefaultBucketMaxSpanSeconds = 60 * 60;
+    static constexpr int kMaxBucketMaxSpanSeconds = 365 * 24 * 60 * 60;
+
+    /**
+     * Parses and validates the 'timeseries' options of a collection.
+     */
+    static StatusWith<TimeseriesOptions> parse(const BSONObj& obj);
+
+    BSONObj toBSON() const;
+
+    // The field of each sample holding its time, which must be a date.
+    std::string timeField;
+
+    // The field of each sample holding the metadata its bucket is grouped by; empty if samples have
+    // no metadata.
+    std::string metaField;
+
+    int bucketMaxSpanSeconds = kDefaultBucketMaxSpanSeconds;
+};
+
+/**
+ * Records that a collection of time-series buckets exists, so that writes check whether they
+ * target a time-series collection. Once set, the flag is never cleared.
+ */
+void noteTimeseriesBucketsCollection();
+
+/**
+ * Returns true if a time-series buckets collection may exist on this node.
+ */
+bool mayHaveTimeseriesCollections();
+
+}  // namespace timeseries
+}  // namespace mongo
@@ -68,6 +68,14 @@ Action TransactionCoordinator::recvTryAbort() {
     return _stateMachine.onEvent(std::move(lk), Event::kRecvTryAbort);
 }
 
+Action TransactionCoordinator::recvTryAbortIfUnused() {
+    stdx::unique_lock<stdx::mutex> lk(_mutex);
+    if (_stateMachine.state() != State::kWaitingForParticipantList) {
+        return Action::kNone;
+    }
+    return _stateMachine.onEvent(std::move(lk), Event::kRecvTryAbort);
+}
+
 void TransactionCoordinator::recvCommitAck(const ShardId& shardId) {
     stdx::unique_lock<stdx::mutex> lk(_mutex);
     _participantList.recordCommitAck(shardId);
@@ -176,6 +176,13 @@ public:
      */
     StateMachine::Action recvTryAbort();
 
+    /**
+     * Same as recvTryAbort, but only delivers the event if the coordinator has not yet received the
+     * participant list, i.e. two-phase commit never began. Returns kNone without changing state
+     * otherwise.
+     */
+    StateMachine::Action recvTryAbortIfUnused();
+
     /**
      * Returns a Future which will be signaled when the TransactionCoordinator either commits
      * or aborts. The resulting future will contain the final state of the coordinator.
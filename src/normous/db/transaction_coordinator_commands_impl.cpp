@@ -46,42 +46,34 @@ namespace mongo {
 namespace {
 
 /**
- * Finds the host and port for a shard.
+ * Finds the host and port for a shard. The returned future is ready as soon as the shard's replica
+ * set monitor knows a matching host, or with an error after waiting up to 20 seconds for one.
  */
-StatusWith<HostAndPort> targetHost(OperationContext* opCtx,
-                                   const ShardId& shardId,
-                                   const ReadPreferenceSetting& readPref) {
+Future<HostAndPort> targetHost(const ShardId& shardId, const ReadPreferenceSetting& readPref) {
     auto shard = Grid::get(getGlobalServiceContext())->shardRegistry()->getShardNoReload(shardId);
     if (!shard) {
-        return Status(ErrorCodes::ShardNotFound,
-                      str::stream() << "Could not find shard " << shardId);
+        return Future<HostAndPort>::makeReady(
+            Status(ErrorCodes::ShardNotFound, str::stream() << "Could not find shard " << shardId));
     }
 
-    auto targeter = shard->getTargeter();
-    return targeter->findHost(opCtx, readPref);
+    return shard->getTargeter()->findHostWithMaxWait(readPref, Seconds(20));
 }
 
 using CallbackFn = stdx::function<void(Status status, const ShardId& shardID)>;
 
 /**
- * Sends the given command object to the given shard ID. If scheduling and running the command is
- * successful, calls the callback with the status of the command response and the shard ID.
+ * Schedules the given command object to be sent to 'host', which is the primary of the given shard
+ * ID. If running the command is successful, calls the callback with the status of the command
+ * response and the shard ID.
  */
-void sendAsyncCommandToShard(OperationContext* opCtx,
-                             executor::TaskExecutor* executor,
-                             const ShardId& shardId,
-                             const BSONObj& commandObj,
-                             CallbackFn callbackOnCommandResponse) {
-    auto readPref = ReadPreferenceSetting(ReadPreference::PrimaryOnly);
-    auto swShardHostAndPort = targetHost(opCtx, shardId, readPref);
-    if (!swShardHostAndPort.isOK()) {
-        LOG(3) << "Coordinator shard failed to target primary host of participant shard for "
-               << commandObj << causedBy(swShardHostAndPort.getStatus());
-        return;
-    }
-
+void scheduleCommandOnHost(executor::TaskExecutor* executor,
+                           const HostAndPort& host,
+                           const ShardId& shardId,
+                           const BSONObj& commandObj,
+                           const ReadPreferenceSetting& readPref,
+                           CallbackFn callbackOnCommandResponse) {
     executor::RemoteCommandRequest request(
-        swShardHostAndPort.getValue(), "admin", commandObj, readPref.toContainingBSON(), nullptr);
+        host, "admin", commandObj, readPref.toContainingBSON(), nullptr);
 
     auto swCallbackHandle = executor->scheduleRemoteCommand(
         request,
@@ -108,6 +100,38 @@ void sendAsyncCommandToShard(OperationContext* opCtx,
     // Do not wait for the callback to run.
 }
 
+/**
+ * Schedules the given command object to be sent to the given shard ID's primary. If scheduling and
+ * running the command is successful, calls the callback with the status of the command response
+ * and the shard ID.
+ *
+ * Targeting the primary does not block the caller, so a participant shard that is slow to elect a
+ * primary does not hold up the messages to the other participants.
+ */
+void sendAsyncCommandToShard(executor::TaskExecutor* executor,
+                             const ShardId& shardId,
+                             const BSONObj& commandObj,
+                             CallbackFn callbackOnCommandResponse) {
+    auto readPref = ReadPreferenceSetting(ReadPreference::PrimaryOnly);
+    targetHost(shardId, readPref)
+        .getAsync([executor, shardId, commandObj, readPref, callbackOnCommandResponse](
+            StatusWith<HostAndPort> swShardHostAndPort) {
+            if (!swShardHostAndPort.isOK()) {
+                LOG(3) << "Coordinator shard failed to target primary host of participant shard "
+                       << shardId << " for " << commandObj
+                       << causedBy(swShardHostAndPort.getStatus());
+                return;
+            }
+
+            scheduleCommandOnHost(executor,
+                                  swShardHostAndPort.getValue(),
+                                  shardId,
+                                  commandObj,
+                                  readPref,
+                                  callbackOnCommandResponse);
+        });
+}
+
 /**
  * Sends the given command object to all shards in the set of shard IDs. For each shard ID, if
  * scheduling and running the command is successful, calls the callback with the status of the
@@ -124,9 +148,9 @@ void sendAsyncCommandToShards(OperationContext* opCtx,
     StringBuilder ss;
     ss << "[";
     // For each non-acked participant, launch an async task to target its shard
-    // and then asynchronously send the command.
+    // and then asynchronously send the command. Targeting happens concurrently for all of them.
     for (const auto& shardId : shardIds) {
-        sendAsyncCommandToShard(opCtx, exec, shardId, commandObj, callbackOnCommandResponse);
+        sendAsyncCommandToShard(exec, shardId, commandObj, callbackOnCommandResponse);
         ss << shardId << " ";
     }
 
@@ -30,4 +30,5 @@
 
 namespace mongo {
 MONGO_DEFINE_SHIM(createTransactionCoordinator);
+MONGO_DEFINE_SHIM(releaseUnusedTransactionCoordinator);
 }
@@ -35,4 +35,11 @@
 namespace mongo {
 extern MONGO_DECLARE_SHIM((OperationContext * opCtx, TxnNumber clientTxnNumber)->void)
     createTransactionCoordinator;
+
+/**
+ * Discards the coordinator created for 'clientTxnNumber' on this operation's session, if it was
+ * never used because the transaction committed without two-phase commit.
+ */
+extern MONGO_DECLARE_SHIM((OperationContext * opCtx, TxnNumber clientTxnNumber)->void)
+    releaseUnusedTransactionCoordinator;
 }  // namespace mongo
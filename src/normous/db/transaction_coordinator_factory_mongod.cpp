@@ -44,4 +44,10 @@ MONGO_REGISTER_SHIM(createTransactionCoordinator)
         clientTxnNumber,
         clockSource->now() + Seconds(transactionLifetimeLimitSeconds.load()));
 }
+
+MONGO_REGISTER_SHIM(releaseUnusedTransactionCoordinator)
+(OperationContext* opCtx, TxnNumber clientTxnNumber)->void {
+    TransactionCoordinatorService::get(opCtx)->releaseUnusedCoordinator(
+        opCtx, opCtx->getLogicalSessionId().get(), clientTxnNumber);
+}
 }  // namespace mongo
@@ -113,6 +113,19 @@ void TransactionCoordinatorService::createCoordinator(OperationContext* opCtx,
     // TODO (SERVER-37025): Schedule poke task on executor.
 }
 
+void TransactionCoordinatorService::releaseUnusedCoordinator(OperationContext* opCtx,
+                                                             LogicalSessionId lsid,
+                                                             TxnNumber txnNumber) {
+    auto coordinator = _coordinatorCatalog->get(lsid, txnNumber);
+    if (!coordinator) {
+        return;
+    }
+
+    // An unused coordinator has no participant list, so there are no participants to send abort
+    // to. Reaching the aborted state is enough for the catalog to remove it.
+    coordinator.get()->recvTryAbortIfUnused();
+}
+
 Future<TransactionCoordinatorService::CommitDecision>
 TransactionCoordinatorService::coordinateCommit(OperationContext* opCtx,
                                                 LogicalSessionId lsid,
@@ -69,6 +69,17 @@ public:
                            TxnNumber txnNumber,
                            Date_t commitDeadline);
 
+    /**
+     * Discards the TransactionCoordinator for the given session id and transaction number if it
+     * never received a participant list, which is the case when the transaction committed directly
+     * on this shard without two-phase commit. This removes the coordinator from the catalog right
+     * away, instead of leaving it for the next transaction on the session to abort. Does nothing
+     * if there is no such coordinator or if it has already begun two-phase commit.
+     */
+    void releaseUnusedCoordinator(OperationContext* opCtx,
+                                  LogicalSessionId lsid,
+                                  TxnNumber txnNumber);
+
     /**
      * Delivers coordinateCommit to the TransactionCoordinator, asynchronously sends commit or
      * abort to participants if necessary, and returns a Future that will contain the commit
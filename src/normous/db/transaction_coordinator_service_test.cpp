@@ -308,6 +308,29 @@ TEST_F(TransactionCoordinatorServiceTest,
     commitTransaction(coordinatorService, lsid(), txnNumber() + 1, kTwoShardIdSet);
 }
 
+TEST_F(TransactionCoordinatorServiceTestSingleTxn, ReleaseUnusedCoordinatorRemovesCoordinator) {
+    coordinatorService()->releaseUnusedCoordinator(operationContext(), lsid(), txnNumber());
+
+    // The coordinator is gone, so a participant list arriving now finds nothing to commit.
+    auto commitDecisionFuture = coordinatorService()->coordinateCommit(
+        operationContext(), lsid(), txnNumber(), kTwoShardIdSet);
+    ASSERT_TRUE(commitDecisionFuture.isReady());
+    ASSERT_EQ(static_cast<int>(commitDecisionFuture.get()),
+              static_cast<int>(TransactionCoordinatorService::CommitDecision::kAbort));
+}
+
+TEST_F(TransactionCoordinatorServiceTestSingleTxn,
+       ReleaseUnusedCoordinatorDoesNotAffectCoordinatorWithParticipantList) {
+    auto commitDecisionFuture = coordinatorService()->coordinateCommit(
+        operationContext(), lsid(), txnNumber(), kTwoShardIdSet);
+
+    coordinatorService()->releaseUnusedCoordinator(operationContext(), lsid(), txnNumber());
+    ASSERT_FALSE(commitDecisionFuture.isReady());
+
+    abortTransaction(
+        *coordinatorService(), lsid(), txnNumber(), kTwoShardIdSet, kTwoShardIdList[0]);
+}
+
 TEST_F(TransactionCoordinatorServiceTestSingleTxn,
        CoordinateCommitWithNoVotesReturnsNotReadyFuture) {
 
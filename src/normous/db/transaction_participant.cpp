@@ -540,14 +540,27 @@ TransactionParticipant::OplogSlotReserver::~OplogSlotReserver() {
     }
 }
 
-TransactionParticipant::TxnResources::TxnResources(OperationContext* opCtx, bool keepTicket) {
+TransactionParticipant::TxnResources::TxnResources(OperationContext* opCtx,
+                                                   bool keepTicket,
+                                                   Spares* spares) {
+    // Spare resources carry the settings of the operation they were displaced from, so they are
+    // only reused by that same operation.
+    Spares reused;
+    if (spares) {
+        if (spares->opId == opCtx->getOpID()) {
+            reused = std::move(*spares);
+        }
+        *spares = Spares();
+    }
+
     // We must lock the Client to change the Locker on the OperationContext.
     stdx::lock_guard<Client> lk(*opCtx->getClient());
 
     _ruState = opCtx->getWriteUnitOfWork()->release();
     opCtx->setWriteUnitOfWork(nullptr);
 
-    _locker = opCtx->swapLockState(stdx::make_unique<LockerImpl>());
+    _locker = opCtx->swapLockState(reused.locker ? std::move(reused.locker)
+                                                 : stdx::make_unique<LockerImpl>());
     // Inherit the locking setting from the original one.
     opCtx->lockState()->setShouldConflictWithSecondaryBatchApplication(
         _locker->shouldConflictWithSecondaryBatchApplication());
@@ -559,6 +572,7 @@ TransactionParticipant::TxnResources::TxnResources(OperationContext* opCtx, bool
     // This thread must still respect the transaction lock timeout, since it can prevent the
     // transaction from making progress.
     auto maxTransactionLockMillis = maxTransactionLockRequestTimeoutMillis.load();
+    opCtx->lockState()->unsetMaxLockTimeout();
     if (opCtx->writesAreReplicated() && maxTransactionLockMillis >= 0) {
         opCtx->lockState()->setMaxLockTimeout(Milliseconds(maxTransactionLockMillis));
     }
@@ -567,8 +581,11 @@ TransactionParticipant::TxnResources::TxnResources(OperationContext* opCtx, bool
     invariant(opCtx->writesAreReplicated() || !opCtx->lockState()->hasMaxLockTimeout());
 
     _recoveryUnit = opCtx->releaseRecoveryUnit();
-    opCtx->setRecoveryUnit(std::unique_ptr<RecoveryUnit>(
-                               opCtx->getServiceContext()->getStorageEngine()->newRecoveryUnit()),
+    if (!reused.recoveryUnit) {
+        reused.recoveryUnit.reset(
+            opCtx->getServiceContext()->getStorageEngine()->newRecoveryUnit());
+    }
+    opCtx->setRecoveryUnit(std::move(reused.recoveryUnit),
                            WriteUnitOfWork::RecoveryUnitState::kNotInUnitOfWork);
 
     _readConcernArgs = repl::ReadConcernArgs::get(opCtx);
@@ -585,32 +602,51 @@ TransactionParticipant::TxnResources::~TxnResources() {
     }
 }
 
-void TransactionParticipant::TxnResources::release(OperationContext* opCtx) {
+void TransactionParticipant::TxnResources::release(OperationContext* opCtx, Spares* spares) {
     // Perform operations that can fail the release before marking the TxnResources as released.
     _locker->reacquireTicket(opCtx);
 
     invariant(!_released);
     _released = true;
 
-    // We intentionally do not capture the return value of swapLockState(), which is just an empty
-    // locker. At the end of the operation, if the transaction is not complete, we will stash the
-    // operation context's locker and replace it with a new empty locker.
-
-    // It is necessary to lock the client to change the Locker on the OperationContext.
-    stdx::lock_guard<Client> lk(*opCtx->getClient());
-    invariant(opCtx->lockState()->getClientState() == Locker::ClientState::kInactive);
-    opCtx->swapLockState(std::move(_locker));
-    opCtx->lockState()->updateThreadIdToCurrentThread();
-
-    auto oldState = opCtx->setRecoveryUnit(std::move(_recoveryUnit),
-                                           WriteUnitOfWork::RecoveryUnitState::kNotInUnitOfWork);
-    invariant(oldState == WriteUnitOfWork::RecoveryUnitState::kNotInUnitOfWork,
-              str::stream() << "RecoveryUnit state was " << oldState);
-
-    opCtx->setWriteUnitOfWork(WriteUnitOfWork::createForSnapshotResume(opCtx, _ruState));
+    // The return value of swapLockState() is just an empty locker. At the end of the operation,
+    // if the transaction is not complete, we will stash the operation context's locker and
+    // replace it with this one if it was kept in 'spares', or with a new empty locker otherwise.
+    std::unique_ptr<Locker> displacedLocker;
+    std::unique_ptr<RecoveryUnit> displacedRecoveryUnit;
+    {
+        // It is necessary to lock the client to change the Locker on the OperationContext.
+        stdx::lock_guard<Client> lk(*opCtx->getClient());
+        invariant(opCtx->lockState()->getClientState() == Locker::ClientState::kInactive);
+        displacedLocker = opCtx->swapLockState(std::move(_locker));
+        opCtx->lockState()->updateThreadIdToCurrentThread();
+
+        displacedRecoveryUnit = opCtx->releaseRecoveryUnit();
+        auto oldState = opCtx->setRecoveryUnit(
+            std::move(_recoveryUnit), WriteUnitOfWork::RecoveryUnitState::kNotInUnitOfWork);
+        invariant(oldState == WriteUnitOfWork::RecoveryUnitState::kNotInUnitOfWork,
+                  str::stream() << "RecoveryUnit state was " << oldState);
+
+        opCtx->setWriteUnitOfWork(WriteUnitOfWork::createForSnapshotResume(opCtx, _ruState));
+
+        auto& readConcernArgs = repl::ReadConcernArgs::get(opCtx);
+        readConcernArgs = _readConcernArgs;
+    }
 
-    auto& readConcernArgs = repl::ReadConcernArgs::get(opCtx);
-    readConcernArgs = _readConcernArgs;
+    if (spares) {
+        // Anything the operation read before unstashing must not be visible to whatever uses the
+        // recovery unit next. A recovery unit with timestamp settings is not worth resetting.
+        displacedRecoveryUnit->abandonSnapshot();
+        spares->opId = opCtx->getOpID();
+        if (displacedRecoveryUnit->getTimestampReadSource() == RecoveryUnit::ReadSource::kUnset &&
+            displacedRecoveryUnit->getCommitTimestamp().isNull() &&
+            !displacedRecoveryUnit->getReadOnce()) {
+            spares->recoveryUnit = std::move(displacedRecoveryUnit);
+        }
+        if (!displacedLocker->isLocked()) {
+            spares->locker = std::move(displacedLocker);
+        }
+    }
 }
 
 TransactionParticipant::SideTransactionBlock::SideTransactionBlock(OperationContext* opCtx)
@@ -641,7 +677,11 @@ void TransactionParticipant::_stashActiveTransaction(WithLock, OperationContext*
     }
 
     invariant(!_txnResourceStash);
-    _txnResourceStash = TxnResources(opCtx);
+    auto tickSource = opCtx->getServiceContext()->getTickSource();
+    auto startTicks = tickSource->getTicks();
+    _txnResourceStash = TxnResources(opCtx, false /* keepTicket */, &_spareResources);
+    ServerTransactionsMetrics::get(opCtx)->addStashTime(
+        tickSource->ticksTo<Microseconds>(tickSource->getTicks() - startTicks));
 }
 
 
@@ -696,8 +736,12 @@ void TransactionParticipant::unstashTransactionResources(OperationContext* opCtx
             uassert(ErrorCodes::InvalidOptions,
                     "Only the first command in a transaction may specify a readConcern",
                     readConcernArgs.isEmpty());
-            _txnResourceStash->release(opCtx);
+            auto tickSource = opCtx->getServiceContext()->getTickSource();
+            auto startTicks = tickSource->getTicks();
+            _txnResourceStash->release(opCtx, &_spareResources);
             _txnResourceStash = boost::none;
+            ServerTransactionsMetrics::get(opCtx)->addUnstashTime(
+                tickSource->ticksTo<Microseconds>(tickSource->getTicks() - startTicks));
             stdx::lock_guard<stdx::mutex> lm(_metricsMutex);
             _transactionMetricsObserver.onUnstash(ServerTransactionsMetrics::get(opCtx),
                                                   opCtx->getServiceContext()->getTickSource());
@@ -885,6 +929,9 @@ std::vector<repl::ReplOperation> TransactionParticipant::endTransactionAndRetrie
 }
 
 void TransactionParticipant::commitUnpreparedTransaction(OperationContext* opCtx) {
+    auto tickSource = opCtx->getServiceContext()->getTickSource();
+    auto startTicks = tickSource->getTicks();
+
     stdx::unique_lock<stdx::mutex> lk(_mutex);
     _checkIsActiveTransaction(lk, *opCtx->getTxnNumber(), true);
 
@@ -921,10 +968,15 @@ void TransactionParticipant::commitUnpreparedTransaction(OperationContext* opCtx
               str::stream() << "Current State: " << _txnState);
 
     _finishCommitTransaction(lk, opCtx);
+    ServerTransactionsMetrics::get(opCtx)->addCommitTime(
+        tickSource->ticksTo<Microseconds>(tickSource->getTicks() - startTicks));
 }
 
 void TransactionParticipant::commitPreparedTransaction(OperationContext* opCtx,
                                                        Timestamp commitTimestamp) {
+    auto tickSource = opCtx->getServiceContext()->getTickSource();
+    auto startTicks = tickSource->getTicks();
+
     stdx::unique_lock<stdx::mutex> lk(_mutex);
     _checkIsActiveTransaction(lk, *opCtx->getTxnNumber(), true);
 
@@ -966,6 +1018,8 @@ void TransactionParticipant::commitPreparedTransaction(OperationContext* opCtx,
         _checkIsActiveTransaction(lk, *opCtx->getTxnNumber(), true);
 
         _finishCommitTransaction(lk, opCtx);
+        ServerTransactionsMetrics::get(opCtx)->addCommitTime(
+            tickSource->ticksTo<Microseconds>(tickSource->getTicks() - startTicks));
     } catch (...) {
         // It is illegal for committing a prepared transaction to fail for any reason, other than an
         // invalid command, so we crash instead.
@@ -983,8 +1037,12 @@ void TransactionParticipant::_commitStorageTransaction(OperationContext* opCtx)
 
     // We must clear the recovery unit and locker for the 'config.transactions' and oplog entry
     // writes.
-    opCtx->setRecoveryUnit(std::unique_ptr<RecoveryUnit>(
-                               opCtx->getServiceContext()->getStorageEngine()->newRecoveryUnit()),
+    std::unique_ptr<RecoveryUnit> recoveryUnit;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        recoveryUnit = _takeSpareRecoveryUnit(lk, opCtx);
+    }
+    opCtx->setRecoveryUnit(std::move(recoveryUnit),
                            WriteUnitOfWork::RecoveryUnitState::kNotInUnitOfWork);
 
     opCtx->lockState()->unsetMaxLockTimeout();
@@ -1029,6 +1087,7 @@ void TransactionParticipant::shutdown() {
 
     _inShutdown = true;
     _txnResourceStash = boost::none;
+    _spareResources = TxnResources::Spares();
 }
 
 void TransactionParticipant::abortArbitraryTransaction() {
@@ -1207,6 +1266,7 @@ void TransactionParticipant::_abortTransactionOnSession(WithLock wl) {
                             TransactionState::kAborted,
                             _txnResourceStash->getReadConcernArgs());
         _txnResourceStash = boost::none;
+        _spareResources = TxnResources::Spares();
     } else {
         stdx::lock_guard<stdx::mutex> lm(_metricsMutex);
         _transactionMetricsObserver.onAbortActive(
@@ -1240,13 +1300,24 @@ void TransactionParticipant::_cleanUpTxnResourceOnOpCtx(
 
     // We must clear the recovery unit and locker so any post-transaction writes can run without
     // transactional settings such as a read timestamp.
-    opCtx->setRecoveryUnit(std::unique_ptr<RecoveryUnit>(
-                               opCtx->getServiceContext()->getStorageEngine()->newRecoveryUnit()),
+    opCtx->setRecoveryUnit(_takeSpareRecoveryUnit(wl, opCtx),
                            WriteUnitOfWork::RecoveryUnitState::kNotInUnitOfWork);
 
+    // The transaction is over, so there is no later stash for a spare locker to be used by.
+    _spareResources = TxnResources::Spares();
+
     opCtx->lockState()->unsetMaxLockTimeout();
 }
 
+std::unique_ptr<RecoveryUnit> TransactionParticipant::_takeSpareRecoveryUnit(
+    WithLock, OperationContext* opCtx) {
+    if (_spareResources.recoveryUnit && _spareResources.opId == opCtx->getOpID()) {
+        return std::move(_spareResources.recoveryUnit);
+    }
+    return std::unique_ptr<RecoveryUnit>(
+        opCtx->getServiceContext()->getStorageEngine()->newRecoveryUnit());
+}
+
 void TransactionParticipant::_checkIsActiveTransaction(WithLock wl,
                                                        const TxnNumber& requestTxnNumber,
                                                        bool checkAbort) const {
@@ -75,11 +75,23 @@ public:
      */
     class TxnResources {
     public:
+        /**
+         * The Locker and RecoveryUnit an operation was running with before transaction resources
+         * were released onto it. They are handed back to the same operation when it stashes the
+         * transaction again, which saves allocating a new Locker and RecoveryUnit per statement.
+         */
+        struct Spares {
+            unsigned int opId = 0;
+            std::unique_ptr<Locker> locker;
+            std::unique_ptr<RecoveryUnit> recoveryUnit;
+        };
+
         /**
          * Stashes transaction state from 'opCtx' in the newly constructed TxnResources.
-         * Ephemerally holds the Client lock associated with opCtx.
+         * Ephemerally holds the Client lock associated with opCtx. If 'spares' holds resources
+         * displaced from this same operation, they replace the stashed ones on 'opCtx'.
          */
-        TxnResources(OperationContext* opCtx, bool keepTicket = false);
+        TxnResources(OperationContext* opCtx, bool keepTicket = false, Spares* spares = nullptr);
 
         ~TxnResources();
 
@@ -104,9 +116,10 @@ public:
 
         /**
          * Releases stashed transaction state onto 'opCtx'. Must only be called once.
-         * Ephemerally holds the Client lock associated with opCtx.
+         * Ephemerally holds the Client lock associated with opCtx. If 'spares' is not null, the
+         * Locker and RecoveryUnit displaced from 'opCtx' are kept there.
          */
-        void release(OperationContext* opCtx);
+        void release(OperationContext* opCtx, Spares* spares = nullptr);
 
         /**
          * Returns the read concern arguments.
@@ -694,6 +707,10 @@ private:
                                     OperationContext* opCtx,
                                     TransactionState::StateFlag terminationCause);
 
+    // Returns the RecoveryUnit that 'opCtx' was running with before it unstashed the transaction,
+    // or a new one if it has none spare.
+    std::unique_ptr<RecoveryUnit> _takeSpareRecoveryUnit(WithLock, OperationContext* opCtx);
+
     // Checks if the current transaction number of this transaction still matches with the
     // parent session as well as the transaction number of the current operation context.
     void _checkIsActiveTransaction(WithLock,
@@ -747,6 +764,9 @@ private:
     // Holds transaction resources between network operations.
     boost::optional<TxnResources> _txnResourceStash;
 
+    // The resources displaced by the last unstash, kept for the operation that unstashed.
+    TxnResources::Spares _spareResources;
+
     // Maintains the transaction state and the transition table for legal state transitions.
     TransactionState _txnState;
 
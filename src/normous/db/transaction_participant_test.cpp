@@ -355,6 +355,32 @@ TEST_F(TxnParticipantTest, StashAndUnstashResources) {
     txnParticipant->commitUnpreparedTransaction(opCtx());
 }
 
+TEST_F(TxnParticipantTest, StashReusesResourcesDisplacedByUnstashOnSameOperation) {
+    OperationContextSessionMongod opCtxSession(opCtx(), true, false, true);
+    auto txnParticipant = TransactionParticipant::get(opCtx());
+    txnParticipant->unstashTransactionResources(opCtx(), "insert");
+    txnParticipant->stashTransactionResources(opCtx());
+
+    // These are the resources the operation continues with once the transaction is stashed.
+    Locker* operationLocker = opCtx()->lockState();
+    RecoveryUnit* operationRecoveryUnit = opCtx()->recoveryUnit();
+
+    // Unstashing displaces them, and stashing again hands the same ones back, rather than new
+    // ones.
+    txnParticipant->unstashTransactionResources(opCtx(), "insert");
+    ASSERT_NOT_EQUALS(operationLocker, opCtx()->lockState());
+    ASSERT_NOT_EQUALS(operationRecoveryUnit, opCtx()->recoveryUnit());
+
+    txnParticipant->stashTransactionResources(opCtx());
+    ASSERT_EQUALS(operationLocker, opCtx()->lockState());
+    ASSERT_EQUALS(operationRecoveryUnit, opCtx()->recoveryUnit());
+    ASSERT_FALSE(opCtx()->lockState()->isLocked());
+    ASSERT(!opCtx()->getWriteUnitOfWork());
+
+    txnParticipant->unstashTransactionResources(opCtx(), "commitTransaction");
+    txnParticipant->commitUnpreparedTransaction(opCtx());
+}
+
 TEST_F(TxnParticipantTest, CannotSpecifyStartTransactionOnInProgressTxn) {
     // Must specify startTransaction=true and autocommit=false to start a transaction.
     OperationContextSessionMongod opCtxSession(opCtx(), true, false, true);
@@ -37,6 +37,7 @@
 #include "mongo/base/counter.h"
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/auth/user_name.h"
+#include "mongo/db/bson/dotted_path_support.h"
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/collection_catalog_entry.h"
 #include "mongo/db/catalog/database_catalog_entry.h"
@@ -47,7 +48,7 @@
 #include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/db_raii.h"
-#include "mongo/db/exec/delete.h"
+#include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/ops/insert.h"
@@ -57,17 +58,51 @@
 #include "mongo/db/ttl_collection_cache.h"
 #include "mongo/util/background.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/exit.h"
 #include "mongo/util/log.h"
 
 namespace mongo {
 
+namespace dps = ::mongo::dotted_path_support;
+
+namespace {
+
+/**
+ * Reports the current value of an AtomicInt64 through serverStatus, for TTL metrics that are
+ * gauges rather than counters.
+ */
+class TTLGaugeMetric : public ServerStatusMetric {
+public:
+    TTLGaugeMetric(const std::string& name, const AtomicInt64* value)
+        : ServerStatusMetric(name), _value(value) {}
+
+    void appendAtLeaf(BSONObjBuilder& b) const override {
+        b.appendNumber(_leafName, _value->load());
+    }
+
+private:
+    const AtomicInt64* const _value;
+};
+
+}  // namespace
+
 Counter64 ttlPasses;
 Counter64 ttlDeletedDocuments;
+Counter64 ttlDeleteBatches;
+Counter64 ttlThrottledMillis;
+AtomicInt64 ttlLagSecs;
+AtomicInt64 ttlLastPassMillis;
 
 ServerStatusMetricField<Counter64> ttlPassesDisplay("ttl.passes", &ttlPasses);
 ServerStatusMetricField<Counter64> ttlDeletedDocumentsDisplay("ttl.deletedDocuments",
                                                               &ttlDeletedDocuments);
+ServerStatusMetricField<Counter64> ttlDeleteBatchesDisplay("ttl.deleteBatches", &ttlDeleteBatches);
+ServerStatusMetricField<Counter64> ttlThrottledMillisDisplay("ttl.throttledMillis",
+                                                             &ttlThrottledMillis);
+// How far, in seconds, the oldest expired document found by the last pass was past its expiry.
+TTLGaugeMetric ttlLagSecsDisplay("ttl.lagSecs", &ttlLagSecs);
+TTLGaugeMetric ttlLastPassMillisDisplay("ttl.lastPassMillis", &ttlLastPassMillis);
 
 MONGO_EXPORT_SERVER_PARAMETER(ttlMonitorEnabled, bool, true);
 MONGO_EXPORT_SERVER_PARAMETER(ttlMonitorSleepSecs, int, 60)
@@ -77,6 +112,46 @@ MONGO_EXPORT_SERVER_PARAMETER(ttlMonitorSleepSecs, int, 60)
         return Status::OK();
     });  // used for testing
 
+// The number of expired documents deleted in each write unit of work.
+MONGO_EXPORT_SERVER_PARAMETER(ttlMonitorDeletesPerWriteUnitOfWork, int, 100)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 1 || newVal > 1000) {
+            return Status(ErrorCodes::BadValue,
+                          "ttlMonitorDeletesPerWriteUnitOfWork must be between 1 and 1000");
+        }
+        return Status::OK();
+    });
+
+// The number of collections whose expired documents are deleted concurrently by a TTL pass.
+MONGO_EXPORT_SERVER_PARAMETER(ttlMonitorMaxConcurrency, int, 4)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 1 || newVal > 64) {
+            return Status(ErrorCodes::BadValue,
+                          "ttlMonitorMaxConcurrency must be between 1 and 64");
+        }
+        return Status::OK();
+    });
+
+// Deleting is paused between batches while the majority commit point trails this node's last
+// applied optime by more than this many seconds. Zero disables the check.
+MONGO_EXPORT_SERVER_PARAMETER(ttlMonitorMaxMajorityLagSecs, int, 10)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0) {
+            return Status(ErrorCodes::BadValue, "ttlMonitorMaxMajorityLagSecs must be >= 0");
+        }
+        return Status::OK();
+    });
+
+// How long deleting is paused for when the storage engine cache is under pressure or replication
+// is lagging.
+MONGO_EXPORT_SERVER_PARAMETER(ttlMonitorThrottleMillis, int, 100)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0) {
+            return Status(ErrorCodes::BadValue, "ttlMonitorThrottleMillis must be >= 0");
+        }
+        return Status::OK();
+    });
+
 class TTLMonitor : public BackgroundJob {
 public:
     TTLMonitor() {}
@@ -125,6 +200,7 @@ private:
     void doTTLPass() {
         const ServiceContext::UniqueOperationContext opCtxPtr = cc().makeOperationContext();
         OperationContext& opCtx = *opCtxPtr;
+        opCtx.lockState()->setPriorityTicketAdmission(true);
 
         // If part of replSet but not in a readable state (e.g. during initial sync), skip.
         if (repl::ReplicationCoordinator::get(&opCtx)->getReplicationMode() ==
@@ -134,9 +210,10 @@ private:
 
         TTLCollectionCache& ttlCollectionCache = TTLCollectionCache::get(getGlobalServiceContext());
         std::vector<std::string> ttlCollections = ttlCollectionCache.getCollections();
-        std::vector<BSONObj> ttlIndexes;
+        std::vector<std::vector<BSONObj>> ttlIndexesByCollection;
 
         ttlPasses.increment();
+        const Date_t passStart = Date_t::now();
 
         // Get all TTL indexes from every collection.
         for (const std::string& collectionNS : ttlCollections) {
@@ -152,45 +229,156 @@ private:
             CollectionCatalogEntry* collEntry = coll->getCatalogEntry();
             std::vector<std::string> indexNames;
             collEntry->getAllIndexes(&opCtx, &indexNames);
+            std::vector<BSONObj> ttlIndexes;
             for (const std::string& name : indexNames) {
                 BSONObj spec = collEntry->getIndexSpec(&opCtx, name);
                 if (spec.hasField(secondsExpireField)) {
                     ttlIndexes.push_back(spec.getOwned());
                 }
             }
+            if (!ttlIndexes.empty()) {
+                ttlIndexesByCollection.push_back(std::move(ttlIndexes));
+            }
+        }
+
+        // Each collection is processed by a single thread, so that concurrent deletes never
+        // conflict with each other, while different collections are processed in parallel.
+        std::vector<long long> lagSecsByCollection(ttlIndexesByCollection.size(), 0);
+        const size_t concurrency = std::min(static_cast<size_t>(ttlMonitorMaxConcurrency.load()),
+                                            ttlIndexesByCollection.size());
+        if (concurrency <= 1) {
+            for (size_t i = 0; i < ttlIndexesByCollection.size(); ++i) {
+                lagSecsByCollection[i] = doTTLForCollection(&opCtx, ttlIndexesByCollection[i]);
+            }
+        } else {
+            ThreadPool::Options options;
+            options.poolName = "TTLMonitorPool";
+            options.threadNamePrefix = "TTLMonitorWorker-";
+            options.maxThreads = concurrency;
+            options.onCreateThread = [](const std::string& threadName) {
+                Client::initThread(threadName.c_str());
+                AuthorizationSession::get(cc())->grantInternalAuthorization();
+            };
+            ThreadPool pool(options);
+            pool.startup();
+            for (size_t i = 0; i < ttlIndexesByCollection.size(); ++i) {
+                Status scheduleStatus = pool.schedule([&, i] {
+                    const auto workerOpCtx = cc().makeOperationContext();
+                    workerOpCtx->lockState()->setPriorityTicketAdmission(true);
+                    lagSecsByCollection[i] =
+                        doTTLForCollection(workerOpCtx.get(), ttlIndexesByCollection[i]);
+                });
+                if (!scheduleStatus.isOK()) {
+                    error() << "Unable to schedule ttl job for collection: "
+                            << redact(scheduleStatus);
+                }
+            }
+            pool.shutdown();
+            pool.join();
         }
 
+        ttlLagSecs.store(lagSecsByCollection.empty() ? 0 : *std::max_element(
+                                                               lagSecsByCollection.begin(),
+                                                               lagSecsByCollection.end()));
+        ttlLastPassMillis.store(durationCount<Milliseconds>(Date_t::now() - passStart));
+    }
+
+    /**
+     * Processes the TTL indexes of a single collection in turn. Returns the largest number of
+     * seconds any of them found its oldest expired document to be past its expiry.
+     */
+    long long doTTLForCollection(OperationContext* opCtx, const std::vector<BSONObj>& ttlIndexes) {
+        long long lagSecs = 0;
         for (const BSONObj& idx : ttlIndexes) {
             try {
-                doTTLForIndex(&opCtx, idx);
+                lagSecs = std::max(lagSecs, doTTLForIndex(opCtx, idx));
             } catch (const DBException& dbex) {
                 error() << "Error processing ttl index: " << idx << " -- " << dbex.toString();
                 // Continue on to the next index.
                 continue;
             }
         }
+        return lagSecs;
+    }
+
+    /**
+     * Returns true if deletes should be paused, because the storage engine cache is under pressure
+     * or the majority commit point is lagging too far behind.
+     */
+    bool shouldThrottle(OperationContext* opCtx) {
+        auto storageEngine = opCtx->getServiceContext()->getStorageEngine();
+        if (storageEngine->isCacheUnderPressure(opCtx)) {
+            LOG(2) << "throttling ttl deletes because the storage engine cache is under pressure";
+            return true;
+        }
+
+        const int maxMajorityLagSecs = ttlMonitorMaxMajorityLagSecs.load();
+        auto replCoord = repl::ReplicationCoordinator::get(opCtx);
+        if (maxMajorityLagSecs == 0 ||
+            replCoord->getReplicationMode() != repl::ReplicationCoordinator::modeReplSet) {
+            return false;
+        }
+
+        const Timestamp lastCommitted = replCoord->getLastCommittedOpTime().getTimestamp();
+        const Timestamp lastApplied = replCoord->getMyLastAppliedOpTime().getTimestamp();
+        if (lastCommitted.isNull() || lastApplied <= lastCommitted) {
+            return false;
+        }
+        const long long majorityLagSecs =
+            static_cast<long long>(lastApplied.getSecs()) - lastCommitted.getSecs();
+        if (majorityLagSecs > maxMajorityLagSecs) {
+            LOG(2) << "throttling ttl deletes because the majority commit point is "
+                   << majorityLagSecs << " seconds behind";
+            return true;
+        }
+        return false;
     }
 
     /**
      * Remove documents from the collection using the specified TTL index after a sufficient amount
-     * of time has passed according to its expiry specification.
+     * of time has passed according to its expiry specification. The documents are deleted in
+     * batches, and the locks are released to pause between batches when the server is under
+     * pressure. Returns how many seconds the oldest expired document was past its expiry.
+     */
+    long long doTTLForIndex(OperationContext* opCtx, const BSONObj& idx) {
+        long long numDeleted = 0;
+        boost::optional<long long> lagSecs;
+        while (!deleteExpiredDocuments(opCtx, idx, &numDeleted, &lagSecs)) {
+            const Milliseconds throttle(ttlMonitorThrottleMillis.load());
+            opCtx->sleepFor(throttle);
+            ttlThrottledMillis.increment(durationCount<Milliseconds>(throttle));
+        }
+
+        LOG(1) << "deleted: " << numDeleted;
+        return lagSecs.value_or(0);
+    }
+
+    /**
+     * Deletes the documents expired according to 'idx' in batches of
+     * 'ttlMonitorDeletesPerWriteUnitOfWork', adding the number deleted to 'numDeleted'. Sets
+     * 'lagSecs' from the first expired document found, if it isn't set yet. Returns false if
+     * deleting stopped early because it should be throttled, and true once there is nothing left
+     * to delete for now.
      */
-    void doTTLForIndex(OperationContext* opCtx, BSONObj idx) {
+    bool deleteExpiredDocuments(OperationContext* opCtx,
+                                BSONObj idx,
+                                long long* numDeleted,
+                                boost::optional<long long>* lagSecs) {
         const NamespaceString collectionNSS(idx["ns"].String());
         if (collectionNSS.isDropPendingNamespace()) {
-            return;
+            return true;
         }
         if (!userAllowedWriteNS(collectionNSS).isOK()) {
             error() << "namespace '" << collectionNSS
                     << "' doesn't allow deletes, skipping ttl job for: " << idx;
-            return;
+            return true;
         }
 
         const BSONObj key = idx["key"].Obj();
         const StringData name = idx["name"].valueStringData();
         if (key.nFields() != 1) {
             error() << "key for ttl index can only have 1 field, skipping ttl job for: " << idx;
-            return;
+            return true;
         }
 
         LOG(1) << "ns: " << collectionNSS << " key: " << key << " name: " << name;
@@ -199,18 +387,18 @@ private:
         Collection* collection = autoGetCollection.getCollection();
         if (!collection) {
             // Collection was dropped.
-            return;
+            return true;
         }
 
         if (!repl::ReplicationCoordinator::get(opCtx)->canAcceptWritesFor(opCtx, collectionNSS)) {
-            return;
+            return true;
         }
 
         IndexDescriptor* desc = collection->getIndexCatalog()->findIndexByName(opCtx, name);
         if (!desc) {
             LOG(1) << "index not found (index build in progress? index dropped?), skipping "
                    << "ttl job for: " << idx;
-            return;
+            return true;
         }
 
         // Re-read 'idx' from the descriptor, in case the collection or index definition changed
@@ -219,7 +407,7 @@ private:
 
         if (IndexType::INDEX_BTREE != IndexNames::nameToType(desc->getAccessMethodName())) {
             error() << "special index can't be used as a ttl index, skipping ttl job for: " << idx;
-            return;
+            return true;
         }
 
         BSONElement secondsExpireElt = idx[secondsExpireField];
@@ -227,7 +415,7 @@ private:
             error() << "ttl indexes require the " << secondsExpireField << " field to be "
                     << "numeric but received a type of " << typeName(secondsExpireElt.type())
                     << ", skipping ttl job for: " << idx;
-            return;
+            return true;
         }
 
         const Date_t kDawnOfTime =
@@ -241,9 +429,9 @@ private:
             ? InternalPlanner::Direction::FORWARD
             : InternalPlanner::Direction::BACKWARD;
 
-        // We need to pass into the DeleteStageParams (below) a CanonicalQuery with a BSONObj that
-        // queries for the expired documents correctly so that we do not delete documents that are
-        // not actually expired when our snapshot changes during deletion.
+        // We need a MatchExpression that queries for the expired documents correctly so that we
+        // do not delete documents that are not actually expired when our snapshot changes between
+        // reading a batch and deleting it.
         const char* keyFieldName = key.firstElement().fieldName();
         BSONObj query =
             BSON(keyFieldName << BSON("$gte" << kDawnOfTime << "$lte" << expirationTime));
@@ -251,32 +439,96 @@ private:
         qr->setFilter(query);
         auto canonicalQuery = CanonicalQuery::canonicalize(opCtx, std::move(qr));
         invariant(canonicalQuery.getStatus());
+        const MatchExpression* expired = canonicalQuery.getValue()->root();
+
+        auto exec = InternalPlanner::indexScan(opCtx,
+                                               collection,
+                                               desc,
+                                               startKey,
+                                               endKey,
+                                               BoundInclusion::kIncludeBothStartAndEndKeys,
+                                               PlanExecutor::YIELD_AUTO,
+                                               direction,
+                                               InternalPlanner::IXSCAN_FETCH);
+
+        const int deletesPerWriteUnitOfWork = ttlMonitorDeletesPerWriteUnitOfWork.load();
+        while (true) {
+            opCtx->checkForInterrupt();
+
+            // Collect the next batch of expired documents, which will be deleted in a single write
+            // unit of work.
+            std::vector<RecordId> toDelete;
+            toDelete.reserve(deletesPerWriteUnitOfWork);
+            bool exhausted = false;
+            while (static_cast<int>(toDelete.size()) < deletesPerWriteUnitOfWork) {
+                RecordId rloc;
+                BSONObj obj;
+                PlanExecutor::ExecState state = exec->getNext(&obj, &rloc);
+                if (state == PlanExecutor::IS_EOF) {
+                    exhausted = true;
+                    break;
+                }
+                if (state == PlanExecutor::FAILURE || state == PlanExecutor::DEAD) {
+                    error() << "ttl query execution for index " << idx
+                            << " failed with status: "
+                            << redact(WorkingSetCommon::toStatusString(obj));
+                    return true;
+                }
+                invariant(PlanExecutor::ADVANCED == state);
+
+                if (!*lagSecs) {
+                    const BSONElement keyElt = dps::extractElementAtPath(obj, keyFieldName);
+                    if (keyElt.type() == BSONType::Date) {
+                        *lagSecs = std::max(
+                            0LL, durationCount<Seconds>(expirationTime - keyElt.date()));
+                    }
+                }
+                toDelete.push_back(rloc);
+            }
 
-        DeleteStageParams params;
-        params.isMulti = true;
-        params.canonicalQuery = canonicalQuery.getValue().get();
-
-        auto exec =
-            InternalPlanner::deleteWithIndexScan(opCtx,
-                                                 collection,
-                                                 params,
-                                                 desc,
-                                                 startKey,
-                                                 endKey,
-                                                 BoundInclusion::kIncludeBothStartAndEndKeys,
-                                                 PlanExecutor::YIELD_AUTO,
-                                                 direction);
-
-        Status result = exec->executePlan();
-        if (!result.isOK()) {
-            error() << "ttl query execution for index " << idx
-                    << " failed with status: " << redact(result);
-            return;
-        }
+            if (toDelete.empty()) {
+                return true;
+            }
 
-        const long long numDeleted = DeleteStage::getNumDeleted(*exec);
-        ttlDeletedDocuments.increment(numDeleted);
-        LOG(1) << "deleted: " << numDeleted;
+            exec->saveState();
+            long long numDeletedInBatch = 0;
+            writeConflictRetry(opCtx, "ttl delete", collectionNSS.ns(), [&] {
+                numDeletedInBatch = 0;
+                WriteUnitOfWork wuow(opCtx);
+                for (const auto& rloc : toDelete) {
+                    // Documents read by an earlier snapshot may since have been deleted or
+                    // updated so that they are no longer expired.
+                    Snapshotted<BSONObj> doc;
+                    if (!collection->findDoc(opCtx, rloc, &doc) ||
+                        !expired->matchesBSON(doc.value())) {
+                        continue;
+                    }
+                    collection->deleteDocument(opCtx, kUninitializedStmtId, rloc, nullptr);
+                    ++numDeletedInBatch;
+                }
+                wuow.commit();
+            });
+
+            *numDeleted += numDeletedInBatch;
+            ttlDeletedDocuments.increment(numDeletedInBatch);
+            ttlDeleteBatches.increment();
+
+            if (exhausted) {
+                return true;
+            }
+
+            // Release the locks before pausing, so that the pause doesn't hold up other operations.
+            if (shouldThrottle(opCtx)) {
+                return false;
+            }
+
+            auto restoreStateStatus = exec->restoreState();
+            if (!restoreStateStatus.isOK()) {
+                error() << "error restoring cursor state for ttl index " << idx << ": "
+                        << redact(restoreStateStatus);
+                return true;
+            }
+        }
     }
 };
 
@@ -186,6 +186,45 @@ void UpdateDriver::parse(
     auto root = stdx::make_unique<UpdateObjectNode>();
     _positional = parseUpdateExpression(updateExpr, root.get(), _expCtx, arrayFilters);
     _root = std::move(root);
+
+    if (!_positional) {
+        analyzeSimpleMods(updateExpr);
+    }
+}
+
+void UpdateDriver::analyzeSimpleMods(const BSONObj& updateExpr) {
+    BSONObj ownedUpdateExpr = updateExpr.getOwned();
+    std::vector<SimpleMod> mods;
+    for (auto&& modifier : ownedUpdateExpr) {
+        const auto modifierName = modifier.fieldNameStringData();
+        if (modifierName == LogBuilder::kUpdateSemanticsFieldName) {
+            continue;
+        }
+
+        const bool isInc = (modifierName == "$inc"_sd);
+        if (!isInc && modifierName != "$set"_sd) {
+            return;
+        }
+        for (auto&& value : modifier.embeddedObject()) {
+            const auto fieldName = value.fieldNameStringData();
+            // Dotted and positional paths, _id, and values which need storage validation go
+            // through the UpdateNode tree.
+            if (fieldName.empty() || fieldName[0] == '$' ||
+                fieldName.find('.') != std::string::npos ||
+                fieldName == "_id"_sd || value.type() == BSONType::Object ||
+                value.type() == BSONType::Array) {
+                return;
+            }
+            mods.push_back({isInc, value});
+        }
+    }
+
+    // Parsing rejected conflicting paths, so every field name is distinct.
+    std::sort(mods.begin(), mods.end(), [](const SimpleMod& lhs, const SimpleMod& rhs) {
+        return lhs.value.fieldNameStringData() < rhs.value.fieldNameStringData();
+    });
+    _simpleMods = std::move(mods);
+    _simpleUpdateExpr = std::move(ownedUpdateExpr);
 }
 
 Status UpdateDriver::populateDocumentWithQueryFields(OperationContext* opCtx,
@@ -247,6 +286,7 @@ Status UpdateDriver::update(StringData matchedField,
     // TODO: assert that update() is called at most once in a !_multi case.
 
     _affectIndices = (isDocReplacement() && (_indexedFields != NULL));
+    _modifiedIndexedPaths.clear();
 
     _logDoc.reset();
     LogBuilder logBuilder(_logDoc.root());
@@ -257,6 +297,9 @@ Status UpdateDriver::update(StringData matchedField,
     applyParams.fromOplogApplication = _fromOplogApplication;
     applyParams.validateForStorage = validateForStorage;
     applyParams.indexData = _indexedFields;
+    if (!isDocReplacement()) {
+        applyParams.modifiedIndexedPaths = &_modifiedIndexedPaths;
+    }
     if (_logOp && logOpRec) {
         applyParams.logBuilder = &logBuilder;
     }
@@ -288,6 +331,154 @@ Status UpdateDriver::update(StringData matchedField,
     return Status::OK();
 }
 
+bool UpdateDriver::updateSimple(const BSONObj& original,
+                                const FieldRefSet& immutablePaths,
+                                BSONObj* newObj,
+                                mutablebson::DamageVector* damages,
+                                BSONObj* logOpRec,
+                                bool* docWasModified) {
+    if (_simpleMods.empty() || _insert ||
+        original.firstElement().fieldNameStringData() != "_id"_sd) {
+        return false;
+    }
+    for (auto&& immutablePath : immutablePaths) {
+        for (auto&& mod : _simpleMods) {
+            if (immutablePath->getPart(0) == mod.value.fieldNameStringData()) {
+                return false;
+            }
+        }
+    }
+
+    auto findMod = [&](StringData fieldName) -> int {
+        auto it = std::lower_bound(_simpleMods.begin(),
+                                   _simpleMods.end(),
+                                   fieldName,
+                                   [](const SimpleMod& mod, StringData name) {
+                                       return mod.value.fieldNameStringData() < name;
+                                   });
+        return (it != _simpleMods.end() && it->value.fieldNameStringData() == fieldName)
+            ? it - _simpleMods.begin()
+            : -1;
+    };
+
+    // Compute the new value of each modified field, leaving it empty for a no-op. Like
+    // mutablebson, only the first of several fields with the same name is modified.
+    std::vector<BSONObj> newValues(_simpleMods.size());
+    std::vector<const char*> existing(_simpleMods.size(), nullptr);
+    for (auto&& elem : original) {
+        const int modIdx = findMod(elem.fieldNameStringData());
+        if (modIdx < 0 || existing[modIdx]) {
+            continue;
+        }
+        existing[modIdx] = elem.rawdata();
+
+        const auto& mod = _simpleMods[modIdx];
+        if (!mod.isInc) {
+            if (!elem.binaryEqualValues(mod.value)) {
+                newValues[modIdx] = mod.value.wrap();
+            }
+            continue;
+        }
+
+        if (!elem.isNumber()) {
+            return false;
+        }
+        const SafeNum originalValue(elem);
+        const SafeNum valueToSet = SafeNum(mod.value) + originalValue;
+        if (valueToSet.isIdentical(originalValue)) {
+            continue;
+        }
+        if (!valueToSet.isValid()) {
+            return false;
+        }
+        BSONObjBuilder valueBuilder;
+        valueToSet.toBSON(elem.fieldNameStringData(), &valueBuilder);
+        newValues[modIdx] = valueBuilder.obj();
+    }
+    bool createsFields = false;
+    for (size_t i = 0; i < _simpleMods.size(); ++i) {
+        if (!existing[i]) {
+            newValues[i] = _simpleMods[i].value.wrap();
+            createsFields = true;
+        }
+    }
+
+    _affectIndices = false;
+    _modifiedIndexedPaths.clear();
+    bool modified = false;
+    bool sameLayout = !createsFields;
+    for (size_t i = 0; i < _simpleMods.size(); ++i) {
+        if (newValues[i].isEmpty()) {
+            continue;
+        }
+        modified = true;
+        if (existing[i] && BSONElement(existing[i]).size() != newValues[i].firstElement().size()) {
+            sameLayout = false;
+        }
+        FieldRef path(_simpleMods[i].value.fieldNameStringData());
+        if (_indexedFields && _indexedFields->mightBeIndexed(path)) {
+            _affectIndices = true;
+            _modifiedIndexedPaths.push_back(std::move(path));
+        }
+    }
+
+    if (docWasModified) {
+        *docWasModified = modified;
+    }
+    if (!modified) {
+        *newObj = original;
+        return true;
+    }
+
+    BSONObjBuilder newBuilder(original.objsize() + 64);
+    std::vector<size_t> newOffsets(_simpleMods.size());
+    for (auto&& elem : original) {
+        const int modIdx = findMod(elem.fieldNameStringData());
+        if (modIdx >= 0 && existing[modIdx] == elem.rawdata() && !newValues[modIdx].isEmpty()) {
+            newOffsets[modIdx] = newBuilder.len();
+            newBuilder.append(newValues[modIdx].firstElement());
+        } else {
+            newBuilder.append(elem);
+        }
+    }
+    for (size_t i = 0; i < _simpleMods.size(); ++i) {
+        if (!existing[i]) {
+            newBuilder.append(newValues[i].firstElement());
+        }
+    }
+    *newObj = newBuilder.obj();
+
+    if (damages) {
+        damages->clear();
+        for (size_t i = 0; sameLayout && i < _simpleMods.size(); ++i) {
+            if (!newValues[i].isEmpty()) {
+                const auto targetOffset = existing[i] - original.objdata();
+                damages->push_back({static_cast<mutablebson::DamageEvent::OffsetSizeType>(
+                                        newOffsets[i]),
+                                    static_cast<mutablebson::DamageEvent::OffsetSizeType>(
+                                        targetOffset),
+                                    static_cast<size_t>(newValues[i].firstElement().size())});
+            }
+        }
+    }
+
+    if (_logOp && logOpRec) {
+        BSONObjBuilder logBuilder;
+        logBuilder.append(LogBuilder::kUpdateSemanticsFieldName,
+                          static_cast<int>(UpdateSemantics::kUpdateNode));
+        BSONObjBuilder setBuilder(logBuilder.subobjStart("$set"));
+        for (auto&& newValue : newValues) {
+            if (!newValue.isEmpty()) {
+                setBuilder.append(newValue.firstElement());
+            }
+        }
+        setBuilder.doneFast();
+        *logOpRec = logBuilder.obj();
+    }
+
+    return true;
+}
+
 bool UpdateDriver::isDocReplacement() const {
     return _replacementMode;
 }
@@ -296,6 +487,10 @@ bool UpdateDriver::modsAffectIndices() const {
     return _affectIndices;
 }
 
+const std::vector<FieldRef>* UpdateDriver::getModifiedIndexedPaths() const {
+    return isDocReplacement() ? nullptr : &_modifiedIndexedPaths;
+}
+
 void UpdateDriver::refreshIndexKeys(const UpdateIndexData* indexedFields) {
     _indexedFields = indexedFields;
 }
@@ -101,6 +101,24 @@ public:
                   BSONObj* logOpRec = nullptr,
                   bool* docWasModified = nullptr);
 
+    /**
+     * Applies the update to 'original' by copying it into a new BSONObj, without building a
+     * mutablebson::Document, if the update only $sets or $incs top-level fields other than _id to
+     * non-container values, and 'original' starts with its _id. Returns false, having changed
+     * nothing, if the update must be applied through update() instead, which includes every case
+     * in which update() would fail.
+     *
+     * Otherwise returns true and fills in 'newObj', 'docWasModified', and 'logOpRec' the way
+     * update() would. If the new document has the layout of 'original', 'damages' receives the
+     * damage events which turn 'original' into it, using 'newObj' as the source buffer.
+     */
+    bool updateSimple(const BSONObj& original,
+                      const FieldRefSet& immutablePaths,
+                      BSONObj* newObj,
+                      mutablebson::DamageVector* damages,
+                      BSONObj* logOpRec,
+                      bool* docWasModified);
+
     //
     // Accessors
     //
@@ -109,6 +127,14 @@ public:
     static bool isDocReplacement(const BSONObj& updateExpr);
 
     bool modsAffectIndices() const;
+
+    /**
+     * Returns the paths, possibly indexed, which the last update() or updateSimple() modified, or
+     * nullptr for a replacement, which may modify any path. Only indexes on one of these paths
+     * can have different keys for the updated document.
+     */
+    const std::vector<FieldRef>* getModifiedIndexedPaths() const;
+
     void refreshIndexKeys(const UpdateIndexData* indexedFields);
 
     bool logOp() const;
@@ -144,6 +170,19 @@ private:
     /** Create the modifier and add it to the back of the modifiers vector */
     inline Status addAndParse(const modifiertable::ModifierType type, const BSONElement& elem);
 
+    /**
+     * Fills '_simpleMods' from the parsed update expression 'updateExpr' if updateSimple() can
+     * apply it.
+     */
+    void analyzeSimpleMods(const BSONObj& updateExpr);
+
+    // A $set or $inc of a top-level field, which updateSimple() can apply.
+    struct SimpleMod {
+        bool isInc;
+        // The operand, named after the field it modifies. Points into '_simpleUpdateExpr'.
+        BSONElement value;
+    };
+
     //
     // immutable properties after parsing
     //
@@ -155,6 +194,11 @@ private:
     // The root of the UpdateNode tree.
     std::unique_ptr<UpdateNode> _root;
 
+    // The modifications updateSimple() applies, sorted by field name, or empty if it cannot apply
+    // this update.
+    std::vector<SimpleMod> _simpleMods;
+    BSONObj _simpleUpdateExpr;
+
     // What are the list of fields in the collection over which the update is going to be
     // applied that participate in indices?
     //
@@ -177,6 +221,9 @@ private:
     // at each call to update.
     bool _affectIndices = false;
 
+    // The modified paths which participate in some index. Is set anew at each call to update.
+    std::vector<FieldRef> _modifiedIndexedPaths;
+
     // Do any of the mods require positional match details when calling 'prepare'?
     bool _positional = false;
 
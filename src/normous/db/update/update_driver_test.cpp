@@ -29,6 +29,7 @@
 #include "mongo/db/update/update_driver.h"
 
 
+#include <algorithm>
 #include <map>
 
 #include "mongo/base/owned_pointer_vector.h"
@@ -162,6 +163,162 @@ TEST(Collator, SetCollationUpdatesModifierInterfaces) {
     ASSERT_TRUE(modified);
 }
 
+/**
+ * Applies 'updateExpr' to 'original' both through UpdateDriver::update() and through
+ * UpdateDriver::updateSimple(), and asserts that the second one applied and agreed with the first.
+ */
+void assertSimpleUpdateMatches(const char* updateExpr, const char* original) {
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    UpdateDriver driver(expCtx);
+    std::map<StringData, std::unique_ptr<ExpressionWithPlaceholder>> arrayFilters;
+    driver.parse(fromjson(updateExpr), arrayFilters);
+    driver.setLogOp(true);
+
+    const FieldRefSet immutablePaths;
+    const BSONObj originalObj = fromjson(original);
+    mutablebson::Document doc(originalObj);
+    BSONObj expectedLog;
+    bool expectedModified = false;
+    ASSERT_OK(driver.update(
+        StringData(), &doc, true, immutablePaths, &expectedLog, &expectedModified));
+
+    BSONObj newObj;
+    mutablebson::DamageVector damages;
+    BSONObj log;
+    bool modified = false;
+    ASSERT_TRUE(
+        driver.updateSimple(originalObj, immutablePaths, &newObj, &damages, &log, &modified));
+    ASSERT_EQ(expectedModified, modified);
+    ASSERT_TRUE(doc.getObject().binaryEqual(newObj)) << doc.getObject() << " != " << newObj;
+    if (modified) {
+        ASSERT_TRUE(expectedLog.binaryEqual(log)) << expectedLog << " != " << log;
+    }
+
+    // Damage events, when there are any, must turn the original document into the new one.
+    if (!damages.empty()) {
+        std::string patched(originalObj.objdata(), originalObj.objsize());
+        for (auto&& damage : damages) {
+            patched.replace(damage.targetOffset,
+                            damage.size,
+                            newObj.objdata() + damage.sourceOffset,
+                            damage.size);
+        }
+        ASSERT_EQ(patched, std::string(newObj.objdata(), newObj.objsize()));
+    }
+}
+
+TEST(UpdateSimple, MatchesUpdateNodeTree) {
+    assertSimpleUpdateMatches("{$set: {a: 2}}", "{_id: 0, a: 1, b: 1}");
+    assertSimpleUpdateMatches("{$set: {a: 'longer string'}}", "{_id: 0, a: 1, b: 1}");
+    assertSimpleUpdateMatches("{$set: {a: 1}}", "{_id: 0, a: 1, b: 1}");
+    assertSimpleUpdateMatches("{$set: {a: NumberLong(1)}}", "{_id: 0, a: 1}");
+    assertSimpleUpdateMatches("{$set: {z: 1, c: 2}}", "{_id: 0, a: 1}");
+    assertSimpleUpdateMatches("{$inc: {a: 1}}", "{_id: 0, a: 1, b: 1}");
+    assertSimpleUpdateMatches("{$inc: {a: 0}}", "{_id: 0, a: 1}");
+    assertSimpleUpdateMatches("{$inc: {a: 1.5}}", "{_id: 0, a: 1}");
+    assertSimpleUpdateMatches("{$inc: {a: 2147483647}}", "{_id: 0, a: 1}");
+    assertSimpleUpdateMatches("{$inc: {c: 1}}", "{_id: 0, a: 1}");
+    assertSimpleUpdateMatches("{$set: {b: 'x'}, $inc: {a: 1, d: 1}}", "{_id: 0, a: 1, b: 'y'}");
+}
+
+TEST(UpdateSimple, FallsBackToUpdateNodeTree) {
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    std::map<StringData, std::unique_ptr<ExpressionWithPlaceholder>> arrayFilters;
+    auto appliesSimply = [&](const char* updateExpr, const char* original) {
+        UpdateDriver driver(expCtx);
+        driver.parse(fromjson(updateExpr), arrayFilters);
+        BSONObj newObj;
+        bool modified = false;
+        return driver.updateSimple(
+            fromjson(original), FieldRefSet(), &newObj, nullptr, nullptr, &modified);
+    };
+
+    ASSERT_TRUE(appliesSimply("{$set: {a: 1}}", "{_id: 0}"));
+    ASSERT_FALSE(appliesSimply("{$set: {'a.b': 1}}", "{_id: 0}"));
+    ASSERT_FALSE(appliesSimply("{$set: {a: {b: 1}}}", "{_id: 0}"));
+    ASSERT_FALSE(appliesSimply("{$set: {_id: 1}}", "{_id: 0}"));
+    ASSERT_FALSE(appliesSimply("{$push: {a: 1}}", "{_id: 0}"));
+    ASSERT_FALSE(appliesSimply("{$inc: {a: 1}}", "{_id: 0, a: 'string'}"));
+    ASSERT_FALSE(appliesSimply("{$set: {a: 1}}", "{a: 0, _id: 0}"));
+}
+
+/**
+ * Applies 'updateExpr' to 'original' with the indexed paths 'indexData', and returns the modified
+ * paths reported by the driver, or boost::none if it reported that any path may be modified.
+ */
+boost::optional<std::vector<std::string>> getModifiedIndexedPaths(const UpdateIndexData& indexData,
+                                                                  const char* updateExpr,
+                                                                  const char* original,
+                                                                  bool simple) {
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    UpdateDriver driver(expCtx);
+    std::map<StringData, std::unique_ptr<ExpressionWithPlaceholder>> arrayFilters;
+    driver.parse(fromjson(updateExpr), arrayFilters);
+    driver.refreshIndexKeys(&indexData);
+
+    const FieldRefSet immutablePaths;
+    const BSONObj originalObj = fromjson(original);
+    if (simple) {
+        BSONObj newObj;
+        bool modified = false;
+        ASSERT_TRUE(driver.updateSimple(
+            originalObj, immutablePaths, &newObj, nullptr, nullptr, &modified));
+    } else {
+        mutablebson::Document doc(originalObj);
+        ASSERT_OK(driver.update(StringData(), &doc, true, immutablePaths, nullptr, nullptr));
+    }
+
+    auto modifiedPaths = driver.getModifiedIndexedPaths();
+    if (!modifiedPaths) {
+        return boost::none;
+    }
+    std::vector<std::string> paths;
+    for (const auto& path : *modifiedPaths) {
+        paths.push_back(path.dottedField().toString());
+    }
+    std::sort(paths.begin(), paths.end());
+    return paths;
+}
+
+TEST(ModifiedIndexedPaths, OnlyIncludesPathsWhichMightBeIndexed) {
+    UpdateIndexData indexData;
+    indexData.addPath(FieldRef("a.b"));
+    indexData.addPath(FieldRef("c"));
+
+    const std::vector<std::string> expected{"a.b", "c"};
+    ASSERT(expected == *getModifiedIndexedPaths(indexData,
+                                                "{$set: {'a.b': 1, x: 1}, $inc: {c: 1}}",
+                                                "{_id: 0, a: {b: 0}, c: 1, x: 0}",
+                                                false));
+    ASSERT(std::vector<std::string>{"c"} ==
+           *getModifiedIndexedPaths(
+               indexData, "{$set: {c: 2, x: 1}}", "{_id: 0, c: 1, x: 0}", true));
+    ASSERT(std::vector<std::string>{} ==
+           *getModifiedIndexedPaths(indexData, "{$set: {x: 1}}", "{_id: 0, x: 0}", false));
+}
+
+TEST(ModifiedIndexedPaths, IncludesArrayElementPaths) {
+    UpdateIndexData indexData;
+    indexData.addPath(FieldRef("a.b"));
+
+    const std::vector<std::string> expected{"a.1.b"};
+    ASSERT(expected == *getModifiedIndexedPaths(indexData,
+                                                "{$set: {'a.1.b': 5}}",
+                                                "{_id: 0, a: [{b: 1}, {b: 2}]}",
+                                                false));
+
+    // Creating an array element reports the array itself.
+    ASSERT(std::vector<std::string>{"a"} ==
+           *getModifiedIndexedPaths(
+               indexData, "{$set: {'a.2.c': 5}}", "{_id: 0, a: [{b: 1}, {b: 2}]}", false));
+}
+
+TEST(ModifiedIndexedPaths, UnknownForReplacement) {
+    UpdateIndexData indexData;
+    indexData.addPath(FieldRef("a"));
+    ASSERT_FALSE(getModifiedIndexedPaths(indexData, "{x: 1}", "{_id: 0, a: 1}", false));
+}
+
 //
 // Tests of creating a base for an upsert from a query document
 // $or, $and, $all get special handling, as does the _id field
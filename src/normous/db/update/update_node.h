@@ -29,6 +29,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "mongo/bson/bsonelement.h"
 #include "mongo/bson/mutable/element.h"
@@ -119,6 +120,10 @@ public:
         // Used to determine whether indexes are affected.
         const UpdateIndexData* indexData = nullptr;
 
+        // If provided, UpdateNode::apply appends the path of each modification which might affect
+        // 'indexData', so that only the indexes on those paths need new keys.
+        std::vector<FieldRef>* modifiedIndexedPaths = nullptr;
+
         // If provided, UpdateNode::apply will log the update here.
         LogBuilder* logBuilder = nullptr;
     };
@@ -47,6 +47,12 @@ void UpdateIndexData::allPathsIndexed() {
     _allPathsIndexed = true;
 }
 
+void UpdateIndexData::merge(const UpdateIndexData& other) {
+    _canonicalPaths.insert(other._canonicalPaths.begin(), other._canonicalPaths.end());
+    _pathComponents.insert(other._pathComponents.begin(), other._pathComponents.end());
+    _allPathsIndexed = _allPathsIndexed || other._allPathsIndexed;
+}
+
 void UpdateIndexData::clear() {
     _canonicalPaths.clear();
     _pathComponents.clear();
@@ -69,6 +69,11 @@ public:
      */
     void allPathsIndexed();
 
+    /**
+     * Registers all of the paths and path components of 'other'.
+     */
+    void merge(const UpdateIndexData& other);
+
     void clear();
 
     bool mightBeIndexed(const FieldRef& path) const;
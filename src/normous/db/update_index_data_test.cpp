@@ -90,6 +90,27 @@ TEST(UpdateIndexDataTest, AllPathsIndexed2) {
     ASSERT_FALSE(a.mightBeIndexed(FieldRef("a")));
 }
 
+TEST(UpdateIndexDataTest, Merge) {
+    UpdateIndexData a;
+    a.addPath(FieldRef("a.b"));
+
+    UpdateIndexData b;
+    b.addPath(FieldRef("c"));
+    b.addPathComponent("d"_sd);
+
+    a.merge(b);
+    ASSERT_TRUE(a.mightBeIndexed(FieldRef("a.b")));
+    ASSERT_TRUE(a.mightBeIndexed(FieldRef("c")));
+    ASSERT_TRUE(a.mightBeIndexed(FieldRef("x.d")));
+    ASSERT_FALSE(a.mightBeIndexed(FieldRef("x")));
+    ASSERT_FALSE(b.mightBeIndexed(FieldRef("a.b")));
+
+    UpdateIndexData all;
+    all.allPathsIndexed();
+    a.merge(all);
+    ASSERT_TRUE(a.mightBeIndexed(FieldRef("x")));
+}
+
 TEST(UpdateIndexDataTest, CanonicalIndexField) {
     ASSERT_EQ(UpdateIndexData::getCanonicalIndexField(FieldRef("a")), FieldRef("a"_sd));
     ASSERT_EQ(UpdateIndexData::getCanonicalIndexField(FieldRef("aaa")), FieldRef("aaa"_sd));
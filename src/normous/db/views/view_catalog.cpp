@@ -84,6 +84,7 @@ Status ViewCatalog::_reloadIfNeeded_inlock(OperationContext* opCtx) {
 
     // Need to reload, first clear our cache.
     _viewMap.clear();
+    _resolvedViews.clear();
 
     Status status = _durable->iterate(opCtx, [&](const BSONObj& view) -> Status {
         BSONObj collationSpec = view.hasField("collation") ? view["collation"].Obj() : BSONObj();
@@ -159,8 +160,10 @@ Status ViewCatalog::_createOrUpdateView_inlock(OperationContext* opCtx,
 
     _durable->upsert(opCtx, viewName, viewDefBuilder.obj());
     _viewMap[viewName.ns()] = view;
+    _resolvedViews.clear();
     opCtx->recoveryUnit()->onRollback([this, viewName]() {
         this->_viewMap.erase(viewName.ns());
+        this->_resolvedViews.clear();
         this->_viewGraphNeedsRefresh = true;
     });
 
@@ -362,6 +365,7 @@ Status ViewCatalog::modifyView(OperationContext* opCtx,
     ViewDefinition savedDefinition = *viewPtr;
     opCtx->recoveryUnit()->onRollback([this, viewName, savedDefinition]() {
         this->_viewMap[viewName.ns()] = std::make_shared<ViewDefinition>(savedDefinition);
+        this->_resolvedViews.clear();
     });
 
     return _createOrUpdateView_inlock(
@@ -389,9 +393,11 @@ Status ViewCatalog::dropView(OperationContext* opCtx, const NamespaceString& vie
     _durable->remove(opCtx, viewName);
     _viewGraph.remove(savedDefinition.name());
     _viewMap.erase(viewName.ns());
+    _resolvedViews.clear();
     opCtx->recoveryUnit()->onRollback([this, viewName, savedDefinition]() {
         this->_viewGraphNeedsRefresh = true;
         this->_viewMap[viewName.ns()] = std::make_shared<ViewDefinition>(savedDefinition);
+        this->_resolvedViews.clear();
     });
 
     // We may get invalidated, but we're exclusively locked, so the change must be ours.
@@ -465,6 +471,13 @@ StatusWith<ResolvedView> ViewCatalog::resolveView(OperationContext* opCtx,
                 break;
             }
 
+            if (depth == 0) {
+                auto cached = _resolvedViews.find(nss.ns());
+                if (cached != _resolvedViews.end()) {
+                    return *cached->second;
+                }
+            }
+
             auto view = _lookup_inlock(opCtx, resolvedNss->ns());
             if (!view) {
                 // Return error status if pipeline is too large.
@@ -477,8 +490,8 @@ StatusWith<ResolvedView> ViewCatalog::resolveView(OperationContext* opCtx,
                             str::stream() << "View pipeline exceeds maximum size; maximum size is "
                                           << ViewGraph::kMaxViewPipelineSizeBytes};
                 }
-                return StatusWith<ResolvedView>(
-                    {*resolvedNss, std::move(resolvedPipeline), std::move(collation.get())});
+                return _cacheResolvedView_inlock(
+                    nss, {*resolvedNss, std::move(resolvedPipeline), std::move(collation.get())});
             }
 
             resolvedNss = &view->viewOn();
@@ -493,8 +506,8 @@ StatusWith<ResolvedView> ViewCatalog::resolveView(OperationContext* opCtx,
 
             // If the first stage is a $collStats, then we return early with the viewOn namespace.
             if (toPrepend.size() > 0 && !toPrepend[0]["$collStats"].eoo()) {
-                return StatusWith<ResolvedView>(
-                    {*resolvedNss, std::move(resolvedPipeline), std::move(collation.get())});
+                return _cacheResolvedView_inlock(
+                    nss, {*resolvedNss, std::move(resolvedPipeline), std::move(collation.get())});
             }
         }
 
@@ -506,4 +519,11 @@ StatusWith<ResolvedView> ViewCatalog::resolveView(OperationContext* opCtx,
     };
     MONGO_UNREACHABLE;
 }
+
+ResolvedView ViewCatalog::_cacheResolvedView_inlock(const NamespaceString& viewName,
+                                                    ResolvedView resolvedView) {
+    auto& cached = _resolvedViews[viewName.ns()];
+    cached = std::make_shared<const ResolvedView>(std::move(resolvedView));
+    return *cached;
+}
 }  // namespace mongo
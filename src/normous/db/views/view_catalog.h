@@ -114,6 +114,8 @@ public:
      * Resolve the views on 'nss', transforming the pipeline appropriately. This function returns a
      * fully-resolved view definition containing the backing namespace, the resolved pipeline and
      * the collation to use for the operation.
+     *
+     * Resolutions of views are cached until the view catalog next changes.
      */
     StatusWith<ResolvedView> resolveView(OperationContext* opCtx, const NamespaceString& nss);
 
@@ -163,6 +165,12 @@ private:
                                      const std::vector<NamespaceString>& refs);
 
     std::shared_ptr<ViewDefinition> _lookup_inlock(OperationContext* opCtx, StringData ns);
+
+    /**
+     * Remembers 'resolvedView' as the resolution of 'viewName' and returns it.
+     */
+    ResolvedView _cacheResolvedView_inlock(const NamespaceString& viewName,
+                                           ResolvedView resolvedView);
     Status _reloadIfNeeded_inlock(OperationContext* opCtx);
 
     void _requireValidCatalog_inlock(OperationContext* opCtx) {
@@ -172,6 +180,9 @@ private:
 
     stdx::mutex _mutex;  // Protects all members, except for _valid.
     ViewMap _viewMap;
+
+    // Resolutions of the views in '_viewMap', which must be cleared whenever any view changes.
+    StringMap<std::shared_ptr<const ResolvedView>> _resolvedViews;
     DurableViewCatalog* _durable;
     AtomicBool _valid;
     ViewGraph _viewGraph;
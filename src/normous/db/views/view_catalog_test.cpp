@@ -561,6 +561,51 @@ TEST_F(ViewCatalogFixture, ResolveViewCorrectlyExtractsDefaultCollation) {
                       expectedCollation.getValue()->getSpec().toBSON());
 }
 
+TEST_F(ViewCatalogFixture, ResolveViewSeesChangesToUnderlyingViews) {
+    const NamespaceString view1("db.view1");
+    const NamespaceString view2("db.view2");
+    const NamespaceString viewOn("db.coll");
+    const NamespaceString otherViewOn("db.other");
+    BSONArrayBuilder pipeline1;
+    BSONArrayBuilder pipeline2;
+    BSONArrayBuilder modifiedPipeline1;
+
+    pipeline1 << BSON("$match" << BSON("foo" << 1));
+    pipeline2 << BSON("$match" << BSON("foo" << 2));
+    modifiedPipeline1 << BSON("$project" << BSON("foo" << 1));
+
+    ASSERT_OK(viewCatalog.createView(opCtx.get(), view1, viewOn, pipeline1.arr(), emptyCollation));
+    ASSERT_OK(viewCatalog.createView(opCtx.get(), view2, view1, pipeline2.arr(), emptyCollation));
+
+    auto resolvedView = viewCatalog.resolveView(opCtx.get(), view2);
+    ASSERT_OK(resolvedView.getStatus());
+    ASSERT_EQ(2U, resolvedView.getValue().getPipeline().size());
+
+    // Resolving again gives the same result.
+    resolvedView = viewCatalog.resolveView(opCtx.get(), view2);
+    ASSERT_OK(resolvedView.getStatus());
+    ASSERT_EQ(resolvedView.getValue().getNamespace(), viewOn);
+    ASSERT_EQ(2U, resolvedView.getValue().getPipeline().size());
+    ASSERT_BSONOBJ_EQ(resolvedView.getValue().getPipeline()[0],
+                      BSON("$match" << BSON("foo" << 1)));
+
+    ASSERT_OK(viewCatalog.modifyView(opCtx.get(), view1, otherViewOn, modifiedPipeline1.arr()));
+
+    resolvedView = viewCatalog.resolveView(opCtx.get(), view2);
+    ASSERT_OK(resolvedView.getStatus());
+    ASSERT_EQ(resolvedView.getValue().getNamespace(), otherViewOn);
+    ASSERT_EQ(2U, resolvedView.getValue().getPipeline().size());
+    ASSERT_BSONOBJ_EQ(resolvedView.getValue().getPipeline()[0],
+                      BSON("$project" << BSON("foo" << 1)));
+
+    ASSERT_OK(viewCatalog.dropView(opCtx.get(), view1));
+
+    resolvedView = viewCatalog.resolveView(opCtx.get(), view2);
+    ASSERT_OK(resolvedView.getStatus());
+    ASSERT_EQ(resolvedView.getValue().getNamespace(), view1);
+    ASSERT_EQ(1U, resolvedView.getValue().getPipeline().size());
+}
+
 TEST_F(ViewCatalogFixture, InvalidateThenReload) {
     const NamespaceString viewName("db.view");
     const NamespaceString viewOn("db.coll");
@@ -35,6 +35,7 @@
 #include "mongo/base/counter.h"
 #include "mongo/bson/util/bson_extract.h"
 #include "mongo/db/client.h"
+#include "mongo/db/curop.h"
 #include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/repl/optime.h"
@@ -47,6 +48,7 @@
 #include "mongo/rpc/protocol.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/log.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -206,6 +208,7 @@ Status waitForWriteConcern(OperationContext* opCtx,
     }
 
     result->syncMillis = syncTimer.millis();
+    CurOp::get(opCtx)->debug().writeConcernSyncMicros += syncTimer.micros();
 
     // Now wait for replication
 
@@ -222,6 +225,10 @@ Status waitForWriteConcern(OperationContext* opCtx,
     }
 
     // Replica set stepdowns and gle mode changes are thrown as errors
+    Timer replicationTimer;
+    ON_BLOCK_EXIT([&] {
+        CurOp::get(opCtx)->debug().writeConcernReplicationMicros += replicationTimer.micros();
+    });
     repl::ReplicationCoordinator::StatusAndDuration replStatus =
         replCoord->awaitReplication(opCtx, replOpTime, writeConcernWithPopulatedSyncMode);
     if (replStatus.status == ErrorCodes::WriteConcernFailed) {
@@ -34,7 +34,9 @@
 
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/catalog/index_catalog_impl.h"
 #include "mongo/db/catalog/multi_index_block.h"
+#include "mongo/db/catalog/multi_index_block_impl.h"
 #include "mongo/db/client.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/dbdirectclient.h"
@@ -42,6 +44,7 @@
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/storage_engine_init.h"
 #include "mongo/dbtests/dbtests.h"
+#include "mongo/util/scopeguard.h"
 
 namespace IndexUpdateTests {
 
@@ -210,6 +213,195 @@ public:
     }
 };
 
+/** A foreground build that scans the collection on several threads indexes every document. */
+class InsertBuildParallelScan : public IndexBuildBase {
+public:
+    void run() {
+        const int numDocs = 50000;
+        {
+            WriteUnitOfWork wunit(&_opCtx);
+            OpDebug* const nullOpDebug = nullptr;
+            for (int i = 0; i < numDocs; ++i) {
+                ASSERT_OK(collection()->insertDocument(
+                    &_opCtx,
+                    InsertStatement(BSON("_id" << i << "a" << BSON_ARRAY(i << -i))),
+                    nullOpDebug,
+                    true));
+            }
+            wunit.commit();
+        }
+
+        const int oldScanThreads = maxIndexBuildScanThreads.swap(4);
+        ON_BLOCK_EXIT([&] { maxIndexBuildScanThreads.store(oldScanThreads); });
+
+        const BSONObj spec = BSON("name"
+                                  << "a_1"
+                                  << "ns"
+                                  << _ns
+                                  << "key"
+                                  << BSON("a" << 1)
+                                  << "v"
+                                  << static_cast<int>(kIndexVersion));
+        auto indexerPtr = collection()->createMultiIndexBlock(&_opCtx);
+        MultiIndexBlock& indexer(*indexerPtr);
+        ASSERT_OK(indexer.init(spec).getStatus());
+        ASSERT_OK(indexer.insertAllDocumentsInCollection());
+        {
+            WriteUnitOfWork wunit(&_opCtx);
+            indexer.commit();
+            wunit.commit();
+        }
+
+        IndexCatalog* catalog = collection()->getIndexCatalog();
+        IndexDescriptor* desc = catalog->findIndexByName(&_opCtx, "a_1");
+        ASSERT(desc);
+        ASSERT(catalog->getEntry(desc)->isMultikey(&_opCtx));
+
+        // A full validation checks that the index holds exactly the keys of every document.
+        BSONObj info;
+        ASSERT(_client.runCommand("unittests",
+                                  BSON("validate"
+                                       << "indexupdate"
+                                       << "full"
+                                       << true),
+                                  info));
+        ASSERT(info["valid"].trueValue()) << info;
+        ASSERT_EQUALS(numDocs, _client.count(_ns, BSON("a" << BSON("$gte" << 0))));
+    }
+};
+
+/** Inserting a batch while generating index keys on several threads indexes every document. */
+class InsertBatchParallelKeyGeneration : public IndexBuildBase {
+public:
+    void run() {
+        for (auto&& field : {"a", "b", "c"}) {
+            ASSERT_OK(createIndex("unittest",
+                                  BSON("name" << std::string(field) + "_1"
+                                              << "ns"
+                                              << _ns
+                                              << "key"
+                                              << BSON(field << 1)
+                                              << "v"
+                                              << static_cast<int>(kIndexVersion)
+                                              << "unique"
+                                              << (std::string(field) == "c"))));
+        }
+
+        const int oldThreads = maxInsertIndexKeyGenerationThreads.swap(4);
+        ON_BLOCK_EXIT([&] { maxInsertIndexKeyGenerationThreads.store(oldThreads); });
+
+        const int numDocs = 100;
+        std::vector<InsertStatement> inserts;
+        for (int i = 0; i < numDocs; ++i) {
+            inserts.emplace_back(BSON("_id" << i << "a" << BSON_ARRAY(i << -i) << "b" << i % 7
+                                            << "c"
+                                            << i));
+        }
+        OpDebug* const nullOpDebug = nullptr;
+        {
+            WriteUnitOfWork wunit(&_opCtx);
+            ASSERT_OK(collection()->insertDocuments(
+                &_opCtx, inserts.begin(), inserts.end(), nullOpDebug, false));
+            wunit.commit();
+        }
+
+        IndexCatalog* catalog = collection()->getIndexCatalog();
+        ASSERT(catalog->getEntry(catalog->findIndexByName(&_opCtx, "a_1"))->isMultikey(&_opCtx));
+
+        // A full validation checks that every index holds exactly the keys of every document.
+        BSONObj info;
+        ASSERT(_client.runCommand("unittests",
+                                  BSON("validate"
+                                       << "indexupdate"
+                                       << "full"
+                                       << true),
+                                  info));
+        ASSERT(info["valid"].trueValue()) << info;
+
+        // Duplicates in a unique index are still reported.
+        std::vector<InsertStatement> duplicates;
+        for (int i = 0; i < numDocs; ++i) {
+            duplicates.emplace_back(BSON("_id" << numDocs + i << "c" << i));
+        }
+        WriteUnitOfWork wunit(&_opCtx);
+        ASSERT_EQUALS(ErrorCodes::DuplicateKey,
+                      collection()->insertDocuments(
+                          &_opCtx, duplicates.begin(), duplicates.end(), nullOpDebug, false));
+    }
+};
+
+/** Inserting a batch merges the keys of its documents and inserts them in index key order. */
+class InsertBatchKeyOrder : public IndexBuildBase {
+public:
+    void run() {
+        ASSERT_OK(createIndex("unittest",
+                              BSON("name"
+                                   << "a_-1"
+                                   << "ns"
+                                   << _ns
+                                   << "key"
+                                   << BSON("a" << -1)
+                                   << "v"
+                                   << static_cast<int>(kIndexVersion))));
+        ASSERT_OK(createIndex("unittest",
+                              BSON("name"
+                                   << "b_1"
+                                   << "ns"
+                                   << _ns
+                                   << "key"
+                                   << BSON("b" << 1)
+                                   << "v"
+                                   << static_cast<int>(kIndexVersion)
+                                   << "unique"
+                                   << true)));
+
+        // Keys arrive in the opposite of index order, and only some documents are multikey.
+        const int numDocs = 50;
+        std::vector<InsertStatement> inserts;
+        for (int i = 0; i < numDocs; ++i) {
+            BSONObjBuilder doc;
+            doc.append("_id", i);
+            doc.append("b", numDocs - i);
+            if (i % 10 == 0) {
+                doc.append("a", BSON_ARRAY(i << numDocs + i));
+            } else {
+                doc.append("a", i);
+            }
+            inserts.emplace_back(doc.obj());
+        }
+        OpDebug* const nullOpDebug = nullptr;
+        {
+            WriteUnitOfWork wunit(&_opCtx);
+            ASSERT_OK(collection()->insertDocuments(
+                &_opCtx, inserts.begin(), inserts.end(), nullOpDebug, false));
+            wunit.commit();
+        }
+
+        IndexCatalog* catalog = collection()->getIndexCatalog();
+        ASSERT(catalog->getEntry(catalog->findIndexByName(&_opCtx, "a_-1"))->isMultikey(&_opCtx));
+        ASSERT_FALSE(
+            catalog->getEntry(catalog->findIndexByName(&_opCtx, "b_1"))->isMultikey(&_opCtx));
+
+        BSONObj info;
+        ASSERT(_client.runCommand("unittests",
+                                  BSON("validate"
+                                       << "indexupdate"
+                                       << "full"
+                                       << true),
+                                  info));
+        ASSERT(info["valid"].trueValue()) << info;
+
+        // A duplicate within the batch is still reported.
+        std::vector<InsertStatement> duplicates;
+        duplicates.emplace_back(BSON("_id" << numDocs << "b" << -1));
+        duplicates.emplace_back(BSON("_id" << numDocs + 1 << "b" << -1));
+        WriteUnitOfWork wunit(&_opCtx);
+        ASSERT_EQUALS(ErrorCodes::DuplicateKey,
+                      collection()->insertDocuments(
+                          &_opCtx, duplicates.begin(), duplicates.end(), nullOpDebug, false));
+    }
+};
+
 /** Index creation is killed if mayInterrupt is true. */
 class InsertBuildIndexInterrupt : public IndexBuildBase {
 public:
@@ -771,6 +963,9 @@ public:
         }
         add<InsertBuildEnforceUnique<true>>();
         add<InsertBuildEnforceUnique<false>>();
+        add<InsertBuildParallelScan>();
+        add<InsertBatchParallelKeyGeneration>();
+        add<InsertBatchKeyOrder>();
         add<InsertBuildIndexInterrupt>();
         add<InsertBuildIndexInterruptDisallowed>();
         add<InsertBuildIdIndexInterrupt>();
@@ -194,8 +194,19 @@ mongo::BSONArray MockRemoteDBServer::query(MockRemoteDBServer::InstanceID id,
 
     auto ns = nsOrUuid.uuid() ? _uuidToNs[*nsOrUuid.uuid()] : nsOrUuid.nss()->ns();
     const vector<BSONObj>& coll = _dataMgr[ns];
+
+    // Only "$min" and "$max" bounds on _id are honored; the query predicate is ignored.
+    const BSONElement minId = query.obj["$min"].isABSONObj() ? query.obj["$min"].Obj()["_id"]
+                                                              : BSONElement();
+    const BSONElement maxId = query.obj["$max"].isABSONObj() ? query.obj["$max"].Obj()["_id"]
+                                                              : BSONElement();
     BSONArrayBuilder result;
     for (vector<BSONObj>::const_iterator iter = coll.begin(); iter != coll.end(); ++iter) {
+        const BSONElement id = (*iter)["_id"];
+        if ((!minId.eoo() && id.woCompare(minId, false) < 0) ||
+            (!maxId.eoo() && id.woCompare(maxId, false) >= 0)) {
+            continue;
+        }
         result.append(iter->copy());
     }
 
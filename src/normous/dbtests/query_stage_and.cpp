@@ -49,6 +49,7 @@
 #include "mongo/db/exec/queued_data_stage.h"
 #include "mongo/db/json.h"
 #include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/util/mongoutils/str.h"
@@ -383,6 +384,67 @@ public:
     }
 };
 
+// An AND with two children whose hash table is summarized by a Bloom filter. RecordIds from the
+// last child which are outside the intersection should mostly be rejected by the filter.
+class QueryStageAndHashTwoLeafBloomFilter : public QueryStageAndBase {
+public:
+    QueryStageAndHashTwoLeafBloomFilter()
+        : _originalMinEntries(internalQueryAndHashBloomFilterMinEntries.load()) {
+        internalQueryAndHashBloomFilterMinEntries.store(1);
+    }
+
+    ~QueryStageAndHashTwoLeafBloomFilter() {
+        internalQueryAndHashBloomFilterMinEntries.store(_originalMinEntries);
+    }
+
+    void run() {
+        dbtests::WriteContextForTests ctx(&_opCtx, ns());
+        Database* db = ctx.db();
+        Collection* coll = ctx.getCollection();
+        if (!coll) {
+            WriteUnitOfWork wuow(&_opCtx);
+            coll = db->createCollection(&_opCtx, ns());
+            wuow.commit();
+        }
+
+        for (int i = 0; i < 50; ++i) {
+            insert(BSON("foo" << i << "bar" << i));
+        }
+
+        addIndex(BSON("foo" << 1));
+        addIndex(BSON("bar" << 1));
+
+        WorkingSet ws;
+        auto ah = make_unique<AndHashStage>(&_opCtx, &ws, coll);
+
+        // Foo <= 20
+        auto params = makeIndexScanParams(&_opCtx, getIndex(BSON("foo" << 1), coll));
+        params.bounds.startKey = BSON("" << 20);
+        params.direction = -1;
+        ah->addChild(new IndexScan(&_opCtx, params, &ws, NULL));
+
+        // Bar <= 40
+        params = makeIndexScanParams(&_opCtx, getIndex(BSON("bar" << 1), coll));
+        params.bounds.startKey = BSON("" << 40);
+        params.direction = -1;
+        ah->addChild(new IndexScan(&_opCtx, params, &ws, NULL));
+
+        // foo == bar, so our values are 0, 1, ..., 20.
+        ASSERT_EQUALS(21, countResults(ah.get()));
+
+        // Every result of the last child was checked against the filter. Of the 20 which are not
+        // in the intersection, the filter rules out all but the rare false positive.
+        const AndHashStats* stats = static_cast<const AndHashStats*>(ah->getSpecificStats());
+        ASSERT_GT(stats->bloomFilterBits, 0U);
+        ASSERT_EQUALS(41U, stats->bloomFilterProbes);
+        ASSERT_EQUALS(20U, stats->bloomFilterRejected + stats->bloomFilterFalsePositives);
+        ASSERT_GT(stats->bloomFilterRejected, stats->bloomFilterFalsePositives);
+    }
+
+private:
+    const int _originalMinEntries;
+};
+
 // An AND with two children.
 // Add large keys (512 bytes) to index of first child to cause
 // internal buffer within hashed AND to exceed threshold (32MB)
@@ -1339,6 +1401,7 @@ public:
     void setupTests() {
         add<QueryStageAndHashDeleteDuringYield>();
         add<QueryStageAndHashTwoLeaf>();
+        add<QueryStageAndHashTwoLeafBloomFilter>();
         add<QueryStageAndHashTwoLeafFirstChildLargeKeys>();
         add<QueryStageAndHashTwoLeafLastChildLargeKeys>();
         add<QueryStageAndHashThreeLeaf>();
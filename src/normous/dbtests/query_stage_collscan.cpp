@@ -44,6 +44,7 @@
 #include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/query/plan_executor.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/storage/record_store.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/stdx/memory.h"
@@ -236,6 +237,62 @@ public:
     }
 };
 
+//
+// With batching enabled, a single work() call skips over records that do not match the filter.
+//
+class QueryStageCollscanBatchedFilter : public QueryStageCollectionScanBase {
+public:
+    QueryStageCollscanBatchedFilter()
+        : _originalBatchSize(internalQueryExecCollectionScanBatchSize.load()) {
+        internalQueryExecCollectionScanBatchSize.store(8);
+    }
+
+    ~QueryStageCollscanBatchedFilter() {
+        internalQueryExecCollectionScanBatchSize.store(_originalBatchSize);
+    }
+
+    void run() {
+        AutoGetCollectionForReadCommand ctx(&_opCtx, nss);
+
+        CollectionScanParams params;
+        params.collection = ctx.getCollection();
+        params.direction = CollectionScanParams::FORWARD;
+        params.tailable = false;
+
+        const boost::intrusive_ptr<ExpressionContext> expCtx(
+            new ExpressionContext(&_opCtx, nullptr));
+        auto statusWithMatcher = MatchExpressionParser::parse(BSON("foo" << GTE << 40), expCtx);
+        ASSERT_OK(statusWithMatcher.getStatus());
+        unique_ptr<MatchExpression> filterExpr = std::move(statusWithMatcher.getValue());
+
+        WorkingSet ws;
+        CollectionScan scan(&_opCtx, params, &ws, filterExpr.get());
+
+        int count = 0;
+        int works = 0;
+        while (!scan.isEOF()) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            PlanStage::StageState state = scan.work(&id);
+            ++works;
+            if (PlanStage::ADVANCED == state) {
+                ASSERT_EQUALS(40 + count, ws.get(id)->obj.value()["foo"].numberInt());
+                ws.free(id);
+                ++count;
+            }
+        }
+
+        ASSERT_EQUALS(10, count);
+        // One work() to create the cursor, five to skip the first 40 records in batches of eight,
+        // one per match and one to reach EOF.
+        ASSERT_EQUALS(1 + 5 + 10 + 1, works);
+        ASSERT_EQUALS(static_cast<size_t>(numObj()),
+                      static_cast<const CollectionScanStats*>(scan.getSpecificStats())->docsTested);
+    }
+
+private:
+    const int _originalBatchSize;
+};
+
 //
 // Get objects in the reverse order we inserted them when we go backwards.
 //
@@ -402,6 +459,7 @@ public:
         add<QueryStageCollscanBasicBackwardWithMatch>();
         add<QueryStageCollscanObjectsInOrderForward>();
         add<QueryStageCollscanObjectsInOrderBackward>();
+        add<QueryStageCollscanBatchedFilter>();
         add<QueryStageCollscanDeleteUpcomingObject>();
         add<QueryStageCollscanDeleteUpcomingObjectBackward>();
     }
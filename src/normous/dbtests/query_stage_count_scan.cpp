@@ -41,10 +41,12 @@
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/json.h"
 #include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/fail_point_registry.h"
 #include "mongo/util/fail_point_service.h"
+#include "mongo/util/scopeguard.h"
 
 namespace QueryStageCountScan {
 
@@ -576,6 +578,60 @@ public:
     }
 };
 
+//
+// Check that the count of a range is remembered until the next write to the index
+//
+class QueryStageCountScanCachesRangeCounts : public CountBase {
+public:
+    void run() {
+        // The cache is created along with the index catalog entry.
+        const int oldCacheSize = internalQueryCountScanCacheSize;
+        internalQueryCountScanCacheSize = 10;
+        ON_BLOCK_EXIT([&] { internalQueryCountScanCacheSize = oldCacheSize; });
+
+        dbtests::WriteContextForTests ctx(&_opCtx, ns());
+
+        for (int i = 0; i < 10; ++i) {
+            insert(BSON("a" << i));
+        }
+        addIndex(BSON("a" << 1));
+
+        auto params = makeCountScanParams(&_opCtx, getIndex(ctx.db(), BSON("a" << 1)));
+        params.startKey = BSON("" << 2);
+        params.startKeyInclusive = true;
+        params.endKey = BSON("" << 7);
+        params.endKeyInclusive = false;
+
+        // The first count walks the index and caches its result.
+        {
+            WorkingSet ws;
+            CountScan count(&_opCtx, params, &ws);
+            ASSERT_FALSE(count.countFromCache());
+            ASSERT_EQUALS(5, runCount(&count));
+        }
+
+        // The second count is served from the cache.
+        {
+            WorkingSet ws;
+            CountScan count(&_opCtx, params, &ws);
+            auto cachedCount = count.countFromCache();
+            ASSERT(cachedCount);
+            ASSERT_EQUALS(5, *cachedCount);
+            ASSERT(count.isEOF());
+            ASSERT(static_cast<const CountScanStats*>(count.getSpecificStats())->countFromCache);
+        }
+
+        // A write to the index invalidates the cached count.
+        insert(BSON("a" << 3));
+        {
+            WorkingSet ws;
+            CountScan count(&_opCtx, params, &ws);
+            ASSERT_FALSE(count.countFromCache());
+            ASSERT_EQUALS(6, runCount(&count));
+        }
+    }
+};
+
 class All : public Suite {
 public:
     All() : Suite("query_stage_count_scan") {}
@@ -591,6 +647,7 @@ public:
         add<QueryStageCountScanDeleteDuringYield>();
         add<QueryStageCountScanInsertNewDocsDuringYield>();
         add<QueryStageCountScanUnusedKeys>();
+        add<QueryStageCountScanCachesRangeCounts>();
     }
 };
 
@@ -43,6 +43,7 @@
 #include "mongo/db/exec/queued_data_stage.h"
 #include "mongo/db/json.h"
 #include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/stdx/memory.h"
 
@@ -219,6 +220,76 @@ public:
     }
 };
 
+//
+// Test that a batched fetch returns documents in the order our child produced them, skipping
+// documents which were deleted before they could be fetched.
+//
+class FetchStageBatched : public QueryStageFetchBase {
+public:
+    FetchStageBatched() : _originalBatchSize(internalQueryExecFetchBatchSize.load()) {
+        internalQueryExecFetchBatchSize.store(4);
+    }
+
+    ~FetchStageBatched() {
+        internalQueryExecFetchBatchSize.store(_originalBatchSize);
+    }
+
+    void run() {
+        dbtests::WriteContextForTests ctx(&_opCtx, ns());
+        Database* db = ctx.db();
+        Collection* coll = db->getCollection(&_opCtx, ns());
+        if (!coll) {
+            WriteUnitOfWork wuow(&_opCtx);
+            coll = db->createCollection(&_opCtx, ns());
+            wuow.commit();
+        }
+
+        WorkingSet ws;
+
+        const int nDocs = 10;
+        for (int i = 0; i < nDocs; ++i) {
+            insert(BSON("foo" << i));
+        }
+        set<RecordId> recordIds;
+        getRecordIds(&recordIds, coll);
+        ASSERT_EQUALS(size_t(nDocs), recordIds.size());
+
+        // Feed the RecordIds in reverse order, so the fetch stage cannot rely on them being sorted.
+        auto mockStage = make_unique<QueuedDataStage>(&_opCtx, &ws);
+        for (auto it = recordIds.rbegin(); it != recordIds.rend(); ++it) {
+            WorkingSetID id = ws.allocate();
+            WorkingSetMember* mockMember = ws.get(id);
+            mockMember->recordId = *it;
+            ws.transitionToRecordIdAndIdx(id);
+            mockStage->pushBack(id);
+        }
+
+        // Remove one of the documents before it is fetched.
+        remove(BSON("foo" << 6));
+
+        unique_ptr<FetchStage> fetchStage(
+            new FetchStage(&_opCtx, &ws, mockStage.release(), NULL, coll));
+
+        std::vector<int> results;
+        PlanStage::StageState state = PlanStage::NEED_TIME;
+        while (state != PlanStage::IS_EOF) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            state = fetchStage->work(&id);
+            if (PlanStage::ADVANCED == state) {
+                WorkingSetMember* member = ws.get(id);
+                ASSERT(member->hasObj());
+                results.push_back(member->obj.value()["foo"].numberInt());
+            }
+        }
+
+        std::vector<int> expected = {9, 8, 7, 5, 4, 3, 2, 1, 0};
+        ASSERT(expected == results);
+    }
+
+private:
+    const int _originalBatchSize;
+};
+
 class All : public Suite {
 public:
     All() : Suite("query_stage_fetch") {}
@@ -226,6 +297,7 @@ public:
     void setupTests() {
         add<FetchStageAlreadyFetched>();
         add<FetchStageFilter>();
+        add<FetchStageBatched>();
     }
 };
 
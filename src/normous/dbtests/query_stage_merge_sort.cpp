@@ -858,6 +858,76 @@ public:
     }
 };
 
+// Sort keys of different numeric types must interleave by value.
+class QueryStageMergeSortMixedNumericTypes : public QueryStageMergeSortTestBase {
+public:
+    void run() {
+        dbtests::WriteContextForTests ctx(&_opCtx, ns());
+        Database* db = ctx.db();
+        Collection* coll = db->getCollection(&_opCtx, ns());
+        if (!coll) {
+            WriteUnitOfWork wuow(&_opCtx);
+            coll = db->createCollection(&_opCtx, ns());
+            wuow.commit();
+        }
+
+        const int N = 50;
+
+        for (int i = 0; i < N; ++i) {
+            insert(BSON("a" << 1 << "c" << i));
+            insert(BSON("b" << 1 << "c" << (i + 0.5)));
+            insert(BSON("a" << 1 << "c" << static_cast<long long>(i + 1)));
+        }
+
+        BSONObj firstIndex = BSON("a" << 1 << "c" << 1);
+        BSONObj secondIndex = BSON("b" << 1 << "c" << 1);
+
+        addIndex(firstIndex);
+        addIndex(secondIndex);
+
+        unique_ptr<WorkingSet> ws = make_unique<WorkingSet>();
+        // Sort by c:-1
+        MergeSortStageParams msparams;
+        msparams.pattern = BSON("c" << -1);
+        MergeSortStage* ms = new MergeSortStage(&_opCtx, msparams, ws.get(), coll);
+
+        // a:1, scanned backwards over c.
+        auto params = makeIndexScanParams(&_opCtx, getIndex(firstIndex, coll));
+        params.bounds.startKey = objWithMaxKey(1);
+        params.bounds.endKey = objWithMinKey(1);
+        params.direction = -1;
+        ms->addChild(new IndexScan(&_opCtx, params, ws.get(), NULL));
+
+        // b:1, scanned backwards over c.
+        params = makeIndexScanParams(&_opCtx, getIndex(secondIndex, coll));
+        params.bounds.startKey = objWithMaxKey(1);
+        params.bounds.endKey = objWithMinKey(1);
+        params.direction = -1;
+        ms->addChild(new IndexScan(&_opCtx, params, ws.get(), NULL));
+
+        unique_ptr<FetchStage> fetchStage =
+            make_unique<FetchStage>(&_opCtx, ws.get(), ms, nullptr, coll);
+        auto statusWithPlanExecutor = PlanExecutor::make(
+            &_opCtx, std::move(ws), std::move(fetchStage), coll, PlanExecutor::NO_YIELD);
+        ASSERT_OK(statusWithPlanExecutor.getStatus());
+        auto exec = std::move(statusWithPlanExecutor.getValue());
+
+        // The results are ordered N, N - 0.5, N - 1, ... 0.5, 0, where each whole number other
+        // than N and 0 appears twice.
+        double previous = N + 1;
+        size_t numResults = 0;
+        BSONObj obj;
+        while (PlanExecutor::ADVANCED == exec->getNext(&obj, NULL)) {
+            const double value = obj["c"].numberDouble();
+            ASSERT_LTE(value, previous);
+            previous = value;
+            ++numResults;
+        }
+        ASSERT_EQUALS(static_cast<size_t>(3 * N), numResults);
+        ASSERT_EQUALS(0.0, previous);
+    }
+};
+
 class All : public Suite {
 public:
     All() : Suite("query_stage_merge_sort_test") {}
@@ -873,6 +943,7 @@ public:
         add<QueryStageMergeSortConcurrentUpdateDedup>();
         add<QueryStageMergeSortStringsWithNullCollation>();
         add<QueryStageMergeSortStringsRespectsCollation>();
+        add<QueryStageMergeSortMixedNumericTypes>();
     }
 };
 
@@ -275,6 +275,35 @@ TEST_F(QueryStageMultiPlanTest, MPSCollectionScanVsHighlySelectiveIXScan) {
     ASSERT_EQUALS(results, N / 10);
 }
 
+TEST_F(QueryStageMultiPlanTest, MPSEndsTrialEarlyWhenOnlyOnePlanIsProductive) {
+    // The collection scan will not see a matching document until it has passed all of the
+    // non-matching ones, while the index scan produces a result on nearly every call to work().
+    for (int i = 0; i < 1000; ++i) {
+        insert(BSON("foo" << 0));
+    }
+    for (int i = 0; i < 200; ++i) {
+        insert(BSON("foo" << 7));
+    }
+
+    addIndex(BSON("foo" << 1));
+
+    const int earlyExitWorks = 20;
+    const int oldEarlyExitWorks = internalQueryPlanEvaluationEarlyExitWorks.load();
+    internalQueryPlanEvaluationEarlyExitWorks.store(earlyExitWorks);
+    ON_BLOCK_EXIT([oldEarlyExitWorks] {
+        internalQueryPlanEvaluationEarlyExitWorks.store(oldEarlyExitWorks);
+    });
+
+    AutoGetCollectionForReadCommand ctx(_opCtx.get(), nss);
+    const Collection* coll = ctx.getCollection();
+
+    auto mps = runMultiPlanner(_opCtx.get(), nss, coll, 7);
+
+    // Without the early exit, the index scan would have been worked until it returned
+    // 'internalQueryPlanEvaluationMaxResults' results.
+    ASSERT_EQ(static_cast<size_t>(earlyExitWorks), getBestPlanWorks(mps.get()));
+}
+
 TEST_F(QueryStageMultiPlanTest, MPSDoesNotCreateActiveCacheEntryImmediately) {
     const int N = 100;
     for (int i = 0; i < N; ++i) {
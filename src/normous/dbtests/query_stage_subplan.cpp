@@ -336,6 +336,65 @@ TEST_F(QueryStageSubplanTest, QueryStageSubplanDontCacheTies) {
     ASSERT_FALSE(subplan->branchPlannedFromCache(1));
 }
 
+/**
+ * Ensure that $or branches sharing a shape are ranked by a single MultiPlanStage trial, and that
+ * the subplan stage reports how each branch was planned.
+ */
+TEST_F(QueryStageSubplanTest, QueryStageSubplanReusesWinnerForBranchesOfSameShape) {
+    dbtests::WriteContextForTests ctx(opCtx(), nss.ns());
+
+    addIndex(BSON("a" << 1));
+    addIndex(BSON("a" << 1 << "b" << 1));
+    addIndex(BSON("c" << 1));
+
+    for (int i = 0; i < 10; i++) {
+        insert(BSON("a" << 1 << "b" << i << "c" << i));
+    }
+
+    // The first three branches share a shape with two candidate plans. The last branch has only
+    // one relevant index.
+    BSONObj query = fromjson("{$or: [{a: 1, b: 3}, {a: 1, b: 4}, {a: 1, b: 5}, {c: 1}]}");
+
+    Collection* collection = ctx.getCollection();
+
+    auto qr = stdx::make_unique<QueryRequest>(nss);
+    qr->setFilter(query);
+    auto statusWithCQ = CanonicalQuery::canonicalize(opCtx(), std::move(qr));
+    ASSERT_OK(statusWithCQ.getStatus());
+    std::unique_ptr<CanonicalQuery> cq = std::move(statusWithCQ.getValue());
+
+    QueryPlannerParams plannerParams;
+    fillOutPlannerParams(opCtx(), collection, cq.get(), &plannerParams);
+
+    WorkingSet ws;
+    std::unique_ptr<SubplanStage> subplan(
+        new SubplanStage(opCtx(), collection, &ws, plannerParams, cq.get()));
+
+    PlanYieldPolicy yieldPolicy(PlanExecutor::NO_YIELD, _clock);
+    ASSERT_OK(subplan->pickBestPlan(&yieldPolicy));
+
+    const SubplanStats* stats = static_cast<const SubplanStats*>(subplan->getSpecificStats());
+    ASSERT_EQ(stats->branchStats.size(), 4U);
+    ASSERT_EQ(stats->branchesReused, 2U);
+    ASSERT_EQ(stats->branchStats[0].planSource, "multiPlanner");
+    ASSERT_GT(stats->branchStats[0].numCandidates, 1U);
+    ASSERT_EQ(stats->branchStats[1].planSource, "reusedBranch");
+    ASSERT_EQ(stats->branchStats[2].planSource, "reusedBranch");
+    ASSERT_EQ(stats->branchStats[3].planSource, "singleSolution");
+
+    // The composite plan built from the reused winners must still return every match.
+    size_t numRecords = 0;
+    WorkingSetID id = WorkingSet::INVALID_ID;
+    PlanStage::StageState state = PlanStage::NEED_TIME;
+    while (state != PlanStage::IS_EOF) {
+        state = subplan->work(&id);
+        if (state == PlanStage::ADVANCED) {
+            ++numRecords;
+        }
+    }
+    ASSERT_EQ(numRecords, 4U);
+}
+
 /**
  * Unit test the subplan stage's canUseSubplanning() method.
  */
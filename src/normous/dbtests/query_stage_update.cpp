@@ -49,10 +49,12 @@
 #include "mongo/db/ops/update_lifecycle_impl.h"
 #include "mongo/db/ops/update_request.h"
 #include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/update/update_driver.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/stdx/memory.h"
+#include "mongo/util/scopeguard.h"
 
 #define ASSERT_DOES_NOT_THROW(EXPRESSION)                                          \
     try {                                                                          \
@@ -365,6 +367,94 @@ public:
     }
 };
 
+/**
+ * Test that a multi-update writes several documents per call to work() when it may batch them
+ * under one WriteUnitOfWork, and commits each batch before returning.
+ */
+class QueryStageUpdateMultiBatchedWrites : public QueryStageUpdateBase {
+public:
+    void run() {
+        const int oldMaxDocs = internalUpdateMultiMaxDocsPerWriteUnitOfWork.swap(4);
+        ON_BLOCK_EXIT([&] { internalUpdateMultiMaxDocsPerWriteUnitOfWork.store(oldMaxDocs); });
+        // Don't let a slow machine cut a batch short.
+        const int oldMaxMillis = internalUpdateMultiMaxMillisPerWriteUnitOfWork.swap(60 * 1000);
+        ON_BLOCK_EXIT(
+            [&] { internalUpdateMultiMaxMillisPerWriteUnitOfWork.store(oldMaxMillis); });
+
+        // Run the update.
+        {
+            dbtests::WriteContextForTests ctx(&_opCtx, nss.ns());
+
+            // Populate the collection.
+            for (int i = 0; i < 10; ++i) {
+                insert(BSON("_id" << i << "foo" << i));
+            }
+            ASSERT_EQUALS(10U, count(BSONObj()));
+
+            OpDebug* opDebug = &CurOp::get(_opCtx)->debug();
+            const CollatorInterface* collator = nullptr;
+            UpdateDriver driver(new ExpressionContext(&_opCtx, collator));
+            Collection* coll = ctx.getCollection();
+
+            UpdateRequest request(nss);
+            UpdateLifecycleImpl updateLifecycle(nss);
+            request.setLifecycle(&updateLifecycle);
+
+            // Update is a multi-update that adds 100 to 'foo' in every document.
+            BSONObj query = BSONObj();
+            request.setMulti();
+            request.setQuery(query);
+            request.setUpdates(fromjson("{$inc: {foo: 100}}"));
+
+            const std::map<StringData, std::unique_ptr<ExpressionWithPlaceholder>> arrayFilters;
+
+            ASSERT_DOES_NOT_THROW(
+                driver.parse(request.getUpdates(), arrayFilters, request.isMulti()));
+
+            // Configure the scan.
+            CollectionScanParams collScanParams;
+            collScanParams.collection = coll;
+            collScanParams.direction = CollectionScanParams::FORWARD;
+            collScanParams.tailable = false;
+
+            // Configure the update.
+            UpdateStageParams updateParams(&request, &driver, opDebug);
+            unique_ptr<CanonicalQuery> cq(canonicalize(query));
+            updateParams.canonicalQuery = cq.get();
+
+            auto ws = make_unique<WorkingSet>();
+            auto cs = make_unique<CollectionScan>(&_opCtx, collScanParams, ws.get(), cq->root());
+
+            auto updateStage =
+                make_unique<UpdateStage>(&_opCtx, updateParams, ws.get(), coll, cs.release());
+
+            const UpdateStats* stats =
+                static_cast<const UpdateStats*>(updateStage->getSpecificStats());
+
+            // The first call to work() updates a full batch of documents.
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            ASSERT_EQUALS(PlanStage::NEED_TIME, updateStage->work(&id));
+            ASSERT_EQUALS(4U, stats->nMatched);
+            ASSERT_FALSE(_opCtx.lockState()->inAWriteUnitOfWork());
+
+            while (!updateStage->isEOF()) {
+                const size_t nMatchedBefore = stats->nMatched;
+                id = WorkingSet::INVALID_ID;
+                PlanStage::StageState state = updateStage->work(&id);
+                ASSERT(PlanStage::NEED_TIME == state || PlanStage::IS_EOF == state);
+                ASSERT_LTE(stats->nMatched - nMatchedBefore, 4U);
+                ASSERT_FALSE(_opCtx.lockState()->inAWriteUnitOfWork());
+            }
+
+            ASSERT_EQUALS(10U, stats->nMatched);
+            ASSERT_EQUALS(10U, stats->nModified);
+        }
+
+        // Every document should have been updated exactly once.
+        ASSERT_EQUALS(10U, count(BSON("foo" << BSON("$gte" << 100 << "$lt" << 110))));
+    }
+};
+
 /**
  * Test that the update stage returns an owned copy of the original document if
  * ReturnDocOption::RETURN_OLD is specified.
@@ -555,6 +645,7 @@ public:
         // Stage-specific tests below.
         add<QueryStageUpdateUpsertEmptyColl>();
         add<QueryStageUpdateSkipDeletedDoc>();
+        add<QueryStageUpdateMultiBatchedWrites>();
         add<QueryStageUpdateReturnOldDoc>();
         add<QueryStageUpdateReturnNewDoc>();
     }
@@ -56,6 +56,7 @@
 #include "mongo/db/storage/encryption_hooks.h"
 #include "mongo/db/storage/storage_engine_init.h"
 #include "mongo/db/ttl.h"
+#include "mongo/embedded/embedded_options.h"
 #include "mongo/embedded/logical_session_cache_factory_embedded.h"
 #include "mongo/embedded/periodic_runner_embedded.h"
 #include "mongo/embedded/replication_coordinator_embedded.h"
@@ -251,7 +252,7 @@ ServiceContext* initialize(const char* yaml_config) {
     }
 
     if (!storageGlobalParams.readOnly) {
-        boost::filesystem::remove_all(storageGlobalParams.dbpath + "/_tmp/");
+        boost::filesystem::remove_all(storageGlobalParams.getTmpDirectory() + "/");
     }
 
     auto startupOpCtx = serviceContext->makeOperationContext(&cc());
@@ -264,7 +265,10 @@ ServiceContext* initialize(const char* yaml_config) {
                                                        repl::StorageInterface::get(serviceContext));
     }
 
-    auto swNonLocalDatabases = repairDatabasesAndCheckVersion(startupOpCtx.get());
+    // A fast open leaves databases other than "admin" and "local" to be opened on first use, so
+    // that startup time does not grow with the number of databases.
+    auto swNonLocalDatabases =
+        repairDatabasesAndCheckVersion(startupOpCtx.get(), !embeddedGlobalParams.fastOpen);
     if (!swNonLocalDatabases.isOK()) {
         // SERVER-31611 introduced a return value to `repairDatabasesAndCheckVersion`. Previously,
         // a failing condition would fassert. SERVER-31611 covers a case where the binary (3.6) is
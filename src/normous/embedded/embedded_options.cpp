@@ -42,6 +42,8 @@ namespace embedded {
 
 using std::string;
 
+EmbeddedParams embeddedGlobalParams;
+
 Status addOptions(optionenvironment::OptionSection* options) {
     moe::OptionSection general_options("General options");
 
@@ -77,6 +79,14 @@ Status addOptions(optionenvironment::OptionSection* options) {
 
 #endif
 
+    storage_options
+        .addOptionChaining("storage.fastOpen",
+                           "",
+                           moe::Bool,
+                           "open databases on first use instead of checking all of them at "
+                           "startup")
+        .setSources(moe::SourceYAMLConfig);
+
     options->addSection(general_options).transitional_ignore();
     options->addSection(storage_options).transitional_ignore();
 
@@ -107,6 +117,10 @@ Status storeOptions(const moe::Environment& params) {
     if (params.count("storage.dbPath")) {
         storageGlobalParams.dbpath = params["storage.dbPath"].as<string>();
     }
+
+    if (params.count("storage.fastOpen")) {
+        embeddedGlobalParams.fastOpen = params["storage.fastOpen"].as<bool>();
+    }
 #ifdef _WIN32
     if (storageGlobalParams.dbpath.size() > 1 &&
         storageGlobalParams.dbpath[storageGlobalParams.dbpath.size() - 1] == '/') {
@@ -131,6 +145,7 @@ Status storeOptions(const moe::Environment& params) {
 
 void resetOptions() {
     storageGlobalParams.reset();
+    embeddedGlobalParams = EmbeddedParams();
 }
 
 }  // namespace embedded
@@ -35,6 +35,14 @@
 namespace mongo {
 namespace embedded {
 
+struct EmbeddedParams {
+    // Open only the databases startup needs, and each other database on its first use, instead
+    // of opening and checking every database in the catalog before startup completes.
+    bool fastOpen = false;
+};
+
+extern EmbeddedParams embeddedGlobalParams;
+
 Status addOptions(optionenvironment::OptionSection* options);
 
 /**
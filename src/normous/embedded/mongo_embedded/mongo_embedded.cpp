@@ -36,6 +36,8 @@
 #include <unordered_map>
 #include <vector>
 
+#include "mongo/base/data_type_endian.h"
+#include "mongo/base/data_view.h"
 #include "mongo/db/client.h"
 #include "mongo/db/dbmain.h"
 #include "mongo/db/service_context.h"
@@ -44,6 +46,7 @@
 #include "mongo/logger/logger.h"
 #include "mongo/logger/message_event_utf8_encoder.h"
 #include "mongo/rpc/message.h"
+#include "mongo/rpc/op_msg.h"
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/transport/service_entry_point.h"
 #include "mongo/transport/transport_layer_mock.h"
@@ -219,6 +222,9 @@ struct mongo_embedded_v1_client {
 
     std::vector<unsigned char> output;
     mongo::DbResponse response;
+
+    // Holds the last request so that its storage can be reused by the next one.
+    mongo::SharedBuffer request;
 };
 
 namespace mongo {
@@ -443,33 +449,24 @@ private:
     mongo_embedded_v1_client* const _client;
 };
 
-void client_wire_protocol_rpc(mongo_embedded_v1_client* const client,
-                              const void* input,
-                              const size_t input_size,
-                              void** const output,
-                              size_t* const output_size,
-                              mongo_embedded_v1_status& status) {
+// Runs "request" as "client" and leaves the reply in the client's response.
+void runRequest(mongo_embedded_v1_client* const client, const Message& request) {
     ClientGuard clientGuard(client);
 
     auto opCtx = cc().makeOperationContext();
     auto sep = client->parent_db->serviceContext->getServiceEntryPoint();
 
-    auto sb = SharedBuffer::allocate(input_size);
-    memcpy(sb.get(), input, input_size);
-
-    Message msg(std::move(sb));
-
-    client->response = sep->handleRequest(opCtx.get(), msg);
-
-    MsgData::View outMessage(client->response.response.buf());
-    outMessage.setId(nextMessageId());
-    outMessage.setResponseToMsgId(msg.header().getId());
+    client->response = sep->handleRequest(opCtx.get(), request);
+}
 
+void setOutputParameters(const void* const buffer,
+                         const size_t size,
+                         void** const output,
+                         size_t* const output_size) {
     // The results of the computations used to fill out-parameters need to be captured and processed
     // before setting the output parameters themselves, in order to maintain the strong-guarantee
     // part of the contract of this function.
-    auto outParams =
-        std::make_tuple(client->response.response.size(), client->response.response.buf());
+    auto outParams = std::make_tuple(size, const_cast<void*>(buffer));
 
     // We force the output parameters to be set in a `noexcept` enabled way.  If the operation
     // itself
@@ -486,6 +483,57 @@ void client_wire_protocol_rpc(mongo_embedded_v1_client* const client,
     }
 }
 
+void client_wire_protocol_rpc(mongo_embedded_v1_client* const client,
+                              const void* input,
+                              const size_t input_size,
+                              void** const output,
+                              size_t* const output_size,
+                              mongo_embedded_v1_status& status) {
+    // Copy the request into the storage of the previous one, unless that is too small or still
+    // referenced from somewhere.
+    if (client->request.isShared() || client->request.capacity() < input_size) {
+        client->request = SharedBuffer::allocate(input_size);
+    }
+    memcpy(client->request.get(), input, input_size);
+
+    Message msg(client->request);
+
+    runRequest(client, msg);
+
+    MsgData::View outMessage(client->response.response.buf());
+    outMessage.setId(nextMessageId());
+    outMessage.setResponseToMsgId(msg.header().getId());
+
+    setOutputParameters(client->response.response.buf(),
+                        client->response.response.size(),
+                        output,
+                        output_size);
+}
+
+void client_invoke_command(mongo_embedded_v1_client* const client,
+                           const void* command,
+                           const size_t command_size,
+                           void** const reply,
+                           size_t* const reply_size,
+                           mongo_embedded_v1_status& status) {
+    uassert(ErrorCodes::InvalidBSON,
+            "The command passed to mongo_embedded_v1_client_invoke_command is not a BSON document "
+            "of the given size",
+            command_size >= size_t(BSONObj::kMinBSONLength) &&
+                static_cast<size_t>(ConstDataView(static_cast<const char*>(command))
+                                        .read<LittleEndian<int>>()) == command_size);
+
+    OpMsgBuilder builder;
+    builder.setBody(BSONObj(static_cast<const char*>(command)));
+
+    runRequest(client, builder.finish());
+
+    // The reply body is left in the client's response buffer rather than being copied out of it.
+    const BSONObj replyBody = OpMsg::parse(client->response.response).body;
+
+    setOutputParameters(replyBody.objdata(), size_t(replyBody.objsize()), reply, reply_size);
+}
+
 int capi_status_get_error(const mongo_embedded_v1_status* const status) noexcept {
     invariant(status);
     return status->error;
@@ -626,6 +674,19 @@ int MONGO_API_CALL mongo_embedded_v1_client_invoke(mongo_embedded_v1_client* con
     });
 }
 
+int MONGO_API_CALL
+mongo_embedded_v1_client_invoke_command(mongo_embedded_v1_client* const client,
+                                        const void* command,
+                                        const size_t command_size,
+                                        void** const reply,
+                                        size_t* const reply_size,
+                                        mongo_embedded_v1_status* const statusPtr) {
+    return enterCXX(statusPtr, [&](mongo_embedded_v1_status& status) {
+        return mongo::client_invoke_command(
+            client, command, command_size, reply, reply_size, status);
+    });
+}
+
 int MONGO_API_CALL
 mongo_embedded_v1_status_get_error(const mongo_embedded_v1_status* const status) {
     return mongo::capi_status_get_error(status);
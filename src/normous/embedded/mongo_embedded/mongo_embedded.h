@@ -736,6 +736,64 @@ mongo_embedded_v1_client_invoke(mongo_embedded_v1_client* client,
                                 size_t* output_size,
                                 mongo_embedded_v1_status* status);
 
+/**
+ * Runs a command on the database, passing BSON documents rather than wire protocol messages.
+ *
+ * The command is the BSON document specified by `command` and `command_size`, in the form of the
+ * body of an `OP_MSG` request; in particular, it names its database in a `$db` field. The reply is
+ * the body of the command's reply, whether or not the command succeeded.
+ *
+ * @pre The specified `client` object must not be `NULL`.
+ * @pre The specified `client` object must be a valid `mongo_embedded_v1_client` object.
+ * @pre The specified `command` buffer must not be `NULL`.
+ * @pre The specified `reply` pointer must not be `NULL`
+ * @pre The specified `reply` pointer must point to a valid, non-const `void *` variable.
+ * @pre The specified `reply_size` pointer must not be `NULL`
+ * @pre The specified `reply_size` pointer must point to a valid, non-const `size_t` variable.
+ *
+ * @pre The specified `status` object must be either a valid `mongo_embedded_v1_status` object or
+ * `NULL`.
+ *
+ * @param client The client that will be running the command on the database
+ *
+ * @param command The BSON document of the command
+ *
+ * @param command_size The size (number of bytes) of the command document
+ *
+ * @param reply A pointer to a `void *` where the database can write the location of the reply
+ * document. The library will manage the memory pointed to by `*reply`.
+ *
+ * @param reply_size A pointer to a location where this function will write the size (number of
+ * bytes) of the reply document.
+ *
+ * @param status A pointer to a `mongo_embedded_v1_status` object which will not be modified unless
+ * this function reports a failure.
+ *
+ * @return Returns MONGO_EMBEDDED_V1_SUCCESS on success.
+ * @return Returns MONGO_EMBEDDED_V1_ERROR_EXCEPTION and modifies `status` if `command` is not a
+ * BSON document of `command_size` bytes.
+ * @return An error code and modifies `status` on other failures.
+ *
+ * @invariant This function is not thread-safe unless its preconditions are met, and the specified
+ * `mongo_embedded_v1_client` object is not concurrently accessed by any other thread until after
+ * this call has completed.
+ *
+ * @note The `reply` and `reply_size` parameters will not be modified unless the function
+ * succeeds.
+ *
+ * @note The storage associated with `reply` is the storage of the reply message, and is reused by
+ * later calls. It will be valid until the next call to `mongo_embedded_v1_client_invoke` or
+ * `mongo_embedded_v1_client_invoke_command` on the specified `client` object, or the `client` is
+ * destroyed using `mongo_embedded_v1_client_destroy`.
+ */
+MONGO_EMBEDDED_API int MONGO_API_CALL
+mongo_embedded_v1_client_invoke_command(mongo_embedded_v1_client* client,
+                                        const void* command,
+                                        size_t command_size,
+                                        void** reply,
+                                        size_t* reply_size,
+                                        mongo_embedded_v1_status* status);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -173,6 +173,21 @@ protected:
         return outputOpMsg.body;
     }
 
+    mongo::BSONObj invokeCommand(MongoDBCAPIClientPtr& client, const mongo::BSONObj& command) {
+        void* reply;
+        size_t replySize;
+
+        int err = mongo_embedded_v1_client_invoke_command(
+            client.get(), command.objdata(), command.objsize(), &reply, &replySize, status);
+        ASSERT_EQUALS(err, MONGO_EMBEDDED_V1_SUCCESS)
+            << mongo_embedded_v1_status_get_explanation(status);
+
+        mongo::BSONObj replyObj(static_cast<const char*>(reply));
+        ASSERT_EQUALS(static_cast<size_t>(replyObj.objsize()), replySize);
+        ASSERT(replyObj.valid(mongo::BSONVersion::kLatest));
+        return replyObj.getOwned();
+    }
+
 
 protected:
     mongo_embedded_v1_lib* lib;
@@ -544,6 +559,78 @@ TEST_F(MongodbCAPITest, InsertAndUpdate) {
     ASSERT(outputBSON2.getIntField("nModified") == 1);
 }
 
+TEST_F(MongodbCAPITest, InvokeCommandInsertAndRead) {
+    auto client = createClient();
+
+    auto insertReply = invokeCommand(
+        client,
+        mongo::fromjson("{insert: 'invoke_command', documents: [{firstName: 'Mongo', age: 10}], "
+                        "$db: 'db_name'}"));
+    ASSERT(insertReply.getField("ok").numberDouble() == 1.0);
+    ASSERT(insertReply.getIntField("n") == 1);
+
+    auto findReply = invokeCommand(
+        client, mongo::fromjson("{find: 'invoke_command', filter: {age: 10}, $db: 'db_name'}"));
+    ASSERT(findReply.getField("ok").numberDouble() == 1.0);
+    auto firstBatch = findReply.getObjectField("cursor").getField("firstBatch").Array();
+    ASSERT_EQUALS(firstBatch.size(), 1U);
+    ASSERT_EQUALS(firstBatch[0].Obj().getStringField("firstName"), std::string("Mongo"));
+}
+
+TEST_F(MongodbCAPITest, InvokeCommandReportsCommandErrorsInTheReply) {
+    auto client = createClient();
+
+    auto reply = invokeCommand(client, mongo::fromjson("{notARealCommand: 1, $db: 'db_name'}"));
+    ASSERT(reply.getField("ok").numberDouble() == 0.0);
+    ASSERT_EQUALS(reply.getIntField("code"), mongo::ErrorCodes::CommandNotFound);
+}
+
+TEST_F(MongodbCAPITest, InvokeCommandRejectsMismatchedSize) {
+    auto client = createClient();
+
+    auto command = mongo::fromjson("{isMaster: 1, $db: 'admin'}");
+    void* reply;
+    size_t replySize;
+    int err = mongo_embedded_v1_client_invoke_command(
+        client.get(), command.objdata(), command.objsize() + 1, &reply, &replySize, status);
+    ASSERT_EQUALS(err, MONGO_EMBEDDED_V1_ERROR_EXCEPTION);
+    ASSERT_EQUALS(mongo_embedded_v1_status_get_code(status), mongo::ErrorCodes::InvalidBSON);
+}
+
+TEST_F(MongodbCAPITest, FastOpenOpensDatabasesOnFirstUse) {
+    {
+        auto client = createClient();
+        auto reply = invokeCommand(
+            client,
+            mongo::fromjson("{insert: 'fast_open', documents: [{_id: 1}], $db: 'db_name'}"));
+        ASSERT(reply.getField("ok").numberDouble() == 1.0);
+    }
+
+    ASSERT_EQUALS(mongo_embedded_v1_instance_destroy(db, status), MONGO_EMBEDDED_V1_SUCCESS)
+        << mongo_embedded_v1_status_get_explanation(status);
+
+    YAML::Emitter yaml;
+    yaml << YAML::BeginMap;
+    yaml << YAML::Key << "storage";
+    yaml << YAML::Value << YAML::BeginMap;
+    yaml << YAML::Key << "dbPath";
+    yaml << YAML::Value << globalTempDir->path();
+    yaml << YAML::Key << "fastOpen";
+    yaml << YAML::Value << true;
+    yaml << YAML::EndMap;  // storage
+    yaml << YAML::EndMap;
+
+    db = mongo_embedded_v1_instance_create(lib, yaml.c_str(), status);
+    ASSERT(db != nullptr) << mongo_embedded_v1_status_get_explanation(status);
+
+    auto client = createClient();
+    auto findReply =
+        invokeCommand(client, mongo::fromjson("{find: 'fast_open', $db: 'db_name'}"));
+    ASSERT(findReply.getField("ok").numberDouble() == 1.0);
+    auto firstBatch = findReply.getObjectField("cursor").getField("firstBatch").Array();
+    ASSERT_EQUALS(firstBatch.size(), 1U);
+}
+
 TEST_F(MongodbCAPITest, RunListCommands) {
     auto client = createClient();
 
@@ -31,4 +31,7 @@
 namespace mongo {
 MONGO_REGISTER_SHIM(createTransactionCoordinator)
 (OperationContext* opCtx, TxnNumber clientTxnNumber)->void {}
+
+MONGO_REGISTER_SHIM(releaseUnusedTransactionCoordinator)
+(OperationContext* opCtx, TxnNumber clientTxnNumber)->void {}
 }  // namespace mongo
@@ -69,7 +69,7 @@ public:
      *
      * The complexity comes from the need to hold a lock when writing to the
      * _activeClients param on the specific pool.  Because the code beneath the client needs to lock
-     * and unlock the parent mutex (and can leave unlocked), we want to start the client with the
+     * and unlock the pool mutex (and can leave unlocked), we want to start the client with the
      * lock acquired, move it into the client, then re-acquire to decrement the counter on the way
      * out.
      *
@@ -85,11 +85,11 @@ public:
     template <typename Callback>
     auto guardCallback(Callback&& cb) {
         return [ cb = std::forward<Callback>(cb), anchor = shared_from_this() ](auto&&... args) {
-            stdx::unique_lock<stdx::mutex> lk(anchor->_parent->_mutex);
+            stdx::unique_lock<stdx::mutex> lk(anchor->_mutex);
             ++(anchor->_activeClients);
 
             ON_BLOCK_EXIT([anchor]() {
-                stdx::unique_lock<stdx::mutex> lk(anchor->_parent->_mutex);
+                stdx::unique_lock<stdx::mutex> lk(anchor->_mutex);
                 --(anchor->_activeClients);
             });
 
@@ -101,8 +101,24 @@ public:
     ~SpecificPool();
 
     /**
-     * Gets a connection from the specific pool. Sinks a unique_lock from the
-     * parent to preserve the lock on _mutex
+     * Acquires the lock protecting this pool's state. Each specific pool has its own lock so that
+     * requests to different hosts don't contend with each other.
+     */
+    stdx::unique_lock<stdx::mutex> lock() {
+        return stdx::unique_lock<stdx::mutex>(_mutex);
+    }
+
+    /**
+     * Returns true once the pool has started shutting down. A pool in shutdown no longer accepts
+     * requests and delists itself from the parent once its last clients are gone.
+     */
+    bool inShutdown(const stdx::unique_lock<stdx::mutex>& lk) const {
+        return _state == State::kInShutdown;
+    }
+
+    /**
+     * Gets a connection from the specific pool. Sinks a unique_lock on the
+     * pool's _mutex
      */
     Future<ConnectionHandle> getConnection(const HostAndPort& hostAndPort,
                                            Milliseconds timeout,
@@ -124,8 +140,8 @@ public:
     void processFailure(const Status& status, stdx::unique_lock<stdx::mutex> lk);
 
     /**
-     * Returns a connection to a specific pool. Sinks a unique_lock from the
-     * parent to preserve the lock on _mutex
+     * Returns a connection to a specific pool. Sinks a unique_lock on the
+     * pool's _mutex
      */
     void returnConnection(ConnectionInterface* connection, stdx::unique_lock<stdx::mutex> lk);
 
@@ -203,6 +219,10 @@ private:
 
     const HostAndPort _hostAndPort;
 
+    // Protects all of the state below. May be held while acquiring the parent's mutex, but never
+    // acquired while holding it.
+    stdx::mutex _mutex;
+
     LRUOwnershipPool _readyPool;
     OwnershipPool _processingPool;
     OwnershipPool _droppedProcessingPool;
@@ -289,7 +309,7 @@ void ConnectionPool::shutdown() {
     }();
 
     for (const auto& pair : pools) {
-        stdx::unique_lock<stdx::mutex> lk(_mutex);
+        auto lk = pair.second->lock();
         pair.second->triggerShutdown(
             Status(ErrorCodes::ShutdownInProgress, "Shutting down the connection pool"),
             std::move(lk));
@@ -297,14 +317,11 @@ void ConnectionPool::shutdown() {
 }
 
 void ConnectionPool::dropConnections(const HostAndPort& hostAndPort) {
-    stdx::unique_lock<stdx::mutex> lk(_mutex);
-
-    auto iter = _pools.find(hostAndPort);
-
-    if (iter == _pools.end())
+    auto pool = findPool(hostAndPort);
+    if (!pool)
         return;
 
-    auto pool = iter->second;
+    auto lk = pool->lock();
     pool->processFailure(Status(ErrorCodes::PooledConnectionsDropped, "Pooled connections dropped"),
                          std::move(lk));
 }
@@ -319,7 +336,7 @@ void ConnectionPool::dropConnections(transport::Session::TagMask tags) {
     for (const auto& pair : pools) {
         auto& pool = pair.second;
 
-        stdx::unique_lock<stdx::mutex> lk(_mutex);
+        auto lk = pool->lock();
         if (pool->matchesTags(lk, tags))
             continue;
 
@@ -332,14 +349,11 @@ void ConnectionPool::dropConnections(transport::Session::TagMask tags) {
 void ConnectionPool::mutateTags(
     const HostAndPort& hostAndPort,
     const stdx::function<transport::Session::TagMask(transport::Session::TagMask)>& mutateFunc) {
-    stdx::unique_lock<stdx::mutex> lk(_mutex);
-
-    auto iter = _pools.find(hostAndPort);
-
-    if (iter == _pools.end())
+    auto pool = findPool(hostAndPort);
+    if (!pool)
         return;
 
-    auto pool = iter->second;
+    auto lk = pool->lock();
     pool->mutateTags(lk, mutateFunc);
 }
 
@@ -351,31 +365,55 @@ void ConnectionPool::get(const HostAndPort& hostAndPort,
 
 Future<ConnectionPool::ConnectionHandle> ConnectionPool::get(const HostAndPort& hostAndPort,
                                                              Milliseconds timeout) {
-    std::shared_ptr<SpecificPool> pool;
+    while (true) {
+        auto pool = [&] {
+            stdx::lock_guard<stdx::mutex> lk(_mutex);
 
-    stdx::unique_lock<stdx::mutex> lk(_mutex);
+            auto& pool = _pools[hostAndPort];
+            if (!pool) {
+                pool = std::make_shared<SpecificPool>(this, hostAndPort);
+            }
+            return pool;
+        }();
 
-    auto iter = _pools.find(hostAndPort);
+        auto lk = pool->lock();
+        if (!pool->inShutdown(lk)) {
+            return pool->getConnection(hostAndPort, timeout, std::move(lk));
+        }
 
-    if (iter == _pools.end()) {
-        pool = stdx::make_unique<SpecificPool>(this, hostAndPort);
-        _pools[hostAndPort] = pool;
-    } else {
-        pool = iter->second;
+        // The pool shut down after we found it, but may not have delisted itself yet because
+        // connections are still being refreshed. Replace it rather than waiting for it to drain.
+        stdx::lock_guard<stdx::mutex> parentLk(_mutex);
+        auto iter = _pools.find(hostAndPort);
+        if (iter != _pools.end() && iter->second == pool) {
+            _pools.erase(iter);
+        }
     }
+}
 
-    invariant(pool);
+std::shared_ptr<ConnectionPool::SpecificPool> ConnectionPool::findPool(
+    const HostAndPort& hostAndPort) const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
 
-    return pool->getConnection(hostAndPort, timeout, std::move(lk));
+    auto iter = _pools.find(hostAndPort);
+    if (iter == _pools.end())
+        return nullptr;
+
+    return iter->second;
 }
 
 void ConnectionPool::appendConnectionStats(ConnectionPoolStats* stats) const {
-    stdx::unique_lock<stdx::mutex> lk(_mutex);
+    // Grab all current pools (under the lock)
+    auto pools = [&] {
+        stdx::unique_lock<stdx::mutex> lk(_mutex);
+        return _pools;
+    }();
 
-    for (const auto& kv : _pools) {
+    for (const auto& kv : pools) {
         HostAndPort host = kv.first;
 
         auto& pool = kv.second;
+        auto lk = pool->lock();
         ConnectionStatsPer hostStats{pool->inUseConnections(lk),
                                      pool->availableConnections(lk),
                                      pool->createdConnections(lk),
@@ -385,25 +423,22 @@ void ConnectionPool::appendConnectionStats(ConnectionPoolStats* stats) const {
 }
 
 size_t ConnectionPool::getNumConnectionsPerHost(const HostAndPort& hostAndPort) const {
-    stdx::unique_lock<stdx::mutex> lk(_mutex);
-    auto iter = _pools.find(hostAndPort);
-    if (iter != _pools.end()) {
-        return iter->second->openConnections(lk);
-    }
+    auto pool = findPool(hostAndPort);
+    if (!pool)
+        return 0;
 
-    return 0;
+    auto lk = pool->lock();
+    return pool->openConnections(lk);
 }
 
 void ConnectionPool::returnConnection(ConnectionInterface* conn) {
-    stdx::unique_lock<stdx::mutex> lk(_mutex);
-
-    auto iter = _pools.find(conn->getHostAndPort());
+    auto pool = findPool(conn->getHostAndPort());
 
-    invariant(iter != _pools.end(),
+    invariant(pool,
               str::stream() << "Tried to return connection but no pool found for "
                             << conn->getHostAndPort());
 
-    auto pool = iter->second;
+    auto lk = pool->lock();
     pool->returnConnection(conn, std::move(lk));
 }
 
@@ -806,7 +841,13 @@ void ConnectionPool::SpecificPool::updateStateInLock() {
         if (_processingPool.empty() && !_activeClients) {
             // If we have no more clients that require access to us, delist from the parent pool
             LOG(2) << "Delisting connection pool for " << _hostAndPort;
-            _parent->_pools.erase(_hostAndPort);
+
+            // ConnectionPool::get() may already have replaced this pool with a new one.
+            stdx::lock_guard<stdx::mutex> parentLk(_parent->_mutex);
+            auto iter = _parent->_pools.find(_hostAndPort);
+            if (iter != _parent->_pools.end() && iter->second.get() == this) {
+                _parent->_pools.erase(iter);
+            }
         }
         return;
     }
@@ -876,7 +917,7 @@ void ConnectionPool::SpecificPool::updateStateInLock() {
 
         // Set the shutdown timer, this gets reset on any request
         _requestTimer->setTimeout(timeout, [ this, anchor = shared_from_this() ]() {
-            stdx::unique_lock<stdx::mutex> lk(anchor->_parent->_mutex);
+            stdx::unique_lock<stdx::mutex> lk(anchor->_mutex);
             if (_state != State::kIdle)
                 return;
 
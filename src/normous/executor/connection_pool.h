@@ -157,6 +157,11 @@ public:
 private:
     void returnConnection(ConnectionInterface* connection);
 
+    /**
+     * Returns the specific pool for the given host, or nullptr if there is none.
+     */
+    std::shared_ptr<SpecificPool> findPool(const HostAndPort& hostAndPort) const;
+
     std::string _name;
 
     // Options are set at startup and never changed at run time, so these are
@@ -165,7 +170,8 @@ private:
 
     const std::shared_ptr<DependentTypeFactoryInterface> _factory;
 
-    // The global mutex for specific pool access and the generation counter
+    // Protects the map of specific pools. The state of each specific pool is protected by that
+    // pool's own mutex, which must never be acquired while holding this one.
     mutable stdx::mutex _mutex;
     stdx::unordered_map<HostAndPort, std::shared_ptr<SpecificPool>> _pools;
 
@@ -219,7 +219,7 @@ Status NetworkInterfaceTL::startCommand(const TaskExecutor::CallbackHandle& cbHa
     // return on the reactor thread.
     //
     // TODO: get rid of this cruft once we have a connection pool that's executor aware.
-    auto connFuture = _reactor->execute([this, state, request, baton] {
+    auto getConnection = [this, state, request, baton] {
         return makeReadyFutureWith(
                    [this, request] { return _pool->get(request.target, request.timeout); })
             .tapError([state](Status error) {
@@ -233,7 +233,17 @@ Status NetworkInterfaceTL::startCommand(const TaskExecutor::CallbackHandle& cbHa
                 return std::make_shared<CommandState::ConnHandle>(
                     conn.release(), CommandState::Deleter{deleter, _reactor});
             });
-    });
+    };
+
+    // Commands started from the completion of other commands (as scatter-gather continuations
+    // running on a NetworkInterfaceThreadPool are) are already on the reactor thread, so they can
+    // get their connection without paying for another trip through the reactor's queue.
+    auto connFuture = [&]() -> Future<std::shared_ptr<CommandState::ConnHandle>> {
+        if (_reactor->onReactorThread()) {
+            return getConnection();
+        }
+        return _reactor->execute(std::move(getConnection));
+    }();
 
     auto remainingWork = [ this, state, future = std::move(pf.future), baton, onFinish ](
         StatusWith<std::shared_ptr<CommandState::ConnHandle>> swConn) mutable {
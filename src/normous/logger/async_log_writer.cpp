@@ -0,0 +1,152 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/logger/async_log_writer.h"
+
+#include "mongo/logger/message_event.h"
+#include "mongo/logger/message_event_utf8_encoder.h"
+#include "mongo/logger/rotatable_file_writer.h"
+#include "mongo/util/concurrency/thread_name.h"
+#include "mongo/util/mongoutils/str.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+namespace logger {
+
+AsyncLogWriter::AsyncLogWriter(RotatableFileWriter* writer, size_t maxQueuedBytes)
+    : _writer(writer), _maxQueuedBytes(maxQueuedBytes), _thread([this] { _writerLoop(); }) {}
+
+AsyncLogWriter::~AsyncLogWriter() {
+    shutdown();
+}
+
+Counter64& AsyncLogWriter::droppedMessages() {
+    static Counter64 droppedMessages;
+    return droppedMessages;
+}
+
+Status AsyncLogWriter::write(std::string message, bool waitUntilWritten) {
+    stdx::unique_lock<stdx::mutex> lk(_mutex);
+
+    if (_inShutdown) {
+        // Keep messages in order by letting the last queued ones be written first.
+        _messagesWritten.wait(lk, [&] { return _numWritten == _numQueued; });
+        lk.unlock();
+
+        return _writeMessages({std::move(message)}, 0);
+    }
+
+    if (!waitUntilWritten && _queuedBytes + message.size() > _maxQueuedBytes) {
+        ++_numDroppedUnreported;
+        droppedMessages().increment();
+        return Status::OK();
+    }
+
+    _queuedBytes += message.size();
+    _queue.push_back(std::move(message));
+    const auto messageNumber = ++_numQueued;
+    _messagesQueued.notify_one();
+
+    if (waitUntilWritten) {
+        _messagesWritten.wait(lk, [&] { return _numWritten >= messageNumber; });
+    }
+    return _lastWriteStatus;
+}
+
+void AsyncLogWriter::shutdown() {
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        if (_inShutdown) {
+            return;
+        }
+        _inShutdown = true;
+        _messagesQueued.notify_one();
+    }
+    _thread.join();
+}
+
+void AsyncLogWriter::_writerLoop() {
+    setThreadName("AsyncLogWriter");
+
+    stdx::unique_lock<stdx::mutex> lk(_mutex);
+    while (true) {
+        _messagesQueued.wait(
+            lk, [&] { return _inShutdown || !_queue.empty() || _numDroppedUnreported > 0; });
+        if (_queue.empty() && _numDroppedUnreported == 0) {
+            return;
+        }
+
+        std::deque<std::string> messages;
+        messages.swap(_queue);
+        _queuedBytes = 0;
+        const auto numDropped = _numDroppedUnreported;
+        _numDroppedUnreported = 0;
+        const auto lastMessageNumber = _numQueued;
+
+        lk.unlock();
+        Status status = _writeMessages(messages, numDropped);
+        lk.lock();
+
+        _lastWriteStatus = std::move(status);
+        _numWritten = lastMessageNumber;
+        _messagesWritten.notify_all();
+    }
+}
+
+Status AsyncLogWriter::_writeMessages(const std::deque<std::string>& messages,
+                                      long long numDropped) {
+    RotatableFileWriter::Use useWriter(_writer);
+    Status status = useWriter.status();
+    if (!status.isOK())
+        return status;
+
+    std::ostream& stream = useWriter.stream();
+    for (const auto& message : messages) {
+        stream.write(message.data(), message.size());
+    }
+
+    if (numDropped > 0) {
+        const std::string note = str::stream()
+            << "Dropped " << numDropped
+            << " log messages because the log file could not keep up with them";
+        MessageEventDetailsEncoder().encode(MessageEventEphemeral(Date_t::now(),
+                                                                  LogSeverity::Warning(),
+                                                                  LogComponent::kControl,
+                                                                  "AsyncLogWriter",
+                                                                  note),
+                                            stream);
+    }
+
+    stream.flush();
+    return useWriter.status();
+}
+
+}  // namespace logger
+}  // namespace mongo
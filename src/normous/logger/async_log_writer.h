@@ -0,0 +1,118 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+
+#include "mongo/base/counter.h"
+#include "mongo/base/disallow_copying.h"
+#include "mongo/base/status.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
+
+namespace mongo {
+namespace logger {
+
+class RotatableFileWriter;
+
+/**
+ * Writes formatted log messages to a RotatableFileWriter from a background thread, so that
+ * threads which log do not wait for the log file.
+ *
+ * Queued messages are bounded by their total size. A message which would exceed the bound is
+ * dropped and counted, and once the writer catches up it logs how many messages it dropped.
+ * Callers may instead wait until their message has been written, in which case it is never
+ * dropped; messages of severity Error and above are logged that way, so that they are on disk
+ * before a failing process exits.
+ *
+ * After shutdown(), messages are written synchronously by the threads that log them.
+ */
+class AsyncLogWriter {
+    MONGO_DISALLOW_COPYING(AsyncLogWriter);
+
+public:
+    /**
+     * Starts a writer for "writer", which must outlive it.
+     */
+    AsyncLogWriter(RotatableFileWriter* writer, size_t maxQueuedBytes);
+
+    ~AsyncLogWriter();
+
+    /**
+     * Queues "message" for writing, or drops it if the queue is full. If "waitUntilWritten" is
+     * true, the message is always queued, and this blocks until it has been written.
+     *
+     * Returns the status of the most recent write to the file, which for a caller that does not
+     * wait is not necessarily the write of its own message.
+     */
+    Status write(std::string message, bool waitUntilWritten);
+
+    /**
+     * Writes out everything queued and stops the background thread.
+     */
+    void shutdown();
+
+    /**
+     * Messages dropped by every AsyncLogWriter in this process.
+     */
+    static Counter64& droppedMessages();
+
+private:
+    void _writerLoop();
+
+    Status _writeMessages(const std::deque<std::string>& messages, long long numDropped);
+
+    RotatableFileWriter* const _writer;
+    const size_t _maxQueuedBytes;
+
+    stdx::mutex _mutex;
+    stdx::condition_variable _messagesQueued;
+    stdx::condition_variable _messagesWritten;
+
+    std::deque<std::string> _queue;
+    size_t _queuedBytes = 0;
+
+    // Messages queued and written since construction, for callers waiting on their message.
+    std::uint64_t _numQueued = 0;
+    std::uint64_t _numWritten = 0;
+
+    // Messages dropped since the writer last reported doing so.
+    long long _numDroppedUnreported = 0;
+
+    Status _lastWriteStatus = Status::OK();
+    bool _inShutdown = false;
+
+    stdx::thread _thread;
+};
+
+}  // namespace logger
+}  // namespace mongo
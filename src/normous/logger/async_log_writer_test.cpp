@@ -0,0 +1,125 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <fstream>
+#include <vector>
+
+#include "mongo/logger/async_log_writer.h"
+#include "mongo/logger/rotatable_file_writer.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace {
+using namespace mongo;
+using namespace mongo::logger;
+
+const std::string logFileName("LogTest_AsyncLogWriter.txt");
+
+class AsyncLogWriterTest : public mongo::unittest::Test {
+public:
+    AsyncLogWriterTest() {
+        unlink(logFileName.c_str());
+    }
+
+    virtual ~AsyncLogWriterTest() {
+        unlink(logFileName.c_str());
+    }
+
+    std::vector<std::string> readLogLines() {
+        std::vector<std::string> lines;
+        std::ifstream ifs(logFileName.c_str());
+        ASSERT_TRUE(ifs.is_open());
+        std::string input;
+        while (std::getline(ifs, input)) {
+            lines.push_back(input);
+        }
+        return lines;
+    }
+};
+
+TEST_F(AsyncLogWriterTest, WritesMessagesInOrder) {
+    RotatableFileWriter writer;
+    ASSERT_OK(RotatableFileWriter::Use(&writer).setFileName(logFileName, false));
+
+    {
+        AsyncLogWriter asyncWriter(&writer, 1024 * 1024);
+        for (int i = 0; i < 100; ++i) {
+            ASSERT_OK(asyncWriter.write(str::stream() << "message " << i << '\n', false));
+        }
+        ASSERT_OK(asyncWriter.write("last message\n", true));
+        asyncWriter.shutdown();
+
+        // Writes after shutdown go straight to the file.
+        ASSERT_OK(asyncWriter.write("after shutdown\n", false));
+    }
+
+    auto lines = readLogLines();
+    ASSERT_EQUALS(lines.size(), 102U);
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQUALS(lines[i], std::string(str::stream() << "message " << i));
+    }
+    ASSERT_EQUALS(lines[100], "last message");
+    ASSERT_EQUALS(lines[101], "after shutdown");
+}
+
+TEST_F(AsyncLogWriterTest, DropsMessagesBeyondTheBoundAndReportsThem) {
+    RotatableFileWriter writer;
+    ASSERT_OK(RotatableFileWriter::Use(&writer).setFileName(logFileName, false));
+
+    const long long droppedBefore = AsyncLogWriter::droppedMessages().get();
+    const int numMessages = 100;
+    {
+        AsyncLogWriter asyncWriter(&writer, 64);
+        {
+            // Holding the file keeps the background thread from writing, so the queue fills.
+            RotatableFileWriter::Use blockWriter(&writer);
+            for (int i = 0; i < numMessages; ++i) {
+                asyncWriter.write("message\n", false).transitional_ignore();
+            }
+        }
+        asyncWriter.shutdown();
+    }
+    const long long numDropped = AsyncLogWriter::droppedMessages().get() - droppedBefore;
+    ASSERT_GT(numDropped, 0);
+
+    long long numWritten = 0;
+    bool sawDroppedNote = false;
+    for (const auto& line : readLogLines()) {
+        if (line == "message") {
+            ++numWritten;
+        } else if (line.find("Dropped ") != std::string::npos) {
+            sawDroppedNote = true;
+        }
+    }
+    ASSERT_TRUE(sawDroppedNote);
+    ASSERT_EQUALS(numWritten + numDropped, numMessages);
+}
+
+}  // namespace
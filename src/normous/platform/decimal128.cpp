@@ -173,6 +173,130 @@ BID_UINT128 decimal128ToLibraryType(Decimal128::Value value) {
     dec128.w[kHigh64] = value.high64;
     return dec128;
 }
+
+/**
+ * Finite values that share an exponent, such as amounts with a fixed number of decimal places,
+ * can be added, subtracted and compared exactly with 128-bit integer arithmetic on their
+ * coefficients. The helpers below implement those cases and return false whenever the result
+ * would need rounding or special value handling, so that the caller falls back on the library.
+ */
+const std::uint64_t kMaxCoefficientHigh = 0x1ed09bead87c0;
+const std::uint64_t kMaxCoefficientLow = 0x378d8e63ffffffff;
+
+struct FastPathOperand {
+    bool isZero() const {
+        return high == 0 && low == 0;
+    }
+
+    bool negative;
+    std::uint32_t exponent;
+    std::uint64_t high;
+    std::uint64_t low;
+};
+
+bool coefficientLess(const FastPathOperand& lhs, const FastPathOperand& rhs) {
+    return lhs.high < rhs.high || (lhs.high == rhs.high && lhs.low < rhs.low);
+}
+
+bool exceedsMaxCoefficient(std::uint64_t high, std::uint64_t low) {
+    return high > kMaxCoefficientHigh || (high == kMaxCoefficientHigh && low > kMaxCoefficientLow);
+}
+
+/**
+ * Decomposes 'value', returning false for NaN, infinity and any encoding the fast paths do not
+ * handle.
+ */
+bool toFastPathOperand(const Decimal128& value, FastPathOperand* out) {
+    const auto exponent = value.getBiasedExponent();
+    const auto high = value.getCoefficientHigh();
+    const auto low = value.getCoefficientLow();
+    if (exponent > Decimal128::kMaxBiasedExponent || exceedsMaxCoefficient(high, low)) {
+        return false;
+    }
+
+    *out = {(value.getValue().high64 >> 63) != 0, exponent, high, low};
+    return true;
+}
+
+Decimal128 fromFastPathOperand(const FastPathOperand& operand) {
+    return Decimal128(operand.negative ? 1 : 0, operand.exponent, operand.high, operand.low);
+}
+
+bool tryFastAdd(const Decimal128& lhs,
+                const Decimal128& rhs,
+                bool negateRhs,
+                Decimal128* result) {
+    FastPathOperand a;
+    FastPathOperand b;
+    if (!toFastPathOperand(lhs, &a) || !toFastPathOperand(rhs, &b)) {
+        return false;
+    }
+    b.negative = b.negative != negateRhs;
+
+    // Adding a zero whose exponent is no smaller leaves the other operand unchanged. This covers
+    // accumulating into a default constructed total.
+    if (b.isZero() && !a.isZero() && a.exponent <= b.exponent) {
+        *result = fromFastPathOperand(a);
+        return true;
+    }
+    if (a.isZero() && !b.isZero() && b.exponent <= a.exponent) {
+        *result = fromFastPathOperand(b);
+        return true;
+    }
+
+    if (a.exponent != b.exponent) {
+        return false;
+    }
+
+    if (a.negative == b.negative) {
+        const std::uint64_t low = a.low + b.low;
+        const std::uint64_t high = a.high + b.high + (low < a.low ? 1 : 0);
+        if (exceedsMaxCoefficient(high, low)) {
+            return false;
+        }
+        *result = fromFastPathOperand({a.negative, a.exponent, high, low});
+        return true;
+    }
+
+    // The sign of an exact zero difference depends on the rounding mode.
+    if (a.high == b.high && a.low == b.low) {
+        return false;
+    }
+
+    const auto& larger = coefficientLess(a, b) ? b : a;
+    const auto& smaller = coefficientLess(a, b) ? a : b;
+    const std::uint64_t low = larger.low - smaller.low;
+    const std::uint64_t high = larger.high - smaller.high - (larger.low < smaller.low ? 1 : 0);
+    *result = fromFastPathOperand({larger.negative, a.exponent, high, low});
+    return true;
+}
+
+/**
+ * Sets 'cmp' to the sign of lhs - rhs when it can be determined without aligning exponents.
+ */
+bool tryFastCompare(const Decimal128& lhs, const Decimal128& rhs, int* cmp) {
+    FastPathOperand a;
+    FastPathOperand b;
+    if (!toFastPathOperand(lhs, &a) || !toFastPathOperand(rhs, &b)) {
+        return false;
+    }
+
+    if (a.isZero() && b.isZero()) {
+        *cmp = 0;
+    } else if (a.isZero()) {
+        *cmp = b.negative ? 1 : -1;
+    } else if (b.isZero() || a.negative != b.negative) {
+        *cmp = a.negative ? -1 : 1;
+    } else if (a.exponent != b.exponent) {
+        return false;
+    } else if (a.high == b.high && a.low == b.low) {
+        *cmp = 0;
+    } else {
+        const int magnitudeCmp = coefficientLess(a, b) ? -1 : 1;
+        *cmp = a.negative ? -magnitudeCmp : magnitudeCmp;
+    }
+    return true;
+}
 }  // namespace
 
 Decimal128::Decimal128(std::int32_t int32Value)
@@ -565,6 +689,11 @@ Decimal128 Decimal128::add(const Decimal128& other, RoundingMode roundMode) cons
 Decimal128 Decimal128::add(const Decimal128& other,
                            std::uint32_t* signalingFlags,
                            RoundingMode roundMode) const {
+    Decimal128 exact;
+    if (tryFastAdd(*this, other, false, &exact)) {
+        return exact;
+    }
+
     BID_UINT128 current = decimal128ToLibraryType(_value);
     BID_UINT128 addend = decimal128ToLibraryType(other.getValue());
     current = bid128_add(current, addend, roundMode, signalingFlags);
@@ -581,6 +710,11 @@ Decimal128 Decimal128::subtract(const Decimal128& other, RoundingMode roundMode)
 Decimal128 Decimal128::subtract(const Decimal128& other,
                                 std::uint32_t* signalingFlags,
                                 RoundingMode roundMode) const {
+    Decimal128 exact;
+    if (tryFastAdd(*this, other, true, &exact)) {
+        return exact;
+    }
+
     BID_UINT128 current = decimal128ToLibraryType(_value);
     BID_UINT128 sub = decimal128ToLibraryType(other.getValue());
     current = bid128_sub(current, sub, roundMode, signalingFlags);
@@ -726,6 +860,11 @@ Decimal128 Decimal128::squareRoot(std::uint32_t* signalingFlags, RoundingMode ro
 }
 
 bool Decimal128::isEqual(const Decimal128& other) const {
+    int cmp;
+    if (tryFastCompare(*this, other, &cmp)) {
+        return cmp == 0;
+    }
+
     std::uint32_t throwAwayFlag = 0;
     BID_UINT128 current = decimal128ToLibraryType(_value);
     BID_UINT128 compare = decimal128ToLibraryType(other.getValue());
@@ -733,6 +872,11 @@ bool Decimal128::isEqual(const Decimal128& other) const {
 }
 
 bool Decimal128::isNotEqual(const Decimal128& other) const {
+    int cmp;
+    if (tryFastCompare(*this, other, &cmp)) {
+        return cmp != 0;
+    }
+
     std::uint32_t throwAwayFlag = 0;
     BID_UINT128 current = decimal128ToLibraryType(_value);
     BID_UINT128 compare = decimal128ToLibraryType(other.getValue());
@@ -740,6 +884,11 @@ bool Decimal128::isNotEqual(const Decimal128& other) const {
 }
 
 bool Decimal128::isGreater(const Decimal128& other) const {
+    int cmp;
+    if (tryFastCompare(*this, other, &cmp)) {
+        return cmp > 0;
+    }
+
     std::uint32_t throwAwayFlag = 0;
     BID_UINT128 current = decimal128ToLibraryType(_value);
     BID_UINT128 compare = decimal128ToLibraryType(other.getValue());
@@ -747,6 +896,11 @@ bool Decimal128::isGreater(const Decimal128& other) const {
 }
 
 bool Decimal128::isGreaterEqual(const Decimal128& other) const {
+    int cmp;
+    if (tryFastCompare(*this, other, &cmp)) {
+        return cmp >= 0;
+    }
+
     std::uint32_t throwAwayFlag = 0;
     BID_UINT128 current = decimal128ToLibraryType(_value);
     BID_UINT128 compare = decimal128ToLibraryType(other.getValue());
@@ -754,6 +908,11 @@ bool Decimal128::isGreaterEqual(const Decimal128& other) const {
 }
 
 bool Decimal128::isLess(const Decimal128& other) const {
+    int cmp;
+    if (tryFastCompare(*this, other, &cmp)) {
+        return cmp < 0;
+    }
+
     std::uint32_t throwAwayFlag = 0;
     BID_UINT128 current = decimal128ToLibraryType(_value);
     BID_UINT128 compare = decimal128ToLibraryType(other.getValue());
@@ -761,6 +920,11 @@ bool Decimal128::isLess(const Decimal128& other) const {
 }
 
 bool Decimal128::isLessEqual(const Decimal128& other) const {
+    int cmp;
+    if (tryFastCompare(*this, other, &cmp)) {
+        return cmp <= 0;
+    }
+
     std::uint32_t throwAwayFlag = 0;
     BID_UINT128 current = decimal128ToLibraryType(_value);
     BID_UINT128 compare = decimal128ToLibraryType(other.getValue());
@@ -1027,6 +1027,75 @@ TEST(Decimal128Test, TestDecimal128SubtractionCase2) {
     ASSERT_EQUALS(result.getValue().high64, expected.getValue().high64);
 }
 
+void assertIdentical(const Decimal128& expected, const Decimal128& actual) {
+    ASSERT_EQUALS(expected.getValue().low64, actual.getValue().low64);
+    ASSERT_EQUALS(expected.getValue().high64, actual.getValue().high64);
+}
+
+TEST(Decimal128Test, TestDecimal128SameExponentAddition) {
+    assertIdentical(Decimal128("30.75"), Decimal128("10.25").add(Decimal128("20.50")));
+    assertIdentical(Decimal128("-30.75"), Decimal128("-10.25").add(Decimal128("-20.50")));
+    assertIdentical(Decimal128("-10.25"), Decimal128("10.25").add(Decimal128("-20.50")));
+    assertIdentical(Decimal128("10.25"), Decimal128("-10.25").add(Decimal128("20.50")));
+
+    // Carry out of the low 64 bits of the coefficient.
+    assertIdentical(Decimal128("18446744073709551616"),
+                    Decimal128("18446744073709551615").add(Decimal128("1")));
+}
+
+TEST(Decimal128Test, TestDecimal128SameExponentSubtraction) {
+    assertIdentical(Decimal128("-10.25"), Decimal128("10.25").subtract(Decimal128("20.50")));
+    assertIdentical(Decimal128("30.75"), Decimal128("10.25").subtract(Decimal128("-20.50")));
+
+    // Borrow from the high 64 bits of the coefficient.
+    assertIdentical(Decimal128("18446744073709551615"),
+                    Decimal128("18446744073709551616").subtract(Decimal128("1")));
+}
+
+TEST(Decimal128Test, TestDecimal128SameExponentAdditionRoundsOnOverflow) {
+    Decimal128 nines("9999999999999999999999999999999999");
+    uint32_t sigFlags = Decimal128::SignalingFlag::kNoFlag;
+    Decimal128 result = nines.add(Decimal128(1), &sigFlags);
+    assertIdentical(Decimal128("1.000000000000000000000000000000000E34"), result);
+    ASSERT_TRUE(Decimal128::hasFlag(sigFlags, Decimal128::SignalingFlag::kInexact));
+}
+
+TEST(Decimal128Test, TestDecimal128ExactZeroDifferenceFollowsRoundingMode) {
+    Decimal128 d("12.34");
+    assertIdentical(Decimal128("0.00"), d.subtract(d));
+    assertIdentical(Decimal128("-0.00"), d.subtract(d, Decimal128::kRoundTowardNegative));
+}
+
+TEST(Decimal128Test, TestDecimal128AddingZeroKeepsOperand) {
+    assertIdentical(Decimal128("12.34"), Decimal128().add(Decimal128("12.34")));
+    assertIdentical(Decimal128("-12.34"), Decimal128("-12.34").add(Decimal128()));
+    assertIdentical(Decimal128("12.34"), Decimal128("12.34").subtract(Decimal128("-0")));
+
+    // A zero with a smaller exponent sets the exponent of the result.
+    assertIdentical(Decimal128("12.340"), Decimal128("12.34").add(Decimal128("0.000")));
+}
+
+TEST(Decimal128Test, TestDecimal128AdditionWithNaNAndInfinity) {
+    ASSERT_TRUE(Decimal128::kPositiveNaN.add(Decimal128("1.00")).isNaN());
+    ASSERT_TRUE(Decimal128::kPositiveInfinity.add(Decimal128("1.00")).isInfinite());
+    ASSERT_TRUE(
+        Decimal128::kPositiveInfinity.subtract(Decimal128::kPositiveInfinity).isNaN());
+}
+
+TEST(Decimal128Test, TestDecimal128SameExponentComparison) {
+    ASSERT_TRUE(Decimal128("10.25").isLess(Decimal128("20.50")));
+    ASSERT_TRUE(Decimal128("-20.50").isLess(Decimal128("-10.25")));
+    ASSERT_TRUE(Decimal128("-10.25").isLess(Decimal128("10.25")));
+    ASSERT_TRUE(Decimal128("10.25").isGreaterEqual(Decimal128("10.25")));
+    ASSERT_TRUE(Decimal128("10.25").isNotEqual(Decimal128("-10.25")));
+    ASSERT_TRUE(Decimal128("0.00").isEqual(Decimal128("-0")));
+    ASSERT_TRUE(Decimal128("-0.01").isLess(Decimal128("0")));
+    ASSERT_TRUE(Decimal128("0.01").isGreater(Decimal128("-0E10")));
+    ASSERT_FALSE(Decimal128::kPositiveNaN.isEqual(Decimal128::kPositiveNaN));
+    ASSERT_TRUE(Decimal128::kPositiveNaN.isNotEqual(Decimal128("1.00")));
+    ASSERT_TRUE(Decimal128::kNegativeInfinity.isLess(Decimal128("-1.00")));
+}
+
 TEST(Decimal128Test, TestDecimal128MultiplicationCase1) {
     Decimal128 d1("25.05E20");
     Decimal128 d2("-50.5218E19");
@@ -36,6 +36,7 @@
 #include <set>
 
 #include "mongo/base/data_type_endian.h"
+#include "mongo/base/data_view.h"
 #include "mongo/db/bson/dotted_path_support.h"
 #include "mongo/rpc/object_check.h"
 #include "mongo/util/bufreader.h"
@@ -57,6 +58,25 @@ enum class Section : uint8_t {
     kDocSequence = 1,
 };
 
+/**
+ * Counts the documents in a document sequence by following their length prefixes, without
+ * validating them, so that the vector holding them can be sized once. Counting stops at the first
+ * length that doesn't fit, which the validating parse will then reject.
+ */
+size_t countSequenceDocuments(const char* data, size_t length) {
+    size_t count = 0;
+    while (length >= sizeof(int32_t)) {
+        const auto size = ConstDataView(data).read<LittleEndian<int32_t>>();
+        if (size < BSONObj::kMinBSONLength || size_t(size) > length) {
+            break;
+        }
+        data += size;
+        length -= size;
+        count++;
+    }
+    return count;
+}
+
 }  // namespace
 
 uint32_t OpMsg::flags(const Message& message) {
@@ -125,6 +145,8 @@ OpMsg OpMsg::parse(const Message& message) try {
                         !msg.getSequence(name));  // TODO IDL
 
                 msg.sequences.push_back({name.toString()});
+                msg.sequences.back().objs.reserve(countSequenceDocuments(
+                    static_cast<const char*>(seqBuf.pos()), seqBuf.remaining()));
                 while (!seqBuf.atEof()) {
                     msg.sequences.back().objs.push_back(seqBuf.read<Validated<BSONObj>>());
                 }
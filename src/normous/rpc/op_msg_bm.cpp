@@ -0,0 +1,127 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/rpc/op_msg.h"
+
+namespace mongo {
+namespace {
+
+BSONObj makeDocument(int i) {
+    return BSON("_id" << i << "name"
+                      << "benchmark"
+                      << "value"
+                      << i * 2
+                      << "nested"
+                      << BSON("a" << 1 << "b" << 2));
+}
+
+// An insert command carrying 'numDocs' documents in a kind 1 'documents' section, as drivers send
+// batched writes.
+Message makeInsert(int numDocs) {
+    OpMsgBuilder builder;
+    {
+        auto docs = builder.beginDocSequence("documents");
+        for (int i = 0; i < numDocs; ++i) {
+            docs.append(makeDocument(i));
+        }
+    }
+    builder.setBody(BSON("insert"
+                         << "coll"
+                         << "$db"
+                         << "test"));
+    return builder.finish();
+}
+
+void BM_OpMsgParseCommand(benchmark::State& state) {
+    const auto message = OpMsg{BSON("find"
+                                    << "coll"
+                                    << "filter"
+                                    << BSON("a" << 1)
+                                    << "$db"
+                                    << "test")}
+                             .serialize();
+    for (auto keepRunning : state) {
+        benchmark::DoNotOptimize(OpMsg::parse(message));
+    }
+}
+
+void BM_OpMsgParseDocSequence(benchmark::State& state) {
+    const auto message = makeInsert(state.range(0));
+    for (auto keepRunning : state) {
+        benchmark::DoNotOptimize(OpMsg::parse(message));
+    }
+    state.SetBytesProcessed(state.iterations() * message.size());
+}
+
+void BM_OpMsgSerializeCommand(benchmark::State& state) {
+    const OpMsg msg{BSON("find"
+                         << "coll"
+                         << "filter"
+                         << BSON("a" << 1)
+                         << "$db"
+                         << "test")};
+    for (auto keepRunning : state) {
+        benchmark::DoNotOptimize(msg.serialize());
+    }
+}
+
+void BM_OpMsgSerializeDocSequence(benchmark::State& state) {
+    OpMsg msg;
+    msg.body = BSON("insert"
+                    << "coll"
+                    << "$db"
+                    << "test");
+    OpMsg::DocumentSequence sequence{"documents", {}};
+    for (int i = 0; i < state.range(0); ++i) {
+        sequence.objs.push_back(makeDocument(i));
+    }
+    msg.sequences.push_back(std::move(sequence));
+    for (auto keepRunning : state) {
+        benchmark::DoNotOptimize(msg.serialize());
+    }
+}
+
+void BM_OpMsgBuildDocSequence(benchmark::State& state) {
+    for (auto keepRunning : state) {
+        benchmark::DoNotOptimize(makeInsert(state.range(0)));
+    }
+}
+
+BENCHMARK(BM_OpMsgParseCommand);
+BENCHMARK(BM_OpMsgParseDocSequence)->Arg(1)->Arg(100)->Arg(1000);
+BENCHMARK(BM_OpMsgSerializeCommand);
+BENCHMARK(BM_OpMsgSerializeDocSequence)->Arg(1)->Arg(100)->Arg(1000);
+BENCHMARK(BM_OpMsgBuildDocSequence)->Arg(100);
+
+}  // namespace
+}  // namespace mongo
@@ -46,6 +46,8 @@
 #include "mongo/db/repl/optime.h"
 #include "mongo/db/repl/read_concern_args.h"
 #include "mongo/db/repl/repl_client_info.h"
+#include "mongo/db/server_options.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/executor/network_interface.h"
 #include "mongo/rpc/get_status_from_command_result.h"
 #include "mongo/rpc/metadata/repl_set_metadata.h"
@@ -71,6 +73,7 @@
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/net/hostandport.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/time_support.h"
 
 namespace mongo {
@@ -101,6 +104,9 @@ const int kChangeLogCollectionSizeMB = 200 * 1024 * 1024;
 
 const NamespaceString kSettingsNamespace("config", "settings");
 
+// Whether identical concurrent majority reads of the config server share a single request.
+MONGO_EXPORT_SERVER_PARAMETER(coalesceConfigServerReads, bool, true);
+
 void toBatchError(const Status& status, BatchedCommandResponse* response) {
     response->clear();
     response->setStatus(status);
@@ -1019,14 +1025,82 @@ StatusWith<repl::OpTimeWith<vector<BSONObj>>> ShardingCatalogClientImpl::_exhaus
     const BSONObj& query,
     const BSONObj& sort,
     boost::optional<long long> limit) {
-    auto response = Grid::get(opCtx)->shardRegistry()->getConfigShard()->exhaustiveFindOnConfig(
-        opCtx, readPref, readConcern, nss, query, sort, limit);
-    if (!response.isOK()) {
-        return response.getStatus();
+    auto runFind = [&]() -> ConfigFindResult {
+        auto response =
+            Grid::get(opCtx)->shardRegistry()->getConfigShard()->exhaustiveFindOnConfig(
+                opCtx, readPref, readConcern, nss, query, sort, limit);
+        if (!response.isOK()) {
+            return response.getStatus();
+        }
+
+        return repl::OpTimeWith<vector<BSONObj>>(std::move(response.getValue().docs),
+                                                 response.getValue().opTime);
+    };
+
+    // Only majority reads are shared, since they are the only ones which promise no more than to
+    // observe everything up to the config optime, which is part of the key. Config servers read
+    // their own data locally and are left alone.
+    if (!coalesceConfigServerReads.load() ||
+        readConcern != repl::ReadConcernLevel::kMajorityReadConcern ||
+        serverGlobalParams.clusterRole == ClusterRole::ConfigServer || opCtx->getTxnNumber()) {
+        return runFind();
     }
 
-    return repl::OpTimeWith<vector<BSONObj>>(std::move(response.getValue().docs),
-                                             response.getValue().opTime);
+    const auto key = [&] {
+        BSONObjBuilder builder;
+        readPref.toContainingBSON(&builder);
+        Grid::get(opCtx)->configOpTime().append(&builder, "configOpTime");
+        builder.append("ns", nss.ns());
+        builder.append("query", query);
+        builder.append("sort", sort);
+        if (limit) {
+            builder.append("limit", *limit);
+        }
+        auto obj = builder.obj();
+        return std::string(obj.objdata(), obj.objsize());
+    }();
+
+    std::shared_ptr<Notification<ConfigFindResult>> inFlight;
+    bool isLeader = false;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        auto& entry = _inFlightConfigFinds[key];
+        if (!entry) {
+            entry = std::make_shared<Notification<ConfigFindResult>>();
+            isLeader = true;
+        }
+        inFlight = entry;
+    }
+
+    if (!isLeader) {
+        auto result = inFlight->get(opCtx);
+
+        // The find that was shared failed because of something particular to the operation that
+        // sent it, such as it being killed or running out of time, so send our own.
+        if (!result.isOK() && (ErrorCodes::isInterruption(result.getStatus().code()) ||
+                               ErrorCodes::isExceededTimeLimitError(result.getStatus().code()))) {
+            return runFind();
+        }
+        return result;
+    }
+
+    ConfigFindResult result(
+        Status(ErrorCodes::InternalError, "Shared config server find did not complete"));
+    ON_BLOCK_EXIT([&] {
+        {
+            stdx::lock_guard<stdx::mutex> lk(_mutex);
+            _inFlightConfigFinds.erase(key);
+        }
+        inFlight->set(result);
+    });
+
+    try {
+        result = runFind();
+    } catch (const DBException& ex) {
+        result = ex.toStatus();
+        throw;
+    }
+    return result;
 }
 
 StatusWith<std::vector<KeysCollectionDocument>> ShardingCatalogClientImpl::getNewKeys(
@@ -33,6 +33,8 @@
 #include "mongo/s/catalog/sharding_catalog_client.h"
 #include "mongo/s/client/shard_registry.h"
 #include "mongo/stdx/mutex.h"
+#include "mongo/util/concurrency/notification.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 
@@ -201,6 +203,13 @@ private:
                                          int cappedSize,
                                          const WriteConcernOptions& writeConcern);
 
+    using ConfigFindResult = StatusWith<repl::OpTimeWith<std::vector<BSONObj>>>;
+
+    /**
+     * Runs the find against the config server. Majority reads which are identical to one already
+     * in flight (including the config optime they must read after) wait for and share that read's
+     * result instead of sending their own.
+     */
     StatusWith<repl::OpTimeWith<std::vector<BSONObj>>> _exhaustiveFindOnConfig(
         OperationContext* opCtx,
         const ReadPreferenceSetting& readPref,
@@ -253,6 +262,10 @@ private:
     // Distributed lock manager singleton.
     std::unique_ptr<DistLockManager> _distLockManager;  // (R)
 
+    // Config server finds currently in flight, keyed by everything that determines their result.
+    // Identical finds started meanwhile wait on the notification instead of being sent again.
+    StringMap<std::shared_ptr<Notification<ConfigFindResult>>> _inFlightConfigFinds;  // (M)
+
     // True if shutDown() has been called. False, otherwise.
     bool _inShutdown = false;  // (M)
 
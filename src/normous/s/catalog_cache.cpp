@@ -561,8 +561,14 @@ void CatalogCache::_scheduleCollectionRefresh(WithLock lk,
             StatusWith<CatalogCacheLoader::CollectionAndChangedChunks> swCollAndChunks) noexcept {
         std::shared_ptr<RoutingTableHistory> newRoutingInfo;
         try {
+            auto& routingTableBuildTimeMicros = existingRoutingInfo
+                ? _stats.totalIncrementalRoutingTableUpdateTimeMicros
+                : _stats.totalFullRoutingTableBuildTimeMicros;
+
+            Timer t;
             newRoutingInfo = refreshCollectionRoutingInfo(
                 opCtx, nss, std::move(existingRoutingInfo), std::move(swCollAndChunks));
+            routingTableBuildTimeMicros.addAndFetch(t.micros());
 
             onRefreshCompleted(Status::OK(), newRoutingInfo.get());
         } catch (const DBException& ex) {
@@ -623,6 +629,11 @@ void CatalogCache::Stats::report(BSONObjBuilder* builder) const {
     builder->append("countFullRefreshesStarted", countFullRefreshesStarted.load());
 
     builder->append("countFailedRefreshes", countFailedRefreshes.load());
+
+    builder->append("totalIncrementalRoutingTableUpdateTimeMicros",
+                    totalIncrementalRoutingTableUpdateTimeMicros.load());
+    builder->append("totalFullRoutingTableBuildTimeMicros",
+                    totalFullRoutingTableBuildTimeMicros.load());
 }
 
 CachedDatabaseInfo::CachedDatabaseInfo(DatabaseType dbt, std::shared_ptr<Shard> primaryShard)
@@ -359,6 +359,11 @@ private:
         // for whatever reason
         AtomicInt64 countFailedRefreshes{0};
 
+        // Cumulative, always-increasing counters of how much time incremental and full refreshes
+        // spent building the new routing table, after the changed chunks have been loaded
+        AtomicInt64 totalIncrementalRoutingTableUpdateTimeMicros{0};
+        AtomicInt64 totalFullRoutingTableBuildTimeMicros{0};
+
         /**
          * Reports the accumulated statistics for serverStatus.
          */
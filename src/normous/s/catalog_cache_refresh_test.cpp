@@ -364,6 +364,47 @@ TEST_F(CatalogCacheRefreshTest, ChunkEpochChangeDuringIncrementalLoad) {
     }
 }
 
+TEST_F(CatalogCacheRefreshTest, IncompleteChunksFoundDuringIncrementalLoad) {
+    const ShardKeyPattern shardKeyPattern(BSON("_id" << 1));
+
+    auto initialRoutingInfo(
+        makeChunkManager(kNss, shardKeyPattern, nullptr, true, {BSON("_id" << 0)}));
+    ASSERT_EQ(2, initialRoutingInfo->numChunks());
+
+    auto future = scheduleRoutingInfoRefresh(kNss);
+
+    ChunkVersion version = initialRoutingInfo->getVersion();
+
+    // The changed chunk replaces (MinKey, 0), but leaves (MinKey, -100) uncovered
+    const auto incompleteChunks = [&]() {
+        version.incMajor();
+        ChunkType chunk1(kNss, {BSON("_id" << -100), BSON("_id" << 0)}, version, {"1"});
+
+        return std::vector<BSONObj>{chunk1.toConfigBSON()};
+    }();
+
+    // Return the incomplete diff three times, which is how frequently the catalog cache retries
+    expectGetCollection(initialRoutingInfo->getVersion().epoch(), shardKeyPattern);
+    expectFindSendBSONObjVector(kConfigHostAndPort, incompleteChunks);
+
+    expectGetCollection(initialRoutingInfo->getVersion().epoch(), shardKeyPattern);
+    expectFindSendBSONObjVector(kConfigHostAndPort, incompleteChunks);
+
+    expectGetCollection(initialRoutingInfo->getVersion().epoch(), shardKeyPattern);
+    expectFindSendBSONObjVector(kConfigHostAndPort, incompleteChunks);
+
+    try {
+        auto routingInfo = future.timed_get(kFutureTimeout);
+        auto cm = routingInfo->cm();
+
+        FAIL(str::stream() << "Returning an incomplete diff for collection did not fail and "
+                              "returned "
+                           << (cm ? cm->toString() : routingInfo->db().primaryId().toString()));
+    } catch (const DBException& ex) {
+        ASSERT_EQ(ErrorCodes::ConflictingOperationInProgress, ex.code());
+    }
+}
+
 TEST_F(CatalogCacheRefreshTest, ChunkEpochChangeDuringIncrementalLoadRecoveryAfterRetry) {
     const ShardKeyPattern shardKeyPattern(BSON("_id" << 1));
 
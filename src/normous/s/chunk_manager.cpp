@@ -32,6 +32,8 @@
 
 #include "mongo/s/chunk_manager.h"
 
+#include <algorithm>
+
 #include "mongo/base/owned_pointer_vector.h"
 #include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/matcher/extensions_callback_noop.h"
@@ -69,12 +71,31 @@ std::string extractKeyStringInternal(const BSONObj& shardKeyValue, Ordering orde
 
 }  // namespace
 
+ChunkInfoLookupTable::ChunkInfoLookupTable(const ChunkInfoMap& chunkMap) {
+    _maxKeyStrings.reserve(chunkMap.size());
+    _chunks.reserve(chunkMap.size());
+
+    for (const auto& entry : chunkMap) {
+        _maxKeyStrings.emplace_back(entry.first);
+        _chunks.push_back(entry.second.get());
+    }
+}
+
+ChunkInfo* ChunkInfoLookupTable::upperBound(StringData keyString) const {
+    const auto it = std::upper_bound(_maxKeyStrings.begin(), _maxKeyStrings.end(), keyString);
+    if (it == _maxKeyStrings.end())
+        return nullptr;
+
+    return _chunks[std::distance(_maxKeyStrings.begin(), it)];
+}
+
 RoutingTableHistory::RoutingTableHistory(NamespaceString nss,
                                          boost::optional<UUID> uuid,
                                          KeyPattern shardKeyPattern,
                                          std::unique_ptr<CollatorInterface> defaultCollator,
                                          bool unique,
                                          ChunkInfoMap chunkMap,
+                                         boost::optional<ShardVersionMap> shardVersions,
                                          ChunkVersion collectionVersion)
     : _sequenceNumber(nextCMSequenceNumber.addAndFetch(1)),
       _nss(std::move(nss)),
@@ -84,8 +105,10 @@ RoutingTableHistory::RoutingTableHistory(NamespaceString nss,
       _defaultCollator(std::move(defaultCollator)),
       _unique(unique),
       _chunkMap(std::move(chunkMap)),
-      _shardVersions(
-          _constructShardVersionMap(collectionVersion.epoch(), _chunkMap, _shardKeyOrdering)),
+      _chunkLookupTable(_chunkMap),
+      _shardVersions(shardVersions ? std::move(*shardVersions)
+                                   : _constructShardVersionMap(
+                                         collectionVersion.epoch(), _chunkMap, _shardKeyOrdering)),
       _collectionVersion(collectionVersion) {}
 
 Chunk ChunkManager::findIntersectingChunk(const BSONObj& shardKey, const BSONObj& collation) const {
@@ -100,25 +123,37 @@ Chunk ChunkManager::findIntersectingChunk(const BSONObj& shardKey, const BSONObj
         }
     }
 
-    const auto it = _rt->getChunkMap().upper_bound(_rt->_extractKeyString(shardKey));
+    const auto chunkInfo = _rt->_findChunkByUpperBound(shardKey);
     uassert(ErrorCodes::ShardKeyNotFound,
             str::stream() << "Cannot target single shard using key " << shardKey,
-            it != _rt->getChunkMap().end() && it->second->containsKey(shardKey));
+            chunkInfo && chunkInfo->containsKey(shardKey));
 
-    return Chunk(*(it->second), _clusterTime);
+    return Chunk(*chunkInfo, _clusterTime);
 }
 
 bool ChunkManager::keyBelongsToShard(const BSONObj& shardKey, const ShardId& shardId) const {
     if (shardKey.isEmpty())
         return false;
 
-    const auto it = _rt->getChunkMap().upper_bound(_rt->_extractKeyString(shardKey));
-    if (it == _rt->getChunkMap().end())
+    const auto chunkInfo = _rt->_findChunkByUpperBound(shardKey);
+    if (!chunkInfo)
         return false;
 
-    invariant(it->second->containsKey(shardKey));
+    invariant(chunkInfo->containsKey(shardKey));
 
-    return it->second->getShardIdAt(_clusterTime) == shardId;
+    return chunkInfo->getShardIdAt(_clusterTime) == shardId;
+}
+
+bool ChunkManager::shardOwnsAllChunks(const ShardId& shardId) const {
+    // The shard versions describe the latest owners of the chunks, which may differ from their
+    // owners at '_clusterTime'.
+    if (_clusterTime) {
+        return false;
+    }
+
+    std::set<ShardId> shardIds;
+    _rt->getAllShardIds(&shardIds);
+    return shardIds.size() == 1 && *shardIds.begin() == shardId;
 }
 
 void ChunkManager::getShardIdsForQuery(OperationContext* opCtx,
@@ -491,6 +526,10 @@ std::string RoutingTableHistory::_extractKeyString(const BSONObj& shardKeyValue)
     return extractKeyStringInternal(shardKeyValue, _shardKeyOrdering);
 }
 
+ChunkInfo* RoutingTableHistory::_findChunkByUpperBound(const BSONObj& shardKey) const {
+    return _chunkLookupTable.upperBound(_extractKeyString(shardKey));
+}
+
 std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeNew(
     NamespaceString nss,
     boost::optional<UUID> uuid,
@@ -505,6 +544,7 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeNew(
                                std::move(defaultCollator),
                                std::move(unique),
                                {},
+                               boost::none,
                                {0, 0, epoch})
         .makeUpdated(chunks);
 }
@@ -515,6 +555,10 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
     const auto startingCollectionVersion = getVersion();
     auto chunkMap = _chunkMap;
 
+    // Tracks what the diff touched, so the shard versions can be patched rather than recomputed
+    std::vector<ChunkInfoMap::value_type> insertedChunks;
+    std::set<ShardId> shardsWithRemovedChunks;
+
     ChunkVersion collectionVersion = startingCollectionVersion;
     for (const auto& chunk : changedChunks) {
         const auto& chunkVersion = chunk.getVersion();
@@ -563,10 +607,14 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
         }
 
         // Erase all chunks from the map, which overlap the chunk we got from the persistent store
+        for (auto it = low; it != high; ++it) {
+            shardsWithRemovedChunks.insert(it->second->getShardIdAt(boost::none));
+        }
         chunkMap.erase(low, high);
 
         // Insert only the chunk itself
         chunkMap.insert(std::make_pair(chunkMaxKeyString, newChunk));
+        insertedChunks.emplace_back(chunkMaxKeyString, std::move(newChunk));
     }
 
     // If at least one diff was applied, the metadata is correct, but it might not have changed so
@@ -580,6 +628,9 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
         return shared_from_this();
     }
 
+    auto shardVersions =
+        _updateShardVersionMap(chunkMap, insertedChunks, shardsWithRemovedChunks);
+
     return std::shared_ptr<RoutingTableHistory>(
         new RoutingTableHistory(_nss,
                                 _uuid,
@@ -587,7 +638,87 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
                                 CollatorInterface::cloneCollator(getDefaultCollator()),
                                 isUnique(),
                                 std::move(chunkMap),
+                                std::move(shardVersions),
                                 collectionVersion));
 }
 
+ShardVersionMap RoutingTableHistory::_updateShardVersionMap(
+    const ChunkInfoMap& chunkMap,
+    const std::vector<ChunkInfoMap::value_type>& insertedChunks,
+    const std::set<ShardId>& shardsWithRemovedChunks) const {
+    ShardVersionMap insertedVersions;
+
+    for (const auto& inserted : insertedChunks) {
+        // A chunk from earlier in the diff may have been replaced by a later one
+        const auto it = chunkMap.find(inserted.first);
+        if (it == chunkMap.end() || it->second != inserted.second)
+            continue;
+
+        const auto& chunk = it->second;
+
+        // The chunks which were not touched by the diff were already validated when the previous
+        // routing table was built, so it is sufficient to check that each inserted chunk lines up
+        // with its neighbours. Every range which was erased has an inserted chunk in its place.
+        if (it == chunkMap.begin()) {
+            checkAllElementsAreOfType(MinKey, chunk->getMin());
+        } else {
+            const auto& prevMax = std::prev(it)->second->getMax();
+            uassert(ErrorCodes::ConflictingOperationInProgress,
+                    str::stream() << "Gap or an overlap between ranges "
+                                  << ChunkRange(chunk->getMin(), chunk->getMax()).toString()
+                                  << " and "
+                                  << prevMax,
+                    SimpleBSONObjComparator::kInstance.evaluate(prevMax == chunk->getMin()));
+        }
+
+        if (std::next(it) == chunkMap.end()) {
+            checkAllElementsAreOfType(MaxKey, chunk->getMax());
+        } else {
+            const auto& nextMin = std::next(it)->second->getMin();
+            uassert(ErrorCodes::ConflictingOperationInProgress,
+                    str::stream() << "Gap or an overlap between ranges "
+                                  << ChunkRange(chunk->getMin(), chunk->getMax()).toString()
+                                  << " and "
+                                  << nextMin,
+                    SimpleBSONObjComparator::kInstance.evaluate(chunk->getMax() == nextMin));
+        }
+
+        invariant(chunk->getLastmod().isSet());
+
+        auto& maxShardVersion =
+            insertedVersions
+                .emplace(chunk->getShardIdAt(boost::none),
+                         ChunkVersion(0, 0, _collectionVersion.epoch()))
+                .first->second;
+        if (chunk->getLastmod() > maxShardVersion)
+            maxShardVersion = chunk->getLastmod();
+    }
+
+    // A shard which lost chunks keeps a known version only if it also received a chunk at least
+    // as new as its previous maximum, since the lost chunk may have been the one carrying it.
+    // Otherwise its version (or whether it still owns any chunks at all) can only be determined
+    // by scanning the whole table.
+    for (const auto& shardId : shardsWithRemovedChunks) {
+        const auto prevIt = _shardVersions.find(shardId);
+        if (prevIt == _shardVersions.end())
+            continue;
+
+        const auto insertedIt = insertedVersions.find(shardId);
+        if (insertedIt == insertedVersions.end() || insertedIt->second < prevIt->second) {
+            return _constructShardVersionMap(
+                _collectionVersion.epoch(), chunkMap, _shardKeyOrdering);
+        }
+    }
+
+    auto shardVersions = _shardVersions;
+    for (const auto& inserted : insertedVersions) {
+        auto& maxShardVersion =
+            shardVersions.emplace(inserted.first, inserted.second).first->second;
+        if (inserted.second > maxShardVersion)
+            maxShardVersion = inserted.second;
+    }
+
+    return shardVersions;
+}
+
 }  // namespace mongo
@@ -55,6 +55,37 @@ using ChunkInfoMap = std::map<std::string, std::shared_ptr<ChunkInfo>>;
 // Map from a shard is to the max chunk version on that shard
 using ShardVersionMap = std::map<ShardId, ChunkVersion>;
 
+/**
+ * Flat, read-only view over a ChunkInfoMap used for point lookups. The chunk max key strings and
+ * the chunks they bound are laid out in two parallel contiguous arrays, sorted in the same order
+ * as the map, so that a lookup is a binary search over a dense array instead of a walk across
+ * individually allocated tree nodes. Collections with a very large number of chunks otherwise pay
+ * a cache miss for nearly every level of the tree on each routed operation.
+ *
+ * The view references the key strings and the chunks owned by the map it was built from, so it
+ * must not outlive that map and the map must not be modified after the view is built.
+ */
+class ChunkInfoLookupTable {
+public:
+    ChunkInfoLookupTable() = default;
+    explicit ChunkInfoLookupTable(const ChunkInfoMap& chunkMap);
+
+    /**
+     * Returns the chunk whose max key string is the smallest one strictly greater than
+     * 'keyString', which is the only chunk which could possibly contain the corresponding key, or
+     * nullptr if there is no such chunk.
+     */
+    ChunkInfo* upperBound(StringData keyString) const;
+
+    size_t size() const {
+        return _chunks.size();
+    }
+
+private:
+    std::vector<StringData> _maxKeyStrings;
+    std::vector<ChunkInfo*> _chunks;
+};
+
 /**
  * In-memory representation of the routing table for a single sharded collection at various points
  * in time.
@@ -163,10 +194,30 @@ private:
                         std::unique_ptr<CollatorInterface> defaultCollator,
                         bool unique,
                         ChunkInfoMap chunkMap,
+                        boost::optional<ShardVersionMap> shardVersions,
                         ChunkVersion collectionVersion);
 
+    /**
+     * Produces the ShardVersionMap for 'chunkMap', which was obtained by applying a diff to this
+     * routing table, that replaced chunks owned by 'shardsWithRemovedChunks' with
+     * 'insertedChunks'. Only the shards and the neighbourhoods touched by the diff are examined,
+     * unless a shard lost the chunk which carried its version, in which case the map is rebuilt
+     * with _constructShardVersionMap.
+     */
+    ShardVersionMap _updateShardVersionMap(
+        const ChunkInfoMap& chunkMap,
+        const std::vector<ChunkInfoMap::value_type>& insertedChunks,
+        const std::set<ShardId>& shardsWithRemovedChunks) const;
+
     std::string _extractKeyString(const BSONObj& shardKeyValue) const;
 
+    /**
+     * Returns the chunk which would contain 'shardKey' if it falls within the chunk's range, or
+     * nullptr if 'shardKey' sorts at or past the max of the last chunk. Callers must still check
+     * that the returned chunk actually contains the key.
+     */
+    ChunkInfo* _findChunkByUpperBound(const BSONObj& shardKey) const;
+
     // The shard versioning mechanism hinges on keeping track of the number of times we reload
     // ChunkManagers.
     const unsigned long long _sequenceNumber;
@@ -192,6 +243,10 @@ private:
     // ranges must cover the complete space from [MinKey, MaxKey).
     const ChunkInfoMap _chunkMap;
 
+    // Flat copy of the ordering of '_chunkMap' used to serve point lookups. It points into
+    // '_chunkMap' and so must be declared (and constructed) after it.
+    const ChunkInfoLookupTable _chunkLookupTable;
+
     // Map from shard id to the maximum chunk version for that shard. If a shard contains no
     // chunks, it won't be present in this map.
     const ShardVersionMap _shardVersions;
@@ -304,6 +359,13 @@ public:
      */
     bool keyBelongsToShard(const BSONObj& shardKey, const ShardId& shardId) const;
 
+    /**
+     * Returns true if all the chunks of the collection are owned by the shard with the given
+     * "shardId", meaning every document of the collection belongs to that shard. Conservatively
+     * returns false for routing tables read at a point in time.
+     */
+    bool shardOwnsAllChunks(const ShardId& shardId) const;
+
     /**
      * Returns true if any chunk owned by the shard with the given "shardId" overlaps "range".
      */
@@ -120,6 +120,35 @@ TEST_F(ChunkManagerQueryTest, GetShardIdsForRangeMinAndMaxAreTheSameAtLastChunkM
                                {ShardId("3")});
 }
 
+TEST_F(ChunkManagerQueryTest, FindIntersectingChunkAtChunkBoundaries) {
+    const ShardKeyPattern shardKeyPattern(BSON("a" << 1));
+    auto chunkManager = makeChunkManager(kNss,
+                                         shardKeyPattern,
+                                         nullptr,
+                                         false,
+                                         {BSON("a" << -100), BSON("a" << 0), BSON("a" << 100)});
+
+    ASSERT_EQ(ShardId("0"),
+              chunkManager->findIntersectingChunkWithSimpleCollation(BSON("a" << MINKEY))
+                  .getShardId());
+    ASSERT_EQ(ShardId("0"),
+              chunkManager->findIntersectingChunkWithSimpleCollation(BSON("a" << -101))
+                  .getShardId());
+    ASSERT_EQ(ShardId("1"),
+              chunkManager->findIntersectingChunkWithSimpleCollation(BSON("a" << -100))
+                  .getShardId());
+    ASSERT_EQ(ShardId("2"),
+              chunkManager->findIntersectingChunkWithSimpleCollation(BSON("a" << 0))
+                  .getShardId());
+    ASSERT_EQ(ShardId("3"),
+              chunkManager->findIntersectingChunkWithSimpleCollation(BSON("a" << 100))
+                  .getShardId());
+
+    ASSERT(chunkManager->keyBelongsToShard(BSON("a" << 99), ShardId("2")));
+    ASSERT(!chunkManager->keyBelongsToShard(BSON("a" << 100), ShardId("2")));
+    ASSERT(!chunkManager->keyBelongsToShard(BSON("a" << MAXKEY), ShardId("3")));
+}
+
 TEST_F(ChunkManagerQueryTest, EmptyQuerySingleShard) {
     runQueryTest(BSON("a" << 1), nullptr, false, {}, BSONObj(), BSONObj(), {ShardId("0")});
 }
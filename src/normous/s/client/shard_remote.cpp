@@ -46,13 +46,17 @@
 #include "mongo/db/query/query_request.h"
 #include "mongo/db/repl/read_concern_args.h"
 #include "mongo/db/server_parameters.h"
+#include "mongo/db/service_context.h"
 #include "mongo/executor/task_executor_pool.h"
 #include "mongo/rpc/get_status_from_command_result.h"
 #include "mongo/rpc/metadata/repl_set_metadata.h"
 #include "mongo/rpc/metadata/tracking_metadata.h"
 #include "mongo/s/grid.h"
+#include "mongo/transport/baton.h"
+#include "mongo/transport/transport_layer.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/time_support.h"
 
 namespace mongo {
@@ -75,6 +79,10 @@ MONGO_EXPORT_SERVER_PARAMETER(internalProhibitShardOperationRetry,
                               bool,
                               internalProhibitShardOperationRetryByDefault);
 
+// Whether commands run synchronously through ShardRemote drive their network I/O on the calling
+// thread through a baton, as the AsyncRequestsSender does.
+MONGO_EXPORT_SERVER_PARAMETER(ShardRemoteUseBaton, bool, true);
+
 /**
  * Returns a new BSONObj describing the same command and arguments as 'cmdObj', but with maxTimeMS
  * replaced by maxTimeMSOverride (or removed if maxTimeMSOverride is Milliseconds::max()).
@@ -194,13 +202,31 @@ StatusWith<Shard::CommandResponse> ShardRemote::_runCommand(OperationContext* op
         Status(ErrorCodes::InternalError,
                str::stream() << "Failed to run remote command request cmd: " << cmdObj);
 
+    // This thread blocks until the response arrives, so let it do the network I/O for the command
+    // itself rather than wait for the reactor thread to hand the response over. An operation which
+    // already has a baton (for instance from an AsyncRequestsSender) keeps using that one.
+    transport::BatonHandle baton = opCtx->getBaton();
+    bool ownsBaton = false;
+    if (!baton && ShardRemoteUseBaton.load()) {
+        if (auto tl = opCtx->getServiceContext()->getTransportLayer()) {
+            baton = tl->makeBaton(opCtx);
+            ownsBaton = bool(baton);
+        }
+    }
+    const auto batonGuard = MakeGuard([&] {
+        if (ownsBaton) {
+            baton->detach();
+        }
+    });
+
     auto asyncStatus = _scheduleCommand(
         opCtx,
         readPref,
         dbName,
         maxTimeMSOverride,
         cmdObj,
-        [&response](const RemoteCommandCallbackArgs& args) { response = args.response; });
+        [&response](const RemoteCommandCallbackArgs& args) { response = args.response; },
+        baton);
 
     if (!asyncStatus.isOK()) {
         return asyncStatus.getStatus();
@@ -217,9 +243,14 @@ StatusWith<Shard::CommandResponse> ShardRemote::_runCommand(OperationContext* op
         // registered with the TaskExecutor to run when the response finally does come back.
         // Since the callback references local state, it would be invalid for the callback to run
         // after leaving the scope of this method.  Therefore we cancel the callback and wait
-        // uninterruptably for the callback to be run.
+        // uninterruptably for the callback to be run. With a baton, the callback only runs while
+        // this thread waits through the operation context.
         executor->cancel(asyncHandle.handle);
-        executor->wait(asyncHandle.handle);
+        if (baton) {
+            opCtx->runWithoutInterruption([&] { executor->wait(asyncHandle.handle, opCtx); });
+        } else {
+            executor->wait(asyncHandle.handle);
+        }
         return e.toStatus();
     }
 
@@ -408,7 +439,8 @@ StatusWith<ShardRemote::AsyncCmdHandle> ShardRemote::_scheduleCommand(
     const std::string& dbName,
     Milliseconds maxTimeMSOverride,
     const BSONObj& cmdObj,
-    const TaskExecutor::RemoteCommandCallbackFn& cb) {
+    const TaskExecutor::RemoteCommandCallbackFn& cb,
+    const transport::BatonHandle& baton) {
     ReadPreferenceSetting readPrefWithMinOpTime(readPref);
 
     if (isConfig()) {
@@ -435,7 +467,7 @@ StatusWith<ShardRemote::AsyncCmdHandle> ShardRemote::_scheduleCommand(
         requestTimeout < Milliseconds::max() ? requestTimeout : RemoteCommandRequest::kNoTimeout);
 
     auto executor = Grid::get(opCtx)->getExecutorPool()->getFixedExecutor();
-    auto swHandle = executor->scheduleRemoteCommand(request, cb);
+    auto swHandle = executor->scheduleRemoteCommand(request, cb, baton);
 
     if (!swHandle.isOK()) {
         return swHandle.getStatus();
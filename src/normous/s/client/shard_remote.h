@@ -127,7 +127,8 @@ private:
         const std::string& dbName,
         Milliseconds maxTimeMSOverride,
         const BSONObj& cmdObj,
-        const executor::TaskExecutor::RemoteCommandCallbackFn& cb);
+        const executor::TaskExecutor::RemoteCommandCallbackFn& cb,
+        const transport::BatonHandle& baton = nullptr);
 
     /**
      * Protects _lastCommittedOpTime.
@@ -44,9 +44,11 @@
 #include "mongo/s/commands/strategy.h"
 #include "mongo/s/grid.h"
 #include "mongo/s/multi_statement_transaction_requests_sender.h"
+#include "mongo/s/query/cluster_query_result_cache.h"
 #include "mongo/s/stale_exception.h"
 #include "mongo/s/transaction_router.h"
 #include "mongo/s/write_ops/cluster_write.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/timer.h"
 
 namespace mongo {
@@ -207,6 +209,9 @@ private:
             txnRouter->setAtClusterTimeToLatestTime(opCtx);
         }
 
+        // Results cached before this write completes may no longer be accurate.
+        ON_BLOCK_EXIT([&] { ClusterQueryResultCache::get(opCtx)->invalidate(nss); });
+
         const auto response = [&] {
             std::vector<AsyncRequestsSender::Request> requests;
             requests.emplace_back(
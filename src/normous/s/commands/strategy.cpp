@@ -80,6 +80,7 @@
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
+#include "mongo/util/sampling_profiler.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/timer.h"
 
@@ -194,6 +195,8 @@ void execCommandClient(OperationContext* opCtx,
                        const OpMsgRequest& request,
                        rpc::ReplyBuilderInterface* result) {
     const Command* c = invocation->definition();
+    SamplingProfiler::ScopedTag profilerTag(SamplingProfiler::TagKind::kCommand,
+                                            c->getName().c_str());
     ON_BLOCK_EXIT([opCtx, &result] {
         auto body = result->getBodyBuilder();
         appendRequiredFieldsToResponse(opCtx, &body);
@@ -273,7 +273,15 @@ StatusWith<ClusterQueryResult> AsyncResultsMerger::nextReady() {
         return {ClusterQueryResult()};
     }
 
-    return _params.getSort() ? _nextReadySorted(lk) : _nextReadyUnsorted(lk);
+    auto result = _params.getSort() ? _nextReadySorted(lk) : _nextReadyUnsorted(lk);
+    if (!result.isEOF()) {
+        ++_numReturned;
+    }
+    return result;
+}
+
+bool AsyncResultsMerger::_limitReached(WithLock) const {
+    return _params.getLimit() && _numReturned >= *_params.getLimit();
 }
 
 ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
@@ -348,6 +356,15 @@ Status AsyncResultsMerger::_askForNextBatch(WithLock, size_t remoteIndex) {
         adjustedBatchSize = *_params.getBatchSize() - remote.fetchedCount;
     }
 
+    // Never ask a single remote for more documents than the merger can still return. With a sort
+    // across many shards, most of a full batch from each of them would otherwise be discarded.
+    if (_params.getLimit()) {
+        const auto remaining = std::max<std::int64_t>(*_params.getLimit() - _numReturned, 1);
+        if (!adjustedBatchSize || *adjustedBatchSize > remaining) {
+            adjustedBatchSize = remaining;
+        }
+    }
+
     BSONObj cmdObj = GetMoreRequest(remote.cursorNss,
                                     remote.cursorId,
                                     adjustedBatchSize,
@@ -398,6 +415,11 @@ Status AsyncResultsMerger::scheduleGetMores() {
 }
 
 Status AsyncResultsMerger::_scheduleGetMores(WithLock lk) {
+    // Once the limit has been satisfied, no more results will be consumed
+    if (_limitReached(lk)) {
+        return Status::OK();
+    }
+
     // Schedule remote work on hosts for which we need more results.
     for (size_t i = 0; i < _remotes.size(); ++i) {
         auto& remote = _remotes[i];
@@ -610,7 +632,8 @@ void AsyncResultsMerger::_processBatchResults(WithLock lk,
     if (_tailableMode == TailableModeEnum::kTailable && !remote.hasNext()) {
         invariant(_remotes.size() == 1);
         _eofNext = true;
-    } else if (!remote.hasNext() && !remote.exhausted() && _lifecycleState == kAlive && _opCtx) {
+    } else if (!remote.hasNext() && !remote.exhausted() && _lifecycleState == kAlive && _opCtx &&
+               !_limitReached(lk)) {
         // If this is normal or tailable-awaitData cursor and we still don't have anything buffered
         // after receiving this batch, we can schedule work to retrieve the next batch right away.
         // Be careful only to do this when '_opCtx' is non-null, since it is illegal to schedule a
@@ -349,6 +349,12 @@ private:
     bool _readySortedTailable(WithLock);
     bool _readyUnsorted(WithLock);
 
+    /**
+     * Returns true if the merger has a limit and has already returned that many results, in which
+     * case no more batches need to be requested from the remotes.
+     */
+    bool _limitReached(WithLock) const;
+
     //
     // Helpers for nextReady().
     //
@@ -446,6 +452,10 @@ private:
     // boost::none.
     bool _eofNext = false;
 
+    // Number of results returned by nextReady(). Used to bound the batches requested from the
+    // remotes when the merger has a limit.
+    std::int64_t _numReturned = 0;
+
     boost::optional<Milliseconds> _awaitDataTimeout;
 
     //
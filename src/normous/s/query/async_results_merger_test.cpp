@@ -1097,6 +1097,66 @@ TEST_F(AsyncResultsMergerTest, GetMoreBatchSizes) {
     ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
 }
 
+TEST_F(AsyncResultsMergerTest, GetMoreBatchSizesBoundedByLimit) {
+    BSONObj findCmd = fromjson("{find: 'testcoll', sort: {_id: 1}, limit: 3}");
+    std::vector<RemoteCursor> cursors;
+    cursors.push_back(
+        makeRemoteCursor(kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, 5, {})));
+    cursors.push_back(
+        makeRemoteCursor(kTestShardIds[1], kTestShardHosts[1], CursorResponse(kTestNss, 6, {})));
+    auto arm = makeARMFromExistingCursors(std::move(cursors), findCmd);
+
+    auto readyEvent = unittest::assertGet(arm->nextEvent());
+
+    // Without a batchSize, each remote is asked for no more than the limit.
+    for (size_t i = 0; i < 2; ++i) {
+        auto request = GetMoreRequest::parseFromBSON("anydbname", getNthPendingRequest(i).cmdObj);
+        ASSERT_OK(request.getStatus());
+        ASSERT_EQ(*request.getValue().batchSize, 3LL);
+    }
+
+    std::vector<CursorResponse> responses;
+    std::vector<BSONObj> batch1 = {fromjson("{$sortKey: {'': 1}}")};
+    responses.emplace_back(kTestNss, CursorId(5), batch1);
+    std::vector<BSONObj> batch2 = {fromjson("{$sortKey: {'': 2}}"),
+                                   fromjson("{$sortKey: {'': 4}}")};
+    responses.emplace_back(kTestNss, CursorId(6), batch2);
+    scheduleNetworkResponses(std::move(responses));
+    executor()->waitForEvent(readyEvent);
+
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: {'': 1}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_FALSE(arm->ready());
+
+    // One result has been returned, so the first remote is only asked for the remaining two.
+    readyEvent = unittest::assertGet(arm->nextEvent());
+    auto request = GetMoreRequest::parseFromBSON("anydbname", getNthPendingRequest(0).cmdObj);
+    ASSERT_OK(request.getStatus());
+    ASSERT_EQ(*request.getValue().batchSize, 2LL);
+    ASSERT_EQ(request.getValue().cursorid, 5LL);
+
+    responses.clear();
+    std::vector<BSONObj> batch3 = {fromjson("{$sortKey: {'': 3}}")};
+    responses.emplace_back(kTestNss, CursorId(5), batch3);
+    scheduleNetworkResponses(std::move(responses));
+    executor()->waitForEvent(readyEvent);
+
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: {'': 2}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: {'': 3}}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+
+    // The limit has been satisfied, so the exhausted buffer of the first remote is not refilled.
+    ASSERT_OK(arm->scheduleGetMores());
+    ASSERT_FALSE(networkHasReadyRequests());
+
+    auto killEvent = arm->kill(operationContext());
+    executor()->waitForEvent(killEvent);
+}
+
 TEST_F(AsyncResultsMergerTest, AllowPartialResults) {
     BSONObj findCmd = fromjson("{find: 'testcoll', allowPartialResults: true}");
     std::vector<RemoteCursor> cursors;
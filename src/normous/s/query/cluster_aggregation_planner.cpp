@@ -30,6 +30,9 @@
 
 #include "mongo/s/query/cluster_aggregation_planner.h"
 
+#include <limits>
+
+#include "mongo/db/pipeline/document_source_exchange.h"
 #include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/document_source_limit.h"
 #include "mongo/db/pipeline/document_source_match.h"
@@ -348,6 +351,84 @@ boost::optional<ShardedExchangePolicy> walkPipelineBackwardsTrackingShardKey(
     return ShardedExchangePolicy{std::move(exchangeSpec), std::move(consumerShards)};
 }
 
+/**
+ * Returns true if 'mergePipeline' begins with the merging half of a $group and every stage after it
+ * can run independently over any subset of the groups. In that case each group can be finalized on
+ * whichever node receives all of the partial results sharing its _id, and the outputs of those
+ * nodes only need to be concatenated.
+ */
+bool isGroupMergeSplittableByKey(const Pipeline* mergePipeline) {
+    const auto& sources = mergePipeline->getSources();
+    auto groupStage = dynamic_cast<DocumentSourceGroup*>(sources.front().get());
+    if (!groupStage || !groupStage->doingMerge()) {
+        return false;
+    }
+
+    for (auto it = std::next(sources.begin()); it != sources.end(); ++it) {
+        // Stages such as $sort and $limit need to see the results of all the groups, and stages
+        // with host requirements (e.g. $out, $lookup) must keep running on their designated host.
+        if (dynamic_cast<NeedsMergerDocumentSource*>(it->get()) ||
+            (*it)->constraints(Pipeline::SplitState::kSplitForMerge).hostRequirement !=
+                StageConstraints::HostTypeRequirement::kNone) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Builds an exchange which hash partitions the partial $group results by their _id across all the
+ * shards in the cluster, so that each shard merges a disjoint set of the groups.
+ */
+boost::optional<ShardedExchangePolicy> buildGroupMergeExchange(OperationContext* opCtx,
+                                                               const Pipeline* mergePipeline) {
+    if (!internalQueryEnableGroupExchange.load() || !isGroupMergeSplittableByKey(mergePipeline)) {
+        return boost::none;
+    }
+
+    // The hash of the group key does not take the collation into account, so two keys which are
+    // equal under a non-simple collation could be sent to different consumers.
+    if (mergePipeline->getContext()->getCollator()) {
+        return boost::none;
+    }
+
+    std::vector<ShardId> consumerShards;
+    Grid::get(opCtx)->shardRegistry()->getAllShardIdsNoReload(&consumerShards);
+    if (consumerShards.size() < 2) {
+        return boost::none;
+    }
+    if (consumerShards.size() > Exchange::kMaxNumberConsumers) {
+        consumerShards.resize(Exchange::kMaxNumberConsumers);
+    }
+
+    // Split the 64-bit hash space into equally sized ranges, one for each consumer.
+    const auto numConsumers = consumerShards.size();
+    const uint64_t rangeWidth = std::numeric_limits<uint64_t>::max() / numConsumers;
+    const uint64_t hashSpaceMin = static_cast<uint64_t>(std::numeric_limits<long long>::min());
+
+    std::vector<BSONObj> boundaries;
+    std::vector<int> consumerIds;
+    boundaries.emplace_back(BSON("_id" << MINKEY));
+    for (size_t i = 1; i < numConsumers; ++i) {
+        const auto splitPoint = static_cast<long long>(hashSpaceMin + i * rangeWidth);
+        boundaries.emplace_back(BSON("_id" << splitPoint));
+    }
+    boundaries.emplace_back(BSON("_id" << MAXKEY));
+    for (size_t i = 0; i < numConsumers; ++i) {
+        consumerIds.emplace_back(static_cast<int>(i));
+    }
+
+    ExchangeSpec exchangeSpec;
+    exchangeSpec.setPolicy(ExchangePolicyEnum::kKeyRange);
+    exchangeSpec.setKey(BSON("_id"
+                             << "hashed"));
+    exchangeSpec.setBoundaries(std::move(boundaries));
+    exchangeSpec.setConsumers(numConsumers);
+    exchangeSpec.setConsumerIds(std::move(consumerIds));
+
+    return ShardedExchangePolicy{std::move(exchangeSpec), std::move(consumerShards)};
+}
+
 }  // namespace
 
 SplitPipeline splitPipeline(std::unique_ptr<Pipeline, PipelineDeleter> pipeline) {
@@ -455,10 +536,15 @@ boost::optional<ShardedExchangePolicy> checkIfEligibleForExchange(OperationConte
 
     const auto outStage =
         dynamic_cast<DocumentSourceOut*>(mergePipeline->getSources().back().get());
-    if (!outStage || outStage->getMode() == WriteModeEnum::kModeReplaceCollection) {
-        // If there's no $out stage we won't try to do an $exchange. If the $out stage is using mode
-        // "replaceCollection", then there's no point doing an $exchange because all the writes will
-        // go to a single node, so we should just perform the merge on that host.
+    if (!outStage) {
+        // Without an $out stage there is no shard key to partition by, but the merging half of a
+        // $group can still be spread across the shards by hashing the group key.
+        return buildGroupMergeExchange(opCtx, mergePipeline);
+    }
+    if (outStage->getMode() == WriteModeEnum::kModeReplaceCollection) {
+        // If the $out stage is using mode "replaceCollection", then there's no point doing an
+        // $exchange because all the writes will go to a single node, so we should just perform the
+        // merge on that host.
         return boost::none;
     }
 
@@ -39,9 +39,11 @@
 #include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
 #include "mongo/db/pipeline/stub_mongo_process_interface.h"
+#include "mongo/db/query/collation/collator_interface_mock.h"
 #include "mongo/s/catalog/type_shard.h"
 #include "mongo/s/catalog_cache_test_fixture.h"
 #include "mongo/s/query/cluster_aggregation_planner.h"
+#include "mongo/s/query/cluster_query_knobs.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/scopeguard.h"
 
@@ -132,6 +134,84 @@ TEST_F(ClusterExchangeTest, ShouldNotExchangeIfPipelineDoesNotEndWithOut) {
                                                                          mergePipe.get()));
 }
 
+TEST_F(ClusterExchangeTest, GroupMergeIsNotEligibleForExchangeByDefault) {
+    setupNShards(2);
+    auto mergePipe = unittest::assertGet(
+        Pipeline::create({parse("{$group: {_id: '$x', $doingMerge: true}}")}, expCtx()));
+    ASSERT_FALSE(cluster_aggregation_planner::checkIfEligibleForExchange(operationContext(),
+                                                                         mergePipe.get()));
+}
+
+TEST_F(ClusterExchangeTest, GroupMergeIsHashPartitionedAcrossAllShards) {
+    internalQueryEnableGroupExchange.store(true);
+    ON_BLOCK_EXIT([] { internalQueryEnableGroupExchange.store(false); });
+
+    setupNShards(3);
+    auto mergePipe = unittest::assertGet(
+        Pipeline::create({parse("{$group: {_id: '$x', count: {$sum: 1}, $doingMerge: true}}"),
+                          parse("{$match: {count: {$gt: 1}}}"),
+                          parse("{$project: {count: 1}}")},
+                         expCtx()));
+
+    auto exchangeSpec = cluster_aggregation_planner::checkIfEligibleForExchange(operationContext(),
+                                                                                mergePipe.get());
+    ASSERT_TRUE(exchangeSpec);
+    ASSERT(exchangeSpec->exchangeSpec.getPolicy() == ExchangePolicyEnum::kKeyRange);
+    ASSERT_BSONOBJ_EQ(exchangeSpec->exchangeSpec.getKey(),
+                      BSON("_id"
+                           << "hashed"));
+    ASSERT_EQ(exchangeSpec->consumerShards.size(), 3UL);  // One for each shard.
+    ASSERT_EQ(exchangeSpec->exchangeSpec.getConsumers(), 3);
+
+    // The hash space is split into one range per consumer.
+    const auto& boundaries = exchangeSpec->exchangeSpec.getBoundaries().get();
+    const auto& consumerIds = exchangeSpec->exchangeSpec.getConsumerIds().get();
+    ASSERT_EQ(boundaries.size(), 4UL);
+    ASSERT_BSONOBJ_EQ(boundaries[0], BSON("_id" << MINKEY));
+    ASSERT_EQ(boundaries[1]["_id"].type(), BSONType::NumberLong);
+    ASSERT_EQ(boundaries[2]["_id"].type(), BSONType::NumberLong);
+    ASSERT_LT(boundaries[1]["_id"].numberLong(), 0LL);
+    ASSERT_GT(boundaries[2]["_id"].numberLong(), 0LL);
+    ASSERT_BSONOBJ_EQ(boundaries[3], BSON("_id" << MAXKEY));
+
+    ASSERT_EQ(consumerIds.size(), 3UL);
+    for (size_t i = 0; i < consumerIds.size(); ++i) {
+        ASSERT_EQ(consumerIds[i], static_cast<int>(i));
+    }
+}
+
+TEST_F(ClusterExchangeTest, GroupMergeIsNotEligibleForExchangeIfFollowedBySortOrLimit) {
+    internalQueryEnableGroupExchange.store(true);
+    ON_BLOCK_EXIT([] { internalQueryEnableGroupExchange.store(false); });
+
+    setupNShards(2);
+    auto mergePipe = unittest::assertGet(Pipeline::create(
+        {parse("{$group: {_id: '$x', $doingMerge: true}}"), parse("{$sort: {_id: 1}}")},
+        expCtx()));
+    ASSERT_FALSE(cluster_aggregation_planner::checkIfEligibleForExchange(operationContext(),
+                                                                         mergePipe.get()));
+
+    mergePipe = unittest::assertGet(Pipeline::create(
+        {parse("{$group: {_id: '$x', $doingMerge: true}}"),
+         DocumentSourceLimit::create(expCtx(), 1)},
+        expCtx()));
+    ASSERT_FALSE(cluster_aggregation_planner::checkIfEligibleForExchange(operationContext(),
+                                                                         mergePipe.get()));
+}
+
+TEST_F(ClusterExchangeTest, GroupMergeIsNotEligibleForExchangeWithNonSimpleCollation) {
+    internalQueryEnableGroupExchange.store(true);
+    ON_BLOCK_EXIT([] { internalQueryEnableGroupExchange.store(false); });
+
+    setupNShards(2);
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kToLowerString);
+    expCtx()->setCollator(&collator);
+    auto mergePipe = unittest::assertGet(
+        Pipeline::create({parse("{$group: {_id: '$x', $doingMerge: true}}")}, expCtx()));
+    ASSERT_FALSE(cluster_aggregation_planner::checkIfEligibleForExchange(operationContext(),
+                                                                         mergePipe.get()));
+}
+
 TEST_F(ClusterExchangeTest, ShouldNotExchangeIfPipelineEndsWithReplaceCollectionOut) {
     setupNShards(2);
 
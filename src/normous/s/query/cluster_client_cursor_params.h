@@ -83,6 +83,11 @@ struct ClusterClientCursorParams {
         armParams.setRemotes(std::move(remotes));
         armParams.setTailableMode(tailableMode);
         armParams.setBatchSize(batchSize);
+        if (limit) {
+            // The skip stage consumes results from the merger too. The sum was verified not to
+            // overflow when the query was parsed.
+            armParams.setLimit(*limit + skip.value_or(0));
+        }
         armParams.setNss(nsString);
         armParams.setAllowPartialResults(isAllowPartialResults);
 
@@ -48,6 +48,7 @@
 #include "mongo/db/query/find_common.h"
 #include "mongo/db/query/getmore_request.h"
 #include "mongo/db/query/query_planner_common.h"
+#include "mongo/db/repl/read_concern_args.h"
 #include "mongo/executor/task_executor_pool.h"
 #include "mongo/platform/overflow_arithmetic.h"
 #include "mongo/s/catalog_cache.h"
@@ -58,6 +59,7 @@
 #include "mongo/s/query/cluster_client_cursor_impl.h"
 #include "mongo/s/query/cluster_cursor_manager.h"
 #include "mongo/s/query/cluster_query_knobs.h"
+#include "mongo/s/query/cluster_query_result_cache.h"
 #include "mongo/s/query/establish_cursors.h"
 #include "mongo/s/query/store_possible_cursor.h"
 #include "mongo/s/stale_exception.h"
@@ -371,6 +373,49 @@ CursorId runQueryWithoutRetrying(OperationContext* opCtx,
     return cursorId;
 }
 
+/**
+ * Returns the key under which the complete results of 'query' may be stored in the
+ * ClusterQueryResultCache, or boost::none if the results of the query must not be cached. The key
+ * includes the routing information, so that the cached results are not used once the shard
+ * versions of the collection change.
+ */
+boost::optional<std::string> makeResultCacheKey(OperationContext* opCtx,
+                                                const CanonicalQuery& query,
+                                                const ReadPreferenceSetting& readPref,
+                                                const CachedCollectionRoutingInfo& routingInfo) {
+    if (internalQueryResultCacheExpirationMillis.load() <= 0 || TransactionRouter::get(opCtx)) {
+        return boost::none;
+    }
+
+    const auto& readConcernArgs = repl::ReadConcernArgs::get(opCtx);
+    const auto readConcernLevel = readConcernArgs.getLevel();
+    if ((readConcernLevel != repl::ReadConcernLevel::kLocalReadConcern &&
+         readConcernLevel != repl::ReadConcernLevel::kAvailableReadConcern) ||
+        readConcernArgs.getArgsAfterClusterTime() || readConcernArgs.getArgsAtClusterTime()) {
+        return boost::none;
+    }
+
+    const auto& qr = query.getQueryRequest();
+    if (qr.isTailable() || qr.isAllowPartialResults()) {
+        return boost::none;
+    }
+
+    BSONObjBuilder keyBuilder;
+    keyBuilder.append("ns", query.nss().ns());
+    if (auto cm = routingInfo.cm()) {
+        keyBuilder.append("epoch", cm->getVersion().epoch());
+        keyBuilder.append("version", static_cast<long long>(cm->getVersion().toLong()));
+    } else {
+        keyBuilder.append("primary", routingInfo.db().primaryId().toString());
+        keyBuilder.append("dbVersion", routingInfo.db().databaseVersion().toBSON());
+    }
+    keyBuilder.append("find", qr.asFindCommand());
+    keyBuilder.append("readPref", readPref.toInnerBSON());
+
+    const auto key = keyBuilder.obj();
+    return std::string(key.objdata(), key.objsize());
+}
+
 /**
  * Populates or re-populates some state of the OperationContext from what's stored on the cursor
  * and/or what's specified on the request.
@@ -435,8 +480,47 @@ CursorId ClusterFind::runQuery(OperationContext* opCtx,
 
         auto routingInfo = uassertStatusOK(routingInfoStatus);
 
+        auto resultCache = ClusterQueryResultCache::get(opCtx);
+        const auto resultCacheKey = makeResultCacheKey(opCtx, query, readPref, routingInfo);
+        const auto resultCacheGeneration = resultCache->getGeneration(query.nss());
+        if (resultCacheKey) {
+            const auto now = opCtx->getServiceContext()->getFastClockSource()->now();
+            if (auto cachedResults = resultCache->lookup(query.nss(), *resultCacheKey, now)) {
+                *results = std::move(*cachedResults);
+                CurOp::get(opCtx)->debug().nreturned = results->size();
+                CurOp::get(opCtx)->debug().cursorExhausted = true;
+                return CursorId(0);
+            }
+        }
+
         try {
-            return runQueryWithoutRetrying(opCtx, query, readPref, routingInfo, results);
+            auto cursorId = runQueryWithoutRetrying(opCtx, query, readPref, routingInfo, results);
+
+            // Only results which were returned in full, without a cursor, can be cached.
+            if (resultCacheKey && cursorId == 0) {
+                long long resultBytes = 0;
+                for (const auto& result : *results) {
+                    resultBytes += result.objsize();
+                }
+
+                if (resultBytes <= internalQueryResultCacheMaxResultBytes.load()) {
+                    std::vector<BSONObj> resultsToCache;
+                    for (const auto& result : *results) {
+                        resultsToCache.push_back(result.getOwned());
+                    }
+
+                    const auto expiration =
+                        opCtx->getServiceContext()->getFastClockSource()->now() +
+                        Milliseconds(internalQueryResultCacheExpirationMillis.load());
+                    resultCache->insert(query.nss(),
+                                        *resultCacheKey,
+                                        std::move(resultsToCache),
+                                        expiration,
+                                        resultCacheGeneration);
+                }
+            }
+
+            return cursorId;
         } catch (DBException& ex) {
             if (retries >= kMaxRetries) {
                 // Check if there are no retries remaining, so the last received error can be
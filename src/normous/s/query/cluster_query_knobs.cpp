@@ -37,5 +37,8 @@ namespace mongo {
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryAlwaysMergeOnPrimaryShard, bool, false);
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryProhibitMergingOnMongoS, bool, false);
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryDisableExchange, bool, false);
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryEnableGroupExchange, bool, false);
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryResultCacheExpirationMillis, int, 0);
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryResultCacheMaxResultBytes, int, 64 * 1024);
 
 }  // namespace mongo
@@ -48,4 +48,18 @@ extern AtomicBool internalQueryProhibitMergingOnMongoS;
 // If set to true on mongos then the cluster query planner will not produce plans with the exchange.
 // False by default, so the queries run with exchanges.
 extern AtomicBool internalQueryDisableExchange;
+
+// If set to true on mongos, aggregations whose merging pipeline begins with a $group and does not
+// otherwise require a single merger will hash partition the partial group results across all of
+// the shards, each of which then merges its own share of the groups. False by default.
+extern AtomicBool internalQueryEnableGroupExchange;
+
+// If greater than zero on mongos, the complete results of eligible finds are cached for this many
+// milliseconds and served to identical finds without contacting the shards. Only finds outside of
+// transactions with read concern "local" or "available" and no afterClusterTime are eligible. Zero
+// by default, which disables the cache.
+extern AtomicInt32 internalQueryResultCacheExpirationMillis;
+
+// Maximum total size of the documents of a single find result for it to be cached on mongos.
+extern AtomicInt32 internalQueryResultCacheMaxResultBytes;
 }  // namespace mongo
@@ -0,0 +1,116 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/query/cluster_query_result_cache.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+
+namespace mongo {
+namespace {
+
+const auto getClusterQueryResultCache =
+    ServiceContext::declareDecoration<ClusterQueryResultCache>();
+
+}  // namespace
+
+constexpr std::size_t ClusterQueryResultCache::kMaxEntries;
+
+ClusterQueryResultCache::ClusterQueryResultCache() : _entries(kMaxEntries) {}
+
+ClusterQueryResultCache* ClusterQueryResultCache::get(ServiceContext* serviceContext) {
+    return &getClusterQueryResultCache(serviceContext);
+}
+
+ClusterQueryResultCache* ClusterQueryResultCache::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+boost::optional<std::vector<BSONObj>> ClusterQueryResultCache::lookup(const NamespaceString& nss,
+                                                                      const std::string& key,
+                                                                      Date_t now) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+
+    auto it = _entries.find(key);
+    if (it == _entries.end()) {
+        ++_numMisses;
+        return boost::none;
+    }
+
+    const auto& entry = it->second;
+    if (entry.expiration <= now || entry.generation != _getGeneration(lk, nss)) {
+        _entries.erase(it);
+        ++_numMisses;
+        return boost::none;
+    }
+
+    ++_numHits;
+    return entry.results;
+}
+
+long long ClusterQueryResultCache::getGeneration(const NamespaceString& nss) const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return _getGeneration(lk, nss);
+}
+
+void ClusterQueryResultCache::insert(const NamespaceString& nss,
+                                     std::string key,
+                                     std::vector<BSONObj> results,
+                                     Date_t expiration,
+                                     long long generation) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    if (generation != _getGeneration(lk, nss)) {
+        return;
+    }
+
+    _entries.add(std::move(key), Entry{std::move(results), expiration, generation});
+}
+
+void ClusterQueryResultCache::invalidate(const NamespaceString& nss) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    ++_generations[nss.ns()];
+    ++_numInvalidations;
+}
+
+void ClusterQueryResultCache::report(BSONObjBuilder* builder) const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    builder->append("numEntries", static_cast<long long>(_entries.size()));
+    builder->append("numHits", _numHits);
+    builder->append("numMisses", _numMisses);
+    builder->append("numInvalidations", _numInvalidations);
+}
+
+long long ClusterQueryResultCache::_getGeneration(WithLock, const NamespaceString& nss) const {
+    auto it = _generations.find(nss.ns());
+    return it == _generations.end() ? 0 : it->second;
+}
+
+}  // namespace mongo
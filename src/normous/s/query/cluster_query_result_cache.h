@@ -0,0 +1,136 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <string>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/lru_cache.h"
+#include "mongo/util/string_map.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Decoration on ServiceContext used by mongos to remember the complete results of recent queries,
+ * so that repeated reads of rarely written collections can be answered without contacting the
+ * shards.
+ *
+ * Entries are keyed by an opaque string which must identify the query, the read preference and
+ * the routing information used to run it, so that a change of shard versions leads to a cache
+ * miss. Entries expire after a fixed time to bound their staleness with respect to writes done
+ * through other routers, and writes done through this router discard all the entries of the
+ * namespace they target.
+ *
+ * This class is thread safe.
+ */
+class ClusterQueryResultCache {
+    MONGO_DISALLOW_COPYING(ClusterQueryResultCache);
+
+public:
+    // Maximum number of entries held by the cache, from most to least recently used.
+    static constexpr std::size_t kMaxEntries = 1000;
+
+    ClusterQueryResultCache();
+
+    static ClusterQueryResultCache* get(ServiceContext* serviceContext);
+    static ClusterQueryResultCache* get(OperationContext* opCtx);
+
+    /**
+     * Returns the results stored for 'key' on namespace 'nss' if they have neither expired at
+     * 'now' nor been invalidated since they were inserted.
+     */
+    boost::optional<std::vector<BSONObj>> lookup(const NamespaceString& nss,
+                                                 const std::string& key,
+                                                 Date_t now);
+
+    /**
+     * Returns the number of times namespace 'nss' has been invalidated. Must be obtained before
+     * running a query whose results will be inserted.
+     */
+    long long getGeneration(const NamespaceString& nss) const;
+
+    /**
+     * Stores the complete results of a query on 'nss' under 'key', to be served by lookup until
+     * 'expiration'. The results are dropped if 'nss' was invalidated since 'generation' was
+     * obtained, because they may predate a write.
+     */
+    void insert(const NamespaceString& nss,
+                std::string key,
+                std::vector<BSONObj> results,
+                Date_t expiration,
+                long long generation);
+
+    /**
+     * Discards all the results stored for namespace 'nss'. Must be called whenever this router
+     * completes a write to the namespace.
+     */
+    void invalidate(const NamespaceString& nss);
+
+    /**
+     * Appends the cache statistics to 'builder'.
+     */
+    void report(BSONObjBuilder* builder) const;
+
+private:
+    struct Entry {
+        std::vector<BSONObj> results;
+        Date_t expiration;
+
+        // Value of the invalidation counter of the entry's namespace when it was inserted.
+        long long generation;
+    };
+
+    // Returns the invalidation counter of namespace 'nss'.
+    long long _getGeneration(WithLock, const NamespaceString& nss) const;
+
+    mutable stdx::mutex _mutex;
+
+    LRUCache<std::string, Entry> _entries;
+
+    // Number of times each namespace was invalidated. Entries inserted before the last
+    // invalidation of their namespace are stale and are discarded on lookup.
+    StringMap<long long> _generations;
+
+    long long _numHits{0};
+    long long _numMisses{0};
+    long long _numInvalidations{0};
+};
+
+}  // namespace mongo
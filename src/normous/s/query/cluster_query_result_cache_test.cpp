@@ -0,0 +1,126 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/query/cluster_query_result_cache.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kNss("test.foo");
+const NamespaceString kOtherNss("test.bar");
+const Date_t kNow = Date_t::fromMillisSinceEpoch(1000);
+const Date_t kExpiration = kNow + Seconds(1);
+
+std::vector<BSONObj> makeResults() {
+    return {BSON("_id" << 1), BSON("_id" << 2)};
+}
+
+void assertResultsEqual(const std::vector<BSONObj>& expected, const std::vector<BSONObj>& actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        ASSERT_BSONOBJ_EQ(expected[i], actual[i]);
+    }
+}
+
+TEST(ClusterQueryResultCacheTest, LookupReturnsInsertedResults) {
+    ClusterQueryResultCache cache;
+    ASSERT(!cache.lookup(kNss, "key", kNow));
+
+    cache.insert(kNss, "key", makeResults(), kExpiration, cache.getGeneration(kNss));
+
+    auto results = cache.lookup(kNss, "key", kNow);
+    ASSERT(results);
+    assertResultsEqual(makeResults(), *results);
+    ASSERT(!cache.lookup(kNss, "otherKey", kNow));
+}
+
+TEST(ClusterQueryResultCacheTest, ExpiredResultsAreNotReturned) {
+    ClusterQueryResultCache cache;
+    cache.insert(kNss, "key", makeResults(), kExpiration, cache.getGeneration(kNss));
+
+    ASSERT(cache.lookup(kNss, "key", kExpiration - Milliseconds(1)));
+    ASSERT(!cache.lookup(kNss, "key", kExpiration));
+    ASSERT(!cache.lookup(kNss, "key", kNow));
+}
+
+TEST(ClusterQueryResultCacheTest, InvalidationDiscardsResultsOfNamespaceOnly) {
+    ClusterQueryResultCache cache;
+    cache.insert(kNss, "key", makeResults(), kExpiration, cache.getGeneration(kNss));
+    cache.insert(kOtherNss, "otherKey", makeResults(), kExpiration, cache.getGeneration(kOtherNss));
+
+    cache.invalidate(kNss);
+
+    ASSERT(!cache.lookup(kNss, "key", kNow));
+    ASSERT(cache.lookup(kOtherNss, "otherKey", kNow));
+
+    // Results obtained after the invalidation can be cached again.
+    cache.insert(kNss, "key", makeResults(), kExpiration, cache.getGeneration(kNss));
+    ASSERT(cache.lookup(kNss, "key", kNow));
+}
+
+TEST(ClusterQueryResultCacheTest, ResultsOfQueryConcurrentWithWriteAreNotInserted) {
+    ClusterQueryResultCache cache;
+    const auto generation = cache.getGeneration(kNss);
+
+    // A write completes while the query is running.
+    cache.invalidate(kNss);
+
+    cache.insert(kNss, "key", makeResults(), kExpiration, generation);
+    ASSERT(!cache.lookup(kNss, "key", kNow));
+}
+
+TEST(ClusterQueryResultCacheTest, LeastRecentlyUsedEntriesAreEvicted) {
+    ClusterQueryResultCache cache;
+    for (std::size_t i = 0; i <= ClusterQueryResultCache::kMaxEntries; i++) {
+        cache.insert(kNss,
+                     str::stream() << "key" << i,
+                     makeResults(),
+                     kExpiration,
+                     cache.getGeneration(kNss));
+    }
+
+    ASSERT(!cache.lookup(kNss, "key0", kNow));
+    ASSERT(cache.lookup(kNss, "key1", kNow));
+
+    BSONObjBuilder builder;
+    cache.report(&builder);
+    const auto report = builder.obj();
+    ASSERT_EQ(static_cast<long long>(ClusterQueryResultCache::kMaxEntries),
+              report["numEntries"].numberLong());
+    ASSERT_EQ(1, report["numHits"].numberLong());
+    ASSERT_EQ(1, report["numMisses"].numberLong());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -82,6 +82,9 @@ protected:
                                               static_cast<std::int64_t>(*qr->getBatchSize()))
                                         : boost::none);
             }
+            if (qr->getLimit()) {
+                params.setLimit(*qr->getLimit() + qr->getSkip().value_or(0));
+            }
             params.setTailableMode(qr->getTailableMode());
             params.setAllowPartialResults(qr->isAllowPartialResults());
         }
@@ -34,6 +34,7 @@
 #include "mongo/s/catalog_cache.h"
 #include "mongo/s/client/shard_registry.h"
 #include "mongo/s/grid.h"
+#include "mongo/s/query/cluster_query_result_cache.h"
 
 namespace mongo {
 namespace {
@@ -82,6 +83,11 @@ public:
 
         BSONObjBuilder result;
         catalogCache->report(&result);
+
+        BSONObjBuilder resultCacheBuilder(result.subobjStart("queryResultCache"));
+        ClusterQueryResultCache::get(opCtx)->report(&resultCacheBuilder);
+        resultCacheBuilder.doneFast();
+
         return result.obj();
     }
 
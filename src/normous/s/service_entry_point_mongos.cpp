@@ -94,9 +94,15 @@ DbResponse ServiceEntryPointMongos::handleRequest(OperationContext* opCtx, const
         auto dbResponse = Strategy::clientCommand(opCtx, message);
 
         // Mark the op as complete, populate the response length, and log it if appropriate.
-        CurOp::get(opCtx)->completeAndLogOperation(
+        auto curOp = CurOp::get(opCtx);
+        curOp->completeAndLogOperation(
             opCtx, logger::LogComponent::kCommand, dbResponse.response.size());
 
+        if (auto command = curOp->getCommand()) {
+            command->recordLatency(
+                durationCount<Microseconds>(curOp->elapsedTimeExcludingPauses()));
+        }
+
         return dbResponse;
     }
 
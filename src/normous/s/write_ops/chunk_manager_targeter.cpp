@@ -35,6 +35,7 @@
 #include "mongo/db/matcher/extensions_callback_noop.h"
 #include "mongo/db/query/canonical_query.h"
 #include "mongo/db/query/collation/collation_index_key.h"
+#include "mongo/db/query/collation/collation_spec.h"
 #include "mongo/s/client/shard_registry.h"
 #include "mongo/s/cluster_commands_helpers.h"
 #include "mongo/s/grid.h"
@@ -331,6 +332,7 @@ Status ChunkManagerTargeter::init(OperationContext* opCtx) {
         return routingInfoStatus.getStatus();
     }
 
+    _lastTargetedChunk = boost::none;
     _routingInfo = std::move(routingInfoStatus.getValue());
 
     return Status::OK();
@@ -626,9 +628,25 @@ StatusWith<std::vector<ShardEndpoint>> ChunkManagerTargeter::_targetQuery(
 ShardEndpoint ChunkManagerTargeter::_targetShardKey(const BSONObj& shardKey,
                                                     const BSONObj& collation,
                                                     long long estDataSize) const {
-    const auto chunk = _routingInfo->cm()->findIntersectingChunk(shardKey, collation);
+    const auto& cm = _routingInfo->cm();
 
-    return {chunk.getShardId(), _routingInfo->cm()->getVersion(chunk.getShardId())};
+    // Only shard keys compared with the simple collation can be routed by a plain range check
+    const bool hasSimpleCollation = (collation.isEmpty() && !cm->getDefaultCollator()) ||
+        SimpleBSONObjComparator::kInstance.evaluate(collation == CollationSpec::kSimpleSpec);
+
+    if (hasSimpleCollation && _lastTargetedChunk &&
+        _lastTargetedChunk->chunk.containsKey(shardKey)) {
+        return _lastTargetedChunk->endpoint;
+    }
+
+    const auto chunk = cm->findIntersectingChunk(shardKey, collation);
+    ShardEndpoint endpoint(chunk.getShardId(), cm->getVersion(chunk.getShardId()));
+
+    if (hasSimpleCollation) {
+        _lastTargetedChunk.emplace(LastTargetedChunk{chunk, endpoint});
+    }
+
+    return endpoint;
 }
 
 StatusWith<std::vector<ShardEndpoint>> ChunkManagerTargeter::targetCollection() const {
@@ -164,6 +164,16 @@ private:
     // The latest loaded routing cache entry
     boost::optional<CachedCollectionRoutingInfo> _routingInfo;
 
+    // The chunk, and its endpoint, to which the last shard key routed with the simple collation
+    // belonged. Consecutive writes in a batch often fall in the same chunk, in which case a range
+    // check against it is cheaper than looking the key up in the routing table. The chunk refers
+    // into '_routingInfo', so this must be reset whenever '_routingInfo' changes.
+    struct LastTargetedChunk {
+        Chunk chunk;
+        ShardEndpoint endpoint;
+    };
+    mutable boost::optional<LastTargetedChunk> _lastTargetedChunk;
+
     // Map of shard->remote shard version reported from stale errors
     ShardVersionMap _remoteShardVersions;
 };
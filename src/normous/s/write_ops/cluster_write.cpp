@@ -46,10 +46,12 @@
 #include "mongo/s/client/shard_registry.h"
 #include "mongo/s/config_server_client.h"
 #include "mongo/s/grid.h"
+#include "mongo/s/query/cluster_query_result_cache.h"
 #include "mongo/s/shard_util.h"
 #include "mongo/s/write_ops/chunk_manager_targeter.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -70,6 +72,9 @@ void ClusterWriter::write(OperationContext* opCtx,
 
     LastError::Disabled disableLastError(&LastError::get(opCtx->getClient()));
 
+    // Results cached before this write completes may no longer be accurate.
+    ON_BLOCK_EXIT([&] { ClusterQueryResultCache::get(opCtx)->invalidate(nss); });
+
     // Config writes and shard writes are done differently
     if (nss.db() == NamespaceString::kAdminDb) {
         Grid::get(opCtx)->catalogClient()->writeConfigServerDirect(opCtx, request, response);
@@ -39,10 +39,15 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/service_context.h"
 #include "mongo/scripting/dbdirectclient_factory.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/concurrency/thread_name.h"
+#include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/fail_point_service.h"
 #include "mongo/util/file.h"
 #include "mongo/util/log.h"
 #include "mongo/util/text.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
@@ -324,11 +329,35 @@ void Scope::execCoreFiles() {
 }
 
 namespace {
+/**
+ * Keeps idle scopes for reuse by the pool they were last used by, along with a small stock of
+ * fresh scopes that have only been initialized and so can be handed to any pool. The stock is
+ * replenished by a background thread, so that an operation which misses its pool does not pay
+ * for creating and initializing a scope.
+ *
+ * The number of idle scopes kept grows with the most scopes in use at once over the last minute
+ * or two, so that a burst of operations can find their scopes again when they next run.
+ */
 class ScopeCache {
 public:
+    ~ScopeCache() {
+        clear();
+    }
+
+    void noteAcquired() {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+
+        _rotateLoadWindow(lk);
+        ++_numInUse;
+        _peakInUseThisWindow = std::max(_peakInUseThisWindow, _numInUse);
+    }
+
     void release(const string& poolName, const std::shared_ptr<Scope>& scope) {
         stdx::lock_guard<stdx::mutex> lk(_mutex);
 
+        _rotateLoadWindow(lk);
+        --_numInUse;
+
         if (scope->hasOutOfMemoryException()) {
             // make some room
             log() << "Clearing all idle JS contexts due to out of memory";
@@ -342,7 +371,10 @@ public:
         if (!scope->getError().empty())
             return;  // not saving errored scopes
 
-        if (_pools.size() >= kMaxPoolSize) {
+        size_t maxPoolSize = std::max(_peakInUseThisWindow, _peakInUseLastWindow);
+        maxPoolSize = std::max(maxPoolSize, size_t(kMinPoolSize));
+        maxPoolSize = std::min(maxPoolSize, size_t(kMaxPoolSize));
+        while (_pools.size() >= maxPoolSize) {
             // prefer to keep recently-used scopes
             _pools.pop_back();
         }
@@ -366,13 +398,34 @@ public:
             }
         }
 
-        return std::shared_ptr<Scope>();
+        _startWarmer(lk);
+        if (_warmScopes.empty()) {
+            return std::shared_ptr<Scope>();
+        }
+
+        std::shared_ptr<Scope> scope = std::move(_warmScopes.back());
+        _warmScopes.pop_back();
+        _warmScopesChanged.notify_all();
+        scope->registerOperation(opCtx);
+        return scope;
     }
 
     void clear() {
-        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        stdx::unique_lock<stdx::mutex> lk(_mutex);
 
         _pools.clear();
+        _warmScopes.clear();
+
+        if (_warmer.joinable()) {
+            _stopWarmer = true;
+            _warmScopesChanged.notify_all();
+            stdx::thread warmer = std::move(_warmer);
+            lk.unlock();
+            warmer.join();
+            lk.lock();
+            _stopWarmer = false;
+            _warmScopes.clear();
+        }
     }
 
 private:
@@ -381,12 +434,73 @@ private:
         string poolName;
     };
 
+    void _rotateLoadWindow(WithLock) {
+        const Date_t now = Date_t::now();
+        if (now - _loadWindowStart < Minutes(1)) {
+            return;
+        }
+        _peakInUseLastWindow = _peakInUseThisWindow;
+        _peakInUseThisWindow = _numInUse;
+        _loadWindowStart = now;
+    }
+
+    void _startWarmer(WithLock) {
+        if (_warmer.joinable()) {
+            return;
+        }
+        _warmer = stdx::thread([this] { _warmScopesLoop(); });
+    }
+
+    void _warmScopesLoop() {
+        setThreadName("JSScopeWarmer");
+
+        stdx::unique_lock<stdx::mutex> lk(_mutex);
+        while (true) {
+            _warmScopesChanged.wait(
+                lk, [&] { return _stopWarmer || _warmScopes.size() < kNumWarmScopes; });
+            if (_stopWarmer) {
+                return;
+            }
+
+            lk.unlock();
+            std::shared_ptr<Scope> scope;
+            try {
+                scope.reset(getGlobalScriptEngine()->newScope());
+            } catch (const DBException& ex) {
+                warning() << "Unable to create a JavaScript scope ahead of use: " << ex.toStatus();
+            }
+            lk.lock();
+
+            if (!scope) {
+                // Leave further scopes to be created when they are needed.
+                return;
+            }
+            _warmScopes.push_back(std::move(scope));
+        }
+    }
+
     // Note: if these numbers change, reconsider choice of datastructure for _pools
-    static const unsigned kMaxPoolSize = 10;
+    static const size_t kMinPoolSize = 10;
+    static const size_t kMaxPoolSize = 50;
     static const int kMaxScopeReuse = 10;
 
+    static const size_t kNumWarmScopes = 2;
+
     typedef std::deque<ScopeAndPool> Pools;  // More-recently used Scopes are kept at the front.
     Pools _pools;                            // protected by _mutex
+
+    // Scopes in use through PooledScope, and the most in use at once during the current and the
+    // previous load window.
+    size_t _numInUse = 0;
+    size_t _peakInUseThisWindow = 0;
+    size_t _peakInUseLastWindow = 0;
+    Date_t _loadWindowStart;
+
+    std::vector<std::shared_ptr<Scope>> _warmScopes;
+    stdx::condition_variable _warmScopesChanged;
+    stdx::thread _warmer;
+    bool _stopWarmer = false;
+
     stdx::mutex _mutex;
 };
 
@@ -400,7 +514,9 @@ void ScriptEngine::dropScopeCache() {
 class PooledScope : public Scope {
 public:
     PooledScope(const std::string& pool, const std::shared_ptr<Scope>& real)
-        : _pool(pool), _real(real) {}
+        : _pool(pool), _real(real) {
+        scopeCache.noteAcquired();
+    }
 
     virtual ~PooledScope() {
         scopeCache.release(_pool, _real);
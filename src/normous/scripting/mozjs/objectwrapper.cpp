@@ -506,19 +506,18 @@ BSONObj ObjectWrapper::toBSON() {
         while (frames.size()) {
             auto& frame = frames.top();
 
-            // If the index is the same as length, we've seen all the keys at this
-            // level and should go up a level
-            if (frame.idx == frame.ids.length()) {
+            if (frame.originalBSON && !frame.altered) {
+                // The object has an unaltered bson behind it (and so no keys were
+                // enumerated for it), so copy that and go up a level.
+                frame.subbob_or(&b)->appendElements(*frame.originalBSON);
                 frames.pop();
                 continue;
             }
 
-            if (frame.idx == 0 && frame.originalBSON && !frame.altered) {
-                // If this is our first look at the object and it has an unaltered
-                // bson behind it, move idx to the end so we'll roll up on the next
-                // pass through the loop.
-                frame.subbob_or(&b)->appendElements(*frame.originalBSON);
-                frame.idx = frame.ids.length();
+            // If the index is the same as length, we've seen all the keys at this
+            // level and should go up a level
+            if (frame.idx == frame.ids.length()) {
+                frames.pop();
                 continue;
             }
 
@@ -568,6 +567,18 @@ ObjectWrapper::WriteFieldRecursionFrame::WriteFieldRecursionFrame(JSContext* cx,
         subbob.emplace(isArray ? parent->subarrayStart(sd) : parent->subobjStart(sd));
     }
 
+    if (getScope(cx)->getProto<BSONInfo>().instanceOf(thisv) ||
+        getScope(cx)->getProto<DBRefInfo>().instanceOf(thisv)) {
+        std::tie(originalBSON, altered) = BSONInfo::originalBSON(cx, thisv);
+
+        if (originalBSON && !altered) {
+            // The object will be written by copying its original BSON, so there's no need to
+            // enumerate its keys. For lazily resolved objects that would also convert every field
+            // name to a JS string just to throw it away.
+            return;
+        }
+    }
+
     if (isArray) {
         uint32_t length;
         if (!JS_GetArrayLength(cx, thisv, &length)) {
@@ -591,11 +602,6 @@ ObjectWrapper::WriteFieldRecursionFrame::WriteFieldRecursionFrame(JSContext* cx,
                 cx, ErrorCodes::JSInterpreterFailure, "Failure to enumerate object");
         }
     }
-
-    if (getScope(cx)->getProto<BSONInfo>().instanceOf(thisv) ||
-        getScope(cx)->getProto<DBRefInfo>().instanceOf(thisv)) {
-        std::tie(originalBSON, altered) = BSONInfo::originalBSON(cx, thisv);
-    }
 }
 
 void ObjectWrapper::_writeField(BSONObjBuilder* b,
@@ -323,11 +323,33 @@ Timestamp getAClusterTimeSecondsInThePast(DBClientBase* conn, int numSecondsInTh
 
 }  // namespace
 
-BenchRunEventCounter::BenchRunEventCounter() = default;
+BenchRunEventCounter::BenchRunEventCounter()
+    : _latencies(stdx::make_unique<HdrLatencyHistogram>()) {}
+
+BenchRunEventCounter::BenchRunEventCounter(const BenchRunEventCounter& other)
+    : BenchRunEventCounter() {
+    updateFrom(other);
+}
+
+BenchRunEventCounter& BenchRunEventCounter::operator=(const BenchRunEventCounter& other) {
+    if (this != &other) {
+        _numEvents = 0;
+        _totalTimeMicros = 0;
+        _latencies = stdx::make_unique<HdrLatencyHistogram>();
+        updateFrom(other);
+    }
+    return *this;
+}
 
 void BenchRunEventCounter::updateFrom(const BenchRunEventCounter& other) {
     _numEvents += other._numEvents;
     _totalTimeMicros += other._totalTimeMicros;
+    _latencies->merge(*other._latencies);
+}
+
+void BenchRunEventCounter::appendLatencies(BSONObjBuilder* builder) const {
+    _latencies->append(false, builder);
+    builder->append("max", static_cast<long long>(_latencies->getPercentile(100)));
 }
 
 void BenchRunStats::updateFrom(const BenchRunStats& other) {
@@ -343,6 +365,13 @@ void BenchRunStats::updateFrom(const BenchRunStats& other) {
     queryCounter.updateFrom(other.queryCounter);
     commandCounter.updateFrom(other.commandCounter);
 
+    for (const auto& entry : other.responseTimeCounters) {
+        responseTimeCounters[entry.first].updateFrom(entry.second);
+    }
+    for (const auto& entry : other.phaseResponseTimeCounters) {
+        phaseResponseTimeCounters[entry.first].updateFrom(entry.second);
+    }
+
     for (const auto& trappedError : other.trappedErrors) {
         trappedErrors.push_back(trappedError);
     }
@@ -360,6 +389,8 @@ void BenchRunConfig::initializeToDefaults() {
 
     parallel = 1;
     seconds = 1.0;
+    opsPerSecond = 0;
+    phases.clear();
     hideResults = true;
     handleErrors = false;
     hideErrors = false;
@@ -625,6 +656,50 @@ BenchRunOp opFromBson(const BSONObj& op) {
     return myOp;
 }
 
+BenchRunConfig::Phase phaseFromBson(const BSONElement& elem, size_t index) {
+    uassert(50986,
+            str::stream() << "Benchrun phase should be an object. Type is "
+                          << typeName(elem.type()),
+            elem.type() == Object);
+
+    BenchRunConfig::Phase phase;
+    phase.name = str::stream() << "phase" << index;
+    phase.seconds = 0;
+    phase.opsPerSecond = 0;
+    boost::optional<double> rampToOpsPerSecond;
+
+    for (auto arg : elem.Obj()) {
+        auto name = arg.fieldNameStringData();
+        if (name == "name") {
+            uassert(50987,
+                    str::stream() << "Benchrun phase field '" << name
+                                  << "' should be a string. Type is "
+                                  << typeName(arg.type()),
+                    arg.type() == String);
+            phase.name = arg.String();
+        } else if (name == "seconds" || name == "opsPerSecond" || name == "rampToOpsPerSecond") {
+            uassert(50988,
+                    str::stream() << "Benchrun phase field '" << name
+                                  << "' should be a non-negative number. Value is "
+                                  << arg,
+                    arg.isNumber() && arg.number() >= 0);
+            if (name == "seconds") {
+                phase.seconds = arg.number();
+            } else if (name == "opsPerSecond") {
+                phase.opsPerSecond = arg.number();
+            } else {
+                rampToOpsPerSecond = arg.number();
+            }
+        } else {
+            uasserted(50989, str::stream() << "Benchrun phase has unsupported field: " << name);
+        }
+    }
+
+    uassert(50990, "Benchrun phase must have a positive 'seconds'", phase.seconds > 0);
+    phase.rampToOpsPerSecond = rampToOpsPerSecond.value_or(phase.opsPerSecond);
+    return phase;
+}
+
 void BenchRunConfig::initializeFromBson(const BSONObj& args) {
     initializeToDefaults();
 
@@ -696,6 +771,21 @@ void BenchRunConfig::initializeFromBson(const BSONObj& args) {
                                   << typeName(arg.type()),
                     arg.isNumber());
             delayMillisOnFailedOperation = Milliseconds(arg.numberInt());
+        } else if (name == "opsPerSecond") {
+            uassert(50984,
+                    str::stream() << "Field '" << name << "' should be a non-negative number. "
+                                  << "Value is "
+                                  << arg,
+                    arg.isNumber() && arg.number() >= 0);
+            opsPerSecond = arg.number();
+        } else if (name == "phases") {
+            uassert(50985,
+                    str::stream() << "Field '" << name << "' should be an array. Type is "
+                                  << typeName(arg.type()),
+                    arg.type() == Array);
+            for (auto&& phaseElem : arg.Obj()) {
+                phases.push_back(phaseFromBson(phaseElem, phases.size()));
+            }
         } else if (name == "hideResults") {
             hideResults = arg.trueValue();
         } else if (name == "handleErrors") {
@@ -739,6 +829,35 @@ void BenchRunConfig::initializeFromBson(const BSONObj& args) {
             uassert(34376, "benchRun passed an unsupported configuration field", false);
         }
     }
+
+    if (!phases.empty()) {
+        seconds = 0;
+        for (const auto& phase : phases) {
+            seconds += phase.seconds;
+        }
+    }
+}
+
+double BenchRunConfig::targetOpsPerSecond(double elapsedSeconds, size_t* phase) const {
+    if (phases.empty()) {
+        *phase = 0;
+        return opsPerSecond;
+    }
+
+    double phaseStart = 0;
+    for (size_t i = 0; i < phases.size(); ++i) {
+        const auto& current = phases[i];
+        if (elapsedSeconds < phaseStart + current.seconds) {
+            *phase = i;
+            const double progress = (elapsedSeconds - phaseStart) / current.seconds;
+            return current.opsPerSecond +
+                (current.rampToOpsPerSecond - current.opsPerSecond) * progress;
+        }
+        phaseStart += current.seconds;
+    }
+
+    *phase = phases.size();
+    return 0;
 }
 
 MONGO_DEFINE_SHIM(BenchRunConfig::createConnectionImpl);
@@ -852,6 +971,39 @@ bool BenchRunWorker::shouldCollectStats() const {
     return _brState.shouldWorkerCollectStats();
 }
 
+boost::optional<long long> BenchRunWorker::waitForScheduledStart(const Timer& timer,
+                                                                 long long* nextStartMicros,
+                                                                 size_t* phase) const {
+    while (!shouldStop()) {
+        const double opsPerSecond =
+            _config->targetOpsPerSecond(*nextStartMicros / 1000000.0, phase);
+        if (opsPerSecond <= 0) {
+            if (*phase == _config->phases.size()) {
+                // The last phase is over, so wait for the run to be stopped.
+                sleepmillis(10);
+            } else {
+                // Step the schedule through a part of a phase that has no arrivals.
+                *nextStartMicros += 1000;
+            }
+            continue;
+        }
+
+        const long long nowMicros = timer.micros();
+        if (nowMicros < *nextStartMicros) {
+            sleepmicros(std::min(*nextStartMicros - nowMicros, 100 * 1000LL));
+            continue;
+        }
+
+        // Each of the 'parallel' threads issues an equal share of the arrivals. A thread that has
+        // fallen behind issues its backlog immediately rather than skipping it.
+        const long long intendedStartMicros = *nextStartMicros;
+        *nextStartMicros += std::max(
+            1LL, static_cast<long long>(_config->parallel * 1000000.0 / opsPerSecond));
+        return intendedStartMicros;
+    }
+    return boost::none;
+}
+
 void BenchRunWorker::generateLoadOnConnection(DBClientBase* conn) {
     verify(conn);
     long long count = 0;
@@ -888,14 +1040,39 @@ void BenchRunWorker::generateLoadOnConnection(DBClientBase* conn) {
         }
     });
 
+    const bool openLoop = _config->isOpenLoop();
+    Timer scheduleTimer;
+    long long nextStartMicros = 0;
+
     while (!shouldStop()) {
         for (const auto& op : _config->ops) {
             if (shouldStop())
                 break;
 
+            boost::optional<long long> intendedStartMicros;
+            size_t phase = 0;
+            if (openLoop) {
+                intendedStartMicros =
+                    waitForScheduledStart(scheduleTimer, &nextStartMicros, &phase);
+                if (!intendedStartMicros)
+                    break;
+            }
+
             opState.stats = shouldCollectStats() ? &_stats : &_statsBlackHole;
 
             try {
+                // Record the response time as soon as the operation completes or fails, before
+                // any error handling below sleeps.
+                ON_BLOCK_EXIT([&] {
+                    if (!intendedStartMicros)
+                        return;
+                    const long long responseMicros = scheduleTimer.micros() - *intendedStartMicros;
+                    opState.stats->responseTimeCounters[kOpTypeNames.find(op.op)->second]
+                        .countOne(responseMicros);
+                    if (!_config->phases.empty()) {
+                        opState.stats->phaseResponseTimeCounters[phase].countOne(responseMicros);
+                    }
+                });
                 op.executeOnce(conn, lsid, *_config, &opState);
             } catch (const DBException& ex) {
                 if (!_config->hideErrors || op.showError) {
@@ -949,7 +1126,7 @@ void BenchRunWorker::generateLoadOnConnection(DBClientBase* conn) {
                 conn->getLastError();
             }
 
-            if (op.delay > 0)
+            if (!openLoop && op.delay > 0)
                 sleepmillis(op.delay);
         }
     }
@@ -1470,6 +1647,54 @@ BSONObj BenchRunner::finish(BenchRunner* runner) {
     appendAverageMicrosIfAvailable("queryLatencyAverageMicros", stats.queryCounter);
     appendAverageMicrosIfAvailable("commandsLatencyAverageMicros", stats.commandCounter);
 
+    // Averages hide the tail, so also report percentiles for each kind of operation that ran.
+    {
+        BSONObjBuilder latencyBuilder(buf.subobjStart("latencyMicros"));
+        const auto appendLatenciesIfAvailable = [&latencyBuilder](
+            StringData name, const BenchRunEventCounter& counter) {
+            if (counter.getNumEvents() > 0) {
+                BSONObjBuilder counterBuilder(latencyBuilder.subobjStart(name));
+                counter.appendLatencies(&counterBuilder);
+            }
+        };
+
+        appendLatenciesIfAvailable("findOne", stats.findOneCounter);
+        appendLatenciesIfAvailable("insert", stats.insertCounter);
+        appendLatenciesIfAvailable("delete", stats.deleteCounter);
+        appendLatenciesIfAvailable("update", stats.updateCounter);
+        appendLatenciesIfAvailable("query", stats.queryCounter);
+        appendLatenciesIfAvailable("command", stats.commandCounter);
+    }
+
+    const auto& config = runner->config();
+    if (config.isOpenLoop()) {
+        BSONObjBuilder responseTimeBuilder(buf.subobjStart("responseTimeMicros"));
+        for (const auto& entry : stats.responseTimeCounters) {
+            BSONObjBuilder counterBuilder(responseTimeBuilder.subobjStart(entry.first));
+            entry.second.appendLatencies(&counterBuilder);
+        }
+    }
+
+    if (!config.phases.empty()) {
+        BSONArrayBuilder phasesBuilder(buf.subarrayStart("phases"));
+        for (size_t i = 0; i < config.phases.size(); ++i) {
+            const auto& phase = config.phases[i];
+            BSONObjBuilder phaseBuilder(phasesBuilder.subobjStart());
+            phaseBuilder.append("name", phase.name);
+            phaseBuilder.append("seconds", phase.seconds);
+            phaseBuilder.append("opsPerSecond", phase.opsPerSecond);
+            phaseBuilder.append("rampToOpsPerSecond", phase.rampToOpsPerSecond);
+
+            BSONObjBuilder responseTimeBuilder(phaseBuilder.subobjStart("responseTimeMicros"));
+            const auto it = stats.phaseResponseTimeCounters.find(i);
+            if (it != stats.phaseResponseTimeCounters.end()) {
+                it->second.appendLatencies(&responseTimeBuilder);
+            } else {
+                BenchRunEventCounter().appendLatencies(&responseTimeBuilder);
+            }
+        }
+    }
+
     buf.append("totalOps", static_cast<long long>(stats.opCount));
 
     const auto appendPerSec = [&buf, runner](StringData name, double total) {
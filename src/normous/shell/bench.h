@@ -28,13 +28,16 @@
 
 #pragma once
 
+#include <algorithm>
 #include <boost/optional.hpp>
+#include <memory>
 #include <string>
 
 #include "mongo/base/shim.h"
 #include "mongo/client/dbclient_base.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/logical_session_id.h"
+#include "mongo/db/stats/hdr_latency_histogram.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/mutex.h"
@@ -221,6 +224,45 @@ public:
      */
     Milliseconds delayMillisOnFailedOperation{0};
 
+    /**
+     * One stage of an open-loop run. The arrival rate moves linearly from 'opsPerSecond' to
+     * 'rampToOpsPerSecond' over 'seconds', so equal rates give a steady phase and different ones
+     * a ramp.
+     */
+    struct Phase {
+        std::string name;
+        double seconds;
+        double opsPerSecond;
+        double rampToOpsPerSecond;
+    };
+
+    /**
+     * If non-zero, the total number of operations per second to issue across all threads. Each
+     * thread then issues its share of operations on a fixed schedule instead of back to back,
+     * and op 'delay' settings are ignored.
+     */
+    double opsPerSecond{0};
+
+    /**
+     * If non-empty, the arrival rate follows these phases in order instead of 'opsPerSecond', and
+     * 'seconds' is their total duration. Threads stay idle once the last phase is over.
+     */
+    std::vector<Phase> phases;
+
+    /**
+     * Whether operations are issued at a fixed arrival rate rather than as fast as the previous
+     * operation on the same thread completes.
+     */
+    bool isOpenLoop() const {
+        return opsPerSecond > 0 || !phases.empty();
+    }
+
+    /**
+     * Returns the total arrival rate 'elapsedSeconds' into an open-loop run, and sets '*phase' to
+     * the index of the phase that time falls in, or to phases.size() once all are over.
+     */
+    double targetOpsPerSecond(double elapsedSeconds, size_t* phase) const;
+
     /// Base random seed for threads
     int64_t randomSeed;
 
@@ -262,6 +304,8 @@ private:
 class BenchRunEventCounter {
 public:
     BenchRunEventCounter();
+    BenchRunEventCounter(const BenchRunEventCounter& other);
+    BenchRunEventCounter& operator=(const BenchRunEventCounter& other);
 
     /**
      * Conceptually the equivalent of "+=". Adds "other" into this.
@@ -278,6 +322,7 @@ public:
         }
         ++_numEvents;
         _totalTimeMicros += timeMicros;
+        _latencies->increment(std::max(timeMicros, 0LL));
     }
 
     /**
@@ -294,9 +339,15 @@ public:
         return _numEvents;
     }
 
+    /**
+     * Appends the latency percentiles of the observed events, and their maximum.
+     */
+    void appendLatencies(BSONObjBuilder* builder) const;
+
 private:
     long long _totalTimeMicros{0};
     long long _numEvents{0};
+    std::unique_ptr<HdrLatencyHistogram> _latencies;
 };
 
 /**
@@ -370,6 +421,12 @@ struct BenchRunStats {
     BenchRunEventCounter queryCounter;
     BenchRunEventCounter commandCounter;
 
+    // Only filled in by open-loop runs. Response times are measured from when each operation was
+    // scheduled to start rather than from when it did, so they include any time spent waiting
+    // behind earlier operations on the same thread.
+    std::map<std::string, BenchRunEventCounter> responseTimeCounters;
+    std::map<size_t, BenchRunEventCounter> phaseResponseTimeCounters;
+
     std::map<std::string, long long> opcounters;
     std::vector<BSONObj> trappedErrors;
 };
@@ -504,6 +561,16 @@ private:
     /// Predicate, used to decide whether or not it's time to collect statistics
     bool shouldCollectStats() const;
 
+    /**
+     * In open-loop runs, blocks until the next operation is due, then returns its intended start
+     * time as measured by 'timer' and sets '*phase' to the phase it belongs to. Advances
+     * '*nextStartMicros' by this thread's share of the arrival interval. Returns boost::none if
+     * the worker should stop instead.
+     */
+    boost::optional<long long> waitForScheduledStart(const Timer& timer,
+                                                     long long* nextStartMicros,
+                                                     size_t* phase) const;
+
     stdx::thread _thread;
 
     const size_t _id;
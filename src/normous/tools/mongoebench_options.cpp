@@ -62,7 +62,11 @@ Status addMongoeBenchOptions(moe::OptionSection* options) {
             "threads", "threads,t", moe::Unsigned, "number of benchRun worker threads")
         .setDefault(moe::Value(1U));
 
-    options->addOptionChaining("time", "time,s", moe::Double, "seconds to run benchRun for")
+    options
+        ->addOptionChaining("time",
+                            "time,s",
+                            moe::Double,
+                            "seconds to run benchRun for, unless the config file has \"phases\"")
         .setDefault(moe::Value(1.0));
 
     options->addOptionChaining("output",
@@ -106,19 +110,29 @@ Status storeMongoeBenchOptions(const moe::Environment& params,
     }
 
     BSONObj config = getBsonFromJsonFile(params["benchRunConfigFile"].as<std::string>());
+    BSONObjBuilder opsConfigBuilder;
     for (auto&& elem : config) {
         const auto fieldName = elem.fieldNameStringData();
         if (fieldName == "pre") {
             mongoeBenchGlobalParams.preConfig.reset(
                 BenchRunConfig::createFromBson(elem.wrap("ops")));
-        } else if (fieldName == "ops") {
-            mongoeBenchGlobalParams.opsConfig.reset(BenchRunConfig::createFromBson(elem.wrap()));
+        } else if (fieldName == "ops" || fieldName == "opsPerSecond" || fieldName == "phases") {
+            // The arrival rate settings only apply to the repeatedly run "ops" section.
+            opsConfigBuilder.append(elem);
         } else {
             return {ErrorCodes::BadValue,
                     str::stream() << "Unrecognized key in benchRun config file: " << fieldName};
         }
     }
 
+    BSONObj opsConfig = opsConfigBuilder.obj();
+    if (opsConfig.hasField("ops")) {
+        mongoeBenchGlobalParams.opsConfig.reset(BenchRunConfig::createFromBson(opsConfig));
+    } else if (!opsConfig.isEmpty()) {
+        return {ErrorCodes::BadValue,
+                "The benchRun config file sets an arrival rate but has no \"ops\" section"};
+    }
+
     int64_t seed = params.count("seed") ? static_cast<int64_t>(params["seed"].as<long>())
                                         : SecureRandom::create()->nextInt64();
 
@@ -133,7 +147,8 @@ Status storeMongoeBenchOptions(const moe::Environment& params,
             mongoeBenchGlobalParams.opsConfig->parallel = params["threads"].as<unsigned>();
         }
 
-        if (params.count("time")) {
+        // A phased workload runs for as long as its phases last.
+        if (params.count("time") && mongoeBenchGlobalParams.opsConfig->phases.empty()) {
             mongoeBenchGlobalParams.opsConfig->seconds = params["time"].as<double>();
         }
     }
@@ -233,6 +233,19 @@ TEST(ZlibMessageCompressor, Fidelity) {
     checkFidelity(testMessage, stdx::make_unique<ZlibMessageCompressor>());
 }
 
+TEST(ZlibMessageCompressor, FidelityAtConfiguredLevels) {
+    auto testMessage = buildMessage();
+    checkFidelity(testMessage, stdx::make_unique<ZlibMessageCompressor>(1));
+    checkFidelity(testMessage, stdx::make_unique<ZlibMessageCompressor>(9));
+}
+
+TEST(ZlibMessageCompressor, RejectsInvalidLevels) {
+    ASSERT_EQ(setZlibMessageCompressionLevel(0), ErrorCodes::BadValue);
+    ASSERT_EQ(setZlibMessageCompressionLevel(10), ErrorCodes::BadValue);
+    ASSERT_EQ(setZlibMessageCompressionLevel(-2), ErrorCodes::BadValue);
+    ASSERT_OK(setZlibMessageCompressionLevel(ZlibMessageCompressor::kDefaultCompressionLevel));
+}
+
 TEST(SnappyMessageCompressor, Overflow) {
     checkOverflow(stdx::make_unique<SnappyMessageCompressor>());
 }
@@ -124,6 +124,15 @@ Status addMessageCompressionOptions(moe::OptionSection* options, bool forShell)
     } else {
         ret.setDefault(moe::Value(kDefaultConfigValue.toString()));
     }
+
+    auto& level = options->addOptionChaining(
+        "net.compression.zlibCompressionLevel",
+        "networkMessageCompressorZlibLevel",
+        moe::Int,
+        "Compression level (1-9, or -1 for the zlib default) for zlib network message compression");
+    if (forShell) {
+        level.hidden();
+    }
     return Status::OK();
 }
 
@@ -136,6 +145,14 @@ Status storeMessageCompressionOptions(const moe::Environment& params) {
         }
     }
 
+    if (params.count("net.compression.zlibCompressionLevel")) {
+        auto level = params["net.compression.zlibCompressionLevel"].as<int>();
+        auto status = setZlibMessageCompressionLevel(level);
+        if (!status.isOK()) {
+            return status;
+        }
+    }
+
     auto& compressorFactory = MessageCompressorRegistry::get();
     compressorFactory.setSupportedCompressors(std::move(restrict));
 
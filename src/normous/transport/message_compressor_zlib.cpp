@@ -31,15 +31,25 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/base/init.h"
+#include "mongo/base/static_assert.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/transport/message_compressor_registry.h"
 #include "mongo/transport/message_compressor_zlib.h"
+#include "mongo/util/mongoutils/str.h"
 
 #include <zlib.h>
 
 namespace mongo {
+namespace {
+int zlibMessageCompressionLevel = ZlibMessageCompressor::kDefaultCompressionLevel;
+}  // namespace
 
-ZlibMessageCompressor::ZlibMessageCompressor() : MessageCompressorBase(MessageCompressor::kZlib) {}
+MONGO_STATIC_ASSERT(ZlibMessageCompressor::kDefaultCompressionLevel == Z_DEFAULT_COMPRESSION);
+
+ZlibMessageCompressor::ZlibMessageCompressor(int level)
+    : MessageCompressorBase(MessageCompressor::kZlib), _level(level) {
+    invariant(level == kDefaultCompressionLevel || (level >= 1 && level <= 9));
+}
 
 std::size_t ZlibMessageCompressor::getMaxCompressedSize(size_t inputSize) {
     return ::compressBound(inputSize);
@@ -52,7 +62,7 @@ StatusWith<std::size_t> ZlibMessageCompressor::compressData(ConstDataRange input
                           reinterpret_cast<uLongf*>(&outLength),
                           reinterpret_cast<const Bytef*>(input.data()),
                           input.length(),
-                          Z_DEFAULT_COMPRESSION);
+                          _level);
 
     if (ret != Z_OK) {
         return Status{ErrorCodes::BadValue, "Could not compress input"};
@@ -76,14 +86,23 @@ StatusWith<std::size_t> ZlibMessageCompressor::decompressData(ConstDataRange inp
     counterHitDecompress(input.length(), output.length());
     return {output.length()};
 }
-
+Status setZlibMessageCompressionLevel(int level) {
+    if (level != ZlibMessageCompressor::kDefaultCompressionLevel && (level < 1 || level > 9)) {
+        return {ErrorCodes::BadValue,
+                str::stream() << "Invalid zlib network message compression level " << level
+                              << ", must be between 1 and 9 or -1 for the default"};
+    }
+    zlibMessageCompressionLevel = level;
+    return Status::OK();
+}
 
 MONGO_INITIALIZER_GENERAL(ZlibMessageCompressorInit,
                           ("EndStartupOptionHandling"),
                           ("AllCompressorsRegistered"))
 (InitializerContext* context) {
     auto& compressorRegistry = MessageCompressorRegistry::get();
-    compressorRegistry.registerImplementation(stdx::make_unique<ZlibMessageCompressor>());
+    compressorRegistry.registerImplementation(
+        stdx::make_unique<ZlibMessageCompressor>(zlibMessageCompressionLevel));
     return Status::OK();
 }
 }  // namespace mongo
@@ -31,14 +31,27 @@
 namespace mongo {
 class ZlibMessageCompressor final : public MessageCompressorBase {
 public:
-    ZlibMessageCompressor();
+    // Matches Z_DEFAULT_COMPRESSION.
+    static constexpr int kDefaultCompressionLevel = -1;
+
+    explicit ZlibMessageCompressor(int level = kDefaultCompressionLevel);
 
     std::size_t getMaxCompressedSize(size_t inputSize) override;
 
     StatusWith<std::size_t> compressData(ConstDataRange input, DataRange output) override;
 
     StatusWith<std::size_t> decompressData(ConstDataRange input, DataRange output) override;
+
+private:
+    const int _level;
 };
 
+/**
+ * Sets the compression level of the zlib compressor registered at startup. The level must be
+ * between 1 and 9, or kDefaultCompressionLevel to use zlib's default. Must be called during
+ * startup option storage.
+ */
+Status setZlibMessageCompressionLevel(int level);
+
 
 }  // namespace mongo
@@ -242,6 +242,15 @@ void ServiceEntryPointImpl::appendStats(BSONObjBuilder* bob) const {
     bob->append("current", static_cast<int>(sessionCount));
     bob->append("available", static_cast<int>(_maxNumConnections - sessionCount));
     bob->append("totalCreated", static_cast<int>(_createdConnections.load()));
+    bob->append("active", static_cast<int>(ServiceStateMachine::numActiveSessions()));
+
+    // Memory held on behalf of the connections themselves, rather than by the operations they run.
+    BSONObjBuilder memory(bob->subobjStart("memory"));
+    const auto bufferedBytes = transport::Session::ingressBufferedBytes();
+    memory.append("receiveBufferBytes", static_cast<long long>(bufferedBytes));
+    memory.append("receiveBufferBytesPerConnection",
+                  static_cast<long long>(sessionCount ? bufferedBytes / int64_t(sessionCount) : 0));
+    memory.doneFast();
 
     if (_adminInternalPool) {
         BSONObjBuilder section(bob->subobjStart("adminConnections"));
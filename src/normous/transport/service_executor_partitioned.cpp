@@ -0,0 +1,396 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kExecutor;
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/transport/service_executor_partitioned.h"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "mongo/db/server_parameters.h"
+#include "mongo/transport/service_entry_point_utils.h"
+#include "mongo/util/concurrency/thread_name.h"
+#include "mongo/util/errno_util.h"
+#include "mongo/util/log.h"
+#include "mongo/util/processinfo.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace transport {
+namespace {
+// The number of partitions, each with its own reactor. If the value is 0 (the default), then it
+// will be set to the number of cores.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(partitionedServiceExecutorPartitions, int, 0);
+
+// Each worker thread will allow ASIO to run for this many milliseconds before checking
+// whether it should exit
+MONGO_EXPORT_SERVER_PARAMETER(partitionedServiceExecutorRunTimeMillis, int, 5000);
+
+// This is the amount of time the threads of a partition may all be running tasks without making
+// progress before the controller thread starts a helper thread on that partition.
+MONGO_EXPORT_SERVER_PARAMETER(partitionedServiceExecutorStuckThreadTimeoutMillis, int, 250);
+
+// The maximum number of threads, including the dedicated one, which run a partition's reactor.
+MONGO_EXPORT_SERVER_PARAMETER(partitionedServiceExecutorMaxThreadsPerPartition, int, 4);
+
+// Tasks scheduled with MayRecurse may be called recursively if the recursion depth is below this
+// value.
+MONGO_EXPORT_SERVER_PARAMETER(partitionedServiceExecutorRecursionLimit, int, 8);
+
+// Whether the dedicated thread of each partition is pinned to a core.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(partitionedServiceExecutorPinThreads, bool, true);
+
+constexpr auto kTotalQueued = "totalQueued"_sd;
+constexpr auto kTotalExecuted = "totalExecuted"_sd;
+constexpr auto kThreadsInUse = "threadsInUse"_sd;
+constexpr auto kThreadsRunning = "threadsRunning"_sd;
+constexpr auto kHelperThreadsStarted = "helperThreadsStarted"_sd;
+constexpr auto kExecutorLabel = "executor"_sd;
+constexpr auto kExecutorName = "partitioned"_sd;
+
+struct ServerParameterOptions : public ServiceExecutorPartitioned::Options {
+    Milliseconds workerThreadRunTime() const final {
+        return Milliseconds{partitionedServiceExecutorRunTimeMillis.load()};
+    }
+
+    Milliseconds stuckThreadTimeout() const final {
+        return Milliseconds{partitionedServiceExecutorStuckThreadTimeoutMillis.load()};
+    }
+
+    int maxThreadsPerPartition() const final {
+        return std::max(partitionedServiceExecutorMaxThreadsPerPartition.load(), 1);
+    }
+
+    int recursionLimit() const final {
+        return partitionedServiceExecutorRecursionLimit.load();
+    }
+
+    bool pinThreads() const final {
+        return partitionedServiceExecutorPinThreads;
+    }
+};
+
+/**
+ * Pins the current thread to the 'index'-th core, modulo the number of cores the process is
+ * allowed to run on.
+ */
+void pinCurrentThreadToCore(size_t index) {
+#ifdef __linux__
+    cpu_set_t allowedCpus;
+    CPU_ZERO(&allowedCpus);
+    if (sched_getaffinity(0, sizeof(allowedCpus), &allowedCpus) != 0) {
+        warning() << "Failed to get the cores available to the process: "
+                  << errnoWithDescription();
+        return;
+    }
+
+    const int numAllowedCpus = CPU_COUNT(&allowedCpus);
+    if (numAllowedCpus == 0) {
+        return;
+    }
+
+    int remaining = index % numAllowedCpus;
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (!CPU_ISSET(cpu, &allowedCpus) || remaining-- > 0) {
+            continue;
+        }
+
+        cpu_set_t pinnedCpu;
+        CPU_ZERO(&pinnedCpu);
+        CPU_SET(cpu, &pinnedCpu);
+        const int error = pthread_setaffinity_np(pthread_self(), sizeof(pinnedCpu), &pinnedCpu);
+        if (error != 0) {
+            warning() << "Failed to pin thread to core " << cpu << ": "
+                      << errnoWithDescription(error);
+        }
+        return;
+    }
+#endif
+}
+
+}  // namespace
+
+thread_local ServiceExecutorPartitioned::ThreadState*
+    ServiceExecutorPartitioned::_localThreadState = nullptr;
+
+ServiceExecutorPartitioned::ServiceExecutorPartitioned(ServiceContext* ctx,
+                                                       std::vector<ReactorHandle> reactors)
+    : ServiceExecutorPartitioned(
+          ctx, std::move(reactors), stdx::make_unique<ServerParameterOptions>()) {}
+
+ServiceExecutorPartitioned::ServiceExecutorPartitioned(ServiceContext* ctx,
+                                                       std::vector<ReactorHandle> reactors,
+                                                       std::unique_ptr<Options> config)
+    : _config(std::move(config)), _tickSource(ctx->getTickSource()) {
+    invariant(!reactors.empty());
+    for (auto& reactor : reactors) {
+        _partitions.push_back(stdx::make_unique<Partition>(std::move(reactor)));
+    }
+}
+
+ServiceExecutorPartitioned::~ServiceExecutorPartitioned() {
+    invariant(!_isRunning.load());
+}
+
+int ServiceExecutorPartitioned::getConfiguredNumPartitions() {
+    const int value = partitionedServiceExecutorPartitions;
+    if (value > 0) {
+        return value;
+    }
+
+    return std::max(static_cast<int>(ProcessInfo::getNumAvailableCores()), 1);
+}
+
+Status ServiceExecutorPartitioned::start() {
+    invariant(!_isRunning.load());
+    _isRunning.store(true);
+
+    const auto now = _tickSource->getTicks();
+    for (size_t i = 0; i < _partitions.size(); i++) {
+        _partitions[i]->lastProgress.store(now);
+        _startWorkerThread(i, false);
+    }
+
+    _controllerThread = stdx::thread(&ServiceExecutorPartitioned::_controllerThreadRoutine, this);
+
+    return Status::OK();
+}
+
+Status ServiceExecutorPartitioned::shutdown(Milliseconds timeout) {
+    if (!_isRunning.load())
+        return Status::OK();
+
+    {
+        stdx::lock_guard<stdx::mutex> lk(_threadsMutex);
+        _isRunning.store(false);
+    }
+
+    _controllerCondition.notify_one();
+    _controllerThread.join();
+
+    stdx::unique_lock<stdx::mutex> lk(_threadsMutex);
+    for (auto& partition : _partitions) {
+        partition->reactor->stop();
+    }
+
+    bool result =
+        _deathCondition.wait_for(lk, timeout.toSystemDuration(), [&] { return _numThreads == 0; });
+
+    return result
+        ? Status::OK()
+        : Status(ErrorCodes::Error::ExceededTimeLimit,
+                 "partitioned executor couldn't shutdown all worker threads within time limit.");
+}
+
+Status ServiceExecutorPartitioned::schedule(Task task,
+                                            ScheduleFlags flags,
+                                            ServiceExecutorTaskName taskName) {
+    if (!_isRunning.load()) {
+        return {ErrorCodes::ShutdownInProgress, "Executor is not running"};
+    }
+
+    // Keep the tasks scheduled by a partition's threads on that partition, which is where the
+    // network events of their connection are delivered.
+    const bool onPartitionThread = _localThreadState && _localThreadState->executor == this;
+    Partition* const partition = onPartitionThread
+        ? _localThreadState->partition
+        : _partitions[_nextPartition.fetchAndAdd(1) % _partitions.size()].get();
+
+    auto wrappedTask = [ this, partition, task = std::move(task) ] {
+        invariant(_localThreadState && _localThreadState->partition == partition);
+
+        if (_localThreadState->recursionDepth++ == 0) {
+            partition->threadsInUse.addAndFetch(1);
+            partition->lastProgress.store(_tickSource->getTicks());
+        }
+        const auto guard = MakeGuard([this, partition] {
+            if (--_localThreadState->recursionDepth == 0) {
+                partition->threadsInUse.subtractAndFetch(1);
+                partition->lastProgress.store(_tickSource->getTicks());
+            }
+            partition->totalExecuted.addAndFetch(1);
+        });
+
+        task();
+    };
+
+    // Dispatching a task on the io_context will run the task immediately, and may run it
+    // on the current thread (if the current thread is running the io_context right now).
+    //
+    // Posting a task on the io_context will run the task without recursion.
+    //
+    // If the task is allowed to recurse and we are not over the depth limit, dispatch it so it
+    // can be called immediately and recursively.
+    if ((flags & kMayRecurse) && onPartitionThread &&
+        (_localThreadState->recursionDepth + 1 < _config->recursionLimit())) {
+        partition->reactor->schedule(Reactor::kDispatch, std::move(wrappedTask));
+    } else {
+        partition->reactor->schedule(Reactor::kPost, std::move(wrappedTask));
+    }
+
+    partition->totalQueued.addAndFetch(1);
+
+    return Status::OK();
+}
+
+bool ServiceExecutorPartitioned::_isStuck(const Partition& partition) const {
+    const auto threadsRunning = partition.threadsRunning.load();
+    if (threadsRunning == 0 || partition.threadsInUse.load() < threadsRunning) {
+        return false;
+    }
+
+    const auto sinceProgress = _tickSource->ticksTo<Milliseconds>(
+        _tickSource->getTicks() - partition.lastProgress.load());
+    return sinceProgress >= _config->stuckThreadTimeout();
+}
+
+void ServiceExecutorPartitioned::_controllerThreadRoutine() {
+    setThreadName("partitioned-executor-controller");
+
+    stdx::unique_lock<stdx::mutex> lk(_threadsMutex);
+    while (_isRunning.load()) {
+        _controllerCondition.wait_for(lk, _config->stuckThreadTimeout().toSystemDuration(), [&] {
+            return !_isRunning.load();
+        });
+
+        if (!_isRunning.load()) {
+            break;
+        }
+
+        // Give every stuck partition one more thread to process its connections' network events
+        // and tasks while its other threads are busy.
+        for (size_t i = 0; i < _partitions.size(); i++) {
+            const auto& partition = *_partitions[i];
+            if (!_isStuck(partition) ||
+                partition.threadsRunning.load() >= _config->maxThreadsPerPartition()) {
+                continue;
+            }
+
+            log() << "Starting helper thread on stuck partition " << i;
+            lk.unlock();
+            _startWorkerThread(i, true);
+            lk.lock();
+        }
+    }
+}
+
+void ServiceExecutorPartitioned::_startWorkerThread(size_t partitionId, bool isHelper) {
+    auto& partition = *_partitions[partitionId];
+
+    {
+        stdx::lock_guard<stdx::mutex> lk(_threadsMutex);
+        _numThreads++;
+    }
+    partition.threadsRunning.addAndFetch(1);
+    if (isHelper) {
+        partition.helperThreadsStarted.addAndFetch(1);
+    }
+
+    const auto launchResult = launchServiceWorkerThread(
+        [this, partitionId, isHelper] { _workerThreadRoutine(partitionId, isHelper); });
+
+    if (!launchResult.isOK()) {
+        warning() << "Failed to launch new worker thread: " << launchResult;
+        partition.threadsRunning.subtractAndFetch(1);
+        if (isHelper) {
+            partition.helperThreadsStarted.subtractAndFetch(1);
+        }
+
+        stdx::lock_guard<stdx::mutex> lk(_threadsMutex);
+        _numThreads--;
+        _deathCondition.notify_one();
+    }
+}
+
+void ServiceExecutorPartitioned::_workerThreadRoutine(size_t partitionId, bool isHelper) {
+    auto& partition = *_partitions[partitionId];
+
+    ThreadState state{this, &partition};
+    _localThreadState = &state;
+    {
+        std::string threadName = str::stream() << "partition-" << partitionId
+                                               << (isHelper ? "-helper" : "");
+        setThreadName(threadName);
+    }
+
+    if (!isHelper && _config->pinThreads()) {
+        pinCurrentThreadToCore(partitionId);
+    }
+
+    log() << "Started new database worker thread for partition " << partitionId;
+
+    const auto guard = MakeGuard([this, &partition] {
+        _localThreadState = nullptr;
+        partition.threadsRunning.subtractAndFetch(1);
+
+        stdx::lock_guard<stdx::mutex> lk(_threadsMutex);
+        _numThreads--;
+        _deathCondition.notify_one();
+    });
+
+    while (_isRunning.load()) {
+        partition.reactor->runFor(_config->workerThreadRunTime());
+
+        // Helper threads only stay while none of the partition's other threads are available.
+        if (isHelper && partition.threadsInUse.load() < partition.threadsRunning.load() - 1) {
+            log() << "Partition " << partitionId << " has available threads. Exiting thread.";
+            break;
+        }
+    }
+}
+
+void ServiceExecutorPartitioned::appendStats(BSONObjBuilder* bob) const {
+    int64_t totalQueued = 0;
+    int64_t totalExecuted = 0;
+    int64_t helperThreadsStarted = 0;
+    int threadsInUse = 0;
+    int threadsRunning = 0;
+    for (const auto& partition : _partitions) {
+        totalQueued += partition->totalQueued.load();
+        totalExecuted += partition->totalExecuted.load();
+        helperThreadsStarted += partition->helperThreadsStarted.load();
+        threadsInUse += partition->threadsInUse.load();
+        threadsRunning += partition->threadsRunning.load();
+    }
+
+    *bob << kExecutorLabel << kExecutorName                                  //
+         << "partitions" << static_cast<int>(_partitions.size())              //
+         << kTotalQueued << totalQueued                                      //
+         << kTotalExecuted << totalExecuted                                  //
+         << kThreadsInUse << threadsInUse                                    //
+         << kThreadsRunning << threadsRunning                                //
+         << kHelperThreadsStarted << helperThreadsStarted;
+}
+
+}  // namespace transport
+}  // namespace mongo
@@ -0,0 +1,163 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "mongo/db/service_context.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/transport/service_executor.h"
+#include "mongo/transport/service_executor_task_names.h"
+#include "mongo/transport/transport_layer.h"
+#include "mongo/util/tick_source.h"
+
+namespace mongo {
+namespace transport {
+
+/**
+ * This is an ASIO-based ServiceExecutor which partitions the connections over several reactors.
+ * Each reactor is run by a dedicated thread, which is pinned to a core where supported, and the
+ * TransportLayer assigns every accepted connection to one of the reactors.
+ *
+ * Tasks scheduled from a partition's threads are run on the same partition, so a connection's
+ * tasks stay on the threads which receive its network events. Other tasks, such as the start of a
+ * new session, are spread over the partitions in round robin order.
+ *
+ * A controller thread starts helper threads on partitions whose threads have all been running
+ * tasks for longer than the stuck thread timeout, so that a long-running task cannot block the
+ * other connections of its partition. Helper threads exit once their partition recovers.
+ */
+class ServiceExecutorPartitioned : public ServiceExecutor {
+public:
+    struct Options {
+        virtual ~Options() = default;
+
+        // The amount of time each worker thread runs its reactor before checking whether it
+        // should exit.
+        virtual Milliseconds workerThreadRunTime() const = 0;
+
+        // The amount of time all the threads of a partition may spend running tasks without any of
+        // them completing before the controller thread starts a helper thread on the partition.
+        virtual Milliseconds stuckThreadTimeout() const = 0;
+
+        // The maximum number of threads running each partition's reactor, including the
+        // partition's dedicated thread.
+        virtual int maxThreadsPerPartition() const = 0;
+
+        // The maximum allowable depth of recursion for tasks scheduled with the MayRecurse flag
+        // before stack unwinding is forced.
+        virtual int recursionLimit() const = 0;
+
+        // Whether the dedicated thread of each partition is pinned to a core.
+        virtual bool pinThreads() const = 0;
+    };
+
+    ServiceExecutorPartitioned(ServiceContext* ctx, std::vector<ReactorHandle> reactors);
+    ServiceExecutorPartitioned(ServiceContext* ctx,
+                               std::vector<ReactorHandle> reactors,
+                               std::unique_ptr<Options> config);
+
+    virtual ~ServiceExecutorPartitioned();
+
+    /**
+     * Returns the number of partitions configured through the server parameters, which is the
+     * number of available cores by default.
+     */
+    static int getConfiguredNumPartitions();
+
+    Status start() final;
+    Status shutdown(Milliseconds timeout) final;
+    Status schedule(Task task, ScheduleFlags flags, ServiceExecutorTaskName taskName) final;
+
+    Mode transportMode() const final {
+        return Mode::kAsynchronous;
+    }
+
+    void appendStats(BSONObjBuilder* bob) const final;
+
+private:
+    struct Partition {
+        explicit Partition(ReactorHandle reactor) : reactor(std::move(reactor)) {}
+
+        const ReactorHandle reactor;
+
+        AtomicWord<int> threadsRunning{0};
+        AtomicWord<int> threadsInUse{0};
+        // When a task last started or finished running on the partition.
+        AtomicWord<TickSource::Tick> lastProgress{0};
+
+        // These counters are only used for reporting in serverStatus.
+        AtomicWord<int64_t> totalQueued{0};
+        AtomicWord<int64_t> totalExecuted{0};
+        AtomicWord<int64_t> helperThreadsStarted{0};
+    };
+
+    struct ThreadState {
+        ServiceExecutorPartitioned* executor;
+        Partition* partition;
+        int recursionDepth = 0;
+    };
+
+    void _startWorkerThread(size_t partitionId, bool isHelper);
+    void _workerThreadRoutine(size_t partitionId, bool isHelper);
+    void _controllerThreadRoutine();
+
+    // Returns true if all the threads of 'partition' are running tasks and no task has started or
+    // finished on it for longer than the stuck thread timeout.
+    bool _isStuck(const Partition& partition) const;
+
+    std::unique_ptr<Options> _config;
+    TickSource* const _tickSource;
+
+    std::vector<std::unique_ptr<Partition>> _partitions;
+    AtomicWord<unsigned> _nextPartition{0};
+
+    AtomicWord<bool> _isRunning{false};
+
+    stdx::thread _controllerThread;
+
+    mutable stdx::mutex _threadsMutex;
+    int _numThreads{0};
+
+    // Threads signal this condition variable when they exit so we can gracefully shutdown the
+    // executor.
+    stdx::condition_variable _deathCondition;
+
+    // Signaled on shutdown to wake up the controller thread.
+    stdx::condition_variable _controllerCondition;
+
+    static thread_local ThreadState* _localThreadState;
+};
+
+}  // namespace transport
+}  // namespace mongo
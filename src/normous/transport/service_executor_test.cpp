@@ -34,6 +34,7 @@
 
 #include "mongo/db/service_context.h"
 #include "mongo/transport/service_executor_adaptive.h"
+#include "mongo/transport/service_executor_partitioned.h"
 #include "mongo/transport/service_executor_synchronous.h"
 #include "mongo/transport/service_executor_task_names.h"
 #include "mongo/unittest/unittest.h"
@@ -82,6 +83,28 @@ struct TestOptions : public ServiceExecutorAdaptive::Options {
     }
 };
 
+struct PartitionedTestOptions : public ServiceExecutorPartitioned::Options {
+    Milliseconds workerThreadRunTime() const final {
+        return kWorkerThreadRunTime;
+    }
+
+    Milliseconds stuckThreadTimeout() const final {
+        return Milliseconds{100};
+    }
+
+    int maxThreadsPerPartition() const final {
+        return 2;
+    }
+
+    int recursionLimit() const final {
+        return 0;
+    }
+
+    bool pinThreads() const final {
+        return false;
+    }
+};
+
 /* This implements the portions of the transport::Reactor based on ASIO, but leaves out
  * the methods not needed by ServiceExecutors.
  *
@@ -175,6 +198,28 @@ protected:
     std::unique_ptr<ServiceExecutorSynchronous> executor;
 };
 
+class ServiceExecutorPartitionedFixture : public unittest::Test {
+protected:
+    void setUp() override {
+        auto scOwned = ServiceContext::make();
+        setGlobalServiceContext(std::move(scOwned));
+
+        std::vector<ReactorHandle> reactors;
+        for (int i = 0; i < kNumPartitions; i++) {
+            reactors.push_back(std::make_shared<ASIOReactor>());
+        }
+
+        executor = stdx::make_unique<ServiceExecutorPartitioned>(
+            getGlobalServiceContext(),
+            std::move(reactors),
+            stdx::make_unique<PartitionedTestOptions>());
+    }
+
+    static constexpr int kNumPartitions = 2;
+
+    std::unique_ptr<ServiceExecutorPartitioned> executor;
+};
+
 void scheduleBasicTask(ServiceExecutor* exec, bool expectSuccess) {
     stdx::condition_variable cond;
     stdx::mutex mutex;
@@ -205,6 +250,102 @@ TEST_F(ServiceExecutorAdaptiveFixture, ScheduleFailsBeforeStartup) {
     scheduleBasicTask(executor.get(), false);
 }
 
+TEST_F(ServiceExecutorPartitionedFixture, BasicTaskRuns) {
+    ASSERT_OK(executor->start());
+    auto guard = MakeGuard([this] { ASSERT_OK(executor->shutdown(kShutdownTime)); });
+
+    scheduleBasicTask(executor.get(), true);
+}
+
+TEST_F(ServiceExecutorPartitionedFixture, ScheduleFailsBeforeStartup) {
+    scheduleBasicTask(executor.get(), false);
+}
+
+TEST_F(ServiceExecutorPartitionedFixture, TasksScheduledByTasksStayOnTheirPartition) {
+    ASSERT_OK(executor->start());
+    auto guard = MakeGuard([this] { ASSERT_OK(executor->shutdown(kShutdownTime)); });
+
+    stdx::mutex mutex;
+    stdx::condition_variable cond;
+    boost::optional<stdx::thread::id> firstThread;
+    boost::optional<stdx::thread::id> secondThread;
+
+    auto secondTask = [&] {
+        stdx::lock_guard<stdx::mutex> lk(mutex);
+        secondThread = stdx::this_thread::get_id();
+        cond.notify_all();
+    };
+
+    auto firstTask = [&] {
+        {
+            stdx::lock_guard<stdx::mutex> lk(mutex);
+            firstThread = stdx::this_thread::get_id();
+        }
+
+        // Without the affinity, the round robin assignment would run this on the other partition.
+        invariant(executor->schedule(std::move(secondTask),
+                                     ServiceExecutor::kEmptyFlags,
+                                     ServiceExecutorTaskName::kSSMProcessMessage));
+    };
+
+    ASSERT_OK(executor->schedule(std::move(firstTask),
+                                 ServiceExecutor::kEmptyFlags,
+                                 ServiceExecutorTaskName::kSSMStartSession));
+
+    stdx::unique_lock<stdx::mutex> lk(mutex);
+    cond.wait(lk, [&] { return bool(secondThread); });
+    ASSERT(*firstThread == *secondThread);
+}
+
+TEST_F(ServiceExecutorPartitionedFixture, StuckPartitionGetsHelperThread) {
+    ASSERT_OK(executor->start());
+    auto guard = MakeGuard([this] { ASSERT_OK(executor->shutdown(kShutdownTime)); });
+
+    stdx::mutex mutex;
+    stdx::condition_variable cond;
+    bool blockingTaskStarted = false;
+    bool releaseBlockingTask = false;
+    bool secondTaskRan = false;
+
+    auto secondTask = [&] {
+        stdx::lock_guard<stdx::mutex> lk(mutex);
+        secondTaskRan = true;
+        cond.notify_all();
+    };
+
+    auto blockingTask = [&] {
+        stdx::unique_lock<stdx::mutex> lk(mutex);
+        blockingTaskStarted = true;
+        cond.notify_all();
+
+        // Schedule a task behind this one on the same partition, which can only run once the
+        // controller starts a helper thread.
+        lk.unlock();
+        invariant(executor->schedule(std::move(secondTask),
+                                     ServiceExecutor::kEmptyFlags,
+                                     ServiceExecutorTaskName::kSSMProcessMessage));
+        lk.lock();
+
+        cond.wait(lk, [&] { return releaseBlockingTask; });
+    };
+
+    ASSERT_OK(executor->schedule(std::move(blockingTask),
+                                 ServiceExecutor::kEmptyFlags,
+                                 ServiceExecutorTaskName::kSSMStartSession));
+
+    stdx::unique_lock<stdx::mutex> lk(mutex);
+    cond.wait(lk, [&] { return blockingTaskStarted; });
+    cond.wait(lk, [&] { return secondTaskRan; });
+
+    releaseBlockingTask = true;
+    cond.notify_all();
+    lk.unlock();
+
+    BSONObjBuilder stats;
+    executor->appendStats(&stats);
+    ASSERT_GTE(stats.obj()["helperThreadsStarted"].numberLong(), 1);
+}
+
 TEST_F(ServiceExecutorSynchronousFixture, BasicTaskRuns) {
     ASSERT_OK(executor->start());
     auto guard = MakeGuard([this] { ASSERT_OK(executor->shutdown(kShutdownTime)); });
@@ -52,9 +52,14 @@
 #include "mongo/util/log.h"
 #include "mongo/util/net/socket_exception.h"
 #include "mongo/util/quick_exit.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
+
+// Number of sessions currently running a request through the database.
+AtomicInt64 activeSessionCount(0);
+
 /**
  * Creates and returns a legacy exhaust message, if exhaust is allowed. The returned message is to
  * be used as the subsequent 'synthetic' exhaust request. Returns an empty message if exhaust is not
@@ -434,16 +439,22 @@ void ServiceStateMachine::_processMessage(ThreadGuard guard) {
 
     networkCounter.hitLogicalIn(_inMessage.size());
 
-    // Pass sourced Message to handler to generate response.
-    auto opCtx = Client::getCurrent()->makeOperationContext();
+    DbResponse dbresponse;
+    {
+        activeSessionCount.addAndFetch(1);
+        ON_BLOCK_EXIT([] { activeSessionCount.subtractAndFetch(1); });
+
+        // Pass sourced Message to handler to generate response.
+        auto opCtx = Client::getCurrent()->makeOperationContext();
 
-    // The handleRequest is implemented in a subclass for mongod/mongos and actually all the
-    // database work for this request.
-    DbResponse dbresponse = _sep->handleRequest(opCtx.get(), _inMessage);
+        // The handleRequest is implemented in a subclass for mongod/mongos and actually all the
+        // database work for this request.
+        dbresponse = _sep->handleRequest(opCtx.get(), _inMessage);
 
-    // opCtx must be destroyed here so that the operation cannot show
-    // up in currentOp results after the response reaches the client
-    opCtx.reset();
+        // opCtx must be destroyed here so that the operation cannot show
+        // up in currentOp results after the response reaches the client
+        opCtx.reset();
+    }
 
     // Format our response, if we have one
     Message& toSink = dbresponse.response;
@@ -587,6 +598,10 @@ void ServiceStateMachine::terminateIfTagsDontMatch(transport::Session::TagMask t
     terminate();
 }
 
+int64_t ServiceStateMachine::numActiveSessions() {
+    return activeSessionCount.load();
+}
+
 void ServiceStateMachine::setCleanupHook(stdx::function<void()> hook) {
     invariant(state() == State::Created);
     _cleanupHook = std::move(hook);
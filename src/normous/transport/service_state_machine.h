@@ -157,6 +157,12 @@ public:
      */
     void setCleanupHook(stdx::function<void()> hook);
 
+    /**
+     * Returns the number of sessions, across all ServiceStateMachines, which are currently running
+     * a request through the database. All other sessions are idle between requests.
+     */
+    static int64_t numActiveSessions();
+
 private:
     /*
      * A class that wraps up lifetime management of the _dbClient and _threadName for runNext();
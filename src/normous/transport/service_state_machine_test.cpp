@@ -73,6 +73,7 @@ public:
     DbResponse handleRequest(OperationContext* opCtx, const Message& request) override {
         log() << "In handleRequest";
         _ranHandler = true;
+        _activeSessionsInHandler = ServiceStateMachine::numActiveSessions();
         ASSERT_TRUE(haveClient());
 
         // Build out a dummy OK response, if no custom response message was set. Otherwise, use the
@@ -120,9 +121,14 @@ public:
         return ret;
     }
 
+    int64_t activeSessionsInHandler() const {
+        return _activeSessionsInHandler;
+    }
+
 private:
     bool _uassertInHandler = false;
     bool _ranHandler = false;
+    int64_t _activeSessionsInHandler = 0;
 
     // A custom response message to return from 'handleRequest'.
     Message _responseMessage;
@@ -609,6 +615,23 @@ TEST_F(ServiceStateMachineFixture, TestThrowHandling) {
     ASSERT_FALSE(_tl->ranSink());
 }
 
+TEST_F(ServiceStateMachineFixture, SessionIsOnlyActiveWhileRunningRequest) {
+    ASSERT_EQ(ServiceStateMachine::numActiveSessions(), 0);
+    runPingTest(State::Process, State::Source);
+    checkPingOk();
+    ASSERT_EQ(_sep->activeSessionsInHandler(), 1);
+    ASSERT_EQ(ServiceStateMachine::numActiveSessions(), 0);
+
+    // A request which throws must not leave the session counted as active.
+    _sep->setUassertInHandler();
+    _ssm->runNext();
+    ASSERT_EQ(_ssm->state(), State::Process);
+    _ssm->runNext();
+    ASSERT_EQ(_ssm->state(), State::Ended);
+    ASSERT_EQ(_sep->activeSessionsInHandler(), 1);
+    ASSERT_EQ(ServiceStateMachine::numActiveSessions(), 0);
+}
+
 TEST_F(ServiceStateMachineFixture, TestSourceError) {
     _tl->setNextFailure(MockTL::Source);
 
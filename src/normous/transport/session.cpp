@@ -40,6 +40,7 @@ namespace transport {
 namespace {
 
 AtomicUInt64 sessionIdCounter(0);
+AtomicInt64 ingressBufferedBytesCounter(0);
 
 }  // namespace
 
@@ -68,5 +69,13 @@ Session::TagMask Session::getTags() const {
     return _tags.load();
 }
 
+int64_t Session::ingressBufferedBytes() {
+    return ingressBufferedBytesCounter.load();
+}
+
+void Session::adjustIngressBufferedBytes(int64_t delta) {
+    ingressBufferedBytesCounter.addAndFetch(delta);
+}
+
 }  // namespace transport
 }  // namespace mongo
@@ -177,9 +177,21 @@ public:
 
     virtual TagMask getTags() const;
 
+    /**
+     * Returns the number of bytes currently held in receive buffers by ingress sessions between
+     * the messages they hand to the database.
+     */
+    static int64_t ingressBufferedBytes();
+
 protected:
     Session();
 
+    /**
+     * Transport layers call this whenever an ingress session acquires or releases a receive
+     * buffer, so that ingressBufferedBytes() stays accurate.
+     */
+    static void adjustIngressBufferedBytes(int64_t delta);
+
 private:
     const Id _id;
 
@@ -28,10 +28,12 @@
 
 #pragma once
 
+#include <array>
 #include <utility>
 
 #include "mongo/base/system_error.h"
 #include "mongo/config.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/stats/counters.h"
 #include "mongo/transport/asio_utils.h"
 #include "mongo/transport/baton.h"
@@ -53,6 +55,18 @@ namespace transport {
 
 MONGO_FAIL_POINT_DEFINE(transportLayerASIOshortOpportunisticReadWrite);
 
+// The number of bytes a plaintext session tries to read at once when sourcing a message. Messages
+// that fit are received with a single read instead of one for the header and one for the body.
+// Zero disables reading ahead.
+MONGO_EXPORT_SERVER_PARAMETER(transportLayerASIOReadAheadBytes, int, 16 * 1024)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0 || newVal > 16 * 1024 * 1024) {
+            return Status(ErrorCodes::BadValue,
+                          "transportLayerASIOReadAheadBytes must be between 0 and 16MB");
+        }
+        return Status::OK();
+    });
+
 template <typename SuccessValue>
 auto futurize(const std::error_code& ec, SuccessValue&& successValue) {
     using Result = Future<std::decay_t<SuccessValue>>;
@@ -101,6 +115,7 @@ public:
 
     ~ASIOSession() {
         end();
+        setReadAheadBuffer(SharedBuffer());
     }
 
     TransportLayer* getTransportLayer() const override {
@@ -344,15 +359,20 @@ private:
     Future<Message> sourceMessageImpl(const transport::BatonHandle& baton = nullptr) {
         static constexpr auto kHeaderSize = sizeof(MSGHEADER::Value);
 
-        auto headerBuffer = SharedBuffer::allocate(kHeaderSize);
-        auto ptr = headerBuffer.get();
-        return read(asio::buffer(ptr, kHeaderSize), baton)
-            .then([ headerBuffer = std::move(headerBuffer), this, baton ]() mutable {
-                if (checkForHTTPRequest(asio::buffer(headerBuffer.get(), kHeaderSize))) {
+        if (_readAheadBytes || canReadAhead()) {
+            return sourceMessageWithReadAhead(baton);
+        }
+
+        // The header is read into storage owned by the session, so that only one buffer has to be
+        // allocated per message once its length is known.
+        auto headerBuffer = _headerBuffer.data();
+        return read(asio::buffer(headerBuffer, kHeaderSize), baton)
+            .then([headerBuffer, this, baton]() {
+                if (checkForHTTPRequest(asio::buffer(headerBuffer, kHeaderSize))) {
                     return sendHTTPResponse(baton);
                 }
 
-                const auto msgLen = size_t(MSGHEADER::View(headerBuffer.get()).getMessageLength());
+                const auto msgLen = size_t(MSGHEADER::View(headerBuffer).getMessageLength());
                 if (msgLen < kHeaderSize || msgLen > MaxMessageSizeBytes) {
                     StringBuilder sb;
                     sb << "recv(): message msgLen " << msgLen << " is invalid. "
@@ -363,17 +383,17 @@ private:
                     return Future<Message>::makeReady(Status(ErrorCodes::ProtocolError, str));
                 }
 
+                auto buffer = SharedBuffer::allocate(msgLen);
+                memcpy(buffer.get(), headerBuffer, kHeaderSize);
+
                 if (msgLen == kHeaderSize) {
                     // This probably isn't a real case since all (current) messages have bodies.
                     if (_isIngressSession) {
                         networkCounter.hitPhysicalIn(msgLen);
                     }
-                    return Future<Message>::makeReady(Message(std::move(headerBuffer)));
+                    return Future<Message>::makeReady(Message(std::move(buffer)));
                 }
 
-                auto buffer = SharedBuffer::allocate(msgLen);
-                memcpy(buffer.get(), headerBuffer.get(), kHeaderSize);
-
                 MsgData::View msgView(buffer.get());
                 return read(asio::buffer(msgView.data(), msgView.dataLen()), baton)
                     .then([ this, buffer = std::move(buffer), msgLen ]() mutable {
@@ -385,6 +405,152 @@ private:
             });
     }
 
+    /**
+     * Reading ahead is only done on plaintext sockets once we know no SSL handshake is coming,
+     * since the SSL stream has to see every byte read off the socket.
+     */
+    bool canReadAhead() const {
+#ifdef MONGO_CONFIG_SSL
+        if (_sslSocket || !_ranHandshake) {
+            return false;
+        }
+#endif
+        return transportLayerASIOReadAheadBytes.load() >= int(sizeof(MSGHEADER::Value));
+    }
+
+    /**
+     * Sources a message by reading up to transportLayerASIOReadAheadBytes at once, so that small
+     * messages take a single read. Any bytes read past the end of the message are kept in
+     * _readAheadBuffer for the next call.
+     */
+    Future<Message> sourceMessageWithReadAhead(const transport::BatonHandle& baton) {
+        static constexpr auto kHeaderSize = sizeof(MSGHEADER::Value);
+
+        return fillReadAhead(kHeaderSize, baton).then([this, baton]() -> Future<Message> {
+            const auto bufferStart = _readAheadBuffer.get();
+            if (checkForHTTPRequest(asio::buffer(bufferStart, kHeaderSize))) {
+                return sendHTTPResponse(baton);
+            }
+
+            const auto msgLen = size_t(MSGHEADER::View(bufferStart).getMessageLength());
+            if (msgLen < kHeaderSize || msgLen > MaxMessageSizeBytes) {
+                StringBuilder sb;
+                sb << "recv(): message msgLen " << msgLen << " is invalid. "
+                   << "Min " << kHeaderSize << " Max: " << MaxMessageSizeBytes;
+                const auto str = sb.str();
+                LOG(0) << str;
+
+                return Future<Message>::makeReady(Status(ErrorCodes::ProtocolError, str));
+            }
+
+            if (msgLen <= _readAheadBytes) {
+                // The whole message is already buffered. In the common case where nothing past it
+                // was read, hand the buffer over as is.
+                SharedBuffer buffer;
+                if (msgLen == _readAheadBytes) {
+                    buffer = setReadAheadBuffer(SharedBuffer());
+                } else {
+                    buffer = SharedBuffer::allocate(msgLen);
+                    memcpy(buffer.get(), bufferStart, msgLen);
+                    memmove(bufferStart, bufferStart + msgLen, _readAheadBytes - msgLen);
+                }
+                _readAheadBytes -= msgLen;
+
+                if (_isIngressSession) {
+                    networkCounter.hitPhysicalIn(msgLen);
+                }
+                return Future<Message>::makeReady(Message(std::move(buffer)));
+            }
+
+            auto buffer = SharedBuffer::allocate(msgLen);
+            const auto alreadyRead = _readAheadBytes;
+            memcpy(buffer.get(), bufferStart, alreadyRead);
+            setReadAheadBuffer(SharedBuffer());
+            _readAheadBytes = 0;
+
+            auto ptr = buffer.get() + alreadyRead;
+            return read(asio::buffer(ptr, msgLen - alreadyRead), baton)
+                .then([ this, buffer = std::move(buffer), msgLen ]() mutable {
+                    if (_isIngressSession) {
+                        networkCounter.hitPhysicalIn(msgLen);
+                    }
+                    return Message(std::move(buffer));
+                });
+        });
+    }
+
+    /**
+     * Replaces _readAheadBuffer with 'buffer', keeping the count of bytes buffered by ingress
+     * sessions up to date, and returns the previous buffer.
+     */
+    SharedBuffer setReadAheadBuffer(SharedBuffer buffer) {
+        if (_isIngressSession) {
+            adjustIngressBufferedBytes(int64_t(buffer.capacity()) -
+                                       int64_t(_readAheadBuffer.capacity()));
+        }
+        buffer.swap(_readAheadBuffer);
+        return buffer;
+    }
+
+    /**
+     * Reads from the socket into _readAheadBuffer until it holds at least minBytes, taking
+     * whatever else is available up to its capacity. The buffer is released while waiting for
+     * the socket to become readable so that idle sessions don't hold on to it.
+     */
+    Future<void> fillReadAhead(size_t minBytes, const transport::BatonHandle& baton) {
+        const auto capacity = std::max(size_t(transportLayerASIOReadAheadBytes.load()), minBytes);
+
+        while (_readAheadBytes < minBytes) {
+            if (!_readAheadBytes && _blockingMode == Sync && !_configuredTimeout) {
+                // A synchronous session would otherwise sit in read_some() holding an empty buffer
+                // until the client sends its next message. Wait for the socket to become readable
+                // first instead. Sessions with a timeout keep blocking in the read, because poll()
+                // does not honor SO_RCVTIMEO.
+                setReadAheadBuffer(SharedBuffer());
+
+                std::error_code ec;
+                _socket.wait(asio::socket_base::wait_read, ec);
+                if (ec) {
+                    return futurize(ec);
+                }
+            }
+
+            if (_readAheadBuffer.capacity() < capacity) {
+                auto newBuffer = SharedBuffer::allocate(capacity);
+                if (_readAheadBytes) {
+                    memcpy(newBuffer.get(), _readAheadBuffer.get(), _readAheadBytes);
+                }
+                setReadAheadBuffer(std::move(newBuffer));
+            }
+
+            std::error_code ec;
+            _readAheadBytes += _socket.read_some(
+                asio::buffer(_readAheadBuffer.get() + _readAheadBytes,
+                             _readAheadBuffer.capacity() - _readAheadBytes),
+                ec);
+            if (!ec) {
+                continue;
+            }
+
+            if (((ec == asio::error::would_block) || (ec == asio::error::try_again)) &&
+                (_blockingMode == Async)) {
+                if (!_readAheadBytes) {
+                    setReadAheadBuffer(SharedBuffer());
+                }
+
+                auto readable = baton
+                    ? baton->addSession(*this, Baton::Type::In)
+                    : _socket.async_wait(asio::socket_base::wait_read, UseFuture{});
+                return std::move(readable).then(
+                    [this, minBytes, baton] { return fillReadAhead(minBytes, baton); });
+            }
+
+            return futurize(ec);
+        }
+
+        return Future<void>::makeReady();
+    }
+
     template <typename MutableBufferSequence>
     Future<void> read(const MutableBufferSequence& buffers,
                       const transport::BatonHandle& baton = nullptr) {
@@ -709,6 +875,14 @@ private:
     bool _ranHandshake = false;
 #endif
 
+    // Receives the header of the message being sourced when not reading ahead.
+    std::array<char, sizeof(MSGHEADER::Value)> _headerBuffer;
+
+    // Bytes read off the socket ahead of the message currently being sourced. Only the first
+    // _readAheadBytes bytes of the buffer are valid.
+    SharedBuffer _readAheadBuffer;
+    size_t _readAheadBytes = 0;
+
     TransportLayerASIO* const _tl;
     bool _isIngressSession;
 };
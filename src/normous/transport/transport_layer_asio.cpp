@@ -233,6 +233,10 @@ TransportLayerASIO::TransportLayerASIO(const TransportLayerASIO::Options& opts,
 #endif
       _sep(sep),
       _listenerOptions(opts) {
+    _ingressReactors.push_back(_ingressReactor);
+    for (size_t i = 1; i < opts.ingressReactors; i++) {
+        _ingressReactors.push_back(std::make_shared<ASIOReactor>());
+    }
 }
 
 TransportLayerASIO::~TransportLayerASIO() = default;
@@ -826,6 +830,10 @@ ReactorHandle TransportLayerASIO::getReactor(WhichReactor which) {
     MONGO_UNREACHABLE;
 }
 
+std::vector<ReactorHandle> TransportLayerASIO::getIngressReactors() {
+    return {_ingressReactors.begin(), _ingressReactors.end()};
+}
+
 void TransportLayerASIO::_acceptConnection(GenericAcceptor& acceptor) {
     auto acceptCb = [this, &acceptor](const std::error_code& ec, GenericSocket peerSocket) mutable {
         if (!_running.load())
@@ -849,7 +857,11 @@ void TransportLayerASIO::_acceptConnection(GenericAcceptor& acceptor) {
         _acceptConnection(acceptor);
     };
 
-    acceptor.async_accept(*_ingressReactor, std::move(acceptCb));
+    // The socket of the next accepted connection is bound to one of the ingress reactors, whose
+    // threads will then handle all of that connection's networking.
+    auto& ingressReactor =
+        *_ingressReactors[_nextIngressReactor.fetchAndAdd(1) % _ingressReactors.size()];
+    acceptor.async_accept(ingressReactor, std::move(acceptCb));
 }
 
 #ifdef MONGO_CONFIG_SSL
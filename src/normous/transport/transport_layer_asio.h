@@ -107,6 +107,8 @@ public:
         Mode transportMode = Mode::kSynchronous;  // whether accepted sockets should be put into
                                                   // non-blocking mode after they're accepted
         size_t maxConns = DEFAULT_MAX_CONN;       // maximum number of active connections
+        size_t ingressReactors = 1;               // number of reactors accepted sockets are
+                                                  // spread over
     };
 
     TransportLayerASIO(const Options& opts, ServiceEntryPoint* sep);
@@ -126,6 +128,12 @@ public:
 
     ReactorHandle getReactor(WhichReactor which) final;
 
+    /**
+     * Returns the reactors which accepted sockets are assigned to, in round robin order. The first
+     * one is the kIngress reactor.
+     */
+    std::vector<ReactorHandle> getIngressReactors();
+
     Status start() final;
 
     void shutdown() final;
@@ -162,6 +170,10 @@ private:
     // all the accepted sockets and all ingress networking activity. The _acceptorReactor contains
     // all the sockets in _acceptors.  The _egressReactor contains egress connections.
     //
+    // If Options::ingressReactors is greater than one, the accepted sockets are instead spread
+    // over the reactors in _ingressReactors, the first of which is the _ingressReactor. Each of
+    // them is then run by its own threads of the ServiceExecutor.
+    //
     // TransportLayerASIO should never call run() on the _ingressReactor.
     // In synchronous mode, this will cause a massive performance degradation due to
     // unnecessary wakeups on the asio thread for sockets we don't intend to interact
@@ -183,6 +195,8 @@ private:
     std::shared_ptr<ASIOReactor> _ingressReactor;
     std::shared_ptr<ASIOReactor> _egressReactor;
     std::shared_ptr<ASIOReactor> _acceptorReactor;
+    std::vector<std::shared_ptr<ASIOReactor>> _ingressReactors;
+    AtomicWord<unsigned> _nextIngressReactor{0};
 
 #ifdef MONGO_CONFIG_SSL
     std::unique_ptr<asio::ssl::context> _ingressSSLContext;
@@ -35,6 +35,7 @@
 #include "mongo/db/service_context.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/transport/service_executor_adaptive.h"
+#include "mongo/transport/service_executor_partitioned.h"
 #include "mongo/transport/service_executor_synchronous.h"
 #include "mongo/transport/session.h"
 #include "mongo/transport/transport_layer_asio.h"
@@ -134,6 +135,9 @@ std::unique_ptr<TransportLayer> TransportLayerManager::createWithConfig(
     transport::TransportLayerASIO::Options opts(config);
     if (config->serviceExecutor == "adaptive") {
         opts.transportMode = transport::Mode::kAsynchronous;
+    } else if (config->serviceExecutor == "partitioned") {
+        opts.transportMode = transport::Mode::kAsynchronous;
+        opts.ingressReactors = ServiceExecutorPartitioned::getConfiguredNumPartitions();
     } else if (config->serviceExecutor == "synchronous") {
         opts.transportMode = transport::Mode::kSynchronous;
     } else {
@@ -146,6 +150,9 @@ std::unique_ptr<TransportLayer> TransportLayerManager::createWithConfig(
         auto reactor = transportLayerASIO->getReactor(TransportLayer::kIngress);
         ctx->setServiceExecutor(
             stdx::make_unique<ServiceExecutorAdaptive>(ctx, std::move(reactor)));
+    } else if (config->serviceExecutor == "partitioned") {
+        ctx->setServiceExecutor(stdx::make_unique<ServiceExecutorPartitioned>(
+            ctx, transportLayerASIO->getIngressReactors()));
     } else if (config->serviceExecutor == "synchronous") {
         ctx->setServiceExecutor(stdx::make_unique<ServiceExecutorSynchronous>(ctx));
     }
@@ -63,6 +63,9 @@ public:
     void lock() {
         EnterCriticalSection(&_cs);
     }
+    bool try_lock() {
+        return TryEnterCriticalSection(&_cs) != 0;
+    }
     void unlock() {
         LeaveCriticalSection(&_cs);
     }
@@ -89,6 +92,10 @@ public:
         verify(pthread_mutex_lock(&_lock) == 0);
     }
 
+    bool try_lock() {
+        return pthread_mutex_trylock(&_lock) == 0;
+    }
+
     void unlock() {
         verify(pthread_mutex_unlock(&_lock) == 0);
     }
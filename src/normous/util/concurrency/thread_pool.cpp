@@ -191,30 +191,39 @@ void ThreadPool::_drainPendingTasks() {
 }
 
 Status ThreadPool::schedule(Task task) {
-    stdx::lock_guard<stdx::mutex> lk(_mutex);
-    switch (_state) {
-        case joinRequired:
-        case joining:
-        case shutdownComplete:
-            return Status(ErrorCodes::ShutdownInProgress,
-                          str::stream() << "Shutdown of thread pool " << _options.poolName
-                                        << " in progress");
-        case preStart:
-        case running:
-            break;
-        default:
-            MONGO_UNREACHABLE;
-    }
-    _pendingTasks.emplace_back(std::move(task));
-    if (_state == preStart) {
-        return Status::OK();
-    }
-    if (_numIdleThreads < _pendingTasks.size()) {
-        _startWorkerThread_inlock();
-    }
-    if (_numIdleThreads <= _pendingTasks.size()) {
-        _lastFullUtilizationDate = Date_t::now();
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        switch (_state) {
+            case joinRequired:
+            case joining:
+            case shutdownComplete:
+                return Status(ErrorCodes::ShutdownInProgress,
+                              str::stream() << "Shutdown of thread pool " << _options.poolName
+                                            << " in progress");
+            case preStart:
+            case running:
+                break;
+            default:
+                MONGO_UNREACHABLE;
+        }
+        _pendingTasks.emplace_back(std::move(task));
+        if (_state == preStart) {
+            return Status::OK();
+        }
+        if (_numIdleThreads < _pendingTasks.size()) {
+            _startWorkerThread_inlock();
+        }
+        if (_numIdleThreads <= _pendingTasks.size()) {
+            _lastFullUtilizationDate = Date_t::now();
+        }
+        if (!_numWaitingThreads) {
+            // Every idle thread is between tasks and will find this one without being woken.
+            return Status::OK();
+        }
     }
+
+    // Signal after releasing _mutex, so that the woken thread doesn't immediately block on it
+    // while the scheduling thread is still holding it.
     _workAvailable.notify_one();
     return Status::OK();
 }
@@ -282,7 +291,9 @@ void ThreadPool::_consumeTasks() {
                 LOG(3) << "Not reaping because the earliest retirement date is "
                        << nextThreadRetirementDate;
                 MONGO_IDLE_THREAD_BLOCK;
+                ++_numWaitingThreads;
                 _workAvailable.wait_until(lk, nextThreadRetirementDate.toSystemTimePoint());
+                --_numWaitingThreads;
             } else {
                 // Since the number of threads is not more than minThreads, this thread is not
                 // eligible for retirement. It is OK to sleep until _workAvailable is signaled,
@@ -291,7 +302,9 @@ void ThreadPool::_consumeTasks() {
                 LOG(3) << "waiting for work; I am one of " << _threads.size() << " thread(s);"
                        << " the minimum number of threads is " << _options.minThreads;
                 MONGO_IDLE_THREAD_BLOCK;
+                ++_numWaitingThreads;
                 _workAvailable.wait(lk);
+                --_numWaitingThreads;
             }
             continue;
         }
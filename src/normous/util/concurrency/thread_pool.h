@@ -234,6 +234,9 @@ private:
     // Count of idle threads.
     size_t _numIdleThreads = 0;
 
+    // Count of idle threads blocked waiting on _workAvailable, as opposed to between tasks.
+    size_t _numWaitingThreads = 0;
+
     // Id counter for assigning thread names
     size_t _nextThreadId = 0;
 
@@ -178,6 +178,40 @@ TEST(DecorableTest, Alignment) {
                   std::alignment_of<int>::value);
 }
 
+struct TrivialDecoration {
+    int value;
+    void* pointer;
+};
+
+struct DefaultedMemberDecoration {
+    int value = 7;
+};
+
+TEST(DecorableTest, TrivialDecorationsAreValueInitialized) {
+    numConstructedAs = 0;
+    numDestructedAs = 0;
+    DecorationRegistry<MyDecorable> registry;
+    const auto dd1 = registry.declareDecoration<TrivialDecoration>();
+    const auto dd2 = registry.declareDecoration<A>();
+    const auto dd3 = registry.declareDecoration<DefaultedMemberDecoration>();
+    const auto dd4 = registry.declareDecoration<long long>();
+
+    for (int i = 0; i < 2; ++i) {
+        DecorationContainer<MyDecorable> decorable(nullptr, &registry);
+        ASSERT_EQ(0, decorable.getDecoration(dd1).value);
+        ASSERT_FALSE(decorable.getDecoration(dd1).pointer);
+        ASSERT_EQ(0, decorable.getDecoration(dd2).value);
+        ASSERT_EQ(7, decorable.getDecoration(dd3).value);
+        ASSERT_EQ(0, decorable.getDecoration(dd4));
+
+        // Dirty the trivial decorations; the next container must still see them zeroed.
+        decorable.getDecoration(dd1).value = 42;
+        decorable.getDecoration(dd4) = 42;
+    }
+    ASSERT_EQ(2, numConstructedAs);
+    ASSERT_EQ(2, numDestructedAs);
+}
+
 struct DecoratedOwnerChecker : public Decorable<DecoratedOwnerChecker> {
     const char answer[100] = "The answer to life the universe and everything is 42";
 };
@@ -96,7 +96,7 @@ public:
     explicit DecorationContainer(Decorable<DecoratedType>* const decorated,
                                  const DecorationRegistry<DecoratedType>* const registry)
         : _registry(registry),
-          _decorationData(new unsigned char[registry->getDecorationBufferSizeBytes()]) {
+          _decorationData(new unsigned char[registry->getDecorationBufferSizeBytes()]()) {
         // Because the decorations live in the externally allocated storage buffer at
         // `_decorationData`, there needs to be a way to get back from a known location within this
         // buffer to the type which owns those decorations.  We place a pointer to ourselves, a
@@ -105,6 +105,8 @@ public:
         Decorable<DecoratedType>** const backLink =
             reinterpret_cast<Decorable<DecoratedType>**>(_decorationData.get());
         *backLink = decorated;
+        // The buffer is zero-filled above, which is how trivially default constructible
+        // decorations are value-initialized; the registry only runs the remaining constructors.
         _registry->construct(this);
     }
 
@@ -61,6 +61,10 @@ public:
      * Declares a decoration of type T, constructed with T's default constructor, and
      * returns a descriptor for accessing that decoration.
      *
+     * Trivially default constructible decorations are value-initialized by zero-filling the
+     * decoration buffer, and trivially destructible ones are not visited on destruction, so that
+     * only decorations with real constructors or destructors cost an indirect call per instance.
+     *
      * NOTE: T's destructor must not throw exceptions.
      */
     template <typename T>
@@ -69,8 +73,14 @@ public:
                                 "Decorations must be nothrow destructible");
         return
             typename DecorationContainer<DecoratedType>::template DecorationDescriptorWithType<T>(
-                std::move(declareDecoration(
-                    sizeof(T), std::alignment_of<T>::value, &constructAt<T>, &destroyAt<T>)));
+                std::move(declareDecoration(sizeof(T),
+                                            std::alignment_of<T>::value,
+                                            std::is_trivially_default_constructible<T>::value
+                                                ? nullptr
+                                                : &constructAt<T>,
+                                            std::is_trivially_destructible<T>::value
+                                                ? nullptr
+                                                : &destroyAt<T>)));
     }
 
     size_t getDecorationBufferSizeBytes() const {
@@ -79,7 +89,7 @@ public:
 
     /**
      * Constructs the decorations declared in this registry on the given instance of
-     * "decorable".
+     * "decorable", whose decoration buffer must already be zero-filled.
      *
      * Called by the DecorationContainer constructor. Do not call directly.
      */
@@ -93,8 +103,9 @@ public:
             std::for_each(std::make_reverse_iterator(iter),
                           crend(this->_decorationInfo),
                           [&](auto&& decoration) {
-                              decoration.destructor(
-                                  container->getDecoration(decoration.descriptor));
+                              if (decoration.destructor)
+                                  decoration.destructor(
+                                      container->getDecoration(decoration.descriptor));
                           });
         };
 
@@ -103,7 +114,8 @@ public:
         using std::cend;
 
         for (; iter != cend(_decorationInfo); ++iter) {
-            iter->constructor(container->getDecoration(iter->descriptor));
+            if (iter->constructor)
+                iter->constructor(container->getDecoration(iter->descriptor));
         }
 
         cleanup.Dismiss();
@@ -116,7 +128,8 @@ public:
      */
     void destroy(DecorationContainer<DecoratedType>* const container) const noexcept try {
         for (auto& decoration : _decorationInfo) {
-            decoration.destructor(container->getDecoration(decoration.descriptor));
+            if (decoration.destructor)
+                decoration.destructor(container->getDecoration(decoration.descriptor));
         }
     } catch (...) {
         std::terminate();
@@ -162,7 +175,8 @@ private:
 
     /**
      * Declares a decoration with given "constructor" and "destructor" functions,
-     * of "sizeBytes" bytes.
+     * of "sizeBytes" bytes. Either function may be null, for decorations that are respectively
+     * value-initialized by zero-filling or trivially destructible.
      *
      * NOTE: "destructor" must not throw exceptions.
      */
@@ -176,7 +190,10 @@ private:
             _totalSizeBytes += alignBytes - misalignment;
         }
         typename DecorationContainer<DecoratedType>::DecorationDescriptor result(_totalSizeBytes);
-        _decorationInfo.push_back(DecorationInfo(result, constructor, destructor));
+        // Decorations that need neither a constructor nor a destructor call are left out of
+        // _decorationInfo entirely; the zero-filled buffer is all they need.
+        if (constructor || destructor)
+            _decorationInfo.push_back(DecorationInfo(result, constructor, destructor));
         _totalSizeBytes += sizeBytes;
         return result;
     }
@@ -28,7 +28,9 @@
 
 #pragma once
 
+#include <cstddef>
 #include <functional>
+#include <new>
 #include <type_traits>
 
 #include "mongo/stdx/type_traits.h"
@@ -44,6 +46,10 @@ class unique_function;
  * it is incapable of being copied.  Often this happens with C++14 or later lambdas which capture a
  * `std::unique_ptr` by move.  The interface of `unique_function` is nearly identical to
  * `std::function`, except that it is not copyable.
+ *
+ * Functors that fit in a few words and are nothrow move constructible, such as lambdas capturing a
+ * couple of pointers or a moved-in smart pointer, are stored inline rather than on the heap. Moving
+ * a `unique_function` holding such a functor moves the functor itself.
  */
 template <typename RetType, typename... Args>
 class unique_function<RetType(Args...)> {
@@ -64,18 +70,29 @@ private:
 public:
     using result_type = RetType;
 
-    ~unique_function() noexcept = default;
+    ~unique_function() noexcept {
+        reset();
+    }
     unique_function() = default;
 
     unique_function(const unique_function&) = delete;
     unique_function& operator=(const unique_function&) = delete;
 
-    unique_function(unique_function&&) noexcept = default;
-    unique_function& operator=(unique_function&&) noexcept = default;
+    unique_function(unique_function&& that) noexcept {
+        takeFrom(that);
+    }
+    unique_function& operator=(unique_function&& that) noexcept {
+        if (this != &that) {
+            reset();
+            takeFrom(that);
+        }
+        return *this;
+    }
 
     void swap(unique_function& that) noexcept {
-        using std::swap;
-        swap(this->impl, that.impl);
+        unique_function tmp(std::move(that));
+        that = std::move(*this);
+        *this = std::move(tmp);
     }
 
     friend void swap(unique_function& a, unique_function& b) noexcept {
@@ -98,7 +115,7 @@ public:
             makeTag(),
         std::enable_if_t<std::is_move_constructible<Functor>::value, TagType> = makeTag(),
         std::enable_if_t<!std::is_same<Functor, unique_function>::value, TagType> = makeTag())
-        : impl(makeImpl(std::forward<Functor>(functor))) {}
+        : impl(makeImpl(std::forward<Functor>(functor), &inlineStorage)) {}
 
     unique_function(std::nullptr_t) noexcept {}
 
@@ -133,8 +150,14 @@ private:
     struct Impl {
         virtual ~Impl() noexcept = default;
         virtual RetType call(Args&&... args) = 0;
+
+        // Move constructs a copy of this impl in 'storage'. Only called on impls stored inline.
+        virtual Impl* moveTo(void* storage) noexcept = 0;
     };
 
+    // Room for an impl, including its vtable pointer, stored inline.
+    using InlineStorage = std::aligned_storage_t<4 * sizeof(void*), alignof(std::max_align_t)>;
+
     // These overload helpers are needed to squelch problems in the `T ()` -> `void ()` case.
     template <typename Functor>
     static void callRegularVoid(const std::true_type isVoid, Functor& f, Args&&... args) {
@@ -149,7 +172,7 @@ private:
     }
 
     template <typename Functor>
-    static auto makeImpl(Functor&& functor) {
+    static Impl* makeImpl(Functor&& functor, InlineStorage* storage) {
         struct SpecificImpl : Impl {
             explicit SpecificImpl(Functor&& func) : f(std::move(func)) {}
 
@@ -157,13 +180,47 @@ private:
                 return callRegularVoid(std::is_void<RetType>(), f, std::forward<Args>(args)...);
             }
 
+            Impl* moveTo(void* storage) noexcept override {
+                return new (storage) SpecificImpl(std::move(f));
+            }
+
             std::decay_t<Functor> f;
         };
 
-        return std::make_unique<SpecificImpl>(std::move(functor));
+        const bool fitsInline = sizeof(SpecificImpl) <= sizeof(InlineStorage) &&
+            alignof(SpecificImpl) <= alignof(InlineStorage) &&
+            std::is_nothrow_move_constructible<std::decay_t<Functor>>::value;
+        if (fitsInline)
+            return new (storage) SpecificImpl(std::move(functor));
+        return new SpecificImpl(std::move(functor));
+    }
+
+    bool isInline() const noexcept {
+        return impl == reinterpret_cast<const Impl*>(&inlineStorage);
+    }
+
+    void reset() noexcept {
+        if (isInline()) {
+            impl->~Impl();
+        } else {
+            delete impl;
+        }
+        impl = nullptr;
+    }
+
+    // Leaves 'that' empty.
+    void takeFrom(unique_function& that) noexcept {
+        if (that.isInline()) {
+            impl = that.impl->moveTo(&inlineStorage);
+            that.reset();
+        } else {
+            impl = that.impl;
+            that.impl = nullptr;
+        }
     }
 
-    std::unique_ptr<Impl> impl;
+    InlineStorage inlineStorage;
+    Impl* impl = nullptr;
 };
 
 template <typename Signature>
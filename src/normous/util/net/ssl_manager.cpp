@@ -242,6 +242,7 @@ std::string x509OidToShortName(const std::string& name) {
 #endif
 
 const auto getTLSVersionCounts = ServiceContext::declareDecoration<TLSVersionCounts>();
+const auto getTLSHandshakeCounts = ServiceContext::declareDecoration<TLSHandshakeCounts>();
 
 }  // namespace
 
@@ -249,6 +250,10 @@ TLSVersionCounts& TLSVersionCounts::get(ServiceContext* serviceContext) {
     return getTLSVersionCounts(serviceContext);
 }
 
+TLSHandshakeCounts& TLSHandshakeCounts::get(ServiceContext* serviceContext) {
+    return getTLSHandshakeCounts(serviceContext);
+}
+
 MONGO_INITIALIZER_WITH_PREREQUISITES(SSLManagerLogger, ("SSLManager", "GlobalLogManager"))
 (InitializerContext*) {
     if (!isSSLServer || (sslGlobalParams.sslMode.load() != SSLParams::SSLMode_disabled)) {
@@ -763,6 +768,13 @@ public:
         builder.append("1.2", counts.tls12.load());
         builder.append("1.3", counts.tls13.load());
         builder.append("unknown", counts.tlsUnknown.load());
+
+        auto& handshakes = TLSHandshakeCounts::get(opCtx->getServiceContext());
+        BSONObjBuilder handshakesBuilder(builder.subobjStart("handshakes"));
+        handshakesBuilder.append("full", handshakes.full.load());
+        handshakesBuilder.append("resumed", handshakes.resumed.load());
+        handshakesBuilder.append("ticketKeyRotations", handshakes.ticketKeyRotations.load());
+        handshakesBuilder.doneFast();
         return builder.obj();
     }
 } tlsVersionStatus;
@@ -817,6 +829,11 @@ void recordTLSVersion(TLSVersion version, const HostAndPort& hostForLogging) {
     }
 }
 
+void recordTLSHandshake(bool resumed) {
+    auto& counts = TLSHandshakeCounts::get(getGlobalServiceContext());
+    (resumed ? counts.resumed : counts.full).addAndFetch(1);
+}
+
 #endif
 
 }  // namespace mongo
@@ -129,6 +129,18 @@ struct TLSVersionCounts {
     static TLSVersionCounts& get(ServiceContext* serviceContext);
 };
 
+/**
+ * Counts of completed TLS handshakes, split by whether they resumed an earlier session, and of
+ * rotations of the keys protecting the session tickets issued by this process.
+ */
+struct TLSHandshakeCounts {
+    AtomicInt64 full;
+    AtomicInt64 resumed;
+    AtomicInt64 ticketKeyRotations;
+
+    static TLSHandshakeCounts& get(ServiceContext* serviceContext);
+};
+
 class SSLManagerInterface : public Decorable<SSLManagerInterface> {
 public:
     static std::unique_ptr<SSLManagerInterface> create(const SSLParams& params, bool isServer);
@@ -258,6 +270,11 @@ StatusWith<TLSVersion> mapTLSVersion(SSLConnectionType conn);
  */
 void recordTLSVersion(TLSVersion version, const HostAndPort& hostForLogging);
 
+/**
+ * Record that a TLS handshake completed, either in full or by resuming an earlier session.
+ */
+void recordTLSHandshake(bool resumed);
+
 
 }  // namespace mongo
 #endif  // #ifdef MONGO_CONFIG_SSL
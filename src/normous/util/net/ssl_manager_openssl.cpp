@@ -33,6 +33,7 @@
 #include "mongo/util/net/ssl_manager.h"
 
 #include <boost/algorithm/string.hpp>
+#include <array>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <fstream>
 #include <iostream>
@@ -68,6 +69,8 @@
 #include <openssl/asn1.h>
 #include <openssl/asn1t.h>
 #include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/rand.h>
 #include <openssl/ssl.h>
 #include <openssl/x509_vfy.h>
 #include <openssl/x509v3.h>
@@ -142,6 +145,123 @@ UniqueBIO makeUniqueMemBio(std::vector<std::uint8_t>& v) {
     return rv;
 }
 
+// Session tickets issued by this server are encrypted with a key which is replaced after this many
+// seconds. Tickets sealed with the previous key are still accepted, and renewed, for one more
+// interval. Zero disables session tickets.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(opensslSessionTicketKeyRotationIntervalSecs, int, 3600)
+    ->withValidator([](const int& newVal) {
+        if (newVal < 0) {
+            return Status(ErrorCodes::BadValue,
+                          "opensslSessionTicketKeyRotationIntervalSecs must not be negative");
+        }
+        return Status::OK();
+    });
+
+/**
+ * The keys used to seal the session tickets handed out by the incoming SSL_CTXs in this process.
+ * Keys are generated randomly and never leave the process, so tickets do not survive a restart.
+ */
+class SessionTicketKeys {
+public:
+    static constexpr size_t kNameLength = 16;
+    static constexpr size_t kKeyLength = 32;
+
+    static SessionTicketKeys& get() {
+        static SessionTicketKeys keys;
+        return keys;
+    }
+
+    /**
+     * Implements the SSL_CTX_set_tlsext_ticket_key_cb() callback. When 'enc' is set, chooses the
+     * current key to seal a new ticket, rotating it first if it has expired. Otherwise looks up the
+     * key named by the ticket, returning 0 if it is no longer known, 1 if it is the current key,
+     * and 2 if the ticket should be reissued under the current key.
+     */
+    int setupTicketCipher(unsigned char* keyName,
+                          unsigned char* iv,
+                          EVP_CIPHER_CTX* cipherCtx,
+                          HMAC_CTX* hmacCtx,
+                          int enc) {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        const auto now = Date_t::now();
+        const Seconds interval(opensslSessionTicketKeyRotationIntervalSecs);
+
+        if (!_current || now - _current->created >= interval) {
+            if (!_rotate_inlock(now)) {
+                return -1;
+            }
+        }
+
+        const Key* key = nullptr;
+        if (enc) {
+            key = &*_current;
+            if (1 != ::RAND_bytes(iv, EVP_CIPHER_iv_length(EVP_aes_256_cbc()))) {
+                return -1;
+            }
+            std::copy(key->name.begin(), key->name.end(), keyName);
+        } else {
+            for (const auto* candidate : {&_current, &_previous}) {
+                if (*candidate &&
+                    std::equal((*candidate)->name.begin(), (*candidate)->name.end(), keyName)) {
+                    key = &**candidate;
+                    break;
+                }
+            }
+            if (!key) {
+                // The ticket was sealed with a key which has since been retired, fall back to a
+                // full handshake.
+                return 0;
+            }
+        }
+
+        if (1 != ::EVP_CipherInit_ex(
+                     cipherCtx, EVP_aes_256_cbc(), nullptr, key->aesKey.data(), iv, enc) ||
+            1 != ::HMAC_Init_ex(hmacCtx, key->hmacKey.data(), kKeyLength, EVP_sha256(), nullptr)) {
+            return -1;
+        }
+
+        return (enc || key == &*_current) ? 1 : 2;
+    }
+
+private:
+    struct Key {
+        std::array<unsigned char, kNameLength> name;
+        std::array<unsigned char, kKeyLength> aesKey;
+        std::array<unsigned char, kKeyLength> hmacKey;
+        Date_t created;
+    };
+
+    bool _rotate_inlock(Date_t now) {
+        Key key;
+        if (1 != ::RAND_bytes(key.name.data(), key.name.size()) ||
+            1 != ::RAND_bytes(key.aesKey.data(), key.aesKey.size()) ||
+            1 != ::RAND_bytes(key.hmacKey.data(), key.hmacKey.size())) {
+            error() << "Failed to generate a TLS session ticket key: "
+                    << SSLManagerInterface::getSSLErrorMessage(ERR_get_error());
+            return false;
+        }
+        key.created = now;
+
+        _previous = std::move(_current);
+        _current = std::move(key);
+        TLSHandshakeCounts::get(getGlobalServiceContext()).ticketKeyRotations.addAndFetch(1);
+        return true;
+    }
+
+    stdx::mutex _mutex;
+    boost::optional<Key> _current;
+    boost::optional<Key> _previous;
+};
+
+int sessionTicketKeyCallback(SSL* ssl,
+                             unsigned char* keyName,
+                             unsigned char* iv,
+                             EVP_CIPHER_CTX* cipherCtx,
+                             HMAC_CTX* hmacCtx,
+                             int enc) {
+    return SessionTicketKeys::get().setupTicketCipher(keyName, iv, cipherCtx, hmacCtx, enc);
+}
+
 // Old copies of OpenSSL will not have constants to disable protocols they don't support.
 // Define them to values we can OR together safely to generically disable these protocols across
 // all versions of OpenSSL.
@@ -756,6 +876,20 @@ Status SSLManagerOpenSSL::initSSLContext(SSL_CTX* context,
                                     << getSSLErrorMessage(ERR_get_error()));
     }
 
+    if (direction == ConnectionDirection::kIncoming) {
+        // Let reconnecting clients resume their sessions instead of redoing the full handshake.
+        // Resumed sessions are bounded by the ticket key lifetime, whether they are resumed from a
+        // ticket or from the server side session cache.
+        const auto ticketKeyInterval = opensslSessionTicketKeyRotationIntervalSecs;
+        if (ticketKeyInterval > 0) {
+            ::SSL_CTX_set_tlsext_ticket_key_cb(context, sessionTicketKeyCallback);
+            ::SSL_CTX_set_timeout(context, ticketKeyInterval);
+        } else {
+            ::SSL_CTX_set_options(context, SSL_OP_NO_TICKET);
+        }
+        ::SSL_CTX_set_session_cache_mode(context, SSL_SESS_CACHE_SERVER);
+    }
+
     if (direction == ConnectionDirection::kOutgoing && params.tlsWithholdClientCertificate) {
         // Do not send a client certificate if they have been suppressed.
 
@@ -1310,6 +1444,7 @@ StatusWith<boost::optional<SSLPeerInfo>> SSLManagerOpenSSL::parseAndValidatePeer
     }
 
     recordTLSVersion(tlsVersionStatus.getValue(), hostForLogging);
+    recordTLSHandshake(::SSL_session_reused(conn));
 
     if (!_sslConfiguration.hasCA && isSSLServer)
         return {boost::none};
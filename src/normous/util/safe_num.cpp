@@ -85,6 +85,25 @@ std::string SafeNum::debugString() const {
     return os.str();
 }
 
+void SafeNum::toBSON(StringData fieldName, BSONObjBuilder* bob) const {
+    switch (_type) {
+        case NumberInt:
+            bob->append(fieldName, _value.int32Val);
+            break;
+        case NumberLong:
+            bob->append(fieldName, static_cast<long long>(_value.int64Val));
+            break;
+        case NumberDouble:
+            bob->append(fieldName, _value.doubleVal);
+            break;
+        case NumberDecimal:
+            bob->append(fieldName, getDecimal(*this));
+            break;
+        default:
+            MONGO_UNREACHABLE;
+    }
+}
+
 std::ostream& operator<<(std::ostream& os, const SafeNum& snum) {
     return os << snum.debugString();
 }
@@ -159,7 +159,11 @@ public:
     friend class mutablebson::Element;
     friend class mutablebson::Document;
 
-    // TODO: output to builder
+    /**
+     * Appends this number to 'bob' as a field named 'fieldName'. Must not be called on an
+     * EOO-typed safe num.
+     */
+    void toBSON(StringData fieldName, BSONObjBuilder* bob) const;
 
     //
     // accessors
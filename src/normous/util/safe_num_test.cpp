@@ -31,6 +31,7 @@
 #undef MONGO_PCH_WHITELISTED  // for malloc/realloc pulled from bson
 
 #include "mongo/bson/bsonobj.h"
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/bson/bsontypes.h"
 #include "mongo/platform/decimal128.h"
 #include "mongo/unittest/unittest.h"
@@ -73,6 +74,19 @@ TEST(Basics, BSONElementInitialization) {
     ASSERT_EQUALS(numDecimal.type(), mongo::NumberDecimal);
 }
 
+TEST(Basics, ToBSONRoundTrips) {
+    const mongo::BSONObj o = BSON("numberInt" << 1 << "numberLong" << 1LL << "numberDouble"
+                                              << 0.1
+                                              << "NumberDecimal"
+                                              << Decimal128("1"));
+
+    mongo::BSONObjBuilder bob;
+    for (auto&& elem : o) {
+        SafeNum(elem).toBSON(elem.fieldNameStringData(), &bob);
+    }
+    ASSERT_TRUE(bob.obj().binaryEqual(o));
+}
+
 TEST(Comparison, EOO) {
     const SafeNum safeNumA;
     const SafeNum safeNumB;
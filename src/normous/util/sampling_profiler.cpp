@@ -0,0 +1,342 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kDefault
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/sampling_profiler.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/config.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/log.h"
+#include "mongo/util/mongoutils/str.h"
+
+#if defined(_POSIX_VERSION) && defined(MONGO_CONFIG_HAVE_EXECINFO_BACKTRACE)
+#define MONGO_HAVE_SAMPLING_PROFILER
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <signal.h>
+#include <sys/time.h>
+#include <third_party/murmurhash3/MurmurHash3.h>
+#endif
+
+namespace mongo {
+namespace {
+
+// The current tags of each thread. These are plain pointers to static strings so that reading
+// them from the signal handler is safe.
+thread_local const char* threadTags[static_cast<size_t>(
+    SamplingProfiler::TagKind::kNumTagKinds)] = {};
+
+}  // namespace
+
+SamplingProfiler::ScopedTag::ScopedTag(TagKind kind, const char* value)
+    : _kind(kind), _previous(threadTags[static_cast<size_t>(kind)]) {
+    threadTags[static_cast<size_t>(kind)] = value;
+}
+
+SamplingProfiler::ScopedTag::~ScopedTag() {
+    threadTags[static_cast<size_t>(_kind)] = _previous;
+}
+
+#ifdef MONGO_HAVE_SAMPLING_PROFILER
+
+namespace {
+
+// Frames recorded per sample, after dropping the handler's own frames.
+const int kMaxFrames = 32;
+const int kSkipFrames = 2;
+
+// Distinct (stack, tags) keys the table can hold, and how far a sample probes for its key.
+const size_t kTableSize = 4096;
+const size_t kMaxProbes = 16;
+
+const size_t kNumTags = static_cast<size_t>(SamplingProfiler::TagKind::kNumTagKinds);
+
+/**
+ * One aggregated stack. An entry is claimed by the first sample to swing 'key' from zero, which
+ * then fills in the frames and tags and publishes them by setting 'ready'. Entries are never
+ * released while samples may still arrive, so readers need only check 'ready'.
+ */
+struct StackEntry {
+    AtomicUInt64 key;
+    AtomicWord<bool> ready;
+    AtomicUInt64 samples;
+    int numFrames;
+    void* frames[kMaxFrames];
+    const char* tags[kNumTags];
+};
+
+// Allocated on the first start and never freed, since a SIGPROF may still be in flight after
+// the timer is stopped.
+StackEntry* stackTable = nullptr;
+
+AtomicWord<bool> sampling{false};
+AtomicUInt64 totalSamples;
+AtomicUInt64 droppedSamples;
+AtomicUInt64 distinctStacks;
+int currentRate = 0;
+
+void recordSample(int, siginfo_t*, void*) {
+    if (!sampling.load())
+        return;
+
+    const int savedErrno = errno;
+
+    void* frames[kMaxFrames + kSkipFrames];
+    const int captured = backtrace(frames, kMaxFrames + kSkipFrames);
+    const int numFrames = std::max(0, captured - kSkipFrames);
+
+    const char* tags[kNumTags];
+    for (size_t i = 0; i < kNumTags; ++i) {
+        tags[i] = threadTags[i];
+    }
+
+    // Hash the frames and the tag pointers together; a 64-bit hash is treated as the identity of
+    // the key, which keeps the handler from having to compare against entries being filled in.
+    uint64_t hash[2];
+    void* keyData[kMaxFrames + kNumTags];
+    std::memcpy(keyData, frames + kSkipFrames, numFrames * sizeof(void*));
+    std::memcpy(keyData + numFrames, tags, sizeof(tags));
+    MurmurHash3_x64_128(keyData, (numFrames + kNumTags) * sizeof(void*), 0, hash);
+    const uint64_t key = hash[0] ? hash[0] : 1;
+
+    totalSamples.fetchAndAdd(1);
+    for (size_t probe = 0; probe < kMaxProbes; ++probe) {
+        StackEntry& entry = stackTable[(key + probe) % kTableSize];
+        uint64_t entryKey = entry.key.load();
+        if (entryKey == 0) {
+            entryKey = entry.key.compareAndSwap(0, key);
+            if (entryKey == 0) {
+                entry.numFrames = numFrames;
+                std::memcpy(entry.frames, frames + kSkipFrames, numFrames * sizeof(void*));
+                std::memcpy(entry.tags, tags, sizeof(tags));
+                entry.ready.store(true);
+                entry.samples.fetchAndAdd(1);
+                distinctStacks.fetchAndAdd(1);
+                errno = savedErrno;
+                return;
+            }
+        }
+        if (entryKey == key) {
+            entry.samples.fetchAndAdd(1);
+            errno = savedErrno;
+            return;
+        }
+    }
+    droppedSamples.fetchAndAdd(1);
+    errno = savedErrno;
+}
+
+std::string symbolize(void* frame) {
+    Dl_info dli;
+    if (dladdr(frame, &dli) && dli.dli_sname) {
+        int status;
+        char* demangled = abi::__cxa_demangle(dli.dli_sname, 0, 0, &status);
+        std::string name;
+        if (demangled) {
+            // Strip off function parameters as they are very verbose and not useful.
+            const char* p = strchr(demangled, '(');
+            name = p ? std::string(demangled, p - demangled) : std::string(demangled);
+            free(demangled);
+        } else {
+            name = dli.dli_sname;
+        }
+        return name;
+    }
+    return str::stream() << frame;
+}
+
+}  // namespace
+
+bool SamplingProfiler::isSupported() {
+    return true;
+}
+
+Status SamplingProfiler::start(int samplesPerSecond) {
+    if (samplesPerSecond < 1 || samplesPerSecond > 1000) {
+        return {ErrorCodes::BadValue, "sampling rate must be between 1 and 1000 per second"};
+    }
+
+    if (!stackTable) {
+        stackTable = new StackEntry[kTableSize]();
+
+        // The first backtrace() call may load libgcc and allocate, which the signal handler must
+        // not do.
+        void* frame;
+        backtrace(&frame, 1);
+
+        // The handler stays installed, since the default action for a stray SIGPROF is to
+        // terminate the process.
+        struct sigaction action;
+        memset(&action, 0, sizeof(action));
+        action.sa_sigaction = &recordSample;
+        action.sa_flags = SA_SIGINFO | SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        if (sigaction(SIGPROF, &action, nullptr) != 0) {
+            return {ErrorCodes::InternalError,
+                    str::stream() << "failed to install SIGPROF handler: "
+                                  << errnoWithDescription()};
+        }
+    }
+
+    struct itimerval timer;
+    timer.it_interval.tv_sec = 0;
+    timer.it_interval.tv_usec = 1000 * 1000 / samplesPerSecond;
+    timer.it_value = timer.it_interval;
+
+    sampling.store(true);
+    if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+        sampling.store(false);
+        return {ErrorCodes::InternalError,
+                str::stream() << "failed to start profiling timer: " << errnoWithDescription()};
+    }
+    currentRate = samplesPerSecond;
+    log() << "Started sampling profiler at " << samplesPerSecond << " samples per second";
+    return Status::OK();
+}
+
+void SamplingProfiler::stop() {
+    if (!isRunning())
+        return;
+    struct itimerval timer;
+    memset(&timer, 0, sizeof(timer));
+    setitimer(ITIMER_PROF, &timer, nullptr);
+    sampling.store(false);
+    currentRate = 0;
+    log() << "Stopped sampling profiler";
+}
+
+bool SamplingProfiler::isRunning() {
+    return sampling.load();
+}
+
+Status SamplingProfiler::reset() {
+    if (isRunning()) {
+        return {ErrorCodes::IllegalOperation, "cannot reset the sampling profiler while running"};
+    }
+    if (stackTable) {
+        for (size_t i = 0; i < kTableSize; ++i) {
+            stackTable[i].ready.store(false);
+            stackTable[i].samples.store(0);
+            stackTable[i].key.store(0);
+        }
+    }
+    totalSamples.store(0);
+    droppedSamples.store(0);
+    distinctStacks.store(0);
+    return Status::OK();
+}
+
+void SamplingProfiler::reportTotals(BSONObjBuilder* builder) {
+    builder->append("running", isRunning());
+    builder->append("samplesPerSecond", currentRate);
+    builder->append("samples", static_cast<long long>(totalSamples.load()));
+    builder->append("droppedSamples", static_cast<long long>(droppedSamples.load()));
+    builder->append("distinctStacks", static_cast<long long>(distinctStacks.load()));
+}
+
+void SamplingProfiler::report(size_t maxStacks, BSONObjBuilder* builder) {
+    reportTotals(builder);
+
+    std::vector<std::pair<uint64_t, const StackEntry*>> entries;
+    if (stackTable) {
+        for (size_t i = 0; i < kTableSize; ++i) {
+            const StackEntry& entry = stackTable[i];
+            if (entry.ready.load()) {
+                entries.emplace_back(entry.samples.load(), &entry);
+            }
+        }
+    }
+    const size_t numReported = std::min(maxStacks, entries.size());
+    std::partial_sort(entries.begin(),
+                      entries.begin() + numReported,
+                      entries.end(),
+                      [](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+
+    BSONArrayBuilder stacksBuilder(builder->subarrayStart("stacks"));
+    for (size_t i = 0; i < numReported; ++i) {
+        const StackEntry& entry = *entries[i].second;
+        BSONObjBuilder stackBuilder(stacksBuilder.subobjStart());
+        stackBuilder.append("samples", static_cast<long long>(entries[i].first));
+        const char* command = entry.tags[static_cast<size_t>(TagKind::kCommand)];
+        const char* phase = entry.tags[static_cast<size_t>(TagKind::kPhase)];
+        if (command)
+            stackBuilder.append("command", command);
+        if (phase)
+            stackBuilder.append("phase", phase);
+        BSONArrayBuilder framesBuilder(stackBuilder.subarrayStart("frames"));
+        for (int j = 0; j < entry.numFrames; ++j) {
+            framesBuilder.append(symbolize(entry.frames[j]));
+        }
+        framesBuilder.doneFast();
+        stackBuilder.doneFast();
+    }
+    stacksBuilder.doneFast();
+}
+
+#else  // MONGO_HAVE_SAMPLING_PROFILER
+
+bool SamplingProfiler::isSupported() {
+    return false;
+}
+
+Status SamplingProfiler::start(int samplesPerSecond) {
+    return {ErrorCodes::CommandNotSupported, "sampling profiler is not supported on this platform"};
+}
+
+void SamplingProfiler::stop() {}
+
+bool SamplingProfiler::isRunning() {
+    return false;
+}
+
+Status SamplingProfiler::reset() {
+    return Status::OK();
+}
+
+void SamplingProfiler::reportTotals(BSONObjBuilder* builder) {
+    builder->append("running", false);
+}
+
+void SamplingProfiler::report(size_t maxStacks, BSONObjBuilder* builder) {
+    reportTotals(builder);
+}
+
+#endif  // MONGO_HAVE_SAMPLING_PROFILER
+
+}  // namespace mongo
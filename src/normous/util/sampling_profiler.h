@@ -0,0 +1,118 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/base/status.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+
+/**
+ * A low-overhead sampling CPU profiler.
+ *
+ * While running, the process receives SIGPROF at the requested rate of CPU time (setitimer with
+ * ITIMER_PROF), and the thread that was interrupted records its stack into a fixed-size table that
+ * aggregates identical stacks. Each sample is also keyed by the thread's current tags: the name
+ * of the command it is running and the operation phase it is in, when those have been set with a
+ * ScopedTag. The signal handler only calls backtrace() and does lock-free updates of the
+ * preallocated table, so leaving the profiler on at a low rate is cheap.
+ *
+ * Stacks are symbolized only when a report is requested. Samples for stacks that don't fit in the
+ * table are counted as dropped.
+ *
+ * The profiler shares SIGPROF with the gperftools CPU profiler (_cpuProfilerStart), and the two
+ * must not be run at the same time.
+ *
+ * All functions other than the ScopedTag ones must not be called concurrently with each other.
+ */
+class SamplingProfiler {
+public:
+    /**
+     * The kinds of tags a thread can attach to its samples.
+     */
+    enum class TagKind { kCommand, kPhase, kNumTagKinds };
+
+    /**
+     * Tags this thread's samples with 'value' for as long as it is in scope, restoring the
+     * previous tag of the same kind on destruction. 'value' must be a null-terminated string with
+     * static lifetime (a string literal or a Command's name).
+     */
+    class ScopedTag {
+        MONGO_DISALLOW_COPYING(ScopedTag);
+
+    public:
+        ScopedTag(TagKind kind, const char* value);
+        ~ScopedTag();
+
+    private:
+        const TagKind _kind;
+        const char* const _previous;
+    };
+
+    /**
+     * Returns false on platforms where sampling is not implemented.
+     */
+    static bool isSupported();
+
+    /**
+     * Starts (or, if running, changes the rate of) sampling at 'samplesPerSecond' samples per
+     * second of process CPU time.
+     */
+    static Status start(int samplesPerSecond);
+
+    /**
+     * Stops sampling. Aggregated samples are kept until reset().
+     */
+    static void stop();
+
+    static bool isRunning();
+
+    /**
+     * Discards all aggregated samples. Only allowed while stopped.
+     */
+    static Status reset();
+
+    /**
+     * Appends the sampling totals and the 'maxStacks' stacks with the most samples, most sampled
+     * first, each with its tags and symbolized frames.
+     */
+    static void report(size_t maxStacks, BSONObjBuilder* builder);
+
+    /**
+     * Appends numeric totals only: samples, dropped samples, distinct stacks and the rate. This
+     * is what serverStatus reports, so that FTDC keeps a stable schema.
+     */
+    static void reportTotals(BSONObjBuilder* builder);
+};
+
+}  // namespace mongo
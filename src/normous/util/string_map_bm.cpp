@@ -0,0 +1,114 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+namespace {
+
+std::vector<std::string> makeKeys(int count) {
+    std::vector<std::string> keys;
+    keys.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        keys.push_back("field_name_" + std::to_string(i));
+    }
+    return keys;
+}
+
+template <typename Map>
+void fill(Map* map, const std::vector<std::string>& keys) {
+    for (size_t i = 0; i < keys.size(); ++i) {
+        (*map)[keys[i]] = i;
+    }
+}
+
+void BM_StringMapFindHit(benchmark::State& state) {
+    const auto keys = makeKeys(state.range(0));
+    StringMap<size_t> map;
+    fill(&map, keys);
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(map.find(keys[i++ % keys.size()]));
+    }
+}
+
+void BM_StringMapFindMiss(benchmark::State& state) {
+    const auto keys = makeKeys(state.range(0));
+    StringMap<size_t> map;
+    fill(&map, keys);
+    const auto missing = makeKeys(2 * state.range(0));
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(map.find(missing[keys.size() + i++ % keys.size()]));
+    }
+}
+
+void BM_StringMapInsert(benchmark::State& state) {
+    const auto keys = makeKeys(state.range(0));
+    for (auto _ : state) {
+        StringMap<size_t> map;
+        fill(&map, keys);
+        benchmark::DoNotOptimize(map.size());
+    }
+}
+
+// The standard library map, as a baseline for the StringMap benchmarks above.
+void BM_StdUnorderedMapFindHit(benchmark::State& state) {
+    const auto keys = makeKeys(state.range(0));
+    std::unordered_map<std::string, size_t> map;
+    fill(&map, keys);
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(map.find(keys[i++ % keys.size()]));
+    }
+}
+
+void BM_StdUnorderedMapInsert(benchmark::State& state) {
+    const auto keys = makeKeys(state.range(0));
+    for (auto _ : state) {
+        std::unordered_map<std::string, size_t> map;
+        fill(&map, keys);
+        benchmark::DoNotOptimize(map.size());
+    }
+}
+
+BENCHMARK(BM_StringMapFindHit)->Range(8, 8 << 10);
+BENCHMARK(BM_StringMapFindMiss)->Range(8, 8 << 10);
+BENCHMARK(BM_StringMapInsert)->Range(8, 8 << 10);
+BENCHMARK(BM_StdUnorderedMapFindHit)->Range(8, 8 << 10);
+BENCHMARK(BM_StdUnorderedMapInsert)->Range(8, 8 << 10);
+
+}  // namespace
+}  // namespace mongo
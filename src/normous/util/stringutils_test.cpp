@@ -270,4 +270,14 @@ TEST(StringUtilsTest, WhitespaceWithinNumberFailsToParse) {
     boost::optional<size_t> result = parseUnsignedBase10Integer(" 10");
     ASSERT(!result);
 }
+
+TEST(StringUtilsTest, EscapeCopiesUnescapedRuns) {
+    ASSERT_EQUALS("", escape(""));
+    ASSERT_EQUALS("plain text", escape("plain text"));
+    ASSERT_EQUALS("\\\"quoted\\\"", escape("\"quoted\""));
+    ASSERT_EQUALS("a\\nb\\tc\\\\", escape("a\nb\tc\\"));
+    ASSERT_EQUALS("a/b", escape("a/b"));
+    ASSERT_EQUALS("a\\/b", escape("a/b", true));
+    ASSERT_EQUALS("x\\u0000y\\u001f", escape(StringData("x\0y\x1f", 4)));
+}
 }  // namespace mongo
@@ -0,0 +1,343 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <list>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/duration.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+/**
+ * A hierarchical timer wheel, which tracks a deadline per key and reports the keys whose deadlines
+ * have passed as time advances.
+ *
+ * Time is divided into ticks of 'resolution'. The wheel has kNumLevels levels of kSlotsPerLevel
+ * slots, where a slot on level L spans kSlotsPerLevel^L ticks, and a timer lives in the slot of the
+ * lowest level that its deadline shares a span with. Whenever the current tick enters a new span of
+ * a level, the timers of the matching slot move down to the level below, until they reach the list
+ * of timers due within the current tick. Deadlines beyond the highest level wait in an overflow
+ * list, which is redistributed once per top level span.
+ *
+ * schedule() and cancel() are O(1). advance() costs O(1) per timer it reports, moves between
+ * levels or finds due within the current tick, plus O(1) per span that contains timers, since spans
+ * without timers are skipped.
+ *
+ * Timers fire exactly: a timer is reported by the first call to advance() with a time at or after
+ * its deadline, whatever the resolution.
+ *
+ * This class is not thread safe.
+ */
+template <typename K, typename Hash = typename stdx::unordered_map<K, int>::hasher>
+class TimerWheel {
+    MONGO_DISALLOW_COPYING(TimerWheel);
+
+public:
+    static constexpr int kBitsPerLevel = 6;
+    static constexpr std::size_t kSlotsPerLevel = 1 << kBitsPerLevel;
+    static constexpr std::size_t kNumLevels = 4;
+
+    /**
+     * Constructs a wheel whose current time is 'start'.
+     */
+    TimerWheel(Milliseconds resolution, Date_t start)
+        : _resolution(resolution), _start(start), _now(start) {
+        invariant(_resolution > Milliseconds(0));
+    }
+
+    /**
+     * Sets the deadline of 'key' to 'deadline', replacing any deadline 'key' already had. A
+     * deadline at or before the current time fires on the next call to advance().
+     */
+    void schedule(const K& key, Date_t deadline) {
+        cancel(key);
+        _insert(key, deadline);
+    }
+
+    /**
+     * Removes the deadline of 'key'. Returns false if 'key' had no deadline.
+     */
+    bool cancel(const K& key) {
+        auto it = _timers.find(key);
+        if (it == _timers.end()) {
+            return false;
+        }
+
+        _remove(it->second);
+        _timers.erase(it);
+        return true;
+    }
+
+    bool contains(const K& key) const {
+        return _timers.find(key) != _timers.end();
+    }
+
+    /**
+     * Returns the number of keys with a deadline.
+     */
+    std::size_t size() const {
+        return _timers.size();
+    }
+
+    /**
+     * Moves the current time forward to 'now', then removes and returns the keys whose deadlines
+     * are at or before it. Moving the current time backwards is a no-op.
+     */
+    std::vector<K> advance(Date_t now) {
+        _now = std::max(_now, now);
+
+        const long long target = _tickOf(_now);
+        while (_currentTick < target) {
+            _skipEmptySpans(target);
+            if (_currentTick == target) {
+                break;
+            }
+
+            // Every timer due within the previous tick has passed its deadline.
+            ++_currentTick;
+            _moveAll(&_due, &_expired, kExpiredLevel);
+            _cascade();
+        }
+
+        for (auto it = _due.begin(); it != _due.end();) {
+            auto& timer = _timers[*it];
+            if (timer.deadline > _now) {
+                ++it;
+                continue;
+            }
+            timer.level = kExpiredLevel;
+            timer.slot = &_expired;
+            _expired.splice(_expired.end(), _due, it++);
+        }
+
+        std::vector<K> expired;
+        expired.reserve(_expired.size());
+        for (auto&& key : _expired) {
+            _timers.erase(key);
+            expired.push_back(std::move(key));
+        }
+        _expired.clear();
+        return expired;
+    }
+
+    /**
+     * Removes every deadline.
+     */
+    void clear() {
+        for (auto&& level : _levels) {
+            for (auto&& slot : level) {
+                slot.clear();
+            }
+        }
+        _levelSizes.fill(0);
+        _overflow.clear();
+        _due.clear();
+        _expired.clear();
+        _timers.clear();
+    }
+
+private:
+    using Slot = std::list<K>;
+
+    // Level indexes for timers which are not on a level of the wheel.
+    static constexpr std::size_t kDueLevel = kNumLevels;
+    static constexpr std::size_t kExpiredLevel = kNumLevels + 1;
+    static constexpr std::size_t kOverflowLevel = kNumLevels + 2;
+
+    struct Timer {
+        Date_t deadline;
+        std::size_t level;
+        Slot* slot;
+        typename Slot::iterator position;
+    };
+
+    /**
+     * Returns the tick which contains 'date'. Dates before '_start' belong to the first tick.
+     */
+    long long _tickOf(Date_t date) const {
+        const long long millis = durationCount<Milliseconds>(date - _start);
+        if (millis <= 0) {
+            return 0;
+        }
+        return millis / durationCount<Milliseconds>(_resolution);
+    }
+
+    static long long _spanOf(std::size_t level) {
+        return 1LL << (kBitsPerLevel * level);
+    }
+
+    /**
+     * Places the timer of 'key' in the slot for 'deadline' relative to the current time.
+     */
+    void _insert(const K& key, Date_t deadline) {
+        Timer timer;
+        timer.deadline = deadline;
+        if (deadline <= _now) {
+            timer.level = kExpiredLevel;
+            timer.slot = &_expired;
+        } else {
+            const long long tick = _tickOf(deadline);
+            timer.level = _levelFor(tick);
+            if (timer.level == kDueLevel) {
+                timer.slot = &_due;
+            } else if (timer.level == kOverflowLevel) {
+                timer.slot = &_overflow;
+            } else {
+                const auto index = (tick >> (kBitsPerLevel * timer.level)) & (kSlotsPerLevel - 1);
+                timer.slot = &_levels[timer.level][index];
+                ++_levelSizes[timer.level];
+            }
+        }
+        timer.position = timer.slot->insert(timer.slot->end(), key);
+        _timers[key] = timer;
+    }
+
+    void _remove(const Timer& timer) {
+        if (timer.level < kNumLevels) {
+            --_levelSizes[timer.level];
+        }
+        timer.slot->erase(timer.position);
+    }
+
+    /**
+     * Returns the lowest level with a span that holds both 'tick' and the current tick, where
+     * 'tick' is not before the current tick.
+     */
+    std::size_t _levelFor(long long tick) const {
+        if (tick == _currentTick) {
+            return kDueLevel;
+        }
+
+        const unsigned long long differingBits = tick ^ _currentTick;
+        for (std::size_t level = 0; level < kNumLevels; ++level) {
+            if ((differingBits >> (kBitsPerLevel * (level + 1))) == 0) {
+                return level;
+            }
+        }
+        return kOverflowLevel;
+    }
+
+    /**
+     * Moves the current tick to just before the next tick at which a timer could fire or cascade,
+     * or to 'target' if that comes first.
+     */
+    void _skipEmptySpans(long long target) {
+        std::size_t emptyLevels = 0;
+        while (emptyLevels < kNumLevels && _levelSizes[emptyLevels] == 0) {
+            ++emptyLevels;
+        }
+        if (emptyLevels == 0) {
+            return;
+        }
+        if (emptyLevels == kNumLevels && _overflow.empty()) {
+            _currentTick = target;
+            return;
+        }
+
+        // Nothing happens until the current tick enters the next span of the lowest level with
+        // timers, which cascades that level's next slot.
+        const long long span = _spanOf(emptyLevels);
+        const long long nextSpan = (_currentTick / span + 1) * span;
+        _currentTick = std::min(target, nextSpan - 1);
+    }
+
+    /**
+     * Redistributes the timers of every slot whose span starts at the current tick, from the
+     * highest level down, so that the timers due within the current tick end up in '_due'.
+     */
+    void _cascade() {
+        if (_currentTick % _spanOf(kNumLevels) == 0) {
+            _redistribute(&_overflow);
+        }
+
+        for (std::size_t level = kNumLevels; level-- > 0;) {
+            if (_currentTick % _spanOf(level) != 0) {
+                continue;
+            }
+            const auto index = (_currentTick >> (kBitsPerLevel * level)) & (kSlotsPerLevel - 1);
+            _redistribute(&_levels[level][index]);
+        }
+    }
+
+    void _redistribute(Slot* slot) {
+        Slot timers;
+        timers.swap(*slot);
+        for (auto&& key : timers) {
+            auto& timer = _timers[key];
+            if (timer.level < kNumLevels) {
+                --_levelSizes[timer.level];
+            }
+            const Date_t deadline = timer.deadline;
+            _insert(key, deadline);
+        }
+    }
+
+    /**
+     * Moves every timer of 'from', which must not be a level of the wheel, to 'to'.
+     */
+    void _moveAll(Slot* from, Slot* to, std::size_t level) {
+        for (auto&& key : *from) {
+            auto& timer = _timers[key];
+            timer.level = level;
+            timer.slot = to;
+        }
+        to->splice(to->end(), *from);
+    }
+
+    const Milliseconds _resolution;
+    const Date_t _start;
+
+    // The latest time passed to advance(), and the number of whole ticks between '_start' and it.
+    Date_t _now;
+    long long _currentTick = 0;
+
+    std::array<std::array<Slot, kSlotsPerLevel>, kNumLevels> _levels;
+    std::array<std::size_t, kNumLevels> _levelSizes{};
+
+    // Timers too far in the future for the highest level.
+    Slot _overflow;
+
+    // Timers whose deadlines fall later within the current tick.
+    Slot _due;
+
+    // Timers whose deadlines have passed, to be reported by the next call to advance().
+    Slot _expired;
+
+    stdx::unordered_map<K, Timer, Hash> _timers;
+};
+
+}  // namespace mongo
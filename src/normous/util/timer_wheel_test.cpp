@@ -0,0 +1,165 @@
+/**
+ * Copyright (C) 2018 MongoDB Inc.
+ *
+ * This program is free software: you can redistribute it and/or  modify
+ * it under the terms of the GNU Affero General Public License, version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * As a special exception, the copyright holders give permission to link the
+ * code of portions of this program with the OpenSSL library under certain
+ * conditions as described in each individual source file and distribute
+ * linked combinations including the program with the OpenSSL library. You
+ * must comply with the GNU Affero General Public License in all respects
+ * for all of the code used other than as permitted herein. If you modify
+ * file(s) with this exception, you may extend this exception to your
+ * version of the file(s), but you are not obligated to do so. If you do not
+ * wish to do so, delete this exception statement from your version. If you
+ * delete this exception statement from all source files in the program,
+ * then also delete it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/timer_wheel.h"
+
+#include <algorithm>
+#include <map>
+
+#include "mongo/platform/random.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const Date_t kStart = Date_t::fromMillisSinceEpoch(1000 * 1000);
+
+std::vector<int> sorted(std::vector<int> keys) {
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+TEST(TimerWheelTest, FiresTimersOnceTheirDeadlinePasses) {
+    TimerWheel<int> wheel(Milliseconds(10), kStart);
+    wheel.schedule(1, kStart + Milliseconds(25));
+    wheel.schedule(2, kStart + Milliseconds(100));
+    ASSERT_EQ(2U, wheel.size());
+
+    // Deadlines within a tick fire exactly.
+    ASSERT(wheel.advance(kStart + Milliseconds(20)).empty());
+    ASSERT(wheel.advance(kStart + Milliseconds(24)).empty());
+    ASSERT(std::vector<int>{1} == wheel.advance(kStart + Milliseconds(25)));
+    ASSERT_FALSE(wheel.contains(1));
+    ASSERT(wheel.advance(kStart + Milliseconds(99)).empty());
+    ASSERT(std::vector<int>{2} == wheel.advance(kStart + Milliseconds(100)));
+    ASSERT_EQ(0U, wheel.size());
+}
+
+TEST(TimerWheelTest, PastDeadlinesFireOnNextAdvance) {
+    TimerWheel<int> wheel(Milliseconds(10), kStart);
+    wheel.advance(kStart + Seconds(1));
+    wheel.schedule(1, kStart);
+    wheel.schedule(2, kStart + Seconds(1));
+    ASSERT(std::vector<int>({1, 2}) == sorted(wheel.advance(kStart + Seconds(1))));
+}
+
+TEST(TimerWheelTest, CancelRemovesTimer) {
+    TimerWheel<int> wheel(Milliseconds(1), kStart);
+    wheel.schedule(1, kStart + Milliseconds(5));
+    wheel.schedule(2, kStart + Milliseconds(5));
+    ASSERT_TRUE(wheel.cancel(1));
+    ASSERT_FALSE(wheel.cancel(1));
+    ASSERT_FALSE(wheel.cancel(3));
+    ASSERT(std::vector<int>{2} == wheel.advance(kStart + Milliseconds(5)));
+}
+
+TEST(TimerWheelTest, ScheduleReplacesDeadline) {
+    TimerWheel<int> wheel(Milliseconds(1), kStart);
+    wheel.schedule(1, kStart + Milliseconds(5));
+    wheel.schedule(1, kStart + Seconds(10));
+    ASSERT_EQ(1U, wheel.size());
+    ASSERT(wheel.advance(kStart + Seconds(9)).empty());
+    ASSERT(std::vector<int>{1} == wheel.advance(kStart + Seconds(10)));
+}
+
+TEST(TimerWheelTest, MovingBackwardsIsANoOp) {
+    TimerWheel<int> wheel(Milliseconds(1), kStart);
+    wheel.advance(kStart + Milliseconds(100));
+    wheel.schedule(1, kStart + Milliseconds(150));
+    ASSERT(wheel.advance(kStart).empty());
+    ASSERT(std::vector<int>{1} == wheel.advance(kStart + Milliseconds(150)));
+}
+
+TEST(TimerWheelTest, CascadesDeadlinesFromEveryLevelAndOverflow) {
+    TimerWheel<int> wheel(Milliseconds(1), kStart);
+
+    // One deadline per level, plus one beyond the highest level.
+    std::vector<long long> offsets{3, 100, 5000, 300000, 20000000, 50000000};
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        wheel.schedule(i, kStart + Milliseconds(offsets[i]));
+    }
+
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        ASSERT(wheel.advance(kStart + Milliseconds(offsets[i] - 1)).empty());
+        ASSERT(std::vector<int>{static_cast<int>(i)} ==
+               wheel.advance(kStart + Milliseconds(offsets[i])));
+    }
+    ASSERT_EQ(0U, wheel.size());
+}
+
+TEST(TimerWheelTest, ClearRemovesEveryTimer) {
+    TimerWheel<int> wheel(Milliseconds(1), kStart);
+    for (int i = 0; i < 100; ++i) {
+        wheel.schedule(i, kStart + Milliseconds(i * 1000));
+    }
+    wheel.clear();
+    ASSERT_EQ(0U, wheel.size());
+    ASSERT(wheel.advance(kStart + Hours(24)).empty());
+}
+
+TEST(TimerWheelTest, MatchesReferenceOnRandomSchedules) {
+    PseudoRandom random(12345);
+    TimerWheel<int> wheel(Milliseconds(7), kStart);
+    std::map<int, Date_t> deadlines;
+
+    Date_t now = kStart;
+    for (int round = 0; round < 2000; ++round) {
+        const int key = random.nextInt32(500);
+        const auto action = random.nextInt32(4);
+        if (action == 0) {
+            ASSERT_EQ(deadlines.erase(key) == 1, wheel.cancel(key));
+        } else {
+            // Deadlines range from the past to far beyond the highest level of the wheel.
+            const long long offset = random.nextInt64(1LL << (round % 32)) - 100;
+            const Date_t deadline = now + Milliseconds(offset);
+            wheel.schedule(key, deadline);
+            deadlines[key] = deadline;
+        }
+
+        now += Milliseconds(random.nextInt64(1LL << (round % 28)));
+        std::vector<int> fired = sorted(wheel.advance(now));
+
+        // Exactly the timers whose deadlines have passed fire, whatever the resolution.
+        std::vector<int> due;
+        for (const auto& entry : deadlines) {
+            if (entry.second <= now) {
+                due.push_back(entry.first);
+            }
+        }
+        ASSERT(due == fired);
+        for (int key : fired) {
+            deadlines.erase(key);
+        }
+        ASSERT_EQ(deadlines.size(), wheel.size());
+    }
+}
+
+}  // namespace
+}  // namespace mongo
@@ -130,6 +130,49 @@ TEST(UniqueFunctionTest, dtor_releases_functor_object_and_does_not_call_function
     ASSERT_FALSE(runDetection1.itRan);
 }
 
+TEST(UniqueFunctionTest, move_and_swap_preserve_small_and_large_functors) {
+    static int liveCounters = 0;
+    struct Counter {
+        Counter() {
+            ++liveCounters;
+        }
+        Counter(Counter&&) noexcept {
+            ++liveCounters;
+        }
+        ~Counter() {
+            --liveCounters;
+        }
+    };
+    struct Padding {
+        char bytes[256];
+    };
+
+    {
+        // The first functor is small enough to be stored inline, the second one is not.
+        mongo::unique_function<int()> small = [c = Counter()] { return 1; };
+        mongo::unique_function<int()> large = [c = Counter(), p = Padding()] { return 2; };
+        ASSERT_EQ(liveCounters, 2);
+
+        mongo::unique_function<int()> movedSmall = std::move(small);
+        mongo::unique_function<int()> movedLarge = std::move(large);
+        ASSERT_FALSE(small);
+        ASSERT_FALSE(large);
+        ASSERT_EQ(liveCounters, 2);
+        ASSERT_EQ(movedSmall(), 1);
+        ASSERT_EQ(movedLarge(), 2);
+
+        swap(movedSmall, movedLarge);
+        ASSERT_EQ(movedSmall(), 2);
+        ASSERT_EQ(movedLarge(), 1);
+        ASSERT_EQ(liveCounters, 2);
+
+        movedSmall = std::move(movedLarge);
+        ASSERT_EQ(movedSmall(), 1);
+        ASSERT_EQ(liveCounters, 1);
+    }
+    ASSERT_EQ(liveCounters, 0);
+}
+
 TEST(UniqueFunctionTest, comparison_checks) {
     mongo::unique_function<void()> uf;
 
@@ -75,7 +75,7 @@ private:
         Entry() = default;
 
         Entry(const Entry& other)
-            : _used(other._used), _everUsed(other.everUsed), _curHash(other._curHash) {
+            : _used(other._used), _everUsed(other._everUsed), _curHash(other._curHash) {
             if (other.isUsed()) {
                 new (&_data) value_type(other.getData());
             }
@@ -156,17 +156,27 @@ private:
     };
 
     struct Area {
+        // Values of the per-slot tags. Any other value is the tag of a used slot, derived from the
+        // hash of its key by tagForHash().
+        enum : uint32_t { kEmptyTag = 0, kDeletedTag = 1, kFirstHashTag = 2 };
+
+        static uint32_t tagForHash(uint32_t hash) {
+            return hash < kFirstHashTag ? hash + kFirstHashTag : hash;
+        }
+
         Area() = default;  // TODO constexpr
 
         Area(unsigned capacity, unsigned maxProbe)
             : _hashMask(capacity - 1),
               _maxProbe(maxProbe),
+              _tags(capacity ? new uint32_t[capacity]() : nullptr),
               _entries(capacity ? new Entry[capacity] : nullptr) {
             // Capacity must be a power of two or zero. See the comment on _hashMask for why.
             dassert((capacity & (capacity - 1)) == 0);
         }
 
         Area(const Area& other) : Area(other.capacity(), other._maxProbe) {
+            std::copy(other._tags.get(), other._tags.get() + other.capacity(), _tags.get());
             std::copy(other.begin(), other.end(), begin());
         }
 
@@ -179,10 +189,22 @@ private:
 
         bool transfer(Area* newArea) const;
 
+        template <typename... Args>
+        void emplaceData(int pos, const HashedKey& key, Args&&... args) {
+            _entries[pos].emplaceData(key, std::forward<Args>(args)...);
+            _tags[pos] = tagForHash(key.hash());
+        }
+
+        void unUse(int pos) {
+            _entries[pos].unUse();
+            _tags[pos] = kDeletedTag;
+        }
+
         void swap(Area* other) {
             using std::swap;
             swap(_hashMask, other->_hashMask);
             swap(_maxProbe, other->_maxProbe);
+            swap(_tags, other->_tags);
             swap(_entries, other->_entries);
         }
 
@@ -210,6 +232,10 @@ private:
         // default hashMask is -1.
         unsigned _hashMask = -1;
         unsigned _maxProbe = 0;
+
+        // One tag per slot, kept apart from the entries so that probing reads a dense array of
+        // 4-byte tags and only touches an entry, and so its key, when the tags match.
+        std::unique_ptr<uint32_t[]> _tags = {};
         std::unique_ptr<Entry[]> _entries = {};
     };
 
@@ -326,7 +352,7 @@ public:
                     _position = -1;
                     break;
                 }
-                if (_area->_entries[_position].isUsed())
+                if (_area->_tags[_position] >= Area::kFirstHashTag)
                     break;
                 ++_position;
             }
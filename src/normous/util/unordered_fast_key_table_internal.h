@@ -40,20 +40,22 @@ inline int UnorderedFastKeyTable<K_L, K_S, V, Traits>::Area::find(const HashedKe
     dassert(capacity());                        // Caller must special-case empty tables.
     dassert(!firstEmpty || *firstEmpty == -1);  // Caller must initialize *firstEmpty.
 
+    const uint32_t tag = tagForHash(key.hash());
     unsigned probe = 0;
     do {
         unsigned pos = (key.hash() + probe) & _hashMask;
+        const uint32_t slotTag = _tags[pos];
 
-        if (!_entries[pos].isUsed()) {
+        if (slotTag < kFirstHashTag) {
             // space is empty
             if (firstEmpty && *firstEmpty == -1)
                 *firstEmpty = pos;
-            if (!_entries[pos].wasEverUsed())
+            if (slotTag == kEmptyTag)
                 return -1;
             continue;
         }
 
-        if (_entries[pos].getCurHash() != key.hash()) {
+        if (slotTag != tag) {
             // space has something else
             continue;
         }
@@ -87,6 +89,7 @@ inline bool UnorderedFastKeyTable<K_L, K_S, V, Traits>::Area::transfer(Area* new
         }
 
         newArea->_entries[firstEmpty] = entry;
+        newArea->_tags[firstEmpty] = tagForHash(entry.getCurHash());
     }
     return true;
 }
@@ -121,7 +124,7 @@ inline size_t UnorderedFastKeyTable<K_L, K_S, V, Traits>::erase(const HashedKey&
         return 0;
 
     --_size;
-    _area._entries[pos].unUse();
+    _area.unUse(pos);
     return 1;
 }
 
@@ -131,7 +134,7 @@ void UnorderedFastKeyTable<K_L, K_S, V, Traits>::erase(const_iterator it) {
     dassert(it._area == &_area);
 
     --_size;
-    _area._entries[it._position].unUse();
+    _area.unUse(it._position);
 }
 
 template <typename K_L, typename K_S, typename V, typename Traits>
@@ -159,7 +162,7 @@ inline auto UnorderedFastKeyTable<K_L, K_S, V, Traits>::try_emplace(const Hashed
         // need to add
         if (firstEmpty >= 0) {
             _size++;
-            _area._entries[firstEmpty].emplaceData(key, std::forward<Args>(args)...);
+            _area.emplaceData(firstEmpty, key, std::forward<Args>(args)...);
             return {iterator(&_area, firstEmpty), true};
         }
 